@@ -25,6 +25,8 @@
 #include <Urho3D/Core/ProcessUtils.h>
 #include <Urho3D/Graphics/Animation.h>
 #include <Urho3D/IO/ArchiveSerialization.h>
+#include <Urho3D/IO/ContentHash.h>
+#include <Urho3D/IO/File.h>
 #include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/Resource/JSONFile.h>
 #if URHO3D_GLOW
@@ -41,6 +43,14 @@ namespace
 
 const ea::string DefaultSkipTag = "[skip]";
 
+/// Folder in asset cache where converted FBX and Blender files are stored.
+const ea::string ConversionCacheFolder = "Conversions/";
+/// Version of the conversion cache. Increment to invalidate all converted files.
+const unsigned ConversionCacheVersion = 1;
+
+/// Folder in asset cache where lightmap UV charts are stored.
+const ea::string LightmapUVCacheFolder = "LightmapUV/";
+
 bool IsFileNameGLTF(const ea::string& fileName, bool strict = true)
 {
     if (!strict && (fileName.ends_with(".gltf_", false) || fileName.ends_with(".glb_", false)))
@@ -170,6 +180,23 @@ void ModelImporter::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Skip Tag", ea::string, settings_.skipTag_, DefaultSkipTag, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Keep Names On Merge", bool, settings_.keepNamesOnMerge_, false, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Add Empty Nodes To Skeleton", bool, settings_.addEmptyNodesToSkeleton_, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Optimize Meshes", bool, settings_.optimizeMeshes_, true, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Weld Vertices", bool, settings_.weldVertices_, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Generate LODs: Count", unsigned, settings_.numGeneratedLODs_, 0, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Generate LODs: Triangle Ratio", float, settings_.generatedLODTriangleRatio_, 0.5f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Generate LODs: Distance", float, settings_.generatedLODDistance_, 20.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Generate LODs: Max Error", float, settings_.generatedLODMaxError_, 0.02f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Streamable LODs", bool, settings_.streamableLODs_, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Quantize: Positions", bool, settings_.quantizePositions_, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Quantize: Normals", bool, settings_.quantizeNormals_, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Quantize: UVs", bool, settings_.quantizeUVs_, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Meshlets: Generate", bool, settings_.generateMeshlets_, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Meshlets: Max Vertices", unsigned, settings_.meshletMaxVertices_, 64, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Meshlets: Max Triangles", unsigned, settings_.meshletMaxTriangles_, 124, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Compress Animations", bool, settings_.compressAnimations_, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Compress Animations: Position Error", float, settings_.animationPositionError_, 0.001f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Compress Animations: Rotation Error", float, settings_.animationRotationError_, 0.1f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Compress Animations: Scale Error", float, settings_.animationScaleError_, 0.001f, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Repair Looping", bool, repairLooping_, false, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Blender: Apply Modifiers", bool, blenderApplyModifiers_, true, AM_DEFAULT);
     URHO3D_ATTRIBUTE("LightMap UV: Generate", bool, lightmapUVGenerate_, false, AM_DEFAULT);
@@ -225,16 +252,11 @@ bool ModelImporter::Execute(
     const AssetTransformerInput& input, AssetTransformerOutput& output, const AssetTransformerVector& transformers)
 {
     const ModelMetadata metadata = LoadMetadata(input.inputFileName_);
-    const GLTFFileHandle handle = LoadData(input.inputFileName_, input.tempPath_);
-
-    if (!handle)
-        return false;
-
-    return ImportGLTF(handle, metadata, input, output, transformers);
+    return ImportGLTF(metadata, input, output, transformers);
 }
 
-bool ModelImporter::ImportGLTF(GLTFFileHandle fileHandle, const ModelMetadata& metadata,
-    const AssetTransformerInput& input, AssetTransformerOutput& output, const AssetTransformerVector& transformers)
+bool ModelImporter::ImportGLTF(const ModelMetadata& metadata, const AssetTransformerInput& input,
+    AssetTransformerOutput& output, const AssetTransformerVector& transformers)
 {
     currentMetadata_ = &metadata;
     const auto metadataGuard = ea::make_finally([&] { currentMetadata_ = nullptr; });
@@ -248,29 +270,32 @@ bool ModelImporter::ImportGLTF(GLTFFileHandle fileHandle, const ModelMetadata& m
 
     const ea::string outputPath = AddTrailingSlash(input.outputFileName_);
     const ea::string resourceNamePrefix = AddTrailingSlash(input.resourceName_);
-    if (!importer->LoadFile(fileHandle->fileName_))
+
+    // Source model doesn't depend on the flavor, so it's loaded once if the asset is imported for several flavors
+    const ea::string sharedModelKey = Format("{}.SourceModel.{}", GetTypeName(), blenderApplyModifiers_);
+    const auto sharedModel =
+        input.sharedData_ ? input.sharedData_->Get<SharedSourceModel>(sharedModelKey) : nullptr;
+    if (sharedModel)
     {
-        URHO3D_LOGERROR("Failed to load asset {} as GLTF model", input.resourceName_);
-        return false;
-    }
+        if (!importer->LoadSourceModel(sharedModel->model_))
+            return false;
 
-    for (const ea::string& secondaryFileName : metadata.appendFiles_)
+        for (const ea::string& dependency : sharedModel->dependencies_)
+            AddDependency(input, output, dependency);
+    }
+    else
     {
-        const ea::string secondaryFilePath = GetPath(input.originalInputFileName_) + secondaryFileName;
-        const GLTFFileHandle secondaryFileHandle = LoadData(secondaryFilePath, input.tempPath_);
-        if (!secondaryFileHandle)
-        {
-            URHO3D_LOGWARNING("Failed to load secondary file {} for asset {}", secondaryFilePath, input.resourceName_);
-            continue;
-        }
+        auto newSharedModel = ea::make_shared<SharedSourceModel>();
+        if (!LoadSourceModel(*importer, metadata, input, newSharedModel->dependencies_))
+            return false;
 
-        AddDependency(input, output, secondaryFilePath);
+        for (const ea::string& dependency : newSharedModel->dependencies_)
+            AddDependency(input, output, dependency);
 
-        if (!importer->MergeFile(secondaryFileHandle->fileName_, GetFileName(secondaryFilePath)))
+        if (input.sharedData_)
         {
-            URHO3D_LOGWARNING(
-                "Failed to merge secondary file {} into asset {}", secondaryFilePath, input.resourceName_);
-            continue;
+            newSharedModel->model_ = importer->GetSourceModel();
+            input.sharedData_->Set(sharedModelKey, newSharedModel);
         }
     }
 
@@ -317,6 +342,8 @@ void ModelImporter::OnModelLoaded(ModelView& modelView)
         LightmapUVGenerationSettings settings;
         settings.texelPerUnit_ = lightmapUVTexelsPerUnit_;
         settings.uvChannel_ = lightmapUVChannel_;
+        if (auto project = GetSubsystem<Project>())
+            settings.cacheDirectory_ = project->GetAssetCachePath() + LightmapUVCacheFolder;
         if (!GenerateLightmapUV(modelView, settings))
             throw RuntimeException("Failed to generate lightmap UVs");
 #else
@@ -428,6 +455,41 @@ void ModelImporter::AppendResourceMetadata(ResourceWithMetadata& resource) const
         resource.AddMetadata(name, value);
 }
 
+bool ModelImporter::LoadSourceModel(GLTFImporter& importer, const ModelMetadata& metadata,
+    const AssetTransformerInput& input, StringVector& dependencies) const
+{
+    const GLTFFileHandle fileHandle = LoadData(input.inputFileName_, input.tempPath_);
+    if (!fileHandle)
+        return false;
+
+    if (!importer.LoadFile(fileHandle->fileName_))
+    {
+        URHO3D_LOGERROR("Failed to load asset {} as GLTF model", input.resourceName_);
+        return false;
+    }
+
+    for (const ea::string& secondaryFileName : metadata.appendFiles_)
+    {
+        const ea::string secondaryFilePath = GetPath(input.originalInputFileName_) + secondaryFileName;
+        const GLTFFileHandle secondaryFileHandle = LoadData(secondaryFilePath, input.tempPath_);
+        if (!secondaryFileHandle)
+        {
+            URHO3D_LOGWARNING("Failed to load secondary file {} for asset {}", secondaryFilePath, input.resourceName_);
+            continue;
+        }
+
+        dependencies.push_back(secondaryFilePath);
+
+        if (!importer.MergeFile(secondaryFileHandle->fileName_, GetFileName(secondaryFilePath)))
+        {
+            URHO3D_LOGWARNING(
+                "Failed to merge secondary file {} into asset {}", secondaryFilePath, input.resourceName_);
+            continue;
+        }
+    }
+    return true;
+}
+
 ModelImporter::ModelMetadata ModelImporter::LoadMetadata(const ea::string& fileName) const
 {
     ModelMetadata result;
@@ -479,6 +541,10 @@ ModelImporter::GLTFFileHandle ModelImporter::LoadDataFromFBX(
     if (!fs->FileExists(fileName))
         return nullptr;
 
+    const ea::string convertedFileName = GetConvertedFileName(fileName, toolManager->GetFBX2glTF(), "", ".glb");
+    if (!convertedFileName.empty() && fs->FileExists(convertedFileName))
+        return ea::make_shared<GLTFFileInfo>(GLTFFileInfo{convertedFileName});
+
     const ea::string tempGltfFile = Format("{}{}.glb", tempPath, GenerateUUID());
     const StringVector arguments{"--binary", "--input", fileName, "--output", tempGltfFile};
 
@@ -489,12 +555,7 @@ ModelImporter::GLTFFileHandle ModelImporter::LoadDataFromFBX(
         return nullptr;
     }
 
-    const auto deleter = [fs](GLTFFileInfo* handle)
-    {
-        fs->Delete(handle->fileName_);
-        delete handle;
-    };
-    return ea::shared_ptr<GLTFFileInfo>(new GLTFFileInfo{tempGltfFile}, deleter);
+    return StoreConvertedFile(tempGltfFile, convertedFileName);
 }
 
 ModelImporter::GLTFFileHandle ModelImporter::LoadDataFromBlend(
@@ -506,6 +567,11 @@ ModelImporter::GLTFFileHandle ModelImporter::LoadDataFromBlend(
     if (!fs->FileExists(fileName))
         return nullptr;
 
+    const ea::string settings = Format("applyModifiers={}", blenderApplyModifiers_);
+    const ea::string convertedFileName = GetConvertedFileName(fileName, toolManager->GetBlender(), settings, ".gltf");
+    if (!convertedFileName.empty() && fs->FileExists(convertedFileName))
+        return ea::make_shared<GLTFFileInfo>(GLTFFileInfo{convertedFileName});
+
     const ea::string tempGltfFile = tempPath + "model.gltf";
 
     // This script is passed as command line argument, so it must be a single line and use single quotes
@@ -527,12 +593,66 @@ ModelImporter::GLTFFileHandle ModelImporter::LoadDataFromBlend(
         return nullptr;
     }
 
+    return StoreConvertedFile(tempGltfFile, convertedFileName);
+}
+
+ea::string ModelImporter::GetConvertedFileName(const ea::string& fileName, const ea::string& toolFileName,
+    const ea::string& settings, const ea::string& extension) const
+{
+    auto fs = context_->GetSubsystem<FileSystem>();
+    auto project = GetSubsystem<Project>();
+    if (!project)
+        return EMPTY_STRING;
+
+    File file(context_);
+    if (!file.Open(fileName, FILE_READ))
+        return EMPTY_STRING;
+
+    // Tool executable modification time is used as a version of the tool
+    ContentHasher hasher;
+    hasher.Append(ConversionCacheVersion);
+    hasher.Append(toolFileName);
+    hasher.Append(fs->GetLastModifiedTime(toolFileName, true));
+    hasher.Append(settings);
+    hasher.Append(file);
+
+    return Format("{}{}{}{}", project->GetAssetCachePath(), ConversionCacheFolder, hasher.ToString(), extension);
+}
+
+ModelImporter::GLTFFileHandle ModelImporter::StoreConvertedFile(
+    const ea::string& tempFileName, const ea::string& convertedFileName) const
+{
+    auto fs = context_->GetSubsystem<FileSystem>();
+
     const auto deleter = [fs](GLTFFileInfo* handle)
     {
         fs->Delete(handle->fileName_);
         delete handle;
     };
-    return ea::shared_ptr<GLTFFileInfo>(new GLTFFileInfo{tempGltfFile}, deleter);
+
+    if (convertedFileName.empty())
+        return ea::shared_ptr<GLTFFileInfo>(new GLTFFileInfo{tempFileName}, deleter);
+
+    // Copy to unique file first so other processes never see partially written file
+    const ea::string partialFileName = Format("{}.{}.tmp", convertedFileName, GenerateUUID());
+    fs->CreateDirsRecursive(GetPath(convertedFileName));
+    if (!fs->Copy(tempFileName, partialFileName) || !fs->Rename(partialFileName, convertedFileName))
+    {
+        fs->Delete(partialFileName);
+
+        // Another process may have stored the same file concurrently
+        if (fs->FileExists(convertedFileName))
+        {
+            fs->Delete(tempFileName);
+            return ea::make_shared<GLTFFileInfo>(GLTFFileInfo{convertedFileName});
+        }
+
+        URHO3D_LOGWARNING("Cannot store converted file {} in asset cache", convertedFileName);
+        return ea::shared_ptr<GLTFFileInfo>(new GLTFFileInfo{tempFileName}, deleter);
+    }
+
+    fs->Delete(tempFileName);
+    return ea::make_shared<GLTFFileInfo>(GLTFFileInfo{convertedFileName});
 }
 
 } // namespace Urho3D
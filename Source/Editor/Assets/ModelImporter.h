@@ -73,6 +73,7 @@ protected:
 
     /// Implement GLTFImporterCallback.
     /// @{
+    bool IsModelCallbackThreadSafe() const override { return true; }
     void OnModelLoaded(ModelView& modelView) override;
     void OnAnimationLoaded(Animation& animation) override;
     /// @}
@@ -93,8 +94,17 @@ private:
     /// Handler of GLTF file. Deletes temporary file on destruction.
     using GLTFFileHandle = ea::shared_ptr<const GLTFFileInfo>;
 
-    bool ImportGLTF(GLTFFileHandle fileHandle, const ModelMetadata& metadata, const AssetTransformerInput& input,
-        AssetTransformerOutput& output, const AssetTransformerVector& transformers);
+    /// Source model and its dependencies that can be reused for other flavors.
+    struct SharedSourceModel
+    {
+        GLTFImporter::SourceModelPtr model_;
+        StringVector dependencies_;
+    };
+
+    bool ImportGLTF(const ModelMetadata& metadata, const AssetTransformerInput& input, AssetTransformerOutput& output,
+        const AssetTransformerVector& transformers);
+    bool LoadSourceModel(GLTFImporter& importer, const ModelMetadata& metadata, const AssetTransformerInput& input,
+        StringVector& dependencies) const;
 
     ModelMetadata LoadMetadata(const ea::string& fileName) const;
     GLTFFileHandle LoadData(const ea::string& fileName, const ea::string& tempPath) const;
@@ -103,6 +113,13 @@ private:
     GLTFFileHandle LoadDataFromFBX(const ea::string& fileName, const ea::string& tempPath) const;
     GLTFFileHandle LoadDataFromBlend(const ea::string& fileName, const ea::string& tempPath) const;
 
+    /// Conversion cache for FBX2glTF and Blender outputs.
+    /// @{
+    ea::string GetConvertedFileName(const ea::string& fileName, const ea::string& toolFileName,
+        const ea::string& settings, const ea::string& extension) const;
+    GLTFFileHandle StoreConvertedFile(const ea::string& tempFileName, const ea::string& convertedFileName) const;
+    /// @}
+
     ToolManager* GetToolManager() const;
 
     GLTFImporterSettings settings_;
@@ -51,6 +51,12 @@ void CompositeEditorAction::Undo() const
         action->Undo();
 }
 
+void CompositeEditorAction::GetSnapshots(ea::vector<UndoSnapshot*>& snapshots) const
+{
+    for (const auto& action : actions_)
+        action->GetSnapshots(snapshots);
+}
+
 CreateRemoveNodeAction::CreateRemoveNodeAction(Node* node, bool removed)
     : removed_(removed)
     , scene_(node->GetScene())
@@ -509,16 +515,14 @@ bool ChangeNodeSubtreeAction::MergeWith(const EditorAction& other)
 }
 
 ChangeSceneAction::ChangeSceneAction(Scene* scene, const PackedSceneData& oldData)
-    : scene_(scene)
-    , oldData_(oldData)
+    : ChangeSceneAction(scene, oldData, PackedSceneData::FromScene(scene))
 {
-    newData_.FromScene(scene);
 }
 
 ChangeSceneAction::ChangeSceneAction(Scene* scene, const PackedSceneData& oldData, const PackedSceneData& newData)
     : scene_(scene)
-    , oldData_(oldData)
-    , newData_(newData)
+    , oldData_(MakeShared<UndoSnapshot>(scene->GetContext(), oldData.GetSceneData().GetBuffer()))
+    , newData_(MakeShared<UndoSnapshot>(newData.GetSceneData().GetBuffer(), oldData_))
 {
 }
 
@@ -529,17 +533,18 @@ bool ChangeSceneAction::CanUndoRedo() const
 
 void ChangeSceneAction::Redo() const
 {
-    UpdateScene(newData_);
+    UpdateScene(*newData_);
 }
 
 void ChangeSceneAction::Undo() const
 {
-    UpdateScene(oldData_);
+    UpdateScene(*oldData_);
 }
 
-void ChangeSceneAction::UpdateScene(const PackedSceneData& data) const
+void ChangeSceneAction::UpdateScene(const UndoSnapshot& data) const
 {
-    data.ToScene(scene_);
+    const PackedSceneData sceneData{data.GetData()};
+    sceneData.ToScene(scene_);
 }
 
 bool ChangeSceneAction::MergeWith(const EditorAction& other)
@@ -551,8 +556,15 @@ bool ChangeSceneAction::MergeWith(const EditorAction& other)
     if (scene_ != otherAction->scene_)
         return false;
 
-    newData_ = otherAction->newData_;
+    // Re-encode new state so the other action is not kept alive
+    newData_ = MakeShared<UndoSnapshot>(otherAction->newData_->GetData(), oldData_);
     return true;
 }
 
+void ChangeSceneAction::GetSnapshots(ea::vector<UndoSnapshot*>& snapshots) const
+{
+    snapshots.push_back(oldData_);
+    snapshots.push_back(newData_);
+}
+
 }
@@ -24,6 +24,7 @@
 
 #include "../Core/CommonEditorActionBuilders.h"
 #include "../Core/UndoManager.h"
+#include "../Core/UndoSnapshot.h"
 
 #include <Urho3D/Scene/Component.h>
 #include <Urho3D/Scene/Node.h>
@@ -64,6 +65,7 @@ public:
     bool CanUndo() const override;
     void Redo() const override;
     void Undo() const override;
+    void GetSnapshots(ea::vector<UndoSnapshot*>& snapshots) const override;
     /// @}
 
 private:
@@ -311,6 +313,7 @@ private:
 };
 
 /// Change entire scene.
+/// New state is stored as difference with the old state.
 class ChangeSceneAction : public EditorAction
 {
 public:
@@ -323,14 +326,15 @@ public:
     void Redo() const override;
     void Undo() const override;
     bool MergeWith(const EditorAction& other) override;
+    void GetSnapshots(ea::vector<UndoSnapshot*>& snapshots) const override;
     /// @}
 
 private:
-    void UpdateScene(const PackedSceneData& data) const;
+    void UpdateScene(const UndoSnapshot& data) const;
 
     const WeakPtr<Scene> scene_;
-    const PackedSceneData oldData_;
-    PackedSceneData newData_;
+    const SharedPtr<UndoSnapshot> oldData_;
+    SharedPtr<UndoSnapshot> newData_;
 };
 
 }
@@ -22,8 +22,12 @@
 
 #include "../Core/UndoManager.h"
 
+#include "../Core/UndoSnapshot.h"
+
 #include <Urho3D/Input/Input.h>
 #include <Urho3D/Input/InputEvents.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
 #include <Urho3D/SystemUI/SystemUI.h>
 
 #include <EASTL/bonus/adaptors.h>
@@ -90,6 +94,11 @@ bool BaseEditorActionWrapper::MergeWith(const EditorAction& other)
     return action_->MergeWith(*otherWrapper.action_);
 }
 
+void BaseEditorActionWrapper::GetSnapshots(ea::vector<UndoSnapshot*>& snapshots) const
+{
+    action_->GetSnapshots(snapshots);
+}
+
 bool UndoManager::ActionGroup::CanRedo() const
 {
     const auto canRedo = [](const EditorActionPtr& action) { return action->CanRedo(); };
@@ -133,6 +142,7 @@ EditorActionFrame UndoManager::PushAction(const EditorActionPtr& action)
     }
 
     group.actions_.push_back(action);
+    memoryBudgetDirty_ = true;
 
     CommitIncompleteAction(true);
     if (!action->IsComplete())
@@ -207,6 +217,28 @@ bool UndoManager::Redo()
     }
 }
 
+void UndoManager::SetSpillDirectory(const ea::string& directory)
+{
+    spillDirectory_ = directory;
+    memoryBudgetDirty_ = true;
+}
+
+void UndoManager::SetMemoryBudget(unsigned long long budget)
+{
+    memoryBudget_ = budget;
+    memoryBudgetDirty_ = true;
+}
+
+unsigned long long UndoManager::GetMemoryUse() const
+{
+    const ea::vector<UndoSnapshot*> snapshots = CollectSnapshots();
+
+    unsigned long long memoryUse = 0;
+    for (const UndoSnapshot* snapshot : snapshots)
+        memoryUse += snapshot->GetMemoryUse();
+    return memoryUse;
+}
+
 bool UndoManager::CanUndo() const
 {
     if (!canUndo_)
@@ -236,6 +268,9 @@ void UndoManager::Update()
 
     if (incompleteAction_ && NeedNewGroup() && incompleteActionTimer_.GetMSec(false) > actionCompletionTimeoutMs_)
         CommitIncompleteAction(false);
+
+    if (memoryBudgetDirty_ && !incompleteAction_)
+        ApplyMemoryBudget();
 }
 
 bool UndoManager::NeedNewGroup() const
@@ -255,4 +290,61 @@ void UndoManager::CommitIncompleteAction(bool force)
         URHO3D_LOGERROR("Incomplete action failed to complete when it was forced");
 }
 
+ea::vector<UndoSnapshot*> UndoManager::CollectSnapshots() const
+{
+    // Undo stack goes first from the oldest action, redo stack goes last from the farthest action
+    ea::vector<UndoSnapshot*> snapshots;
+    for (const ActionGroup& group : undoStack_)
+    {
+        for (const EditorActionPtr& action : group.actions_)
+            action->GetSnapshots(snapshots);
+    }
+    for (const ActionGroup& group : redoStack_)
+    {
+        for (const EditorActionPtr& action : group.actions_)
+            action->GetSnapshots(snapshots);
+    }
+    return snapshots;
+}
+
+void UndoManager::ApplyMemoryBudget()
+{
+    memoryBudgetDirty_ = false;
+    if (spillDirectory_.empty())
+        return;
+
+    const ea::vector<UndoSnapshot*> snapshots = CollectSnapshots();
+
+    unsigned long long memoryUse = 0;
+    for (const UndoSnapshot* snapshot : snapshots)
+        memoryUse += snapshot->GetMemoryUse();
+
+    if (memoryUse <= memoryBudget_)
+        return;
+
+    // Snapshots are moved to disk in order of the stack, the oldest first
+    auto fs = GetSubsystem<FileSystem>();
+    if (!fs->DirExists(spillDirectory_))
+        fs->CreateDirsRecursive(spillDirectory_);
+
+    for (UndoSnapshot* snapshot : snapshots)
+    {
+        if (memoryUse <= memoryBudget_)
+            break;
+
+        if (snapshot->IsSpilled())
+            continue;
+
+        const unsigned snapshotMemoryUse = snapshot->GetMemoryUse();
+        const ea::string fileName = Format("{}{}.bin", spillDirectory_, numSpilledSnapshots_++);
+        if (!snapshot->SpillToDisk(fileName))
+        {
+            URHO3D_LOGERROR("Cannot move undo snapshot to file '{}'", fileName);
+            return;
+        }
+
+        memoryUse -= ea::min(memoryUse, static_cast<unsigned long long>(snapshotMemoryUse));
+    }
+}
+
 }
@@ -32,6 +32,8 @@
 namespace Urho3D
 {
 
+class UndoSnapshot;
+
 /// Exception thrown when UndoManager stack is desynchronized with editor state.
 class UndoException : public RuntimeException
 {
@@ -70,6 +72,8 @@ public:
     virtual void Undo() const = 0;
     /// Try to merge this action with another. Return true if successfully merged.
     virtual bool MergeWith(const EditorAction& other) { return false; }
+    /// Return snapshots owned by the action. Snapshots may be moved to disk if undo stack is too large.
+    virtual void GetSnapshots(ea::vector<UndoSnapshot*>& snapshots) const {}
 };
 
 /// Base class for action wrappers.
@@ -90,6 +94,7 @@ public:
     bool CanUndo() const override;
     void Undo() const override;
     bool MergeWith(const EditorAction& other) override;
+    void GetSnapshots(ea::vector<UndoSnapshot*>& snapshots) const override;
     /// @}
 
 protected:
@@ -104,6 +109,9 @@ class UndoManager : public Object
     URHO3D_OBJECT(UndoManager, Object);
 
 public:
+    /// Default memory budget for undo snapshots.
+    static const unsigned long long DefaultMemoryBudget = 256 * 1024 * 1024;
+
     explicit UndoManager(Context* context);
 
     /// Force new frame. Call it on any resource save.
@@ -120,6 +128,14 @@ public:
     /// Return whether can redo.
     bool CanRedo() const;
 
+    /// Set directory where old snapshots are moved when memory budget is exceeded.
+    /// Snapshots are kept in memory if directory is empty.
+    void SetSpillDirectory(const ea::string& directory);
+    /// Set memory budget for snapshots in undo and redo stacks.
+    void SetMemoryBudget(unsigned long long budget);
+    /// Return memory used by snapshots in undo and redo stacks.
+    unsigned long long GetMemoryUse() const;
+
 private:
     struct ActionGroup
     {
@@ -134,6 +150,8 @@ private:
     void Update();
     bool NeedNewGroup() const;
     void CommitIncompleteAction(bool force);
+    ea::vector<UndoSnapshot*> CollectSnapshots() const;
+    void ApplyMemoryBudget();
 
     const unsigned actionCompletionTimeoutMs_{1000};
 
@@ -146,6 +164,11 @@ private:
 
     mutable ea::optional<bool> canUndo_;
     mutable ea::optional<bool> canRedo_;
+
+    ea::string spillDirectory_;
+    unsigned long long memoryBudget_{DefaultMemoryBudget};
+    unsigned numSpilledSnapshots_{};
+    bool memoryBudgetDirty_{};
 };
 
 }
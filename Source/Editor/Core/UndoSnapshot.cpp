@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Core/UndoSnapshot.h"
+
+#include "../Core/UndoManager.h"
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/IO/Compression.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+
+namespace Urho3D
+{
+
+UndoSnapshot::UndoSnapshot(Context* context, const ByteVector& data)
+    : context_(context)
+    , size_(data.size())
+{
+    Compress(data.data(), size_);
+}
+
+UndoSnapshot::UndoSnapshot(const ByteVector& data, UndoSnapshot* base)
+    : context_(base->GetContext())
+    , base_(base)
+    , size_(data.size())
+{
+    const ByteVector baseData = base_->GetData();
+    const unsigned maxSharedSize = ea::min(size_, baseData.size());
+
+    while (prefixSize_ < maxSharedSize && data[prefixSize_] == baseData[prefixSize_])
+        ++prefixSize_;
+    while (prefixSize_ + suffixSize_ < maxSharedSize
+        && data[size_ - suffixSize_ - 1] == baseData[baseData.size() - suffixSize_ - 1])
+        ++suffixSize_;
+
+    // Don't keep the base alive if nothing is shared
+    if (prefixSize_ == 0 && suffixSize_ == 0)
+        base_ = nullptr;
+
+    Compress(data.data() + prefixSize_, size_ - prefixSize_ - suffixSize_);
+}
+
+UndoSnapshot::~UndoSnapshot()
+{
+    if (IsSpilled())
+    {
+        auto fs = context_->GetSubsystem<FileSystem>();
+        fs->Delete(fileName_);
+    }
+}
+
+void UndoSnapshot::Compress(const unsigned char* data, unsigned size)
+{
+    compressedData_.resize(EstimateCompressBound(size));
+    compressedSize_ = size != 0 ? CompressData(compressedData_.data(), data, size) : 0;
+    compressedData_.resize(compressedSize_);
+    compressedData_.shrink_to_fit();
+}
+
+ByteVector UndoSnapshot::GetData() const
+{
+    ByteVector result(size_);
+
+    const unsigned decompressedSize = size_ - prefixSize_ - suffixSize_;
+    if (decompressedSize != 0)
+    {
+        if (IsSpilled())
+        {
+            const ByteVector compressedData = ReadCompressedData();
+            DecompressData(result.data() + prefixSize_, compressedData.data(), decompressedSize);
+        }
+        else
+            DecompressData(result.data() + prefixSize_, compressedData_.data(), decompressedSize);
+    }
+
+    if (base_)
+    {
+        const ByteVector baseData = base_->GetData();
+        ea::copy_n(baseData.begin(), prefixSize_, result.begin());
+        ea::copy_n(baseData.end() - suffixSize_, suffixSize_, result.end() - suffixSize_);
+    }
+
+    return result;
+}
+
+bool UndoSnapshot::SpillToDisk(const ea::string& fileName)
+{
+    if (IsSpilled())
+        return true;
+
+    File file(context_, fileName, FILE_WRITE);
+    if (!file.IsOpen() || file.Write(compressedData_.data(), compressedSize_) != compressedSize_)
+        return false;
+
+    fileName_ = fileName;
+    compressedData_.clear();
+    compressedData_.shrink_to_fit();
+    return true;
+}
+
+ByteVector UndoSnapshot::ReadCompressedData() const
+{
+    ByteVector result(compressedSize_);
+
+    File file(context_, fileName_, FILE_READ);
+    if (!file.IsOpen() || file.Read(result.data(), compressedSize_) != compressedSize_)
+        throw UndoException("Cannot read undo snapshot from file '{}'", fileName_);
+
+    return result;
+}
+
+}
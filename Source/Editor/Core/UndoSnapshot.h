@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include <Urho3D/Container/ByteVector.h>
+#include <Urho3D/Container/RefCounted.h>
+#include <Urho3D/Container/Ptr.h>
+
+#include <EASTL/string.h>
+
+namespace Urho3D
+{
+
+class Context;
+
+/// Binary state captured by undo action, e.g. serialized scene or resource.
+/// Data is compressed and may be stored as difference with the base snapshot.
+/// Compressed data may be moved to disk to keep memory usage of undo stack under control.
+class UndoSnapshot : public RefCounted
+{
+public:
+    /// Create snapshot from data.
+    UndoSnapshot(Context* context, const ByteVector& data);
+    /// Create snapshot from data, store only bytes that are different from the base snapshot.
+    UndoSnapshot(const ByteVector& data, UndoSnapshot* base);
+    ~UndoSnapshot() override;
+
+    /// Return uncompressed data. Data is read from disk if spilled.
+    ByteVector GetData() const;
+    /// Move compressed data to disk. Return true on success.
+    bool SpillToDisk(const ea::string& fileName);
+
+    /// Return context.
+    Context* GetContext() const { return context_; }
+    /// Return size of uncompressed data.
+    unsigned GetSize() const { return size_; }
+    /// Return memory used by the snapshot itself, base snapshot is not included.
+    unsigned GetMemoryUse() const { return compressedData_.size(); }
+    /// Return whether the data is stored on disk.
+    bool IsSpilled() const { return !fileName_.empty(); }
+
+private:
+    void Compress(const unsigned char* data, unsigned size);
+    ByteVector ReadCompressedData() const;
+
+    Context* context_{};
+    SharedPtr<UndoSnapshot> base_;
+
+    /// Size of uncompressed data.
+    unsigned size_{};
+    /// Number of leading and trailing bytes shared with the base snapshot.
+    /// @{
+    unsigned prefixSize_{};
+    unsigned suffixSize_{};
+    /// @}
+
+    unsigned compressedSize_{};
+    ByteVector compressedData_;
+    ea::string fileName_;
+};
+
+}
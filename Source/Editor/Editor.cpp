@@ -24,6 +24,7 @@
 
 #include "Assets/ModelImporter.h"
 #include "Foundation/AnimationViewTab.h"
+#include "Foundation/AssetCooking.h"
 #include "Foundation/ConsoleTab.h"
 #include "Foundation/ConcurrentAssetProcessing.h"
 #include "Foundation/GameViewTab.h"
@@ -101,6 +102,7 @@ Editor::Editor(Context* context)
 
     editorPluginManager_->AddPlugin("Foundation.StandardFileTypes", &Foundation_StandardFileTypes);
     editorPluginManager_->AddPlugin("Foundation.ConcurrentAssetProcessing", &Foundation_ConcurrentAssetProcessing);
+    editorPluginManager_->AddPlugin("Foundation.AssetCooking", &Foundation_AssetCooking);
 
     editorPluginManager_->AddPlugin("Foundation.GameView", &Foundation_GameViewTab);
     editorPluginManager_->AddPlugin("Foundation.SceneView", &Foundation_SceneViewTab);
@@ -193,6 +195,8 @@ void Editor::Setup()
     cmd.add_flag("--read-only", readOnly_, "Prevents Editor from modifying any project files, unless it is explicitly done via executed command.");
     cmd.add_option("--command", command_, "Command to execute on startup.")->type_name("command");
     cmd.add_flag("--exit", exitAfterCommand_, "Forces Editor to exit after command execution.");
+    cmd.add_option("--flavor", flavor_, "Flavor used to process assets. Non-empty flavor uses separate cache folder.")->type_name("flavor");
+    cmd.add_option("--asset-workers", maxAssetWorkers_, "Max number of asset worker processes. Number of logical CPUs is used by default.")->type_name("count");
     cmd.add_option("project", pendingOpenProject_, "Project to open or create on startup.")->type_name("dir");
 
     engineParameters_[EP_WINDOW_TITLE] = GetTypeName();
@@ -279,6 +283,9 @@ void Editor::Stop()
     auto workQueue = GetSubsystem<WorkQueue>();
     workQueue->CompleteAll();
 
+    if (project_ && project_->GetExitCode() != 0)
+        exitCode_ = project_->GetExitCode();
+
     CloseProject();
 
     context_->RemoveSubsystem<WorkQueue>(); // Prevents deadlock when unloading plugin AppDomain in managed host.
@@ -635,7 +642,10 @@ void Editor::UpdateProjectStatus()
         if (!isHeadless)
             InitializeUI();
 
-        project_ = MakeShared<Project>(context_, pendingOpenProject_, settingsJsonPath_, readOnly_);
+        ProjectParameters parameters;
+        parameters.flavor_ = ApplicationFlavor{flavor_};
+        parameters.maxAssetWorkers_ = maxAssetWorkers_;
+        project_ = MakeShared<Project>(context_, pendingOpenProject_, settingsJsonPath_, readOnly_, parameters);
         project_->OnShallowSaved.Subscribe(this, &Editor::SaveTempJson);
 
         recentProjects_.erase_first(pendingOpenProject_);
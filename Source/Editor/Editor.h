@@ -95,6 +95,10 @@ protected:
     ea::string command_;
     /// Whether to exit the editor after executing the command.
     bool exitAfterCommand_{};
+    /// Flavor used to process assets.
+    ea::string flavor_;
+    /// Max number of asset worker processes.
+    unsigned maxAssetWorkers_{};
 
     /// UI state
     /// @{
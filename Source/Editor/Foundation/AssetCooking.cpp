@@ -0,0 +1,152 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Foundation/AssetCooking.h"
+
+#include "../Project/AssetManager.h"
+#include "../Project/AssetProcessingProfiler.h"
+
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Resource/JSONFile.h>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const ea::string CookCommand = "CookAssets";
+
+struct CookingSummary
+{
+    unsigned numRecords_[4]{};
+    long long startTimeUs_{};
+    long long endTimeUs_{};
+    StringVector failedAssets_;
+
+    unsigned GetNumRecords(AssetProcessingResult result) const { return numRecords_[static_cast<unsigned>(result)]; }
+};
+
+CookingSummary SummarizeRecords(const ea::vector<AssetProcessingRecord>& records)
+{
+    CookingSummary summary;
+    for (const AssetProcessingRecord& record : records)
+    {
+        ++summary.numRecords_[static_cast<unsigned>(record.result_)];
+        if (record.result_ == AssetProcessingResult::Failed)
+            summary.failedAssets_.push_back(record.resourceName_);
+
+        const long long endTimeUs = record.startTimeUs_ + record.durationUs_;
+        if (summary.startTimeUs_ == 0 || record.startTimeUs_ < summary.startTimeUs_)
+            summary.startTimeUs_ = record.startTimeUs_;
+        summary.endTimeUs_ = ea::max(summary.endTimeUs_, endTimeUs);
+    }
+    return summary;
+}
+
+bool SaveReport(Context* context, const ea::string& fileName, const ApplicationFlavor& flavor,
+    const ea::vector<AssetProcessingRecord>& records, const CookingSummary& summary)
+{
+    JSONValue failedAssets{JSONValueType::JSON_ARRAY};
+    for (const ea::string& resourceName : summary.failedAssets_)
+        failedAssets.Push(resourceName);
+
+    JSONValue assets{JSONValueType::JSON_ARRAY};
+    for (const AssetProcessingRecord& record : records)
+    {
+        JSONValue asset;
+        asset.Set("resource", record.resourceName_);
+        asset.Set("result", ToString(record.result_));
+        asset.Set("durationMs", static_cast<double>(record.durationUs_) / 1000.0);
+        asset.Set("bytesRead", static_cast<double>(record.bytesRead_));
+        asset.Set("bytesWritten", static_cast<double>(record.bytesWritten_));
+        asset.Set("peakMemory", static_cast<double>(record.peakMemory_));
+        assets.Push(asset);
+    }
+
+    JSONFile file(context);
+    JSONValue& root = file.GetRoot();
+    root.Set("flavor", flavor.ToString());
+    root.Set("success", summary.failedAssets_.empty());
+    root.Set("durationMs", static_cast<double>(summary.endTimeUs_ - summary.startTimeUs_) / 1000.0);
+    root.Set("numProcessed", summary.GetNumRecords(AssetProcessingResult::Processed));
+    root.Set("numFailed", summary.GetNumRecords(AssetProcessingResult::Failed));
+    root.Set("numRestoredFromCache", summary.GetNumRecords(AssetProcessingResult::RestoredFromCache));
+    root.Set("numRestoredFromRemoteCache", summary.GetNumRecords(AssetProcessingResult::RestoredFromRemoteCache));
+    root.Set("failedAssets", failedAssets);
+    root.Set("assets", assets);
+
+    if (!file.SaveFile(fileName))
+    {
+        URHO3D_LOGERROR("Cannot save asset cooking report to {}", fileName);
+        return false;
+    }
+    return true;
+}
+
+void CookAssets(Project* project, const ea::string& reportFileName)
+{
+    auto context = project->GetContext();
+    auto fs = context->GetSubsystem<FileSystem>();
+    AssetManager* assetManager = project->GetAssetManager();
+
+    const ea::vector<AssetProcessingRecord>& records = assetManager->GetProfiler()->GetRecords();
+    const CookingSummary summary = SummarizeRecords(records);
+
+    URHO3D_LOGINFO("Assets are cooked: {} processed, {} failed, {} restored from cache, {} restored from remote cache",
+        summary.GetNumRecords(AssetProcessingResult::Processed), summary.GetNumRecords(AssetProcessingResult::Failed),
+        summary.GetNumRecords(AssetProcessingResult::RestoredFromCache),
+        summary.GetNumRecords(AssetProcessingResult::RestoredFromRemoteCache));
+    for (const ea::string& resourceName : summary.failedAssets_)
+        URHO3D_LOGERROR("Failed to cook asset {}", resourceName);
+
+    bool success = summary.failedAssets_.empty();
+    if (!reportFileName.empty())
+    {
+        const ea::string fileName =
+            IsAbsolutePath(reportFileName) ? reportFileName : fs->GetCurrentDir() + reportFileName;
+        if (!SaveReport(context, fileName, project->GetParameters().flavor_, records, summary))
+            success = false;
+    }
+
+    if (!success)
+        project->SetExitCode(EXIT_FAILURE);
+}
+
+}
+
+void Foundation_AssetCooking(Context* context, Project* project)
+{
+    project->OnCommand.Subscribe(project,
+        [=](const ea::string& command, const ea::string& args, bool& processed)
+    {
+        if (command != CookCommand)
+            return;
+
+        CookAssets(project, args);
+        processed = true;
+    });
+}
+
+}
@@ -23,9 +23,15 @@
 #include "../Foundation/ConcurrentAssetProcessing.h"
 
 #include "../Project/AssetManager.h"
+#include "../Project/AssetWorkerPool.h"
 
 #include <Urho3D/Core/ProcessUtils.h>
-#include <Urho3D/Resource/JSONFile.h>
+#include <Urho3D/IO/ArchiveSerialization.h>
+#include <Urho3D/IO/IOEvents.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Resource/ResourceCache.h>
 
 namespace Urho3D
 {
@@ -33,111 +39,104 @@ namespace Urho3D
 namespace
 {
 
-const ea::string commandName = "ProcessAsset";
-
-void RequestProcessAsset(Project* project, const AssetTransformerInput& input,
-    const AssetManager::OnProcessAssetCompleted& callback)
+/// Collects error messages logged during asset processing.
+class AssetWorkerLogCollector : public Object
 {
-    auto context = project->GetContext();
-    auto assetManager = project->GetAssetManager();
+    URHO3D_OBJECT(AssetWorkerLogCollector, Object);
 
-    auto tempDir = ea::make_shared<TemporaryDir>(project->CreateTemporaryDir());
+public:
+    explicit AssetWorkerLogCollector(Context* context)
+        : Object(context)
+    {
+        SubscribeToEvent(E_LOGMESSAGE, [this](VariantMap& eventData)
+        {
+            using namespace LogMessage;
+            if (!output_.empty())
+                output_ += "\n";
+            output_ += eventData[P_MESSAGE].GetString();
+        });
+    }
 
-    // Strip the base path to avoid having spaces in the path passed to the command
-    const ea::string projectPath = project->GetProjectPath();
-    const ea::string relativeTempPath = tempDir->GetPath().substr(projectPath.size());
+    const ea::string& GetOutput() const { return output_; }
 
-    const ea::string inputPath = relativeTempPath + "input.json";
-    const ea::string outputPath = relativeTempPath + "output.json";
+private:
+    ea::string output_;
+};
 
-    JSONFile inputFile(context);
-    if (!inputFile.SaveObject("input", input))
-    {
-        callback(input, ea::nullopt, "Cannot serialize input pipe");
-        return;
-    }
+/// Response message layout: bool success, string message, buffer output (if successful).
+ByteVector SerializeResponse(const ea::optional<AssetTransformerOutput>& output, const ea::string& message)
+{
+    VectorBuffer response;
+    response.WriteBool(output.has_value());
+    response.WriteString(message);
+    if (output)
+        response.WriteBuffer(output->ToBytes());
+    return response.GetBuffer();
+}
 
-    if (!inputFile.SaveFile(projectPath + inputPath))
+void RequestProcessAsset(AssetWorkerPool* workerPool, const AssetTransformerInput& input,
+    const AssetManager::OnProcessAssetCompleted& callback)
+{
+    const auto onCompleted = [=](const ea::optional<ByteVector>& response, const ea::string& message)
     {
-        callback(input, ea::nullopt, "Cannot save input pipe");
-        return;
-    }
+        if (!response)
+        {
+            callback(input, ea::nullopt, message);
+            return;
+        }
 
-    const ea::string command = Format("{} {} {}", commandName, inputPath, outputPath);
-    project->ExecuteRemoteCommandAsync(command,
-        [=, tempDir2 = tempDir](bool success, const ea::string& commandOutput)
-    {
+        MemoryBuffer responseBuffer(*response);
+        const bool success = responseBuffer.ReadBool();
+        const ea::string commandOutput = responseBuffer.ReadString();
         if (!success)
         {
             callback(input, ea::nullopt, commandOutput);
             return;
         }
 
-        JSONFile outputFile(context);
-        if (!outputFile.LoadFile(projectPath + outputPath))
+        try
         {
-            callback(input, ea::nullopt, "Cannot load output pipe");
-            return;
+            const AssetTransformerOutput output = AssetTransformerOutput::FromBytes(responseBuffer.ReadBuffer());
+            callback(input, output, commandOutput);
         }
-
-        AssetTransformerOutput output;
-        if (!outputFile.LoadObject("output", output))
+        catch (const ArchiveException& e)
         {
-            callback(input, ea::nullopt, "Cannot deserialize output pipe");
-            return;
+            callback(input, ea::nullopt, Format("Cannot deserialize output pipe: {}", e.what()));
         }
+    };
 
-        callback(input, output, commandOutput);
-    });
+    workerPool->QueueJob(input.ToBytes(), onCompleted);
 }
 
-bool ProcessAsset(Project* project, const ea::string& inputName, const ea::string& outputName)
+ByteVector ProcessAsset(Project* project, const ByteVector& request)
 {
     auto context = project->GetContext();
     auto assetManager = project->GetAssetManager();
 
-    const ea::string& projectPath = project->GetProjectPath();
-
-    JSONFile inputFile(context);
-    if (!inputFile.LoadFile(projectPath + inputName))
+    AssetTransformerInput input;
+    try
     {
-        URHO3D_LOGERROR("Cannot load input pipe");
-        return false;
+        input = AssetTransformerInput::FromBytes(request);
     }
-
-    AssetTransformerInput input;
-    if (!inputFile.LoadObject("input", input))
+    catch (const ArchiveException& e)
     {
-        URHO3D_LOGERROR("Cannot deserialize input pipe");
-        return false;
+        return SerializeResponse(ea::nullopt, Format("Cannot deserialize input pipe: {}", e.what()));
     }
 
-    bool success = false;
+    auto logCollector = MakeShared<AssetWorkerLogCollector>(context);
+
+    ea::optional<AssetTransformerOutput> result;
     assetManager->ProcessAsset(input,
-        [&](const AssetTransformerInput& input,
-            const ea::optional<AssetTransformerOutput>& output, const ea::string& error)
+        [&](const AssetTransformerInput& input, const ea::optional<AssetTransformerOutput>& output, const ea::string& error)
     {
         // Error should be logged by the asset manager
-        if (!output)
-            return;
-
-        JSONFile outputFile(project->GetContext());
-        if (!outputFile.SaveObject("output", *output))
-        {
-            URHO3D_LOGERROR("Cannot serialize output pipe");
-            return;
-        }
-
-        if (!outputFile.SaveFile(projectPath + outputName))
-        {
-            URHO3D_LOGERROR("Cannot save output pipe");
-            return;
-        }
-
-        success = true;
+        result = output;
     });
 
-    return success;
+    // Worker is long-lived, don't keep resources that may be changed by the next job
+    context->GetSubsystem<ResourceCache>()->ReleaseAllResources(false);
+
+    return SerializeResponse(result, logCollector->GetOutput());
 }
 
 }
@@ -145,25 +144,26 @@ bool ProcessAsset(Project* project, const ea::string& inputName, const ea::strin
 void Foundation_ConcurrentAssetProcessing(Context* context, Project* project)
 {
     auto assetManager = project->GetAssetManager();
+    const unsigned maxAssetWorkers = project->GetParameters().maxAssetWorkers_;
+    const unsigned maxWorkers = maxAssetWorkers != 0 ? maxAssetWorkers : GetNumLogicalCPUs();
+    auto workerPool = MakeShared<AssetWorkerPool>(context, project, maxWorkers);
 
     const auto requestProcessAsset = [=](
         const AssetTransformerInput& input, const AssetManager::OnProcessAssetCompleted& callback)
     {
-        RequestProcessAsset(project, input, callback);
+        RequestProcessAsset(workerPool, input, callback);
     };
 
-    assetManager->SetProcessCallback(requestProcessAsset, GetNumLogicalCPUs());
+    assetManager->SetProcessCallback(requestProcessAsset, workerPool->GetMaxWorkers());
     project->OnCommand.Subscribe(project,
         [=](const ea::string& command, const ea::string& args, bool& processed)
     {
         const StringVector argsVector = args.split(' ');
-        if (command != commandName || argsVector.size() != 2)
+        if (command != AssetWorkerPool::WorkerCommand || argsVector.size() != 1)
             return;
 
-        const ea::string& inputName = argsVector[0];
-        const ea::string& outputName = argsVector[1];
-
-        if (ProcessAsset(project, inputName, outputName))
+        const auto processJob = [=](const ByteVector& request) { return ProcessAsset(project, request); };
+        if (AssetWorkerPool::RunWorker(context, argsVector[0], processJob))
             processed = true;
     });
 }
@@ -22,7 +22,13 @@
 
 #include "../Foundation/ProfilerTab.h"
 
+#include "../Project/AssetManager.h"
+#include "../Project/AssetProcessingProfiler.h"
+
+#include <Urho3D/Core/FrameProfiler.h>
 #include <Urho3D/Core/Thread.h>
+#include <Urho3D/RenderAPI/GpuProfiler.h>
+#include <Urho3D/RenderAPI/RenderDevice.h>
 #include <Urho3D/SystemUI/SystemUI.h>
 
 // Use older version of font because Tracy uses it.
@@ -41,6 +47,8 @@ namespace Urho3D
 namespace
 {
 
+const unsigned maxSlowestAssets = 20;
+
 void QueueProfilerCallback(std::function<void()> callback, bool forceDelay)
 {
     if (auto context = Context::GetInstance())
@@ -103,6 +111,15 @@ void ProfilerTab::RenderContent()
             callback();
     }
 
+    if (ui::CollapsingHeader("Asset Processing"))
+        RenderAssetProcessingStats();
+
+    if (ui::CollapsingHeader("Frame Profiler"))
+        RenderFrameProfilerStats();
+
+    if (ui::CollapsingHeader("GPU Profiler"))
+        RenderGpuProfilerStats();
+
 #if URHO3D_PROFILING
     if (view_)
     {
@@ -128,4 +145,161 @@ void ProfilerTab::RenderContent()
 #endif
 }
 
+void ProfilerTab::RenderFrameProfilerStats()
+{
+    bool enabled = FrameProfiler::IsEnabled();
+    if (ui::Checkbox("Enabled", &enabled))
+        FrameProfiler::SetEnabled(enabled);
+    ui::SameLine();
+    if (ui::Button(ICON_FA_TRASH " Clear"))
+        FrameProfiler::ClearHistory();
+
+    if (ui::BeginTable("##FrameProfilerZones", 4, ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg))
+    {
+        ui::TableSetupColumn("Zone");
+        ui::TableSetupColumn("Count");
+        ui::TableSetupColumn("Total, ms");
+        ui::TableSetupColumn("Max, ms");
+        ui::TableHeadersRow();
+
+        for (const FrameProfilerZoneStats& zone : FrameProfiler::GetAverageStats())
+        {
+            ui::TableNextRow();
+
+            ui::TableNextColumn();
+            ui::Text("%s", zone.name_);
+
+            ui::TableNextColumn();
+            ui::Text("%.1f", zone.count_);
+
+            ui::TableNextColumn();
+            ui::Text("%.3f", zone.totalMs_);
+
+            ui::TableNextColumn();
+            ui::Text("%.3f", zone.maxMs_);
+        }
+        ui::EndTable();
+    }
+}
+
+void ProfilerTab::RenderGpuProfilerStats()
+{
+    auto renderDevice = GetSubsystem<RenderDevice>();
+    GpuProfiler* profiler = renderDevice ? renderDevice->GetGpuProfiler() : nullptr;
+    if (!profiler || !profiler->IsSupported())
+    {
+        ui::TextUnformatted("Timestamp queries are not supported by the device.");
+        return;
+    }
+
+    bool enabled = profiler->IsEnabled();
+    if (ui::Checkbox("Enabled", &enabled))
+        profiler->SetEnabled(enabled);
+    ui::SameLine();
+    ui::Text("Frame: %.3f ms", profiler->GetFrameTimeMs());
+
+    if (ui::BeginTable("##GpuProfilerZones", 2, ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg))
+    {
+        ui::TableSetupColumn("Zone");
+        ui::TableSetupColumn("Time, ms");
+        ui::TableHeadersRow();
+
+        for (const GpuProfilerZoneStats& zone : profiler->GetFrameStats())
+        {
+            ui::TableNextRow();
+
+            ui::TableNextColumn();
+            ui::Text("%*s%s", static_cast<int>(zone.depth_ * 2), "", zone.name_);
+
+            ui::TableNextColumn();
+            ui::Text("%.3f", zone.durationMs_);
+        }
+        ui::EndTable();
+    }
+}
+
+void ProfilerTab::RenderAssetProcessingStats()
+{
+    Project* project = GetProject();
+    AssetProcessingProfiler* profiler = project->GetAssetManager()->GetProfiler();
+
+    ui::Text("%u assets, %u restored from cache, %u processed", static_cast<unsigned>(profiler->GetRecords().size()),
+        profiler->GetNumCacheHits(), profiler->GetNumCacheMisses());
+
+    if (ui::Button(ICON_FA_FILE_EXPORT " Export Chrome Trace"))
+        profiler->SaveChromeTrace(project->GetArtifactsPath() + "AssetProcessingTrace.json");
+    ui::SameLine();
+    if (ui::Button(ICON_FA_TRASH " Clear"))
+        profiler->Clear();
+
+    if (ui::BeginTable("##Transformers", 5, ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg))
+    {
+        ui::TableSetupColumn("Transformer");
+        ui::TableSetupColumn("Executions");
+        ui::TableSetupColumn("Total, ms");
+        ui::TableSetupColumn("Max, ms");
+        ui::TableSetupColumn("Slowest Asset");
+        ui::TableHeadersRow();
+
+        for (const AssetTransformerSummary& summary : profiler->GetTransformerSummary())
+        {
+            ui::TableNextRow();
+
+            ui::TableNextColumn();
+            ui::Text("%s", summary.type_.c_str());
+
+            ui::TableNextColumn();
+            ui::Text("%u", summary.numExecutions_);
+
+            ui::TableNextColumn();
+            ui::Text("%.1f", summary.totalDurationUs_ / 1000.0);
+
+            ui::TableNextColumn();
+            ui::Text("%.1f", summary.maxDurationUs_ / 1000.0);
+
+            ui::TableNextColumn();
+            ui::Text("%s", summary.slowestResourceName_.c_str());
+        }
+        ui::EndTable();
+    }
+
+    if (ui::BeginTable("##SlowestAssets", 6, ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg))
+    {
+        ui::TableSetupColumn("Asset");
+        ui::TableSetupColumn("Result");
+        ui::TableSetupColumn("Time, ms");
+        ui::TableSetupColumn("Read, KB");
+        ui::TableSetupColumn("Written, KB");
+        ui::TableSetupColumn("Peak Memory, MB");
+        ui::TableHeadersRow();
+
+        const auto& records = profiler->GetRecords();
+        for (unsigned index : profiler->GetSlowestRecords(maxSlowestAssets))
+        {
+            const AssetProcessingRecord& record = records[index];
+
+            ui::TableNextRow();
+
+            ui::TableNextColumn();
+            ui::Text("%s", record.resourceName_.c_str());
+
+            ui::TableNextColumn();
+            ui::Text("%s", ToString(record.result_));
+
+            ui::TableNextColumn();
+            ui::Text("%.1f", record.durationUs_ / 1000.0);
+
+            ui::TableNextColumn();
+            ui::Text("%.1f", record.bytesRead_ / 1024.0);
+
+            ui::TableNextColumn();
+            ui::Text("%.1f", record.bytesWritten_ / 1024.0);
+
+            ui::TableNextColumn();
+            ui::Text("%.1f", record.peakMemory_ / (1024.0 * 1024.0));
+        }
+        ui::EndTable();
+    }
+}
+
 }
@@ -52,6 +52,10 @@ public:
     /// @}
 
 private:
+    void RenderAssetProcessingStats();
+    void RenderFrameProfilerStats();
+    void RenderGpuProfilerStats();
+
     ea::string connectTo_{"127.0.0.1"};
     int port_{8086};
 
@@ -23,6 +23,7 @@
 #include "../Core/IniHelpers.h"
 #include "../Foundation/ResourceBrowserTab.h"
 
+#include <Urho3D/Graphics/Texture2D.h>
 #include <Urho3D/IO/FileSystem.h>
 
 #include <EASTL/sort.h>
@@ -511,19 +512,93 @@ void ResourceBrowserTab::RenderDirectoryContent()
     if (!entry->resourceName_.empty())
         RenderDirectoryUp(*entry);
 
-    for (const FileSystemEntry& childEntry : entry->children_)
+    if (right_.rowsDirty_ || right_.rowsDirectory_ != entry)
+        UpdateContentRows(*entry);
+
+    // Only visible rows are rendered, the list is rebuilt when the content changes
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(right_.rows_.size()));
+    if (right_.scrollToSelection_)
     {
-        if (!childEntry.isFile_)
-            RenderDirectoryContentEntry(childEntry);
+        const auto iter = ea::find_if(right_.rows_.begin(), right_.rows_.end(),
+            [this](const ContentRow& row) { return IsRightSelected(row.entry_->resourceName_); });
+        if (iter != right_.rows_.end())
+        {
+            const int index = static_cast<int>(iter - right_.rows_.begin());
+            clipper.ForceDisplayRangeByIndices(index, index + 1);
+        }
     }
 
-    for (const FileSystemEntry& childEntry : entry->children_)
+    while (clipper.Step())
     {
-        if (childEntry.isFile_)
-            RenderDirectoryContentEntry(childEntry);
+        for (int index = clipper.DisplayStart; index < clipper.DisplayEnd; ++index)
+        {
+            const ContentRow row = right_.rows_[index];
+            if (row.owner_)
+            {
+                ui::Indent();
+                RenderCompositeFileEntry(*row.entry_, *row.owner_);
+                ui::Unindent();
+            }
+            else
+                RenderDirectoryContentEntry(*row.entry_);
+        }
+    }
+}
+
+void ResourceBrowserTab::UpdateContentRows(const FileSystemEntry& directoryEntry)
+{
+    const auto project = GetProject();
+    const ResourceRoot& root = roots_[left_.selectedRoot_];
+
+    right_.rows_.clear();
+    right_.rowsDirectory_ = &directoryEntry;
+    right_.rowsDirty_ = false;
+
+    // Directories go first
+    for (const FileSystemEntry& childEntry : directoryEntry.children_)
+    {
+        if (!childEntry.isFile_ && !project->IsFileNameIgnored(childEntry.localName_))
+            right_.rows_.push_back(ContentRow{&childEntry});
+    }
+
+    for (const FileSystemEntry& childEntry : directoryEntry.children_)
+    {
+        if (!childEntry.isFile_ || project->IsFileNameIgnored(childEntry.localName_))
+            continue;
+
+        right_.rows_.push_back(ContentRow{&childEntry});
+
+        const bool isCompositeFile = root.supportCompositeFiles_ && childEntry.isDirectory_;
+        if (!isCompositeFile || !IsCompositeFileOpen(childEntry))
+            continue;
+
+        tempEntryList_.clear();
+        childEntry.ForEach([&](const FileSystemEntry& nestedEntry)
+        {
+            if (&nestedEntry != &childEntry && nestedEntry.isFile_ && !project->IsFileNameIgnored(nestedEntry.localName_))
+                tempEntryList_.push_back(&nestedEntry);
+        });
+
+        const auto compare = [](const FileSystemEntry* lhs, const FileSystemEntry* rhs)
+        {
+            return FileSystemEntry::CompareFilesFirst(*lhs, *rhs);
+        };
+        ea::sort(tempEntryList_.begin(), tempEntryList_.end(), compare);
+
+        for (const FileSystemEntry* nestedEntry : tempEntryList_)
+            right_.rows_.push_back(ContentRow{nestedEntry, &childEntry});
     }
 }
 
+bool ResourceBrowserTab::IsCompositeFileOpen(const FileSystemEntry& entry) const
+{
+    // Should match ID of the tree node in RenderDirectoryContentEntry, composite files are open by default
+    const IdScopeGuard guard(entry.localName_.c_str());
+    const ea::string name = Format("{} {}", GetEntryIcon(entry), entry.localName_);
+    return ui::GetStateStorage()->GetInt(ui::GetID(name.c_str()), 1) != 0;
+}
+
 void ResourceBrowserTab::RenderDirectoryUp(const FileSystemEntry& entry)
 {
     const IdScopeGuard guard("..");
@@ -582,10 +657,13 @@ void ResourceBrowserTab::RenderDirectoryContentEntry(const FileSystemEntry& entr
         | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_SpanFullWidth;
     if (isSelected)
         flags |= ImGuiTreeNodeFlags_Selected;
-    flags |= isCompositeFile ? ImGuiTreeNodeFlags_DefaultOpen : ImGuiTreeNodeFlags_Leaf;
+    // Composite file content is rendered as separate rows
+    flags |= isCompositeFile ? ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_NoTreePushOnOpen : ImGuiTreeNodeFlags_Leaf;
 
     const ea::string name = Format("{} {}", GetEntryIcon(entry), entry.localName_);
     const bool isOpen = ui::TreeNodeEx(name.c_str(), flags);
+    if (isCompositeFile && ui::IsItemToggledOpen())
+        right_.rowsDirty_ = true;
     const bool isContextMenuOpen = ui::IsItemClicked(MOUSEB_RIGHT);
     const bool toggleSelection = ui::IsKeyDown(KEY_LCTRL) || ui::IsKeyDown(KEY_RCTRL);
 
@@ -622,6 +700,10 @@ void ResourceBrowserTab::RenderDirectoryContentEntry(const FileSystemEntry& entr
         }
     }
 
+    // Render thumbnail of hovered file if it is ready, it is generated in background otherwise
+    if (isNormalFile && ui::IsItemHovered() && !ui::IsMouseDragPastThreshold(MOUSEB_LEFT))
+        RenderEntryThumbnail(entry);
+
     // Process drag&drop from this element
     if (ui::BeginDragDropSource())
     {
@@ -643,13 +725,8 @@ void ResourceBrowserTab::RenderDirectoryContentEntry(const FileSystemEntry& entr
         ui::EndDragDropTarget();
     }
 
-    // Render children if any
-    if (isOpen)
-    {
-        if (isCompositeFile)
-            RenderCompositeFile(entry);
+    if (isOpen && !isCompositeFile)
         ui::TreePop();
-    }
 
     if (isContextMenuOpen)
         ui::OpenPopup(contextMenuId.c_str());
@@ -658,23 +735,15 @@ void ResourceBrowserTab::RenderDirectoryContentEntry(const FileSystemEntry& entr
     RenderEntryContextMenu(entry);
 }
 
-void ResourceBrowserTab::RenderCompositeFile(const FileSystemEntry& entry)
+void ResourceBrowserTab::RenderEntryThumbnail(const FileSystemEntry& entry)
 {
-    tempEntryList_.clear();
-    entry.ForEach([&](const FileSystemEntry& childEntry)
-    {
-        if (&childEntry != &entry && childEntry.isFile_)
-            tempEntryList_.push_back(&childEntry);
-    });
-
-    const auto compare = [](const FileSystemEntry* lhs, const FileSystemEntry* rhs)
+    ThumbnailManager* thumbnailManager = GetProject()->GetThumbnailManager();
+    if (Texture2D* thumbnail = thumbnailManager->GetThumbnail(entry.resourceName_))
     {
-        return FileSystemEntry::CompareFilesFirst(*lhs, *rhs);
-    };
-    ea::sort(tempEntryList_.begin(), tempEntryList_.end(), compare);
-
-    for (const FileSystemEntry* childEntry : tempEntryList_)
-        RenderCompositeFileEntry(*childEntry, entry);
+        ui::BeginTooltip();
+        ui::Image(thumbnail, ToImGui(thumbnail->GetSize().ToVector2()));
+        ui::EndTooltip();
+    }
 }
 
 void ResourceBrowserTab::RenderCompositeFileEntry(const FileSystemEntry& entry, const FileSystemEntry& ownerEntry)
@@ -1218,6 +1287,7 @@ void ResourceBrowserTab::BeginEntryCreate(const FileSystemEntry& entry, Resource
 
 void ResourceBrowserTab::RefreshContents()
 {
+    right_.rowsDirty_ = true;
     ScrollToSelection();
     waitingForUpdate_ = false;
 }
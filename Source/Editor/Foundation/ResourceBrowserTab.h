@@ -120,7 +120,6 @@ private:
     void RenderDirectoryContent();
     void RenderDirectoryUp(const FileSystemEntry& entry);
     void RenderDirectoryContentEntry(const FileSystemEntry& entry);
-    void RenderCompositeFile(const FileSystemEntry& entry);
     void RenderCompositeFileEntry(const FileSystemEntry& entry, const FileSystemEntry& ownerEntry);
     void RenderCreateButton(const FileSystemEntry& entry);
     /// @}
@@ -130,6 +129,7 @@ private:
     void RenderDialogs();
 
     void RenderEntryContextMenu(const FileSystemEntry& entry);
+    void RenderEntryThumbnail(const FileSystemEntry& entry);
     void RenderEntryContextMenuItems(const FileSystemEntry& entry);
     ea::optional<unsigned> RenderEntryCreateContextMenu(const FileSystemEntry& entry);
 
@@ -151,6 +151,8 @@ private:
 
     /// Utility functions
     /// @{
+    void UpdateContentRows(const FileSystemEntry& directoryEntry);
+    bool IsCompositeFileOpen(const FileSystemEntry& entry) const;
     ea::string GetEntryIcon(const FileSystemEntry& entry) const;
     unsigned GetRootIndex(const FileSystemEntry& entry) const;
     const ResourceRoot& GetRoot(const FileSystemEntry& entry) const;
@@ -214,12 +216,24 @@ private:
         bool scrollToSelection_{};
     } left_;
 
+    struct ContentRow
+    {
+        const FileSystemEntry* entry_{};
+        /// Composite file that contains the entry, if any.
+        const FileSystemEntry* owner_{};
+    };
+
     struct RightPanel
     {
         ea::string lastSelectedPath_;
         ea::unordered_set<ea::string> selectedPaths_;
 
         bool scrollToSelection_{};
+
+        /// Flattened content of the directory, only visible rows are rendered.
+        ea::vector<ContentRow> rows_;
+        const FileSystemEntry* rowsDirectory_{};
+        bool rowsDirty_{true};
     } right_;
 
     struct CursorForHotkeys
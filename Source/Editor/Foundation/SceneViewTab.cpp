@@ -1166,22 +1166,65 @@ void SceneViewTab::LoadPageConfig(SceneViewPage& page) const
     }
 }
 
-void SceneViewTab::BeginPluginReload()
+void SceneViewTab::BeginPluginReload(VariantMap& eventData)
 {
+    using namespace BeginPluginReload;
+
+    // On partial reload, only components of reloaded types are removed and the rest of the scene is kept alive
+    const bool partial = eventData[P_PARTIAL].GetBool();
+    const auto pluginManager = GetSubsystem<PluginManager>();
+    const auto& reloadingTypes = pluginManager->GetReloadingTypes();
+
     for (const auto& [_, page] : scenes_)
     {
-        page->archivedScene_ = PackedSceneData::FromScene(page->scene_);
         page->archivedSelection_ = page->selection_.Pack();
-        page->scene_->Clear();
+        if (!partial)
+        {
+            page->archivedScene_ = PackedSceneData::FromScene(page->scene_);
+            page->scene_->Clear();
+            continue;
+        }
+
+        ea::vector<Node*> nodes;
+        page->scene_->GetChildren(nodes, true);
+        nodes.push_back(page->scene_);
+
+        ea::vector<Component*> components;
+        for (Node* node : nodes)
+        {
+            for (Component* component : node->GetComponents())
+            {
+                if (reloadingTypes.contains(component->GetType()))
+                    components.push_back(component);
+            }
+        }
+
+        page->archivedComponents_.clear();
+        for (Component* component : components)
+            page->archivedComponents_.emplace_back(component);
+        for (Component* component : components)
+            component->Remove();
     }
 }
 
-void SceneViewTab::EndPluginReload()
+void SceneViewTab::EndPluginReload(VariantMap& eventData)
 {
+    using namespace EndPluginReload;
+
+    const bool partial = eventData[P_PARTIAL].GetBool();
     for (const auto& [_, page] : scenes_)
     {
-        page->scene_->Clear();
-        page->archivedScene_.ToScene(page->scene_);
+        if (partial)
+        {
+            for (const PackedComponentData& componentData : page->archivedComponents_)
+                componentData.SpawnExact(page->scene_);
+            page->archivedComponents_.clear();
+        }
+        else
+        {
+            page->scene_->Clear();
+            page->archivedScene_.ToScene(page->scene_);
+        }
         page->selection_.Load(page->scene_, page->archivedSelection_);
     }
 }
@@ -1320,4 +1363,15 @@ ea::vector<RayQueryResult> QueryGeometriesFromScene(Scene* scene, const Ray& ray
     return results;
 }
 
+ea::optional<RayQueryResult> QueryClosestGeometryFromScene(Scene* scene, const Ray& ray, RayQueryLevel level, float maxDistance, unsigned viewMask)
+{
+    ea::vector<RayQueryResult> results;
+    RayOctreeQuery query(results, ray, level, maxDistance, DRAWABLE_GEOMETRY, viewMask);
+    if (auto octree = scene->GetComponent<Octree>())
+        octree->RaycastSingle(query);
+    if (results.empty())
+        return ea::nullopt;
+    return results.front();
+}
+
 }
@@ -35,6 +35,7 @@
 #include <Urho3D/Utility/PackedSceneData.h>
 
 #include <EASTL/any.h>
+#include <EASTL/optional.h>
 #include <EASTL/vector_multiset.h>
 
 namespace Urho3D
@@ -86,6 +87,7 @@ public:
     Ray cameraRay_;
 
     PackedSceneData archivedScene_;
+    ea::vector<PackedComponentData> archivedComponents_;
     PackedSceneSelection archivedSelection_;
 
     /// UI state
@@ -292,8 +294,8 @@ private:
     bool UpdateDropToScene();
     void InspectSelection(SceneViewPage& page);
 
-    void BeginPluginReload();
-    void EndPluginReload();
+    void BeginPluginReload(VariantMap& eventData);
+    void EndPluginReload(VariantMap& eventData);
 
     ea::vector<SharedPtr<SceneViewAddon>> addons_;
     AddonSetByInputPriority addonsByInputPriority_;
@@ -382,6 +384,10 @@ private:
 /// Helper function to query geometries from a scene.
 ea::vector<RayQueryResult> QueryGeometriesFromScene(Scene* scene, const Ray& ray,
     RayQueryLevel level = RAY_TRIANGLE, float maxDistance = M_INFINITY, unsigned viewMask = DEFAULT_VIEWMASK);
+/// Helper function to query the closest geometry from a scene.
+/// Cheaper than QueryGeometriesFromScene because drawables behind the closest hit are not tested.
+ea::optional<RayQueryResult> QueryClosestGeometryFromScene(Scene* scene, const Ray& ray,
+    RayQueryLevel level = RAY_TRIANGLE, float maxDistance = M_INFINITY, unsigned viewMask = DEFAULT_VIEWMASK);
 
 template <class T, class ... Args>
 SceneViewAddon* SceneViewTab::RegisterAddon(const Args&... args)
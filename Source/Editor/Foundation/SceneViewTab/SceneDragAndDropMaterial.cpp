@@ -143,11 +143,12 @@ void SceneDragAndDropMaterial::CreateAssignment(Drawable* drawable, unsigned mat
 
 ea::pair<Drawable*, unsigned> SceneDragAndDropMaterial::QueryHoveredGeometry(Scene* scene, const Ray& cameraRay)
 {
-    const auto results = QueryGeometriesFromScene(scene, cameraRay);
+    // Only the closest geometry is needed, it's queried every frame while dragging
+    const auto result = QueryClosestGeometryFromScene(scene, cameraRay);
 
-    if (!results.empty())
+    if (result)
     {
-        Drawable* drawable = results[0].drawable_;
+        Drawable* drawable = result->drawable_;
         const Variant& material = drawable->GetAttribute(MaterialAttr);
 
         if (material.GetType() == VAR_RESOURCEREF)
@@ -156,7 +157,7 @@ ea::pair<Drawable*, unsigned> SceneDragAndDropMaterial::QueryHoveredGeometry(Sce
         {
             // TODO: This is a hack
             const unsigned numMaterials = material.GetResourceRefList().names_.size();
-            const unsigned materialIndex = ea::min(results[0].subObject_, ea::max(numMaterials, 1u) - 1u);
+            const unsigned materialIndex = ea::min(result->subObject_, ea::max(numMaterials, 1u) - 1u);
             return {drawable, materialIndex};
         }
     }
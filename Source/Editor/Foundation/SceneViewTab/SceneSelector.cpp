@@ -59,8 +59,14 @@ void SceneSelector::ProcessInput(SceneViewPage& scenePage, bool& mouseConsumed)
 
 Drawable* SceneSelector::QuerySelectedDrawable(Scene* scene, const Ray& cameraRay, RayQueryLevel level) const
 {
-    const auto results = QueryGeometriesFromScene(scene, cameraRay);
-
+    // Closest hit is usually enough, it doesn't test triangles of all drawables along the ray
+    const auto closestResult = QueryClosestGeometryFromScene(scene, cameraRay, level);
+    if (!closestResult)
+        return nullptr;
+    if (closestResult->drawable_->GetScene() != nullptr)
+        return closestResult->drawable_;
+
+    const auto results = QueryGeometriesFromScene(scene, cameraRay, level);
     for (const RayQueryResult& result : results)
     {
         if (result.drawable_->GetScene() != nullptr)
@@ -0,0 +1,531 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Project/AssetCache.h"
+
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/ArchiveSerialization.h>
+#include <Urho3D/IO/BinaryArchive.h>
+#include <Urho3D/IO/ContentHash.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#ifdef URHO3D_NETWORK
+    #include <Urho3D/Network/HttpRequest.h>
+#endif
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const ea::string entryFileName = "Entry.bin";
+const ea::string entryFilesFolder = "Files/";
+
+/// Version of the packed entry format used by remote storage.
+const unsigned packedEntryVersion = 1;
+
+struct PackedEntry
+{
+    unsigned version_{};
+    ea::string key_;
+    ByteVector entry_;
+    ea::unordered_map<ea::string, ByteVector> files_;
+
+    void SerializeInBlock(Archive& archive)
+    {
+        SerializeValue(archive, "version", version_);
+        SerializeValue(archive, "key", key_);
+        SerializeValue(archive, "entry", entry_);
+        SerializeValue(archive, "files", files_);
+    }
+};
+
+bool ReadFileContent(Context* context, const ea::string& fileName, ByteVector& content)
+{
+    File file(context);
+    if (!file.Open(fileName, FILE_READ))
+        return false;
+
+    content.resize(file.GetSize());
+    return file.Read(content.data(), content.size()) == content.size();
+}
+
+bool WriteFileContent(Context* context, const ea::string& fileName, const ByteVector& content)
+{
+    File file(context);
+    if (!file.Open(fileName, FILE_WRITE))
+        return false;
+
+    return file.Write(content.data(), content.size()) == content.size();
+}
+
+/// Remote storage on the network file share. Each entry is stored as single file.
+class FolderRemoteStorage : public RemoteAssetCacheStorage
+{
+public:
+    FolderRemoteStorage(Context* context, const ea::string& path)
+        : context_(context)
+        , path_(AddTrailingSlash(path))
+    {
+    }
+
+    ea::optional<ByteVector> Fetch(const ea::string& key) override
+    {
+        ByteVector data;
+        if (!ReadFileContent(context_, GetEntryFileName(key), data))
+            return ea::nullopt;
+        return data;
+    }
+
+    bool Publish(const ea::string& key, const ByteVector& data) override
+    {
+        auto fs = context_->GetSubsystem<FileSystem>();
+
+        // Entries are content-addressed, existing entry is always up to date
+        const ea::string entryFileName = GetEntryFileName(key);
+        if (fs->FileExists(entryFileName))
+            return true;
+
+        // Write to temporary file first so other clients never see incomplete entries
+        const ea::string tempFileName = Format("{}.{}.tmp", entryFileName, GenerateUUID());
+        fs->CreateDirsRecursive(GetPath(entryFileName));
+        if (!WriteFileContent(context_, tempFileName, data) || !fs->Rename(tempFileName, entryFileName))
+        {
+            fs->Delete(tempFileName);
+            return fs->FileExists(entryFileName);
+        }
+        return true;
+    }
+
+private:
+    ea::string GetEntryFileName(const ea::string& key) const
+    {
+        return Format("{}{}/{}.bin", path_, key.substr(0, 2), key);
+    }
+
+    Context* const context_{};
+    const ea::string path_;
+};
+
+#ifdef URHO3D_NETWORK
+/// Remote storage on the plain HTTP server that supports GET and PUT.
+/// Entries are transferred as Base64 text because HttpRequest doesn't support binary request bodies.
+class HttpRemoteStorage : public RemoteAssetCacheStorage
+{
+public:
+    explicit HttpRemoteStorage(const ea::string& url)
+        : url_(url.ends_with("/") ? url : url + "/")
+    {
+    }
+
+    ea::optional<ByteVector> Fetch(const ea::string& key) override
+    {
+        const auto request = MakeShared<HttpRequest>(GetEntryUrl(key), "GET", StringVector{}, EMPTY_STRING);
+        if (!WaitForRequest(*request))
+            return ea::nullopt;
+
+        ea::string body;
+        body.resize(request->GetAvailableSize());
+        if (!body.empty())
+            request->Read(body.data(), body.size());
+
+        // Error pages are rejected later when the entry is unpacked
+        ByteVector data = DecodeBase64(body);
+        if (data.empty())
+            return ea::nullopt;
+        return data;
+    }
+
+    bool Publish(const ea::string& key, const ByteVector& data) override
+    {
+        const auto request = MakeShared<HttpRequest>(GetEntryUrl(key), "PUT",
+            StringVector{"Content-Type: text/plain"}, EncodeBase64(data));
+        return WaitForRequest(*request);
+    }
+
+private:
+    static const unsigned RequestTimeoutMs = 30000;
+
+    ea::string GetEntryUrl(const ea::string& key) const { return Format("{}{}/{}", url_, key.substr(0, 2), key); }
+
+    static bool WaitForRequest(const HttpRequest& request)
+    {
+        Timer timer;
+        while (timer.GetMSec(false) < RequestTimeoutMs)
+        {
+            switch (request.GetState())
+            {
+            case HTTP_CLOSED:
+                return true;
+            case HTTP_ERROR:
+                return false;
+            default:
+                Time::Sleep(1);
+                break;
+            }
+        }
+        return false;
+    }
+
+    const ea::string url_;
+};
+#endif
+
+}
+
+void RemoteAssetCacheSettings::SerializeInBlock(Archive& archive)
+{
+    SerializeOptionalValue(archive, "Location", location_);
+    SerializeOptionalValue(archive, "Publish", publish_);
+}
+
+void AssetCache::EntryDesc::SerializeInBlock(Archive& archive)
+{
+    SerializeValue(archive, "output", output_);
+    SerializeValue(archive, "dependencyHashes", dependencyHashes_);
+}
+
+AssetCache::AssetCache(Context* context, const ea::string& dataPath, const ea::string& outputPath,
+    const ea::string& storagePath)
+    : Object(context)
+    , dataPath_(dataPath)
+    , outputPath_(outputPath)
+    , storagePath_(storagePath)
+{
+}
+
+AssetCache::~AssetCache()
+{
+    // Let pending uploads finish, downloads are discarded
+    for (std::future<bool>& publish : pendingPublishes_)
+        publish.wait();
+}
+
+ea::string AssetCache::GetKey(const AssetTransformerInput& input, const AssetTransformerVector& transformers) const
+{
+    File file(context_);
+    if (!file.Open(input.inputFileName_, FILE_READ))
+        return EMPTY_STRING;
+
+    ContentHasher hasher;
+    hasher.Append(EntryVersion);
+    hasher.Append(input.flavor_.ToString());
+    hasher.Append(input.resourceName_);
+    hasher.Append(file);
+
+    for (AssetTransformer* transformer : transformers)
+    {
+        VectorBuffer attributes;
+        transformer->Save(attributes);
+
+        hasher.Append(transformer->GetTypeName());
+        hasher.Append(attributes.GetData(), attributes.GetSize());
+    }
+
+    return hasher.ToString();
+}
+
+ea::optional<AssetTransformerOutput> AssetCache::Restore(const ea::string& key) const
+{
+    auto fs = GetSubsystem<FileSystem>();
+
+    const ea::string entryPath = GetEntryPath(key);
+    if (!fs->FileExists(entryPath + entryFileName))
+        return ea::nullopt;
+
+    EntryDesc entry;
+    try
+    {
+        File file(context_, entryPath + entryFileName, FILE_READ);
+        BinaryInputArchive archive(context_, file);
+        SerializeValue(archive, "entry", entry);
+    }
+    catch (const ArchiveException& e)
+    {
+        URHO3D_LOGWARNING("Cannot read asset cache entry {}: {}", key, e.what());
+        return ea::nullopt;
+    }
+
+    // Check that dependencies are not changed and sync modification times with the actual files
+    AssetTransformerOutput& output = entry.output_;
+    for (auto& [dependencyResourceName, modificationTime] : output.dependencyModificationTimes_)
+    {
+        const auto iter = entry.dependencyHashes_.find(dependencyResourceName);
+        const ea::string dependencyFileName = dataPath_ + dependencyResourceName;
+        if (iter == entry.dependencyHashes_.end() || iter->second != GetFileHash(dependencyFileName))
+            return ea::nullopt;
+
+        modificationTime = fs->GetLastModifiedTime(dependencyFileName, true);
+    }
+
+    for (const ea::string& outputResourceName : output.outputResourceNames_)
+    {
+        const ea::string sourceFileName = entryPath + entryFilesFolder + outputResourceName;
+        const ea::string outputFileName = outputPath_ + outputResourceName;
+
+        fs->CreateDirsRecursive(GetPath(outputFileName));
+        if (!fs->Copy(sourceFileName, outputFileName))
+        {
+            URHO3D_LOGWARNING("Cannot restore file {} from asset cache entry {}", outputResourceName, key);
+            return ea::nullopt;
+        }
+    }
+
+    return output;
+}
+
+bool AssetCache::Store(const ea::string& key, const AssetTransformerOutput& output) const
+{
+    auto fs = GetSubsystem<FileSystem>();
+
+    // Assets that modify their own sources cannot be restored safely
+    if (key.empty() || output.sourceModified_)
+        return false;
+
+    const ea::string entryPath = GetEntryPath(key);
+    fs->RemoveDir(entryPath, true);
+
+    EntryDesc entry;
+    entry.output_ = output;
+    for (const auto& [dependencyResourceName, _] : output.dependencyModificationTimes_)
+    {
+        const ea::string dependencyHash = GetFileHash(dataPath_ + dependencyResourceName);
+        if (dependencyHash.empty())
+            return false;
+        entry.dependencyHashes_[dependencyResourceName] = dependencyHash;
+    }
+
+    for (const ea::string& outputResourceName : output.outputResourceNames_)
+    {
+        const ea::string targetFileName = entryPath + entryFilesFolder + outputResourceName;
+        fs->CreateDirsRecursive(GetPath(targetFileName));
+        if (!fs->Copy(outputPath_ + outputResourceName, targetFileName))
+        {
+            fs->RemoveDir(entryPath, true);
+            return false;
+        }
+    }
+
+    // Write entry file last so incomplete entries are never used
+    try
+    {
+        File file(context_, entryPath + entryFileName, FILE_WRITE);
+        BinaryOutputArchive archive(context_, file);
+        SerializeValue(archive, "entry", entry);
+        return true;
+    }
+    catch (const ArchiveException& e)
+    {
+        URHO3D_LOGWARNING("Cannot write asset cache entry {}: {}", key, e.what());
+        fs->RemoveDir(entryPath, true);
+        return false;
+    }
+}
+
+void AssetCache::SetRemoteStorage(const RemoteAssetCacheSettings& settings)
+{
+    const ea::string location = settings.location_.trimmed();
+
+    remoteStorage_ = nullptr;
+    publishRemote_ = false;
+    if (location.empty())
+        return;
+
+    if (location.starts_with("http://") || location.starts_with("https://"))
+    {
+#ifdef URHO3D_NETWORK
+        remoteStorage_ = ea::make_shared<HttpRemoteStorage>(location);
+#else
+        URHO3D_LOGERROR("Cannot use remote asset cache {}: network support is disabled", location);
+        return;
+#endif
+    }
+    else
+    {
+        remoteStorage_ = ea::make_shared<FolderRemoteStorage>(context_, location);
+    }
+
+    publishRemote_ = settings.publish_;
+    URHO3D_LOGINFO("Remote asset cache {} is used{}", location, publishRemote_ ? " for download and upload" : "");
+}
+
+void AssetCache::FetchRemote(const ea::string& key, const ea::function<void(bool success)>& callback)
+{
+    if (!remoteStorage_)
+    {
+        callback(false);
+        return;
+    }
+
+    PendingFetch& fetch = pendingFetches_.emplace_back();
+    fetch.key_ = key;
+    fetch.callback_ = callback;
+    fetch.result_ = std::async(std::launch::async, [remoteStorage = remoteStorage_, key] { return remoteStorage->Fetch(key); });
+}
+
+void AssetCache::PublishRemote(const ea::string& key)
+{
+    if (!remoteStorage_ || !publishRemote_)
+        return;
+
+    auto data = PackEntry(key);
+    if (!data)
+        return;
+
+    pendingPublishes_.push_back(std::async(std::launch::async,
+        [remoteStorage = remoteStorage_, key, data = ea::move(*data)]
+    {
+        const bool success = remoteStorage->Publish(key, data);
+        if (!success)
+            URHO3D_LOGWARNING("Cannot upload asset cache entry {}", key);
+        return success;
+    }));
+}
+
+void AssetCache::Update()
+{
+    const auto isReady = [](const auto& future) { return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; };
+
+    ea::erase_if(pendingPublishes_, isReady);
+
+    // Callbacks may start new fetches, so take ready ones out first
+    ea::vector<PendingFetch> completedFetches;
+    for (PendingFetch& fetch : pendingFetches_)
+    {
+        if (isReady(fetch.result_))
+            completedFetches.push_back(ea::move(fetch));
+    }
+    ea::erase_if(pendingFetches_, [](const PendingFetch& fetch) { return !fetch.result_.valid(); });
+
+    for (PendingFetch& fetch : completedFetches)
+    {
+        const ea::optional<ByteVector> data = fetch.result_.get();
+        fetch.callback_(data && UnpackEntry(fetch.key_, *data));
+    }
+}
+
+ea::optional<ByteVector> AssetCache::PackEntry(const ea::string& key) const
+{
+    const ea::string entryPath = GetEntryPath(key);
+
+    PackedEntry packedEntry;
+    packedEntry.version_ = packedEntryVersion;
+    packedEntry.key_ = key;
+    if (!ReadFileContent(context_, entryPath + entryFileName, packedEntry.entry_))
+        return ea::nullopt;
+
+    EntryDesc entry;
+    try
+    {
+        MemoryBuffer entryBuffer(packedEntry.entry_);
+        BinaryInputArchive archive(context_, entryBuffer);
+        SerializeValue(archive, "entry", entry);
+
+        for (const ea::string& outputResourceName : entry.output_.outputResourceNames_)
+        {
+            ByteVector& content = packedEntry.files_[outputResourceName];
+            if (!ReadFileContent(context_, entryPath + entryFilesFolder + outputResourceName, content))
+                return ea::nullopt;
+        }
+
+        VectorBuffer buffer;
+        BinaryOutputArchive packedArchive(context_, buffer);
+        SerializeValue(packedArchive, "packedEntry", packedEntry);
+        return buffer.GetBuffer();
+    }
+    catch (const ArchiveException& e)
+    {
+        URHO3D_LOGWARNING("Cannot pack asset cache entry {}: {}", key, e.what());
+        return ea::nullopt;
+    }
+}
+
+bool AssetCache::UnpackEntry(const ea::string& key, const ByteVector& data) const
+{
+    auto fs = GetSubsystem<FileSystem>();
+
+    PackedEntry packedEntry;
+    try
+    {
+        MemoryBuffer buffer(data);
+        BinaryInputArchive archive(context_, buffer);
+        SerializeValue(archive, "packedEntry", packedEntry);
+    }
+    catch (const ArchiveException& e)
+    {
+        URHO3D_LOGWARNING("Cannot unpack asset cache entry {}: {}", key, e.what());
+        return false;
+    }
+
+    if (packedEntry.version_ != packedEntryVersion || packedEntry.key_ != key)
+        return false;
+
+    const ea::string entryPath = GetEntryPath(key);
+    fs->RemoveDir(entryPath, true);
+
+    for (const auto& [outputResourceName, content] : packedEntry.files_)
+    {
+        const ea::string targetFileName = entryPath + entryFilesFolder + outputResourceName;
+        fs->CreateDirsRecursive(GetPath(targetFileName));
+        if (!WriteFileContent(context_, targetFileName, content))
+        {
+            fs->RemoveDir(entryPath, true);
+            return false;
+        }
+    }
+
+    // Write entry file last so incomplete entries are never used
+    if (!WriteFileContent(context_, entryPath + entryFileName, packedEntry.entry_))
+    {
+        fs->RemoveDir(entryPath, true);
+        return false;
+    }
+    return true;
+}
+
+ea::string AssetCache::GetEntryPath(const ea::string& key) const
+{
+    return Format("{}{}/{}/", storagePath_, key.substr(0, 2), key);
+}
+
+ea::string AssetCache::GetFileHash(const ea::string& fileName) const
+{
+    auto fs = GetSubsystem<FileSystem>();
+    if (!fs->FileExists(fileName))
+        return EMPTY_STRING;
+
+    File file(context_);
+    if (!file.Open(fileName, FILE_READ))
+        return EMPTY_STRING;
+
+    ContentHasher hasher;
+    hasher.Append(file);
+    return hasher.ToString();
+}
+
+}
@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include <Urho3D/Container/ByteVector.h>
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/Utility/AssetTransformer.h>
+
+#include <EASTL/functional.h>
+#include <EASTL/optional.h>
+#include <EASTL/shared_ptr.h>
+
+#include <future>
+
+namespace Urho3D
+{
+
+/// Settings of the asset cache shared between team members and CI agents.
+struct RemoteAssetCacheSettings
+{
+    /// URL of HTTP endpoint (http:// or https://) or path to a network file share. Empty to disable.
+    ea::string location_;
+    /// Whether to upload locally processed assets to the remote cache.
+    bool publish_{};
+
+    void SerializeInBlock(Archive& archive);
+    bool operator==(const RemoteAssetCacheSettings& rhs) const
+    {
+        return location_ == rhs.location_ && publish_ == rhs.publish_;
+    }
+};
+
+/// Remote storage of packed asset cache entries. Methods are called from worker threads.
+class RemoteAssetCacheStorage
+{
+public:
+    virtual ~RemoteAssetCacheStorage() = default;
+
+    /// Download packed entry. Return nothing if the entry is missing or cannot be downloaded.
+    virtual ea::optional<ByteVector> Fetch(const ea::string& key) = 0;
+    /// Upload packed entry.
+    virtual bool Publish(const ea::string& key, const ByteVector& data) = 0;
+};
+
+/// Content-addressed cache of asset processing results.
+/// Entry key is the hash of the asset contents, transformer settings and flavor,
+/// so the asset can be restored without processing after checkout, branch switch or clean clone.
+class AssetCache : public Object
+{
+    URHO3D_OBJECT(AssetCache, Object);
+
+public:
+    AssetCache(Context* context, const ea::string& dataPath, const ea::string& outputPath,
+        const ea::string& storagePath);
+    ~AssetCache() override;
+
+    /// Return key of the asset processed by specified transformers. Return empty string if asset cannot be read.
+    ea::string GetKey(const AssetTransformerInput& input, const AssetTransformerVector& transformers) const;
+    /// Restore outputs of the asset into output path. Return nothing if the entry is missing or outdated.
+    ea::optional<AssetTransformerOutput> Restore(const ea::string& key) const;
+    /// Store outputs of the processed asset.
+    bool Store(const ea::string& key, const AssetTransformerOutput& output) const;
+
+    /// Remote cache
+    /// @{
+    void SetRemoteStorage(const RemoteAssetCacheSettings& settings);
+    bool HasRemoteStorage() const { return remoteStorage_ != nullptr; }
+    /// Download remote entry into local storage. Callback is invoked from Update.
+    void FetchRemote(const ea::string& key, const ea::function<void(bool success)>& callback);
+    /// Upload local entry to remote storage in background, if publishing is enabled.
+    void PublishRemote(const ea::string& key);
+    /// Complete pending remote operations.
+    void Update();
+    /// @}
+
+    /// Pack local entry into single blob. Return nothing if the entry is missing.
+    ea::optional<ByteVector> PackEntry(const ea::string& key) const;
+    /// Unpack blob into local entry.
+    bool UnpackEntry(const ea::string& key, const ByteVector& data) const;
+
+private:
+    /// Version of the entry format. Increment to invalidate all entries.
+    static const unsigned EntryVersion = 2;
+
+    struct EntryDesc
+    {
+        AssetTransformerOutput output_;
+        ea::unordered_map<ea::string, ea::string> dependencyHashes_;
+
+        void SerializeInBlock(Archive& archive);
+    };
+
+    struct PendingFetch
+    {
+        ea::string key_;
+        std::future<ea::optional<ByteVector>> result_;
+        ea::function<void(bool success)> callback_;
+    };
+
+    ea::string GetEntryPath(const ea::string& key) const;
+    ea::string GetFileHash(const ea::string& fileName) const;
+
+    const ea::string dataPath_;
+    const ea::string outputPath_;
+    const ea::string storagePath_;
+
+    ea::shared_ptr<RemoteAssetCacheStorage> remoteStorage_;
+    bool publishRemote_{};
+    ea::vector<PendingFetch> pendingFetches_;
+    ea::vector<std::future<bool>> pendingPublishes_;
+};
+
+}
@@ -21,18 +21,71 @@
 //
 
 #include "../Project/AssetManager.h"
+
+#include "../Project/AssetCache.h"
+#include "../Project/AssetProcessingProfiler.h"
+#include "../Project/FileIndex.h"
 #include "../Project/Project.h"
 
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/IO/ArchiveSerialization.h>
+#include <Urho3D/IO/BinaryArchive.h>
+#include <Urho3D/IO/File.h>
 #include <Urho3D/IO/Log.h>
 #include <Urho3D/Resource/JSONArchive.h>
 #include <Urho3D/Resource/JSONFile.h>
 
+#include <EASTL/algorithm.h>
 #include <EASTL/sort.h>
 
 namespace Urho3D
 {
 
+namespace
+{
+
+/// Sort paths and remove ones that are nested in other paths.
+StringVector CompressPaths(StringVector paths)
+{
+    ea::sort(paths.begin(), paths.end());
+
+    StringVector result;
+    for (const ea::string& path : paths)
+    {
+        if (!result.empty())
+        {
+            const ea::string& parentPath = result.back();
+            if (parentPath.empty() || path == parentPath || path.starts_with(AddTrailingSlash(parentPath)))
+                continue;
+        }
+        result.push_back(path);
+    }
+    return result;
+}
+
+unsigned GetFileSize(Context* context, const ea::string& fileName)
+{
+    File file(context);
+    return file.Open(fileName, FILE_READ) ? file.GetSize() : 0;
+}
+
+ea::string GetFileIndexFileName(const ea::string& cacheFileName)
+{
+    return GetPath(cacheFileName) + GetFileName(cacheFileName) + "Index.bin";
+}
+
+ea::string GetAssetSnapshotFileName(const ea::string& cacheFileName)
+{
+    return GetPath(cacheFileName) + GetFileName(cacheFileName) + "Assets.bin";
+}
+
+ea::string GetAssetJournalFileName(const ea::string& cacheFileName)
+{
+    return GetPath(cacheFileName) + GetFileName(cacheFileName) + "Journal.bin";
+}
+
+}
+
 void AssetManager::AssetDesc::SerializeInBlock(Archive& archive)
 {
     SerializeOptionalValue(archive, "outputs", outputs_);
@@ -41,6 +94,33 @@ void AssetManager::AssetDesc::SerializeInBlock(Archive& archive)
     SerializeOptionalValue(archive, "dependencyModificationTimes", dependencyModificationTimes_);
 }
 
+void AssetManager::AssetSchedulingHint::SerializeInBlock(Archive& archive)
+{
+    SerializeOptionalValue(archive, "processingTime", processingTimeMs_);
+    SerializeOptionalValue(archive, "dependencies", dependencies_);
+}
+
+void AssetManager::AssetJournalEntry::SerializeInBlock(Archive& archive)
+{
+    SerializeValue(archive, "resourceName", resourceName_);
+    SerializeValue(archive, "hasAsset", hasAsset_);
+    if (hasAsset_)
+        SerializeValue(archive, "asset", asset_);
+    SerializeValue(archive, "hasSchedulingHint", hasSchedulingHint_);
+    if (hasSchedulingHint_)
+        SerializeValue(archive, "schedulingHint", schedulingHint_);
+}
+
+void AssetManager::AssetJournalBatch::SerializeInBlock(Archive& archive)
+{
+    unsigned version = DatabaseVersion;
+    SerializeValue(archive, "version", version);
+    if (version != DatabaseVersion)
+        throw ArchiveException("Unsupported asset journal version {}", version);
+
+    SerializeValue(archive, "entries", entries_);
+}
+
 bool AssetManager::AssetDesc::IsAnyTransformerUsed(const StringVector& transformers) const
 {
     for (const ea::string& transformer : transformers)
@@ -62,6 +142,11 @@ AssetManager::AssetManager(Context* context)
     : Object(context)
     , project_(GetSubsystem<Project>())
     , dataWatcher_(MakeShared<FileWatcher>(context))
+    , assetCache_(MakeShared<AssetCache>(
+          context, project_->GetDataPath(), project_->GetCachePath(), project_->GetAssetCachePath()))
+    , profiler_(MakeShared<AssetProcessingProfiler>(context))
+    , fileIndex_(MakeShared<FileIndex>(context, project_->GetDataPath()))
+    , defaultFlavor_(project_->GetParameters().flavor_)
     , transformerHierarchy_(MakeShared<AssetTransformerHierarchy>(context_))
 {
     dataWatcher_->StartWatching(project_->GetDataPath(), true);
@@ -83,12 +168,28 @@ void AssetManager::SetProcessCallback(const OnProcessAssetQueued& callback, unsi
     maxConcurrentRequests_ = ea::max(maxConcurrency, 1u);
 }
 
+void AssetManager::SetRemoteCache(const RemoteAssetCacheSettings& settings)
+{
+    assetCache_->SetRemoteStorage(settings);
+}
+
 void AssetManager::Initialize(bool readOnly)
 {
     autoProcessAssets_ = !readOnly;
 
     InitializeAssetPipelines();
-    InvalidateOutdatedAssetsInPath("");
+
+    // Check only changed files if the index is available
+    FileIndexChanges changes;
+    fileIndex_->UpdatePath("", changes);
+    if (fileIndexLoaded_)
+        ApplyFileIndexChanges(changes);
+    else
+    {
+        InvalidateOutdatedAssetsInPath("");
+        pathsToScan_.push_back("");
+        cleanupWholeCacheFolder_ = true;
+    }
 
     if (autoProcessAssets_)
     {
@@ -105,6 +206,8 @@ void AssetManager::Initialize(bool readOnly)
 
 void AssetManager::Update()
 {
+    assetCache_->Update();
+
     if (!requestQueue_.empty() || numOngoingRequests_ != 0)
     {
         if (!requestQueue_.empty() && numOngoingRequests_ < maxConcurrentRequests_)
@@ -130,25 +233,216 @@ void AssetManager::Update()
     }
 }
 
+void AssetManager::ScheduleAssetQueue()
+{
+    requestQueueScheduled_ = true;
+
+    ea::unordered_map<ea::string, unsigned> requestIndices;
+    for (unsigned index = 0; index < requestQueue_.size(); ++index)
+        requestIndices[requestQueue_[index].input_.resourceName_] = index;
+
+    // Build graph of queued assets using dependencies from the previous processing
+    ea::vector<unsigned> processingTimes(requestQueue_.size());
+    ea::vector<ea::vector<unsigned>> dependents(requestQueue_.size());
+    for (unsigned index = 0; index < requestQueue_.size(); ++index)
+    {
+        QueuedRequest& request = requestQueue_[index];
+        request.dependencies_.clear();
+
+        const auto hintIter = schedulingHints_.find(request.input_.resourceName_);
+        if (hintIter == schedulingHints_.end())
+        {
+            processingTimes[index] = EstimateProcessingTime(request.input_);
+            continue;
+        }
+
+        processingTimes[index] = hintIter->second.processingTimeMs_;
+        for (const ea::string& dependencyResourceName : hintIter->second.dependencies_)
+        {
+            const auto dependencyIter = requestIndices.find(dependencyResourceName);
+            if (dependencyIter != requestIndices.end() && dependencyIter->second != index)
+            {
+                request.dependencies_.push_back(dependencyResourceName);
+                dependents[dependencyIter->second].push_back(index);
+            }
+        }
+    }
+
+    // Critical path is the longest chain of dependent assets starting from the asset.
+    // Dependency cycles are broken arbitrarily.
+    enum class VisitState { NotVisited, Visiting, Visited };
+    ea::vector<VisitState> visitStates(requestQueue_.size(), VisitState::NotVisited);
+    const auto evaluateCriticalPath = [&](unsigned index, const auto& self) -> unsigned
+    {
+        QueuedRequest& request = requestQueue_[index];
+        if (visitStates[index] != VisitState::NotVisited)
+            return visitStates[index] == VisitState::Visited ? request.criticalPathMs_ : 0;
+
+        visitStates[index] = VisitState::Visiting;
+        unsigned longestDependentPathMs = 0;
+        for (unsigned dependentIndex : dependents[index])
+            longestDependentPathMs = ea::max(longestDependentPathMs, self(dependentIndex, self));
+
+        visitStates[index] = VisitState::Visited;
+        request.criticalPathMs_ = processingTimes[index] + longestDependentPathMs;
+        return request.criticalPathMs_;
+    };
+
+    for (unsigned index = 0; index < requestQueue_.size(); ++index)
+        evaluateCriticalPath(index, evaluateCriticalPath);
+
+    ea::stable_sort(requestQueue_.begin(), requestQueue_.end(),
+        [](const QueuedRequest& lhs, const QueuedRequest& rhs) { return lhs.criticalPathMs_ < rhs.criticalPathMs_; });
+}
+
+unsigned AssetManager::EstimateProcessingTime(const AssetTransformerInput& input) const
+{
+    File file(context_);
+    if (!file.Open(input.inputFileName_, FILE_READ))
+        return 0;
+
+    const unsigned sizeInKilobytes = file.GetSize() / 1024;
+    return ea::max(1u, sizeInKilobytes * EstimatedProcessingTimeMsPerMegabyte / 1024);
+}
+
+ea::vector<AssetManager::QueuedRequest>::iterator AssetManager::FindReadyRequest()
+{
+    ea::unordered_set<ea::string> queuedResourceNames;
+    for (const QueuedRequest& request : requestQueue_)
+        queuedResourceNames.insert(request.input_.resourceName_);
+
+    const auto isPending = [&](const ea::string& resourceName)
+    { return queuedResourceNames.contains(resourceName) || ongoingRequests_.contains(resourceName); };
+
+    for (auto iter = requestQueue_.rbegin(); iter != requestQueue_.rend(); ++iter)
+    {
+        if (ea::none_of(iter->dependencies_.begin(), iter->dependencies_.end(), isPending))
+            return ea::prev(iter.base());
+    }
+
+    // Dependency cycle, just pick the longest request
+    if (ongoingRequests_.empty() && !requestQueue_.empty())
+        return ea::prev(requestQueue_.end());
+
+    return requestQueue_.end();
+}
+
 void AssetManager::ConsumeAssetQueue()
 {
+    if (!requestQueueScheduled_)
+        ScheduleAssetQueue();
+
+    Timer cacheRestoreTimer;
+
     ea::vector<AssetTransformerInput> queue;
     while (!requestQueue_.empty() && numOngoingRequests_ < maxConcurrentRequests_)
     {
+        const auto requestIter = FindReadyRequest();
+        if (requestIter == requestQueue_.end())
+            break;
+
         ++numOngoingRequests_;
         ++progress_.second;
-        queue.push_back(requestQueue_.back());
-        requestQueue_.pop_back();
+        const AssetTransformerInput input = ea::move(requestIter->input_);
+        requestQueue_.erase(requestIter);
+        ongoingRequests_[input.resourceName_].startTimeUs_ = Time::GetTimeSinceEpochUs();
+
+        // Cached assets are completed immediately and don't occupy processing slots
+        if (cacheRestoreTimer.GetMSec(false) < CacheRestoreBudgetMs && RestoreAssetFromCache(input))
+            continue;
+
+        queue.push_back(input);
     }
 
     for (const AssetTransformerInput& input : queue)
     {
-        processCallback_(input,
-            [this](const AssetTransformerInput& input, const ea::optional<AssetTransformerOutput>& output, const ea::string& message)
+        const auto cacheKeyIter = ongoingRequestCacheKeys_.find(input.resourceName_);
+        if (!assetCache_->HasRemoteStorage() || cacheKeyIter == ongoingRequestCacheKeys_.end())
+        {
+            DispatchAssetProcessing(input);
+            continue;
+        }
+
+        // Try the remote cache before processing the asset locally
+        const ea::string cacheKey = cacheKeyIter->second;
+        assetCache_->FetchRemote(cacheKey, [this, input, cacheKey](bool success)
+        {
+            if (const auto output = success ? assetCache_->Restore(cacheKey) : ea::nullopt)
+            {
+                URHO3D_LOGDEBUG("Asset {} was restored from remote cache", input.resourceName_);
+                ongoingRequestCacheKeys_.erase(input.resourceName_);
+                ongoingRequests_[input.resourceName_].restoredFromRemoteCache_ = true;
+                CompleteAssetProcessing(input, output, EMPTY_STRING);
+                return;
+            }
+
+            DispatchAssetProcessing(input);
+        });
+    }
+}
+
+void AssetManager::DispatchAssetProcessing(const AssetTransformerInput& input)
+{
+    OngoingRequest& request = ongoingRequests_[input.resourceName_];
+    request.timer_.Reset();
+    request.dispatched_ = true;
+
+    // Thread-safe transformers don't need process isolation
+    const AssetTransformerVector transformers = transformerHierarchy_->GetTransformerCandidates(
+        input.resourceName_, input.flavor_);
+    if (AssetTransformer::IsThreadSafe(transformers))
+    {
+        ProcessAssetInWorkerThread(input, transformers);
+        return;
+    }
+
+    processCallback_(input,
+        [this](const AssetTransformerInput& input, const ea::optional<AssetTransformerOutput>& output, const ea::string& message)
+    {
+        CompleteAssetProcessing(input, output, message);
+    });
+}
+
+void AssetManager::ProcessAssetInWorkerThread(
+    const AssetTransformerInput& input, const AssetTransformerVector& transformers)
+{
+    auto workQueue = GetSubsystem<WorkQueue>();
+
+    // Keep transformers alive in case the pipeline is reloaded during execution
+    const ea::vector<SharedPtr<AssetTransformer>> transformerRefs{transformers.begin(), transformers.end()};
+    workQueue->PostTask([=, weakSelf = WeakPtr<AssetManager>(this), cachePath = project_->GetCachePath()]
+    {
+        const AssetTransformerVector threadTransformers{transformerRefs.begin(), transformerRefs.end()};
+
+        AssetTransformerOutput output;
+        const bool success = AssetTransformer::ExecuteTransformersAndStore(input, cachePath, output, threadTransformers);
+
+        workQueue->PostTaskForMainThread([=]
         {
-            CompleteAssetProcessing(input, output, message);
+            if (weakSelf)
+                weakSelf->CompleteAssetProcessing(input, success ? ea::make_optional(output) : ea::nullopt, EMPTY_STRING);
         });
+    });
+}
+
+bool AssetManager::RestoreAssetFromCache(const AssetTransformerInput& input)
+{
+    const AssetTransformerVector transformers = transformerHierarchy_->GetTransformerCandidates(
+        input.resourceName_, input.flavor_);
+
+    const ea::string cacheKey = assetCache_->GetKey(input, transformers);
+    if (cacheKey.empty())
+        return false;
+
+    if (const auto output = assetCache_->Restore(cacheKey))
+    {
+        URHO3D_LOGDEBUG("Asset {} was restored from cache", input.resourceName_);
+        CompleteAssetProcessing(input, output, EMPTY_STRING);
+        return true;
     }
+
+    ongoingRequestCacheKeys_[input.resourceName_] = cacheKey;
+    return false;
 }
 
 void AssetManager::MarkCacheDirty(const ea::string& resourcePath)
@@ -165,8 +459,11 @@ void AssetManager::ProcessFileSystemUpdates()
     if (!pathUpdates.empty())
     {
         UpdateAssetPipelines();
+
+        FileIndexChanges changes;
         for (const ea::string& updatedPath : pathUpdates)
-            InvalidateOutdatedAssetsInPath(updatedPath);
+            fileIndex_->UpdatePath(updatedPath, changes);
+        ApplyFileIndexChanges(changes);
     }
 }
 
@@ -187,7 +484,9 @@ void AssetManager::ScanAndQueueAssetProcessing()
         return;
 
     Stats stats;
-    ScanAssetsInPath("", stats);
+    for (const ea::string& resourcePath : CompressPaths(ea::move(pathsToScan_)))
+        ScanAssetsInPath(resourcePath, stats);
+    pathsToScan_.clear();
 
     URHO3D_LOGINFO("Assets scanned: {} processed, {} up-to-date, {} ignored",
         stats.numProcessedAssets_, stats.numUpToDateAssets_, stats.numIgnoredAssets_);
@@ -199,6 +498,7 @@ void AssetManager::SerializeInBlock(Archive& archive)
 {
     SerializeOptionalValue(archive, "Assets", assets_);
     SerializeOptionalValue(archive, "AssetPipelineModificationTimes", assetPipelineFiles_);
+    SerializeOptionalValue(archive, "SchedulingHints", schedulingHints_);
 
     if (archive.IsInput())
     {
@@ -209,16 +509,196 @@ void AssetManager::SerializeInBlock(Archive& archive)
 
 void AssetManager::LoadFile(const ea::string& fileName)
 {
+    auto fs = GetSubsystem<FileSystem>();
+
+    const ea::string snapshotFileName = GetAssetSnapshotFileName(fileName);
+    if (fs->FileExists(snapshotFileName))
+    {
+        if (LoadSnapshot(snapshotFileName))
+        {
+            LoadJournal(GetAssetJournalFileName(fileName));
+            fileIndexLoaded_ = fileIndex_->LoadFile(GetFileIndexFileName(fileName));
+        }
+        return;
+    }
+
+    // Fall back to the database in JSON format, it will be converted to the snapshot on the next save
     auto jsonFile = MakeShared<JSONFile>(context_);
     if (jsonFile->LoadFile(fileName))
+    {
         jsonFile->LoadObject("Cache", *this);
+        fileIndexLoaded_ = fileIndex_->LoadFile(GetFileIndexFileName(fileName));
+    }
+    snapshotOutdated_ = true;
 }
 
-void AssetManager::SaveFile(const ea::string& fileName) const
+void AssetManager::SaveFile(const ea::string& fileName)
 {
-    auto jsonFile = MakeShared<JSONFile>(context_);
-    if (jsonFile->SaveObject("Cache", *this))
-        jsonFile->SaveFile(fileName);
+    auto fs = GetSubsystem<FileSystem>();
+
+    const ea::string journalFileName = GetAssetJournalFileName(fileName);
+    const unsigned maxJournalEntries = ea::max(MinJournalEntriesToCompact, assets_.size() / 4);
+
+    bool saved = false;
+    if (snapshotOutdated_ || numJournalEntries_ + modifiedAssets_.size() > maxJournalEntries)
+    {
+        saved = SaveSnapshot(GetAssetSnapshotFileName(fileName));
+        if (saved)
+        {
+            fs->Delete(journalFileName);
+            numJournalEntries_ = 0;
+            snapshotOutdated_ = false;
+        }
+    }
+    else
+        saved = modifiedAssets_.empty() || AppendJournal(journalFileName);
+
+    if (saved)
+    {
+        modifiedAssets_.clear();
+        fileIndex_->SaveFile(GetFileIndexFileName(fileName));
+    }
+    else
+    {
+        // Journal may be damaged, rewrite everything next time
+        snapshotOutdated_ = true;
+    }
+}
+
+bool AssetManager::LoadSnapshot(const ea::string& fileName)
+{
+    try
+    {
+        File file(context_, fileName, FILE_READ);
+        BinaryInputArchive archive(context_, file);
+        ArchiveBlock block = archive.OpenUnorderedBlock("assetDatabase");
+
+        unsigned version{};
+        SerializeValue(archive, "version", version);
+        if (version != DatabaseVersion)
+            throw ArchiveException("Unsupported asset database version {}", version);
+
+        SerializeInBlock(archive);
+        numJournalEntries_ = 0;
+        snapshotOutdated_ = false;
+        return true;
+    }
+    catch (const ArchiveException& e)
+    {
+        URHO3D_LOGWARNING("Cannot load asset database {}: {}", fileName, e.what());
+        assets_.clear();
+        assetPipelineFiles_.clear();
+        schedulingHints_.clear();
+        snapshotOutdated_ = true;
+        return false;
+    }
+}
+
+bool AssetManager::SaveSnapshot(const ea::string& fileName) const
+{
+    try
+    {
+        File file(context_, fileName, FILE_WRITE);
+        BinaryOutputArchive archive(context_, file);
+        ArchiveBlock block = archive.OpenUnorderedBlock("assetDatabase");
+
+        unsigned version = DatabaseVersion;
+        SerializeValue(archive, "version", version);
+        const_cast<AssetManager*>(this)->SerializeInBlock(archive);
+        return true;
+    }
+    catch (const ArchiveException& e)
+    {
+        URHO3D_LOGWARNING("Cannot save asset database {}: {}", fileName, e.what());
+        return false;
+    }
+}
+
+void AssetManager::LoadJournal(const ea::string& fileName)
+{
+    auto fs = GetSubsystem<FileSystem>();
+    if (!fs->FileExists(fileName))
+        return;
+
+    File file(context_, fileName, FILE_READ);
+    while (!file.IsEof())
+    {
+        AssetJournalBatch batch;
+        try
+        {
+            BinaryInputArchive archive(context_, file);
+            SerializeValue(archive, "batch", batch);
+        }
+        catch (const ArchiveException& e)
+        {
+            // Keep the batches read so far, the last one may be incomplete if the editor was closed while saving
+            URHO3D_LOGWARNING("Cannot load asset journal {}: {}", fileName, e.what());
+            snapshotOutdated_ = true;
+            break;
+        }
+
+        for (AssetJournalEntry& entry : batch.entries_)
+        {
+            if (entry.hasAsset_)
+            {
+                entry.asset_.resourceName_ = entry.resourceName_;
+                assets_[entry.resourceName_] = ea::move(entry.asset_);
+            }
+            else
+                assets_.erase(entry.resourceName_);
+
+            if (entry.hasSchedulingHint_)
+                schedulingHints_[entry.resourceName_] = ea::move(entry.schedulingHint_);
+            else
+                schedulingHints_.erase(entry.resourceName_);
+        }
+        numJournalEntries_ += batch.entries_.size();
+    }
+}
+
+bool AssetManager::AppendJournal(const ea::string& fileName)
+{
+    AssetJournalBatch batch;
+    batch.entries_.reserve(modifiedAssets_.size());
+    for (const ea::string& resourceName : modifiedAssets_)
+    {
+        AssetJournalEntry& entry = batch.entries_.emplace_back();
+        entry.resourceName_ = resourceName;
+
+        const auto assetIter = assets_.find(resourceName);
+        if (assetIter != assets_.end())
+        {
+            entry.hasAsset_ = true;
+            entry.asset_ = assetIter->second;
+        }
+
+        const auto hintIter = schedulingHints_.find(resourceName);
+        if (hintIter != schedulingHints_.end())
+        {
+            entry.hasSchedulingHint_ = true;
+            entry.schedulingHint_ = hintIter->second;
+        }
+    }
+
+    try
+    {
+        File file(context_, fileName, FILE_READWRITE);
+        file.Seek(file.GetSize());
+        BinaryOutputArchive archive(context_, file);
+        SerializeValue(archive, "batch", batch);
+        numJournalEntries_ += batch.entries_.size();
+        return true;
+    }
+    catch (const ArchiveException& e)
+    {
+        URHO3D_LOGWARNING("Cannot save asset journal {}: {}", fileName, e.what());
+        return false;
+    }
+}
+
+void AssetManager::MarkAssetModified(const ea::string& resourceName)
+{
+    modifiedAssets_.insert(resourceName);
 }
 
 AssetManager::AssetPipelineList AssetManager::EnumerateAssetPipelineFiles() const
@@ -410,10 +890,22 @@ void AssetManager::CleanupInvalidatedAssets()
         {
             const ea::string outputFileName = project_->GetCachePath() + outputResourceName;
             fs->Delete(outputFileName);
+
+            for (unsigned i = outputResourceName.find('/'); i != ea::string::npos; i = outputResourceName.find('/', i + 1))
+                cacheFoldersToCleanup_.insert(outputResourceName.substr(0, i));
         }
+
+        // Asset may be processed differently now
+        pathsToScan_.push_back(resourceName);
     }
 
-    ea::erase_if(assets_, [](const auto& pair) { return pair.second.cacheInvalid_; });
+    ea::erase_if(assets_, [this](const auto& pair)
+    {
+        if (!pair.second.cacheInvalid_)
+            return false;
+        MarkAssetModified(pair.first);
+        return true;
+    });
 }
 
 void AssetManager::CleanupCacheFolder()
@@ -430,29 +922,72 @@ void AssetManager::CleanupCacheFolder()
         }
     }
 
+    // Scan the whole folder only once, later check only folders of removed outputs
     StringVector allFolders;
-    fs->ScanDir(allFolders, project_->GetCachePath(), "", SCAN_DIRS | SCAN_RECURSIVE);
+    if (cleanupWholeCacheFolder_)
+    {
+        fs->ScanDir(allFolders, project_->GetCachePath(), "", SCAN_DIRS | SCAN_RECURSIVE);
 
-    if (const auto iter = allFolders.find("."); iter != allFolders.end())
-        allFolders.erase(iter);
-    if (const auto iter = allFolders.find(".."); iter != allFolders.end())
-        allFolders.erase(iter);
+        if (const auto iter = allFolders.find("."); iter != allFolders.end())
+            allFolders.erase(iter);
+        if (const auto iter = allFolders.find(".."); iter != allFolders.end())
+            allFolders.erase(iter);
 
-    ea::erase_if(allFolders, [](const ea::string& folder) { return folder.ends_with(".") || folder.ends_with(".."); });
+        ea::erase_if(allFolders, [](const ea::string& folder) { return folder.ends_with(".") || folder.ends_with(".."); });
+    }
+    else
+        allFolders.assign(cacheFoldersToCleanup_.begin(), cacheFoldersToCleanup_.end());
+
+    cleanupWholeCacheFolder_ = false;
+    cacheFoldersToCleanup_.clear();
 
     for (const ea::string& resourcePath : allFolders)
     {
-        if (!foldersToKeep.contains(resourcePath))
-            fs->RemoveDir(project_->GetCachePath() + resourcePath, true);
+        const ea::string folderName = project_->GetCachePath() + resourcePath;
+        if (!foldersToKeep.contains(resourcePath) && fs->DirExists(folderName))
+            fs->RemoveDir(folderName, true);
+    }
+}
+
+void AssetManager::ApplyFileIndexChanges(const FileIndexChanges& changes)
+{
+    // Sync modification times of the files that were touched without changes
+    if (!changes.touchedFiles_.empty())
+    {
+        const auto updateTime = [&](const ea::string& resourceName, FileTime& modificationTime)
+        {
+            const auto iter = changes.touchedFiles_.find(resourceName);
+            if (iter == changes.touchedFiles_.end() || iter->second.first != modificationTime)
+                return false;
+            modificationTime = iter->second.second;
+            return true;
+        };
+
+        for (auto& [resourceName, assetDesc] : assets_)
+        {
+            bool modified = updateTime(resourceName, assetDesc.modificationTime_);
+            for (auto& [dependencyResourceName, modificationTime] : assetDesc.dependencyModificationTimes_)
+                modified = updateTime(dependencyResourceName, modificationTime) || modified;
+            if (modified)
+                MarkAssetModified(resourceName);
+        }
+    }
+
+    for (const ea::string& resourceName : changes.changedFiles_)
+    {
+        InvalidateOutdatedAssetsInPath(resourceName);
+        pathsToScan_.push_back(resourceName);
     }
 }
 
 StringVector AssetManager::GetUpdatedPaths(bool updateAll)
 {
     StringVector allPathUpdates;
-    FileChange change;
-    while (dataWatcher_->GetNextChange(change))
+    ea::vector<FileChange> changes;
+    dataWatcher_->GetNextChanges(changes);
+    for (const FileChange& change : changes)
     {
+        // Empty file name means full rescan and is compressed with all other paths below
         allPathUpdates.push_back(change.fileName_);
         if (!change.oldFileName_.empty())
             allPathUpdates.push_back(change.oldFileName_);
@@ -490,6 +1025,8 @@ void AssetManager::InitializeAssetPipelines()
         InvalidateAssetsInPath(GetPath(resourceName));
 
     assetPipelines_ = newAssetPipelines;
+    if (assetPipelineFiles_ != newAssetPipelineFiles)
+        snapshotOutdated_ = true;
     assetPipelineFiles_ = newAssetPipelineFiles;
     UpdateTransformHierarchy();
 }
@@ -516,6 +1053,8 @@ void AssetManager::UpdateAssetPipelines()
             InvalidateApplicableAssetsInPath(resourcePath, GetTransformers(*diff.newPipeline_));
     }
 
+    if (assetPipelineFiles_ != newAssetPipelineFiles)
+        snapshotOutdated_ = true;
     assetPipelineFiles_ = newAssetPipelineFiles;
     assetPipelines_ = newAssetPipelines;
     UpdateTransformHierarchy();
@@ -564,6 +1103,7 @@ bool AssetManager::QueueAssetProcessing(const ea::string& resourceName, const Ap
     AssetDesc& assetDesc = assets_[resourceName];
     assetDesc.resourceName_ = resourceName;
     assetDesc.modificationTime_ = assetModifiedTime;
+    MarkAssetModified(resourceName);
 
     const AssetTransformerInput input{flavor, resourceName, fileName, assetModifiedTime};
     if (!AssetTransformer::IsApplicable(input, transformers))
@@ -571,7 +1111,8 @@ bool AssetManager::QueueAssetProcessing(const ea::string& resourceName, const Ap
 
     const ea::string tempPath = project_->GetRandomTemporaryPath();
     const ea::string outputFileName = tempPath + resourceName;
-    requestQueue_.push_back(AssetTransformerInput{input, tempPath, outputFileName});
+    requestQueue_.push_back(QueuedRequest{AssetTransformerInput{input, tempPath, outputFileName}});
+    requestQueueScheduled_ = false;
     return true;
 }
 
@@ -600,6 +1141,30 @@ void AssetManager::CompleteAssetProcessing(
 
     ++progress_.first;
 
+    const auto ongoingRequestIter = ongoingRequests_.find(input.resourceName_);
+    if (ongoingRequestIter != ongoingRequests_.end())
+    {
+        if (output && ongoingRequestIter->second.dispatched_)
+        {
+            AssetSchedulingHint& hint = schedulingHints_[input.resourceName_];
+            hint.processingTimeMs_ = ongoingRequestIter->second.timer_.GetMSec(false);
+            hint.dependencies_.clear();
+            for (const auto& [dependencyResourceName, _] : output->dependencyModificationTimes_)
+                hint.dependencies_.push_back(dependencyResourceName);
+            MarkAssetModified(input.resourceName_);
+        }
+        RecordAssetProcessing(input, output, ongoingRequestIter->second);
+        ongoingRequests_.erase(ongoingRequestIter);
+    }
+
+    const auto cacheKeyIter = ongoingRequestCacheKeys_.find(input.resourceName_);
+    if (cacheKeyIter != ongoingRequestCacheKeys_.end())
+    {
+        if (output && assetCache_->Store(cacheKeyIter->second, *output))
+            assetCache_->PublishRemote(cacheKeyIter->second);
+        ongoingRequestCacheKeys_.erase(cacheKeyIter);
+    }
+
     if (output)
     {
         AssetDesc& assetDesc = assets_[input.resourceName_];
@@ -608,6 +1173,7 @@ void AssetManager::CompleteAssetProcessing(
         assetDesc.dependencyModificationTimes_ = output->dependencyModificationTimes_;
         assetDesc.outputs_ = output->outputResourceNames_;
         assetDesc.transformers_ = output->appliedTransformers_;
+        MarkAssetModified(input.resourceName_);
 
         if (output->sourceModified_)
             ignoredAssetUpdates_.insert(input.resourceName_);
@@ -625,13 +1191,43 @@ void AssetManager::CompleteAssetProcessing(
     }
 }
 
-StringVector AssetManager::EnumerateAssetFiles(const ea::string& resourcePath) const
+void AssetManager::RecordAssetProcessing(
+    const AssetTransformerInput& input, const ea::optional<AssetTransformerOutput>& output, const OngoingRequest& request)
 {
-    auto fs = GetSubsystem<FileSystem>();
+    AssetProcessingRecord record;
+    record.resourceName_ = input.resourceName_;
+    record.startTimeUs_ = request.startTimeUs_;
+    record.durationUs_ = Time::GetTimeSinceEpochUs() - request.startTimeUs_;
+
+    if (request.dispatched_)
+        record.result_ = output ? AssetProcessingResult::Processed : AssetProcessingResult::Failed;
+    else if (request.restoredFromRemoteCache_)
+        record.result_ = AssetProcessingResult::RestoredFromRemoteCache;
+    else
+        record.result_ = AssetProcessingResult::RestoredFromCache;
 
-    StringVector result;
-    fs->ScanDir(result, GetFileName(resourcePath), "", SCAN_FILES | SCAN_RECURSIVE);
+    record.bytesRead_ = GetFileSize(context_, input.inputFileName_);
+    if (output)
+    {
+        for (const auto& [dependencyResourceName, _] : output->dependencyModificationTimes_)
+            record.bytesRead_ += GetFileSize(context_, GetFileName(dependencyResourceName));
+        for (const ea::string& outputResourceName : output->outputResourceNames_)
+            record.bytesWritten_ += GetFileSize(context_, project_->GetCachePath() + outputResourceName);
 
+        // Statistics restored from cache are not relevant
+        if (request.dispatched_)
+        {
+            record.peakMemory_ = output->peakMemory_;
+            record.transformers_ = output->transformerStats_;
+        }
+    }
+
+    profiler_->AddRecord(record);
+}
+
+StringVector AssetManager::EnumerateAssetFiles(const ea::string& resourcePath) const
+{
+    StringVector result = fileIndex_->GetFilesInPath(resourcePath);
     ea::erase_if(result, [this](const ea::string& fileName)
     {
         return project_->IsFileNameIgnored(fileName);
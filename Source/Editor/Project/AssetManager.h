@@ -23,6 +23,7 @@
 #pragma once
 
 #include <Urho3D/Core/Signal.h>
+#include <Urho3D/Core/Timer.h>
 #include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/IO/FileWatcher.h>
 #include <Urho3D/Scene/Serializable.h>
@@ -37,6 +38,12 @@
 namespace Urho3D
 {
 
+class AssetCache;
+class AssetProcessingProfiler;
+struct AssetProcessingRecord;
+class FileIndex;
+struct FileIndexChanges;
+struct RemoteAssetCacheSettings;
 class JSONFile;
 class Project;
 
@@ -61,6 +68,8 @@ public:
 
     /// Override asset processing.
     void SetProcessCallback(const OnProcessAssetQueued& callback, unsigned maxConcurrency = 1);
+    /// Set shared cache used to download and upload processed assets.
+    void SetRemoteCache(const RemoteAssetCacheSettings& settings);
     /// Process asset without affecting internal state of AssetManager.
     void ProcessAsset(const AssetTransformerInput& input, const OnProcessAssetCompleted& callback) const;
 
@@ -74,12 +83,17 @@ public:
     ProgressInfo GetProgress() const { return progress_; }
     /// Return whether asset manager is currently processing assets.
     bool IsProcessing() const { return progress_ != ProgressInfo{}; }
+    /// Return statistics of asset processing.
+    AssetProcessingProfiler* GetProfiler() const { return profiler_; }
 
     /// Serialize
     /// @{
     void SerializeInBlock(Archive& archive) override;
+    /// Load asset database. Binary snapshot and journal next to the file are preferred over the file itself.
     void LoadFile(const ea::string& fileName);
-    void SaveFile(const ea::string& fileName) const;
+    /// Save asset database. Changed assets are appended to the journal, which is compacted into the snapshot once it
+    /// grows too large.
+    void SaveFile(const ea::string& fileName);
     /// @}
 
 private:
@@ -117,6 +131,54 @@ private:
         ea::string GetTransformerDebugString() const;
     };
 
+    /// Information about the last processing of the asset used for scheduling.
+    /// Unlike AssetDesc, it's kept when the asset is invalidated.
+    struct AssetSchedulingHint
+    {
+        unsigned processingTimeMs_{};
+        StringVector dependencies_;
+
+        void SerializeInBlock(Archive& archive);
+    };
+
+    /// Change of single asset recorded in the journal.
+    struct AssetJournalEntry
+    {
+        ea::string resourceName_;
+        bool hasAsset_{};
+        AssetDesc asset_;
+        bool hasSchedulingHint_{};
+        AssetSchedulingHint schedulingHint_;
+
+        void SerializeInBlock(Archive& archive);
+    };
+
+    /// Changes of assets saved at once.
+    struct AssetJournalBatch
+    {
+        AssetPipelineList assetPipelineFiles_;
+        ea::vector<AssetJournalEntry> entries_;
+
+        void SerializeInBlock(Archive& archive);
+    };
+
+    struct QueuedRequest
+    {
+        AssetTransformerInput input_;
+        /// Estimated time to process this asset and all queued assets that depend on it.
+        unsigned criticalPathMs_{};
+        /// Queued assets that should be processed before this asset.
+        StringVector dependencies_;
+    };
+
+    struct OngoingRequest
+    {
+        Timer timer_;
+        long long startTimeUs_{};
+        bool dispatched_{};
+        bool restoredFromRemoteCache_{};
+    };
+
     struct Stats
     {
         unsigned numProcessedAssets_{};
@@ -146,6 +208,7 @@ private:
     void InvalidateOutdatedAssetsInPath(const ea::string& resourcePath);
     void CleanupInvalidatedAssets();
     void CleanupCacheFolder();
+    void ApplyFileIndexChanges(const FileIndexChanges& changes);
     /// @}
 
     StringVector GetUpdatedPaths(bool updateAll);
@@ -159,26 +222,61 @@ private:
 
     void ScanAssetsInPath(const ea::string& resourcePath, Stats& stats);
     bool QueueAssetProcessing(const ea::string& resourceName, const ApplicationFlavor& flavor);
+    void ScheduleAssetQueue();
+    unsigned EstimateProcessingTime(const AssetTransformerInput& input) const;
+    ea::vector<QueuedRequest>::iterator FindReadyRequest();
     void ConsumeAssetQueue();
+    bool RestoreAssetFromCache(const AssetTransformerInput& input);
+    void DispatchAssetProcessing(const AssetTransformerInput& input);
+    void ProcessAssetInWorkerThread(const AssetTransformerInput& input, const AssetTransformerVector& transformers);
 
     void CompleteAssetProcessing(
         const AssetTransformerInput& input, const ea::optional<AssetTransformerOutput>& output, const ea::string& message);
+    void RecordAssetProcessing(const AssetTransformerInput& input, const ea::optional<AssetTransformerOutput>& output,
+        const OngoingRequest& request);
+
+    /// Asset database persistence.
+    /// @{
+    bool LoadSnapshot(const ea::string& fileName);
+    bool SaveSnapshot(const ea::string& fileName) const;
+    void LoadJournal(const ea::string& fileName);
+    bool AppendJournal(const ea::string& fileName);
+    void MarkAssetModified(const ea::string& resourceName);
+    /// @}
 
     void OnReflectionRemoved(ObjectReflection* reflection);
 
+    /// Max time spent on restoring assets from the cache per update.
+    static const unsigned CacheRestoreBudgetMs = 16;
+    /// Estimated processing time of the asset that was never processed before, per megabyte of source file.
+    static const unsigned EstimatedProcessingTimeMsPerMegabyte = 100;
+    /// Version of binary asset database snapshot and journal.
+    static const unsigned DatabaseVersion = 1;
+    /// Min number of journal entries before the journal is compacted into the snapshot.
+    static const unsigned MinJournalEntriesToCompact = 1024;
+
     const WeakPtr<Project> project_;
     SharedPtr<FileWatcher> dataWatcher_;
+    SharedPtr<AssetCache> assetCache_;
+    SharedPtr<AssetProcessingProfiler> profiler_;
+    SharedPtr<FileIndex> fileIndex_;
+    bool fileIndexLoaded_{};
 
     OnProcessAssetQueued processCallback_;
     unsigned maxConcurrentRequests_{};
 
-    ApplicationFlavor defaultFlavor_; // TODO(editor): Make configurable
+    const ApplicationFlavor defaultFlavor_;
 
     bool initialized_{};
     bool autoProcessAssets_{};
     bool reloadAssetPipelines_{};
     bool hasInvalidAssets_{};
     bool scanAssets_{};
+    /// Paths that should be scanned for new assets on the next scan.
+    StringVector pathsToScan_;
+    /// Cache folders that may become empty after cleanup of invalidated assets.
+    ea::unordered_set<ea::string> cacheFoldersToCleanup_;
+    bool cleanupWholeCacheFolder_{};
 
     AssetPipelineDescVector assetPipelines_;
     SharedPtr<AssetTransformerHierarchy> transformerHierarchy_;
@@ -186,8 +284,21 @@ private:
     AssetPipelineList assetPipelineFiles_;
     ea::unordered_set<ea::string> ignoredAssetUpdates_;
 
-    ea::vector<AssetTransformerInput> requestQueue_;
+    /// Queue of requests sorted by critical path length, longest last.
+    ea::vector<QueuedRequest> requestQueue_;
+    bool requestQueueScheduled_{};
+    ea::unordered_map<ea::string, AssetSchedulingHint> schedulingHints_;
+    ea::unordered_map<ea::string, OngoingRequest> ongoingRequests_;
     unsigned numOngoingRequests_{};
+    /// Asset cache keys of ongoing requests.
+    ea::unordered_map<ea::string, ea::string> ongoingRequestCacheKeys_;
+
+    /// Assets changed since the last save.
+    ea::unordered_set<ea::string> modifiedAssets_;
+    /// Number of entries in the journal after the snapshot.
+    unsigned numJournalEntries_{};
+    /// Whether the snapshot should be rewritten on the next save.
+    bool snapshotOutdated_{true};
 
     ProgressInfo progress_;
 };
@@ -0,0 +1,193 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Project/AssetProcessingProfiler.h"
+
+#include <Urho3D/Core/Profiler.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Resource/JSONFile.h>
+
+#include <EASTL/sort.h>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+JSONValue CreateTraceEvent(const ea::string& name, const ea::string& category, long long startTimeUs,
+    long long durationUs, unsigned lane)
+{
+    JSONValue event;
+    event.Set("name", name);
+    event.Set("cat", category);
+    event.Set("ph", "X");
+    event.Set("ts", static_cast<double>(startTimeUs));
+    event.Set("dur", static_cast<double>(durationUs));
+    event.Set("pid", 1);
+    event.Set("tid", lane);
+    return event;
+}
+
+}
+
+const char* ToString(AssetProcessingResult result)
+{
+    switch (result)
+    {
+    case AssetProcessingResult::Processed: return "Processed";
+    case AssetProcessingResult::Failed: return "Failed";
+    case AssetProcessingResult::RestoredFromCache: return "RestoredFromCache";
+    case AssetProcessingResult::RestoredFromRemoteCache: return "RestoredFromRemoteCache";
+    default: return "";
+    }
+}
+
+AssetProcessingProfiler::AssetProcessingProfiler(Context* context)
+    : Object(context)
+{
+}
+
+AssetProcessingProfiler::~AssetProcessingProfiler()
+{
+}
+
+void AssetProcessingProfiler::AddRecord(const AssetProcessingRecord& record)
+{
+    const bool isCacheHit = record.result_ == AssetProcessingResult::RestoredFromCache
+        || record.result_ == AssetProcessingResult::RestoredFromRemoteCache;
+    if (isCacheHit)
+        ++numCacheHits_;
+    else
+        ++numCacheMisses_;
+
+    records_.push_back(record);
+
+#if URHO3D_PROFILING
+    const ea::string message = Format("{} {} in {:.1f} ms", ToString(record.result_), record.resourceName_,
+        record.durationUs_ / 1000.0);
+    URHO3D_PROFILE_MESSAGE(message.c_str(), message.length());
+    URHO3D_PROFILE_VALUE("Asset Processing Time (ms)", record.durationUs_ / 1000.0);
+#endif
+}
+
+void AssetProcessingProfiler::Clear()
+{
+    records_.clear();
+    numCacheHits_ = 0;
+    numCacheMisses_ = 0;
+}
+
+ea::vector<AssetTransformerSummary> AssetProcessingProfiler::GetTransformerSummary() const
+{
+    ea::unordered_map<ea::string, AssetTransformerSummary> summaryByType;
+    for (const AssetProcessingRecord& record : records_)
+    {
+        for (const AssetTransformerStats& stats : record.transformers_)
+        {
+            AssetTransformerSummary& summary = summaryByType[stats.type_];
+            summary.type_ = stats.type_;
+            ++summary.numExecutions_;
+            summary.totalDurationUs_ += stats.durationUs_;
+            if (stats.durationUs_ >= summary.maxDurationUs_)
+            {
+                summary.maxDurationUs_ = stats.durationUs_;
+                summary.slowestResourceName_ = record.resourceName_;
+            }
+        }
+    }
+
+    ea::vector<AssetTransformerSummary> result;
+    for (const auto& [type, summary] : summaryByType)
+        result.push_back(summary);
+
+    ea::sort(result.begin(), result.end(), [](const AssetTransformerSummary& lhs, const AssetTransformerSummary& rhs)
+    { return lhs.totalDurationUs_ > rhs.totalDurationUs_; });
+    return result;
+}
+
+ea::vector<unsigned> AssetProcessingProfiler::GetSlowestRecords(unsigned maxRecords) const
+{
+    ea::vector<unsigned> result(records_.size());
+    for (unsigned index = 0; index < records_.size(); ++index)
+        result[index] = index;
+
+    const unsigned numRecords = ea::min<unsigned>(maxRecords, result.size());
+    ea::partial_sort(result.begin(), result.begin() + numRecords, result.end(), [&](unsigned lhs, unsigned rhs)
+    { return records_[lhs].durationUs_ > records_[rhs].durationUs_; });
+
+    result.resize(numRecords);
+    return result;
+}
+
+bool AssetProcessingProfiler::SaveChromeTrace(const ea::string& fileName) const
+{
+    ea::vector<unsigned> orderedRecords(records_.size());
+    for (unsigned index = 0; index < records_.size(); ++index)
+        orderedRecords[index] = index;
+    ea::sort(orderedRecords.begin(), orderedRecords.end(),
+        [&](unsigned lhs, unsigned rhs) { return records_[lhs].startTimeUs_ < records_[rhs].startTimeUs_; });
+
+    // Place overlapping requests on different lanes
+    ea::vector<long long> laneEndTimes;
+    JSONValue events{JSONValueType::JSON_ARRAY};
+    for (unsigned index : orderedRecords)
+    {
+        const AssetProcessingRecord& record = records_[index];
+        const long long endTimeUs = record.startTimeUs_ + record.durationUs_;
+
+        const auto laneIter = ea::find_if(laneEndTimes.begin(), laneEndTimes.end(),
+            [&](long long laneEndTimeUs) { return laneEndTimeUs <= record.startTimeUs_; });
+        const unsigned lane = laneIter - laneEndTimes.begin();
+        if (laneIter == laneEndTimes.end())
+            laneEndTimes.push_back(endTimeUs);
+        else
+            *laneIter = endTimeUs;
+
+        JSONValue event = CreateTraceEvent(record.resourceName_, ToString(record.result_),
+            record.startTimeUs_, record.durationUs_, lane);
+
+        JSONValue args;
+        args.Set("bytesRead", static_cast<double>(record.bytesRead_));
+        args.Set("bytesWritten", static_cast<double>(record.bytesWritten_));
+        args.Set("peakMemory", static_cast<double>(record.peakMemory_));
+        event.Set("args", args);
+        events.Push(event);
+
+        for (const AssetTransformerStats& stats : record.transformers_)
+            events.Push(CreateTraceEvent(stats.type_, "Transformer", stats.startTimeUs_, stats.durationUs_, lane));
+    }
+
+    JSONFile file(context_);
+    file.GetRoot().Set("traceEvents", events);
+    file.GetRoot().Set("displayTimeUnit", "ms");
+    if (!file.SaveFile(fileName))
+    {
+        URHO3D_LOGERROR("Cannot save asset processing trace to {}", fileName);
+        return false;
+    }
+
+    URHO3D_LOGINFO("Asset processing trace is saved to {}", fileName);
+    return true;
+}
+
+}
@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/Utility/AssetTransformer.h>
+
+namespace Urho3D
+{
+
+/// How the asset request was completed.
+enum class AssetProcessingResult
+{
+    Processed,
+    Failed,
+    RestoredFromCache,
+    RestoredFromRemoteCache,
+};
+
+/// Statistics of the single asset request.
+struct AssetProcessingRecord
+{
+    ea::string resourceName_;
+    AssetProcessingResult result_{};
+    /// Start time in microseconds since epoch, see Time::GetTimeSinceEpochUs.
+    long long startTimeUs_{};
+    long long durationUs_{};
+    /// Total size of the asset and its dependencies.
+    unsigned long long bytesRead_{};
+    /// Total size of the outputs.
+    unsigned long long bytesWritten_{};
+    /// Peak memory usage of the process that executed the transformers. 0 if unknown.
+    unsigned long long peakMemory_{};
+    /// Statistics of the transformers. Empty if the asset was restored from cache.
+    ea::vector<AssetTransformerStats> transformers_;
+};
+
+/// Aggregated statistics of the transformer type.
+struct AssetTransformerSummary
+{
+    ea::string type_;
+    unsigned numExecutions_{};
+    long long totalDurationUs_{};
+    long long maxDurationUs_{};
+    ea::string slowestResourceName_;
+};
+
+/// Collects statistics of asset processing and exports them as Chrome trace.
+class AssetProcessingProfiler : public Object
+{
+    URHO3D_OBJECT(AssetProcessingProfiler, Object);
+
+public:
+    explicit AssetProcessingProfiler(Context* context);
+    ~AssetProcessingProfiler() override;
+
+    void AddRecord(const AssetProcessingRecord& record);
+    void Clear();
+
+    /// Return statistics of all transformers, slowest first.
+    ea::vector<AssetTransformerSummary> GetTransformerSummary() const;
+    /// Return indices of slowest records, slowest first.
+    ea::vector<unsigned> GetSlowestRecords(unsigned maxRecords) const;
+    /// Save all records in Chrome trace event format, can be opened in chrome://tracing or Perfetto.
+    bool SaveChromeTrace(const ea::string& fileName) const;
+
+    const ea::vector<AssetProcessingRecord>& GetRecords() const { return records_; }
+    unsigned GetNumCacheHits() const { return numCacheHits_; }
+    unsigned GetNumCacheMisses() const { return numCacheMisses_; }
+
+private:
+    ea::vector<AssetProcessingRecord> records_;
+    unsigned numCacheHits_{};
+    unsigned numCacheMisses_{};
+};
+
+/// Return human-readable name of the result.
+const char* ToString(AssetProcessingResult result);
+
+}
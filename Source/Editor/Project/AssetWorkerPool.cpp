@@ -0,0 +1,292 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Project/AssetWorkerPool.h"
+
+#include "../Project/Project.h"
+
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Message type and payload size.
+const unsigned messageHeaderSize = 5;
+
+}
+
+const ea::string AssetWorkerPool::WorkerCommand = "AssetWorker";
+
+AssetWorkerChannel::AssetWorkerChannel(Context* context, const ea::string& pipeName, bool isServer)
+    : pipeName_(pipeName)
+    , pipe_(MakeShared<NamedPipe>(context, pipeName, isServer))
+{
+}
+
+bool AssetWorkerChannel::Send(AssetWorkerMessageType type, const ByteVector& payload)
+{
+    VectorBuffer frame;
+    frame.WriteUByte(static_cast<unsigned char>(type));
+    frame.WriteUInt(payload.size());
+    if (!payload.empty())
+        frame.Write(payload.data(), payload.size());
+
+    return pipe_->Write(frame.GetData(), frame.GetSize()) == frame.GetSize();
+}
+
+ea::optional<AssetWorkerMessage> AssetWorkerChannel::Receive()
+{
+    unsigned char buffer[4096];
+    while (const unsigned numBytes = pipe_->Read(buffer, sizeof(buffer)))
+        receiveBuffer_.insert(receiveBuffer_.end(), buffer, buffer + numBytes);
+
+    if (receiveBuffer_.size() < messageHeaderSize)
+        return ea::nullopt;
+
+    MemoryBuffer header(receiveBuffer_.data(), messageHeaderSize);
+    const auto type = static_cast<AssetWorkerMessageType>(header.ReadUByte());
+    const unsigned payloadSize = header.ReadUInt();
+    if (receiveBuffer_.size() < messageHeaderSize + payloadSize)
+        return ea::nullopt;
+
+    const auto payloadBegin = receiveBuffer_.begin() + messageHeaderSize;
+    const auto payloadEnd = payloadBegin + payloadSize;
+
+    AssetWorkerMessage message;
+    message.type_ = type;
+    message.payload_.assign(payloadBegin, payloadEnd);
+    receiveBuffer_.erase(receiveBuffer_.begin(), payloadEnd);
+    return message;
+}
+
+AssetWorkerPool::AssetWorkerPool(Context* context, Project* project, unsigned maxWorkers, unsigned maxJobsPerWorker)
+    : Object(context)
+    , project_(project)
+    , maxWorkers_(ea::max(maxWorkers, 1u))
+    , maxJobsPerWorker_(ea::max(maxJobsPerWorker, 1u))
+{
+    SubscribeToEvent(E_UPDATE, &AssetWorkerPool::Update);
+}
+
+AssetWorkerPool::~AssetWorkerPool()
+{
+    // Don't invoke callbacks here, their owners may be already destroyed
+    for (const WorkerPtr& worker : workers_)
+    {
+        if (!worker->isExited_)
+            worker->channel_->Send(AssetWorkerMessageType::Exit);
+    }
+}
+
+void AssetWorkerPool::QueueJob(const ByteVector& request, const JobCallback& callback)
+{
+    jobQueue_.push_back(PendingJob{request, callback});
+}
+
+bool AssetWorkerPool::RunWorker(Context* context, const ea::string& pipeName, const JobHandler& handler)
+{
+    AssetWorkerChannel channel(context, pipeName, false);
+    if (!channel.IsOpen() || !channel.Send(AssetWorkerMessageType::Ready))
+    {
+        URHO3D_LOGERROR("Cannot connect to asset worker pool via pipe '{}'", pipeName);
+        return false;
+    }
+
+    Timer lastMessageTimer;
+    while (lastMessageTimer.GetMSec(false) < WorkerTimeoutMs)
+    {
+        const ea::optional<AssetWorkerMessage> message = channel.Receive();
+        if (!message)
+        {
+            Time::Sleep(1);
+            continue;
+        }
+
+        switch (message->type_)
+        {
+        case AssetWorkerMessageType::Exit:
+            return true;
+
+        case AssetWorkerMessageType::Request:
+            if (!channel.Send(AssetWorkerMessageType::Response, handler(message->payload_)))
+            {
+                URHO3D_LOGERROR("Cannot send response to asset worker pool");
+                return false;
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        lastMessageTimer.Reset();
+    }
+
+    URHO3D_LOGERROR("Asset worker pool is not responding");
+    return false;
+}
+
+void AssetWorkerPool::Update()
+{
+    SpawnWorkers();
+
+    for (const WorkerPtr& worker : workers_)
+        UpdateWorker(*worker);
+
+    ea::erase_if(workers_, [](const WorkerPtr& worker) { return worker->isExited_; });
+}
+
+void AssetWorkerPool::SpawnWorkers()
+{
+    if (jobQueue_.empty())
+        return;
+
+    if (numSpawnFailures_ >= MaxConsecutiveSpawnFailures)
+    {
+        FailAllJobs("Cannot start asset worker process");
+        return;
+    }
+
+    unsigned numIdleWorkers = 0;
+    for (const WorkerPtr& worker : workers_)
+    {
+        if (!worker->currentJob_)
+            ++numIdleWorkers;
+    }
+
+    while (workers_.size() < maxWorkers_ && numIdleWorkers < jobQueue_.size())
+    {
+        SpawnWorker();
+        ++numIdleWorkers;
+    }
+}
+
+void AssetWorkerPool::SpawnWorker()
+{
+    const ea::string pipeName = Format("AssetWorker-{}-{}", GetCurrentProcessID(), GenerateUUID());
+
+    auto worker = ea::make_shared<Worker>();
+    worker->channel_ = ea::make_unique<AssetWorkerChannel>(context_, pipeName, true);
+    if (!worker->channel_->IsOpen())
+    {
+        ++numSpawnFailures_;
+        return;
+    }
+
+    const ea::string command = Format("{} {}", WorkerCommand, pipeName);
+    const auto onExited = [weakWorker = ea::weak_ptr<Worker>(worker)](bool success, const ea::string& output)
+    {
+        if (const WorkerPtr worker = weakWorker.lock())
+        {
+            worker->isExited_ = true;
+            worker->exitOutput_ = output;
+        }
+    };
+
+    project_->ExecuteRemoteCommandAsync(command, onExited);
+    workers_.push_back(worker);
+}
+
+void AssetWorkerPool::UpdateWorker(Worker& worker)
+{
+    while (const ea::optional<AssetWorkerMessage> message = worker.channel_->Receive())
+    {
+        if (message->type_ == AssetWorkerMessageType::Ready)
+        {
+            worker.isReady_ = true;
+            numSpawnFailures_ = 0;
+        }
+        else if (message->type_ == AssetWorkerMessageType::Response && worker.currentJob_)
+        {
+            const PendingJob job = ea::move(*worker.currentJob_);
+            worker.currentJob_.reset();
+            ++worker.numJobs_;
+            job.callback_(message->payload_, EMPTY_STRING);
+        }
+    }
+
+    if (worker.isExited_)
+    {
+        if (!worker.isReady_)
+            ++numSpawnFailures_;
+
+        if (worker.currentJob_)
+        {
+            const PendingJob job = ea::move(*worker.currentJob_);
+            worker.currentJob_.reset();
+            job.callback_(ea::nullopt, Format("Asset worker process exited unexpectedly: {}", worker.exitOutput_));
+        }
+        return;
+    }
+
+    if (!worker.isReady_ || worker.currentJob_)
+        return;
+
+    if (worker.numJobs_ >= maxJobsPerWorker_)
+    {
+        RetireWorker(worker);
+        return;
+    }
+
+    if (!jobQueue_.empty())
+    {
+        worker.currentJob_ = ea::move(jobQueue_.front());
+        jobQueue_.erase(jobQueue_.begin());
+
+        if (!worker.channel_->Send(AssetWorkerMessageType::Request, worker.currentJob_->request_))
+        {
+            // Put the job back into the queue so it's picked by another worker
+            jobQueue_.push_back(ea::move(*worker.currentJob_));
+            worker.currentJob_.reset();
+            RetireWorker(worker);
+        }
+    }
+    else if (worker.pingTimer_.GetMSec(false) >= PingIntervalMs)
+    {
+        worker.channel_->Send(AssetWorkerMessageType::Ping);
+        worker.pingTimer_.Reset();
+    }
+}
+
+void AssetWorkerPool::RetireWorker(Worker& worker)
+{
+    worker.channel_->Send(AssetWorkerMessageType::Exit);
+    worker.isExited_ = true;
+}
+
+void AssetWorkerPool::FailAllJobs(const ea::string& message)
+{
+    const auto jobQueue = ea::move(jobQueue_);
+    jobQueue_.clear();
+
+    for (const PendingJob& job : jobQueue)
+        job.callback_(ea::nullopt, message);
+}
+
+}
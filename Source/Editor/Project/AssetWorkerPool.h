@@ -0,0 +1,150 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include <Urho3D/Container/ByteVector.h>
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/NamedPipe.h>
+
+#include <EASTL/functional.h>
+#include <EASTL/optional.h>
+#include <EASTL/shared_ptr.h>
+
+namespace Urho3D
+{
+
+class Project;
+
+/// Type of the message exchanged between AssetWorkerPool and worker process.
+enum class AssetWorkerMessageType : unsigned char
+{
+    /// Worker to pool: worker is connected and ready to accept jobs.
+    Ready,
+    /// Pool to worker: keep-alive.
+    Ping,
+    /// Pool to worker: finish current job and exit.
+    Exit,
+    /// Pool to worker: execute the job.
+    Request,
+    /// Worker to pool: result of the job.
+    Response,
+};
+
+/// Message exchanged between AssetWorkerPool and worker process.
+struct AssetWorkerMessage
+{
+    AssetWorkerMessageType type_{};
+    ByteVector payload_;
+};
+
+/// Framed message channel on top of NamedPipe. Never blocks on receive.
+class AssetWorkerChannel
+{
+public:
+    AssetWorkerChannel(Context* context, const ea::string& pipeName, bool isServer);
+
+    /// Send message. Return false if the pipe is broken.
+    bool Send(AssetWorkerMessageType type, const ByteVector& payload = {});
+    /// Receive next complete message, if any.
+    ea::optional<AssetWorkerMessage> Receive();
+
+    bool IsOpen() const { return pipe_->IsOpen(); }
+    const ea::string& GetName() const { return pipeName_; }
+
+private:
+    ea::string pipeName_;
+    SharedPtr<NamedPipe> pipe_;
+    ByteVector receiveBuffer_;
+};
+
+/// Pool of long-lived headless editor processes used to execute asset jobs.
+/// Workers are spawned on demand and recycled on crash or after a fixed number of jobs.
+class AssetWorkerPool : public Object
+{
+    URHO3D_OBJECT(AssetWorkerPool, Object);
+
+public:
+    /// Command that should be handled by worker process. Single argument is the pipe name.
+    static const ea::string WorkerCommand;
+    /// Default number of jobs after which the worker process is restarted.
+    static const unsigned DefaultMaxJobsPerWorker = 256;
+
+    /// Callback invoked on the main thread when the job is completed or failed.
+    using JobCallback = ea::function<void(const ea::optional<ByteVector>& response, const ea::string& message)>;
+    /// Callback invoked on the worker side for each job.
+    using JobHandler = ea::function<ByteVector(const ByteVector& request)>;
+
+    AssetWorkerPool(Context* context, Project* project, unsigned maxWorkers,
+        unsigned maxJobsPerWorker = DefaultMaxJobsPerWorker);
+    ~AssetWorkerPool() override;
+
+    /// Queue job for execution. Callback is invoked during one of the following updates.
+    void QueueJob(const ByteVector& request, const JobCallback& callback);
+
+    /// Run worker loop in the current process until the pool requests exit or the connection is lost.
+    static bool RunWorker(Context* context, const ea::string& pipeName, const JobHandler& handler);
+
+    unsigned GetNumWorkers() const { return workers_.size(); }
+    unsigned GetMaxWorkers() const { return maxWorkers_; }
+
+private:
+    static const unsigned PingIntervalMs = 1000;
+    static const unsigned WorkerTimeoutMs = 60000;
+    static const unsigned MaxConsecutiveSpawnFailures = 3;
+
+    struct PendingJob
+    {
+        ByteVector request_;
+        JobCallback callback_;
+    };
+
+    struct Worker
+    {
+        ea::unique_ptr<AssetWorkerChannel> channel_;
+        bool isReady_{};
+        bool isExited_{};
+        ea::string exitOutput_;
+        unsigned numJobs_{};
+        ea::optional<PendingJob> currentJob_;
+        Timer pingTimer_;
+    };
+    using WorkerPtr = ea::shared_ptr<Worker>;
+
+    void Update();
+    void SpawnWorkers();
+    void SpawnWorker();
+    void UpdateWorker(Worker& worker);
+    void RetireWorker(Worker& worker);
+    void FailAllJobs(const ea::string& message);
+
+    const WeakPtr<Project> project_;
+    const unsigned maxWorkers_{};
+    const unsigned maxJobsPerWorker_{};
+
+    ea::vector<WorkerPtr> workers_;
+    ea::vector<PendingJob> jobQueue_;
+    unsigned numSpawnFailures_{};
+};
+
+}
@@ -0,0 +1,197 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Project/FileIndex.h"
+
+#include <Urho3D/IO/ArchiveSerialization.h>
+#include <Urho3D/IO/BinaryArchive.h>
+#include <Urho3D/IO/ContentHash.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+
+#include <EASTL/unordered_set.h>
+
+namespace Urho3D
+{
+
+void FileIndex::Entry::SerializeInBlock(Archive& archive)
+{
+    SerializeValue(archive, "size", size_);
+    SerializeValue(archive, "modificationTime", modificationTime_);
+    SerializeValue(archive, "hash", hash_);
+}
+
+FileIndex::FileIndex(Context* context, const ea::string& rootPath)
+    : Object(context)
+    , rootPath_(rootPath)
+{
+}
+
+FileIndex::~FileIndex()
+{
+}
+
+template <class T> void FileIndex::ForEachEntryInPath(const ea::string& resourcePath, const T& callback) const
+{
+    const ea::string directoryPrefix = resourcePath.empty() ? EMPTY_STRING : AddTrailingSlash(resourcePath);
+
+    if (const auto iter = entries_.find(resourcePath); iter != entries_.end())
+        callback(iter->first);
+
+    for (auto iter = entries_.lower_bound(directoryPrefix); iter != entries_.end(); ++iter)
+    {
+        if (!iter->first.starts_with(directoryPrefix))
+            break;
+        callback(iter->first);
+    }
+}
+
+void FileIndex::UpdatePath(const ea::string& resourcePath, FileIndexChanges& changes)
+{
+    auto fs = GetSubsystem<FileSystem>();
+
+    ea::unordered_set<ea::string> existingFiles;
+    const ea::string fileName = rootPath_ + resourcePath;
+    if (!resourcePath.empty() && fs->FileExists(fileName))
+        existingFiles.insert(resourcePath);
+    else if (fs->DirExists(fileName))
+    {
+        const ea::string directoryPrefix = resourcePath.empty() ? EMPTY_STRING : AddTrailingSlash(resourcePath);
+
+        StringVector files;
+        fs->ScanDir(files, fileName, "", SCAN_FILES | SCAN_RECURSIVE);
+        for (const ea::string& file : files)
+            existingFiles.insert(directoryPrefix + file);
+    }
+
+    StringVector removedFiles;
+    ForEachEntryInPath(resourcePath, [&](const ea::string& resourceName)
+    {
+        if (!existingFiles.contains(resourceName))
+            removedFiles.push_back(resourceName);
+    });
+
+    for (const ea::string& resourceName : removedFiles)
+    {
+        entries_.erase(resourceName);
+        changes.changedFiles_.push_back(resourceName);
+    }
+
+    for (const ea::string& resourceName : existingFiles)
+        UpdateFile(resourceName, changes);
+}
+
+void FileIndex::UpdateFile(const ea::string& resourceName, FileIndexChanges& changes)
+{
+    auto fs = GetSubsystem<FileSystem>();
+
+    const ea::string fileName = rootPath_ + resourceName;
+    const FileTime modificationTime = fs->GetLastModifiedTime(fileName, true);
+
+    const auto iter = entries_.find(resourceName);
+    if (iter != entries_.end() && iter->second.modificationTime_ == modificationTime)
+        return;
+
+    File file(context_);
+    if (!file.Open(fileName, FILE_READ))
+    {
+        if (iter != entries_.end())
+        {
+            entries_.erase(iter);
+            changes.changedFiles_.push_back(resourceName);
+        }
+        return;
+    }
+
+    ContentHasher hasher;
+    Entry newEntry;
+    newEntry.size_ = hasher.Append(file);
+    newEntry.modificationTime_ = modificationTime;
+    newEntry.hash_ = hasher.GetHash();
+
+    if (iter != entries_.end() && iter->second.size_ == newEntry.size_ && iter->second.hash_ == newEntry.hash_)
+    {
+        changes.touchedFiles_[resourceName] = {iter->second.modificationTime_, modificationTime};
+        iter->second.modificationTime_ = modificationTime;
+        return;
+    }
+
+    entries_[resourceName] = newEntry;
+    changes.changedFiles_.push_back(resourceName);
+}
+
+StringVector FileIndex::GetFilesInPath(const ea::string& resourcePath) const
+{
+    StringVector result;
+    ForEachEntryInPath(resourcePath, [&](const ea::string& resourceName) { result.push_back(resourceName); });
+    return result;
+}
+
+void FileIndex::SerializeInBlock(Archive& archive)
+{
+    unsigned version = IndexVersion;
+    SerializeValue(archive, "version", version);
+    if (version != IndexVersion)
+        throw ArchiveException("Unsupported file index version {}", version);
+
+    SerializeValue(archive, "entries", entries_);
+}
+
+bool FileIndex::LoadFile(const ea::string& fileName)
+{
+    auto fs = GetSubsystem<FileSystem>();
+    if (!fs->FileExists(fileName))
+        return false;
+
+    try
+    {
+        File file(context_, fileName, FILE_READ);
+        BinaryInputArchive archive(context_, file);
+        SerializeValue(archive, "fileIndex", *this);
+        return true;
+    }
+    catch (const ArchiveException& e)
+    {
+        URHO3D_LOGWARNING("Cannot load file index {}: {}", fileName, e.what());
+        entries_.clear();
+        return false;
+    }
+}
+
+bool FileIndex::SaveFile(const ea::string& fileName) const
+{
+    try
+    {
+        File file(context_, fileName, FILE_WRITE);
+        BinaryOutputArchive archive(context_, file);
+        SerializeValue(archive, "fileIndex", const_cast<FileIndex&>(*this));
+        return true;
+    }
+    catch (const ArchiveException& e)
+    {
+        URHO3D_LOGWARNING("Cannot save file index {}: {}", fileName, e.what());
+        return false;
+    }
+}
+
+}
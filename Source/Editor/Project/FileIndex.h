@@ -0,0 +1,88 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include <Urho3D/Core/Object.h>
+#include <Urho3D/IO/ScanFlags.h>
+
+#include <EASTL/map.h>
+#include <EASTL/unordered_map.h>
+
+namespace Urho3D
+{
+
+/// Files changed since the previous update of FileIndex.
+struct FileIndexChanges
+{
+    /// Files that were added, removed or had their content changed.
+    StringVector changedFiles_;
+    /// Files that had only modification time changed, mapped to old and new modification time.
+    ea::unordered_map<ea::string, ea::pair<FileTime, FileTime>> touchedFiles_;
+};
+
+/// Persistent index of files in the directory: size, modification time and content hash of each file.
+/// Content is hashed only when modification time changes, so that touched files are not reported as changed.
+class FileIndex : public Object
+{
+    URHO3D_OBJECT(FileIndex, Object);
+
+public:
+    FileIndex(Context* context, const ea::string& rootPath);
+    ~FileIndex() override;
+
+    /// Update index for the file or directory (recursively) and collect changes.
+    void UpdatePath(const ea::string& resourcePath, FileIndexChanges& changes);
+    /// Return all indexed files in the file or directory (recursively).
+    StringVector GetFilesInPath(const ea::string& resourcePath) const;
+    /// Return whether the index is empty.
+    bool IsEmpty() const { return entries_.empty(); }
+
+    /// Serialize
+    /// @{
+    void SerializeInBlock(Archive& archive) override;
+    bool LoadFile(const ea::string& fileName);
+    bool SaveFile(const ea::string& fileName) const;
+    /// @}
+
+private:
+    /// Version of the file format. Increment to discard old indices.
+    static const unsigned IndexVersion = 1;
+
+    struct Entry
+    {
+        unsigned size_{};
+        FileTime modificationTime_{};
+        unsigned long long hash_{};
+
+        void SerializeInBlock(Archive& archive);
+    };
+    using EntryMap = ea::map<ea::string, Entry>;
+
+    template <class T> void ForEachEntryInPath(const ea::string& resourcePath, const T& callback) const;
+    void UpdateFile(const ea::string& resourceName, FileIndexChanges& changes);
+
+    const ea::string rootPath_;
+    EntryMap entries_;
+};
+
+}
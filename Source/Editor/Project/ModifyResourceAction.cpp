@@ -46,7 +46,7 @@ void ModifyResourceAction::AddResource(Resource* resource)
         ResourceData oldData;
         oldData.resourceType_ = resource->GetType();
         oldData.fileName_ = resource->GetAbsoluteFileName();
-        oldData.bytes_ = ea::make_shared<ByteVector>(buffer.GetBuffer());
+        oldData.snapshot_ = MakeShared<UndoSnapshot>(context_, buffer.GetBuffer());
         oldData_[resource->GetName()] = ea::move(oldData);
     }
 }
@@ -77,7 +77,7 @@ void ModifyResourceAction::Complete(bool force)
                 ResourceData newData;
                 newData.resourceType_ = oldData.resourceType_;
                 newData.fileName_ = oldData.fileName_;
-                newData.bytes_ = ea::make_shared<ByteVector>(buffer.GetBuffer());
+                newData.snapshot_ = MakeShared<UndoSnapshot>(buffer.GetBuffer(), oldData.snapshot_);
                 newData_[resourceName] = ea::move(newData);
             }
         }
@@ -89,7 +89,7 @@ void ModifyResourceAction::Complete(bool force)
     if (saveOnComplete_)
     {
         for (const auto& [resourceName, data] : newData_)
-            project_->SaveFileDelayed(data.fileName_, resourceName, data.bytes_);
+            project_->SaveFileDelayed(data.fileName_, resourceName, ea::make_shared<ByteVector>(data.snapshot_->GetData()));
     }
 }
 
@@ -110,17 +110,27 @@ bool ModifyResourceAction::MergeWith(const EditorAction& other)
     return false;
 }
 
+void ModifyResourceAction::GetSnapshots(ea::vector<UndoSnapshot*>& snapshots) const
+{
+    for (const auto& [resourceName, data] : oldData_)
+        snapshots.push_back(data.snapshot_);
+    for (const auto& [resourceName, data] : newData_)
+        snapshots.push_back(data.snapshot_);
+}
+
 void ModifyResourceAction::ApplyResourceData(const ea::string& resourceName, const ResourceData& data) const
 {
+    const auto bytes = ea::make_shared<ByteVector>(data.snapshot_->GetData());
+
     auto cache = context_->GetSubsystem<ResourceCache>();
     if (Resource* resource = cache->GetResource(data.resourceType_, resourceName, false))
     {
-        MemoryBuffer buffer{*data.bytes_};
+        MemoryBuffer buffer{*bytes};
         buffer.SetName(resourceName);
         resource->Load(buffer);
     }
 
-    project_->SaveFileDelayed(data.fileName_, resourceName, data.bytes_);
+    project_->SaveFileDelayed(data.fileName_, resourceName, bytes);
 }
 
 }
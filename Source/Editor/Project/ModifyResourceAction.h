@@ -45,6 +45,7 @@ public:
     void Redo() const override;
     void Undo() const override;
     bool MergeWith(const EditorAction& other) override;
+    void GetSnapshots(ea::vector<UndoSnapshot*>& snapshots) const override;
     /// @}
 
 private:
@@ -52,7 +53,8 @@ private:
     {
         StringHash resourceType_;
         ea::string fileName_;
-        SharedByteVector bytes_;
+        /// New data is stored as difference with the old data.
+        SharedPtr<UndoSnapshot> snapshot_;
     };
 
     void ApplyResourceData(const ea::string& resourceName, const ResourceData& data) const;
@@ -145,6 +145,18 @@ ea::pair<ea::string, ea::string> ParseCommand(const ea::string& command)
     return {commandName, commandArgs};
 }
 
+/// Return suffix of cache file names for non-empty flavor, e.g. "-platform_mobile".
+ea::string GetFlavorSuffix(const ApplicationFlavor& flavor)
+{
+    if (flavor.components_.empty())
+        return EMPTY_STRING;
+
+    ea::string suffix = "-";
+    for (const char ch : flavor.ToString())
+        suffix += IsAlpha(ch) || IsDigit(ch) ? ch : '_';
+    return suffix;
+}
+
 }
 
 ResourceCacheGuard::ResourceCacheGuard(Context* context)
@@ -198,19 +210,22 @@ ImFont* Project::GetMonoFont()
     return monoFont;
 }
 
-Project::Project(Context* context, const ea::string& projectPath, const ea::string& settingsJsonPath, bool isReadOnly)
+Project::Project(Context* context, const ea::string& projectPath, const ea::string& settingsJsonPath, bool isReadOnly,
+    const ProjectParameters& parameters)
     : Object(context)
     , isHeadless_(context->GetSubsystem<Engine>()->IsHeadless())
     , isReadOnly_(isReadOnly)
     , isXR_(context->GetSubsystem<Engine>()->GetParameter(EP_XR).GetBool())
+    , parameters_(parameters)
     , projectPath_(GetSanitizedPath(projectPath + "/"))
     , coreDataPath_(projectPath_ + "CoreData/")
-    , cachePath_(projectPath_ + "Cache/")
+    , cachePath_(projectPath_ + "Cache" + GetFlavorSuffix(parameters_.flavor_) + "/")
     , tempPath_(projectPath_ + "Temp/")
     , artifactsPath_(projectPath_ + "Artifacts/")
+    , assetCachePath_(projectPath_ + "AssetCache/")
     , projectJsonPath_(projectPath_ + "Project.json")
     , settingsJsonPath_(settingsJsonPath)
-    , cacheJsonPath_(projectPath_ + "Cache.json")
+    , cacheJsonPath_(projectPath_ + "Cache" + GetFlavorSuffix(parameters_.flavor_) + ".json")
     , uiIniPath_(projectPath_ + "ui.ini")
     , gitIgnorePath_(projectPath_ + ".gitignore")
     , previewPngPath_(projectPath_ + "Preview.png")
@@ -222,6 +237,7 @@ Project::Project(Context* context, const ea::string& projectPath, const ea::stri
     , pluginManager_(MakeShared<PluginManager>(context_))
     , launchManager_(MakeShared<LaunchManager>(context_))
     , toolManager_(MakeShared<ToolManager>(context_))
+    , thumbnailManager_(MakeShared<ThumbnailManager>(context_, tempPath_ + "Thumbnails/"))
     , closeDialog_(MakeShared<CloseDialog>(context_))
 {
     auto initializationGuard = ea::make_shared<int>(0);
@@ -243,6 +259,8 @@ Project::Project(Context* context, const ea::string& projectPath, const ea::stri
     EnsureDirectoryInitialized();
     InitializeResourceCache();
 
+    undoManager_->SetSpillDirectory(GetRandomTemporaryPath());
+
     // Delay asset manager creation until project is ready
     assetManager_ = MakeShared<AssetManager>(context);
     assetManager_->OnInitialized.Subscribe(this, [=](Project*) mutable { initializationGuard.reset(); });
@@ -261,6 +279,7 @@ Project::Project(Context* context, const ea::string& projectPath, const ea::stri
     projectJsonFile.LoadFile(projectJsonPath_);
     JSONInputArchive archive{&projectJsonFile};
     SerializeOptionalValue(archive, "Project", *this, AlwaysSerialize{});
+    assetManager_->SetRemoteCache(remoteAssetCache_);
 
     if (firstInitialization_)
         InitializeDefaultProject();
@@ -281,6 +300,7 @@ void Project::SerializeInBlock(Archive& archive)
 {
     SerializeOptionalValue(archive, "PluginManager", *pluginManager_, AlwaysSerialize{});
     SerializeOptionalValue(archive, "LaunchManager", *launchManager_, AlwaysSerialize{});
+    SerializeOptionalValue(archive, "RemoteAssetCache", remoteAssetCache_);
 }
 
 void Project::ExecuteCommand(const ea::string& command, bool exitOnCompletion)
@@ -302,7 +322,7 @@ bool Project::ExecuteRemoteCommand(const ea::string& command, ea::string* output
     auto fileSystem = context_->GetSubsystem<FileSystem>();
     auto engine = context_->GetSubsystem<Engine>();
 
-    const StringVector arguments = {
+    StringVector arguments = {
         "--quiet",
         "--log",
         "ERROR",
@@ -316,6 +336,13 @@ bool Project::ExecuteRemoteCommand(const ea::string& command, ea::string* output
         projectPath_,
     };
 
+    // Workers should write to the same cache folder
+    if (!parameters_.flavor_.components_.empty())
+    {
+        arguments.insert(arguments.end() - 1, "--flavor");
+        arguments.insert(arguments.end() - 1, parameters_.flavor_.ToString());
+    }
+
     ea::string tempOutput;
     ea::string& effectiveOutput = output ? *output : tempOutput;
 
@@ -330,6 +357,12 @@ bool Project::ExecuteRemoteCommand(const ea::string& command, ea::string* output
     return true;
 }
 
+void Project::SetExitCode(int exitCode)
+{
+    if (exitCode != 0)
+        exitCode_ = exitCode;
+}
+
 void Project::ExecuteRemoteCommandAsync(const ea::string& command, CommandExecutedCallback callback)
 {
     PendingRemoteCommand remoteCommand;
@@ -350,6 +383,9 @@ void Project::Destroy()
 
     ProcessDelayedSaves(true);
 
+    // Release asset processing callback so the external workers, if any, are shut down
+    assetManager_->SetProcessCallback(nullptr);
+
     context_->RemoveSubsystem<PluginManager>();
     context_->RegisterSubsystem<PluginManager>();
 }
@@ -707,6 +743,11 @@ void Project::SaveGitIgnore()
     content += "# Ignore asset cache\n";
     content += "/Cache/\n";
     content += "/Cache.json\n";
+    content += "/CacheIndex.bin\n";
+    content += "/Cache-*/\n";
+    content += "/Cache-*.json\n";
+    content += "/Cache-*Index.bin\n";
+    content += "/AssetCache/\n";
     content += "\n";
 
     content += "# Ignore temporary files\n";
@@ -767,6 +808,8 @@ void Project::Render()
     }
 
     assetManager_->Update();
+    if (!isHeadless_)
+        thumbnailManager_->Update();
 
     bool initialFocusPending = false;
     if (!initialized_ && initializationGuard_.expired())
@@ -22,14 +22,17 @@
 
 #pragma once
 
+#include "../Project/AssetCache.h"
 #include "../Project/CloseDialog.h"
 #include "../Project/EditorTab.h"
 #include "../Project/LaunchManager.h"
 #include "../Project/ProjectRequest.h"
+#include "../Project/ThumbnailManager.h"
 #include "../Project/ToolManager.h"
 
 #include <Urho3D/IO/MountPoint.h>
 #include <Urho3D/Core/Object.h>
+#include <Urho3D/Engine/ApplicationFlavor.h>
 #include <Urho3D/IO/File.h>
 #include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/Plugins/PluginManager.h>
@@ -93,6 +96,16 @@ struct AnalyzeFileContext
     bool HasXMLRoot(std::initializer_list<ea::string_view> roots) const;
 };
 
+/// Project parameters that are usually configured from the command line.
+struct ProjectParameters
+{
+    /// Flavor used to process assets. Non-empty flavor uses its own cache folder,
+    /// so different flavors of the same project can be processed concurrently.
+    ApplicationFlavor flavor_;
+    /// Max number of asset worker processes. 0 to use number of logical CPUs.
+    unsigned maxAssetWorkers_{};
+};
+
 /// Main class for all Editor logic related to the project folder.
 class Project : public Object
 {
@@ -111,7 +124,8 @@ public:
     Signal<void(ProjectRequest*)> OnRequest;
     Signal<void(const ea::string& command, const ea::string& args, bool& processed)> OnCommand;
 
-    Project(Context* context, const ea::string& projectPath, const ea::string& settingsJsonPath, bool isReadOnly);
+    Project(Context* context, const ea::string& projectPath, const ea::string& settingsJsonPath, bool isReadOnly,
+        const ProjectParameters& parameters = {});
     ~Project() override;
     void SerializeInBlock(Archive& archive) override;
 
@@ -196,9 +210,15 @@ public:
     const ea::string& GetDataPath() const { return dataPath_; }
     const ea::string& GetCachePath() const { return cachePath_; }
     const ea::string& GetArtifactsPath() const { return artifactsPath_; }
+    const ea::string& GetAssetCachePath() const { return assetCachePath_; }
     const ea::string& GetPreviewPngPath() const { return previewPngPath_; }
+    const ProjectParameters& GetParameters() const { return parameters_; }
     /// @}
 
+    /// Set exit code of the application. Only non-zero code overrides previous value.
+    void SetExitCode(int exitCode);
+    int GetExitCode() const { return exitCode_; }
+
     /// Return singletons
     /// @{
     AssetManager* GetAssetManager() const { return assetManager_; }
@@ -208,6 +228,7 @@ public:
     PluginManager* GetPluginManager() const { return pluginManager_; }
     LaunchManager* GetLaunchManager() const { return launchManager_; }
     ToolManager* GetToolManager() const { return toolManager_; }
+    ThumbnailManager* GetThumbnailManager() const { return thumbnailManager_; }
     /// @}
 
     /// Internal
@@ -264,6 +285,7 @@ private:
     const bool isHeadless_{};
     const bool isReadOnly_{};
     const bool isXR_{};
+    const ProjectParameters parameters_;
     const unsigned saveDelayMs_{3000};
 
     const ea::string projectPath_;
@@ -272,6 +294,7 @@ private:
     const ea::string cachePath_;
     const ea::string tempPath_;
     const ea::string artifactsPath_;
+    const ea::string assetCachePath_;
 
     const ea::string projectJsonPath_;
     const ea::string settingsJsonPath_;
@@ -292,6 +315,8 @@ private:
     SharedPtr<PluginManager> pluginManager_;
     SharedPtr<LaunchManager> launchManager_;
     SharedPtr<ToolManager> toolManager_;
+    SharedPtr<ThumbnailManager> thumbnailManager_;
+    RemoteAssetCacheSettings remoteAssetCache_;
 
     bool assetManagerInitialized_{};
     ea::weak_ptr<void> initializationGuard_;
@@ -322,6 +347,9 @@ private:
     CloseProjectResult closeProjectResult_{};
     /// @}
 
+    /// Exit code reported to the application on close.
+    int exitCode_{};
+
     /// UI state
     /// @{
     bool pendingResetLayout_{};
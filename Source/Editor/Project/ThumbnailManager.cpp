@@ -0,0 +1,447 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Project/ThumbnailManager.h"
+
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/Light.h>
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Graphics/Texture2D.h>
+#include <Urho3D/Graphics/Zone.h>
+#include <Urho3D/IO/ContentHash.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Resource/Image.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Resource/ResourceEvents.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Utility/SceneRendererToTexture.h>
+
+#include <EASTL/sort.h>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Version of thumbnail generation, change it to invalidate cached thumbnails.
+const unsigned long long ThumbnailVersion = 1;
+/// Number of bytes checked to find out whether XML file is a material.
+const unsigned MaterialHeaderSize = 1024;
+
+SharedPtr<Image> LoadCachedThumbnail(Context* context, const ea::string& fileName)
+{
+    auto fs = context->GetSubsystem<FileSystem>();
+    if (!fs->FileExists(fileName))
+        return nullptr;
+
+    File file(context, fileName, FILE_READ);
+    auto image = MakeShared<Image>(context);
+    return file.IsOpen() && image->Load(file) ? image : nullptr;
+}
+
+bool IsMaterialFile(Deserializer& source)
+{
+    char buffer[MaterialHeaderSize];
+    const unsigned size = source.Read(buffer, MaterialHeaderSize);
+    return ea::string_view(buffer, size).find("<material") != ea::string_view::npos;
+}
+
+SharedPtr<Image> CreateTextureThumbnail(Context* context, Deserializer& source, unsigned thumbnailSize)
+{
+    auto image = MakeShared<Image>(context);
+    if (!image->Load(source) || image->GetDepth() > 1)
+        return nullptr;
+
+    if (image->IsCompressed())
+    {
+        image = image->GetDecompressedImage();
+        if (!image)
+            return nullptr;
+    }
+
+    // Keep aspect ratio of the texture
+    const int maxSide = ea::max(image->GetWidth(), image->GetHeight());
+    if (maxSide > static_cast<int>(thumbnailSize))
+    {
+        const float scale = static_cast<float>(thumbnailSize) / maxSide;
+        const int width = ea::max(1, RoundToInt(image->GetWidth() * scale));
+        const int height = ea::max(1, RoundToInt(image->GetHeight() * scale));
+        if (!image->Resize(width, height))
+            return nullptr;
+    }
+    return image;
+}
+
+SharedPtr<Texture2D> CreateThumbnailTexture(Context* context, Image* image)
+{
+    auto texture = MakeShared<Texture2D>(context);
+    texture->SetNumLevels(1);
+    return texture->SetData(image) ? texture : nullptr;
+}
+
+}
+
+ThumbnailManager::ThumbnailManager(Context* context, const ea::string& cachePath)
+    : Object(context)
+    , cachePath_(cachePath)
+{
+    auto fs = GetSubsystem<FileSystem>();
+    if (!fs->DirExists(cachePath_))
+        fs->CreateDirsRecursive(cachePath_);
+
+    SubscribeToEvent(E_RESOURCEBACKGROUNDLOADED, &ThumbnailManager::HandleResourceLoaded);
+    SubscribeToEvent(E_FILECHANGED,
+        [this](VariantMap& eventData) { InvalidateThumbnail(eventData[FileChanged::P_RESOURCENAME].GetString()); });
+}
+
+ThumbnailManager::~ThumbnailManager() = default;
+
+ThumbnailType ThumbnailManager::GetThumbnailType(const ea::string& resourceName)
+{
+    static const ea::string textureExtensions[] = {
+        ".png", ".jpg", ".jpeg", ".tga", ".bmp", ".dds", ".ktx", ".pvr", ".hdr", ".webp"};
+
+    const ea::string extension = GetExtension(resourceName);
+    if (extension == ".mdl")
+        return ThumbnailType::Model;
+    if (extension == ".xml")
+        return ThumbnailType::Material;
+    if (ea::find(ea::begin(textureExtensions), ea::end(textureExtensions), extension) != ea::end(textureExtensions))
+        return ThumbnailType::Texture;
+    return ThumbnailType::None;
+}
+
+Texture2D* ThumbnailManager::GetThumbnail(const ea::string& resourceName)
+{
+    Thumbnail& thumbnail = thumbnails_[resourceName];
+    if (thumbnail.requestId_ == 0)
+    {
+        thumbnail.requestId_ = ++nextRequestId_;
+        thumbnail.type_ = GetThumbnailType(resourceName);
+        if (thumbnail.type_ != ThumbnailType::None)
+            queue_.push_back(resourceName);
+        else
+            thumbnail.state_ = ThumbnailState::Failed;
+    }
+
+    thumbnail.lastUsedFrame_ = frameNumber_;
+    return thumbnail.state_ == ThumbnailState::Ready ? thumbnail.texture_.Get() : nullptr;
+}
+
+void ThumbnailManager::InvalidateThumbnail(const ea::string& resourceName)
+{
+    // Results of ongoing requests are ignored because the request identifier is not found anymore
+    thumbnails_.erase(resourceName);
+}
+
+void ThumbnailManager::Update()
+{
+    ++frameNumber_;
+
+    // Render at most one thumbnail per frame, it takes one frame for the rendering to happen
+    if (!renderingResource_.empty())
+    {
+        if (frameNumber_ > renderingFrame_)
+            EndRender();
+    }
+    else
+    {
+        while (!renderQueue_.empty() && renderingResource_.empty())
+        {
+            const ea::string resourceName = renderQueue_.back();
+            renderQueue_.pop_back();
+
+            const auto iter = thumbnails_.find(resourceName);
+            if (iter == thumbnails_.end() || iter->second.state_ != ThumbnailState::ReadyToRender)
+                continue;
+
+            if (!BeginRender(resourceName, iter->second))
+                iter->second.state_ = ThumbnailState::Failed;
+        }
+    }
+
+    while (numPendingLoads_ < maxPendingLoads_ && !queue_.empty())
+    {
+        const ea::string resourceName = queue_.back();
+        queue_.pop_back();
+
+        const auto iter = thumbnails_.find(resourceName);
+        if (iter == thumbnails_.end() || iter->second.state_ != ThumbnailState::Queued)
+            continue;
+
+        // Skip resources that went out of sight while waiting in the queue
+        if (frameNumber_ - iter->second.lastUsedFrame_ > 1)
+        {
+            thumbnails_.erase(iter);
+            continue;
+        }
+
+        QueueLoad(resourceName, iter->second);
+    }
+
+    EvictThumbnails();
+}
+
+void ThumbnailManager::QueueLoad(const ea::string& resourceName, Thumbnail& thumbnail)
+{
+    thumbnail.state_ = ThumbnailState::Loading;
+    ++numPendingLoads_;
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    Context* context = context_;
+    const ea::string cachePath = cachePath_;
+    const unsigned thumbnailSize = thumbnailSize_;
+    const unsigned requestId = thumbnail.requestId_;
+    const ThumbnailType requestedType = thumbnail.type_;
+    const WeakPtr<ThumbnailManager> weakSelf{this};
+
+    // Hashing and decoding are performed in the worker thread, only texture upload happens in the main thread
+    workQueue->PostTask([=]()
+    {
+        auto cache = context->GetSubsystem<ResourceCache>();
+
+        ThumbnailType type = ThumbnailType::None;
+        ea::string cacheFileName;
+        SharedPtr<Image> image;
+        if (AbstractFilePtr file = cache->GetFile(resourceName, false))
+        {
+            ContentHasher hasher(ThumbnailVersion);
+            hasher.Append(thumbnailSize);
+            hasher.Append(*file);
+            cacheFileName = Format("{}{}.png", cachePath, hasher.ToString());
+
+            type = requestedType;
+            image = LoadCachedThumbnail(context, cacheFileName);
+            file->Seek(0);
+
+            if (!image && type == ThumbnailType::Material && !IsMaterialFile(*file))
+                type = ThumbnailType::None;
+            else if (!image && type == ThumbnailType::Texture)
+            {
+                image = CreateTextureThumbnail(context, *file, thumbnailSize);
+                if (image)
+                    image->SavePNG(cacheFileName);
+                else
+                    type = ThumbnailType::None;
+            }
+        }
+
+        workQueue->PostTaskForMainThread([=]()
+        {
+            if (weakSelf)
+                weakSelf->FinishLoad(resourceName, requestId, type, cacheFileName, image);
+        });
+    });
+}
+
+void ThumbnailManager::FinishLoad(const ea::string& resourceName, unsigned requestId, ThumbnailType type,
+    const ea::string& cacheFileName, Image* image)
+{
+    --numPendingLoads_;
+
+    const auto iter = thumbnails_.find(resourceName);
+    if (iter == thumbnails_.end() || iter->second.requestId_ != requestId)
+        return;
+
+    Thumbnail& thumbnail = iter->second;
+    thumbnail.type_ = type;
+    thumbnail.cacheFileName_ = cacheFileName;
+
+    if (image)
+    {
+        thumbnail.texture_ = CreateThumbnailTexture(context_, image);
+        thumbnail.state_ = thumbnail.texture_ ? ThumbnailState::Ready : ThumbnailState::Failed;
+    }
+    else if (type == ThumbnailType::Model || type == ThumbnailType::Material)
+        RequestResource(resourceName, thumbnail);
+    else
+        thumbnail.state_ = ThumbnailState::Failed;
+}
+
+void ThumbnailManager::RequestResource(const ea::string& resourceName, Thumbnail& thumbnail)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+    const StringHash resourceType =
+        thumbnail.type_ == ThumbnailType::Model ? Model::GetTypeStatic() : Material::GetTypeStatic();
+
+    if (cache->GetExistingResource(resourceType, resourceName))
+    {
+        thumbnail.state_ = ThumbnailState::ReadyToRender;
+        renderQueue_.push_back(resourceName);
+    }
+    else if (cache->BackgroundLoadResource(resourceType, resourceName))
+        thumbnail.state_ = ThumbnailState::WaitingForResource;
+    else
+        thumbnail.state_ = ThumbnailState::Failed;
+}
+
+void ThumbnailManager::HandleResourceLoaded(StringHash eventType, VariantMap& eventData)
+{
+    using namespace ResourceBackgroundLoaded;
+
+    const ea::string& resourceName = eventData[P_RESOURCENAME].GetString();
+    const auto iter = thumbnails_.find(resourceName);
+    if (iter == thumbnails_.end() || iter->second.state_ != ThumbnailState::WaitingForResource)
+        return;
+
+    if (eventData[P_SUCCESS].GetBool())
+    {
+        iter->second.state_ = ThumbnailState::ReadyToRender;
+        renderQueue_.push_back(resourceName);
+    }
+    else
+        iter->second.state_ = ThumbnailState::Failed;
+}
+
+bool ThumbnailManager::BeginRender(const ea::string& resourceName, Thumbnail& thumbnail)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+
+    CreatePreviewScene();
+    if (thumbnail.type_ == ThumbnailType::Model)
+    {
+        auto model = cache->GetExistingResource<Model>(resourceName);
+        if (!model)
+            return false;
+        previewModel_->SetModel(model);
+    }
+    else
+    {
+        auto material = cache->GetExistingResource<Material>(resourceName);
+        if (!material)
+            return false;
+        previewModel_->SetModel(cache->GetResource<Model>("Models/Sphere.mdl"));
+        previewModel_->SetMaterial(material);
+    }
+
+    const Model* model = previewModel_->GetModel();
+    if (!model)
+        return false;
+
+    // Fit bounding sphere of the model into the view
+    const BoundingBox& boundingBox = model->GetBoundingBox();
+    const float radius = ea::max(boundingBox.Size().Length() * 0.5f, M_EPSILON);
+    Camera* camera = renderer_->GetCamera();
+    const float distance = radius / Sin(camera->GetFov() * 0.5f);
+    const Vector3 direction = Vector3(-1.0f, 1.0f, -1.0f).Normalized();
+
+    Node* cameraNode = renderer_->GetCameraNode();
+    cameraNode->SetPosition(boundingBox.Center() + direction * distance);
+    cameraNode->LookAt(boundingBox.Center());
+    camera->SetNearClip(ea::max(distance - radius, distance * 0.01f));
+    camera->SetFarClip(distance + radius);
+
+    renderer_->Update();
+    RenderSurface* renderSurface = renderer_->GetTexture()->GetRenderSurface();
+    if (!renderSurface)
+        return false;
+    renderSurface->QueueUpdate();
+
+    renderingResource_ = resourceName;
+    renderingRequestId_ = thumbnail.requestId_;
+    renderingFrame_ = frameNumber_;
+    return true;
+}
+
+void ThumbnailManager::EndRender()
+{
+    const ea::string resourceName = ea::move(renderingResource_);
+    renderingResource_.clear();
+
+    SharedPtr<Image> image = renderer_->GetTexture()->GetImage();
+    previewModel_->SetModel(nullptr);
+
+    const auto iter = thumbnails_.find(resourceName);
+    if (iter == thumbnails_.end() || iter->second.requestId_ != renderingRequestId_)
+        return;
+
+    Thumbnail& thumbnail = iter->second;
+    thumbnail.texture_ = image ? CreateThumbnailTexture(context_, image) : nullptr;
+    thumbnail.state_ = thumbnail.texture_ ? ThumbnailState::Ready : ThumbnailState::Failed;
+    if (!thumbnail.texture_)
+    {
+        URHO3D_LOGWARNING("Cannot render thumbnail of '{}'", resourceName);
+        return;
+    }
+
+    // Encoding is slow, save the thumbnail in the worker thread
+    auto workQueue = GetSubsystem<WorkQueue>();
+    const ea::string cacheFileName = thumbnail.cacheFileName_;
+    workQueue->PostTask([=]() { image->SavePNG(cacheFileName); });
+}
+
+void ThumbnailManager::CreatePreviewScene()
+{
+    if (previewScene_)
+        return;
+
+    previewScene_ = MakeShared<Scene>(context_);
+    previewScene_->CreateComponent<Octree>();
+
+    auto zone = previewScene_->CreateComponent<Zone>();
+    zone->SetBoundingBox(BoundingBox(-M_LARGE_VALUE, M_LARGE_VALUE));
+    zone->SetAmbientColor(Color(0.4f, 0.4f, 0.4f));
+    zone->SetFogColor(Color(0.15f, 0.15f, 0.15f));
+
+    Node* lightNode = previewScene_->CreateChild("DirectionalLight");
+    lightNode->LookAt(Vector3(1.0f, -1.0f, 1.0f));
+    auto light = lightNode->CreateComponent<Light>();
+    light->SetLightType(LIGHT_DIRECTIONAL);
+
+    previewNode_ = previewScene_->CreateChild("Preview");
+    previewModel_ = previewNode_->CreateComponent<StaticModel>();
+
+    renderer_ = MakeShared<SceneRendererToTexture>(previewScene_);
+    renderer_->SetTextureSize(IntVector2::ONE * static_cast<int>(thumbnailSize_));
+    renderer_->SetActive(false);
+}
+
+void ThumbnailManager::EvictThumbnails()
+{
+    if (thumbnails_.size() <= maxThumbnails_)
+        return;
+
+    // Only finished thumbnails that were not used in this frame may be removed
+    ea::vector<ea::pair<unsigned, ea::string>> candidates;
+    for (const auto& [resourceName, thumbnail] : thumbnails_)
+    {
+        const bool isFinished =
+            thumbnail.state_ == ThumbnailState::Ready || thumbnail.state_ == ThumbnailState::Failed;
+        if (isFinished && thumbnail.lastUsedFrame_ != frameNumber_)
+            candidates.emplace_back(thumbnail.lastUsedFrame_, resourceName);
+    }
+
+    ea::sort(candidates.begin(), candidates.end());
+    const unsigned numExcess = ea::min<unsigned>(thumbnails_.size() - maxThumbnails_, candidates.size());
+    for (unsigned i = 0; i < numExcess; ++i)
+        thumbnails_.erase(candidates[i].second);
+}
+
+}
@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include <Urho3D/Core/Object.h>
+
+#include <EASTL/unordered_map.h>
+
+namespace Urho3D
+{
+
+class Image;
+class Node;
+class Resource;
+class Scene;
+class SceneRendererToTexture;
+class StaticModel;
+class Texture2D;
+
+/// Type of the thumbnail, depends on the resource.
+enum class ThumbnailType
+{
+    None,
+    Texture,
+    Model,
+    Material,
+};
+
+/// Generates small previews of textures, models and materials.
+/// Thumbnails are cached on disk by the content hash of the resource file. Files are hashed and images are decoded
+/// in worker threads. Models and materials are loaded in background and rendered offscreen, one per frame.
+class ThumbnailManager : public Object
+{
+    URHO3D_OBJECT(ThumbnailManager, Object);
+
+public:
+    /// Default size of the thumbnail in pixels.
+    static const unsigned DefaultThumbnailSize = 128;
+    /// Default number of thumbnails that may be loaded in worker threads at once.
+    static const unsigned DefaultMaxPendingLoads = 4;
+    /// Default number of thumbnails kept in memory.
+    static const unsigned DefaultMaxThumbnails = 512;
+
+    ThumbnailManager(Context* context, const ea::string& cachePath);
+    ~ThumbnailManager() override;
+
+    /// Return thumbnail of the resource if it is ready, queue it otherwise.
+    Texture2D* GetThumbnail(const ea::string& resourceName);
+    /// Forget thumbnail of the resource so it is generated again on the next request.
+    void InvalidateThumbnail(const ea::string& resourceName);
+    /// Process queued thumbnails. Should be called once per frame.
+    void Update();
+
+    /// Return type of the thumbnail judging by the resource name. XML files may turn out to be materials.
+    static ThumbnailType GetThumbnailType(const ea::string& resourceName);
+
+    /// Set max number of thumbnails loaded in worker threads at once.
+    void SetMaxPendingLoads(unsigned count) { maxPendingLoads_ = ea::max(count, 1u); }
+    /// Return max number of thumbnails loaded in worker threads at once.
+    unsigned GetMaxPendingLoads() const { return maxPendingLoads_; }
+    /// Set number of thumbnails kept in memory.
+    void SetMaxThumbnails(unsigned count) { maxThumbnails_ = ea::max(count, 1u); }
+    /// Return number of thumbnails kept in memory.
+    unsigned GetMaxThumbnails() const { return maxThumbnails_; }
+
+    /// Return size of thumbnails in pixels.
+    unsigned GetThumbnailSize() const { return thumbnailSize_; }
+    /// Return path where thumbnails are cached.
+    const ea::string& GetCachePath() const { return cachePath_; }
+
+private:
+    enum class ThumbnailState
+    {
+        Queued,
+        Loading,
+        WaitingForResource,
+        ReadyToRender,
+        Ready,
+        Failed,
+    };
+
+    struct Thumbnail
+    {
+        ThumbnailType type_{};
+        ThumbnailState state_{};
+        /// Identifier of the request, used to ignore results of the invalidated requests.
+        unsigned requestId_{};
+        /// File name of the cached thumbnail.
+        ea::string cacheFileName_;
+        SharedPtr<Texture2D> texture_;
+        unsigned lastUsedFrame_{};
+    };
+
+    /// Start hashing and loading the thumbnail in the worker thread.
+    void QueueLoad(const ea::string& resourceName, Thumbnail& thumbnail);
+    /// Apply the thumbnail loaded in the worker thread.
+    void FinishLoad(const ea::string& resourceName, unsigned requestId, ThumbnailType type,
+        const ea::string& cacheFileName, Image* image);
+    /// Request the resource to render the thumbnail from.
+    void RequestResource(const ea::string& resourceName, Thumbnail& thumbnail);
+    void HandleResourceLoaded(StringHash eventType, VariantMap& eventData);
+
+    /// Setup preview scene for the thumbnail.
+    bool BeginRender(const ea::string& resourceName, Thumbnail& thumbnail);
+    /// Read back the rendered thumbnail and store it.
+    void EndRender();
+    void CreatePreviewScene();
+
+    /// Remove the least recently used thumbnails if there are too many.
+    void EvictThumbnails();
+
+    const ea::string cachePath_;
+    const unsigned thumbnailSize_{DefaultThumbnailSize};
+    unsigned maxPendingLoads_{DefaultMaxPendingLoads};
+    unsigned maxThumbnails_{DefaultMaxThumbnails};
+
+    ea::unordered_map<ea::string, Thumbnail> thumbnails_;
+    /// Resources with queued thumbnails, the most recently requested last.
+    ea::vector<ea::string> queue_;
+    /// Resources loaded and waiting to be rendered.
+    ea::vector<ea::string> renderQueue_;
+    unsigned numPendingLoads_{};
+    unsigned frameNumber_{};
+    unsigned nextRequestId_{};
+
+    SharedPtr<Scene> previewScene_;
+    Node* previewNode_{};
+    StaticModel* previewModel_{};
+    SharedPtr<SceneRendererToTexture> renderer_;
+    /// Resource whose thumbnail is being rendered, if any.
+    ea::string renderingResource_;
+    unsigned renderingRequestId_{};
+    unsigned renderingFrame_{};
+};
+
+}
@@ -343,6 +343,24 @@ TEST_CASE("Simultanious *By tweening")
     CHECK(rotatedNode->GetRotation().Equals(Quaternion(20, Vector3::RIGHT) * Quaternion(20, Vector3::UP)));
 }
 
+TEST_CASE("MoveBy tweening keeps external node movement")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto actionManager = context->GetSubsystem<ActionManager>();
+    auto node = MakeShared<Node>(context);
+    ActionBuilder(context).MoveBy(1.0f, Vector3(10, 0, 0)).Run(node);
+
+    actionManager->Update(0.0f);
+    actionManager->Update(0.5f);
+    CHECK(node->GetPosition().Equals(Vector3(5, 0, 0)));
+
+    // Node is moved by someone else while the action is running
+    node->Translate(Vector3(0, 3, 0));
+    actionManager->Update(1.0f);
+    CHECK(node->GetPosition().Equals(Vector3(10, 3, 0)));
+}
+
 TEST_CASE("Repeat MoveBy")
 {
     auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
@@ -0,0 +1,597 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+#include "BenchmarkUtils.h"
+
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Resource/Image.h>
+#include <Urho3D/Resource/JSONFile.h>
+#include <Urho3D/Utility/GLTFImporter.h>
+
+#include <EASTL/sort.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+
+/// Parameters of synthetic corpus, may be overridden by environment variables.
+/// Reference corpus is used instead if URHO3D_BENCHMARK_ASSET_CORPUS points to the directory with glTF files.
+struct AssetCorpusParameters
+{
+    unsigned numSceneMeshes_{};
+    unsigned numSceneNodes_{};
+    unsigned meshResolution_{};
+    unsigned numBones_{};
+    unsigned numAnimations_{};
+    unsigned numKeyFrames_{};
+    unsigned numTextures_{};
+    unsigned textureSize_{};
+    unsigned numIterations_{};
+};
+
+AssetCorpusParameters GetAssetCorpusParameters()
+{
+    AssetCorpusParameters params;
+    params.numSceneMeshes_ = Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_ASSET_MESHES", 200u);
+    params.numSceneNodes_ = Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_ASSET_NODES", 2000u);
+    params.meshResolution_ = ea::max(1u, Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_ASSET_MESH_RESOLUTION", 32u));
+    params.numBones_ = ea::max(1u, Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_ASSET_BONES", 64u));
+    params.numAnimations_ = Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_ASSET_ANIMATIONS", 50u);
+    params.numKeyFrames_ = ea::max(2u, Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_ASSET_KEY_FRAMES", 120u));
+    params.numTextures_ = Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_ASSET_TEXTURES", 8u);
+    params.textureSize_ = ea::max(4u, Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_ASSET_TEXTURE_SIZE", 1024u));
+    params.numIterations_ = ea::max(1u, Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_ASSET_ITERATIONS", 3u));
+    return params;
+}
+
+const unsigned COMPONENT_UNSIGNED_SHORT = 5123;
+const unsigned COMPONENT_UNSIGNED_INT = 5125;
+const unsigned COMPONENT_FLOAT = 5126;
+const unsigned TARGET_ARRAY_BUFFER = 34962;
+const unsigned TARGET_ELEMENT_ARRAY_BUFFER = 34963;
+
+JSONArray ToJSONArray(std::initializer_list<float> values)
+{
+    JSONArray result;
+    for (float value : values)
+        result.push_back(value);
+    return result;
+}
+
+/// Writes glTF file with all binary data stored in one external buffer.
+class SyntheticGLTFWriter
+{
+public:
+    /// Add accessor for tightly packed data. Return accessor index.
+    unsigned AddAccessor(const void* data, unsigned count, unsigned elementSize, unsigned componentType,
+        const char* type, unsigned target = 0, const JSONValue& min = {}, const JSONValue& max = {})
+    {
+        const unsigned offset = buffer_.size();
+        const auto bytes = static_cast<const unsigned char*>(data);
+        buffer_.insert(buffer_.end(), bytes, bytes + count * elementSize);
+        buffer_.resize((buffer_.size() + 3u) & ~3u);
+
+        JSONObject bufferView;
+        bufferView["buffer"] = 0u;
+        bufferView["byteOffset"] = offset;
+        bufferView["byteLength"] = count * elementSize;
+        if (target != 0)
+            bufferView["target"] = target;
+        bufferViews_.push_back(bufferView);
+
+        JSONObject accessor;
+        accessor["bufferView"] = static_cast<unsigned>(bufferViews_.size() - 1);
+        accessor["componentType"] = componentType;
+        accessor["count"] = count;
+        accessor["type"] = type;
+        if (!min.IsNull())
+            accessor["min"] = min;
+        if (!max.IsNull())
+            accessor["max"] = max;
+        accessors_.push_back(accessor);
+        return accessors_.size() - 1;
+    }
+
+    /// Add grid mesh on XY plane with given number of quads per side. Return mesh index.
+    unsigned AddGridMesh(unsigned resolution, float width, float height, int material, unsigned numBones = 0)
+    {
+        const unsigned numSideVertices = resolution + 1;
+        ea::vector<Vector3> positions;
+        ea::vector<Vector3> normals;
+        ea::vector<Vector2> uvs;
+        ea::vector<unsigned short> joints;
+        ea::vector<Vector4> weights;
+        for (unsigned y = 0; y < numSideVertices; ++y)
+        {
+            for (unsigned x = 0; x < numSideVertices; ++x)
+            {
+                const Vector2 uv{static_cast<float>(x) / resolution, static_cast<float>(y) / resolution};
+                positions.emplace_back((uv.x_ - 0.5f) * width, uv.y_ * height, 0.0f);
+                normals.push_back(Vector3::BACK);
+                uvs.emplace_back(uv.x_, 1.0f - uv.y_);
+                if (numBones > 0)
+                {
+                    const auto bone = static_cast<unsigned short>(ea::min(numBones - 1, static_cast<unsigned>(uv.y_ * numBones)));
+                    joints.push_back(bone);
+                    joints.resize(joints.size() + 3, 0);
+                    weights.push_back(Vector4{1.0f, 0.0f, 0.0f, 0.0f});
+                }
+            }
+        }
+
+        ea::vector<unsigned> indices;
+        for (unsigned y = 0; y < resolution; ++y)
+        {
+            for (unsigned x = 0; x < resolution; ++x)
+            {
+                const unsigned i = y * numSideVertices + x;
+                const unsigned quad[] = {i, i + 1, i + numSideVertices, i + 1, i + numSideVertices + 1, i + numSideVertices};
+                indices.insert(indices.end(), ea::begin(quad), ea::end(quad));
+            }
+        }
+
+        const unsigned numVertices = positions.size();
+        JSONObject attributes;
+        attributes["POSITION"] = AddAccessor(positions.data(), numVertices, sizeof(Vector3), COMPONENT_FLOAT, "VEC3",
+            TARGET_ARRAY_BUFFER, ToJSONArray({-0.5f * width, 0.0f, 0.0f}), ToJSONArray({0.5f * width, height, 0.0f}));
+        attributes["NORMAL"] = AddAccessor(normals.data(), numVertices, sizeof(Vector3), COMPONENT_FLOAT, "VEC3", TARGET_ARRAY_BUFFER);
+        attributes["TEXCOORD_0"] = AddAccessor(uvs.data(), numVertices, sizeof(Vector2), COMPONENT_FLOAT, "VEC2", TARGET_ARRAY_BUFFER);
+        if (numBones > 0)
+        {
+            attributes["JOINTS_0"] = AddAccessor(joints.data(), numVertices, 4 * sizeof(unsigned short),
+                COMPONENT_UNSIGNED_SHORT, "VEC4", TARGET_ARRAY_BUFFER);
+            attributes["WEIGHTS_0"] = AddAccessor(weights.data(), numVertices, sizeof(Vector4), COMPONENT_FLOAT, "VEC4", TARGET_ARRAY_BUFFER);
+        }
+
+        JSONObject primitive;
+        primitive["attributes"] = attributes;
+        primitive["indices"] = AddAccessor(indices.data(), indices.size(), sizeof(unsigned), COMPONENT_UNSIGNED_INT,
+            "SCALAR", TARGET_ELEMENT_ARRAY_BUFFER);
+        if (material >= 0)
+            primitive["material"] = material;
+
+        JSONObject mesh;
+        mesh["primitives"] = JSONArray{primitive};
+        meshes_.push_back(mesh);
+        return meshes_.size() - 1;
+    }
+
+    /// Add material with base color texture. Image file should be stored next to glTF file.
+    unsigned AddTexturedMaterial(const ea::string& imageFileName)
+    {
+        JSONObject image;
+        image["uri"] = imageFileName;
+        images_.push_back(image);
+
+        JSONObject texture;
+        texture["source"] = static_cast<unsigned>(images_.size() - 1);
+        textures_.push_back(texture);
+
+        JSONObject baseColorTexture;
+        baseColorTexture["index"] = static_cast<unsigned>(textures_.size() - 1);
+        JSONObject pbr;
+        pbr["baseColorTexture"] = baseColorTexture;
+        JSONObject material;
+        material["name"] = Format("Material{}", materials_.size());
+        material["pbrMetallicRoughness"] = pbr;
+        materials_.push_back(material);
+        return materials_.size() - 1;
+    }
+
+    /// Add node. Return node index.
+    unsigned AddNode(const ea::string& name, const Vector3& translation, int mesh = -1, int skin = -1)
+    {
+        JSONObject node;
+        node["name"] = name;
+        node["translation"] = ToJSONArray({translation.x_, translation.y_, translation.z_});
+        if (mesh >= 0)
+            node["mesh"] = mesh;
+        if (skin >= 0)
+            node["skin"] = skin;
+        nodes_.push_back(node);
+        return nodes_.size() - 1;
+    }
+
+    void AddChild(unsigned parent, unsigned child)
+    {
+        JSONValue& node = nodes_[parent];
+        JSONArray children = node.Get("children").GetArray();
+        children.push_back(child);
+        node.Set("children", children);
+    }
+
+    void AddRootNode(unsigned node) { rootNodes_.push_back(node); }
+
+    void AddSkin(const JSONArray& joints, const ea::vector<Matrix4>& inverseBindMatrices)
+    {
+        // glTF matrices are column-major
+        ea::vector<Matrix4> transposedMatrices;
+        for (const Matrix4& matrix : inverseBindMatrices)
+            transposedMatrices.push_back(matrix.Transpose());
+
+        JSONObject skin;
+        skin["joints"] = joints;
+        skin["inverseBindMatrices"] =
+            AddAccessor(transposedMatrices.data(), transposedMatrices.size(), sizeof(Matrix4), COMPONENT_FLOAT, "MAT4");
+        skins_.push_back(skin);
+    }
+
+    void AddAnimation(const JSONObject& animation) { animations_.push_back(animation); }
+
+    bool Save(Context* context, const ea::string& fileName) const
+    {
+        const ea::string bufferFileName = ReplaceExtension(fileName, ".bin");
+
+        JSONObject asset;
+        asset["version"] = "2.0";
+        JSONObject scene;
+        scene["nodes"] = rootNodes_;
+        JSONObject buffer;
+        buffer["uri"] = GetFileNameAndExtension(bufferFileName);
+        buffer["byteLength"] = static_cast<unsigned>(buffer_.size());
+
+        JSONObject root;
+        root["asset"] = asset;
+        root["scene"] = 0u;
+        root["scenes"] = JSONArray{scene};
+        root["buffers"] = JSONArray{buffer};
+        root["bufferViews"] = bufferViews_;
+        root["accessors"] = accessors_;
+        const auto setOptional = [&](const char* name, const JSONArray& array)
+        {
+            if (!array.empty())
+                root[name] = array;
+        };
+        setOptional("nodes", nodes_);
+        setOptional("meshes", meshes_);
+        setOptional("materials", materials_);
+        setOptional("textures", textures_);
+        setOptional("images", images_);
+        setOptional("skins", skins_);
+        setOptional("animations", animations_);
+
+        auto jsonFile = MakeShared<JSONFile>(context);
+        jsonFile->GetRoot() = root;
+        File file(context, fileName, FILE_WRITE);
+        if (!file.IsOpen() || !jsonFile->Save(file))
+            return false;
+
+        File bufferFile(context, bufferFileName, FILE_WRITE);
+        return bufferFile.IsOpen() && bufferFile.Write(buffer_.data(), buffer_.size()) == buffer_.size();
+    }
+
+private:
+    ea::vector<unsigned char> buffer_;
+    JSONArray bufferViews_;
+    JSONArray accessors_;
+    JSONArray nodes_;
+    JSONArray rootNodes_;
+    JSONArray meshes_;
+    JSONArray materials_;
+    JSONArray textures_;
+    JSONArray images_;
+    JSONArray skins_;
+    JSONArray animations_;
+};
+
+/// Write reproducible noise texture.
+bool WriteNoiseTexture(Context* context, const ea::string& fileName, unsigned size, unsigned seed)
+{
+    RandomEngine random{seed};
+    ea::vector<unsigned char> data(size * size * 4);
+    for (unsigned i = 0; i < data.size(); i += 4)
+    {
+        data[i] = static_cast<unsigned char>(random.GetUInt(0, 256));
+        data[i + 1] = static_cast<unsigned char>((i / 4) % size);
+        data[i + 2] = static_cast<unsigned char>((i / 4) / size);
+        data[i + 3] = 255;
+    }
+
+    auto image = MakeShared<Image>(context);
+    image->SetSize(size, size, 4);
+    image->SetData(data.data());
+    return image->SavePNG(fileName);
+}
+
+/// Generate large scene with many meshes, nodes and textures.
+bool WriteSceneAsset(Context* context, const ea::string& path, const AssetCorpusParameters& params)
+{
+    SyntheticGLTFWriter writer;
+
+    ea::vector<unsigned> materials;
+    for (unsigned i = 0; i < params.numTextures_; ++i)
+    {
+        const ea::string imageFileName = Format("Texture{}.png", i);
+        if (!WriteNoiseTexture(context, path + imageFileName, params.textureSize_, i))
+            return false;
+        materials.push_back(writer.AddTexturedMaterial(imageFileName));
+    }
+
+    ea::vector<unsigned> meshes;
+    for (unsigned i = 0; i < params.numSceneMeshes_; ++i)
+    {
+        const int material = materials.empty() ? -1 : static_cast<int>(materials[i % materials.size()]);
+        meshes.push_back(writer.AddGridMesh(params.meshResolution_, 1.0f + i % 7, 1.0f + i % 5, material));
+    }
+
+    const unsigned rootNode = writer.AddNode("Root", Vector3::ZERO);
+    writer.AddRootNode(rootNode);
+
+    RandomEngine random{0};
+    for (unsigned i = 0; i < params.numSceneNodes_; ++i)
+    {
+        const Vector3 position{random.GetFloat(-500.0f, 500.0f), 0.0f, random.GetFloat(-500.0f, 500.0f)};
+        const int mesh = meshes.empty() ? -1 : static_cast<int>(meshes[i % meshes.size()]);
+        writer.AddChild(rootNode, writer.AddNode(Format("Node{}", i), position, mesh));
+    }
+
+    return writer.Save(context, path + "Scene.gltf");
+}
+
+/// Generate skinned character with bone chain and many animations.
+bool WriteCharacterAsset(Context* context, const ea::string& path, const AssetCorpusParameters& params)
+{
+    SyntheticGLTFWriter writer;
+
+    const float boneLength = 0.25f;
+    const float height = boneLength * params.numBones_;
+    const unsigned mesh = writer.AddGridMesh(params.meshResolution_, 0.5f, height, -1, params.numBones_);
+
+    JSONArray joints;
+    ea::vector<Matrix4> inverseBindMatrices;
+    unsigned parentBone = M_MAX_UNSIGNED;
+    for (unsigned i = 0; i < params.numBones_; ++i)
+    {
+        const Vector3 offset = i == 0 ? Vector3::ZERO : Vector3::UP * boneLength;
+        const unsigned bone = writer.AddNode(Format("Bone{}", i), offset);
+        if (parentBone != M_MAX_UNSIGNED)
+            writer.AddChild(parentBone, bone);
+        parentBone = bone;
+
+        joints.push_back(bone);
+        inverseBindMatrices.push_back(Matrix3x4{Vector3::DOWN * (boneLength * i), Quaternion::IDENTITY, 1.0f}.ToMatrix4());
+    }
+    const unsigned skeletonRoot = joints[0].GetUInt();
+    writer.AddSkin(joints, inverseBindMatrices);
+
+    const unsigned characterNode = writer.AddNode("Character", Vector3::ZERO, mesh, 0);
+    writer.AddRootNode(skeletonRoot);
+    writer.AddRootNode(characterNode);
+
+    const float frameRate = 30.0f;
+    ea::vector<float> times;
+    for (unsigned i = 0; i < params.numKeyFrames_; ++i)
+        times.push_back(i / frameRate);
+
+    for (unsigned animationIndex = 0; animationIndex < params.numAnimations_; ++animationIndex)
+    {
+        const unsigned timeAccessor = writer.AddAccessor(times.data(), times.size(), sizeof(float), COMPONENT_FLOAT,
+            "SCALAR", 0, ToJSONArray({times.front()}), ToJSONArray({times.back()}));
+
+        JSONArray channels;
+        JSONArray samplers;
+        for (unsigned boneIndex = 0; boneIndex < params.numBones_; ++boneIndex)
+        {
+            ea::vector<Quaternion> rotations;
+            for (unsigned i = 0; i < params.numKeyFrames_; ++i)
+            {
+                const float angle = Sin(times[i] * 360.0f * (1 + animationIndex % 4) + boneIndex * 10.0f) * 20.0f;
+                rotations.emplace_back(angle, Vector3::FORWARD);
+            }
+
+            // glTF stores quaternions as xyzw
+            ea::vector<Vector4> values;
+            for (const Quaternion& rotation : rotations)
+                values.emplace_back(rotation.x_, rotation.y_, rotation.z_, rotation.w_);
+
+            JSONObject sampler;
+            sampler["input"] = timeAccessor;
+            sampler["output"] = writer.AddAccessor(values.data(), values.size(), sizeof(Vector4), COMPONENT_FLOAT, "VEC4");
+            samplers.push_back(sampler);
+
+            JSONObject target;
+            target["node"] = joints[boneIndex];
+            target["path"] = "rotation";
+            JSONObject channel;
+            channel["sampler"] = static_cast<unsigned>(samplers.size() - 1);
+            channel["target"] = target;
+            channels.push_back(channel);
+        }
+
+        JSONObject animation;
+        animation["name"] = Format("Animation{}", animationIndex);
+        animation["channels"] = channels;
+        animation["samplers"] = samplers;
+        writer.AddAnimation(animation);
+    }
+
+    return writer.Save(context, path + "Character.gltf");
+}
+
+/// Time of import stages in milliseconds.
+struct ImportStats
+{
+    double loadMs_{};
+    double processMs_{};
+    double saveMs_{};
+    unsigned long long outputSize_{};
+    unsigned numResources_{};
+
+    double GetTotalMs() const { return loadMs_ + processMs_ + saveMs_; }
+};
+
+/// Import asset the same way model importer does.
+/// Cold import parses source file, warm import reuses parsed source model like multi-flavor import does.
+bool ImportAsset(Context* context, const ea::string& fileName, const ea::string& outputPath,
+    GLTFImporter::SourceModelPtr& sourceModel, ImportStats& stats)
+{
+    auto fs = context->GetSubsystem<FileSystem>();
+
+    GLTFImporterSettings settings;
+    settings.assetName_ = GetFileName(fileName);
+    auto importer = MakeShared<GLTFImporter>(context, settings);
+
+    HiresTimer timer;
+    if (sourceModel)
+    {
+        if (!importer->LoadSourceModel(sourceModel))
+            return false;
+    }
+    else
+    {
+        if (!importer->LoadFile(fileName))
+            return false;
+        sourceModel = importer->GetSourceModel();
+    }
+    stats.loadMs_ = timer.GetUSec(true) / 1000.0;
+
+    if (!importer->Process(outputPath, Format("Benchmarks/{}/", settings.assetName_), nullptr))
+        return false;
+    stats.processMs_ = timer.GetUSec(true) / 1000.0;
+
+    fs->RemoveDir(outputPath, true);
+    if (!importer->SaveResources())
+        return false;
+    stats.saveMs_ = timer.GetUSec(true) / 1000.0;
+
+    stats.outputSize_ = 0;
+    stats.numResources_ = 0;
+    for (const auto& [resourceName, resourceFileName] : importer->GetSavedResources())
+    {
+        File file(context, resourceFileName);
+        stats.outputSize_ += file.GetSize();
+        ++stats.numResources_;
+    }
+    return true;
+}
+
+}
+
+TEST_CASE("Asset import benchmark over glTF corpus", "[benchmark]")
+{
+    const AssetCorpusParameters params = GetAssetCorpusParameters();
+
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fs = context->GetSubsystem<FileSystem>();
+
+    const ea::string rootPath = Format("{}Urho3D-Benchmarks-{}/", fs->GetTemporaryDir(), GenerateUUID());
+    const TemporaryDir rootPathHolder{context, rootPath};
+
+    // Use reference corpus if provided, generate synthetic corpus otherwise
+    ea::string corpusPath;
+    if (const char* referenceCorpus = std::getenv("URHO3D_BENCHMARK_ASSET_CORPUS"))
+        corpusPath = AddTrailingSlash(referenceCorpus);
+    else
+    {
+        corpusPath = rootPath + "Corpus/";
+        REQUIRE(fs->CreateDirsRecursive(corpusPath));
+
+        HiresTimer timer;
+        REQUIRE(WriteSceneAsset(context, corpusPath, params));
+        REQUIRE(WriteCharacterAsset(context, corpusPath, params));
+        std::printf("Generated synthetic corpus in %.1f ms\n", timer.GetUSec(false) / 1000.0);
+    }
+
+    StringVector assetFiles;
+    fs->ScanDir(assetFiles, corpusPath, "*.gltf", SCAN_FILES | SCAN_RECURSIVE);
+    StringVector binaryAssetFiles;
+    fs->ScanDir(binaryAssetFiles, corpusPath, "*.glb", SCAN_FILES | SCAN_RECURSIVE);
+    assetFiles.insert(assetFiles.end(), binaryAssetFiles.begin(), binaryAssetFiles.end());
+    ea::sort(assetFiles.begin(), assetFiles.end());
+    REQUIRE(!assetFiles.empty());
+
+    ea::string report;
+    report += Format("Asset import benchmark: {} assets, {} warm iterations\n", assetFiles.size(), params.numIterations_);
+    report += Format("  {:<32} {:>5} {:>10} {:>10} {:>10} {:>10} {:>12}\n",
+        "Asset", "Mode", "Load ms", "Process ms", "Save ms", "Total ms", "Output KB");
+
+    const auto reportStats = [&](const ea::string& assetName, const char* mode, const ImportStats& stats)
+    {
+        report += Format("  {:<32} {:>5} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f} {:>12.1f}\n", assetName, mode,
+            stats.loadMs_, stats.processMs_, stats.saveMs_, stats.GetTotalMs(), stats.outputSize_ / 1024.0);
+
+        const ea::string prefix = Format("AssetImport/{}/{}", assetName, mode);
+        Tests::RecordBenchmarkMetric(prefix + "/Load", stats.loadMs_, "ms");
+        Tests::RecordBenchmarkMetric(prefix + "/Process", stats.processMs_, "ms");
+        Tests::RecordBenchmarkMetric(prefix + "/Save", stats.saveMs_, "ms");
+        Tests::RecordBenchmarkMetric(prefix + "/Total", stats.GetTotalMs(), "ms");
+    };
+
+    ImportStats totalCold;
+    ImportStats totalWarm;
+    for (const ea::string& assetFile : assetFiles)
+    {
+        const ea::string assetName = GetFileNameAndExtension(assetFile);
+        const ea::string outputPath = Format("{}Output/{}/", rootPath, assetName);
+
+        // Cold: source file is parsed and output directory is empty
+        GLTFImporter::SourceModelPtr sourceModel;
+        ImportStats coldStats;
+        fs->RemoveDir(outputPath, true);
+        REQUIRE(ImportAsset(context, corpusPath + assetFile, outputPath, sourceModel, coldStats));
+        REQUIRE(coldStats.numResources_ > 0);
+        reportStats(assetName, "Cold", coldStats);
+
+        // Warm: parsed source model and output directory are reused, best iteration is reported
+        ImportStats warmStats;
+        for (unsigned i = 0; i < params.numIterations_; ++i)
+        {
+            ImportStats iterationStats;
+            REQUIRE(ImportAsset(context, corpusPath + assetFile, outputPath, sourceModel, iterationStats));
+            if (i == 0 || iterationStats.GetTotalMs() < warmStats.GetTotalMs())
+                warmStats = iterationStats;
+        }
+        reportStats(assetName, "Warm", warmStats);
+
+        // Import is deterministic, so warm import should produce the same output
+        CHECK(warmStats.numResources_ == coldStats.numResources_);
+        CHECK(warmStats.outputSize_ == coldStats.outputSize_);
+
+        Tests::RecordBenchmarkMetric(Format("AssetImport/{}/OutputSize", assetName), coldStats.outputSize_, "bytes");
+        Tests::RecordBenchmarkMetric(Format("AssetImport/{}/Resources", assetName), coldStats.numResources_, "resources");
+
+        totalCold.loadMs_ += coldStats.loadMs_;
+        totalCold.processMs_ += coldStats.processMs_;
+        totalCold.saveMs_ += coldStats.saveMs_;
+        totalCold.outputSize_ += coldStats.outputSize_;
+        totalWarm.loadMs_ += warmStats.loadMs_;
+        totalWarm.processMs_ += warmStats.processMs_;
+        totalWarm.saveMs_ += warmStats.saveMs_;
+        totalWarm.outputSize_ += warmStats.outputSize_;
+    }
+
+    reportStats("All", "Cold", totalCold);
+    reportStats("All", "Warm", totalWarm);
+
+    const unsigned long long peakMemory = GetPeakProcessMemory();
+    report += Format("  Peak process memory: {:.1f} MB\n", peakMemory / (1024.0 * 1024.0));
+    Tests::RecordBenchmarkMetric("AssetImport/PeakMemory", peakMemory, "bytes");
+    std::fputs(report.c_str(), stdout);
+}
@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+#include "BenchmarkUtils.h"
+
+#include <Urho3D/Core/StringUtils.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace Tests
+{
+
+namespace
+{
+
+struct BenchmarkMetric
+{
+    ea::string name_;
+    double value_{};
+    ea::string unit_;
+};
+
+ea::vector<BenchmarkMetric>& GetBenchmarkMetrics()
+{
+    static ea::vector<BenchmarkMetric> metrics;
+    return metrics;
+}
+
+ea::string EscapeJsonString(ea::string_view value)
+{
+    ea::string result;
+    for (const char ch : value)
+    {
+        if (ch == '"' || ch == '\\')
+            result += '\\';
+        result += ch;
+    }
+    return result;
+}
+
+/// Collects results of Catch2 benchmarks and writes all results as JSON at the end of the run.
+class BenchmarkJsonListener : public Catch::EventListenerBase
+{
+public:
+    using Catch::EventListenerBase::EventListenerBase;
+
+    void benchmarkEnded(const Catch::BenchmarkStats<>& stats) override
+    {
+        RecordBenchmarkMetric(Format("{}/mean", stats.info.name.c_str()), stats.mean.point.count(), "ns");
+        RecordBenchmarkMetric(
+            Format("{}/stddev", stats.info.name.c_str()), stats.standardDeviation.point.count(), "ns");
+    }
+
+    void testRunEnded(const Catch::TestRunStats& testRunStats) override
+    {
+        const char* fileName = std::getenv("URHO3D_BENCHMARK_JSON");
+        if (!fileName || !*fileName)
+            return;
+
+        FILE* file = std::fopen(fileName, "w");
+        if (!file)
+        {
+            std::fprintf(stderr, "Cannot write benchmark results to '%s'\n", fileName);
+            return;
+        }
+
+        const auto& metrics = GetBenchmarkMetrics();
+        std::fputs("{\n  \"metrics\": [\n", file);
+        for (unsigned i = 0; i < metrics.size(); ++i)
+        {
+            const BenchmarkMetric& metric = metrics[i];
+            const ea::string line = Format("    {{\"name\": \"{}\", \"value\": {}, \"unit\": \"{}\"}}{}\n",
+                EscapeJsonString(metric.name_), metric.value_, EscapeJsonString(metric.unit_),
+                i + 1 < metrics.size() ? "," : "");
+            std::fputs(line.c_str(), file);
+        }
+        std::fputs("  ]\n}\n", file);
+        std::fclose(file);
+    }
+};
+
+CATCH_REGISTER_LISTENER(BenchmarkJsonListener)
+
+}
+
+float GetBenchmarkParameter(const char* name, float defaultValue)
+{
+    const char* value = std::getenv(name);
+    return value ? ToFloat(value) : defaultValue;
+}
+
+unsigned GetBenchmarkParameter(const char* name, unsigned defaultValue)
+{
+    const char* value = std::getenv(name);
+    return value ? ToUInt(value) : defaultValue;
+}
+
+void RecordBenchmarkMetric(ea::string_view name, double value, ea::string_view unit)
+{
+    GetBenchmarkMetrics().push_back(BenchmarkMetric{ea::string{name}, value, ea::string{unit}});
+}
+
+}
@@ -0,0 +1,41 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include <EASTL/string_view.h>
+
+namespace Tests
+{
+
+/// Return benchmark parameter from environment variable, or default value if not set.
+/// Parameters are used to scale synthetic scenes without rebuilding benchmarks.
+float GetBenchmarkParameter(const char* name, float defaultValue);
+unsigned GetBenchmarkParameter(const char* name, unsigned defaultValue);
+
+/// Record custom benchmark metric.
+/// Recorded metrics and results of Catch2 benchmarks are written as JSON to the file
+/// specified by URHO3D_BENCHMARK_JSON environment variable when the run is finished.
+void RecordBenchmarkMetric(ea::string_view name, double value, ea::string_view unit);
+
+}
@@ -0,0 +1,254 @@
+//
+// Copyright (c) 2017-2021 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+#include "../NetworkUtils.h"
+#include "../SceneUtils.h"
+#include "BenchmarkUtils.h"
+
+#include <Urho3D/Core/FrameProfiler.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Network/Network.h>
+#include <Urho3D/Replica/BehaviorNetworkObject.h>
+#include <Urho3D/Replica/NetworkSettingsConsts.h>
+#include <Urho3D/Replica/ReplicatedTransform.h>
+#include <Urho3D/Replica/ServerReplicator.h>
+#include <Urho3D/Scene/PrefabResource.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Count heap allocations of the whole process, all containers allocate through global operator new
+namespace
+{
+
+std::atomic<unsigned long long> numAllocations{};
+
+}
+
+void* operator new(std::size_t size)
+{
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+
+/// Parameters of the benchmark, may be overridden by environment variables.
+struct BenchmarkParameters
+{
+    unsigned numClients_{8};
+    unsigned numObjects_{200};
+    float latency_{0.1f};
+    float loss_{0.02f};
+    float duration_{10.0f};
+    bool parallel_{};
+};
+
+BenchmarkParameters GetBenchmarkParameters()
+{
+    BenchmarkParameters params;
+    params.numClients_ = Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_CLIENTS", params.numClients_);
+    params.numObjects_ = Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_OBJECTS", params.numObjects_);
+    params.latency_ = Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_LATENCY", params.latency_);
+    params.loss_ = Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_LOSS", params.loss_);
+    params.duration_ = Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_DURATION", params.duration_);
+    params.parallel_ = Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_PARALLEL", 0u) != 0;
+    return params;
+}
+
+SharedPtr<PrefabResource> CreateBenchmarkPrefab(Context* context)
+{
+    auto node = MakeShared<Node>(context);
+    node->CreateComponent<ReplicatedTransform>();
+
+    return Tests::ConvertNodeToPrefab(node);
+}
+
+Vector3 GetObjectPosition(unsigned index, float time)
+{
+    const float angle = index * 7.0f + time * 45.0f;
+    const float radius = 10.0f + index % 50;
+    return Vector3{Cos(angle) * radius, 0.0f, Sin(angle) * radius};
+}
+
+/// Server zones reported per phase.
+const char* const serverPhases[] = {
+    "ServerNetworkUpdate",
+    "PrepareReplication",
+    "UpdateClientObjects",
+    "CookDeltaUpdates",
+    "SendClientMessages",
+};
+
+struct PhaseStats
+{
+    double totalMs_{};
+    double maxMs_{};
+};
+
+}
+
+TEST_CASE("Replication benchmark with simulated clients", "[benchmark]")
+{
+    const BenchmarkParameters params = GetBenchmarkParameters();
+    constexpr unsigned framesInSecond = Tests::NetworkSimulator::FramesInSecond;
+
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(framesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/Benchmarks/Replication.prefab", CreateBenchmarkPrefab);
+
+    // Setup scenes
+    const auto quality = Tests::ConnectionQuality{params.latency_, params.latency_ * 1.2f, params.latency_ * 2.0f, params.loss_, params.loss_};
+    auto serverScene = MakeShared<Scene>(context);
+    ea::vector<SharedPtr<Scene>> clientScenes;
+    for (unsigned i = 0; i < params.numClients_; ++i)
+        clientScenes.push_back(MakeShared<Scene>(context));
+
+    ea::vector<Node*> serverNodes;
+    for (unsigned i = 0; i < params.numObjects_; ++i)
+    {
+        serverNodes.push_back(Tests::SpawnOnServer<BehaviorNetworkObject>(
+            serverScene, prefab, Format("Object {}", i), GetObjectPosition(i, 0.0f)));
+    }
+
+    Tests::NetworkSimulator sim(serverScene);
+    ServerReplicator* serverReplicator = serverScene->GetComponent<ReplicationManager>()->GetServerReplicator();
+    serverReplicator->SetSetting(NetworkSettings::ParallelClientUpdates, params.parallel_);
+    for (Scene* clientScene : clientScenes)
+        sim.AddClient(clientScene, quality);
+
+    // Warm up until all clients are synchronized
+    sim.SimulateTime(3.0f);
+
+    ea::vector<unsigned long long> initialBytes;
+    for (Scene* clientScene : clientScenes)
+    {
+        auto connection = static_cast<Tests::ManualConnection*>(sim.GetServerToClientConnection(clientScene));
+        initialBytes.push_back(connection->GetTotalBytes());
+    }
+
+    // Move all objects every frame and measure
+    FrameProfiler::SetEnabled(true);
+    FrameProfiler::ClearHistory();
+    FrameProfiler::EndFrame();
+
+    ea::unordered_map<ea::string, PhaseStats> phaseStats;
+    unsigned long long totalAllocations = 0;
+    unsigned long long maxAllocations = 0;
+    double totalFrameMs = 0.0;
+    const unsigned numFrames = ea::max(1, RoundToInt(params.duration_ * framesInSecond));
+    for (unsigned frame = 1; frame <= numFrames; ++frame)
+    {
+        const float time = static_cast<float>(frame) / framesInSecond;
+        for (unsigned i = 0; i < serverNodes.size(); ++i)
+            serverNodes[i]->SetWorldPosition(GetObjectPosition(i, time));
+
+        HiresTimer timer;
+        const unsigned long long allocationsBefore = numAllocations.load(std::memory_order_relaxed);
+        sim.SimulateTime(1.0f / framesInSecond);
+        const unsigned long long frameAllocations = numAllocations.load(std::memory_order_relaxed) - allocationsBefore;
+        totalFrameMs += timer.GetUSec(false) / 1000.0;
+        totalAllocations += frameAllocations;
+        maxAllocations = ea::max(maxAllocations, frameAllocations);
+
+        FrameProfiler::EndFrame();
+        for (const FrameProfilerZoneStats& zone : FrameProfiler::GetFrameStats())
+        {
+            PhaseStats& stats = phaseStats[zone.name_];
+            stats.totalMs_ += zone.totalMs_;
+            stats.maxMs_ = ea::max(stats.maxMs_, zone.maxMs_);
+        }
+    }
+
+    // Soak check: all clients converge to server state once objects stop
+    sim.SimulateTime(2.0f);
+    for (Scene* clientScene : clientScenes)
+    {
+        for (unsigned i = 0; i < serverNodes.size(); ++i)
+        {
+            Node* clientNode = clientScene->GetChild(Format("Object {}", i), true);
+            REQUIRE(clientNode);
+            CHECK(clientNode->GetWorldPosition().Equals(serverNodes[i]->GetWorldPosition(), 0.01f));
+        }
+    }
+
+    // Report results
+    const double measuredSeconds = static_cast<double>(numFrames) / framesInSecond;
+    double totalBytesPerSecond = 0.0;
+    for (unsigned i = 0; i < clientScenes.size(); ++i)
+    {
+        auto connection = static_cast<Tests::ManualConnection*>(sim.GetServerToClientConnection(clientScenes[i]));
+        totalBytesPerSecond += (connection->GetTotalBytes() - initialBytes[i]) / measuredSeconds;
+    }
+
+    ea::string report;
+    report += Format("Replication benchmark: {} clients, {} objects, latency {}s, loss {}, parallel {}\n",
+        params.numClients_, params.numObjects_, params.latency_, params.loss_, params.parallel_);
+    report += Format("  Simulated frame: {:.3f} ms avg (server and all clients)\n", totalFrameMs / numFrames);
+    Tests::RecordBenchmarkMetric("Replication/Frame", totalFrameMs / numFrames, "ms");
+    for (const char* phase : serverPhases)
+    {
+        const PhaseStats& stats = phaseStats[phase];
+        report += Format("  {:<24} {:.3f} ms avg, {:.3f} ms max\n", phase, stats.totalMs_ / numFrames, stats.maxMs_);
+        Tests::RecordBenchmarkMetric(Format("Replication/{}", phase), stats.totalMs_ / numFrames, "ms");
+    }
+    report += Format("  Bytes per client per second: {:.0f}\n", totalBytesPerSecond / ea::max(1u, params.numClients_));
+    report += Format("  Allocations per frame: {:.1f} avg, {} max\n", static_cast<double>(totalAllocations) / numFrames, maxAllocations);
+    Tests::RecordBenchmarkMetric(
+        "Replication/BytesPerClientPerSecond", totalBytesPerSecond / ea::max(1u, params.numClients_), "bytes");
+    Tests::RecordBenchmarkMetric(
+        "Replication/AllocationsPerFrame", static_cast<double>(totalAllocations) / numFrames, "allocations");
+    std::fputs(report.c_str(), stdout);
+}
@@ -0,0 +1,194 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+#include "BenchmarkUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/Light.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/OctreeQuery.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+/// Parameters of synthetic scene, may be overridden by environment variables.
+struct SyntheticSceneParameters
+{
+    unsigned numDrawables_{};
+    unsigned numLights_{};
+    unsigned numMovingNodes_{};
+    float size_{};
+};
+
+SyntheticSceneParameters GetSyntheticSceneParameters()
+{
+    SyntheticSceneParameters params;
+    params.numDrawables_ = Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_DRAWABLES", 10000u);
+    params.numLights_ = Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_LIGHTS", 100u);
+    params.numMovingNodes_ = Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_MOVING_NODES", 1000u);
+    params.size_ = Tests::GetBenchmarkParameter("URHO3D_BENCHMARK_SCENE_SIZE", 1000.0f);
+    return params;
+}
+
+/// Create reproducible scene with drawables and point lights scattered on the plane.
+SharedPtr<Scene> CreateSyntheticScene(Context* context, const SyntheticSceneParameters& params)
+{
+    auto scene = MakeShared<Scene>(context);
+    auto octree = scene->CreateComponent<Octree>();
+    octree->SetSize(BoundingBox(-params.size_, params.size_), 8);
+
+    auto model = MakeShared<Model>(context);
+    model->SetBoundingBox(BoundingBox(-1.0f, 1.0f));
+
+    RandomEngine random{0};
+    const auto randomPosition = [&]()
+    {
+        const float halfSize = params.size_ * 0.5f;
+        return Vector3{random.GetFloat(-halfSize, halfSize), random.GetFloat(0.0f, 10.0f), random.GetFloat(-halfSize, halfSize)};
+    };
+
+    for (unsigned i = 0; i < params.numDrawables_; ++i)
+    {
+        Node* node = scene->CreateChild(Format("Drawable {}", i));
+        node->SetPosition(randomPosition());
+        node->CreateComponent<StaticModel>()->SetModel(model);
+    }
+
+    for (unsigned i = 0; i < params.numLights_; ++i)
+    {
+        Node* node = scene->CreateChild(Format("Light {}", i));
+        node->SetPosition(randomPosition());
+        auto light = node->CreateComponent<Light>();
+        light->SetLightType(LIGHT_POINT);
+        light->SetRange(20.0f);
+    }
+
+    octree->Update(FrameInfo{});
+    return scene;
+}
+
+}
+
+TEST_CASE("Octree benchmark with synthetic scene", "[benchmark]")
+{
+    const SyntheticSceneParameters params = GetSyntheticSceneParameters();
+
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = CreateSyntheticScene(context, params);
+    auto octree = scene->GetComponent<Octree>();
+
+    Node* cameraNode = scene->CreateChild("Camera");
+    cameraNode->SetPosition({0.0f, 20.0f, -params.size_ * 0.5f});
+    cameraNode->LookAt(Vector3::ZERO);
+    auto camera = cameraNode->CreateComponent<Camera>();
+    camera->SetFarClip(params.size_);
+
+    ea::vector<Drawable*> result;
+    BENCHMARK("Octree/FrustumQuery")
+    {
+        result.clear();
+        FrustumOctreeQuery query(result, camera->GetFrustum(), DRAWABLE_GEOMETRY | DRAWABLE_LIGHT);
+        octree->GetDrawables(query);
+        return result.size();
+    };
+
+    BENCHMARK("Octree/SphereQuery")
+    {
+        result.clear();
+        SphereOctreeQuery query(result, Sphere{Vector3::ZERO, params.size_ * 0.1f}, DRAWABLE_GEOMETRY);
+        octree->GetDrawables(query);
+        return result.size();
+    };
+
+    ea::vector<RayQueryResult> rayResult;
+    BENCHMARK("Octree/Raycast")
+    {
+        rayResult.clear();
+        RayOctreeQuery query(rayResult, Ray{cameraNode->GetPosition(), cameraNode->GetWorldDirection()}, RAY_AABB,
+            params.size_, DRAWABLE_GEOMETRY);
+        octree->Raycast(query);
+        return rayResult.size();
+    };
+
+    ea::vector<Node*> movingNodes;
+    for (unsigned i = 0; i < ea::min(params.numMovingNodes_, params.numDrawables_); ++i)
+        movingNodes.push_back(scene->GetChild(Format("Drawable {}", i)));
+
+    float offset = 1.0f;
+    BENCHMARK("Octree/UpdateMovingDrawables")
+    {
+        offset = -offset;
+        for (Node* node : movingNodes)
+            node->Translate({offset, 0.0f, 0.0f});
+        octree->Update(FrameInfo{});
+    };
+}
+
+TEST_CASE("Scene serialization benchmark with synthetic scene", "[benchmark]")
+{
+    const SyntheticSceneParameters params = GetSyntheticSceneParameters();
+
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = CreateSyntheticScene(context, params);
+
+    VectorBuffer binaryData;
+    REQUIRE(scene->Save(binaryData));
+    VectorBuffer xmlData;
+    REQUIRE(scene->SaveXML(xmlData));
+    Tests::RecordBenchmarkMetric("Scene/BinarySize", binaryData.GetSize(), "bytes");
+    Tests::RecordBenchmarkMetric("Scene/XMLSize", xmlData.GetSize(), "bytes");
+
+    BENCHMARK("Scene/SaveBinary")
+    {
+        VectorBuffer buffer;
+        return scene->Save(buffer);
+    };
+
+    BENCHMARK("Scene/SaveXML")
+    {
+        VectorBuffer buffer;
+        return scene->SaveXML(buffer);
+    };
+
+    auto loadedScene = MakeShared<Scene>(context);
+    BENCHMARK("Scene/LoadBinary")
+    {
+        MemoryBuffer buffer{binaryData.GetBuffer()};
+        return loadedScene->Load(buffer);
+    };
+
+    BENCHMARK("Scene/LoadXML")
+    {
+        MemoryBuffer buffer{xmlData.GetBuffer()};
+        return loadedScene->LoadXML(buffer);
+    };
+
+    REQUIRE(loadedScene->GetNumChildren() == scene->GetNumChildren());
+}
@@ -74,3 +74,39 @@ TEST_CASE("Variant is move-assigned")
         REQUIRE(value.GetCustomPtr<TestLargeObject>()->c_ == "12345678901234567890");
     }
 }
+
+TEST_CASE("Variant takes ownership of moved containers")
+{
+    ea::string longString = "12345678901234567890123456789012345678901234567890";
+    const char* stringData = longString.data();
+    const Variant stringValue{ea::move(longString)};
+    REQUIRE(stringValue.GetType() == VAR_STRING);
+    CHECK(stringValue.GetString().data() == stringData);
+
+    VariantVector vector{Variant{1}, Variant{2}, Variant{3}};
+    const Variant* vectorData = vector.data();
+    Variant vectorValue;
+    vectorValue = ea::move(vector);
+    REQUIRE(vectorValue.GetType() == VAR_VARIANTVECTOR);
+    CHECK(vectorValue.GetVariantVector().data() == vectorData);
+
+    VariantBuffer buffer{1, 2, 3, 4};
+    const unsigned char* bufferData = buffer.data();
+    const Variant bufferValue{ea::move(buffer)};
+    REQUIRE(bufferValue.GetType() == VAR_BUFFER);
+    CHECK(bufferValue.GetBuffer().data() == bufferData);
+
+    VariantMap map{{StringHash{"A"}, Variant{1}}, {StringHash{"B"}, Variant{2}}};
+    const Variant mapValue{ea::move(map)};
+    REQUIRE(mapValue.GetType() == VAR_VARIANTMAP);
+    CHECK(mapValue.GetVariantMap().size() == 2);
+    CHECK(map.empty());
+
+#if URHO3D_PROFILING
+    Variant::ResetNumHeapAllocations();
+    const Variant copiedValue = stringValue;
+    CHECK(Variant::GetNumHeapAllocations() == 1);
+    const Variant movedValue{ea::string{"123456789012345678901234567890"}};
+    CHECK(Variant::GetNumHeapAllocations() == 1);
+#endif
+}
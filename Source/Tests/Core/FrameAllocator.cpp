@@ -0,0 +1,62 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/FrameAllocator.h>
+
+TEST_CASE("Linear allocator returns aligned memory and merges blocks on reset")
+{
+    LinearAllocator allocator(256);
+
+    for (unsigned alignment : {1u, 4u, 16u, 64u, 256u})
+    {
+        void* memory = allocator.Allocate(24, alignment);
+        REQUIRE(memory != nullptr);
+        REQUIRE(reinterpret_cast<uintptr_t>(memory) % alignment == 0);
+    }
+
+    // Allocation larger than the block
+    REQUIRE(allocator.Allocate(1000) != nullptr);
+    const unsigned capacity = allocator.GetCapacity();
+    REQUIRE(capacity > 256);
+
+    allocator.Reset();
+    REQUIRE(allocator.GetUsedSize() == 0);
+    REQUIRE(allocator.GetCapacity() == capacity);
+
+    // Same amount of memory fits into one block now
+    REQUIRE(allocator.Allocate(capacity) != nullptr);
+    REQUIRE(allocator.GetCapacity() == capacity);
+}
+
+TEST_CASE("Frame vector uses frame memory")
+{
+    const unsigned usedSize = FrameAllocator::GetUsedSize();
+    {
+        FrameVector<unsigned> values;
+        for (unsigned i = 0; i < 1000; ++i)
+            values.push_back(i);
+        REQUIRE(values.size() == 1000);
+        REQUIRE(values[999] == 999);
+    }
+    REQUIRE(FrameAllocator::GetUsedSize() >= usedSize + 1000 * sizeof(unsigned));
+}
@@ -0,0 +1,74 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/Profiler.h>
+
+#include <thread>
+
+namespace
+{
+
+void ProfiledFunction()
+{
+    URHO3D_PROFILE("FrameProfilerTestZone");
+}
+
+}
+
+TEST_CASE("Frame profiler aggregates zones from all threads")
+{
+    FrameProfiler::SetEnabled(true);
+    FrameProfiler::EndFrame();
+
+    for (unsigned i = 0; i < 3; ++i)
+        ProfiledFunction();
+    std::thread thread{[] { ProfiledFunction(); }};
+    thread.join();
+
+    FrameProfiler::EndFrame();
+
+    const auto findZone = [](const ea::vector<FrameProfilerZoneStats>& stats) -> const FrameProfilerZoneStats*
+    {
+        for (const FrameProfilerZoneStats& zone : stats)
+        {
+            if (ea::string_view{zone.name_} == "FrameProfilerTestZone")
+                return &zone;
+        }
+        return nullptr;
+    };
+
+    const auto frameStats = FrameProfiler::GetFrameStats();
+    const FrameProfilerZoneStats* zone = findZone(frameStats);
+    REQUIRE(zone);
+    CHECK(zone->count_ == 4.0);
+    CHECK(zone->totalMs_ >= zone->maxMs_);
+    CHECK(!FrameProfiler::FormatStats(frameStats).empty());
+
+    // Disabled profiler doesn't collect samples
+    FrameProfiler::SetEnabled(false);
+    ProfiledFunction();
+    FrameProfiler::SetEnabled(true);
+    FrameProfiler::EndFrame();
+    CHECK_FALSE(findZone(FrameProfiler::GetFrameStats()));
+}
@@ -0,0 +1,101 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/MemoryTracker.h>
+
+namespace
+{
+
+URHO3D_MEMORY_TAG(TestMemoryTag, "MemoryTrackerTestTag");
+
+const MemoryTagStats* FindTag(const ea::vector<MemoryTagStats>& stats, ea::string_view name)
+{
+    for (const MemoryTagStats& tag : stats)
+    {
+        if (ea::string_view{tag.name_} == name)
+            return &tag;
+    }
+    return nullptr;
+}
+
+}
+
+TEST_CASE("Memory tracker accounts tagged allocations")
+{
+    MemoryTracker::SetEnabled(true);
+    MemoryTracker::EndFrame();
+
+    {
+        ea::vector<int, TaggedAllocator<TestMemoryTag>> values;
+        values.reserve(100);
+        MemoryTracker::EndFrame();
+
+        const auto stats = MemoryTracker::GetStats();
+        const MemoryTagStats* tag = FindTag(stats, "MemoryTrackerTestTag");
+        REQUIRE(tag);
+        CHECK(tag->liveBytes_ == 100 * sizeof(int));
+        CHECK(tag->peakBytes_ >= 100 * sizeof(int));
+        CHECK(tag->liveAllocations_ == 1);
+        CHECK(tag->frameAllocations_ == 1);
+        CHECK(tag->frameBytes_ == 100 * sizeof(int));
+    }
+
+    MemoryTracker::EndFrame();
+
+    const auto stats = MemoryTracker::GetStats();
+    const MemoryTagStats* tag = FindTag(stats, "MemoryTrackerTestTag");
+    REQUIRE(tag);
+    CHECK(tag->liveBytes_ == 0);
+    CHECK(tag->peakBytes_ >= 100 * sizeof(int));
+    CHECK(tag->liveAllocations_ == 0);
+    CHECK(tag->frameAllocations_ == 0);
+}
+
+TEST_CASE("Memory tracker accounts blocks allocated for third-party libraries")
+{
+    MemoryTracker::SetEnabled(true);
+    const unsigned tagIndex = MemoryTracker::RegisterTag("MemoryTrackerTestBlocks");
+    CHECK(MemoryTracker::RegisterTag("MemoryTrackerTestBlocks") == tagIndex);
+
+    void* block = MemoryTracker::AllocateTracked(tagIndex, 1000);
+    REQUIRE(block);
+    CHECK(reinterpret_cast<uintptr_t>(block) % alignof(std::max_align_t) == 0);
+
+    const auto statsAllocated = MemoryTracker::GetStats();
+    const MemoryTagStats* tag = FindTag(statsAllocated, "MemoryTrackerTestBlocks");
+    REQUIRE(tag);
+    CHECK(tag->liveBytes_ == 1000);
+
+    // Block allocated while tracking is enabled is still accounted when it is freed
+    MemoryTracker::SetEnabled(false);
+    MemoryTracker::FreeTracked(tagIndex, block);
+    MemoryTracker::SetEnabled(true);
+
+    const auto statsFreed = MemoryTracker::GetStats();
+    tag = FindTag(statsFreed, "MemoryTrackerTestBlocks");
+    REQUIRE(tag);
+    CHECK(tag->liveBytes_ == 0);
+    CHECK(tag->liveAllocations_ == 0);
+}
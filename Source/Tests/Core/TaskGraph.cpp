@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/TaskGraph.h>
+#include <Urho3D/Core/WorkQueue.h>
+
+#include <atomic>
+
+TEST_CASE("Task graph executes nodes after their dependencies")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    // Diamond: A -> (B, C) -> D, plus independent E
+    std::atomic<unsigned> counter{};
+    unsigned order[5]{};
+    const auto makeTask = [&](unsigned index) { return [&, index](unsigned) { order[index] = ++counter; }; };
+
+    TaskGraph graph(workQueue);
+    const auto a = graph.AddTask(makeTask(0));
+    const auto b = graph.AddContinuation(a, makeTask(1));
+    const auto c = graph.AddContinuation(a, makeTask(2));
+    const auto d = graph.AddTask(makeTask(3));
+    graph.AddDependency(d, b);
+    graph.AddDependency(d, c);
+    graph.AddTask(makeTask(4));
+
+    for (unsigned run = 0; run < 3; ++run)
+    {
+        counter = 0;
+        REQUIRE(graph.Run());
+        REQUIRE(counter == 5);
+        REQUIRE(order[0] < order[1]);
+        REQUIRE(order[0] < order[2]);
+        REQUIRE(order[1] < order[3]);
+        REQUIRE(order[2] < order[3]);
+    }
+}
+
+TEST_CASE("Task graph processes whole range of parallel node")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    ea::vector<unsigned> values;
+    std::atomic<unsigned> sum{};
+
+    TaskGraph graph(workQueue);
+    const auto fill = graph.AddParallelTask(0, 16, [&](unsigned beginIndex, unsigned endIndex, unsigned)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+            values[i] = i;
+    });
+    graph.AddContinuation(fill, [&](unsigned)
+    {
+        for (unsigned value : values)
+            sum += value;
+    });
+
+    for (unsigned size : {0u, 1u, 15u, 1000u})
+    {
+        values.assign(size, 0u);
+        sum = 0;
+        graph.SetTaskSize(fill, size);
+        REQUIRE(graph.Run());
+        REQUIRE(sum == (size > 0 ? size * (size - 1) / 2 : 0u));
+    }
+}
+
+TEST_CASE("Task graph with cyclic dependencies is not executed")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    bool executed = false;
+    TaskGraph graph(workQueue);
+    const auto a = graph.AddTask([&](unsigned) { executed = true; });
+    const auto b = graph.AddContinuation(a, [&](unsigned) { executed = true; });
+    graph.AddDependency(a, b);
+
+    REQUIRE_FALSE(graph.Run());
+    REQUIRE_FALSE(executed);
+
+    graph.Clear();
+    REQUIRE(graph.Run());
+}
@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/CoreEvents.h>
+
+namespace
+{
+
+struct TestTypedEvent
+{
+    URHO3D_TYPED_EVENT(TestTypedEvent);
+    int value_{};
+};
+
+class TypedEventReceiver : public Object
+{
+    URHO3D_OBJECT(TypedEventReceiver, Object);
+
+public:
+    using Object::Object;
+
+    void HandleEvent(const TestTypedEvent& event) { sum_ += event.value_; }
+
+    int sum_{};
+};
+
+}
+
+TEST_CASE("Typed events are delivered to subscribers")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto sender = MakeShared<TypedEventReceiver>(context);
+    auto otherSender = MakeShared<TypedEventReceiver>(context);
+    auto receiver = MakeShared<TypedEventReceiver>(context);
+    auto specificReceiver = MakeShared<TypedEventReceiver>(context);
+
+    receiver->SubscribeToEvent<TestTypedEvent>(&TypedEventReceiver::HandleEvent);
+    specificReceiver->SubscribeToEvent<TestTypedEvent>(sender, &TypedEventReceiver::HandleEvent);
+    REQUIRE(receiver->HasSubscribedToEvent<TestTypedEvent>());
+    REQUIRE(sender->HasEventSubscribers<TestTypedEvent>());
+
+    sender->SendEvent(TestTypedEvent{1});
+    otherSender->SendEvent(TestTypedEvent{10});
+    REQUIRE(receiver->sum_ == 11);
+    REQUIRE(specificReceiver->sum_ == 1);
+
+    // String-hash events do not trigger typed handlers
+    receiver->SendEvent(E_UPDATE);
+    REQUIRE(receiver->sum_ == 11);
+
+    receiver->UnsubscribeFromEvent<TestTypedEvent>();
+    REQUIRE_FALSE(receiver->HasSubscribedToEvent<TestTypedEvent>());
+    sender->SendEvent(TestTypedEvent{100});
+    REQUIRE(receiver->sum_ == 11);
+    REQUIRE(specificReceiver->sum_ == 101);
+
+    // Expired receivers are dropped
+    specificReceiver = nullptr;
+    sender->SendEvent(TestTypedEvent{1000});
+    REQUIRE_FALSE(sender->HasEventSubscribers<TestTypedEvent>());
+}
+
+TEST_CASE("Typed event handlers may change subscriptions during dispatch")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto sender = MakeShared<TypedEventReceiver>(context);
+    auto first = MakeShared<TypedEventReceiver>(context);
+    auto second = MakeShared<TypedEventReceiver>(context);
+
+    unsigned numCalls = 0;
+    first->SubscribeToEvent<TestTypedEvent>([&]()
+    {
+        ++numCalls;
+        // New subscription is invoked starting from the next event
+        second->SubscribeToEvent<TestTypedEvent>(&TypedEventReceiver::HandleEvent);
+        first->UnsubscribeFromEvent<TestTypedEvent>();
+    });
+
+    sender->SendEvent(TestTypedEvent{1});
+    REQUIRE(numCalls == 1);
+    REQUIRE(second->sum_ == 0);
+
+    sender->SendEvent(TestTypedEvent{2});
+    REQUIRE(numCalls == 1);
+    REQUIRE(second->sum_ == 2);
+
+    second->UnsubscribeFromAllEvents();
+    sender->SendEvent(TestTypedEvent{4});
+    REQUIRE(second->sum_ == 2);
+}
@@ -24,6 +24,8 @@
 #include "../CommonUtils.h"
 #include <Urho3D/Engine/StateManager.h>
 #include <Urho3D/Engine/StateManagerEvents.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Resource/ResourceCache.h>
 
 namespace
 {
@@ -246,3 +248,45 @@ TEST_CASE("StateManager: Last state is unknown")
                 EventMatcher(E_LEAVINGAPPLICATIONSTATE, State1::GetTypeStatic(), unknownState),
                 EventMatcher(E_STATETRANSITIONCOMPLETE, State1::GetTypeStatic(), StringHash::Empty)}));
 }
+
+TEST_CASE("StateManager: Preload resources of the next state")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto guard = Tests::MakeScopedReflection<State1, State2>(context);
+    auto cache = context->GetSubsystem<ResourceCache>();
+    cache->ReleaseResource<Model>("Models/Box.mdl", true);
+
+    auto* stateManager = context->GetSubsystem<StateManager>();
+    stateManager->Reset();
+
+    stateManager->EnqueueState(State1::GetTypeStatic());
+    Tests::RunFrame(context, 0.1f);
+    REQUIRE(stateManager->GetState()->GetType() == State1::GetTypeStatic());
+
+    unsigned numProgressEvents = 0;
+    Serializable subscriber(context);
+    subscriber.SubscribeToEvent(E_STATEPRELOADPROGRESS, [&](StringHash, VariantMap& data)
+    {
+        using namespace StatePreloadProgress;
+        CHECK(data[P_STATE].GetStringHash() == State2::GetTypeStatic());
+        CHECK(data[P_NUMTOTAL].GetUInt() == 1);
+        ++numProgressEvents;
+    });
+
+    auto state2 = MakeShared<State2>(context);
+    state2->AddPreloadResource(Model::GetTypeStatic(), "Models/Box.mdl");
+    stateManager->EnqueueState(state2);
+    CHECK(stateManager->GetNumPreloadResources() == 1);
+
+    for (unsigned i = 0; i < 100 && stateManager->GetState() != state2; ++i)
+        Tests::RunFrame(context, 0.1f);
+
+    REQUIRE(stateManager->GetState() == state2);
+    CHECK(stateManager->IsPreloadComplete());
+    CHECK(cache->GetExistingResource<Model>("Models/Box.mdl"));
+#ifdef URHO3D_THREADING
+    CHECK(numProgressEvents == 1);
+#endif
+
+    stateManager->Reset();
+}
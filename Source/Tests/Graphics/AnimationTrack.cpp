@@ -0,0 +1,101 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/AnimationTrack.h>
+
+namespace
+{
+
+Transform SampleTrack(const AnimationTrack& track, float time, float duration)
+{
+    Transform result;
+    unsigned frameIndex = 0;
+    track.Sample(time, duration, false, frameIndex, result);
+    return result;
+}
+
+}
+
+TEST_CASE("AnimationTrack key frames are compressed within error")
+{
+    const float duration = 2.0f;
+    const unsigned numKeyFrames = 61;
+
+    AnimationTrack track;
+    track.channelMask_ = CHANNEL_POSITION | CHANNEL_ROTATION | CHANNEL_SCALE;
+    for (unsigned i = 0; i < numKeyFrames; ++i)
+    {
+        const float time = duration * i / (numKeyFrames - 1);
+
+        AnimationKeyFrame keyFrame;
+        keyFrame.time_ = time;
+        // Linear motion first and then stop
+        keyFrame.position_ = Vector3::RIGHT * ea::min(time, 1.0f);
+        // Non-linear rotation
+        keyFrame.rotation_ = Quaternion(90.0f * time * time, Vector3::UP);
+        keyFrame.scale_ = Vector3::ONE;
+        track.AddKeyFrame(keyFrame);
+    }
+
+    AnimationTrack compressedTrack = track;
+    compressedTrack.CompressKeyFrames(0.001f, 0.5f, 0.001f);
+
+    REQUIRE(compressedTrack.GetNumKeyFrames() > 2);
+    REQUIRE(compressedTrack.GetNumKeyFrames() < numKeyFrames / 2);
+    REQUIRE(compressedTrack.keyFrames_.front().time_ == 0.0f);
+    REQUIRE(compressedTrack.keyFrames_.back().time_ == duration);
+
+    for (unsigned i = 0; i <= 200; ++i)
+    {
+        const float time = duration * i / 200;
+        const Transform expected = SampleTrack(track, time, duration);
+        const Transform actual = SampleTrack(compressedTrack, time, duration);
+
+        CHECK(expected.position_.Equals(actual.position_, 0.0011f));
+        CHECK(2.0f * Acos(Abs(expected.rotation_.DotProduct(actual.rotation_))) < 0.6f);
+        CHECK(expected.scale_.Equals(actual.scale_, 0.0011f));
+    }
+}
+
+TEST_CASE("Constant AnimationTrack is compressed to single key frame")
+{
+    AnimationTrack track;
+    track.channelMask_ = CHANNEL_POSITION | CHANNEL_ROTATION;
+    for (unsigned i = 0; i < 10; ++i)
+    {
+        AnimationKeyFrame keyFrame;
+        keyFrame.time_ = i * 0.1f;
+        keyFrame.position_ = Vector3::UP;
+        keyFrame.rotation_ = Quaternion(45.0f, Vector3::FORWARD);
+        // Ignored because the channel is not animated
+        keyFrame.scale_ = Vector3::ONE * static_cast<float>(i);
+        track.AddKeyFrame(keyFrame);
+    }
+
+    track.CompressKeyFrames(0.001f, 0.1f, 0.001f);
+
+    REQUIRE(track.GetNumKeyFrames() == 1);
+    CHECK(SampleTrack(track, 0.55f, 1.0f).position_.Equals(Vector3::UP));
+    CHECK(SampleTrack(track, 0.55f, 1.0f).rotation_.Equivalent(Quaternion(45.0f, Vector3::FORWARD)));
+}
@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/IO/FileSystem.h>
+
+#ifdef URHO3D_GLOW
+#include <Urho3D/Glow/BakedLightCache.h>
+
+TEST_CASE("BakedLightFileCache evicts light data to files within memory limit")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fs = context->GetSubsystem<FileSystem>();
+    const ea::string directory = fs->GetTemporaryDir() + "BakedLightFileCacheTest/";
+    const ea::string fileName = directory + "Lightmap-0.bin";
+
+    {
+        // Memory limit fits only one lightmap
+        const unsigned long long lightmapMemory = 4 * 4 * sizeof(Vector3);
+        BakedLightFileCache cache(context, directory, lightmapMemory);
+
+        BakedLightmap lightmap0(4);
+        lightmap0.lightmap_[3] = Vector3{1.0f, 2.0f, 3.0f};
+        BakedLightmap lightmap1(4);
+        lightmap1.lightmap_[5] = Vector3{0.5f, 0.25f, 0.125f};
+
+        cache.StoreLightmap(0, lightmap0);
+        cache.StoreLightmap(1, lightmap1);
+        REQUIRE(cache.GetMemoryUse() == lightmapMemory);
+        REQUIRE(fs->FileExists(fileName));
+
+        const auto lightmap0Copy = cache.LoadLightmap(0);
+        REQUIRE(lightmap0Copy);
+        REQUIRE(lightmap0Copy->lightmapSize_ == 4);
+        REQUIRE(lightmap0Copy->lightmap_ == lightmap0.lightmap_);
+
+        const auto lightmap1Copy = cache.LoadLightmap(1);
+        REQUIRE(lightmap1Copy);
+        REQUIRE(lightmap1Copy->lightmap_ == lightmap1.lightmap_);
+        REQUIRE(cache.GetMemoryUse() == lightmapMemory);
+
+        REQUIRE_FALSE(cache.LoadLightmap(2));
+        REQUIRE_FALSE(cache.LoadDirectLight(0));
+    }
+
+    REQUIRE_FALSE(fs->FileExists(fileName));
+}
+#endif
@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/RenderPipeline/ClusteredLighting.h>
+#include <Urho3D/Scene/Node.h>
+
+TEST_CASE("ClusteredLighting assigns lights to intersecting clusters only")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto node = MakeShared<Node>(context);
+    auto camera = node->CreateComponent<Camera>();
+    camera->SetNearClip(0.1f);
+    camera->SetFarClip(100.0f);
+
+    const BoundingBox centerLight{Vector3(-1.0f, -1.0f, 9.0f), Vector3(1.0f, 1.0f, 11.0f)};
+    const BoundingBox crossingNearPlane{Vector3(-20.0f, -20.0f, -5.0f), Vector3(20.0f, 20.0f, 5.0f)};
+    const BoundingBox behindCamera{Vector3(-1.0f, -1.0f, -11.0f), Vector3(1.0f, 1.0f, -9.0f)};
+
+    auto clusteredLighting = MakeShared<ClusteredLighting>(context);
+    clusteredLighting->BeginUpdate(camera);
+    clusteredLighting->AddLight(centerLight, {});
+    clusteredLighting->AddLight(crossingNearPlane, {});
+    clusteredLighting->AddLight(behindCamera, {});
+    clusteredLighting->EndUpdate();
+
+    REQUIRE(clusteredLighting->GetNumLights() == 2);
+
+    const auto centerCluster = clusteredLighting->GetClusterLights(clusteredLighting->GetClusterIndex({0.0f, 0.0f, 10.0f}));
+    REQUIRE(centerCluster.size() == 1);
+    CHECK(centerCluster[0] == 0);
+
+    const auto nearCluster = clusteredLighting->GetClusterLights(clusteredLighting->GetClusterIndex({0.0f, 0.0f, 1.0f}));
+    REQUIRE(nearCluster.size() == 1);
+    CHECK(nearCluster[0] == 1);
+
+    CHECK(clusteredLighting->GetClusterLights(clusteredLighting->GetClusterIndex({0.0f, 0.0f, 50.0f})).empty());
+    CHECK(clusteredLighting->GetClusterLights(clusteredLighting->GetClusterIndex({5.0f, 0.0f, 10.0f})).empty());
+}
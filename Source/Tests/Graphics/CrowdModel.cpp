@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+#include "../ModelUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/CrowdModel.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Utility/VertexAnimationMetadata.h>
+
+TEST_CASE("CrowdModel resolves animation frames of instances")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto modelView = Tests::CreateSkinnedQuad_Model(context);
+    modelView->AddMetadata(VertexAnimationMetadata::Animations, StringVector{"Idle", "Walk"});
+    modelView->AddMetadata(VertexAnimationMetadata::AnimationFrames, VariantVector{IntVector2(0, 10), IntVector2(10, 20)});
+    modelView->AddMetadata(VertexAnimationMetadata::FrameRate, 10.0f);
+    auto model = modelView->ExportModel();
+
+    auto scene = MakeShared<Scene>(context);
+    auto octree = scene->CreateComponent<Octree>();
+    auto camera = scene->CreateChild("Camera")->CreateComponent<Camera>();
+    auto crowdModel = scene->CreateChild("Crowd")->CreateComponent<CrowdModel>();
+    crowdModel->SetModel(model);
+
+    REQUIRE(crowdModel->GetNumAnimations() == 2);
+    REQUIRE(crowdModel->FindAnimation("Walk") == 1);
+    REQUIRE(crowdModel->FindAnimation("Run") == M_MAX_UNSIGNED);
+    REQUIRE(Equals(crowdModel->GetAnimationLength(1), 2.0f));
+
+    crowdModel->AddInstance(Transform::Identity, 0, 0.25f);
+    crowdModel->AddInstance(Transform{Vector3(5.0f, 0.0f, 0.0f)}, 1, 1.95f);
+    octree->Update(FrameInfo{});
+
+    FrameInfo frameInfo;
+    frameInfo.camera_ = camera;
+    crowdModel->UpdateBatches(frameInfo);
+
+    const SourceBatch& batch = crowdModel->GetBatches()[0];
+    REQUIRE(batch.numWorldTransforms_ == 2);
+    REQUIRE(batch.worldTransform_[1].Translation().Equals(Vector3(5.0f, 0.0f, 0.0f)));
+    REQUIRE(batch.instancingData_);
+
+    REQUIRE(batch.instancingData_[0].x_ == 2.0f);
+    REQUIRE(batch.instancingData_[0].y_ == 3.0f);
+    REQUIRE(Equals(batch.instancingData_[0].z_, 0.5f));
+
+    // Last frame of the looped animation blends into the first one
+    REQUIRE(batch.instancingData_[1].x_ == 29.0f);
+    REQUIRE(batch.instancingData_[1].y_ == 10.0f);
+    REQUIRE(Equals(batch.instancingData_[1].z_, 0.5f, 0.001f));
+
+    // Instances are serialized
+    auto crowdModelCopy = scene->CreateChild("Copy")->CreateComponent<CrowdModel>();
+    crowdModelCopy->SetInstancesAttr(crowdModel->GetInstancesAttr());
+    REQUIRE(crowdModelCopy->GetNumInstances() == 2);
+    REQUIRE(crowdModelCopy->GetInstance(1).animation_ == 1);
+    REQUIRE(Equals(crowdModelCopy->GetInstance(1).time_, 1.95f));
+    REQUIRE(crowdModelCopy->GetInstance(1).transform_.position_.Equals(Vector3(5.0f, 0.0f, 0.0f)));
+}
@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/DecalSet.h>
+
+namespace
+{
+
+/// Create grid of quads on the XZ plane, two triangles each.
+void CreateGrid(unsigned size, ea::vector<Vector3>& positions, ea::vector<unsigned>& indices)
+{
+    for (unsigned z = 0; z <= size; ++z)
+    {
+        for (unsigned x = 0; x <= size; ++x)
+            positions.emplace_back(static_cast<float>(x), 0.0f, static_cast<float>(z));
+    }
+
+    for (unsigned z = 0; z < size; ++z)
+    {
+        for (unsigned x = 0; x < size; ++x)
+        {
+            const unsigned i0 = z * (size + 1) + x;
+            const unsigned i1 = i0 + 1;
+            const unsigned i2 = i0 + size + 1;
+            const unsigned i3 = i2 + 1;
+            indices.insert(indices.end(), {i0, i2, i1, i1, i2, i3});
+        }
+    }
+}
+
+}
+
+TEST_CASE("DecalTriangleTree returns all triangles intersecting the frustum")
+{
+    ea::vector<Vector3> positions;
+    ea::vector<unsigned> indices;
+    CreateGrid(64, positions, indices);
+
+    DecalTriangleTree tree;
+    tree.Define(positions, {}, indices);
+    REQUIRE(tree.GetNumTriangles() == 64 * 64 * 2);
+
+    // Project the decal down onto the grid
+    Frustum frustum;
+    frustum.DefineOrtho(3.0f, 1.0f, 1.0f, 0.0f, 2.0f,
+        Matrix3x4(Vector3(20.5f, 1.0f, 30.5f), Quaternion(90.0f, 0.0f, 0.0f), 1.0f));
+
+    ea::vector<unsigned> triangles;
+    tree.GetTriangles(triangles, frustum);
+    REQUIRE(!triangles.empty());
+    REQUIRE(triangles.size() < tree.GetNumTriangles() / 16);
+
+    // Every triangle inside the frustum is found
+    const ea::vector<Vector3>& treePositions = tree.GetPositions();
+    const ea::vector<unsigned>& treeIndices = tree.GetIndices();
+    for (unsigned i = 0; i < tree.GetNumTriangles(); ++i)
+    {
+        BoundingBox box;
+        for (unsigned j = 0; j < 3; ++j)
+            box.Merge(treePositions[treeIndices[i * 3 + j]]);
+
+        if (frustum.IsInside(box) != OUTSIDE)
+            REQUIRE(triangles.contains(i));
+    }
+}
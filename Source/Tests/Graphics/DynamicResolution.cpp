@@ -0,0 +1,92 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+#include "../CommonUtils.h"
+
+#include <Urho3D/RenderPipeline/DynamicResolutionController.h>
+
+namespace
+{
+
+DynamicResolutionSettings CreateSettings()
+{
+    DynamicResolutionSettings settings;
+    settings.enabled_ = true;
+    settings.targetFrameTime_ = 0.016f;
+    settings.minScale_ = 0.5f;
+    settings.maxScale_ = 1.0f;
+    settings.scaleStep_ = 0.05f;
+    settings.adjustInterval_ = 10;
+    return settings;
+}
+
+float RunFrames(DynamicResolutionController& controller, float fullResolutionFrameTime, unsigned numFrames)
+{
+    float scale = controller.GetRenderScale();
+    for (unsigned i = 0; i < numFrames; ++i)
+        scale = controller.Update(fullResolutionFrameTime * scale * scale);
+    return scale;
+}
+
+}
+
+TEST_CASE("Dynamic resolution is disabled by default")
+{
+    DynamicResolutionController controller;
+    REQUIRE(controller.Update(0.1f) == 1.0f);
+    REQUIRE(controller.GetRenderScale() == 1.0f);
+}
+
+TEST_CASE("Dynamic resolution keeps full scale within frame budget")
+{
+    DynamicResolutionController controller;
+    controller.SetSettings(CreateSettings());
+
+    REQUIRE(RunFrames(controller, 0.010f, 200) == 1.0f);
+}
+
+TEST_CASE("Dynamic resolution converges to target frame time")
+{
+    DynamicResolutionController controller;
+    controller.SetSettings(CreateSettings());
+
+    // Full resolution costs twice the budget, so the scale should settle near sqrt(0.5)
+    const float scale = RunFrames(controller, 0.032f, 1000);
+    REQUIRE(scale < 0.75f);
+    REQUIRE(scale >= 0.6f);
+
+    // Scale should be stable once converged
+    REQUIRE(RunFrames(controller, 0.032f, 100) == scale);
+
+    // Scale should return to full when the load goes away
+    REQUIRE(RunFrames(controller, 0.008f, 1000) == 1.0f);
+}
+
+TEST_CASE("Dynamic resolution respects scale limits")
+{
+    DynamicResolutionController controller;
+    controller.SetSettings(CreateSettings());
+
+    REQUIRE(RunFrames(controller, 0.5f, 1000) == 0.5f);
+
+    controller.Reset();
+    REQUIRE(controller.GetRenderScale() == 1.0f);
+}
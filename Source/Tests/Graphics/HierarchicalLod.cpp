@@ -0,0 +1,88 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/HierarchicalLod.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Scene/Scene.h>
+
+TEST_CASE("HierarchicalLod switches between proxy and detailed nodes with hysteresis")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+
+    Node* detailedNode1 = scene->CreateChild("Detailed 1");
+    Node* detailedNode2 = scene->CreateChild("Detailed 2");
+    auto detailedModel1 = detailedNode1->CreateComponent<StaticModel>();
+    auto detailedModel2 = detailedNode2->CreateComponent<StaticModel>();
+
+    Node* proxyNode = scene->CreateChild("Proxy");
+    auto proxyModel = proxyNode->CreateComponent<StaticModel>();
+    proxyModel->SetEnabled(false);
+    auto hierarchicalLod = proxyNode->CreateComponent<HierarchicalLod>();
+    hierarchicalLod->SetDistance(100.0f);
+    hierarchicalLod->SetHysteresis(0.1f);
+    hierarchicalLod->AddDetailedNode(detailedNode1);
+    hierarchicalLod->AddDetailedNode(detailedNode2);
+    hierarchicalLod->AddDetailedNode(detailedNode2);
+    REQUIRE(hierarchicalLod->GetNumDetailedNodes() == 2);
+    REQUIRE(hierarchicalLod->GetNodeIDsAttr().size() == 3);
+
+    Node* cameraNode = scene->CreateChild("Camera");
+    auto camera = cameraNode->CreateComponent<Camera>();
+
+    const auto updateAt = [&](float distance)
+    {
+        cameraNode->SetPosition({0.0f, 0.0f, -distance});
+        hierarchicalLod->UpdateLod(camera);
+    };
+
+    updateAt(50.0f);
+    REQUIRE_FALSE(hierarchicalLod->IsProxyShown());
+    REQUIRE(detailedModel1->IsEnabled());
+    REQUIRE_FALSE(proxyModel->IsEnabled());
+
+    updateAt(200.0f);
+    REQUIRE(hierarchicalLod->IsProxyShown());
+    REQUIRE_FALSE(detailedModel1->IsEnabled());
+    REQUIRE_FALSE(detailedModel2->IsEnabled());
+    REQUIRE(proxyModel->IsEnabled());
+
+    updateAt(95.0f);
+    REQUIRE(hierarchicalLod->IsProxyShown());
+
+    updateAt(80.0f);
+    REQUIRE_FALSE(hierarchicalLod->IsProxyShown());
+    REQUIRE(detailedModel1->IsEnabled());
+    REQUIRE(detailedModel2->IsEnabled());
+    REQUIRE_FALSE(proxyModel->IsEnabled());
+
+    // Disabled component restores detailed nodes
+    updateAt(200.0f);
+    REQUIRE(hierarchicalLod->IsProxyShown());
+    hierarchicalLod->SetEnabled(false);
+    REQUIRE_FALSE(hierarchicalLod->IsProxyShown());
+    REQUIRE(detailedModel1->IsEnabled());
+    REQUIRE(detailedModel2->IsEnabled());
+}
@@ -0,0 +1,53 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#ifdef URHO3D_GLOW
+#include <Urho3D/Glow/IncrementalLightBaker.h>
+
+TEST_CASE("Light baking chunk job and result are serialized")
+{
+    LightBakingChunkJob job;
+    job.chunks_ = {IntVector3{0, 0, 0}, IntVector3{1, -2, 3}};
+
+    const LightBakingChunkJob jobCopy = LightBakingChunkJob::FromBytes(job.ToBytes());
+    REQUIRE(jobCopy.chunks_ == job.chunks_);
+
+    LightBakingChunkResult result;
+    result.lightmapIndices_ = {3, 7};
+    result.lightmaps_.emplace_back(2);
+    result.lightmaps_.emplace_back(4);
+    result.lightmaps_[0].lightmap_[1] = Vector3{1.0f, 2.0f, 3.0f};
+    result.lightmaps_[1].lightmap_[15] = Vector3{0.5f, 0.25f, 0.125f};
+
+    const LightBakingChunkResult resultCopy = LightBakingChunkResult::FromBytes(result.ToBytes());
+    REQUIRE(resultCopy.lightmapIndices_ == result.lightmapIndices_);
+    REQUIRE(resultCopy.lightmaps_.size() == 2);
+    for (unsigned i = 0; i < 2; ++i)
+    {
+        REQUIRE(resultCopy.lightmaps_[i].lightmapSize_ == result.lightmaps_[i].lightmapSize_);
+        REQUIRE(resultCopy.lightmaps_[i].lightmap_ == result.lightmaps_[i].lightmap_);
+    }
+}
+#endif
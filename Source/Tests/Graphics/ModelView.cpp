@@ -23,9 +23,12 @@
 #include "../CommonUtils.h"
 #include "../ModelUtils.h"
 
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/Graphics/Geometry.h>
 #include <Urho3D/Graphics/IndexBuffer.h>
+#include <Urho3D/Graphics/MeshOptimizer.h>
 #include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/ModelResidencyManager.h>
 #include <Urho3D/Graphics/ModelView.h>
 
 TEST_CASE("Simple model is constructed and desconstructed")
@@ -465,3 +468,452 @@ TEST_CASE("Animation is serialized")
         }
     }
 }
+
+TEST_CASE("ModelView geometry is welded and optimized")
+{
+    static const unsigned gridSize = 32;
+
+    // Create grid of triangles with unique vertices in scrambled order
+    GeometryLODView lodView;
+    lodView.primitiveType_ = TRIANGLE_LIST;
+    lodView.vertexFormat_.position_ = TYPE_VECTOR3;
+
+    ea::vector<ea::array<Vector3, 3>> triangles;
+    for (unsigned y = 0; y < gridSize; ++y)
+    {
+        for (unsigned x = 0; x < gridSize; ++x)
+        {
+            const Vector3 p00{static_cast<float>(x), 0.0f, static_cast<float>(y)};
+            const Vector3 p10 = p00 + Vector3::RIGHT;
+            const Vector3 p01 = p00 + Vector3::FORWARD;
+            const Vector3 p11 = p00 + Vector3::RIGHT + Vector3::FORWARD;
+            triangles.push_back({p00, p01, p11});
+            triangles.push_back({p00, p11, p10});
+        }
+    }
+
+    for (unsigned i = 0; i < triangles.size(); ++i)
+    {
+        const auto& triangle = triangles[(i * 7919) % triangles.size()];
+        for (const Vector3& position : triangle)
+        {
+            ModelVertex vertex;
+            vertex.SetPosition(position);
+            lodView.indices_.push_back(lodView.vertices_.size());
+            lodView.vertices_.push_back(vertex);
+        }
+    }
+
+    const auto getCentroids = [](const GeometryLODView& lodView)
+    {
+        ea::vector<ea::pair<float, float>> result;
+        for (unsigned i = 0; i < lodView.indices_.size(); i += 3)
+        {
+            Vector3 centroid;
+            for (unsigned k = 0; k < 3; ++k)
+                centroid += lodView.vertices_[lodView.indices_[i + k]].position_.ToVector3();
+            result.emplace_back(centroid.x_, centroid.z_);
+        }
+        ea::sort(result.begin(), result.end());
+        return result;
+    };
+    const auto originalCentroids = getCentroids(lodView);
+
+    // Weld vertices
+    lodView.WeldVertices();
+    REQUIRE(lodView.vertices_.size() == (gridSize + 1) * (gridSize + 1));
+    REQUIRE(lodView.indices_.size() == triangles.size() * 3);
+    REQUIRE(getCentroids(lodView) == originalCentroids);
+
+    // Optimize triangles
+    const unsigned numVertices = lodView.vertices_.size();
+    const float scrambledACMR = CalculateAverageCacheMissRatio(lodView.indices_, numVertices);
+    lodView.OptimizeTriangles();
+    const float optimizedACMR = CalculateAverageCacheMissRatio(lodView.indices_, numVertices);
+
+    REQUIRE(lodView.vertices_.size() == numVertices);
+    REQUIRE(getCentroids(lodView) == originalCentroids);
+    CHECK(optimizedACMR < 1.0f);
+    CHECK(optimizedACMR < scrambledACMR * 0.5f);
+
+    // Vertices are ordered by first use
+    unsigned maxIndex = 0;
+    for (unsigned index : lodView.indices_)
+    {
+        REQUIRE(index <= maxIndex + 1);
+        maxIndex = ea::max(maxIndex, index);
+    }
+}
+
+TEST_CASE("ModelView LODs are generated")
+{
+    static const unsigned gridSize = 32;
+
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto modelView = MakeShared<ModelView>(context);
+
+    // Create flat grid as the only LOD
+    auto& geometries = modelView->GetGeometries();
+    geometries.resize(1);
+    geometries[0].lods_.resize(1);
+
+    GeometryLODView& sourceLod = geometries[0].lods_[0];
+    sourceLod.primitiveType_ = TRIANGLE_LIST;
+    sourceLod.vertexFormat_.position_ = TYPE_VECTOR3;
+    for (unsigned y = 0; y <= gridSize; ++y)
+    {
+        for (unsigned x = 0; x <= gridSize; ++x)
+        {
+            ModelVertex vertex;
+            vertex.SetPosition({static_cast<float>(x), 0.0f, static_cast<float>(y)});
+            sourceLod.vertices_.push_back(vertex);
+        }
+    }
+
+    const auto getIndex = [](unsigned x, unsigned y) { return y * (gridSize + 1) + x; };
+    for (unsigned y = 0; y < gridSize; ++y)
+    {
+        for (unsigned x = 0; x < gridSize; ++x)
+        {
+            sourceLod.indices_.insert(sourceLod.indices_.end(), {getIndex(x, y), getIndex(x, y + 1),
+                getIndex(x + 1, y + 1), getIndex(x, y), getIndex(x + 1, y + 1), getIndex(x + 1, y)});
+        }
+    }
+
+    modelView->GenerateLODs(3, 0.5f, 10.0f, 0.01f);
+
+    const unsigned numSourceTriangles = gridSize * gridSize * 2;
+    REQUIRE(geometries[0].lods_.size() == 4);
+    CHECK(Equals(geometries[0].lods_[1].lodDistance_, 10.0f));
+    CHECK(Equals(geometries[0].lods_[2].lodDistance_, 10.0f * Sqrt(2.0f), 0.001f));
+    CHECK(Equals(geometries[0].lods_[3].lodDistance_, 20.0f, 0.001f));
+
+    unsigned numPreviousTriangles = numSourceTriangles;
+    for (unsigned lodIndex = 1; lodIndex < 4; ++lodIndex)
+    {
+        const GeometryLODView& lodView = geometries[0].lods_[lodIndex];
+        const unsigned numTriangles = lodView.GetNumPrimitives();
+        CHECK(numTriangles < numPreviousTriangles);
+        CHECK(numTriangles >= (numSourceTriangles >> lodIndex) * 0.9f);
+        CHECK(lodView.vertices_.size() < geometries[0].lods_[0].vertices_.size());
+        numPreviousTriangles = numTriangles;
+
+        // Simplified flat grid should cover the same area without flipped triangles
+        float area = 0.0f;
+        for (unsigned i = 0; i < lodView.indices_.size(); i += 3)
+        {
+            const Vector3 p0 = lodView.vertices_[lodView.indices_[i]].GetPosition();
+            const Vector3 p1 = lodView.vertices_[lodView.indices_[i + 1]].GetPosition();
+            const Vector3 p2 = lodView.vertices_[lodView.indices_[i + 2]].GetPosition();
+            const Vector3 normal = (p1 - p0).CrossProduct(p2 - p0);
+            CHECK(normal.y_ > 0.0f);
+            area += normal.Length() * 0.5f;
+        }
+        CHECK(Equals(area, static_cast<float>(gridSize * gridSize), 0.01f));
+    }
+
+    const auto model = modelView->ExportModel();
+    REQUIRE(model->GetNumGeometryLodLevels(0) == 4);
+}
+
+TEST_CASE("ModelView vertices are quantized on export")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto modelView = MakeShared<ModelView>(context);
+
+    auto& geometries = modelView->GetGeometries();
+    geometries.resize(1);
+    geometries[0].lods_.resize(1);
+
+    GeometryLODView& lodView = geometries[0].lods_[0];
+    Tests::AppendQuad(lodView, {0.0f, 0.5f, 0.0f}, {30.0f, Vector3::UP}, {1.0f, 2.0f}, Color::WHITE);
+    Tests::AppendQuad(lodView, {1.5f, 0.5f, 0.0f}, {90.0f, Vector3::RIGHT}, {1.0f, 1.0f}, Color::RED);
+    lodView.vertexFormat_ = Tests::GetVertexFormat();
+    lodView.vertexFormat_.uv_[0] = TYPE_VECTOR2;
+    for (ModelVertex& vertex : lodView.vertices_)
+        vertex.uv_[0] = Vector4{vertex.position_.x_, vertex.position_.y_, 0.0f, 0.0f};
+
+    const auto floatModel = modelView->ExportModel();
+    const auto quantizedModel = modelView->ExportModel(EMPTY_STRING, ModelVertexQuantizationFlag::All);
+
+    // Check vertex format
+    REQUIRE(quantizedModel->GetVertexBuffers().size() == 1);
+    const VertexBuffer* vertexBuffer = quantizedModel->GetVertexBuffers()[0];
+    CHECK(vertexBuffer->HasElement(TYPE_HALF4, SEM_POSITION));
+    CHECK(vertexBuffer->HasElement(TYPE_BYTE4_NORM, SEM_NORMAL));
+    CHECK(vertexBuffer->HasElement(TYPE_UBYTE4_NORM, SEM_COLOR));
+    CHECK(vertexBuffer->HasElement(TYPE_HALF2, SEM_TEXCOORD));
+    CHECK(vertexBuffer->GetVertexSize() < floatModel->GetVertexBuffers()[0]->GetVertexSize());
+
+    // Check that data is preserved
+    auto quantizedModelView = MakeShared<ModelView>(context);
+    REQUIRE(quantizedModelView->ImportModel(quantizedModel));
+
+    const GeometryLODView& quantizedLodView = quantizedModelView->GetGeometries()[0].lods_[0];
+    REQUIRE(quantizedLodView.vertices_.size() == lodView.vertices_.size());
+    CHECK(quantizedLodView.indices_ == lodView.indices_);
+    for (unsigned i = 0; i < lodView.vertices_.size(); ++i)
+    {
+        const ModelVertex& expected = lodView.vertices_[i];
+        const ModelVertex& actual = quantizedLodView.vertices_[i];
+        CHECK(actual.position_.Equals(expected.position_, 0.005f));
+        CHECK(actual.normal_.Equals(expected.normal_, 0.01f));
+        CHECK(actual.uv_[0].ToVector2().Equals(expected.uv_[0].ToVector2(), 0.005f));
+    }
+
+    // Check that CPU-side geometry data is still available
+    const Geometry* geometry = quantizedModel->GetGeometry(0, 0);
+    const Ray ray{Vector3{0.0f, 0.5f, -5.0f}, Vector3::FORWARD};
+    CHECK(geometry->GetHitDistance(ray) < M_INFINITY);
+}
+
+TEST_CASE("ModelView meshlets are generated and serialized")
+{
+    static const unsigned gridSize = 32;
+    static const unsigned maxVertices = 64;
+    static const unsigned maxTriangles = 124;
+
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto modelView = MakeShared<ModelView>(context);
+
+    // Create flat grid facing up
+    auto& geometries = modelView->GetGeometries();
+    geometries.resize(1);
+    geometries[0].lods_.resize(1);
+
+    GeometryLODView& lodView = geometries[0].lods_[0];
+    lodView.primitiveType_ = TRIANGLE_LIST;
+    lodView.vertexFormat_.position_ = TYPE_VECTOR3;
+    for (unsigned y = 0; y <= gridSize; ++y)
+    {
+        for (unsigned x = 0; x <= gridSize; ++x)
+        {
+            ModelVertex vertex;
+            vertex.SetPosition({static_cast<float>(x), 0.0f, static_cast<float>(y)});
+            lodView.vertices_.push_back(vertex);
+        }
+    }
+
+    const auto getIndex = [](unsigned x, unsigned y) { return y * (gridSize + 1) + x; };
+    for (unsigned y = 0; y < gridSize; ++y)
+    {
+        for (unsigned x = 0; x < gridSize; ++x)
+        {
+            lodView.indices_.insert(lodView.indices_.end(), {getIndex(x, y), getIndex(x, y + 1),
+                getIndex(x + 1, y + 1), getIndex(x, y), getIndex(x + 1, y + 1), getIndex(x + 1, y)});
+        }
+    }
+
+    modelView->GenerateMeshlets(maxVertices, maxTriangles);
+
+    // Check that meshlets describe the same triangles
+    const GeometryMeshlets& meshlets = lodView.meshlets_;
+    const unsigned numTriangles = gridSize * gridSize * 2;
+    REQUIRE_FALSE(meshlets.IsEmpty());
+    CHECK(meshlets.meshlets_.size() < numTriangles / maxTriangles * 2);
+
+    ea::vector<ea::array<unsigned, 3>> expectedTriangles;
+    for (unsigned i = 0; i < lodView.indices_.size(); i += 3)
+        expectedTriangles.push_back({lodView.indices_[i], lodView.indices_[i + 1], lodView.indices_[i + 2]});
+
+    ea::vector<ea::array<unsigned, 3>> actualTriangles;
+    for (const ModelMeshlet& meshlet : meshlets.meshlets_)
+    {
+        CHECK(meshlet.vertexCount_ <= maxVertices);
+        CHECK(meshlet.triangleCount_ <= maxTriangles);
+
+        for (unsigned i = 0; i < meshlet.triangleCount_; ++i)
+        {
+            ea::array<unsigned, 3> triangle;
+            for (unsigned k = 0; k < 3; ++k)
+            {
+                const unsigned localIndex = meshlets.triangles_[(meshlet.triangleOffset_ + i) * 3 + k];
+                REQUIRE(localIndex < meshlet.vertexCount_);
+
+                triangle[k] = meshlets.vertices_[meshlet.vertexOffset_ + localIndex];
+                const Vector3 position = lodView.vertices_[triangle[k]].GetPosition();
+                CHECK((position - meshlet.center_).Length() <= meshlet.radius_ + M_LARGE_EPSILON);
+            }
+            actualTriangles.push_back(triangle);
+        }
+
+        // Flat meshlet is visible only from above
+        CHECK(meshlet.coneAxis_.Equals(Vector3::UP));
+        CHECK(meshlet.coneCutoff_ < 1.0f);
+        const auto isBackFacing = [&](const Vector3& cameraPosition)
+        {
+            return (meshlet.coneApex_ - cameraPosition).Normalized().DotProduct(meshlet.coneAxis_) >= meshlet.coneCutoff_;
+        };
+        CHECK_FALSE(isBackFacing(meshlet.center_ + Vector3{1.0f, 10.0f, 1.0f}));
+        CHECK(isBackFacing(meshlet.center_ + Vector3{1.0f, -10.0f, 1.0f}));
+    }
+
+    ea::sort(expectedTriangles.begin(), expectedTriangles.end());
+    ea::sort(actualTriangles.begin(), actualTriangles.end());
+    CHECK(actualTriangles == expectedTriangles);
+
+    // Check that meshlets survive serialization
+    VectorBuffer modelData;
+    REQUIRE(modelView->ExportModel()->Save(modelData));
+    modelData.Seek(0);
+
+    auto model = MakeShared<Model>(context);
+    REQUIRE(model->Load(modelData));
+
+    const GeometryMeshlets* loadedMeshlets = model->GetGeometryMeshlets(0, 0);
+    REQUIRE(loadedMeshlets);
+    CHECK(*loadedMeshlets == meshlets);
+
+    auto loadedModelView = MakeShared<ModelView>(context);
+    REQUIRE(loadedModelView->ImportModel(model));
+    CHECK(loadedModelView->GetGeometries()[0].lods_[0].meshlets_ == meshlets);
+}
+
+TEST_CASE("Model LOD levels are streamed from the file")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto modelView = MakeShared<ModelView>(context);
+
+    // Geometry #0 has three LOD levels with 3, 2 and 1 quads, geometry #1 has single LOD level
+    auto& geometries = modelView->GetGeometries();
+    geometries.resize(2);
+    geometries[0].lods_.resize(3);
+    geometries[1].lods_.resize(1);
+    for (unsigned lodIndex = 0; lodIndex < 3; ++lodIndex)
+    {
+        GeometryLODView& lodView = geometries[0].lods_[lodIndex];
+        lodView.vertexFormat_ = Tests::GetVertexFormat();
+        lodView.lodDistance_ = lodIndex * 10.0f;
+        for (unsigned i = lodIndex; i < 3; ++i)
+            Tests::AppendQuad(lodView, {i * 2.0f, 0.0f, 0.0f}, Quaternion::IDENTITY, {1.0f, 1.0f}, Color::WHITE);
+    }
+    geometries[1].lods_[0].vertexFormat_ = Tests::GetVertexFormat();
+    Tests::AppendQuad(geometries[1].lods_[0], {0.0f, 2.0f, 0.0f}, Quaternion::IDENTITY, {1.0f, 1.0f}, Color::WHITE);
+
+    VectorBuffer modelData;
+    REQUIRE(modelView->ExportModel(EMPTY_STRING, ModelVertexQuantizationFlag::None, true)->Save(modelData));
+
+    context->RegisterSubsystem(new ModelResidencyManager(context));
+
+    // Only the coarsest LOD levels are loaded initially
+    modelData.Seek(0);
+    auto model = MakeShared<Model>(context);
+    REQUIRE(model->Load(modelData));
+    REQUIRE(model->IsLodStreamable());
+    REQUIRE(model->GetMaxStreamedLodsToSkip() == 2);
+    REQUIRE(model->GetStreamedLodsToSkip() == 2);
+    CHECK(model->GetVertexBuffers().size() == 3);
+    CHECK(model->GetGeometry(0, 0)->GetIndexCount() == 6);
+    CHECK(model->GetGeometry(0, 1)->GetIndexCount() == 6);
+    CHECK(model->GetGeometry(0, 2)->GetIndexCount() == 6);
+    CHECK(model->GetGeometry(1, 0)->GetIndexCount() == 6);
+    CHECK(Equals(model->GetGeometry(0, 1)->GetLodDistance(), 10.0f));
+
+    // Stream in all LOD levels
+    ea::vector<ModelStreamedBuffer> buffers = model->GetStreamedBuffers(0);
+    REQUIRE(buffers.size() == 4);
+    REQUIRE(Model::ReadStreamedBuffers(modelData, buffers));
+    REQUIRE(model->SetStreamedData(buffers, 0));
+    CHECK(model->GetStreamedLodsToSkip() == 0);
+    CHECK(model->GetGeometry(0, 0)->GetIndexCount() == 18);
+    CHECK(model->GetGeometry(0, 1)->GetIndexCount() == 12);
+    CHECK(model->GetGeometry(0, 2)->GetIndexCount() == 6);
+
+    const Ray ray{Vector3{4.0f, 0.0f, -5.0f}, Vector3::FORWARD};
+    CHECK(model->GetGeometry(0, 0)->GetHitDistance(ray) < M_INFINITY);
+
+    // Stream out the finest LOD level
+    REQUIRE(model->SetStreamedLodsToSkip(1));
+    CHECK(model->GetGeometry(0, 0)->GetIndexCount() == 12);
+    CHECK(model->GetGeometry(0, 1)->GetIndexCount() == 12);
+    CHECK(model->GetStreamedBuffers(0).size() == 2);
+    CHECK_FALSE(model->Save(modelData));
+
+    // Models with shared buffers are loaded completely
+    VectorBuffer sharedModelData;
+    REQUIRE(modelView->ExportModel()->Save(sharedModelData));
+    sharedModelData.Seek(0);
+    auto sharedModel = MakeShared<Model>(context);
+    REQUIRE(sharedModel->Load(sharedModelData));
+    CHECK_FALSE(sharedModel->IsLodStreamable());
+    CHECK(sharedModel->GetGeometry(0, 0)->GetIndexCount() == 18);
+
+    context->RemoveSubsystem<ModelResidencyManager>();
+}
+
+namespace
+{
+
+void AppendGrid(GeometryLODView& dest, unsigned size, bool bumpy)
+{
+    for (unsigned z = 0; z <= size; ++z)
+    {
+        for (unsigned x = 0; x <= size; ++x)
+        {
+            const float height = bumpy ? Sin(x * 37.0f) * Cos(z * 23.0f) * 0.3f : 0.0f;
+            ModelVertex vertex;
+            vertex.position_ = Vector4{static_cast<float>(x), height, static_cast<float>(z), 1.0f};
+            vertex.normal_ = Vector4{0.0f, 1.0f, 0.0f, 0.0f};
+            vertex.uv_[0] = Vector4{static_cast<float>(x), static_cast<float>(z), 0.0f, 0.0f};
+            dest.vertices_.push_back(vertex);
+        }
+    }
+
+    for (unsigned z = 0; z < size; ++z)
+    {
+        for (unsigned x = 0; x < size; ++x)
+        {
+            const unsigned base = z * (size + 1) + x;
+            const unsigned quad[6] = {base, base + size + 1, base + 1, base + 1, base + size + 1, base + size + 2};
+            dest.indices_.insert(dest.indices_.end(), ea::begin(quad), ea::end(quad));
+        }
+    }
+
+    if (bumpy)
+        dest.RecalculateSmoothNormals();
+}
+
+}
+
+TEST_CASE("Tangents are calculated for small and large geometries")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto modelView = MakeShared<ModelView>(context);
+
+    auto& geometries = modelView->GetGeometries();
+    geometries.resize(2);
+    geometries[0].lods_.resize(1);
+    geometries[1].lods_.resize(1);
+    AppendGrid(geometries[0].lods_[0], 2, false);
+    AppendGrid(geometries[1].lods_[0], 200, false);
+
+    modelView->CalculateMissingTangents();
+
+    for (const GeometryView& geometry : geometries)
+    {
+        const GeometryLODView& lod = geometry.lods_[0];
+        REQUIRE(lod.vertexFormat_.tangent_ == TYPE_VECTOR4);
+        for (const ModelVertex& vertex : lod.vertices_)
+            REQUIRE(vertex.tangent_.Equals(Vector4{1.0f, 0.0f, 0.0f, -1.0f}));
+    }
+}
+
+TEST_CASE("Tangents calculated in multiple threads are identical to tangents calculated in one thread")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    GeometryLODView lodView;
+    AppendGrid(lodView, 100, true);
+
+    GeometryLODView lodViewCopy = lodView;
+    lodView.RecalculateTangents();
+    lodViewCopy.RecalculateTangents(context->GetSubsystem<WorkQueue>());
+
+    for (unsigned i = 0; i < lodView.vertices_.size(); ++i)
+    {
+        const Vector4& tangent = lodView.vertices_[i].tangent_;
+        REQUIRE(tangent == lodViewCopy.vertices_[i].tangent_);
+        REQUIRE(tangent.ToVector3().Length() == Catch::Approx(1.0f));
+        REQUIRE(Abs(tangent.ToVector3().DotProduct(lodView.vertices_[i].normal_.ToVector3())) < 0.001f);
+    }
+}
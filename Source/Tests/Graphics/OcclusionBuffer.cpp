@@ -0,0 +1,73 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/OcclusionBuffer.h>
+#include <Urho3D/Scene/Node.h>
+
+TEST_CASE("OcclusionBuffer hides boxes behind occluder")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto node = MakeShared<Node>(context);
+    auto camera = node->CreateComponent<Camera>();
+    camera->SetAspectRatio(2.0f);
+
+    // Quad that covers the left half of the view
+    const Vector3 vertices[] = {
+        {-20.0f, -10.0f, 10.0f}, {-20.0f, 10.0f, 10.0f}, {0.0f, 10.0f, 10.0f},
+        {-20.0f, -10.0f, 10.0f}, {0.0f, 10.0f, 10.0f}, {0.0f, -10.0f, 10.0f},
+    };
+
+    auto buffer = MakeShared<OcclusionBuffer>(context);
+    REQUIRE(buffer->SetSize(64, 32, false));
+    buffer->SetView(camera);
+    buffer->SetCullMode(CULL_NONE);
+    buffer->Clear();
+    REQUIRE(buffer->AddTriangles(Matrix3x4::IDENTITY, vertices, sizeof(Vector3), 0, 6));
+    buffer->DrawTriangles();
+
+    const BoundingBox behindOccluder{Vector3(-6.0f, -2.0f, 20.0f), Vector3(-4.0f, 2.0f, 22.0f)};
+    const BoundingBox beforeOccluder{Vector3(-6.0f, -2.0f, 5.0f), Vector3(-4.0f, 2.0f, 7.0f)};
+    const BoundingBox besideOccluder{Vector3(4.0f, -2.0f, 20.0f), Vector3(6.0f, 2.0f, 22.0f)};
+    const BoundingBox crossingNearPlane{Vector3(-6.0f, -2.0f, -1.0f), Vector3(-4.0f, 2.0f, 22.0f)};
+
+    // Check both pixel-level test and depth hierarchy
+    for (bool useHierarchy : {false, true})
+    {
+        if (useHierarchy)
+            buffer->BuildDepthHierarchy();
+
+        CHECK_FALSE(buffer->IsVisible(behindOccluder));
+        CHECK(buffer->IsVisible(beforeOccluder));
+        CHECK(buffer->IsVisible(besideOccluder));
+        CHECK(buffer->IsVisible(crossingNearPlane));
+    }
+
+    // Check depth values of the covered and the empty halves
+    const int* depth = buffer->GetBuffer();
+    const int width = buffer->GetWidth();
+    const int height = buffer->GetHeight();
+    CHECK(depth[(height / 2) * width + width / 4] < static_cast<int>(OCCLUSION_Z_SCALE));
+    CHECK(depth[(height / 2) * width + width * 3 / 4] == static_cast<int>(OCCLUSION_Z_SCALE));
+}
@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+StaticModel* CreateBoxDrawable(Scene* scene, Model* model, const Vector3& position)
+{
+    Node* node = scene->CreateChild();
+    node->SetPosition(position);
+    auto staticModel = node->CreateComponent<StaticModel>();
+    staticModel->SetModel(model);
+    return staticModel;
+}
+
+}
+
+TEST_CASE("Octree reinserts moved drawables into fitting octants")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    auto octree = scene->GetOrCreateComponent<Octree>();
+    octree->SetSize(BoundingBox(-1000.0f, 1000.0f), 8);
+
+    auto model = MakeShared<Model>(context);
+    model->SetBoundingBox(BoundingBox(-1.0f, 1.0f));
+
+    ea::vector<StaticModel*> drawables;
+    for (unsigned i = 0; i < 100; ++i)
+        drawables.push_back(CreateBoxDrawable(scene, model, Vector3(i * 10.0f - 500.0f, 0.0f, i * 5.0f)));
+    octree->Update(FrameInfo{});
+
+    for (unsigned i = 0; i < 100; i += 2)
+        drawables[i]->GetNode()->Translate(Vector3(0.0f, 300.0f, 0.0f));
+    octree->Update(FrameInfo{});
+
+    for (StaticModel* drawable : drawables)
+    {
+        const Octant* octant = drawable->GetOctant();
+        REQUIRE(octant);
+        REQUIRE(octant != octree->GetRootOctant());
+        REQUIRE(octant->GetCullingBox().IsInside(drawable->GetWorldBoundingBox()) == INSIDE);
+        REQUIRE(octant->GetDrawables().contains(drawable));
+    }
+    REQUIRE(octree->GetRootOctant()->GetNumDrawables() == 100);
+}
+
+TEST_CASE("Octree expands automatically to fit distant drawables")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    auto octree = scene->GetOrCreateComponent<Octree>();
+    octree->SetSize(BoundingBox(-1000.0f, 1000.0f), 8);
+
+    auto model = MakeShared<Model>(context);
+    model->SetBoundingBox(BoundingBox(-1.0f, 1.0f));
+
+    StaticModel* nearDrawable = CreateBoxDrawable(scene, model, Vector3(10.0f, 0.0f, 10.0f));
+    StaticModel* farDrawable = CreateBoxDrawable(scene, model, Vector3(10000.0f, 0.0f, -5000.0f));
+
+    octree->Update(FrameInfo{});
+    REQUIRE(farDrawable->GetOctant() == octree->GetRootOctant());
+    REQUIRE(octree->GetNumLevels() == 8);
+
+    octree->SetAutoExpand(true);
+    farDrawable->GetNode()->Translate(Vector3::ONE);
+    octree->Update(FrameInfo{});
+
+    const BoundingBox& rootBox = octree->GetRootOctant()->GetWorldBoundingBox();
+    REQUIRE(rootBox.IsInside(farDrawable->GetWorldBoundingBox()) == INSIDE);
+    REQUIRE(rootBox.Size().x_ == 32000.0f);
+    REQUIRE(octree->GetNumLevels() == 12);
+    REQUIRE(farDrawable->GetOctant() != octree->GetRootOctant());
+    REQUIRE(nearDrawable->GetOctant() != octree->GetRootOctant());
+    REQUIRE(nearDrawable->GetOctant()->GetWorldBoundingBox().Size().x_ == rootBox.Size().x_ / (1 << 12));
+}
+
+TEST_CASE("Octree increments update revision of moved drawables only")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    auto octree = scene->GetOrCreateComponent<Octree>();
+
+    auto model = MakeShared<Model>(context);
+    model->SetBoundingBox(BoundingBox(-1.0f, 1.0f));
+
+    StaticModel* staticDrawable = CreateBoxDrawable(scene, model, Vector3(10.0f, 0.0f, 10.0f));
+    StaticModel* movedDrawable = CreateBoxDrawable(scene, model, Vector3(-10.0f, 0.0f, 10.0f));
+    octree->Update(FrameInfo{});
+
+    const unsigned staticRevision = staticDrawable->GetUpdateRevision();
+    const unsigned movedRevision = movedDrawable->GetUpdateRevision();
+
+    movedDrawable->GetNode()->Translate(Vector3::ONE);
+    octree->Update(FrameInfo{});
+    octree->Update(FrameInfo{});
+
+    REQUIRE(staticDrawable->GetUpdateRevision() == staticRevision);
+    REQUIRE(movedDrawable->GetUpdateRevision() == movedRevision + 1);
+}
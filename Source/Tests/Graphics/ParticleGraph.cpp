@@ -29,7 +29,9 @@
 #include <Urho3D/Particles/ParticleGraphLayerInstance.h>
 #include <Urho3D/Graphics/Material.h>
 #include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Particles/ParticleGraphComputeTranslator.h>
 #include <Urho3D/Particles/ParticleGraphEffect.h>
+#include <Urho3D/Particles/ParticleGraphEmitterManager.h>
 #include <Urho3D/Particles/All.h>
 #include <Urho3D/Scene/Scene.h>
 #include <EASTL/variant.h>
@@ -492,3 +494,372 @@ TEST_CASE("Test Make IntVector2")
     auto attributeSpan = emitter->GetLayer(0)->GetAttributeValues<IntVector2>(0);
     CHECK(attributeSpan[0] == IntVector2(2, 3));
 }
+
+TEST_CASE("Particle graph kernels process contiguous and sparse attributes alike")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const auto effect = MakeShared<ParticleGraphEffect>(context);
+    auto xml = R"(<particleGraphEffect>
+    <layers>
+	    <layer type="ParticleGraphLayer" capacity="16">
+		    <emit>
+			    <nodes>
+			    </nodes>
+		    </emit>
+		    <init>
+			    <nodes>
+				    <node id="1" name="Constant">
+					    <properties>
+						    <property name="Value" type="Vector3" value="1 2 3" />
+					    </properties>
+					    <out>
+						    <pin name="out" type="Vector3" />
+					    </out>
+				    </node>
+				    <node id="2" name="SetAttribute">
+					    <in>
+						    <pin name="" type="Vector3" node="1" pin="out" />
+					    </in>
+					    <out>
+						    <pin name="vel" type="Vector3" />
+					    </out>
+				    </node>
+			    </nodes>
+		    </init>
+		    <update>
+			    <nodes>
+				    <node id="1" name="GetAttribute">
+					    <out>
+						    <pin name="vel" type="Vector3" />
+					    </out>
+				    </node>
+				    <node id="2" name="Constant">
+					    <properties>
+						    <property name="Value" type="Vector3" value="0 -10 0" />
+					    </properties>
+					    <out>
+						    <pin name="out" type="Vector3" />
+					    </out>
+				    </node>
+				    <node id="3" name="ApplyForce">
+					    <in>
+						    <pin name="velocity" type="Vector3" node="1" pin="vel" />
+						    <pin name="force" type="Vector3" node="2" pin="out" />
+					    </in>
+					    <out>
+						    <pin name="out" type="Vector3" />
+					    </out>
+				    </node>
+				    <node id="4" name="Add">
+					    <in>
+						    <pin name="x" type="Vector3" node="3" pin="out" />
+						    <pin name="y" type="Vector3" node="1" pin="vel" />
+					    </in>
+					    <out>
+						    <pin name="out" type="Vector3" />
+					    </out>
+				    </node>
+				    <node id="5" name="SetAttribute">
+					    <in>
+						    <pin name="" type="Vector3" node="3" pin="out" />
+					    </in>
+					    <out>
+						    <pin name="vel" type="Vector3" />
+					    </out>
+				    </node>
+				    <node id="6" name="SetAttribute">
+					    <in>
+						    <pin name="" type="Vector3" node="4" pin="out" />
+					    </in>
+					    <out>
+						    <pin name="sum" type="Vector3" />
+					    </out>
+				    </node>
+			    </nodes>
+		    </update>
+	    </layer>
+    </layers>
+</particleGraphEffect>)";
+    MemoryBuffer buffer(xml);
+    REQUIRE(effect->Load(buffer));
+
+    const auto scene = MakeShared<Scene>(context);
+    const auto node = scene->CreateChild();
+    auto emitter = node->CreateComponent<ParticleGraphEmitter>();
+    emitter->SetEffect(effect);
+
+    const unsigned numParticles = 7;
+    for (unsigned i = 0; i < numParticles; ++i)
+        REQUIRE(emitter->EmitNewParticle(0));
+
+    Tests::RunFrame(context, 0.1f, 0.1f);
+
+    ParticleGraphLayerInstance* layerInstance = emitter->GetLayer(0);
+    REQUIRE(layerInstance->GetNumActiveParticles() == numParticles);
+    REQUIRE(layerInstance->GetNumAttributes() == 2);
+
+    // Destroy particle in the middle so the attributes are accessed through shuffled indices
+    layerInstance->MarkForDeletion(2);
+    Tests::RunFrame(context, 0.1f, 0.1f);
+    REQUIRE(layerInstance->GetNumActiveParticles() == numParticles - 1);
+    Tests::RunFrame(context, 0.1f, 0.1f);
+
+    const auto vel = layerInstance->GetAttributeValues<Vector3>(0);
+    const auto sum = layerInstance->GetAttributeValues<Vector3>(1);
+    for (unsigned i = 0; i < numParticles - 1; ++i)
+    {
+        CHECK(vel[i].Equals(Vector3(1.0f, -1.0f, 3.0f)));
+        CHECK(sum[i].Equals(Vector3(2.0f, -1.0f, 6.0f)));
+    }
+}
+
+TEST_CASE("Particle graph fuses elementwise nodes and updates them in blocks of particles")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const unsigned numParticles = ParticleGraphLayerInstance::FusedBlockSize * 2 + 7;
+    const auto effect = MakeShared<ParticleGraphEffect>(context);
+    auto xml = R"(<particleGraphEffect>
+    <layers>
+	    <layer type="ParticleGraphLayer" capacity="16">
+		    <emit>
+			    <nodes>
+			    </nodes>
+		    </emit>
+		    <init>
+			    <nodes>
+				    <node id="1" name="Constant">
+					    <properties>
+						    <property name="Value" type="Vector3" value="1 2 3" />
+					    </properties>
+					    <out>
+						    <pin name="out" type="Vector3" />
+					    </out>
+				    </node>
+				    <node id="2" name="SetAttribute">
+					    <in>
+						    <pin name="" type="Vector3" node="1" pin="out" />
+					    </in>
+					    <out>
+						    <pin name="vel" type="Vector3" />
+					    </out>
+				    </node>
+			    </nodes>
+		    </init>
+		    <update>
+			    <nodes>
+				    <node id="1" name="GetAttribute">
+					    <out>
+						    <pin name="vel" type="Vector3" />
+					    </out>
+				    </node>
+				    <node id="2" name="Add">
+					    <in>
+						    <pin name="x" type="Vector3" node="1" pin="vel" />
+						    <pin name="y" type="Vector3" node="1" pin="vel" />
+					    </in>
+					    <out>
+						    <pin name="out" type="Vector3" />
+					    </out>
+				    </node>
+				    <node id="3" name="Negate">
+					    <in>
+						    <pin name="x" type="Vector3" node="2" pin="out" />
+					    </in>
+					    <out>
+						    <pin name="out" type="Vector3" />
+					    </out>
+				    </node>
+				    <node id="4" name="SetAttribute">
+					    <in>
+						    <pin name="" type="Vector3" node="3" pin="out" />
+					    </in>
+					    <out>
+						    <pin name="sum" type="Vector3" />
+					    </out>
+				    </node>
+			    </nodes>
+		    </update>
+	    </layer>
+    </layers>
+</particleGraphEffect>)";
+    MemoryBuffer buffer(xml);
+    REQUIRE(effect->Load(buffer));
+    effect->GetLayer(0)->SetCapacity(numParticles);
+
+    const auto scene = MakeShared<Scene>(context);
+    const auto node = scene->CreateChild();
+    auto emitter = node->CreateComponent<ParticleGraphEmitter>();
+    emitter->SetEffect(effect);
+
+    for (unsigned i = 0; i < numParticles; ++i)
+        REQUIRE(emitter->EmitNewParticle(0));
+
+    ParticleGraphLayerInstance* layerInstance = emitter->GetLayer(0);
+    Tests::RunFrame(context, 0.1f, 0.1f);
+    REQUIRE(layerInstance->GetNumActiveParticles() == numParticles);
+
+    // Shuffle indices so fused blocks access attributes through sparse indices too
+    layerInstance->MarkForDeletion(3);
+    Tests::RunFrame(context, 0.1f, 0.1f);
+    Tests::RunFrame(context, 0.1f, 0.1f);
+    REQUIRE(layerInstance->GetNumActiveParticles() == numParticles - 1);
+
+    const auto sum = layerInstance->GetAttributeValues<Vector3>(1);
+    for (unsigned i = 0; i < numParticles - 1; ++i)
+        CHECK(sum[i].Equals(Vector3(-2.0f, -4.0f, -6.0f)));
+}
+
+namespace
+{
+
+SharedPtr<ParticleGraphEffect> CreateFallingParticlesEffect(Context* context)
+{
+    const auto effect = MakeShared<ParticleGraphEffect>(context);
+    effect->SetNumLayers(1);
+    auto layer = effect->GetLayer(0);
+    {
+        auto& emitGraph = layer->GetEmitGraph();
+
+        auto count = MakeShared<ParticleGraphNodes::Constant>(context);
+        count->SetValue(2.0f);
+        auto countIndex = emitGraph.Add(count);
+
+        auto emit = MakeShared<ParticleGraphNodes::Emit>(context);
+        emit->SetPinSource(0, countIndex);
+        emitGraph.Add(emit);
+    }
+    {
+        auto& initGraph = layer->GetInitGraph();
+
+        auto c = MakeShared<ParticleGraphNodes::Constant>(context);
+        c->SetValue(Vector3(1, 2, 3));
+        auto constIndex = initGraph.Add(c);
+
+        auto set = MakeShared<ParticleGraphNodes::SetAttribute>(context);
+        set->SetAttributeName("vel");
+        set->SetAttributeType(VAR_VECTOR3);
+        set->SetPinSource(set->GetPinIndex(""), constIndex);
+        initGraph.Add(set);
+    }
+    {
+        auto& updateGraph = layer->GetUpdateGraph();
+
+        auto get = MakeShared<ParticleGraphNodes::GetAttribute>(context);
+        get->SetAttributeName("vel");
+        get->SetAttributeType(VAR_VECTOR3);
+        auto getIndex = updateGraph.Add(get);
+
+        auto force = MakeShared<ParticleGraphNodes::Constant>(context);
+        force->SetValue(Vector3(0, -10, 0));
+        auto forceIndex = updateGraph.Add(force);
+
+        auto applyForce = MakeShared<ParticleGraphNodes::ApplyForce>(context);
+        applyForce->SetPinSource(0, getIndex);
+        applyForce->SetPinSource(1, forceIndex);
+        auto applyForceIndex = updateGraph.Add(applyForce);
+
+        auto set = MakeShared<ParticleGraphNodes::SetAttribute>(context);
+        set->SetAttributeName("vel");
+        set->SetAttributeType(VAR_VECTOR3);
+        set->SetPinSource(set->GetPinIndex(""), applyForceIndex, applyForce->GetPinIndex("out"));
+        updateGraph.Add(set);
+    }
+    return effect;
+}
+
+ea::vector<Vector3> GetVelocities(ParticleGraphEmitter* emitter)
+{
+    ParticleGraphLayerInstance* layer = emitter->GetLayer(0);
+    const auto values = layer->GetAttributeValues<Vector3>(0);
+
+    ea::vector<Vector3> result;
+    for (unsigned i = 0; i < layer->GetNumActiveParticles(); ++i)
+        result.push_back(values[i]);
+    return result;
+}
+
+}
+
+TEST_CASE("Particle graph emitters are updated in parallel")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto effect = CreateFallingParticlesEffect(context);
+
+    const unsigned numEmitters = 32;
+    ea::vector<ParticleGraphEmitter*> emitters[2];
+    SharedPtr<Scene> scenes[2];
+    for (unsigned sceneIndex = 0; sceneIndex < 2; ++sceneIndex)
+    {
+        scenes[sceneIndex] = MakeShared<Scene>(context);
+        for (unsigned i = 0; i < numEmitters; ++i)
+        {
+            auto emitter = scenes[sceneIndex]->CreateChild()->CreateComponent<ParticleGraphEmitter>();
+            emitter->SetEffect(effect);
+            emitters[sceneIndex].push_back(emitter);
+        }
+
+        auto manager = scenes[sceneIndex]->GetComponent<ParticleGraphEmitterManager>();
+        REQUIRE(manager);
+        CHECK(manager->GetNumEmitters() == numEmitters);
+        manager->SetParallelUpdate(sceneIndex == 0);
+    }
+
+    // Disabled emitters are not updated
+    emitters[0].back()->SetEnabled(false);
+    emitters[1].back()->SetEnabled(false);
+    CHECK(scenes[0]->GetComponent<ParticleGraphEmitterManager>()->GetNumEmitters() == numEmitters - 1);
+
+    for (unsigned frame = 0; frame < 3; ++frame)
+        Tests::RunFrame(context, 0.1f, 0.1f);
+
+    for (unsigned i = 0; i < numEmitters - 1; ++i)
+    {
+        const auto parallelVelocities = GetVelocities(emitters[0][i]);
+        REQUIRE(parallelVelocities.size() == 6);
+        CHECK(parallelVelocities == GetVelocities(emitters[1][i]));
+    }
+    CHECK(emitters[0].back()->GetLayer(0)->GetNumActiveParticles() == 0);
+}
+
+TEST_CASE("Particle graph layer is translated to compute shader")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto effect = CreateFallingParticlesEffect(context);
+    ParticleGraphLayer* layer = effect->GetLayer(0);
+
+    ParticleGraphComputeTranslator translator;
+    REQUIRE(translator.Translate(*layer));
+    CHECK(translator.GetParticleStride() == 3);
+    CHECK(translator.GetAttributeOffset(0) == 0);
+    CHECK(translator.GetAttributeOffset(1) == M_MAX_UNSIGNED);
+
+    const ea::string& code = translator.GetShaderCode();
+    CHECK(code.contains("vec3 a0 = vec3(0.0);"));
+    CHECK(code.contains("a0 = vec3(1.0, 2.0, 3.0);"));
+    CHECK(code.contains("vec3 u2 = a0 + cTimeStep * vec3(0.0, -10.0, 0.0);"));
+    CHECK(code.contains("atomicAdd(args[1], 1u)"));
+
+    // Layer is still simulated on CPU if compute shaders are not available
+    layer->SetComputeSimulation(true);
+    auto scene = MakeShared<Scene>(context);
+    auto emitter = scene->CreateChild()->CreateComponent<ParticleGraphEmitter>();
+    emitter->SetEffect(effect);
+    if (!emitter->GetLayer(0)->GetComputeSimulator())
+    {
+        for (unsigned frame = 0; frame < 3; ++frame)
+            Tests::RunFrame(context, 0.1f, 0.1f);
+        CHECK(GetVelocities(emitter).size() == 6);
+    }
+
+    // Unsupported nodes keep the layer on CPU
+    auto& updateGraph = layer->GetUpdateGraph();
+    auto normalized = MakeShared<ParticleGraphNodes::Normalized>(context);
+    updateGraph.Add(normalized);
+    layer->Invalidate();
+
+    CHECK_FALSE(translator.Translate(*layer));
+    CHECK(translator.GetError().contains("Normalized"));
+    CHECK(translator.GetShaderCode().empty());
+}
@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/RenderPipeline/PipelineBatchSortKey.h>
+
+namespace
+{
+
+ea::vector<PipelineBatchByState> CreateBatchesByState(unsigned count)
+{
+    RandomEngine randomEngine{0};
+    ea::vector<PipelineBatchByState> batches(count);
+    for (PipelineBatchByState& batch : batches)
+    {
+        batch.primaryKey_ = (static_cast<unsigned long long>(randomEngine.GetUInt()) << 32) | randomEngine.GetUInt(0, 4);
+        batch.secondaryKey_ = static_cast<unsigned long long>(randomEngine.GetUInt(0, 16)) << 40;
+    }
+    return batches;
+}
+
+ea::vector<PipelineBatchBackToFront> CreateBatchesBackToFront(unsigned count)
+{
+    RandomEngine randomEngine{0};
+    ea::vector<PipelineBatchBackToFront> batches(count);
+    for (PipelineBatchBackToFront& batch : batches)
+    {
+        batch.renderOrder_ = static_cast<unsigned char>(randomEngine.GetUInt(0, 3));
+        batch.distance_ = randomEngine.GetFloat(-100.0f, 1000.0f);
+    }
+    return batches;
+}
+
+template <class T>
+bool IsSortedByKey(const ea::vector<T>& batches)
+{
+    for (unsigned i = 1; i < batches.size(); ++i)
+    {
+        if (batches[i] < batches[i - 1])
+            return false;
+    }
+    return true;
+}
+
+}
+
+TEST_CASE("Radix sort of pipeline batches matches comparison sort")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    for (unsigned count : {0u, 1u, 100u, 20000u})
+    {
+        auto batchesByState = CreateBatchesByState(count);
+        SortPipelineBatches(batchesByState, true, workQueue);
+        REQUIRE(IsSortedByKey(batchesByState));
+
+        auto batchesBackToFront = CreateBatchesBackToFront(count);
+        SortPipelineBatches(batchesBackToFront, true, workQueue);
+        REQUIRE(IsSortedByKey(batchesBackToFront));
+    }
+}
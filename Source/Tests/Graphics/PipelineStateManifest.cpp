@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/PipelineStateManifest.h>
+#include <Urho3D/IO/ArchiveSerialization.h>
+#include <Urho3D/IO/BinaryArchive.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Resource/JSONArchive.h>
+
+namespace
+{
+
+PipelineStateManifestEntry CreateGraphicsEntry()
+{
+    PipelineStateManifestEntry entry;
+    entry.type_ = PipelineStateType::Graphics;
+
+    GraphicsPipelineStateDesc& desc = entry.graphics_;
+    desc.debugName_ = "Test";
+    desc.colorWriteEnabled_ = true;
+    desc.blendMode_ = BLEND_ALPHA;
+    desc.cullMode_ = CULL_CW;
+    desc.constantDepthBias_ = 0.5f;
+    desc.depthWriteEnabled_ = true;
+    desc.depthCompareFunction_ = CMP_LESSEQUAL;
+    desc.stencilWriteMask_ = 0xff;
+    desc.primitiveType_ = TRIANGLE_STRIP;
+
+    desc.inputLayout_.size_ = 2;
+    desc.inputLayout_.elements_[0].bufferStride_ = 20;
+    desc.inputLayout_.elements_[0].elementType_ = TYPE_VECTOR3;
+    desc.inputLayout_.elements_[0].elementSemantic_ = SEM_POSITION;
+    desc.inputLayout_.elements_[1].bufferStride_ = 20;
+    desc.inputLayout_.elements_[1].elementOffset_ = 12;
+    desc.inputLayout_.elements_[1].elementType_ = TYPE_VECTOR2;
+    desc.inputLayout_.elements_[1].elementSemantic_ = SEM_TEXCOORD;
+
+    desc.output_.depthStencilFormat_ = TextureFormat::TEX_FORMAT_D24_UNORM_S8_UINT;
+    desc.output_.numRenderTargets_ = 1;
+    desc.output_.renderTargetFormats_[0] = TextureFormat::TEX_FORMAT_RGBA8_UNORM;
+    desc.output_.multiSample_ = 4;
+
+    desc.samplers_.Add("DiffMap", SamplerStateDesc::Trilinear(ADDRESS_WRAP));
+    desc.samplers_.Add("ShadowMap", SamplerStateDesc::Bilinear());
+
+    entry.shaderNames_[VS] = "Shaders/GLSL/v2/M_Default.glsl";
+    entry.shaderNames_[PS] = "Shaders/GLSL/v2/M_Default.glsl";
+    entry.shaderDefines_[VS] = "DIFFMAP";
+    entry.shaderDefines_[PS] = "DIFFMAP ALPHAMASK";
+    return entry;
+}
+
+}
+
+TEST_CASE("Pipeline state manifest entry is serialized")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    PipelineStateManifestEntry sourceEntry = CreateGraphicsEntry();
+
+    SECTION("JSON")
+    {
+        JSONValue root;
+        {
+            JSONOutputArchive archive{context, root};
+            SerializeValue(archive, "entry", sourceEntry);
+        }
+
+        PipelineStateManifestEntry loadedEntry;
+        JSONInputArchive archive{context, root};
+        SerializeValue(archive, "entry", loadedEntry);
+        CHECK(loadedEntry == sourceEntry);
+        CHECK(loadedEntry.ToHash() == sourceEntry.ToHash());
+        CHECK(loadedEntry.graphics_.debugName_ == "Test");
+    }
+
+    SECTION("Binary")
+    {
+        VectorBuffer buffer;
+        {
+            BinaryOutputArchive archive{context, buffer};
+            SerializeValue(archive, "entry", sourceEntry);
+        }
+
+        buffer.Seek(0);
+        PipelineStateManifestEntry loadedEntry;
+        BinaryInputArchive archive{context, buffer};
+        SerializeValue(archive, "entry", loadedEntry);
+        CHECK(loadedEntry == sourceEntry);
+    }
+}
@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/PrecomputedVisibility.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+
+#ifdef URHO3D_GLOW
+TEST_CASE("PrecomputedVisibility culls objects hidden behind walls")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto cache = context->GetSubsystem<ResourceCache>();
+    auto boxModel = cache->GetResource<Model>("Models/Box.mdl");
+    REQUIRE(boxModel);
+
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<Octree>();
+
+    const auto createBox = [&](const Vector3& position, const Vector3& scale)
+    {
+        Node* node = scene->CreateChild();
+        node->SetPosition(position);
+        node->SetScale(scale);
+        auto staticModel = node->CreateComponent<StaticModel>();
+        staticModel->SetModel(boxModel);
+        return staticModel;
+    };
+
+    StaticModel* nearBox = createBox({0.0f, 0.0f, 0.0f}, Vector3::ONE);
+    StaticModel* wall = createBox({5.0f, 0.0f, 0.0f}, {1.0f, 40.0f, 40.0f});
+    StaticModel* hiddenBox = createBox({10.0f, 0.0f, 0.0f}, Vector3::ONE);
+
+    auto visibility = scene->CreateComponent<PrecomputedVisibility>();
+    visibility->SetVolume(BoundingBox{{-3.0f, -2.0f, -2.0f}, {1.0f, 2.0f, 2.0f}});
+    visibility->SetCellSize(4.0f);
+    visibility->Bake();
+
+    REQUIRE(visibility->IsBaked());
+    REQUIRE(visibility->GetNumCells() == IntVector3::ONE);
+    REQUIRE(visibility->GetNumNodes() == 3);
+
+    // Culling is enabled only inside of the volume
+    REQUIRE(visibility->UpdateCulling({-1.0f, 0.0f, 0.0f}));
+    CHECK_FALSE(visibility->IsCulled(nearBox));
+    CHECK_FALSE(visibility->IsCulled(wall));
+    CHECK(visibility->IsCulled(hiddenBox));
+
+    REQUIRE_FALSE(visibility->UpdateCulling({20.0f, 0.0f, 0.0f}));
+    CHECK_FALSE(visibility->IsCulled(hiddenBox));
+
+    // Baked data survives serialization
+    VectorBuffer buffer;
+    REQUIRE(scene->SaveXML(buffer));
+    buffer.Seek(0);
+    auto sceneCopy = MakeShared<Scene>(context);
+    REQUIRE(sceneCopy->LoadXML(buffer));
+    auto visibilityCopy = sceneCopy->GetComponent<PrecomputedVisibility>();
+    REQUIRE(visibilityCopy);
+    REQUIRE(visibilityCopy->IsBaked());
+    REQUIRE(visibilityCopy->GetNumNodes() == 3);
+    REQUIRE(visibilityCopy->UpdateCulling({-1.0f, 0.0f, 0.0f}));
+}
+#endif
@@ -0,0 +1,59 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Shader/ShaderTranslator.h>
+
+#ifdef URHO3D_SHADER_TRANSLATOR
+
+TEST_CASE("Preprocessed shader doesn't depend on comments and unused defines")
+{
+    const ea::string shaderCode = R"(
+#ifdef USED_DEFINE
+    #define COLOR vec4(1.0)
+#else
+    #define COLOR vec4(0.0)
+#endif
+layout(location = 0) out vec4 fragColor;
+void main()
+{
+    // Write color
+    fragColor = COLOR;
+}
+)";
+
+    const auto preprocess = [&](const ea::string& prefix)
+    {
+        ea::string output;
+        REQUIRE(PreprocessUniversalShader(output, PS, prefix + shaderCode, TargetShaderLanguage::VULKAN_1_0));
+        return output;
+    };
+
+    const ea::string baseline = preprocess("");
+    CHECK(preprocess("#define UNUSED_DEFINE\n#define OTHER_UNUSED_DEFINE 1\n") == baseline);
+    CHECK(preprocess("/* Comment */\n") == baseline);
+    CHECK(preprocess("#define USED_DEFINE\n") != baseline);
+}
+
+#endif
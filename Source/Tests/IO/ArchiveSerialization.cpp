@@ -580,3 +580,50 @@ TEST_CASE("Enum safe serialization")
         CHECK(scanCode == static_cast<Scancode>(512));
     }
 }
+
+TEST_CASE("Arrays of primitive values are serialized to binary archive as bytes")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const ea::vector<Vector3> sourceVector{Vector3::ONE, Vector3::UP, Vector3(1.0f, 2.0f, 3.0f)};
+    const ea::array<int, 3> sourceArray{-1, 5, 100000};
+
+    const auto serializeElementwise = [](Archive& archive, const char* name, auto& value) { SerializeValue(archive, name, value); };
+
+    // Fast path produces the same bytes as serialization of individual elements
+    VectorBuffer fastBuffer;
+    {
+        BinaryOutputArchive archive{context, fastBuffer};
+        auto block = archive.OpenSafeUnorderedBlock("root");
+        auto vector = sourceVector;
+        auto array = sourceArray;
+        SerializeVectorAsObjects(archive, "vector", vector);
+        SerializeArrayAsObjects(archive, "array", array);
+    }
+
+    VectorBuffer slowBuffer;
+    {
+        BinaryOutputArchive archive{context, slowBuffer};
+        auto block = archive.OpenSafeUnorderedBlock("root");
+        auto vector = sourceVector;
+        auto array = sourceArray;
+        SerializeVectorAsObjects(archive, "vector", vector, "element", serializeElementwise);
+        SerializeArrayAsObjects(archive, "array", array, "element", serializeElementwise);
+    }
+
+    REQUIRE(fastBuffer.GetBuffer() == slowBuffer.GetBuffer());
+
+    // Fast path reads the data back
+    {
+        fastBuffer.Seek(0);
+        BinaryInputArchive archive{context, fastBuffer};
+        auto block = archive.OpenSafeUnorderedBlock("root");
+        ea::vector<Vector3> vector;
+        ea::array<int, 3> array{};
+        SerializeVectorAsObjects(archive, "vector", vector);
+        SerializeArrayAsObjects(archive, "array", array);
+
+        REQUIRE(vector == sourceVector);
+        REQUIRE(array == sourceArray);
+    }
+}
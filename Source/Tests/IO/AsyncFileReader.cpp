@@ -0,0 +1,88 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/AsyncFileReader.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+
+#ifdef URHO3D_THREADING
+
+TEST_CASE("AsyncFileReader reads files in background")
+{
+    static const unsigned numFiles = 16;
+
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fs = context->GetSubsystem<FileSystem>();
+
+    const ea::string rootPath = Format("{}Urho3D-Tests-{}/", fs->GetTemporaryDir(), GenerateUUID());
+    const TemporaryDir rootPathHolder{context, rootPath};
+
+    ea::vector<ByteVector> expectedData(numFiles);
+    for (unsigned i = 0; i < numFiles; ++i)
+    {
+        ByteVector& data = expectedData[i];
+        data.resize(i * 10000 + 1);
+        for (unsigned j = 0; j < data.size(); ++j)
+            data[j] = static_cast<unsigned char>(i + j * 7);
+
+        File file(context, Format("{}file{}.bin", rootPath, i), FILE_WRITE);
+        REQUIRE(file.Write(data.data(), data.size()) == data.size());
+    }
+
+    auto reader = MakeShared<AsyncFileReader>();
+
+    std::atomic<unsigned> numCallbacks{};
+    ea::vector<SharedPtr<AsyncReadRequest>> requests;
+    for (unsigned i = 0; i < numFiles; ++i)
+    {
+        const auto file = MakeShared<File>(context, Format("{}file{}.bin", rootPath, i));
+        REQUIRE(file->IsOpen());
+
+        // Skip first byte to check that the reading starts from the current position
+        file->ReadUByte();
+
+        auto request = reader->ReadFile(file, [&](AsyncReadRequest*) { ++numCallbacks; });
+        REQUIRE(request);
+        requests.push_back(request);
+    }
+    CHECK_FALSE(reader->ReadFile(nullptr));
+
+    Timer timer;
+    while (reader->GetNumPendingRequests() > 0 && timer.GetMSec(false) < 10000)
+        Time::Sleep(1);
+    REQUIRE(reader->GetNumPendingRequests() == 0);
+    CHECK(numCallbacks == numFiles);
+
+    for (unsigned i = 0; i < numFiles; ++i)
+    {
+        REQUIRE(requests[i]->IsCompleted());
+        REQUIRE(requests[i]->IsSucceeded());
+        const ByteVector expected(expectedData[i].begin() + 1, expectedData[i].end());
+        CHECK(requests[i]->GetData() == expected);
+    }
+}
+
+#endif
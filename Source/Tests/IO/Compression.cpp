@@ -0,0 +1,145 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/IO/Compression.h>
+
+namespace
+{
+
+ByteVector MakeMessage(unsigned index)
+{
+    // Messages share most of the structure and differ in a few fields
+    const ea::string text = Format(
+        "{{\"type\":\"Character\",\"prefab\":\"Objects/Character.prefab\",\"id\":{},\"position\":[{},0.5,{}],"
+        "\"health\":100,\"team\":\"{}\",\"animation\":\"Animations/Idle.ani\"}}",
+        index, index * 3 % 17, index * 7 % 13, index % 2 ? "Red" : "Blue");
+    return ByteVector(text.begin(), text.end());
+}
+
+}
+
+TEST_CASE("Data is compressed and decompressed by all codecs")
+{
+    ByteVector source;
+    for (unsigned i = 0; i < 64; ++i)
+    {
+        const ByteVector message = MakeMessage(i);
+        source.insert(source.end(), message.begin(), message.end());
+    }
+
+    for (const CompressionCodec codec : {CompressionCodec::None, CompressionCodec::LZ4, CompressionCodec::LZ4HC})
+    {
+        CompressionSettings settings;
+        settings.codec_ = codec;
+
+        ByteVector compressed(EstimateCompressBound(source.size(), codec));
+        const unsigned compressedSize =
+            CompressData(compressed.data(), compressed.size(), source.data(), source.size(), settings);
+        REQUIRE(compressedSize != 0);
+        if (codec != CompressionCodec::None)
+            CHECK(compressedSize < source.size() / 2);
+
+        ByteVector decompressed(source.size());
+        REQUIRE(DecompressData(decompressed.data(), decompressed.size(), compressed.data(), compressedSize, codec));
+        CHECK(decompressed == source);
+
+        // Truncated data is detected
+        if (codec != CompressionCodec::None)
+        {
+            CHECK_FALSE(DecompressData(
+                decompressed.data(), decompressed.size(), compressed.data(), compressedSize / 2, codec));
+        }
+    }
+}
+
+TEST_CASE("Trained dictionary improves compression of small messages")
+{
+    ea::vector<ByteVector> samples;
+    for (unsigned i = 0; i < 100; ++i)
+        samples.push_back(MakeMessage(i));
+
+    const auto dictionary = CompressionDictionary::Train(samples, 4 * 1024);
+    REQUIRE(dictionary);
+    REQUIRE_FALSE(dictionary->GetData().empty());
+    REQUIRE(dictionary->GetData().size() <= 4 * 1024);
+
+    const ByteVector message = MakeMessage(1000);
+    ByteVector compressed(EstimateCompressBound(message.size(), CompressionCodec::LZ4HC));
+
+    CompressionSettings settings;
+    const unsigned sizeWithoutDictionary =
+        CompressData(compressed.data(), compressed.size(), message.data(), message.size(), settings);
+
+    settings.dictionary_ = dictionary;
+    const unsigned sizeWithDictionary =
+        CompressData(compressed.data(), compressed.size(), message.data(), message.size(), settings);
+    REQUIRE(sizeWithDictionary != 0);
+    CHECK(sizeWithDictionary * 2 < sizeWithoutDictionary);
+
+    ByteVector decompressed(message.size());
+    REQUIRE(DecompressData(decompressed.data(), decompressed.size(), compressed.data(), sizeWithDictionary,
+        CompressionCodec::LZ4HC, dictionary));
+    CHECK(decompressed == message);
+}
+
+TEST_CASE("Buffer is compressed in parallel blocks")
+{
+    ByteVector source;
+    for (unsigned i = 0; source.size() < 200 * 1024; ++i)
+    {
+        const ByteVector message = MakeMessage(i);
+        source.insert(source.end(), message.begin(), message.end());
+    }
+    // Random tail is stored as is
+    for (unsigned i = 0; i < 1000; ++i)
+        source.push_back(static_cast<unsigned char>(Rand()));
+
+    ea::vector<ByteVector> samples{MakeMessage(1), MakeMessage(2), MakeMessage(3)};
+    const auto dictionary = CompressionDictionary::Train(samples);
+
+    CompressionSettings settings;
+    settings.codec_ = CompressionCodec::LZ4;
+    settings.blockSize_ = 16 * 1024;
+    settings.numThreads_ = 4;
+    settings.dictionary_ = dictionary;
+
+    const ByteVector compressed = CompressBuffer(source, settings);
+    CHECK(compressed.size() < source.size() / 2);
+
+    ByteVector decompressed;
+    REQUIRE(DecompressBuffer(compressed, decompressed, dictionary));
+    CHECK(decompressed == source);
+
+    // Single-threaded compression produces the same result
+    settings.numThreads_ = 1;
+    CHECK(CompressBuffer(source, settings) == compressed);
+
+    // Dictionary is required
+    CHECK_FALSE(DecompressBuffer(compressed, decompressed));
+
+    // Corrupted frame is detected
+    ByteVector truncated(compressed.begin(), compressed.begin() + compressed.size() / 2);
+    CHECK_FALSE(DecompressBuffer(truncated, decompressed, dictionary));
+}
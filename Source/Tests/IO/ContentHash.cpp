@@ -0,0 +1,65 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/IO/ContentHash.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+
+TEST_CASE("Content hash matches reference XXH64 values")
+{
+    const auto hashString = [](const char* value, unsigned long long seed = 0)
+    {
+        return MakeContentHash(value, strlen(value), seed);
+    };
+
+    REQUIRE(hashString("") == 0xef46db3751d8e999ull);
+    REQUIRE(hashString("a") == 0xd24ec4f1a98c6e5bull);
+    REQUIRE(hashString("abc") == 0x44bc2cf5ad770999ull);
+    REQUIRE(hashString("Nobody inspects the spammish repetition") == 0xfbcea83c8a378bf1ull);
+
+    unsigned char bytes[100];
+    for (unsigned i = 0; i < 100; ++i)
+        bytes[i] = static_cast<unsigned char>(i);
+    REQUIRE(MakeContentHash(bytes, sizeof(bytes)) == 0x6ac1e58032166597ull);
+}
+
+TEST_CASE("Content hasher combines values and streams")
+{
+    ContentHasher hasherA;
+    hasherA.Append("ab");
+    hasherA.Append("c");
+
+    ContentHasher hasherB;
+    hasherB.Append("a");
+    hasherB.Append("bc");
+
+    REQUIRE(hasherA.GetHash() != hasherB.GetHash());
+    REQUIRE(hasherA.ToString().length() == 16);
+
+    const ea::string data = "Some file content";
+    MemoryBuffer buffer(data.data(), data.size());
+
+    ContentHasher streamHasher;
+    REQUIRE(streamHasher.Append(buffer) == data.size());
+    REQUIRE(streamHasher.GetHash() == MakeContentHash(data.data(), data.size()));
+}
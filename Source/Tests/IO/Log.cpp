@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/IO/IOEvents.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Scene/Serializable.h>
+
+namespace
+{
+
+/// Count messages of given logger received via E_LOGMESSAGE.
+void CountLoggerMessages(Object* receiver, const ea::string& loggerName, unsigned& counter)
+{
+    receiver->SubscribeToEvent(E_LOGMESSAGE, [&counter, loggerName](VariantMap& eventData)
+    {
+        if (eventData[LogMessage::P_LOGGER].GetString() == loggerName)
+            ++counter;
+    });
+}
+
+}
+
+TEST_CASE("Log drops messages over rate limit")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto log = context->GetSubsystem<Log>();
+    unsigned numMessages = 0;
+    auto receiver = MakeShared<Serializable>(context);
+    CountLoggerMessages(receiver, "RateLimitTest", numMessages);
+
+    log->SetRateLimit("RateLimitTest", 3);
+    const Logger logger = Log::GetLogger("RateLimitTest");
+    for (unsigned i = 0; i < 10; ++i)
+        logger.Info("Message #{}", i);
+    log->SetRateLimit("RateLimitTest", 0);
+
+    REQUIRE(numMessages == 3);
+}
+
+TEST_CASE("Log delivers all messages in async mode")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto log = context->GetSubsystem<Log>();
+    unsigned numMessages = 0;
+    auto receiver = MakeShared<Serializable>(context);
+    CountLoggerMessages(receiver, "AsyncTest", numMessages);
+
+    log->SetAsync(true, 64, LogOverflowPolicy::Block);
+    REQUIRE(log->IsAsync());
+
+    const Logger logger = Log::GetLogger("AsyncTest");
+    for (unsigned i = 0; i < 100; ++i)
+        logger.Info("Message #{}", i);
+
+    // Disabling async mode drains the queue, messages from the writer thread are delivered on pump
+    log->SetAsync(false);
+    REQUIRE_FALSE(log->IsAsync());
+    log->PumpThreadMessages();
+
+    REQUIRE(numMessages == 100);
+}
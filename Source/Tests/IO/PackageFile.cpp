@@ -0,0 +1,293 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/MountedExternalMemory.h>
+#include <Urho3D/IO/PackageFile.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/IO/VirtualFileSystem.h>
+
+#include <LZ4/lz4.h>
+
+namespace
+{
+
+void WriteTestPackage(Context* context, const ea::string& fileName, const ea::vector<ea::pair<ea::string, ea::string>>& files)
+{
+    unsigned headerSize = 4 + 2 * sizeof(unsigned);
+    for (const auto& [name, content] : files)
+        headerSize += name.size() + 1 + 3 * sizeof(unsigned);
+
+    File file(context, fileName, FILE_WRITE);
+    file.WriteFileID("UPAK");
+    file.WriteUInt(files.size());
+    file.WriteUInt(0);
+
+    unsigned offset = headerSize;
+    for (const auto& [name, content] : files)
+    {
+        file.WriteString(name);
+        file.WriteUInt(offset);
+        file.WriteUInt(content.size());
+        file.WriteUInt(0);
+        offset += content.size();
+    }
+
+    for (const auto& [name, content] : files)
+        file.Write(content.data(), content.size());
+}
+
+ByteVector CompressIndexedBlocks(const ByteVector& data, unsigned blockSize)
+{
+    const unsigned numBlocks = (data.size() + blockSize - 1) / blockSize;
+    const unsigned tableSize = (numBlocks + 1) * sizeof(unsigned);
+
+    VectorBuffer table;
+    ByteVector blocks;
+    ByteVector compressBuffer(LZ4_compressBound(blockSize));
+    for (unsigned pos = 0; pos < data.size(); pos += blockSize)
+    {
+        const unsigned unpackedSize = ea::min(blockSize, data.size() - pos);
+        table.WriteUInt(tableSize + blocks.size());
+
+        const int packedSize = LZ4_compress_default(reinterpret_cast<const char*>(&data[pos]),
+            reinterpret_cast<char*>(compressBuffer.data()), unpackedSize, compressBuffer.size());
+        if (packedSize > 0 && static_cast<unsigned>(packedSize) < unpackedSize)
+            blocks.insert(blocks.end(), compressBuffer.begin(), compressBuffer.begin() + packedSize);
+        else
+            blocks.insert(blocks.end(), &data[pos], &data[pos] + unpackedSize);
+    }
+    table.WriteUInt(tableSize + blocks.size());
+
+    ByteVector result = table.GetBuffer();
+    result.insert(result.end(), blocks.begin(), blocks.end());
+    return result;
+}
+
+void WriteIndexedTestPackage(Context* context, const ea::string& fileName, unsigned blockSize,
+    const ea::vector<ea::pair<ea::string, ByteVector>>& files, const ea::vector<bool>& compressed)
+{
+    File file(context, fileName, FILE_WRITE);
+    file.WriteFileID("RLZ4");
+    file.WriteUInt(files.size());
+    file.WriteUInt(0);
+    file.WriteUInt(PACKAGE_VERSION_BLOCK_INDEX);
+    file.WriteInt64(0);
+    file.WriteUInt(blockSize);
+
+    ea::vector<unsigned> offsets;
+    for (unsigned i = 0; i < files.size(); ++i)
+    {
+        offsets.push_back(file.GetSize());
+        const ByteVector data = compressed[i] ? CompressIndexedBlocks(files[i].second, blockSize) : files[i].second;
+        file.Write(data.data(), data.size());
+    }
+
+    const long long fileListOffset = file.GetSize();
+    for (unsigned i = 0; i < files.size(); ++i)
+    {
+        file.WriteString(files[i].first);
+        file.WriteUInt(offsets[i]);
+        file.WriteUInt(files[i].second.size());
+        file.WriteUInt(0);
+        file.WriteUByte(static_cast<unsigned char>(compressed[i] ? PackageCompression::LZ4 : PackageCompression::None));
+    }
+    file.WriteUInt(file.GetSize() + sizeof(unsigned));
+
+    file.Seek(4 + 3 * sizeof(unsigned));
+    file.WriteInt64(fileListOffset);
+}
+
+}
+
+TEST_CASE("PackageFile is memory mapped")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fs = context->GetSubsystem<FileSystem>();
+
+    const ea::string rootPath = Format("{}Urho3D-Tests-{}/", fs->GetTemporaryDir(), GenerateUUID());
+    const TemporaryDir rootPathHolder{context, rootPath};
+
+    const ea::string packageName = rootPath + "Test.pak";
+    WriteTestPackage(context, packageName, {{"a.txt", "first file"}, {"b/c.txt", "second file in the package"}});
+
+    auto package = MakeShared<PackageFile>(context, packageName);
+    REQUIRE(package->GetNumFiles() == 2);
+    REQUIRE_FALSE(package->IsMemoryMapped());
+
+    for (const bool memoryMapped : {false, true})
+    {
+        package->SetMemoryMapped(memoryMapped);
+        REQUIRE(package->IsMemoryMapped() == memoryMapped);
+
+        const AbstractFilePtr fileA = package->OpenFile(FileIdentifier{"", "a.txt"}, FILE_READ);
+        const AbstractFilePtr fileC = package->OpenFile(FileIdentifier{"", "b/c.txt"}, FILE_READ);
+        REQUIRE(fileA);
+        REQUIRE(fileC);
+
+        // Unmapping doesn't invalidate opened files
+        package->SetMemoryMapped(false);
+
+        CHECK(fileA->GetSize() == 10);
+        CHECK(fileC->GetSize() == 26);
+
+        ea::string contentA(fileA->GetSize(), '\0');
+        ea::string contentC(fileC->GetSize(), '\0');
+        fileA->Read(contentA.data(), contentA.size());
+        fileC->Read(contentC.data(), contentC.size());
+        CHECK(contentA == "first file");
+        CHECK(contentC == "second file in the package");
+    }
+}
+
+TEST_CASE("PackageFile with block index is read at random positions")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fs = context->GetSubsystem<FileSystem>();
+
+    const ea::string rootPath = Format("{}Urho3D-Tests-{}/", fs->GetTemporaryDir(), GenerateUUID());
+    const TemporaryDir rootPathHolder{context, rootPath};
+
+    // Mix of compressible and incompressible blocks
+    ByteVector data(100000);
+    unsigned seed = 1;
+    for (unsigned i = 0; i < data.size(); ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (i / 4096) % 2 ? static_cast<unsigned char>(seed >> 16) : static_cast<unsigned char>(i % 7);
+    }
+
+    const ea::string packageName = rootPath + "Test.pak";
+    const unsigned blockSize = 4096;
+    WriteIndexedTestPackage(context, packageName, blockSize, {{"Compressed.bin", data}, {"Raw.bin", data}}, {true, false});
+
+    auto package = MakeShared<PackageFile>(context, packageName);
+    REQUIRE(package->GetNumFiles() == 2);
+    REQUIRE(package->IsCompressed());
+    REQUIRE(package->HasBlockIndex());
+    REQUIRE(package->GetBlockSize() == blockSize);
+
+    for (const bool memoryMapped : {false, true})
+    {
+        package->SetMemoryMapped(memoryMapped);
+
+        for (const char* name : {"Compressed.bin", "Raw.bin"})
+        {
+            const AbstractFilePtr file = package->OpenFile(FileIdentifier{"", name}, FILE_READ);
+            REQUIRE(file);
+            REQUIRE(file->GetSize() == data.size());
+
+            ByteVector content(data.size());
+            REQUIRE(file->Read(content.data(), content.size()) == data.size());
+            CHECK(content == data);
+
+            // Reads within one block, across block boundaries and at the end of the file
+            const ea::pair<unsigned, unsigned> ranges[] = {
+                {5000, 100}, {4000, 200}, {100, 20000}, {0, 1}, {99990, 10}, {12288, 4096}, {1, 99999}};
+            for (const auto& [offset, size] : ranges)
+            {
+                REQUIRE(file->Seek(offset) == offset);
+                ByteVector chunk(size);
+                REQUIRE(file->Read(chunk.data(), size) == size);
+                CHECK(ea::equal(chunk.begin(), chunk.end(), data.begin() + offset));
+                CHECK(file->Tell() == offset + size);
+            }
+        }
+    }
+}
+
+TEST_CASE("VirtualFileSystem finds files in indexed packages in order of mounting")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fs = context->GetSubsystem<FileSystem>();
+    auto vfs = context->GetSubsystem<VirtualFileSystem>();
+
+    const ea::string rootPath = Format("{}Urho3D-Tests-{}/", fs->GetTemporaryDir(), GenerateUUID());
+    const TemporaryDir rootPathHolder{context, rootPath};
+
+    WriteTestPackage(context, rootPath + "A.pak", {{"Index/x.txt", "A"}, {"Index/a.txt", "A"}});
+    WriteTestPackage(context, rootPath + "B.pak", {{"Index/x.txt", "B"}});
+
+    auto packageA = MakeShared<PackageFile>(context, rootPath + "A.pak");
+    auto packageB = MakeShared<PackageFile>(context, rootPath + "B.pak");
+    auto memory = MakeShared<MountedExternalMemory>(context, "");
+    memory->LinkMemory("Index/x.txt", "M");
+    memory->LinkMemory("Index/m.txt", "M");
+
+    REQUIRE(packageA->GetFileNameHashes());
+    CHECK(packageA->GetFileNameHashes()->size() == 2);
+    REQUIRE_FALSE(memory->GetFileNameHashes());
+
+    const auto readFile = [&](const ea::string& fileName) { return vfs->ReadAllText(FileIdentifier{"", fileName}); };
+
+    MountPointGuard guardA{packageA};
+    MountPointGuard guardMemory{memory};
+    {
+        MountPointGuard guardB{packageB};
+
+        CHECK(readFile("Index/x.txt") == "B");
+        CHECK(readFile("Index/a.txt") == "A");
+        CHECK(readFile("Index/m.txt") == "M");
+        CHECK_FALSE(vfs->Exists(FileIdentifier{"", "Index/missing.txt"}));
+    }
+
+    // Mount point that is not indexed takes priority over packages mounted earlier
+    CHECK(readFile("Index/x.txt") == "M");
+    memory->UnlinkMemory("Index/x.txt");
+    CHECK(readFile("Index/x.txt") == "A");
+    CHECK(readFile("Index/m.txt") == "M");
+}
+
+TEST_CASE("Packages and directories are mounted in order")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fs = context->GetSubsystem<FileSystem>();
+
+    const ea::string rootPath = Format("{}Urho3D-Tests-{}/", fs->GetTemporaryDir(), GenerateUUID());
+    const TemporaryDir rootPathHolder{context, rootPath};
+
+    WriteTestPackage(context, rootPath + "A.pak", {{"a.txt", "only in A"}, {"shared.txt", "from A"}});
+    WriteTestPackage(context, rootPath + "C.pak", {{"shared.txt", "from C"}});
+    fs->CreateDir(rootPath + "B");
+    {
+        File file(context, rootPath + "B/shared.txt", FILE_WRITE);
+        file.WriteString("from B");
+    }
+
+    auto vfs = MakeShared<VirtualFileSystem>(context);
+    vfs->MountExistingDirectoriesOrPackages({rootPath}, {"A", "B", "C", "Missing"});
+    REQUIRE(vfs->NumMountPoints() == 3);
+    CHECK(vfs->GetMountPoint(0)->GetType() == PackageFile::GetTypeStatic());
+    CHECK(vfs->GetMountPoint(1)->GetType() != PackageFile::GetTypeStatic());
+    CHECK(vfs->GetMountPoint(2)->GetType() == PackageFile::GetTypeStatic());
+    CHECK(vfs->ReadAllText(FileIdentifier{"", "a.txt"}) == "only in A");
+    CHECK(vfs->ReadAllText(FileIdentifier{"", "shared.txt"}) == "from C");
+
+    vfs->UnmountAll();
+    vfs->MountExistingPackages({rootPath}, {"C.pak", "Missing.pak", "A.pak"});
+    REQUIRE(vfs->NumMountPoints() == 2);
+    CHECK(vfs->ReadAllText(FileIdentifier{"", "shared.txt"}) == "from A");
+}
@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Math/Frustum.h>
+#include <Urho3D/Math/RandomEngine.h>
+
+TEST_CASE("Frustum tests multiple bounding boxes at once")
+{
+    Frustum frustum;
+    frustum.Define(60.0f, 1.5f, 1.0f, 0.1f, 100.0f, Matrix3x4::IDENTITY);
+
+    RandomEngine randomEngine{0};
+    for (unsigned iteration = 0; iteration < 256; ++iteration)
+    {
+        BoundingBox boxes[4];
+        const BoundingBox* boxPointers[4];
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            const Vector3 center{randomEngine.GetFloat(-100.0f, 100.0f), randomEngine.GetFloat(-100.0f, 100.0f),
+                randomEngine.GetFloat(-20.0f, 120.0f)};
+            const Vector3 size{randomEngine.GetFloat(0.0f, 10.0f), randomEngine.GetFloat(0.0f, 10.0f),
+                randomEngine.GetFloat(0.0f, 10.0f)};
+            boxes[i] = BoundingBox{center - size, center + size};
+            boxPointers[i] = &boxes[i];
+        }
+
+        for (unsigned count = 1; count <= 4; ++count)
+        {
+            unsigned expectedMask = 0;
+            for (unsigned i = 0; i < count; ++i)
+            {
+                if (frustum.IsInsideFast(boxes[i]) != OUTSIDE)
+                    expectedMask |= 1u << i;
+            }
+            REQUIRE(frustum.IsInsideFastMask(boxPointers, count) == expectedMask);
+        }
+    }
+}
+
+TEST_CASE("Enclosing frustum contains both frustums")
+{
+    const float eyeOffset = 0.032f;
+    const Quaternion eyeRotation{5.0f, Vector3::UP};
+    Frustum leftEye;
+    leftEye.Define(90.0f, 0.9f, 1.0f, 0.1f, 100.0f, Matrix3x4{Vector3::LEFT * eyeOffset, eyeRotation.Inverse(), 1.0f});
+    Frustum rightEye;
+    rightEye.Define(90.0f, 0.9f, 1.0f, 0.1f, 100.0f, Matrix3x4{Vector3::RIGHT * eyeOffset, eyeRotation, 1.0f});
+
+    Frustum frustum;
+    frustum.DefineEnclosing(leftEye, rightEye);
+
+    for (const Frustum* eye : {&leftEye, &rightEye})
+    {
+        for (const Vector3& vertex : eye->vertices_)
+            CHECK(frustum.Distance(vertex) < 0.001f);
+    }
+
+    RandomEngine randomEngine{0};
+    for (unsigned iteration = 0; iteration < 1024; ++iteration)
+    {
+        const Vector3 center{randomEngine.GetFloat(-100.0f, 100.0f), randomEngine.GetFloat(-100.0f, 100.0f),
+            randomEngine.GetFloat(-20.0f, 120.0f)};
+        const Vector3 size{randomEngine.GetFloat(0.0f, 10.0f), randomEngine.GetFloat(0.0f, 10.0f),
+            randomEngine.GetFloat(0.0f, 10.0f)};
+        const BoundingBox box{center - size, center + size};
+
+        if (leftEye.IsInside(box) != OUTSIDE || rightEye.IsInside(box) != OUTSIDE)
+            CHECK(frustum.IsInside(box) != OUTSIDE);
+    }
+}
@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2021-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Math/Matrix3x4.h>
+
+using namespace Urho3D;
+
+TEST_CASE("Matrix3x4 batch operations match single operations")
+{
+    const Matrix3x4 matrix{Vector3(1.0f, -2.0f, 3.0f), Quaternion(30.0f, Vector3(1.0f, 2.0f, -1.0f).Normalized()), Vector3(0.5f, 2.0f, 1.5f)};
+    const ea::vector<Vector3> vectors{Vector3::ZERO, Vector3::ONE, Vector3(-3.0f, 4.0f, 0.25f), Vector3(10.0f, -7.0f, 2.0f)};
+
+    ea::vector<Vector3> positions = vectors;
+    TransformPositions(matrix, positions, positions);
+    ea::vector<Vector3> directions(vectors.size());
+    TransformDirections(matrix, vectors, directions);
+    for (unsigned i = 0; i < vectors.size(); ++i)
+    {
+        CHECK(positions[i].Equals(matrix * vectors[i]));
+        CHECK(directions[i].Equals(matrix * Vector4(vectors[i], 0.0f)));
+    }
+
+    const ea::vector<Matrix3x4> matrices{Matrix3x4::IDENTITY, matrix,
+        Matrix3x4{Vector3(5.0f, 0.0f, -1.0f), Quaternion(-60.0f, Vector3::UP), Vector3::ONE}};
+    ea::vector<Matrix3x4> products = matrices;
+    MultiplyMatrices(matrix, products, products);
+    ea::vector<Matrix3x4> pairwise(matrices.size());
+    MultiplyMatrices(matrices, matrices, pairwise);
+    for (unsigned i = 0; i < matrices.size(); ++i)
+    {
+        CHECK(products[i].Equals(matrix * matrices[i]));
+        CHECK(pairwise[i].Equals(matrices[i] * matrices[i]));
+    }
+}
@@ -23,9 +23,13 @@
 
 #include "../CommonUtils.h"
 
+#include <Urho3D/Core/StringHashRegister.h>
+
 #include <EASTL/string.h>
 #include <EASTL/string_view.h>
 
+#include <thread>
+
 using namespace Urho3D;
 
 TEST_CASE("StringHash is persistent and stable across builds and types")
@@ -52,3 +56,40 @@ TEST_CASE("StringHash is persistent and stable across builds and types")
     CHECK(StringHash{""}.IsEmpty());
     CHECK(!StringHash{testString}.IsEmpty());
 }
+
+TEST_CASE("StringHash is calculated at compile time from literals")
+{
+    static_assert(StringHash{}.Value() == StringHash::EmptyValue);
+    static_assert(StringHash::Calculate(ea::string_view{""}) == StringHash::EmptyValue);
+    static_assert(StringHash::Calculate(ea::string_view{"Test string 12345"}) == 373547853u);
+    static_assert("Test string 12345"_sh == StringHash{373547853u});
+    static_assert(""_sh.IsEmpty());
+
+    CHECK("Position"_sh == StringHash{"Position"});
+    CHECK("Position"_sh.Value() == StringHash::Calculate("Position"));
+}
+
+TEST_CASE("StringHashRegister registers strings from multiple threads")
+{
+    StringHashRegister stringHashRegister(true);
+
+    ea::vector<std::thread> threads;
+    for (unsigned threadIndex = 0; threadIndex < 4; ++threadIndex)
+    {
+        threads.emplace_back([&]()
+        {
+            for (unsigned i = 0; i < 1000; ++i)
+                stringHashRegister.RegisterString(Format("String {}", i % 100));
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        const ea::string string = Format("String {}", i);
+        CHECK(stringHashRegister.Contains(StringHash{string}));
+        CHECK(stringHashRegister.GetStringCopy(StringHash{string}) == string);
+    }
+    CHECK(stringHashRegister.GetInternalMap().size() == 100);
+}
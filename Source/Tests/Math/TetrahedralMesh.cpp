@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Math/TetrahedralMesh.h>
+
+using namespace Urho3D;
+
+namespace
+{
+
+float EvaluateLinearFunction(const Vector3& position)
+{
+    return position.DotProduct({ 1.0f, -2.0f, 0.5f }) + 3.0f;
+}
+
+}
+
+TEST_CASE("TetrahedralMesh batched sampling matches single sampling")
+{
+    RandomEngine re(0);
+    ea::vector<Vector3> vertices;
+    const Vector3 jitter = Vector3::ONE * 0.3f;
+    for (int x = 0; x < 4; ++x)
+    {
+        for (int y = 0; y < 3; ++y)
+        {
+            for (int z = 0; z < 4; ++z)
+                vertices.push_back(Vector3(x * 2.0f, y * 1.5f, z * 2.0f) + re.GetVector3(-jitter, jitter));
+        }
+    }
+
+    TetrahedralMesh mesh;
+    mesh.Define(vertices);
+    REQUIRE(mesh.numInnerTetrahedrons_ > 0);
+
+    ea::vector<float> values;
+    for (const Vector3& vertex : mesh.vertices_)
+        values.push_back(EvaluateLinearFunction(vertex));
+
+    ea::vector<Vector3> positions;
+    for (unsigned i = 0; i < 200; ++i)
+        positions.push_back(re.GetVector3({ -2.0f, -2.0f, -2.0f }, { 9.0f, 6.0f, 9.0f }));
+
+    ea::vector<unsigned> hints(positions.size(), M_MAX_UNSIGNED);
+    ea::vector<float> results(positions.size());
+    mesh.Sample(values, ea::span<const Vector3>(positions), ea::span<float>(results), ea::span<unsigned>(hints));
+
+    for (unsigned i = 0; i < positions.size(); ++i)
+    {
+        unsigned hint = M_MAX_UNSIGNED;
+        const float expected = mesh.Sample(values, positions[i], hint);
+        CHECK(Equals(results[i], expected, 0.001f));
+    }
+
+    // Linear function is interpolated exactly within the hull
+    const ea::vector<Vector3> innerPositions = { { 1.0f, 1.0f, 1.0f }, { 5.0f, 2.0f, 3.0f }, { 3.3f, 0.7f, 5.1f } };
+    ea::vector<unsigned> innerHints(innerPositions.size(), M_MAX_UNSIGNED);
+    ea::vector<float> innerResults(innerPositions.size());
+    mesh.Sample(values, ea::span<const Vector3>(innerPositions), ea::span<float>(innerResults),
+        ea::span<unsigned>(innerHints));
+
+    for (unsigned i = 0; i < innerPositions.size(); ++i)
+    {
+        CHECK(innerHints[i] < mesh.numInnerTetrahedrons_);
+        CHECK(Equals(innerResults[i], EvaluateLinearFunction(innerPositions[i]), 0.001f));
+    }
+
+    // Stale hints are recovered from the lookup grid
+    ea::vector<Vector3> reversedPositions(innerPositions.rbegin(), innerPositions.rend());
+    ea::vector<float> staleResults(reversedPositions.size());
+    mesh.Sample(values, ea::span<const Vector3>(reversedPositions), ea::span<float>(staleResults),
+        ea::span<unsigned>(innerHints));
+
+    for (unsigned i = 0; i < reversedPositions.size(); ++i)
+        CHECK(Equals(staleResults[i], EvaluateLinearFunction(reversedPositions[i]), 0.001f));
+}
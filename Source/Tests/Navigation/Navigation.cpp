@@ -27,6 +27,8 @@
 #include "../CommonUtils.h"
 #include "../SceneUtils.h"
 
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/Scene/Scene.h>
 #include <Urho3D/Resource/ResourceCache.h>
 #include <Urho3D/Navigation/CrowdAgent.h>
@@ -105,6 +107,245 @@ CrowdAgentTest SpawnCrowdAgent(Vector3 pos, Node* agentsSceneNode, bool isValid)
 }
 
 
+TEST_CASE("Navigation mesh tiles built in parallel match tiles rebuilt one by one")
+{
+    SetRandomSeed(1);
+
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = CreateTestScene(context, 20);
+    scene->CreateComponent<Navigable>();
+
+    auto* navMesh = scene->CreateComponent<NavigationMesh>();
+    navMesh->SetTileSize(32);
+    navMesh->SetAgentHeight(10.0f);
+    navMesh->SetCellHeight(0.05f);
+    REQUIRE(navMesh->Build());
+
+    const IntVector2 numTiles = navMesh->GetNumTiles();
+    REQUIRE(numTiles.x_ * numTiles.y_ > 1);
+
+    const Vector3 start{-45.0f, 0.0f, -45.0f};
+    const Vector3 end{45.0f, 0.0f, 45.0f};
+    ea::vector<Vector3> expectedPath;
+    navMesh->FindPath(expectedPath, start, end);
+    REQUIRE(expectedPath.size() >= 2);
+
+    for (int z = 0; z < numTiles.y_; ++z)
+    {
+        for (int x = 0; x < numTiles.x_; ++x)
+        {
+            REQUIRE(navMesh->Build(IntVector2{x, z}, IntVector2{x, z}));
+            REQUIRE(navMesh->HasTile({x, z}));
+        }
+    }
+
+    ea::vector<Vector3> path;
+    navMesh->FindPath(path, start, end);
+    REQUIRE(path == expectedPath);
+}
+
+TEST_CASE("Navigation mesh tiles are rebuilt asynchronously")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = CreateTestScene(context, 0);
+    scene->CreateComponent<Navigable>();
+
+    auto* navMesh = scene->CreateComponent<NavigationMesh>();
+    navMesh->SetTileSize(32);
+    navMesh->SetAgentHeight(10.0f);
+    navMesh->SetCellHeight(0.05f);
+    REQUIRE(navMesh->Build());
+
+    const Vector3 start{-20.0f, 0.0f, 0.0f};
+    const Vector3 end{20.0f, 0.0f, 0.0f};
+    ea::vector<Vector3> oldPath;
+    navMesh->FindPath(oldPath, start, end);
+    REQUIRE(oldPath.size() == 2);
+
+    // Block the straight path with the wall
+    Node* wallNode = scene->CreateChild("Wall");
+    wallNode->SetScale(Vector3(2.0f, 5.0f, 40.0f));
+    wallNode->SetPosition(Vector3(0.0f, 2.5f, 0.0f));
+    wallNode->CreateComponent<RigidBody>();
+    wallNode->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+
+    navMesh->BuildAsync(BoundingBox(Vector3(-1.0f, 0.0f, -20.0f), Vector3(1.0f, 5.0f, 20.0f)));
+    REQUIRE(navMesh->IsAsyncBuildPending());
+
+    // Old tiles are used until the rebuild is applied
+    ea::vector<Vector3> path;
+    navMesh->FindPath(path, start, end);
+    REQUIRE(path == oldPath);
+
+    navMesh->CompleteAsyncBuild();
+    REQUIRE_FALSE(navMesh->IsAsyncBuildPending());
+
+    navMesh->FindPath(path, start, end);
+    REQUIRE(path.size() > 2);
+}
+
+TEST_CASE("Path requests are processed in batches and match synchronous queries")
+{
+    SetRandomSeed(1);
+
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = CreateTestScene(context, 20);
+    scene->CreateComponent<Navigable>();
+
+    auto* navMesh = scene->CreateComponent<NavigationMesh>();
+    navMesh->SetAgentHeight(10.0f);
+    navMesh->SetCellHeight(0.05f);
+    REQUIRE(navMesh->Build());
+
+    ea::vector<SharedPtr<NavigationPathRequest>> requests;
+    unsigned numCallbacks = 0;
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        const Vector3 start{Random(80.0f) - 40.0f, 0.0f, Random(80.0f) - 40.0f};
+        const Vector3 end{Random(80.0f) - 40.0f, 0.0f, Random(80.0f) - 40.0f};
+        requests.push_back(navMesh->RequestPath(start, end, Vector3::ONE, nullptr,
+            [&](NavigationPathRequest* request) { ++numCallbacks; }));
+    }
+    REQUIRE(navMesh->GetNumPendingPathRequests() == 100);
+
+    navMesh->ProcessPathRequests(60);
+    REQUIRE(navMesh->GetNumPendingPathRequests() == 40);
+    REQUIRE(numCallbacks == 60);
+    REQUIRE(requests[59]->IsCompleted());
+    REQUIRE_FALSE(requests[60]->IsCompleted());
+
+    navMesh->ProcessPathRequests(60);
+    REQUIRE(navMesh->GetNumPendingPathRequests() == 0);
+    REQUIRE(numCallbacks == 100);
+
+    for (NavigationPathRequest* request : requests)
+    {
+        ea::vector<NavigationPathPoint> expectedPath;
+        navMesh->FindPath(expectedPath, request->GetStart(), request->GetEnd());
+
+        const ea::vector<NavigationPathPoint>& path = request->GetPath();
+        REQUIRE(path.size() == expectedPath.size());
+        for (unsigned i = 0; i < path.size(); ++i)
+            REQUIRE(path[i].position_.Equals(expectedPath[i].position_));
+    }
+}
+
+TEST_CASE("Navigation mesh tiles are streamed in regions around streaming points")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fs = context->GetSubsystem<FileSystem>();
+
+    const ea::string rootPath = Format("{}Urho3D-Tests-{}/", fs->GetTemporaryDir(), GenerateUUID());
+    const TemporaryDir rootPathHolder{context, rootPath};
+
+    auto scene = CreateTestScene(context, 0);
+    scene->CreateComponent<Navigable>();
+
+    auto* navMesh = scene->CreateComponent<NavigationMesh>();
+    navMesh->SetTileSize(32);
+    navMesh->SetAgentHeight(10.0f);
+    navMesh->SetCellHeight(0.05f);
+    navMesh->SetStreamingRegionSize(2);
+    REQUIRE(navMesh->Build());
+    REQUIRE(navMesh->SaveStreamingRegions(rootPath));
+
+    // Only mesh parameters are stored in the scene
+    const ByteVector fullData = navMesh->GetNavigationDataAttr();
+    navMesh->SetStreamingDirectory("file://" + rootPath);
+    const ByteVector headerData = navMesh->GetNavigationDataAttr();
+    REQUIRE(headerData.size() < fullData.size());
+
+    const Vector3 nearPosition{-45.0f, 0.0f, -45.0f};
+    const Vector3 farPosition{45.0f, 0.0f, 45.0f};
+    const IntVector2 nearTile = navMesh->GetTileIndex(nearPosition);
+    const IntVector2 farTile = navMesh->GetTileIndex(farPosition);
+
+    auto streamedScene = MakeShared<Scene>(context);
+    auto* streamedMesh = streamedScene->CreateComponent<NavigationMesh>();
+    streamedMesh->SetStreamingRegionSize(2);
+    streamedMesh->SetStreamingDistance(10.0f);
+    streamedMesh->SetStreamingDirectory("file://" + rootPath);
+    streamedMesh->SetNavigationDataAttr(headerData);
+    REQUIRE_FALSE(streamedMesh->HasTile(nearTile));
+
+    Node* pointNode = streamedScene->CreateChild("Streaming Point");
+    pointNode->SetPosition(nearPosition);
+    streamedMesh->AddStreamingPoint(pointNode);
+
+    const auto waitForRegions = [&]()
+    {
+        for (unsigned i = 0; i < 100; ++i)
+        {
+            Tests::RunFrame(context, 0.01f);
+            if (streamedMesh->GetNumLoadingRegions() == 0)
+                break;
+        }
+        REQUIRE(streamedMesh->GetNumLoadingRegions() == 0);
+    };
+
+    waitForRegions();
+    CHECK(streamedMesh->HasTile(nearTile));
+    CHECK_FALSE(streamedMesh->HasTile(farTile));
+
+    pointNode->SetPosition(farPosition);
+    waitForRegions();
+    CHECK_FALSE(streamedMesh->HasTile(nearTile));
+    CHECK(streamedMesh->HasTile(farTile));
+
+    // Links of the tile polygons depend on loaded neighbors, so compare the tile size and queries instead of data
+    CHECK(streamedMesh->GetTileData(farTile).size() == navMesh->GetTileData(farTile).size());
+    const Vector3 extents{5.0f, 5.0f, 5.0f};
+    CHECK(streamedMesh->FindNearestPoint(farPosition, extents).Equals(navMesh->FindNearestPoint(farPosition, extents)));
+}
+
+TEST_CASE("Parallel crowd update matches serial crowd update")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const auto createCrowd = [&](bool parallelUpdate)
+    {
+        SetRandomSeed(1);
+        auto scene = CreateTestScene(context, 20);
+        scene->CreateComponent<Navigable>();
+
+        auto* navMesh = scene->CreateComponent<DynamicNavigationMesh>();
+        navMesh->SetTileSize(32);
+        navMesh->SetAgentHeight(10.0f);
+        navMesh->SetCellHeight(0.05f);
+        navMesh->Build();
+
+        auto* crowdManager = scene->CreateComponent<CrowdManager>();
+        crowdManager->SetParallelUpdate(parallelUpdate);
+
+        Node* agentsNode = scene->CreateChild("Agents");
+        for (unsigned i = 0; i < 100; ++i)
+        {
+            const Vector3 position{-40.0f + (i % 10) * 2.0f, 0.0f, -10.0f + (i / 10) * 2.0f};
+            SpawnCrowdAgent(position, agentsNode, true);
+        }
+        crowdManager->SetCrowdTarget(Vector3(40.0f, 0.0f, 0.0f), agentsNode);
+        return scene;
+    };
+
+    auto serialScene = createCrowd(false);
+    auto parallelScene = createCrowd(true);
+
+    const auto& serialAgents = serialScene->GetChild("Agents")->GetChildren();
+    const auto& parallelAgents = parallelScene->GetChild("Agents")->GetChildren();
+    REQUIRE(serialAgents.size() == parallelAgents.size());
+
+    Tests::RunFrame(context, 2.0f, 0.1f);
+
+    for (unsigned i = 0; i < serialAgents.size(); ++i)
+    {
+        REQUIRE(serialAgents[i]->GetWorldPosition() != Vector3(-40.0f + (i % 10) * 2.0f, 0.0f, -10.0f + (i / 10) * 2.0f));
+        REQUIRE(serialAgents[i]->GetWorldPosition().Equals(parallelAgents[i]->GetWorldPosition()));
+    }
+}
+
 TEST_CASE("Recast/Detour Crowdmanager test with DynamicNavigationMesh")
 {
 
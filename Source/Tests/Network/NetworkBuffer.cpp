@@ -0,0 +1,50 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Network/Transport/NetworkBuffer.h>
+
+TEST_CASE("Network buffers are reused when released")
+{
+    NetworkBufferPool pool;
+
+    SharedPtr<NetworkBuffer> first = pool.Acquire();
+    first->GetData().resize(100);
+    const unsigned char* firstData = first->GetData().data();
+
+    // Buffer is still referenced by the slice, new buffer is allocated
+    NetworkBufferSlice slice{first, 10, 20};
+    first = nullptr;
+    SharedPtr<NetworkBuffer> second = pool.Acquire();
+    CHECK(pool.GetNumBuffers() == 2);
+    CHECK(slice.GetData() == firstData + 10);
+    CHECK(slice.GetSize() == 20);
+
+    // Buffer is reused once released, memory is kept
+    slice = {};
+    SharedPtr<NetworkBuffer> third = pool.Acquire();
+    CHECK(pool.GetNumBuffers() == 2);
+    CHECK(third->GetSize() == 0);
+    CHECK(third->GetData().capacity() >= 100);
+    CHECK(third->GetData().data() == firstData);
+}
@@ -0,0 +1,71 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/Network/Network.h>
+
+TEST_CASE("Remote events are serialized once and decoded with registered schema")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto network = context->GetSubsystem<Network>();
+
+    const StringHash genericEvent{"TestGenericRemoteEvent"};
+    const StringHash compactEvent{"TestCompactRemoteEvent"};
+    network->RegisterRemoteEvent(genericEvent);
+    network->RegisterRemoteEvent(compactEvent, {{"Damage", VAR_FLOAT}, {"Position", VAR_VECTOR3}, {"Target", VAR_INT}});
+
+    const auto roundtrip = [&](StringHash eventType, const VariantMap& eventData, NetworkMessageId expectedMessageId)
+    {
+        const RemoteEvent remoteEvent = network->SerializeRemoteEvent(eventType, true, eventData);
+        REQUIRE(remoteEvent.data_);
+        CHECK(remoteEvent.messageId_ == expectedMessageId);
+        CHECK(remoteEvent.inOrder_);
+
+        MemoryBuffer buffer(*remoteEvent.data_);
+        REQUIRE(buffer.ReadStringHash() == eventType);
+
+        VariantMap decodedData;
+        REQUIRE(network->DeserializeRemoteEventData(remoteEvent.messageId_, eventType, buffer, decodedData));
+        CHECK(buffer.IsEof());
+        CHECK(decodedData == eventData);
+        return remoteEvent.data_->size();
+    };
+
+    const VariantMap eventData{
+        {"Damage", 12.5f},
+        {"Position", Vector3{1.0f, 2.0f, 3.0f}},
+        {"Extra", ea::string{"Critical"}},
+    };
+    const unsigned genericSize = roundtrip(genericEvent, eventData, MSG_REMOTEEVENT);
+    const unsigned compactSize = roundtrip(compactEvent, eventData, MSG_REMOTEEVENT_COMPACT);
+    CHECK(compactSize < genericSize);
+
+    // Type mismatch falls back to generic encoding
+    roundtrip(compactEvent, {{"Damage", 12}}, MSG_REMOTEEVENT);
+    roundtrip(compactEvent, {}, MSG_REMOTEEVENT_COMPACT);
+
+    network->UnregisterRemoteEvent(genericEvent);
+    network->UnregisterRemoteEvent(compactEvent);
+}
@@ -0,0 +1,134 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Network/Transport/Udp/UdpConnection.h>
+#include <Urho3D/Network/Transport/Udp/UdpServer.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+
+/// Wait until predicate is true or timeout is reached.
+template <class T>
+bool WaitFor(const T& predicate, unsigned timeoutMs = 3000)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!predicate())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+ea::string MakeMessage(unsigned size, char seed)
+{
+    ea::string result(size, '\\0');
+    for (unsigned i = 0; i < size; ++i)
+        result[i] = static_cast<char>(seed + i % 31);
+    return result;
+}
+
+}
+
+TEST_CASE("UDP transport delivers reliable and unreliable messages")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    std::mutex mutex;
+    SharedPtr<NetworkConnection> serverConnection;
+    ea::vector<ea::string> serverMessages;
+    ea::vector<ea::string> clientMessages;
+
+    auto server = MakeShared<UdpServer>(context);
+    server->onConnected_ = [&](NetworkConnection* connection)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        connection->onMessage_ = [&](ea::string_view message)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            serverMessages.emplace_back(message);
+        };
+        serverConnection = connection;
+    };
+    REQUIRE(server->Listen(URL{"udp://:0"}));
+    REQUIRE(server->GetLocalPort() != 0);
+
+    auto client = MakeShared<UdpConnection>(context);
+    std::atomic_bool clientConnected{};
+    client->onConnected_ = [&] { clientConnected = true; };
+    client->onMessage_ = [&](ea::string_view message)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        clientMessages.emplace_back(message);
+    };
+
+    URL url{"udp://127.0.0.1"};
+    url.port_ = server->GetLocalPort();
+    REQUIRE(client->Connect(url));
+    REQUIRE(WaitFor([&] { return clientConnected.load(); }));
+    REQUIRE(WaitFor([&] { std::lock_guard<std::mutex> lock(mutex); return serverConnection != nullptr; }));
+    CHECK(client->GetState() == NetworkConnection::State::Connected);
+
+    // Send messages of all types, large message is fragmented
+    const ea::string smallMessage = MakeMessage(100, 'a');
+    const ea::string largeMessage = MakeMessage(5000, 'b');
+    client->SendMessage(smallMessage, PacketType::ReliableOrdered);
+    client->SendMessage(largeMessage, PacketType::ReliableOrdered);
+    client->SendMessage(smallMessage, PacketType::ReliableUnordered);
+    client->SendMessage(smallMessage, PacketType::UnreliableOrdered);
+    client->SendMessage(smallMessage, PacketType::UnreliableUnordered);
+    client->Flush();
+
+    REQUIRE(WaitFor([&] { std::lock_guard<std::mutex> lock(mutex); return serverMessages.size() >= 5; }));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        CHECK(serverMessages.size() == 5);
+        CHECK(ea::count(serverMessages.begin(), serverMessages.end(), largeMessage) == 1);
+        CHECK(ea::count(serverMessages.begin(), serverMessages.end(), smallMessage) == 4);
+    }
+
+    // Reliable messages are acknowledged
+    CHECK(WaitFor([&] { return client->GetNumPendingReliableMessages() == 0; }));
+
+    // Send reply from server
+    serverConnection->SendMessage(largeMessage, PacketType::ReliableOrdered);
+    serverConnection->Flush();
+    REQUIRE(WaitFor([&] { std::lock_guard<std::mutex> lock(mutex); return !clientMessages.empty(); }));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        CHECK(clientMessages.front() == largeMessage);
+    }
+
+    // Disconnect is delivered to server
+    client->Disconnect();
+    CHECK(client->GetState() == NetworkConnection::State::Disconnected);
+    CHECK(WaitFor([&] { return server->GetNumConnections() == 0; }));
+
+    server->Stop();
+}
@@ -65,6 +65,7 @@ void ManualConnection::SendMessageInternal(NetworkMessageId messageId, const uns
     const bool inOrder = packetType & PacketType::Ordered;
 
     ++totalMessages_;
+    totalBytes_ += numBytes;
     if (!reliable)
         ++totalUnreliableMessages_;
     if (!inOrder)
@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2017-2021 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+#include "../ModelUtils.h"
+
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/IO/MountedExternalMemory.h>
+#include <Urho3D/IO/VirtualFileSystem.h>
+#include <Urho3D/Physics/CollisionGeometryCache.h>
+#include <Urho3D/Physics/CollisionShape.h>
+#include <Urho3D/Physics/PhysicsWorld.h>
+#include <Urho3D/Physics/RigidBody.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+SharedPtr<Model> CreateFloorModel(Context* context, const ea::string& name, unsigned size)
+{
+    auto modelView = MakeShared<ModelView>(context);
+    auto& geometries = modelView->GetGeometries();
+    geometries.resize(1);
+    geometries[0].lods_.resize(1);
+
+    GeometryLODView& lod = geometries[0].lods_[0];
+    lod.vertexFormat_ = Tests::GetVertexFormat();
+    for (unsigned x = 0; x < size; ++x)
+    {
+        for (unsigned z = 0; z < size; ++z)
+        {
+            const Vector3 position{x + 0.5f, 0.0f, z + 0.5f};
+            Tests::AppendQuad(lod, position, Quaternion{90.0f, Vector3::RIGHT}, Vector2::ONE, Color::WHITE);
+        }
+    }
+    return modelView->ExportModel(name);
+}
+
+SharedPtr<Scene> CreateFloorScene(Context* context, Model* model)
+{
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<PhysicsWorld>();
+    Node* floorNode = scene->CreateChild("Floor");
+    floorNode->CreateComponent<RigidBody>();
+    floorNode->CreateComponent<CollisionShape>()->SetTriangleMesh(model);
+    return scene;
+}
+
+}
+
+TEST_CASE("Collision geometry is shared between physics worlds")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto model = CreateFloorModel(context, "Models/SharedFloor.mdl", 4);
+
+    auto scene1 = CreateFloorScene(context, model);
+    auto scene2 = CreateFloorScene(context, model);
+    auto shape1 = scene1->GetChild("Floor")->GetComponent<CollisionShape>();
+    auto shape2 = scene2->GetChild("Floor")->GetComponent<CollisionShape>();
+
+    auto geometryCache = context->GetSubsystem<CollisionGeometryCache>();
+    REQUIRE(geometryCache);
+    REQUIRE(shape1->GetGeometryData());
+    CHECK(shape1->GetGeometryData() == shape2->GetGeometryData());
+    CHECK(geometryCache->GetGeometry(SHAPE_TRIANGLEMESH, model, 0) == shape1->GetGeometryData());
+
+    // Geometry is released when the last shape is removed
+    shape1->Remove();
+    CHECK(geometryCache->GetGeometry(SHAPE_TRIANGLEMESH, model, 0) == shape2->GetGeometryData());
+    scene2->GetChild("Floor")->Remove();
+    CHECK_FALSE(geometryCache->GetGeometry(SHAPE_TRIANGLEMESH, model, 0));
+}
+
+TEST_CASE("Cooked collision BVH is used if it matches the model")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto mountPoint = MakeShared<MountedExternalMemory>(context, "memory");
+    const MountPointGuard mountPointGuard(mountPoint);
+
+    auto model = CreateFloorModel(context, "memory://Models/CookedFloor.mdl", 8);
+    auto otherModel = CreateFloorModel(context, "memory://Models/OtherFloor.mdl", 6);
+
+    VectorBuffer cookedBvh;
+    {
+        const TriangleMeshData data(model, 0, false);
+        REQUIRE_FALSE(data.IsCookedBvhUsed());
+        REQUIRE(data.SaveBvh(cookedBvh));
+    }
+    mountPoint->LinkMemory("Models/CookedFloor_LOD0.bvh", MemoryBuffer(cookedBvh));
+    mountPoint->LinkMemory("Models/OtherFloor_LOD0.bvh", MemoryBuffer(cookedBvh));
+
+    // Cooked BVH is loaded and behaves the same as the built one
+    {
+        const TriangleMeshData data(model, 0);
+        CHECK(data.IsCookedBvhUsed());
+
+        auto scene = CreateFloorScene(context, model);
+        auto physicsWorld = scene->GetComponent<PhysicsWorld>();
+        auto shape = scene->GetChild("Floor")->GetComponent<CollisionShape>();
+        CHECK(static_cast<TriangleMeshData*>(shape->GetGeometryData())->IsCookedBvhUsed());
+
+        physicsWorld->UpdateCollisions();
+        PhysicsRaycastResult result;
+        physicsWorld->RaycastSingle(result, Ray{{3.3f, 5.0f, 6.7f}, Vector3::DOWN}, 10.0f);
+        CHECK(result.body_ == scene->GetChild("Floor")->GetComponent<RigidBody>());
+        CHECK(result.position_.Equals({3.3f, 0.0f, 6.7f}));
+
+        physicsWorld->RaycastSingle(result, Ray{{9.0f, 5.0f, 3.0f}, Vector3::DOWN}, 10.0f);
+        CHECK_FALSE(result.body_);
+    }
+
+    // Mismatching BVH is ignored
+    {
+        const TriangleMeshData data(otherModel, 0);
+        CHECK_FALSE(data.IsCookedBvhUsed());
+    }
+}
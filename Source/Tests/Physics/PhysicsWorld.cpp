@@ -0,0 +1,226 @@
+//
+// Copyright (c) 2017-2021 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Physics/CollisionShape.h>
+#include <Urho3D/Physics/KinematicCharacterController.h>
+#include <Urho3D/Physics/PhysicsWorld.h>
+#include <Urho3D/Physics/RigidBody.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+ea::vector<Node*> CreateFallingBoxes(Scene* scene, unsigned count)
+{
+    Node* floorNode = scene->CreateChild("Floor");
+    floorNode->CreateComponent<CollisionShape>()->SetStaticPlane();
+    floorNode->CreateComponent<RigidBody>()->SetCollisionLayer(2);
+
+    ea::vector<Node*> boxNodes;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        Node* boxNode = scene->CreateChild("Box");
+        boxNode->SetPosition({(i % 8) * 2.0f, 1.0f + (i % 3), (i / 8) * 2.0f});
+        boxNode->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+        boxNode->CreateComponent<RigidBody>()->SetMass(1.0f);
+        boxNodes.push_back(boxNode);
+    }
+    return boxNodes;
+}
+
+}
+
+TEST_CASE("Multithreaded physics world simulates rigid bodies")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const bool multithreaded = GENERATE(false, true);
+    auto scene = MakeShared<Scene>(context);
+    auto physicsWorld = scene->CreateComponent<PhysicsWorld>();
+    physicsWorld->SetGravity(Vector3::DOWN * 10.0f);
+    physicsWorld->SetNumIterations(20);
+    physicsWorld->SetMultithreaded(multithreaded);
+
+    REQUIRE(physicsWorld->IsMultithreaded() == multithreaded);
+    REQUIRE(physicsWorld->GetGravity() == Vector3::DOWN * 10.0f);
+    REQUIRE(physicsWorld->GetNumIterations() == 20);
+
+    // Simulate boxes until they fall on the floor
+    const ea::vector<Node*> boxNodes = CreateFallingBoxes(scene, 32);
+    for (unsigned i = 0; i < 5 * 60; ++i)
+        physicsWorld->Update(1.0f / 60.0f);
+
+    for (Node* boxNode : boxNodes)
+    {
+        CHECK(boxNode->GetPosition().y_ == Catch::Approx(0.5f).margin(0.05f));
+        CHECK(boxNode->GetComponent<RigidBody>()->GetLinearVelocity().Length() < 0.1f);
+    }
+
+    // World cannot be recreated when there are objects in it
+    physicsWorld->SetMultithreaded(!multithreaded);
+    CHECK(physicsWorld->IsMultithreaded() == multithreaded);
+}
+
+TEST_CASE("Sleeping rigid bodies are not synchronized with nodes")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = MakeShared<Scene>(context);
+    auto physicsWorld = scene->CreateComponent<PhysicsWorld>();
+    const ea::vector<Node*> boxNodes = CreateFallingBoxes(scene, 16);
+
+    Node* kinematicNode = scene->CreateChild("Kinematic");
+    kinematicNode->SetPosition({-10.0f, 5.0f, 0.0f});
+    kinematicNode->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+    auto kinematicBody = kinematicNode->CreateComponent<RigidBody>();
+    kinematicBody->SetMass(1.0f);
+    kinematicBody->SetKinematic(true);
+
+    physicsWorld->Update(1.0f / 60.0f);
+    CHECK(physicsWorld->GetNumSynchronizedBodies() == boxNodes.size());
+
+    // Let all boxes fall asleep
+    for (unsigned i = 0; i < 10 * 60; ++i)
+        physicsWorld->Update(1.0f / 60.0f);
+
+    for (Node* boxNode : boxNodes)
+    {
+        CHECK_FALSE(boxNode->GetComponent<RigidBody>()->IsActive());
+        CHECK(boxNode->GetPosition().y_ == Catch::Approx(0.5f).margin(0.05f));
+    }
+    CHECK(physicsWorld->GetNumSynchronizedBodies() == 0);
+    CHECK(kinematicNode->GetPosition() == Vector3{-10.0f, 5.0f, 0.0f});
+
+    // Woken up body is synchronized again. Motion states lag one step behind because of interpolation
+    boxNodes[0]->GetComponent<RigidBody>()->ApplyImpulse(Vector3::UP * 5.0f);
+    physicsWorld->Update(1.0f / 60.0f);
+    physicsWorld->Update(1.0f / 60.0f);
+    CHECK(physicsWorld->GetNumSynchronizedBodies() >= 1);
+    CHECK(boxNodes[0]->GetPosition().y_ > 0.5f);
+}
+
+TEST_CASE("Batched physics queries match single queries")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = MakeShared<Scene>(context);
+    auto physicsWorld = scene->CreateComponent<PhysicsWorld>();
+    const ea::vector<Node*> boxNodes = CreateFallingBoxes(scene, 32);
+    physicsWorld->UpdateCollisions();
+
+    // Cast rays and spheres down from the grid covering some of the boxes
+    ea::vector<PhysicsRaycastQuery> rayQueries;
+    ea::vector<PhysicsSphereCastQuery> sphereQueries;
+    ea::vector<PhysicsOverlapQuery> overlapQueries;
+    for (int x = -2; x < 20; ++x)
+    {
+        for (int z = -2; z < 10; ++z)
+        {
+            const Vector3 origin{x * 1.3f, 10.0f, z * 1.1f};
+            rayQueries.push_back(PhysicsRaycastQuery{Ray{origin, Vector3::DOWN}, 20.0f});
+            sphereQueries.push_back(PhysicsSphereCastQuery{Ray{origin, Vector3::DOWN}, 0.3f, 20.0f});
+            overlapQueries.push_back(PhysicsOverlapQuery{BoundingBox{origin - Vector3{0.2f, 8.0f, 0.2f}, origin - Vector3{-0.2f, 7.0f, -0.2f}}, 1});
+        }
+    }
+
+    ea::vector<PhysicsRaycastResult> rayResults(rayQueries.size());
+    ea::vector<PhysicsRaycastResult> sphereResults(sphereQueries.size());
+    ea::vector<RigidBody*> overlapResults(overlapQueries.size());
+    physicsWorld->RaycastSingleBatch(rayQueries, rayResults);
+    physicsWorld->SphereCastBatch(sphereQueries, sphereResults);
+    physicsWorld->OverlapBatch(overlapQueries, overlapResults);
+
+    unsigned numBoxHits = 0;
+    unsigned numOverlaps = 0;
+    for (unsigned i = 0; i < rayQueries.size(); ++i)
+    {
+        PhysicsRaycastResult result;
+        physicsWorld->RaycastSingle(result, rayQueries[i].ray_, rayQueries[i].maxDistance_);
+        CHECK(rayResults[i].body_ == result.body_);
+        CHECK(rayResults[i].position_ == result.position_);
+
+        physicsWorld->SphereCast(result, sphereQueries[i].ray_, sphereQueries[i].radius_, sphereQueries[i].maxDistance_);
+        CHECK(sphereResults[i].body_ == result.body_);
+        CHECK(sphereResults[i].position_ == result.position_);
+
+        if (rayResults[i].body_ && rayResults[i].body_->GetNode() != scene->GetChild("Floor"))
+            ++numBoxHits;
+        if (overlapResults[i])
+        {
+            CHECK(overlapResults[i]->GetNode() != scene->GetChild("Floor"));
+            ++numOverlaps;
+        }
+    }
+
+    CHECK(numBoxHits > 0);
+    CHECK(numOverlaps > 0);
+    CHECK(numBoxHits < rayQueries.size());
+    CHECK(numOverlaps < overlapQueries.size());
+}
+
+TEST_CASE("Idle kinematic characters are skipped by physics world")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = MakeShared<Scene>(context);
+    auto physicsWorld = scene->CreateComponent<PhysicsWorld>();
+    physicsWorld->SetSkipIdleCharacters(true);
+
+    Node* floorNode = scene->CreateChild("Floor");
+    floorNode->CreateComponent<CollisionShape>()->SetStaticPlane();
+    floorNode->CreateComponent<RigidBody>();
+
+    ea::vector<KinematicCharacterController*> controllers;
+    for (unsigned i = 0; i < 8; ++i)
+    {
+        Node* characterNode = scene->CreateChild("Character");
+        characterNode->SetPosition({i * 2.0f, 0.5f, 0.0f});
+        controllers.push_back(characterNode->CreateComponent<KinematicCharacterController>());
+    }
+    REQUIRE(physicsWorld->GetNumCharacterControllers() == 8);
+
+    // Characters fall on the floor and fall asleep
+    for (unsigned i = 0; i < 2 * 60; ++i)
+        physicsWorld->Update(1.0f / 60.0f);
+
+    for (KinematicCharacterController* controller : controllers)
+    {
+        CHECK(controller->OnGround());
+        CHECK(controller->GetNode()->GetPosition().y_ == Catch::Approx(0.0f).margin(0.1f));
+    }
+    CHECK(physicsWorld->GetNumIdleCharacterControllers() == 8);
+
+    // Walking character is simulated
+    const Vector3 startPosition = controllers[0]->GetRawPosition();
+    controllers[0]->SetWalkIncrement(Vector3::FORWARD * 0.05f);
+    for (unsigned i = 0; i < 10; ++i)
+        physicsWorld->Update(1.0f / 60.0f);
+
+    CHECK(physicsWorld->GetNumIdleCharacterControllers() == 7);
+    CHECK(controllers[0]->GetRawPosition().z_ > startPosition.z_ + 0.25f);
+
+    // Removed characters are not simulated
+    controllers[1]->Remove();
+    CHECK(physicsWorld->GetNumCharacterControllers() == 7);
+}
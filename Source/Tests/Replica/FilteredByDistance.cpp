@@ -31,8 +31,10 @@
 #include <Urho3D/Scene/SceneEvents.h>
 #include <Urho3D/Replica/BehaviorNetworkObject.h>
 #include <Urho3D/Replica/FilteredByDistance.h>
+#include <Urho3D/Replica/NetworkSettingsConsts.h>
 #include <Urho3D/Replica/ReplicationManager.h>
 #include <Urho3D/Replica/ReplicatedTransform.h>
+#include <Urho3D/Replica/ServerReplicator.h>
 
 namespace
 {
@@ -70,10 +72,18 @@ TEST_CASE("FilteredByDistance handles object hierarchies")
     // Create scenes
     auto serverScene = MakeShared<Scene>(context);
     auto clientScene = MakeShared<Scene>(context);
+    auto otherClientScene = MakeShared<Scene>(context);
 
     const auto quality = Tests::ConnectionQuality{ 0.08f, 0.12f, 0.20f, 0.02f, 0.02f };
     Tests::NetworkSimulator sim(serverScene);
+
+    // Client updates are the same whether performed in parallel or not
+    const bool isParallel = GENERATE(false, true);
+    ServerReplicator* serverReplicator = serverScene->GetComponent<ReplicationManager>()->GetServerReplicator();
+    serverReplicator->SetSetting(NetworkSettings::ParallelClientUpdates, isParallel);
+
     sim.AddClient(clientScene, quality);
+    sim.AddClient(otherClientScene, quality);
     sim.SimulateTime(5.0f);
 
     // Spawn objects
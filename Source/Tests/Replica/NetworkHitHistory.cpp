@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2017-2021 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Replica/NetworkHitHistory.h>
+
+namespace
+{
+
+NetworkHitShape MakeShape(NetworkHitShape::Type type, float size)
+{
+    NetworkHitShape shape;
+    shape.type_ = type;
+    shape.size_ = Vector3::ONE * size;
+    return shape;
+}
+
+}
+
+TEST_CASE("Network hit history rewinds queries to the past frames")
+{
+    const NetworkId movingObject = ConstructComponentReference(1, 1);
+    const NetworkId staticObject = ConstructComponentReference(2, 1);
+    const NetworkHitShape box = MakeShape(NetworkHitShape::Type::Box, 2.0f);
+    const NetworkHitShape sphere = MakeShape(NetworkHitShape::Type::Sphere, 2.0f);
+
+    // Moving object moves by 10 units along X each frame, static object stays still
+    NetworkHitHistory history;
+    history.Reset(10, 4.0f);
+    for (unsigned i = 1; i <= 5; ++i)
+    {
+        const auto frame = static_cast<NetworkFrame>(i);
+        history.RecordFrame(frame, {});
+        history.RecordObject(frame, movingObject, Matrix3x4{Vector3{i * 10.0f, 0.0f, 0.0f}, Quaternion::IDENTITY, 1.0f}, {&box, 1});
+        history.RecordObject(frame, staticObject, Matrix3x4{Vector3{0.0f, 0.0f, 20.0f}, Quaternion::IDENTITY, 1.0f}, {&sphere, 1});
+    }
+    REQUIRE(history.HasFrame(static_cast<NetworkFrame>(5)));
+    REQUIRE(history.GetNumObjects(static_cast<NetworkFrame>(3)) == 2);
+
+    SECTION("Ray queries return the closest hit at the time of each query")
+    {
+        const Ray rayAtMovingObject{Vector3{25.0f, 0.0f, -10.0f}, Vector3::FORWARD};
+        const Ray rayAtStaticObject{Vector3{0.0f, 0.0f, -10.0f}, Vector3::FORWARD};
+        const NetworkRayQuery queries[] = {
+            {rayAtMovingObject, M_LARGE_VALUE, NetworkTime{static_cast<NetworkFrame>(2), 0.5f}},
+            {rayAtMovingObject, M_LARGE_VALUE, NetworkTime{static_cast<NetworkFrame>(4)}},
+            {rayAtStaticObject, M_LARGE_VALUE, NetworkTime{static_cast<NetworkFrame>(3)}},
+            {rayAtStaticObject, 20.0f, NetworkTime{static_cast<NetworkFrame>(3)}},
+        };
+
+        ea::vector<NetworkHitResult> results;
+        history.ProcessRayQueries(queries, results);
+
+        REQUIRE(results.size() == 2);
+        CHECK(results[0].queryIndex_ == 0);
+        CHECK(results[0].networkId_ == movingObject);
+        CHECK(results[0].distance_ == Catch::Approx(9.0f));
+        CHECK(results[0].position_.Equals(Vector3{25.0f, 0.0f, -1.0f}));
+        CHECK(results[1].queryIndex_ == 2);
+        CHECK(results[1].networkId_ == staticObject);
+        CHECK(results[1].distance_ == Catch::Approx(29.0f));
+    }
+
+    SECTION("Sphere queries return all overlapped objects")
+    {
+        const NetworkSphereQuery queries[] = {
+            {Sphere{Vector3{40.0f, 0.0f, 0.0f}, 1.5f}, NetworkTime{static_cast<NetworkFrame>(4)}},
+            {Sphere{Vector3{40.0f, 0.0f, 0.0f}, 1.5f}, NetworkTime{static_cast<NetworkFrame>(1)}},
+            {Sphere{Vector3{0.0f, 0.0f, 10.0f}, 30.0f}, NetworkTime{static_cast<NetworkFrame>(1)}},
+        };
+
+        ea::vector<NetworkHitResult> results;
+        history.ProcessSphereQueries(queries, results);
+
+        REQUIRE(results.size() == 3);
+        CHECK(results[0].queryIndex_ == 0);
+        CHECK(results[0].networkId_ == movingObject);
+        CHECK(results[1].queryIndex_ == 2);
+        CHECK(results[2].queryIndex_ == 2);
+    }
+
+    SECTION("Queries outside of the history are clamped")
+    {
+        const NetworkRayQuery queries[] = {
+            {Ray{Vector3{50.0f, 0.0f, -10.0f}, Vector3::FORWARD}, M_LARGE_VALUE, NetworkTime{static_cast<NetworkFrame>(100)}},
+            {Ray{Vector3{10.0f, 0.0f, -10.0f}, Vector3::FORWARD}, M_LARGE_VALUE, NetworkTime{static_cast<NetworkFrame>(-100)}},
+        };
+
+        ea::vector<NetworkHitResult> results;
+        history.ProcessRayQueries(queries, results);
+
+        REQUIRE(results.size() == 2);
+        CHECK(results[0].networkId_ == movingObject);
+        CHECK(results[1].networkId_ == movingObject);
+    }
+}
+
+TEST_CASE("Network hit history uses spatial grid for many objects")
+{
+    const NetworkHitShape box = MakeShape(NetworkHitShape::Type::Box, 2.0f);
+    const auto frame = static_cast<NetworkFrame>(1);
+
+    NetworkHitHistory history;
+    history.Reset(4, 4.0f);
+    history.RecordFrame(frame, {});
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        const Matrix3x4 transform{Vector3{i * 10.0f, 0.0f, 0.0f}, Quaternion::IDENTITY, 1.0f};
+        history.RecordObject(frame, ConstructComponentReference(i + 1, 1), transform, {&box, 1});
+    }
+
+    ea::vector<NetworkRayQuery> queries;
+    for (unsigned i = 0; i < 100; ++i)
+        queries.push_back({Ray{Vector3{i * 10.0f + 0.5f, 5.0f, 0.0f}, Vector3::DOWN}, M_LARGE_VALUE, NetworkTime{frame}});
+    queries.push_back({Ray{Vector3{-10.0f, 0.0f, 0.0f}, Vector3::RIGHT}, M_LARGE_VALUE, NetworkTime{frame}});
+    queries.push_back({Ray{Vector3{5.0f, 5.0f, 0.0f}, Vector3::DOWN}, M_LARGE_VALUE, NetworkTime{frame}});
+
+    ea::vector<NetworkHitResult> results;
+    history.ProcessRayQueries(queries, results);
+
+    REQUIRE(results.size() == 101);
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        CHECK(results[i].queryIndex_ == i);
+        CHECK(results[i].networkId_ == ConstructComponentReference(i + 1, 1));
+        CHECK(results[i].distance_ == Catch::Approx(4.0f));
+    }
+    CHECK(results[100].queryIndex_ == 100);
+    CHECK(results[100].networkId_ == ConstructComponentReference(1, 1));
+    CHECK(results[100].distance_ == Catch::Approx(9.0f));
+}
@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2017-2021 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Replica/NetworkInterestGrid.h>
+
+TEST_CASE("NetworkInterestGrid finds nearest interest point of connection")
+{
+    auto connectionA = reinterpret_cast<AbstractConnection*>(1);
+    auto connectionB = reinterpret_cast<AbstractConnection*>(2);
+
+    NetworkInterestGrid grid;
+    grid.Reset(10.0f);
+    grid.AddInterestPoint(connectionA, Vector3{0.0f, 0.0f, 0.0f});
+    grid.AddInterestPoint(connectionA, Vector3{95.0f, 0.0f, 0.0f});
+    grid.AddInterestPoint(connectionB, Vector3{-3.0f, 0.0f, 0.0f});
+
+    CHECK(grid.GetNumInterestPoints(connectionA) == 2);
+    CHECK(grid.GetNumInterestPoints(connectionB) == 1);
+
+    // Query that covers few cells
+    CHECK(grid.IsInRange(connectionA, Vector3{5.0f, 0.0f, 0.0f}, 6.0f));
+    CHECK_FALSE(grid.IsInRange(connectionA, Vector3{5.0f, 0.0f, 0.0f}, 4.0f));
+    CHECK(grid.IsInRange(connectionA, Vector3{-12.0f, 0.0f, 0.0f}, 13.0f));
+    CHECK_FALSE(grid.IsInRange(connectionB, Vector3{95.0f, 0.0f, 0.0f}, 13.0f));
+    CHECK(grid.GetDistanceToConnection(connectionA, Vector3{90.0f, 0.0f, 0.0f}, 10.0f) == Catch::Approx(5.0f));
+
+    // Query that covers many cells falls back to the list of points
+    CHECK(grid.GetDistanceToConnection(connectionB, Vector3{97.0f, 0.0f, 0.0f}, 1000.0f) == Catch::Approx(100.0f));
+    CHECK(grid.GetDistanceToConnection(connectionA, Vector3{50.0f, 0.0f, 0.0f}, M_LARGE_VALUE) == Catch::Approx(45.0f));
+
+    // Grid is empty after reset
+    grid.Reset(10.0f);
+    CHECK(grid.GetNumInterestPoints(connectionA) == 0);
+    CHECK_FALSE(grid.IsInRange(connectionA, Vector3::ZERO, 1000.0f));
+}
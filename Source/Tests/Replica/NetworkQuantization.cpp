@@ -0,0 +1,70 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Replica/NetworkQuantization.h>
+
+TEST_CASE("Signed integers are encoded with ZigZag")
+{
+    for (int value : {0, 1, -1, 63, -64, 1000000, -1000000, M_MAX_INT, M_MIN_INT})
+        CHECK(ZigZagDecode(ZigZagEncode(value)) == value);
+
+    CHECK(ZigZagEncode(0) == 0);
+    CHECK(ZigZagEncode(-1) == 1);
+    CHECK(ZigZagEncode(1) == 2);
+}
+
+TEST_CASE("Vectors are quantized with given precision")
+{
+    const float precision = 0.001f;
+    const Vector3 value{12.3456f, -0.0004f, -1000.0f};
+
+    VectorBuffer buffer;
+    WriteQuantizedVector3(buffer, value, precision);
+    CHECK(buffer.GetSize() < sizeof(Vector3));
+
+    MemoryBuffer src{buffer.GetBuffer()};
+    const Vector3 result = ReadQuantizedVector3(src, precision);
+    CHECK(result.Equals(value, precision));
+    CHECK(src.IsEof());
+}
+
+TEST_CASE("Quaternions are packed into 32 bits")
+{
+    const Quaternion rotations[] = {
+        Quaternion::IDENTITY,
+        Quaternion{90.0f, Vector3::UP},
+        Quaternion{-170.0f, Vector3::RIGHT},
+        Quaternion{30.0f, 60.0f, 120.0f},
+        Quaternion{-0.5f, 0.5f, -0.5f, 0.5f},
+    };
+
+    for (const Quaternion& rotation : rotations)
+    {
+        const Quaternion result = UnpackQuaternion(PackQuaternion(rotation));
+        CHECK(result.Equivalent(rotation, 0.0001f));
+        CHECK((result.Equals(rotation, 0.002f) || result.Equals(-rotation, 0.002f)));
+    }
+}
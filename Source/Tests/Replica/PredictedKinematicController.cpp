@@ -31,6 +31,7 @@
 #include <Urho3D/Physics/PhysicsWorld.h>
 #include <Urho3D/Physics/RigidBody.h>
 #include <Urho3D/Replica/ClientInputStatistics.h>
+#include <Urho3D/Replica/ClientReplica.h>
 #include <Urho3D/Replica/BehaviorNetworkObject.h>
 #include <Urho3D/Replica/PredictedKinematicController.h>
 #include <Urho3D/Replica/ReplicatedTransform.h>
@@ -272,3 +273,61 @@ TEST_CASE("PredictedKinematicController works standalone")
     CHECK(standaloneNode->GetWorldPosition().x_ == 0.0f);
     CHECK(standaloneNode->GetWorldPosition().z_ == Catch::Approx(10.0f).margin(0.1f));
 }
+
+TEST_CASE("Predicted kinematic controllers are replayed together on correction")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/PredictedKinematicController/Test.prefab", CreateTestPrefab);
+
+    // Setup scenes
+    const auto quality = Tests::ConnectionQuality{ 0.08f, 0.12f, 0.20f, 0, 0 };
+
+    auto serverScene = CreateTestScene(context);
+    auto clientScene = CreateTestScene(context);
+
+    // Start simulation
+    Tests::NetworkSimulator sim(serverScene);
+    sim.AddClient(clientScene, quality);
+
+    // Create nodes
+    const unsigned numPlayers = 3;
+    ea::vector<Node*> serverNodes;
+    for (unsigned i = 0; i < numPlayers; ++i)
+    {
+        const Vector3 position{i * 4.0f, 0.96f, 0.0f};
+        Node* serverNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, Format("Player {}", i), position);
+        serverNode->GetComponent<BehaviorNetworkObject>()->SetOwner(sim.GetServerToClientConnection(clientScene));
+        serverNodes.push_back(serverNode);
+    }
+
+    // Wait for synchronization, expect all controllers managed by the replayer
+    sim.SimulateTime(10.0f);
+
+    ClientReplica* clientReplica = clientScene->GetComponent<ReplicationManager>()->GetClientReplica();
+    PredictedKinematicReplayer* replayer = clientReplica->GetKinematicReplayer();
+    REQUIRE(replayer);
+    REQUIRE(replayer->GetNumControllers() == numPlayers);
+
+    for (unsigned i = 0; i < numPlayers; ++i)
+    {
+        Node* clientNode = clientScene->GetChild(Format("Player {}", i), true);
+        REQUIRE(clientNode);
+        CHECK(clientNode->GetWorldPosition().Equals(serverNodes[i]->GetWorldPosition(), 0.1f));
+    }
+
+    // Teleport all controllers on server, expect client prediction corrected in one batch
+    for (Node* serverNode : serverNodes)
+        serverNode->Translate(Vector3::FORWARD * 5.0f, TS_WORLD);
+    sim.SimulateTime(2.0f);
+
+    CHECK(replayer->GetNumReplayedControllers() == numPlayers);
+    CHECK(replayer->GetNumReplayedFrames() > 0);
+
+    for (unsigned i = 0; i < numPlayers; ++i)
+    {
+        Node* clientNode = clientScene->GetChild(Format("Player {}", i), true);
+        CHECK(clientNode->GetWorldPosition().Equals(serverNodes[i]->GetWorldPosition(), ReplicatedTransform::DefaultMovementThreshold));
+    }
+}
@@ -36,8 +36,10 @@
 #include <Urho3D/Replica/BehaviorNetworkObject.h>
 #include <Urho3D/Replica/ReplicationManager.h>
 #include <Urho3D/Replica/NetworkObject.h>
+#include <Urho3D/Replica/NetworkSettingsConsts.h>
 #include <Urho3D/Replica/NetworkValue.h>
 #include <Urho3D/Replica/ReplicatedTransform.h>
+#include <Urho3D/Replica/ServerReplicator.h>
 
 namespace
 {
@@ -550,3 +552,104 @@ TEST_CASE("Ownership is consistent on server and on clients")
     REQUIRE(serverReplicator->GetNetworkObjectOwnedByConnection(sim.GetServerToClientConnection(clientScenes[2])) == nullptr);
 
 }
+
+TEST_CASE("Unreliable updates are prioritized within bandwidth budget")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/SceneSynchronization/SimpleTest.prefab", CreateSimpleTestPrefab);
+
+    // Setup scenes
+    const auto quality = Tests::ConnectionQuality{ 0.08f, 0.12f, 0.20f, 0, 0 };
+    auto serverScene = MakeShared<Scene>(context);
+    auto clientScene = MakeShared<Scene>(context);
+
+    static constexpr unsigned numNodes = 10;
+    ea::vector<WeakPtr<Node>> serverNodes;
+    for (unsigned i = 0; i < numNodes; ++i)
+        serverNodes.emplace_back(Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, Format("Node {}", i)));
+
+    // Allow only a few updates per frame
+    Tests::NetworkSimulator sim(serverScene);
+    ServerReplicator* serverReplicator = serverScene->GetComponent<ReplicationManager>()->GetServerReplicator();
+    serverReplicator->SetSetting(NetworkSettings::UnreliableBandwidthBudget, 150 * Tests::NetworkSimulator::FramesInSecond);
+    sim.AddClient(clientScene, quality);
+    sim.SimulateTime(5.0f);
+
+    // Move all nodes every frame
+    AbstractConnection* connection = sim.GetServerToClientConnection(clientScene);
+    unsigned maxDeferredUpdates = 0;
+    for (unsigned frame = 1; frame <= Tests::NetworkSimulator::FramesInSecond; ++frame)
+    {
+        for (unsigned i = 0; i < numNodes; ++i)
+            serverNodes[i]->SetWorldPosition(Vector3{static_cast<float>(i), 0.0f, frame * 0.1f});
+        sim.SimulateTime(1.0f / Tests::NetworkSimulator::FramesInSecond);
+        maxDeferredUpdates = ea::max(maxDeferredUpdates, serverReplicator->GetNumDeferredUpdates(connection));
+    }
+    CHECK(maxDeferredUpdates > 0);
+
+    // Deferred updates are eventually delivered
+    sim.SimulateTime(5.0f);
+    for (unsigned i = 0; i < numNodes; ++i)
+    {
+        auto clientNode = clientScene->GetChild(Format("Node {}", i), true);
+        REQUIRE(clientNode);
+        CHECK(clientNode->GetWorldPosition().Equals(serverNodes[i]->GetWorldPosition(), 0.01f));
+    }
+}
+
+TEST_CASE("Initial state is streamed to new clients over several frames")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/SceneSynchronization/ComplexTest.prefab", CreateComplexTestPrefab);
+
+    // Setup scenes
+    const auto quality = Tests::ConnectionQuality{ 0.08f, 0.12f, 0.20f, 0, 0 };
+    auto serverScene = MakeShared<Scene>(context);
+    SharedPtr<Scene> clientScenes[] = {
+        MakeShared<Scene>(context),
+        MakeShared<Scene>(context)
+    };
+
+    static constexpr unsigned numNodes = 50;
+    ea::vector<WeakPtr<Node>> serverNodes;
+    for (unsigned i = 0; i < numNodes; ++i)
+    {
+        serverNodes.emplace_back(Tests::SpawnOnServer<BehaviorNetworkObject>(
+            serverScene, prefab, Format("Node {}", i), Vector3{static_cast<float>(i), 0.0f, 0.0f}));
+    }
+
+    // Both clients join at once and receive only a few objects per frame
+    Tests::NetworkSimulator sim(serverScene);
+    ServerReplicator* serverReplicator = serverScene->GetComponent<ReplicationManager>()->GetServerReplicator();
+    serverReplicator->SetSetting(NetworkSettings::MaxAddedObjectsPerFrame, 10);
+    for (Scene* clientScene : clientScenes)
+        sim.AddClient(clientScene, quality);
+
+    unsigned maxDeferredObjects = 0;
+    for (unsigned frame = 0; frame < 5 * Tests::NetworkSimulator::FramesInSecond; ++frame)
+    {
+        sim.SimulateTime(1.0f / Tests::NetworkSimulator::FramesInSecond);
+        for (Scene* clientScene : clientScenes)
+        {
+            AbstractConnection* connection = sim.GetServerToClientConnection(clientScene);
+            maxDeferredObjects = ea::max(maxDeferredObjects, serverReplicator->GetNumDeferredAddedObjects(connection));
+        }
+    }
+    CHECK(maxDeferredObjects == numNodes - 10);
+
+    // All objects are eventually delivered
+    for (Scene* clientScene : clientScenes)
+    {
+        for (unsigned i = 0; i < numNodes; ++i)
+        {
+            auto clientNode = clientScene->GetChild(Format("Node {}", i), true);
+            REQUIRE(clientNode);
+            CHECK(clientNode->GetWorldPosition().Equals(serverNodes[i]->GetWorldPosition(), 0.01f));
+            REQUIRE(clientNode->GetChild("Child"));
+        }
+    }
+}
@@ -34,6 +34,7 @@
 #include <Urho3D/Replica/BehaviorNetworkObject.h>
 #include <Urho3D/Replica/ReplicationManager.h>
 #include <Urho3D/Replica/TrackedAnimatedModel.h>
+#include <Urho3D/Replica/TrackedAnimatedModelManager.h>
 
 namespace
 {
@@ -92,3 +93,63 @@ TEST_CASE("TrackedAnimatedModel tracks bones on server")
     REQUIRE(trackedAnimatedModel->SampleTemporalBoneRotation(serverTime, 1) == quad1Rotation);
     REQUIRE(trackedAnimatedModel->SampleTemporalBoneRotation(serverTime, 2) == quad2Rotation);
 }
+
+TEST_CASE("TrackedAnimatedModel evaluates hitbox bones only")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto model = Tests::GetOrCreateResource<Model>(context, "@/TrackedAnimatedModel/TestModel.mdl", CreateTestAnimatedModel);
+
+    // Setup scene
+    auto serverScene = MakeShared<Scene>(context);
+
+    ea::vector<TrackedAnimatedModel*> trackedAnimatedModels;
+    ea::vector<Node*> quads;
+    for (unsigned i = 0; i < 8; ++i)
+    {
+        Node* node = serverScene->CreateChild("Node");
+        node->SetPosition({static_cast<float>(i), 0.0f, 0.0f});
+        node->CreateComponent<BehaviorNetworkObject>();
+        auto animatedModel = node->CreateComponent<AnimatedModel>();
+        animatedModel->SetModel(model);
+        auto trackedAnimatedModel = node->CreateComponent<TrackedAnimatedModel>();
+        trackedAnimatedModel->SetEvaluateBonesOnly(true);
+        trackedAnimatedModel->SetTrackHitboxBonesOnly(true);
+
+        trackedAnimatedModels.push_back(trackedAnimatedModel);
+        quads.push_back(node->GetChild("Quad 2", true));
+    }
+
+    // Animate objects forever
+    serverScene->SubscribeToEvent(serverScene, E_SCENEUPDATE,
+        [&](VariantMap& eventData)
+    {
+        const float timeStep = eventData[SceneUpdate::P_TIMESTEP].GetFloat();
+        for (Node* quad : quads)
+            quad->Translate(timeStep * Vector3::FORWARD, TS_PARENT);
+    });
+
+    // Simulate some time and remember current state
+    Tests::NetworkSimulator sim(serverScene);
+    ServerReplicator* serverReplicator = serverScene->GetComponent<ReplicationManager>()->GetServerReplicator();
+
+    sim.SimulateTime(10.0f);
+    const NetworkTime serverTime = serverReplicator->GetServerTime();
+    ea::vector<Vector3> quadPositions;
+    for (Node* quad : quads)
+        quadPositions.push_back(quad->GetWorldPosition());
+
+    auto manager = serverScene->GetComponent<TrackedAnimatedModelManager>();
+    REQUIRE(manager);
+    REQUIRE(manager->GetNumModels() == quads.size());
+
+    // Spend some more time and check that trace matches
+    sim.SimulateTime(2.0f);
+    for (unsigned i = 0; i < quads.size(); ++i)
+    {
+        REQUIRE(trackedAnimatedModels[i]->GetNumTrackedBones() == 2);
+        REQUIRE(trackedAnimatedModels[i]->SampleTemporalBonePosition(serverTime, 0) == Vector3::ZERO);
+        REQUIRE(trackedAnimatedModels[i]->SampleTemporalBonePosition(serverTime, 2).Equals(quadPositions[i]));
+    }
+}
@@ -22,7 +22,10 @@
 
 #include "../CommonUtils.h"
 #include "Urho3D/IO/MemoryBuffer.h"
+#include "Urho3D/IO/VectorBuffer.h"
 #include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/Resource/Compress.h>
+#include <Urho3D/Resource/Decompress.h>
 #include <Urho3D/Resource/Image.h>
 
 namespace Tests
@@ -98,4 +101,91 @@ TEST_CASE("DXT, ETC and PVRTC images are decompressed")
     REQUIRE(CompareImages(*imageReference, *imagePVRTC4, false) < 0.15f);
 }
 
+TEST_CASE("Images are compressed to DXT")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const auto imageReference = ReadImage(context, PNG, CF_NONE);
+    const int width = imageReference->GetWidth();
+    const int height = imageReference->GetHeight();
+
+    for (const CompressedFormat format : {CF_DXT1, CF_DXT3, CF_DXT5})
+    {
+        ByteVector blocks(GetCompressedImageSizeDXT(width, height, format));
+        CompressImageDXT(blocks.data(), imageReference->GetData(), width, height, format);
+
+        auto imageDecompressed = MakeShared<Image>(context);
+        imageDecompressed->SetSize(width, height, 4);
+        DecompressImageDXT(imageDecompressed->GetData(), blocks.data(), width, height, 1, format);
+
+        REQUIRE(CompareImages(*imageReference, *imageDecompressed, format != CF_DXT1) < 0.03f);
+    }
+}
+
+TEST_CASE("Image mip levels are generated with Kaiser filter")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const auto imageReference = ReadImage(context, PNG, CF_NONE);
+    const auto boxLevel = imageReference->GetNextLevel(ImageMipFilter::Box);
+    const auto kaiserLevel = imageReference->GetNextLevel(ImageMipFilter::Kaiser);
+
+    REQUIRE(kaiserLevel->GetSize() == IntVector3{8, 8, 1});
+    REQUIRE(CompareImages(*boxLevel, *kaiserLevel, true) < 0.1f);
+
+    auto imageSolid = MakeShared<Image>(context);
+    imageSolid->SetSize(5, 3, 4);
+    imageSolid->Clear(0x80402010_argb);
+
+    const auto solidLevel = imageSolid->GetNextLevel(ImageMipFilter::Kaiser);
+    REQUIRE(solidLevel->GetSize() == IntVector3{2, 1, 1});
+    REQUIRE(solidLevel->GetPixel(0, 0) == 0x80402010_argb);
+    REQUIRE(solidLevel->GetPixel(1, 0) == 0x80402010_argb);
+}
+
+TEST_CASE("Image decodes PNG directly into RGBA with premultiplied alpha")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const auto encodePNG = [&](unsigned components, const Color& color)
+    {
+        auto image = MakeShared<Image>(context);
+        image->SetSize(2, 2, components);
+        for (const IntVector2 index : IntRect(IntVector2::ZERO, IntVector2{2, 2}))
+            image->SetPixel(index.x_, index.y_, color);
+        VectorBuffer buffer;
+        REQUIRE(image->Save(buffer));
+        return buffer.GetBuffer();
+    };
+
+    const auto decodePNG = [&](const ByteVector& data, bool premultipliedAlpha, bool sRGB)
+    {
+        auto image = MakeShared<Image>(context);
+        image->SetDecodeToRGBA(true);
+        image->SetDecodePremultipliedAlpha(premultipliedAlpha, sRGB);
+        MemoryBuffer buffer(data);
+        REQUIRE(image->BeginLoad(buffer));
+        return image;
+    };
+
+    const Color color{1.0f, 0.2f, 0.0f, 0.2f};
+    const ByteVector rgb = encodePNG(3, color);
+    const ByteVector rgba = encodePNG(4, color);
+
+    const auto rgbImage = decodePNG(rgb, true, false);
+    REQUIRE(rgbImage->GetComponents() == 4);
+    REQUIRE(rgbImage->GetPixelInt(1, 1) == Color{1.0f, 0.2f, 0.0f, 1.0f}.ToUInt());
+
+    const auto premultipliedImage = decodePNG(rgba, true, false);
+    REQUIRE(premultipliedImage->GetComponents() == 4);
+    REQUIRE(premultipliedImage->GetPixel(1, 1).Equals(Color{0.2f, 0.04f, 0.0f, 0.2f}, 1.0f / 255.0f));
+
+    const auto premultipliedSRGBImage = decodePNG(rgba, true, true);
+    const Color expectedSRGB = (color.GammaToLinear() * color.a_).LinearToGamma();
+    REQUIRE(premultipliedSRGBImage->GetPixel(1, 1).ToVector3().Equals(expectedSRGB.ToVector3(), 2.0f / 255.0f));
+
+    const auto straightImage = decodePNG(rgba, false, false);
+    REQUIRE(straightImage->GetPixel(1, 1).Equals(color, 1.0f / 255.0f));
+}
+
 } // namespace Tests
@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Resource/JSONFile.h>
+
+using namespace Urho3D;
+
+TEST_CASE("JSONFile parses nested values directly into JSONValue")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto file = MakeShared<JSONFile>(context);
+
+    const ea::string source = R"({
+        // Comment
+        "int": -5,
+        "uint": 3000000000,
+        "double": 1.5,
+        "string": "a\nb",
+        "null": null,
+        "array": [true, false, [1, 2], {"key": "value"},],
+        "object": {"nested": {"empty": {}, "list": []}},
+    })";
+    REQUIRE(file->FromString(source));
+
+    const JSONValue& root = file->GetRoot();
+    REQUIRE(root.IsObject());
+    CHECK(root.Size() == 7);
+    CHECK(root["int"].GetInt() == -5);
+    CHECK(root["uint"].GetUInt() == 3000000000u);
+    CHECK(root["double"].GetDouble() == 1.5);
+    CHECK(root["string"].GetString() == "a\nb");
+    CHECK(root["null"].IsNull());
+
+    const JSONValue& array = root["array"];
+    REQUIRE(array.IsArray());
+    REQUIRE(array.Size() == 4);
+    CHECK(array[0].GetBool() == true);
+    CHECK(array[1].GetBool() == false);
+    CHECK(array[2].Size() == 2);
+    CHECK(array[2][1].GetInt() == 2);
+    CHECK(array[3]["key"].GetString() == "value");
+
+    const JSONValue& nested = root["object"]["nested"];
+    CHECK(nested["empty"].IsObject());
+    CHECK(nested["empty"].Size() == 0);
+    CHECK(nested["list"].IsArray());
+    CHECK(nested["list"].Size() == 0);
+}
+
+TEST_CASE("JSONFile reports parse errors and keeps the value")
+{
+    JSONValue value;
+    REQUIRE(JSONFile::ParseJSON("[1, 2, 3]", value));
+    CHECK(value.Size() == 3);
+
+    CHECK_FALSE(JSONFile::ParseJSON("[1, 2", value, false));
+    CHECK(value.Size() == 3);
+}
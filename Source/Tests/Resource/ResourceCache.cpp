@@ -22,6 +22,9 @@
 
 #include "../CommonUtils.h"
 
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/IO/MountedExternalMemory.h>
 #include <Urho3D/IO/VirtualFileSystem.h>
 #include <Urho3D/Resource/ResourceCache.h>
@@ -52,4 +55,172 @@ TEST_CASE("ResourceCache loads resources from memory")
     CHECK(xmlFile->GetRoot().GetName() == "something_else");
 }
 
+TEST_CASE("ResourceCache loads resources in background by multiple threads")
+{
+    static const unsigned numResources = 32;
+
+    const auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto resourceCache = context->GetSubsystem<ResourceCache>();
+    auto mountPoint = MakeShared<MountedExternalMemory>(context, "memory");
+    const MountPointGuard mountPointGuard(mountPoint);
+
+    const unsigned oldNumThreads = resourceCache->GetNumBackgroundLoadThreads();
+    resourceCache->SetNumBackgroundLoadThreads(4);
+    CHECK(resourceCache->GetNumBackgroundLoadThreads() == 4);
+
+    // Mounted memory is not copied, and files should be linked before loader threads start reading them
+    ea::vector<ea::string> contents(numResources);
+    for (unsigned i = 0; i < numResources; ++i)
+    {
+        contents[i] = Format("<element{}/>", i);
+        mountPoint->LinkMemory(Format("background/file{}.xml", i), contents[i]);
+    }
+
+    for (unsigned i = 0; i < numResources; ++i)
+    {
+        const ea::string resourceName = Format("memory://background/file{}.xml", i);
+        REQUIRE(resourceCache->BackgroundLoadResource<XMLFile>(resourceName, true, nullptr, static_cast<float>(i)));
+    }
+
+    // Duplicate request is ignored even with higher priority
+    CHECK_FALSE(resourceCache->BackgroundLoadResource<XMLFile>("memory://background/file0.xml", true, nullptr, 100.0f));
+
+    for (unsigned i = 0; i < numResources; ++i)
+    {
+        auto xmlFile = resourceCache->GetResource<XMLFile>(Format("memory://background/file{}.xml", i));
+        REQUIRE(xmlFile);
+        CHECK(xmlFile->GetRoot().GetName() == Format("element{}", i));
+    }
+    CHECK(resourceCache->GetNumBackgroundLoadResources() == 0);
+
+    for (unsigned i = 0; i < numResources; ++i)
+        resourceCache->ReleaseResource<XMLFile>(Format("memory://background/file{}.xml", i), true);
+    resourceCache->SetNumBackgroundLoadThreads(oldNumThreads);
+}
+
+TEST_CASE("ResourceCache finishes background resources within frame budget")
+{
+    static const unsigned numResources = 8;
+    static const unsigned maxFrames = 10000;
+
+    const auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto resourceCache = context->GetSubsystem<ResourceCache>();
+    auto mountPoint = MakeShared<MountedExternalMemory>(context, "memory");
+    const MountPointGuard mountPointGuard(mountPoint);
+
+    const unsigned long long oldBytes = resourceCache->GetFinishBackgroundResourcesBytes();
+    resourceCache->SetFinishBackgroundResourcesBytes(1);
+    CHECK(resourceCache->GetFinishBackgroundResourcesBytes() == 1);
+
+    ea::vector<ea::string> contents(numResources);
+    for (unsigned i = 0; i < numResources; ++i)
+    {
+        contents[i] = Format("<element{}/>", i);
+        mountPoint->LinkMemory(Format("budget/file{}.xml", i), contents[i]);
+    }
+
+    for (unsigned i = 0; i < numResources; ++i)
+    {
+        const ea::string resourceName = Format("memory://budget/file{}.xml", i);
+        REQUIRE(resourceCache->BackgroundLoadResource<XMLFile>(resourceName, true, nullptr, static_cast<float>(i)));
+    }
+
+    // At least one resource is finished per frame regardless of the budget
+    unsigned numFrames = 0;
+    while (resourceCache->GetNumBackgroundLoadResources() > 0 && numFrames < maxFrames)
+    {
+        resourceCache->SendEvent(E_BEGINFRAME);
+        Time::Sleep(1);
+        ++numFrames;
+    }
+    REQUIRE(resourceCache->GetNumBackgroundLoadResources() == 0);
+
+    for (unsigned i = 0; i < numResources; ++i)
+    {
+        const ea::string resourceName = Format("memory://budget/file{}.xml", i);
+        auto xmlFile = resourceCache->GetExistingResource<XMLFile>(resourceName);
+        REQUIRE(xmlFile);
+        CHECK(xmlFile->GetRoot().GetName() == Format("element{}", i));
+        resourceCache->ReleaseResource<XMLFile>(resourceName, true);
+    }
+    resourceCache->SetFinishBackgroundResourcesBytes(oldBytes);
+}
+
+TEST_CASE("ResourceCache finds existing resources from worker threads")
+{
+    static const unsigned numResources = 64;
+
+    const auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto resourceCache = context->GetSubsystem<ResourceCache>();
+    const auto workQueue = context->GetSubsystem<WorkQueue>();
+    auto mountPoint = MakeShared<MountedExternalMemory>(context, "memory");
+    const MountPointGuard mountPointGuard(mountPoint);
+
+    ea::vector<ea::string> contents(numResources);
+    for (unsigned i = 0; i < numResources; ++i)
+    {
+        const ea::string fileName = Format("concurrent/file{}.xml", i);
+        contents[i] = Format("<element{}/>", i);
+        mountPoint->LinkMemory(fileName, contents[i]);
+        REQUIRE(resourceCache->GetResource<XMLFile>("memory://" + fileName));
+    }
+
+    std::atomic<unsigned> numFound{};
+    std::atomic<unsigned> numMissing{};
+    for (unsigned i = 0; i < numResources; ++i)
+    {
+        workQueue->PostTask([&, i]()
+        {
+            const ea::string resourceName = Format("memory://concurrent/file{}.xml", i);
+            auto xmlFile = resourceCache->GetExistingResource<XMLFile>(resourceName);
+            if (xmlFile && xmlFile->GetName() == resourceName)
+                ++numFound;
+            if (!resourceCache->GetExistingResource(StringHash::Empty, "memory://concurrent/missing.xml"))
+                ++numMissing;
+        });
+    }
+    workQueue->CompleteAll();
+
+    CHECK(numFound == numResources);
+    CHECK(numMissing == numResources);
+
+    for (unsigned i = 0; i < numResources; ++i)
+    {
+        const ea::string resourceName = Format("memory://concurrent/file{}.xml", i);
+        resourceCache->ReleaseResource<XMLFile>(resourceName, true);
+        CHECK_FALSE(resourceCache->GetExistingResource<XMLFile>(resourceName));
+    }
+}
+
+TEST_CASE("ResourceCache records requested resources in order")
+{
+    const auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto resourceCache = context->GetSubsystem<ResourceCache>();
+    auto mountPoint = MakeShared<MountedExternalMemory>(context, "memory");
+    const MountPointGuard mountPointGuard(mountPoint);
+
+    mountPoint->LinkMemory("record/first.xml", "<first/>");
+    mountPoint->LinkMemory("record/second.xml", "<second/>");
+
+    // Resources requested before recording are ignored
+    REQUIRE(resourceCache->GetResource<XMLFile>("memory://record/first.xml"));
+
+    resourceCache->StartResourceRecording();
+    CHECK(resourceCache->IsRecordingResources());
+    REQUIRE(resourceCache->GetResource<XMLFile>("memory://record/second.xml"));
+    REQUIRE(resourceCache->GetResource<XMLFile>("memory://record/first.xml"));
+    REQUIRE(resourceCache->GetResource<XMLFile>("memory://record/second.xml"));
+    CHECK_FALSE(resourceCache->GetResource<XMLFile>("memory://record/missing.xml", false));
+
+    const ea::vector<ResourceRef> resources = resourceCache->StopResourceRecording();
+    CHECK_FALSE(resourceCache->IsRecordingResources());
+    REQUIRE(resources.size() == 3);
+    CHECK(resources[0] == ResourceRef{XMLFile::GetTypeStatic(), "memory://record/second.xml"});
+    CHECK(resources[1] == ResourceRef{XMLFile::GetTypeStatic(), "memory://record/first.xml"});
+    CHECK(resources[2] == ResourceRef{XMLFile::GetTypeStatic(), "memory://record/missing.xml"});
+
+    resourceCache->ReleaseResource<XMLFile>("memory://record/first.xml", true);
+    resourceCache->ReleaseResource<XMLFile>("memory://record/second.xml", true);
+}
+
 } // namespace Tests
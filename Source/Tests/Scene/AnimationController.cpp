@@ -26,6 +26,7 @@
 
 #include <Urho3D/Graphics/AnimatedModel.h>
 #include <Urho3D/Graphics/AnimationController.h>
+#include <Urho3D/Graphics/AnimationControllerManager.h>
 #include <Urho3D/Graphics/Camera.h>
 #include <Urho3D/Graphics/Octree.h>
 #include <Urho3D/Scene/Scene.h>
@@ -181,6 +182,46 @@ TEST_CASE("Animation of hierarchical AnimatedModels is stable")
         REQUIRE(positions[i].x_ == i * -0.125f);
 }
 
+TEST_CASE("Skeleton is animated in lean update mode only if bone transforms are used")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto model = Tests::GetOrCreateResource<Model>(context, "@Tests/AnimationController/SkinnedModel.mdl", CreateTestSkinnedModel);
+    auto animationTranslateX = Tests::GetOrCreateResource<Animation>(context, "@Tests/AnimationController/TranslateX.ani", CreateTestTranslateXAnimation);
+
+    auto scene = MakeShared<Scene>(context);
+    auto octree = scene->CreateComponent<Octree>();
+    octree->SetLeanUpdate(true);
+
+    Node* node = scene->CreateChild("Node");
+    auto animatedModel = node->CreateComponent<AnimatedModel>();
+    animatedModel->SetModel(model);
+    auto controller = node->CreateComponent<AnimationController>();
+    controller->Play(animationTranslateX->GetName(), 0, true);
+
+    Node* boneNode = node->GetChild("Quad 2", true);
+    REQUIRE(boneNode);
+    REQUIRE_FALSE(animatedModel->HasBoneAttachments());
+
+    // Nothing depends on the bones
+    const Vector3 bindPosition = boneNode->GetPosition();
+    Tests::RunFrame(context, 1.0f / 16, 1.0f / 64);
+    CHECK(boneNode->GetPosition() == bindPosition);
+
+    // Gameplay code reads bone transforms
+    animatedModel->SetBoneTransformsRequired(true);
+    Tests::RunFrame(context, 1.0f / 16, 1.0f / 64);
+    const Vector3 animatedPosition = boneNode->GetPosition();
+    CHECK(animatedPosition != bindPosition);
+
+    // Node is attached to the bone
+    animatedModel->SetBoneTransformsRequired(false);
+    boneNode->CreateChild("Attachment");
+    REQUIRE(animatedModel->HasBoneAttachments());
+    Tests::RunFrame(context, 1.0f / 16, 1.0f / 64);
+    CHECK(boneNode->GetPosition() != animatedPosition);
+}
+
 TEST_CASE("Animations are blended with linear interpolation")
 {
     auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
@@ -409,6 +450,67 @@ TEST_CASE("Animation track with empty name is applied to the owner node itself")
     }
 }
 
+TEST_CASE("AnimationControllerManager updates all controllers of the scene")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto animationTranslateX = Tests::GetOrCreateResource<Animation>(context, "@Tests/AnimationController/UnnamedTranslateX.ani", CreateTestUnnamedTranslateXAnimation);
+
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<Octree>();
+    auto manager = scene->CreateComponent<AnimationControllerManager>();
+
+    const unsigned numNodes = 3 * AnimationControllerManager::ParallelUpdateBucketSize;
+    ea::vector<Node*> nodes;
+    for (unsigned i = 0; i < numNodes; ++i)
+    {
+        Node* node = scene->CreateChild("Node");
+        auto animationController = node->CreateComponent<AnimationController>();
+        animationController->PlayNew(AnimationParameters{animationTranslateX}.Looped());
+        nodes.push_back(node);
+    }
+    REQUIRE(manager->GetNumControllers() == numNodes);
+
+    // Time 0.5: Translate X to -1
+    Tests::RunFrame(context, 0.5f, 0.05f);
+    for (Node* node : nodes)
+        CHECK(node->GetPosition().Equals({-1.0f, 0.0f, 0.0f}, M_LARGE_EPSILON));
+
+    // Time 1.5: Translate X to 1, controllers update themselves without the manager
+    manager->Remove();
+    Tests::RunFrame(context, 1.0f, 0.05f);
+    for (Node* node : nodes)
+        CHECK(node->GetPosition().Equals({1.0f, 0.0f, 0.0f}, M_LARGE_EPSILON));
+}
+
+TEST_CASE("AnimationController with pose caching skips unchanged animations")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto animationTranslateX = Tests::GetOrCreateResource<Animation>(context, "@Tests/AnimationController/UnnamedTranslateX.ani", CreateTestUnnamedTranslateXAnimation);
+
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<Octree>();
+
+    auto node = scene->CreateChild("Node");
+    auto animationController = node->CreateComponent<AnimationController>();
+    animationController->SetPoseCaching(true);
+    animationController->PlayNew(AnimationParameters{animationTranslateX}.Looped().Time(0.5f).Speed(0.0f));
+
+    Tests::RunFrame(context, 0.1f, 0.05f);
+    CHECK(node->GetPosition().Equals({-1.0f, 0.0f, 0.0f}, M_LARGE_EPSILON));
+
+    // Paused animation is not applied again
+    node->SetPosition(Vector3::ONE);
+    Tests::RunFrame(context, 0.1f, 0.05f);
+    CHECK(node->GetPosition().Equals(Vector3::ONE, M_LARGE_EPSILON));
+
+    // Changed animation is applied
+    animationController->UpdateAnimationTime(animationTranslateX, 1.5f);
+    Tests::RunFrame(context, 0.1f, 0.05f);
+    CHECK(node->GetPosition().Equals({1.0f, 0.0f, 0.0f}, M_LARGE_EPSILON));
+}
+
 TEST_CASE("Animation is filtered when start bone is specified")
 {
     auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Scene/LogicComponent.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+class ParallelLogicComponent : public LogicComponent
+{
+    URHO3D_OBJECT(ParallelLogicComponent, LogicComponent);
+
+public:
+    explicit ParallelLogicComponent(Context* context)
+        : LogicComponent(context)
+    {
+        SetUpdateEventMask(USE_UPDATE | USE_POSTUPDATE);
+        SetParallelUpdateEventMask(USE_UPDATE | USE_POSTUPDATE);
+    }
+
+    void DelayedStart() override { ++numDelayedStarts_; }
+
+    void Update(float timeStep) override
+    {
+        ++numUpdates_;
+        if (numUpdates_ == 2)
+        {
+            WeakPtr<Node> node{GetNode()};
+            GetScene()->DeferAction([node]()
+            {
+                if (node)
+                    node->CreateChild("Spawned");
+            });
+        }
+    }
+
+    void PostUpdate(float timeStep) override
+    {
+        ++numPostUpdates_;
+        if (numPostUpdates_ > numUpdates_)
+            invalidOrder_ = true;
+    }
+
+    unsigned numDelayedStarts_{};
+    unsigned numUpdates_{};
+    unsigned numPostUpdates_{};
+    bool invalidOrder_{};
+};
+
+}
+
+TEST_CASE("Logic components are updated in parallel phase")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto guard = Tests::MakeScopedReflection<ParallelLogicComponent>(context);
+
+    auto scene = MakeShared<Scene>(context);
+    ea::vector<ParallelLogicComponent*> components;
+    for (unsigned i = 0; i < 100; ++i)
+        components.push_back(scene->CreateChild()->CreateComponent<ParallelLogicComponent>());
+
+    scene->Update(0.1f);
+    for (ParallelLogicComponent* component : components)
+    {
+        REQUIRE(component->numDelayedStarts_ == 1);
+        REQUIRE(component->numUpdates_ == 1);
+        REQUIRE(component->numPostUpdates_ == 1);
+    }
+
+    // Disabled component is not updated
+    components[0]->SetEnabled(false);
+    scene->Update(0.1f);
+    scene->Update(0.1f);
+
+    REQUIRE(components[0]->numUpdates_ == 1);
+    REQUIRE(components[0]->GetNode()->GetNumChildren() == 0);
+    for (unsigned i = 1; i < components.size(); ++i)
+    {
+        ParallelLogicComponent* component = components[i];
+        REQUIRE(component->numDelayedStarts_ == 1);
+        REQUIRE(component->numUpdates_ == 3);
+        REQUIRE(component->numPostUpdates_ == 3);
+        REQUIRE_FALSE(component->invalidOrder_);
+        REQUIRE(component->GetNode()->GetNumChildren() == 1);
+    }
+
+    // Removed component is not updated
+    components[1]->GetNode()->Remove();
+    scene->Update(0.1f);
+    REQUIRE(components[2]->numUpdates_ == 4);
+}
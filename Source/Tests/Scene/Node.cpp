@@ -44,3 +44,55 @@ TEST_CASE("Load node from XML node file")
     CHECK(child->GetName() == "NodeName");
     CHECK(child->GetComponent<StaticModel>());
 };
+
+TEST_CASE("Nodes and components are reused from object pools")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto nodeReflection = context->GetReflection<Node>();
+    auto modelReflection = context->GetReflection<StaticModel>();
+    nodeReflection->SetObjectPoolSize(4);
+    modelReflection->SetObjectPoolSize(4);
+
+    auto scene = MakeShared<Scene>(context);
+
+    Node* child = scene->CreateChild("Child");
+    child->AddTag("Tag");
+    child->SetPosition({1.0f, 2.0f, 3.0f});
+    child->SetVar("Var", 1);
+    auto model = child->CreateComponent<StaticModel>();
+    model->SetCastShadows(true);
+
+    WeakPtr<Node> weakChild{child};
+    WeakPtr<StaticModel> weakModel{model};
+    const Node* oldChild = child;
+    const StaticModel* oldModel = model;
+
+    child->Remove();
+    CHECK(weakChild.Expired());
+    CHECK(weakModel.Expired());
+    CHECK(nodeReflection->GetNumPooledObjects() == 1);
+    CHECK(modelReflection->GetNumPooledObjects() == 1);
+
+    Node* newChild = scene->CreateChild();
+    auto newModel = newChild->CreateComponent<StaticModel>();
+    CHECK(newChild == oldChild);
+    CHECK(newModel == oldModel);
+    CHECK(nodeReflection->GetNumPooledObjects() == 0);
+    CHECK(modelReflection->GetNumPooledObjects() == 0);
+
+    CHECK(newChild->GetName().empty());
+    CHECK(newChild->GetTags().empty());
+    CHECK(newChild->GetPosition() == Vector3::ZERO);
+    CHECK(newChild->GetVars().empty());
+    CHECK(newChild->GetNumComponents() == 1);
+    CHECK(newChild->GetScene() == scene);
+    CHECK(newModel->GetNode() == newChild);
+    CHECK(newModel->GetCastShadows() == false);
+    CHECK(newModel->GetID() != 0);
+
+    scene = nullptr;
+    nodeReflection->SetObjectPoolSize(0);
+    modelReflection->SetObjectPoolSize(0);
+    CHECK(nodeReflection->GetNumPooledObjects() == 0);
+    CHECK(modelReflection->GetNumPooledObjects() == 0);
+}
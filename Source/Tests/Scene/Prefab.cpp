@@ -33,9 +33,13 @@
 #include <Urho3D/Physics/Constraint.h>
 #include <Urho3D/Physics/RigidBody.h>
 
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Scene/CookedPrefab.h>
 #include <Urho3D/Scene/PrefabReference.h>
 #include <Urho3D/Scene/PrefabReader.h>
 #include <Urho3D/Scene/PrefabResource.h>
+#include <Urho3D/Scene/PrefabTemplate.h>
 #include <Urho3D/Scene/PrefabWriter.h>
 
 namespace
@@ -126,6 +130,31 @@ NodePrefab MakeTestPrefab()
     return source;
 }
 
+/// Return copy of prefab with attribute names replaced with hashes, as stored in cooked prefab.
+NodePrefab HashAttributeNames(const NodePrefab& source)
+{
+    const auto hashNames = [](SerializablePrefab& prefab)
+    {
+        for (AttributePrefab& attribute : prefab.GetMutableAttributes())
+        {
+            if (attribute.GetIdentifierType() == AttributePrefab::IdentifierType::Name)
+            {
+                AttributePrefab hashedAttribute{attribute.GetNameHash()};
+                hashedAttribute.SetValue(attribute.GetValue());
+                attribute = ea::move(hashedAttribute);
+            }
+        }
+    };
+
+    NodePrefab result = source;
+    hashNames(result.GetMutableNode());
+    for (SerializablePrefab& component : result.GetMutableComponents())
+        hashNames(component);
+    for (NodePrefab& child : result.GetMutableChildren())
+        child = HashAttributeNames(child);
+    return result;
+}
+
 } // namespace
 
 TEST_CASE("Attribute prefab is serialized as binary")
@@ -549,6 +578,44 @@ TEST_CASE("Scene prefab is serialized")
     CHECK(dest == source);
 }
 
+TEST_CASE("Scene prefab is serialized as cooked binary")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    NodePrefab source = MakeTestPrefab();
+    source.GetMutableComponents()[0].SetTemporary(true);
+    source.GetMutableChildren()[0].GetMutableNode().GetMutableAttributes().emplace_back(AttributeId{7}).SetValue(5);
+
+    VectorBuffer buffer;
+    REQUIRE(CookedPrefab::Save(buffer, source));
+    REQUIRE(CookedPrefab::IsCooked(buffer.GetBuffer()));
+
+    const NodePrefab expected = HashAttributeNames(source);
+
+    NodePrefab dest;
+    REQUIRE(CookedPrefab::Load(context, buffer.GetBuffer(), dest));
+    CHECK(dest == expected);
+    CHECK(dest.GetComponents()[0].IsTemporary());
+    CHECK_FALSE(dest.GetComponents()[1].IsTemporary());
+
+    NodePrefab destParallel;
+    REQUIRE(CookedPrefab::Load(context, buffer.GetBuffer(), destParallel, context->GetSubsystem<WorkQueue>()));
+    CHECK(destParallel == expected);
+
+    // Cooked prefab is recognized by resource
+    auto resource = MakeShared<PrefabResource>(context);
+    MemoryBuffer resourceBuffer{buffer.GetBuffer()};
+    REQUIRE(resource->Load(resourceBuffer));
+    CHECK(resource->GetScenePrefab() == expected);
+
+    // Truncated data is rejected
+    ByteVector truncated = buffer.GetBuffer();
+    truncated.resize(truncated.size() - 3);
+    NodePrefab destTruncated;
+    CHECK_FALSE(CookedPrefab::Load(context, truncated, destTruncated));
+    CHECK(destTruncated.IsEmpty());
+}
+
 TEST_CASE("PrefabReader iterates over nodes and components")
 {
     auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
@@ -679,6 +746,78 @@ TEST_CASE("Prefab is loaded to Node")
     }
 }
 
+TEST_CASE("Prefab template is instantiated same as prefab")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto guard = Tests::MakeScopedReflection<Tests::RegisterObject<TestComponent>>(context);
+
+    const NodePrefab source = MakeTestPrefab();
+
+    PrefabTemplate prefabTemplate;
+    REQUIRE(prefabTemplate.Compile(context, source));
+    CHECK(prefabTemplate.GetNumNodes() == 7);
+
+    auto expectedScene = MakeShared<Scene>(context);
+    PrefabReaderFromMemory reader{source};
+    REQUIRE(expectedScene->CreateChild()->Load(reader));
+
+    auto actualScene = MakeShared<Scene>(context);
+    prefabTemplate.Instantiate(actualScene->CreateChild());
+
+    CHECK(actualScene->GeneratePrefab() == expectedScene->GeneratePrefab());
+    CHECK(actualScene->GetChild(0u)->GetComponent<TestComponent>()->enum_ == TestEnum::Blue);
+
+    // Unknown types are not supported by template
+    NodePrefab unknownSource = source;
+    unknownSource.GetMutableComponents()[0].SetType("UnknownComponentType");
+    CHECK_FALSE(prefabTemplate.Compile(context, unknownSource));
+    CHECK_FALSE(prefabTemplate.IsValid());
+}
+
+TEST_CASE("Prefab instances are recycled")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto guard = Tests::MakeScopedReflection<Tests::RegisterObject<TestComponent>>(context);
+
+    auto prefabResource = MakeShared<PrefabResource>(context);
+    prefabResource->GetMutableScenePrefab().GetMutableChildren().push_back(MakeTestPrefab());
+
+    auto scene = MakeShared<Scene>(context);
+    Node* node = prefabResource->Spawn(scene, Vector3{5, 0, 0});
+    REQUIRE(node);
+    CHECK(node->GetName() == "Apple");
+    CHECK(node->GetPosition() == Vector3{5, 0, 0});
+    REQUIRE(node->GetNumComponents() == 2);
+    CHECK_FALSE(node->GetComponents()[0]->IsTemporary());
+    REQUIRE(node->GetNumChildren() == 4);
+
+    // Modify instance, it should be reset when reused
+    node->SetName("Banana");
+    node->GetComponent<TestComponent>()->enum_ = TestEnum::Green;
+
+    const WeakPtr<Node> weakNode{node};
+    prefabResource->Recycle(node);
+    CHECK(weakNode);
+    CHECK(scene->GetNumChildren() == 0);
+    CHECK(prefabResource->GetPoolSize() == 1);
+
+    Node* reusedNode = prefabResource->Spawn(scene);
+    CHECK(reusedNode == weakNode);
+    CHECK(reusedNode->GetScene() == scene);
+    CHECK(reusedNode->GetName() == "Apple");
+    CHECK(reusedNode->GetPosition() == Vector3::ZERO);
+    CHECK(reusedNode->GetComponent<TestComponent>()->enum_ == TestEnum::Blue);
+    CHECK(prefabResource->GetPoolSize() == 0);
+
+    // Instance that doesn't match the prefab is not reused
+    reusedNode->CreateChild();
+    prefabResource->Recycle(reusedNode);
+    Node* newNode = prefabResource->Spawn(scene);
+    CHECK(newNode != weakNode);
+    CHECK_FALSE(weakNode);
+    CHECK(newNode->GetNumChildren() == 4);
+}
+
 TEST_CASE("PrefabWriter iterates over nodes and components")
 {
     auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
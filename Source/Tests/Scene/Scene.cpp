@@ -87,6 +87,81 @@ TEST_CASE("Scene LoadXML from old XML")
     REQUIRE(1 == scene->GetNumChildren());
 }
 
+TEST_CASE("Scene batched transform update matches lazy update")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    scene->SetBatchedTransformUpdate(true);
+
+    auto child0 = scene->CreateChild("Child_0");
+    auto child00 = child0->CreateChild("Child_0_0");
+    auto child000 = child00->CreateChild("Child_0_0_0");
+    auto child1 = scene->CreateChild("Child_1");
+    auto child10 = child1->CreateChild("Child_1_0");
+
+    child0->SetTransform({1.0f, 2.0f, 3.0f}, Quaternion{90.0f, Vector3::UP}, 2.0f);
+    child00->SetTransform({0.0f, 1.0f, 0.0f}, Quaternion{45.0f, Vector3::RIGHT}, 0.5f);
+    child000->SetPosition({3.0f, 0.0f, 0.0f});
+    child1->SetPosition({-1.0f, 0.0f, 0.0f});
+    child10->SetRotation(Quaternion{30.0f, Vector3::FORWARD});
+
+    scene->UpdateWorldTransforms();
+
+    const auto expected000 = child0->GetTransformMatrix() * child00->GetTransformMatrix() * child000->GetTransformMatrix();
+    REQUIRE_FALSE(child000->IsDirty());
+    REQUIRE(child000->GetWorldTransform().Equals(expected000));
+
+    // Reparent and move nodes, flat hierarchy should be rebuilt
+    child00->SetParent(child10);
+    child1->Translate({0.0f, 0.0f, 5.0f});
+    scene->UpdateWorldTransforms();
+
+    const auto expected000Reparented = child1->GetTransformMatrix() * child10->GetTransformMatrix()
+        * child00->GetTransformMatrix() * child000->GetTransformMatrix();
+    REQUIRE_FALSE(child0->IsDirty());
+    REQUIRE_FALSE(child10->IsDirty());
+    REQUIRE_FALSE(child000->IsDirty());
+    REQUIRE(child000->GetWorldTransform().Equals(expected000Reparented, 0.0001f));
+    REQUIRE(child000->GetWorldRotation().Equals(
+        child1->GetRotation() * child10->GetRotation() * child00->GetRotation() * child000->GetRotation(), 0.0001f));
+
+    const TransformHierarchy* hierarchy = scene->GetTransformHierarchy();
+    REQUIRE(hierarchy->GetNumNodes() == 5);
+    for (unsigned index = 0; index < hierarchy->GetNumNodes(); ++index)
+        REQUIRE(hierarchy->GetWorldTransform(index).Equals(hierarchy->GetNode(index)->GetWorldTransform()));
+}
+
+TEST_CASE("Scene component index keeps components in dense array")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+
+    auto model0 = scene->CreateChild("Child_0")->CreateComponent<StaticModel>();
+    scene->CreateComponentIndex<StaticModel>();
+    auto model1 = scene->CreateChild("Child_1")->CreateComponent<StaticModel>();
+    auto model2 = scene->CreateChild("Child_2")->CreateComponent<StaticModel>();
+
+    const SceneComponentIndex& index = scene->GetComponentIndex<StaticModel>();
+    REQUIRE(index.size() == 3);
+    REQUIRE(index.Contains(model0));
+    REQUIRE(index.Contains(model1));
+    REQUIRE(index.Contains(model2));
+
+    model0->Remove();
+    REQUIRE(index.size() == 2);
+    REQUIRE_FALSE(index.Contains(model0));
+    REQUIRE(index.GetComponents()[index.GetIndex(model1)] == model1);
+    REQUIRE(index.GetComponents()[index.GetIndex(model2)] == model2);
+
+    unsigned numModels = 0;
+    index.ForEach<StaticModel>([&](StaticModel* model) { numModels += model->GetScene() == scene; });
+    REQUIRE(numModels == 2);
+
+    model2->GetNode()->Remove();
+    REQUIRE(index.size() == 1);
+    REQUIRE(index.GetComponents()[0] == model1);
+}
+
 //TODO: Figure out how to make this test succeed
 //TEST_CASE("Scene LoadXML from incorrect XML returns false")
 //{
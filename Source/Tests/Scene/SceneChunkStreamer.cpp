@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/PrefabResource.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Scene/SceneChunkStreamer.h>
+
+TEST_CASE("Scene chunks are streamed by distance to observer")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto cache = context->GetSubsystem<ResourceCache>();
+
+    auto prefab = MakeShared<PrefabResource>(context);
+    prefab->SetName("Tests/Scene/SceneChunkStreamer.prefab");
+    NodePrefab& nodePrefab = prefab->GetMutableNodePrefab();
+    nodePrefab.GetMutableChildren().emplace_back().GetMutableNode().GetMutableAttributes().emplace_back("Name").SetValue("Tree");
+    cache->AddManualResource(prefab);
+    prefab = nullptr;
+
+    auto scene = MakeShared<Scene>(context);
+    Node* observer = scene->CreateChild("Observer");
+    Node* streamerNode = scene->CreateChild("Streamer");
+    auto streamer = streamerNode->CreateComponent<SceneChunkStreamer>();
+    streamer->SetObserver(observer);
+    streamer->SetLoadDistance(10.0f);
+    streamer->SetUnloadDistance(20.0f);
+    streamer->SetMaxInstantiationsPerFrame(1);
+    streamer->AddChunk("Tests/Scene/SceneChunkStreamer.prefab", Vector3{100.0f, 0.0f, 0.0f}, 5.0f);
+    streamer->AddChunk("Tests/Scene/SceneChunkStreamer.prefab", Vector3{110.0f, 0.0f, 0.0f}, 5.0f);
+
+    scene->Update(0.1f);
+    CHECK(streamer->GetNumLoadedChunks() == 0);
+    CHECK(streamerNode->GetNumChildren() == 0);
+
+    // Both chunks are in range, only one is attached per frame
+    observer->SetPosition(Vector3{100.0f, 0.0f, 0.0f});
+    scene->Update(0.1f);
+    CHECK(streamer->IsChunkLoaded(0));
+    CHECK_FALSE(streamer->IsChunkLoaded(1));
+
+    scene->Update(0.1f);
+    CHECK(streamer->GetNumLoadedChunks() == 2);
+    REQUIRE(streamer->GetChunkNode(0));
+    CHECK(streamer->GetChunkNode(0)->IsTemporary());
+    CHECK(streamer->GetChunkNode(0)->GetChild("Tree", true));
+
+    // Chunk between load and unload distances stays loaded
+    observer->SetPosition(Vector3{85.0f, 0.0f, 0.0f});
+    scene->Update(0.1f);
+    CHECK(streamer->IsChunkLoaded(0));
+    CHECK(streamer->IsChunkLoaded(1));
+
+    observer->SetPosition(Vector3{75.0f, 0.0f, 0.0f});
+    scene->Update(0.1f);
+    CHECK(streamer->IsChunkLoaded(0));
+    CHECK_FALSE(streamer->IsChunkLoaded(1));
+    CHECK(streamerNode->GetNumChildren() == 1);
+
+    observer->SetPosition(Vector3::ZERO);
+    scene->Update(0.1f);
+    CHECK(streamer->GetNumLoadedChunks() == 0);
+    CHECK(streamerNode->GetNumChildren() == 0);
+
+    cache->ReleaseResource<PrefabResource>("Tests/Scene/SceneChunkStreamer.prefab", true);
+}
@@ -0,0 +1,48 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Scene/ValueAnimation.h>
+
+TEST_CASE("ValueAnimation is sampled with cached key frame index")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto animation = MakeShared<ValueAnimation>(context);
+    animation->SetKeyFrame(0.0f, 0.0f);
+    animation->SetKeyFrame(1.0f, 10.0f);
+    animation->SetKeyFrame(2.0f, 30.0f);
+    animation->SetKeyFrame(3.0f, 60.0f);
+
+    unsigned keyFrameIndex = 1;
+    for (const float time : {0.0f, 0.5f, 1.5f, 2.5f, 3.0f, 0.5f, 2.0f, 1.0f})
+    {
+        const Variant cachedValue = animation->GetAnimationValue(time, keyFrameIndex);
+        CHECK(cachedValue == animation->GetAnimationValue(time));
+    }
+
+    keyFrameIndex = 100;
+    CHECK(animation->GetAnimationValue(1.5f, keyFrameIndex).GetFloat() == 20.0f);
+    CHECK(keyFrameIndex == 2);
+}
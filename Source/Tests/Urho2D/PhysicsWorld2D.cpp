@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Physics2D/CollisionBox2D.h>
+#include <Urho3D/Physics2D/CollisionCircle2D.h>
+#include <Urho3D/Physics2D/PhysicsEvents2D.h>
+#include <Urho3D/Physics2D/PhysicsWorld2D.h>
+#include <Urho3D/Physics2D/RigidBody2D.h>
+#include <Urho3D/Scene/Scene.h>
+
+using namespace Urho3D;
+
+TEST_CASE("PhysicsWorld2D sends batched contact events")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const bool perContactEvents = GENERATE(false, true);
+    auto scene = MakeShared<Scene>(context);
+    auto physicsWorld = scene->CreateComponent<PhysicsWorld2D>();
+    physicsWorld->SetPerContactEvents(perContactEvents);
+    REQUIRE(physicsWorld->GetPerContactEvents() == perContactEvents);
+
+    Node* groundNode = scene->CreateChild("Ground");
+    groundNode->CreateComponent<RigidBody2D>()->SetBodyType(BT_STATIC);
+    groundNode->CreateComponent<CollisionBox2D>()->SetSize(20.0f, 1.0f);
+
+    ea::vector<Node*> ballNodes;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        Node* ballNode = scene->CreateChild("Ball");
+        ballNode->SetPosition2D({i * 2.0f - 3.0f, 2.0f});
+        ballNode->CreateComponent<RigidBody2D>()->SetBodyType(BT_DYNAMIC);
+        ballNode->CreateComponent<CollisionCircle2D>()->SetRadius(0.5f);
+        ballNodes.push_back(ballNode);
+    }
+
+    unsigned numBatchedBeginContacts = 0;
+    unsigned numBeginContactEvents = 0;
+    scene->SubscribeToEvent(physicsWorld, E_PHYSICSCONTACTS2D, [&](VariantMap& eventData)
+    {
+        const unsigned numBeginContacts = eventData[PhysicsContacts2D::P_NUMBEGINCONTACTS].GetUInt();
+        CHECK(physicsWorld->GetBeginContacts().size() == numBeginContacts);
+        for (const PhysicsWorld2D::ContactInfo& contact : physicsWorld->GetBeginContacts())
+            CHECK((contact.bodyA_ && contact.bodyB_));
+        numBatchedBeginContacts += numBeginContacts;
+    });
+    scene->SubscribeToEvent(physicsWorld, E_PHYSICSBEGINCONTACT2D, [&](VariantMap& eventData) { ++numBeginContactEvents; });
+
+    // Balls fall on the ground
+    for (unsigned i = 0; i < 2 * 60; ++i)
+        physicsWorld->Update(1.0f / 60.0f);
+
+    CHECK(numBatchedBeginContacts == 4);
+    CHECK(numBeginContactEvents == (perContactEvents ? 4 : 0));
+    for (Node* ballNode : ballNodes)
+        CHECK(ballNode->GetPosition2D().y_ == Catch::Approx(1.0f).margin(0.05f));
+}
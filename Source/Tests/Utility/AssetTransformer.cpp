@@ -22,6 +22,9 @@
 
 #include "../CommonUtils.h"
 
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/Utility/AssetTransformerHierarchy.h>
 
 namespace
@@ -63,6 +66,39 @@ public:
     using AssetTransformer::AssetTransformer;
 };
 
+class TestFlavorAssetTransformer : public AssetTransformer
+{
+    URHO3D_OBJECT(TestFlavorAssetTransformer, AssetTransformer);
+
+public:
+    unsigned numSourceLoads_{};
+
+    using AssetTransformer::AssetTransformer;
+
+    bool IsApplicable(const AssetTransformerInput& input) override { return true; }
+
+    bool Execute(const AssetTransformerInput& input, AssetTransformerOutput& output,
+        const AssetTransformerVector& transformers) override
+    {
+        const ea::string key = "TestFlavorAssetTransformer.Source";
+        auto source = input.sharedData_ ? input.sharedData_->Get<ea::string>(key) : nullptr;
+        if (!source)
+        {
+            ++numSourceLoads_;
+            source = ea::make_shared<const ea::string>("source");
+            if (input.sharedData_)
+                input.sharedData_->Set(key, source);
+        }
+
+        auto fs = GetSubsystem<FileSystem>();
+        fs->CreateDirsRecursive(GetPath(input.outputFileName_));
+
+        File file(context_, input.outputFileName_, FILE_WRITE);
+        file.WriteString(*source + ":" + input.flavor_.ToString());
+        return true;
+    }
+};
+
 using TestVector = ea::vector<AssetTransformer*>;
 
 }
@@ -221,3 +257,63 @@ TEST_CASE("Asset transformer sorts by type")
     REQUIRE(getTransformerCandidates("foo/bar", "platform=*") == TestVector{t0, t4, t2});
     REQUIRE(getTransformerCandidates("foo/bar", "platform=mobile") == TestVector{t0, t4, t2});
 }
+
+TEST_CASE("Asset transformer input and output are serialized to bytes")
+{
+    AssetTransformerInput input{ApplicationFlavor{"platform=mobile,ios"}, "Models/Box.gltf", "/data/Models/Box.gltf", 42};
+    input = AssetTransformerInput{input, "/temp/", "/temp/Models/Box.gltf"};
+
+    const AssetTransformerInput inputCopy = AssetTransformerInput::FromBytes(input.ToBytes());
+    REQUIRE(inputCopy.flavor_.components_ == input.flavor_.components_);
+    REQUIRE(inputCopy.originalResourceName_ == input.originalResourceName_);
+    REQUIRE(inputCopy.originalInputFileName_ == input.originalInputFileName_);
+    REQUIRE(inputCopy.resourceName_ == input.resourceName_);
+    REQUIRE(inputCopy.inputFileName_ == input.inputFileName_);
+    REQUIRE(inputCopy.inputFileTime_ == input.inputFileTime_);
+    REQUIRE(inputCopy.tempPath_ == input.tempPath_);
+    REQUIRE(inputCopy.outputFileName_ == input.outputFileName_);
+
+    AssetTransformerOutput output;
+    output.sourceModified_ = true;
+    output.outputResourceNames_ = {"Models/Box.mdl", "Models/Box.xml"};
+    output.appliedTransformers_ = {"GLTFImporter"};
+    output.dependencyModificationTimes_ = {{"Models/Box.bin", 43}};
+
+    const AssetTransformerOutput outputCopy = AssetTransformerOutput::FromBytes(output.ToBytes());
+    REQUIRE(outputCopy.sourceModified_ == output.sourceModified_);
+    REQUIRE(outputCopy.outputResourceNames_ == output.outputResourceNames_);
+    REQUIRE(outputCopy.appliedTransformers_ == output.appliedTransformers_);
+    REQUIRE(outputCopy.dependencyModificationTimes_ == output.dependencyModificationTimes_);
+}
+
+TEST_CASE("Asset transformer executed for several flavors shares source data")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fs = context->GetSubsystem<FileSystem>();
+    auto transformer = MakeShared<TestFlavorAssetTransformer>(context);
+
+    const ea::string rootPath = Format("{}Urho3D-Tests-{}/", fs->GetTemporaryDir(), GenerateUUID());
+    const TemporaryDir rootPathHolder{context, rootPath};
+
+    const AssetTransformerInput input{
+        AssetTransformerInput{ApplicationFlavor::Empty, "Models/Box.txt", rootPath + "Data/Models/Box.txt", 42},
+        rootPath + "Temp/", rootPath + "Temp/Models/Box.txt"};
+
+    const ea::vector<AssetTransformerFlavorTarget> targets{
+        {ApplicationFlavor{"platform=desktop"}, {transformer}, rootPath + "Cache-desktop/"},
+        {ApplicationFlavor{"platform=mobile"}, {transformer}, rootPath + "Cache-mobile/"},
+    };
+
+    ea::vector<AssetTransformerOutput> outputs;
+    REQUIRE(AssetTransformer::ExecuteTransformersAndStore(input, targets, outputs));
+    REQUIRE(transformer->numSourceLoads_ == 1);
+
+    REQUIRE(outputs.size() == 2);
+    REQUIRE(outputs[0].outputResourceNames_ == StringVector{"Models/Box.txt"});
+    REQUIRE(outputs[1].outputResourceNames_ == StringVector{"Models/Box.txt"});
+
+    File desktopFile(context, rootPath + "Cache-desktop/Models/Box.txt");
+    File mobileFile(context, rootPath + "Cache-mobile/Models/Box.txt");
+    REQUIRE(desktopFile.ReadString() == "source:platform=desktop");
+    REQUIRE(mobileFile.ReadString() == "source:platform=mobile");
+}
@@ -0,0 +1,46 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Resource/JSONFile.h>
+#include <Urho3D/Utility/ShaderCooker.h>
+
+TEST_CASE("Shader variation list is serialized without duplicates")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    ShaderVariationList source;
+    source.Add({"Shaders/GLSL/v2/M_Lit.glsl", VS, "GEOM_STATIC"});
+    source.Add({"Shaders/GLSL/v2/M_Lit.glsl", PS, "GEOM_STATIC"});
+    source.Add({"Shaders/GLSL/v2/M_Lit.glsl", VS, "GEOM_STATIC"});
+    source.Add({"Shaders/GLSL/v2/M_Unlit.glsl", VS, ""});
+    REQUIRE(source.variations_.size() == 3);
+
+    JSONFile file(context);
+    REQUIRE(file.SaveObject("shaderVariations", source));
+
+    ShaderVariationList dest;
+    REQUIRE(file.LoadObject("shaderVariations", dest));
+    CHECK(dest.variations_ == source.variations_);
+}
@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Utility/TextureAtlasPacker.h>
+
+namespace
+{
+
+TextureAtlasSprite MakeSprite(int width, int height)
+{
+    TextureAtlasSprite sprite;
+    sprite.size_ = {width, height};
+    sprite.frameSize_ = sprite.size_;
+    return sprite;
+}
+
+bool IsOverlapping(const IntRect& lhs, const IntRect& rhs)
+{
+    return lhs.left_ < rhs.right_ && rhs.left_ < lhs.right_ && lhs.top_ < rhs.bottom_ && rhs.top_ < lhs.bottom_;
+}
+
+}
+
+TEST_CASE("TextureAtlasPacker packs sprites without overlap")
+{
+    ea::vector<TextureAtlasSprite> sprites;
+    for (int i = 0; i < 40; ++i)
+        sprites.push_back(MakeSprite(5 + (i * 7) % 29, 3 + (i * 11) % 37));
+
+    const int padding = 1;
+    const int alignment = 4;
+    IntVector2 atlasSize;
+    REQUIRE(TextureAtlasPacker::PackSprites(sprites, 1024, padding, alignment, atlasSize));
+    REQUIRE(IsPowerOfTwo(atlasSize.x_));
+    REQUIRE(IsPowerOfTwo(atlasSize.y_));
+
+    for (unsigned i = 0; i < sprites.size(); ++i)
+    {
+        const TextureAtlasSprite& sprite = sprites[i];
+        const IntRect rect{sprite.position_, sprite.position_ + sprite.size_ + IntVector2::ONE * padding};
+        CHECK(sprite.position_.x_ % alignment == 0);
+        CHECK(sprite.position_.y_ % alignment == 0);
+        CHECK(rect.left_ >= 0);
+        CHECK(rect.top_ >= 0);
+        CHECK(rect.right_ <= atlasSize.x_);
+        CHECK(rect.bottom_ <= atlasSize.y_);
+
+        for (unsigned j = i + 1; j < sprites.size(); ++j)
+        {
+            const TextureAtlasSprite& other = sprites[j];
+            const IntRect otherRect{other.position_, other.position_ + other.size_ + IntVector2::ONE * padding};
+            CHECK_FALSE(IsOverlapping(rect, otherRect));
+        }
+    }
+}
+
+TEST_CASE("TextureAtlasPacker chooses the smallest atlas")
+{
+    ea::vector<TextureAtlasSprite> sprites;
+    for (int i = 0; i < 4; ++i)
+        sprites.push_back(MakeSprite(16, 16));
+
+    IntVector2 atlasSize;
+    REQUIRE(TextureAtlasPacker::PackSprites(sprites, 1024, 0, 4, atlasSize));
+    CHECK(atlasSize == IntVector2(32, 32));
+
+    sprites.push_back(MakeSprite(2000, 16));
+    CHECK_FALSE(TextureAtlasPacker::PackSprites(sprites, 1024, 0, 4, atlasSize));
+}
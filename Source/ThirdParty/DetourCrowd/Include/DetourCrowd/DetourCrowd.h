@@ -204,11 +204,27 @@ struct dtCrowdAgentDebugInfo
 /// Type for the update callback.
 typedef void (*dtUpdateCallback)(bool positionUpdate, dtCrowdAgent* agent, float* pos, float dt);
 
+// Urho3D: Add parallel update support
+/// Type for the function that processes agents in range [begin, end) from the thread with given index.
+typedef void (*dtCrowdRangeCallback)(void* context, int begin, int end, int threadIndex);
+/// Type for the function that splits range [0, count) between threads, invokes the callback and waits for completion.
+typedef void (*dtParallelForCallback)(void* userData, int count, dtCrowdRangeCallback callback, void* context);
+
 /// Provides local steering behaviors for a group of agents. 
 /// @ingroup crowd
 class dtCrowd
 {
 	dtUpdateCallback m_updateCallback; // Urho3D
+	// Urho3D: Add parallel update support
+	dtParallelForCallback m_parallelFor;
+	void* m_parallelForUserData;
+	int m_maxThreads;
+	dtNavMeshQuery** m_threadNavQueries;
+	dtObstacleAvoidanceQuery** m_threadObstacleQueries;
+	int* m_threadSampleCounts;
+	int m_updateNumAgents;
+	dtCrowdAgentDebugInfo* m_updateDebug;
+	int m_updateDebugIdx;
 	int m_maxAgents;
 	dtCrowdAgent* m_agents;
 	dtCrowdAgent** m_activeAgents;
@@ -242,6 +258,13 @@ class dtCrowd
 
 	bool requestMoveTargetReplan(const int idx, dtPolyRef ref, const float* pos);
 
+	// Urho3D: Add parallel update support
+	void parallelFor(const int count, dtCrowdRangeCallback callback);
+	void freeThreadQueries();
+	static void updateNeighboursRange(void* context, int begin, int end, int threadIndex);
+	static void updateCornersRange(void* context, int begin, int end, int threadIndex);
+	static void planVelocityRange(void* context, int begin, int end, int threadIndex);
+
 	void purge();
 	
 public:
@@ -256,6 +279,15 @@ public:
 	/// @return True if the initialization succeeded.
 	bool init(const int maxAgents, const float maxAgentRadius, dtNavMesh* nav, dtUpdateCallback cb = 0);
 	
+	// Urho3D: Add parallel update support
+	/// Enables parallel update of independent per-agent steps: neighbour and corner queries, velocity planning.
+	/// Should be called after init. Each thread gets its own navigation mesh and obstacle avoidance queries.
+	///  @param[in]		callback		The function that executes the range in parallel, or null to disable.
+	///  @param[in]		userData		User data passed to the callback.
+	///  @param[in]		maxThreads		The maximum number of threads. Thread indices are in range [0, maxThreads).
+	/// @return True if the per-thread queries were initialized.
+	bool setParallelFor(dtParallelForCallback callback, void* userData, const int maxThreads);
+
 	/// Sets the shared avoidance configuration for the specified index.
 	///  @param[in]		idx		The index. [Limits: 0 <= value < #DT_CROWD_MAX_OBSTAVOIDANCE_PARAMS]
 	///  @param[in]		params	The new configuration.
@@ -333,6 +333,15 @@ Notes:
 
 dtCrowd::dtCrowd() :
 	m_updateCallback(0), // Urho3D: Add update callback support
+	m_parallelFor(0), // Urho3D: Add parallel update support
+	m_parallelForUserData(0),
+	m_maxThreads(0),
+	m_threadNavQueries(0),
+	m_threadObstacleQueries(0),
+	m_threadSampleCounts(0),
+	m_updateNumAgents(0),
+	m_updateDebug(0),
+	m_updateDebugIdx(-1),
 	m_maxAgents(0),
 	m_agents(0),
 	m_activeAgents(0),
@@ -357,6 +366,8 @@ dtCrowd::~dtCrowd()
 
 void dtCrowd::purge()
 {
+	freeThreadQueries(); // Urho3D: Add parallel update support
+
 	for (int i = 0; i < m_maxAgents; ++i)
 		m_agents[i].~dtCrowdAgent();
 	dtFree(m_agents);
@@ -470,6 +481,233 @@ bool dtCrowd::init(const int maxAgents, const float maxAgentRadius, dtNavMesh* n
 	return true;
 }
 
+// Urho3D: Add parallel update support
+bool dtCrowd::setParallelFor(dtParallelForCallback callback, void* userData, const int maxThreads)
+{
+	freeThreadQueries();
+	if (!callback || maxThreads <= 1 || !m_navquery)
+		return true;
+
+	m_threadNavQueries = (dtNavMeshQuery**)dtAlloc(sizeof(dtNavMeshQuery*)*maxThreads, DT_ALLOC_PERM);
+	m_threadObstacleQueries = (dtObstacleAvoidanceQuery**)dtAlloc(sizeof(dtObstacleAvoidanceQuery*)*maxThreads, DT_ALLOC_PERM);
+	m_threadSampleCounts = (int*)dtAlloc(sizeof(int)*maxThreads, DT_ALLOC_PERM);
+	if (!m_threadNavQueries || !m_threadObstacleQueries || !m_threadSampleCounts)
+	{
+		freeThreadQueries();
+		return false;
+	}
+	m_maxThreads = maxThreads;
+
+	// The first thread reuses the queries of the crowd
+	m_threadNavQueries[0] = m_navquery;
+	m_threadObstacleQueries[0] = m_obstacleQuery;
+	for (int i = 1; i < maxThreads; ++i)
+	{
+		m_threadNavQueries[i] = 0;
+		m_threadObstacleQueries[i] = 0;
+	}
+
+	const dtNavMesh* nav = m_navquery->getAttachedNavMesh();
+	for (int i = 1; i < maxThreads; ++i)
+	{
+		m_threadNavQueries[i] = dtAllocNavMeshQuery();
+		m_threadObstacleQueries[i] = dtAllocObstacleAvoidanceQuery();
+		if (!m_threadNavQueries[i] || dtStatusFailed(m_threadNavQueries[i]->init(nav, MAX_COMMON_NODES)) ||
+			!m_threadObstacleQueries[i] || !m_threadObstacleQueries[i]->init(6, 8))
+		{
+			freeThreadQueries();
+			return false;
+		}
+	}
+
+	m_parallelFor = callback;
+	m_parallelForUserData = userData;
+	return true;
+}
+
+void dtCrowd::freeThreadQueries()
+{
+	for (int i = 1; i < m_maxThreads; ++i)
+	{
+		if (m_threadNavQueries)
+			dtFreeNavMeshQuery(m_threadNavQueries[i]);
+		if (m_threadObstacleQueries)
+			dtFreeObstacleAvoidanceQuery(m_threadObstacleQueries[i]);
+	}
+	dtFree(m_threadNavQueries);
+	m_threadNavQueries = 0;
+	dtFree(m_threadObstacleQueries);
+	m_threadObstacleQueries = 0;
+	dtFree(m_threadSampleCounts);
+	m_threadSampleCounts = 0;
+
+	m_maxThreads = 0;
+	m_parallelFor = 0;
+	m_parallelForUserData = 0;
+}
+
+void dtCrowd::parallelFor(const int count, dtCrowdRangeCallback callback)
+{
+	if (m_parallelFor)
+		m_parallelFor(m_parallelForUserData, count, callback, this);
+	else
+		callback(this, 0, count, 0);
+}
+
+void dtCrowd::updateNeighboursRange(void* context, int begin, int end, int threadIndex)
+{
+	dtCrowd* crowd = (dtCrowd*)context;
+	dtNavMeshQuery* navquery = crowd->m_threadNavQueries ? crowd->m_threadNavQueries[threadIndex] : crowd->m_navquery;
+	dtCrowdAgent** agents = crowd->m_activeAgents;
+	const int nagents = crowd->m_updateNumAgents;
+
+	for (int i = begin; i < end; ++i)
+	{
+		dtCrowdAgent* ag = agents[i];
+		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+			continue;
+
+		const dtQueryFilter* filter = &crowd->m_filters[ag->params.queryFilterType];
+
+		// Update the collision boundary after certain distance has been passed or
+		// if it has become invalid.
+		const float updateThr = ag->params.collisionQueryRange*0.25f;
+		if (dtVdist2DSqr(ag->npos, ag->boundary.getCenter()) > dtSqr(updateThr) ||
+			!ag->boundary.isValid(navquery, filter))
+		{
+			ag->boundary.update(ag->corridor.getFirstPoly(), ag->npos, ag->params.collisionQueryRange,
+								navquery, filter);
+		}
+		// Query neighbour agents
+		ag->nneis = getNeighbours(ag->npos, ag->params.height, ag->params.collisionQueryRange,
+								  ag, ag->neis, DT_CROWDAGENT_MAX_NEIGHBOURS,
+								  agents, nagents, crowd->m_grid);
+		for (int j = 0; j < ag->nneis; j++)
+			ag->neis[j].idx = crowd->getAgentIndex(agents[ag->neis[j].idx]);
+	}
+}
+
+void dtCrowd::updateCornersRange(void* context, int begin, int end, int threadIndex)
+{
+	dtCrowd* crowd = (dtCrowd*)context;
+	dtNavMeshQuery* navquery = crowd->m_threadNavQueries ? crowd->m_threadNavQueries[threadIndex] : crowd->m_navquery;
+	dtCrowdAgent** agents = crowd->m_activeAgents;
+	dtCrowdAgentDebugInfo* debug = crowd->m_updateDebug;
+	const int debugIdx = crowd->m_updateDebugIdx;
+
+	for (int i = begin; i < end; ++i)
+	{
+		dtCrowdAgent* ag = agents[i];
+		
+		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+			continue;
+		if (ag->targetState == DT_CROWDAGENT_TARGET_NONE || ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
+			continue;
+
+		const dtQueryFilter* filter = &crowd->m_filters[ag->params.queryFilterType];
+		
+		// Find corners for steering
+		ag->ncorners = ag->corridor.findCorners(ag->cornerVerts, ag->cornerFlags, ag->cornerPolys,
+												DT_CROWDAGENT_MAX_CORNERS, navquery, filter);
+		
+		// Check to see if the corner after the next corner is directly visible,
+		// and short cut to there.
+		if ((ag->params.updateFlags & DT_CROWD_OPTIMIZE_VIS) && ag->ncorners > 0)
+		{
+			const float* target = &ag->cornerVerts[dtMin(1,ag->ncorners-1)*3];
+			ag->corridor.optimizePathVisibility(target, ag->params.pathOptimizationRange, navquery, filter);
+			
+			// Copy data for debug purposes.
+			if (debugIdx == i)
+			{
+				dtVcopy(debug->optStart, ag->corridor.getPos());
+				dtVcopy(debug->optEnd, target);
+			}
+		}
+		else
+		{
+			// Copy data for debug purposes.
+			if (debugIdx == i)
+			{
+				dtVset(debug->optStart, 0,0,0);
+				dtVset(debug->optEnd, 0,0,0);
+			}
+		}
+	}
+}
+
+void dtCrowd::planVelocityRange(void* context, int begin, int end, int threadIndex)
+{
+	dtCrowd* crowd = (dtCrowd*)context;
+	dtObstacleAvoidanceQuery* obstacleQuery =
+		crowd->m_threadObstacleQueries ? crowd->m_threadObstacleQueries[threadIndex] : crowd->m_obstacleQuery;
+	dtCrowdAgent** agents = crowd->m_activeAgents;
+	dtCrowdAgentDebugInfo* debug = crowd->m_updateDebug;
+	const int debugIdx = crowd->m_updateDebugIdx;
+
+	int sampleCount = 0;
+	for (int i = begin; i < end; ++i)
+	{
+		dtCrowdAgent* ag = agents[i];
+		
+		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+			continue;
+		
+		if (ag->params.updateFlags & DT_CROWD_OBSTACLE_AVOIDANCE)
+		{
+			obstacleQuery->reset();
+			
+			// Add neighbours as obstacles.
+			for (int j = 0; j < ag->nneis; ++j)
+			{
+				const dtCrowdAgent* nei = &crowd->m_agents[ag->neis[j].idx];
+				obstacleQuery->addCircle(nei->npos, nei->params.radius, nei->vel, nei->dvel);
+			}
+
+			// Append neighbour segments as obstacles.
+			for (int j = 0; j < ag->boundary.getSegmentCount(); ++j)
+			{
+				const float* s = ag->boundary.getSegment(j);
+				if (dtTriArea2D(ag->npos, s, s+3) < 0.0f)
+					continue;
+				obstacleQuery->addSegment(s, s+3);
+			}
+
+			dtObstacleAvoidanceDebugData* vod = 0;
+			if (debugIdx == i) 
+				vod = debug->vod;
+			
+			// Sample new safe velocity.
+			bool adaptive = true;
+			int ns = 0;
+
+			const dtObstacleAvoidanceParams* params = &crowd->m_obstacleQueryParams[ag->params.obstacleAvoidanceType];
+				
+			if (adaptive)
+			{
+				ns = obstacleQuery->sampleVelocityAdaptive(ag->npos, ag->params.radius, ag->desiredSpeed,
+														   ag->vel, ag->dvel, ag->nvel, params, vod);
+			}
+			else
+			{
+				ns = obstacleQuery->sampleVelocityGrid(ag->npos, ag->params.radius, ag->desiredSpeed,
+													   ag->vel, ag->dvel, ag->nvel, params, vod);
+			}
+			sampleCount += ns;
+		}
+		else
+		{
+			// If not using velocity planning, new velocity is directly the desired velocity.
+			dtVcopy(ag->nvel, ag->dvel);
+		}
+	}
+
+	if (crowd->m_threadSampleCounts)
+		crowd->m_threadSampleCounts[threadIndex] += sampleCount;
+	else
+		crowd->m_velocitySampleCount += sampleCount;
+}
+
 void dtCrowd::setObstacleAvoidanceParams(const int idx, const dtObstacleAvoidanceParams* params)
 {
 	if (idx >= 0 && idx < DT_CROWD_MAX_OBSTAVOIDANCE_PARAMS)
@@ -1083,68 +1321,16 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 		m_grid->addItem((unsigned short)i, p[0]-r, p[2]-r, p[0]+r, p[2]+r);
 	}
 	
-	// Get nearby navmesh segments and agents to collide with.
-	for (int i = 0; i < nagents; ++i)
-	{
-		dtCrowdAgent* ag = agents[i];
-		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
+	// Urho3D: Add parallel update support
+	m_updateNumAgents = nagents;
+	m_updateDebug = debug;
+	m_updateDebugIdx = debugIdx;
 
-		// Update the collision boundary after certain distance has been passed or
-		// if it has become invalid.
-		const float updateThr = ag->params.collisionQueryRange*0.25f;
-		if (dtVdist2DSqr(ag->npos, ag->boundary.getCenter()) > dtSqr(updateThr) ||
-			!ag->boundary.isValid(m_navquery, &m_filters[ag->params.queryFilterType]))
-		{
-			ag->boundary.update(ag->corridor.getFirstPoly(), ag->npos, ag->params.collisionQueryRange,
-								m_navquery, &m_filters[ag->params.queryFilterType]);
-		}
-		// Query neighbour agents
-		ag->nneis = getNeighbours(ag->npos, ag->params.height, ag->params.collisionQueryRange,
-								  ag, ag->neis, DT_CROWDAGENT_MAX_NEIGHBOURS,
-								  agents, nagents, m_grid);
-		for (int j = 0; j < ag->nneis; j++)
-			ag->neis[j].idx = getAgentIndex(agents[ag->neis[j].idx]);
-	}
+	// Get nearby navmesh segments and agents to collide with.
+	parallelFor(nagents, updateNeighboursRange);
 	
 	// Find next corner to steer to.
-	for (int i = 0; i < nagents; ++i)
-	{
-		dtCrowdAgent* ag = agents[i];
-		
-		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
-		if (ag->targetState == DT_CROWDAGENT_TARGET_NONE || ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
-			continue;
-		
-		// Find corners for steering
-		ag->ncorners = ag->corridor.findCorners(ag->cornerVerts, ag->cornerFlags, ag->cornerPolys,
-												DT_CROWDAGENT_MAX_CORNERS, m_navquery, &m_filters[ag->params.queryFilterType]);
-		
-		// Check to see if the corner after the next corner is directly visible,
-		// and short cut to there.
-		if ((ag->params.updateFlags & DT_CROWD_OPTIMIZE_VIS) && ag->ncorners > 0)
-		{
-			const float* target = &ag->cornerVerts[dtMin(1,ag->ncorners-1)*3];
-			ag->corridor.optimizePathVisibility(target, ag->params.pathOptimizationRange, m_navquery, &m_filters[ag->params.queryFilterType]);
-			
-			// Copy data for debug purposes.
-			if (debugIdx == i)
-			{
-				dtVcopy(debug->optStart, ag->corridor.getPos());
-				dtVcopy(debug->optEnd, target);
-			}
-		}
-		else
-		{
-			// Copy data for debug purposes.
-			if (debugIdx == i)
-			{
-				dtVset(debug->optStart, 0,0,0);
-				dtVset(debug->optEnd, 0,0,0);
-			}
-		}
-	}
+	parallelFor(nagents, updateCornersRange);
 	
 	// Trigger off-mesh connections (depends on corners).
 	for (int i = 0; i < nagents; ++i)
@@ -1270,61 +1456,19 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 		dtVcopy(ag->dvel, dvel);
 	}
 	
-	// Velocity planning.	
-	for (int i = 0; i < nagents; ++i)
+	// Velocity planning.
+	if (m_threadSampleCounts)
 	{
-		dtCrowdAgent* ag = agents[i];
-		
-		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
-		
-		if (ag->params.updateFlags & DT_CROWD_OBSTACLE_AVOIDANCE)
-		{
-			m_obstacleQuery->reset();
-			
-			// Add neighbours as obstacles.
-			for (int j = 0; j < ag->nneis; ++j)
-			{
-				const dtCrowdAgent* nei = &m_agents[ag->neis[j].idx];
-				m_obstacleQuery->addCircle(nei->npos, nei->params.radius, nei->vel, nei->dvel);
-			}
-
-			// Append neighbour segments as obstacles.
-			for (int j = 0; j < ag->boundary.getSegmentCount(); ++j)
-			{
-				const float* s = ag->boundary.getSegment(j);
-				if (dtTriArea2D(ag->npos, s, s+3) < 0.0f)
-					continue;
-				m_obstacleQuery->addSegment(s, s+3);
-			}
+		for (int i = 0; i < m_maxThreads; ++i)
+			m_threadSampleCounts[i] = 0;
+	}
 
-			dtObstacleAvoidanceDebugData* vod = 0;
-			if (debugIdx == i) 
-				vod = debug->vod;
-			
-			// Sample new safe velocity.
-			bool adaptive = true;
-			int ns = 0;
+	parallelFor(nagents, planVelocityRange);
 
-			const dtObstacleAvoidanceParams* params = &m_obstacleQueryParams[ag->params.obstacleAvoidanceType];
-				
-			if (adaptive)
-			{
-				ns = m_obstacleQuery->sampleVelocityAdaptive(ag->npos, ag->params.radius, ag->desiredSpeed,
-															 ag->vel, ag->dvel, ag->nvel, params, vod);
-			}
-			else
-			{
-				ns = m_obstacleQuery->sampleVelocityGrid(ag->npos, ag->params.radius, ag->desiredSpeed,
-														 ag->vel, ag->dvel, ag->nvel, params, vod);
-			}
-			m_velocitySampleCount += ns;
-		}
-		else
-		{
-			// If not using velocity planning, new velocity is directly the desired velocity.
-			dtVcopy(ag->nvel, ag->dvel);
-		}
+	if (m_threadSampleCounts)
+	{
+		for (int i = 0; i < m_maxThreads; ++i)
+			m_velocitySampleCount += m_threadSampleCounts[i];
 	}
 
 	// Integrate.
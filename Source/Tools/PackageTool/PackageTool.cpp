@@ -24,15 +24,21 @@
 
 #include <Urho3D/Core/Context.h>
 #include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/IO/ContentHash.h>
 #include <Urho3D/IO/File.h>
 #include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/MountPoint.h>
 #include <Urho3D/IO/PackageFile.h>
+#include <Urho3D/IO/VectorBuffer.h>
 
 #ifdef WIN32
 #include <windows.h>
 #endif
 
 #include <EASTL/unique_ptr.h>
+#include <EASTL/unordered_map.h>
 #include <LZ4/lz4.h>
 #include <LZ4/lz4hc.h>
 
@@ -42,6 +48,29 @@
 using namespace Urho3D;
 
 static const unsigned COMPRESSED_BLOCK_SIZE = 32768;
+static const unsigned MAX_BATCH_SIZE = 256 * 1024 * 1024;
+
+/// Files are considered identical if they have the same size and hashes.
+struct ContentKey
+{
+    unsigned long long hash_{};
+    unsigned size_{};
+    unsigned checksum_{};
+
+    bool operator==(const ContentKey& rhs) const
+    {
+        return hash_ == rhs.hash_ && size_ == rhs.size_ && checksum_ == rhs.checksum_;
+    }
+
+    unsigned ToHash() const
+    {
+        unsigned result = 0;
+        CombineHash(result, MakeHash(hash_));
+        CombineHash(result, size_);
+        CombineHash(result, checksum_);
+        return result;
+    }
+};
 
 struct FileEntry
 {
@@ -49,6 +78,20 @@ struct FileEntry
     unsigned offset_{};
     unsigned size_{};
     unsigned checksum_{};
+    PackageCompression compression_{};
+    ContentKey contentKey_;
+};
+
+struct PackedEntry
+{
+    /// Error message if the file cannot be read.
+    ea::string error_;
+    /// Index of the entry with the same content, if any.
+    unsigned duplicateOf_{M_MAX_UNSIGNED};
+    ByteVector data_;
+    ea::vector<ByteVector> packedBlocks_;
+    /// Block offset table and blocks. Empty if the file is stored uncompressed.
+    ByteVector packedData_;
 };
 
 Context* context_ = nullptr;
@@ -59,6 +102,7 @@ unsigned checksum_ = 0;
 bool compress_ = false;
 bool quiet_ = false;
 unsigned blockSize_ = COMPRESSED_BLOCK_SIZE;
+unsigned numThreads_ = M_MAX_UNSIGNED;
 
 ea::string ignoreExtensions_[] = {
     ".bak",
@@ -69,12 +113,18 @@ int main(int argc, char** argv);
 void Run(const ea::vector<ea::string>& arguments);
 void ProcessFile(const ea::string& fileName, const ea::string& rootDir);
 void WritePackageFile(const ea::string& fileName, const ea::string& rootDir);
-void WriteHeader(File& dest);
+void WriteHeader(File& dest, long long fileListOffset);
+void WriteFileList(File& dest);
+void ReadEntry(FileEntry& entry, const ea::string& rootDir, PackedEntry& result);
+void CompressEntries(ea::vector<PackedEntry>& batch);
+void AssembleBlocks(PackedEntry& entry);
+unsigned CombineChecksums(unsigned firstChecksum, unsigned secondChecksum, unsigned secondSize);
 
 int main(int argc, char** argv)
 {
     SharedPtr<Context> context(new Context());
     SharedPtr<FileSystem> fileSystem(new FileSystem(context));
+    context->RegisterSubsystem(new WorkQueue(context));
     ea::vector<ea::string> arguments;
     context_ = context;
     fileSystem_ = fileSystem;
@@ -96,8 +146,9 @@ void Run(const ea::vector<ea::string>& arguments)
             "Usage: PackageTool <directory to process> <package name> [basepath] [options]\n"
             "\n"
             "Options:\n"
-            "-c      Enable package file LZ4 compression\n"
+            "-c      Enable package file LZ4 compression. Compressed entries are indexed by blocks for fast seeking\n"
             "-q      Enable quiet mode\n"
+            "-jN     Use N threads to read and compress files, all logical CPUs are used by default\n"
             "\n"
             "Basepath is an optional prefix that will be added to the file entries.\n\n"
             "Alternative output usage: PackageTool <output option> <package name>\n"
@@ -128,6 +179,11 @@ void Run(const ea::vector<ea::string>& arguments)
                     case 'q':
                         quiet_ = true;
                         break;
+                    case 'j':
+                        numThreads_ = ToUInt(arguments[i].substr(2));
+                        if (numThreads_ == 0)
+                            ErrorExit("Invalid number of threads");
+                        break;
                     default:
                         ErrorExit("Unrecognized option");
                     }
@@ -192,6 +248,10 @@ void Run(const ea::vector<ea::string>& arguments)
         for (unsigned i = 0; i < fileNames.size(); ++i)
             ProcessFile(fileNames[i], dirName);
 
+        // Main thread takes part in processing too
+        const unsigned numThreads = numThreads_ != M_MAX_UNSIGNED ? numThreads_ : ea::max(GetNumLogicalCPUs(), 1u);
+        context_->GetSubsystem<WorkQueue>()->Initialize(numThreads - 1);
+
         WritePackageFile(packageName, dirName);
     }
     else
@@ -206,6 +266,9 @@ void Run(const ea::vector<ea::string>& arguments)
             PrintLine("Package size: " + ea::to_string(packageFile->GetTotalSize()));
             PrintLine("Checksum: " + ea::to_string(packageFile->GetChecksum()));
             PrintLine("Compressed: " + ea::string(packageFile->IsCompressed() ? "yes" : "no"));
+            PrintLine("Version: " + ea::to_string(packageFile->GetVersion()));
+            if (packageFile->HasBlockIndex())
+                PrintLine("Block size: " + ea::to_string(packageFile->GetBlockSize()));
             break;
         case 'L':
             if (!packageFile->IsCompressed())
@@ -261,117 +324,254 @@ void WritePackageFile(const ea::string& fileName, const ea::string& rootDir)
     if (!dest.Open(fileName, FILE_WRITE))
         ErrorExit("Could not open output file " + fileName);
 
-    // Write ID, number of files & placeholder for checksum
-    WriteHeader(dest);
-
-    for (unsigned i = 0; i < entries_.size(); ++i)
-    {
-        // Write entry (correct offset is still unknown, will be filled in later)
-        dest.WriteString(basePath_ + entries_[i].name_);
-        dest.WriteUInt(entries_[i].offset_);
-        dest.WriteUInt(entries_[i].size_);
-        dest.WriteUInt(entries_[i].checksum_);
-    }
+    // Write ID, number of files & placeholders for checksum and file list offset
+    WriteHeader(dest, 0);
 
     unsigned totalDataSize = 0;
-    unsigned lastOffset;
+    unsigned numDuplicates = 0;
+    ea::unordered_map<ContentKey, unsigned> uniqueEntries;
 
-    // Write file data, calculate checksums & correct offsets
-    for (unsigned i = 0; i < entries_.size(); ++i)
+    // Files are read and compressed in parallel by batches of limited size. All the output is written
+    // in the order of entries, so the package is the same for the same input regardless of thread timings.
+    auto workQueue = context_->GetSubsystem<WorkQueue>();
+    for (unsigned batchBegin = 0; batchBegin < entries_.size();)
     {
-        lastOffset = entries_[i].offset_ = dest.GetSize();
-        ea::string fileFullPath = rootDir + "/" + entries_[i].name_;
-
-        File srcFile(context_, fileFullPath);
-        if (!srcFile.IsOpen())
-            ErrorExit("Could not open file " + fileFullPath);
-
-        unsigned dataSize = entries_[i].size_;
-        totalDataSize += dataSize;
-        ea::unique_ptr<unsigned char[]> buffer(new unsigned char[dataSize]);
-
-        if (srcFile.Read(&buffer[0], dataSize) != dataSize)
-            ErrorExit("Could not read file " + fileFullPath);
-        srcFile.Close();
-
-        for (unsigned j = 0; j < dataSize; ++j)
+        unsigned batchEnd = batchBegin + 1;
+        unsigned batchSize = entries_[batchBegin].size_;
+        while (batchEnd < entries_.size() && batchSize + entries_[batchEnd].size_ <= MAX_BATCH_SIZE)
+            batchSize += entries_[batchEnd++].size_;
+
+        ea::vector<PackedEntry> batch(batchEnd - batchBegin);
+        ForEachParallel(workQueue, 1u, batch.size(),
+            [&](unsigned beginIndex, unsigned endIndex)
         {
-            checksum_ = SDBMHash(checksum_, buffer[j]);
-            entries_[i].checksum_ = SDBMHash(entries_[i].checksum_, buffer[j]);
-        }
+            for (unsigned i = beginIndex; i < endIndex; ++i)
+                ReadEntry(entries_[batchBegin + i], rootDir, batch[i]);
+        });
 
-        if (!compress_)
+        // Identical files are stored once, only the first one is compressed
+        for (unsigned i = 0; i < batch.size(); ++i)
         {
-            if (!quiet_)
-                PrintLine(entries_[i].name_ + " size " + ea::to_string(dataSize));
-            dest.Write(&buffer[0], entries_[i].size_);
+            FileEntry& entry = entries_[batchBegin + i];
+            if (!batch[i].error_.empty())
+                ErrorExit(batch[i].error_);
+
+            const auto iter = uniqueEntries.find(entry.contentKey_);
+            if (iter != uniqueEntries.end())
+                batch[i].duplicateOf_ = iter->second;
+            else
+                uniqueEntries.emplace(entry.contentKey_, batchBegin + i);
         }
-        else
+
+        if (compress_)
+            CompressEntries(batch);
+
+        for (unsigned i = 0; i < batch.size(); ++i)
         {
-            ea::unique_ptr<unsigned char[]> compressBuffer(new unsigned char[LZ4_compressBound(blockSize_)]);
+            FileEntry& entry = entries_[batchBegin + i];
+            PackedEntry& packedEntry = batch[i];
 
-            unsigned pos = 0;
+            totalDataSize += entry.size_;
+            checksum_ = CombineChecksums(checksum_, entry.checksum_, entry.size_);
 
-            while (pos < dataSize)
+            if (packedEntry.duplicateOf_ != M_MAX_UNSIGNED)
             {
-                unsigned unpackedSize = blockSize_;
-                if (pos + unpackedSize > dataSize)
-                    unpackedSize = dataSize - pos;
-
-                auto packedSize = (unsigned)LZ4_compress_HC((const char*)&buffer[pos], (char*)compressBuffer.get(), unpackedSize, LZ4_compressBound(unpackedSize), 0);
-                if (!packedSize)
-                    ErrorExit("LZ4 compression failed for file " + entries_[i].name_ + " at offset " + ea::to_string(pos));
+                const FileEntry& original = entries_[packedEntry.duplicateOf_];
+                entry.offset_ = original.offset_;
+                entry.compression_ = original.compression_;
+                ++numDuplicates;
+
+                if (!quiet_)
+                    PrintLine(entry.name_ + " is duplicate of " + original.name_);
+                continue;
+            }
 
-                dest.WriteUShort((unsigned short)unpackedSize);
-                dest.WriteUShort((unsigned short)packedSize);
-                dest.Write(compressBuffer.get(), packedSize);
+            entry.offset_ = dest.GetSize();
+            if (!packedEntry.packedData_.empty())
+            {
+                entry.compression_ = PackageCompression::LZ4;
+                dest.Write(packedEntry.packedData_.data(), packedEntry.packedData_.size());
 
-                pos += unpackedSize;
+                if (!quiet_)
+                {
+                    const unsigned totalPackedBytes = packedEntry.packedData_.size();
+                    ea::string fileEntry(entry.name_);
+                    fileEntry.append_sprintf("\tin: %u\tout: %u\tratio: %f", entry.size_, totalPackedBytes,
+                        totalPackedBytes ? 1.f * entry.size_ / totalPackedBytes : 0.f);
+                    PrintLine(fileEntry);
+                }
             }
-
-            if (!quiet_)
+            else
             {
-                unsigned totalPackedBytes = dest.GetSize() - lastOffset;
-                ea::string fileEntry(entries_[i].name_);
-                fileEntry.append_sprintf("\tin: %u\tout: %u\tratio: %f", dataSize, totalPackedBytes,
-                    totalPackedBytes ? 1.f * dataSize / totalPackedBytes : 0.f);
-                PrintLine(fileEntry);
+                // Store files that don't benefit from compression as is
+                entry.compression_ = PackageCompression::None;
+                if (!quiet_)
+                    PrintLine(entry.name_ + " size " + ea::to_string(entry.size_));
+                dest.Write(packedEntry.data_.data(), packedEntry.data_.size());
             }
         }
+
+        batchBegin = batchEnd;
     }
 
+    // File list is in the end, followed by hashes of file names
+    const long long fileListOffset = dest.GetSize();
+    WriteFileList(dest);
+
     // Write package size to the end of file to allow finding it linked to an executable file
     unsigned currentSize = dest.GetSize();
     dest.WriteUInt(currentSize + sizeof(unsigned));
 
     // Write header again with correct offsets & checksums
     dest.Seek(0);
-    WriteHeader(dest);
-
-    for (unsigned i = 0; i < entries_.size(); ++i)
-    {
-        dest.WriteString(basePath_ + entries_[i].name_);
-        dest.WriteUInt(entries_[i].offset_);
-        dest.WriteUInt(entries_[i].size_);
-        dest.WriteUInt(entries_[i].checksum_);
-    }
+    WriteHeader(dest, fileListOffset);
 
     if (!quiet_)
     {
         PrintLine("Number of files: " + ea::to_string(entries_.size()));
+        PrintLine("Number of duplicate files: " + ea::to_string(numDuplicates));
         PrintLine("File data size: " + ea::to_string(totalDataSize));
-        PrintLine("Package size: " + ea::to_string(dest.GetSize()));
+        PrintLine("Package size: " + ea::to_string(currentSize + sizeof(unsigned)));
         PrintLine("Checksum: " + ea::to_string(checksum_));
         PrintLine("Compressed: " + ea::string(compress_ ? "yes" : "no"));
     }
 }
 
-void WriteHeader(File& dest)
+void ReadEntry(FileEntry& entry, const ea::string& rootDir, PackedEntry& result)
 {
-    if (!compress_)
-        dest.WriteFileID("UPAK");
-    else
-        dest.WriteFileID("ULZ4");
+    const ea::string fileFullPath = rootDir + "/" + entry.name_;
+
+    File srcFile(context_, fileFullPath);
+    if (!srcFile.IsOpen())
+    {
+        result.error_ = "Could not open file " + fileFullPath;
+        return;
+    }
+
+    result.data_.resize(entry.size_);
+    if (srcFile.Read(result.data_.data(), entry.size_) != entry.size_)
+    {
+        result.error_ = "Could not read file " + fileFullPath;
+        return;
+    }
+
+    entry.checksum_ = 0;
+    for (unsigned char value : result.data_)
+        entry.checksum_ = SDBMHash(entry.checksum_, value);
+    entry.contentKey_ = ContentKey{MakeContentHash(result.data_.data(), result.data_.size()), entry.size_, entry.checksum_};
+}
+
+void CompressEntries(ea::vector<PackedEntry>& batch)
+{
+    // Compress blocks of all files at once, so large files are compressed in parallel too
+    ea::vector<ea::pair<unsigned, unsigned>> blocks;
+    for (unsigned i = 0; i < batch.size(); ++i)
+    {
+        if (batch[i].duplicateOf_ != M_MAX_UNSIGNED)
+            continue;
+
+        const unsigned numBlocks = (batch[i].data_.size() + blockSize_ - 1) / blockSize_;
+        batch[i].packedBlocks_.resize(numBlocks);
+        for (unsigned blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+            blocks.emplace_back(i, blockIndex);
+    }
+
+    auto workQueue = context_->GetSubsystem<WorkQueue>();
+    ForEachParallel(workQueue, 1u, blocks.size(),
+        [&](unsigned beginIndex, unsigned endIndex)
+    {
+        ea::unique_ptr<unsigned char[]> compressBuffer(new unsigned char[LZ4_compressBound(blockSize_)]);
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            const auto [entryIndex, blockIndex] = blocks[i];
+            PackedEntry& entry = batch[entryIndex];
+            const unsigned pos = blockIndex * blockSize_;
+            const unsigned unpackedSize = ea::min(blockSize_, entry.data_.size() - pos);
+
+            const auto packedSize = static_cast<unsigned>(LZ4_compress_HC(reinterpret_cast<const char*>(&entry.data_[pos]),
+                reinterpret_cast<char*>(compressBuffer.get()), unpackedSize, LZ4_compressBound(unpackedSize), 0));
+
+            // Store block as is if compression doesn't help, reader distinguishes such blocks by size
+            ByteVector& packedBlock = entry.packedBlocks_[blockIndex];
+            if (packedSize == 0 || packedSize >= unpackedSize)
+                packedBlock.assign(&entry.data_[pos], &entry.data_[pos] + unpackedSize);
+            else
+                packedBlock.assign(compressBuffer.get(), compressBuffer.get() + packedSize);
+        }
+    });
+
+    for (PackedEntry& entry : batch)
+    {
+        if (entry.duplicateOf_ == M_MAX_UNSIGNED)
+            AssembleBlocks(entry);
+    }
+}
+
+void AssembleBlocks(PackedEntry& entry)
+{
+    const unsigned numBlocks = entry.packedBlocks_.size();
+    const unsigned tableSize = (numBlocks + 1) * sizeof(unsigned);
+
+    unsigned packedSize = 0;
+    for (const ByteVector& packedBlock : entry.packedBlocks_)
+        packedSize += packedBlock.size();
+
+    // Keep packed data empty if compression doesn't help
+    if (tableSize + packedSize < entry.data_.size())
+    {
+        VectorBuffer buffer;
+        unsigned blockOffset = tableSize;
+        for (const ByteVector& packedBlock : entry.packedBlocks_)
+        {
+            buffer.WriteUInt(blockOffset);
+            blockOffset += packedBlock.size();
+        }
+        buffer.WriteUInt(blockOffset);
+
+        for (const ByteVector& packedBlock : entry.packedBlocks_)
+            buffer.Write(packedBlock.data(), packedBlock.size());
+        entry.packedData_ = ea::move(buffer.GetBuffer());
+    }
+
+    entry.packedBlocks_.clear();
+}
+
+unsigned CombineChecksums(unsigned firstChecksum, unsigned secondChecksum, unsigned secondSize)
+{
+    // SDBM hash is linear: each byte multiplies previous value by 65599, so the first checksum is scaled by 65599^size
+    unsigned multiplier = 1;
+    unsigned base = 65599;
+    for (unsigned exponent = secondSize; exponent; exponent >>= 1)
+    {
+        if (exponent & 1)
+            multiplier *= base;
+        base *= base;
+    }
+    return firstChecksum * multiplier + secondChecksum;
+}
+
+void WriteHeader(File& dest, long long fileListOffset)
+{
+    dest.WriteFileID(compress_ ? "RLZ4" : "RPAK");
     dest.WriteUInt(entries_.size());
     dest.WriteUInt(checksum_);
+    dest.WriteUInt(PACKAGE_VERSION_NAME_HASHES);
+    dest.WriteInt64(fileListOffset);
+    dest.WriteUInt(blockSize_);
+}
+
+void WriteFileList(File& dest)
+{
+    for (const FileEntry& entry : entries_)
+    {
+        dest.WriteString(basePath_ + entry.name_);
+        dest.WriteUInt(entry.offset_);
+        dest.WriteUInt(entry.size_);
+        dest.WriteUInt(entry.checksum_);
+        dest.WriteUByte(static_cast<unsigned char>(entry.compression_));
+    }
+
+    // Virtual file system indexes packages by these hashes without hashing every name on load
+    for (const FileEntry& entry : entries_)
+        dest.WriteUInt(MakeFileNameHash(basePath_ + entry.name_).Value());
 }
@@ -162,9 +162,9 @@ void ActionManager::CompleteAllActions()
     tmpKeysArray_.clear();
     tmpKeysArray_.reserve(targets_.size() * 2);
 
-    for (auto target : targets_)
+    for (const auto& [target, element] : targets_)
     {
-        tmpKeysArray_.push_back(target.first);
+        tmpKeysArray_.push_back(target);
     }
 
     for (auto target : tmpKeysArray_)
@@ -183,9 +183,9 @@ void ActionManager::CancelAllActions()
     tmpKeysArray_.clear();
     tmpKeysArray_.reserve(targets_.size() * 2);
 
-    for (auto target : targets_)
+    for (const auto& [target, element] : targets_)
     {
-        tmpKeysArray_.push_back(target.first);
+        tmpKeysArray_.push_back(target);
     }
 
     for (auto target : tmpKeysArray_)
@@ -340,9 +340,9 @@ void ActionManager::Update(float dt)
     tmpKeysArray_.clear();
     if (tmpKeysArray_.capacity() < count)
         tmpKeysArray_.reserve(count * 2);
-    for (auto target : targets_)
+    for (const auto& [target, element] : targets_)
     {
-        tmpKeysArray_.push_back(target.first);
+        tmpKeysArray_.push_back(target);
     }
 
     for (unsigned i = 0; i < count; i++)
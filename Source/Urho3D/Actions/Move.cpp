@@ -25,6 +25,8 @@
 
 #include "../Core/Context.h"
 #include "../IO/Log.h"
+#include "../Scene/Node.h"
+#include "../UI/UIElement.h"
 #include "AttributeActionState.h"
 #include "FiniteTimeActionState.h"
 #include "Urho3D/IO/ArchiveSerializationBasic.h"
@@ -36,6 +38,115 @@ namespace Actions
 
 namespace
 {
+/// Return whether the action animates given transform attribute of the Node directly.
+/// Such actions skip attribute accessors and Variant conversion.
+bool IsNodeAttribute(Object* target, const ea::string& attributeName, ea::string_view nodeAttributeName)
+{
+    return target->IsInstanceOf<Node>() && attributeName == nodeAttributeName;
+}
+
+/// Return whether the action animates position of the UIElement directly.
+bool IsUIElementPosition(Object* target, const ea::string& attributeName)
+{
+    return target->IsInstanceOf<UIElement>() && attributeName == POSITION_ATTRIBUTE;
+}
+
+class NodeMoveByState : public FiniteTimeActionState
+{
+    Vector3 positionDelta_;
+    Vector3 startPosition_;
+    Vector3 previousPosition_;
+
+public:
+    NodeMoveByState(MoveBy* action, Node* target)
+        : FiniteTimeActionState(action, target)
+    {
+        positionDelta_ = action->GetPositionDelta();
+        previousPosition_ = startPosition_ = target->GetPosition();
+    }
+
+    void Update(float time) override
+    {
+        auto node = static_cast<Node*>(GetTarget());
+        startPosition_ += node->GetPosition() - previousPosition_;
+        const auto newPos = startPosition_ + positionDelta_ * time;
+        node->SetPosition(newPos);
+        previousPosition_ = newPos;
+    }
+};
+
+class UIElementMoveByState : public FiniteTimeActionState
+{
+    Vector2 positionDelta_;
+    IntVector2 startPosition_;
+    IntVector2 previousPosition_;
+
+public:
+    UIElementMoveByState(MoveBy* action, UIElement* target)
+        : FiniteTimeActionState(action, target)
+    {
+        positionDelta_ = action->GetPositionDelta().ToVector2();
+        previousPosition_ = startPosition_ = target->GetPosition();
+    }
+
+    void Update(float time) override
+    {
+        auto element = static_cast<UIElement*>(GetTarget());
+        startPosition_ += element->GetPosition() - previousPosition_;
+        const auto newPos = startPosition_ + (positionDelta_ * time).ToIntVector2();
+        element->SetPosition(newPos);
+        previousPosition_ = newPos;
+    }
+};
+
+class NodeScaleByState : public FiniteTimeActionState
+{
+    Vector3 scaleDelta_;
+    Vector3 startScale_;
+    Vector3 previousScale_;
+
+public:
+    NodeScaleByState(ScaleBy* action, Node* target)
+        : FiniteTimeActionState(action, target)
+    {
+        scaleDelta_ = action->GetScaleDelta();
+        previousScale_ = startScale_ = target->GetScale();
+    }
+
+    void Update(float time) override
+    {
+        auto node = static_cast<Node*>(GetTarget());
+        startScale_ = startScale_ * (node->GetScale() / previousScale_);
+        const auto newScale = startScale_ * Vector3::ONE.Lerp(scaleDelta_, time);
+        node->SetScale(newScale);
+        previousScale_ = newScale;
+    }
+};
+
+class NodeRotateByState : public FiniteTimeActionState
+{
+    Quaternion rotationDelta_;
+    Quaternion startRotation_;
+    Quaternion previousRotation_;
+
+public:
+    NodeRotateByState(RotateBy* action, Node* target)
+        : FiniteTimeActionState(action, target)
+    {
+        rotationDelta_ = action->GetRotationDelta();
+        previousRotation_ = startRotation_ = target->GetRotation();
+    }
+
+    void Update(float time) override
+    {
+        auto node = static_cast<Node*>(GetTarget());
+        startRotation_ = startRotation_ * (previousRotation_.Inverse() * node->GetRotation());
+        const auto newRotation = startRotation_ * Quaternion::IDENTITY.Slerp(rotationDelta_, time);
+        node->SetRotation(newRotation);
+        previousRotation_ = newRotation;
+    }
+};
+
 class MoveByVec3State : public AttributeActionState
 {
     Vector3 positionDelta_;
@@ -422,6 +533,11 @@ void MoveBy::SerializeInBlock(Archive& archive)
 /// Create new action state from the action.
 SharedPtr<ActionState> MoveBy::StartAction(Object* target)
 {
+    if (IsNodeAttribute(target, GetAttributeName(), POSITION_ATTRIBUTE))
+        return MakeShared<NodeMoveByState>(this, static_cast<Node*>(target));
+    if (IsUIElementPosition(target, GetAttributeName()))
+        return MakeShared<UIElementMoveByState>(this, static_cast<UIElement*>(target));
+
     if (auto attribute = GetAttribute(target))
     {
         switch (attribute->type_)
@@ -551,6 +667,9 @@ void ScaleBy::SerializeInBlock(Archive& archive)
 /// Create new action state from the action.
 SharedPtr<ActionState> ScaleBy::StartAction(Object* target)
 {
+    if (IsNodeAttribute(target, GetAttributeName(), SCALE_ATTRIBUTE))
+        return MakeShared<NodeScaleByState>(this, static_cast<Node*>(target));
+
     if (auto attribute = GetAttribute(target))
     {
         switch (attribute->type_)
@@ -621,6 +740,9 @@ void RotateBy::SerializeInBlock(Archive& archive)
 /// Create new action state from the action.
 SharedPtr<ActionState> RotateBy::StartAction(Object* target)
 {
+    if (IsNodeAttribute(target, GetAttributeName(), ROTATION_ATTRIBUTE))
+        return MakeShared<NodeRotateByState>(this, static_cast<Node*>(target));
+
     if (auto attribute = GetAttribute(target))
     {
         switch (attribute->type_)
@@ -33,8 +33,14 @@
 #include "../Core/Profiler.h"
 #include "../IO/Log.h"
 
+#include <EASTL/sort.h>
+
 #include <SDL.h>
 
+#ifdef URHO3D_SSE
+#include <emmintrin.h>
+#endif
+
 #include "../DebugNew.h"
 
 #ifdef _MSC_VER
@@ -405,6 +411,15 @@ void Audio::MixOutput(void* dest, unsigned samples)
         }
         // Copy output from clip buffer to destination
         auto* destPtr = (short*)dest;
+#ifdef URHO3D_SSE
+        // Pack with signed saturation is equivalent to clamping
+        for (; clipSamples >= 8; clipSamples -= 8, clipPtr += 8, destPtr += 8)
+        {
+            const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(clipPtr));
+            const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(clipPtr + 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destPtr), _mm_packs_epi32(low, high));
+        }
+#endif
         while (clipSamples--)
             *destPtr++ = (short)Clamp(*clipPtr++, -32768, 32767);
         samples -= workSamples;
@@ -449,6 +464,33 @@ void Audio::UpdateInternal(float timeStep)
 
         source->Update(timeStep);
     }
+
+    UpdateVirtualVoices();
+}
+
+void Audio::UpdateVirtualVoices()
+{
+    playingSources_.clear();
+    for (SoundSource* source : soundSources_)
+    {
+        if (source->IsPlaying() && !pausedSoundTypes_.contains(source->GetSoundType()))
+            playingSources_.push_back(source);
+        else
+            source->SetVirtual(false);
+    }
+
+    const unsigned numVoices = ea::min<unsigned>(maxVoices_ ? maxVoices_ : M_MAX_UNSIGNED, playingSources_.size());
+    if (numVoices < playingSources_.size())
+    {
+        const auto isMoreAudible = [](const SoundSource* lhs, const SoundSource* rhs)
+        { return lhs->GetAudibility() > rhs->GetAudibility(); };
+        ea::nth_element(playingSources_.begin(), playingSources_.begin() + numVoices, playingSources_.end(), isMoreAudible);
+    }
+
+    MutexLock lock(audioMutex_);
+    for (unsigned i = 0; i < playingSources_.size(); ++i)
+        playingSources_[i]->SetVirtual(i >= numVoices);
+    numVirtualVoices_ = playingSources_.size() - numVoices;
 }
 
 StringVector Audio::EnumerateMicrophones() const
@@ -75,6 +75,10 @@ public:
     void SetListener(SoundListener* listener);
     /// Stop any sound source playing a certain sound clip.
     void StopSound(Sound* sound);
+    /// Set max number of sound sources mixed at once. Sources with the least audibility are virtualized:
+    /// their playback position advances, but they are not mixed. 0 means no limit.
+    /// @property
+    void SetMaxVoices(unsigned maxVoices) { maxVoices_ = maxVoices; }
 
     /// Return byte size of one sample.
     /// @property
@@ -96,6 +100,13 @@ public:
     /// @property
     SpeakerMode GetSpeakerMode() const { return speakerMode_; }
 
+    /// Return max number of sound sources mixed at once.
+    /// @property
+    unsigned GetMaxVoices() const { return maxVoices_; }
+
+    /// Return number of sound sources virtualized due to voice limit in the last update.
+    unsigned GetNumVirtualVoices() const { return numVirtualVoices_; }
+
     /// Return whether audio is being output.
     /// @property
     bool IsPlaying() const { return playing_; }
@@ -149,6 +160,8 @@ private:
     void Release();
     /// Actually update sound sources with the specific timestep. Called internally.
     void UpdateInternal(float timeStep);
+    /// Choose sound sources to virtualize according to voice limit.
+    void UpdateVirtualVoices();
 
     /// Clipping buffer for mixing.
     ea::unique_ptr<int[]> clipBuffer_;
@@ -176,6 +189,12 @@ private:
     ea::hash_set<StringHash> pausedSoundTypes_;
     /// Sound sources.
     ea::vector<SoundSource*> soundSources_;
+    /// Max number of mixed sound sources.
+    unsigned maxVoices_{};
+    /// Number of virtualized sound sources.
+    unsigned numVirtualVoices_{};
+    /// Playing sound sources, reused between updates.
+    ea::vector<SoundSource*> playingSources_;
     /// Sound listener.
     WeakPtr<SoundListener> listener_;
     /// List of microphones being tracked.
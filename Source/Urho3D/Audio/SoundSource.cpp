@@ -147,6 +147,7 @@ void SoundSource::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Panning", float, panning_, 0.0f, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Reach", float, reach_, 0.0f, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Low Frequency Effect", bool, lowFrequency_, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Priority", float, priority_, 1.0f, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Is Playing", IsPlaying, SetPlayingAttr, bool, false, AM_DEFAULT);
     URHO3D_ENUM_ATTRIBUTE("Autoremove Mode", autoRemove_, autoRemoveModeNames, REMOVE_DISABLED, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Play Position", GetPositionAttr, SetPositionAttr, int, 0, AM_DEFAULT);
@@ -279,6 +280,11 @@ void SoundSource::SetGain(float gain)
     gain_ = Max(gain, 0.0f);
 }
 
+void SoundSource::SetPriority(float priority)
+{
+    priority_ = Max(priority, 0.0f);
+}
+
 void SoundSource::SetAttenuation(float attenuation)
 {
     attenuation_ = Clamp(attenuation, 0.0f, 1.0f);
@@ -394,8 +400,11 @@ void SoundSource::Mix(int dest[], unsigned samples, int mixRate, SpeakerMode mod
     if (!sound)
         return;
 
+    // Virtual sources only advance playback position
+    if (virtual_)
+        MixZeroVolume(sound, samples, mixRate);
     // Choose the correct mixing routine
-    if (!sound->IsStereo())
+    else if (!sound->IsStereo())
     {
         if (interpolation)
         {
@@ -83,6 +83,9 @@ public:
     /// Set whether this is a LFE output.
     /// @property
     void SetLowFrequency(bool state);
+    /// Set priority. Audible volume is multiplied by priority when Audio chooses which sources to mix.
+    /// @property
+    void SetPriority(float priority);
     /// Set to remove either the sound source component or its owner node from the scene automatically on sound playback completion. Disabled by default.
     /// @property
     void SetAutoRemoveMode(AutoRemoveMode mode);
@@ -128,6 +131,18 @@ public:
     /// @property
     bool IsLowFrequency() const { return lowFrequency_; }
 
+    /// Return priority.
+    /// @property
+    float GetPriority() const { return priority_; }
+
+    /// Return audible volume multiplied by priority. Used to choose which sources to mix when voice limit is exceeded.
+    float GetAudibility() const { return masterGain_ * attenuation_ * gain_ * priority_; }
+
+    /// Set whether the source is virtual, i.e. playback position advances but nothing is mixed. Called by Audio.
+    void SetVirtual(bool isVirtual) { virtual_ = isVirtual; }
+    /// Return whether the source is virtual.
+    bool IsVirtual() const { return virtual_; }
+
     /// Return automatic removal mode on sound playback completion.
     /// @property
     AutoRemoveMode GetAutoRemoveMode() const { return autoRemove_; }
@@ -171,6 +186,8 @@ protected:
     float panning_;
     /// Surround sound forward/back reach.
     float reach_{0.0f};
+    /// Priority for voice limiting.
+    float priority_{1.0f};
     /// Effective master gain.
     float masterGain_{};
     /// Whether finished event should be sent on playback stop.
@@ -232,6 +249,8 @@ private:
     SharedPtr<Sound> streamBuffer_;
     /// Unused stream bytes from previous frame.
     int unusedStreamSize_;
+    /// Whether the source is not mixed due to voice limit.
+    bool virtual_{};
 };
 
 }
@@ -41,14 +41,40 @@ namespace Urho3DNet
 #endif
         private static void EventHandlerCallback(IntPtr actionHandle, uint eventHash, IntPtr argMap)
         {
-            var eventHandler = (Action<StringHash, VariantMap>)GCHandle.FromIntPtr(actionHandle).Target;
-            eventHandler(new StringHash(eventHash), VariantMap.wrap(argMap, false));
+            var eventHandler = (EventHandlerState)GCHandle.FromIntPtr(actionHandle).Target;
+            eventHandler.Invoke(new StringHash(eventHash), argMap);
         }
         private static readonly EventCallbackDelegate EventHandlerCallbackInstance = EventHandlerCallback;
 
+        /// <summary>
+        /// Event handler with cached wrapper of event arguments. Senders usually reuse the same native map for every
+        /// event, so the wrapper is created once instead of on every invocation.
+        /// </summary>
+        private sealed class EventHandlerState
+        {
+            private readonly Action<StringHash, VariantMap> _handler;
+            private IntPtr _argMap;
+            private VariantMap _args;
+
+            public EventHandlerState(Action<StringHash, VariantMap> handler)
+            {
+                _handler = handler;
+            }
+
+            public void Invoke(StringHash eventType, IntPtr argMap)
+            {
+                if (_args == null || _argMap != argMap)
+                {
+                    _argMap = argMap;
+                    _args = VariantMap.wrap(argMap, false);
+                }
+                _handler(eventType, _args);
+            }
+        }
+
         public void SubscribeToEvent(StringHash e, Object sender, Action<StringHash, VariantMap> eventHandler)
         {
-            IntPtr handle = GCHandle.ToIntPtr(GCHandle.Alloc(eventHandler));
+            IntPtr handle = GCHandle.ToIntPtr(GCHandle.Alloc(new EventHandlerState(eventHandler)));
             IntPtr callback = Marshal.GetFunctionPointerForDelegate(EventHandlerCallbackInstance);
             Urho3D_Object_SubscribeToEvent(swigCPtr, getCPtr(sender), e.Hash, callback, handle);
         }
@@ -20,7 +20,10 @@
 // THE SOFTWARE.
 //
 
+using System;
+using System.Collections.Generic;
 using System.ComponentModel;
+using System.Runtime.InteropServices;
 
 namespace Urho3DNet
 {
@@ -104,5 +107,82 @@ namespace Urho3DNet
         {
             return (T)GetParentDerivedComponent(typeof(T).Name, fullTraversal);
         }
+
+        [DllImport(global::Urho3DNet.Urho3DPINVOKE.DllImportModule, EntryPoint = "Urho3D_Node_GetTransforms")]
+        private static extern void Urho3D_Node_GetTransforms(IntPtr[] nodes, int count, bool world,
+            [Out] Vector3[] positions, [Out] Quaternion[] rotations, [Out] Vector3[] scales);
+
+        [DllImport(global::Urho3DNet.Urho3DPINVOKE.DllImportModule, EntryPoint = "Urho3D_Node_GetWorldTransforms")]
+        private static extern void Urho3D_Node_GetWorldTransforms(IntPtr[] nodes, int count, [Out] Matrix3x4[] transforms);
+
+        [DllImport(global::Urho3DNet.Urho3DPINVOKE.DllImportModule, EntryPoint = "Urho3D_Node_SetTransforms")]
+        private static extern void Urho3D_Node_SetTransforms(IntPtr[] nodes, int count, bool world,
+            [In] Vector3[] positions, [In] Quaternion[] rotations, [In] Vector3[] scales);
+
+        [ThreadStatic]
+        private static IntPtr[] _nodeHandles;
+
+        /// <summary>
+        /// Return native pointers of the nodes. Buffer is reused between calls on the same thread.
+        /// </summary>
+        private static IntPtr[] GetNodeHandles(IReadOnlyList<Node> nodes)
+        {
+            if (_nodeHandles == null || _nodeHandles.Length < nodes.Count)
+                _nodeHandles = new IntPtr[Math.Max(nodes.Count, 2 * (_nodeHandles?.Length ?? 0))];
+            for (int i = 0; i < nodes.Count; ++i)
+                _nodeHandles[i] = getCPtr(nodes[i]).Handle;
+            return _nodeHandles;
+        }
+
+        private static void CheckLength(Array array, int count, string name)
+        {
+            if (array != null && array.Length < count)
+                throw new ArgumentException($"Array is shorter than the list of nodes", name);
+        }
+
+        /// <summary>
+        /// Get position, rotation and scale of many nodes in one native call. Arrays may be null.
+        /// </summary>
+        /// <param name="nodes">Nodes to read.</param>
+        /// <param name="positions">Output positions.</param>
+        /// <param name="rotations">Output rotations.</param>
+        /// <param name="scales">Output scales.</param>
+        /// <param name="world">Whether to read world transforms instead of local ones.</param>
+        public static void GetTransforms(IReadOnlyList<Node> nodes, Vector3[] positions, Quaternion[] rotations,
+            Vector3[] scales, bool world = false)
+        {
+            CheckLength(positions, nodes.Count, nameof(positions));
+            CheckLength(rotations, nodes.Count, nameof(rotations));
+            CheckLength(scales, nodes.Count, nameof(scales));
+            Urho3D_Node_GetTransforms(GetNodeHandles(nodes), nodes.Count, world, positions, rotations, scales);
+        }
+
+        /// <summary>
+        /// Get world transform matrices of many nodes in one native call.
+        /// </summary>
+        /// <param name="nodes">Nodes to read.</param>
+        /// <param name="transforms">Output world transforms.</param>
+        public static void GetWorldTransforms(IReadOnlyList<Node> nodes, Matrix3x4[] transforms)
+        {
+            CheckLength(transforms, nodes.Count, nameof(transforms));
+            Urho3D_Node_GetWorldTransforms(GetNodeHandles(nodes), nodes.Count, transforms);
+        }
+
+        /// <summary>
+        /// Set position, rotation and scale of many nodes in one native call. Arrays may be null, corresponding components are kept.
+        /// </summary>
+        /// <param name="nodes">Nodes to modify.</param>
+        /// <param name="positions">New positions.</param>
+        /// <param name="rotations">New rotations.</param>
+        /// <param name="scales">New scales.</param>
+        /// <param name="world">Whether to set world transforms instead of local ones.</param>
+        public static void SetTransforms(IReadOnlyList<Node> nodes, Vector3[] positions, Quaternion[] rotations,
+            Vector3[] scales, bool world = false)
+        {
+            CheckLength(positions, nodes.Count, nameof(positions));
+            CheckLength(rotations, nodes.Count, nameof(rotations));
+            CheckLength(scales, nodes.Count, nameof(scales));
+            Urho3D_Node_SetTransforms(GetNodeHandles(nodes), nodes.Count, world, positions, rotations, scales);
+        }
     }
 }
@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include <Urho3D/Scene/Node.h>
+#include <Urho3D/Script/Script.h>
+
+namespace Urho3D
+{
+
+extern "C"
+{
+
+/// Read transforms of many nodes at once. Output arrays may be null.
+URHO3D_EXPORT_API void SWIGSTDCALL Urho3D_Node_GetTransforms(Node** nodes, int count, bool world,
+    Vector3* positions, Quaternion* rotations, Vector3* scales)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        Node* node = nodes[i];
+        if (!node)
+            continue;
+
+        if (positions)
+            positions[i] = world ? node->GetWorldPosition() : node->GetPosition();
+        if (rotations)
+            rotations[i] = world ? node->GetWorldRotation() : node->GetRotation();
+        if (scales)
+            scales[i] = world ? node->GetWorldScale() : node->GetScale();
+    }
+}
+
+/// Read world transform matrices of many nodes at once.
+URHO3D_EXPORT_API void SWIGSTDCALL Urho3D_Node_GetWorldTransforms(Node** nodes, int count, Matrix3x4* transforms)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        if (Node* node = nodes[i])
+            transforms[i] = node->GetWorldTransform();
+    }
+}
+
+/// Write transforms of many nodes at once. Input arrays may be null, corresponding components are not changed.
+URHO3D_EXPORT_API void SWIGSTDCALL Urho3D_Node_SetTransforms(Node** nodes, int count, bool world,
+    const Vector3* positions, const Quaternion* rotations, const Vector3* scales)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        Node* node = nodes[i];
+        if (!node)
+            continue;
+
+        // Set whole transform at once when possible to mark node dirty only once
+        if (positions && rotations && scales)
+        {
+            if (world)
+                node->SetWorldTransform(positions[i], rotations[i], scales[i]);
+            else
+                node->SetTransform(positions[i], rotations[i], scales[i]);
+            continue;
+        }
+
+        if (world)
+        {
+            if (positions)
+                node->SetWorldPosition(positions[i]);
+            if (rotations)
+                node->SetWorldRotation(rotations[i]);
+            if (scales)
+                node->SetWorldScale(scales[i]);
+        }
+        else
+        {
+            if (positions)
+                node->SetPosition(positions[i]);
+            if (rotations)
+                node->SetRotation(rotations[i]);
+            if (scales)
+                node->SetScale(scales[i]);
+        }
+    }
+}
+
+}
+
+}
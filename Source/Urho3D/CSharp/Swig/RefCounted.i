@@ -266,6 +266,8 @@ URHO3D_REFCOUNTED(Urho3D::BehaviorNetworkObject);
 //%interface_custom("%s", "I%s", Urho3D::RefCounted);
 %director Urho3D::RefCounted;
 %ignore Urho3D::RefCounted::RefCountPtr;
+%ignore Urho3D::RefCounted::DeleteThis;
+%ignore Urho3D::RefCounted::RenewRefCount;
 %ignore Urho3D::RefCount;
 %csmethodmodifiers Urho3D::RefCounted::SetScriptObject "internal"
 %csmethodmodifiers Urho3D::RefCounted::GetScriptObject "internal"
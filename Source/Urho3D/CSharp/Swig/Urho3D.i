@@ -507,6 +507,10 @@ public:
 %ignore Urho3D::Serializable::networkState_;
 %ignore Urho3D::Serializable::instanceDefaultValues_;
 %ignore Urho3D::Serializable::temporary_;
+%ignore Urho3D::Serializable::DeleteThis;
+%ignore Urho3D::Serializable::OnRecycle;
+%ignore Urho3D::Component::OnRecycle;
+%ignore Urho3D::Node::OnRecycle;
 %ignore Urho3D::Component::CleanupConnection;
 %ignore Urho3D::Scene::CleanupConnection;
 %ignore Urho3D::Node::CleanupConnection;
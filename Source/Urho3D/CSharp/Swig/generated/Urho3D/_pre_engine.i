@@ -36,6 +36,10 @@
 %ignore Urho3D::EP_MAIN_PLUGIN;
 %constant const char* EpMaterialQuality = "MaterialQuality";
 %ignore Urho3D::EP_MATERIAL_QUALITY;
+%constant const char* EpMemoryMappedPackages = "MemoryMappedPackages";
+%ignore Urho3D::EP_MEMORY_MAPPED_PACKAGES;
+%constant const char* EpModelStreaming = "ModelStreaming";
+%ignore Urho3D::EP_MODEL_STREAMING;
 %constant const char* EpMonitor = "Monitor";
 %ignore Urho3D::EP_MONITOR;
 %constant const char* EpMultiSample = "MultiSample";
@@ -84,6 +88,8 @@
 %ignore Urho3D::EP_TEXTURE_FILTER_MODE;
 %constant const char* EpTextureQuality = "TextureQuality";
 %ignore Urho3D::EP_TEXTURE_QUALITY;
+%constant const char* EpTextureStreaming = "TextureStreaming";
+%ignore Urho3D::EP_TEXTURE_STREAMING;
 %constant const char* EpTimeOut = "TimeOut";
 %ignore Urho3D::EP_TIME_OUT;
 %constant const char* EpTouchEmulation = "TouchEmulation";
@@ -8,7 +8,7 @@
 %csconstvalue("0") Urho3D::DEBUGHUD_SHOW_NONE;
 %csconstvalue("1") Urho3D::DEBUGHUD_SHOW_STATS;
 %csconstvalue("2") Urho3D::DEBUGHUD_SHOW_MODE;
-%csconstvalue("7") Urho3D::DEBUGHUD_SHOW_ALL;
+%csconstvalue("15") Urho3D::DEBUGHUD_SHOW_ALL;
 %typemap(csattributes) Urho3D::DebugHudMode "[global::System.Flags]";
 using DebugHudModeFlags = Urho3D::DebugHudMode;
 %typemap(ctype) DebugHudModeFlags "size_t";
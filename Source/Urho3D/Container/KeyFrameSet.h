@@ -24,6 +24,7 @@
 
 #include "../Core/Variant.h"
 
+#include <EASTL/algorithm.h>
 #include <EASTL/vector.h>
 #include <EASTL/sort.h>
 
@@ -102,17 +103,30 @@ struct KeyFrameSet
         if (time < 0.0f)
             time = 0.0f;
 
-        if (index >= keyFrames_.size())
-            index = keyFrames_.size() - 1;
+        const unsigned numFrames = keyFrames_.size();
+        if (index >= numFrames)
+            index = numFrames - 1;
+
+        // Check the hint and the next keyframe, which is the common case for playback
+        const auto isFrameAtTime = [&](unsigned frameIndex)
+        {
+            return (frameIndex == 0 || keyFrames_[frameIndex].time_ <= time)
+                && (frameIndex + 1 == numFrames || time < keyFrames_[frameIndex + 1].time_);
+        };
 
-        // Check for being too far ahead
-        while (index && time < keyFrames_[index].time_)
-            --index;
+        if (isFrameAtTime(index))
+            return true;
 
-        // Check for being too far behind
-        while (index < keyFrames_.size() - 1 && time >= keyFrames_[index + 1].time_)
+        if (index + 1 < numFrames && isFrameAtTime(index + 1))
+        {
             ++index;
+            return true;
+        }
 
+        // Hint is too far off, keyframes may be sparse after compression
+        static const auto compare = [](float lhs, const KeyFrame& rhs) { return lhs < rhs.time_; };
+        const auto iter = ea::upper_bound(keyFrames_.begin(), keyFrames_.end(), time, compare);
+        index = iter != keyFrames_.begin() ? static_cast<unsigned>(iter - keyFrames_.begin()) - 1 : 0;
         return true;
     }
 
@@ -85,6 +85,19 @@ RefCounted::~RefCounted()
     refCount_ = nullptr;
 }
 
+void RefCounted::RenewRefCount()
+{
+    assert(refCount_);
+    assert(refCount_->refs_ == 0);
+
+    refCount_->refs_ = -1;
+    if (ea::Internal::atomic_decrement(&refCount_->weakRefs_) == 0)
+        RefCount::Free(refCount_);
+
+    refCount_ = RefCount::Allocate();
+    refCount_->weakRefs_++;
+}
+
 int RefCounted::AddRef()
 {
     int refs = ea::Internal::atomic_increment(&refCount_->refs_);
@@ -120,11 +133,11 @@ int RefCounted::ReleaseRef()
             assert(api != nullptr);
             api->Dispose(this);
         }
-        delete this;
+        DeleteThis();
     }
 #else
     if (refs == 0)
-        delete this;
+        DeleteThis();
 #endif
     return refs;
 }
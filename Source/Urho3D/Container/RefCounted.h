@@ -109,6 +109,11 @@ public:
     }
 
 protected:
+    /// Destroy the object when the last reference is released. May be overridden to reuse the object instead.
+    virtual void DeleteThis() { delete this; }
+    /// Expire all weak references to the object and start reference counting from scratch. Used when the object is reused.
+    void RenewRefCount();
+
 #if URHO3D_CSHARP
     /// Returns handle to wrapper script object. This is scripting-runtime-dependent.
     void* GetScriptObject() const { return scriptObject_; }
@@ -141,6 +141,9 @@ Context::Context()
 
 Context::~Context()
 {
+    // Pooled objects may reference subsystems, destroy them while everything is still available.
+    ClearObjectPools();
+
     // Destroying resource cache does clear it, however some resources depend on resource cache being available when
     // destructor executes.
     if (auto* cache = GetSubsystem<ResourceCache>())
@@ -308,6 +311,12 @@ void Context::AddEventReceiver(Object* receiver, StringHash eventType)
     group->Add(receiver);
 }
 
+void Context::RemoveTypedEventReceiver(Object* receiver)
+{
+    for (const auto& [eventType, channel] : typedEventChannels_)
+        channel->Unsubscribe(receiver, true, nullptr);
+}
+
 void Context::AddEventReceiver(Object* receiver, Object* sender, StringHash eventType)
 {
     SharedPtr<EventReceiverGroup>& group = specificEventReceivers_[sender][eventType];
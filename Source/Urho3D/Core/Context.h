@@ -175,6 +175,20 @@ private:
     /// End event send. Clean up event receivers removed in the meanwhile.
     void EndSendEvent();
 
+    /// Return typed event channel, or null if not created yet.
+    TypedEventChannelBase* FindTypedEventChannel(StringHash eventType) const
+    {
+        auto iter = typedEventChannels_.find(eventType);
+        return iter != typedEventChannels_.end() ? iter->second.get() : nullptr;
+    }
+    /// Add typed event channel.
+    void AddTypedEventChannel(StringHash eventType, TypedEventChannelBase* channel)
+    {
+        typedEventChannels_[eventType].reset(channel);
+    }
+    /// Unsubscribe receiver from all typed events.
+    void RemoveTypedEventReceiver(Object* receiver);
+
     /// Set current event handler. Called by Object.
     void SetEventHandler(EventHandler* handler) { eventHandler_ = handler; }
 
@@ -184,6 +198,8 @@ private:
     ea::unordered_map<StringHash, SharedPtr<EventReceiverGroup> > eventReceivers_;
     /// Event receivers for specific senders' events.
     ea::unordered_map<Object*, ea::unordered_map<StringHash, SharedPtr<EventReceiverGroup> > > specificEventReceivers_;
+    /// Typed event channels.
+    ea::unordered_map<StringHash, ea::unique_ptr<TypedEventChannelBase>> typedEventChannels_;
     /// Event sender stack.
     ea::vector<Object*> eventSenders_;
     /// Event data stack.
@@ -46,12 +46,26 @@ URHO3D_EVENT(E_UPDATE, Update)
     URHO3D_PARAM(P_TIMESTEP, TimeStep);            // float
 }
 
+/// Application-wide logic update event. Typed version of E_UPDATE, sent before it.
+struct UpdateTypedEvent
+{
+    URHO3D_TYPED_EVENT(UpdateTypedEvent);
+    float timeStep_{};
+};
+
 /// Application-wide logic post-update event.
 URHO3D_EVENT(E_POSTUPDATE, PostUpdate)
 {
     URHO3D_PARAM(P_TIMESTEP, TimeStep);            // float
 }
 
+/// Application-wide logic post-update event. Typed version of E_POSTUPDATE, sent before it.
+struct PostUpdateTypedEvent
+{
+    URHO3D_TYPED_EVENT(PostUpdateTypedEvent);
+    float timeStep_{};
+};
+
 /// Render update event.
 URHO3D_EVENT(E_RENDERUPDATE, RenderUpdate)
 {
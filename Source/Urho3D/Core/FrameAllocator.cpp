@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Core/FrameAllocator.h"
+
+#include "Urho3D/Core/Mutex.h"
+#include "Urho3D/Core/WorkQueue.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Allocators of WorkQueue threads, indexed by thread index.
+ea::vector<ea::unique_ptr<LinearAllocator>> threadAllocators;
+/// Allocator shared by threads not owned by WorkQueue.
+LinearAllocator sharedAllocator;
+Mutex sharedAllocatorMutex;
+
+}
+
+LinearAllocator::LinearAllocator(unsigned blockSize)
+    : blockSize_(ea::max(blockSize, 1u))
+{
+}
+
+LinearAllocator::~LinearAllocator() = default;
+
+void* LinearAllocator::Allocate(unsigned size, unsigned alignment)
+{
+    URHO3D_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+    if (!blocks_.empty())
+    {
+        if (void* memory = AllocateInLastBlock(size, alignment))
+            return memory;
+    }
+
+    // New block always fits the allocation
+    AllocateBlock(size + alignment);
+    return AllocateInLastBlock(size, alignment);
+}
+
+void LinearAllocator::Reset()
+{
+    if (blocks_.size() > 1)
+    {
+        blocks_.clear();
+        AllocateBlock(capacity_);
+    }
+    offset_ = 0;
+    usedSize_ = 0;
+}
+
+void LinearAllocator::AllocateBlock(unsigned minSize)
+{
+    if (blocks_.empty())
+        capacity_ = 0;
+
+    Block& block = blocks_.emplace_back();
+    block.size_ = ea::max(minSize, blockSize_);
+    block.data_ = ea::make_unique<unsigned char[]>(block.size_);
+    capacity_ += block.size_;
+    offset_ = 0;
+}
+
+void* LinearAllocator::AllocateInLastBlock(unsigned size, unsigned alignment)
+{
+    const Block& block = blocks_.back();
+    const auto begin = reinterpret_cast<uintptr_t>(block.data_.get());
+    const uintptr_t aligned = (begin + offset_ + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    const auto newOffset = static_cast<unsigned>(aligned - begin) + size;
+    if (newOffset > block.size_)
+        return nullptr;
+
+    usedSize_ += newOffset - offset_;
+    offset_ = newOffset;
+    return reinterpret_cast<void*>(aligned);
+}
+
+void FrameAllocator::Initialize(unsigned numThreads)
+{
+    threadAllocators.clear();
+    for (unsigned i = 0; i < numThreads; ++i)
+        threadAllocators.push_back(ea::make_unique<LinearAllocator>());
+}
+
+void* FrameAllocator::Allocate(unsigned size, unsigned alignment)
+{
+    const unsigned threadIndex = WorkQueue::GetThreadIndex();
+    if (threadIndex < threadAllocators.size())
+        return threadAllocators[threadIndex]->Allocate(size, alignment);
+
+    MutexLock lock(sharedAllocatorMutex);
+    return sharedAllocator.Allocate(size, alignment);
+}
+
+void FrameAllocator::Reset()
+{
+    for (const auto& allocator : threadAllocators)
+        allocator->Reset();
+
+    MutexLock lock(sharedAllocatorMutex);
+    sharedAllocator.Reset();
+}
+
+unsigned FrameAllocator::GetUsedSize()
+{
+    unsigned result = 0;
+    for (const auto& allocator : threadAllocators)
+        result += allocator->GetUsedSize();
+
+    MutexLock lock(sharedAllocatorMutex);
+    return result + sharedAllocator.GetUsedSize();
+}
+
+}
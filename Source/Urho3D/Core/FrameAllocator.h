@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Urho3D/Urho3D.h"
+#include "Urho3D/Core/NonCopyable.h"
+
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Urho3D
+{
+
+/// Allocator that hands out memory linearly from big blocks and releases all of it at once. Not thread-safe.
+class URHO3D_API LinearAllocator : public NonCopyable
+{
+public:
+    /// Default size of the memory block.
+    static const unsigned DefaultBlockSize = 64 * 1024;
+
+    explicit LinearAllocator(unsigned blockSize = DefaultBlockSize);
+    ~LinearAllocator();
+
+    /// Allocate memory. Memory is never freed individually.
+    void* Allocate(unsigned size, unsigned alignment = alignof(std::max_align_t));
+    /// Release all allocations. Blocks are merged into one so the same amount of memory fits without allocation.
+    void Reset();
+
+    /// Return size of memory allocated since last reset.
+    unsigned GetUsedSize() const { return usedSize_; }
+    /// Return total size of memory blocks.
+    unsigned GetCapacity() const { return capacity_; }
+
+private:
+    struct Block
+    {
+        ea::unique_ptr<unsigned char[]> data_;
+        unsigned size_{};
+    };
+
+    /// Allocate new block that can fit the allocation.
+    void AllocateBlock(unsigned minSize);
+    /// Allocate memory in the last block. Return null if it doesn't fit.
+    void* AllocateInLastBlock(unsigned size, unsigned alignment);
+
+    unsigned blockSize_{};
+    ea::vector<Block> blocks_;
+    /// Offset in the last block.
+    unsigned offset_{};
+    unsigned usedSize_{};
+    unsigned capacity_{};
+};
+
+/// Per-thread linear allocators for transient data that lives until the end of the frame.
+/// Memory is allocated from the allocator of the current WorkQueue thread without any synchronization.
+/// Threads that are not owned by WorkQueue share one allocator guarded by mutex.
+/// All memory is released by Engine at the end of the frame: containers using it must not outlive the frame.
+class URHO3D_API FrameAllocator
+{
+public:
+    /// Create allocators for given number of threads. Should be called once WorkQueue is initialized.
+    static void Initialize(unsigned numThreads);
+    /// Allocate memory that is valid until the end of the frame. Thread-safe.
+    static void* Allocate(unsigned size, unsigned alignment = alignof(std::max_align_t));
+    /// Release memory of all threads. Should be called from main thread when no tasks are running.
+    static void Reset();
+
+    /// Return size of memory allocated by all threads since last reset.
+    static unsigned GetUsedSize();
+};
+
+/// EASTL allocator that uses FrameAllocator. Deallocation does nothing.
+class EASTLFrameAllocator
+{
+public:
+    EASTLFrameAllocator(const char* name = nullptr) {}
+    EASTLFrameAllocator(const EASTLFrameAllocator& other, const char* name) {}
+
+    void* allocate(size_t n, int flags = 0)
+    {
+        return FrameAllocator::Allocate(static_cast<unsigned>(n));
+    }
+
+    void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0)
+    {
+        alignment = ea::max(alignment, alignof(std::max_align_t));
+        if (offset == 0)
+            return FrameAllocator::Allocate(static_cast<unsigned>(n), static_cast<unsigned>(alignment));
+
+        // Reserve extra space so the memory at offset can be aligned
+        void* memory = FrameAllocator::Allocate(static_cast<unsigned>(n + alignment));
+        const auto base = reinterpret_cast<uintptr_t>(memory);
+        const uintptr_t aligned = (base + offset + alignment - 1) & ~(alignment - 1);
+        return reinterpret_cast<void*>(aligned - offset);
+    }
+
+    void deallocate(void* p, size_t n) {}
+
+    const char* get_name() const { return "FrameAllocator"; }
+    void set_name(const char* name) {}
+
+    bool operator==(const EASTLFrameAllocator& rhs) const { return true; }
+    bool operator!=(const EASTLFrameAllocator& rhs) const { return false; }
+};
+
+/// Vector that uses frame memory.
+template <class T> using FrameVector = ea::vector<T, EASTLFrameAllocator>;
+
+}
@@ -0,0 +1,254 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Core/FrameProfiler.h"
+
+#include "Urho3D/Core/Format.h"
+#include "Urho3D/Core/Mutex.h"
+#include "Urho3D/IO/Log.h"
+
+#include <EASTL/sort.h>
+#include <EASTL/unique_ptr.h>
+
+#include <chrono>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Per-thread accumulators. Written only by owner thread, read and reset by main thread.
+struct ThreadBuffer
+{
+    std::atomic<long long> ticks_[FrameProfiler::MaxZones]{};
+    std::atomic<unsigned> counts_[FrameProfiler::MaxZones]{};
+    std::atomic<long long> maxTicks_[FrameProfiler::MaxZones]{};
+};
+
+/// Collected statistics of one zone in one frame.
+struct ZoneFrameStats
+{
+    long long ticks_{};
+    unsigned count_{};
+    long long maxTicks_{};
+};
+
+struct ProfilerState
+{
+    Mutex mutex_;
+    ea::vector<const char*> zoneNames_;
+    std::atomic<unsigned> numZones_{};
+    ea::vector<ea::unique_ptr<ThreadBuffer>> threadBuffers_;
+
+    ea::vector<ea::vector<ZoneFrameStats>> history_;
+    unsigned numFrames_{};
+    unsigned dumpInterval_{};
+};
+
+ProfilerState& GetState()
+{
+    static ProfilerState state;
+    return state;
+}
+
+ThreadBuffer& GetThreadBuffer()
+{
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer)
+    {
+        ProfilerState& state = GetState();
+        MutexLock lock(state.mutex_);
+        buffer = state.threadBuffers_.emplace_back(ea::make_unique<ThreadBuffer>()).get();
+    }
+    return *buffer;
+}
+
+double TicksToMs(double ticks)
+{
+    using Period = std::chrono::steady_clock::period;
+    return ticks * 1000.0 * Period::num / Period::den;
+}
+
+ea::vector<FrameProfilerZoneStats> SortStats(ea::vector<FrameProfilerZoneStats> stats)
+{
+    ea::sort(stats.begin(), stats.end(),
+        [](const FrameProfilerZoneStats& lhs, const FrameProfilerZoneStats& rhs) { return lhs.totalMs_ > rhs.totalMs_; });
+    return stats;
+}
+
+}
+
+std::atomic_bool FrameProfiler::enabled_{true};
+
+unsigned FrameProfiler::RegisterZone(const char* name)
+{
+    ProfilerState& state = GetState();
+    MutexLock lock(state.mutex_);
+
+    const unsigned index = state.zoneNames_.size();
+    if (index >= MaxZones)
+        return MaxZones;
+
+    state.zoneNames_.push_back(name);
+    state.numZones_.store(index + 1, std::memory_order_release);
+    return index;
+}
+
+void FrameProfiler::SetDumpInterval(unsigned numFrames)
+{
+    ProfilerState& state = GetState();
+    MutexLock lock(state.mutex_);
+    state.dumpInterval_ = numFrames;
+}
+
+long long FrameProfiler::GetTicks()
+{
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+void FrameProfiler::AddSample(unsigned zone, long long ticks)
+{
+    if (zone >= MaxZones)
+        return;
+
+    // Counters may be reset by main thread at any time. Max check is not atomic, but only owner thread raises it
+    ThreadBuffer& buffer = GetThreadBuffer();
+    buffer.ticks_[zone].fetch_add(ticks, std::memory_order_relaxed);
+    buffer.counts_[zone].fetch_add(1, std::memory_order_relaxed);
+    if (ticks > buffer.maxTicks_[zone].load(std::memory_order_relaxed))
+        buffer.maxTicks_[zone].store(ticks, std::memory_order_relaxed);
+}
+
+void FrameProfiler::EndFrame()
+{
+    ProfilerState& state = GetState();
+    const unsigned numZones = state.numZones_.load(std::memory_order_acquire);
+
+    ea::vector<ZoneFrameStats> frameStats(numZones);
+    unsigned dumpInterval{};
+    {
+        MutexLock lock(state.mutex_);
+        for (const auto& buffer : state.threadBuffers_)
+        {
+            for (unsigned zone = 0; zone < numZones; ++zone)
+            {
+                ZoneFrameStats& stats = frameStats[zone];
+                stats.ticks_ += buffer->ticks_[zone].exchange(0, std::memory_order_relaxed);
+                stats.count_ += buffer->counts_[zone].exchange(0, std::memory_order_relaxed);
+                stats.maxTicks_ = ea::max(stats.maxTicks_, buffer->maxTicks_[zone].exchange(0, std::memory_order_relaxed));
+            }
+        }
+
+        if (state.history_.size() < HistorySize)
+            state.history_.resize(HistorySize);
+        state.history_[state.numFrames_ % HistorySize] = ea::move(frameStats);
+        ++state.numFrames_;
+        dumpInterval = state.dumpInterval_;
+    }
+
+    if (dumpInterval != 0 && state.numFrames_ % dumpInterval == 0)
+        URHO3D_LOGINFO("Frame profiler statistics:\n{}", FormatStats(GetAverageStats(), 20));
+}
+
+void FrameProfiler::ClearHistory()
+{
+    ProfilerState& state = GetState();
+    MutexLock lock(state.mutex_);
+    state.history_.clear();
+    state.numFrames_ = 0;
+}
+
+ea::vector<FrameProfilerZoneStats> FrameProfiler::GetFrameStats()
+{
+    ProfilerState& state = GetState();
+    MutexLock lock(state.mutex_);
+
+    ea::vector<FrameProfilerZoneStats> result;
+    if (state.numFrames_ == 0)
+        return result;
+
+    const auto& frameStats = state.history_[(state.numFrames_ - 1) % HistorySize];
+    for (unsigned zone = 0; zone < frameStats.size(); ++zone)
+    {
+        const ZoneFrameStats& stats = frameStats[zone];
+        if (stats.count_ != 0)
+        {
+            result.push_back(FrameProfilerZoneStats{
+                state.zoneNames_[zone], static_cast<double>(stats.count_), TicksToMs(stats.ticks_), TicksToMs(stats.maxTicks_)});
+        }
+    }
+    return SortStats(ea::move(result));
+}
+
+ea::vector<FrameProfilerZoneStats> FrameProfiler::GetAverageStats()
+{
+    ProfilerState& state = GetState();
+    MutexLock lock(state.mutex_);
+
+    const unsigned numFrames = ea::min(state.numFrames_, HistorySize);
+    if (numFrames == 0)
+        return {};
+
+    ea::vector<FrameProfilerZoneStats> result(state.zoneNames_.size());
+    for (unsigned zone = 0; zone < result.size(); ++zone)
+        result[zone].name_ = state.zoneNames_[zone];
+
+    for (unsigned frame = 0; frame < numFrames; ++frame)
+    {
+        const auto& frameStats = state.history_[frame];
+        for (unsigned zone = 0; zone < frameStats.size(); ++zone)
+        {
+            const ZoneFrameStats& stats = frameStats[zone];
+            FrameProfilerZoneStats& dest = result[zone];
+            dest.count_ += stats.count_;
+            dest.totalMs_ += TicksToMs(stats.ticks_);
+            dest.maxMs_ = ea::max(dest.maxMs_, TicksToMs(stats.maxTicks_));
+        }
+    }
+
+    ea::erase_if(result, [](const FrameProfilerZoneStats& stats) { return stats.count_ == 0; });
+    for (FrameProfilerZoneStats& stats : result)
+    {
+        stats.count_ /= numFrames;
+        stats.totalMs_ /= numFrames;
+    }
+    return SortStats(ea::move(result));
+}
+
+ea::string FrameProfiler::FormatStats(const ea::vector<FrameProfilerZoneStats>& stats, unsigned maxZones)
+{
+    ea::string result;
+    result += Format("{:<40} {:>10} {:>10} {:>10}\n", "Zone", "Count", "Total, ms", "Max, ms");
+    const unsigned numZones = ea::min<unsigned>(stats.size(), maxZones);
+    for (unsigned i = 0; i < numZones; ++i)
+    {
+        const FrameProfilerZoneStats& zone = stats[i];
+        result += Format("{:<40} {:>10.1f} {:>10.3f} {:>10.3f}\n", zone.name_, zone.count_, zone.totalMs_, zone.maxMs_);
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,116 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "Urho3D/Urho3D.h"
+#include "Urho3D/Math/MathDefs.h"
+
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+#include <atomic>
+
+namespace Urho3D
+{
+
+/// Aggregated statistics of profiler zone.
+struct FrameProfilerZoneStats
+{
+    /// Zone name.
+    const char* name_{};
+    /// Number of times the zone was entered, from all threads.
+    double count_{};
+    /// Total time spent in the zone in milliseconds, from all threads.
+    double totalMs_{};
+    /// Max time of single zone execution in milliseconds.
+    double maxMs_{};
+};
+
+/// Built-in profiler that aggregates time and counts of URHO3D_PROFILE zones per frame.
+/// Unlike Tracy, it doesn't need external viewer and is intended to collect frame-phase metrics in production.
+/// Zones are accumulated in per-thread buffers without locks and collected by Engine at the end of the frame.
+/// Time is inclusive: nested zones are counted both on their own and as part of the parent zone.
+class URHO3D_API FrameProfiler
+{
+public:
+    /// Max number of unique zones. Zones registered above the limit are ignored.
+    static const unsigned MaxZones = 2048;
+    /// Number of frames in the history used for average statistics.
+    static const unsigned HistorySize = 60;
+
+    /// Register zone name and return zone index. Name should be string literal. Thread-safe.
+    static unsigned RegisterZone(const char* name);
+    /// Enable or disable profiling. Enabled by default.
+    static void SetEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    /// Return whether profiling is enabled.
+    static bool IsEnabled() { return enabled_.load(std::memory_order_relaxed); }
+    /// Set number of frames between dumps of average statistics to the log. Zero disables dumps.
+    static void SetDumpInterval(unsigned numFrames);
+
+    /// Collect statistics of all threads and store them as the last frame. Should be called from main thread.
+    static void EndFrame();
+    /// Clear collected statistics.
+    static void ClearHistory();
+
+    /// Return statistics of the last frame. Only entered zones are returned, sorted by total time.
+    static ea::vector<FrameProfilerZoneStats> GetFrameStats();
+    /// Return statistics averaged over the history of frames, sorted by total time.
+    static ea::vector<FrameProfilerZoneStats> GetAverageStats();
+    /// Format statistics as a human-readable table with up to given number of zones.
+    static ea::string FormatStats(const ea::vector<FrameProfilerZoneStats>& stats, unsigned maxZones = M_MAX_UNSIGNED);
+
+    /// Return current time in profiler ticks.
+    static long long GetTicks();
+    /// Add zone execution time in ticks for the current thread.
+    static void AddSample(unsigned zone, long long ticks);
+
+private:
+    static std::atomic_bool enabled_;
+};
+
+/// Scope guard that measures the time of profiler zone.
+class FrameProfilerScope
+{
+public:
+    explicit FrameProfilerScope(unsigned zone)
+        : zone_(zone)
+        , startTicks_(FrameProfiler::IsEnabled() ? FrameProfiler::GetTicks() : 0)
+    {
+    }
+
+    ~FrameProfilerScope()
+    {
+        if (startTicks_ != 0)
+            FrameProfiler::AddSample(zone_, FrameProfiler::GetTicks() - startTicks_);
+    }
+
+    FrameProfilerScope(const FrameProfilerScope&) = delete;
+    FrameProfilerScope& operator=(const FrameProfilerScope&) = delete;
+
+private:
+    unsigned zone_{};
+    long long startTicks_{};
+};
+
+}
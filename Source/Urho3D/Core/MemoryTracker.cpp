@@ -0,0 +1,237 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Core/MemoryTracker.h"
+
+#include "Urho3D/Core/Format.h"
+#include "Urho3D/Core/Mutex.h"
+
+#include <EASTL/sort.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+struct TagCounters
+{
+    std::atomic<long long> liveBytes_{};
+    std::atomic<long long> peakBytes_{};
+    std::atomic<unsigned long long> numAllocations_{};
+    std::atomic<unsigned long long> numDeallocations_{};
+    std::atomic<unsigned long long> allocatedBytes_{};
+};
+
+/// Counters of the previous frame, used to calculate per-frame rates.
+struct TagFrameCounters
+{
+    unsigned long long numAllocations_{};
+    unsigned long long allocatedBytes_{};
+    unsigned long long frameAllocations_{};
+    unsigned long long frameBytes_{};
+};
+
+/// Header of the memory block allocated by AllocateTracked, keeps alignment of malloc.
+struct alignas(std::max_align_t) TrackedBlockHeader
+{
+    size_t size_{};
+    bool tracked_{};
+};
+
+/// State has only fixed-size members so allocations may be tracked during static destruction.
+struct TrackerState
+{
+    Mutex mutex_;
+    const char* tagNames_[MemoryTracker::MaxTags]{};
+    std::atomic<unsigned> numTags_{};
+    TagCounters counters_[MemoryTracker::MaxTags];
+    TagFrameCounters frameCounters_[MemoryTracker::MaxTags];
+};
+
+TrackerState& GetState()
+{
+    static TrackerState state;
+    return state;
+}
+
+void AddAllocation(unsigned tag, size_t size)
+{
+    TagCounters& counters = GetState().counters_[tag];
+    counters.numAllocations_.fetch_add(1, std::memory_order_relaxed);
+    counters.allocatedBytes_.fetch_add(size, std::memory_order_relaxed);
+
+    const long long liveBytes = counters.liveBytes_.fetch_add(size, std::memory_order_relaxed) + size;
+    long long peakBytes = counters.peakBytes_.load(std::memory_order_relaxed);
+    while (liveBytes > peakBytes
+        && !counters.peakBytes_.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed))
+    {
+    }
+}
+
+void RemoveAllocation(unsigned tag, size_t size)
+{
+    TagCounters& counters = GetState().counters_[tag];
+    counters.numDeallocations_.fetch_add(1, std::memory_order_relaxed);
+    counters.liveBytes_.fetch_sub(size, std::memory_order_relaxed);
+}
+
+}
+
+std::atomic_bool MemoryTracker::enabled_{true};
+
+unsigned MemoryTracker::RegisterTag(const char* name)
+{
+    TrackerState& state = GetState();
+    MutexLock lock(state.mutex_);
+
+    // Same tag may be registered from different modules
+    const unsigned numTags = state.numTags_.load(std::memory_order_relaxed);
+    for (unsigned tag = 0; tag < numTags; ++tag)
+    {
+        if (strcmp(state.tagNames_[tag], name) == 0)
+            return tag;
+    }
+
+    if (numTags >= MaxTags)
+        return MaxTags;
+
+    state.tagNames_[numTags] = name;
+    state.numTags_.store(numTags + 1, std::memory_order_release);
+    return numTags;
+}
+
+void MemoryTracker::TrackAllocation(unsigned tag, size_t size)
+{
+    if (tag < MaxTags && IsEnabled())
+        AddAllocation(tag, size);
+}
+
+void MemoryTracker::TrackDeallocation(unsigned tag, size_t size)
+{
+    if (tag < MaxTags && IsEnabled())
+        RemoveAllocation(tag, size);
+}
+
+void* MemoryTracker::AllocateTracked(unsigned tag, size_t size)
+{
+    void* block = malloc(sizeof(TrackedBlockHeader) + size);
+    if (!block)
+        return nullptr;
+
+    // Remember whether the block was tracked so toggling tracking doesn't break the counters
+    auto header = new (block) TrackedBlockHeader{size, tag < MaxTags && IsEnabled()};
+    if (header->tracked_)
+        AddAllocation(tag, size);
+    return header + 1;
+}
+
+void MemoryTracker::FreeTracked(unsigned tag, void* ptr)
+{
+    if (!ptr)
+        return;
+
+    auto header = static_cast<TrackedBlockHeader*>(ptr) - 1;
+    if (header->tracked_)
+        RemoveAllocation(tag, header->size_);
+    free(header);
+}
+
+void MemoryTracker::EndFrame()
+{
+    TrackerState& state = GetState();
+    MutexLock lock(state.mutex_);
+
+    const unsigned numTags = state.numTags_.load(std::memory_order_acquire);
+    for (unsigned tag = 0; tag < numTags; ++tag)
+    {
+        const TagCounters& counters = state.counters_[tag];
+        TagFrameCounters& frameCounters = state.frameCounters_[tag];
+
+        const unsigned long long numAllocations = counters.numAllocations_.load(std::memory_order_relaxed);
+        const unsigned long long allocatedBytes = counters.allocatedBytes_.load(std::memory_order_relaxed);
+        frameCounters.frameAllocations_ = numAllocations - frameCounters.numAllocations_;
+        frameCounters.frameBytes_ = allocatedBytes - frameCounters.allocatedBytes_;
+        frameCounters.numAllocations_ = numAllocations;
+        frameCounters.allocatedBytes_ = allocatedBytes;
+    }
+}
+
+ea::vector<MemoryTagStats> MemoryTracker::GetStats()
+{
+    TrackerState& state = GetState();
+    MutexLock lock(state.mutex_);
+
+    ea::vector<MemoryTagStats> result;
+    const unsigned numTags = state.numTags_.load(std::memory_order_acquire);
+    for (unsigned tag = 0; tag < numTags; ++tag)
+    {
+        const TagCounters& counters = state.counters_[tag];
+        const TagFrameCounters& frameCounters = state.frameCounters_[tag];
+
+        const unsigned long long numAllocations = counters.numAllocations_.load(std::memory_order_relaxed);
+        if (numAllocations == 0)
+            continue;
+
+        MemoryTagStats& stats = result.emplace_back();
+        stats.name_ = state.tagNames_[tag];
+        stats.liveBytes_ = counters.liveBytes_.load(std::memory_order_relaxed);
+        stats.peakBytes_ = counters.peakBytes_.load(std::memory_order_relaxed);
+        stats.liveAllocations_ = static_cast<long long>(
+            numAllocations - counters.numDeallocations_.load(std::memory_order_relaxed));
+        stats.frameAllocations_ = frameCounters.frameAllocations_;
+        stats.frameBytes_ = frameCounters.frameBytes_;
+    }
+
+    ea::sort(result.begin(), result.end(), [](const MemoryTagStats& lhs, const MemoryTagStats& rhs)
+    {
+        if (lhs.liveBytes_ != rhs.liveBytes_)
+            return lhs.liveBytes_ > rhs.liveBytes_;
+        return lhs.liveAllocations_ > rhs.liveAllocations_;
+    });
+    return result;
+}
+
+ea::string MemoryTracker::FormatStats(const ea::vector<MemoryTagStats>& stats, unsigned maxTags)
+{
+    ea::string result;
+    result += Format("{:<32} {:>12} {:>12} {:>10} {:>10} {:>12}\n",
+        "Tag", "Live, KB", "Peak, KB", "Allocs", "Allocs/f", "Bytes/f");
+    const unsigned numTags = ea::min<unsigned>(stats.size(), maxTags);
+    for (unsigned i = 0; i < numTags; ++i)
+    {
+        const MemoryTagStats& tag = stats[i];
+        result += Format("{:<32} {:>12.1f} {:>12.1f} {:>10} {:>10} {:>12}\n", tag.name_, tag.liveBytes_ / 1024.0,
+            tag.peakBytes_ / 1024.0, tag.liveAllocations_, tag.frameAllocations_, tag.frameBytes_);
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,145 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "Urho3D/Urho3D.h"
+#include "Urho3D/Math/MathDefs.h"
+
+#include <EASTL/allocator.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+#include <atomic>
+
+namespace Urho3D
+{
+
+/// Statistics of memory tag.
+struct MemoryTagStats
+{
+    /// Tag name.
+    const char* name_{};
+    /// Number of bytes currently allocated.
+    long long liveBytes_{};
+    /// Max number of bytes allocated at once.
+    long long peakBytes_{};
+    /// Number of allocations that are not freed yet.
+    long long liveAllocations_{};
+    /// Number of allocations during the last frame.
+    unsigned long long frameAllocations_{};
+    /// Number of bytes allocated during the last frame.
+    unsigned long long frameBytes_{};
+};
+
+/// Accounting of heap memory by tags, e.g. subsystem or resource type.
+/// Memory is reported explicitly by tagged allocators and instrumented code, untagged allocations are not counted.
+/// Some tags only count allocations without the size, e.g. Variant and Object.
+/// Counters are atomic, so allocations may be tracked from any thread.
+class URHO3D_API MemoryTracker
+{
+public:
+    /// Max number of tags. Tags registered above the limit are ignored.
+    static const unsigned MaxTags = 256;
+
+    /// Register tag name and return tag index. Same name returns same index. Name should be string literal. Thread-safe.
+    static unsigned RegisterTag(const char* name);
+    /// Enable or disable tracking. Enabled by default.
+    static void SetEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    /// Return whether tracking is enabled.
+    static bool IsEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    /// Track allocation of given size.
+    static void TrackAllocation(unsigned tag, size_t size);
+    /// Track deallocation of given size.
+    static void TrackDeallocation(unsigned tag, size_t size);
+    /// Allocate memory from the heap and track it. Used as custom allocator of third-party libraries. Thread-safe.
+    static void* AllocateTracked(unsigned tag, size_t size);
+    /// Free memory allocated by AllocateTracked with the same tag. Thread-safe.
+    static void FreeTracked(unsigned tag, void* ptr);
+
+    /// Update per-frame allocation rates. Should be called from main thread.
+    static void EndFrame();
+    /// Return statistics of all tags that were ever used, sorted by live bytes.
+    static ea::vector<MemoryTagStats> GetStats();
+    /// Format statistics as a human-readable table with up to given number of tags.
+    static ea::string FormatStats(const ea::vector<MemoryTagStats>& stats, unsigned maxTags = M_MAX_UNSIGNED);
+
+private:
+    static std::atomic_bool enabled_;
+};
+
+/// EASTL allocator that reports to MemoryTracker.
+/// Tag is a type with static member `Name`, so containers with the allocator can be default-constructed.
+template <class Tag>
+class TaggedAllocator : public EASTLAllocatorType
+{
+public:
+    explicit TaggedAllocator(const char* name = EASTL_NAME_VAL(Tag::Name))
+        : EASTLAllocatorType(name)
+    {
+    }
+
+    TaggedAllocator(const TaggedAllocator& other, const char* name)
+        : EASTLAllocatorType(other, name)
+    {
+    }
+
+    void* allocate(size_t n, int flags = 0)
+    {
+        MemoryTracker::TrackAllocation(GetTag(), n);
+        return EASTLAllocatorType::allocate(n, flags);
+    }
+
+    void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0)
+    {
+        MemoryTracker::TrackAllocation(GetTag(), n);
+        return EASTLAllocatorType::allocate(n, alignment, offset, flags);
+    }
+
+    void deallocate(void* p, size_t n)
+    {
+        if (p)
+            MemoryTracker::TrackDeallocation(GetTag(), n);
+        EASTLAllocatorType::deallocate(p, n);
+    }
+
+    /// Return tag index.
+    static unsigned GetTag()
+    {
+        static const unsigned tag = MemoryTracker::RegisterTag(Tag::Name);
+        return tag;
+    }
+
+    bool operator==(const TaggedAllocator&) const { return true; }
+    bool operator!=(const TaggedAllocator&) const { return false; }
+};
+
+}
+
+/// Declare memory tag type for TaggedAllocator.
+#define URHO3D_MEMORY_TAG(type, name) \
+    struct type \
+    { \
+        static constexpr const char* Name = name; \
+    }
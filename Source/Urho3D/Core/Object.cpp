@@ -23,6 +23,7 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/MemoryTracker.h"
 #include "../Core/ProcessUtils.h"
 #include "../Core/Thread.h"
 #include "../Core/Profiler.h"
@@ -35,14 +36,28 @@
 namespace Urho3D
 {
 
+static unsigned GetObjectMemoryTag()
+{
+    static const unsigned tag = MemoryTracker::RegisterTag("Object");
+    return tag;
+}
+
 Object::Object(Context* context) :
     context_(context),
     blockEvents_(false)
 {
     assert(context_);
+    // Size of the derived object is unknown, only the number of objects is tracked
+    MemoryTracker::TrackAllocation(GetObjectMemoryTag(), 0);
 }
 
 Object::~Object()
+{
+    RemoveAllEventSubscriptions();
+    MemoryTracker::TrackDeallocation(GetObjectMemoryTag(), 0);
+}
+
+void Object::RemoveAllEventSubscriptions()
 {
     if (!context_.Expired())
     {
@@ -203,6 +218,13 @@ void Object::UnsubscribeFromEvents(Object* sender)
 
 void Object::UnsubscribeFromAllEvents()
 {
+    if (hasTypedEventHandlers_)
+    {
+        hasTypedEventHandlers_ = false;
+        context_->RemoveTypedEventReceiver(this);
+    }
+
+
     for (;;)
     {
         auto handler = eventHandlers_.begin();
@@ -264,13 +286,7 @@ void Object::SendEvent(StringHash eventType)
 
 void Object::SendEvent(StringHash eventType, VariantMap& eventData)
 {
-    if (!Thread::IsMainThread())
-    {
-        URHO3D_LOGERROR("Sending events is only supported from the main thread");
-        return;
-    }
-
-    if (blockEvents_)
+    if (!CanSendEvents())
         return;
 
 #if URHO3D_PROFILING
@@ -450,6 +466,27 @@ void Object::RemoveEventSender(Object* sender)
     }
 }
 
+TypedEventChannelBase* Object::FindTypedEventChannel(StringHash eventType) const
+{
+    return context_->FindTypedEventChannel(eventType);
+}
+
+void Object::AddTypedEventChannel(StringHash eventType, TypedEventChannelBase* channel)
+{
+    context_->AddTypedEventChannel(eventType, channel);
+}
+
+bool Object::CanSendEvents() const
+{
+    if (!Thread::IsMainThread())
+    {
+        URHO3D_LOGERROR("Sending events is only supported from the main thread");
+        return false;
+    }
+
+    return !blockEvents_;
+}
+
 StringHashRegister& GetEventNameRegister()
 {
     static StringHashRegister eventNameRegister(false /*non thread safe*/);
@@ -42,6 +42,8 @@ class Archive;
 class ArchiveBlock;
 class Context;
 class EventHandler;
+class TypedEventChannelBase;
+template <class T> class TypedEventChannel;
 
 #define URHO3D_OBJECT(typeName, baseTypeName) \
     public: \
@@ -54,6 +56,17 @@ class EventHandler;
         static const ea::string& GetTypeNameStatic() { return GetTypeInfoStatic()->GetTypeName(); } \
         static const Urho3D::TypeInfo* GetTypeInfoStatic() { static const Urho3D::TypeInfo typeInfoStatic(#typeName, BaseClassName::GetTypeInfoStatic()); return &typeInfoStatic; }
 
+/// Declare typed event inside the payload struct. Typed events are dispatched without VariantMap.
+#define URHO3D_TYPED_EVENT(typeName) \
+    static Urho3D::StringHash GetEventTypeStatic() { static const Urho3D::StringHash eventType(Urho3D::GetEventNameRegister().RegisterString(#typeName)); return eventType; }
+
+/// Whether the type is declared as typed event payload.
+template <class T, class = void> struct IsTypedEvent : ea::false_type {};
+template <class T> struct IsTypedEvent<T, ea::void_t<decltype(T::GetEventTypeStatic())>> : ea::true_type {};
+
+/// Get register of event names.
+URHO3D_API StringHashRegister& GetEventNameRegister();
+
 /// Base class for objects with type identification, subsystem access and event sending/receiving capability.
 /// @templateversion
 class URHO3D_API Object : public RefCounted
@@ -101,6 +114,12 @@ public:
     template <class T> void SubscribeToEvent(StringHash eventType, T handler);
     /// Subscribe to a specific sender's event.
     template <class T> void SubscribeToEvent(Object* sender, StringHash eventType, T handler);
+    /// Subscribe to a typed event that can be sent by any sender.
+    template <class Event, class T> ea::enable_if_t<IsTypedEvent<Event>::value> SubscribeToEvent(T handler);
+    /// Subscribe to a specific sender's typed event.
+    template <class Event, class T> ea::enable_if_t<IsTypedEvent<Event>::value> SubscribeToEvent(Object* sender, T handler);
+    /// Unsubscribe from a typed event.
+    template <class Event> ea::enable_if_t<IsTypedEvent<Event>::value> UnsubscribeFromEvent();
     /// Unsubscribe from an event.
     void UnsubscribeFromEvent(StringHash eventType);
     /// Unsubscribe from a specific sender's event.
@@ -117,6 +136,8 @@ public:
     void SendEvent(StringHash eventType);
     /// Send event with parameters to all subscribers.
     void SendEvent(StringHash eventType, VariantMap& eventData);
+    /// Send typed event to all subscribers of the event type. Doesn't allocate.
+    template <class Event> ea::enable_if_t<IsTypedEvent<Event>::value> SendEvent(const Event& event);
     /// Return a preallocated map for event data. Used for optimization to avoid constant re-allocation of event data maps.
     VariantMap& GetEventDataMap() const;
     /// Send event with variadic parameter pairs to all subscribers. The parameters are (paramID, paramValue) pairs.
@@ -149,8 +170,13 @@ public:
     /// Return whether has subscribed to a specific sender's event.
     bool HasSubscribedToEvent(Object* sender, StringHash eventType) const;
 
+    /// Return whether has subscribed to a typed event.
+    template <class Event> ea::enable_if_t<IsTypedEvent<Event>::value, bool> HasSubscribedToEvent() const;
+    /// Return whether there are any subscribers to the typed event. May be used to skip payload preparation.
+    template <class Event> ea::enable_if_t<IsTypedEvent<Event>::value, bool> HasEventSubscribers() const;
+
     /// Return whether has subscribed to any event.
-    bool HasEventHandlers() const { return !eventHandlers_.empty(); }
+    bool HasEventHandlers() const { return !eventHandlers_.empty() || hasTypedEventHandlers_; }
 
     /// Template version of returning a subsystem.
     template <class T> T* GetSubsystem() const;
@@ -166,6 +192,9 @@ public:
     bool GetBlockEvents() const { return blockEvents_; }
 
 protected:
+    /// Unsubscribe from all events and remove subscriptions of other objects to events sent by this object.
+    void RemoveAllEventSubscriptions();
+
     /// Execution context.
     WeakPtr<Context> context_;
 
@@ -188,12 +217,22 @@ private:
     ea::intrusive_list<EventHandler>::iterator EraseEventHandler(ea::intrusive_list<EventHandler>::iterator handlerIter);
     /// Remove event handlers related to a specific sender.
     void RemoveEventSender(Object* sender);
+    /// Return typed event channel, or null if there were no subscriptions yet.
+    TypedEventChannelBase* FindTypedEventChannel(StringHash eventType) const;
+    /// Return typed event channel, create if doesn't exist.
+    template <class Event> TypedEventChannel<Event>& GetOrCreateTypedEventChannel();
+    /// Add new typed event channel. Context owns the channel.
+    void AddTypedEventChannel(StringHash eventType, TypedEventChannelBase* channel);
+    /// Return whether it is allowed to send events now.
+    bool CanSendEvents() const;
 
     /// Event handlers. Sender is null for non-specific handlers.
     ea::intrusive_list<EventHandler> eventHandlers_;
 
     /// Block object from sending and receiving any events.
     bool blockEvents_;
+    /// Whether the object has ever subscribed to a typed event.
+    bool hasTypedEventHandlers_{};
 };
 
 template <class T> T* Object::GetSubsystem() const { return GetSubsystems().Get<T>(); }
@@ -303,6 +342,251 @@ private:
     HandlerFunction handler_;
 };
 
+/// Base class of typed event channel. One channel per event type is owned by Context.
+class URHO3D_API TypedEventChannelBase
+{
+public:
+    virtual ~TypedEventChannelBase() = default;
+    /// Unsubscribe specific receiver from the event, optionally only from the specific sender.
+    virtual void Unsubscribe(Object* receiver, bool anySender, Object* sender) = 0;
+    /// Return whether the receiver has subscribed to the event.
+    virtual bool HasSubscription(const Object* receiver) const = 0;
+    /// Return whether the channel has any subscriptions.
+    virtual bool HasSubscriptions() const = 0;
+};
+
+/// Typed event channel. Handlers receive payload struct directly instead of VariantMap.
+/// Subscriptions are never resized during dispatch, so handlers may subscribe and unsubscribe freely.
+template <class T>
+class TypedEventChannel : public TypedEventChannelBase
+{
+public:
+    using HandlerFunction = ea::function<void(Object* receiver, const T& event)>;
+
+    /// Subscribe receiver to the event. Replaces existing subscription with the same sender.
+    void Subscribe(Object* receiver, Object* sender, HandlerFunction handler)
+    {
+        Unsubscribe(receiver, false, sender);
+        auto subscription = ea::make_unique<Subscription>();
+        subscription->receiver_ = receiver;
+        subscription->sender_ = sender;
+        subscription->hasSender_ = sender != nullptr;
+        subscription->handler_ = ea::move(handler);
+        // Don't invoke new subscriptions until the end of current invocation
+        if (invocationDepth_ > 0)
+            pendingSubscriptions_.push_back(ea::move(subscription));
+        else
+            subscriptions_.push_back(ea::move(subscription));
+    }
+
+    void Unsubscribe(Object* receiver, bool anySender, Object* sender) override
+    {
+        const auto matches = [&](const ea::unique_ptr<Subscription>& subscription)
+        {
+            return subscription->receiver_.Get() == receiver
+                && (anySender || (subscription->hasSender_ == (sender != nullptr) && subscription->sender_.Get() == sender));
+        };
+
+        // Receiver may be already expired if called from the destructor
+        for (auto& subscription : subscriptions_)
+        {
+            if (matches(subscription))
+                subscription->receiver_ = nullptr;
+            if (!subscription->receiver_)
+                hasExpiredSubscriptions_ = true;
+        }
+        ea::erase_if(pendingSubscriptions_, matches);
+
+        if (invocationDepth_ == 0)
+            RemoveExpiredSubscriptions();
+    }
+
+    bool HasSubscription(const Object* receiver) const override
+    {
+        const auto isReceiver = [&](const ea::unique_ptr<Subscription>& subscription)
+        { return subscription->receiver_.Get() == receiver; };
+        return ea::any_of(subscriptions_.begin(), subscriptions_.end(), isReceiver)
+            || ea::any_of(pendingSubscriptions_.begin(), pendingSubscriptions_.end(), isReceiver);
+    }
+
+    bool HasSubscriptions() const override { return !subscriptions_.empty() || !pendingSubscriptions_.empty(); }
+
+    /// Invoke all handlers that match the sender in order of subscription.
+    /// Unlike string-hash events, both specific and non-specific handlers of the same receiver are invoked.
+    void Send(Object* sender, const T& event)
+    {
+        WeakPtr<Object> self(sender);
+
+        ++invocationDepth_;
+        const unsigned numSubscriptions = subscriptions_.size();
+        for (unsigned i = 0; i < numSubscriptions; ++i)
+        {
+            // Subscription is kept alive until the end of invocation even if unsubscribed
+            Subscription& subscription = *subscriptions_[i];
+            Object* receiver = subscription.receiver_.Get();
+            if (!receiver)
+            {
+                hasExpiredSubscriptions_ = true;
+                continue;
+            }
+
+            if (subscription.hasSender_)
+            {
+                Object* subscriptionSender = subscription.sender_.Get();
+                if (!subscriptionSender)
+                {
+                    subscription.receiver_ = nullptr;
+                    hasExpiredSubscriptions_ = true;
+                }
+                if (subscriptionSender != sender)
+                    continue;
+            }
+
+            if (receiver->GetBlockEvents())
+                continue;
+
+            subscription.handler_(receiver, event);
+
+            // If sender has been destroyed as a result of event handling, exit
+            if (self.Expired())
+                break;
+        }
+        --invocationDepth_;
+
+        if (invocationDepth_ == 0)
+        {
+            RemoveExpiredSubscriptions();
+            for (auto& subscription : pendingSubscriptions_)
+                subscriptions_.push_back(ea::move(subscription));
+            pendingSubscriptions_.clear();
+        }
+    }
+
+private:
+    struct Subscription
+    {
+        WeakPtr<Object> receiver_;
+        WeakPtr<Object> sender_;
+        bool hasSender_{};
+        HandlerFunction handler_;
+    };
+
+    void RemoveExpiredSubscriptions()
+    {
+        if (!hasExpiredSubscriptions_)
+            return;
+        hasExpiredSubscriptions_ = false;
+        ea::erase_if(subscriptions_,
+            [](const ea::unique_ptr<Subscription>& subscription) { return !subscription->receiver_; });
+    }
+
+    ea::vector<ea::unique_ptr<Subscription>> subscriptions_;
+    ea::vector<ea::unique_ptr<Subscription>> pendingSubscriptions_;
+    unsigned invocationDepth_{};
+    bool hasExpiredSubscriptions_{};
+};
+
+/// Wrap typed event handler of flexible signature.
+template <class Event, class T> typename TypedEventChannel<Event>::HandlerFunction WrapTypedEventHandler(T&& handler)
+{
+    if constexpr (ea::is_member_function_pointer_v<T>)
+    {
+        using ObjectType = MemberFunctionObject<T>;
+
+        static constexpr bool hasEvent = ea::is_invocable_r_v<void, T, ObjectType*, const Event&>;
+        static constexpr bool hasNone = ea::is_invocable_r_v<void, T, ObjectType*>;
+        static_assert(hasEvent || hasNone, "Invalid handler signature");
+
+        // clang-format off
+        if constexpr (hasEvent)
+            return [handler](Object* receiver, const Event& event) { (static_cast<ObjectType*>(receiver)->*handler)(event); };
+        else
+            return [handler](Object* receiver, const Event&) { (static_cast<ObjectType*>(receiver)->*handler)(); };
+        // clang-format on
+    }
+    else
+    {
+        static constexpr bool hasEvent = ea::is_invocable_r_v<void, T, const Event&>;
+        static constexpr bool hasNone = ea::is_invocable_r_v<void, T>;
+        static_assert(hasEvent || hasNone, "Invalid handler signature");
+
+        // clang-format off
+        if constexpr (hasEvent)
+            return [handler = ea::move(handler)](Object*, const Event& event) mutable { handler(event); };
+        else
+            return [handler = ea::move(handler)](Object*, const Event&) mutable { handler(); };
+        // clang-format on
+    }
+}
+
+template <class Event>
+TypedEventChannel<Event>& Object::GetOrCreateTypedEventChannel()
+{
+    const StringHash eventType = Event::GetEventTypeStatic();
+    if (TypedEventChannelBase* channel = FindTypedEventChannel(eventType))
+        return *static_cast<TypedEventChannel<Event>*>(channel);
+
+    auto channel = new TypedEventChannel<Event>();
+    AddTypedEventChannel(eventType, channel);
+    return *channel;
+}
+
+template <class Event, class T>
+inline ea::enable_if_t<IsTypedEvent<Event>::value> Object::SubscribeToEvent(T handler)
+{
+    hasTypedEventHandlers_ = true;
+    GetOrCreateTypedEventChannel<Event>().Subscribe(this, nullptr, WrapTypedEventHandler<Event>(ea::move(handler)));
+}
+
+template <class Event, class T>
+inline ea::enable_if_t<IsTypedEvent<Event>::value> Object::SubscribeToEvent(Object* sender, T handler)
+{
+    // If a null sender was specified, the event can not be subscribed to
+    if (!sender)
+        return;
+
+    hasTypedEventHandlers_ = true;
+    GetOrCreateTypedEventChannel<Event>().Subscribe(this, sender, WrapTypedEventHandler<Event>(ea::move(handler)));
+}
+
+template <class Event>
+inline ea::enable_if_t<IsTypedEvent<Event>::value> Object::UnsubscribeFromEvent()
+{
+    if (TypedEventChannelBase* channel = FindTypedEventChannel(Event::GetEventTypeStatic()))
+        channel->Unsubscribe(this, true, nullptr);
+}
+
+template <class Event>
+inline ea::enable_if_t<IsTypedEvent<Event>::value> Object::SendEvent(const Event& event)
+{
+    if (!CanSendEvents())
+        return;
+
+    if (TypedEventChannelBase* channel = FindTypedEventChannel(Event::GetEventTypeStatic()))
+    {
+#if URHO3D_PROFILING
+        URHO3D_PROFILE_C("SendEvent", PROFILER_COLOR_EVENTS);
+        const auto& eventName = GetEventNameRegister().GetString(Event::GetEventTypeStatic());
+        URHO3D_PROFILE_ZONENAME(eventName.c_str(), eventName.length());
+#endif
+        static_cast<TypedEventChannel<Event>*>(channel)->Send(this, event);
+    }
+}
+
+template <class Event>
+inline ea::enable_if_t<IsTypedEvent<Event>::value, bool> Object::HasSubscribedToEvent() const
+{
+    TypedEventChannelBase* channel = FindTypedEventChannel(Event::GetEventTypeStatic());
+    return channel && channel->HasSubscription(this);
+}
+
+template <class Event>
+inline ea::enable_if_t<IsTypedEvent<Event>::value, bool> Object::HasEventSubscribers() const
+{
+    TypedEventChannelBase* channel = FindTypedEventChannel(Event::GetEventTypeStatic());
+    return channel && channel->HasSubscriptions();
+}
+
 template<typename T>
 inline void Object::SubscribeToEvent(StringHash eventType, T handler)
 {
@@ -315,8 +599,7 @@ inline void Object::SubscribeToEvent(Object* sender, StringHash eventType, T han
     SubscribeToEventManual(sender, eventType, new Urho3D::EventHandler(this, ea::move(handler)));
 }
 
-/// Get register of event names.
-URHO3D_API StringHashRegister& GetEventNameRegister();
+/// Get register of event parameter names.
 URHO3D_API StringHashRegister& GetEventParamRegister();
 
 /// Describe an event's hash ID and begin a namespace in which to define its parameters.
@@ -59,11 +59,71 @@ ObjectReflection::ObjectReflection(Context* context, ea::unique_ptr<TypeInfo> ty
 {
 }
 
+ObjectReflection::~ObjectReflection()
+{
+    ClearObjectPool();
+}
+
 SharedPtr<Object> ObjectReflection::CreateObject()
 {
+    if (objectPoolSize_ != 0)
+    {
+        MutexLock lock(objectPoolMutex_);
+        if (!objectPool_.empty())
+        {
+            SharedPtr<Object> object = ea::move(objectPool_.back());
+            objectPool_.pop_back();
+            return object;
+        }
+    }
+
     return createObject_ ? createObject_(typeInfo_, context_) : nullptr;
 }
 
+void ObjectReflection::SetObjectPoolSize(unsigned size)
+{
+    ea::vector<SharedPtr<Object>> removedObjects;
+    {
+        MutexLock lock(objectPoolMutex_);
+        objectPoolSize_ = size;
+        while (objectPool_.size() > size)
+        {
+            removedObjects.push_back(ea::move(objectPool_.back()));
+            objectPool_.pop_back();
+        }
+    }
+    // Objects are destroyed outside of the lock because they may try to return to the pool
+}
+
+unsigned ObjectReflection::GetNumPooledObjects() const
+{
+    MutexLock lock(objectPoolMutex_);
+    return objectPool_.size();
+}
+
+void ObjectReflection::ClearObjectPool()
+{
+    const unsigned poolSize = objectPoolSize_;
+    SetObjectPoolSize(0);
+    objectPoolSize_ = poolSize;
+}
+
+bool ObjectReflection::CanRecycleObject() const
+{
+    MutexLock lock(objectPoolMutex_);
+    return objectPool_.size() < objectPoolSize_;
+}
+
+bool ObjectReflection::RecycleObject(SharedPtr<Object> object)
+{
+    MutexLock lock(objectPoolMutex_);
+    if (objectPool_.size() >= objectPoolSize_)
+        return false;
+
+    objectPool_.push_back(ea::move(object));
+    return true;
+}
+
 AttributeHandle ObjectReflection::AddAttribute(const AttributeInfo& attr)
 {
     // None or pointer types can not be supported
@@ -256,6 +316,7 @@ void ObjectReflectionRegistry::RemoveReflection(StringHash typeNameHash)
     }
 
     const auto reflection = iter->second;
+    reflection->SetObjectPoolSize(0);
     RemoveReflectionFromCurrentCategory(reflection);
     reflections_.erase(iter);
     OnReflectionRemoved(this, reflection.Get());
@@ -267,6 +328,12 @@ SharedPtr<Object> ObjectReflectionRegistry::CreateObject(StringHash typeNameHash
     return iter != reflections_.end() ? iter->second->CreateObject() : nullptr;
 }
 
+void ObjectReflectionRegistry::ClearObjectPools()
+{
+    for (const auto& [_, reflection] : reflections_)
+        reflection->ClearObjectPool();
+}
+
 void ObjectReflectionRegistry::ErrorReflectionNotFound(StringHash typeNameHash) const
 {
     URHO3D_LOGWARNING("Reflection of object {} is not found", typeNameHash.ToDebugString());
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "../Core/Attribute.h"
+#include "../Core/Mutex.h"
 #include "../Core/Signal.h"
 #include "../Core/TypeInfo.h"
 #include "../Container/Ptr.h"
@@ -47,6 +48,7 @@ public:
 
     ObjectReflection(Context* context, const TypeInfo* typeInfo);
     ObjectReflection(Context* context, ea::unique_ptr<TypeInfo> typeInfo);
+    ~ObjectReflection() override;
 
     /// @name Factory management
     /// @{
@@ -56,6 +58,20 @@ public:
     bool HasObjectFactory() const { return createObject_ != nullptr; }
     /// @}
 
+    /// @name Object pool management
+    /// Objects returned to the pool are reused by CreateObject instead of being allocated again.
+    /// Only types that reset their state on recycling, such as Node and Component, return objects to the pool.
+    /// @{
+    void SetObjectPoolSize(unsigned size);
+    unsigned GetObjectPoolSize() const { return objectPoolSize_; }
+    unsigned GetNumPooledObjects() const;
+    void ClearObjectPool();
+    /// Return whether the pool may accept one more object. Used as an early out before the object is reset.
+    bool CanRecycleObject() const;
+    /// Return unused object to the pool. Object should have no references except the given one.
+    bool RecycleObject(SharedPtr<Object> object);
+    /// @}
+
     /// @name Category management
     /// @{
     void SetCategory(ea::string_view category) { category_ = category; }
@@ -110,6 +126,14 @@ private:
     const TypeInfo* typeInfo_{};
     ea::unique_ptr<TypeInfo> ownedTypeInfo_;
     ObjectFactoryCallback createObject_{};
+
+    /// Max number of unused objects kept in the pool.
+    unsigned objectPoolSize_{};
+    /// Unused objects ready to be reused.
+    ea::vector<SharedPtr<Object>> objectPool_;
+    /// Mutex for the pool, objects may be created and destroyed in worker threads.
+    mutable SpinLockMutex objectPoolMutex_;
+
     /// Category of the object.
     ea::string category_;
 
@@ -167,6 +191,8 @@ public:
 
     /// Create an object by type. Return pointer to it or null if no reflection is found.
     SharedPtr<Object> CreateObject(StringHash typeNameHash);
+    /// Destroy all pooled objects of all types.
+    void ClearObjectPools();
 
     /// Return reflections of all objects.
     const ea::unordered_map<StringHash, SharedPtr<ObjectReflection>>& GetObjectReflections() const { return reflections_; }
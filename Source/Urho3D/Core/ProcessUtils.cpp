@@ -47,6 +47,10 @@ extern "C" unsigned SDL_TVOS_GetActiveProcessorCount();
 
 #if defined(_WIN32)
 #include <windows.h>
+#ifndef PSAPI_VERSION
+#define PSAPI_VERSION 2
+#endif
+#include <psapi.h>
 #include <rpc.h>
 #include <io.h>
 #include <direct.h>
@@ -75,6 +79,9 @@ extern "C" unsigned SDL_TVOS_GetActiveProcessorCount();
 #ifndef _WIN32
 #include <unistd.h>
 #endif
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#include <sys/resource.h>
+#endif
 
 #if defined(__EMSCRIPTEN__) && defined(__EMSCRIPTEN_PTHREADS__)
 #include <emscripten/threading.h>
@@ -524,6 +531,25 @@ unsigned long long GetTotalMemory()
     return 0ull;
 }
 
+unsigned long long GetPeakProcessMemory()
+{
+#if defined(_WIN32) && !defined(UWP)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize;
+#elif defined(__APPLE__)
+    struct rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+        return usage.ru_maxrss;
+#elif !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+    // Linux reports kilobytes
+    struct rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+        return usage.ru_maxrss * 1024ull;
+#endif
+    return 0ull;
+}
+
 ea::string GetLoginName()
 {
 #if defined(__linux__) && !defined(__ANDROID__)
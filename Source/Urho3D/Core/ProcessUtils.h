@@ -102,6 +102,8 @@ URHO3D_API void SetMiniDumpDir(const ea::string& pathName);
 URHO3D_API ea::string GetMiniDumpDir();
 /// Return the total amount of usable memory in bytes.
 URHO3D_API unsigned long long GetTotalMemory();
+/// Return peak resident memory of the current process in bytes, or 0 if not supported.
+URHO3D_API unsigned long long GetPeakProcessMemory();
 /// Return the name of the currently logged in user, or (?) if not identified.
 URHO3D_API ea::string GetLoginName();
 /// Return the name of the running machine.
@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include "../Core/FrameProfiler.h"
+
 #include <tracy/Tracy.hpp>
 #if URHO3D_PROFILING
 #include <tracy/client/TracyLock.hpp>
@@ -37,9 +39,15 @@ void SetProfilerThreadName(const char* name);
 
 }
 
-#define URHO3D_PROFILE_FUNCTION()                   ZoneScopedN(__FUNCTION__)
-#define URHO3D_PROFILE_C(name, color)               ZoneScopedNC(name, color)
-#define URHO3D_PROFILE(name)                        ZoneScopedN(name)
+#define URHO3D_PROFILE_CONCAT_IMPL(x, y)            x##y
+#define URHO3D_PROFILE_CONCAT(x, y)                 URHO3D_PROFILE_CONCAT_IMPL(x, y)
+#define URHO3D_FRAME_PROFILE(name) \
+    static const unsigned URHO3D_PROFILE_CONCAT(frameProfilerZone, __LINE__) = ::Urho3D::FrameProfiler::RegisterZone(name); \
+    const ::Urho3D::FrameProfilerScope URHO3D_PROFILE_CONCAT(frameProfilerScope, __LINE__){URHO3D_PROFILE_CONCAT(frameProfilerZone, __LINE__)}
+
+#define URHO3D_PROFILE_FUNCTION()                   ZoneScopedN(__FUNCTION__); URHO3D_FRAME_PROFILE(__FUNCTION__)
+#define URHO3D_PROFILE_C(name, color)               ZoneScopedNC(name, color); URHO3D_FRAME_PROFILE(name)
+#define URHO3D_PROFILE(name)                        ZoneScopedN(name); URHO3D_FRAME_PROFILE(name)
 #define URHO3D_PROFILE_THREAD(name)                 Urho3D::SetProfilerThreadName(name)
 #define URHO3D_PROFILE_VALUE(name, value)           TracyPlot(name, value)
 #define URHO3D_PROFILE_FRAME()                      FrameMark
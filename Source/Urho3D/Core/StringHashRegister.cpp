@@ -23,7 +23,6 @@
 #include "../Precompiled.h"
 
 #include "../Core/StringHashRegister.h"
-#include "../Core/Mutex.h"
 #include "../IO/Log.h"
 
 #include <cstdio>
@@ -36,7 +35,7 @@ namespace Urho3D
 StringHashRegister::StringHashRegister(bool threadSafe)
 {
     if (threadSafe)
-        mutex_ = ea::make_unique<Mutex>();
+        mutex_ = ea::make_unique<std::shared_mutex>();
 }
 
 
@@ -47,8 +46,18 @@ StringHashRegister::~StringHashRegister()       // NOLINT(hicpp-use-equals-defau
 
 StringHash StringHashRegister::RegisterString(const StringHash& hash, ea::string_view string)
 {
+    // Most strings are already registered, check them without blocking other threads
     if (mutex_)
-        mutex_->Acquire();
+    {
+        std::shared_lock<std::shared_mutex> lock(*mutex_);
+        const auto iter = map_.find(hash);
+        if (iter != map_.end() && ea::string_view(iter->second) == string)
+            return hash;
+    }
+
+    std::unique_lock<std::shared_mutex> lock;
+    if (mutex_)
+        lock = std::unique_lock<std::shared_mutex>(*mutex_);
 
     auto iter = map_.find(hash);
     if (iter == map_.end())
@@ -61,9 +70,6 @@ StringHash StringHashRegister::RegisterString(const StringHash& hash, ea::string
             string, iter->second.c_str(), hash.ToString().c_str());
     }
 
-    if (mutex_)
-        mutex_->Release();
-
     return hash;
 }
 
@@ -75,28 +81,20 @@ StringHash StringHashRegister::RegisterString(ea::string_view string)
 
 ea::string StringHashRegister::GetStringCopy(const StringHash& hash) const
 {
+    std::shared_lock<std::shared_mutex> lock;
     if (mutex_)
-        mutex_->Acquire();
+        lock = std::shared_lock<std::shared_mutex>(*mutex_);
 
-    const ea::string copy = GetString(hash);
-
-    if (mutex_)
-        mutex_->Release();
-
-    return copy;
+    return GetString(hash);
 }
 
 bool StringHashRegister::Contains(const StringHash& hash) const
 {
+    std::shared_lock<std::shared_mutex> lock;
     if (mutex_)
-        mutex_->Acquire();
-
-    const bool contains = map_.contains(hash);
-
-    if (mutex_)
-        mutex_->Release();
+        lock = std::shared_lock<std::shared_mutex>(*mutex_);
 
-    return contains;
+    return map_.contains(hash);
 }
 
 const ea::string& StringHashRegister::GetString(const StringHash& hash) const
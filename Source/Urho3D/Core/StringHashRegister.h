@@ -28,10 +28,11 @@
 #include "../Core/Variant.h"
 #include "../Math/StringHash.h"
 
+#include <shared_mutex>
+
 namespace Urho3D
 {
 
-class Mutex;
 class StringHash;
 
 /// Helper class used for StringHash reversing.
@@ -39,6 +40,7 @@ class URHO3D_API StringHashRegister
 {
 public:
     /// Construct. threadSafe controls whether the RegisterString and GetStringCopy are thread-safe.
+    /// Thread-safe register allows concurrent lookups, only registration of new strings is exclusive.
     StringHashRegister(bool threadSafe);
     /// Destruct.
     ~StringHashRegister();
@@ -60,8 +62,8 @@ public:
 private:
     /// Hash to string map.
     StringMap map_;
-    /// Mutex.
-    ea::unique_ptr<Mutex> mutex_;
+    /// Reader-writer lock, if thread-safe.
+    mutable ea::unique_ptr<std::shared_mutex> mutex_;
 };
 
 }
@@ -0,0 +1,286 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Core/TaskGraph.h"
+
+#include "Urho3D/Core/WorkQueue.h"
+#include "Urho3D/IO/Log.h"
+
+#ifdef URHO3D_THREADING
+#include <enkiTS/src/TaskScheduler.h>
+#endif
+
+namespace Urho3D
+{
+
+struct TaskGraph::Node
+#ifdef URHO3D_THREADING
+    : public enki::ITaskSet
+#endif
+{
+    TaskGraphFunction function_;
+    TaskGraphRangeFunction rangeFunction_;
+    unsigned size_{1};
+    ea::vector<NodeId> dependencies_;
+
+    void Execute(unsigned beginIndex, unsigned endIndex, unsigned threadIndex) const
+    {
+        if (rangeFunction_)
+        {
+            endIndex = ea::min(endIndex, size_);
+            if (beginIndex < endIndex)
+                rangeFunction_(beginIndex, endIndex, threadIndex);
+        }
+        else
+            function_(threadIndex);
+    }
+
+#ifdef URHO3D_THREADING
+    ea::vector<enki::Dependency> internalDependencies_;
+
+    void ExecuteRange(enki::TaskSetPartition range, uint32_t threadNum) override
+    {
+        Execute(range.start, range.end, threadNum);
+    }
+#endif
+};
+
+struct TaskGraph::CompletionObserver
+{
+#ifdef URHO3D_THREADING
+    enki::ICompletable completable_;
+    ea::vector<enki::Dependency> internalDependencies_;
+#endif
+};
+
+TaskGraph::TaskGraph(WorkQueue* workQueue)
+    : workQueue_(workQueue)
+    , completion_(ea::make_unique<CompletionObserver>())
+{
+}
+
+TaskGraph::~TaskGraph()
+{
+#ifdef URHO3D_THREADING
+    // Unlink dependencies before tasks are destroyed
+    completion_->internalDependencies_.clear();
+    for (const auto& node : nodes_)
+        node->internalDependencies_.clear();
+#endif
+}
+
+TaskGraph::NodeId TaskGraph::AddTask(const TaskGraphFunction& function)
+{
+    auto node = ea::make_unique<Node>();
+    node->function_ = function;
+#ifdef URHO3D_THREADING
+    node->m_Priority = static_cast<enki::TaskPriority>(TaskPriority::Immediate);
+#endif
+    nodes_.push_back(ea::move(node));
+    dirty_ = true;
+    return nodes_.size() - 1;
+}
+
+TaskGraph::NodeId TaskGraph::AddParallelTask(unsigned size, unsigned grainSize, const TaskGraphRangeFunction& function)
+{
+    auto node = ea::make_unique<Node>();
+    node->rangeFunction_ = function;
+#ifdef URHO3D_THREADING
+    node->m_Priority = static_cast<enki::TaskPriority>(TaskPriority::Immediate);
+    node->m_MinRange = ea::max(grainSize, 1u);
+#endif
+    nodes_.push_back(ea::move(node));
+    dirty_ = true;
+
+    const NodeId nodeId = nodes_.size() - 1;
+    SetTaskSize(nodeId, size);
+    return nodeId;
+}
+
+TaskGraph::NodeId TaskGraph::AddContinuation(NodeId node, const TaskGraphFunction& function)
+{
+    const NodeId continuation = AddTask(function);
+    AddDependency(continuation, node);
+    return continuation;
+}
+
+void TaskGraph::AddDependency(NodeId node, NodeId dependency)
+{
+    URHO3D_ASSERT(node < nodes_.size() && dependency < nodes_.size());
+
+    ea::vector<NodeId>& dependencies = nodes_[node]->dependencies_;
+    if (ea::find(dependencies.begin(), dependencies.end(), dependency) == dependencies.end())
+    {
+        dependencies.push_back(dependency);
+        dirty_ = true;
+    }
+}
+
+void TaskGraph::SetTaskSize(NodeId node, unsigned size)
+{
+    URHO3D_ASSERT(node < nodes_.size());
+
+    Node& data = *nodes_[node];
+    data.size_ = size;
+#ifdef URHO3D_THREADING
+    // Task of zero size is still executed by the scheduler to keep dependencies going
+    data.m_SetSize = ea::max(size, 1u);
+#endif
+}
+
+void TaskGraph::Clear()
+{
+#ifdef URHO3D_THREADING
+    completion_->internalDependencies_.clear();
+    for (const auto& node : nodes_)
+        node->internalDependencies_.clear();
+#endif
+    nodes_.clear();
+    executionOrder_.clear();
+    rootNodes_.clear();
+    dirty_ = false;
+    valid_ = true;
+}
+
+bool TaskGraph::Run()
+{
+    if (dirty_)
+    {
+        dirty_ = false;
+        valid_ = UpdateExecutionOrder();
+        if (!valid_)
+            URHO3D_LOGERROR("TaskGraph has cyclic dependencies and cannot be executed");
+#ifdef URHO3D_THREADING
+        else
+            SetupDependencies();
+#endif
+    }
+
+    if (!valid_)
+        return false;
+
+    if (nodes_.empty())
+        return true;
+
+#ifdef URHO3D_THREADING
+    if (workQueue_->taskScheduler_)
+    {
+        RunParallel();
+        return true;
+    }
+#endif
+
+    RunSerial();
+    return true;
+}
+
+bool TaskGraph::UpdateExecutionOrder()
+{
+    const unsigned numNodes = nodes_.size();
+
+    ea::vector<unsigned> numPendingDependencies(numNodes);
+    ea::vector<ea::vector<NodeId>> dependents(numNodes);
+    for (NodeId nodeId = 0; nodeId < numNodes; ++nodeId)
+    {
+        numPendingDependencies[nodeId] = nodes_[nodeId]->dependencies_.size();
+        for (NodeId dependency : nodes_[nodeId]->dependencies_)
+            dependents[dependency].push_back(nodeId);
+    }
+
+    rootNodes_.clear();
+    for (NodeId nodeId = 0; nodeId < numNodes; ++nodeId)
+    {
+        if (numPendingDependencies[nodeId] == 0)
+            rootNodes_.push_back(nodeId);
+    }
+
+    executionOrder_ = rootNodes_;
+    for (unsigned i = 0; i < executionOrder_.size(); ++i)
+    {
+        for (NodeId dependent : dependents[executionOrder_[i]])
+        {
+            if (--numPendingDependencies[dependent] == 0)
+                executionOrder_.push_back(dependent);
+        }
+    }
+
+    return executionOrder_.size() == numNodes;
+}
+
+void TaskGraph::RunSerial()
+{
+    const unsigned threadIndex = WorkQueue::GetThreadIndex();
+    for (NodeId nodeId : executionOrder_)
+    {
+        const Node& node = *nodes_[nodeId];
+        node.Execute(0, node.size_, threadIndex);
+    }
+}
+
+#ifdef URHO3D_THREADING
+void TaskGraph::SetupDependencies()
+{
+    completion_->internalDependencies_.clear();
+    for (const auto& node : nodes_)
+        node->internalDependencies_.clear();
+
+    ea::vector<bool> hasDependents(nodes_.size());
+    for (const auto& node : nodes_)
+    {
+        node->internalDependencies_.resize(node->dependencies_.size());
+        for (unsigned i = 0; i < node->dependencies_.size(); ++i)
+        {
+            const NodeId dependency = node->dependencies_[i];
+            node->SetDependency(node->internalDependencies_[i], nodes_[dependency].get());
+            hasDependents[dependency] = true;
+        }
+    }
+
+    // Graph is completed when all the leaf nodes are completed
+    const unsigned numLeafNodes = ea::count(hasDependents.begin(), hasDependents.end(), false);
+    completion_->internalDependencies_.resize(numLeafNodes);
+
+    unsigned leafIndex = 0;
+    for (NodeId nodeId = 0; nodeId < nodes_.size(); ++nodeId)
+    {
+        if (!hasDependents[nodeId])
+        {
+            enki::Dependency& dependency = completion_->internalDependencies_[leafIndex++];
+            completion_->completable_.SetDependency(dependency, nodes_[nodeId].get());
+        }
+    }
+}
+
+void TaskGraph::RunParallel()
+{
+    enki::TaskScheduler* taskScheduler = workQueue_->taskScheduler_.get();
+    for (NodeId nodeId : rootNodes_)
+        taskScheduler->AddTaskSetToPipe(nodes_[nodeId].get());
+
+    static const auto priority = static_cast<enki::TaskPriority>(TaskPriority::Immediate);
+    taskScheduler->WaitforTask(&completion_->completable_, priority);
+}
+#endif
+
+}
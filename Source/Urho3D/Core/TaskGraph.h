@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "Urho3D/Urho3D.h"
+#include "Urho3D/Core/NonCopyable.h"
+
+#include <EASTL/functional.h>
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class WorkQueue;
+
+/// Function of task graph node. Signature: void(unsigned threadIndex).
+using TaskGraphFunction = ea::function<void(unsigned threadIndex)>;
+/// Function of parallel task graph node. Signature: void(unsigned beginIndex, unsigned endIndex, unsigned threadIndex).
+using TaskGraphRangeFunction = ea::function<void(unsigned beginIndex, unsigned endIndex, unsigned threadIndex)>;
+
+/// Graph of tasks connected by dependencies and executed by WorkQueue.
+/// Node is started as soon as all nodes it depends on are completed, so independent nodes are executed concurrently.
+/// Parallel node splits its range into chunks that are stolen by idle threads.
+/// Chunk size adapts to the number of threads, but never goes below the grain size of the node.
+/// Graph is supposed to be built once and executed many times, e.g. every frame.
+class URHO3D_API TaskGraph : public NonCopyable
+{
+public:
+    /// Index of the node in the graph.
+    using NodeId = unsigned;
+
+    explicit TaskGraph(WorkQueue* workQueue);
+    ~TaskGraph();
+
+    /// Add node that executes function once.
+    NodeId AddTask(const TaskGraphFunction& function);
+    /// Add node that processes range [0, size) in chunks of at least grainSize elements.
+    NodeId AddParallelTask(unsigned size, unsigned grainSize, const TaskGraphRangeFunction& function);
+    /// Add node that is executed after completion of another node.
+    NodeId AddContinuation(NodeId node, const TaskGraphFunction& function);
+    /// Make the node wait for completion of another node.
+    void AddDependency(NodeId node, NodeId dependency);
+    /// Set number of elements processed by parallel node. May be changed between runs.
+    void SetTaskSize(NodeId node, unsigned size);
+    /// Remove all nodes.
+    void Clear();
+
+    /// Execute all nodes and wait for completion. Should be called from main thread or from WorkQueue task.
+    /// Return false if the graph has cyclic dependencies and cannot be executed.
+    bool Run();
+
+    /// Return number of nodes.
+    unsigned GetNumNodes() const { return nodes_.size(); }
+
+private:
+    struct Node;
+    struct CompletionObserver;
+
+    /// Sort nodes in order of dependencies. Return false if there are cycles.
+    bool UpdateExecutionOrder();
+    /// Execute nodes one by one in the current thread.
+    void RunSerial();
+#ifdef URHO3D_THREADING
+    /// Link nodes with scheduler dependencies.
+    void SetupDependencies();
+    /// Execute nodes in the worker threads.
+    void RunParallel();
+#endif
+
+    WorkQueue* workQueue_{};
+    ea::vector<ea::unique_ptr<Node>> nodes_;
+    /// Nodes sorted so that each node goes after its dependencies.
+    ea::vector<NodeId> executionOrder_;
+    /// Nodes without dependencies.
+    ea::vector<NodeId> rootNodes_;
+    ea::unique_ptr<CompletionObserver> completion_;
+
+    bool dirty_{};
+    bool valid_{};
+};
+
+}
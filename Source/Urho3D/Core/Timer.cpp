@@ -28,6 +28,7 @@
 
 #include <SDL_timer.h>
 
+#include <chrono>
 #include <ctime>
 
 #ifdef _WIN32
@@ -167,6 +168,12 @@ unsigned Time::GetTimeSinceEpoch()
     return (unsigned)time(nullptr);
 }
 
+long long Time::GetTimeSinceEpochUs()
+{
+    const auto sinceEpoch = std::chrono::system_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch).count();
+}
+
 ea::string Time::GetTimeStamp(const char* format)
 {
     time_t timestamp = 0;
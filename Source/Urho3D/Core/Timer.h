@@ -117,6 +117,8 @@ public:
     static unsigned GetSystemTime();
     /// Get system time as seconds since 1.1.1970.
     static unsigned GetTimeSinceEpoch();
+    /// Get system time as microseconds since 1.1.1970. Can be compared between processes.
+    static long long GetTimeSinceEpochUs();
     /// Get a date/time stamp as a string.
     static ea::string GetTimeStamp(const char* format=nullptr);
     /// Get a date/time stamp as a string.
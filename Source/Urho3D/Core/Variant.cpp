@@ -22,10 +22,12 @@
 
 #include "../Precompiled.h"
 
+#include "../Core/MemoryTracker.h"
 #include "../Core/StringUtils.h"
 #include "../IO/VectorBuffer.h"
 #include "../Core/VariantCurve.h"
 
+#include <atomic>
 #include <cstring>
 
 namespace Urho3D
@@ -41,6 +43,14 @@ const StringVector Variant::emptyStringVector { };
 const VariantCurve Variant::emptyCurve;
 const StringVariantMap Variant::emptyStringVariantMap;
 
+static std::atomic<unsigned> numHeapAllocations{};
+
+static unsigned GetMemoryTag()
+{
+    static const unsigned tag = MemoryTracker::RegisterTag("Variant");
+    return tag;
+}
+
 static const char* typeNames[] =
 {
     "None",
@@ -93,11 +103,11 @@ Variant& Variant::operator =(const Variant& rhs)
     switch (type_)
     {
     case VAR_STRING:
-        value_.string_ = rhs.value_.string_;
+        CopyValue(value_.string_, rhs.value_.string_);
         break;
 
     case VAR_BUFFER:
-        value_.buffer_ = rhs.value_.buffer_;
+        CopyValue(value_.buffer_, rhs.value_.buffer_);
         break;
 
     case VAR_RESOURCEREF:
@@ -109,11 +119,11 @@ Variant& Variant::operator =(const Variant& rhs)
         break;
 
     case VAR_VARIANTVECTOR:
-        value_.variantVector_ = rhs.value_.variantVector_;
+        CopyValue(value_.variantVector_, rhs.value_.variantVector_);
         break;
 
     case VAR_STRINGVECTOR:
-        value_.stringVector_ = rhs.value_.stringVector_;
+        CopyValue(value_.stringVector_, rhs.value_.stringVector_);
         break;
 
     case VAR_VARIANTMAP:
@@ -855,6 +865,7 @@ void Variant::SetType(VariantType newType)
         break;
 
     case VAR_VARIANTMAP:
+        MemoryTracker::TrackDeallocation(GetMemoryTag(), sizeof(*value_.variantMap_));
         delete value_.variantMap_;
         break;
 
@@ -863,14 +874,17 @@ void Variant::SetType(VariantType newType)
         break;
 
     case VAR_MATRIX3:
+        MemoryTracker::TrackDeallocation(GetMemoryTag(), sizeof(*value_.matrix3_));
         delete value_.matrix3_;
         break;
 
     case VAR_MATRIX3X4:
+        MemoryTracker::TrackDeallocation(GetMemoryTag(), sizeof(*value_.matrix3x4_));
         delete value_.matrix3x4_;
         break;
 
     case VAR_MATRIX4:
+        MemoryTracker::TrackDeallocation(GetMemoryTag(), sizeof(*value_.matrix4_));
         delete value_.matrix4_;
         break;
 
@@ -879,10 +893,12 @@ void Variant::SetType(VariantType newType)
         break;
 
     case VAR_VARIANTCURVE:
+        MemoryTracker::TrackDeallocation(GetMemoryTag(), sizeof(*value_.variantCurve_));
         delete value_.variantCurve_;
         break;
 
     case VAR_STRINGVARIANTMAP:
+        MemoryTracker::TrackDeallocation(GetMemoryTag(), sizeof(*value_.stringVariantMap_));
         delete value_.stringVariantMap_;
         break;
 
@@ -920,6 +936,8 @@ void Variant::SetType(VariantType newType)
 
     case VAR_VARIANTMAP:
         value_.variantMap_ = new VariantMap();
+        MemoryTracker::TrackAllocation(GetMemoryTag(), sizeof(VariantMap));
+        CountHeapAllocation();
         break;
 
     case VAR_PTR:
@@ -928,14 +946,20 @@ void Variant::SetType(VariantType newType)
 
     case VAR_MATRIX3:
         value_.matrix3_ = new Matrix3();
+        MemoryTracker::TrackAllocation(GetMemoryTag(), sizeof(Matrix3));
+        CountHeapAllocation();
         break;
 
     case VAR_MATRIX3X4:
         value_.matrix3x4_ = new Matrix3x4();
+        MemoryTracker::TrackAllocation(GetMemoryTag(), sizeof(Matrix3x4));
+        CountHeapAllocation();
         break;
 
     case VAR_MATRIX4:
         value_.matrix4_ = new Matrix4();
+        MemoryTracker::TrackAllocation(GetMemoryTag(), sizeof(Matrix4));
+        CountHeapAllocation();
         break;
 
     case VAR_CUSTOM:
@@ -945,10 +969,14 @@ void Variant::SetType(VariantType newType)
 
     case VAR_VARIANTCURVE:
         value_.variantCurve_ = new VariantCurve();
+        MemoryTracker::TrackAllocation(GetMemoryTag(), sizeof(VariantCurve));
+        CountHeapAllocation();
         break;
 
     case VAR_STRINGVARIANTMAP:
         value_.stringVariantMap_ = new StringVariantMap();
+        MemoryTracker::TrackAllocation(GetMemoryTag(), sizeof(StringVariantMap));
+        CountHeapAllocation();
         break;
 
     default:
@@ -956,6 +984,23 @@ void Variant::SetType(VariantType newType)
     }
 }
 
+unsigned Variant::GetNumHeapAllocations()
+{
+    return numHeapAllocations.load(std::memory_order_relaxed);
+}
+
+void Variant::ResetNumHeapAllocations()
+{
+    numHeapAllocations.store(0, std::memory_order_relaxed);
+}
+
+void Variant::CountHeapAllocation()
+{
+#if URHO3D_PROFILING
+    numHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+#endif
+}
+
 template <> int Variant::Get<int>(int) const
 {
     return GetInt();
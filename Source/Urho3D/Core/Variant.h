@@ -567,6 +567,12 @@ public:
         *this = value;
     }
 
+    /// Construct from a string by moving it.
+    Variant(ea::string&& value)             // NOLINT(google-explicit-constructor)
+    {
+        *this = ea::move(value);
+    }
+
     /// Construct from a C string.
     Variant(const char* value)          // NOLINT(google-explicit-constructor)
     {
@@ -579,6 +585,12 @@ public:
         *this = value;
     }
 
+    /// Construct from a buffer by moving it.
+    Variant(VariantBuffer&& value)           // NOLINT(google-explicit-constructor)
+    {
+        *this = ea::move(value);
+    }
+
     /// Construct from a %VectorBuffer and store as a buffer.
     Variant(const VectorBuffer& value)  // NOLINT(google-explicit-constructor)
     {
@@ -603,24 +615,48 @@ public:
         *this = value;
     }
 
+    /// Construct from a resource reference list by moving it.
+    Variant(ResourceRefList&& value)        // NOLINT(google-explicit-constructor)
+    {
+        *this = ea::move(value);
+    }
+
     /// Construct from a variant vector.
     Variant(const VariantVector& value) // NOLINT(google-explicit-constructor)
     {
         *this = value;
     }
 
+    /// Construct from a variant vector by moving it.
+    Variant(VariantVector&& value)      // NOLINT(google-explicit-constructor)
+    {
+        *this = ea::move(value);
+    }
+
     /// Construct from a variant map.
     Variant(const VariantMap& value)    // NOLINT(google-explicit-constructor)
     {
         *this = value;
     }
 
+    /// Construct from a variant map by moving it.
+    Variant(VariantMap&& value)         // NOLINT(google-explicit-constructor)
+    {
+        *this = ea::move(value);
+    }
+
     /// Construct from a string vector.
     Variant(const StringVector& value)  // NOLINT(google-explicit-constructor)
     {
         *this = value;
     }
 
+    /// Construct from a string vector by moving it.
+    Variant(StringVector&& value)       // NOLINT(google-explicit-constructor)
+    {
+        *this = ea::move(value);
+    }
+
     /// Construct from a rect.
     Variant(const Rect& value)          // NOLINT(google-explicit-constructor)
     {
@@ -681,6 +717,12 @@ public:
         *this = value;
     }
 
+    /// Construct from a string variant map by moving it.
+    Variant(StringVariantMap&& value)         // NOLINT(google-explicit-constructor)
+    {
+        *this = ea::move(value);
+    }
+
     /// Construct from type and value.
     Variant(const ea::string& type, const ea::string& value)
     {
@@ -846,7 +888,15 @@ public:
     Variant& operator =(const ea::string& rhs)
     {
         SetType(VAR_STRING);
-        value_.string_ = rhs;
+        CopyValue(value_.string_, rhs);
+        return *this;
+    }
+
+    /// Move-assign from a string.
+    Variant& operator =(ea::string&& rhs)
+    {
+        SetType(VAR_STRING);
+        value_.string_ = ea::move(rhs);
         return *this;
     }
 
@@ -862,7 +912,15 @@ public:
     Variant& operator =(const VariantBuffer& rhs)
     {
         SetType(VAR_BUFFER);
-        value_.buffer_ = rhs;
+        CopyValue(value_.buffer_, rhs);
+        return *this;
+    }
+
+    /// Move-assign from a buffer.
+    Variant& operator =(VariantBuffer&& rhs)
+    {
+        SetType(VAR_BUFFER);
+        value_.buffer_ = ea::move(rhs);
         return *this;
     }
 
@@ -893,11 +951,27 @@ public:
         return *this;
     }
 
+    /// Move-assign from a resource reference list.
+    Variant& operator =(ResourceRefList&& rhs)
+    {
+        SetType(VAR_RESOURCEREFLIST);
+        value_.resourceRefList_ = ea::move(rhs);
+        return *this;
+    }
+
     /// Assign from a variant vector.
     Variant& operator =(const VariantVector& rhs)
     {
         SetType(VAR_VARIANTVECTOR);
-        value_.variantVector_ = rhs;
+        CopyValue(value_.variantVector_, rhs);
+        return *this;
+    }
+
+    /// Move-assign from a variant vector.
+    Variant& operator =(VariantVector&& rhs)
+    {
+        SetType(VAR_VARIANTVECTOR);
+        value_.variantVector_ = ea::move(rhs);
         return *this;
     }
 
@@ -905,7 +979,15 @@ public:
     Variant& operator =(const StringVector& rhs)
     {
         SetType(VAR_STRINGVECTOR);
-        value_.stringVector_ = rhs;
+        CopyValue(value_.stringVector_, rhs);
+        return *this;
+    }
+
+    /// Move-assign from a string vector.
+    Variant& operator =(StringVector&& rhs)
+    {
+        SetType(VAR_STRINGVECTOR);
+        value_.stringVector_ = ea::move(rhs);
         return *this;
     }
 
@@ -917,6 +999,14 @@ public:
         return *this;
     }
 
+    /// Move-assign from a variant map.
+    Variant& operator =(VariantMap&& rhs)
+    {
+        SetType(VAR_VARIANTMAP);
+        *value_.variantMap_ = ea::move(rhs);
+        return *this;
+    }
+
     /// Assign from a rect.
     Variant& operator =(const Rect& rhs)
     {
@@ -992,6 +1082,14 @@ public:
         return *this;
     }
 
+    /// Move-assign from a string variant map.
+    Variant& operator =(StringVariantMap&& rhs)
+    {
+        SetType(VAR_STRINGVARIANTMAP);
+        *value_.stringVariantMap_ = ea::move(rhs);
+        return *this;
+    }
+
     /// Test for equality with another variant.
     bool operator ==(const Variant& rhs) const;
 
@@ -1651,9 +1749,30 @@ public:
     /// Empty string variant map.
     static const StringVariantMap emptyStringVariantMap;
 
+    /// Return number of heap allocations made by variants since the last reset. Counted only if profiling is enabled.
+    /// Allocations made by nested containers are not counted.
+    static unsigned GetNumHeapAllocations();
+    /// Reset number of heap allocations made by variants.
+    static void ResetNumHeapAllocations();
+
 private:
     /// Set new type and allocate/deallocate memory as necessary.
     void SetType(VariantType newType);
+    /// Count heap allocation for statistics.
+    static void CountHeapAllocation();
+
+    /// Copy string or vector and count allocation if capacity was changed.
+    template <class T> static void CopyValue(T& dest, const T& src)
+    {
+#if URHO3D_PROFILING
+        const auto oldCapacity = dest.capacity();
+        dest = src;
+        if (dest.capacity() != oldCapacity)
+            CountHeapAllocation();
+#else
+        dest = src;
+#endif
+    }
 
     /// Variant type.
     VariantType type_ = VAR_NONE;
@@ -25,6 +25,9 @@
 #include "../Audio/Audio.h"
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
+#include "../Core/FrameAllocator.h"
+#include "../Core/MemoryTracker.h"
+#include "../Core/NonCopyable.h"
 #include "../Core/Profiler.h"
 #include "../Core/ProcessUtils.h"
 #include "../Core/Thread.h"
@@ -43,7 +46,9 @@
 #include "../RenderAPI/PipelineState.h"
 #include "../RenderAPI/RenderAPIUtils.h"
 #include "../Resource/JSONArchive.h"
+#include "../Graphics/ModelResidencyManager.h"
 #include "../Graphics/Renderer.h"
+#include "../Graphics/TextureResidencyManager.h"
 #include "../Input/Input.h"
 #include "../Input/DirectionalPadAdapter.h"
 #include "../IO/FileSystem.h"
@@ -89,6 +94,11 @@
 #endif
 #include "../Plugins/PluginManager.h"
 #include "../Utility/AnimationVelocityExtractor.h"
+#include "../Utility/ShaderCooker.h"
+#include "../Utility/StaticModelMerger.h"
+#include "../Utility/TextureAtlasPacker.h"
+#include "../Utility/TextureCompressor.h"
+#include "../Utility/VertexAnimationBaker.h"
 #include "../Utility/AssetPipeline.h"
 #include "../Utility/AssetTransformer.h"
 #include "../Utility/SceneViewerApplication.h"
@@ -108,6 +118,8 @@
 #include "StateManager.h"
 #include "../Core/CommandLine.h"
 
+#include <EASTL/optional.h>
+
 #include "../DebugNew.h"
 
 #if defined(_MSC_VER) && defined(_DEBUG)
@@ -148,6 +160,40 @@ namespace Urho3D
 
 extern const char* logLevelNames[];
 
+namespace
+{
+
+/// Measure the time of engine initialization phase.
+class StartupPhaseScope : public NonCopyable
+{
+public:
+    StartupPhaseScope(ea::vector<EngineStartupPhase>& phases, HiresTimer& timer, const char* name)
+        : phases_(phases)
+        , timer_(timer)
+        , name_(name)
+        , startUSec_(timer_.GetUSec(false))
+    {
+    }
+
+    ~StartupPhaseScope()
+    {
+        const long long endUSec = timer_.GetUSec(false);
+        phases_.push_back(EngineStartupPhase{name_, startUSec_ / 1000.0, (endUSec - startUSec_) / 1000.0});
+    }
+
+private:
+    ea::vector<EngineStartupPhase>& phases_;
+    HiresTimer& timer_;
+    const char* name_{};
+    long long startUSec_{};
+};
+
+}
+
+#define URHO3D_STARTUP_PHASE(name) \
+    URHO3D_PROFILE(name); \
+    const StartupPhaseScope URHO3D_PROFILE_CONCAT(startupPhase_, __LINE__)(startupPhases_, startupTimer_, name)
+
 Engine::Engine(Context* context) :
     Object(context),
     timeStep_(0.0f),
@@ -233,6 +279,11 @@ Engine::Engine(Context* context) :
     context_->AddFactoryReflection<AssetPipeline>();
     context_->AddFactoryReflection<AssetTransformer>();
     AnimationVelocityExtractor::RegisterObject(context_);
+    ShaderCooker::RegisterObject(context_);
+    StaticModelMerger::RegisterObject(context_);
+    TextureAtlasPacker::RegisterObject(context_);
+    TextureCompressor::RegisterObject(context_);
+    VertexAnimationBaker::RegisterObject(context_);
 
     SubscribeToEvent(E_EXITREQUESTED, URHO3D_HANDLER(Engine, HandleExitRequested));
     SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(Engine, HandleEndFrame));
@@ -245,7 +296,9 @@ bool Engine::Initialize(const StringVariantMap& applicationParameters, const Str
     if (initialized_)
         return true;
 
-    URHO3D_PROFILE("InitEngine");
+    startupTimer_.Reset();
+    startupPhases_.clear();
+    URHO3D_STARTUP_PHASE("InitEngine");
 
     engineParameters_->DefineVariables(applicationParameters);
     engineParameters_->UpdatePriorityVariables(commandLineParameters);
@@ -267,6 +320,8 @@ bool Engine::Initialize(const StringVariantMap& applicationParameters, const Str
         if (HasParameter(EP_LOG_LEVEL))
             log->SetLevel(static_cast<LogLevel>(GetParameter(EP_LOG_LEVEL).GetInt()));
         log->SetQuiet(GetParameter(EP_LOG_QUIET).GetBool());
+        if (GetParameter(EP_LOG_ASYNC).GetBool())
+            log->SetAsync(true);
         const ea::string logFileName = GetLogFileName(GetParameter(EP_LOG_NAME).GetString());
         if (!logFileName.empty())
             log->Open(logFileName);
@@ -276,18 +331,41 @@ bool Engine::Initialize(const StringVariantMap& applicationParameters, const Str
     if (!appPreferencesDir_.empty())
         fileSystem->CreateDir(appPreferencesDir_);
 
-    InitializeVirtualFileSystem();
+    // Set amount of worker threads according to the available physical CPU cores. Using also hyperthreaded cores results in
+    // unpredictable extra synchronization overhead. Also reserve one core for the main thread.
+    // Threads are started before the file system is mounted so packages are opened in parallel,
+    // hence the parameter is taken only from application and command line parameters.
+    {
+        URHO3D_STARTUP_PHASE("InitWorkQueue");
+#ifdef URHO3D_THREADING
+        const unsigned numThreads = GetParameter(EP_WORKER_THREADS).GetBool() ? GetNumPhysicalCPUs() - 1 : 0;
+#else
+        const unsigned numThreads = 0;
+#endif
+        GetSubsystem<WorkQueue>()->Initialize(numThreads);
+        FrameAllocator::Initialize(WorkQueue::GetThreadIndexCount());
+    }
+
+    {
+        URHO3D_STARTUP_PHASE("InitVirtualFileSystem");
+        InitializeVirtualFileSystem();
+    }
 
     // Read and merge configs
-    LoadConfigFiles();
+    {
+        URHO3D_STARTUP_PHASE("LoadConfigFiles");
+        LoadConfigFiles();
+    }
 
     // Override config values with command line parameters
     engineParameters_->DefineVariables(commandLineParameters);
 
     // Set headless mode
     headless_ = GetParameter(EP_HEADLESS).GetBool();
+    leanHeadless_ = headless_ && GetParameter(EP_LEAN_HEADLESS).GetBool();
 
     // Register the rest of the subsystems
+    ea::optional<StartupPhaseScope> subsystemsPhase{ea::in_place, startupPhases_, startupTimer_, "CreateSubsystems"};
     context_->RegisterSubsystem(new Input(context_));
     RegisterInputLibrary(context_);
 
@@ -315,6 +393,7 @@ bool Engine::Initialize(const StringVariantMap& applicationParameters, const Str
 #endif
 
     context_->RegisterSubsystem(new PluginManager(context_));
+    subsystemsPhase.reset();
 
     // Set maximally accurate low res timer
     GetSubsystem<Time>()->SetTimerPeriod(1);
@@ -323,20 +402,12 @@ bool Engine::Initialize(const StringVariantMap& applicationParameters, const Str
     if (GetParameter(EP_FRAME_LIMITER) == false)
         SetMaxFps(0);
 
-    // Set amount of worker threads according to the available physical CPU cores. Using also hyperthreaded cores results in
-    // unpredictable extra synchronization overhead. Also reserve one core for the main thread
-#ifdef URHO3D_THREADING
-    const unsigned numThreads = GetParameter(EP_WORKER_THREADS).GetBool() ? GetNumPhysicalCPUs() - 1 : 0;
-#else
-    const unsigned numThreads = 0;
-#endif
-    GetSubsystem<WorkQueue>()->Initialize(numThreads);
-
     auto* cache = GetSubsystem<ResourceCache>();
 
     // Initialize graphics & audio output
     if (!headless_)
     {
+        URHO3D_STARTUP_PHASE("InitGraphics");
         auto* graphics = GetSubsystem<Graphics>();
         auto* renderer = GetSubsystem<Renderer>();
 
@@ -372,10 +443,14 @@ bool Engine::Initialize(const StringVariantMap& applicationParameters, const Str
         graphicsSettings.d3d12_ = d3d12Tweaks.value_or(RenderDeviceSettingsD3D12{});
 
         graphicsSettings.shaderCacheDir_ = FileIdentifier::FromUri(GetParameter(EP_SHADER_CACHE_DIR).GetString());
+        graphicsSettings.cookedShaderCacheDir_ =
+            FileIdentifier::FromUri(GetParameter(EP_COOKED_SHADER_CACHE_DIR).GetString());
         graphicsSettings.logShaderSources_ = GetParameter(EP_SHADER_LOG_SOURCES).GetBool();
         graphicsSettings.validateShaders_ = GetParameter(EP_VALIDATE_SHADERS).GetBool();
         graphicsSettings.discardShaderCache_ = GetParameter(EP_DISCARD_SHADER_CACHE).GetBool();
         graphicsSettings.cacheShaders_ = GetParameter(EP_SAVE_SHADER_CACHE).GetBool();
+        graphicsSettings.asyncShaderCompilation_ = GetParameter(EP_ASYNC_SHADER_COMPILATION).GetBool();
+        graphicsSettings.pipelinedPresent_ = GetParameter(EP_PIPELINED_PRESENT).GetBool();
 
         WindowSettings windowSettings;
         const int width = GetParameter(EP_WINDOW_WIDTH).GetInt();
@@ -433,8 +508,11 @@ bool Engine::Initialize(const StringVariantMap& applicationParameters, const Str
             SetParameter(EP_MONITOR, eventData[P_MONITOR].GetInt());
         });
 
-        if (!graphics->SetDefaultWindowModes(windowSettings))
-            return false;
+        {
+            URHO3D_STARTUP_PHASE("CreateWindow");
+            if (!graphics->SetDefaultWindowModes(windowSettings))
+                return false;
+        }
 
         if (HasParameter(EP_WINDOW_POSITION_X) && HasParameter(EP_WINDOW_POSITION_Y))
             graphics->SetWindowPosition(GetParameter(EP_WINDOW_POSITION_X).GetInt(),
@@ -443,14 +521,24 @@ bool Engine::Initialize(const StringVariantMap& applicationParameters, const Str
         if (GetParameter(EP_WINDOW_MAXIMIZE).GetBool())
             graphics->Maximize();
 
-        graphics->InitializePipelineStateCache(FileIdentifier::FromUri(GetParameter(EP_PSO_CACHE).GetString()));
+        {
+            URHO3D_STARTUP_PHASE("LoadPipelineStateCache");
+            graphics->InitializePipelineStateCache(FileIdentifier::FromUri(GetParameter(EP_PSO_CACHE).GetString()));
+        }
 
         renderer->SetTextureQuality((MaterialQuality)GetParameter(EP_TEXTURE_QUALITY).GetInt());
         renderer->SetTextureFilterMode((TextureFilterMode)GetParameter(EP_TEXTURE_FILTER_MODE).GetInt());
         renderer->SetTextureAnisotropy(GetParameter(EP_TEXTURE_ANISOTROPY).GetInt());
 
+        if (GetParameter(EP_TEXTURE_STREAMING).GetBool())
+            context_->RegisterSubsystem(new TextureResidencyManager(context_));
+
+        if (GetParameter(EP_MODEL_STREAMING).GetBool())
+            context_->RegisterSubsystem(new ModelResidencyManager(context_));
+
         if (GetParameter(EP_SOUND).GetBool())
         {
+            URHO3D_STARTUP_PHASE("InitAudio");
             GetSubsystem<Audio>()->SetMode(
                 GetParameter(EP_SOUND_BUFFER).GetInt(),
                 GetParameter(EP_SOUND_MIX_RATE).GetInt(),
@@ -479,6 +567,7 @@ bool Engine::Initialize(const StringVariantMap& applicationParameters, const Str
     if (!headless_)
     {
 #ifdef URHO3D_SYSTEMUI
+        URHO3D_STARTUP_PHASE("InitSystemUI");
         context_->RegisterSubsystem(new SystemUI(context_,
             GetParameter(EP_SYSTEMUI_FLAGS).GetUInt()));
         RegisterStandardSerializableHooks(context_);
@@ -487,12 +576,22 @@ bool Engine::Initialize(const StringVariantMap& applicationParameters, const Str
 
     frameTimer_.Reset();
 
-    URHO3D_LOGINFO("Initialized engine");
+    URHO3D_LOGINFO("Initialized engine in {:.1f} ms", startupTimer_.GetUSec(false) / 1000.0);
+    URHO3D_LOGDEBUG("Engine startup phases:\n{}", FormatStartupPhases());
     initialized_ = true;
     SendEvent(E_ENGINEINITIALIZED);
     return true;
 }
 
+ea::string Engine::FormatStartupPhases() const
+{
+    ea::string result;
+    result += Format("{:<32} {:>10} {:>10}\n", "Phase", "Start, ms", "Time, ms");
+    for (const EngineStartupPhase& phase : startupPhases_)
+        result += Format("{:<32} {:>10.1f} {:>10.1f}\n", phase.name_, phase.startMs_, phase.durationMs_);
+    return result;
+}
+
 void Engine::InitializeVirtualFileSystem()
 {
     auto fileSystem = GetSubsystem<FileSystem>();
@@ -509,6 +608,7 @@ void Engine::InitializeVirtualFileSystem()
         absolutePrefixPaths.push_back(programDir);
 
     vfs->UnmountAll();
+    vfs->SetMemoryMappedPackages(GetParameter(EP_MEMORY_MAPPED_PACKAGES).GetBool());
     vfs->MountRoot();
     vfs->MountExistingDirectoriesOrPackages(absolutePrefixPaths, paths);
     vfs->MountExistingPackages(absolutePrefixPaths, packages);
@@ -587,6 +687,19 @@ void Engine::RunFrame()
 
     time->EndFrame();
 
+    // Transient data of the frame is not used anymore
+    FrameAllocator::Reset();
+
+    // Collect built-in profiler statistics of the frame
+    FrameProfiler::EndFrame();
+    MemoryTracker::EndFrame();
+
+    // Report heap allocations of variants to track allocation churn
+#if URHO3D_PROFILING
+    URHO3D_PROFILE_VALUE("VariantAllocations", static_cast<int64_t>(Variant::GetNumHeapAllocations()));
+    Variant::ResetNumHeapAllocations();
+#endif
+
     // Mark a frame for profiling
     URHO3D_PROFILE_FRAME();
 }
@@ -825,8 +938,9 @@ void Engine::DumpMemory()
 
     URHO3D_LOGINFO("Total allocated memory {} bytes in {} blocks", total, blocks);
 #else
-    URHO3D_LOGINFO("DumpMemory() supported on MSVC debug mode only");
+    URHO3D_LOGINFO("DumpMemory() of heap blocks supported on MSVC debug mode only");
 #endif
+    URHO3D_LOGINFO("Tracked memory:\n{}", MemoryTracker::FormatStats(MemoryTracker::GetStats()));
 #endif
 }
 
@@ -843,11 +957,17 @@ void Engine::Update()
     SendEvent(E_INPUTREADY, eventData);
 
     // Logic update event
+    SendEvent(UpdateTypedEvent{timeStep_});
     SendEvent(E_UPDATE, eventData);
 
     // Logic post-update event
+    SendEvent(PostUpdateTypedEvent{timeStep_});
     SendEvent(E_POSTUPDATE, eventData);
 
+    // Present previous frame before rendering update may touch GPU resources
+    if (auto graphics = GetSubsystem<Graphics>())
+        graphics->PresentPendingFrame();
+
     // Rendering update event
     SendEvent(E_RENDERUPDATE, eventData);
 
@@ -1017,6 +1137,7 @@ void Engine::DefineParameters(CLI::App& commandLine, StringVariantMap& enginePar
     };
 
     addFlag("--headless", EP_HEADLESS, true, "Do not initialize graphics subsystem");
+    addFlag("--lean-headless", EP_LEAN_HEADLESS, true, "Skip render-only work of scene components in headless mode");
     addFlag("--validate-shaders", EP_VALIDATE_SHADERS, true, "Validate shaders before submitting them to GAPI");
     addFlag("--nolimit", EP_FRAME_LIMITER, false, "Disable frame limiter");
     addOptionPrependString("--landscape", EP_ORIENTATIONS, "LandscapeLeft LandscapeRight ", "Force landscape orientation");
@@ -1039,6 +1160,7 @@ void Engine::DefineParameters(CLI::App& commandLine, StringVariantMap& enginePar
         return true;
     })->type_name(createOptions("string in {%s}", logLevelNames).c_str())->type_size(1);
     addOptionString("--log-file", EP_LOG_NAME, "Log output file");
+    addFlag("--log-async", EP_LOG_ASYNC, true, "Write log messages from the dedicated thread");
     addOptionInt("-x,--width", EP_WINDOW_WIDTH, "Window width");
     addOptionInt("-y,--height", EP_WINDOW_HEIGHT, "Window height");
     addOptionInt("--monitor", EP_MONITOR, "Create window on the specified monitor");
@@ -1136,6 +1258,8 @@ void Engine::PopulateDefaultParameters()
 
     engineParameters_->DefineVariable(EP_APPLICATION_NAME, "Unspecified Application");
     engineParameters_->DefineVariable(EP_APPLICATION_PREFERENCES_DIR, EMPTY_STRING);
+    engineParameters_->DefineVariable(EP_ASYNC_SHADER_COMPILATION, false);
+    engineParameters_->DefineVariable(EP_PIPELINED_PRESENT, false);
     engineParameters_->DefineVariable(EP_AUTOLOAD_PATHS, "Autoload").CommandLinePriority();
     engineParameters_->DefineVariable(EP_CONFIG_NAME, "EngineParameters.json");
     engineParameters_->DefineVariable(EP_BORDERLESS, true).Overridable();
@@ -1147,10 +1271,14 @@ void Engine::PopulateDefaultParameters()
     engineParameters_->DefineVariable(EP_FULL_SCREEN, false).Overridable();
     engineParameters_->DefineVariable(EP_GPU_DEBUG, false);
     engineParameters_->DefineVariable(EP_HEADLESS, false);
+    engineParameters_->DefineVariable(EP_LEAN_HEADLESS, false);
+    engineParameters_->DefineVariable(EP_LOG_ASYNC, false).CommandLinePriority();
     engineParameters_->DefineVariable(EP_LOG_LEVEL, LOG_TRACE).CommandLinePriority();
     engineParameters_->DefineVariable(EP_LOG_NAME, "conf://Urho3D.log").CommandLinePriority();
     engineParameters_->DefineVariable(EP_LOG_QUIET, false).CommandLinePriority();
     engineParameters_->DefineVariable(EP_MAIN_PLUGIN, EMPTY_STRING);
+    engineParameters_->DefineVariable(EP_MEMORY_MAPPED_PACKAGES, false);
+    engineParameters_->DefineVariable(EP_MODEL_STREAMING, false).Overridable();
     engineParameters_->DefineVariable(EP_MONITOR, 0).Overridable();
     engineParameters_->DefineVariable(EP_MULTI_SAMPLE, 1);
     engineParameters_->DefineVariable(EP_ORGANIZATION_NAME, "Urho3D Rebel Fork");
@@ -1163,6 +1291,7 @@ void Engine::PopulateDefaultParameters()
     engineParameters_->DefineVariable(EP_RESOURCE_PREFIX_PATHS, EMPTY_STRING).CommandLinePriority();
     engineParameters_->DefineVariable(EP_SAVE_SHADER_CACHE, true);
     engineParameters_->DefineVariable(EP_SHADER_CACHE_DIR, "conf://ShaderCache");
+    engineParameters_->DefineVariable(EP_COOKED_SHADER_CACHE_DIR, "ShaderCache");
     engineParameters_->DefineVariable(EP_SHADER_POLICY).SetOptional<int>();
     engineParameters_->DefineVariable(EP_SHADER_LOG_SOURCES, false);
     engineParameters_->DefineVariable(EP_SOUND, true);
@@ -1174,6 +1303,7 @@ void Engine::PopulateDefaultParameters()
     engineParameters_->DefineVariable(EP_TEXTURE_ANISOTROPY, 4).Overridable();
     engineParameters_->DefineVariable(EP_TEXTURE_FILTER_MODE, FILTER_TRILINEAR).Overridable();
     engineParameters_->DefineVariable(EP_TEXTURE_QUALITY, QUALITY_HIGH).Overridable();
+    engineParameters_->DefineVariable(EP_TEXTURE_STREAMING, false).Overridable();
     engineParameters_->DefineVariable(EP_TIME_OUT, 0);
     engineParameters_->DefineVariable(EP_TOUCH_EMULATION, false);
     engineParameters_->DefineVariable(EP_TWEAK_D3D12, ToJSONString(d3d12Tweaks).value_or(""));
@@ -1188,7 +1318,7 @@ void Engine::PopulateDefaultParameters()
     engineParameters_->DefineVariable(EP_WINDOW_RESIZABLE, false);
     engineParameters_->DefineVariable(EP_WINDOW_TITLE, "Urho3D");
     engineParameters_->DefineVariable(EP_WINDOW_WIDTH, 0); //.Overridable();
-    engineParameters_->DefineVariable(EP_WORKER_THREADS, true);
+    engineParameters_->DefineVariable(EP_WORKER_THREADS, true).CommandLinePriority();
     engineParameters_->DefineVariable(EP_PSO_CACHE, "conf://psocache.bin");
     engineParameters_->DefineVariable(EP_RENDER_BACKEND).SetOptional<int>();
     engineParameters_->DefineVariable(EP_XR, defaultXR);
@@ -39,6 +39,17 @@ namespace Urho3D
 class Console;
 class DebugHud;
 
+/// Timing of engine initialization phase.
+struct EngineStartupPhase
+{
+    /// Phase name.
+    const char* name_{};
+    /// Time from the start of initialization in milliseconds.
+    double startMs_{};
+    /// Duration of the phase in milliseconds.
+    double durationMs_{};
+};
+
 /// Urho3D engine. Creates the other subsystems.
 class URHO3D_API Engine : public Object
 {
@@ -94,9 +105,14 @@ public:
     void DumpProfiler();
     /// Dump information of all resources to the log.
     void DumpResources(bool dumpFileName = false);
-    /// Dump information of all memory allocations to the log. Supported in MSVC debug mode only.
+    /// Dump information of all memory allocations to the log. Heap blocks are dumped in MSVC debug mode only, tracked memory tags are dumped always.
     void DumpMemory();
 
+    /// Return timings of initialization phases in the order of completion. Nested phases are listed before the parent.
+    const ea::vector<EngineStartupPhase>& GetStartupPhases() const { return startupPhases_; }
+    /// Format startup phases as a human-readable table.
+    ea::string FormatStartupPhases() const;
+
     /// Return preference directory name.
     const ea::string& GetAppPreferencesDir() const { return appPreferencesDir_; }
 
@@ -138,6 +154,8 @@ public:
     /// Return whether the engine has been created in headless mode.
     /// @property
     bool IsHeadless() const { return headless_; }
+    /// Return whether the engine is headless and scene components should skip work that is only needed for rendering.
+    bool IsLeanHeadless() const { return leanHeadless_; }
 
     /// Send frame update events.
     void Update();
@@ -174,6 +192,10 @@ private:
     ea::string appPreferencesDir_;
     /// Frame update timer.
     HiresTimer frameTimer_;
+    /// Timer started at the beginning of initialization.
+    HiresTimer startupTimer_;
+    /// Timings of initialization phases.
+    ea::vector<EngineStartupPhase> startupPhases_;
     /// Previous timesteps for smoothing.
     ea::vector<float> lastTimeSteps_;
     /// Next frame timestep in seconds.
@@ -200,6 +222,8 @@ private:
     bool exiting_;
     /// Headless mode flag.
     bool headless_;
+    /// Lean headless mode flag.
+    bool leanHeadless_{};
     /// Audio paused flag.
     bool audioPaused_;
 };
@@ -34,9 +34,11 @@ namespace Urho3D
 /// @{
 URHO3D_GLOBAL_CONSTANT(ConstString EP_APPLICATION_NAME{"ApplicationName"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_APPLICATION_PREFERENCES_DIR{"ApplicationPreferencesDir"});
+URHO3D_GLOBAL_CONSTANT(ConstString EP_ASYNC_SHADER_COMPILATION{"AsyncShaderCompilation"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_AUTOLOAD_PATHS{"AutoloadPaths"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_BORDERLESS{"Borderless"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_CONFIG_NAME{"ConfigName"});
+URHO3D_GLOBAL_CONSTANT(ConstString EP_COOKED_SHADER_CACHE_DIR{"CookedShaderCacheDir"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_DISCARD_SHADER_CACHE{"DiscardShaderCache"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_ENGINE_AUTO_LOAD_SCRIPTS{"EngineAutoLoadScripts"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_ENGINE_CLI_PARAMETERS{"EngineCliParameters"});
@@ -45,16 +47,21 @@ URHO3D_GLOBAL_CONSTANT(ConstString EP_FRAME_LIMITER{"FrameLimiter"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_FULL_SCREEN{"FullScreen"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_GPU_DEBUG{"GPUDebug"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_HEADLESS{"Headless"});
+URHO3D_GLOBAL_CONSTANT(ConstString EP_LEAN_HEADLESS{"LeanHeadless"});
+URHO3D_GLOBAL_CONSTANT(ConstString EP_LOG_ASYNC{"LogAsync"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_LOG_LEVEL{"LogLevel"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_LOG_NAME{"LogName"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_LOG_QUIET{"LogQuiet"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_MAIN_PLUGIN{"MainPlugin"});
+URHO3D_GLOBAL_CONSTANT(ConstString EP_MEMORY_MAPPED_PACKAGES{"MemoryMappedPackages"});
+URHO3D_GLOBAL_CONSTANT(ConstString EP_MODEL_STREAMING{"ModelStreaming"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_MONITOR{"Monitor"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_MULTI_SAMPLE{"MultiSample"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_ORGANIZATION_NAME{"OrganizationName"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_ORIENTATIONS{"Orientations"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_PACKAGE_CACHE_DIR{"PackageCacheDir"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_PLUGINS{"Plugins"});
+URHO3D_GLOBAL_CONSTANT(ConstString EP_PIPELINED_PRESENT{"PipelinedPresent"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_REFRESH_RATE{"RefreshRate"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_RESOURCE_PACKAGES{"ResourcePackages"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_RESOURCE_PATHS{"ResourcePaths"});
@@ -72,6 +79,7 @@ URHO3D_GLOBAL_CONSTANT(ConstString EP_SYSTEMUI_FLAGS{"SystemUIFlags"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_TEXTURE_ANISOTROPY{"TextureAnisotropy"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_TEXTURE_FILTER_MODE{"TextureFilterMode"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_TEXTURE_QUALITY{"TextureQuality"});
+URHO3D_GLOBAL_CONSTANT(ConstString EP_TEXTURE_STREAMING{"TextureStreaming"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_TIME_OUT{"TimeOut"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_TOUCH_EMULATION{"TouchEmulation"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_TWEAK_D3D12{"TweakD3D12"});
@@ -59,11 +59,13 @@ URHO3D_EVENT(E_APPLICATIONSTOPPED, ApplicationStopped)
 /// Begin plugin reloading.
 URHO3D_EVENT(E_BEGINPLUGINRELOAD, BeginPluginReload)
 {
+    URHO3D_PARAM(P_PARTIAL, Partial);          // bool, only types from PluginManager::GetReloadingTypes are unloaded
 }
 
 /// End plugin reloading.
 URHO3D_EVENT(E_ENDPLUGINRELOAD, EndPluginReload)
 {
+    URHO3D_PARAM(P_PARTIAL, Partial);          // bool
 }
 
 }
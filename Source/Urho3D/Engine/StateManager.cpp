@@ -31,6 +31,7 @@
 #include "../Graphics/Zone.h"
 #include "../UI/UI.h"
 #include "../Resource/ResourceCache.h"
+#include "../Resource/ResourceEvents.h"
 #if URHO3D_SYSTEMUI
     #include "../SystemUI/Console.h"
 #endif
@@ -119,6 +120,24 @@ bool ApplicationState::CanLeaveState() const
 /// Handle the logic update event.
 void ApplicationState::Update(float timeStep) {}
 
+/// Collect resources that should be loaded in background before the state is activated.
+void ApplicationState::GetPreloadResources(const StringVariantMap& bundle, ea::vector<ResourceRef>& resources) const
+{
+    resources.insert(resources.end(), preloadManifest_.begin(), preloadManifest_.end());
+}
+
+/// Add resource to the preload manifest.
+void ApplicationState::AddPreloadResource(StringHash type, const ea::string& name)
+{
+    preloadManifest_.emplace_back(type, name);
+}
+
+/// Remove all resources from the preload manifest.
+void ApplicationState::RemoveAllPreloadResources()
+{
+    preloadManifest_.clear();
+}
+
 /// Deactivate game screen. Executed by Application.
 void ApplicationState::Deactivate()
 {
@@ -409,6 +428,7 @@ void StateManager::Reset()
     }
     ea::queue<QueueItem> emptyQueue;
     std::swap(stateQueue_, emptyQueue);
+    ResetPreload();
 
     SetTransitionState(TransitionState::Sustain);
     if (hasState)
@@ -558,7 +578,11 @@ void StateManager::InitiateTransition()
     {
         if (activeState_ != nullptr)
         {
-            SetTransitionState(TransitionState::FadeOut);
+            PreloadNextState();
+            if (IsPreloadComplete())
+                SetTransitionState(TransitionState::FadeOut);
+            else
+                SetTransitionState(TransitionState::WaitToExit);
         }
         else
         {
@@ -623,7 +647,7 @@ void StateManager::Update(float timeStep)
         case TransitionState::Sustain:
             return;
         case TransitionState::WaitToExit:
-            if (activeState_ && activeState_->CanLeaveState())
+            if (activeState_ && activeState_->CanLeaveState() && IsPreloadComplete())
                 SetTransitionState(TransitionState::FadeOut);
             else
                 return;
@@ -634,10 +658,11 @@ void StateManager::Update(float timeStep)
             {
                 timeStep = fadeTime_ - fadeInDuration_;
                 CompleteTransition();
+                PreloadNextState();
 
                 if (stateQueue_.empty())
                     SetTransitionState(TransitionState::Sustain);
-                else if (activeState_ && !activeState_->CanLeaveState())
+                else if (activeState_ && (!activeState_->CanLeaveState() || !IsPreloadComplete()))
                     SetTransitionState(TransitionState::WaitToExit);
                 else
                     SetTransitionState(TransitionState::FadeOut);
@@ -676,23 +701,11 @@ void StateManager::CreateNextState()
     {
         QueueItem nextQueueItem = stateQueue_.front();
         stateQueue_.pop();
-        SharedPtr<ApplicationState> nextState = nextQueueItem.state_;
+        SharedPtr<ApplicationState> nextState = ResolveState(nextQueueItem);
         if (!nextState)
         {
-            auto stateCacheIt = stateCache_.find(nextQueueItem.stateType_);
-            if (stateCacheIt != stateCache_.end() && !stateCacheIt->second.Expired())
-            {
-                nextState = stateCacheIt->second.Lock();
-            }
-            else
-            {
-                nextState.DynamicCast(context_->CreateObject(nextQueueItem.stateType_));
-                if (!nextState)
-                {
-                    URHO3D_LOGERROR("Can't create application state object");
-                    continue;
-                }
-            }
+            URHO3D_LOGERROR("Can't create application state object");
+            continue;
         }
         destinationState_ = nextState->GetType();
         stateCache_[destinationState_] = nextState;
@@ -707,12 +720,119 @@ void StateManager::CreateNextState()
         SetTransitionState(TransitionState::FadeIn);
         activeState_->Activate(nextQueueItem.bundle_);
         UpdateFadeOverlay(0.0f);
+
+        // Preloaded resources are owned by the state now, start loading the state after it
+        ResetPreload();
+        PreloadNextState();
         return;
     }
     destinationState_ = StringHash::Empty;
+    ResetPreload();
     SetTransitionState(TransitionState::Sustain);
     CompleteTransition();
 }
 
+/// Return state object for the queue item, creating it if necessary.
+SharedPtr<ApplicationState> StateManager::ResolveState(QueueItem& item)
+{
+    if (!item.state_)
+    {
+        auto stateCacheIt = stateCache_.find(item.stateType_);
+        if (stateCacheIt != stateCache_.end() && !stateCacheIt->second.Expired())
+            item.state_ = stateCacheIt->second.Lock();
+        else
+            item.state_.DynamicCast(context_->CreateObject(item.stateType_));
+    }
+    return item.state_;
+}
+
+/// Start background loading of resources of the next state in the queue.
+void StateManager::PreloadNextState()
+{
+    if (stateQueue_.empty())
+        return;
+
+    QueueItem& nextQueueItem = stateQueue_.front();
+    SharedPtr<ApplicationState> nextState = ResolveState(nextQueueItem);
+    if (!nextState || preloadState_.Get() == nextState.Get())
+        return;
+
+    ResetPreload();
+    preloadState_ = nextState;
+
+    ea::vector<ResourceRef> resources;
+    nextState->GetPreloadResources(nextQueueItem.bundle_, resources);
+
+    auto* cache = context_->GetSubsystem<ResourceCache>();
+    for (const ResourceRef& resourceRef : resources)
+    {
+        const ea::string name = cache->SanitateResourceName(resourceRef.name_);
+        if (name.empty() || pendingPreloadResources_.find(name) != pendingPreloadResources_.end())
+            continue;
+
+        if (!context_->IsReflected(resourceRef.type_))
+        {
+            URHO3D_LOGWARNING("Cannot preload resource '{}' of unknown type", name);
+            continue;
+        }
+
+        ++numPreloadResources_;
+        cache->BackgroundLoadResource(resourceRef.type_, name);
+
+        // Resource is already loaded or threading is not supported
+        if (Resource* resource = cache->GetExistingResource(resourceRef.type_, name))
+            preloadedResources_.emplace_back(resource);
+        else
+            pendingPreloadResources_.insert(name);
+    }
+
+    if (!pendingPreloadResources_.empty())
+        SubscribeToEvent(E_RESOURCEBACKGROUNDLOADED, URHO3D_HANDLER(StateManager, HandleResourceBackgroundLoaded));
+}
+
+/// Forget resources of the next state.
+void StateManager::ResetPreload()
+{
+    UnsubscribeFromEvent(E_RESOURCEBACKGROUNDLOADED);
+    preloadState_.Reset();
+    pendingPreloadResources_.clear();
+    preloadedResources_.clear();
+    numPreloadResources_ = 0;
+}
+
+/// Return loading progress of the next state resources, from 0 to 1.
+float StateManager::GetPreloadProgress() const
+{
+    if (numPreloadResources_ == 0)
+        return 1.0f;
+    return static_cast<float>(numPreloadResources_ - pendingPreloadResources_.size()) / numPreloadResources_;
+}
+
+/// Handle background loaded resource of the next state.
+void StateManager::HandleResourceBackgroundLoaded(StringHash eventName, VariantMap& args)
+{
+    using namespace ResourceBackgroundLoaded;
+    const auto iter = pendingPreloadResources_.find(args[P_RESOURCENAME].GetString());
+    if (iter == pendingPreloadResources_.end())
+        return;
+
+    pendingPreloadResources_.erase(iter);
+    if (args[P_SUCCESS].GetBool())
+        preloadedResources_.emplace_back(static_cast<Resource*>(args[P_RESOURCE].GetPtr()));
+
+    if (pendingPreloadResources_.empty())
+        UnsubscribeFromEvent(E_RESOURCEBACKGROUNDLOADED);
+
+    {
+        using namespace StatePreloadProgress;
+        auto& data = context_->GetEventDataMap();
+        data[P_STATE] = preloadState_ ? preloadState_->GetType() : StringHash::Empty;
+        data[P_PROGRESS] = GetPreloadProgress();
+        data[P_NUMLOADED] = numPreloadResources_ - pendingPreloadResources_.size();
+        data[P_NUMTOTAL] = numPreloadResources_;
+        SendEvent(E_STATEPRELOADPROGRESS, data);
+    }
+}
+
 
 } // namespace Urho3D
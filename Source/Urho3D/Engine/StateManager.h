@@ -31,9 +31,11 @@
 #endif
 
 #include <EASTL/queue.h>
+#include <EASTL/unordered_set.h>
 
 namespace Urho3D
 {
+class Resource;
 class ResourceCache;
 class UI;
 
@@ -68,6 +70,17 @@ public:
     /// Handle the logic update event.
     virtual void Update(float timeStep);
 
+    /// Collect resources that should be loaded in background before the state is activated.
+    /// Executed by StateManager while the previous state is still running. By default returns the preload manifest.
+    virtual void GetPreloadResources(const StringVariantMap& bundle, ea::vector<ResourceRef>& resources) const;
+
+    /// Add resource to the preload manifest. SceneResource may be used to preload scenes.
+    void AddPreloadResource(StringHash type, const ea::string& name);
+    /// Remove all resources from the preload manifest.
+    void RemoveAllPreloadResources();
+    /// Return preload manifest.
+    const ea::vector<ResourceRef>& GetPreloadManifest() const { return preloadManifest_; }
+
     /// Get activation flag. Returns true if game screen is active.
     bool IsActive() const { return active_; }
 
@@ -171,6 +184,8 @@ private:
     Color fogColor_{0.0f, 0.0f, 0.0f};
     /// Saved fog color to be restored at deactivation.
     Color savedFogColor_{};
+    /// Resources to load in background before activation.
+    ea::vector<ResourceRef> preloadManifest_;
 #if URHO3D_ACTIONS
     /// Local action manager.
     SharedPtr<ActionManager> actionManager_;
@@ -239,6 +254,15 @@ public:
     /// Get fade out animation duration;
     float GetFadeOutDuration() const { return fadeOutDuration_; }
 
+    /// Return whether all resources of the next state are loaded.
+    bool IsPreloadComplete() const { return pendingPreloadResources_.empty(); }
+    /// Return loading progress of the next state resources, from 0 to 1.
+    float GetPreloadProgress() const;
+    /// Return total number of resources preloaded for the next state.
+    unsigned GetNumPreloadResources() const { return numPreloadResources_; }
+    /// Return number of resources of the next state that are not loaded yet.
+    unsigned GetNumPendingPreloadResources() const { return pendingPreloadResources_.size(); }
+
 private:
     /// Initiate state transition if necessary.
     void InitiateTransition();
@@ -264,6 +288,18 @@ private:
     /// Dequeue and set next state as active.
     void CreateNextState();
 
+    /// Return state object for the queue item, creating it if necessary.
+    SharedPtr<ApplicationState> ResolveState(QueueItem& item);
+
+    /// Start background loading of resources of the next state in the queue.
+    void PreloadNextState();
+
+    /// Forget resources of the next state.
+    void ResetPreload();
+
+    /// Handle background loaded resource of the next state.
+    void HandleResourceBackgroundLoaded(StringHash eventName, VariantMap& args);
+
     /// Notify subscribers about transition state updates.
     void Notify(StringHash eventType);
 
@@ -294,6 +330,15 @@ private:
 
     /// State transition state.
     TransitionState transitionState_{TransitionState::Sustain};
+
+    /// State which resources are being preloaded.
+    WeakPtr<ApplicationState> preloadState_;
+    /// Resources of the next state that are still loading.
+    ea::unordered_set<ea::string> pendingPreloadResources_;
+    /// Loaded resources of the next state, held until the state is activated.
+    ea::vector<SharedPtr<Resource>> preloadedResources_;
+    /// Total number of resources of the next state.
+    unsigned numPreloadResources_{};
 };
 
 template <class T> void StateManager::EnqueueState(StringVariantMap& bundle)
@@ -51,4 +51,13 @@ URHO3D_EVENT(E_STATETRANSITIONCOMPLETE, StateTransitionComplete)
     URHO3D_PARAM(P_TO, To); // (StringHash) Destination state type hash
 }
 
+/// Resource of the next application state is loaded in background.
+URHO3D_EVENT(E_STATEPRELOADPROGRESS, StatePreloadProgress)
+{
+    URHO3D_PARAM(P_STATE, State); // (StringHash) Preloaded state type hash
+    URHO3D_PARAM(P_PROGRESS, Progress); // (float) Loading progress from 0 to 1
+    URHO3D_PARAM(P_NUMLOADED, NumLoaded); // (unsigned) Number of loaded resources
+    URHO3D_PARAM(P_NUMTOTAL, NumTotal); // (unsigned) Total number of resources
+}
+
 } // namespace Urho3D
@@ -26,9 +26,86 @@
 
 #include "../Glow/BakedLightCache.h"
 
+#include "../IO/File.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+
 namespace Urho3D
 {
 
+namespace
+{
+
+template <class T> void WriteVector(File& file, const ea::vector<T>& values)
+{
+    file.WriteUInt(values.size());
+    file.Write(values.data(), values.size() * sizeof(T));
+}
+
+template <class T> bool ReadVector(File& file, ea::vector<T>& values)
+{
+    const unsigned size = file.ReadUInt();
+    values.resize(size);
+    return file.Read(values.data(), size * sizeof(T)) == size * sizeof(T);
+}
+
+void WriteData(File& file, const LightmapChartBakedDirect& data)
+{
+    file.WriteUInt(data.lightmapSize_);
+    WriteVector(file, data.directLight_);
+    WriteVector(file, data.surfaceLight_);
+    WriteVector(file, data.albedo_);
+}
+
+bool ReadData(File& file, LightmapChartBakedDirect& data)
+{
+    data.lightmapSize_ = file.ReadUInt();
+    data.realLightmapSize_ = static_cast<float>(data.lightmapSize_);
+    return ReadVector(file, data.directLight_) && ReadVector(file, data.surfaceLight_)
+        && ReadVector(file, data.albedo_);
+}
+
+unsigned long long GetDataSize(const LightmapChartBakedDirect& data)
+{
+    return (data.directLight_.size() + data.surfaceLight_.size() + data.albedo_.size()) * sizeof(Vector3);
+}
+
+void WriteData(File& file, const LightmapChartBakedIndirect& data)
+{
+    file.WriteUInt(data.lightmapSize_);
+    WriteVector(file, data.light_);
+}
+
+bool ReadData(File& file, LightmapChartBakedIndirect& data)
+{
+    data.lightmapSize_ = file.ReadUInt();
+    return ReadVector(file, data.light_);
+}
+
+unsigned long long GetDataSize(const LightmapChartBakedIndirect& data)
+{
+    return data.light_.size() * sizeof(Vector4);
+}
+
+void WriteData(File& file, const BakedLightmap& data)
+{
+    file.WriteUInt(data.lightmapSize_);
+    WriteVector(file, data.lightmap_);
+}
+
+bool ReadData(File& file, BakedLightmap& data)
+{
+    data.lightmapSize_ = file.ReadUInt();
+    return ReadVector(file, data.lightmap_);
+}
+
+unsigned long long GetDataSize(const BakedLightmap& data)
+{
+    return data.lightmap_.size() * sizeof(Vector3);
+}
+
+}
+
 BakedLightCache::~BakedLightCache() = default;
 
 void BakedLightMemoryCache::StoreBakedChunk(const IntVector3& chunk, BakedSceneChunk bakedChunk)
@@ -53,6 +130,17 @@ ea::shared_ptr<const LightmapChartBakedDirect> BakedLightMemoryCache::LoadDirect
     return iter != directLightCache_.end() ? iter->second : nullptr;
 }
 
+void BakedLightMemoryCache::StoreIndirectLight(unsigned lightmapIndex, LightmapChartBakedIndirect bakedIndirect)
+{
+    indirectLightCache_[lightmapIndex] = ea::make_shared<LightmapChartBakedIndirect>(ea::move(bakedIndirect));
+}
+
+ea::shared_ptr<const LightmapChartBakedIndirect> BakedLightMemoryCache::LoadIndirectLight(unsigned lightmapIndex)
+{
+    auto iter = indirectLightCache_.find(lightmapIndex);
+    return iter != indirectLightCache_.end() ? iter->second : nullptr;
+}
+
 void BakedLightMemoryCache::StoreLightmap(unsigned lightmapIndex, BakedLightmap bakedLightmap)
 {
     lightmapCache_[lightmapIndex] = ea::make_shared<BakedLightmap>(ea::move(bakedLightmap));
@@ -64,4 +152,164 @@ ea::shared_ptr<const BakedLightmap> BakedLightMemoryCache::LoadLightmap(unsigned
     return iter != lightmapCache_.end() ? iter->second : nullptr;
 }
 
+BakedLightFileCache::BakedLightFileCache(Context* context, const ea::string& directory, unsigned long long memoryLimit)
+    : context_(context)
+    , directory_(AddTrailingSlash(directory))
+    , memoryLimit_(memoryLimit)
+{
+    context_->GetSubsystem<FileSystem>()->CreateDirsRecursive(directory_);
+}
+
+BakedLightFileCache::~BakedLightFileCache()
+{
+    auto fs = context_->GetSubsystem<FileSystem>();
+    for (unsigned long long key : storedKeys_)
+    {
+        const auto type = static_cast<DataType>(key >> 32);
+        const auto lightmapIndex = static_cast<unsigned>(key & M_MAX_UNSIGNED);
+        fs->Delete(GetFileName(type, lightmapIndex));
+    }
+}
+
+void BakedLightFileCache::StoreBakedChunk(const IntVector3& chunk, BakedSceneChunk bakedChunk)
+{
+    bakedChunkCache_[chunk] = ea::make_shared<BakedSceneChunk>(ea::move(bakedChunk));
+}
+
+ea::shared_ptr<const BakedSceneChunk> BakedLightFileCache::LoadBakedChunk(const IntVector3& chunk)
+{
+    auto iter = bakedChunkCache_.find(chunk);
+    return iter != bakedChunkCache_.end() ? iter->second : nullptr;
+}
+
+void BakedLightFileCache::StoreDirectLight(unsigned lightmapIndex, LightmapChartBakedDirect bakedDirect)
+{
+    StoreData(DataType::DirectLight, lightmapIndex, ea::move(bakedDirect));
+}
+
+ea::shared_ptr<const LightmapChartBakedDirect> BakedLightFileCache::LoadDirectLight(unsigned lightmapIndex)
+{
+    return LoadData<LightmapChartBakedDirect>(DataType::DirectLight, lightmapIndex);
+}
+
+void BakedLightFileCache::StoreIndirectLight(unsigned lightmapIndex, LightmapChartBakedIndirect bakedIndirect)
+{
+    StoreData(DataType::IndirectLight, lightmapIndex, ea::move(bakedIndirect));
+}
+
+ea::shared_ptr<const LightmapChartBakedIndirect> BakedLightFileCache::LoadIndirectLight(unsigned lightmapIndex)
+{
+    return LoadData<LightmapChartBakedIndirect>(DataType::IndirectLight, lightmapIndex);
+}
+
+void BakedLightFileCache::StoreLightmap(unsigned lightmapIndex, BakedLightmap bakedLightmap)
+{
+    StoreData(DataType::Lightmap, lightmapIndex, ea::move(bakedLightmap));
+}
+
+ea::shared_ptr<const BakedLightmap> BakedLightFileCache::LoadLightmap(unsigned lightmapIndex)
+{
+    return LoadData<BakedLightmap>(DataType::Lightmap, lightmapIndex);
+}
+
+unsigned long long BakedLightFileCache::GetKey(DataType type, unsigned lightmapIndex)
+{
+    return (static_cast<unsigned long long>(type) << 32) | lightmapIndex;
+}
+
+ea::string BakedLightFileCache::GetFileName(DataType type, unsigned lightmapIndex) const
+{
+    static const char* prefixes[] = {"Direct", "Indirect", "Lightmap"};
+    return Format("{}{}-{}.bin", directory_, prefixes[static_cast<unsigned>(type)], lightmapIndex);
+}
+
+template <class T> void BakedLightFileCache::StoreData(DataType type, unsigned lightmapIndex, T data)
+{
+    const unsigned long long key = GetKey(type, lightmapIndex);
+    const ea::string fileName = GetFileName(type, lightmapIndex);
+
+    // Keep data in memory if it cannot be written
+    File file(context_, fileName, FILE_WRITE);
+    const bool isStored = file.IsOpen();
+    if (isStored)
+    {
+        WriteData(file, data);
+        storedKeys_.insert(key);
+    }
+    else
+        URHO3D_LOGWARNING("Cannot write light baking cache file '{}'", fileName);
+
+    const unsigned long long size = GetDataSize(data);
+    StoreInMemory(key, ea::make_shared<T>(ea::move(data)), size, isStored);
+}
+
+template <class T> ea::shared_ptr<const T> BakedLightFileCache::LoadData(DataType type, unsigned lightmapIndex)
+{
+    const unsigned long long key = GetKey(type, lightmapIndex);
+    if (ea::shared_ptr<const void> data = LoadFromMemory(key))
+        return ea::static_pointer_cast<const T>(data);
+
+    if (!storedKeys_.contains(key))
+        return nullptr;
+
+    const ea::string fileName = GetFileName(type, lightmapIndex);
+    const auto data = ea::make_shared<T>();
+    File file(context_, fileName);
+    if (!file.IsOpen() || !ReadData(file, *data))
+    {
+        URHO3D_LOGERROR("Cannot read light baking cache file '{}'", fileName);
+        return nullptr;
+    }
+
+    StoreInMemory(key, data, GetDataSize(*data), true);
+    return data;
+}
+
+void BakedLightFileCache::StoreInMemory(
+    unsigned long long key, ea::shared_ptr<const void> data, unsigned long long size, bool evictable)
+{
+    const auto iter = cachedData_.find(key);
+    if (iter != cachedData_.end())
+    {
+        memoryUse_ -= iter->second.size_;
+        lruList_.erase(iter->second.lruIterator_);
+        cachedData_.erase(iter);
+    }
+
+    lruList_.push_front(key);
+    CachedData& entry = cachedData_[key];
+    entry.data_ = ea::move(data);
+    entry.size_ = size;
+    entry.lruIterator_ = lruList_.begin();
+    entry.evictable_ = evictable;
+    memoryUse_ += size;
+
+    // Evict least recently used data, but keep the data that was just stored
+    auto lruIter = lruList_.end();
+    while (memoryUse_ > memoryLimit_ && lruIter != lruList_.begin())
+    {
+        --lruIter;
+        if (*lruIter == key)
+            break;
+
+        const auto dataIter = cachedData_.find(*lruIter);
+        if (!dataIter->second.evictable_)
+            continue;
+
+        memoryUse_ -= dataIter->second.size_;
+        cachedData_.erase(dataIter);
+        lruIter = lruList_.erase(lruIter);
+    }
+}
+
+ea::shared_ptr<const void> BakedLightFileCache::LoadFromMemory(unsigned long long key)
+{
+    const auto iter = cachedData_.find(key);
+    if (iter == cachedData_.end())
+        return nullptr;
+
+    lruList_.splice(lruList_.begin(), lruList_, iter->second.lruIterator_);
+    return iter->second.data_;
+}
+
 }
@@ -32,7 +32,9 @@
 #include "../Graphics/LightProbeGroup.h"
 #include "../Math/Vector3.h"
 
+#include <EASTL/list.h>
 #include <EASTL/shared_ptr.h>
+#include <EASTL/unordered_set.h>
 
 namespace Urho3D
 {
@@ -71,6 +73,11 @@ public:
     /// Load direct light for the lightmap chart.
     virtual ea::shared_ptr<const LightmapChartBakedDirect> LoadDirectLight(unsigned lightmapIndex) = 0;
 
+    /// Store accumulated indirect light for the lightmap chart.
+    virtual void StoreIndirectLight(unsigned lightmapIndex, LightmapChartBakedIndirect bakedIndirect) = 0;
+    /// Load accumulated indirect light for the lightmap chart.
+    virtual ea::shared_ptr<const LightmapChartBakedIndirect> LoadIndirectLight(unsigned lightmapIndex) = 0;
+
     /// Store baked lightmap.
     virtual void StoreLightmap(unsigned lightmapIndex, BakedLightmap bakedLightmap) = 0;
     /// Load baked lightmap.
@@ -91,6 +98,11 @@ public:
     /// Load direct light for the lightmap chart.
     ea::shared_ptr<const LightmapChartBakedDirect> LoadDirectLight(unsigned lightmapIndex) override;
 
+    /// Store accumulated indirect light for the lightmap chart.
+    void StoreIndirectLight(unsigned lightmapIndex, LightmapChartBakedIndirect bakedIndirect) override;
+    /// Load accumulated indirect light for the lightmap chart.
+    ea::shared_ptr<const LightmapChartBakedIndirect> LoadIndirectLight(unsigned lightmapIndex) override;
+
     /// Store baked lightmap.
     void StoreLightmap(unsigned lightmapIndex, BakedLightmap bakedLightmap) override;
     /// Load baked lightmap.
@@ -101,8 +113,96 @@ private:
     ea::unordered_map<IntVector3, ea::shared_ptr<const BakedSceneChunk>> bakedChunkCache_;
     /// Direct light cache.
     ea::unordered_map<unsigned, ea::shared_ptr<const LightmapChartBakedDirect>> directLightCache_;
+    /// Indirect light cache.
+    ea::unordered_map<unsigned, ea::shared_ptr<const LightmapChartBakedIndirect>> indirectLightCache_;
     /// Baked lightmaps.
     ea::unordered_map<unsigned, ea::shared_ptr<const BakedLightmap>> lightmapCache_;
 };
 
+/// File lightmap cache. Light data of lightmap charts is written to files in the cache directory,
+/// only recently used data is kept in memory within the memory limit.
+/// Baked scene chunks are always kept in memory because raytracer scenes cannot be serialized.
+class URHO3D_API BakedLightFileCache : public BakedLightCache
+{
+public:
+    /// Construct.
+    BakedLightFileCache(Context* context, const ea::string& directory, unsigned long long memoryLimit);
+    /// Destruct. Remove cache files.
+    ~BakedLightFileCache() override;
+
+    /// Store baked scene chunk in the cache.
+    void StoreBakedChunk(const IntVector3& chunk, BakedSceneChunk bakedChunk) override;
+    /// Load baked scene chunk.
+    ea::shared_ptr<const BakedSceneChunk> LoadBakedChunk(const IntVector3& chunk) override;
+
+    /// Store direct light for the lightmap chart.
+    void StoreDirectLight(unsigned lightmapIndex, LightmapChartBakedDirect bakedDirect) override;
+    /// Load direct light for the lightmap chart.
+    ea::shared_ptr<const LightmapChartBakedDirect> LoadDirectLight(unsigned lightmapIndex) override;
+
+    /// Store accumulated indirect light for the lightmap chart.
+    void StoreIndirectLight(unsigned lightmapIndex, LightmapChartBakedIndirect bakedIndirect) override;
+    /// Load accumulated indirect light for the lightmap chart.
+    ea::shared_ptr<const LightmapChartBakedIndirect> LoadIndirectLight(unsigned lightmapIndex) override;
+
+    /// Store baked lightmap.
+    void StoreLightmap(unsigned lightmapIndex, BakedLightmap bakedLightmap) override;
+    /// Load baked lightmap.
+    ea::shared_ptr<const BakedLightmap> LoadLightmap(unsigned lightmapIndex) override;
+
+    /// Return memory used by light data kept in memory.
+    unsigned long long GetMemoryUse() const { return memoryUse_; }
+
+private:
+    /// Type of light data.
+    enum class DataType
+    {
+        DirectLight,
+        IndirectLight,
+        Lightmap
+    };
+
+    /// Light data kept in memory.
+    struct CachedData
+    {
+        ea::shared_ptr<const void> data_;
+        unsigned long long size_{};
+        ea::list<unsigned long long>::iterator lruIterator_;
+        /// Whether the data is stored in file and can be evicted from memory.
+        bool evictable_{};
+    };
+
+    /// Return key of the data.
+    static unsigned long long GetKey(DataType type, unsigned lightmapIndex);
+    /// Return file name of the data.
+    ea::string GetFileName(DataType type, unsigned lightmapIndex) const;
+
+    /// Store data in file and in memory.
+    template <class T> void StoreData(DataType type, unsigned lightmapIndex, T data);
+    /// Load data from memory or file.
+    template <class T> ea::shared_ptr<const T> LoadData(DataType type, unsigned lightmapIndex);
+    /// Store data in memory and evict least recently used data exceeding memory limit.
+    void StoreInMemory(unsigned long long key, ea::shared_ptr<const void> data, unsigned long long size, bool evictable);
+    /// Load data from memory. Return null if evicted.
+    ea::shared_ptr<const void> LoadFromMemory(unsigned long long key);
+
+    /// Context.
+    Context* context_{};
+    /// Cache directory.
+    ea::string directory_;
+    /// Max memory used by light data kept in memory.
+    unsigned long long memoryLimit_{};
+
+    /// Baking contexts cache.
+    ea::unordered_map<IntVector3, ea::shared_ptr<const BakedSceneChunk>> bakedChunkCache_;
+    /// Light data kept in memory.
+    ea::unordered_map<unsigned long long, CachedData> cachedData_;
+    /// Keys of light data from the most to the least recently used.
+    ea::list<unsigned long long> lruList_;
+    /// Memory used by light data kept in memory.
+    unsigned long long memoryUse_{};
+    /// Keys of light data stored in files.
+    ea::unordered_set<unsigned long long> storedKeys_;
+};
+
 }
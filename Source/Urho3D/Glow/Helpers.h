@@ -34,25 +34,42 @@
 
 #include <EASTL/string.h>
 
+#include <atomic>
 #include <future>
+#include <thread>
 
 namespace Urho3D
 {
 
-/// Parallel loop.
+/// Parallel loop. Elements are split into numTasks ranges, which are processed by at most one thread per core.
+/// Threads pick ranges one by one, so all threads stay busy even if some ranges are much cheaper than others.
 template <class T>
 void ParallelFor(unsigned count, unsigned numTasks, const T& callback)
 {
+    numTasks = ea::max(1u, numTasks);
+    const unsigned chunkSize = (count + numTasks - 1) / numTasks;
+    if (chunkSize == 0)
+        return;
+
+    const unsigned numCores = ea::max(1u, std::thread::hardware_concurrency());
+    const unsigned numThreads = ea::min(numTasks, numCores);
+    std::atomic<unsigned> nextIndex{};
+
     // Post async tasks
     ea::vector<std::future<void>> tasks;
-    const unsigned chunkSize = (count + numTasks - 1) / numTasks;
-    for (unsigned i = 0; i < numTasks; ++i)
+    for (unsigned i = 0; i < numThreads; ++i)
     {
-        tasks.push_back(std::async([&, i]()
+        tasks.push_back(std::async(std::launch::async, [&]()
         {
-            const unsigned fromIndex = i * chunkSize;
-            const unsigned toIndex = ea::min(fromIndex + chunkSize, count);
-            callback(fromIndex, toIndex);
+            while (true)
+            {
+                const unsigned fromIndex = nextIndex.fetch_add(chunkSize, std::memory_order_relaxed);
+                if (fromIndex >= count)
+                    break;
+
+                const unsigned toIndex = ea::min(fromIndex + chunkSize, count);
+                callback(fromIndex, toIndex);
+            }
         }));
     }
 
@@ -38,8 +38,12 @@
 #include "../Graphics/Graphics.h"
 #include "../Graphics/LightProbeGroup.h"
 #include "../Graphics/Model.h"
+#include "../IO/ArchiveSerialization.h"
+#include "../IO/BinaryArchive.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
+#include "../IO/VectorBuffer.h"
 #include "../Math/TetrahedralMesh.h"
 #include "../Resource/Image.h"
 #include "../Resource/ResourceCache.h"
@@ -86,6 +90,57 @@ unsigned long long Swizzle(const IntVector3& vec, const IntVector3& base = IntVe
 
 }
 
+void LightBakingChunkJob::SerializeInBlock(Archive& archive)
+{
+    SerializeValue(archive, "chunks", chunks_);
+}
+
+LightBakingChunkJob LightBakingChunkJob::FromBytes(const ByteVector& bytes)
+{
+    MemoryBuffer buffer(bytes);
+    BinaryInputArchive archive(nullptr, buffer);
+    LightBakingChunkJob result;
+    SerializeValue(archive, "job", result);
+    return result;
+}
+
+ByteVector LightBakingChunkJob::ToBytes() const
+{
+    VectorBuffer buffer;
+    BinaryOutputArchive archive(nullptr, buffer);
+    SerializeValue(archive, "job", const_cast<LightBakingChunkJob&>(*this));
+    return buffer.GetBuffer();
+}
+
+void LightBakingChunkResult::SerializeInBlock(Archive& archive)
+{
+    SerializeValue(archive, "lightmapIndices", lightmapIndices_);
+    SerializeVectorAsObjects(archive, "lightmaps", lightmaps_, "lightmap",
+        [](Archive& archive, const char* name, BakedLightmap& lightmap)
+    {
+        const auto block = archive.OpenUnorderedBlock(name);
+        SerializeValue(archive, "size", lightmap.lightmapSize_);
+        SerializeValue(archive, "data", lightmap.lightmap_);
+    });
+}
+
+LightBakingChunkResult LightBakingChunkResult::FromBytes(const ByteVector& bytes)
+{
+    MemoryBuffer buffer(bytes);
+    BinaryInputArchive archive(nullptr, buffer);
+    LightBakingChunkResult result;
+    SerializeValue(archive, "result", result);
+    return result;
+}
+
+ByteVector LightBakingChunkResult::ToBytes() const
+{
+    VectorBuffer buffer;
+    BinaryOutputArchive archive(nullptr, buffer);
+    SerializeValue(archive, "result", const_cast<LightBakingChunkResult&>(*this));
+    return buffer.GetBuffer();
+}
+
 /// Incremental light baker implementation.
 struct IncrementalLightBaker::Impl
 {
@@ -255,118 +310,170 @@ struct IncrementalLightBaker::Impl
     }
 
     /// Bake indirect light, filter baked direct and indirect, bake direct light probes.
-    bool BakeIndirectAndFilter(StopToken stopToken)
+    /// Indirect light of charts is accumulated over several passes, intermediate lightmaps are saved for preview.
+    bool BakeIndirectAndFilter(StopToken stopToken, const ea::vector<unsigned>& chunkIndices)
     {
+        const unsigned numPasses = ea::max(1u, settings_.incremental_.numIndirectPasses_);
+
+        unsigned numLightmaps = 0;
+        for (unsigned chunkIndex : chunkIndices)
+            numLightmaps += cache_->LoadBakedChunk(chunks_[chunkIndex])->lightmaps_.size();
+
         status_.phase_.store(IncrementalLightBakerPhase::BakingIndirectLighting, std::memory_order_relaxed);
         status_.processedElements_.store(0, std::memory_order_relaxed);
-        status_.totalElements_.store(numLightmapsTotal_, std::memory_order_relaxed);
+        status_.totalElements_.store(numLightmaps * numPasses, std::memory_order_relaxed);
+        status_.totalPasses_.store(numPasses, std::memory_order_relaxed);
 
-        const unsigned numTexels = settings_.charting_.lightmapSize_ * settings_.charting_.lightmapSize_;
-        ea::vector<Vector3> directFilterBuffer(numTexels);
-        ea::vector<Vector4> indirectFilterBuffer(numTexels);
-        LightProbeCollectionBakedData lightProbesBakedData;
-        LightmapChartBakedIndirect bakedIndirect{ settings_.charting_.lightmapSize_ };
+        // Indirect light of light probes is baked once and used as fallback for charts in all passes
+        ea::vector<LightProbeCollectionBakedData> indirectLightProbes(chunks_.size());
 
-        for (const IntVector3 chunk : chunks_)
+        for (unsigned pass = 0; pass < numPasses; ++pass)
         {
-            if (stopToken.IsStopped())
-                return false;
+            status_.currentPass_.store(pass, std::memory_order_relaxed);
 
-            const ea::shared_ptr<const BakedSceneChunk> bakedChunk = cache_->LoadBakedChunk(chunk);
+            // Split samples between passes
+            IndirectLightTracingSettings indirectChartTracing = settings_.indirectChartTracing_;
+            indirectChartTracing.maxSamples_ = ea::max(1u,
+                (settings_.indirectChartTracing_.maxSamples_ + numPasses - 1 - pass) / numPasses);
 
-            // Collect required direct lightmaps
-            ea::vector<ea::shared_ptr<const LightmapChartBakedDirect>> bakedDirectLightmapsRefs(numLightmapCharts_);
-            ea::vector<const LightmapChartBakedDirect*> bakedDirectLightmaps(numLightmapCharts_);
-            for (unsigned lightmapIndex : bakedChunk->requiredDirectLightmaps_)
+            const bool isFirstPass = pass == 0;
+            const bool isLastPass = pass + 1 == numPasses;
+            for (unsigned chunkIndex : chunkIndices)
             {
-                bakedDirectLightmapsRefs[lightmapIndex] = cache_->LoadDirectLight(lightmapIndex);
-                bakedDirectLightmaps[lightmapIndex] = bakedDirectLightmapsRefs[lightmapIndex].get();
+                if (!BakeIndirectAndFilterChunk(stopToken, chunkIndex, indirectLightProbes[chunkIndex],
+                    indirectChartTracing, isFirstPass, isLastPass))
+                    return false;
             }
 
-            // Allocate storage for light probes
-            lightProbesBakedData.Resize(bakedChunk->lightProbesCollection_.GetNumProbes());
+            // Stitching requires GPU, so intermediate lightmaps are saved as is
+            if (!isLastPass)
+                SaveImagesWithoutStitching(chunkIndices);
+        }
 
-            // Bake indirect light for light probes
-            BakeIndirectLightForLightProbes(lightProbesBakedData, bakedChunk->lightProbesCollection_,
-                bakedDirectLightmaps, *bakedChunk->raytracerScene_, settings_.indirectProbesTracing_);
+        status_.phase_.store(IncrementalLightBakerPhase::Finalizing, std::memory_order_relaxed);
+        return true;
+    }
 
-            // Build light probes mesh for fallback indirect
-            TetrahedralMesh lightProbesMesh;
-            lightProbesMesh.Define(bakedChunk->lightProbesCollection_.worldPositions_);
+    /// Bake indirect light for one chunk and accumulate it with previous passes.
+    bool BakeIndirectAndFilterChunk(StopToken stopToken, unsigned chunkIndex,
+        LightProbeCollectionBakedData& indirectLightProbes, const IndirectLightTracingSettings& indirectChartTracing,
+        bool isFirstPass, bool isLastPass)
+    {
+        if (stopToken.IsStopped())
+            return false;
 
-            // Bake indirect lighting for charts
-            for (unsigned i = 0; i < bakedChunk->lightmaps_.size(); ++i)
-            {
-                if (stopToken.IsStopped())
-                    return false;
+        const IntVector3 chunk = chunks_[chunkIndex];
+        const ea::shared_ptr<const BakedSceneChunk> bakedChunk = cache_->LoadBakedChunk(chunk);
 
-                const unsigned lightmapIndex = bakedChunk->lightmaps_[i];
-                const LightmapChartGeometryBuffer& geometryBuffer = bakedChunk->geometryBuffers_[i];
-                const ea::shared_ptr<const LightmapChartBakedDirect> bakedDirect = cache_->LoadDirectLight(lightmapIndex);
+        const unsigned numTexels = settings_.charting_.lightmapSize_ * settings_.charting_.lightmapSize_;
+        ea::vector<Vector3> directFilterBuffer(numTexels);
+        ea::vector<Vector4> indirectFilterBuffer(numTexels);
 
-                ea::fill(bakedIndirect.light_.begin(), bakedIndirect.light_.end(), Vector4::ZERO);
+        // Collect required direct lightmaps
+        ea::vector<ea::shared_ptr<const LightmapChartBakedDirect>> bakedDirectLightmapsRefs(numLightmapCharts_);
+        ea::vector<const LightmapChartBakedDirect*> bakedDirectLightmaps(numLightmapCharts_);
+        for (unsigned lightmapIndex : bakedChunk->requiredDirectLightmaps_)
+        {
+            bakedDirectLightmapsRefs[lightmapIndex] = cache_->LoadDirectLight(lightmapIndex);
+            bakedDirectLightmaps[lightmapIndex] = bakedDirectLightmapsRefs[lightmapIndex].get();
+        }
 
-                // Bake indirect lights
-                BakeIndirectLightForCharts(bakedIndirect, bakedDirectLightmaps,
-                    geometryBuffer, lightProbesMesh, lightProbesBakedData,
-                    *bakedChunk->raytracerScene_, bakedChunk->geometryBufferToRaytracer_,
-                    settings_.indirectChartTracing_);
+        // Bake indirect light for light probes
+        if (isFirstPass)
+        {
+            indirectLightProbes.Resize(bakedChunk->lightProbesCollection_.GetNumProbes());
+            BakeIndirectLightForLightProbes(indirectLightProbes, bakedChunk->lightProbesCollection_,
+                bakedDirectLightmaps, *bakedChunk->raytracerScene_, settings_.indirectProbesTracing_);
+        }
 
-                // Filter direct and indirect
-                bakedIndirect.NormalizeLight();
+        // Build light probes mesh for fallback indirect
+        TetrahedralMesh lightProbesMesh;
+        lightProbesMesh.Define(bakedChunk->lightProbesCollection_.worldPositions_);
 
-                if (settings_.directFilter_.kernelRadius_ > 0)
-                {
-                    FilterDirectLight(*bakedDirect, directFilterBuffer,
-                        geometryBuffer, settings_.directFilter_, settings_.directChartTracing_.numTasks_);
-                }
+        // Bake indirect lighting for charts
+        for (unsigned i = 0; i < bakedChunk->lightmaps_.size(); ++i)
+        {
+            if (stopToken.IsStopped())
+                return false;
 
-                if (settings_.indirectFilter_.kernelRadius_ > 0)
-                {
-                    FilterIndirectLight(bakedIndirect, indirectFilterBuffer,
-                        geometryBuffer, settings_.indirectFilter_, settings_.indirectChartTracing_.numTasks_);
-                }
+            const unsigned lightmapIndex = bakedChunk->lightmaps_[i];
+            const LightmapChartGeometryBuffer& geometryBuffer = bakedChunk->geometryBuffers_[i];
+            const ea::shared_ptr<const LightmapChartBakedDirect> bakedDirect = cache_->LoadDirectLight(lightmapIndex);
 
-                // Generate final images
-                BakedLightmap bakedLightmap(settings_.charting_.lightmapSize_);
-                for (unsigned i = 0; i < bakedLightmap.lightmap_.size(); ++i)
-                {
-                    const Vector3 directLight = static_cast<Vector3>(directFilterBuffer[i]);
-                    const Vector3 indirectLight = indirectFilterBuffer[i].ToVector3();
-                    bakedLightmap.lightmap_[i] = VectorMax(Vector3::ZERO, directLight);
-                    bakedLightmap.lightmap_[i] += VectorMax(Vector3::ZERO, indirectLight);
-                }
+            // Continue accumulation of previous passes
+            const ea::shared_ptr<const LightmapChartBakedIndirect> previousIndirect =
+                isFirstPass ? nullptr : cache_->LoadIndirectLight(lightmapIndex);
+            LightmapChartBakedIndirect bakedIndirect = previousIndirect
+                ? *previousIndirect : LightmapChartBakedIndirect{ settings_.charting_.lightmapSize_ };
 
-                // Store lightmap
-                cache_->StoreLightmap(lightmapIndex, ea::move(bakedLightmap));
+            // Bake indirect lights
+            BakeIndirectLightForCharts(bakedIndirect, bakedDirectLightmaps,
+                geometryBuffer, lightProbesMesh, indirectLightProbes,
+                *bakedChunk->raytracerScene_, bakedChunk->geometryBufferToRaytracer_,
+                indirectChartTracing);
 
-                status_.processedElements_.fetch_add(1u, std::memory_order_relaxed);
+            // Keep unnormalized light for the next pass
+            LightmapChartBakedIndirect normalizedIndirect = bakedIndirect;
+            if (!isLastPass)
+                cache_->StoreIndirectLight(lightmapIndex, ea::move(bakedIndirect));
+
+            // Filter direct and indirect
+            normalizedIndirect.NormalizeLight();
+
+            if (settings_.directFilter_.kernelRadius_ > 0)
+            {
+                FilterDirectLight(*bakedDirect, directFilterBuffer,
+                    geometryBuffer, settings_.directFilter_, settings_.directChartTracing_.numTasks_);
             }
 
-            // Bake direct lights for light probes
-            for (const BakedLight& bakedLight : bakedChunk->bakedLights_)
+            if (settings_.indirectFilter_.kernelRadius_ > 0)
             {
-                BakeDirectLightForLightProbes(lightProbesBakedData,
-                    bakedChunk->lightProbesCollection_, *bakedChunk->raytracerScene_,
-                    bakedLight, settings_.directProbesTracing_);
+                FilterIndirectLight(normalizedIndirect, indirectFilterBuffer,
+                    geometryBuffer, settings_.indirectFilter_, settings_.indirectChartTracing_.numTasks_);
             }
 
-            // Save light probes
-            for (unsigned groupIndex = 0; groupIndex < bakedChunk->numUniqueLightProbes_; ++groupIndex)
+            // Generate final images
+            BakedLightmap bakedLightmap(settings_.charting_.lightmapSize_);
+            for (unsigned i = 0; i < bakedLightmap.lightmap_.size(); ++i)
             {
-                const FileIdentifier fileName = GetLightProbeBakedDataFileName(chunk, groupIndex);
-                if (!LightProbeGroup::SaveLightProbesBakedData(context_, fileName,
-                    bakedChunk->lightProbesCollection_, lightProbesBakedData, groupIndex))
-                {
-                    const ea::string groupName = groupIndex < bakedChunk->lightProbesCollection_.GetNumGroups()
-                        ? bakedChunk->lightProbesCollection_.names_[groupIndex] : "";
-                    URHO3D_LOGERROR("Cannot save light probes for group '{}' in chunk {}",
-                        groupName, chunk.ToString());
-                }
+                const Vector3 directLight = static_cast<Vector3>(directFilterBuffer[i]);
+                const Vector3 indirectLight = indirectFilterBuffer[i].ToVector3();
+                bakedLightmap.lightmap_[i] = VectorMax(Vector3::ZERO, directLight);
+                bakedLightmap.lightmap_[i] += VectorMax(Vector3::ZERO, indirectLight);
+            }
+
+            // Store lightmap
+            cache_->StoreLightmap(lightmapIndex, ea::move(bakedLightmap));
+
+            status_.processedElements_.fetch_add(1u, std::memory_order_relaxed);
+        }
+
+        if (!isFirstPass)
+            return true;
+
+        // Bake direct lights for light probes
+        LightProbeCollectionBakedData lightProbesBakedData = indirectLightProbes;
+        for (const BakedLight& bakedLight : bakedChunk->bakedLights_)
+        {
+            BakeDirectLightForLightProbes(lightProbesBakedData,
+                bakedChunk->lightProbesCollection_, *bakedChunk->raytracerScene_,
+                bakedLight, settings_.directProbesTracing_);
+        }
+
+        // Save light probes
+        for (unsigned groupIndex = 0; groupIndex < bakedChunk->numUniqueLightProbes_; ++groupIndex)
+        {
+            const FileIdentifier fileName = GetLightProbeBakedDataFileName(chunk, groupIndex);
+            if (!LightProbeGroup::SaveLightProbesBakedData(context_, fileName,
+                bakedChunk->lightProbesCollection_, lightProbesBakedData, groupIndex))
+            {
+                const ea::string groupName = groupIndex < bakedChunk->lightProbesCollection_.GetNumGroups()
+                    ? bakedChunk->lightProbesCollection_.names_[groupIndex] : "";
+                URHO3D_LOGERROR("Cannot save light probes for group '{}' in chunk {}",
+                    groupName, chunk.ToString());
             }
         }
 
-        status_.phase_.store(IncrementalLightBakerPhase::Finalizing, std::memory_order_relaxed);
         return true;
     }
 
@@ -412,30 +519,124 @@ struct IncrementalLightBaker::Impl
                         buffer[i] = Vector4(bakedLightmap->lightmap_[i], 1.0f);
                 }
 
-                // Generate image
+                SaveImage(lightmapImage, buffer, lightmapIndex);
+            }
+        }
+    }
+
+    /// Save current lightmaps without stitching. Safe to call from the baking thread.
+    void SaveImagesWithoutStitching(const ea::vector<unsigned>& chunkIndices)
+    {
+        const unsigned numTexels = settings_.charting_.lightmapSize_ * settings_.charting_.lightmapSize_;
+        ea::vector<Vector4> buffer(numTexels);
+
+        auto lightmapImage = MakeShared<Image>(context_);
+        if (!lightmapImage->SetSize(settings_.charting_.lightmapSize_, settings_.charting_.lightmapSize_, 4))
+        {
+            URHO3D_LOGERROR("Cannot allocate image for lightmap");
+            return;
+        }
+
+        for (unsigned chunkIndex : chunkIndices)
+        {
+            const ea::shared_ptr<const BakedSceneChunk> bakedChunk = cache_->LoadBakedChunk(chunks_[chunkIndex]);
+            for (unsigned lightmapIndex : bakedChunk->lightmaps_)
+            {
+                const ea::shared_ptr<const BakedLightmap> bakedLightmap = cache_->LoadLightmap(lightmapIndex);
                 for (unsigned i = 0; i < numTexels; ++i)
+                    buffer[i] = Vector4(bakedLightmap->lightmap_[i], 1.0f);
+
+                SaveImage(lightmapImage, buffer, lightmapIndex);
+            }
+        }
+    }
+
+    /// Return indices of given chunks. Unknown chunks are ignored.
+    ea::vector<unsigned> GetChunkIndices(const ea::vector<IntVector3>& chunks) const
+    {
+        ea::vector<unsigned> chunkIndices;
+        for (const IntVector3& chunk : chunks)
+        {
+            const auto iter = ea::find(chunks_.begin(), chunks_.end(), chunk);
+            if (iter != chunks_.end())
+                chunkIndices.push_back(static_cast<unsigned>(iter - chunks_.begin()));
+            else
+                URHO3D_LOGWARNING("Cannot bake unknown chunk {}", chunk.ToString());
+        }
+        return chunkIndices;
+    }
+
+    /// Return indices of all chunks.
+    ea::vector<unsigned> GetAllChunkIndices() const
+    {
+        ea::vector<unsigned> chunkIndices(chunks_.size());
+        ea::iota(chunkIndices.begin(), chunkIndices.end(), 0u);
+        return chunkIndices;
+    }
+
+    /// Return baked lightmaps of given chunks.
+    LightBakingChunkResult ExportChunks(const ea::vector<IntVector3>& chunks) const
+    {
+        LightBakingChunkResult result;
+        for (unsigned chunkIndex : GetChunkIndices(chunks))
+        {
+            const ea::shared_ptr<const BakedSceneChunk> bakedChunk = cache_->LoadBakedChunk(chunks_[chunkIndex]);
+            for (unsigned lightmapIndex : bakedChunk->lightmaps_)
+            {
+                if (const ea::shared_ptr<const BakedLightmap> bakedLightmap = cache_->LoadLightmap(lightmapIndex))
                 {
-                    const unsigned x = i % geometryBuffer.lightmapSize_;
-                    const unsigned y = i / geometryBuffer.lightmapSize_;
-
-                    static const float multiplier = 1.0f / 2.0f;
-                    Color color = static_cast<Color>(buffer[i].ToVector3()).LinearToGamma();
-                    color.r_ *= multiplier;
-                    color.g_ *= multiplier;
-                    color.b_ *= multiplier;
-                    lightmapImage->SetPixel(x, y, color);
+                    result.lightmapIndices_.push_back(lightmapIndex);
+                    result.lightmaps_.push_back(*bakedLightmap);
                 }
+            }
+        }
+        return result;
+    }
 
-                // Save image to destination folder
-                const FileIdentifier fileName = GetLightmapFileName(lightmapIndex);
-                lightmapImage->SaveFile(fileName);
+    /// Store lightmaps baked by workers.
+    void ImportChunks(const LightBakingChunkResult& result)
+    {
+        const unsigned numLightmaps = ea::min(result.lightmapIndices_.size(), result.lightmaps_.size());
+        for (unsigned i = 0; i < numLightmaps; ++i)
+        {
+            const unsigned lightmapIndex = result.lightmapIndices_[i];
+            const BakedLightmap& bakedLightmap = result.lightmaps_[i];
+            if (lightmapIndex >= numLightmapCharts_ || bakedLightmap.lightmapSize_ != settings_.charting_.lightmapSize_
+                || bakedLightmap.lightmap_.size() != bakedLightmap.lightmapSize_ * bakedLightmap.lightmapSize_)
+            {
+                URHO3D_LOGERROR("Cannot import baked lightmap {}: data is inconsistent with the scene", lightmapIndex);
+                continue;
             }
+            cache_->StoreLightmap(lightmapIndex, BakedLightmap{bakedLightmap});
         }
     }
 
+    const ea::vector<IntVector3>& GetChunks() const { return chunks_; }
+
     const IncrementalLightBakerStatus& GetStatus() const { return status_; }
 
 private:
+    /// Convert lightmap data to image and save it to the destination folder.
+    void SaveImage(Image* lightmapImage, const ea::vector<Vector4>& buffer, unsigned lightmapIndex)
+    {
+        const unsigned lightmapSize = settings_.charting_.lightmapSize_;
+        for (unsigned i = 0; i < buffer.size(); ++i)
+        {
+            const unsigned x = i % lightmapSize;
+            const unsigned y = i / lightmapSize;
+
+            static const float multiplier = 1.0f / 2.0f;
+            Color color = static_cast<Color>(buffer[i].ToVector3()).LinearToGamma();
+            color.r_ *= multiplier;
+            color.g_ *= multiplier;
+            color.b_ *= multiplier;
+            lightmapImage->SetPixel(x, y, color);
+        }
+
+        const FileIdentifier fileName = GetLightmapFileName(lightmapIndex);
+        lightmapImage->SaveFile(fileName);
+    }
+
     FileIdentifier GetOutputDirectory() const
     {
         if (!settings_.incremental_.outputDirectory_.empty())
@@ -507,7 +708,15 @@ ea::string IncrementalLightBakerStatus::ToString() const
     case IncrementalLightBakerPhase::BakingDirectLighting:
         return Format("Baking direct lighting: {}/{} lightmaps...", current, total);
     case IncrementalLightBakerPhase::BakingIndirectLighting:
+    {
+        const unsigned numPasses = totalPasses_.load(std::memory_order_relaxed);
+        if (numPasses > 1)
+        {
+            const unsigned pass = currentPass_.load(std::memory_order_relaxed) + 1;
+            return Format("Baking indirect lighting (pass {}/{}): {}/{} lightmaps...", pass, numPasses, current, total);
+        }
         return Format("Baking indirect lighting: {}/{} lightmaps...", current, total);
+    }
     case IncrementalLightBakerPhase::NotStarted:
     default:
         return "Not started.";
@@ -540,12 +749,33 @@ bool IncrementalLightBaker::Bake(StopToken stopToken)
     if (!impl_->BakeDirectCharts(stopToken))
         return false;
 
-    if (!impl_->BakeIndirectAndFilter(stopToken))
+    if (!impl_->BakeIndirectAndFilter(stopToken, impl_->GetAllChunkIndices()))
         return false;
 
     return true;
 }
 
+bool IncrementalLightBaker::BakeChunks(StopToken stopToken, const ea::vector<IntVector3>& chunks)
+{
+    if (!impl_->BakeDirectCharts(stopToken))
+        return false;
+
+    if (!impl_->BakeIndirectAndFilter(stopToken, impl_->GetChunkIndices(chunks)))
+        return false;
+
+    return true;
+}
+
+LightBakingChunkResult IncrementalLightBaker::ExportChunks(const ea::vector<IntVector3>& chunks) const
+{
+    return impl_->ExportChunks(chunks);
+}
+
+void IncrementalLightBaker::ImportChunks(const LightBakingChunkResult& result)
+{
+    impl_->ImportChunks(result);
+}
+
 void IncrementalLightBaker::CommitScene()
 {
     impl_->StitchAndSaveImages();
@@ -556,4 +786,9 @@ const IncrementalLightBakerStatus& IncrementalLightBaker::GetStatus() const
     return impl_->GetStatus();
 }
 
+const ea::vector<IntVector3>& IncrementalLightBaker::GetChunks() const
+{
+    return impl_->GetChunks();
+}
+
 }
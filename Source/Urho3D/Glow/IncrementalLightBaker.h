@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "../Container/ByteVector.h"
 #include "../Core/StopToken.h"
 #include "../Glow/BakedLightCache.h"
 #include "../Glow/BakedSceneCollector.h"
@@ -48,10 +49,39 @@ struct IncrementalLightBakerStatus
     std::atomic<IncrementalLightBakerPhase> phase_{ IncrementalLightBakerPhase::NotStarted };
     std::atomic_uint32_t processedElements_{ 0 };
     std::atomic_uint32_t totalElements_{ 0 };
+    std::atomic_uint32_t currentPass_{ 0 };
+    std::atomic_uint32_t totalPasses_{ 1 };
 
     ea::string ToString() const;
 };
 
+class Archive;
+
+/// Job to bake indirect lighting for subset of chunks, e.g. in another process.
+/// Worker is expected to load the same scene and bake it with the same settings.
+struct URHO3D_API LightBakingChunkJob
+{
+    /// Chunks to bake.
+    ea::vector<IntVector3> chunks_;
+
+    void SerializeInBlock(Archive& archive);
+    static LightBakingChunkJob FromBytes(const ByteVector& bytes);
+    ByteVector ToBytes() const;
+};
+
+/// Result of LightBakingChunkJob. Light probes are saved to files by the worker.
+struct URHO3D_API LightBakingChunkResult
+{
+    /// Indices of baked lightmaps.
+    ea::vector<unsigned> lightmapIndices_;
+    /// Baked lightmaps, in the same order as indices.
+    ea::vector<BakedLightmap> lightmaps_;
+
+    void SerializeInBlock(Archive& archive);
+    static LightBakingChunkResult FromBytes(const ByteVector& bytes);
+    ByteVector ToBytes() const;
+};
+
 /// Incremental light baker.
 class URHO3D_API IncrementalLightBaker
 {
@@ -70,11 +100,21 @@ public:
     /// It is safe to call Bake from another thread as long as lightmap cache is safe to use from said thread.
     /// Return false if canceled.
     bool Bake(StopToken stopToken);
+    /// Bake direct lighting for all chunks and indirect lighting only for given chunks.
+    /// Used to split baking between several workers. Same thread safety rules as Bake apply.
+    /// Return false if canceled.
+    bool BakeChunks(StopToken stopToken, const ea::vector<IntVector3>& chunks);
+    /// Return baked lightmaps of given chunks.
+    LightBakingChunkResult ExportChunks(const ea::vector<IntVector3>& chunks) const;
+    /// Store lightmaps baked by workers into the cache. Should be called before CommitScene.
+    void ImportChunks(const LightBakingChunkResult& result);
     /// Commit the rest of changes to scene. Scene collector is used here.
     void CommitScene();
 
     /// Return current status. Thread-safe.
     const IncrementalLightBakerStatus& GetStatus() const;
+    /// Return all chunks in baking order. Valid after Initialize.
+    const ea::vector<IntVector3>& GetChunks() const;
 
 private:
     struct Impl;
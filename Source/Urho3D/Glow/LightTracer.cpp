@@ -579,12 +579,13 @@ void TraceDirectLight(T sharedKernel, U sharedGenerator,
         Vector3 incomingLightIntensity;
         rayContext.incomingLight_ = &incomingLightIntensity;
 
-        RTCRayHit rayHit;
-        rayHit.ray.mask = sharedKernel.GetGeometryMask();
-        rayHit.ray.tnear = 0.0f;
-        rayHit.ray.time = 0.0f;
-        rayHit.ray.id = 0;
-        rayHit.ray.flags = 0;
+        // Shadow rays only need to know whether any opaque geometry is hit
+        RTCRay ray;
+        ray.mask = sharedKernel.GetGeometryMask();
+        ray.tnear = 0.0f;
+        ray.time = 0.0f;
+        ray.id = 0;
+        ray.flags = 0;
 
         for (unsigned elementIndex = fromIndex; elementIndex < toIndex; ++elementIndex)
         {
@@ -601,18 +602,17 @@ void TraceDirectLight(T sharedKernel, U sharedGenerator,
                 if (!generator.Generate(position, rayOffset, incomingLightIntensity, incomingLightDirection))
                     continue;
 
-                // Cast direct ray
-                rayHit.ray.dir_x = rayOffset.x_;
-                rayHit.ray.dir_y = rayOffset.y_;
-                rayHit.ray.dir_z = rayOffset.z_;
-                rayHit.ray.org_x = position.x_ - rayOffset.x_;
-                rayHit.ray.org_y = position.y_ - rayOffset.y_;
-                rayHit.ray.org_z = position.z_ - rayOffset.z_;
-                rayHit.ray.tfar = 1.0f;
-                rayHit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
-                rtcIntersect1(scene, &rayContext, &rayHit);
-
-                if (rayHit.hit.geomID == RTC_INVALID_GEOMETRY_ID)
+                // Cast direct ray, tfar is set to -inf if occluded
+                ray.dir_x = rayOffset.x_;
+                ray.dir_y = rayOffset.y_;
+                ray.dir_z = rayOffset.z_;
+                ray.org_x = position.x_ - rayOffset.x_;
+                ray.org_y = position.y_ - rayOffset.y_;
+                ray.org_z = position.z_ - rayOffset.z_;
+                ray.tfar = 1.0f;
+                rtcOccluded1(scene, &rayContext, &ray);
+
+                if (ray.tfar >= 0.0f)
                     kernel.EndSample(incomingLightIntensity, incomingLightDirection);
             }
 
@@ -65,17 +65,53 @@ float GetLuminance(const T& color)
     return Color{ color.x_, color.y_, color.z_ }.Luma();
 }
 
-/// Calculate edge-stopping weight.
-float CalculateEdgeWeight(
-    float luminance1, float luminance2, float luminanceSigma,
-    const Vector3& position1, const Vector3& position2, float positionSigma,
-    const Vector3& normal1, const Vector3& normal2, float normalPower)
+/// Raise value to power, with fast path for small integer powers.
+float PowNormalWeight(float value, float power, int integerPower)
 {
-    const float colorWeight = Abs(luminance1 - luminance2) / luminanceSigma;
-    const float positionWeight = positionSigma > M_EPSILON ? (position1 - position2).LengthSquared() / positionSigma : 0.0f;
-    const float normalWeight = Pow(ea::max(0.0f, normal1.DotProduct(normal2)), normalPower);
+    if (integerPower < 0)
+        return Pow(value, power);
 
-    return std::exp(0.0f - colorWeight - positionWeight) * normalWeight;
+    float result = 1.0f;
+    for (int i = 0; i < integerPower; ++i)
+        result *= value;
+    return result;
+}
+
+/// Precomputed kernel tap.
+struct KernelTap
+{
+    /// Offset in texels.
+    IntVector2 offset_;
+    /// Gauss kernel weight.
+    float kernel_{};
+    /// Inverse of position sigma scaled by offset length, zero if position weight is disabled.
+    float invPositionSigma_{};
+};
+
+/// Precompute kernel taps except the center one.
+ea::vector<KernelTap> GetKernelTaps(const EdgeStoppingGaussFilterParameters& params)
+{
+    const ea::span<const float> kernelWeights = GetKernel(params.kernelRadius_);
+
+    ea::vector<KernelTap> taps;
+    for (int dy = -params.kernelRadius_; dy <= params.kernelRadius_; ++dy)
+    {
+        for (int dx = -params.kernelRadius_; dx <= params.kernelRadius_; ++dx)
+        {
+            if (dx == 0 && dy == 0)
+                continue;
+
+            const float dxdy = Vector2{ static_cast<float>(dx), static_cast<float>(dy) }.Length();
+            const float positionSigma = dxdy * params.positionSigma_;
+
+            KernelTap tap;
+            tap.offset_ = IntVector2{ dx, dy } * params.upscale_;
+            tap.kernel_ = kernelWeights[Abs(dx)] * kernelWeights[Abs(dy)];
+            tap.invPositionSigma_ = positionSigma > M_EPSILON ? 1.0f / positionSigma : 0.0f;
+            taps.push_back(tap);
+        }
+    }
+    return taps;
 }
 
 /// Apply Gauss filter edge stopping function to array.
@@ -85,6 +121,22 @@ void FilterArray(const ea::vector<T>& input, ea::vector<T>& output,
     const EdgeStoppingGaussFilterParameters& params, unsigned numTasks)
 {
     const ea::span<const float> kernelWeights = GetKernel(params.kernelRadius_);
+    const ea::vector<KernelTap> taps = GetKernelTaps(params);
+
+    const float invLuminanceSigma = 1.0f / params.luminanceSigma_;
+    const float roundedNormalPower = Round(params.normalPower_);
+    const int integerNormalPower = roundedNormalPower == params.normalPower_ && roundedNormalPower >= 0.0f
+        && roundedNormalPower <= 8.0f ? static_cast<int>(roundedNormalPower) : -1;
+
+    // Luminance is needed for every tap, calculate it once
+    ea::vector<float> luminance(input.size());
+    ParallelFor(input.size(), numTasks,
+        [&](unsigned fromIndex, unsigned toIndex)
+    {
+        for (unsigned index = fromIndex; index < toIndex; ++index)
+            luminance[index] = GetLuminance(input[index]);
+    });
+
     ParallelFor(input.size(), numTasks,
         [&](unsigned fromIndex, unsigned toIndex)
     {
@@ -100,40 +152,35 @@ void FilterArray(const ea::vector<T>& input, ea::vector<T>& output,
             const IntVector2 centerLocation = geometryBuffer.IndexToLocation(index);
 
             const T centerColor = input[index];
-            const float centerLuminance = GetLuminance(centerColor);
+            const float centerLuminance = luminance[index];
             const Vector3 centerPosition = geometryBuffer.positions_[index];
             const Vector3 centerNormal = geometryBuffer.smoothNormals_[index];
 
             float colorWeight = kernelWeights[0] * kernelWeights[0];
             T colorSum = centerColor * colorWeight;
-            for (int dy = -params.kernelRadius_; dy <= params.kernelRadius_; ++dy)
+            for (const KernelTap& tap : taps)
             {
-                for (int dx = -params.kernelRadius_; dx <= params.kernelRadius_; ++dx)
-                {
-                    if (dx == 0 && dy == 0)
-                        continue;
-
-                    const IntVector2 offset = IntVector2{ dx, dy } * params.upscale_;
-                    const IntVector2 otherLocation = centerLocation + offset;
-                    if (!geometryBuffer.IsValidLocation(otherLocation))
-                        continue;
-
-                    const float dxdy = Vector2{ static_cast<float>(dx), static_cast<float>(dy) }.Length();
-                    const float kernel = kernelWeights[Abs(dx)] * kernelWeights[Abs(dy)];
-
-                    const unsigned otherIndex = geometryBuffer.LocationToIndex(otherLocation);
-                    const unsigned otherGeometryId = geometryBuffer.geometryIds_[otherIndex];
-                    if (!otherGeometryId)
-                        continue;
-
-                    const T otherColor = input[otherIndex];
-                    const float weight = CalculateEdgeWeight(centerLuminance, GetLuminance(otherColor), params.luminanceSigma_,
-                        centerPosition, geometryBuffer.positions_[otherIndex], dxdy * params.positionSigma_,
-                        centerNormal, geometryBuffer.smoothNormals_[otherIndex], params.normalPower_);
-
-                    colorSum += otherColor * weight * kernel;
-                    colorWeight += weight * kernel;
-                }
+                const IntVector2 otherLocation = centerLocation + tap.offset_;
+                if (!geometryBuffer.IsValidLocation(otherLocation))
+                    continue;
+
+                const unsigned otherIndex = geometryBuffer.LocationToIndex(otherLocation);
+                if (!geometryBuffer.geometryIds_[otherIndex])
+                    continue;
+
+                // Texels facing away never contribute, don't waste time on exponent
+                const float normalDot = ea::max(0.0f, centerNormal.DotProduct(geometryBuffer.smoothNormals_[otherIndex]));
+                if (normalDot == 0.0f && params.normalPower_ > 0.0f)
+                    continue;
+
+                const float luminanceWeight = Abs(centerLuminance - luminance[otherIndex]) * invLuminanceSigma;
+                const float positionWeight = (centerPosition - geometryBuffer.positions_[otherIndex]).LengthSquared()
+                    * tap.invPositionSigma_;
+                const float normalWeight = PowNormalWeight(normalDot, params.normalPower_, integerNormalPower);
+                const float weight = std::exp(0.0f - luminanceWeight - positionWeight) * normalWeight * tap.kernel_;
+
+                colorSum += input[otherIndex] * weight;
+                colorWeight += weight;
             }
 
             output[index] = colorSum / ea::max(M_EPSILON, colorWeight);
@@ -24,6 +24,15 @@
 
 #include "../Glow/LightmapUVGenerator.h"
 
+#include "../Core/ProcessUtils.h"
+#include "../IO/ContentHash.h"
+#include "../IO/File.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+
+#include <EASTL/algorithm.h>
+#include <EASTL/optional.h>
+
 #include <xatlas.h>
 
 namespace Urho3D
@@ -33,7 +42,80 @@ const ea::string LightmapUVGenerationSettings::LightmapSizeKey{ "LightmapSize" }
 const ea::string LightmapUVGenerationSettings::LightmapDensityKey{ "LightmapDensity" };
 const ea::string LightmapUVGenerationSettings::LightmapSharedUV{ "LightmapSharedUV" };
 
-bool GenerateLightmapUV(ModelView& modelView, const LightmapUVGenerationSettings& settings)
+namespace
+{
+
+/// Version of the cached file format.
+const unsigned LightmapUVCacheVersion = 1;
+
+/// Charts of single geometry LOD generated by xatlas.
+struct LightmapUVMeshCharts
+{
+    /// Indices of the source vertices for each output vertex.
+    ea::vector<unsigned> xrefs_;
+    /// Lightmap UVs in texels for each output vertex.
+    ea::vector<Vector2> uvs_;
+    /// Output indices.
+    ea::vector<unsigned> indices_;
+};
+
+/// Charts of the whole model.
+struct LightmapUVCharts
+{
+    IntVector2 atlasSize_;
+    ea::vector<LightmapUVMeshCharts> meshes_;
+};
+
+using GeometryLodMapping = ea::vector<ea::pair<unsigned, unsigned>>;
+
+/// Return geometry LODs that receive lightmap UVs.
+GeometryLodMapping GetGeometryLodMapping(const ModelView& modelView)
+{
+    GeometryLodMapping result;
+    unsigned geometryIndex = 0;
+    for (const GeometryView& geometryView : modelView.GetGeometries())
+    {
+        unsigned lodIndex = 0;
+        for (const GeometryLODView& geometryLodView : geometryView.lods_)
+        {
+            if (!geometryLodView.vertices_.empty() && geometryLodView.primitiveType_ == TRIANGLE_LIST)
+                result.emplace_back(geometryIndex, lodIndex);
+            ++lodIndex;
+        }
+        ++geometryIndex;
+    }
+    return result;
+}
+
+/// Return hash of everything that affects generated charts.
+ea::string GetChartsHash(const ModelView& modelView, const GeometryLodMapping& mapping,
+    const LightmapUVGenerationSettings& settings)
+{
+    const auto& geometries = modelView.GetGeometries();
+
+    ContentHasher hasher;
+    hasher.Append(LightmapUVCacheVersion);
+    hasher.Append(&settings.texelPerUnit_, sizeof(settings.texelPerUnit_));
+    for (const auto& [geometryIndex, lodIndex] : mapping)
+    {
+        const GeometryLODView& geometryLodView = geometries[geometryIndex].lods_[lodIndex];
+        hasher.Append(geometryIndex);
+        hasher.Append(lodIndex);
+        hasher.Append(geometryLodView.vertices_.size());
+        for (const ModelVertex& vertex : geometryLodView.vertices_)
+        {
+            hasher.Append(&vertex.position_, sizeof(vertex.position_));
+            hasher.Append(&vertex.normal_, sizeof(vertex.normal_));
+        }
+        hasher.Append(geometryLodView.indices_.size());
+        hasher.Append(geometryLodView.indices_.data(), geometryLodView.indices_.size() * sizeof(unsigned));
+    }
+    return hasher.ToString();
+}
+
+/// Generate charts using xatlas. Charts of the mesh are computed and packed in parallel by xatlas itself.
+ea::optional<LightmapUVCharts> GenerateCharts(const ModelView& modelView, const GeometryLodMapping& mapping,
+    const LightmapUVGenerationSettings& settings)
 {
     // Create atlas
     const auto releaseAtlas = [](xatlas::Atlas* atlas)
@@ -44,37 +126,24 @@ bool GenerateLightmapUV(ModelView& modelView, const LightmapUVGenerationSettings
 
     // Fill input mesh
     // TODO: Do something more clever about connectivity
-    auto& sourceGeometries = modelView.GetGeometries();
-    ea::vector<ea::pair<unsigned, unsigned>> meshToGeometryLodMapping;
-    unsigned geometryIndex = 0;
-    for (const GeometryView& geometryView : sourceGeometries)
+    const auto& sourceGeometries = modelView.GetGeometries();
+    for (const auto& [geometryIndex, lodIndex] : mapping)
     {
-        unsigned lodIndex = 0;
-        for (const GeometryLODView& geometryLodView : geometryView.lods_)
-        {
-            if (!geometryLodView.vertices_.empty() && geometryLodView.primitiveType_ == TRIANGLE_LIST)
-            {
-                xatlas::MeshDecl meshDecl;
-                meshDecl.vertexCount = geometryLodView.vertices_.size();
-                meshDecl.vertexPositionData = &geometryLodView.vertices_[0].position_;
-                meshDecl.vertexPositionStride = sizeof(ModelVertex);
-                meshDecl.vertexNormalData = &geometryLodView.vertices_[0].normal_;
-                meshDecl.vertexNormalStride = sizeof(ModelVertex);
-                meshDecl.indexData = geometryLodView.indices_.data();
-                meshDecl.indexCount = geometryLodView.indices_.size();
-                meshDecl.indexFormat = xatlas::IndexFormat::UInt32;
-
-                const xatlas::AddMeshError::Enum error = xatlas::AddMesh(atlas.get(), meshDecl);
-                if (error != xatlas::AddMeshError::Success)
-                    return false;
-
-                meshToGeometryLodMapping.emplace_back(geometryIndex, lodIndex);
-            }
+        const GeometryLODView& geometryLodView = sourceGeometries[geometryIndex].lods_[lodIndex];
 
-            ++lodIndex;
-        }
+        xatlas::MeshDecl meshDecl;
+        meshDecl.vertexCount = geometryLodView.vertices_.size();
+        meshDecl.vertexPositionData = &geometryLodView.vertices_[0].position_;
+        meshDecl.vertexPositionStride = sizeof(ModelVertex);
+        meshDecl.vertexNormalData = &geometryLodView.vertices_[0].normal_;
+        meshDecl.vertexNormalStride = sizeof(ModelVertex);
+        meshDecl.indexData = geometryLodView.indices_.data();
+        meshDecl.indexCount = geometryLodView.indices_.size();
+        meshDecl.indexFormat = xatlas::IndexFormat::UInt32;
 
-        ++geometryIndex;
+        const xatlas::AddMeshError::Enum error = xatlas::AddMesh(atlas.get(), meshDecl);
+        if (error != xatlas::AddMeshError::Success)
+            return ea::nullopt;
     }
 
     // Generate things
@@ -86,38 +155,174 @@ bool GenerateLightmapUV(ModelView& modelView, const LightmapUVGenerationSettings
     xatlas::Generate(atlas.get(), {}, nullptr, packOptions);
 
     // Copy output
-    const IntVector2 atlasSize{ static_cast<int>(atlas->width), static_cast<int>(atlas->height) };
-
-    const float uScale = 1.f / atlas->width;
-    const float vScale = 1.f / atlas->height;
-
+    LightmapUVCharts result;
+    result.atlasSize_ = IntVector2{static_cast<int>(atlas->width), static_cast<int>(atlas->height)};
+    result.meshes_.resize(atlas->meshCount);
     for (unsigned meshIndex = 0; meshIndex < atlas->meshCount; ++meshIndex)
     {
-        const unsigned geometryIndex = meshToGeometryLodMapping[meshIndex].first;
-        const unsigned lodIndex = meshToGeometryLodMapping[meshIndex].second;
-        GeometryLODView& geometryLodView = sourceGeometries[geometryIndex].lods_[lodIndex];
         const xatlas::Mesh& mesh = atlas->meshes[meshIndex];
+        LightmapUVMeshCharts& meshCharts = result.meshes_[meshIndex];
 
-        ea::vector<ModelVertex> newVertices;
+        meshCharts.xrefs_.resize(mesh.vertexCount);
+        meshCharts.uvs_.resize(mesh.vertexCount);
         for (unsigned vertexIndex = 0; vertexIndex < mesh.vertexCount; ++vertexIndex)
         {
             const xatlas::Vertex& vertex = mesh.vertexArray[vertexIndex];
-            ModelVertex newVertex = geometryLodView.vertices_[vertex.xref];
-            newVertex.uv_[settings.uvChannel_].x_ = uScale * vertex.uv[0];
-            newVertex.uv_[settings.uvChannel_].y_ = vScale * vertex.uv[1];
-            newVertices.push_back(newVertex);
+            meshCharts.xrefs_[vertexIndex] = vertex.xref;
+            meshCharts.uvs_[vertexIndex] = Vector2{vertex.uv[0], vertex.uv[1]};
+        }
+
+        meshCharts.indices_.assign(mesh.indexArray, mesh.indexArray + mesh.indexCount);
+    }
+    return result;
+}
+
+/// Load charts from the cache. Return nothing if the cached file is missing or doesn't match the model.
+ea::optional<LightmapUVCharts> LoadCharts(
+    Context* context, const ea::string& fileName, const ModelView& modelView, const GeometryLodMapping& mapping)
+{
+    auto fs = context->GetSubsystem<FileSystem>();
+    if (!fs->FileExists(fileName))
+        return ea::nullopt;
+
+    File file(context);
+    if (!file.Open(fileName, FILE_READ) || file.ReadFileID() != "LMUV" || file.ReadUInt() != LightmapUVCacheVersion)
+        return ea::nullopt;
+
+    LightmapUVCharts result;
+    result.atlasSize_ = file.ReadIntVector2();
+    if (file.ReadVLE() != mapping.size())
+        return ea::nullopt;
+
+    const auto& geometries = modelView.GetGeometries();
+    result.meshes_.resize(mapping.size());
+    for (unsigned meshIndex = 0; meshIndex < mapping.size(); ++meshIndex)
+    {
+        const auto [geometryIndex, lodIndex] = mapping[meshIndex];
+        const unsigned numSourceVertices = geometries[geometryIndex].lods_[lodIndex].vertices_.size();
+        LightmapUVMeshCharts& meshCharts = result.meshes_[meshIndex];
+
+        const unsigned numVertices = file.ReadVLE();
+        const unsigned vertexDataSize = numVertices * (sizeof(unsigned) + sizeof(Vector2));
+        if (vertexDataSize > file.GetSize() - file.GetPosition())
+            return ea::nullopt;
+
+        meshCharts.xrefs_.resize(numVertices);
+        meshCharts.uvs_.resize(numVertices);
+        file.Read(meshCharts.xrefs_.data(), numVertices * sizeof(unsigned));
+        file.Read(meshCharts.uvs_.data(), numVertices * sizeof(Vector2));
+
+        const unsigned numIndices = file.ReadVLE();
+        const unsigned indexDataSize = numIndices * sizeof(unsigned);
+        if (indexDataSize > file.GetSize() - file.GetPosition())
+            return ea::nullopt;
+
+        meshCharts.indices_.resize(numIndices);
+        file.Read(meshCharts.indices_.data(), indexDataSize);
+
+        const auto isBadXref = [&](unsigned xref) { return xref >= numSourceVertices; };
+        const auto isBadIndex = [&](unsigned index) { return index >= numVertices; };
+        if (ea::any_of(meshCharts.xrefs_.begin(), meshCharts.xrefs_.end(), isBadXref)
+            || ea::any_of(meshCharts.indices_.begin(), meshCharts.indices_.end(), isBadIndex))
+            return ea::nullopt;
+    }
+
+    return result;
+}
+
+/// Store charts in the cache. Charts are written to unique file first so other threads and processes
+/// never see partially written file.
+void StoreCharts(Context* context, const ea::string& fileName, const LightmapUVCharts& charts)
+{
+    auto fs = context->GetSubsystem<FileSystem>();
+    fs->CreateDirsRecursive(GetPath(fileName));
+
+    const ea::string partialFileName = Format("{}.{}.tmp", fileName, GenerateUUID());
+    {
+        File file(context);
+        if (!file.Open(partialFileName, FILE_WRITE))
+        {
+            URHO3D_LOGWARNING("Cannot store lightmap UV charts in {}", fileName);
+            return;
+        }
+
+        file.WriteFileID("LMUV");
+        file.WriteUInt(LightmapUVCacheVersion);
+        file.WriteIntVector2(charts.atlasSize_);
+        file.WriteVLE(charts.meshes_.size());
+        for (const LightmapUVMeshCharts& meshCharts : charts.meshes_)
+        {
+            file.WriteVLE(meshCharts.xrefs_.size());
+            file.Write(meshCharts.xrefs_.data(), meshCharts.xrefs_.size() * sizeof(unsigned));
+            file.Write(meshCharts.uvs_.data(), meshCharts.uvs_.size() * sizeof(Vector2));
+            file.WriteVLE(meshCharts.indices_.size());
+            file.Write(meshCharts.indices_.data(), meshCharts.indices_.size() * sizeof(unsigned));
         }
+    }
+
+    // Another thread may have stored the same charts concurrently, it's fine
+    if (!fs->Rename(partialFileName, fileName))
+        fs->Delete(partialFileName);
+}
+
+}
+
+bool GenerateLightmapUV(ModelView& modelView, const LightmapUVGenerationSettings& settings)
+{
+    Context* context = modelView.GetContext();
+    const GeometryLodMapping mapping = GetGeometryLodMapping(modelView);
+
+    // Charts depend only on the geometry, try to reuse them
+    const ea::string cacheFileName = !settings.cacheDirectory_.empty()
+        ? Format("{}{}.lmuv", AddTrailingSlash(settings.cacheDirectory_), GetChartsHash(modelView, mapping, settings))
+        : EMPTY_STRING;
+
+    ea::optional<LightmapUVCharts> charts;
+    if (!cacheFileName.empty())
+        charts = LoadCharts(context, cacheFileName, modelView, mapping);
+
+    if (!charts)
+    {
+        charts = GenerateCharts(modelView, mapping, settings);
+        if (!charts)
+            return false;
 
-        ea::vector<unsigned> newIndices;
-        newIndices.assign(mesh.indexArray, mesh.indexArray + mesh.indexCount);
+        if (!cacheFileName.empty())
+            StoreCharts(context, cacheFileName, *charts);
+    }
+
+    if (charts->meshes_.size() != mapping.size())
+        return false;
+
+    // Apply charts
+    auto& sourceGeometries = modelView.GetGeometries();
+    const float uScale = 1.f / charts->atlasSize_.x_;
+    const float vScale = 1.f / charts->atlasSize_.y_;
+
+    for (unsigned meshIndex = 0; meshIndex < mapping.size(); ++meshIndex)
+    {
+        const auto [geometryIndex, lodIndex] = mapping[meshIndex];
+        GeometryLODView& geometryLodView = sourceGeometries[geometryIndex].lods_[lodIndex];
+        LightmapUVMeshCharts& meshCharts = charts->meshes_[meshIndex];
+
+        ea::vector<ModelVertex> newVertices;
+        newVertices.reserve(meshCharts.xrefs_.size());
+        for (unsigned vertexIndex = 0; vertexIndex < meshCharts.xrefs_.size(); ++vertexIndex)
+        {
+            const Vector2& uv = meshCharts.uvs_[vertexIndex];
+            ModelVertex newVertex = geometryLodView.vertices_[meshCharts.xrefs_[vertexIndex]];
+            newVertex.uv_[settings.uvChannel_].x_ = uScale * uv.x_;
+            newVertex.uv_[settings.uvChannel_].y_ = vScale * uv.y_;
+            newVertices.push_back(newVertex);
+        }
 
         geometryLodView.vertices_ = ea::move(newVertices);
-        geometryLodView.indices_ = ea::move(newIndices);
+        geometryLodView.indices_ = ea::move(meshCharts.indices_);
         geometryLodView.vertexFormat_.uv_[settings.uvChannel_] = TYPE_VECTOR2;
     }
 
     // Finalize
-    modelView.AddMetadata(LightmapUVGenerationSettings::LightmapSizeKey, atlasSize);
+    modelView.AddMetadata(LightmapUVGenerationSettings::LightmapSizeKey, charts->atlasSize_);
     modelView.AddMetadata(LightmapUVGenerationSettings::LightmapDensityKey, settings.texelPerUnit_);
     modelView.AddMetadata(LightmapUVGenerationSettings::LightmapSharedUV, false);
 
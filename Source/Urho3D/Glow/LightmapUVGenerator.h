@@ -45,9 +45,11 @@ struct URHO3D_API LightmapUVGenerationSettings
     float texelPerUnit_{ 10 };
     /// UV channel to write. 2nd channel by default.
     unsigned uvChannel_{ 1 };
+    /// Directory where generated charts are cached by hash of the geometry. Cache is disabled if empty.
+    ea::string cacheDirectory_;
 };
 
-/// Generate lightmap UVs for the model.
+/// Generate lightmap UVs for the model. Thread-safe as long as the model is not shared.
 bool URHO3D_API GenerateLightmapUV(ModelView& model, const LightmapUVGenerationSettings& settings);
 
 }
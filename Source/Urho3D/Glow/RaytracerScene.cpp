@@ -394,7 +394,7 @@ ea::vector<RaytracerGeometry> CreateRaytracerGeometriesForStaticModel(RTCDevice
     for (unsigned geometryIndex = 0; geometryIndex < geometries.size(); ++geometryIndex)
     {
         const Material* material = staticModel->GetMaterial(geometryIndex);
-        if (!material)
+        if (!material && renderer)
             material = renderer->GetDefaultMaterial();
 
         const GeometryView& geometryView = geometries[geometryIndex];
@@ -429,7 +429,7 @@ ea::vector<RaytracerGeometry> CreateRaytracerGeometriesForTerrain(RTCDevice embr
     auto renderer = terrain->GetContext()->GetSubsystem<Renderer>();
 
     const Material* material = terrain->GetMaterial();
-    if (!material)
+    if (!material && renderer)
         material = renderer->GetDefaultMaterial();
 
     const Vector4& lightmapUVScaleOffset = terrain->GetLightmapScaleOffset();
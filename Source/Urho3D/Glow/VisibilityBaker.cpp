@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Glow/VisibilityBaker.h"
+
+#include "../Glow/Helpers.h"
+#include "../Glow/RaytracerScene.h"
+#include "../Math/RandomEngine.h"
+
+#include <embree3/rtcore.h>
+#include <embree3/rtcore_ray.h>
+
+using namespace embree3;
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Mark objects visible along the ray.
+void TraceVisibilityRay(RTCScene scene, RTCIntersectContext& rayContext, const RaytracerScene& raytracerScene,
+    const ea::vector<unsigned>& raytracerObjectToObject, const Vector3& origin, const Vector3& direction,
+    unsigned maxTransparentHits, unsigned* cellMask)
+{
+    const auto& geometries = raytracerScene.GetGeometries();
+
+    RTCRayHit rayHit;
+    rayHit.ray.org_x = origin.x_;
+    rayHit.ray.org_y = origin.y_;
+    rayHit.ray.org_z = origin.z_;
+    rayHit.ray.dir_x = direction.x_;
+    rayHit.ray.dir_y = direction.y_;
+    rayHit.ray.dir_z = direction.z_;
+    rayHit.ray.tnear = 0.0f;
+    rayHit.ray.time = 0.0f;
+    rayHit.ray.id = 0;
+    rayHit.ray.mask = RaytracerScene::PrimaryLODGeometry | RaytracerScene::DirectShadowOnlyGeometry;
+    rayHit.ray.flags = 0;
+
+    // Continue through transparent surfaces, objects behind them are visible too
+    for (unsigned i = 0; i <= maxTransparentHits; ++i)
+    {
+        rayHit.ray.tfar = raytracerScene.GetMaxDistance() * 2.0f;
+        rayHit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+        rtcIntersect1(scene, &rayContext, &rayHit);
+
+        if (rayHit.hit.geomID == RTC_INVALID_GEOMETRY_ID)
+            return;
+
+        const RaytracerGeometry& geometry = geometries[rayHit.hit.geomID];
+        const unsigned objectIndex = raytracerObjectToObject[geometry.objectIndex_];
+        cellMask[objectIndex / 32] |= 1u << (objectIndex % 32);
+
+        if (geometry.material_.opaque_)
+            return;
+
+        rayHit.ray.tnear = rayHit.ray.tfar + M_LARGE_EPSILON;
+    }
+}
+
+}
+
+ea::vector<unsigned> BakeVisibility(const RaytracerScene& raytracerScene,
+    const ea::vector<unsigned>& raytracerObjectToObject, const ea::vector<BoundingBox>& objectBoxes,
+    const BoundingBox& volume, const IntVector3& numCells, const VisibilityBakingSettings& settings)
+{
+    const unsigned numObjects = objectBoxes.size();
+    const unsigned numWordsPerCell = (numObjects + 31) / 32;
+    const unsigned totalCells = static_cast<unsigned>(numCells.x_ * numCells.y_ * numCells.z_);
+    ea::vector<unsigned> result(totalCells * numWordsPerCell);
+    if (totalCells == 0 || numObjects == 0)
+        return result;
+
+    const Vector3 cellSize = volume.Size() / numCells.ToVector3();
+    ParallelFor(totalCells, settings.numTasks_,
+        [&](unsigned fromIndex, unsigned toIndex)
+    {
+        RTCScene scene = raytracerScene.GetEmbreeScene();
+        RTCIntersectContext rayContext;
+        rtcInitIntersectContext(&rayContext);
+
+        for (unsigned cellIndex = fromIndex; cellIndex < toIndex; ++cellIndex)
+        {
+            unsigned* cellMask = &result[cellIndex * numWordsPerCell];
+            const IntVector3 cell{static_cast<int>(cellIndex % numCells.x_),
+                static_cast<int>(cellIndex / numCells.x_ % numCells.y_),
+                static_cast<int>(cellIndex / (numCells.x_ * numCells.y_))};
+            const Vector3 cellMin = volume.min_ + cell.ToVector3() * cellSize;
+            const BoundingBox cellBox{cellMin, cellMin + cellSize};
+
+            for (unsigned objectIndex = 0; objectIndex < numObjects; ++objectIndex)
+            {
+                if (cellBox.IsInside(objectBoxes[objectIndex]) != OUTSIDE)
+                    cellMask[objectIndex / 32] |= 1u << (objectIndex % 32);
+            }
+
+            // Seed by cell so the result doesn't depend on the number of tasks
+            RandomEngine random{cellIndex + 1};
+            for (unsigned sampleIndex = 0; sampleIndex < settings.numSamplesPerCell_; ++sampleIndex)
+            {
+                const Vector3 origin = random.GetVector3(cellBox);
+                for (unsigned i = 0; i < settings.numRandomRays_; ++i)
+                {
+                    TraceVisibilityRay(scene, rayContext, raytracerScene, raytracerObjectToObject,
+                        origin, random.GetDirectionVector3(), settings.maxTransparentHits_, cellMask);
+                }
+
+                for (unsigned objectIndex = 0; objectIndex < numObjects; ++objectIndex)
+                {
+                    // Skip objects that are already known to be visible from this cell
+                    if (cellMask[objectIndex / 32] & (1u << (objectIndex % 32)))
+                        continue;
+
+                    for (unsigned i = 0; i < settings.numRaysPerObject_; ++i)
+                    {
+                        const Vector3 direction = random.GetVector3(objectBoxes[objectIndex]) - origin;
+                        if (direction.LengthSquared() < M_EPSILON)
+                            continue;
+
+                        TraceVisibilityRay(scene, rayContext, raytracerScene, raytracerObjectToObject,
+                            origin, direction.Normalized(), settings.maxTransparentHits_, cellMask);
+                    }
+                }
+            }
+        }
+    });
+
+    return result;
+}
+
+}
@@ -0,0 +1,61 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/// \file
+
+#pragma once
+
+#include "../Math/BoundingBox.h"
+#include "../Math/Vector3.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class RaytracerScene;
+
+/// Settings of precomputed visibility baking.
+struct VisibilityBakingSettings
+{
+    /// Number of sample points in each cell.
+    unsigned numSamplesPerCell_{8};
+    /// Number of rays traced from each sample point towards each object.
+    unsigned numRaysPerObject_{4};
+    /// Number of rays traced from each sample point in random directions.
+    unsigned numRandomRays_{256};
+    /// Max number of transparent surfaces the ray may pass through.
+    unsigned maxTransparentHits_{8};
+    /// Number of parallel tasks.
+    unsigned numTasks_{1};
+};
+
+/// Bake potentially visible objects for each cell of the volume.
+/// Objects are identified by index in objectBoxes, raytracerObjectToObject maps raytracer object indices to them.
+/// Objects that intersect the cell are always visible from it.
+/// Returns bit mask of visible objects per cell, cell masks are padded to 32-bit words. Cells are in XYZ order.
+URHO3D_API ea::vector<unsigned> BakeVisibility(const RaytracerScene& raytracerScene,
+    const ea::vector<unsigned>& raytracerObjectToObject, const ea::vector<BoundingBox>& objectBoxes,
+    const BoundingBox& volume, const IntVector3& numCells, const VisibilityBakingSettings& settings);
+
+}
@@ -26,10 +26,12 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/Thread.h"
 #include "../Graphics/AnimatedModel.h"
 #include "../Graphics/Animation.h"
 #include "../Graphics/AnimationState.h"
 #include "../Graphics/Camera.h"
+#include "../Graphics/ComputeModelAnimator.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/DrawableEvents.h"
 #include "../Graphics/Geometry.h"
@@ -97,6 +99,10 @@ void AnimatedModel::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Shadow Distance", GetShadowDistance, SetShadowDistance, float, 0.0f, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("LOD Bias", GetLodBias, SetLodBias, float, 1.0f, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Animation LOD Bias", GetAnimationLodBias, SetAnimationLodBias, float, 1.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Animation LOD Interpolation", GetAnimationLodInterpolation, SetAnimationLodInterpolation,
+        bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Animation LOD Bone Screen Size", GetAnimationLodBoneScreenSize,
+        SetAnimationLodBoneScreenSize, float, 0.0f, AM_DEFAULT);
     URHO3D_COPY_BASE_ATTRIBUTES(Drawable);
     URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Bone Animation Enabled", GetBonesEnabledAttr, SetBonesEnabledAttr, VariantVector,
         Variant::emptyVariantVector, AM_DEFAULT | AM_NOEDIT);
@@ -228,6 +234,11 @@ void AnimatedModel::Update(const FrameInfo& frame)
 
     if (isMaster_)
     {
+        // Don't animate the skeleton if nothing but rendering depends on it
+        Octree* octree = octant_->GetOctree();
+        if (octree->IsLeanUpdate() && !boneTransformsRequired_ && !HasBoneAttachments())
+            return;
+
         // On main component, update animation and bounding box
         bool transformsDirty = false;
         if (animationDirty_ || boneBoundingBoxDirty_)
@@ -241,6 +252,11 @@ void AnimatedModel::Update(const FrameInfo& frame)
                     CalculateAnimations();
                     transformsDirty = true;
                 }
+                else if (!lodTargetPose_.empty())
+                {
+                    InterpolateLodPose();
+                    transformsDirty = true;
+                }
             }
 
             if (boneBoundingBoxDirty_)
@@ -249,7 +265,6 @@ void AnimatedModel::Update(const FrameInfo& frame)
 
         if (transformsDirty)
         {
-            Octree* octree = octant_->GetOctree();
             for (unsigned boneIndex = 0; boneIndex < skeleton_.GetNumBones(); ++boneIndex)
             {
                 Node* node = skeleton_.GetBone(boneIndex)->node_;
@@ -271,6 +286,30 @@ void AnimatedModel::Update(const FrameInfo& frame)
     }
 }
 
+bool AnimatedModel::HasBoneAttachments() const
+{
+    const ea::vector<Bone>& bones = skeleton_.GetBones();
+
+    // Bone nodes are expected to contain nothing but child bone nodes
+    unsigned numChildNodes = 0;
+    unsigned numChildBones = 0;
+    for (unsigned boneIndex = 0; boneIndex < bones.size(); ++boneIndex)
+    {
+        const Bone& bone = bones[boneIndex];
+        Node* boneNode = bone.node_;
+        if (!boneNode)
+            continue;
+
+        if (boneNode->GetNumComponents() != 0)
+            return true;
+
+        numChildNodes += boneNode->GetNumChildren();
+        if (bone.parentIndex_ != boneIndex && boneNode->GetParent() == bones[bone.parentIndex_].node_.Get())
+            ++numChildBones;
+    }
+    return numChildNodes > numChildBones;
+}
+
 void AnimatedModel::InitializeLocalBoneTransforms(bool reset)
 {
     URHO3D_ASSERT(skeleton_.GetNumBones() == skeletonData_.size());
@@ -332,20 +371,30 @@ void AnimatedModel::UpdateBatches(const FrameInfo& frame)
     float scale = transformedBoundingBox.Size().DotProduct(DOT_SCALE);
     float newLodDistance = frame.camera_->GetLodDistance(distance_, scale, lodBias_);
 
-    // If model is rendered from several views, use the minimum LOD distance for animation LOD
+    const float halfViewSize = ea::max(frame.camera_->GetHalfViewSize(), M_EPSILON);
+    const float viewDistance = frame.camera_->IsOrthographic() ? 1.0f : ea::max(distance_, M_EPSILON);
+    const float pixelsPerUnit = 0.5f * frame.viewSize_.y_ / halfViewSize / viewDistance;
+
+    // If model is rendered from several views, use the minimum LOD distance and the maximum size for animation LOD
     if (frame.frameNumber_ != animationLodFrameNumber_)
     {
         animationLodDistance_ = newLodDistance;
+        animationLodPixelsPerUnit_ = pixelsPerUnit;
         animationLodFrameNumber_ = frame.frameNumber_;
     }
     else
+    {
         animationLodDistance_ = Min(animationLodDistance_, newLodDistance);
+        animationLodPixelsPerUnit_ = ea::max(animationLodPixelsPerUnit_, pixelsPerUnit);
+    }
 
     if (newLodDistance != lodDistance_)
     {
         lodDistance_ = newLodDistance;
         CalculateLodLevels();
     }
+
+    ReportLodLevels();
 }
 
 void AnimatedModel::UpdateGeometry(const FrameInfo& frame)
@@ -364,13 +413,23 @@ void AnimatedModel::UpdateGeometry(const FrameInfo& frame)
 
     if (morphsDirty_)
         UpdateMorphs();
+
+    // Vertex data calculated in worker thread is uploaded later from the main thread
+    if (commitPending_ && Thread::IsMainThread())
+    {
+        if (modelAnimator_)
+            modelAnimator_->Commit();
+        commitPending_ = false;
+    }
 }
 
 UpdateGeometryType AnimatedModel::GetUpdateGeometryType()
 {
-    if (morphsDirty_ || forceAnimationUpdate_ || (skinningDirty_ && softwareSkinning_))
+    // CPU morphing and skinning is done in worker thread, GPU work is done in main thread
+    const bool morphsOnGPU = computeModelAnimator_ || !modelAnimator_;
+    if (forceAnimationUpdate_ || commitPending_ || (morphsOnGPU && (morphsDirty_ || (skinningDirty_ && softwareSkinning_))))
         return UPDATE_MAIN_THREAD;
-    else if (skinningDirty_)
+    else if (skinningDirty_ || morphsDirty_)
         return UPDATE_WORKER_THREAD;
     else
         return UPDATE_NONE;
@@ -425,6 +484,7 @@ void AnimatedModel::SetModel(Model* model, bool createBones)
 
         // Copy morphs. Note: morph vertex buffers will be created later on-demand
         modelAnimator_ = nullptr;
+        computeModelAnimator_ = nullptr;
         morphs_ = model->GetMorphs();
 
         // Copy bounding box & skeleton
@@ -486,6 +546,7 @@ void AnimatedModel::SetModel(Model* model, bool createBones)
         SetNumGeometries(0);
         geometryBoneMappings_.clear();
         modelAnimator_ = nullptr;
+        computeModelAnimator_ = nullptr;
         morphs_.clear();
         skeletonData_.clear();
         SetBoundingBox(BoundingBox());
@@ -498,6 +559,21 @@ void AnimatedModel::SetAnimationLodBias(float bias)
     animationLodBias_ = Max(bias, 0.0f);
 }
 
+void AnimatedModel::SetAnimationLodInterpolation(bool enable)
+{
+    animationLodInterpolation_ = enable;
+    if (!enable)
+    {
+        lodPreviousPose_.clear();
+        lodTargetPose_.clear();
+    }
+}
+
+void AnimatedModel::SetAnimationLodBoneScreenSize(float size)
+{
+    animationLodBoneScreenSize_ = Max(size, 0.0f);
+}
+
 void AnimatedModel::SetUpdateInvisible(bool enable)
 {
     updateInvisible_ = enable;
@@ -510,7 +586,7 @@ void AnimatedModel::SetMorphWeight(unsigned index, float weight)
         return;
 
     // If morph vertex buffers have not been created yet, create now
-    if (weight != 0.0f && !modelAnimator_)
+    if (weight != 0.0f && !modelAnimator_ && !computeModelAnimator_)
         CloneGeometries();
 
     if (weight != morphs_[index].weight_)
@@ -588,6 +664,8 @@ void AnimatedModel::ResetBones()
 const ea::vector<SharedPtr<VertexBuffer> >& AnimatedModel::GetMorphVertexBuffers() const
 {
     static const ea::vector<SharedPtr<VertexBuffer>> empty;
+    if (computeModelAnimator_)
+        return computeModelAnimator_->GetVertexBuffers();
     return modelAnimator_ ? modelAnimator_->GetVertexBuffers() : empty;
 }
 
@@ -965,9 +1043,29 @@ void AnimatedModel::MarkMorphsDirty()
 
 void AnimatedModel::CloneGeometries()
 {
-    modelAnimator_ = MakeShared<SoftwareModelAnimator>(context_);
-    modelAnimator_->Initialize(model_, softwareSkinning_, numSoftwareSkinningBones_);
-    geometries_ = modelAnimator_->GetGeometries();
+    modelAnimator_ = nullptr;
+    computeModelAnimator_ = nullptr;
+    commitPending_ = false;
+
+    if (computeSkinning_)
+    {
+        computeModelAnimator_ = MakeShared<ComputeModelAnimator>(context_);
+        if (computeModelAnimator_->Initialize(model_, !skinMatrices_.empty()))
+            geometries_ = computeModelAnimator_->GetGeometries();
+        else
+        {
+            URHO3D_LOGWARNING("Model {} cannot be animated by compute shader. Falling back to software skinning.",
+                model_->GetName());
+            computeModelAnimator_ = nullptr;
+        }
+    }
+
+    if (!computeModelAnimator_)
+    {
+        modelAnimator_ = MakeShared<SoftwareModelAnimator>(context_);
+        modelAnimator_->Initialize(model_, softwareSkinning_, numSoftwareSkinningBones_);
+        geometries_ = modelAnimator_->GetGeometries();
+    }
 
     // Make sure the rendering batches use the new cloned geometries
     ResetLodLevels();
@@ -1036,6 +1134,17 @@ void AnimatedModel::CalculateAnimations()
 {
     URHO3D_ASSERT(isMaster_);
 
+    UpdateLodSkippedBones();
+
+    // Animate from the last sampled pose rather than from the interpolated one
+    const unsigned numBones = skeletonData_.size();
+    const bool interpolate = animationLodInterpolation_ && animationLodBias_ > 0.0f && animationLodDistance_ > 0.0f;
+    if (interpolate && lodTargetPose_.size() == numBones)
+    {
+        for (unsigned i = 0; i < numBones; ++i)
+            skeletonData_[i].localToParent_ = lodTargetPose_[i];
+    }
+
     // AnimationStateSource is a weak pointer which may or may not be an issue
     if (AnimationStateSource* animationStateSource = animationStateSource_)
     {
@@ -1043,10 +1152,80 @@ void AnimatedModel::CalculateAnimations()
             state->CalculateModelTracks(skeletonData_);
     }
 
+    if (interpolate)
+        StoreLodTargetPose();
+    else
+    {
+        lodPreviousPose_.clear();
+        lodTargetPose_.clear();
+    }
+
     animationDirty_ = false;
     boneBoundingBoxDirty_ = true;
 }
 
+void AnimatedModel::UpdateLodSkippedBones()
+{
+    const Vector3 worldScale = node_->GetWorldScale().Abs();
+    const float pixelsPerUnit = animationLodPixelsPerUnit_ * ea::max(worldScale.x_, ea::max(worldScale.y_, worldScale.z_));
+    const bool enabled = animationLodBoneScreenSize_ > 0.0f && pixelsPerUnit > 0.0f;
+
+    numLodSkippedBones_ = 0;
+    for (unsigned boneIndex = 0; boneIndex < skeletonData_.size(); ++boneIndex)
+    {
+        ModelAnimationOutput& output = skeletonData_[boneIndex];
+        output.lodSkipped_ = false;
+        if (!enabled)
+            continue;
+
+        // Bones without size are never skipped, they are likely to affect other bones
+        const Bone* bone = skeleton_.GetBone(boneIndex);
+        float size = 0.0f;
+        if (bone->collisionMask_ & BONECOLLISION_SPHERE)
+            size = 2.0f * bone->radius_;
+        if (bone->collisionMask_ & BONECOLLISION_BOX)
+            size = ea::max(size, bone->boundingBox_.Size().Length());
+
+        if (size > 0.0f && size * pixelsPerUnit < animationLodBoneScreenSize_)
+        {
+            output.lodSkipped_ = true;
+            ++numLodSkippedBones_;
+        }
+    }
+}
+
+void AnimatedModel::StoreLodTargetPose()
+{
+    const unsigned numBones = skeletonData_.size();
+    if (lodTargetPose_.size() != numBones)
+    {
+        lodTargetPose_.resize(numBones);
+        for (unsigned i = 0; i < numBones; ++i)
+            lodTargetPose_[i] = skeletonData_[i].localToParent_;
+    }
+
+    // Show the previous pose now, the new pose is reached by the next update
+    lodPreviousPose_ = lodTargetPose_;
+    for (unsigned i = 0; i < numBones; ++i)
+    {
+        lodTargetPose_[i] = skeletonData_[i].localToParent_;
+        skeletonData_[i].localToParent_ = lodPreviousPose_[i];
+    }
+}
+
+void AnimatedModel::InterpolateLodPose()
+{
+    const unsigned numBones = skeletonData_.size();
+    if (lodPreviousPose_.size() != numBones || lodTargetPose_.size() != numBones || animationLodDistance_ <= 0.0f)
+        return;
+
+    const float factor = Clamp(animationLodTimer_ / animationLodDistance_, 0.0f, 1.0f);
+    for (unsigned i = 0; i < numBones; ++i)
+        skeletonData_[i].localToParent_ = lodPreviousPose_[i].Lerp(lodTargetPose_[i], factor);
+
+    boneBoundingBoxDirty_ = true;
+}
+
 void AnimatedModel::ApplyAnimation()
 {
     // Reset skeleton, apply all animations, calculate bones' bounding box. Make sure this is only done for the master model
@@ -1060,6 +1239,44 @@ void AnimatedModel::ApplyAnimation()
     }
 }
 
+void AnimatedModel::EvaluateBoneWorldTransforms(ea::span<Vector3> positions, ea::span<Quaternion> rotations)
+{
+    const unsigned numBones = skeleton_.GetNumBones();
+    URHO3D_ASSERT(positions.size() == numBones && rotations.size() == numBones);
+
+    InitializeLocalBoneTransforms(false);
+    for (ModelAnimationOutput& output : skeletonData_)
+        output.lodSkipped_ = false;
+
+    if (AnimationStateSource* animationStateSource = isMaster_ ? animationStateSource_.Get() : nullptr)
+    {
+        for (AnimationState* state : animationStateSource->GetAnimationStates())
+            state->CalculateModelTracks(skeletonData_);
+    }
+
+    // Accumulate world transforms in the same order as Node does, so the result matches the nodes if they were updated.
+    // Model space matrices are not needed here, reuse them to store world space matrices
+    for (unsigned boneIndex : skeleton_.GetBonesOrder())
+    {
+        const Bone* bone = skeleton_.GetBone(boneIndex);
+        ModelAnimationOutput& output = skeletonData_[boneIndex];
+        const Matrix3x4 localTransform = output.localToParent_.ToMatrix3x4();
+
+        if (bone->parentIndex_ == boneIndex)
+        {
+            const Node* parentNode = bone->node_ && bone->node_->GetParent() ? bone->node_->GetParent() : node_;
+            output.localToComponent_ = parentNode->GetWorldTransform() * localTransform;
+            rotations[boneIndex] = parentNode->GetWorldRotation() * output.localToParent_.rotation_;
+        }
+        else
+        {
+            output.localToComponent_ = skeletonData_[bone->parentIndex_].localToComponent_ * localTransform;
+            rotations[boneIndex] = rotations[bone->parentIndex_] * output.localToParent_.rotation_;
+        }
+        positions[boneIndex] = output.localToComponent_.Translation();
+    }
+}
+
 void AnimatedModel::ApplyBoneTransformsToNodes()
 {
     for (unsigned boneIndex = 0; boneIndex < skeleton_.GetNumBones(); ++boneIndex)
@@ -1128,13 +1345,19 @@ void AnimatedModel::UpdateMorphs()
     if (!graphics)
         return;
 
-    if (modelAnimator_)
+    if (computeModelAnimator_)
+        computeModelAnimator_->Update(morphs_, skinMatrices_);
+    else if (modelAnimator_)
     {
         modelAnimator_->ResetAnimation();
         modelAnimator_->ApplyMorphs(morphs_);
         if (softwareSkinning_)
             modelAnimator_->ApplySkinning(skinMatrices_);
-        modelAnimator_->Commit();
+
+        if (Thread::IsMainThread())
+            modelAnimator_->Commit();
+        else
+            commitPending_ = true;
     }
 
     morphsDirty_ = false;
@@ -1154,6 +1377,7 @@ void AnimatedModel::UpdateSoftwareSkinningState()
         return;
 
     softwareSkinning_ = !renderer->GetUseHardwareSkinning();
+    computeSkinning_ = renderer->GetUseComputeSkinning();
     numSoftwareSkinningBones_ = renderer->GetNumSoftwareSkinningBones();
 
     if (renderer->GetSkinningMode() == SKINNING_AUTO && model_)
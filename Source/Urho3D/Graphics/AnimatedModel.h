@@ -32,6 +32,7 @@ namespace Urho3D
 
 class Animation;
 class AnimationState;
+class ComputeModelAnimator;
 class SoftwareModelAnimator;
 
 /// Animated model component.
@@ -77,9 +78,20 @@ public:
     /// Set animation LOD bias.
     /// @property
     void SetAnimationLodBias(float bias);
+    /// Set whether to interpolate the pose between updates skipped by animation LOD.
+    /// Pose is delayed by one update interval, but the motion is smooth.
+    /// @property
+    void SetAnimationLodInterpolation(bool enable);
+    /// Set size of the bone on the screen in pixels below which the bone is not animated.
+    /// Only bones with collision sphere or box are affected. Zero disables bone LOD.
+    /// @property
+    void SetAnimationLodBoneScreenSize(float size);
     /// Set whether to update animation and the bounding box when not visible. Recommended to enable for physically controlled models like ragdolls.
     /// @property
     void SetUpdateInvisible(bool enable);
+    /// Set whether bone transforms are used by gameplay code and should be animated in lean update mode of Octree.
+    /// Bones with components or attached nodes are always animated.
+    void SetBoneTransformsRequired(bool required) { boneTransformsRequired_ = required; }
     /// Set vertex morph weight by index.
     void SetMorphWeight(unsigned index, float weight);
     /// Set vertex morph weight by name.
@@ -93,6 +105,11 @@ public:
     void ResetBones();
     /// Apply all animation states to nodes.
     void ApplyAnimation();
+    /// Evaluate animation states and return world positions and rotations of all bones without applying them to nodes.
+    /// Bounding box, morphs and skinning are not updated. Transforms of bone nodes are used for channels that are not animated.
+    /// Safe to call from worker threads for different models
+    /// if world transforms of the model node and of the parent of the root bone are already calculated.
+    void EvaluateBoneWorldTransforms(ea::span<Vector3> positions, ea::span<Quaternion> rotations);
     /// Connect to AnimationStateSource that provides animation states.
     void ConnectToAnimationStateSource(AnimationStateSource* source);
 
@@ -103,10 +120,22 @@ public:
     /// Return animation LOD bias.
     /// @property
     float GetAnimationLodBias() const { return animationLodBias_; }
+    /// Return whether to interpolate the pose between updates skipped by animation LOD.
+    /// @property
+    bool GetAnimationLodInterpolation() const { return animationLodInterpolation_; }
+    /// Return size of the bone on the screen in pixels below which the bone is not animated.
+    /// @property
+    float GetAnimationLodBoneScreenSize() const { return animationLodBoneScreenSize_; }
+    /// Return number of bones skipped by animation LOD during the last update.
+    unsigned GetNumLodSkippedBones() const { return numLodSkippedBones_; }
 
     /// Return whether to update animation when not visible.
     /// @property
     bool GetUpdateInvisible() const { return updateInvisible_; }
+    /// Return whether bone transforms are used by gameplay code and should be animated in lean update mode of Octree.
+    bool GetBoneTransformsRequired() const { return boneTransformsRequired_; }
+    /// Return whether any bone node has components or child nodes that are not bones.
+    bool HasBoneAttachments() const;
 
     /// Return all vertex morphs.
     const ea::vector<ModelMorph>& GetMorphs() const { return morphs_; }
@@ -190,6 +219,9 @@ private:
     void CalculateFinalBoneTransforms();
     void CalculateLocalBoundingBox();
     void CalculateAnimations();
+    void UpdateLodSkippedBones();
+    void StoreLodTargetPose();
+    void InterpolateLodPose();
     void ApplyBoneTransformsToNodes();
 
     void UpdateSkinning();
@@ -202,6 +234,8 @@ private:
     bool morphsDirty_{};
     bool skinningDirty_{true};
     bool boneBoundingBoxDirty_{true};
+    /// Whether software animated vertices are calculated in worker thread and should be uploaded from main thread.
+    bool commitPending_{};
     /// @}
 
     /// Skeleton.
@@ -212,6 +246,8 @@ private:
     WeakPtr<AnimationStateSource> animationStateSource_;
     /// Software model animator.
     SharedPtr<SoftwareModelAnimator> modelAnimator_;
+    /// Compute model animator. Used instead of software model animator if compute skinning is enabled.
+    SharedPtr<ComputeModelAnimator> computeModelAnimator_;
     /// Vertex morphs.
     ea::vector<ModelMorph> morphs_;
     /// Skinning matrices.
@@ -234,10 +270,25 @@ private:
     float animationLodTimer_;
     /// Animation LOD distance, the minimum of all LOD view distances last frame.
     float animationLodDistance_;
+    /// Whether to interpolate the pose between updates skipped by animation LOD.
+    bool animationLodInterpolation_{};
+    /// Size of the bone on the screen in pixels below which the bone is not animated.
+    float animationLodBoneScreenSize_{};
+    /// Screen pixels per world unit, the maximum of all views last frame.
+    float animationLodPixelsPerUnit_{};
+    /// Number of bones skipped by animation LOD during the last update.
+    unsigned numLodSkippedBones_{};
+    /// Pose of the previous and the last animation update, used for interpolation.
+    ea::vector<Transform> lodPreviousPose_;
+    ea::vector<Transform> lodTargetPose_;
     /// Update animation when invisible flag.
     bool updateInvisible_;
+    /// Whether bone transforms are required in lean update mode.
+    bool boneTransformsRequired_{};
     /// Software skinning flag.
     bool softwareSkinning_{};
+    /// Compute skinning flag. Compute skinning also uses static geometries like software skinning.
+    bool computeSkinning_{};
     /// Number of bones used for software skinning.
     unsigned numSoftwareSkinningBones_{ 4 };
     /// Master model flag.
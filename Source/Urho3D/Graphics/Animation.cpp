@@ -27,6 +27,7 @@
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
 #include "../Graphics/Animation.h"
+#include "../Graphics/Skeleton.h"
 #include "../IO/Deserializer.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
@@ -589,6 +590,8 @@ AnimationTriggerPoint* Animation::GetTrigger(unsigned index)
 
 void Animation::SetTracks(const ea::vector<AnimationTrack>& tracks)
 {
+    MarkRevisionUpdated();
+
     tracks_.clear();
 
     for (auto itr = tracks.begin(); itr != tracks.end(); itr++)
@@ -597,4 +600,21 @@ void Animation::SetTracks(const ea::vector<AnimationTrack>& tracks)
     }
 }
 
+const ea::vector<unsigned>& Animation::GetTrackBoneIndices(const Skeleton& skeleton) const
+{
+    unsigned skeletonHash = 0;
+    for (const Bone& bone : skeleton.GetBones())
+        CombineHash(skeletonHash, bone.nameHash_.Value());
+
+    TrackBoneMapping& mapping = trackBoneMappings_[skeletonHash];
+    if (mapping.revision_ != GetRevision() || mapping.boneIndices_.size() != tracks_.size())
+    {
+        mapping.revision_ = GetRevision();
+        mapping.boneIndices_.clear();
+        for (const auto& [nameHash, track] : tracks_)
+            mapping.boneIndices_.push_back(skeleton.GetBoneIndex(track.nameHash_));
+    }
+    return mapping.boneIndices_;
+}
+
 }
@@ -32,6 +32,8 @@
 namespace Urho3D
 {
 
+class Skeleton;
+
 /// %Animation trigger point.
 struct AnimationTriggerPoint
 {
@@ -145,6 +147,11 @@ public:
     /// Set all animation tracks.
     void SetTracks(const ea::vector<AnimationTrack>& tracks);
 
+    /// Return index of the skeleton bone for each track in the order of GetTracks(), M_MAX_UNSIGNED if there's no bone.
+    /// Mapping is cached per set of bone names and shared by all models with the same skeleton.
+    /// Should be called from the main thread.
+    const ea::vector<unsigned>& GetTrackBoneIndices(const Skeleton& skeleton) const;
+
 private:
     void LoadTriggersFromXML(const XMLElement& source);
 
@@ -169,6 +176,15 @@ private:
     ea::unordered_map<StringHash, VariantAnimationTrack> variantTracks_;
     /// Animation trigger points.
     ea::vector<AnimationTriggerPoint> triggers_;
+
+    /// Bone indices of tracks for specific skeleton.
+    struct TrackBoneMapping
+    {
+        unsigned revision_{M_MAX_UNSIGNED};
+        ea::vector<unsigned> boneIndices_;
+    };
+    /// Cached bone indices of tracks. Key is the hash of skeleton bone names.
+    mutable ea::unordered_map<unsigned, TrackBoneMapping> trackBoneMappings_;
 };
 
 }
@@ -27,6 +27,7 @@
 #include "../Graphics/AnimatedModel.h"
 #include "../Graphics/Animation.h"
 #include "../Graphics/AnimationController.h"
+#include "../Graphics/AnimationControllerManager.h"
 #include "../Graphics/AnimationState.h"
 #include "../Graphics/DrawableEvents.h"
 #include "../Graphics/Renderer.h"
@@ -395,7 +396,11 @@ AnimationController::AnimationController(Context* context) :
 {
 }
 
-AnimationController::~AnimationController() = default;
+AnimationController::~AnimationController()
+{
+    if (manager_)
+        manager_->RemoveController(this);
+}
 
 void AnimationController::RegisterObject(Context* context)
 {
@@ -403,6 +408,7 @@ void AnimationController::RegisterObject(Context* context)
 
     URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, bool, true, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Reset Skeleton", bool, resetSkeleton_, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Cache Pose", IsPoseCaching, SetPoseCaching, bool, false, AM_DEFAULT);
     URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Animations", GetAnimationsAttr, SetAnimationsAttr, VariantVector, Variant::emptyVariantVector, AM_DEFAULT)
         .SetMetadata(AttributeMetadata::VectorStructElements, animationParametersNames);
 
@@ -416,32 +422,25 @@ void AnimationController::ApplyAttributes()
 
 void AnimationController::OnSetEnabled()
 {
-    Scene* scene = GetScene();
-    if (scene)
-    {
-        if (IsEnabledEffective())
-            SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(AnimationController, HandleScenePostUpdate));
-        else
-            UnsubscribeFromEvent(scene, E_SCENEPOSTUPDATE);
-    }
+    if (Scene* scene = GetScene())
+        UpdateEventSubscriptions(scene);
 }
 
 void AnimationController::Update(float timeStep)
 {
-    // Update stats
-    if (auto renderer = GetSubsystem<Renderer>())
-    {
-        FrameStatistics& stats = renderer->GetMutableFrameStats();
-        ++stats.animations_;
-        if (revisionDirty_)
-            ++stats.changedAnimations_;
-    }
+    UpdateAnimations(timeStep);
+    CommitAnimations();
+}
 
+void AnimationController::UpdateAnimations(float timeStep)
+{
     // Update revision
+    revisionUpdated_ = revisionDirty_;
     if (revisionDirty_)
     {
         ++revision_;
         revisionDirty_ = false;
+        poseDirty_ = true;
     }
 
     // Update individual animations
@@ -451,20 +450,41 @@ void AnimationController::Update(float timeStep)
         if (!params.GetAnimation())
             continue;
         UpdateInstance(params, timeStep, true);
-        if (!params.removed_)
-            UpdateState(state, params);
+        if (!params.removed_ && UpdateState(state, params))
+            poseDirty_ = true;
     }
+    const unsigned numAnimations = animations_.size();
     ea::erase_if(animations_, [](const AnimationInstance& value) { return value.params_.removed_; });
+    if (animations_.size() != numAnimations)
+        animationStatesDirty_ = true;
 
     // Sort animation states if necessary
     if (animationStatesDirty_)
+    {
         SortAnimationStates();
+        poseDirty_ = true;
+    }
+}
+
+void AnimationController::CommitAnimations()
+{
+    // Update stats
+    if (auto renderer = GetSubsystem<Renderer>())
+    {
+        FrameStatistics& stats = renderer->GetMutableFrameStats();
+        ++stats.animations_;
+        if (revisionUpdated_)
+            ++stats.changedAnimations_;
+    }
 
     // Update animation tracks if necessary
     for (AnimationState* state : animationStates_)
     {
         if (state->AreTracksDirty())
+        {
             UpdateAnimationStateTracks(state);
+            poseDirty_ = true;
+        }
     }
 
     // Reset skeleton if necessary
@@ -474,8 +494,24 @@ void AnimationController::Update(float timeStep)
             model->GetSkeleton().Reset();
     }
 
-    // Node and attribute animations need to be applied manually
-    CommitNodeAndAttributeAnimations();
+    // Node and attribute animations need to be applied manually.
+    // Skeleton reset discards the pose, so it has to be applied every frame.
+    if (!poseCaching_ || poseDirty_ || resetSkeleton_)
+        CommitNodeAndAttributeAnimations();
+    poseDirty_ = false;
+}
+
+void AnimationController::SetManager(AnimationControllerManager* manager)
+{
+    if (manager_ != manager)
+    {
+        if (manager_)
+            manager_->RemoveController(this);
+        manager_ = manager;
+        if (manager_)
+            manager_->AddController(this);
+    }
+    UpdateEventSubscriptions(GetScene());
 }
 
 const AnimationParameters& AnimationController::GetAnimationParameters(unsigned index) const
@@ -978,9 +1014,26 @@ void AnimationController::OnNodeSet(Node* previousNode, Node* currentNode)
 
 void AnimationController::OnSceneSet(Scene* scene)
 {
-    if (scene && IsEnabledEffective())
+    auto manager = scene ? scene->GetComponent<AnimationControllerManager>() : nullptr;
+    if (manager && !manager->IsEnabledEffective())
+        manager = nullptr;
+
+    if (manager_ != manager)
+    {
+        if (manager_)
+            manager_->RemoveController(this);
+        manager_ = manager;
+        if (manager_)
+            manager_->AddController(this);
+    }
+    UpdateEventSubscriptions(scene);
+}
+
+void AnimationController::UpdateEventSubscriptions(Scene* scene)
+{
+    if (!manager_ && scene && IsEnabledEffective())
         SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(AnimationController, HandleScenePostUpdate));
-    else if (!scene)
+    else
         UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
 }
 
@@ -1168,9 +1221,9 @@ void AnimationController::EnsureStateInitialized(AnimationState* state, const An
     state->Initialize(params.GetAnimation(), params.startBone_, params.blendMode_);
 }
 
-void AnimationController::UpdateState(AnimationState* state, const AnimationParameters& params) const
+bool AnimationController::UpdateState(AnimationState* state, const AnimationParameters& params) const
 {
-    state->Update(params.looped_, params.GetTime(), params.weight_);
+    return state->Update(params.looped_, params.GetTime(), params.weight_);
 }
 
 void AnimationController::SortAnimationStates()
@@ -1195,7 +1248,6 @@ void AnimationController::SortAnimationStates()
 
 void AnimationController::UpdateAnimationStateTracks(AnimationState* state)
 {
-    // TODO(animation): Cache lookups?
     auto model = GetComponent<AnimatedModel>();
     const Animation* animation = state->GetAnimation();
 
@@ -1216,15 +1268,19 @@ void AnimationController::UpdateAnimationStateTracks(AnimationState* state)
     if (!startNode)
         startNode = node_;
 
-    // Setup model and node tracks
+    // Setup model and node tracks. Bone lookups are shared by all models with the same skeleton.
     const auto& tracks = animation->GetTracks();
+    const ea::vector<unsigned>* trackBoneIndices = model ? &animation->GetTrackBoneIndices(model->GetSkeleton()) : nullptr;
+    unsigned trackIndex = 0;
     for (const auto& item : tracks)
     {
         const AnimationTrack& track = item.second;
 
         // Try to find bone first, filter by start bone node
-        const unsigned trackBoneIndex = model ? model->GetSkeleton().GetBoneIndex(track.nameHash_) : M_MAX_UNSIGNED;
+        const unsigned trackBoneIndex = trackBoneIndices ? (*trackBoneIndices)[trackIndex++] : M_MAX_UNSIGNED;
         Bone* trackBone = trackBoneIndex != M_MAX_UNSIGNED ? model->GetSkeleton().GetBone(trackBoneIndex) : nullptr;
+        if (trackBone && trackBone->nameHash_ != track.nameHash_)
+            trackBone = nullptr;
         if (trackBone && trackBone->node_ && (startNode == node_ || trackBone->node_->IsChildOf(startNode)))
         {
             ModelAnimationStateTrack stateTrack;
@@ -36,6 +36,7 @@ namespace Urho3D
 
 class AnimatedModel;
 class Animation;
+class AnimationControllerManager;
 struct AnimationTriggerPoint;
 struct Bone;
 
@@ -156,7 +157,7 @@ public:
     /// Should be called on every substantial change in animated structure.
     void MarkAnimationStateTracksDirty() override;
 
-    /// Update the animations. Is called from HandleScenePostUpdate().
+    /// Update the animations. Is called from HandleScenePostUpdate() unless AnimationControllerManager is present.
     virtual void Update(float timeStep);
     /// Smoothly replace existing animations with animations from external source.
     void ReplaceAnimations(ea::span<const AnimationParameters> newAnimations, float elapsedTime, float fadeTime);
@@ -215,6 +216,20 @@ public:
     bool IsSkeletonReset() const { return resetSkeleton_; }
     void SetSkeletonReset(bool resetSkeleton) { resetSkeleton_ = resetSkeleton; }
 
+    /// Set whether to skip applying node and attribute animations when no animation has changed since the last update.
+    void SetPoseCaching(bool enable) { poseCaching_ = enable; poseDirty_ = true; }
+    /// Return whether to skip applying node and attribute animations when no animation has changed.
+    bool IsPoseCaching() const { return poseCaching_; }
+
+    /// Internal. Phases of Update used by AnimationControllerManager.
+    /// UpdateAnimations changes only the controller and its AnimatedModel and may be called from worker threads.
+    /// CommitAnimations applies node and attribute animations and should be called from the main thread.
+    /// @{
+    void UpdateAnimations(float timeStep);
+    void CommitAnimations();
+    void SetManager(AnimationControllerManager* manager);
+    /// @}
+
     /// Set animation parameters attribute.
     void SetAnimationsAttr(const VariantVector& value);
     /// Return animation parameters attribute.
@@ -229,6 +244,8 @@ protected:
 private:
     /// Handle scene post-update event.
     void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+    /// Subscribe to scene update or register in the manager.
+    void UpdateEventSubscriptions(Scene* scene);
     /// Sort animations states according to the layers.
     void SortAnimationStates();
     /// Update animation state tracks so they are connected to correct animatable objects.
@@ -251,7 +268,7 @@ private:
     void ApplyInstanceRemoval(AnimationParameters& params, bool isCompleted) const;
 
     void EnsureStateInitialized(AnimationState* state, const AnimationParameters& params);
-    void UpdateState(AnimationState* state, const AnimationParameters& params) const;
+    bool UpdateState(AnimationState* state, const AnimationParameters& params) const;
     /// @}
 
     void CommitNodeAndAttributeAnimations();
@@ -259,6 +276,10 @@ private:
 
     /// Whether to reset AnimatedModel skeleton to bind pose every frame.
     bool resetSkeleton_{};
+    /// Whether to skip node and attribute animations if nothing has changed.
+    bool poseCaching_{};
+    /// Manager that updates the controller, if present in the scene.
+    WeakPtr<AnimationControllerManager> manager_;
 
     /// Currently playing animations.
     struct AnimationInstance
@@ -280,6 +301,11 @@ private:
     bool revisionDirty_{};
     /// @}
 
+    /// Whether the animations have changed since the last commit.
+    bool poseDirty_{true};
+    /// Whether the revision has changed on the last update.
+    bool revisionUpdated_{};
+
     /// Temporary buffers for animated values.
     /// TODO: Nodes may be expired for unused elements!
     /// TODO: Revisit allocations?
@@ -0,0 +1,152 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Graphics/AnimationControllerManager.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
+#include "../Graphics/AnimationController.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
+
+#include <EASTL/algorithm.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+AnimationControllerManager::AnimationControllerManager(Context* context)
+    : Component(context)
+{
+}
+
+AnimationControllerManager::~AnimationControllerManager()
+{
+    const auto controllers = controllers_;
+    for (AnimationController* controller : controllers)
+        controller->SetManager(nullptr);
+}
+
+void AnimationControllerManager::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<AnimationControllerManager>(Category_Logic);
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, bool, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Parallel Update", IsParallelUpdate, SetParallelUpdate, bool, true, AM_DEFAULT);
+}
+
+void AnimationControllerManager::OnSetEnabled()
+{
+    ConnectControllers(GetScene() && IsEnabledEffective());
+}
+
+void AnimationControllerManager::AddController(AnimationController* controller)
+{
+    if (ea::find(controllers_.begin(), controllers_.end(), controller) == controllers_.end())
+        controllers_.push_back(controller);
+}
+
+void AnimationControllerManager::RemoveController(AnimationController* controller)
+{
+    const auto iter = ea::find(controllers_.begin(), controllers_.end(), controller);
+    if (iter != controllers_.end())
+    {
+        *iter = controllers_.back();
+        controllers_.pop_back();
+    }
+}
+
+void AnimationControllerManager::Update(float timeStep)
+{
+    URHO3D_PROFILE("UpdateAnimationControllers");
+
+    enabledControllers_.clear();
+    for (AnimationController* controller : controllers_)
+    {
+        if (controller->IsEnabledEffective())
+            enabledControllers_.push_back(controller);
+    }
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    Scene* scene = GetScene();
+    if (parallelUpdate_ && workQueue && enabledControllers_.size() > ParallelUpdateBucketSize)
+    {
+        // AnimatedModel-s are queued for update from worker threads
+        scene->BeginThreadedUpdate();
+        ForEachParallel(workQueue, ParallelUpdateBucketSize, enabledControllers_,
+            [timeStep](unsigned /*index*/, AnimationController* controller) { controller->UpdateAnimations(timeStep); });
+        scene->EndThreadedUpdate();
+    }
+    else
+    {
+        for (AnimationController* controller : enabledControllers_)
+            controller->UpdateAnimations(timeStep);
+    }
+
+    // Applied animations may add or remove controllers, iterate by index over the actual list
+    for (unsigned i = 0; i < controllers_.size(); ++i)
+    {
+        AnimationController* controller = controllers_[i];
+        if (controller->IsEnabledEffective())
+            controller->CommitAnimations();
+    }
+}
+
+void AnimationControllerManager::OnSceneSet(Scene* scene)
+{
+    if (scene)
+    {
+        SubscribeToEvent(scene, E_SCENEPOSTUPDATE,
+            [this](VariantMap& eventData)
+        {
+            using namespace ScenePostUpdate;
+            Update(eventData[P_TIMESTEP].GetFloat());
+        });
+    }
+    else
+        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+
+    ConnectControllers(scene && IsEnabledEffective());
+}
+
+void AnimationControllerManager::ConnectControllers(bool connect)
+{
+    if (!connect)
+    {
+        const auto controllers = controllers_;
+        for (AnimationController* controller : controllers)
+            controller->SetManager(nullptr);
+        return;
+    }
+
+    ea::vector<AnimationController*> controllers;
+    GetScene()->GetComponents<AnimationController>(controllers, true);
+    for (AnimationController* controller : controllers)
+        controller->SetManager(this);
+}
+
+}
@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/// \file
+
+#pragma once
+
+#include "../Scene/Component.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class AnimationController;
+
+/// Updates all AnimationController components of the scene at once.
+/// Animation time and weights are updated in parallel on WorkQueue threads,
+/// node and attribute animations are applied from the main thread afterwards.
+/// Should be added to the scene root. Controllers update themselves if the manager is absent.
+class URHO3D_API AnimationControllerManager : public Component
+{
+    URHO3D_OBJECT(AnimationControllerManager, Component);
+
+public:
+    /// Number of controllers processed by thread at once.
+    static constexpr unsigned ParallelUpdateBucketSize = 16;
+
+    /// Construct.
+    explicit AnimationControllerManager(Context* context);
+    /// Destruct.
+    ~AnimationControllerManager() override;
+    /// Register object factory.
+    static void RegisterObject(Context* context);
+
+    /// Handle enabled/disabled state change.
+    void OnSetEnabled() override;
+
+    /// Update all controllers. Called automatically on scene post-update.
+    void Update(float timeStep);
+
+    /// Set whether to update controllers in parallel.
+    void SetParallelUpdate(bool enable) { parallelUpdate_ = enable; }
+    /// Return whether to update controllers in parallel.
+    bool IsParallelUpdate() const { return parallelUpdate_; }
+
+    /// Return number of managed controllers, including disabled ones.
+    unsigned GetNumControllers() const { return controllers_.size(); }
+
+    /// Internal. Manage controllers.
+    /// @{
+    void AddController(AnimationController* controller);
+    void RemoveController(AnimationController* controller);
+    /// @}
+
+protected:
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+
+private:
+    /// Connect all controllers of the scene to the manager or disconnect them.
+    void ConnectControllers(bool connect);
+
+    bool parallelUpdate_{true};
+
+    ea::vector<AnimationController*> controllers_;
+    /// Controllers updated on the current frame.
+    ea::vector<AnimationController*> enabledControllers_;
+};
+
+}
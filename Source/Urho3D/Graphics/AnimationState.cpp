@@ -132,11 +132,17 @@ void AnimationState::Initialize(Animation* animation, const ea::string& startBon
     }
 }
 
-void AnimationState::Update(bool looped, float time, float weight)
+bool AnimationState::Update(bool looped, float time, float weight)
 {
+    const bool oldLooped = looped_;
+    const float oldTime = time_;
+    const float oldWeight = weight_;
+
     SetLooped(looped);
     SetTime(time);
     SetWeight(weight);
+
+    return looped_ != oldLooped || time_ != oldTime || weight_ != oldWeight;
 }
 
 bool AnimationState::AreTracksDirty() const
@@ -245,6 +251,8 @@ void AnimationState::CalculateModelTracks(ea::vector<ModelAnimationOutput>& outp
 
         URHO3D_ASSERT(output.size() > stateTrack.boneIndex_);
         ModelAnimationOutput& trackOutput = output[stateTrack.boneIndex_];
+        if (trackOutput.lodSkipped_)
+            continue;
 
         unsigned keyFrame = stateTrack.keyFrame_;
         CalculateTransformTrack(trackOutput, *stateTrack.track_, keyFrame, weight_);
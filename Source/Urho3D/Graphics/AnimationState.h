@@ -85,6 +85,8 @@ struct ModelAnimationOutput : public NodeAnimationOutput
 {
     // Unused by AnimationState, but it's just convinient to have here.
     Matrix3x4 localToComponent_;
+    /// Whether the bone is skipped by animation LOD. Tracks are not applied to skipped bones.
+    bool lodSkipped_{};
 };
 
 /// Custom attribute type, used to support sub-attribute animation in special cases.
@@ -146,8 +148,8 @@ public:
     ~AnimationState() override;
     /// Initialize static properties of the state and dirty tracks if changed.
     void Initialize(Animation* animation, const ea::string& startBone, AnimationBlendMode blendMode);
-    /// Update dynamic properies of the state.
-    void Update(bool looped, float time, float weight);
+    /// Update dynamic properies of the state. Return whether any of them has changed.
+    bool Update(bool looped, float time, float weight);
 
     /// Modify tracks. For internal use only.
     /// @{
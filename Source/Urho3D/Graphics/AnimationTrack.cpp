@@ -30,6 +30,17 @@
 namespace Urho3D
 {
 
+namespace
+{
+
+/// Return angle between rotations in degrees.
+float GetRotationDifference(const Quaternion& lhs, const Quaternion& rhs)
+{
+    return 2.0f * Acos(Abs(lhs.DotProduct(rhs)));
+}
+
+}
+
 void AnimationTrack::Sample(float time, float duration, bool isLooped, unsigned& frameIndex, Transform& value) const
 {
     float blendFactor{};
@@ -77,6 +88,72 @@ bool AnimationTrack::IsLooped(float positionThreshold, float rotationThreshold,
     return true;
 }
 
+void AnimationTrack::CompressKeyFrames(float positionError, float rotationError, float scaleError)
+{
+    const unsigned numKeyFrames = keyFrames_.size();
+    if (numKeyFrames <= 1)
+        return;
+
+    const auto isEquivalent = [&](const Transform& lhs, const Transform& rhs)
+    {
+        if (channelMask_.Test(CHANNEL_POSITION) && (lhs.position_ - rhs.position_).Length() > positionError)
+            return false;
+        if (channelMask_.Test(CHANNEL_ROTATION) && GetRotationDifference(lhs.rotation_, rhs.rotation_) > rotationError)
+            return false;
+        if (channelMask_.Test(CHANNEL_SCALE) && (lhs.scale_ - rhs.scale_).Length() > scaleError)
+            return false;
+        return true;
+    };
+
+    const AnimationKeyFrame& firstKeyFrame = keyFrames_.front();
+    const auto isConstant = [&](const AnimationKeyFrame& keyFrame) { return isEquivalent(keyFrame, firstKeyFrame); };
+    if (ea::all_of(keyFrames_.begin() + 1, keyFrames_.end(), isConstant))
+    {
+        keyFrames_.resize(1);
+        return;
+    }
+
+    // Return whether keyframes between begin and end are reproduced by interpolation in the same way as Sample does
+    const auto isSegmentInterpolated = [&](unsigned begin, unsigned end)
+    {
+        const AnimationKeyFrame& beginKeyFrame = keyFrames_[begin];
+        const AnimationKeyFrame& endKeyFrame = keyFrames_[end];
+        const float timeInterval = endKeyFrame.time_ - beginKeyFrame.time_;
+        if (timeInterval <= 0.0f)
+            return false;
+
+        for (unsigned i = begin + 1; i < end; ++i)
+        {
+            const float blendFactor = (keyFrames_[i].time_ - beginKeyFrame.time_) / timeInterval;
+
+            Transform interpolated;
+            interpolated.position_ = beginKeyFrame.position_.Lerp(endKeyFrame.position_, blendFactor);
+            interpolated.rotation_ = beginKeyFrame.rotation_.Slerp(endKeyFrame.rotation_, blendFactor);
+            interpolated.scale_ = beginKeyFrame.scale_.Lerp(endKeyFrame.scale_, blendFactor);
+            if (!isEquivalent(interpolated, keyFrames_[i]))
+                return false;
+        }
+        return true;
+    };
+
+    // Greedily extend each segment while intermediate keyframes can be dropped
+    ea::vector<AnimationKeyFrame> result;
+    result.push_back(firstKeyFrame);
+
+    unsigned segmentBegin = 0;
+    for (unsigned segmentEnd = 2; segmentEnd < numKeyFrames; ++segmentEnd)
+    {
+        if (!isSegmentInterpolated(segmentBegin, segmentEnd))
+        {
+            segmentBegin = segmentEnd - 1;
+            result.push_back(keyFrames_[segmentBegin]);
+        }
+    }
+    result.push_back(keyFrames_.back());
+
+    keyFrames_ = ea::move(result);
+}
+
 bool VariantAnimationTrack::IsLooped() const
 {
     if (keyFrames_.empty())
@@ -66,6 +66,10 @@ struct URHO3D_API AnimationTrack : public KeyFrameSet<AnimationKeyFrame>
     void Sample(float time, float duration, bool isLooped, unsigned& frameIndex, Transform& transform) const;
     /// Return whether the track is looped, i.e. the first and the last keyframes have the same value.
     bool IsLooped(float positionThreshold = 0.001f, float rotationThreshold = 0.001f, float scaleThreshold = 0.001f) const;
+    /// Remove keyframes that are reproduced by interpolation of the remaining keyframes within given errors.
+    /// Position and scale errors are absolute, rotation error is angle in degrees.
+    /// Constant track is reduced to single keyframe.
+    void CompressKeyFrames(float positionError, float rotationError, float scaleError);
 };
 
 /// Generic variant animation keyframe.
@@ -26,6 +26,7 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/BillboardSet.h"
 #include "../Graphics/Camera.h"
 #include "../Graphics/Geometry.h"
@@ -70,10 +71,16 @@ static const StringVector billboardsStructureElementNames =
     "   Is Enabled"
 };
 
-inline bool CompareBillboards(Billboard* lhs, Billboard* rhs)
+/// Number of billboards processed by one task.
+static const unsigned BILLBOARDS_PER_TASK = 512;
+/// Radix sort is used for larger billboard sets.
+static const unsigned MIN_RADIX_SORT_BILLBOARDS = 128;
+
+struct ExtractBillboardSortKey
 {
-    return lhs->sortDistance_ > rhs->sortDistance_;
-}
+    using radix_type = unsigned;
+    radix_type operator()(const ea::pair<unsigned, unsigned>& value) const { return value.first; }
+};
 
 BillboardSet::BillboardSet(Context* context) :
     Drawable(context, DRAWABLE_GEOMETRY),
@@ -555,9 +562,10 @@ void BillboardSet::UpdateBufferSize()
     indexBuffer_->ClearDataLost();
 }
 
-void BillboardSet::BuildDefaultVertexBuffer(unsigned enabledBillboards, float* dest, const Vector3& billboardScale)
+void BillboardSet::BuildDefaultVertexBuffer(unsigned beginIndex, unsigned endIndex, float* dest, const Vector3& billboardScale)
 {
-    for (unsigned i = 0; i < enabledBillboards; ++i)
+    dest += beginIndex * 32;
+    for (unsigned i = beginIndex; i < endIndex; ++i)
     {
         Billboard& billboard = *sortedBillboards_[i];
 
@@ -611,9 +619,10 @@ void BillboardSet::BuildDefaultVertexBuffer(unsigned enabledBillboards, float* d
     }
 }
 
-void BillboardSet::BuildDirectionVertexBuffer(unsigned enabledBillboards, float* dest, const Vector3& billboardScale)
+void BillboardSet::BuildDirectionVertexBuffer(unsigned beginIndex, unsigned endIndex, float* dest, const Vector3& billboardScale)
 {
-    for (unsigned i = 0; i < enabledBillboards; ++i)
+    dest += beginIndex * 44;
+    for (unsigned i = beginIndex; i < endIndex; ++i)
     {
         Billboard& billboard = *sortedBillboards_[i];
 
@@ -679,9 +688,10 @@ void BillboardSet::BuildDirectionVertexBuffer(unsigned enabledBillboards, float*
     }
 }
 
-void BillboardSet::BuildAxisAngleVertexBuffer(unsigned enabledBillboards, float* dest, const Vector3& billboardScale)
+void BillboardSet::BuildAxisAngleVertexBuffer(unsigned beginIndex, unsigned endIndex, float* dest, const Vector3& billboardScale)
 {
-    for (unsigned i = 0; i < enabledBillboards; ++i)
+    dest += beginIndex * 52;
+    for (unsigned i = beginIndex; i < endIndex; ++i)
     {
         Billboard& billboard = *sortedBillboards_[i];
 
@@ -750,6 +760,52 @@ void BillboardSet::BuildAxisAngleVertexBuffer(unsigned enabledBillboards, float*
         ++dest;
     }
 }
+
+void BillboardSet::SortBillboards(const FrameInfo& frame, const Matrix3x4& billboardTransform)
+{
+    const unsigned numBillboards = sortedBillboards_.size();
+    sortKeys_.resize(numBillboards);
+
+    // Camera position and view are evaluated here because they are cached lazily
+    const Camera* camera = frame.camera_;
+    const bool isOrthographic = camera->IsOrthographic();
+    const Vector3 cameraPosition = camera->GetNode() ? camera->GetNode()->GetWorldPosition() : Vector3::ZERO;
+    const Matrix3x4 view = camera->GetView();
+
+    ForEachParallel(GetSubsystem<WorkQueue>(), BILLBOARDS_PER_TASK, numBillboards,
+        [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            Billboard& billboard = *sortedBillboards_[i];
+            const Vector3 worldPosition = billboardTransform * billboard.position_;
+            if (!isOrthographic)
+                billboard.sortDistance_ = (worldPosition - cameraPosition).LengthSquared();
+            else
+            {
+                const float distance = (view * worldPosition).z_;
+                billboard.sortDistance_ = distance * distance;
+            }
+
+            // Squared distance is non-negative and its bits are ordered like unsigned integers. Invert to sort back to front
+            sortKeys_[i] = {~FloatToRawIntBits(billboard.sortDistance_), i};
+        }
+    });
+
+    if (numBillboards >= MIN_RADIX_SORT_BILLBOARDS)
+    {
+        sortBuffer_.resize(numBillboards);
+        ea::radix_sort<ea::pair<unsigned, unsigned>*, ExtractBillboardSortKey>(
+            sortKeys_.begin(), sortKeys_.end(), sortBuffer_.begin());
+    }
+    else
+        ea::quick_sort(sortKeys_.begin(), sortKeys_.end());
+
+    unsortedBillboards_ = sortedBillboards_;
+    for (unsigned i = 0; i < numBillboards; ++i)
+        sortedBillboards_[i] = unsortedBillboards_[sortKeys_[i].second];
+}
+
 void BillboardSet::UpdateVertexBuffer(const FrameInfo& frame)
 {
     // If using animation LOD, accumulate time and see if it is time to update
@@ -782,16 +838,12 @@ void BillboardSet::UpdateVertexBuffer(const FrameInfo& frame)
     sortedBillboards_.resize(enabledBillboards);
     unsigned index = 0;
 
-    // Then set initial sort order and distances
+    // Then set initial sort order
     for (unsigned i = 0; i < numBillboards; ++i)
     {
         Billboard& billboard = billboards_[i];
         if (billboard.enabled_)
-        {
             sortedBillboards_[index++] = &billboard;
-            if (sorted_)
-                billboard.sortDistance_ = frame.camera_->GetDistanceSquared(billboardTransform * billboards_[i].position_);
-        }
     }
 
     batches_[0].geometry_->SetDrawRange(TRIANGLE_LIST, 0, enabledBillboards * 6, false);
@@ -803,7 +855,7 @@ void BillboardSet::UpdateVertexBuffer(const FrameInfo& frame)
 
     if (sorted_)
     {
-        ea::quick_sort(sortedBillboards_.begin(), sortedBillboards_.end(), CompareBillboards);
+        SortBillboards(frame, billboardTransform);
         Vector3 worldPos = node_->GetWorldPosition();
         // Store the "last sorted position" now
         previousOffset_ = (worldPos - frame.camera_->GetNode()->GetWorldPosition());
@@ -813,18 +865,17 @@ void BillboardSet::UpdateVertexBuffer(const FrameInfo& frame)
     if (!dest)
         return;
 
-    if (faceCameraMode_ == FC_DIRECTION)
+    // Billboards are written to disjoint ranges of the buffer, so large sets are processed in parallel
+    ForEachParallel(GetSubsystem<WorkQueue>(), BILLBOARDS_PER_TASK, enabledBillboards,
+        [&](unsigned beginIndex, unsigned endIndex)
     {
-        BuildDirectionVertexBuffer(enabledBillboards, dest, billboardScale);
-    }
-    else if (faceCameraMode_ == FC_AXIS_ANGLE)
-    {
-        BuildAxisAngleVertexBuffer(enabledBillboards, dest, billboardScale);
-    }
-    else
-    {
-        BuildDefaultVertexBuffer(enabledBillboards, dest, billboardScale);
-    }
+        if (faceCameraMode_ == FC_DIRECTION)
+            BuildDirectionVertexBuffer(beginIndex, endIndex, dest, billboardScale);
+        else if (faceCameraMode_ == FC_AXIS_ANGLE)
+            BuildAxisAngleVertexBuffer(beginIndex, endIndex, dest, billboardScale);
+        else
+            BuildDefaultVertexBuffer(beginIndex, endIndex, dest, billboardScale);
+    });
 
     vertexBuffer_->Unmap();
     vertexBuffer_->ClearDataLost();
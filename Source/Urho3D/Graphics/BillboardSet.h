@@ -197,12 +197,14 @@ private:
     void UpdateBufferSize();
     /// Rewrite billboard vertex buffer.
     void UpdateVertexBuffer(const FrameInfo& frame);
-    ///
-    void BuildDefaultVertexBuffer(unsigned enabledBillboards, float* dest, const Vector3& billboardScale);
-    ///
-    void BuildDirectionVertexBuffer(unsigned enabledBillboards, float* dest, const Vector3& billboardScale);
-    ///
-    void BuildAxisAngleVertexBuffer(unsigned enabledBillboards, float* dest, const Vector3& billboardScale);
+    /// Sort enabled billboards back to front.
+    void SortBillboards(const FrameInfo& frame, const Matrix3x4& billboardTransform);
+    /// Write vertices of sorted billboards in range [beginIndex, endIndex) for default face camera modes.
+    void BuildDefaultVertexBuffer(unsigned beginIndex, unsigned endIndex, float* dest, const Vector3& billboardScale);
+    /// Write vertices of sorted billboards in range [beginIndex, endIndex) for FC_DIRECTION mode.
+    void BuildDirectionVertexBuffer(unsigned beginIndex, unsigned endIndex, float* dest, const Vector3& billboardScale);
+    /// Write vertices of sorted billboards in range [beginIndex, endIndex) for FC_AXIS_ANGLE mode.
+    void BuildAxisAngleVertexBuffer(unsigned beginIndex, unsigned endIndex, float* dest, const Vector3& billboardScale);
     /// Return currently requested format of vertex buffer.
     unsigned GetVertexBufferFormat() const;
     /// Calculate billboard scale factors in fixed screen size mode.
@@ -234,6 +236,12 @@ private:
     Vector3 previousOffset_;
     /// Billboard pointers for sorting.
     ea::vector<Billboard*> sortedBillboards_;
+    /// Billboard pointers before sorting.
+    ea::vector<Billboard*> unsortedBillboards_;
+    /// Sort keys of billboards: inverted distance bits and index in sortedBillboards_.
+    ea::vector<ea::pair<unsigned, unsigned>> sortKeys_;
+    /// Temporary buffer for radix sort.
+    ea::vector<ea::pair<unsigned, unsigned>> sortBuffer_;
 };
 
 }
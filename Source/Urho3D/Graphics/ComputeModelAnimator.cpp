@@ -0,0 +1,447 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Graphics/ComputeModelAnimator.h"
+
+#include "../Core/Context.h"
+#include "../Graphics/Geometry.h"
+#include "../Graphics/Graphics.h"
+#include "../Graphics/VertexBuffer.h"
+#include "../IO/Log.h"
+#include "../RenderAPI/DrawCommandQueue.h"
+#include "../RenderAPI/PipelineState.h"
+#include "../RenderAPI/RenderContext.h"
+#include "../RenderAPI/RenderDevice.h"
+#include "../RenderAPI/RenderScope.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Layouts shall match C_AnimateVertices shader.
+/// @{
+const unsigned SourceVertexStride = 17;
+const unsigned MorphDeltaStride = 10;
+const unsigned BoneStride = 12;
+/// @}
+
+/// Create buffer of 32-bit words that can be bound as unordered access view.
+SharedPtr<VertexBuffer> CreateStorageBuffer(Context* context, const ea::string& debugName, const ea::vector<unsigned>& data)
+{
+    static const ea::vector<VertexElement> elements{VertexElement{TYPE_INT, SEM_TEXCOORD}};
+
+    auto buffer = MakeShared<VertexBuffer>(context);
+    buffer->SetDebugName(debugName);
+    buffer->SetUnorderedAccess(true);
+    if (!buffer->SetSize(data.size(), elements))
+        return nullptr;
+    buffer->Update(data.data());
+    return buffer;
+}
+
+void StoreFloats(unsigned* dest, const unsigned char* src, unsigned count)
+{
+    memcpy(dest, src, count * sizeof(float));
+}
+
+}
+
+ComputeModelAnimator::ComputeModelAnimator(Context* context) : Object(context) {}
+
+ComputeModelAnimator::~ComputeModelAnimator() {}
+
+void ComputeModelAnimator::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<ComputeModelAnimator>();
+}
+
+bool ComputeModelAnimator::IsSupported(Context* context)
+{
+    auto renderDevice = context->GetSubsystem<RenderDevice>();
+    return renderDevice && renderDevice->GetCaps().computeShaders_;
+}
+
+bool ComputeModelAnimator::Initialize(Model* model, bool skinned)
+{
+    originalModel_ = model;
+    numBones_ = skinned ? model->GetSkeleton().GetNumBones() : 0;
+    skinned_ = numBones_ > 0;
+
+    vertexBuffers_.clear();
+    geometries_.clear();
+    buffersData_.clear();
+
+    if (!IsSupported(context_) || !CloneModelGeometries())
+        return false;
+
+    const unsigned numMorphs = originalModel_->GetNumMorphs();
+    animationData_.resize(ea::max(1u, numBones_ * BoneStride + numMorphs));
+
+    animationBuffer_ = MakeShared<VertexBuffer>(context_);
+    animationBuffer_->SetDebugName(Format("{}: Animation Data", model->GetName()));
+    animationBuffer_->SetUnorderedAccess(true);
+    if (!animationBuffer_->SetSize(animationData_.size(), {VertexElement{TYPE_FLOAT, SEM_TEXCOORD}}))
+        return false;
+
+    return true;
+}
+
+void ComputeModelAnimator::Update(ea::span<const ModelMorph> morphs, ea::span<const Matrix3x4> skinMatrices)
+{
+    if (!animationBuffer_)
+        return;
+
+    // Upload all animation data at once, then every buffer is processed by single dispatch
+    const unsigned numBones = ea::min<unsigned>(numBones_, skinMatrices.size());
+    for (unsigned i = 0; i < numBones; ++i)
+        memcpy(&animationData_[i * BoneStride], skinMatrices[i].Data(), BoneStride * sizeof(float));
+
+    const unsigned morphWeightsOffset = numBones_ * BoneStride;
+    const unsigned numMorphs = ea::min<unsigned>(morphs.size(), animationData_.size() - morphWeightsOffset);
+    for (unsigned i = 0; i < numMorphs; ++i)
+        animationData_[morphWeightsOffset + i] = morphs[i].weight_;
+
+    animationBuffer_->Update(animationData_.data());
+
+    auto renderDevice = GetSubsystem<RenderDevice>();
+    RenderContext* renderContext = renderDevice->GetRenderContext();
+    DrawCommandQueue* drawQueue = renderDevice->GetDefaultQueue();
+
+    const RenderScope renderScope(renderContext, "ComputeModelAnimator::Update");
+
+    drawQueue->Reset();
+    for (unsigned i = 0; i < buffersData_.size(); ++i)
+    {
+        const AnimatedBufferData& data = buffersData_[i];
+        if (!data.pipelineState_)
+            continue;
+
+        drawQueue->SetPipelineState(data.pipelineState_);
+
+        if (drawQueue->BeginShaderParameterGroup(SP_OBJECT, true))
+        {
+            drawQueue->AddShaderParameter("NumVertices", static_cast<int>(data.numVertices_));
+            drawQueue->AddShaderParameter("OutputStride", data.outputStride_);
+            drawQueue->AddShaderParameter("NormalOffset", data.normalOffset_);
+            drawQueue->AddShaderParameter("TangentOffset", data.tangentOffset_);
+            drawQueue->AddShaderParameter("MorphWeightsOffset", static_cast<int>(morphWeightsOffset));
+            drawQueue->CommitShaderParameterGroup(SP_OBJECT);
+        }
+
+        drawQueue->AddUnorderedAccessView("SourceVertices", data.sourceBuffer_);
+        drawQueue->AddUnorderedAccessView("AnimationData", animationBuffer_);
+        if (data.morphBuffer_)
+            drawQueue->AddUnorderedAccessView("MorphDeltas", data.morphBuffer_);
+        drawQueue->AddUnorderedAccessView("OutputVertices", vertexBuffers_[i]);
+        drawQueue->CommitUnorderedAccessViews();
+
+        drawQueue->Dispatch({static_cast<int>((data.numVertices_ + GroupSize - 1) / GroupSize), 1, 1});
+    }
+
+    renderContext->ResetRenderTargets();
+    renderContext->Execute(drawQueue);
+}
+
+VertexMaskFlags ComputeModelAnimator::GetMorphElementMask() const
+{
+    if (skinned_)
+        return MASK_POSITION | MASK_NORMAL | MASK_TANGENT;
+
+    VertexMaskFlags morphElementMask = MASK_NONE;
+    for (const ModelMorph& morph : originalModel_->GetMorphs())
+    {
+        for (const auto& morphedBuffer : morph.buffers_)
+            morphElementMask |= morphedBuffer.second.elementMask_;
+    }
+    return morphElementMask | MASK_POSITION;
+}
+
+bool ComputeModelAnimator::CloneModelGeometries()
+{
+    ea::unordered_map<VertexBuffer*, SharedPtr<VertexBuffer>> originalToOutputMapping;
+    const VertexMaskFlags morphElementMask = GetMorphElementMask();
+
+    const auto& originalVertexBuffers = originalModel_->GetVertexBuffers();
+    vertexBuffers_.resize(originalVertexBuffers.size());
+    buffersData_.resize(originalVertexBuffers.size());
+
+    for (unsigned i = 0; i < originalVertexBuffers.size(); ++i)
+    {
+        // Skip buffer if not needed
+        if (!skinned_ && !originalModel_->GetMorphRangeCount(i))
+            continue;
+
+        // Source vertices are packed on CPU, shadow data is required
+        VertexBuffer* originalVertexBuffer = originalVertexBuffers[i];
+        if (!originalVertexBuffer->GetShadowData())
+        {
+            URHO3D_LOGERROR("Vertex buffer must be shadowed for compute skinning and morphing");
+            return false;
+        }
+
+        const VertexMaskFlags outputBufferMask = morphElementMask & originalVertexBuffer->GetElementMask();
+        if (!(outputBufferMask & MASK_POSITION))
+            continue;
+
+        if (originalVertexBuffer->GetElementOffset(SEM_POSITION) != 0
+            || ((outputBufferMask & MASK_NORMAL) && !originalVertexBuffer->HasElement(TYPE_VECTOR3, SEM_NORMAL))
+            || ((outputBufferMask & MASK_TANGENT) && !originalVertexBuffer->HasElement(TYPE_VECTOR4, SEM_TANGENT)))
+        {
+            URHO3D_LOGERROR("Vertex format is not supported for compute skinning and morphing");
+            return false;
+        }
+
+        auto outputVertexBuffer = MakeShared<VertexBuffer>(context_);
+        outputVertexBuffer->SetDebugName(Format("{}: Animated Output", originalVertexBuffer->GetDebugName()));
+        outputVertexBuffer->SetUnorderedAccess(true);
+        if (!outputVertexBuffer->SetSize(originalVertexBuffer->GetVertexCount(), outputBufferMask))
+            return false;
+
+        vertexBuffers_[i] = outputVertexBuffer;
+        originalToOutputMapping[originalVertexBuffer] = outputVertexBuffer;
+
+        if (!InitializeBufferData(i))
+            return false;
+    }
+
+    // Clone geometries
+    geometries_ = originalModel_->GetGeometries();
+    for (auto& geometryLods : geometries_)
+    {
+        for (SharedPtr<Geometry>& geometry : geometryLods)
+        {
+            SharedPtr<Geometry> originalGeometry = geometry;
+            SharedPtr<Geometry> cloneGeometry = MakeShared<Geometry>(context_);
+
+            // Append vertex buffers with animated data
+            // Note: array grows inside loop
+            ea::vector<SharedPtr<VertexBuffer>> vertexBuffers = originalGeometry->GetVertexBuffers();
+            const unsigned numVertexBuffers = vertexBuffers.size();
+            for (unsigned i = 0; i < numVertexBuffers; ++i)
+            {
+                const auto outputBufferIter = originalToOutputMapping.find(vertexBuffers[i]);
+                if (outputBufferIter != originalToOutputMapping.end())
+                    vertexBuffers.push_back(outputBufferIter->second);
+            }
+
+            cloneGeometry->SetIndexBuffer(originalGeometry->GetIndexBuffer());
+            cloneGeometry->SetVertexBuffers(vertexBuffers);
+            cloneGeometry->SetDrawRange(originalGeometry->GetPrimitiveType(),
+                originalGeometry->GetIndexStart(), originalGeometry->GetIndexCount());
+            cloneGeometry->SetLodDistance(originalGeometry->GetLodDistance());
+
+            geometry = cloneGeometry;
+        }
+    }
+
+    return true;
+}
+
+bool ComputeModelAnimator::InitializeBufferData(unsigned bufferIndex)
+{
+    VertexBuffer* originalBuffer = originalModel_->GetVertexBuffers()[bufferIndex];
+    VertexBuffer* outputBuffer = vertexBuffers_[bufferIndex];
+    AnimatedBufferData& data = buffersData_[bufferIndex];
+
+    const unsigned numVertices = originalBuffer->GetVertexCount();
+    const unsigned vertexSize = originalBuffer->GetVertexSize();
+    const unsigned char* originalData = originalBuffer->GetShadowData();
+
+    data.numVertices_ = numVertices;
+    data.outputStride_ = static_cast<int>(outputBuffer->GetVertexSize() / sizeof(float));
+    if (outputBuffer->HasElement(SEM_NORMAL))
+        data.normalOffset_ = static_cast<int>(outputBuffer->GetElementOffset(SEM_NORMAL) / sizeof(float));
+    if (outputBuffer->HasElement(SEM_TANGENT))
+        data.tangentOffset_ = static_cast<int>(outputBuffer->GetElementOffset(SEM_TANGENT) / sizeof(float));
+
+    const unsigned normalOffset = originalBuffer->GetElementOffset(TYPE_VECTOR3, SEM_NORMAL);
+    const unsigned tangentOffset = originalBuffer->GetElementOffset(TYPE_VECTOR4, SEM_TANGENT);
+    const unsigned indicesOffset = originalBuffer->GetElementOffset(TYPE_UBYTE4, SEM_BLENDINDICES);
+    const unsigned vector4WeightsOffset = originalBuffer->GetElementOffset(TYPE_VECTOR4, SEM_BLENDWEIGHTS);
+    const unsigned ubyte4WeightsOffset = originalBuffer->GetElementOffset(TYPE_UBYTE4_NORM, SEM_BLENDWEIGHTS);
+    const bool skinned = skinned_ && indicesOffset != M_MAX_UNSIGNED
+        && (vector4WeightsOffset != M_MAX_UNSIGNED || ubyte4WeightsOffset != M_MAX_UNSIGNED);
+
+    // Group morph deltas by vertex so each thread can apply all morphs of its vertex
+    ea::vector<unsigned> morphCounts(numVertices);
+    unsigned numMorphDeltas = 0;
+    for (const ModelMorph& morph : originalModel_->GetMorphs())
+    {
+        const auto iter = morph.buffers_.find(bufferIndex);
+        if (iter == morph.buffers_.end())
+            continue;
+
+        const VertexBufferMorph& bufferMorph = iter->second;
+        const VertexMaskFlags morphedElements = bufferMorph.elementMask_ & (MASK_POSITION | MASK_NORMAL | MASK_TANGENT);
+        const unsigned deltaSize = sizeof(unsigned) + CountSetBits(morphedElements.AsInteger()) * 3 * sizeof(float);
+        const unsigned char* morphData = bufferMorph.morphData_.get();
+        for (unsigned i = 0; i < bufferMorph.vertexCount_; ++i)
+        {
+            const unsigned vertexIndex = *reinterpret_cast<const unsigned*>(morphData + i * deltaSize);
+            if (vertexIndex < numVertices)
+            {
+                ++morphCounts[vertexIndex];
+                ++numMorphDeltas;
+            }
+        }
+    }
+
+    ea::vector<unsigned> morphStarts(numVertices);
+    for (unsigned i = 1; i < numVertices; ++i)
+        morphStarts[i] = morphStarts[i - 1] + morphCounts[i - 1];
+
+    // Pack source vertices
+    ea::vector<unsigned> sourceData(numVertices * SourceVertexStride);
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        const unsigned char* src = originalData + i * vertexSize;
+        unsigned* dest = &sourceData[i * SourceVertexStride];
+
+        StoreFloats(dest, src, 3);
+        if (normalOffset != M_MAX_UNSIGNED)
+            StoreFloats(dest + 3, src + normalOffset, 3);
+        if (tangentOffset != M_MAX_UNSIGNED)
+            StoreFloats(dest + 6, src + tangentOffset, 4);
+
+        if (skinned)
+        {
+            if (vector4WeightsOffset != M_MAX_UNSIGNED)
+                StoreFloats(dest + 10, src + vector4WeightsOffset, MaxBones);
+            else
+            {
+                for (unsigned j = 0; j < MaxBones; ++j)
+                {
+                    const float weight = src[ubyte4WeightsOffset + j] / 255.0f;
+                    memcpy(dest + 10 + j, &weight, sizeof(float));
+                }
+            }
+            memcpy(dest + 14, src + indicesOffset, sizeof(unsigned));
+        }
+
+        dest[15] = morphStarts[i];
+        dest[16] = morphCounts[i];
+    }
+
+    data.sourceBuffer_ = CreateStorageBuffer(
+        context_, Format("{}: Animation Source", originalBuffer->GetDebugName()), sourceData);
+    if (!data.sourceBuffer_)
+        return false;
+
+    // Pack morph deltas
+    if (numMorphDeltas > 0)
+    {
+        ea::vector<unsigned> morphData(numMorphDeltas * MorphDeltaStride);
+        ea::vector<unsigned> morphOffsets = morphStarts;
+
+        const auto& morphs = originalModel_->GetMorphs();
+        for (unsigned morphIndex = 0; morphIndex < morphs.size(); ++morphIndex)
+        {
+            const auto iter = morphs[morphIndex].buffers_.find(bufferIndex);
+            if (iter == morphs[morphIndex].buffers_.end())
+                continue;
+
+            const VertexBufferMorph& bufferMorph = iter->second;
+            const unsigned char* src = bufferMorph.morphData_.get();
+            for (unsigned i = 0; i < bufferMorph.vertexCount_; ++i)
+            {
+                const unsigned vertexIndex = *reinterpret_cast<const unsigned*>(src);
+                src += sizeof(unsigned);
+
+                unsigned* dest = vertexIndex < numVertices
+                    ? &morphData[(morphOffsets[vertexIndex]++) * MorphDeltaStride] : nullptr;
+                if (dest)
+                    dest[0] = morphIndex;
+
+                unsigned elementIndex = 0;
+                for (const VertexMaskFlags element : {MASK_POSITION, MASK_NORMAL, MASK_TANGENT})
+                {
+                    if (bufferMorph.elementMask_ & element)
+                    {
+                        if (dest)
+                            StoreFloats(dest + 1 + elementIndex * 3, src, 3);
+                        src += 3 * sizeof(float);
+                    }
+                    ++elementIndex;
+                }
+            }
+        }
+
+        data.morphBuffer_ = CreateStorageBuffer(
+            context_, Format("{}: Animation Morphs", originalBuffer->GetDebugName()), morphData);
+        if (!data.morphBuffer_)
+            return false;
+    }
+
+    // Initialize output with bind pose so the buffer is valid before the first update
+    ea::vector<float> outputData(numVertices * data.outputStride_);
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        const unsigned* src = &sourceData[i * SourceVertexStride];
+        float* dest = &outputData[i * data.outputStride_];
+        memcpy(dest, src, 3 * sizeof(float));
+        if (data.normalOffset_ >= 0)
+            memcpy(dest + data.normalOffset_, src + 3, 3 * sizeof(float));
+        if (data.tangentOffset_ >= 0)
+            memcpy(dest + data.tangentOffset_, src + 6, 4 * sizeof(float));
+    }
+    outputBuffer->Update(outputData.data());
+
+    return InitializePipelineState(bufferIndex, skinned, numMorphDeltas > 0);
+}
+
+bool ComputeModelAnimator::InitializePipelineState(unsigned bufferIndex, bool skinned, bool morphed)
+{
+    AnimatedBufferData& data = buffersData_[bufferIndex];
+    if (!skinned && !morphed)
+        return true;
+
+    auto graphics = GetSubsystem<Graphics>();
+    auto pipelineStateCache = GetSubsystem<PipelineStateCache>();
+
+    ea::string shaderDefines;
+    if (skinned)
+        shaderDefines += "URHO3D_SKINNED ";
+    if (morphed)
+        shaderDefines += "URHO3D_MORPHED ";
+
+    ComputePipelineStateDesc desc;
+    desc.debugName_ = Format("C_AnimateVertices: {}", shaderDefines);
+    desc.computeShader_ = graphics->GetShader(CS, "v2/C_AnimateVertices", shaderDefines);
+
+    data.pipelineState_ = pipelineStateCache->GetComputePipelineState(desc);
+    if (!data.pipelineState_->IsValid())
+    {
+        URHO3D_LOGERROR("ComputeModelAnimator failed to create pipeline state");
+        data.pipelineState_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+}
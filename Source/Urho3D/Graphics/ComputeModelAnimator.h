@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Graphics/Model.h"
+
+#include <EASTL/span.h>
+
+namespace Urho3D
+{
+
+class PipelineState;
+
+/// Class for model animation (morphing and skinning) on GPU by compute shader.
+/// Each vertex buffer is morphed and skinned once per update into the output vertex buffer,
+/// which is then used as is by all passes and shadow splits.
+class URHO3D_API ComputeModelAnimator : public Object
+{
+    URHO3D_OBJECT(ComputeModelAnimator, Object);
+
+public:
+    /// Max number of bones affecting a vertex.
+    static const unsigned MaxBones = 4;
+    /// Number of threads in compute shader group.
+    static const unsigned GroupSize = 64;
+
+    /// Construct.
+    explicit ComputeModelAnimator(Context* context);
+    /// Destruct.
+    ~ComputeModelAnimator() override;
+    /// Register object factory.
+    static void RegisterObject(Context* context);
+
+    /// Return whether compute animation is supported by current render device.
+    static bool IsSupported(Context* context);
+
+    /// Initialize with model. Shall be manually called on model reload.
+    /// Return false if compute animation cannot be used for this model.
+    bool Initialize(Model* model, bool skinned);
+    /// Apply morphs and skinning on GPU. Skin matrices are ignored if the model is not skinned.
+    void Update(ea::span<const ModelMorph> morphs, ea::span<const Matrix3x4> skinMatrices);
+
+    /// Return animated geometries.
+    const ea::vector<ea::vector<SharedPtr<Geometry>>>& GetGeometries() const { return geometries_; }
+    /// Return all output vertex buffers.
+    const ea::vector<SharedPtr<VertexBuffer>>& GetVertexBuffers() const { return vertexBuffers_; }
+
+private:
+    /// GPU data of animated vertex buffer.
+    struct AnimatedBufferData
+    {
+        /// Packed bind pose, skin weights and morph ranges of vertices.
+        SharedPtr<VertexBuffer> sourceBuffer_;
+        /// Packed morph deltas grouped by vertex.
+        SharedPtr<VertexBuffer> morphBuffer_;
+        /// Pipeline state of the compute shader.
+        SharedPtr<PipelineState> pipelineState_;
+
+        unsigned numVertices_{};
+        /// Output vertex size, normal and tangent offsets in 32-bit words. Offsets are negative if not present.
+        int outputStride_{};
+        int normalOffset_{-1};
+        int tangentOffset_{-1};
+    };
+
+    /// Return morph mask.
+    VertexMaskFlags GetMorphElementMask() const;
+    /// Create output buffers and clone model geometries.
+    bool CloneModelGeometries();
+    /// Create source and morph buffers for vertex buffer.
+    bool InitializeBufferData(unsigned bufferIndex);
+    /// Create pipeline state for vertex buffer.
+    bool InitializePipelineState(unsigned bufferIndex, bool skinned, bool morphed);
+
+    /// Original model.
+    SharedPtr<Model> originalModel_;
+    /// Output vertex buffers.
+    ea::vector<SharedPtr<VertexBuffer>> vertexBuffers_;
+    /// Animated model geometries.
+    ea::vector<ea::vector<SharedPtr<Geometry>>> geometries_;
+    /// GPU data for vertex buffers.
+    ea::vector<AnimatedBufferData> buffersData_;
+
+    /// Whether skinning is applied.
+    bool skinned_{};
+    /// Number of bones in the skeleton.
+    unsigned numBones_{};
+    /// Bone matrices followed by morph weights, updated every frame.
+    SharedPtr<VertexBuffer> animationBuffer_;
+    /// Temporary data for animation buffer.
+    ea::vector<float> animationData_;
+};
+
+}
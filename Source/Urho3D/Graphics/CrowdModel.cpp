@@ -0,0 +1,358 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Graphics/CrowdModel.h"
+
+#include "../Core/Context.h"
+#include "../Graphics/Camera.h"
+#include "../Graphics/Model.h"
+#include "../Graphics/OctreeQuery.h"
+#include "../IO/Log.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
+#include "../Utility/VertexAnimationMetadata.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+static const StringVector instancesStructureElementNames = {
+    "Instance Count",
+    "   Position",
+    "   Rotation",
+    "   Scale",
+    "   Animation",
+    "   Time",
+    "   Speed",
+};
+
+/// Number of variants per instance in the attribute.
+static const unsigned NumInstanceAttrElements = 6;
+
+}
+
+CrowdModel::CrowdModel(Context* context)
+    : StaticModel(context)
+{
+}
+
+CrowdModel::~CrowdModel() = default;
+
+void CrowdModel::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<CrowdModel>(Category_Geometry);
+
+    URHO3D_COPY_BASE_ATTRIBUTES(StaticModel);
+    URHO3D_ACCESSOR_ATTRIBUTE("Instances", GetInstancesAttr, SetInstancesAttr,
+        VariantVector, Variant::emptyVariantVector, AM_DEFAULT)
+        .SetMetadata(AttributeMetadata::VectorStructElements, instancesStructureElementNames);
+}
+
+void CrowdModel::ProcessRayQuery(const RayOctreeQuery& query, ea::vector<RayQueryResult>& results)
+{
+    RayQueryLevel level = query.level_;
+    if (level < RAY_AABB)
+    {
+        Drawable::ProcessRayQuery(query, results);
+        return;
+    }
+
+    // GetWorldBoundingBox() updates the world transforms
+    if (query.ray_.HitDistance(GetWorldBoundingBox()) >= query.maxDistance_)
+        return;
+
+    // Geometry is in bind pose, so hit instances are tested against bounding boxes only
+    for (unsigned i = 0; i < worldTransforms_.size(); ++i)
+    {
+        const auto distanceAndNormal = query.ray_.HitDistanceAndNormal(boundingBox_.Transformed(worldTransforms_[i]));
+        float distance = distanceAndNormal.distance_;
+        if (level >= RAY_OBB && distance < query.maxDistance_)
+        {
+            const Ray localRay = query.ray_.Transformed(worldTransforms_[i].Inverse());
+            distance = localRay.HitDistance(boundingBox_);
+        }
+
+        if (distance < query.maxDistance_)
+        {
+            RayQueryResult result;
+            result.position_ = query.ray_.origin_ + distance * query.ray_.direction_;
+            result.normal_ = distanceAndNormal.normal_;
+            result.distance_ = distance;
+            result.drawable_ = this;
+            result.node_ = node_;
+            result.subObject_ = i;
+            results.push_back(result);
+        }
+    }
+}
+
+void CrowdModel::Update(const FrameInfo& frame)
+{
+    for (unsigned i = 0; i < instances_.size(); ++i)
+    {
+        const CrowdModelInstance& instance = instances_[i];
+        if (instance.animation_ >= animations_.size() || animations_[instance.animation_].numFrames_ == 0)
+        {
+            instanceData_[i] = Vector4::ZERO;
+            continue;
+        }
+
+        const AnimationClip& clip = animations_[instance.animation_];
+        const float frameTime = AbsMod(instance.time_ * frameRate_, static_cast<float>(clip.numFrames_));
+        const unsigned frameIndex = ea::min(static_cast<unsigned>(frameTime), clip.numFrames_ - 1);
+        const unsigned nextFrameIndex = (frameIndex + 1) % clip.numFrames_;
+        const float blendFactor = frameTime - static_cast<float>(frameIndex);
+
+        instanceData_[i] = Vector4(static_cast<float>(clip.firstFrame_ + frameIndex),
+            static_cast<float>(clip.firstFrame_ + nextFrameIndex), blendFactor, 0.0f);
+    }
+}
+
+void CrowdModel::UpdateBatches(const FrameInfo& frame)
+{
+    // Getting the world bounding box ensures the transforms are updated
+    const BoundingBox& worldBoundingBox = GetWorldBoundingBox();
+    const Matrix3x4& worldTransform = node_->GetWorldTransform();
+    distance_ = frame.camera_->GetDistance(worldBoundingBox.Center());
+
+    const unsigned numInstances = worldTransforms_.size();
+    for (unsigned i = 0; i < batches_.size(); ++i)
+    {
+        SourceBatch& batch = batches_[i];
+        batch.distance_ = batches_.size() > 1
+            ? frame.camera_->GetDistance(worldTransform * geometryData_[i].center_)
+            : distance_;
+        batch.worldTransform_ = numInstances ? worldTransforms_.data() : &Matrix3x4::IDENTITY;
+        batch.numWorldTransforms_ = numInstances;
+        batch.instancingData_ = numInstances ? instanceData_.data() : nullptr;
+    }
+
+    const float scale = worldBoundingBox.Size().DotProduct(DOT_SCALE);
+    const float newLodDistance = frame.camera_->GetLodDistance(distance_, scale, lodBias_);
+    if (newLodDistance != lodDistance_)
+    {
+        lodDistance_ = newLodDistance;
+        CalculateLodLevels();
+    }
+
+    ReportLodLevels();
+}
+
+void CrowdModel::SetModel(Model* model)
+{
+    StaticModel::SetModel(model);
+
+    animations_.clear();
+    frameRate_ = 0.0f;
+    if (!model_)
+        return;
+
+    const StringVector& names = model_->GetMetadata(VertexAnimationMetadata::Animations).GetStringVector();
+    const VariantVector& frames = model_->GetMetadata(VertexAnimationMetadata::AnimationFrames).GetVariantVector();
+    if (names.size() != frames.size())
+    {
+        URHO3D_LOGWARNING("Model '{}' has no valid vertex animation metadata", model_->GetName());
+        return;
+    }
+
+    frameRate_ = model_->GetMetadata(VertexAnimationMetadata::FrameRate).GetFloat();
+    for (unsigned i = 0; i < names.size(); ++i)
+    {
+        const IntVector2 range = frames[i].GetIntVector2();
+        animations_.push_back(
+            AnimationClip{names[i], static_cast<unsigned>(ea::max(range.x_, 0)), static_cast<unsigned>(ea::max(range.y_, 0))});
+    }
+
+    MarkForUpdate();
+}
+
+unsigned CrowdModel::AddInstance(const Transform& transform, unsigned animation, float time)
+{
+    instances_.push_back(CrowdModelInstance{transform, animation, time});
+    UpdateNumInstances();
+    return instances_.size() - 1;
+}
+
+void CrowdModel::RemoveAllInstances()
+{
+    instances_.clear();
+    UpdateNumInstances();
+}
+
+void CrowdModel::SetInstanceTransform(unsigned index, const Transform& transform)
+{
+    if (index >= instances_.size())
+    {
+        URHO3D_LOGERROR("Invalid crowd instance index {}", index);
+        return;
+    }
+
+    instances_[index].transform_ = transform;
+    OnMarkedDirty(node_);
+}
+
+void CrowdModel::SetInstanceAnimation(unsigned index, unsigned animation, float time)
+{
+    if (index >= instances_.size())
+    {
+        URHO3D_LOGERROR("Invalid crowd instance index {}", index);
+        return;
+    }
+
+    instances_[index].animation_ = animation;
+    instances_[index].time_ = time;
+    MarkForUpdate();
+}
+
+void CrowdModel::SetInstanceSpeed(unsigned index, float speed)
+{
+    if (index >= instances_.size())
+    {
+        URHO3D_LOGERROR("Invalid crowd instance index {}", index);
+        return;
+    }
+
+    instances_[index].speed_ = speed;
+}
+
+unsigned CrowdModel::FindAnimation(const ea::string& name) const
+{
+    for (unsigned i = 0; i < animations_.size(); ++i)
+    {
+        if (animations_[i].name_ == name)
+            return i;
+    }
+    return M_MAX_UNSIGNED;
+}
+
+float CrowdModel::GetAnimationLength(unsigned index) const
+{
+    if (index >= animations_.size() || frameRate_ <= 0.0f)
+        return 0.0f;
+    return animations_[index].numFrames_ / frameRate_;
+}
+
+void CrowdModel::SetInstancesAttr(const VariantVector& value)
+{
+    instances_.clear();
+
+    unsigned index = 0;
+    unsigned numInstances = index < value.size() ? value[index++].GetUInt() : 0;
+    // Prevent crash on entering negative value in the editor
+    if (numInstances > M_MAX_INT)
+        numInstances = 0;
+
+    instances_.resize(numInstances);
+    for (CrowdModelInstance& instance : instances_)
+    {
+        if (index + NumInstanceAttrElements > value.size())
+            break;
+
+        instance.transform_.position_ = value[index++].GetVector3();
+        instance.transform_.rotation_ = value[index++].GetQuaternion();
+        instance.transform_.scale_ = value[index++].GetVector3();
+        instance.animation_ = value[index++].GetUInt();
+        instance.time_ = value[index++].GetFloat();
+        instance.speed_ = value[index++].GetFloat();
+    }
+
+    UpdateNumInstances();
+}
+
+VariantVector CrowdModel::GetInstancesAttr() const
+{
+    VariantVector result;
+    result.reserve(1 + instances_.size() * NumInstanceAttrElements);
+    result.push_back(instances_.size());
+    for (const CrowdModelInstance& instance : instances_)
+    {
+        result.push_back(instance.transform_.position_);
+        result.push_back(instance.transform_.rotation_);
+        result.push_back(instance.transform_.scale_);
+        result.push_back(instance.animation_);
+        result.push_back(instance.time_);
+        result.push_back(instance.speed_);
+    }
+    return result;
+}
+
+void CrowdModel::OnSceneSet(Scene* scene)
+{
+    StaticModel::OnSceneSet(scene);
+
+    if (scene)
+        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, &CrowdModel::HandleScenePostUpdate);
+    else
+        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+}
+
+void CrowdModel::OnWorldBoundingBoxUpdate()
+{
+    const Matrix3x4& nodeTransform = node_->GetWorldTransform();
+    BoundingBox worldBox;
+
+    // Transforms are resized only in the main thread, so this function may be called from multiple threads
+    for (unsigned i = 0; i < instances_.size(); ++i)
+    {
+        worldTransforms_[i] = nodeTransform * instances_[i].transform_.ToMatrix3x4();
+        worldBox.Merge(boundingBox_.Transformed(worldTransforms_[i]));
+    }
+
+    worldBoundingBox_ = worldBox;
+}
+
+void CrowdModel::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+{
+    using namespace ScenePostUpdate;
+
+    if (instances_.empty() || animations_.empty())
+        return;
+
+    const float timeStep = eventData[P_TIMESTEP].GetFloat();
+    for (CrowdModelInstance& instance : instances_)
+    {
+        // Keep time in range to avoid loss of precision
+        const float length = GetAnimationLength(instance.animation_);
+        instance.time_ += timeStep * instance.speed_;
+        if (length > 0.0f)
+            instance.time_ = AbsMod(instance.time_, length);
+    }
+
+    MarkForUpdate();
+}
+
+void CrowdModel::UpdateNumInstances()
+{
+    worldTransforms_.resize(instances_.size());
+    instanceData_.resize(instances_.size());
+
+    OnMarkedDirty(node_);
+    MarkForUpdate();
+}
+
+}
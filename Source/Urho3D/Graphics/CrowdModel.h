@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Graphics/StaticModel.h"
+#include "../Math/Transform.h"
+
+namespace Urho3D
+{
+
+/// Instance of CrowdModel.
+struct CrowdModelInstance
+{
+    /// Transform relative to the node.
+    Transform transform_;
+    /// Index of vertex animation.
+    unsigned animation_{};
+    /// Time of vertex animation in seconds.
+    float time_{};
+    /// Speed of vertex animation.
+    float speed_{1.0f};
+};
+
+/// Renders many instances of the model animated by vertex animation texture in a few instanced draw calls.
+/// Model and materials should be produced by VertexAnimationBaker. Animation of each instance is resolved on the CPU
+/// into a pair of baked frames passed to shaders as custom instance data, so skeletons are not evaluated at all.
+/// Instances are culled and receive light as one unit.
+class URHO3D_API CrowdModel : public StaticModel
+{
+    URHO3D_OBJECT(CrowdModel, StaticModel);
+
+public:
+    /// Construct.
+    explicit CrowdModel(Context* context);
+    /// Destruct.
+    ~CrowdModel() override;
+    /// Register object factory. StaticModel must be registered first.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Process octree raycast. May be called from a worker thread.
+    void ProcessRayQuery(const RayOctreeQuery& query, ea::vector<RayQueryResult>& results) override;
+    /// Update animation frames of instances. Called from a worker thread.
+    void Update(const FrameInfo& frame) override;
+    /// Calculate distance and prepare batches for rendering. May be called from worker thread(s), possibly re-entrantly.
+    void UpdateBatches(const FrameInfo& frame) override;
+    /// Return number of occlusion geometry triangles. Animated instances are never occluders.
+    unsigned GetNumOccluderTriangles() override { return 0; }
+
+    /// Set model. Baked animations are read from the model metadata.
+    void SetModel(Model* model) override;
+
+    /// Add instance. Return instance index.
+    unsigned AddInstance(const Transform& transform, unsigned animation = 0, float time = 0.0f);
+    /// Remove all instances.
+    void RemoveAllInstances();
+    /// Set transform of the instance relative to the node.
+    void SetInstanceTransform(unsigned index, const Transform& transform);
+    /// Set animation of the instance and time in it.
+    void SetInstanceAnimation(unsigned index, unsigned animation, float time = 0.0f);
+    /// Set animation speed of the instance.
+    void SetInstanceSpeed(unsigned index, float speed);
+
+    /// Return number of instances.
+    /// @property
+    unsigned GetNumInstances() const { return instances_.size(); }
+    /// Return instance by index.
+    const CrowdModelInstance& GetInstance(unsigned index) const { return instances_[index]; }
+    /// Return number of baked animations.
+    /// @property
+    unsigned GetNumAnimations() const { return animations_.size(); }
+    /// Return index of baked animation by name, M_MAX_UNSIGNED if not found.
+    unsigned FindAnimation(const ea::string& name) const;
+    /// Return length of baked animation in seconds.
+    float GetAnimationLength(unsigned index) const;
+
+    /// Set instances attribute.
+    void SetInstancesAttr(const VariantVector& value);
+    /// Return instances attribute.
+    VariantVector GetInstancesAttr() const;
+
+protected:
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+    /// Recalculate the world-space bounding box.
+    void OnWorldBoundingBoxUpdate() override;
+
+private:
+    /// Baked animation.
+    struct AnimationClip
+    {
+        ea::string name_;
+        unsigned firstFrame_{};
+        unsigned numFrames_{};
+    };
+
+    /// Handle scene post-update event.
+    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+    /// Resize transforms and instance data after instances are added or removed.
+    void UpdateNumInstances();
+
+    /// Baked animations.
+    ea::vector<AnimationClip> animations_;
+    /// Number of baked frames per second.
+    float frameRate_{};
+
+    /// Instances.
+    ea::vector<CrowdModelInstance> instances_;
+    /// World transforms of instances.
+    ea::vector<Matrix3x4> worldTransforms_;
+    /// Current frames of instances passed to shaders.
+    ea::vector<Vector4> instanceData_;
+};
+
+}
@@ -144,14 +144,22 @@ CubemapUpdateResult CubemapRenderer::Update(const CubemapUpdateParameters& param
         updateStage_ = CubemapUpdateStage::Idle;
         numFacesToUpdate_ = 0;
         numFacesToRender_ = 0;
+        nextFilterLevel_ = 0;
     }
 
+    if (updateStage_ == CubemapUpdateStage::FilterLevels)
+        return UpdateFilterLevel();
+
+    // Sliced update is not complete until filtered, wait for the last face to be rendered
+    if (updateStage_ == CubemapUpdateStage::Ready && params.slicedUpdate_ && params.filterResult_)
+        return {0, 0, false};
+
     URHO3D_ASSERT(updateStage_ != CubemapUpdateStage::Ready);
 
     if (params.overrideFinalTexture_ && !IsTextureMatching(params.overrideFinalTexture_, params.settings_))
     {
         URHO3D_ASSERTLOG(0, "Invalid texture is used as override for CubemapRenderer::Update");
-        return {MAX_CUBEMAP_FACES, true};
+        return {MAX_CUBEMAP_FACES, 0, true};
     }
 
     if (updateStage_ == CubemapUpdateStage::Idle)
@@ -230,7 +238,7 @@ CubemapUpdateResult CubemapRenderer::UpdateFull()
     for (unsigned face = 0; face < MAX_CUBEMAP_FACES; ++face)
         QueueFaceUpdate(static_cast<CubeMapFace>(face));
 
-    return {MAX_CUBEMAP_FACES, true};
+    return {MAX_CUBEMAP_FACES, 0, true};
 }
 
 CubemapUpdateResult CubemapRenderer::UpdateSliced()
@@ -255,8 +263,27 @@ CubemapUpdateResult CubemapRenderer::UpdateSliced()
         }
     }
 
-    const bool isComplete = updateStage_ == CubemapUpdateStage::Ready;
-    return {1, isComplete};
+    const bool isComplete = updateStage_ == CubemapUpdateStage::Ready && !currentParams_.filterResult_;
+    return {1, 0, isComplete};
+}
+
+CubemapUpdateResult CubemapRenderer::UpdateFilterLevel()
+{
+    if (!currentViewportTexture_ || !currentFilteredTexture_)
+    {
+        updateStage_ = CubemapUpdateStage::Idle;
+        return {0, 0, true};
+    }
+
+    FilterCubemap(currentViewportTexture_, currentFilteredTexture_, nextFilterLevel_, 1);
+    ++nextFilterLevel_;
+
+    if (nextFilterLevel_ < currentFilteredTexture_->GetLevels())
+        return {0, 1, false};
+
+    updateStage_ = CubemapUpdateStage::Idle;
+    ProcessCubemapFiltered();
+    return {0, 1, true};
 }
 
 void CubemapRenderer::ProcessFaceRendered()
@@ -279,9 +306,22 @@ void CubemapRenderer::ProcessCubemapRendered()
     if (currentViewportTexture_ != viewportTexture_)
         DisconnectViewportsFromTexture(currentViewportTexture_);
 
+    // Spread filtering of sliced update over next updates, one mip level at a time
+    if (currentFilteredTexture_ && currentParams_.slicedUpdate_)
+    {
+        updateStage_ = CubemapUpdateStage::FilterLevels;
+        nextFilterLevel_ = 0;
+        return;
+    }
+
     if (currentFilteredTexture_)
-        FilterCubemap(currentViewportTexture_, currentFilteredTexture_);
+        FilterCubemap(currentViewportTexture_, currentFilteredTexture_, 0, currentFilteredTexture_->GetLevels());
 
+    ProcessCubemapFiltered();
+}
+
+void CubemapRenderer::ProcessCubemapFiltered()
+{
     TextureCube* finalTexture = currentFilteredTexture_ ? currentFilteredTexture_ : currentViewportTexture_;
     OnCubemapRendered(this, finalTexture);
 
@@ -299,7 +339,8 @@ void CubemapRenderer::QueueFaceUpdate(CubeMapFace face)
     renderer->QueueRenderSurface(surface);
 }
 
-void CubemapRenderer::FilterCubemap(TextureCube* sourceTexture, TextureCube* destTexture)
+void CubemapRenderer::FilterCubemap(
+    TextureCube* sourceTexture, TextureCube* destTexture, unsigned firstLevel, unsigned numLevelsToFilter)
 {
     auto renderDevice = GetSubsystem<RenderDevice>();
     if (!renderDevice->GetCaps().computeShaders_)
@@ -318,12 +359,13 @@ void CubemapRenderer::FilterCubemap(TextureCube* sourceTexture, TextureCube* des
 
     const RenderScope renderScope(renderContext, "CubemapRenderer::FilterCubemap");
 
-    for (unsigned i = 0; i < numLevels; ++i)
+    const unsigned endLevel = ea::min(firstLevel + numLevelsToFilter, numLevels);
+    for (unsigned i = firstLevel; i < endLevel; ++i)
         destTexture->CreateUAV(RawTextureUAVKey{}.FromLevel(i));
 
     drawQueue->Reset();
 
-    for (unsigned i = 0; i < numLevels; ++i)
+    for (unsigned i = firstLevel; i < endLevel; ++i)
     {
         drawQueue->SetPipelineState(cachedPipelineStates_->pipelineStates_[i]);
 
@@ -356,7 +398,7 @@ void CubemapRenderer::EnsurePipelineStates(unsigned numLevels)
     for (unsigned i = 0; i < numLevels; ++i)
     {
         const auto levelWidth = static_cast<float>(1 << (numLevels - 1 - i));
-        const unsigned rayCount = rayCounts[ea::max<unsigned>(i, rayCounts.size() - 1)];
+        const unsigned rayCount = rayCounts[ea::min<unsigned>(i, rayCounts.size() - 1)];
 
         const ea::string shaderParams = Format("RAY_COUNT={}u FILTER_RES={}u FILTER_INV_RES={:.7f} ROUGHNESS={:.7f}",
             rayCount, levelWidth, 1.0f / levelWidth, roughStep * i);
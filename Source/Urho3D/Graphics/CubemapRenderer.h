@@ -46,12 +46,15 @@ enum class CubemapUpdateStage
 {
     Idle,
     RenderFaces,
-    Ready
+    Ready,
+    /// Sliced update only: filter one mip level of the result per update.
+    FilterLevels
 };
 
 struct CubemapUpdateResult
 {
     unsigned numRenderedFaces_{};
+    unsigned numFilteredLevels_{};
     bool isComplete_{};
 };
 
@@ -110,6 +113,9 @@ public:
 
     CubemapUpdateResult Update(const CubemapUpdateParameters& params);
 
+    /// Return whether the next update will filter the result instead of rendering.
+    bool IsFiltering() const { return updateStage_ == CubemapUpdateStage::FilterLevels; }
+
 private:
     struct CachedPipelineStates
     {
@@ -127,13 +133,15 @@ private:
     bool IsTextureMatching(TextureCube* textureCube, const CubemapRenderingSettings& settings) const;
     CubemapUpdateResult UpdateFull();
     CubemapUpdateResult UpdateSliced();
+    CubemapUpdateResult UpdateFilterLevel();
     void QueueFaceUpdate(CubeMapFace face);
 
     void ProcessFaceRendered();
     void ProcessCubemapRendered();
+    void ProcessCubemapFiltered();
 
     void EnsurePipelineStates(unsigned numLevels);
-    void FilterCubemap(TextureCube* sourceTexture, TextureCube* destTexture);
+    void FilterCubemap(TextureCube* sourceTexture, TextureCube* destTexture, unsigned firstLevel, unsigned numLevels);
 
     WeakPtr<Scene> scene_;
     ea::array<SharedPtr<Node>, MAX_CUBEMAP_FACES> renderCameras_;
@@ -146,6 +154,7 @@ private:
     CubemapUpdateStage updateStage_{};
     unsigned numFacesToUpdate_{};
     unsigned numFacesToRender_{};
+    unsigned nextFilterLevel_{};
     WeakPtr<TextureCube> currentViewportTexture_;
     WeakPtr<TextureCube> currentFilteredTexture_;
     bool viewportsConnectedToSelf_{};
@@ -52,6 +52,70 @@ static const unsigned MAX_LINES = 1000000;
 // Cap the amount of triangles to prevent crash.
 static const unsigned MAX_TRIANGLES = 100000;
 
+namespace
+{
+
+float* WriteLineVertices(float* dest, ea::span<const DebugLine> lines)
+{
+    for (const DebugLine& line : lines)
+    {
+        dest[0] = line.start_.x_;
+        dest[1] = line.start_.y_;
+        dest[2] = line.start_.z_;
+        ((unsigned&)dest[3]) = line.color_;
+        dest[4] = line.end_.x_;
+        dest[5] = line.end_.y_;
+        dest[6] = line.end_.z_;
+        ((unsigned&)dest[7]) = line.color_;
+
+        dest += 8;
+    }
+    return dest;
+}
+
+float* WriteTriangleVertices(float* dest, ea::span<const DebugTriangle> triangles)
+{
+    for (const DebugTriangle& triangle : triangles)
+    {
+        dest[0] = triangle.v1_.x_;
+        dest[1] = triangle.v1_.y_;
+        dest[2] = triangle.v1_.z_;
+        ((unsigned&)dest[3]) = triangle.color_;
+
+        dest[4] = triangle.v2_.x_;
+        dest[5] = triangle.v2_.y_;
+        dest[6] = triangle.v2_.z_;
+        ((unsigned&)dest[7]) = triangle.color_;
+
+        dest[8] = triangle.v3_.x_;
+        dest[9] = triangle.v3_.y_;
+        dest[10] = triangle.v3_.z_;
+        ((unsigned&)dest[11]) = triangle.color_;
+
+        dest += 12;
+    }
+    return dest;
+}
+
+template <class T>
+void AppendLimited(ea::vector<T>& dest, ea::span<const T> source, unsigned maxSize)
+{
+    const unsigned count = ea::min<unsigned>(source.size(), maxSize - ea::min<unsigned>(dest.size(), maxSize));
+    dest.insert(dest.end(), source.begin(), source.begin() + count);
+}
+
+template <class T>
+void MoveLimited(ea::vector<T>& dest, ea::vector<T>& source, unsigned maxSize)
+{
+    if (!source.empty())
+    {
+        AppendLimited(dest, ea::span<const T>(source), maxSize);
+        source.clear();
+    }
+}
+
+}
+
 DebugRenderer::DebugRenderer(Context* context)
     : Component(context)
     , lineAntiAlias_(false)
@@ -105,6 +169,12 @@ void DebugRenderer::AddLine(const Vector3& start, const Vector3& end, unsigned c
         noDepthLines_.push_back(DebugLine(start, end, color));
 }
 
+void DebugRenderer::AddLines(ea::span<const DebugLine> lines, bool depthTest)
+{
+    MutexLock lock(pendingMutex_);
+    AppendLimited(depthTest ? pendingLines_ : pendingNoDepthLines_, lines, MAX_LINES);
+}
+
 void DebugRenderer::AddLine2D(const Vector2& start, const Vector2& end, const Color& color, bool depthTest)
 {
     AddLine2D(start, end, color.ToUInt(), depthTest);
@@ -135,6 +205,12 @@ void DebugRenderer::AddTriangle(const Vector3& v1, const Vector3& v2, const Vect
         noDepthTriangles_.push_back(DebugTriangle(v1, v2, v3, color));
 }
 
+void DebugRenderer::AddTriangles(ea::span<const DebugTriangle> triangles, bool depthTest)
+{
+    MutexLock lock(pendingMutex_);
+    AppendLimited(depthTest ? pendingTriangles_ : pendingNoDepthTriangles_, triangles, MAX_TRIANGLES);
+}
+
 void DebugRenderer::AddPolygon(const Vector3& v1, const Vector3& v2, const Vector3& v3, const Vector3& v4, const Color& color, bool depthTest)
 {
     AddTriangle(v1, v2, v3, color, depthTest);
@@ -540,105 +616,83 @@ void DebugRenderer::AddQuad(const Vector3& center, float width, float height, co
     AddLine(v3, v0, uintColor, depthTest);
 }
 
-void DebugRenderer::Render()
+bool DebugRenderer::DrawRetainedGeometry(const ea::string& name, unsigned version)
 {
-    if (!HasContent())
-        return;
-
-    auto* renderDevice = GetSubsystem<RenderDevice>();
-    auto* renderContext = renderDevice->GetRenderContext();
-
-    const RenderScope renderScope(renderContext, "DebugRenderer::Render");
+    const auto iter = retainedGeometry_.find(name);
+    if (iter == retainedGeometry_.end() || iter->second.version_ != version || iter->second.vertexBuffer_->IsDataLost())
+        return false;
 
-    URHO3D_PROFILE("RenderDebugGeometry");
+    iter->second.drawn_ = true;
+    return true;
+}
 
-    unsigned numVertices = (lines_.size() + noDepthLines_.size()) * 2 + (triangles_.size() + noDepthTriangles_.size()) * 3;
-    // Resize the vertex buffer if too small or much too large
-    if (vertexBuffer_->GetVertexCount() < numVertices || vertexBuffer_->GetVertexCount() > numVertices * 2)
-        vertexBuffer_->SetSize(numVertices, MASK_POSITION | MASK_COLOR, true);
+void DebugRenderer::SetRetainedGeometry(const ea::string& name, unsigned version,
+    ea::span<const DebugLine> lines, ea::span<const DebugTriangle> triangles, bool depthTest)
+{
+    RetainedGeometry& layer = retainedGeometry_[name];
+    layer.version_ = version;
+    layer.numLineVertices_ = lines.size() * 2;
+    layer.numTriangleVertices_ = triangles.size() * 3;
+    layer.depthTest_ = depthTest;
+    layer.drawn_ = true;
 
-    auto* dest = (float*)vertexBuffer_->Map();
-    if (!dest)
+    const unsigned numVertices = layer.numLineVertices_ + layer.numTriangleVertices_;
+    if (numVertices == 0)
         return;
 
-    for (unsigned i = 0; i < lines_.size(); ++i)
+    if (!layer.vertexBuffer_)
     {
-        const DebugLine& line = lines_[i];
-
-        dest[0] = line.start_.x_;
-        dest[1] = line.start_.y_;
-        dest[2] = line.start_.z_;
-        ((unsigned&)dest[3]) = line.color_;
-        dest[4] = line.end_.x_;
-        dest[5] = line.end_.y_;
-        dest[6] = line.end_.z_;
-        ((unsigned&)dest[7]) = line.color_;
-
-        dest += 8;
+        layer.vertexBuffer_ = MakeShared<VertexBuffer>(context_);
+        layer.vertexBuffer_->SetDebugName(Format("DebugRenderer for {}", name));
     }
 
-    for (unsigned i = 0; i < noDepthLines_.size(); ++i)
-    {
-        const DebugLine& line = noDepthLines_[i];
+    ea::vector<float> data(numVertices * 4);
+    float* dest = WriteLineVertices(data.data(), lines);
+    WriteTriangleVertices(dest, triangles);
 
-        dest[0] = line.start_.x_;
-        dest[1] = line.start_.y_;
-        dest[2] = line.start_.z_;
-        ((unsigned&)dest[3]) = line.color_;
-        dest[4] = line.end_.x_;
-        dest[5] = line.end_.y_;
-        dest[6] = line.end_.z_;
-        ((unsigned&)dest[7]) = line.color_;
+    layer.vertexBuffer_->SetSize(numVertices, MASK_POSITION | MASK_COLOR);
+    layer.vertexBuffer_->Update(data.data());
+}
 
-        dest += 8;
-    }
+void DebugRenderer::RemoveRetainedGeometry(const ea::string& name)
+{
+    retainedGeometry_.erase(name);
+}
 
-    for (unsigned i = 0; i < triangles_.size(); ++i)
-    {
-        const DebugTriangle& triangle = triangles_[i];
+void DebugRenderer::Render()
+{
+    FlushPendingGeometry();
 
-        dest[0] = triangle.v1_.x_;
-        dest[1] = triangle.v1_.y_;
-        dest[2] = triangle.v1_.z_;
-        ((unsigned&)dest[3]) = triangle.color_;
+    if (!HasContent())
+        return;
 
-        dest[4] = triangle.v2_.x_;
-        dest[5] = triangle.v2_.y_;
-        dest[6] = triangle.v2_.z_;
-        ((unsigned&)dest[7]) = triangle.color_;
+    auto* renderDevice = GetSubsystem<RenderDevice>();
+    auto* renderContext = renderDevice->GetRenderContext();
 
-        dest[8] = triangle.v3_.x_;
-        dest[9] = triangle.v3_.y_;
-        dest[10] = triangle.v3_.z_;
-        ((unsigned&)dest[11]) = triangle.color_;
+    const RenderScope renderScope(renderContext, "DebugRenderer::Render");
 
-        dest += 12;
-    }
+    URHO3D_PROFILE("RenderDebugGeometry");
 
-    for (unsigned i = 0; i < noDepthTriangles_.size(); ++i)
+    const unsigned numVertices =
+        (lines_.size() + noDepthLines_.size()) * 2 + (triangles_.size() + noDepthTriangles_.size()) * 3;
+    if (numVertices > 0)
     {
-        const DebugTriangle& triangle = noDepthTriangles_[i];
+        // Resize the vertex buffer if too small or much too large
+        if (vertexBuffer_->GetVertexCount() < numVertices || vertexBuffer_->GetVertexCount() > numVertices * 2)
+            vertexBuffer_->SetSize(numVertices, MASK_POSITION | MASK_COLOR, true);
 
-        dest[0] = triangle.v1_.x_;
-        dest[1] = triangle.v1_.y_;
-        dest[2] = triangle.v1_.z_;
-        ((unsigned&)dest[3]) = triangle.color_;
+        auto* dest = (float*)vertexBuffer_->Map();
+        if (!dest)
+            return;
 
-        dest[4] = triangle.v2_.x_;
-        dest[5] = triangle.v2_.y_;
-        dest[6] = triangle.v2_.z_;
-        ((unsigned&)dest[7]) = triangle.color_;
+        dest = WriteLineVertices(dest, lines_);
+        dest = WriteLineVertices(dest, noDepthLines_);
+        dest = WriteTriangleVertices(dest, triangles_);
+        WriteTriangleVertices(dest, noDepthTriangles_);
 
-        dest[8] = triangle.v3_.x_;
-        dest[9] = triangle.v3_.y_;
-        dest[10] = triangle.v3_.z_;
-        ((unsigned&)dest[11]) = triangle.color_;
-
-        dest += 12;
+        vertexBuffer_->Unmap();
     }
 
-    vertexBuffer_->Unmap();
-
     if (!pipelineStatesInitialized_)
         InitializePipelineStates();
 
@@ -668,43 +722,49 @@ void DebugRenderer::Render()
         }
     };
 
-    drawQueue->SetVertexBuffers({vertexBuffer_});
-
     const PipelineStateOutputDesc& outputDesc = renderContext->GetCurrentRenderTargetsDesc();
 
-    unsigned start = 0;
-    unsigned count = 0;
-    if (lines_.size())
-    {
-        count = lines_.size() * 2;
-        drawQueue->SetPipelineState(pipelineStates_.GetState(depthLinesPipelineState_[lineAntiAlias_], outputDesc));
-        setDefaultConstants();
-        drawQueue->Draw(start, count);
-        start += count;
-    }
-    if (noDepthLines_.size())
+    const auto draw = [&](StaticPipelineStateId pipelineState, unsigned start, unsigned count)
     {
-        count = noDepthLines_.size() * 2;
-        drawQueue->SetPipelineState(pipelineStates_.GetState(noDepthLinesPipelineState_[lineAntiAlias_], outputDesc));
+        if (count == 0)
+            return;
+
+        drawQueue->SetPipelineState(pipelineStates_.GetState(pipelineState, outputDesc));
         setDefaultConstants();
         drawQueue->Draw(start, count);
-        start += count;
-    }
+    };
 
-    if (triangles_.size())
+    // Retained layers go first, their geometry is already uploaded
+    for (const auto& [name, layer] : retainedGeometry_)
     {
-        count = triangles_.size() * 3;
-        drawQueue->SetPipelineState(pipelineStates_.GetState(depthTrianglesPipelineState_, outputDesc));
-        setDefaultConstants();
-        drawQueue->Draw(start, count);
-        start += count;
+        if (!layer.drawn_ || !layer.vertexBuffer_ || layer.numLineVertices_ + layer.numTriangleVertices_ == 0)
+            continue;
+
+        drawQueue->SetVertexBuffers({layer.vertexBuffer_});
+        if (layer.depthTest_)
+        {
+            draw(depthLinesPipelineState_[lineAntiAlias_], 0, layer.numLineVertices_);
+            draw(depthTrianglesPipelineState_, layer.numLineVertices_, layer.numTriangleVertices_);
+        }
+        else
+        {
+            draw(noDepthLinesPipelineState_[lineAntiAlias_], 0, layer.numLineVertices_);
+            draw(noDepthTrianglesPipelineState_, layer.numLineVertices_, layer.numTriangleVertices_);
+        }
     }
-    if (noDepthTriangles_.size())
+
+    if (numVertices > 0)
     {
-        count = noDepthTriangles_.size() * 3;
-        drawQueue->SetPipelineState(pipelineStates_.GetState(noDepthTrianglesPipelineState_, outputDesc));
-        setDefaultConstants();
-        drawQueue->Draw(start, count);
+        drawQueue->SetVertexBuffers({vertexBuffer_});
+
+        unsigned start = 0;
+        draw(depthLinesPipelineState_[lineAntiAlias_], start, lines_.size() * 2);
+        start += lines_.size() * 2;
+        draw(noDepthLinesPipelineState_[lineAntiAlias_], start, noDepthLines_.size() * 2);
+        start += noDepthLines_.size() * 2;
+        draw(depthTrianglesPipelineState_, start, triangles_.size() * 3);
+        start += triangles_.size() * 3;
+        draw(noDepthTrianglesPipelineState_, start, noDepthTriangles_.size() * 3);
     }
 
     renderContext->Execute(drawQueue);
@@ -717,11 +777,46 @@ bool DebugRenderer::IsInside(const BoundingBox& box) const
 
 bool DebugRenderer::HasContent() const
 {
-    return !(lines_.empty() && noDepthLines_.empty() && triangles_.empty() && noDepthTriangles_.empty());
+    if (!(lines_.empty() && noDepthLines_.empty() && triangles_.empty() && noDepthTriangles_.empty()))
+        return true;
+
+    for (const auto& [name, layer] : retainedGeometry_)
+    {
+        if (layer.drawn_ && layer.numLineVertices_ + layer.numTriangleVertices_ > 0)
+            return true;
+    }
+
+    MutexLock lock(pendingMutex_);
+    return !(pendingLines_.empty() && pendingNoDepthLines_.empty() && pendingTriangles_.empty()
+        && pendingNoDepthTriangles_.empty());
+}
+
+void DebugRenderer::FlushPendingGeometry()
+{
+    MutexLock lock(pendingMutex_);
+
+    MoveLimited(lines_, pendingLines_, MAX_LINES);
+    MoveLimited(noDepthLines_, pendingNoDepthLines_, MAX_LINES);
+    MoveLimited(triangles_, pendingTriangles_, MAX_TRIANGLES);
+    MoveLimited(noDepthTriangles_, pendingNoDepthTriangles_, MAX_TRIANGLES);
 }
 
 void DebugRenderer::HandleEndFrame(StringHash eventType, VariantMap& eventData)
 {
+    // Release retained layers that were not drawn in this frame
+    for (auto iter = retainedGeometry_.begin(); iter != retainedGeometry_.end();)
+    {
+        if (!iter->second.drawn_)
+            iter = retainedGeometry_.erase(iter);
+        else
+        {
+            iter->second.drawn_ = false;
+            ++iter;
+        }
+    }
+
+    FlushPendingGeometry();
+
     // When the amount of debug geometry is reduced, release memory
     unsigned linesSize = lines_.size();
     unsigned noDepthLinesSize = noDepthLines_.size();
@@ -22,11 +22,15 @@
 
 #pragma once
 
+#include "../Core/Mutex.h"
 #include "../RenderPipeline/StaticPipelineStateCache.h"
 #include "../Math/Color.h"
 #include "../Math/Frustum.h"
 #include "../Scene/Component.h"
 
+#include <EASTL/span.h>
+#include <EASTL/unordered_map.h>
+
 namespace Urho3D
 {
 
@@ -115,10 +119,14 @@ public:
     void AddLine2D(const Vector2& start, const Vector2& end, const Color& color, bool depthTest = true);
     /// Add a line in 2D screen space with color already converted to unsigned.
     void AddLine2D(const Vector2& start, const Vector2& end, unsigned color, bool depthTest = true);
+    /// Add lines in bulk. Thread-safe.
+    void AddLines(ea::span<const DebugLine> lines, bool depthTest = true);
     /// Add a solid triangle.
     void AddTriangle(const Vector3& v1, const Vector3& v2, const Vector3& v3, const Color& color, bool depthTest = true);
     /// Add a solid triangle with color already converted to unsigned.
     void AddTriangle(const Vector3& v1, const Vector3& v2, const Vector3& v3, unsigned color, bool depthTest = true);
+    /// Add solid triangles in bulk. Thread-safe.
+    void AddTriangles(ea::span<const DebugTriangle> triangles, bool depthTest = true);
     /// Add a solid quadrangular polygon.
     void AddPolygon(const Vector3& v1, const Vector3& v2, const Vector3& v3, const Vector3& v4, const Color& color, bool depthTest = true);
     /// Add a solid quadrangular polygon with color already converted to unsigned.
@@ -159,6 +167,16 @@ public:
     /// Add a quad on the XZ plane.
     void AddQuad(const Vector3& center, float width, float height, const Color& color, bool depthTest = true);
 
+    /// Draw retained geometry layer in this frame. Return false if the layer doesn't exist or has different version,
+    /// in which case the geometry should be set again via SetRetainedGeometry.
+    bool DrawRetainedGeometry(const ea::string& name, unsigned version);
+    /// Upload geometry of retained layer and draw it in this frame.
+    /// Retained layer is kept in GPU memory and is released when it's not drawn for a frame.
+    void SetRetainedGeometry(const ea::string& name, unsigned version,
+        ea::span<const DebugLine> lines, ea::span<const DebugTriangle> triangles, bool depthTest = true);
+    /// Release retained geometry layer.
+    void RemoveRetainedGeometry(const ea::string& name);
+
     /// Update vertex buffer and render all debug lines. The viewport and rendertarget should be set before.
     void Render();
 
@@ -181,6 +199,25 @@ public:
     bool HasContent() const;
 
 private:
+    /// Retained geometry layer.
+    struct RetainedGeometry
+    {
+        /// Static vertex buffer. Lines go first, then triangles.
+        SharedPtr<VertexBuffer> vertexBuffer_;
+        /// User-provided version of the geometry.
+        unsigned version_{};
+        /// Number of line vertices.
+        unsigned numLineVertices_{};
+        /// Number of triangle vertices.
+        unsigned numTriangleVertices_{};
+        /// Whether to use depth test.
+        bool depthTest_{};
+        /// Whether the layer is drawn in this frame.
+        bool drawn_{};
+    };
+
+    /// Move geometry added from other threads to the main containers.
+    void FlushPendingGeometry();
     /// Handle end of frame. Clear debug geometry.
     void HandleEndFrame(StringHash eventType, VariantMap& eventData);
     /// Initialize pipeline states. Is expected to be called only once.
@@ -194,6 +231,18 @@ private:
     ea::vector<DebugTriangle> triangles_;
     /// Triangles rendered without depth test.
     ea::vector<DebugTriangle> noDepthTriangles_;
+    /// Mutex for geometry added in bulk.
+    mutable Mutex pendingMutex_;
+    /// Pending lines rendered with depth test.
+    ea::vector<DebugLine> pendingLines_;
+    /// Pending lines rendered without depth test.
+    ea::vector<DebugLine> pendingNoDepthLines_;
+    /// Pending triangles rendered with depth test.
+    ea::vector<DebugTriangle> pendingTriangles_;
+    /// Pending triangles rendered without depth test.
+    ea::vector<DebugTriangle> pendingNoDepthTriangles_;
+    /// Retained geometry layers.
+    ea::unordered_map<ea::string, RetainedGeometry> retainedGeometry_;
     /// View transform.
     Matrix3x4 view_;
     /// Projection transform.
@@ -24,6 +24,7 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/AnimatedModel.h"
 #include "../Graphics/Camera.h"
 #include "../Graphics/DecalSet.h"
@@ -39,6 +40,11 @@
 #include "../Scene/Scene.h"
 #include "../Scene/SceneEvents.h"
 
+#include <EASTL/fixed_vector.h>
+#include <EASTL/shared_ptr.h>
+#include <EASTL/sort.h>
+#include <EASTL/unordered_map.h>
+
 #include "../DebugNew.h"
 
 #ifdef _MSC_VER
@@ -125,6 +131,174 @@ static void ClipPolygon(ea::vector<DecalVertex>& dest, const ea::vector<DecalVer
         dest.push_back(ClipEdge(src[last], src[0], lastDistance, distance, skinned));
 }
 
+namespace
+{
+
+/// Geometry data signature used to detect changes of the geometry with cached triangle tree.
+struct TriangleTreeKey
+{
+    const void* vertexData_{};
+    const void* indexData_{};
+    unsigned numVertices_{};
+    unsigned indexStart_{};
+    unsigned indexCount_{};
+    unsigned vertexStart_{};
+    unsigned vertexCount_{};
+    bool dynamic_{};
+
+    bool operator==(const TriangleTreeKey& rhs) const
+    {
+        return vertexData_ == rhs.vertexData_ && indexData_ == rhs.indexData_ && numVertices_ == rhs.numVertices_
+            && indexStart_ == rhs.indexStart_ && indexCount_ == rhs.indexCount_ && vertexStart_ == rhs.vertexStart_
+            && vertexCount_ == rhs.vertexCount_ && dynamic_ == rhs.dynamic_;
+    }
+};
+
+TriangleTreeKey GetTriangleTreeKey(Geometry* geometry)
+{
+    TriangleTreeKey key;
+    if (VertexBuffer* vb = geometry->GetVertexBuffer(0))
+    {
+        key.vertexData_ = vb->GetShadowData();
+        key.numVertices_ = vb->GetVertexCount();
+        key.dynamic_ = vb->IsDynamic();
+    }
+    if (IndexBuffer* ib = geometry->GetIndexBuffer())
+    {
+        key.indexData_ = ib->GetShadowData();
+        key.dynamic_ = key.dynamic_ || ib->IsDynamic();
+    }
+    key.indexStart_ = geometry->GetIndexStart();
+    key.indexCount_ = geometry->GetIndexCount();
+    key.vertexStart_ = geometry->GetVertexStart();
+    key.vertexCount_ = geometry->GetVertexCount();
+    return key;
+}
+
+struct CachedTriangleTree
+{
+    WeakPtr<Geometry> geometry_;
+    TriangleTreeKey key_;
+    SharedPtr<DecalTriangleTree> tree_;
+};
+
+/// Triangle trees are shared by all drawables using the same geometry.
+Mutex triangleTreeCacheMutex;
+ea::unordered_map<unsigned, CachedTriangleTree> triangleTreeCache;
+
+void CalculateUVs(
+    Decal& decal, const Matrix3x4& view, const Matrix4& projection, const Vector2& topLeftUV, const Vector2& bottomRightUV)
+{
+    Matrix4 viewProj = projection * view;
+
+    for (auto i = decal.vertices_.begin(); i != decal.vertices_.end(); ++i)
+    {
+        Vector3 projected = viewProj * i->position_;
+        i->texCoord_ = Vector2(
+            Lerp(topLeftUV.x_, bottomRightUV.x_, projected.x_ * 0.5f + 0.5f),
+            Lerp(bottomRightUV.y_, topLeftUV.y_, projected.y_ * 0.5f + 0.5f)
+        );
+    }
+}
+
+void TransformVertices(Decal& decal, const Matrix3x4& transform)
+{
+    for (auto i = decal.vertices_.begin(); i != decal.vertices_.end(); ++i)
+    {
+        i->position_ = transform * i->position_;
+        i->normal_ = (transform * i->normal_.ToVector4()).Normalized();
+    }
+}
+
+/// Clip faces by the decal frustum and triangulate them into the decal.
+void ClipAndTriangulate(Decal& decal, ea::vector<ea::vector<DecalVertex>>& faces, const Frustum& frustum, bool skinned)
+{
+    ea::vector<DecalVertex> tempFace;
+
+    // Clip the acquired faces against all frustum planes
+    for (const auto& plane : frustum.planes_)
+    {
+        for (unsigned j = 0; j < faces.size(); ++j)
+        {
+            ea::vector<DecalVertex>& face = faces[j];
+            if (face.empty())
+                continue;
+
+            ClipPolygon(tempFace, face, plane, skinned);
+            face = tempFace;
+        }
+    }
+
+    // Now triangulate the resulting faces into decal vertices
+    for (unsigned i = 0; i < faces.size(); ++i)
+    {
+        ea::vector<DecalVertex>& face = faces[i];
+        if (face.size() < 3)
+            continue;
+
+        for (unsigned j = 2; j < face.size(); ++j)
+        {
+            decal.AddVertex(face[0]);
+            decal.AddVertex(face[j - 1]);
+            decal.AddVertex(face[j]);
+        }
+    }
+}
+
+/// Get faces of static geometry which may intersect the decal frustum.
+void GetTreeFaces(ea::vector<ea::vector<DecalVertex>>& faces, const DecalTriangleTree& tree, const Frustum& frustum,
+    const Vector3& decalNormal, float normalCutoff)
+{
+    const ea::vector<Vector3>& positions = tree.GetPositions();
+    const ea::vector<Vector3>& normals = tree.GetNormals();
+    const ea::vector<unsigned>& indices = tree.GetIndices();
+    const bool hasNormals = !normals.empty();
+
+    ea::vector<unsigned> triangles;
+    tree.GetTriangles(triangles, frustum);
+
+    for (unsigned triangle : triangles)
+    {
+        const unsigned i0 = indices[triangle * 3];
+        const unsigned i1 = indices[triangle * 3 + 1];
+        const unsigned i2 = indices[triangle * 3 + 2];
+
+        const Vector3& v0 = positions[i0];
+        const Vector3& v1 = positions[i1];
+        const Vector3& v2 = positions[i2];
+
+        // Calculate unsmoothed face normals if no normal data
+        Vector3 faceNormal = Vector3::ZERO;
+        if (!hasNormals)
+            faceNormal = ((v1 - v0).CrossProduct(v2 - v0)).Normalized();
+
+        const Vector3& n0 = hasNormals ? normals[i0] : faceNormal;
+        const Vector3& n1 = hasNormals ? normals[i1] : faceNormal;
+        const Vector3& n2 = hasNormals ? normals[i2] : faceNormal;
+
+        // Check if face is too much away from the decal normal
+        if (decalNormal.DotProduct((n0 + n1 + n2) / 3.0f) < normalCutoff)
+            continue;
+
+        // Check if face is culled completely by any of the planes
+        bool culled = false;
+        for (const Plane& plane : frustum.planes_)
+        {
+            if (plane.Distance(v0) < 0.0f && plane.Distance(v1) < 0.0f && plane.Distance(v2) < 0.0f)
+            {
+                culled = true;
+                break;
+            }
+        }
+        if (culled)
+            continue;
+
+        faces.push_back({DecalVertex(v0, n0), DecalVertex(v1, n1), DecalVertex(v2, n2)});
+    }
+}
+
+}
+
 void Decal::AddVertex(const DecalVertex& vertex)
 {
     for (unsigned i = 0; i < vertices_.size(); ++i)
@@ -148,6 +322,237 @@ void Decal::CalculateBoundingBox()
         boundingBox_.Merge(vertices_[i].position_);
 }
 
+bool DecalTriangleTree::Define(Geometry* geometry)
+{
+    if (!geometry || geometry->GetPrimitiveType() != TRIANGLE_LIST)
+        return false;
+
+    const unsigned char* positionData = nullptr;
+    const unsigned char* normalData = nullptr;
+    const unsigned char* indexData = nullptr;
+    unsigned positionStride = 0;
+    unsigned normalStride = 0;
+    unsigned indexStride = 0;
+    unsigned numVertices = 0;
+
+    IndexBuffer* ib = geometry->GetIndexBuffer();
+    if (ib)
+    {
+        indexData = ib->GetShadowData();
+        indexStride = ib->GetIndexSize();
+    }
+
+    // For morphed models positions and normals may be in different buffers
+    for (unsigned i = 0; i < geometry->GetNumVertexBuffers(); ++i)
+    {
+        VertexBuffer* vb = geometry->GetVertexBuffer(i);
+        if (!vb)
+            continue;
+
+        unsigned elementMask = vb->GetElementMask();
+        unsigned char* data = vb->GetShadowData();
+        if (!data)
+            continue;
+
+        if (elementMask & MASK_POSITION)
+        {
+            positionData = data;
+            positionStride = vb->GetVertexSize();
+            numVertices = vb->GetVertexCount();
+        }
+        if (elementMask & MASK_NORMAL)
+        {
+            normalData = data + vb->GetElementOffset(SEM_NORMAL);
+            normalStride = vb->GetVertexSize();
+        }
+    }
+
+    if (!positionData)
+    {
+        // As a fallback, try to get the geometry's raw vertex/index data
+        const ea::vector<VertexElement>* elements;
+        geometry->GetRawData(positionData, positionStride, indexData, indexStride, elements);
+        if (!positionData)
+            return false;
+        normalData = nullptr;
+        numVertices = M_MAX_UNSIGNED;
+    }
+
+    // Copy only referenced vertices
+    ea::vector<unsigned> indices;
+    if (indexData)
+    {
+        const unsigned indexStart = geometry->GetIndexStart();
+        const unsigned indexCount = geometry->GetIndexCount() / 3 * 3;
+        indices.resize(indexCount);
+        for (unsigned i = 0; i < indexCount; ++i)
+        {
+            indices[i] = indexStride == sizeof(unsigned short)
+                ? reinterpret_cast<const unsigned short*>(indexData)[indexStart + i]
+                : reinterpret_cast<const unsigned*>(indexData)[indexStart + i];
+        }
+    }
+    else
+    {
+        const unsigned vertexStart = geometry->GetVertexStart();
+        const unsigned vertexCount = geometry->GetVertexCount() / 3 * 3;
+        indices.resize(vertexCount);
+        for (unsigned i = 0; i < vertexCount; ++i)
+            indices[i] = vertexStart + i;
+    }
+
+    ea::vector<Vector3> positions;
+    ea::vector<Vector3> normals;
+    ea::unordered_map<unsigned, unsigned> vertexRemap;
+    for (unsigned& index : indices)
+    {
+        if (index >= numVertices)
+            return false;
+
+        const auto [iter, isNew] = vertexRemap.emplace(index, positions.size());
+        if (isNew)
+        {
+            positions.push_back(*reinterpret_cast<const Vector3*>(&positionData[index * positionStride]));
+            if (normalData)
+                normals.push_back(*reinterpret_cast<const Vector3*>(&normalData[index * normalStride]));
+        }
+        index = iter->second;
+    }
+
+    Define(positions, normals, indices);
+    return true;
+}
+
+void DecalTriangleTree::Define(
+    ea::span<const Vector3> positions, ea::span<const Vector3> normals, ea::span<const unsigned> indices)
+{
+    positions_.assign(positions.begin(), positions.end());
+    normals_.assign(normals.begin(), normals.end());
+    indices_.assign(indices.begin(), indices.end());
+    nodes_.clear();
+
+    const unsigned numTriangles = indices.size() / 3;
+    ea::vector<Vector3> centers(numTriangles);
+    ea::vector<unsigned> triangles(numTriangles);
+    for (unsigned i = 0; i < numTriangles; ++i)
+    {
+        triangles[i] = i;
+        centers[i] = (positions_[indices_[i * 3]] + positions_[indices_[i * 3 + 1]] + positions_[indices_[i * 3 + 2]]) / 3.0f;
+    }
+
+    if (numTriangles > 0)
+        BuildNode(triangles, 0, centers);
+
+    // Store triangles in the node order
+    ea::vector<unsigned> sortedIndices(numTriangles * 3);
+    for (unsigned i = 0; i < numTriangles; ++i)
+    {
+        for (unsigned j = 0; j < 3; ++j)
+            sortedIndices[i * 3 + j] = indices_[triangles[i] * 3 + j];
+    }
+    indices_ = ea::move(sortedIndices);
+}
+
+unsigned DecalTriangleTree::BuildNode(ea::span<unsigned> triangles, unsigned firstTriangle, const ea::vector<Vector3>& centers)
+{
+    const unsigned nodeIndex = nodes_.size();
+    nodes_.emplace_back();
+
+    BoundingBox boundingBox;
+    BoundingBox centerBox;
+    for (unsigned triangle : triangles)
+    {
+        centerBox.Merge(centers[triangle]);
+        for (unsigned j = 0; j < 3; ++j)
+            boundingBox.Merge(positions_[indices_[triangle * 3 + j]]);
+    }
+
+    nodes_[nodeIndex].firstTriangle_ = firstTriangle;
+    nodes_[nodeIndex].numTriangles_ = triangles.size();
+
+    if (triangles.size() > MaxLeafTriangles)
+    {
+        // Split by median of the longest axis
+        const Vector3 size = centerBox.Size();
+        const unsigned axis = size.x_ >= size.y_ && size.x_ >= size.z_ ? 0 : (size.y_ >= size.z_ ? 1 : 2);
+        const unsigned middle = triangles.size() / 2;
+        ea::nth_element(triangles.begin(), triangles.begin() + middle, triangles.end(),
+            [&](unsigned lhs, unsigned rhs) { return centers[lhs].Data()[axis] < centers[rhs].Data()[axis]; });
+
+        BuildNode(triangles.subspan(0, middle), firstTriangle, centers);
+        const unsigned secondChild = BuildNode(triangles.subspan(middle), firstTriangle + middle, centers);
+        nodes_[nodeIndex].secondChild_ = secondChild;
+    }
+
+    nodes_[nodeIndex].boundingBox_ = boundingBox;
+    return nodeIndex;
+}
+
+void DecalTriangleTree::GetTriangles(ea::vector<unsigned>& triangles, const Frustum& frustum) const
+{
+    if (nodes_.empty())
+        return;
+
+    ea::fixed_vector<unsigned, 64> stack;
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+        const unsigned nodeIndex = stack.back();
+        stack.pop_back();
+
+        const Node& node = nodes_[nodeIndex];
+        const Intersection intersection = frustum.IsInside(node.boundingBox_);
+        if (intersection == OUTSIDE)
+            continue;
+
+        if (intersection == INSIDE || !node.secondChild_)
+        {
+            for (unsigned i = 0; i < node.numTriangles_; ++i)
+                triangles.push_back(node.firstTriangle_ + i);
+        }
+        else
+        {
+            stack.push_back(node.secondChild_);
+            stack.push_back(nodeIndex + 1);
+        }
+    }
+}
+
+SharedPtr<DecalTriangleTree> DecalTriangleTree::GetOrCreate(Geometry* geometry)
+{
+    if (!geometry)
+        return nullptr;
+
+    const TriangleTreeKey key = GetTriangleTreeKey(geometry);
+    const bool cacheable = !key.dynamic_;
+
+    MutexLock lock(triangleTreeCacheMutex);
+    if (cacheable)
+    {
+        const auto iter = triangleTreeCache.find(geometry->GetObjectID());
+        if (iter != triangleTreeCache.end() && iter->second.geometry_ == geometry && iter->second.key_ == key)
+            return iter->second.tree_;
+    }
+
+    auto tree = MakeShared<DecalTriangleTree>();
+    if (!tree->Define(geometry))
+        return nullptr;
+
+    if (cacheable)
+    {
+        // Forget trees of destroyed geometries
+        for (auto iter = triangleTreeCache.begin(); iter != triangleTreeCache.end();)
+        {
+            if (!iter->second.geometry_)
+                iter = triangleTreeCache.erase(iter);
+            else
+                ++iter;
+        }
+        triangleTreeCache[geometry->GetObjectID()] = CachedTriangleTree{WeakPtr<Geometry>(geometry), key, tree};
+    }
+    return tree;
+}
+
 DecalSet::DecalSet(Context* context) :
     Drawable(context, DRAWABLE_GEOMETRY),
     geometry_(MakeShared<Geometry>(context)),
@@ -300,6 +705,49 @@ bool DecalSet::AddDecal(Drawable* target, const Vector3& worldPosition, const Qu
 {
     URHO3D_PROFILE("AddDecal");
 
+    DecalRequest request;
+    if (!PrepareDecal(request, target, worldPosition, worldRotation, size, aspectRatio, depth, topLeftUV, bottomRightUV,
+        timeToLive, normalCutoff, subGeometry))
+        return false;
+
+    Decal newDecal;
+    if (skinned_)
+        GenerateSkinnedDecal(newDecal, target, request, subGeometry);
+    else
+        GenerateStaticDecal(newDecal, request);
+
+    return CommitDecal(newDecal);
+}
+
+bool DecalSet::AddDecalAsync(Drawable* target, const Vector3& worldPosition, const Quaternion& worldRotation, float size,
+    float aspectRatio, float depth, const Vector2& topLeftUV, const Vector2& bottomRightUV, float timeToLive, float normalCutoff,
+    unsigned subGeometry)
+{
+    // Skinned decals need bone lookup and are generated immediately
+    if (dynamic_cast<AnimatedModel*>(target))
+    {
+        return AddDecal(target, worldPosition, worldRotation, size, aspectRatio, depth, topLeftUV, bottomRightUV, timeToLive,
+            normalCutoff, subGeometry);
+    }
+
+    URHO3D_PROFILE("AddDecalAsync");
+
+    DecalRequest request;
+    if (!PrepareDecal(request, target, worldPosition, worldRotation, size, aspectRatio, depth, topLeftUV, bottomRightUV,
+        timeToLive, normalCutoff, subGeometry))
+        return false;
+
+    if (numAsyncDecals_ < maxAsyncDecals_)
+        StartAsyncDecal(request);
+    else
+        queuedDecals_.push_back(ea::move(request));
+    return true;
+}
+
+bool DecalSet::PrepareDecal(DecalRequest& request, Drawable* target, const Vector3& worldPosition,
+    const Quaternion& worldRotation, float size, float aspectRatio, float depth, const Vector2& topLeftUV,
+    const Vector2& bottomRightUV, float timeToLive, float normalCutoff, unsigned subGeometry)
+{
     // Do not add decals in headless mode
     if (!node_ || !GetSubsystem<Graphics>())
         return false;
@@ -369,98 +817,124 @@ bool DecalSet::AddDecal(Drawable* target, const Vector3& worldPosition, const Qu
     }
 
     // Build the decal frustum
-    Frustum decalFrustum;
-    Matrix3x4 frustumTransform = targetTransform * Matrix3x4(adjustedWorldPosition, worldRotation, 1.0f);
-    decalFrustum.DefineOrtho(size, aspectRatio, 1.0, 0.0f, depth, frustumTransform);
+    request.frustumTransform_ = targetTransform * Matrix3x4(adjustedWorldPosition, worldRotation, 1.0f);
+    request.frustum_.DefineOrtho(size, aspectRatio, 1.0, 0.0f, depth, request.frustumTransform_);
+    request.decalNormal_ = (targetTransform * (worldRotation * Vector3::BACK).ToVector4()).Normalized();
+    request.normalCutoff_ = normalCutoff;
+
+    request.projection_ = Matrix4::ZERO;
+    request.projection_.m11_ = (1.0f / (size * 0.5f));
+    request.projection_.m00_ = request.projection_.m11_ / aspectRatio;
+    request.projection_.m22_ = 1.0f / depth;
+    request.projection_.m33_ = 1.0f;
+
+    request.topLeftUV_ = topLeftUV;
+    request.bottomRightUV_ = bottomRightUV;
+    request.timeToLive_ = timeToLive;
+    request.decalTransform_ = skinned_
+        ? Matrix3x4::IDENTITY
+        : node_->GetWorldTransform().Inverse() * target->GetNode()->GetWorldTransform();
+    request.generation_ = asyncGeneration_;
+
+    // Static geometry is looked up via cached triangle trees
+    if (!skinned_)
+    {
+        const unsigned numBatches = target->GetBatches().size();
+        const unsigned beginBatch = subGeometry < numBatches ? subGeometry : 0;
+        const unsigned endBatch = subGeometry < numBatches ? subGeometry + 1 : numBatches;
+        for (unsigned i = beginBatch; i < endBatch; ++i)
+        {
+            // Try to use the most accurate LOD level if possible
+            Geometry* geometry = target->GetLodGeometry(i, 0);
+            if (!geometry || geometry->GetPrimitiveType() != TRIANGLE_LIST)
+                continue;
 
-    Vector3 decalNormal = (targetTransform * (worldRotation * Vector3::BACK).ToVector4()).Normalized();
+            if (SharedPtr<DecalTriangleTree> tree = DecalTriangleTree::GetOrCreate(geometry))
+                request.triangleTrees_.push_back(tree);
+            else
+                URHO3D_LOGWARNING("Can not add decal, target drawable has no CPU-side geometry data");
+        }
+    }
 
-    decals_.resize(decals_.size() + 1);
-    Decal& newDecal = decals_.back();
-    newDecal.timeToLive_ = timeToLive;
+    return true;
+}
+
+void DecalSet::GenerateStaticDecal(Decal& decal, const DecalRequest& request)
+{
+    decal.timeToLive_ = request.timeToLive_;
+
+    ea::vector<ea::vector<DecalVertex>> faces;
+    for (const DecalTriangleTree* tree : request.triangleTrees_)
+        GetTreeFaces(faces, *tree, request.frustum_, request.decalNormal_, request.normalCutoff_);
+
+    ClipAndTriangulate(decal, faces, request.frustum_, false);
+    if (decal.vertices_.empty())
+        return;
+
+    CalculateUVs(decal, request.frustumTransform_.Inverse(), request.projection_, request.topLeftUV_, request.bottomRightUV_);
+
+    // Transform vertices to this node's local space and generate tangents
+    TransformVertices(decal, request.decalTransform_);
+    GenerateTangents(&decal.vertices_[0], sizeof(DecalVertex), &decal.indices_[0], sizeof(unsigned short), 0,
+        decal.indices_.size(), offsetof(DecalVertex, normal_), offsetof(DecalVertex, texCoord_), offsetof(DecalVertex,
+        tangent_));
+
+    decal.CalculateBoundingBox();
+}
+
+void DecalSet::GenerateSkinnedDecal(Decal& decal, Drawable* target, const DecalRequest& request, unsigned subGeometry)
+{
+    decal.timeToLive_ = request.timeToLive_;
 
     ea::vector<ea::vector<DecalVertex> > faces;
-    ea::vector<DecalVertex> tempFace;
 
     unsigned numBatches = target->GetBatches().size();
 
     // Use either a specified subgeometry in the target, or all
     if (subGeometry < numBatches)
-        GetFaces(faces, target, subGeometry, decalFrustum, decalNormal, normalCutoff);
+        GetFaces(faces, target, subGeometry, request.frustum_, request.decalNormal_, request.normalCutoff_);
     else
     {
         for (unsigned i = 0; i < numBatches; ++i)
-            GetFaces(faces, target, i, decalFrustum, decalNormal, normalCutoff);
+            GetFaces(faces, target, i, request.frustum_, request.decalNormal_, request.normalCutoff_);
     }
 
-    // Clip the acquired faces against all frustum planes
-    for (const auto& plane : decalFrustum.planes_)
-    {
-        for (unsigned j = 0; j < faces.size(); ++j)
-        {
-            ea::vector<DecalVertex>& face = faces[j];
-            if (face.empty())
-                continue;
+    ClipAndTriangulate(decal, faces, request.frustum_, true);
+    if (decal.vertices_.empty())
+        return;
 
-            ClipPolygon(tempFace, face, plane, skinned_);
-            face = tempFace;
-        }
-    }
+    CalculateUVs(decal, request.frustumTransform_.Inverse(), request.projection_, request.topLeftUV_, request.bottomRightUV_);
 
-    // Now triangulate the resulting faces into decal vertices
-    for (unsigned i = 0; i < faces.size(); ++i)
-    {
-        ea::vector<DecalVertex>& face = faces[i];
-        if (face.size() < 3)
-            continue;
+    // Skinned decals stay in the bind pose space and generate tangents
+    TransformVertices(decal, request.decalTransform_);
+    GenerateTangents(&decal.vertices_[0], sizeof(DecalVertex), &decal.indices_[0], sizeof(unsigned short), 0,
+        decal.indices_.size(), offsetof(DecalVertex, normal_), offsetof(DecalVertex, texCoord_), offsetof(DecalVertex,
+        tangent_));
 
-        for (unsigned j = 2; j < face.size(); ++j)
-        {
-            newDecal.AddVertex(face[0]);
-            newDecal.AddVertex(face[j - 1]);
-            newDecal.AddVertex(face[j]);
-        }
-    }
+    decal.CalculateBoundingBox();
+}
 
+bool DecalSet::CommitDecal(Decal& decal)
+{
     // Check if resulted in no triangles
-    if (newDecal.vertices_.empty())
-    {
-        decals_.pop_back();
+    if (decal.vertices_.empty())
         return true;
-    }
 
-    if (newDecal.vertices_.size() > maxVertices_)
+    if (decal.vertices_.size() > maxVertices_)
     {
-        URHO3D_LOGWARNING("Can not add decal, vertex count " + ea::to_string(newDecal.vertices_.size()) + " exceeds maximum " +
+        URHO3D_LOGWARNING("Can not add decal, vertex count " + ea::to_string(decal.vertices_.size()) + " exceeds maximum " +
                    ea::to_string(maxVertices_));
-        decals_.pop_back();
         return false;
     }
-    if (newDecal.indices_.size() > maxIndices_)
+    if (decal.indices_.size() > maxIndices_)
     {
-        URHO3D_LOGWARNING("Can not add decal, index count " + ea::to_string(newDecal.indices_.size()) + " exceeds maximum " +
+        URHO3D_LOGWARNING("Can not add decal, index count " + ea::to_string(decal.indices_.size()) + " exceeds maximum " +
                    ea::to_string(maxIndices_));
-        decals_.pop_back();
         return false;
     }
 
-    // Calculate UVs
-    Matrix4 projection(Matrix4::ZERO);
-    projection.m11_ = (1.0f / (size * 0.5f));
-    projection.m00_ = projection.m11_ / aspectRatio;
-    projection.m22_ = 1.0f / depth;
-    projection.m33_ = 1.0f;
-
-    CalculateUVs(newDecal, frustumTransform.Inverse(), projection, topLeftUV, bottomRightUV);
-
-    // Transform vertices to this node's local space and generate tangents
-    Matrix3x4 decalTransform = node_->GetWorldTransform().Inverse() * target->GetNode()->GetWorldTransform();
-    TransformVertices(newDecal, skinned_ ? Matrix3x4::IDENTITY : decalTransform);
-    GenerateTangents(&newDecal.vertices_[0], sizeof(DecalVertex), &newDecal.indices_[0], sizeof(unsigned short), 0,
-        newDecal.indices_.size(), offsetof(DecalVertex, normal_), offsetof(DecalVertex, texCoord_), offsetof(DecalVertex,
-        tangent_));
-
-    newDecal.CalculateBoundingBox();
+    decals_.push_back(ea::move(decal));
+    Decal& newDecal = decals_.back();
     numVertices_ += newDecal.vertices_.size();
     numIndices_ += newDecal.indices_.size();
 
@@ -478,6 +952,40 @@ bool DecalSet::AddDecal(Drawable* target, const Vector3& worldPosition, const Qu
     return true;
 }
 
+void DecalSet::StartAsyncDecal(const DecalRequest& request)
+{
+    ++numAsyncDecals_;
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    const WeakPtr<DecalSet> weakSelf{this};
+    workQueue->PostTask([=]()
+    {
+        auto decal = ea::make_shared<Decal>();
+        GenerateStaticDecal(*decal, request);
+
+        workQueue->PostTaskForMainThread([=]()
+        {
+            if (weakSelf)
+                weakSelf->FinishAsyncDecal(*decal, request.generation_);
+        });
+    });
+}
+
+void DecalSet::FinishAsyncDecal(Decal& decal, unsigned generation)
+{
+    --numAsyncDecals_;
+
+    // Discard decals requested before all decals were removed
+    if (generation == asyncGeneration_ && !skinned_)
+        CommitDecal(decal);
+
+    while (numAsyncDecals_ < maxAsyncDecals_ && !queuedDecals_.empty())
+    {
+        StartAsyncDecal(queuedDecals_.front());
+        queuedDecals_.pop_front();
+    }
+}
+
 void DecalSet::RemoveDecals(unsigned num)
 {
     while (num-- && decals_.size())
@@ -486,6 +994,10 @@ void DecalSet::RemoveDecals(unsigned num)
 
 void DecalSet::RemoveAllDecals()
 {
+    // Discard decals that are being generated
+    ++asyncGeneration_;
+    queuedDecals_.clear();
+
     if (!decals_.empty())
     {
         decals_.clear();
@@ -953,30 +1465,6 @@ bool DecalSet::GetBones(Drawable* target, unsigned batchIndex, const float* blen
     return true;
 }
 
-void DecalSet::CalculateUVs(Decal& decal, const Matrix3x4& view, const Matrix4& projection, const Vector2& topLeftUV,
-    const Vector2& bottomRightUV)
-{
-    Matrix4 viewProj = projection * view;
-
-    for (auto i = decal.vertices_.begin(); i != decal.vertices_.end(); ++i)
-    {
-        Vector3 projected = viewProj * i->position_;
-        i->texCoord_ = Vector2(
-            Lerp(topLeftUV.x_, bottomRightUV.x_, projected.x_ * 0.5f + 0.5f),
-            Lerp(bottomRightUV.y_, topLeftUV.y_, projected.y_ * 0.5f + 0.5f)
-        );
-    }
-}
-
-void DecalSet::TransformVertices(Decal& decal, const Matrix3x4& transform)
-{
-    for (auto i = decal.vertices_.begin(); i != decal.vertices_.end(); ++i)
-    {
-        i->position_ = transform * i->position_;
-        i->normal_ = (transform * i->normal_.ToVector4()).Normalized();
-    }
-}
-
 ea::list<Decal>::iterator DecalSet::RemoveDecal(ea::list<Decal>::iterator i)
 {
     numVertices_ -= i->vertices_.size();
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <EASTL/list.h>
+#include <EASTL/span.h>
 
 #include "../Graphics/Drawable.h"
 #include "../Graphics/Skeleton.h"
@@ -31,6 +32,7 @@
 namespace Urho3D
 {
 
+class Geometry;
 class IndexBuffer;
 class VertexBuffer;
 
@@ -100,6 +102,62 @@ struct URHO3D_API Decal
     ea::vector<unsigned short> indices_;
 };
 
+/// Bounding volume hierarchy of geometry triangles, used to find decal faces without testing every triangle.
+/// Keeps a copy of vertex positions and normals, so it may be used from worker threads.
+class URHO3D_API DecalTriangleTree : public RefCounted
+{
+public:
+    /// Tree node. Triangles of the node and all its children are stored contiguously.
+    struct Node
+    {
+        /// Bounding box of the node triangles.
+        BoundingBox boundingBox_;
+        /// First triangle of the node.
+        unsigned firstTriangle_{};
+        /// Number of triangles in the node.
+        unsigned numTriangles_{};
+        /// Index of the second child node, or 0 for leaf node. First child always follows the node.
+        unsigned secondChild_{};
+    };
+
+    /// Max number of triangles in leaf node.
+    static const unsigned MaxLeafTriangles = 8;
+
+    /// Define from triangle list geometry. Return false if the geometry has no CPU-side data.
+    bool Define(Geometry* geometry);
+    /// Define from vertex positions, optional vertex normals and triangle list indices.
+    void Define(ea::span<const Vector3> positions, ea::span<const Vector3> normals, ea::span<const unsigned> indices);
+    /// Return triangles which may intersect the frustum.
+    void GetTriangles(ea::vector<unsigned>& triangles, const Frustum& frustum) const;
+
+    /// Return cached tree for the geometry or create new one. Return null if the geometry has no CPU-side data.
+    static SharedPtr<DecalTriangleTree> GetOrCreate(Geometry* geometry);
+
+    /// Return vertex positions.
+    const ea::vector<Vector3>& GetPositions() const { return positions_; }
+    /// Return vertex normals. Empty if the geometry has no normals.
+    const ea::vector<Vector3>& GetNormals() const { return normals_; }
+    /// Return triangle list indices, ordered by nodes.
+    const ea::vector<unsigned>& GetIndices() const { return indices_; }
+    /// Return tree nodes. First node is root.
+    const ea::vector<Node>& GetNodes() const { return nodes_; }
+    /// Return number of triangles.
+    unsigned GetNumTriangles() const { return indices_.size() / 3; }
+
+private:
+    /// Build node for given range of triangles. Return node index.
+    unsigned BuildNode(ea::span<unsigned> triangles, unsigned firstTriangle, const ea::vector<Vector3>& centers);
+
+    /// Vertex positions.
+    ea::vector<Vector3> positions_;
+    /// Vertex normals.
+    ea::vector<Vector3> normals_;
+    /// Triangle list indices.
+    ea::vector<unsigned> indices_;
+    /// Tree nodes.
+    ea::vector<Node> nodes_;
+};
+
 /// %Decal renderer component.
 class URHO3D_API DecalSet : public Drawable
 {
@@ -138,6 +196,9 @@ public:
     /// Set maximum number of decal vertex indices.
     /// @property
     void SetMaxIndices(unsigned num);
+    /// Set max number of decals generated in worker threads at once.
+    /// @property
+    void SetMaxAsyncDecals(unsigned num) { maxAsyncDecals_ = ea::max(num, 1u); }
     /// Set whether to optimize GPU buffer sizes according to current amount of decals. Default false, which will size the buffers according to the maximum vertices/indices. When true, buffers will be reallocated whenever decals are added/removed, which can be worse for performance.
     /// @property
     void SetOptimizeBufferSize(bool enable);
@@ -145,6 +206,12 @@ public:
     bool AddDecal(Drawable* target, const Vector3& worldPosition, const Quaternion& worldRotation, float size, float aspectRatio,
         float depth, const Vector2& topLeftUV, const Vector2& bottomRightUV, float timeToLive = 0.0f, float normalCutoff = 0.1f,
         unsigned subGeometry = M_MAX_UNSIGNED);
+    /// Add a decal asynchronously. Faces of the target are found and clipped in a worker thread and the decal appears
+    /// when the work is done, at most "max async decals" are generated at once and the rest wait in queue.
+    /// Decals on animated models are added immediately. Return false if the decal can not be added.
+    bool AddDecalAsync(Drawable* target, const Vector3& worldPosition, const Quaternion& worldRotation, float size,
+        float aspectRatio, float depth, const Vector2& topLeftUV, const Vector2& bottomRightUV, float timeToLive = 0.0f,
+        float normalCutoff = 0.1f, unsigned subGeometry = M_MAX_UNSIGNED);
     /// Remove n oldest decals.
     void RemoveDecals(unsigned num);
     /// Remove all decals.
@@ -174,6 +241,13 @@ public:
     /// @property
     unsigned GetMaxIndices() const { return maxIndices_; }
 
+    /// Return max number of decals generated in worker threads at once.
+    /// @property
+    unsigned GetMaxAsyncDecals() const { return maxAsyncDecals_; }
+
+    /// Return number of decals being generated asynchronously or waiting in queue.
+    unsigned GetNumPendingDecals() const { return numAsyncDecals_ + queuedDecals_.size(); }
+
     /// Return whether is optimizing GPU buffer sizes according to current amount of decals.
     /// @property
     bool GetOptimizeBufferSize() const { return optimizeBufferSize_; }
@@ -194,6 +268,47 @@ protected:
     void OnMarkedDirty(Node* node) override;
 
 private:
+    /// Decal placement calculated in the main thread.
+    struct DecalRequest
+    {
+        /// Decal frustum in the target space.
+        Frustum frustum_;
+        /// Decal frustum transform in the target space.
+        Matrix3x4 frustumTransform_;
+        /// Decal projection.
+        Matrix4 projection_;
+        /// Decal normal in the target space.
+        Vector3 decalNormal_;
+        /// Faces with normals too far from the decal normal are ignored.
+        float normalCutoff_{};
+        /// Top left texture coordinates.
+        Vector2 topLeftUV_;
+        /// Bottom right texture coordinates.
+        Vector2 bottomRightUV_;
+        /// Time to live.
+        float timeToLive_{};
+        /// Transform from the target space to the decal set space.
+        Matrix3x4 decalTransform_;
+        /// Triangle trees of the target geometries. Used only for static targets.
+        ea::vector<SharedPtr<DecalTriangleTree>> triangleTrees_;
+        /// Async generation counter at the moment of the request.
+        unsigned generation_{};
+    };
+
+    /// Calculate decal placement. Switches skinned mode if necessary. Return false on error.
+    bool PrepareDecal(DecalRequest& request, Drawable* target, const Vector3& worldPosition, const Quaternion& worldRotation,
+        float size, float aspectRatio, float depth, const Vector2& topLeftUV, const Vector2& bottomRightUV, float timeToLive,
+        float normalCutoff, unsigned subGeometry);
+    /// Generate decal on static geometry. Safe to call from worker threads.
+    static void GenerateStaticDecal(Decal& decal, const DecalRequest& request);
+    /// Generate decal on animated model.
+    void GenerateSkinnedDecal(Decal& decal, Drawable* target, const DecalRequest& request, unsigned subGeometry);
+    /// Add generated decal to the set. Return false if the decal is too big.
+    bool CommitDecal(Decal& decal);
+    /// Start generating decal in a worker thread.
+    void StartAsyncDecal(const DecalRequest& request);
+    /// Handle decal generated in a worker thread.
+    void FinishAsyncDecal(Decal& decal, unsigned generation);
     /// Get triangle faces from the target geometry.
     void GetFaces(ea::vector<ea::vector<DecalVertex> >& faces, Drawable* target, unsigned batchIndex, const Frustum& frustum,
         const Vector3& decalNormal, float normalCutoff);
@@ -206,11 +321,6 @@ private:
     /// Get bones referenced by skinning data and remap the skinning indices. Return true if successful.
     bool GetBones(Drawable* target, unsigned batchIndex, const float* blendWeights, const unsigned char* blendIndices,
         unsigned char* newBlendIndices);
-    /// Calculate UV coordinates for the decal.
-    void CalculateUVs
-        (Decal& decal, const Matrix3x4& view, const Matrix4& projection, const Vector2& topLeftUV, const Vector2& bottomRightUV);
-    /// Transform decal's vertices from the target geometry to the decal set local space.
-    void TransformVertices(Decal& decal, const Matrix3x4& transform);
     /// Remove a decal by iterator and return iterator to the next decal.
     ea::list<Decal>::iterator RemoveDecal(ea::list<Decal>::iterator i);
     /// Mark decals and the bounding box dirty.
@@ -264,6 +374,14 @@ private:
     bool assignBonesPending_;
     /// Subscribed to scene post update event flag.
     bool subscribed_;
+    /// Max number of decals generated in worker threads at once.
+    unsigned maxAsyncDecals_{4};
+    /// Number of decals being generated in worker threads.
+    unsigned numAsyncDecals_{};
+    /// Incremented when all decals are removed, so decals requested before are discarded.
+    unsigned asyncGeneration_{};
+    /// Decals waiting for generation in worker threads.
+    ea::list<DecalRequest> queuedDecals_;
 };
 
 }
@@ -173,8 +173,8 @@ struct URHO3D_API SourceBatch
     const Matrix3x4* worldTransform_{&Matrix3x4::IDENTITY};
     /// Number of world transforms.
     unsigned numWorldTransforms_{1};
-    /// Per-instance data. If not null, must contain enough data to fill instancing buffer.
-    void* instancingData_{};
+    /// Optional custom per-instance data, one element per world transform. Exposed to shaders as cInstanceData.
+    const Vector4* instancingData_{};
     /// %Geometry type.
     GeometryType geometryType_{GEOM_STATIC};
     /// Lightmap UV scale and offset.
@@ -232,6 +232,7 @@ public:
     virtual void UpdateGeometry(const FrameInfo& frame) { }
 
     /// Return whether a geometry update is necessary, and if it can happen in a worker thread.
+    /// If main thread update is requested after update in a worker thread, UpdateGeometry is called again from main thread.
     virtual UpdateGeometryType GetUpdateGeometryType() { return UPDATE_NONE; }
 
     /// Return the geometry for a specific LOD level.
@@ -388,6 +389,9 @@ public:
     /// Return whether the drawable is added to Octree.
     bool IsInOctree() const { return drawableIndex_ != M_MAX_UNSIGNED; }
 
+    /// Return revision that is incremented every time Octree processes queued update of the drawable.
+    unsigned GetUpdateRevision() const { return updateRevision_; }
+
     /// Return current zone.
     /// @property
     Zone* GetZone() const { return cachedZone_.zone_; }
@@ -516,6 +520,8 @@ protected:
     Octant* octant_;
     /// Index of Drawable in Scene. May be updated.
     unsigned drawableIndex_{ M_MAX_UNSIGNED };
+    /// Number of queued updates processed by Octree.
+    unsigned updateRevision_{};
     /// Current zone.
     CachedDrawableZone cachedZone_;
     /// Current reflection.
@@ -95,7 +95,7 @@ void Geometry::SetVertexBuffers(const ea::vector<SharedPtr<VertexBuffer>>& verte
 
 void Geometry::SetIndexBuffer(IndexBuffer* buffer)
 {
-    indexBufferDependency_ = CreateDependency(indexBuffer_);
+    indexBufferDependency_ = CreateDependency(buffer);
     indexBuffer_ = buffer;
 }
 
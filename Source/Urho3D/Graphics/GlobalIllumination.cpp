@@ -125,6 +125,12 @@ SphericalHarmonicsDot9 GlobalIllumination::SampleAmbientSH(const Vector3& positi
     return lightProbesMesh_.Sample(lightProbesBakedData_.sphericalHarmonics_, position, hint);
 }
 
+void GlobalIllumination::SampleAmbientSH(ea::span<const Vector3> positions, ea::span<SphericalHarmonicsDot9> results,
+    ea::span<unsigned> hints) const
+{
+    lightProbesMesh_.Sample(lightProbesBakedData_.sphericalHarmonics_, positions, results, hints);
+}
+
 Vector3 GlobalIllumination::SampleAverageAmbient(const Vector3& position, unsigned& hint) const
 {
     return lightProbesMesh_.Sample(lightProbesBakedData_.ambient_, position, hint);
@@ -57,6 +57,9 @@ public:
 
     /// Sample ambient spherical harmonics.
     SphericalHarmonicsDot9 SampleAmbientSH(const Vector3& position, unsigned& hint) const;
+    /// Sample ambient spherical harmonics for multiple positions at once. Spans should have the same size.
+    void SampleAmbientSH(ea::span<const Vector3> positions, ea::span<SphericalHarmonicsDot9> results,
+        ea::span<unsigned> hints) const;
     /// Sample average ambient lighting.
     Vector3 SampleAverageAmbient(const Vector3& position, unsigned& hint) const;
 
@@ -27,7 +27,9 @@
 #include "../Graphics/AnimatedModel.h"
 #include "../Graphics/Animation.h"
 #include "../Graphics/AnimationController.h"
+#include "../Graphics/AnimationControllerManager.h"
 #include "../Graphics/Camera.h"
+#include "../Graphics/CrowdModel.h"
 #include "../Graphics/Geometry.h"
 #include "../Graphics/CustomGeometry.h"
 #include "../Graphics/DebugRenderer.h"
@@ -35,6 +37,7 @@
 #include "../Graphics/GlobalIllumination.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/GraphicsEvents.h"
+#include "../Graphics/HierarchicalLod.h"
 #include "../Graphics/IndexBuffer.h"
 #include "../Graphics/LightBaker.h"
 #include "../Graphics/LightProbeGroup.h"
@@ -44,6 +47,8 @@
 #include "../Graphics/OutlineGroup.h"
 #include "../Graphics/ParticleEffect.h"
 #include "../Graphics/ParticleEmitter.h"
+#include "../Graphics/PipelineStateManifest.h"
+#include "../Graphics/PrecomputedVisibility.h"
 #include "../Graphics/ReflectionProbe.h"
 #include "../Graphics/RibbonTrail.h"
 #include "../Graphics/Shader.h"
@@ -52,6 +57,7 @@
 #include "../Graphics/Technique.h"
 #include "../Graphics/Terrain.h"
 #include "../Graphics/TerrainPatch.h"
+#include "../Graphics/TerrainStreamer.h"
 #include "../Graphics/Texture2D.h"
 #include "../Graphics/Texture2DArray.h"
 #include "../Graphics/Texture3D.h"
@@ -68,6 +74,8 @@
 #include "Urho3D/RenderAPI/RenderDevice.h"
 #include "Urho3D/Resource/ResourceCache.h"
 
+#include <Diligent/Graphics/GraphicsEngine/interface/DeviceContext.h>
+
 #include <SDL.h>
 
 #include "../DebugNew.h"
@@ -227,6 +235,9 @@ bool Graphics::BeginFrame()
             return false;
     }
 
+    // Frame should be presented before the next one is recorded
+    PresentPendingFrame();
+
     SendEvent(E_BEGINRENDERING);
     return true;
 }
@@ -236,6 +247,17 @@ void Graphics::EndFrame()
     if (!IsInitialized())
         return;
 
+    if (settings_.pipelinedPresent_)
+    {
+        URHO3D_PROFILE("SubmitFrame");
+
+        SendEvent(E_ENDRENDERING);
+
+        renderDevice_->GetImmediateContext()->Flush();
+        presentPending_ = true;
+        return;
+    }
+
     {
         URHO3D_PROFILE("Present");
 
@@ -245,6 +267,16 @@ void Graphics::EndFrame()
     }
 }
 
+void Graphics::PresentPendingFrame()
+{
+    if (!presentPending_ || !IsInitialized())
+        return;
+
+    URHO3D_PROFILE("Present");
+    presentPending_ = false;
+    renderDevice_->Present();
+}
+
 void Graphics::SetWindowTitle(const ea::string& windowTitle)
 {
     windowTitle_ = windowTitle;
@@ -711,9 +743,13 @@ void RegisterGraphicsLibrary(Context* context)
     GlobalIllumination::RegisterObject(context);
     StaticModel::RegisterObject(context);
     StaticModelGroup::RegisterObject(context);
+    HierarchicalLod::RegisterObject(context);
+    PrecomputedVisibility::RegisterObject(context);
+    CrowdModel::RegisterObject(context);
     Skybox::RegisterObject(context);
     AnimatedModel::RegisterObject(context);
     AnimationController::RegisterObject(context);
+    AnimationControllerManager::RegisterObject(context);
     BillboardSet::RegisterObject(context);
     ParticleEffect::RegisterObject(context);
     ParticleEmitter::RegisterObject(context);
@@ -722,6 +758,7 @@ void RegisterGraphicsLibrary(Context* context)
     DecalSet::RegisterObject(context);
     Terrain::RegisterObject(context);
     TerrainPatch::RegisterObject(context);
+    TerrainStreamer::RegisterObject(context);
     DebugRenderer::RegisterObject(context);
     Octree::RegisterObject(context);
     OutlineGroup::RegisterObject(context);
@@ -729,6 +766,7 @@ void RegisterGraphicsLibrary(Context* context)
     Geometry::RegisterObject(context);
     Viewport::RegisterObject(context);
     OcclusionBuffer::RegisterObject(context);
+    PipelineStateManifest::RegisterObject(context);
     ReflectionProbe::RegisterObject(context);
     ReflectionProbeManager::RegisterObject(context);
 }
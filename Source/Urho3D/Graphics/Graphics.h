@@ -68,6 +68,8 @@ struct GraphicsSettings : public RenderDeviceSettings
 
     /// Directory to store cached compiled shaders and logged shader sources.
     FileIdentifier shaderCacheDir_;
+    /// Read-only directory with bytecode cooked by ShaderCooker, usually shipped in resources.
+    FileIdentifier cookedShaderCacheDir_;
     /// Whether to log all compiled shaders.
     bool logShaderSources_{};
     /// Whether the shader validation is enabled.
@@ -76,6 +78,13 @@ struct GraphicsSettings : public RenderDeviceSettings
     bool discardShaderCache_{};
     /// Whether to cache shaders compiled during this run on the disk.
     bool cacheShaders_{};
+    /// Whether to compile shaders missing in the cache on worker threads.
+    /// Pipeline states that use such shaders are invalid until compilation is finished.
+    bool asyncShaderCompilation_{};
+    /// Whether to postpone presentation of the frame until logic update of the next frame is finished.
+    /// Rendered frame is submitted to GPU at the end of frame rendering, so GPU works on it
+    /// while the next frame is updated. Adds one frame of presentation latency.
+    bool pipelinedPresent_{};
 };
 
 /// %Graphics subsystem. Manages the application window, rendering state and GPU resources.
@@ -132,7 +141,11 @@ public:
     /// Begin frame rendering. Return true if device available and can render.
     bool BeginFrame();
     /// End frame rendering and swap buffers.
+    /// If pipelined presentation is enabled, only submit the frame and postpone swapping buffers.
     void EndFrame();
+    /// Swap buffers of the frame postponed by EndFrame, if any.
+    /// Called by Engine after logic update and before any GPU resources are updated for the next frame.
+    void PresentPendingFrame();
     /// Clear any or all of rendertarget, depth buffer and stencil buffer.
     void Clear(ClearTargetFlags flags, const Color& color = Color::TRANSPARENT_BLACK, float depth = 1.0f, unsigned stencil = 0);
 
@@ -306,6 +319,8 @@ private:
     WindowSettings secondaryWindowSettings_;
     /// Window position.
     IntVector2 position_;
+    /// Whether the frame is submitted but not presented yet.
+    bool presentPending_{};
     /// ETC1 format support flag.
     bool etcTextureSupport_{};
     /// ETC2 format support flag.
@@ -0,0 +1,242 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Graphics/HierarchicalLod.h"
+
+#include "../Core/Context.h"
+#include "../Core/Timer.h"
+#include "../Graphics/Camera.h"
+#include "../Graphics/GraphicsEvents.h"
+#include "../Graphics/StaticModel.h"
+#include "../Scene/Node.h"
+#include "../Scene/Scene.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+void SetStaticModelsEnabled(Node* node, bool enabled)
+{
+    for (Component* component : node->GetComponents())
+    {
+        if (component->IsInstanceOf<StaticModel>())
+            component->SetEnabled(enabled);
+    }
+}
+
+}
+
+HierarchicalLod::HierarchicalLod(Context* context)
+    : Component(context)
+{
+}
+
+HierarchicalLod::~HierarchicalLod() = default;
+
+void HierarchicalLod::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<HierarchicalLod>(Category_Geometry);
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, bool, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Distance", GetDistance, SetDistance, float, DefaultDistance, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Hysteresis", GetHysteresis, SetHysteresis, float, DefaultHysteresis, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Detailed Nodes", GetNodeIDsAttr, SetNodeIDsAttr,
+        VariantVector, Variant::emptyVariantVector, AM_DEFAULT | AM_NODEIDVECTOR);
+}
+
+void HierarchicalLod::ApplyAttributes()
+{
+    if (!nodesDirty_)
+        return;
+
+    // Detailed nodes may be replaced, make sure that old nodes are not left hidden
+    const bool proxyShown = proxyShown_;
+    SetProxyShown(false);
+    detailedNodes_.clear();
+
+    if (Scene* scene = GetScene())
+    {
+        // The first index stores the number of IDs redundantly. This is for editing
+        for (unsigned i = 1; i < nodeIDsAttr_.size(); ++i)
+        {
+            if (Node* node = scene->GetNode(nodeIDsAttr_[i].GetUInt()))
+                detailedNodes_.emplace_back(node);
+        }
+    }
+
+    nodesDirty_ = false;
+    SetProxyShown(proxyShown);
+}
+
+void HierarchicalLod::OnSetEnabled()
+{
+    if (!IsEnabledEffective())
+        SetProxyShown(false);
+}
+
+void HierarchicalLod::AddDetailedNode(Node* node)
+{
+    if (!node)
+        return;
+
+    for (const WeakPtr<Node>& detailedNode : detailedNodes_)
+    {
+        if (detailedNode == node)
+            return;
+    }
+
+    detailedNodes_.emplace_back(node);
+    nodeIDsDirty_ = true;
+
+    if (proxyShown_)
+    {
+        SetStaticModelsEnabled(node, false);
+    }
+}
+
+void HierarchicalLod::RemoveAllDetailedNodes()
+{
+    SetProxyShown(false);
+    detailedNodes_.clear();
+    nodeIDsDirty_ = true;
+}
+
+void HierarchicalLod::SetProxyShown(bool show)
+{
+    if (proxyShown_ == show)
+        return;
+
+    proxyShown_ = show;
+
+    if (auto proxy = GetComponent<StaticModel>())
+        proxy->SetEnabled(show);
+
+    for (Node* node : detailedNodes_)
+    {
+        if (node)
+            SetStaticModelsEnabled(node, !show);
+    }
+}
+
+void HierarchicalLod::UpdateLod(const Camera* camera)
+{
+    if (!camera || !IsEnabledEffective())
+        return;
+
+    Vector3 center = node_->GetWorldPosition();
+    auto proxy = GetComponent<StaticModel>();
+    if (proxy && proxy->GetModel())
+        center = proxy->GetWorldBoundingBox().Center();
+
+    const float distance = camera->GetLodDistance(camera->GetDistance(center), 1.0f, 1.0f);
+    if (!proxyShown_ && distance > distance_)
+        SetProxyShown(true);
+    else if (proxyShown_ && distance < distance_ * (1.0f - hysteresis_))
+        SetProxyShown(false);
+}
+
+Node* HierarchicalLod::GetDetailedNode(unsigned index) const
+{
+    return index < detailedNodes_.size() ? detailedNodes_[index].Get() : nullptr;
+}
+
+void HierarchicalLod::SetNodeIDsAttr(const VariantVector& value)
+{
+    // Just remember the node IDs. They need to go through the SceneResolver, and we actually find the nodes during
+    // ApplyAttributes()
+    nodeIDsAttr_.clear();
+    if (value.size())
+    {
+        unsigned index = 0;
+        unsigned numNodes = value[index++].GetUInt();
+        // Prevent crash on entering negative value in the editor
+        if (numNodes > M_MAX_INT)
+            numNodes = 0;
+
+        nodeIDsAttr_.push_back(numNodes);
+        while (numNodes--)
+        {
+            // If vector contains less IDs than should, fill the rest with zeroes
+            if (index < value.size())
+                nodeIDsAttr_.push_back(value[index++].GetUInt());
+            else
+                nodeIDsAttr_.push_back(0);
+        }
+    }
+    else
+        nodeIDsAttr_.push_back(0);
+
+    nodesDirty_ = true;
+    nodeIDsDirty_ = false;
+}
+
+const VariantVector& HierarchicalLod::GetNodeIDsAttr() const
+{
+    if (nodeIDsDirty_)
+        UpdateNodeIDs();
+
+    return nodeIDsAttr_;
+}
+
+void HierarchicalLod::OnSceneSet(Scene* scene)
+{
+    if (scene)
+        SubscribeToEvent(E_BEGINVIEWUPDATE, &HierarchicalLod::HandleBeginViewUpdate);
+    else
+        UnsubscribeFromEvent(E_BEGINVIEWUPDATE);
+}
+
+void HierarchicalLod::HandleBeginViewUpdate(StringHash eventType, VariantMap& eventData)
+{
+    using namespace BeginViewUpdate;
+
+    if (eventData[P_SCENE].GetPtr() != GetScene())
+        return;
+
+    // Select LOD once per frame so multiple views don't fight over the shared state
+    const unsigned frameNumber = GetSubsystem<Time>()->GetFrameNumber();
+    if (lastUpdateFrame_ == frameNumber)
+        return;
+
+    lastUpdateFrame_ = frameNumber;
+    UpdateLod(static_cast<Camera*>(eventData[P_CAMERA].GetPtr()));
+}
+
+void HierarchicalLod::UpdateNodeIDs() const
+{
+    nodeIDsAttr_.clear();
+    nodeIDsAttr_.push_back(detailedNodes_.size());
+
+    for (Node* node : detailedNodes_)
+        nodeIDsAttr_.push_back(node ? node->GetID() : 0);
+
+    nodeIDsDirty_ = false;
+}
+
+}
@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Scene/Component.h"
+
+namespace Urho3D
+{
+
+class Camera;
+class StaticModel;
+
+/// Hierarchical LOD of a group of static objects.
+/// Shows the proxy StaticModel of the same node when the group is far from the camera,
+/// and StaticModels of detailed nodes otherwise. Hidden models are disabled, so they are not processed by Octree.
+/// LOD is selected once per frame by the first view of the scene. Proxies are usually generated by StaticModelMerger.
+class URHO3D_API HierarchicalLod : public Component
+{
+    URHO3D_OBJECT(HierarchicalLod, Component);
+
+public:
+    static constexpr float DefaultDistance = 100.0f;
+    static constexpr float DefaultHysteresis = 0.1f;
+
+    /// Construct.
+    explicit HierarchicalLod(Context* context);
+    /// Destruct.
+    ~HierarchicalLod() override;
+    /// Register object factory.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Apply attribute changes that can not be applied immediately. Called after scene load or a network update.
+    void ApplyAttributes() override;
+    /// Handle enabled/disabled state change.
+    void OnSetEnabled() override;
+
+    /// Set distance from the camera to the proxy bounding box center beyond which the proxy is shown.
+    /// @property
+    void SetDistance(float distance) { distance_ = ea::max(distance, 0.0f); }
+    /// Set fraction of the distance the camera should come closer by to show detailed nodes again.
+    /// @property
+    void SetHysteresis(float hysteresis) { hysteresis_ = Clamp(hysteresis, 0.0f, 1.0f); }
+    /// Add detailed scene node.
+    void AddDetailedNode(Node* node);
+    /// Remove all detailed scene nodes.
+    void RemoveAllDetailedNodes();
+    /// Show proxy or detailed nodes.
+    void SetProxyShown(bool show);
+    /// Select LOD for the camera.
+    void UpdateLod(const Camera* camera);
+
+    /// Return distance beyond which the proxy is shown.
+    /// @property
+    float GetDistance() const { return distance_; }
+    /// Return fraction of the distance the camera should come closer by to show detailed nodes again.
+    /// @property
+    float GetHysteresis() const { return hysteresis_; }
+    /// Return number of detailed nodes.
+    unsigned GetNumDetailedNodes() const { return detailedNodes_.size(); }
+    /// Return detailed node by index.
+    Node* GetDetailedNode(unsigned index) const;
+    /// Return whether the proxy is shown.
+    bool IsProxyShown() const { return proxyShown_; }
+
+    /// Set node IDs attribute.
+    void SetNodeIDsAttr(const VariantVector& value);
+    /// Return node IDs attribute.
+    const VariantVector& GetNodeIDsAttr() const;
+
+protected:
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+
+private:
+    /// Handle beginning of the view update.
+    void HandleBeginViewUpdate(StringHash eventType, VariantMap& eventData);
+    /// Update node IDs attribute from the actual nodes.
+    void UpdateNodeIDs() const;
+
+    float distance_{DefaultDistance};
+    float hysteresis_{DefaultHysteresis};
+
+    /// Detailed nodes.
+    ea::vector<WeakPtr<Node>> detailedNodes_;
+    /// IDs of detailed nodes for serialization.
+    mutable VariantVector nodeIDsAttr_;
+    /// Whether node IDs have been set and nodes should be searched for during ApplyAttributes.
+    bool nodesDirty_{};
+    /// Whether nodes have been manipulated by the API and node ID attribute should be refreshed.
+    mutable bool nodeIDsDirty_{};
+
+    /// Whether the proxy is shown.
+    bool proxyShown_{};
+    /// Frame number when LOD was last selected.
+    unsigned lastUpdateFrame_{M_MAX_UNSIGNED};
+};
+
+}
@@ -45,7 +45,7 @@ void IndexBuffer::SetShadowed(bool enable)
     shadowedPending_ = enable;
 }
 
-bool IndexBuffer::SetSize(unsigned indexCount, bool largeIndices, bool dynamic)
+bool IndexBuffer::SetSize(unsigned indexCount, bool largeIndices, bool dynamic, const void* data)
 {
     indexCount_ = indexCount;
     indexSize_ = (unsigned)(largeIndices ? sizeof(unsigned) : sizeof(unsigned short));
@@ -60,7 +60,7 @@ bool IndexBuffer::SetSize(unsigned indexCount, bool largeIndices, bool dynamic)
     if (dynamic)
         params.flags_ |= BufferFlag::Dynamic;
 
-    return Create(params, nullptr);
+    return Create(params, data);
 }
 
 bool IndexBuffer::GetUsedVertexRange(unsigned start, unsigned count, unsigned& minVertex, unsigned& vertexCount)
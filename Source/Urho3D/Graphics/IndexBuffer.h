@@ -52,7 +52,10 @@ public:
     /// @property
     void SetShadowed(bool enable);
     /// Set size and vertex elements and dynamic mode. Previous data will be lost.
-    bool SetSize(unsigned indexCount, bool largeIndices, bool dynamic = false);
+    /// Optional initial data should contain the whole buffer and cannot be used with dynamic mode.
+    /// Device context is not used for initial data, so it's safe to call from worker thread
+    /// if RenderDeviceCaps::threadedResourceCreation_ is set.
+    bool SetSize(unsigned indexCount, bool largeIndices, bool dynamic = false, const void* data = nullptr);
 
     /// Return whether is dynamic.
     /// @property
@@ -33,10 +33,12 @@
 #include "../Graphics/Renderer.h"
 #include "../Graphics/Skybox.h"
 #include "../Graphics/Zone.h"
+#include "../IO/ArchiveSerialization.h"
 #include "../IO/Log.h"
 #include "../Scene/Scene.h"
 
 #if URHO3D_GLOW
+#include "../Glow/BakedLightCache.h"
 #include "../Glow/IncrementalLightBaker.h"
 #endif
 
@@ -55,6 +57,17 @@ static const char* qualityNames[] =
     nullptr
 };
 
+#if URHO3D_GLOW
+ea::unique_ptr<BakedLightCache> CreateBakedLightCache(Context* context, const IncrementalLightBakerSettings& settings)
+{
+    if (settings.cacheDirectory_.empty())
+        return ea::make_unique<BakedLightMemoryCache>();
+
+    const unsigned long long memoryLimit = static_cast<unsigned long long>(settings.cacheMemoryLimit_) * 1024 * 1024;
+    return ea::make_unique<BakedLightFileCache>(context, settings.cacheDirectory_, memoryLimit);
+}
+#endif
+
 }
 
 /// State of async light baker task.
@@ -69,8 +82,8 @@ struct LightBaker::TaskData
 #if URHO3D_GLOW
     /// Scene collector.
     DefaultBakedSceneCollector sceneCollector_;
-    /// Memory cache
-    BakedLightMemoryCache cache_;
+    /// Light data cache.
+    ea::unique_ptr<BakedLightCache> cache_;
     /// Baker.
     IncrementalLightBaker baker_;
 #endif
@@ -99,6 +112,8 @@ void LightBaker::RegisterObject(Context* context)
     URHO3D_ACTION_DYNAMIC_LABEL("Bake", BakeAsync, GetBakeLabel);
 
     URHO3D_ATTRIBUTE("Output Directory", ea::string, settings_.incremental_.outputDirectory_, "", AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Cache Directory", ea::string, settings_.incremental_.cacheDirectory_, "", AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Cache Memory Limit (MB)", unsigned, settings_.incremental_.cacheMemoryLimit_, defaultSettings.incremental_.cacheMemoryLimit_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Lightmap Size", unsigned, settings_.charting_.lightmapSize_, defaultSettings.charting_.lightmapSize_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Texel Density", float, settings_.charting_.texelDensity_, defaultSettings.charting_.texelDensity_, AM_DEFAULT);
     URHO3D_ENUM_ACCESSOR_ATTRIBUTE("Quality", GetQuality, SetQuality, LightBakingQuality, qualityNames, LightBakingQuality::Custom, AM_DEFAULT);
@@ -107,6 +122,7 @@ void LightBaker::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Indirect Bounces", unsigned, settings_.indirectChartTracing_.maxBounces_, defaultSettings.indirectChartTracing_.maxBounces_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Indirect Samples (Texture)", unsigned, settings_.indirectChartTracing_.maxSamples_, defaultSettings.indirectChartTracing_.maxSamples_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Indirect Samples (Light Probes)", unsigned, settings_.indirectProbesTracing_.maxSamples_, defaultSettings.indirectProbesTracing_.maxSamples_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Indirect Passes", unsigned, settings_.incremental_.numIndirectPasses_, defaultSettings.incremental_.numIndirectPasses_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Filter Radius (Direct)", unsigned, settings_.directFilter_.kernelRadius_, defaultSettings.directFilter_.kernelRadius_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Filter Radius (Indirect)", unsigned, settings_.indirectFilter_.kernelRadius_, defaultSettings.indirectFilter_.kernelRadius_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Chunk Size", Vector3, settings_.incremental_.chunkSize_, defaultSettings.incremental_.chunkSize_, AM_DEFAULT);
@@ -161,6 +177,50 @@ void LightBaker::BakeAsync()
         state_ = InternalState::ScheduledAsync;
 }
 
+ByteVector LightBaker::BakeChunks(const ByteVector& job)
+{
+#if URHO3D_GLOW
+    if (state_ != InternalState::NotStarted)
+    {
+        URHO3D_LOGERROR("Cannot bake chunks while baking is in progress");
+        return {};
+    }
+
+    LightBakingChunkJob chunkJob;
+    try
+    {
+        chunkJob = LightBakingChunkJob::FromBytes(job);
+    }
+    catch (const ArchiveException& e)
+    {
+        URHO3D_LOGERROR("Cannot deserialize light baking job: {}", e.what());
+        return {};
+    }
+
+    if (!UpdateSettings())
+        return {};
+
+    TaskData taskData;
+    taskData.cache_ = CreateBakedLightCache(context_, settings_.incremental_);
+    if (!taskData.baker_.Initialize(settings_, GetScene(), &taskData.sceneCollector_, taskData.cache_.get()))
+    {
+        URHO3D_LOGERROR("Cannot initialize light baking");
+        return {};
+    }
+
+    taskData.baker_.ProcessScene();
+    taskData.baker_.BakeChunks(taskData.stopToken_, chunkJob.chunks_);
+
+    const ByteVector result = taskData.baker_.ExportChunks(chunkJob.chunks_).ToBytes();
+    URHO3D_LOGINFO("Light baking of {} chunks is finished in {} seconds",
+        chunkJob.chunks_.size(), taskData.timer_.GetMSec(false) / 1000);
+    return result;
+#else
+    URHO3D_LOGERROR("Enable URHO3D_GLOW in build options");
+    return {};
+#endif
+}
+
 bool LightBaker::UpdateSettings()
 {
     Scene* scene = GetScene();
@@ -202,7 +262,8 @@ void LightBaker::Update()
 
         auto taskData = ea::make_shared<TaskData>();
         taskData->weakSelf_ = this;
-        if (!taskData->baker_.Initialize(settings_, GetScene(), &taskData->sceneCollector_, &taskData->cache_))
+        taskData->cache_ = CreateBakedLightCache(context_, settings_.incremental_);
+        if (!taskData->baker_.Initialize(settings_, GetScene(), &taskData->sceneCollector_, taskData->cache_.get()))
         {
             URHO3D_LOGERROR("Cannot initialize light baking");
             state_ = InternalState::NotStarted;
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "../Container/ByteVector.h"
 #include "../Graphics/LightBakingSettings.h"
 #include "../Scene/Component.h"
 
@@ -70,6 +71,10 @@ public:
     void Bake();
     /// Bake light in worker thread.
     void BakeAsync();
+    /// Bake lighting for chunks listed in serialized LightBakingChunkJob in main thread.
+    /// Lightmaps are not saved, serialized LightBakingChunkResult is returned instead. Empty on failure.
+    /// Used to distribute baking of the same scene between worker processes.
+    ByteVector BakeChunks(const ByteVector& job);
 
 private:
     /// Baking task data.
@@ -172,8 +172,15 @@ struct IncrementalLightBakerSettings
     float indirectPadding_ = 32.0f;
     /// Shadow casting distance for directional light.
     float directionalLightShadowDistance_ = 128.0f;
+    /// Number of passes of indirect light baking. Samples of lightmap charts are split between passes.
+    /// Lightmaps are saved without seam stitching after each pass except the last one, for preview.
+    unsigned numIndirectPasses_{ 1 };
     /// Output directory name.
     ea::string outputDirectory_;
+    /// Directory for temporary light data. If empty, all light data is kept in memory.
+    ea::string cacheDirectory_;
+    /// Max memory in megabytes used by light data if cache directory is specified.
+    unsigned cacheMemoryLimit_{ 1024 };
     /// Global illumination data file.
     ea::string giDataFileName_{ "GI.bin" };
     /// Lightmap name format string.
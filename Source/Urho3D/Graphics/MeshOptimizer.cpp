@@ -0,0 +1,846 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Graphics/MeshOptimizer.h"
+
+#include "../Core/Assert.h"
+#include "../Graphics/Model.h"
+#include "../Math/BoundingBox.h"
+#include "../Math/MathDefs.h"
+
+#include <EASTL/array.h>
+#include <EASTL/sort.h>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Parameters of Forsyth's vertex cache optimization.
+/// @{
+const unsigned OptimizerCacheSize = 32;
+const float CacheDecayPower = 1.5f;
+const float LastTriangleScore = 0.75f;
+const float ValenceBoostScale = 2.0f;
+const float ValenceBoostPower = 0.5f;
+/// @}
+
+/// Size of FIFO cache simulated to find cluster boundaries.
+const unsigned OverdrawCacheSize = 16;
+/// Minimum number of triangles in overdraw cluster.
+const unsigned MinClusterTriangles = 32;
+
+float CalculateVertexScore(int cachePosition, unsigned numRemainingTriangles)
+{
+    if (numRemainingTriangles == 0)
+        return -1.0f;
+
+    float score = 0.0f;
+    if (cachePosition >= 0)
+    {
+        // Vertices of the last triangle get fixed score so the order of vertices in triangle doesn't matter
+        if (cachePosition < 3)
+            score = LastTriangleScore;
+        else
+        {
+            const float scale = 1.0f / (OptimizerCacheSize - 3);
+            score = Pow(1.0f - (cachePosition - 3) * scale, CacheDecayPower);
+        }
+    }
+
+    // Prefer vertices with few remaining triangles so they are not left behind
+    score += ValenceBoostScale * Pow(static_cast<float>(numRemainingTriangles), -ValenceBoostPower);
+    return score;
+}
+
+/// FIFO vertex cache simulated with timestamps.
+class VertexCacheSimulator
+{
+public:
+    VertexCacheSimulator(unsigned numVertices, unsigned cacheSize)
+        : timestamps_(numVertices, 0)
+        , cacheSize_(cacheSize)
+        , time_(cacheSize + 1)
+    {
+    }
+
+    /// Process vertex. Return true on cache miss.
+    bool Process(unsigned vertex)
+    {
+        if (time_ - timestamps_[vertex] <= cacheSize_)
+            return false;
+
+        timestamps_[vertex] = time_++;
+        return true;
+    }
+
+private:
+    ea::vector<unsigned> timestamps_;
+    const unsigned cacheSize_{};
+    unsigned time_{};
+};
+
+/// Symmetric 4x4 matrix of quadric error metric.
+struct Quadric
+{
+    double a00_{}, a01_{}, a02_{}, a11_{}, a12_{}, a22_{};
+    double b0_{}, b1_{}, b2_{};
+    double c_{};
+    double weight_{};
+
+    /// Construct quadric of squared distance to the plane, scaled by weight.
+    static Quadric FromPlane(const Vector3& normal, float offset, float weight)
+    {
+        const double nx = normal.x_;
+        const double ny = normal.y_;
+        const double nz = normal.z_;
+        const double d = offset;
+
+        Quadric result;
+        result.a00_ = weight * nx * nx;
+        result.a01_ = weight * nx * ny;
+        result.a02_ = weight * nx * nz;
+        result.a11_ = weight * ny * ny;
+        result.a12_ = weight * ny * nz;
+        result.a22_ = weight * nz * nz;
+        result.b0_ = weight * nx * d;
+        result.b1_ = weight * ny * d;
+        result.b2_ = weight * nz * d;
+        result.c_ = weight * d * d;
+        result.weight_ = weight;
+        return result;
+    }
+
+    void operator +=(const Quadric& rhs)
+    {
+        a00_ += rhs.a00_;
+        a01_ += rhs.a01_;
+        a02_ += rhs.a02_;
+        a11_ += rhs.a11_;
+        a12_ += rhs.a12_;
+        a22_ += rhs.a22_;
+        b0_ += rhs.b0_;
+        b1_ += rhs.b1_;
+        b2_ += rhs.b2_;
+        c_ += rhs.c_;
+        weight_ += rhs.weight_;
+    }
+
+    /// Evaluate weighted average of squared distances from point to the planes.
+    double Evaluate(const Vector3& point) const
+    {
+        if (weight_ <= 0.0)
+            return 0.0;
+
+        const double x = point.x_;
+        const double y = point.y_;
+        const double z = point.z_;
+        const double result = a00_ * x * x + a11_ * y * y + a22_ * z * z
+            + 2.0 * (a01_ * x * y + a02_ * x * z + a12_ * y * z)
+            + 2.0 * (b0_ * x + b1_ * y + b2_ * z) + c_;
+        return ea::max(result / weight_, 0.0);
+    }
+};
+
+/// Candidate of edge collapse that moves source vertex into target vertex.
+struct EdgeCollapse
+{
+    double error_{};
+    unsigned source_{};
+    unsigned target_{};
+
+    bool operator <(const EdgeCollapse& rhs) const { return error_ < rhs.error_; }
+};
+
+/// Calculate bounding sphere and normal cone of meshlet.
+void CalculateMeshletBounds(ModelMeshlet& meshlet, ea::span<const unsigned> vertices,
+    ea::span<const unsigned char> triangles, ea::span<const Vector3> positions)
+{
+    BoundingBox boundingBox;
+    for (unsigned vertex : vertices)
+        boundingBox.Merge(positions[vertex]);
+
+    meshlet.center_ = boundingBox.Center();
+    meshlet.radius_ = 0.0f;
+    for (unsigned vertex : vertices)
+        meshlet.radius_ = ea::max(meshlet.radius_, (positions[vertex] - meshlet.center_).Length());
+
+    // Use average normal as cone axis, skipping degenerate triangles
+    ea::vector<ea::pair<Vector3, Vector3>> trianglePlanes;
+    Vector3 axis;
+    for (unsigned i = 0; i + 2 < triangles.size(); i += 3)
+    {
+        const Vector3& p0 = positions[vertices[triangles[i]]];
+        const Vector3& p1 = positions[vertices[triangles[i + 1]]];
+        const Vector3& p2 = positions[vertices[triangles[i + 2]]];
+        const Vector3 normal = (p1 - p0).CrossProduct(p2 - p0);
+        if (normal.Length() < M_LARGE_EPSILON * M_LARGE_EPSILON)
+            continue;
+
+        trianglePlanes.emplace_back(p0, normal.Normalized());
+        axis += trianglePlanes.back().second;
+    }
+
+    meshlet.coneApex_ = meshlet.center_;
+    meshlet.coneAxis_ = Vector3::ZERO;
+    meshlet.coneCutoff_ = 1.0f;
+    if (trianglePlanes.empty() || axis.Length() < M_LARGE_EPSILON)
+        return;
+    axis.Normalize();
+
+    float minDot = 1.0f;
+    for (const auto& [point, normal] : trianglePlanes)
+        minDot = ea::min(minDot, normal.DotProduct(axis));
+
+    // Wide cones are almost never culled, so don't bother
+    meshlet.coneAxis_ = axis;
+    if (minDot <= 0.1f)
+        return;
+
+    // Move apex back along the axis so that it's behind all triangle planes
+    float maxOffset = 0.0f;
+    for (const auto& [point, normal] : trianglePlanes)
+        maxOffset = ea::max(maxOffset, (meshlet.center_ - point).DotProduct(normal) / axis.DotProduct(normal));
+
+    meshlet.coneApex_ = meshlet.center_ - axis * maxOffset;
+    meshlet.coneCutoff_ = Sqrt(1.0f - minDot * minDot);
+}
+
+/// Return whether each vertex can be moved by simplification.
+ea::vector<bool> FindMovableVertices(ea::span<const unsigned> indices, ea::span<const Vector3> positions)
+{
+    const unsigned numVertices = positions.size();
+    const unsigned numTriangles = indices.size() / 3;
+
+    // Group vertices with identical positions
+    ea::vector<unsigned> sortedVertices(numVertices);
+    for (unsigned i = 0; i < numVertices; ++i)
+        sortedVertices[i] = i;
+
+    const auto compareVertices = [&](unsigned lhs, unsigned rhs)
+    {
+        const Vector3& lhsPosition = positions[lhs];
+        const Vector3& rhsPosition = positions[rhs];
+        if (lhsPosition.x_ != rhsPosition.x_)
+            return lhsPosition.x_ < rhsPosition.x_;
+        if (lhsPosition.y_ != rhsPosition.y_)
+            return lhsPosition.y_ < rhsPosition.y_;
+        return lhsPosition.z_ < rhsPosition.z_;
+    };
+    ea::sort(sortedVertices.begin(), sortedVertices.end(), compareVertices);
+
+    ea::vector<bool> isMovable(numVertices, true);
+    ea::vector<unsigned> positionIndices(numVertices);
+    for (unsigned i = 0; i < numVertices;)
+    {
+        unsigned groupEnd = i + 1;
+        while (groupEnd < numVertices && positions[sortedVertices[groupEnd]] == positions[sortedVertices[i]])
+            ++groupEnd;
+
+        for (unsigned j = i; j < groupEnd; ++j)
+        {
+            positionIndices[sortedVertices[j]] = sortedVertices[i];
+            // Moving vertex on attribute seam would tear the mesh apart
+            if (groupEnd - i > 1)
+                isMovable[sortedVertices[j]] = false;
+        }
+        i = groupEnd;
+    }
+
+    // Lock vertices on borders and non-manifold edges, i.e. edges not shared by exactly two triangles
+    ea::vector<ea::pair<unsigned, unsigned>> edges;
+    edges.reserve(numTriangles * 3);
+    for (unsigned triangle = 0; triangle < numTriangles; ++triangle)
+    {
+        for (unsigned k = 0; k < 3; ++k)
+        {
+            const unsigned v0 = positionIndices[indices[triangle * 3 + k]];
+            const unsigned v1 = positionIndices[indices[triangle * 3 + (k + 1) % 3]];
+            edges.emplace_back(ea::min(v0, v1), ea::max(v0, v1));
+        }
+    }
+    ea::sort(edges.begin(), edges.end());
+
+    for (unsigned i = 0; i < edges.size();)
+    {
+        unsigned edgeEnd = i + 1;
+        while (edgeEnd < edges.size() && edges[edgeEnd] == edges[i])
+            ++edgeEnd;
+
+        if (edgeEnd - i != 2)
+        {
+            isMovable[edges[i].first] = false;
+            isMovable[edges[i].second] = false;
+        }
+        i = edgeEnd;
+    }
+
+    // Propagate locks to all vertices at the same position
+    for (unsigned vertex = 0; vertex < numVertices; ++vertex)
+    {
+        if (!isMovable[positionIndices[vertex]])
+            isMovable[vertex] = false;
+    }
+    return isMovable;
+}
+
+}
+
+void OptimizeVertexCache(ea::span<unsigned> indices, unsigned numVertices)
+{
+    const unsigned numIndices = indices.size();
+    const unsigned numTriangles = numIndices / 3;
+    if (numTriangles <= 1)
+        return;
+
+    // Build vertex to triangle adjacency
+    ea::vector<unsigned> numRemainingTriangles(numVertices);
+    for (unsigned i = 0; i < numTriangles * 3; ++i)
+    {
+        URHO3D_ASSERT(indices[i] < numVertices);
+        ++numRemainingTriangles[indices[i]];
+    }
+
+    ea::vector<unsigned> adjacencyOffsets(numVertices + 1);
+    for (unsigned vertex = 0; vertex < numVertices; ++vertex)
+        adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + numRemainingTriangles[vertex];
+
+    ea::vector<unsigned> adjacency(numTriangles * 3);
+    {
+        ea::vector<unsigned> fillOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (unsigned triangle = 0; triangle < numTriangles; ++triangle)
+        {
+            for (unsigned k = 0; k < 3; ++k)
+                adjacency[fillOffsets[indices[triangle * 3 + k]]++] = triangle;
+        }
+    }
+
+    ea::vector<int> cachePositions(numVertices, -1);
+    ea::vector<float> vertexScores(numVertices);
+    for (unsigned vertex = 0; vertex < numVertices; ++vertex)
+        vertexScores[vertex] = CalculateVertexScore(-1, numRemainingTriangles[vertex]);
+
+    const auto getTriangleScore = [&](unsigned triangle)
+    {
+        return vertexScores[indices[triangle * 3]] + vertexScores[indices[triangle * 3 + 1]]
+            + vertexScores[indices[triangle * 3 + 2]];
+    };
+
+    int bestTriangle = 0;
+    float bestScore = getTriangleScore(0);
+    for (unsigned triangle = 1; triangle < numTriangles; ++triangle)
+    {
+        const float score = getTriangleScore(triangle);
+        if (score > bestScore)
+        {
+            bestScore = score;
+            bestTriangle = triangle;
+        }
+    }
+
+    ea::vector<bool> isEmitted(numTriangles);
+    ea::vector<unsigned> result;
+    result.reserve(numTriangles * 3);
+
+    unsigned cache[OptimizerCacheSize + 3];
+    unsigned cacheSize = 0;
+    unsigned nextUnemittedTriangle = 0;
+    while (result.size() < numTriangles * 3)
+    {
+        // Fall back to the next triangle in original order if nothing in cache is useful
+        if (bestTriangle < 0)
+        {
+            while (isEmitted[nextUnemittedTriangle])
+                ++nextUnemittedTriangle;
+            bestTriangle = nextUnemittedTriangle;
+        }
+
+        const unsigned triangle = static_cast<unsigned>(bestTriangle);
+        isEmitted[triangle] = true;
+
+        unsigned newCache[OptimizerCacheSize + 3];
+        unsigned newCacheSize = 0;
+        for (unsigned k = 0; k < 3; ++k)
+        {
+            const unsigned vertex = indices[triangle * 3 + k];
+            result.push_back(vertex);
+
+            // Remove triangle from the active adjacency of the vertex
+            unsigned* vertexTriangles = &adjacency[adjacencyOffsets[vertex]];
+            const unsigned numVertexTriangles = numRemainingTriangles[vertex];
+            for (unsigned i = 0; i < numVertexTriangles; ++i)
+            {
+                if (vertexTriangles[i] == triangle)
+                {
+                    ea::swap(vertexTriangles[i], vertexTriangles[numVertexTriangles - 1]);
+                    break;
+                }
+            }
+            --numRemainingTriangles[vertex];
+
+            if (ea::find(newCache, newCache + newCacheSize, vertex) == newCache + newCacheSize)
+                newCache[newCacheSize++] = vertex;
+        }
+
+        const unsigned numTriangleVertices = newCacheSize;
+        for (unsigned i = 0; i < cacheSize; ++i)
+        {
+            const unsigned vertex = cache[i];
+            if (ea::find(newCache, newCache + numTriangleVertices, vertex) == newCache + numTriangleVertices)
+                newCache[newCacheSize++] = vertex;
+        }
+
+        // Update scores of vertices in cache and of vertices just evicted from cache
+        for (unsigned i = 0; i < newCacheSize; ++i)
+        {
+            const unsigned vertex = newCache[i];
+            cachePositions[vertex] = i < OptimizerCacheSize ? static_cast<int>(i) : -1;
+            vertexScores[vertex] = CalculateVertexScore(cachePositions[vertex], numRemainingTriangles[vertex]);
+        }
+
+        // Find the best triangle among triangles adjacent to cached vertices
+        bestTriangle = -1;
+        bestScore = -1.0f;
+        for (unsigned i = 0; i < newCacheSize; ++i)
+        {
+            const unsigned vertex = newCache[i];
+            const unsigned* vertexTriangles = &adjacency[adjacencyOffsets[vertex]];
+            for (unsigned j = 0; j < numRemainingTriangles[vertex]; ++j)
+            {
+                const unsigned candidate = vertexTriangles[j];
+                const float score = getTriangleScore(candidate);
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    bestTriangle = candidate;
+                }
+            }
+        }
+
+        cacheSize = ea::min(newCacheSize, OptimizerCacheSize);
+        ea::copy_n(newCache, cacheSize, cache);
+    }
+
+    ea::copy(result.begin(), result.end(), indices.begin());
+}
+
+void OptimizeOverdraw(ea::span<unsigned> indices, ea::span<const Vector3> positions)
+{
+    const unsigned numTriangles = indices.size() / 3;
+    const unsigned numVertices = positions.size();
+    if (numTriangles <= MinClusterTriangles)
+        return;
+
+    // Split triangles into clusters where vertex cache is flushed anyway
+    ea::vector<unsigned> clusterStarts{0};
+    VertexCacheSimulator cache(numVertices, OverdrawCacheSize);
+    for (unsigned triangle = 0; triangle < numTriangles; ++triangle)
+    {
+        unsigned numMisses = 0;
+        for (unsigned k = 0; k < 3; ++k)
+            numMisses += cache.Process(indices[triangle * 3 + k]) ? 1 : 0;
+
+        if (numMisses == 3 && triangle - clusterStarts.back() >= MinClusterTriangles)
+            clusterStarts.push_back(triangle);
+    }
+    clusterStarts.push_back(numTriangles);
+
+    const unsigned numClusters = clusterStarts.size() - 1;
+    if (numClusters <= 1)
+        return;
+
+    // Sort clusters by how much they face outwards from the mesh center
+    const auto getTrianglePositions = [&](unsigned triangle)
+    {
+        return ea::array<Vector3, 3>{positions[indices[triangle * 3]], positions[indices[triangle * 3 + 1]],
+            positions[indices[triangle * 3 + 2]]};
+    };
+
+    Vector3 meshCenter;
+    float meshArea = 0.0f;
+    ea::vector<Vector3> clusterCenters(numClusters);
+    ea::vector<Vector3> clusterNormals(numClusters);
+    for (unsigned cluster = 0; cluster < numClusters; ++cluster)
+    {
+        float clusterArea = 0.0f;
+        for (unsigned triangle = clusterStarts[cluster]; triangle < clusterStarts[cluster + 1]; ++triangle)
+        {
+            const auto [p0, p1, p2] = getTrianglePositions(triangle);
+            const Vector3 normal = (p1 - p0).CrossProduct(p2 - p0);
+            const float area = normal.Length();
+            const Vector3 center = (p0 + p1 + p2) / 3.0f;
+
+            clusterCenters[cluster] += center * area;
+            clusterNormals[cluster] += normal;
+            clusterArea += area;
+        }
+
+        meshCenter += clusterCenters[cluster];
+        meshArea += clusterArea;
+        clusterCenters[cluster] /= ea::max(clusterArea, M_EPSILON);
+        clusterNormals[cluster].Normalize();
+    }
+    meshCenter /= ea::max(meshArea, M_EPSILON);
+
+    ea::vector<ea::pair<float, unsigned>> sortedClusters(numClusters);
+    for (unsigned cluster = 0; cluster < numClusters; ++cluster)
+    {
+        const float sortKey = (clusterCenters[cluster] - meshCenter).DotProduct(clusterNormals[cluster]);
+        sortedClusters[cluster] = {-sortKey, cluster};
+    }
+    ea::stable_sort(sortedClusters.begin(), sortedClusters.end());
+
+    ea::vector<unsigned> result;
+    result.reserve(numTriangles * 3);
+    for (const auto& [_, cluster] : sortedClusters)
+    {
+        const unsigned begin = clusterStarts[cluster] * 3;
+        const unsigned end = clusterStarts[cluster + 1] * 3;
+        result.insert(result.end(), indices.begin() + begin, indices.begin() + end);
+    }
+    ea::copy(result.begin(), result.end(), indices.begin());
+}
+
+ea::vector<unsigned> GenerateVertexFetchRemap(ea::span<const unsigned> indices, unsigned numVertices)
+{
+    ea::vector<unsigned> remap(numVertices, M_MAX_UNSIGNED);
+    unsigned nextVertex = 0;
+    for (const unsigned index : indices)
+    {
+        if (remap[index] == M_MAX_UNSIGNED)
+            remap[index] = nextVertex++;
+    }
+    return remap;
+}
+
+float CalculateAverageCacheMissRatio(ea::span<const unsigned> indices, unsigned numVertices, unsigned cacheSize)
+{
+    const unsigned numTriangles = indices.size() / 3;
+    if (numTriangles == 0)
+        return 0.0f;
+
+    VertexCacheSimulator cache(numVertices, cacheSize);
+    unsigned numMisses = 0;
+    for (unsigned i = 0; i < numTriangles * 3; ++i)
+        numMisses += cache.Process(indices[i]) ? 1 : 0;
+    return static_cast<float>(numMisses) / numTriangles;
+}
+
+ea::vector<unsigned> SimplifyMesh(ea::span<const unsigned> indices, ea::span<const Vector3> positions,
+    unsigned targetNumTriangles, float maxError, float* resultError)
+{
+    const unsigned numVertices = positions.size();
+    const unsigned numTriangles = indices.size() / 3;
+
+    ea::vector<unsigned> result(indices.begin(), indices.begin() + numTriangles * 3);
+    if (resultError)
+        *resultError = 0.0f;
+    if (numTriangles <= targetNumTriangles)
+        return result;
+
+    BoundingBox boundingBox;
+    for (const unsigned index : result)
+    {
+        URHO3D_ASSERT(index < numVertices);
+        boundingBox.Merge(positions[index]);
+    }
+    const float meshExtent = ea::max(boundingBox.Size().Length(), M_EPSILON);
+    const double maxAbsoluteError = maxError * meshExtent;
+    const double maxQuadricError = maxAbsoluteError * maxAbsoluteError;
+
+    // Accumulate area-weighted quadrics of adjacent triangle planes
+    ea::vector<Quadric> quadrics(numVertices);
+    for (unsigned triangle = 0; triangle < numTriangles; ++triangle)
+    {
+        const unsigned i0 = result[triangle * 3];
+        const unsigned i1 = result[triangle * 3 + 1];
+        const unsigned i2 = result[triangle * 3 + 2];
+        const Vector3 crossProduct = (positions[i1] - positions[i0]).CrossProduct(positions[i2] - positions[i0]);
+        const float area = crossProduct.Length() * 0.5f;
+        if (area < M_EPSILON * M_EPSILON)
+            continue;
+
+        const Vector3 normal = crossProduct.Normalized();
+        const Quadric quadric = Quadric::FromPlane(normal, -normal.DotProduct(positions[i0]), area);
+        quadrics[i0] += quadric;
+        quadrics[i1] += quadric;
+        quadrics[i2] += quadric;
+    }
+
+    // Build vertex to triangle adjacency. Lists of target vertices grow on collapse and may contain dead triangles.
+    ea::vector<ea::vector<unsigned>> vertexTriangles(numVertices);
+    for (unsigned triangle = 0; triangle < numTriangles; ++triangle)
+    {
+        for (unsigned k = 0; k < 3; ++k)
+            vertexTriangles[result[triangle * 3 + k]].push_back(triangle);
+    }
+
+    const ea::vector<bool> isMovable = FindMovableVertices(result, positions);
+    ea::vector<bool> isTriangleAlive(numTriangles, true);
+    ea::vector<unsigned> vertexPasses(numVertices, M_MAX_UNSIGNED);
+    unsigned numAliveTriangles = numTriangles;
+    double maxCollapseError = 0.0;
+
+    // Return whether moving the vertex flips or degenerates any of its triangles that are not removed by collapse
+    const auto isCollapseFlippingTriangles = [&](unsigned source, unsigned target)
+    {
+        for (const unsigned triangle : vertexTriangles[source])
+        {
+            if (!isTriangleAlive[triangle])
+                continue;
+
+            const unsigned* triangleIndices = &result[triangle * 3];
+            if (triangleIndices[0] == target || triangleIndices[1] == target || triangleIndices[2] == target)
+                continue;
+
+            ea::array<Vector3, 3> oldPositions;
+            ea::array<Vector3, 3> newPositions;
+            for (unsigned k = 0; k < 3; ++k)
+            {
+                oldPositions[k] = positions[triangleIndices[k]];
+                newPositions[k] = triangleIndices[k] == source ? positions[target] : oldPositions[k];
+            }
+
+            const Vector3 oldNormal = (oldPositions[1] - oldPositions[0]).CrossProduct(oldPositions[2] - oldPositions[0]);
+            const Vector3 newNormal = (newPositions[1] - newPositions[0]).CrossProduct(newPositions[2] - newPositions[0]);
+            if (oldNormal.DotProduct(newNormal) <= 0.0f)
+                return true;
+        }
+        return false;
+    };
+
+    // Collapse edges in passes, at most one collapse per vertex in each pass
+    ea::vector<EdgeCollapse> collapses;
+    for (unsigned pass = 0; numAliveTriangles > targetNumTriangles; ++pass)
+    {
+        collapses.clear();
+        for (unsigned triangle = 0; triangle < numTriangles; ++triangle)
+        {
+            if (!isTriangleAlive[triangle])
+                continue;
+
+            for (unsigned k = 0; k < 3; ++k)
+            {
+                const unsigned source = result[triangle * 3 + k];
+                const unsigned target = result[triangle * 3 + (k + 1) % 3];
+                if (!isMovable[source])
+                    continue;
+
+                Quadric quadric = quadrics[source];
+                quadric += quadrics[target];
+                const double error = quadric.Evaluate(positions[target]);
+                if (error <= maxQuadricError)
+                    collapses.push_back(EdgeCollapse{error, source, target});
+            }
+        }
+        ea::sort(collapses.begin(), collapses.end());
+
+        unsigned numCollapses = 0;
+        for (const EdgeCollapse& collapse : collapses)
+        {
+            if (numAliveTriangles <= targetNumTriangles)
+                break;
+
+            const unsigned source = collapse.source_;
+            const unsigned target = collapse.target_;
+            if (vertexPasses[source] == pass || vertexPasses[target] == pass)
+                continue;
+
+            if (isCollapseFlippingTriangles(source, target))
+                continue;
+
+            for (const unsigned triangle : vertexTriangles[source])
+            {
+                if (!isTriangleAlive[triangle])
+                    continue;
+
+                unsigned* triangleIndices = &result[triangle * 3];
+                if (triangleIndices[0] == target || triangleIndices[1] == target || triangleIndices[2] == target)
+                {
+                    isTriangleAlive[triangle] = false;
+                    --numAliveTriangles;
+                    continue;
+                }
+
+                for (unsigned k = 0; k < 3; ++k)
+                {
+                    if (triangleIndices[k] == source)
+                        triangleIndices[k] = target;
+                }
+                vertexTriangles[target].push_back(triangle);
+            }
+            vertexTriangles[source].clear();
+
+            quadrics[target] += quadrics[source];
+            vertexPasses[source] = pass;
+            vertexPasses[target] = pass;
+            maxCollapseError = ea::max(maxCollapseError, collapse.error_);
+            ++numCollapses;
+        }
+
+        if (numCollapses == 0)
+            break;
+
+        // Drop dead triangles from adjacency so lists don't grow indefinitely
+        for (ea::vector<unsigned>& triangles : vertexTriangles)
+            ea::erase_if(triangles, [&](unsigned triangle) { return !isTriangleAlive[triangle]; });
+    }
+
+    unsigned numOutputIndices = 0;
+    for (unsigned triangle = 0; triangle < numTriangles; ++triangle)
+    {
+        if (!isTriangleAlive[triangle])
+            continue;
+
+        for (unsigned k = 0; k < 3; ++k)
+            result[numOutputIndices++] = result[triangle * 3 + k];
+    }
+    result.resize(numOutputIndices);
+
+    if (resultError)
+        *resultError = static_cast<float>(Sqrt(maxCollapseError) / meshExtent);
+    return result;
+}
+
+GeometryMeshlets BuildMeshlets(ea::span<const unsigned> indices, ea::span<const Vector3> positions,
+    unsigned maxVertices, unsigned maxTriangles)
+{
+    maxVertices = Clamp(maxVertices, 3u, 256u);
+    maxTriangles = ea::max(maxTriangles, 1u);
+
+    const unsigned numVertices = positions.size();
+    const unsigned numTriangles = indices.size() / 3;
+
+    // Build vertex to triangle adjacency
+    ea::vector<unsigned> adjacencyOffsets(numVertices + 1);
+    for (unsigned index : indices)
+        ++adjacencyOffsets[index + 1];
+    for (unsigned vertex = 0; vertex < numVertices; ++vertex)
+        adjacencyOffsets[vertex + 1] += adjacencyOffsets[vertex];
+
+    ea::vector<unsigned> adjacentTriangles(adjacencyOffsets.back());
+    ea::vector<unsigned> adjacencyFill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (unsigned i = 0; i < numTriangles * 3; ++i)
+        adjacentTriangles[adjacencyFill[indices[i]]++] = i / 3;
+
+    GeometryMeshlets result;
+    ea::vector<bool> isTriangleUsed(numTriangles);
+    ea::vector<unsigned> localIndices(numVertices, M_MAX_UNSIGNED);
+    ModelMeshlet meshlet;
+
+    const auto getNumNewVertices = [&](unsigned triangle)
+    {
+        unsigned count = 0;
+        for (unsigned k = 0; k < 3; ++k)
+        {
+            if (localIndices[indices[triangle * 3 + k]] == M_MAX_UNSIGNED)
+                ++count;
+        }
+        return count;
+    };
+
+    const auto flushMeshlet = [&]()
+    {
+        if (meshlet.triangleCount_ == 0)
+            return;
+
+        const auto vertices = ea::span<const unsigned>(result.vertices_).subspan(meshlet.vertexOffset_, meshlet.vertexCount_);
+        const auto triangles = ea::span<const unsigned char>(result.triangles_).subspan(
+            meshlet.triangleOffset_ * 3, meshlet.triangleCount_ * 3);
+        CalculateMeshletBounds(meshlet, vertices, triangles, positions);
+
+        for (unsigned vertex : vertices)
+            localIndices[vertex] = M_MAX_UNSIGNED;
+
+        result.meshlets_.push_back(meshlet);
+        meshlet = ModelMeshlet{};
+        meshlet.vertexOffset_ = result.vertices_.size();
+        meshlet.triangleOffset_ = result.triangles_.size() / 3;
+    };
+
+    unsigned nextSeedTriangle = 0;
+    while (true)
+    {
+        // Prefer unused triangle adjacent to current meshlet that adds the least number of vertices
+        unsigned bestTriangle = M_MAX_UNSIGNED;
+        unsigned bestNumNewVertices = M_MAX_UNSIGNED;
+        for (unsigned i = 0; i < meshlet.vertexCount_ && bestNumNewVertices > 0; ++i)
+        {
+            const unsigned vertex = result.vertices_[meshlet.vertexOffset_ + i];
+            for (unsigned j = adjacencyOffsets[vertex]; j < adjacencyOffsets[vertex + 1]; ++j)
+            {
+                const unsigned triangle = adjacentTriangles[j];
+                if (isTriangleUsed[triangle])
+                    continue;
+
+                const unsigned numNewVertices = getNumNewVertices(triangle);
+                if (numNewVertices < bestNumNewVertices)
+                {
+                    bestTriangle = triangle;
+                    bestNumNewVertices = numNewVertices;
+                }
+            }
+        }
+
+        // Start from the next unused triangle in the original order
+        if (bestTriangle == M_MAX_UNSIGNED)
+        {
+            while (nextSeedTriangle < numTriangles && isTriangleUsed[nextSeedTriangle])
+                ++nextSeedTriangle;
+            if (nextSeedTriangle == numTriangles)
+                break;
+
+            bestTriangle = nextSeedTriangle;
+            bestNumNewVertices = getNumNewVertices(bestTriangle);
+        }
+
+        if (meshlet.vertexCount_ + bestNumNewVertices > maxVertices || meshlet.triangleCount_ + 1 > maxTriangles)
+        {
+            flushMeshlet();
+            continue;
+        }
+
+        for (unsigned k = 0; k < 3; ++k)
+        {
+            const unsigned vertex = indices[bestTriangle * 3 + k];
+            unsigned& localIndex = localIndices[vertex];
+            if (localIndex == M_MAX_UNSIGNED)
+            {
+                localIndex = meshlet.vertexCount_++;
+                result.vertices_.push_back(vertex);
+            }
+            result.triangles_.push_back(static_cast<unsigned char>(localIndex));
+        }
+
+        isTriangleUsed[bestTriangle] = true;
+        ++meshlet.triangleCount_;
+    }
+
+    flushMeshlet();
+    return result;
+}
+
+}
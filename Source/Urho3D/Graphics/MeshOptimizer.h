@@ -0,0 +1,58 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Math/Vector3.h"
+
+#include <EASTL/span.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+struct GeometryMeshlets;
+
+/// Reorder triangles of indexed triangle list to improve post-transform vertex cache hit rate.
+/// Uses Tom Forsyth's linear-speed vertex cache optimization.
+URHO3D_API void OptimizeVertexCache(ea::span<unsigned> indices, unsigned numVertices);
+/// Reorder clusters of triangles of indexed triangle list so outward-facing clusters are drawn first.
+/// Clusters are split at vertex cache flushes, so it should be called after OptimizeVertexCache.
+URHO3D_API void OptimizeOverdraw(ea::span<unsigned> indices, ea::span<const Vector3> positions);
+/// Return vertex remap table that orders vertices by first use in index buffer.
+/// Unused vertices are mapped to M_MAX_UNSIGNED.
+URHO3D_API ea::vector<unsigned> GenerateVertexFetchRemap(ea::span<const unsigned> indices, unsigned numVertices);
+/// Return indices of triangle list simplified to the target number of triangles using quadric error metric.
+/// Simplification stops early when the error would exceed maxError, which is relative to the mesh extent.
+/// Border vertices and vertices with several attribute sets at the same position are never moved.
+/// Error of the result relative to the mesh extent is returned via resultError, if specified.
+URHO3D_API ea::vector<unsigned> SimplifyMesh(ea::span<const unsigned> indices, ea::span<const Vector3> positions,
+    unsigned targetNumTriangles, float maxError, float* resultError = nullptr);
+/// Split indexed triangle list into meshlets with bounding spheres and normal cones.
+/// Triangles are grown from adjacent ones so meshlets stay compact. No more than 256 vertices per meshlet.
+URHO3D_API GeometryMeshlets BuildMeshlets(ea::span<const unsigned> indices, ea::span<const Vector3> positions,
+    unsigned maxVertices = 64, unsigned maxTriangles = 124);
+/// Return average number of vertex shader invocations per triangle for FIFO vertex cache of given size.
+URHO3D_API float CalculateAverageCacheMissRatio(ea::span<const unsigned> indices, unsigned numVertices, unsigned cacheSize = 16);
+
+}
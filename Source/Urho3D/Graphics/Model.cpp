@@ -27,6 +27,7 @@
 #include "../Graphics/Geometry.h"
 #include "../Graphics/IndexBuffer.h"
 #include "../Graphics/Model.h"
+#include "../Graphics/ModelResidencyManager.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/VertexBuffer.h"
 #include "../IO/Log.h"
@@ -35,6 +36,9 @@
 #include "../IO/VirtualFileSystem.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/XMLFile.h"
+#include "Urho3D/RenderAPI/RenderDevice.h"
+
+#include <EASTL/algorithm.h>
 
 #include "../DebugNew.h"
 
@@ -90,13 +94,20 @@ bool Model::BeginLoad(Deserializer& source)
     geometries_.clear();
     geometryBoneMappings_.clear();
     geometryCenters_.clear();
+    geometryMeshlets_.clear();
     morphs_.clear();
     vertexBuffers_.clear();
     indexBuffers_.clear();
+    streamedVBDescs_.clear();
+    streamedIBDescs_.clear();
+    streamedGeometries_.clear();
 
     unsigned memoryUse = sizeof(Model);
     bool async = GetAsyncLoadState() == ASYNC_LOADING;
 
+    // If streaming is enabled, read only the coarsest LOD levels now. Finer LOD levels are streamed in on demand
+    const unsigned lodsToSkip = GetSubsystem<ModelResidencyManager>() ? M_MAX_UNSIGNED : 0;
+
     // Read vertex buffers
     unsigned numVertexBuffers = source.ReadUInt();
     vertexBuffers_.reserve(numVertexBuffers);
@@ -129,15 +140,24 @@ bool Model::BeginLoad(Deserializer& source)
 
         morphRangeStarts_[i] = source.ReadUInt();
         morphRangeCounts_[i] = source.ReadUInt();
+        desc.maxLodsToSkip_ = version >= lodStreamingVersion ? source.ReadUInt() : M_MAX_UNSIGNED;
 
         SharedPtr<VertexBuffer> buffer(MakeShared<VertexBuffer>(context_));
         unsigned vertexSize = VertexBuffer::GetVertexSize(desc.vertexElements_);
         desc.dataSize_ = desc.vertexCount_ * vertexSize;
+        desc.offset_ = source.GetPosition();
 
         buffer->SetDebugName(Format("Model '{}' Vertex Buffer #{}", GetName(), i));
 
         // Prepare vertex buffer data to be uploaded during EndLoad()
-        if (async)
+        if (!IsBufferUsed(desc.maxLodsToSkip_, lodsToSkip))
+        {
+            desc.data_.reset();
+            source.Seek(desc.offset_ + desc.dataSize_);
+            vertexBuffers_.push_back(buffer);
+            continue;
+        }
+        else if (async)
         {
             desc.data_ = new unsigned char[desc.dataSize_];
             source.Read(desc.data_.get(), desc.dataSize_);
@@ -166,15 +186,26 @@ bool Model::BeginLoad(Deserializer& source)
         unsigned indexCount = source.ReadUInt();
         unsigned indexSize = source.ReadUInt();
 
+        IndexBufferDesc& desc = loadIBData_[i];
+        desc.indexCount_ = indexCount;
+        desc.indexSize_ = indexSize;
+        desc.dataSize_ = indexCount * indexSize;
+        desc.maxLodsToSkip_ = version >= lodStreamingVersion ? source.ReadUInt() : M_MAX_UNSIGNED;
+        desc.offset_ = source.GetPosition();
+
         SharedPtr<IndexBuffer> buffer(MakeShared<IndexBuffer>(context_));
         buffer->SetDebugName(Format("Model '{}' Index Buffer #{}", GetName(), i));
 
         // Prepare index buffer data to be uploaded during EndLoad()
-        if (async)
+        if (!IsBufferUsed(desc.maxLodsToSkip_, lodsToSkip))
+        {
+            desc.data_.reset();
+            source.Seek(desc.offset_ + desc.dataSize_);
+            indexBuffers_.push_back(buffer);
+            continue;
+        }
+        else if (async)
         {
-            loadIBData_[i].indexCount_ = indexCount;
-            loadIBData_[i].indexSize_ = indexSize;
-            loadIBData_[i].dataSize_ = indexCount * indexSize;
             loadIBData_[i].data_ = new unsigned char[loadIBData_[i].dataSize_];
             source.Read(loadIBData_[i].data_.get(), loadIBData_[i].dataSize_);
         }
@@ -257,6 +288,21 @@ bool Model::BeginLoad(Deserializer& source)
         geometries_.push_back(geometryLodLevels);
     }
 
+    // LOD levels may be streamed only if some buffers are not used by the coarsest LOD levels
+    const auto isStreamedBuffer = [](const auto& desc) { return desc.maxLodsToSkip_ != M_MAX_UNSIGNED; };
+    maxStreamedLodsToSkip_ = 0;
+    if (ea::any_of(loadVBData_.begin(), loadVBData_.end(), isStreamedBuffer)
+        || ea::any_of(loadIBData_.begin(), loadIBData_.end(), isStreamedBuffer))
+    {
+        for (const auto& lodLevels : loadGeometries_)
+        {
+            const unsigned numLodLevels = lodLevels.size();
+            if (numLodLevels > 1)
+                maxStreamedLodsToSkip_ = ea::max(maxStreamedLodsToSkip_, numLodLevels - 1);
+        }
+    }
+    streamedLodsToSkip_ = ea::min(lodsToSkip, maxStreamedLodsToSkip_);
+
     // Read morphs
     unsigned numMorphs = source.ReadUInt();
     morphs_.reserve(numMorphs);
@@ -314,6 +360,41 @@ bool Model::BeginLoad(Deserializer& source)
         geometryCenters_.push_back(Vector3::ZERO);
     memoryUse += sizeof(Vector3) * geometries_.size();
 
+    // Read geometry meshlets
+    if (version >= meshletVersion)
+    {
+        const unsigned numGeometriesWithMeshlets = source.ReadVLE();
+        geometryMeshlets_.resize(numGeometriesWithMeshlets);
+        for (unsigned i = 0; i < numGeometriesWithMeshlets; ++i)
+        {
+            geometryMeshlets_[i].resize(source.ReadVLE());
+            for (GeometryMeshlets& geometryMeshlets : geometryMeshlets_[i])
+            {
+                geometryMeshlets.meshlets_.resize(source.ReadVLE());
+                for (ModelMeshlet& meshlet : geometryMeshlets.meshlets_)
+                {
+                    meshlet.vertexOffset_ = source.ReadUInt();
+                    meshlet.vertexCount_ = source.ReadUInt();
+                    meshlet.triangleOffset_ = source.ReadUInt();
+                    meshlet.triangleCount_ = source.ReadUInt();
+                    meshlet.center_ = source.ReadVector3();
+                    meshlet.radius_ = source.ReadFloat();
+                    meshlet.coneApex_ = source.ReadVector3();
+                    meshlet.coneAxis_ = source.ReadVector3();
+                    meshlet.coneCutoff_ = source.ReadFloat();
+                }
+
+                geometryMeshlets.vertices_.resize(source.ReadVLE());
+                source.Read(geometryMeshlets.vertices_.data(), geometryMeshlets.vertices_.size() * sizeof(unsigned));
+                geometryMeshlets.triangles_.resize(source.ReadVLE());
+                source.Read(geometryMeshlets.triangles_.data(), geometryMeshlets.triangles_.size());
+
+                memoryUse += geometryMeshlets.meshlets_.size() * sizeof(ModelMeshlet)
+                    + geometryMeshlets.vertices_.size() * sizeof(unsigned) + geometryMeshlets.triangles_.size();
+            }
+        }
+    }
+
     // Read metadata
     auto* cache = GetSubsystem<ResourceCache>();
     ea::string xmlName = ReplaceExtension(GetName(), ".xml");
@@ -325,6 +406,50 @@ bool Model::BeginLoad(Deserializer& source)
     return true;
 }
 
+unsigned long long Model::GetEndLoadUploadSize() const
+{
+    unsigned long long result = 0;
+    for (const VertexBufferDesc& desc : loadVBData_)
+        result += desc.data_ ? desc.dataSize_ : 0;
+    for (const IndexBufferDesc& desc : loadIBData_)
+        result += desc.data_ ? desc.dataSize_ : 0;
+    return result;
+}
+
+bool Model::EndLoadInWorkerThread()
+{
+    auto renderDevice = GetSubsystem<RenderDevice>();
+    if (!renderDevice || !renderDevice->GetCaps().threadedResourceCreation_)
+        return true;
+
+    // Buffers are not used by anyone yet, create them with initial data and leave only geometry setup to EndLoad()
+    for (unsigned i = 0; i < vertexBuffers_.size(); ++i)
+    {
+        VertexBuffer* buffer = vertexBuffers_[i];
+        VertexBufferDesc& desc = loadVBData_[i];
+        if (desc.data_)
+        {
+            buffer->SetShadowed(true);
+            buffer->SetSize(desc.vertexCount_, desc.vertexElements_, false, desc.data_.get());
+            desc.data_.reset();
+        }
+    }
+
+    for (unsigned i = 0; i < indexBuffers_.size(); ++i)
+    {
+        IndexBuffer* buffer = indexBuffers_[i];
+        IndexBufferDesc& desc = loadIBData_[i];
+        if (desc.data_)
+        {
+            buffer->SetShadowed(true);
+            buffer->SetSize(desc.indexCount_, desc.indexSize_ > sizeof(unsigned short), false, desc.data_.get());
+            desc.data_.reset();
+        }
+    }
+
+    return true;
+}
+
 bool Model::EndLoad()
 {
     // Upload vertex buffer data
@@ -354,16 +479,37 @@ bool Model::EndLoad()
     }
 
     // Set up geometries
-    for (unsigned i = 0; i < geometries_.size(); ++i)
+    if (IsLodStreamable())
     {
-        for (unsigned j = 0; j < geometries_[i].size(); ++j)
+        // Keep descriptions of buffers and geometries to stream LOD levels later
+        for (VertexBufferDesc& desc : loadVBData_)
+            desc.data_.reset();
+        for (IndexBufferDesc& desc : loadIBData_)
+            desc.data_.reset();
+
+        streamedVBDescs_ = ea::move(loadVBData_);
+        streamedIBDescs_ = ea::move(loadIBData_);
+        streamedGeometries_ = ea::move(loadGeometries_);
+        UpdateStreamedGeometries();
+
+        if (auto modelResidencyManager = GetSubsystem<ModelResidencyManager>())
+            modelResidencyManager->AddModel(this);
+    }
+    else
+    {
+        for (unsigned i = 0; i < geometries_.size(); ++i)
         {
-            Geometry* geometry = geometries_[i][j];
-            GeometryDesc& desc = loadGeometries_[i][j];
-            geometry->SetVertexBuffer(0, vertexBuffers_[desc.vbRef_]);
-            geometry->SetIndexBuffer(indexBuffers_[desc.ibRef_]);
-            geometry->SetDrawRange(desc.type_, desc.indexStart_, desc.indexCount_);
+            for (unsigned j = 0; j < geometries_[i].size(); ++j)
+            {
+                Geometry* geometry = geometries_[i][j];
+                GeometryDesc& desc = loadGeometries_[i][j];
+                geometry->SetVertexBuffer(0, vertexBuffers_[desc.vbRef_]);
+                geometry->SetIndexBuffer(indexBuffers_[desc.ibRef_]);
+                geometry->SetDrawRange(desc.type_, desc.indexStart_, desc.indexCount_);
+            }
         }
+
+        DecodeQuantizedPositions();
     }
 
     loadVBData_.clear();
@@ -374,11 +520,21 @@ bool Model::EndLoad()
 
 bool Model::Save(Serializer& dest) const
 {
+    if (streamedLodsToSkip_ > 0)
+    {
+        URHO3D_LOGERROR("Cannot save model '{}' while its LOD levels are streamed out", GetName());
+        return false;
+    }
+
     // Write ID
     if (!dest.WriteFileID("UMD3"))
         return false;
     dest.WriteUInt(currentVersion);
 
+    ea::vector<unsigned> vertexBufferMaxLodsToSkip;
+    ea::vector<unsigned> indexBufferMaxLodsToSkip;
+    CalculateBufferMaxLodsToSkip(vertexBufferMaxLodsToSkip, indexBufferMaxLodsToSkip);
+
     // Write vertex buffers
     dest.WriteUInt(vertexBuffers_.size());
     for (unsigned i = 0; i < vertexBuffers_.size(); ++i)
@@ -396,6 +552,7 @@ bool Model::Save(Serializer& dest) const
         }
         dest.WriteUInt(morphRangeStarts_[i]);
         dest.WriteUInt(morphRangeCounts_[i]);
+        dest.WriteUInt(vertexBufferMaxLodsToSkip[i]);
         dest.Write(buffer->GetShadowData(), buffer->GetVertexCount() * buffer->GetVertexSize());
     }
     // Write index buffers
@@ -405,6 +562,7 @@ bool Model::Save(Serializer& dest) const
         IndexBuffer* buffer = indexBuffers_[i];
         dest.WriteUInt(buffer->GetIndexCount());
         dest.WriteUInt(buffer->GetIndexSize());
+        dest.WriteUInt(indexBufferMaxLodsToSkip[i]);
         dest.Write(buffer->GetShadowData(), buffer->GetIndexCount() * buffer->GetIndexSize());
     }
     // Write geometries
@@ -470,6 +628,34 @@ bool Model::Save(Serializer& dest) const
     for (unsigned i = 0; i < geometryCenters_.size(); ++i)
         dest.WriteVector3(geometryCenters_[i]);
 
+    // Write geometry meshlets
+    dest.WriteVLE(geometryMeshlets_.size());
+    for (const ea::vector<GeometryMeshlets>& lodLevels : geometryMeshlets_)
+    {
+        dest.WriteVLE(lodLevels.size());
+        for (const GeometryMeshlets& geometryMeshlets : lodLevels)
+        {
+            dest.WriteVLE(geometryMeshlets.meshlets_.size());
+            for (const ModelMeshlet& meshlet : geometryMeshlets.meshlets_)
+            {
+                dest.WriteUInt(meshlet.vertexOffset_);
+                dest.WriteUInt(meshlet.vertexCount_);
+                dest.WriteUInt(meshlet.triangleOffset_);
+                dest.WriteUInt(meshlet.triangleCount_);
+                dest.WriteVector3(meshlet.center_);
+                dest.WriteFloat(meshlet.radius_);
+                dest.WriteVector3(meshlet.coneApex_);
+                dest.WriteVector3(meshlet.coneAxis_);
+                dest.WriteFloat(meshlet.coneCutoff_);
+            }
+
+            dest.WriteVLE(geometryMeshlets.vertices_.size());
+            dest.Write(geometryMeshlets.vertices_.data(), geometryMeshlets.vertices_.size() * sizeof(unsigned));
+            dest.WriteVLE(geometryMeshlets.triangles_.size());
+            dest.Write(geometryMeshlets.triangles_.data(), geometryMeshlets.triangles_.size());
+        }
+    }
+
     // Write metadata
     if (HasMetadata())
     {
@@ -621,6 +807,282 @@ void Model::SetMorphs(const ea::vector<ModelMorph>& morphs)
     morphs_ = morphs;
 }
 
+bool Model::SetGeometryMeshlets(unsigned index, unsigned lodLevel, const GeometryMeshlets& meshlets)
+{
+    if (index >= geometries_.size())
+    {
+        URHO3D_LOGERROR("Geometry index out of bounds");
+        return false;
+    }
+    if (lodLevel >= geometries_[index].size())
+    {
+        URHO3D_LOGERROR("LOD level index out of bounds");
+        return false;
+    }
+
+    if (index >= geometryMeshlets_.size())
+        geometryMeshlets_.resize(index + 1);
+    if (lodLevel >= geometryMeshlets_[index].size())
+        geometryMeshlets_[index].resize(lodLevel + 1);
+
+    geometryMeshlets_[index][lodLevel] = meshlets;
+    return true;
+}
+
+void Model::DecodeQuantizedPositions()
+{
+    static const ea::vector<VertexElement> positionElements{VertexElement(TYPE_VECTOR3, SEM_POSITION)};
+
+    ea::unordered_map<VertexBuffer*, ea::shared_array<unsigned char>> decodedPositions;
+    for (const ea::vector<SharedPtr<Geometry>>& lodLevels : geometries_)
+    {
+        for (Geometry* geometry : lodLevels)
+        {
+            VertexBuffer* vertexBuffer = geometry ? geometry->GetVertexBuffer(0) : nullptr;
+            if (!vertexBuffer || !vertexBuffer->GetShadowData())
+                continue;
+
+            const VertexElement* positionElement = vertexBuffer->GetElement(SEM_POSITION);
+            if (!positionElement || positionElement->type_ == TYPE_VECTOR3)
+                continue;
+
+            ea::shared_array<unsigned char>& positions = decodedPositions[vertexBuffer];
+            if (!positions)
+            {
+                const unsigned vertexCount = vertexBuffer->GetVertexCount();
+                ea::vector<Vector4> unpackedPositions(vertexCount);
+                VertexBuffer::UnpackVertexData(vertexBuffer->GetShadowData(), vertexBuffer->GetVertexSize(),
+                    *positionElement, 0, vertexCount, unpackedPositions.data(), sizeof(Vector4));
+
+                positions = ea::shared_array<unsigned char>(new unsigned char[vertexCount * sizeof(Vector3)]);
+                auto dest = reinterpret_cast<Vector3*>(positions.get());
+                for (unsigned i = 0; i < vertexCount; ++i)
+                    dest[i] = unpackedPositions[i].ToVector3();
+            }
+
+            geometry->SetRawVertexData(positions, positionElements);
+        }
+    }
+}
+
+bool Model::SetStreamedLodsToSkip(unsigned lodsToSkip)
+{
+    lodsToSkip = ea::min(lodsToSkip, maxStreamedLodsToSkip_);
+    if (lodsToSkip < streamedLodsToSkip_)
+    {
+        URHO3D_LOGERROR("Cannot load LOD levels of model '{}' without data", GetName());
+        return false;
+    }
+
+    if (lodsToSkip == streamedLodsToSkip_)
+        return true;
+
+    // Release buffers of skipped LOD levels. Geometries still refer to them until updated
+    unsigned releasedMemory = 0;
+    for (unsigned i = 0; i < streamedVBDescs_.size(); ++i)
+    {
+        const VertexBufferDesc& desc = streamedVBDescs_[i];
+        if (IsBufferUsed(desc.maxLodsToSkip_, streamedLodsToSkip_) && !IsBufferUsed(desc.maxLodsToSkip_, lodsToSkip))
+        {
+            auto buffer = MakeShared<VertexBuffer>(context_);
+            buffer->SetDebugName(vertexBuffers_[i]->GetDebugName());
+            vertexBuffers_[i] = buffer;
+            releasedMemory += desc.dataSize_;
+        }
+    }
+
+    for (unsigned i = 0; i < streamedIBDescs_.size(); ++i)
+    {
+        const IndexBufferDesc& desc = streamedIBDescs_[i];
+        if (IsBufferUsed(desc.maxLodsToSkip_, streamedLodsToSkip_) && !IsBufferUsed(desc.maxLodsToSkip_, lodsToSkip))
+        {
+            auto buffer = MakeShared<IndexBuffer>(context_);
+            buffer->SetDebugName(indexBuffers_[i]->GetDebugName());
+            indexBuffers_[i] = buffer;
+            releasedMemory += desc.dataSize_;
+        }
+    }
+
+    streamedLodsToSkip_ = lodsToSkip;
+    UpdateStreamedGeometries();
+    SetMemoryUse(GetMemoryUse() - ea::min(GetMemoryUse(), releasedMemory));
+    return true;
+}
+
+ea::vector<ModelStreamedBuffer> Model::GetStreamedBuffers(unsigned lodsToSkip) const
+{
+    lodsToSkip = ea::min(lodsToSkip, maxStreamedLodsToSkip_);
+
+    // Buffers are sorted by offset in the file
+    ea::vector<ModelStreamedBuffer> result;
+    for (unsigned i = 0; i < streamedVBDescs_.size(); ++i)
+    {
+        const VertexBufferDesc& desc = streamedVBDescs_[i];
+        if (IsBufferUsed(desc.maxLodsToSkip_, lodsToSkip) && !IsBufferUsed(desc.maxLodsToSkip_, streamedLodsToSkip_))
+            result.push_back(ModelStreamedBuffer{false, i, desc.offset_, desc.dataSize_});
+    }
+
+    for (unsigned i = 0; i < streamedIBDescs_.size(); ++i)
+    {
+        const IndexBufferDesc& desc = streamedIBDescs_[i];
+        if (IsBufferUsed(desc.maxLodsToSkip_, lodsToSkip) && !IsBufferUsed(desc.maxLodsToSkip_, streamedLodsToSkip_))
+            result.push_back(ModelStreamedBuffer{true, i, desc.offset_, desc.dataSize_});
+    }
+
+    return result;
+}
+
+bool Model::ReadStreamedBuffers(Deserializer& source, ea::vector<ModelStreamedBuffer>& buffers)
+{
+    for (ModelStreamedBuffer& buffer : buffers)
+    {
+        if (source.Seek(buffer.offset_) != buffer.offset_)
+            return false;
+
+        buffer.data_ = new unsigned char[buffer.dataSize_];
+        if (source.Read(buffer.data_.get(), buffer.dataSize_) != buffer.dataSize_)
+            return false;
+    }
+    return true;
+}
+
+bool Model::SetStreamedData(const ea::vector<ModelStreamedBuffer>& buffers, unsigned lodsToSkip)
+{
+    lodsToSkip = ea::min(lodsToSkip, maxStreamedLodsToSkip_);
+    if (lodsToSkip >= streamedLodsToSkip_)
+        return SetStreamedLodsToSkip(lodsToSkip);
+
+    // Model may be reloaded or streamed out since the buffers were requested
+    const auto isSameBuffer = [](const ModelStreamedBuffer& lhs, const ModelStreamedBuffer& rhs)
+    {
+        return lhs.isIndexBuffer_ == rhs.isIndexBuffer_ && lhs.index_ == rhs.index_ && lhs.offset_ == rhs.offset_
+            && lhs.dataSize_ == rhs.dataSize_ && rhs.data_;
+    };
+    const ea::vector<ModelStreamedBuffer> expectedBuffers = GetStreamedBuffers(lodsToSkip);
+    if (expectedBuffers.size() != buffers.size()
+        || !ea::equal(expectedBuffers.begin(), expectedBuffers.end(), buffers.begin(), isSameBuffer))
+    {
+        URHO3D_LOGERROR("Streamed data doesn't match LOD levels of model '{}'", GetName());
+        return false;
+    }
+
+    unsigned loadedMemory = 0;
+    for (const ModelStreamedBuffer& streamedBuffer : buffers)
+    {
+        if (!streamedBuffer.isIndexBuffer_)
+        {
+            VertexBuffer* buffer = vertexBuffers_[streamedBuffer.index_];
+            const VertexBufferDesc& desc = streamedVBDescs_[streamedBuffer.index_];
+            buffer->SetShadowed(true);
+            buffer->SetSize(desc.vertexCount_, desc.vertexElements_);
+            buffer->Update(streamedBuffer.data_.get());
+        }
+        else
+        {
+            IndexBuffer* buffer = indexBuffers_[streamedBuffer.index_];
+            const IndexBufferDesc& desc = streamedIBDescs_[streamedBuffer.index_];
+            buffer->SetShadowed(true);
+            buffer->SetSize(desc.indexCount_, desc.indexSize_ > sizeof(unsigned short));
+            buffer->Update(streamedBuffer.data_.get());
+        }
+        loadedMemory += streamedBuffer.dataSize_;
+    }
+
+    streamedLodsToSkip_ = lodsToSkip;
+    UpdateStreamedGeometries();
+    SetMemoryUse(GetMemoryUse() + loadedMemory);
+    return true;
+}
+
+void Model::ReportLodLevel(unsigned lodLevel)
+{
+    unsigned oldLodLevel = lodLevel_.load(std::memory_order_relaxed);
+    while (lodLevel < oldLodLevel && !lodLevel_.compare_exchange_weak(oldLodLevel, lodLevel, std::memory_order_relaxed))
+        ;
+}
+
+void Model::CalculateBufferMaxLodsToSkip(ea::vector<unsigned>& vertexBuffers, ea::vector<unsigned>& indexBuffers) const
+{
+    const auto findBuffer = [](const auto& buffers, const auto* buffer)
+    {
+        for (unsigned i = 0; i < buffers.size(); ++i)
+        {
+            if (buffers[i] == buffer)
+                return i;
+        }
+        return M_MAX_UNSIGNED;
+    };
+
+    ea::vector<bool> isVertexBufferUsed(vertexBuffers_.size());
+    ea::vector<bool> isIndexBufferUsed(indexBuffers_.size());
+    vertexBuffers.assign(vertexBuffers_.size(), 0);
+    indexBuffers.assign(indexBuffers_.size(), 0);
+
+    for (const ea::vector<SharedPtr<Geometry>>& lodLevels : geometries_)
+    {
+        const unsigned numLodLevels = lodLevels.size();
+        for (unsigned lodLevel = 0; lodLevel < numLodLevels; ++lodLevel)
+        {
+            const Geometry* geometry = lodLevels[lodLevel];
+            if (!geometry)
+                continue;
+
+            // The coarsest LOD level of the geometry is used no matter how many LOD levels are skipped
+            const unsigned maxLodsToSkip = lodLevel + 1 == numLodLevels ? M_MAX_UNSIGNED : lodLevel;
+            for (unsigned i = 0; i < geometry->GetNumVertexBuffers(); ++i)
+            {
+                const unsigned index = findBuffer(vertexBuffers_, geometry->GetVertexBuffer(i));
+                if (index != M_MAX_UNSIGNED)
+                {
+                    vertexBuffers[index] = ea::max(vertexBuffers[index], maxLodsToSkip);
+                    isVertexBufferUsed[index] = true;
+                }
+            }
+
+            const unsigned index = findBuffer(indexBuffers_, geometry->GetIndexBuffer());
+            if (index != M_MAX_UNSIGNED)
+            {
+                indexBuffers[index] = ea::max(indexBuffers[index], maxLodsToSkip);
+                isIndexBufferUsed[index] = true;
+            }
+        }
+    }
+
+    // Unused buffers are always loaded, just in case
+    for (unsigned i = 0; i < vertexBuffers.size(); ++i)
+    {
+        if (!isVertexBufferUsed[i])
+            vertexBuffers[i] = M_MAX_UNSIGNED;
+    }
+    for (unsigned i = 0; i < indexBuffers.size(); ++i)
+    {
+        if (!isIndexBufferUsed[i])
+            indexBuffers[i] = M_MAX_UNSIGNED;
+    }
+}
+
+void Model::UpdateStreamedGeometries()
+{
+    for (unsigned i = 0; i < geometries_.size(); ++i)
+    {
+        const unsigned numLodLevels = geometries_[i].size();
+        for (unsigned j = 0; j < numLodLevels; ++j)
+        {
+            // Skipped LOD levels are rendered with the finest loaded LOD level
+            const unsigned sourceLodLevel = ea::min(ea::max(j, streamedLodsToSkip_), numLodLevels - 1);
+            const GeometryDesc& desc = streamedGeometries_[i][sourceLodLevel];
+
+            Geometry* geometry = geometries_[i][j];
+            geometry->SetVertexBuffer(0, vertexBuffers_[desc.vbRef_]);
+            geometry->SetIndexBuffer(indexBuffers_[desc.ibRef_]);
+            geometry->SetDrawRange(desc.type_, desc.indexStart_, desc.indexCount_);
+            geometry->SetRawVertexData(ea::shared_array<unsigned char>{}, ea::vector<VertexElement>{});
+        }
+    }
+
+    DecodeQuantizedPositions();
+}
+
 SharedPtr<Model> Model::Clone(const ea::string& cloneName) const
 {
     SharedPtr<Model> ret(MakeShared<Model>(context_));
@@ -630,6 +1092,7 @@ SharedPtr<Model> Model::Clone(const ea::string& cloneName) const
     ret->skeleton_ = skeleton_;
     ret->geometryBoneMappings_ = geometryBoneMappings_;
     ret->geometryCenters_ = geometryCenters_;
+    ret->geometryMeshlets_ = geometryMeshlets_;
     ret->morphs_ = morphs_;
     ret->morphRangeStarts_ = morphRangeStarts_;
     ret->morphRangeCounts_ = morphRangeCounts_;
@@ -707,6 +1170,7 @@ SharedPtr<Model> Model::Clone(const ea::string& cloneName) const
             ret->geometries_[i][j] = cloneGeometry;
         }
     }
+    ret->DecodeQuantizedPositions();
 
 
     // Deep copy the morph data (if any) to allow modifying it
@@ -747,6 +1211,15 @@ Geometry* Model::GetGeometry(unsigned index, unsigned lodLevel) const
     return geometries_[index][lodLevel];
 }
 
+const GeometryMeshlets* Model::GetGeometryMeshlets(unsigned index, unsigned lodLevel) const
+{
+    if (index >= geometryMeshlets_.size() || lodLevel >= geometryMeshlets_[index].size())
+        return nullptr;
+
+    const GeometryMeshlets& meshlets = geometryMeshlets_[index][lodLevel];
+    return !meshlets.IsEmpty() ? &meshlets : nullptr;
+}
+
 const ModelMorph* Model::GetMorph(unsigned index) const
 {
     return index < morphs_.size() ? &morphs_[index] : nullptr;
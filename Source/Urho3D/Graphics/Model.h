@@ -30,6 +30,8 @@
 #include "../Math/BoundingBox.h"
 #include "../Resource/Resource.h"
 
+#include <atomic>
+
 namespace Urho3D
 {
 
@@ -75,6 +77,10 @@ struct VertexBufferDesc
     unsigned dataSize_;
     /// Vertex data.
     ea::shared_array<unsigned char> data_;
+    /// Max number of skipped finest LOD levels while the buffer is still used.
+    unsigned maxLodsToSkip_{M_MAX_UNSIGNED};
+    /// Offset of vertex data in the file.
+    unsigned offset_{};
 };
 
 /// Description of index buffer data for asynchronous loading.
@@ -88,6 +94,10 @@ struct IndexBufferDesc
     unsigned dataSize_;
     /// Index data.
     ea::shared_array<unsigned char> data_;
+    /// Max number of skipped finest LOD levels while the buffer is still used.
+    unsigned maxLodsToSkip_{M_MAX_UNSIGNED};
+    /// Offset of index data in the file.
+    unsigned offset_{};
 };
 
 /// Description of a geometry for asynchronous loading.
@@ -105,6 +115,79 @@ struct GeometryDesc
     unsigned indexCount_;
 };
 
+/// Vertex or index buffer data of finer LOD levels streamed from the file.
+struct ModelStreamedBuffer
+{
+    /// Whether the data belongs to index buffer.
+    bool isIndexBuffer_{};
+    /// Index of vertex or index buffer in the model.
+    unsigned index_{};
+    /// Offset of the data in the file.
+    unsigned offset_{};
+    /// Data size.
+    unsigned dataSize_{};
+    /// Data. Filled by Model::ReadStreamedBuffers.
+    ea::shared_array<unsigned char> data_;
+};
+
+/// Small cluster of geometry triangles with bounds for GPU-driven culling.
+struct ModelMeshlet
+{
+    /// Offset in the array of meshlet vertices.
+    unsigned vertexOffset_{};
+    /// Number of vertices.
+    unsigned vertexCount_{};
+    /// Offset in the array of meshlet triangles, in triangles.
+    unsigned triangleOffset_{};
+    /// Number of triangles.
+    unsigned triangleCount_{};
+    /// Bounding sphere center.
+    Vector3 center_;
+    /// Bounding sphere radius.
+    float radius_{};
+    /// Normal cone apex. Meshlet is back-facing if dot(normalize(coneApex_ - cameraPosition), coneAxis_) >= coneCutoff_.
+    Vector3 coneApex_;
+    /// Normal cone axis.
+    Vector3 coneAxis_;
+    /// Sine of normal cone angle. Meshlet is never culled if the cutoff is 1.
+    float coneCutoff_{1.0f};
+
+    bool operator ==(const ModelMeshlet& rhs) const
+    {
+        return vertexOffset_ == rhs.vertexOffset_
+            && vertexCount_ == rhs.vertexCount_
+            && triangleOffset_ == rhs.triangleOffset_
+            && triangleCount_ == rhs.triangleCount_
+            && center_ == rhs.center_
+            && radius_ == rhs.radius_
+            && coneApex_ == rhs.coneApex_
+            && coneAxis_ == rhs.coneAxis_
+            && coneCutoff_ == rhs.coneCutoff_;
+    }
+    bool operator !=(const ModelMeshlet& rhs) const { return !(*this == rhs); }
+};
+
+/// Meshlets of geometry LOD level.
+struct GeometryMeshlets
+{
+    /// Meshlets.
+    ea::vector<ModelMeshlet> meshlets_;
+    /// Vertex indices of all meshlets, relative to geometry vertex start.
+    ea::vector<unsigned> vertices_;
+    /// Triangles of all meshlets as triplets of vertex indices local to meshlet.
+    ea::vector<unsigned char> triangles_;
+
+    bool IsEmpty() const { return meshlets_.empty(); }
+
+    bool operator ==(const GeometryMeshlets& rhs) const
+    {
+        return meshlets_ == rhs.meshlets_
+            && vertices_ == rhs.vertices_
+            && triangles_ == rhs.triangles_;
+    }
+    bool operator !=(const GeometryMeshlets& rhs) const { return !(*this == rhs); }
+};
+
 /// 3D model resource.
 class URHO3D_API Model : public ResourceWithMetadata
 {
@@ -121,8 +204,12 @@ public:
 
     /// Load resource from stream. May be called from a worker thread. Return true if successful.
     bool BeginLoad(Deserializer& source) override;
+    /// Create vertex and index buffers in the worker thread if supported by the render device.
+    bool EndLoadInWorkerThread() override;
     /// Finish resource loading. Always called from the main thread. Return true if successful.
     bool EndLoad() override;
+    /// Return amount of vertex and index data not uploaded to GPU yet.
+    unsigned long long GetEndLoadUploadSize() const override;
     /// Save resource. Return true if successful.
     bool Save(Serializer& dest) const override;
 
@@ -151,6 +238,11 @@ public:
     void SetGeometryBoneMappings(const ea::vector<ea::vector<unsigned> >& geometryBoneMappings);
     /// Set vertex morphs.
     void SetMorphs(const ea::vector<ModelMorph>& morphs);
+    /// Set meshlets of geometry LOD level. Meshlets are optional and are not used by the default renderer.
+    bool SetGeometryMeshlets(unsigned index, unsigned lodLevel, const GeometryMeshlets& meshlets);
+    /// Provide float positions as raw vertex data for geometries with quantized positions.
+    /// This keeps CPU-side queries like raycasts and collision shapes working.
+    void DecodeQuantizedPositions();
     /// Clone the model. The geometry data is deep-copied and can be modified in the clone without affecting the original.
     SharedPtr<Model> Clone(const ea::string& cloneName = EMPTY_STRING) const;
 
@@ -195,6 +287,9 @@ public:
         return index < geometryCenters_.size() ? geometryCenters_[index] : Vector3::ZERO;
     }
 
+    /// Return meshlets of geometry LOD level, or null if not present.
+    const GeometryMeshlets* GetGeometryMeshlets(unsigned index, unsigned lodLevel) const;
+
     /// Return geometery bone mappings.
     const ea::vector<ea::vector<unsigned> >& GetGeometryBoneMappings() const { return geometryBoneMappings_; }
 
@@ -222,13 +317,45 @@ public:
     /// Return morph range vertex counts for each vertex buffer.
     const ea::vector<unsigned>& GetMorphRangeCounts() const { return morphRangeCounts_; }
 
+    /// LOD streaming. Finer LOD levels may be streamed only if they are stored in their own buffers.
+    /// Geometries of LOD levels that are not loaded are rendered with the finest loaded LOD level.
+    /// @{
+    /// Return whether the finer LOD levels can be streamed in and out.
+    bool IsLodStreamable() const { return maxStreamedLodsToSkip_ > 0; }
+    /// Return max number of finest LOD levels that may be skipped.
+    unsigned GetMaxStreamedLodsToSkip() const { return maxStreamedLodsToSkip_; }
+    /// Return number of finest LOD levels that are not loaded.
+    unsigned GetStreamedLodsToSkip() const { return streamedLodsToSkip_; }
+    /// Unload finest LOD levels. Number of skipped LOD levels cannot be decreased this way.
+    bool SetStreamedLodsToSkip(unsigned lodsToSkip);
+    /// Return buffers that should be read to load LOD levels up to given number of skipped LOD levels.
+    ea::vector<ModelStreamedBuffer> GetStreamedBuffers(unsigned lodsToSkip) const;
+    /// Read data of streamed buffers from the model file. Thread-safe.
+    static bool ReadStreamedBuffers(Deserializer& source, ea::vector<ModelStreamedBuffer>& buffers);
+    /// Set data of streamed buffers and load finer LOD levels.
+    bool SetStreamedData(const ea::vector<ModelStreamedBuffer>& buffers, unsigned lodsToSkip);
+    /// Report that the LOD level is used for rendering. Thread-safe.
+    void ReportLodLevel(unsigned lodLevel);
+    /// Return the finest LOD level reported since the last call and reset it.
+    unsigned ConsumeLodLevel() { return lodLevel_.exchange(M_MAX_UNSIGNED, std::memory_order_relaxed); }
+    /// @}
+
 private:
+    /// Return whether the buffer used while given number of LOD levels is skipped.
+    static bool IsBufferUsed(unsigned maxLodsToSkip, unsigned lodsToSkip) { return maxLodsToSkip >= lodsToSkip; }
+    /// Calculate max number of skipped LOD levels for each buffer from geometries.
+    void CalculateBufferMaxLodsToSkip(ea::vector<unsigned>& vertexBuffers, ea::vector<unsigned>& indexBuffers) const;
+    /// Set up geometries from streamed geometry descriptions according to loaded LOD levels.
+    void UpdateStreamedGeometries();
+
     /// Class versions (used for serialization)
     /// @{
     static const unsigned legacyVersion = 1; // Fake version for legacy unversioned UMDL/UMD2 file
     static const unsigned morphWeightVersion = 2; // Initial morph weights support added here
+    static const unsigned meshletVersion = 3; // Optional geometry meshlets added here
+    static const unsigned lodStreamingVersion = 4; // LOD levels of buffers for streaming added here
 
-    static const unsigned currentVersion = morphWeightVersion;
+    static const unsigned currentVersion = lodStreamingVersion;
     /// @}
 
     /// Bounding box.
@@ -245,6 +372,8 @@ private:
     ea::vector<ea::vector<unsigned> > geometryBoneMappings_;
     /// Geometry centers.
     ea::vector<Vector3> geometryCenters_;
+    /// Geometry meshlets. May be smaller than geometries.
+    ea::vector<ea::vector<GeometryMeshlets>> geometryMeshlets_;
     /// Vertex morphs.
     ea::vector<ModelMorph> morphs_;
     /// Vertex buffer morph range start.
@@ -257,6 +386,19 @@ private:
     ea::vector<IndexBufferDesc> loadIBData_;
     /// Geometry definitions for asynchronous loading.
     ea::vector<ea::vector<GeometryDesc> > loadGeometries_;
+
+    /// Number of finest LOD levels that are not loaded.
+    unsigned streamedLodsToSkip_{};
+    /// Max number of finest LOD levels that may be skipped.
+    unsigned maxStreamedLodsToSkip_{};
+    /// Vertex buffer descriptions for LOD streaming, without data.
+    ea::vector<VertexBufferDesc> streamedVBDescs_;
+    /// Index buffer descriptions for LOD streaming, without data.
+    ea::vector<IndexBufferDesc> streamedIBDescs_;
+    /// Geometry definitions for LOD streaming.
+    ea::vector<ea::vector<GeometryDesc> > streamedGeometries_;
+    /// The finest reported LOD level.
+    std::atomic<unsigned> lodLevel_{M_MAX_UNSIGNED};
 };
 
 }
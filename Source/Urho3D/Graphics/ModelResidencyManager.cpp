@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Graphics/ModelResidencyManager.h"
+
+#include "../Core/CoreEvents.h"
+#include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
+#include "../IO/Log.h"
+#include "../Resource/ResourceCache.h"
+
+#include <EASTL/shared_ptr.h>
+#include <EASTL/sort.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+ModelResidencyManager::ModelResidencyManager(Context* context)
+    : Object(context)
+{
+    SubscribeToEvent(E_ENDFRAME, &ModelResidencyManager::Update);
+}
+
+ModelResidencyManager::~ModelResidencyManager() = default;
+
+void ModelResidencyManager::AddModel(Model* model)
+{
+    if (!model || model->GetName().empty() || !model->IsLodStreamable())
+        return;
+
+    ModelState& state = models_[model];
+    state = ModelState{};
+    state.model_ = model;
+    state.lodLevelFrame_ = frameNumber_;
+    state.targetLodsToSkip_ = model->GetStreamedLodsToSkip();
+}
+
+void ModelResidencyManager::Update()
+{
+    URHO3D_PROFILE("UpdateModelResidency");
+
+    ++frameNumber_;
+
+    FrameVector<ModelState*> statesToLoad;
+    for (auto iter = models_.begin(); iter != models_.end();)
+    {
+        ModelState& state = iter->second;
+        Model* model = state.model_;
+        if (!model)
+        {
+            iter = models_.erase(iter);
+            continue;
+        }
+
+        // Keep the finest recent LOD level for a while to avoid reloading LOD levels back and forth
+        const unsigned lodLevel = model->ConsumeLodLevel();
+        if (lodLevel <= state.lodLevel_ || frameNumber_ - state.lodLevelFrame_ > streamOutDelay_)
+        {
+            state.lodLevel_ = lodLevel;
+            state.lodLevelFrame_ = frameNumber_;
+        }
+
+        if (!state.isLoading_ && !state.isFailed_)
+        {
+            state.targetLodsToSkip_ = ea::min(state.lodLevel_, model->GetMaxStreamedLodsToSkip());
+
+            // Stream out immediately because it only frees memory
+            const unsigned lodsToSkip = model->GetStreamedLodsToSkip();
+            if (state.targetLodsToSkip_ > lodsToSkip)
+                model->SetStreamedLodsToSkip(state.targetLodsToSkip_);
+            else if (state.targetLodsToSkip_ < lodsToSkip)
+                statesToLoad.push_back(&state);
+        }
+
+        ++iter;
+    }
+
+    // Stream in models that need the finest LOD levels first
+    ea::sort(statesToLoad.begin(), statesToLoad.end(),
+        [](const ModelState* lhs, const ModelState* rhs) { return lhs->targetLodsToSkip_ < rhs->targetLodsToSkip_; });
+
+    for (ModelState* state : statesToLoad)
+    {
+        if (numPendingLoads_ >= maxPendingLoads_)
+            break;
+        QueueLoad(*state);
+    }
+}
+
+void ModelResidencyManager::QueueLoad(ModelState& state)
+{
+    state.isLoading_ = true;
+    ++numPendingLoads_;
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    Context* context = context_;
+    const ea::string fileName = state.model_->GetName();
+    const unsigned lodsToSkip = state.targetLodsToSkip_;
+    const WeakPtr<ModelResidencyManager> weakSelf{this};
+    const WeakPtr<Model> weakModel = state.model_;
+    const auto buffers = ea::make_shared<ea::vector<ModelStreamedBuffer>>(state.model_->GetStreamedBuffers(lodsToSkip));
+
+    // Data is read in the worker thread with low priority so it doesn't delay loading of new resources
+    workQueue->PostTask([=]()
+    {
+        auto cache = context->GetSubsystem<ResourceCache>();
+        AbstractFilePtr file = cache->GetFile(fileName, false);
+        const bool success = file && Model::ReadStreamedBuffers(*file, *buffers);
+
+        workQueue->PostTaskForMainThread([=]()
+        {
+            if (weakSelf)
+                weakSelf->FinishLoad(weakModel, success ? buffers.get() : nullptr, lodsToSkip);
+        });
+    }, TaskPriority::Low);
+}
+
+void ModelResidencyManager::FinishLoad(
+    Model* model, const ea::vector<ModelStreamedBuffer>* buffers, unsigned lodsToSkip)
+{
+    --numPendingLoads_;
+
+    const auto iter = model ? models_.find(model) : models_.end();
+    if (iter == models_.end())
+        return;
+
+    ModelState& state = iter->second;
+    state.isLoading_ = false;
+
+    if (!buffers || !model->SetStreamedData(*buffers, lodsToSkip))
+    {
+        URHO3D_LOGWARNING("Cannot stream LOD levels of model '{}'", model->GetName());
+        state.isFailed_ = true;
+    }
+}
+
+}
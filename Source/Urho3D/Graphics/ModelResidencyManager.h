@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Core/FrameAllocator.h"
+#include "../Core/Object.h"
+#include "../Graphics/Model.h"
+
+#include <EASTL/unordered_map.h>
+
+namespace Urho3D
+{
+
+/// Streams finer LOD levels of models in and out according to LOD levels used for rendering.
+/// Models with streamable LOD levels are loaded with the coarsest LOD levels only when this subsystem is present.
+/// Drawables report LOD levels they render, finer LOD levels are streamed in with the finest requested first
+/// and streamed out if not used for a while.
+class URHO3D_API ModelResidencyManager : public Object
+{
+    URHO3D_OBJECT(ModelResidencyManager, Object);
+
+public:
+    /// Default number of models that may be reloaded at once.
+    static const unsigned DefaultMaxPendingLoads = 4;
+    /// Default number of frames to wait before streaming out LOD levels that are not used anymore.
+    static const unsigned DefaultStreamOutDelay = 60;
+
+    explicit ModelResidencyManager(Context* context);
+    ~ModelResidencyManager() override;
+
+    /// Start managing model. Model should be loaded from file so its LOD levels can be read later.
+    void AddModel(Model* model);
+    /// Choose LOD levels for all models and queue reads. Called automatically at the end of the frame.
+    void Update();
+
+    /// Set max number of models that may be reloaded at once.
+    void SetMaxPendingLoads(unsigned count) { maxPendingLoads_ = ea::max(count, 1u); }
+    /// Return max number of models that may be reloaded at once.
+    unsigned GetMaxPendingLoads() const { return maxPendingLoads_; }
+    /// Set number of frames to wait before streaming out LOD levels that are not used anymore.
+    void SetStreamOutDelay(unsigned frames) { streamOutDelay_ = frames; }
+    /// Return number of frames to wait before streaming out LOD levels that are not used anymore.
+    unsigned GetStreamOutDelay() const { return streamOutDelay_; }
+
+    /// Return number of managed models.
+    unsigned GetNumModels() const { return models_.size(); }
+    /// Return number of models being reloaded.
+    unsigned GetNumPendingLoads() const { return numPendingLoads_; }
+
+private:
+    struct ModelState
+    {
+        WeakPtr<Model> model_;
+        /// The finest LOD level recently reported.
+        unsigned lodLevel_{M_MAX_UNSIGNED};
+        /// Frame when the LOD level was last decreased or reset.
+        unsigned lodLevelFrame_{};
+        /// Number of skipped LOD levels requested for the model.
+        unsigned targetLodsToSkip_{};
+        /// Whether the model is being reloaded now.
+        bool isLoading_{};
+        /// Whether the last load failed. Failed models are not reloaded.
+        bool isFailed_{};
+    };
+
+    /// Start reading LOD levels of the model.
+    void QueueLoad(ModelState& state);
+    /// Apply loaded LOD levels to the model. Called from the main thread.
+    void FinishLoad(Model* model, const ea::vector<ModelStreamedBuffer>* buffers, unsigned lodsToSkip);
+
+    unsigned maxPendingLoads_{DefaultMaxPendingLoads};
+    unsigned streamOutDelay_{DefaultStreamOutDelay};
+
+    ea::unordered_map<Model*, ModelState> models_;
+    unsigned frameNumber_{};
+    unsigned numPendingLoads_{};
+};
+
+}
@@ -24,12 +24,15 @@
 
 #include "../Graphics/ModelView.h"
 
+#include "../Core/WorkQueue.h"
 #include "../Graphics/Geometry.h"
 #include "../Graphics/IndexBuffer.h"
+#include "../Graphics/MeshOptimizer.h"
 #include "../Graphics/Model.h"
 #include "../Graphics/Tangent.h"
 #include "../Graphics/VertexBuffer.h"
 #include "../Graphics/Material.h"
+#include "../IO/ContentHash.h"
 #include "../IO/Log.h"
 
 #include <EASTL/numeric.h>
@@ -46,6 +49,19 @@ static bool CompareVertexElementSemantics(const VertexElement& lhs, const Vertex
     return lhs.semantic_ == rhs.semantic_ && lhs.index_ == rhs.index_;
 }
 
+/// Hash and compare vertices bitwise.
+struct ModelVertexBitwiseHasher
+{
+    size_t operator()(const ModelVertex& vertex) const
+    {
+        return static_cast<size_t>(MakeContentHash(&vertex, sizeof(vertex)));
+    }
+    bool operator()(const ModelVertex& lhs, const ModelVertex& rhs) const
+    {
+        return memcmp(&lhs, &rhs, sizeof(ModelVertex)) == 0;
+    }
+};
+
 /// Read vertex buffer data.
 ea::vector<ModelVertex> GetVertexBufferData(const VertexBuffer* vertexBuffer, unsigned start, unsigned count)
 {
@@ -413,6 +429,41 @@ void ModelVertexFormat::MergeFrom(const ModelVertexFormat& rhs)
         mergeFrom(uv_[i], rhs.uv_[i]);
 }
 
+ModelVertexFormat ModelVertexFormat::Quantized(ModelVertexQuantizationFlags flags) const
+{
+    static const auto quantizeFloats = [](VertexElementType& type)
+    {
+        if (type == TYPE_VECTOR2)
+            type = TYPE_HALF2;
+        else if (type == TYPE_VECTOR3 || type == TYPE_VECTOR4)
+            type = TYPE_HALF4;
+    };
+
+    static const auto quantizeDirection = [](VertexElementType& type)
+    {
+        if (type == TYPE_VECTOR3 || type == TYPE_VECTOR4)
+            type = TYPE_BYTE4_NORM;
+    };
+
+    ModelVertexFormat result = *this;
+    if (flags.Test(ModelVertexQuantizationFlag::Positions))
+        quantizeFloats(result.position_);
+    if (flags.Test(ModelVertexQuantizationFlag::NormalsAndTangents))
+    {
+        quantizeDirection(result.normal_);
+        quantizeDirection(result.tangent_);
+        quantizeDirection(result.binormal_);
+    }
+    if (flags.Test(ModelVertexQuantizationFlag::UVs))
+    {
+        for (VertexElementType& uv : result.uv_)
+            quantizeFloats(uv);
+    }
+    if (flags.Test(ModelVertexQuantizationFlag::BoneWeights) && result.blendWeights_ == TYPE_VECTOR4)
+        result.blendWeights_ = TYPE_UBYTE4_NORM;
+    return result;
+}
+
 unsigned ModelVertexFormat::ToHash() const
 {
     unsigned hash = 0;
@@ -447,7 +498,8 @@ bool GeometryLODView::operator ==(const GeometryLODView& rhs) const
         && indices_ == rhs.indices_
         && lodDistance_ == rhs.lodDistance_
         && vertexFormat_ == rhs.vertexFormat_
-        && morphs_ == rhs.morphs_;
+        && morphs_ == rhs.morphs_
+        && meshlets_ == rhs.meshlets_;
 }
 
 bool GeometryView::operator ==(const GeometryView& rhs) const
@@ -812,7 +864,7 @@ void GeometryLODView::RecalculateSmoothNormals()
         vertex.normal_ = vertex.normal_.ToVector3().Normalized().ToVector4();
 }
 
-void GeometryLODView::RecalculateTangents()
+void GeometryLODView::RecalculateTangents(WorkQueue* workQueue)
 {
     if (!IsTriangleGeometry())
     {
@@ -822,7 +874,110 @@ void GeometryLODView::RecalculateTangents()
 
     GenerateTangents(vertices_.data(), sizeof(ModelVertex),
         indices_.data(), sizeof(unsigned), 0, indices_.size(),
-        offsetof(ModelVertex, normal_), offsetof(ModelVertex, uv_), offsetof(ModelVertex, tangent_));
+        offsetof(ModelVertex, normal_), offsetof(ModelVertex, uv_), offsetof(ModelVertex, tangent_), workQueue);
+}
+
+void GeometryLODView::WeldVertices()
+{
+    if (!morphs_.empty())
+        return;
+
+    ea::unordered_map<ModelVertex, unsigned, ModelVertexBitwiseHasher, ModelVertexBitwiseHasher> vertexToIndex;
+    ea::vector<ModelVertex> newVertices;
+    ea::vector<unsigned> remap(vertices_.size());
+    for (unsigned i = 0; i < vertices_.size(); ++i)
+    {
+        const auto [iter, isNew] = vertexToIndex.emplace(vertices_[i], newVertices.size());
+        if (isNew)
+            newVertices.push_back(vertices_[i]);
+        remap[i] = iter->second;
+    }
+
+    if (newVertices.size() == vertices_.size())
+        return;
+
+    for (unsigned& index : indices_)
+        index = remap[index];
+    vertices_ = ea::move(newVertices);
+    meshlets_ = {};
+}
+
+void GeometryLODView::OptimizeTriangles()
+{
+    if (primitiveType_ != TRIANGLE_LIST || indices_.size() < 3)
+        return;
+
+    const unsigned numVertices = vertices_.size();
+    OptimizeVertexCache(indices_, numVertices);
+
+    ea::vector<Vector3> positions(numVertices);
+    for (unsigned i = 0; i < numVertices; ++i)
+        positions[i] = vertices_[i].position_.ToVector3();
+    OptimizeOverdraw(indices_, positions);
+
+    RemoveUnusedVertices();
+}
+
+void GeometryLODView::RemoveUnusedVertices()
+{
+    const unsigned numVertices = vertices_.size();
+    const ea::vector<unsigned> remap = GenerateVertexFetchRemap(indices_, numVertices);
+    const unsigned numUsedVertices = numVertices - ea::count(remap.begin(), remap.end(), M_MAX_UNSIGNED);
+
+    ea::vector<ModelVertex> newVertices(numUsedVertices);
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        if (remap[i] != M_MAX_UNSIGNED)
+            newVertices[remap[i]] = vertices_[i];
+    }
+    vertices_ = ea::move(newVertices);
+    meshlets_ = {};
+
+    for (unsigned& index : indices_)
+        index = remap[index];
+
+    for (auto& [morphIndex, morphVector] : morphs_)
+    {
+        ea::erase_if(morphVector, [&](const ModelVertexMorph& morph) { return remap[morph.index_] == M_MAX_UNSIGNED; });
+        for (ModelVertexMorph& morph : morphVector)
+            morph.index_ = remap[morph.index_];
+        NormalizeModelVertexMorphVector(morphVector);
+    }
+}
+
+GeometryLODView GeometryLODView::Simplify(unsigned targetNumTriangles, float maxError, float* resultError) const
+{
+    GeometryLODView result = *this;
+    if (primitiveType_ != TRIANGLE_LIST)
+    {
+        assert(0);
+        return result;
+    }
+
+    const unsigned numVertices = vertices_.size();
+    ea::vector<Vector3> positions(numVertices);
+    for (unsigned i = 0; i < numVertices; ++i)
+        positions[i] = vertices_[i].position_.ToVector3();
+
+    result.indices_ = SimplifyMesh(indices_, positions, targetNumTriangles, maxError, resultError);
+    result.RemoveUnusedVertices();
+    return result;
+}
+
+void GeometryLODView::GenerateMeshlets(unsigned maxVertices, unsigned maxTriangles)
+{
+    if (primitiveType_ != TRIANGLE_LIST)
+    {
+        assert(0);
+        return;
+    }
+
+    const unsigned numVertices = vertices_.size();
+    ea::vector<Vector3> positions(numVertices);
+    for (unsigned i = 0; i < numVertices; ++i)
+        positions[i] = vertices_[i].position_.ToVector3();
+
+    meshlets_ = BuildMeshlets(indices_, positions, maxVertices, maxTriangles);
 }
 
 unsigned GeometryView::CalculateNumMorphs() const
@@ -1000,6 +1155,9 @@ bool ModelView::ImportModel(const Model* model)
             ea::erase_if(geometry.morphs_,
                 [](const auto& elem) { return elem.second.empty(); });
 
+            if (const GeometryMeshlets* meshlets = model->GetGeometryMeshlets(geometryIndex, lodIndex))
+                geometry.meshlets_ = *meshlets;
+
             geometries_[geometryIndex].lods_[lodIndex] = ea::move(geometry);
         }
     }
@@ -1044,8 +1202,20 @@ bool ModelView::ImportModel(const Model* model)
     return true;
 }
 
-void ModelView::ExportModel(Model* model) const
+void ModelView::ExportModel(Model* model, ModelVertexQuantizationFlags quantization, bool streamableLODs) const
 {
+    // Software skinning and morphing expect floating point positions, normals and tangents
+    const auto getVertexFormat = [&](const GeometryLODView& geometryLod)
+    {
+        ModelVertexQuantizationFlags flags = quantization;
+        if (!bones_.empty() || !geometryLod.morphs_.empty())
+        {
+            flags.Set(ModelVertexQuantizationFlag::Positions, false);
+            flags.Set(ModelVertexQuantizationFlag::NormalsAndTangents, false);
+        }
+        return geometryLod.vertexFormat_.Quantized(flags);
+    };
+
     struct VertexBufferData
     {
         ea::vector<ModelVertex> vertices_;
@@ -1056,15 +1226,52 @@ void ModelView::ExportModel(Model* model) const
         unsigned morphRangeCount_{};
     };
 
-    // Collect vertices and indices
-    ea::unordered_map<ModelVertexFormat, VertexBufferData> vertexBuffersData;
-    ea::vector<unsigned> indexBufferData;
+    /// Vertex and index buffers shared by LOD levels with the same max number of skipped LOD levels.
+    struct BufferGroup
+    {
+        unsigned maxLodsToSkip_{};
+        ea::unordered_map<ModelVertexFormat, VertexBufferData> vertexBuffersData_;
+        ea::vector<unsigned> indexBufferData_;
+        SharedPtr<IndexBuffer> indexBuffer_;
+    };
+
+    // Morphs refer to vertex buffers and cannot be streamed
+    const bool hasMorphs = !morphs_.empty();
+    if (streamableLODs && hasMorphs)
+        URHO3D_LOGWARNING("Model '{}' has morphs, LOD levels are not streamable", name_);
 
+    // The coarsest LOD level of each geometry is used no matter how many LOD levels are skipped
+    const auto getMaxLodsToSkip = [&](const GeometryView& geometry, unsigned lodIndex)
+    {
+        if (!streamableLODs || hasMorphs || lodIndex + 1 == geometry.lods_.size())
+            return M_MAX_UNSIGNED;
+        return lodIndex;
+    };
+
+    // Buffers of the coarsest LOD levels go first, so they are read first when the model is streamed
+    ea::vector<BufferGroup> bufferGroups;
+    const auto getBufferGroup = [&](unsigned maxLodsToSkip) -> BufferGroup&
+    {
+        const auto iter = ea::find_if(bufferGroups.begin(), bufferGroups.end(),
+            [&](const BufferGroup& group) { return group.maxLodsToSkip_ <= maxLodsToSkip; });
+        if (iter != bufferGroups.end() && iter->maxLodsToSkip_ == maxLodsToSkip)
+            return *iter;
+
+        BufferGroup& group = *bufferGroups.insert(iter, BufferGroup{});
+        group.maxLodsToSkip_ = maxLodsToSkip;
+        return group;
+    };
+
+    // Collect vertices and indices
     for (const GeometryView& sourceGeometry : geometries_)
     {
-        for (const GeometryLODView& sourceGeometryLod : sourceGeometry.lods_)
+        for (unsigned lodIndex = 0; lodIndex < sourceGeometry.lods_.size(); ++lodIndex)
         {
-            VertexBufferData& vertexBufferData = vertexBuffersData[sourceGeometryLod.vertexFormat_];
+            const GeometryLODView& sourceGeometryLod = sourceGeometry.lods_[lodIndex];
+            BufferGroup& group = getBufferGroup(getMaxLodsToSkip(sourceGeometry, lodIndex));
+            ea::vector<unsigned>& indexBufferData = group.indexBufferData_;
+
+            VertexBufferData& vertexBufferData = group.vertexBuffersData_[getVertexFormat(sourceGeometryLod)];
             const unsigned startVertex = vertexBufferData.vertices_.size();
             const unsigned startIndex = indexBufferData.size();
 
@@ -1090,34 +1297,37 @@ void ModelView::ExportModel(Model* model) const
     }
 
     // Create vertex buffers
-    for (auto& [vertexFormat, vertexBufferData] : vertexBuffersData)
+    for (BufferGroup& group : bufferGroups)
     {
-        const auto vertexElements = CollectVertexElements(vertexFormat);
-        if (vertexElements.empty())
-            URHO3D_LOGERROR("No vertex elements in vertex buffer");
-
-        auto vertexBuffer = MakeShared<VertexBuffer>(context_);
-        vertexBuffer->SetDebugName(Format("Model '{}' Vertex Buffer", name_));
-        vertexBuffer->SetShadowed(true);
-        vertexBuffer->SetSize(vertexBufferData.vertices_.size(), vertexElements);
-        SetVertexBufferData(vertexBuffer, vertexBufferData.vertices_);
-
-        unsigned minMorphVertex = M_MAX_UNSIGNED;
-        unsigned maxMorphVertex = 0;
-        for (const ModelVertexMorphVector& morphData : vertexBufferData.morphs_)
+        for (auto& [vertexFormat, vertexBufferData] : group.vertexBuffersData_)
         {
-            for (const ModelVertexMorph& vertexMorph : morphData)
+            const auto vertexElements = CollectVertexElements(vertexFormat);
+            if (vertexElements.empty())
+                URHO3D_LOGERROR("No vertex elements in vertex buffer");
+
+            auto vertexBuffer = MakeShared<VertexBuffer>(context_);
+            vertexBuffer->SetDebugName(Format("Model '{}' Vertex Buffer", name_));
+            vertexBuffer->SetShadowed(true);
+            vertexBuffer->SetSize(vertexBufferData.vertices_.size(), vertexElements);
+            SetVertexBufferData(vertexBuffer, vertexBufferData.vertices_);
+
+            unsigned minMorphVertex = M_MAX_UNSIGNED;
+            unsigned maxMorphVertex = 0;
+            for (const ModelVertexMorphVector& morphData : vertexBufferData.morphs_)
             {
-                minMorphVertex = ea::min(minMorphVertex, vertexMorph.index_);
-                maxMorphVertex = ea::max(maxMorphVertex, vertexMorph.index_);
+                for (const ModelVertexMorph& vertexMorph : morphData)
+                {
+                    minMorphVertex = ea::min(minMorphVertex, vertexMorph.index_);
+                    maxMorphVertex = ea::max(maxMorphVertex, vertexMorph.index_);
+                }
             }
-        }
 
-        vertexBufferData.buffer_ = vertexBuffer;
-        if (minMorphVertex <= maxMorphVertex)
-        {
-            vertexBufferData.morphRangeStart_ = minMorphVertex;
-            vertexBufferData.morphRangeCount_ = maxMorphVertex - minMorphVertex + 1;
+            vertexBufferData.buffer_ = vertexBuffer;
+            if (minMorphVertex <= maxMorphVertex)
+            {
+                vertexBufferData.morphRangeStart_ = minMorphVertex;
+                vertexBufferData.morphRangeCount_ = maxMorphVertex - minMorphVertex + 1;
+            }
         }
     }
 
@@ -1125,11 +1335,14 @@ void ModelView::ExportModel(Model* model) const
     ea::vector<SharedPtr<VertexBuffer>> vertexBuffers;
     ea::vector<unsigned> morphRangeStarts;
     ea::vector<unsigned> morphRangeCounts;
-    for (auto& [vertexFormat, vertexBufferData] : vertexBuffersData)
+    for (BufferGroup& group : bufferGroups)
     {
-        vertexBuffers.push_back(vertexBufferData.buffer_);
-        morphRangeStarts.push_back(vertexBufferData.morphRangeStart_);
-        morphRangeCounts.push_back(vertexBufferData.morphRangeCount_);
+        for (auto& [vertexFormat, vertexBufferData] : group.vertexBuffersData_)
+        {
+            vertexBuffers.push_back(vertexBufferData.buffer_);
+            morphRangeStarts.push_back(vertexBufferData.morphRangeStart_);
+            morphRangeCounts.push_back(vertexBufferData.morphRangeCount_);
+        }
     }
 
     // Create morphs
@@ -1141,31 +1354,41 @@ void ModelView::ExportModel(Model* model) const
         morphs[i].weight_ = morphs_[i].initialWeight_;
     }
 
-    for (auto& [vertexFormat, vertexBufferData] : vertexBuffersData)
+    for (BufferGroup& group : bufferGroups)
     {
-        const unsigned numMorphsForVertexBuffer = vertexBufferData.morphs_.size();
-        if (morphs.size() < numMorphsForVertexBuffer)
-            morphs.resize(numMorphsForVertexBuffer);
-
-        for (unsigned i = 0; i < numMorphsForVertexBuffer; ++i)
+        for (auto& [vertexFormat, vertexBufferData] : group.vertexBuffersData_)
         {
-            const ModelVertexMorphVector& morphDataForBuffer = vertexBufferData.morphs_[i];
-            ModelMorph& modelMorph = morphs[i];
+            const unsigned numMorphsForVertexBuffer = vertexBufferData.morphs_.size();
+            if (morphs.size() < numMorphsForVertexBuffer)
+                morphs.resize(numMorphsForVertexBuffer);
 
-            const unsigned vertexBufferIndex = vertexBuffers.index_of(vertexBufferData.buffer_);
-            VertexBufferMorph vertexBufferMorph = CreateVertexBufferMorph(morphDataForBuffer);
-            if (vertexBufferMorph.vertexCount_ > 0)
-                modelMorph.buffers_[vertexBufferIndex] = ea::move(vertexBufferMorph);
+            for (unsigned i = 0; i < numMorphsForVertexBuffer; ++i)
+            {
+                const ModelVertexMorphVector& morphDataForBuffer = vertexBufferData.morphs_[i];
+                ModelMorph& modelMorph = morphs[i];
+
+                const unsigned vertexBufferIndex = vertexBuffers.index_of(vertexBufferData.buffer_);
+                VertexBufferMorph vertexBufferMorph = CreateVertexBufferMorph(morphDataForBuffer);
+                if (vertexBufferMorph.vertexCount_ > 0)
+                    modelMorph.buffers_[vertexBufferIndex] = ea::move(vertexBufferMorph);
+            }
         }
     }
 
-    // Create index buffer
-    const bool largeIndices = HasLargeIndices(indexBufferData);
-    auto indexBuffer = MakeShared<IndexBuffer>(context_);
-    indexBuffer->SetDebugName(Format("Model '{}' Index Buffer", name_));
-    indexBuffer->SetShadowed(true);
-    indexBuffer->SetSize(indexBufferData.size(), largeIndices);
-    indexBuffer->SetUnpackedData(indexBufferData.data());
+    // Create index buffers
+    ea::vector<SharedPtr<IndexBuffer>> indexBuffers;
+    for (BufferGroup& group : bufferGroups)
+    {
+        const bool largeIndices = HasLargeIndices(group.indexBufferData_);
+        auto indexBuffer = MakeShared<IndexBuffer>(context_);
+        indexBuffer->SetDebugName(Format("Model '{}' Index Buffer", name_));
+        indexBuffer->SetShadowed(true);
+        indexBuffer->SetSize(group.indexBufferData_.size(), largeIndices);
+        indexBuffer->SetUnpackedData(group.indexBufferData_.data());
+
+        group.indexBuffer_ = indexBuffer;
+        indexBuffers.push_back(indexBuffer);
+    }
 
     // Create model
     model->SetName(name_);
@@ -1174,12 +1397,12 @@ void ModelView::ExportModel(Model* model) const
 
     model->SetBoundingBox(CalculateBoundingBox());
     model->SetVertexBuffers(vertexBuffers, morphRangeStarts, morphRangeCounts);
-    model->SetIndexBuffers({ indexBuffer });
+    model->SetIndexBuffers(indexBuffers);
     model->SetMorphs(morphs);
 
     // Write geometries
-    unsigned indexStart = 0;
-    ea::unordered_map<ModelVertexFormat, unsigned> vertexStart;
+    ea::unordered_map<unsigned, unsigned> indexStart;
+    ea::unordered_map<ea::pair<unsigned, ModelVertexFormat>, unsigned> vertexStart;
 
     const unsigned numGeometries = geometries_.size();
     model->SetNumGeometries(numGeometries);
@@ -1196,22 +1419,29 @@ void ModelView::ExportModel(Model* model) const
         for (unsigned lodIndex = 0; lodIndex < numLods; ++lodIndex)
         {
             const GeometryLODView& sourceGeometryLod = sourceGeometry.lods_[lodIndex];
-            const ModelVertexFormat& vertexFormat = sourceGeometryLod.vertexFormat_;
+            const unsigned maxLodsToSkip = getMaxLodsToSkip(sourceGeometry, lodIndex);
+            BufferGroup& group = getBufferGroup(maxLodsToSkip);
+            const ModelVertexFormat vertexFormat = getVertexFormat(sourceGeometryLod);
             const unsigned indexCount = sourceGeometryLod.indices_.size();
             const unsigned vertexCount = sourceGeometryLod.vertices_.size();
 
+            unsigned& groupIndexStart = indexStart[maxLodsToSkip];
+            unsigned& groupVertexStart = vertexStart[ea::make_pair(maxLodsToSkip, vertexFormat)];
+
             SharedPtr<Geometry> geometry = MakeShared<Geometry>(context_);
 
             geometry->SetNumVertexBuffers(1);
-            geometry->SetVertexBuffer(0, vertexBuffersData[vertexFormat].buffer_);
-            geometry->SetIndexBuffer(indexBuffer);
+            geometry->SetVertexBuffer(0, group.vertexBuffersData_[vertexFormat].buffer_);
+            geometry->SetIndexBuffer(group.indexBuffer_);
             geometry->SetLodDistance(sourceGeometryLod.lodDistance_);
-            geometry->SetDrawRange(sourceGeometryLod.primitiveType_, indexStart, indexCount, vertexStart[vertexFormat], vertexCount);
+            geometry->SetDrawRange(sourceGeometryLod.primitiveType_, groupIndexStart, indexCount, groupVertexStart, vertexCount);
 
             model->SetGeometry(geometryIndex, lodIndex, geometry);
+            if (!sourceGeometryLod.meshlets_.IsEmpty())
+                model->SetGeometryMeshlets(geometryIndex, lodIndex, sourceGeometryLod.meshlets_);
 
-            indexStart += indexCount;
-            vertexStart[vertexFormat] += vertexCount;
+            groupIndexStart += indexCount;
+            groupVertexStart += vertexCount;
         }
     }
 
@@ -1246,12 +1476,14 @@ void ModelView::ExportModel(Model* model) const
 
     skeleton.UpdateBoneOrder();
     model->SetSkeleton(skeleton);
+    model->DecodeQuantizedPositions();
 }
 
-SharedPtr<Model> ModelView::ExportModel(const ea::string& name) const
+SharedPtr<Model> ModelView::ExportModel(
+    const ea::string& name, ModelVertexQuantizationFlags quantization, bool streamableLODs) const
 {
     auto model = MakeShared<Model>(context_);
-    ExportModel(model);
+    ExportModel(model, quantization, streamableLODs);
     if (!name.empty())
         model->SetName(name);
     return model;
@@ -1394,6 +1626,11 @@ void ModelView::CalculateMissingNormals(bool flatNormals)
 
 void ModelView::CalculateMissingTangents()
 {
+    // Large geometries are split between threads, small geometries are processed in parallel with each other
+    static const unsigned maxSmallGeometryIndices = 3 * 16384;
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    ea::vector<GeometryLODView*> smallGeometries;
     for (GeometryView& geometryView : geometries_)
     {
         for (GeometryLODView& lodView : geometryView.lods_)
@@ -1404,7 +1641,85 @@ void ModelView::CalculateMissingTangents()
                 continue;
 
             lodView.vertexFormat_.tangent_ = TYPE_VECTOR4;
-            lodView.RecalculateTangents();
+            if (workQueue && lodView.indices_.size() > maxSmallGeometryIndices)
+                lodView.RecalculateTangents(workQueue);
+            else
+                smallGeometries.push_back(&lodView);
+        }
+    }
+
+    if (workQueue && workQueue->IsMultithreaded())
+        ForEachParallel(workQueue, smallGeometries, [](unsigned, GeometryLODView* lodView) { lodView->RecalculateTangents(); });
+    else
+    {
+        for (GeometryLODView* lodView : smallGeometries)
+            lodView->RecalculateTangents();
+    }
+}
+
+void ModelView::OptimizeGeometries(bool weldVertices)
+{
+    for (GeometryView& geometryView : geometries_)
+    {
+        for (GeometryLODView& lodView : geometryView.lods_)
+        {
+            if (lodView.primitiveType_ != TRIANGLE_LIST)
+                continue;
+
+            if (weldVertices)
+                lodView.WeldVertices();
+            lodView.OptimizeTriangles();
+        }
+    }
+}
+
+void ModelView::GenerateLODs(unsigned numLODs, float triangleRatio, float lodDistance, float maxError)
+{
+    if (numLODs == 0 || triangleRatio <= 0.0f || triangleRatio >= 1.0f)
+        return;
+
+    // Screen-space size of simplified edges stays the same if distance grows proportionally to edge length
+    const float distanceScale = 1.0f / Sqrt(triangleRatio);
+    for (GeometryView& geometryView : geometries_)
+    {
+        if (geometryView.lods_.size() != 1 || geometryView.lods_[0].primitiveType_ != TRIANGLE_LIST)
+            continue;
+
+        const GeometryLODView& sourceLod = geometryView.lods_[0];
+        const unsigned numSourceTriangles = sourceLod.GetNumPrimitives();
+
+        float targetRatio = 1.0f;
+        float targetDistance = lodDistance;
+        unsigned numPreviousTriangles = numSourceTriangles;
+        for (unsigned lodIndex = 1; lodIndex <= numLODs; ++lodIndex)
+        {
+            targetRatio *= triangleRatio;
+            const auto targetNumTriangles = static_cast<unsigned>(numSourceTriangles * targetRatio);
+
+            GeometryLODView lodView = geometryView.lods_[0].Simplify(targetNumTriangles, maxError);
+            const unsigned numTriangles = lodView.GetNumPrimitives();
+
+            // Stop if simplification is limited by error and the LOD is not worth it
+            if (numTriangles == 0 || numTriangles > numPreviousTriangles * (1.0f + triangleRatio) / 2)
+                break;
+
+            lodView.lodDistance_ = targetDistance;
+            geometryView.lods_.push_back(ea::move(lodView));
+
+            numPreviousTriangles = numTriangles;
+            targetDistance *= distanceScale;
+        }
+    }
+}
+
+void ModelView::GenerateMeshlets(unsigned maxVertices, unsigned maxTriangles)
+{
+    for (GeometryView& geometryView : geometries_)
+    {
+        for (GeometryLODView& lodView : geometryView.lods_)
+        {
+            if (lodView.primitiveType_ == TRIANGLE_LIST)
+                lodView.GenerateMeshlets(maxVertices, maxTriangles);
         }
     }
 }
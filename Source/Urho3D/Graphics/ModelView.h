@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "../Graphics/Model.h"
 #include "../Graphics/VertexBuffer.h"
 #include "../Graphics/Skeleton.h"
 #include "../Math/BoundingBox.h"
@@ -33,6 +34,25 @@ namespace Urho3D
 {
 
 class Model;
+class WorkQueue;
+
+/// Vertex elements that are stored in compact formats when Model is exported.
+enum class ModelVertexQuantizationFlag
+{
+    None = 0,
+    /// Store positions as half floats. Ignored for skinned and morphed geometries.
+    Positions = 1 << 0,
+    /// Store normals, tangents and binormals as signed normalized bytes. Ignored for skinned and morphed geometries.
+    NormalsAndTangents = 1 << 1,
+    /// Store texture coordinates as half floats.
+    UVs = 1 << 2,
+    /// Store bone weights as normalized unsigned bytes.
+    BoneWeights = 1 << 3,
+
+    All = Positions | NormalsAndTangents | UVs | BoneWeights,
+};
+
+URHO3D_FLAGSET(ModelVertexQuantizationFlag, ModelVertexQuantizationFlags);
 
 /// Model vertex format, unpacked for easy editing.
 struct URHO3D_API ModelVertexFormat
@@ -54,6 +74,8 @@ struct URHO3D_API ModelVertexFormat
     /// @}
 
     void MergeFrom(const ModelVertexFormat& rhs);
+    /// Return format with floating point elements replaced by compact ones.
+    ModelVertexFormat Quantized(ModelVertexQuantizationFlags flags) const;
     unsigned ToHash() const;
 
     bool operator ==(const ModelVertexFormat& rhs) const;
@@ -156,6 +178,8 @@ struct URHO3D_API GeometryLODView
     float lodDistance_{};
     ModelVertexFormat vertexFormat_;
     ea::unordered_map<unsigned, ModelVertexMorphVector> morphs_;
+    /// Optional meshlets. Reset by operations that change vertex order.
+    GeometryMeshlets meshlets_;
 
     /// Getters
     /// @{
@@ -175,7 +199,20 @@ struct URHO3D_API GeometryLODView
     void InvalidateNormalsAndTangents();
     void RecalculateFlatNormals();
     void RecalculateSmoothNormals();
-    void RecalculateTangents();
+    /// Recalculate tangents. Large geometry is processed in multiple threads if work queue is provided.
+    void RecalculateTangents(WorkQueue* workQueue = nullptr);
+
+    /// Merge bitwise identical vertices. Ignored if there are morphs.
+    void WeldVertices();
+    /// Reorder triangles and vertices of triangle list for vertex cache, overdraw and vertex fetch efficiency.
+    void OptimizeTriangles();
+    /// Remove vertices that are not referenced by indices. Vertices are reordered by first use.
+    void RemoveUnusedVertices();
+    /// Return triangle list simplified to the target number of triangles.
+    /// Error threshold is relative to the geometry extent. Actual error is returned via resultError, if specified.
+    GeometryLODView Simplify(unsigned targetNumTriangles, float maxError, float* resultError = nullptr) const;
+    /// Split triangle list into meshlets for GPU-driven culling.
+    void GenerateMeshlets(unsigned maxVertices, unsigned maxTriangles);
 
     /// Iterate all triangles in primitive. Callback is called with three vertex indices.
     template <class T>
@@ -298,8 +335,12 @@ public:
     /// Import and export from/to native Model.
     /// @{
     bool ImportModel(const Model* model);
-    void ExportModel(Model* model) const;
-    SharedPtr<Model> ExportModel(const ea::string& name = EMPTY_STRING) const;
+    /// If streamableLODs is set, each LOD level is stored in its own buffers, the coarsest LOD levels first,
+    /// so finer LOD levels can be streamed. Ignored for models with morphs.
+    void ExportModel(Model* model, ModelVertexQuantizationFlags quantization = ModelVertexQuantizationFlag::None,
+        bool streamableLODs = false) const;
+    SharedPtr<Model> ExportModel(const ea::string& name = EMPTY_STRING,
+        ModelVertexQuantizationFlags quantization = ModelVertexQuantizationFlag::None, bool streamableLODs = false) const;
     ResourceRefList ExportMaterialList() const;
     /// @}
 
@@ -315,12 +356,21 @@ public:
     void ScaleGeometries(float scale);
     /// Calculate normals for geometries without normals in vertex format. Resets tangents for affected geometries.
     void CalculateMissingNormals(bool flatNormals = false);
-    /// Calculate tangents for geometries without tangents in vertex format.
+    /// Calculate tangents for geometries without tangents in vertex format. Geometries are processed in parallel.
     void CalculateMissingTangents();
     /// Normalize bone weights and cleanup invalid bones. Ignored if there's no bones.
     void RepairBoneWeights();
     /// Recalculate bounding boxes for bones.
     void RecalculateBoneBoundingBoxes();
+    /// Optimize triangle list geometries for rendering, optionally merging identical vertices first.
+    void OptimizeGeometries(bool weldVertices = false);
+    /// Generate LODs for triangle list geometries that have exactly one LOD.
+    /// Each LOD has triangleRatio of triangles of the previous one. First generated LOD is used at lodDistance,
+    /// distances of next LODs are scaled by the expected growth of edge length.
+    /// Generation stops when the simplification error would exceed maxError, relative to the geometry extent.
+    void GenerateLODs(unsigned numLODs, float triangleRatio, float lodDistance, float maxError);
+    /// Generate meshlets for all triangle list geometries. Should be called after all other geometry processing.
+    void GenerateMeshlets(unsigned maxVertices = 64, unsigned maxTriangles = 124);
 
     /// Set contents
     /// @{
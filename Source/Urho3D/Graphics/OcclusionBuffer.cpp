@@ -29,6 +29,10 @@
 #include "../Graphics/OcclusionBuffer.h"
 #include "../IO/Log.h"
 
+#ifdef URHO3D_SSE
+#include <emmintrin.h>
+#endif
+
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -45,6 +49,107 @@ enum ClipMask : unsigned
 };
 URHO3D_FLAGSET(ClipMask, ClipMaskFlags);
 
+namespace
+{
+
+/// Number of pixels merged by one task.
+const unsigned MergeBucketSize = 16384;
+
+#ifdef URHO3D_SSE
+/// Return per-component minimum of integers. SSE2 has no instruction for it.
+inline __m128i MinInt4(__m128i lhs, __m128i rhs)
+{
+    const __m128i mask = _mm_cmplt_epi32(lhs, rhs);
+    return _mm_or_si128(_mm_and_si128(mask, lhs), _mm_andnot_si128(mask, rhs));
+}
+
+/// Return per-component maximum of integers.
+inline __m128i MaxInt4(__m128i lhs, __m128i rhs)
+{
+    const __m128i mask = _mm_cmpgt_epi32(lhs, rhs);
+    return _mm_or_si128(_mm_and_si128(mask, lhs), _mm_andnot_si128(mask, rhs));
+}
+
+/// Return minimum of interleaved min values and maximum of interleaved max values.
+inline __m128i MinMaxInt4(__m128i lhs, __m128i rhs)
+{
+    const __m128i maxMask = _mm_setr_epi32(0, -1, 0, -1);
+    return _mm_or_si128(_mm_andnot_si128(maxMask, MinInt4(lhs, rhs)), _mm_and_si128(maxMask, MaxInt4(lhs, rhs)));
+}
+
+/// Shuffle integers of two vectors like _mm_shuffle_ps.
+template <int Mask>
+inline __m128i ShuffleInt4(__m128i lhs, __m128i rhs)
+{
+    return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lhs), _mm_castsi128_ps(rhs), Mask));
+}
+
+/// Return horizontal minimum of floats.
+inline float HorizontalMin(__m128 value)
+{
+    value = _mm_min_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1)));
+    value = _mm_min_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm_cvtss_f32(value);
+}
+
+/// Return horizontal maximum of floats.
+inline float HorizontalMax(__m128 value)
+{
+    value = _mm_max_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1)));
+    value = _mm_max_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm_cvtss_f32(value);
+}
+#endif
+
+/// Write interpolated depth to the span of pixels if closer.
+inline void DrawSpan(int* dest, int* end, int invZ, int dInvZdX)
+{
+#ifdef URHO3D_SSE
+    if (end - dest >= 4)
+    {
+        __m128i invZ4 = _mm_add_epi32(_mm_set1_epi32(invZ), _mm_setr_epi32(0, dInvZdX, dInvZdX * 2, dInvZdX * 3));
+        const __m128i step4 = _mm_set1_epi32(dInvZdX * 4);
+        while (end - dest >= 4)
+        {
+            auto dest4 = reinterpret_cast<__m128i*>(dest);
+            _mm_storeu_si128(dest4, MinInt4(invZ4, _mm_loadu_si128(dest4)));
+            invZ4 = _mm_add_epi32(invZ4, step4);
+            dest += 4;
+        }
+        invZ = _mm_cvtsi128_si32(invZ4);
+    }
+#endif
+    while (dest < end)
+    {
+        if (invZ < *dest)
+            *dest = invZ;
+        invZ += dInvZdX;
+        ++dest;
+    }
+}
+
+/// Merge depth values of the thread buffer into the destination buffer.
+inline void MergeDepth(int* dest, const int* src, unsigned count)
+{
+    unsigned i = 0;
+#ifdef URHO3D_SSE
+    for (; i + 4 <= count; i += 4)
+    {
+        auto dest4 = reinterpret_cast<__m128i*>(dest + i);
+        const __m128i src4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(dest4, MinInt4(src4, _mm_loadu_si128(dest4)));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        // If thread buffer's depth value is closer, overwrite the original
+        if (src[i] < dest[i])
+            dest[i] = src[i];
+    }
+}
+
+}
+
 OcclusionBuffer::OcclusionBuffer(Context* context) :
     Object(context)
 {
@@ -245,6 +350,33 @@ void OcclusionBuffer::BuildDepthHierarchy()
             if (y * 2 + 1 < height_)
             {
                 int* src2 = src + width_;
+#ifdef URHO3D_SSE
+                // Reduce 8x2 pixels into 4 depth values at once
+                while (end - dest >= 4)
+                {
+                    const __m128i upper0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+                    const __m128i upper1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4));
+                    const __m128i lower0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src2));
+                    const __m128i lower1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src2 + 4));
+
+                    const __m128i min0 = MinInt4(upper0, lower0);
+                    const __m128i min1 = MinInt4(upper1, lower1);
+                    const __m128i max0 = MaxInt4(upper0, lower0);
+                    const __m128i max1 = MaxInt4(upper1, lower1);
+
+                    const __m128i minValue = MinInt4(ShuffleInt4<_MM_SHUFFLE(2, 0, 2, 0)>(min0, min1),
+                        ShuffleInt4<_MM_SHUFFLE(3, 1, 3, 1)>(min0, min1));
+                    const __m128i maxValue = MaxInt4(ShuffleInt4<_MM_SHUFFLE(2, 0, 2, 0)>(max0, max1),
+                        ShuffleInt4<_MM_SHUFFLE(3, 1, 3, 1)>(max0, max1));
+
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), _mm_unpacklo_epi32(minValue, maxValue));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 2), _mm_unpackhi_epi32(minValue, maxValue));
+
+                    src += 8;
+                    src2 += 8;
+                    dest += 4;
+                }
+#endif
                 while (dest < end)
                 {
                     int minUpper = Min(src[0], src[1]);
@@ -290,6 +422,27 @@ void OcclusionBuffer::BuildDepthHierarchy()
             if (y * 2 + 1 < prevHeight)
             {
                 DepthValue* src2 = src + prevWidth;
+#ifdef URHO3D_SSE
+                // Reduce 4x2 depth values into 2 depth values at once
+                while (end - dest >= 2)
+                {
+                    const __m128i upper0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+                    const __m128i upper1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2));
+                    const __m128i lower0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src2));
+                    const __m128i lower1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src2 + 2));
+
+                    const __m128i value0 = MinMaxInt4(upper0, lower0);
+                    const __m128i value1 = MinMaxInt4(upper1, lower1);
+                    const __m128i value = MinMaxInt4(ShuffleInt4<_MM_SHUFFLE(1, 0, 1, 0)>(value0, value1),
+                        ShuffleInt4<_MM_SHUFFLE(3, 2, 3, 2)>(value0, value1));
+
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), value);
+
+                    src += 4;
+                    src2 += 4;
+                    dest += 2;
+                }
+#endif
                 while (dest < end)
                 {
                     int minUpper = Min(src[0].min_, src[1].min_);
@@ -331,6 +484,56 @@ bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
     if (buffers_.empty())
         return true;
 
+    // Transform to screen space. If any of the corners cross the near plane, assume visible
+    float minX, maxX, minY, maxY, minZ;
+
+#ifdef URHO3D_SSE
+    // Transform four corners at once, corners are ordered like in the scalar version
+    const Vector3& boxMin = worldSpaceBox.min_;
+    const Vector3& boxMax = worldSpaceBox.max_;
+    const __m128 cornersX = _mm_setr_ps(boxMin.x_, boxMax.x_, boxMin.x_, boxMax.x_);
+    const __m128 cornersY = _mm_setr_ps(boxMin.y_, boxMin.y_, boxMax.y_, boxMax.y_);
+    const float* matrix = viewProj_.Data();
+    const auto transformCorners = [&](unsigned row, __m128 cornersZ)
+    {
+        const float* rowData = matrix + row * 4;
+        __m128 result = _mm_mul_ps(_mm_set1_ps(rowData[0]), cornersX);
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(rowData[1]), cornersY));
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(rowData[2]), cornersZ));
+        return _mm_add_ps(result, _mm_set1_ps(rowData[3]));
+    };
+
+    __m128 minX4, maxX4, minY4, maxY4, minZ4;
+    for (unsigned i = 0; i < 2; ++i)
+    {
+        const __m128 cornersZ = _mm_set1_ps(i == 0 ? boxMin.z_ : boxMax.z_);
+        const __m128 x = transformCorners(0, cornersZ);
+        const __m128 y = transformCorners(1, cornersZ);
+        // Apply a far clip relative bias
+        const __m128 z = _mm_sub_ps(transformCorners(2, cornersZ), _mm_set1_ps(OCCLUSION_RELATIVE_BIAS));
+        const __m128 w = transformCorners(3, cornersZ);
+
+        if (_mm_movemask_ps(_mm_cmple_ps(z, _mm_setzero_ps())))
+            return true;
+
+        const __m128 invW = _mm_div_ps(_mm_set1_ps(1.0f), w);
+        const __m128 projectedX = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(invW, x), _mm_set1_ps(scaleX_)), _mm_set1_ps(offsetX_));
+        const __m128 projectedY = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(invW, y), _mm_set1_ps(scaleY_)), _mm_set1_ps(offsetY_));
+        const __m128 projectedZ = _mm_mul_ps(_mm_mul_ps(invW, z), _mm_set1_ps(OCCLUSION_Z_SCALE));
+
+        minX4 = i == 0 ? projectedX : _mm_min_ps(minX4, projectedX);
+        maxX4 = i == 0 ? projectedX : _mm_max_ps(maxX4, projectedX);
+        minY4 = i == 0 ? projectedY : _mm_min_ps(minY4, projectedY);
+        maxY4 = i == 0 ? projectedY : _mm_max_ps(maxY4, projectedY);
+        minZ4 = i == 0 ? projectedZ : _mm_min_ps(minZ4, projectedZ);
+    }
+
+    minX = HorizontalMin(minX4);
+    maxX = HorizontalMax(maxX4);
+    minY = HorizontalMin(minY4);
+    maxY = HorizontalMax(maxY4);
+    minZ = HorizontalMin(minZ4);
+#else
     // Transform corners to projection space
     Vector4 vertices[8];
     vertices[0] = ModelTransform(viewProj_, worldSpaceBox.min_);
@@ -346,9 +549,6 @@ bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
     for (auto& vertice : vertices)
         vertice.z_ -= OCCLUSION_RELATIVE_BIAS;
 
-    // Transform to screen space. If any of the corners cross the near plane, assume visible
-    float minX, maxX, minY, maxY, minZ;
-
     if (vertices[0].z_ <= 0.0f)
         return true;
 
@@ -371,6 +571,7 @@ bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
         if (projected.y_ > maxY) maxY = projected.y_;
         if (projected.z_ < minZ) minZ = projected.z_;
     }
+#endif
 
     // Expand the bounding box 1 pixel in each direction to be conservative and correct rasterization offset
     IntRect rect((int)(minX - 1.5f), (int)(minY - 1.5f), RoundToInt(maxX), RoundToInt(maxY));
@@ -897,13 +1098,7 @@ void OcclusionBuffer::DrawTriangle2D(const Vector3* vertices, bool clockwise, un
                 int invZ = topToBottom.invZ_;
                 int* dest = row + (topToBottom.x_ >> 16u);
                 int* end = row + (topToMiddle.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
+                DrawSpan(dest, end, invZ, gradients.dInvZdXInt_);
 
                 topToBottom.x_ += topToBottom.xStep_;
                 topToBottom.invZ_ += topToBottom.invZStep_;
@@ -923,13 +1118,7 @@ void OcclusionBuffer::DrawTriangle2D(const Vector3* vertices, bool clockwise, un
                 int invZ = topToBottom.invZ_;
                 int* dest = row + (topToBottom.x_ >> 16u);
                 int* end = row + (middleToBottom.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
+                DrawSpan(dest, end, invZ, gradients.dInvZdXInt_);
 
                 topToBottom.x_ += topToBottom.xStep_;
                 topToBottom.invZ_ += topToBottom.invZStep_;
@@ -951,13 +1140,7 @@ void OcclusionBuffer::DrawTriangle2D(const Vector3* vertices, bool clockwise, un
                 int invZ = topToMiddle.invZ_;
                 int* dest = row + (topToMiddle.x_ >> 16u);
                 int* end = row + (topToBottom.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
+                DrawSpan(dest, end, invZ, gradients.dInvZdXInt_);
 
                 topToMiddle.x_ += topToMiddle.xStep_;
                 topToMiddle.invZ_ += topToMiddle.invZStep_;
@@ -977,13 +1160,7 @@ void OcclusionBuffer::DrawTriangle2D(const Vector3* vertices, bool clockwise, un
                 int invZ = middleToBottom.invZ_;
                 int* dest = row + (middleToBottom.x_ >> 16u);
                 int* end = row + (topToBottom.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
+                DrawSpan(dest, end, invZ, gradients.dInvZdXInt_);
 
                 middleToBottom.x_ += middleToBottom.xStep_;
                 middleToBottom.invZ_ += middleToBottom.invZStep_;
@@ -998,24 +1175,18 @@ void OcclusionBuffer::MergeBuffers()
 {
     URHO3D_PROFILE("MergeBuffers");
 
-    for (unsigned i = 1; i < buffers_.size(); ++i)
+    // Merge in parallel by ranges of pixels, thread buffers are merged in order within each range
+    const auto count = static_cast<unsigned>(width_ * height_);
+    ForEachParallel(GetSubsystem<WorkQueue>(), MergeBucketSize, count,
+        [this](unsigned beginIndex, unsigned endIndex)
     {
-        if (!buffers_[i].used_)
-            continue;
-
-        int* src = buffers_[i].data_;
-        int* dest = buffers_[0].data_;
-        int count = width_ * height_;
-
-        while (count--)
+        int* dest = buffers_[0].data_ + beginIndex;
+        for (unsigned i = 1; i < buffers_.size(); ++i)
         {
-            // If thread buffer's depth value is closer, overwrite the original
-            if (*src < *dest)
-                *dest = *src;
-            ++src;
-            ++dest;
+            if (buffers_[i].used_)
+                MergeDepth(dest, buffers_[i].data_ + beginIndex, endIndex - beginIndex);
         }
-    }
+    });
 }
 
 void OcclusionBuffer::ClearBuffer(unsigned threadIndex)
@@ -28,6 +28,7 @@
 #include "../Core/CoreEvents.h"
 #include "../Core/Profiler.h"
 #include "../Core/Thread.h"
+#include "../Engine/Engine.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/Octree.h"
@@ -49,6 +50,9 @@ namespace Urho3D
 
 static const float DEFAULT_OCTREE_SIZE = 1000.0f;
 static const int DEFAULT_OCTREE_LEVELS = 8;
+static const unsigned ReinsertionBucketSize = 64;
+static const float MAX_AUTO_EXPAND_SIZE = 1000000.0f;
+static const unsigned MAX_AUTO_EXPAND_LEVELS = 16;
 
 inline bool CompareRayQueryResults(const RayQueryResult& lhs, const RayQueryResult& rhs)
 {
@@ -123,34 +127,58 @@ void Octant::DeleteChild(unsigned index)
 void Octant::InsertDrawable(Drawable* drawable)
 {
     const BoundingBox& box = drawable->GetWorldBoundingBox();
+    Octant* newOctant = GetOrCreateInsertionOctant(box, drawable->IsOccludee());
 
+    Octant* oldOctant = drawable->octant_;
+    if (oldOctant != newOctant)
+    {
+        // Add first, then remove, because drawable count going to zero deletes the octree branch in question
+        newOctant->AddDrawable(drawable);
+        if (oldOctant)
+            oldOctant->RemoveDrawable(drawable, false);
+    }
+}
+
+bool Octant::IsInsertionOctant(const BoundingBox& box, bool isOccludee) const
+{
     // If root octant, insert all non-occludees here, so that octant occlusion does not hide the drawable.
     // Also if drawable is outside the root octant bounds, insert to root
-    bool insertHere;
     if (this == octree_->GetRootOctant())
-        insertHere = !drawable->IsOccludee() || cullingBox_.IsInside(box) != INSIDE || CheckDrawableFit(box);
+        return !isOccludee || cullingBox_.IsInside(box) != INSIDE || CheckDrawableFit(box);
     else
-        insertHere = CheckDrawableFit(box);
+        return CheckDrawableFit(box);
+}
 
-    if (insertHere)
+const Octant* Octant::FindInsertionOctant(const BoundingBox& box, bool isOccludee) const
+{
+    const Octant* octant = this;
+    while (!octant->IsInsertionOctant(box, isOccludee))
     {
-        Octant* oldOctant = drawable->octant_;
-        if (oldOctant != this)
-        {
-            // Add first, then remove, because drawable count going to zero deletes the octree branch in question
-            AddDrawable(drawable);
-            if (oldOctant)
-                oldOctant->RemoveDrawable(drawable, false);
-        }
+        const Octant* child = octant->children_[octant->GetChildIndex(box)];
+        if (!child)
+            break;
+        octant = child;
     }
-    else
-    {
-        Vector3 boxCenter = box.Center();
-        unsigned x = boxCenter.x_ < center_.x_ ? 0 : 1;
-        unsigned y = boxCenter.y_ < center_.y_ ? 0 : 2;
-        unsigned z = boxCenter.z_ < center_.z_ ? 0 : 4;
+    return octant;
+}
+
+Octant* Octant::GetOrCreateInsertionOctant(const BoundingBox& box, bool isOccludee)
+{
+    Octant* octant = this;
+    while (!octant->IsInsertionOctant(box, isOccludee))
+        octant = octant->GetOrCreateChild(octant->GetChildIndex(box));
+    return octant;
+}
 
-        GetOrCreateChild(x + y + z)->InsertDrawable(drawable);
+void Octant::RemoveMovedDrawables()
+{
+    const auto iter = ea::remove_if(drawables_.begin(), drawables_.end(),
+        [this](const Drawable* drawable) { return drawable->GetOctant() != this; });
+    const auto numRemoved = static_cast<unsigned>(drawables_.end() - iter);
+    if (numRemoved > 0)
+    {
+        drawables_.erase(iter, drawables_.end());
+        DecDrawableCount(numRemoved);
     }
 }
 
@@ -409,10 +437,17 @@ Octree::Octree(Context* context) :
     worldBoundingBox_(rootOctant_.GetWorldBoundingBox()),
     zones_(context)
 {
+    threadedDrawableUpdates_.Clear();
+
     // If the engine is running headless, subscribe to RenderUpdate events for manually updating the octree
     // to allow raycasts and animation update
     if (!GetSubsystem<Graphics>())
+    {
         SubscribeToEvent(E_RENDERUPDATE, URHO3D_HANDLER(Octree, HandleRenderUpdate));
+
+        auto engine = GetSubsystem<Engine>();
+        leanUpdate_ = engine && engine->IsLeanHeadless();
+    }
 }
 
 Octree::~Octree()
@@ -432,6 +467,7 @@ void Octree::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE_EX("Bounding Box Min", Vector3, worldBoundingBox_.min_, UpdateOctreeSize, defaultBoundsMin, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Bounding Box Max", Vector3, worldBoundingBox_.max_, UpdateOctreeSize, defaultBoundsMax, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Number of Levels", int, numLevels_, UpdateOctreeSize, DEFAULT_OCTREE_LEVELS, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Auto Expand", bool, autoExpand_, false, AM_DEFAULT);
 }
 
 void Octree::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
@@ -473,6 +509,7 @@ void Octree::Update(const FrameInfo& frame)
         scene->BeginThreadedUpdate();
 
         pendingNodeTransforms_.Clear();
+        threadedDrawableUpdates_.Clear();
 
         ForEachParallel(queue, drawableUpdates_, [this, &frame](unsigned, Drawable* drawable)
         {
@@ -484,14 +521,12 @@ void Octree::Update(const FrameInfo& frame)
     }
 
     // If any drawables were inserted during threaded update, update them now from the main thread
-    if (!threadedDrawableUpdates_.empty())
+    if (threadedDrawableUpdates_.Size() != 0)
     {
         URHO3D_PROFILE("UpdateDrawablesQueuedDuringUpdate");
 
-        for (auto i = threadedDrawableUpdates_.begin(); i !=
-            threadedDrawableUpdates_.end(); ++i)
+        for (Drawable* drawable : threadedDrawableUpdates_)
         {
-            Drawable* drawable = *i;
             if (drawable)
             {
                 drawable->Update(frame);
@@ -499,7 +534,7 @@ void Octree::Update(const FrameInfo& frame)
             }
         }
 
-        threadedDrawableUpdates_.clear();
+        threadedDrawableUpdates_.Clear();
     }
 
     // Commit delayed Node transforms
@@ -526,32 +561,13 @@ void Octree::Update(const FrameInfo& frame)
     if (!drawableUpdates_.empty())
     {
         URHO3D_PROFILE("ReinsertToOctree");
+        ReinsertDrawables();
 
-        for (auto i = drawableUpdates_.begin(); i != drawableUpdates_.end(); ++i)
+        // Drawables outside of octree bounds are always in the root octant
+        if (autoExpand_ && ExpandToFitDrawables())
         {
-            Drawable* drawable = *i;
-            drawable->updateQueued_ = false;
-            Octant* octant = drawable->GetOctant();
-            const BoundingBox& box = drawable->GetWorldBoundingBox();
-
-            // Skip if no octant or does not belong to this octree anymore
-            if (!octant || octant->GetOctree() != this)
-                continue;
-            // Skip if still fits the current octant
-            if (drawable->IsOccludee() && octant->GetCullingBox().IsInside(box) == INSIDE && octant->CheckDrawableFit(box))
-                continue;
-
-            rootOctant_.InsertDrawable(drawable);
-
-#ifdef _DEBUG
-            // Verify that the drawable will be culled correctly
-            octant = drawable->GetOctant();
-            if (octant != GetRootOctant() && octant->GetCullingBox().IsInside(box) != INSIDE)
-            {
-                URHO3D_LOGERROR("Drawable is not fully inside its octant's culling bounds: drawable box " + box.ToString() +
-                         " octant box " + octant->GetCullingBox().ToString());
-            }
-#endif
+            for (Drawable* drawable : drawables_)
+                rootOctant_.InsertDrawable(drawable);
         }
     }
 
@@ -561,7 +577,7 @@ void Octree::Update(const FrameInfo& frame)
     // TODO: Refactor it, maybe split Octree?
     zones_.Commit();
 
-    if (scene)
+    if (scene && !leanUpdate_)
     {
         if (auto reflectionProbeManager = scene->GetComponent<ReflectionProbeManager>())
             reflectionProbeManager->Update();
@@ -731,14 +747,113 @@ Zone* Octree::GetBackgroundZone() const
     return zones_.GetBackgroundZone();
 }
 
+void Octree::ReinsertDrawables()
+{
+    // Find new octants in worker threads. Tree is not modified at this point.
+    const unsigned numUpdates = drawableUpdates_.size();
+    reinsertionOctants_.resize(numUpdates);
+    ForEachParallel(GetSubsystem<WorkQueue>(), ReinsertionBucketSize, numUpdates,
+        [this](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            Drawable* drawable = drawableUpdates_[i];
+            drawable->updateQueued_ = false;
+            ++drawable->updateRevision_;
+            reinsertionOctants_[i] = nullptr;
+
+            // Skip if no octant or does not belong to this octree anymore
+            const Octant* octant = drawable->GetOctant();
+            if (!octant || octant->GetOctree() != this)
+                continue;
+
+            // Skip if still fits the current octant
+            const BoundingBox& box = drawable->GetWorldBoundingBox();
+            const bool isOccludee = drawable->IsOccludee();
+            if (isOccludee && octant->GetCullingBox().IsInside(box) == INSIDE && octant->CheckDrawableFit(box))
+                continue;
+
+            reinsertionOctants_[i] = rootOctant_.FindInsertionOctant(box, isOccludee);
+        }
+    });
+
+    // Move drawables in the original order so the content of octants is deterministic.
+    // Drawables are added to new octants first, because removal may delete empty branches.
+    reinsertionSourceOctants_.clear();
+    for (unsigned i = 0; i < numUpdates; ++i)
+    {
+        if (!reinsertionOctants_[i])
+            continue;
+
+        // Octant may be missing some children, they are created here
+        Drawable* drawable = drawableUpdates_[i];
+        const BoundingBox& box = drawable->GetWorldBoundingBox();
+        auto existingOctant = const_cast<Octant*>(reinsertionOctants_[i]);
+        Octant* newOctant = existingOctant->GetOrCreateInsertionOctant(box, drawable->IsOccludee());
+        Octant* oldOctant = drawable->GetOctant();
+        if (newOctant == oldOctant)
+            continue;
+
+        newOctant->AddDrawable(drawable);
+        reinsertionSourceOctants_.push_back(oldOctant);
+
+#ifdef _DEBUG
+        // Verify that the drawable will be culled correctly
+        if (newOctant != GetRootOctant() && newOctant->GetCullingBox().IsInside(box) != INSIDE)
+        {
+            URHO3D_LOGERROR("Drawable is not fully inside its octant's culling bounds: drawable box " + box.ToString() +
+                     " octant box " + newOctant->GetCullingBox().ToString());
+        }
+#endif
+    }
+
+    // Remove moved drawables from old octants, once per octant
+    ea::sort(reinsertionSourceOctants_.begin(), reinsertionSourceOctants_.end());
+    reinsertionSourceOctants_.erase(
+        ea::unique(reinsertionSourceOctants_.begin(), reinsertionSourceOctants_.end()), reinsertionSourceOctants_.end());
+    for (Octant* octant : reinsertionSourceOctants_)
+        octant->RemoveMovedDrawables();
+}
+
+bool Octree::ExpandToFitDrawables()
+{
+    const BoundingBox& rootBox = rootOctant_.GetWorldBoundingBox();
+    BoundingBox requiredBox = rootBox;
+    for (Drawable* drawable : rootOctant_.GetDrawables())
+    {
+        // Ignore drawables that are practically infinite, like directional lights
+        const BoundingBox& box = drawable->GetWorldBoundingBox();
+        if (box.Defined() && box.Size().Length() < MAX_AUTO_EXPAND_SIZE)
+            requiredBox.Merge(box);
+    }
+
+    if (requiredBox == rootBox)
+        return false;
+
+    // Double the size around the same center so the smallest octants don't change
+    const Vector3 center = rootBox.Center();
+    Vector3 halfSize = VectorMax(rootBox.HalfSize(), Vector3::ONE);
+    unsigned numLevels = numLevels_;
+    BoundingBox newBox{center - halfSize, center + halfSize};
+    while (newBox.IsInside(requiredBox) != INSIDE && halfSize.Length() < MAX_AUTO_EXPAND_SIZE)
+    {
+        halfSize *= 2.0f;
+        numLevels = Min(numLevels + 1, Max(numLevels_, MAX_AUTO_EXPAND_LEVELS));
+        newBox = BoundingBox{center - halfSize, center + halfSize};
+    }
+
+    if (newBox == rootBox)
+        return false;
+
+    SetSize(newBox, numLevels);
+    return true;
+}
+
 void Octree::QueueUpdate(Drawable* drawable)
 {
     Scene* scene = GetScene();
     if (scene && scene->IsThreadedUpdate())
-    {
-        MutexLock lock(octreeMutex_);
-        threadedDrawableUpdates_.push_back(drawable);
-    }
+        threadedDrawableUpdates_.Insert(drawable);
     else
         drawableUpdates_.push_back(drawable);
 
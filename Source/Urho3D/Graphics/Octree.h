@@ -23,7 +23,6 @@
 #pragma once
 
 #include "../Container/MultiVector.h"
-#include "../Core/Mutex.h"
 #include "../Core/WorkQueue.h"
 #include "../Graphics/Drawable.h"
 #include "../Graphics/OctreeQuery.h"
@@ -56,6 +55,13 @@ public:
     void InsertDrawable(Drawable* drawable);
     /// Check if a drawable object fits.
     bool CheckDrawableFit(const BoundingBox& box) const;
+    /// Return existing octant where the drawable should be inserted. Thread-safe.
+    /// If the proper octant doesn't exist yet, return its deepest existing ancestor.
+    const Octant* FindInsertionOctant(const BoundingBox& box, bool isOccludee) const;
+    /// Return octant where the drawable should be inserted, create child octants if needed.
+    Octant* GetOrCreateInsertionOctant(const BoundingBox& box, bool isOccludee);
+    /// Remove drawables that were moved to another octant. Should be called after AddDrawable for other octant.
+    void RemoveMovedDrawables();
 
     /// Add a drawable object to this octant.
     void AddDrawable(Drawable* drawable)
@@ -97,6 +103,9 @@ public:
     /// Return number of drawables.
     unsigned GetNumDrawables() const { return numDrawables_; }
 
+    /// Return drawables in this octant, not including child octants.
+    const ea::vector<Drawable*>& GetDrawables() const { return drawables_; }
+
     /// Return true if there are no drawable objects in this octant and child octants.
     bool IsEmpty() { return numDrawables_ == 0; }
 
@@ -127,12 +136,24 @@ protected:
             parent_->IncDrawableCount();
     }
 
+    /// Return whether the drawable should be inserted into this octant.
+    bool IsInsertionOctant(const BoundingBox& box, bool isOccludee) const;
+    /// Return index of child octant for the drawable.
+    unsigned GetChildIndex(const BoundingBox& box) const
+    {
+        const Vector3 boxCenter = box.Center();
+        const unsigned x = boxCenter.x_ < center_.x_ ? 0 : 1;
+        const unsigned y = boxCenter.y_ < center_.y_ ? 0 : 2;
+        const unsigned z = boxCenter.z_ < center_.z_ ? 0 : 4;
+        return x + y + z;
+    }
+
     /// Decrease drawable object count recursively and remove octant if it becomes empty.
-    void DecDrawableCount()
+    void DecDrawableCount(unsigned count = 1)
     {
         Octant* parent = parent_;
 
-        --numDrawables_;
+        numDrawables_ -= count;
         if (!numDrawables_)
         {
             if (parent)
@@ -140,7 +161,7 @@ protected:
         }
 
         if (parent)
-            parent->DecDrawableCount();
+            parent->DecDrawableCount(count);
     }
 
     /// World bounding box.
@@ -229,6 +250,14 @@ public:
 
     /// Set size and maximum subdivision levels. If octree is not empty, drawable objects will be temporarily moved to the root.
     void SetSize(const BoundingBox& box, unsigned numLevels);
+    /// Set whether to expand the octree automatically when drawables are outside of its bounds.
+    /// Octree is expanded by doubling its size and adding subdivision levels, so the smallest octants keep their size.
+    /// @property
+    void SetAutoExpand(bool enable) { autoExpand_ = enable; }
+    /// Set whether drawables should skip the work that is only needed for rendering,
+    /// e.g. animation of models without bone attachments and particle simulation.
+    /// Enabled automatically in lean headless mode. Not serialized.
+    void SetLeanUpdate(bool enable) { leanUpdate_ = enable; }
     /// Update and reinsert drawable objects.
     void Update(const FrameInfo& frame);
     /// Add a drawable manually.
@@ -266,6 +295,11 @@ public:
     /// Return subdivision levels.
     /// @property
     unsigned GetNumLevels() const { return numLevels_; }
+    /// Return whether to expand the octree automatically when drawables are outside of its bounds.
+    /// @property
+    bool GetAutoExpand() const { return autoExpand_; }
+    /// Return whether drawables should skip the work that is only needed for rendering.
+    bool IsLeanUpdate() const { return leanUpdate_; }
 
     /// Return all drawables in all octants.
     const ea::vector<Drawable*>& GetAllDrawables() const { return drawables_; }
@@ -285,25 +319,35 @@ private:
     void HandleRenderUpdate(StringHash eventType, VariantMap& eventData);
     /// Update octree size.
     void UpdateOctreeSize() { SetSize(worldBoundingBox_, numLevels_); }
+    /// Reinsert updated drawables into proper octants.
+    void ReinsertDrawables();
+    /// Expand octree if drawables are outside of its bounds. Return whether the octree was expanded.
+    bool ExpandToFitDrawables();
 
     /// Root octant.
     Octant rootOctant_;
     /// Drawable objects that require update.
     ea::vector<Drawable*> drawableUpdates_;
-    /// Drawable objects that were inserted during threaded update phase.
-    ea::vector<Drawable*> threadedDrawableUpdates_;
+    /// Drawable objects that were inserted during threaded update phase. Each thread has its own queue.
+    WorkQueueVector<Drawable*> threadedDrawableUpdates_;
+    /// Octants found for updated drawables, null if drawable doesn't need reinsertion.
+    ea::vector<const Octant*> reinsertionOctants_;
+    /// Octants that drawables are moved from.
+    ea::vector<Octant*> reinsertionSourceOctants_;
     /// Node transforms to be applied before reinsertion.
     WorkQueueVector<ea::pair<Node*, Transform>> pendingNodeTransforms_;
     /// All Drawable objects.
     ea::vector<Drawable*> drawables_;
-    /// Mutex for octree reinsertions.
-    Mutex octreeMutex_;
     /// Ray query temporary list of drawables.
     mutable ea::vector<Drawable*> rayQueryDrawables_;
     /// Subdivision level.
     unsigned numLevels_;
     /// World bounding box.
     BoundingBox worldBoundingBox_;
+    /// Whether to expand the octree automatically.
+    bool autoExpand_{};
+    /// Whether to skip render-only updates.
+    bool leanUpdate_{};
     /// Zones.
     ZoneLookupIndex zones_;
 };
@@ -105,16 +105,9 @@ Intersection FrustumOctreeQuery::TestOctant(const BoundingBox& box, bool inside)
 
 void FrustumOctreeQuery::TestDrawables(Drawable** start, Drawable** end, bool inside)
 {
-    while (start != end)
-    {
-        Drawable* drawable = *start++;
-
-        if ((drawable->GetDrawableFlags() & drawableFlags_) && (drawable->GetViewMask() & viewMask_))
-        {
-            if (inside || frustum_.IsInsideFast(drawable->GetWorldBoundingBox()))
-                result_.push_back(drawable);
-        }
-    }
+    const auto filter = [this](Drawable* drawable)
+    { return (drawable->GetDrawableFlags() & drawableFlags_) && (drawable->GetViewMask() & viewMask_); };
+    TestDrawablesInFrustum(start, end, inside, filter, [this](Drawable* drawable) { result_.push_back(drawable); });
 }
 
 
@@ -149,6 +149,49 @@ public:
     /// Intersection test for drawables.
     void TestDrawables(Drawable** start, Drawable** end, bool inside) override;
 
+    /// Test bounding boxes of drawables accepted by the filter against the frustum, four at a time.
+    /// Callback is invoked for visible drawables in the original order.
+    template <class Filter, class Callback>
+    void TestDrawablesInFrustum(Drawable** start, Drawable** end, bool inside,
+        const Filter& filter, const Callback& callback) const
+    {
+        Drawable* candidates[4];
+        const BoundingBox* boxes[4];
+        unsigned numCandidates = 0;
+
+        const auto flushCandidates = [&]()
+        {
+            const unsigned mask = frustum_.IsInsideFastMask(boxes, numCandidates);
+            for (unsigned i = 0; i < numCandidates; ++i)
+            {
+                if (mask & (1u << i))
+                    callback(candidates[i]);
+            }
+            numCandidates = 0;
+        };
+
+        for (Drawable** iter = start; iter != end; ++iter)
+        {
+            Drawable* drawable = *iter;
+            if (!filter(drawable))
+                continue;
+
+            if (inside)
+            {
+                callback(drawable);
+                continue;
+            }
+
+            candidates[numCandidates] = drawable;
+            boxes[numCandidates] = &drawable->GetWorldBoundingBox();
+            if (++numCandidates == 4)
+                flushCandidates();
+        }
+
+        if (numCandidates > 0)
+            flushCandidates();
+    }
+
     /// Frustum.
     Frustum frustum_;
 };
@@ -0,0 +1,345 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Graphics/PipelineStateManifest.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../Graphics/Shader.h"
+#include "../Graphics/ShaderVariation.h"
+#include "../IO/ArchiveSerialization.h"
+#include "../IO/Log.h"
+#include "../Resource/ResourceCache.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+void SerializeValue(Archive& archive, const char* name, SamplerStateDesc& value)
+{
+    auto block = archive.OpenUnorderedBlock(name);
+    SerializeValue(archive, "filter", value.filterMode_);
+    SerializeValue(archive, "anisotropy", value.anisotropy_);
+    SerializeValue(archive, "shadowCompare", value.shadowCompare_);
+    SerializeValue(archive, "addressU", value.addressMode_[TextureCoordinate::U]);
+    SerializeValue(archive, "addressV", value.addressMode_[TextureCoordinate::V]);
+    SerializeValue(archive, "addressW", value.addressMode_[TextureCoordinate::W]);
+}
+
+void SerializeValue(Archive& archive, const char* name, InputLayoutElementDesc& value)
+{
+    auto block = archive.OpenUnorderedBlock(name);
+    SerializeValue(archive, "bufferIndex", value.bufferIndex_);
+    SerializeValue(archive, "bufferStride", value.bufferStride_);
+    SerializeValue(archive, "elementOffset", value.elementOffset_);
+    SerializeValue(archive, "instanceStepRate", value.instanceStepRate_);
+    SerializeValue(archive, "type", value.elementType_);
+    SerializeValue(archive, "semantic", value.elementSemantic_);
+    SerializeValue(archive, "semanticIndex", value.elementSemanticIndex_);
+}
+
+/// Serialize first elements of fixed-capacity array, size is stored separately.
+template <class T, size_t N>
+void SerializeFixedArray(Archive& archive, const char* name, unsigned& size, ea::array<T, N>& array)
+{
+    auto block = archive.OpenArrayBlock(name, size);
+    if (archive.IsInput())
+    {
+        if (block.GetSizeHint() > N)
+            throw ArchiveException("'{}/{}' has too many elements", archive.GetCurrentBlockPath(), name);
+        size = block.GetSizeHint();
+    }
+
+    for (unsigned i = 0; i < size; ++i)
+        SerializeValue(archive, "element", array[i]);
+}
+
+void SerializeValue(Archive& archive, const char* name, ImmutableSamplersDesc& value)
+{
+    auto block = archive.OpenUnorderedBlock(name);
+    unsigned numNames = value.size_;
+    SerializeFixedArray(archive, "names", numNames, value.names_);
+    SerializeFixedArray(archive, "samplers", value.size_, value.desc_);
+    if (numNames != value.size_)
+        throw ArchiveException("'{}/{}' has inconsistent number of samplers", archive.GetCurrentBlockPath(), name);
+}
+
+void SerializeValue(Archive& archive, const char* name, GraphicsPipelineStateDesc& value)
+{
+    auto block = archive.OpenUnorderedBlock(name);
+
+    SerializeValue(archive, "colorWrite", value.colorWriteEnabled_);
+    SerializeValue(archive, "blendMode", value.blendMode_);
+    SerializeValue(archive, "alphaToCoverage", value.alphaToCoverageEnabled_);
+
+    SerializeValue(archive, "fillMode", value.fillMode_);
+    SerializeValue(archive, "cullMode", value.cullMode_);
+    SerializeValue(archive, "constantDepthBias", value.constantDepthBias_);
+    SerializeValue(archive, "slopeScaledDepthBias", value.slopeScaledDepthBias_);
+    SerializeValue(archive, "scissorTest", value.scissorTestEnabled_);
+    SerializeValue(archive, "lineAntiAlias", value.lineAntiAlias_);
+
+    SerializeValue(archive, "depthWrite", value.depthWriteEnabled_);
+    SerializeValue(archive, "stencilTest", value.stencilTestEnabled_);
+    SerializeValue(archive, "depthCompare", value.depthCompareFunction_);
+    SerializeValue(archive, "stencilCompare", value.stencilCompareFunction_);
+    SerializeValue(archive, "stencilPassed", value.stencilOperationOnPassed_);
+    SerializeValue(archive, "stencilFailed", value.stencilOperationOnStencilFailed_);
+    SerializeValue(archive, "stencilDepthFailed", value.stencilOperationOnDepthFailed_);
+    SerializeValue(archive, "stencilCompareMask", value.stencilCompareMask_);
+    SerializeValue(archive, "stencilWriteMask", value.stencilWriteMask_);
+
+    SerializeFixedArray(archive, "inputLayout", value.inputLayout_.size_, value.inputLayout_.elements_);
+    SerializeValue(archive, "primitiveType", value.primitiveType_);
+
+    SerializeValue(archive, "depthStencilFormat", value.output_.depthStencilFormat_);
+    SerializeFixedArray(archive, "renderTargetFormats", value.output_.numRenderTargets_, value.output_.renderTargetFormats_);
+    SerializeValue(archive, "multiSample", value.output_.multiSample_);
+
+    SerializeValue(archive, "samplers", value.samplers_);
+    SerializeValue(archive, "readOnlyDepth", value.readOnlyDepth_);
+}
+
+const RawShader* GetShader(const PipelineStateDesc& desc, ShaderType type)
+{
+    if (const GraphicsPipelineStateDesc* graphicsDesc = desc.AsGraphics())
+    {
+        switch (type)
+        {
+        case VS: return graphicsDesc->vertexShader_;
+        case PS: return graphicsDesc->pixelShader_;
+        case GS: return graphicsDesc->geometryShader_;
+        case HS: return graphicsDesc->hullShader_;
+        case DS: return graphicsDesc->domainShader_;
+        default: return nullptr;
+        }
+    }
+    else if (const ComputePipelineStateDesc* computeDesc = desc.AsCompute())
+        return type == CS ? computeDesc->computeShader_.Get() : nullptr;
+    return nullptr;
+}
+
+}
+
+ea::optional<PipelineStateManifestEntry> PipelineStateManifestEntry::FromDesc(const PipelineStateDesc& desc)
+{
+    PipelineStateManifestEntry entry;
+    entry.type_ = desc.GetType();
+    if (const GraphicsPipelineStateDesc* graphicsDesc = desc.AsGraphics())
+    {
+        entry.graphics_ = *graphicsDesc;
+        entry.graphics_.vertexShader_ = nullptr;
+        entry.graphics_.pixelShader_ = nullptr;
+        entry.graphics_.geometryShader_ = nullptr;
+        entry.graphics_.hullShader_ = nullptr;
+        entry.graphics_.domainShader_ = nullptr;
+    }
+    else if (const ComputePipelineStateDesc* computeDesc = desc.AsCompute())
+    {
+        entry.compute_ = *computeDesc;
+        entry.compute_.computeShader_ = nullptr;
+    }
+
+    for (unsigned i = 0; i < MAX_SHADER_TYPES; ++i)
+    {
+        const RawShader* rawShader = GetShader(desc, static_cast<ShaderType>(i));
+        if (!rawShader)
+            continue;
+
+        // Shaders created from bytecode directly cannot be restored
+        const auto shaderVariation = dynamic_cast<const ShaderVariation*>(rawShader);
+        const Shader* shader = shaderVariation ? shaderVariation->GetOwner() : nullptr;
+        if (!shader || shader->GetName().empty())
+            return ea::nullopt;
+
+        entry.shaderNames_[i] = shader->GetName();
+        entry.shaderDefines_[i] = shaderVariation->GetDefines();
+    }
+
+    return entry;
+}
+
+ea::optional<PipelineStateDesc> PipelineStateManifestEntry::ToDesc(Context* context) const
+{
+    auto cache = context->GetSubsystem<ResourceCache>();
+
+    ea::array<SharedPtr<RawShader>, MAX_SHADER_TYPES> shaders;
+    for (unsigned i = 0; i < MAX_SHADER_TYPES; ++i)
+    {
+        if (shaderNames_[i].empty())
+            continue;
+
+        auto shader = cache->GetResource<Shader>(shaderNames_[i]);
+        if (!shader)
+            return ea::nullopt;
+
+        shaders[i] = shader->GetVariation(static_cast<ShaderType>(i), shaderDefines_[i]);
+        if (!shaders[i])
+            return ea::nullopt;
+    }
+
+    if (type_ == PipelineStateType::Graphics)
+    {
+        GraphicsPipelineStateDesc desc = graphics_;
+        desc.vertexShader_ = shaders[VS];
+        desc.pixelShader_ = shaders[PS];
+        desc.geometryShader_ = shaders[GS];
+        desc.hullShader_ = shaders[HS];
+        desc.domainShader_ = shaders[DS];
+        if (!desc.IsInitialized())
+            return ea::nullopt;
+        return PipelineStateDesc{desc};
+    }
+    else
+    {
+        ComputePipelineStateDesc desc = compute_;
+        desc.computeShader_ = shaders[CS];
+        if (!desc.IsInitialized())
+            return ea::nullopt;
+        return PipelineStateDesc{desc};
+    }
+}
+
+void PipelineStateManifestEntry::SerializeInBlock(Archive& archive)
+{
+    SerializeValue(archive, "type", type_);
+    if (type_ == PipelineStateType::Graphics)
+    {
+        SerializeValue(archive, "name", graphics_.debugName_);
+        SerializeValue(archive, "graphics", graphics_);
+    }
+    else
+    {
+        SerializeValue(archive, "name", compute_.debugName_);
+        SerializeValue(archive, "samplers", compute_.samplers_);
+    }
+    SerializeArrayAsObjects(archive, "shaders", shaderNames_, "shader");
+    SerializeArrayAsObjects(archive, "defines", shaderDefines_, "defines");
+}
+
+PipelineStateManifest::PipelineStateManifest(Context* context)
+    : SimpleResource(context)
+{
+}
+
+PipelineStateManifest::~PipelineStateManifest() = default;
+
+void PipelineStateManifest::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<PipelineStateManifest>();
+}
+
+void PipelineStateManifest::SerializeInBlock(Archive& archive)
+{
+    if (archive.IsInput())
+        Clear();
+
+    SerializeVectorAsObjects(archive, "pipelineStates", entries_, "pipelineState");
+
+    if (archive.IsInput())
+    {
+        for (const PipelineStateManifestEntry& entry : entries_)
+            uniqueEntries_.insert(entry);
+    }
+}
+
+void PipelineStateManifest::StartRecording()
+{
+    auto psoCache = GetSubsystem<PipelineStateCache>();
+    if (isRecording_ || !psoCache)
+        return;
+
+    isRecording_ = true;
+    psoCache->OnPipelineStateCreated.Subscribe(this,
+        [](PipelineStateManifest* self, const PipelineStateDesc& desc) { self->AddPipelineState(desc); });
+}
+
+void PipelineStateManifest::StopRecording()
+{
+    if (!isRecording_)
+        return;
+
+    isRecording_ = false;
+    if (auto psoCache = GetSubsystem<PipelineStateCache>())
+        psoCache->OnPipelineStateCreated.Unsubscribe(this);
+}
+
+bool PipelineStateManifest::AddPipelineState(const PipelineStateDesc& desc)
+{
+    const auto entry = PipelineStateManifestEntry::FromDesc(desc);
+    if (!entry)
+        return false;
+
+    if (uniqueEntries_.insert(*entry).second)
+        entries_.push_back(*entry);
+    return true;
+}
+
+void PipelineStateManifest::Clear()
+{
+    entries_.clear();
+    uniqueEntries_.clear();
+    ReleasePipelineStates();
+}
+
+bool PipelineStateManifest::CreatePipelineStates(unsigned maxStates)
+{
+    auto psoCache = GetSubsystem<PipelineStateCache>();
+    if (!psoCache)
+        return true;
+
+    URHO3D_PROFILE("CreatePipelineStates");
+
+    const unsigned endIndex = ea::min(entries_.size(), numProcessedEntries_ + ea::min(maxStates, entries_.size()));
+    for (; numProcessedEntries_ < endIndex; ++numProcessedEntries_)
+    {
+        const PipelineStateManifestEntry& entry = entries_[numProcessedEntries_];
+        const auto desc = entry.ToDesc(context_);
+        if (!desc)
+        {
+            URHO3D_LOGWARNING("Cannot restore pipeline state '{}' from manifest '{}'",
+                entry.type_ == PipelineStateType::Graphics ? entry.graphics_.debugName_ : entry.compute_.debugName_,
+                GetName());
+            continue;
+        }
+
+        if (SharedPtr<PipelineState> pipelineState = psoCache->GetPipelineState(*desc))
+            pipelineStates_.push_back(pipelineState);
+    }
+
+    return numProcessedEntries_ == entries_.size();
+}
+
+void PipelineStateManifest::ReleasePipelineStates()
+{
+    pipelineStates_.clear();
+    numProcessedEntries_ = 0;
+}
+
+}
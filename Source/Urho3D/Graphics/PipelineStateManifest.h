@@ -0,0 +1,145 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../RenderAPI/PipelineState.h"
+#include "../Resource/Resource.h"
+
+#include <EASTL/array.h>
+#include <EASTL/optional.h>
+#include <EASTL/unordered_set.h>
+
+namespace Urho3D
+{
+
+class PipelineStateCache;
+
+/// Description of pipeline state with shaders referenced by resource name and defines, so it can be stored in file.
+struct URHO3D_API PipelineStateManifestEntry
+{
+    /// Type of pipeline state.
+    PipelineStateType type_{};
+    /// Graphics pipeline state description without shaders.
+    GraphicsPipelineStateDesc graphics_;
+    /// Compute pipeline state description without shaders.
+    ComputePipelineStateDesc compute_;
+    /// Shader resource names per shader type.
+    ea::array<ea::string, MAX_SHADER_TYPES> shaderNames_;
+    /// Shader defines per shader type.
+    ea::array<ea::string, MAX_SHADER_TYPES> shaderDefines_;
+
+    /// Create entry from pipeline state description. Return null if shaders are not loaded from resources.
+    static ea::optional<PipelineStateManifestEntry> FromDesc(const PipelineStateDesc& desc);
+    /// Create pipeline state description. Shaders are loaded if needed. Return null if shaders are missing.
+    ea::optional<PipelineStateDesc> ToDesc(Context* context) const;
+
+    /// Serialize content from/to archive. May throw ArchiveException.
+    void SerializeInBlock(Archive& archive);
+
+    /// Operators.
+    /// @{
+    auto Tie() const
+    {
+        return ea::make_tuple(type_, graphics_.Tie(), compute_.Tie(), //
+            ea::span<const ea::string>(shaderNames_), ea::span<const ea::string>(shaderDefines_));
+    }
+
+    bool operator==(const PipelineStateManifestEntry& rhs) const { return Tie() == rhs.Tie(); }
+    bool operator!=(const PipelineStateManifestEntry& rhs) const { return Tie() != rhs.Tie(); }
+    unsigned ToHash() const
+    {
+        unsigned result = MakeHash(type_);
+        CombineHash(result, graphics_.ToHash());
+        CombineHash(result, compute_.ToHash());
+        for (unsigned i = 0; i < MAX_SHADER_TYPES; ++i)
+        {
+            CombineHash(result, MakeHash(shaderNames_[i]));
+            CombineHash(result, MakeHash(shaderDefines_[i]));
+        }
+        return result;
+    }
+    /// @}
+};
+
+/// List of pipeline states used by some content, e.g. by a scene.
+/// Manifest may be recorded while the content is played and shipped alongside it.
+/// On load, all pipeline states from the manifest are created before the content is shown,
+/// so first appearance of a material doesn't cause a hitch.
+class URHO3D_API PipelineStateManifest : public SimpleResource
+{
+    URHO3D_OBJECT(PipelineStateManifest, SimpleResource);
+
+public:
+    explicit PipelineStateManifest(Context* context);
+    ~PipelineStateManifest() override;
+    /// Register object factory.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Implement SimpleResource.
+    void SerializeInBlock(Archive& archive) override;
+
+    /// Start adding all newly created pipeline states to the manifest.
+    void StartRecording();
+    /// Stop adding newly created pipeline states to the manifest.
+    void StopRecording();
+    /// Add pipeline state to the manifest. Return false if pipeline state cannot be stored.
+    bool AddPipelineState(const PipelineStateDesc& desc);
+    /// Remove all pipeline states from the manifest.
+    void Clear();
+
+    /// Create up to given number of pipeline states that are not created yet. Return whether all states are created.
+    /// May be called every frame during loading screen with small limit to avoid freezing.
+    /// Created pipeline states are kept alive while the manifest exists or until ReleasePipelineStates is called.
+    bool CreatePipelineStates(unsigned maxStates = M_MAX_UNSIGNED);
+    /// Release created pipeline states.
+    void ReleasePipelineStates();
+
+    /// Return whether the manifest is recording.
+    bool IsRecording() const { return isRecording_; }
+    /// Return number of pipeline states in the manifest.
+    unsigned GetNumPipelineStates() const { return entries_.size(); }
+    /// Return number of pipeline states processed by CreatePipelineStates, including ones that failed to be created.
+    unsigned GetNumProcessedPipelineStates() const { return numProcessedEntries_; }
+
+protected:
+    /// Implement SimpleResource.
+    /// @{
+    BinaryMagic GetBinaryMagic() const override { return {{'P', 'S', 'O', 'M'}}; }
+    const char* GetRootBlockName() const override { return "pipelineStates"; }
+    InternalResourceFormat GetDefaultInternalFormat() const override { return InternalResourceFormat::Binary; }
+    /// @}
+
+private:
+    ea::vector<PipelineStateManifestEntry> entries_;
+    ea::unordered_set<PipelineStateManifestEntry> uniqueEntries_;
+    bool isRecording_{};
+
+    /// Number of entries processed by CreatePipelineStates.
+    unsigned numProcessedEntries_{};
+    /// Pipeline states kept alive.
+    ea::vector<SharedPtr<PipelineState>> pipelineStates_;
+};
+
+}
@@ -0,0 +1,327 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Graphics/PrecomputedVisibility.h"
+
+#include "../Core/Context.h"
+#include "../Core/Timer.h"
+#include "../Graphics/Drawable.h"
+#include "../Graphics/StaticModel.h"
+#include "../IO/Log.h"
+#include "../Scene/Node.h"
+#include "../Scene/Scene.h"
+
+#if URHO3D_GLOW
+#include "../Glow/BakedSceneBackground.h"
+#include "../Glow/RaytracerScene.h"
+#include "../Glow/VisibilityBaker.h"
+#endif
+
+#include <EASTL/unordered_map.h>
+
+#include <thread>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Return whether StaticModel is considered static and can be baked.
+bool IsBakeableStaticModel(StaticModel* staticModel)
+{
+    return staticModel->GetType() == StaticModel::GetTypeStatic() && staticModel->GetModel()
+        && staticModel->IsEnabledEffective();
+}
+
+}
+
+PrecomputedVisibility::PrecomputedVisibility(Context* context)
+    : Component(context)
+{
+}
+
+PrecomputedVisibility::~PrecomputedVisibility() = default;
+
+void PrecomputedVisibility::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<PrecomputedVisibility>(Category_Geometry);
+
+    URHO3D_ACTION_STATIC_LABEL("Bake", Bake, "Bake visibility of StaticModels in the volume");
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, bool, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Volume Min", GetVolumeMin, SetVolumeMin, Vector3, Vector3::ZERO, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Volume Max", GetVolumeMax, SetVolumeMax, Vector3, Vector3::ZERO, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Cell Size", GetCellSize, SetCellSize, float, DefaultCellSize, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Samples Per Cell", GetNumSamplesPerCell, SetNumSamplesPerCell, unsigned,
+        DefaultNumSamplesPerCell, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Rays Per Object", GetNumRaysPerObject, SetNumRaysPerObject, unsigned,
+        DefaultNumRaysPerObject, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Random Rays", GetNumRandomRays, SetNumRandomRays, unsigned,
+        DefaultNumRandomRays, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Baked Cells", IntVector3, numCells_, IntVector3::ZERO, AM_DEFAULT | AM_NOEDIT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Baked Nodes", GetNodeIDsAttr, SetNodeIDsAttr,
+        VariantVector, Variant::emptyVariantVector, AM_DEFAULT | AM_NODEIDVECTOR | AM_NOEDIT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Visibility Data", GetVisibilityDataAttr, SetVisibilityDataAttr,
+        ea::vector<unsigned char>, Variant::emptyBuffer, AM_DEFAULT | AM_NOEDIT);
+}
+
+void PrecomputedVisibility::ApplyAttributes()
+{
+    if (!nodesDirty_)
+        return;
+
+    nodes_.clear();
+    if (Scene* scene = GetScene())
+    {
+        // The first index stores the number of IDs redundantly. Missing nodes are kept as null to preserve indices
+        for (unsigned i = 1; i < nodeIDsAttr_.size(); ++i)
+            nodes_.emplace_back(scene->GetNode(nodeIDsAttr_[i].GetUInt()));
+    }
+
+    ResetCulling();
+    nodesDirty_ = false;
+}
+
+void PrecomputedVisibility::Bake()
+{
+#if URHO3D_GLOW
+    Scene* scene = GetScene();
+    if (!scene)
+    {
+        URHO3D_LOGERROR("Cannot bake visibility outside of the scene");
+        return;
+    }
+
+    Timer timer;
+
+    ea::vector<StaticModel*> staticModels;
+    scene->GetComponents<StaticModel>(staticModels, true);
+    ea::erase_if(staticModels, [](StaticModel* staticModel) { return !IsBakeableStaticModel(staticModel); });
+
+    // Objects are nodes, all StaticModels of the node are culled together
+    ea::vector<WeakPtr<Node>> nodes;
+    ea::vector<BoundingBox> nodeBoxes;
+    ea::vector<unsigned> modelToNode;
+    ea::unordered_map<Node*, unsigned> nodeIndices;
+    BoundingBox modelsBox;
+    for (StaticModel* staticModel : staticModels)
+    {
+        Node* node = staticModel->GetNode();
+        const auto [iter, isNew] = nodeIndices.emplace(node, nodes.size());
+        if (isNew)
+        {
+            nodes.emplace_back(node);
+            nodeBoxes.emplace_back();
+        }
+
+        const BoundingBox& worldBoundingBox = staticModel->GetWorldBoundingBox();
+        nodeBoxes[iter->second].Merge(worldBoundingBox);
+        modelsBox.Merge(worldBoundingBox);
+        modelToNode.push_back(iter->second);
+    }
+
+    if (nodes.empty())
+    {
+        URHO3D_LOGWARNING("Cannot bake visibility, there are no StaticModels in the scene");
+        return;
+    }
+
+    const BoundingBox volume = volume_.Size().Length() > M_EPSILON ? volume_ : modelsBox;
+    const IntVector3 numCells = VectorMax(IntVector3::ONE,
+        VectorMin(VectorCeilToInt(volume.Size() / cellSize_), IntVector3::ONE * MaxCellsPerAxis));
+
+    const ea::vector<Component*> geometries(staticModels.begin(), staticModels.end());
+    const auto backgrounds = ea::make_shared<ea::vector<BakedSceneBackground>>(1);
+    const SharedPtr<RaytracerScene> raytracerScene = CreateRaytracingScene(context_, geometries, 1, backgrounds);
+
+    VisibilityBakingSettings settings;
+    settings.numSamplesPerCell_ = numSamplesPerCell_;
+    settings.numRaysPerObject_ = numRaysPerObject_;
+    settings.numRandomRays_ = numRandomRays_;
+    settings.numTasks_ = ea::max(1u, std::thread::hardware_concurrency()) * 4;
+
+    visibility_ = BakeVisibility(*raytracerScene, modelToNode, nodeBoxes, volume, numCells, settings);
+    volume_ = volume;
+    numCells_ = numCells;
+    nodes_ = ea::move(nodes);
+    nodeIDsDirty_ = true;
+    nodesDirty_ = false;
+    ResetCulling();
+
+    URHO3D_LOGINFO("Visibility of {} nodes is baked for {}x{}x{} cells in {} seconds", nodes_.size(), numCells.x_,
+        numCells.y_, numCells.z_, timer.GetMSec(false) / 1000.0f);
+#else
+    URHO3D_LOGERROR("Enable URHO3D_GLOW in build options");
+#endif
+}
+
+void PrecomputedVisibility::SetVolume(const BoundingBox& volume)
+{
+    volume_.min_ = volume.min_;
+    volume_.max_ = volume.max_;
+}
+
+bool PrecomputedVisibility::IsBaked() const
+{
+    const unsigned numCells = static_cast<unsigned>(numCells_.x_ * numCells_.y_ * numCells_.z_);
+    const unsigned numWordsPerCell = (nodes_.size() + 31) / 32;
+    return numCells > 0 && numWordsPerCell > 0 && visibility_.size() == numCells * numWordsPerCell;
+}
+
+unsigned PrecomputedVisibility::GetCellIndex(const Vector3& position) const
+{
+    if (numCells_.x_ <= 0 || numCells_.y_ <= 0 || numCells_.z_ <= 0 || volume_.IsInside(position) == OUTSIDE)
+        return M_MAX_UNSIGNED;
+
+    const Vector3 cellSize = volume_.Size() / numCells_.ToVector3();
+    const IntVector3 cell = VectorMin(
+        VectorMax(VectorFloorToInt((position - volume_.min_) / cellSize), IntVector3::ZERO), numCells_ - IntVector3::ONE);
+    return static_cast<unsigned>(cell.x_ + numCells_.x_ * (cell.y_ + numCells_.y_ * cell.z_));
+}
+
+bool PrecomputedVisibility::IsNodeVisible(unsigned cellIndex, unsigned nodeIndex) const
+{
+    const unsigned numWordsPerCell = (nodes_.size() + 31) / 32;
+    const unsigned wordIndex = cellIndex * numWordsPerCell + nodeIndex / 32;
+    if (nodeIndex >= nodes_.size() || wordIndex >= visibility_.size())
+        return true;
+    return (visibility_[wordIndex] & (1u << (nodeIndex % 32))) != 0;
+}
+
+bool PrecomputedVisibility::UpdateCulling(const Vector3& viewPosition)
+{
+    ResetCulling();
+
+    const unsigned cellIndex = IsBaked() ? GetCellIndex(viewPosition) : M_MAX_UNSIGNED;
+    if (cellIndex == M_MAX_UNSIGNED)
+        return false;
+
+    for (unsigned nodeIndex = 0; nodeIndex < nodes_.size(); ++nodeIndex)
+    {
+        Node* node = nodes_[nodeIndex];
+        if (!node || IsNodeVisible(cellIndex, nodeIndex))
+            continue;
+
+        for (Component* component : node->GetComponents())
+        {
+            if (component->GetType() != StaticModel::GetTypeStatic())
+                continue;
+
+            const unsigned drawableIndex = static_cast<Drawable*>(component)->GetDrawableIndex();
+            if (drawableIndex == M_MAX_UNSIGNED)
+                continue;
+
+            if (drawableIndex >= culledDrawables_.size())
+                culledDrawables_.resize(drawableIndex + 1);
+            culledDrawables_[drawableIndex] = true;
+            culledIndices_.push_back(drawableIndex);
+        }
+    }
+
+    return !culledIndices_.empty();
+}
+
+bool PrecomputedVisibility::IsCulled(const Drawable* drawable) const
+{
+    const unsigned drawableIndex = drawable->GetDrawableIndex();
+    return drawableIndex < culledDrawables_.size() && culledDrawables_[drawableIndex];
+}
+
+void PrecomputedVisibility::SetNodeIDsAttr(const VariantVector& value)
+{
+    // Just remember the node IDs. They need to go through the SceneResolver, and we actually find the nodes during
+    // ApplyAttributes()
+    nodeIDsAttr_.clear();
+    if (value.size())
+    {
+        unsigned index = 0;
+        unsigned numNodes = value[index++].GetUInt();
+        // Prevent crash on entering negative value in the editor
+        if (numNodes > M_MAX_INT)
+            numNodes = 0;
+
+        nodeIDsAttr_.push_back(numNodes);
+        while (numNodes--)
+        {
+            // If vector contains less IDs than should, fill the rest with zeroes
+            if (index < value.size())
+                nodeIDsAttr_.push_back(value[index++].GetUInt());
+            else
+                nodeIDsAttr_.push_back(0);
+        }
+    }
+    else
+        nodeIDsAttr_.push_back(0);
+
+    nodesDirty_ = true;
+    nodeIDsDirty_ = false;
+}
+
+const VariantVector& PrecomputedVisibility::GetNodeIDsAttr() const
+{
+    if (nodeIDsDirty_)
+        UpdateNodeIDs();
+
+    return nodeIDsAttr_;
+}
+
+void PrecomputedVisibility::SetVisibilityDataAttr(const ByteVector& value)
+{
+    visibility_.resize(value.size() / sizeof(unsigned));
+    if (!visibility_.empty())
+        memcpy(visibility_.data(), value.data(), visibility_.size() * sizeof(unsigned));
+    ResetCulling();
+}
+
+ByteVector PrecomputedVisibility::GetVisibilityDataAttr() const
+{
+    ByteVector result(visibility_.size() * sizeof(unsigned));
+    if (!visibility_.empty())
+        memcpy(result.data(), visibility_.data(), result.size());
+    return result;
+}
+
+void PrecomputedVisibility::UpdateNodeIDs() const
+{
+    nodeIDsAttr_.clear();
+    nodeIDsAttr_.push_back(nodes_.size());
+
+    for (Node* node : nodes_)
+        nodeIDsAttr_.push_back(node ? node->GetID() : 0);
+
+    nodeIDsDirty_ = false;
+}
+
+void PrecomputedVisibility::ResetCulling()
+{
+    for (unsigned drawableIndex : culledIndices_)
+        culledDrawables_[drawableIndex] = false;
+    culledIndices_.clear();
+}
+
+}
@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Math/BoundingBox.h"
+#include "../Scene/Component.h"
+
+namespace Urho3D
+{
+
+class Drawable;
+
+/// Potentially visible set of static objects baked for each cell of the volume, useful for indoor levels.
+/// Should be created in the scene root node. Render pipeline skips StaticModels of baked nodes
+/// that are not visible from the camera cell before testing them against the frustum.
+/// Camera outside of the volume doesn't cull anything, nodes created after baking are never culled.
+/// Baking traces rays from random points of each cell and requires URHO3D_GLOW.
+class URHO3D_API PrecomputedVisibility : public Component
+{
+    URHO3D_OBJECT(PrecomputedVisibility, Component);
+
+public:
+    static constexpr float DefaultCellSize = 4.0f;
+    static const unsigned DefaultNumSamplesPerCell = 8;
+    static const unsigned DefaultNumRaysPerObject = 4;
+    static const unsigned DefaultNumRandomRays = 256;
+    /// Max number of cells along each axis.
+    static const int MaxCellsPerAxis = 256;
+
+    /// Construct.
+    explicit PrecomputedVisibility(Context* context);
+    /// Destruct.
+    ~PrecomputedVisibility() override;
+    /// Register object factory.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Apply attribute changes that can not be applied immediately. Called after scene load or a network update.
+    void ApplyAttributes() override;
+
+    /// Bake visibility of StaticModels in the scene in main thread. Must be called outside rendering.
+    void Bake();
+
+    /// Set volume. If empty, bounding box of all StaticModels is used on bake.
+    void SetVolume(const BoundingBox& volume);
+    /// Set volume min point.
+    /// @property
+    void SetVolumeMin(const Vector3& value) { volume_.min_ = value; }
+    /// Set volume max point.
+    /// @property
+    void SetVolumeMax(const Vector3& value) { volume_.max_ = value; }
+    /// Set size of the cell in world units.
+    /// @property
+    void SetCellSize(float size) { cellSize_ = ea::max(size, M_EPSILON); }
+    /// Set number of sample points in each cell.
+    /// @property
+    void SetNumSamplesPerCell(unsigned count) { numSamplesPerCell_ = ea::max(count, 1u); }
+    /// Set number of rays traced from each sample point towards each object.
+    /// @property
+    void SetNumRaysPerObject(unsigned count) { numRaysPerObject_ = count; }
+    /// Set number of rays traced from each sample point in random directions.
+    /// @property
+    void SetNumRandomRays(unsigned count) { numRandomRays_ = count; }
+
+    /// Return volume.
+    const BoundingBox& GetVolume() const { return volume_; }
+    /// Return volume min point.
+    /// @property
+    const Vector3& GetVolumeMin() const { return volume_.min_; }
+    /// Return volume max point.
+    /// @property
+    const Vector3& GetVolumeMax() const { return volume_.max_; }
+    /// Return size of the cell in world units.
+    /// @property
+    float GetCellSize() const { return cellSize_; }
+    /// Return number of sample points in each cell.
+    /// @property
+    unsigned GetNumSamplesPerCell() const { return numSamplesPerCell_; }
+    /// Return number of rays traced from each sample point towards each object.
+    /// @property
+    unsigned GetNumRaysPerObject() const { return numRaysPerObject_; }
+    /// Return number of rays traced from each sample point in random directions.
+    /// @property
+    unsigned GetNumRandomRays() const { return numRandomRays_; }
+
+    /// Return number of baked cells along each axis.
+    const IntVector3& GetNumCells() const { return numCells_; }
+    /// Return number of baked nodes.
+    unsigned GetNumNodes() const { return nodes_.size(); }
+    /// Return baked node by index.
+    Node* GetNode(unsigned index) const { return index < nodes_.size() ? nodes_[index].Get() : nullptr; }
+    /// Return whether the visibility is baked.
+    bool IsBaked() const;
+    /// Return index of the baked cell containing position, or M_MAX_UNSIGNED if outside of the volume.
+    unsigned GetCellIndex(const Vector3& position) const;
+    /// Return whether the baked node is visible from the cell.
+    bool IsNodeVisible(unsigned cellIndex, unsigned nodeIndex) const;
+
+    /// Prepare culling for the view position. Return false if nothing can be culled.
+    bool UpdateCulling(const Vector3& viewPosition);
+    /// Return whether the drawable is culled for the last view position.
+    bool IsCulled(const Drawable* drawable) const;
+
+    /// Set node IDs attribute.
+    void SetNodeIDsAttr(const VariantVector& value);
+    /// Return node IDs attribute.
+    const VariantVector& GetNodeIDsAttr() const;
+    /// Set visibility data attribute.
+    void SetVisibilityDataAttr(const ByteVector& value);
+    /// Return visibility data attribute.
+    ByteVector GetVisibilityDataAttr() const;
+
+private:
+    /// Update node IDs attribute from the actual nodes.
+    void UpdateNodeIDs() const;
+    /// Reset culling state of the last view position.
+    void ResetCulling();
+
+    BoundingBox volume_{Vector3::ZERO, Vector3::ZERO};
+    float cellSize_{DefaultCellSize};
+    unsigned numSamplesPerCell_{DefaultNumSamplesPerCell};
+    unsigned numRaysPerObject_{DefaultNumRaysPerObject};
+    unsigned numRandomRays_{DefaultNumRandomRays};
+
+    /// Number of baked cells along each axis.
+    IntVector3 numCells_;
+    /// Baked nodes.
+    ea::vector<WeakPtr<Node>> nodes_;
+    /// Bit mask of visible nodes for each cell, padded to 32-bit words.
+    ea::vector<unsigned> visibility_;
+
+    /// IDs of baked nodes for serialization.
+    mutable VariantVector nodeIDsAttr_;
+    /// Whether node IDs have been set and nodes should be searched for during ApplyAttributes.
+    bool nodesDirty_{};
+    /// Whether nodes have been manipulated and node ID attribute should be refreshed.
+    mutable bool nodeIDsDirty_{};
+
+    /// Culled drawables by drawable index.
+    ea::vector<bool> culledDrawables_;
+    /// Indices of culled drawables.
+    ea::vector<unsigned> culledIndices_;
+};
+
+}
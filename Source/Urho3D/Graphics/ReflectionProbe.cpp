@@ -202,6 +202,7 @@ void ReflectionProbeManager::RegisterObject(Context* context)
 
     URHO3D_ATTRIBUTE("Query Padding", float, queryPadding_, DefaultQueryPadding, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Render Budget", unsigned, renderBudget_, DefaultRenderBudget, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Filter Budget", unsigned, filterBudget_, DefaultFilterBudget, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Filter Cubemaps", bool, filterCubemaps_, true, AM_DEFAULT);
 }
 
@@ -338,11 +339,15 @@ void ReflectionProbeManager::ConsumeUpdateQueue()
 
     unsigned numStaticProbesRendered = 0;
     unsigned numRenderedFaces = 0;
+    unsigned numFilteredLevels = 0;
+    unsigned numVisitedProbes = 0;
     for (QueuedReflectionProbe& queuedProbe : updateQueue_)
     {
         if (numRenderedFaces >= renderBudget_ && renderBudget_ > 0)
             break;
 
+        ++numVisitedProbes;
+
         ReflectionProbe* probe = queuedProbe.probe_;
         if (!probe)
             continue;
@@ -359,6 +364,9 @@ void ReflectionProbeManager::ConsumeUpdateQueue()
         // Render dynamic probe
         if (CubemapRenderer* probeRenderer = queuedProbe.cubemapRenderer_)
         {
+            if (probeRenderer->IsFiltering() && numFilteredLevels >= filterBudget_ && filterBudget_ > 0)
+                continue;
+
             CubemapUpdateParameters params;
             params.settings_ = probe->GetCubemapRenderingSettings();
             params.position_ = position;
@@ -368,6 +376,7 @@ void ReflectionProbeManager::ConsumeUpdateQueue()
             const CubemapUpdateResult result = probeRenderer->Update(params);
 
             numRenderedFaces += result.numRenderedFaces_;
+            numFilteredLevels += result.numFilteredLevels_;
             if (result.isComplete_)
                 queuedProbe = {};
             continue;
@@ -425,6 +434,9 @@ void ReflectionProbeManager::ConsumeUpdateQueue()
         ++numStaticProbesRendered;
     }
 
+    // Move visited probes to the end so sliced updates of all probes progress in round-robin
+    ea::rotate(updateQueue_.begin(), updateQueue_.begin() + numVisitedProbes, updateQueue_.end());
+
     ea::erase_if(updateQueue_, [](const QueuedReflectionProbe& queuedProbe)
     {
         return !queuedProbe.probe_;
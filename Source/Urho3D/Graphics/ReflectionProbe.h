@@ -81,6 +81,7 @@ public:
     using ReflectionProbeSpan = TransformedSpan<TrackedComponentBase* const, ReflectionProbe* const, StaticCaster<ReflectionProbe* const>>;
     static constexpr float DefaultQueryPadding = 2.0f;
     static constexpr unsigned DefaultRenderBudget = 6;
+    static constexpr unsigned DefaultFilterBudget = 2;
 
     explicit ReflectionProbeManager(Context* context);
     ~ReflectionProbeManager() override;
@@ -155,6 +156,8 @@ private:
 
     float queryPadding_{DefaultQueryPadding};
     unsigned renderBudget_{DefaultRenderBudget};
+    /// Max number of cubemap mip levels filtered per frame by sliced updates. Zero means unlimited.
+    unsigned filterBudget_{DefaultFilterBudget};
     bool filterCubemaps_{true};
 
     ea::unordered_set<WeakPtr<ReflectionProbe>> probesToUpdate_;
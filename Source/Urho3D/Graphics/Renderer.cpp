@@ -626,6 +626,7 @@ void Renderer::Initialize()
     graphics_ = graphics;
 
     hardwareSkinningSupported_ = true;
+    computeSkinningSupported_ = renderDevice && renderDevice->GetCaps().computeShaders_;
 
     defaultLightRamp_ = cache->GetResource<Texture2D>("Textures/Ramp.png");
     defaultLightSpot_ = cache->GetResource<Texture2D>("Textures/Spot.png");
@@ -177,6 +177,8 @@ enum SkinningMode
     SKINNING_AUTO,
     SKINNING_HARDWARE,
     SKINNING_SOFTWARE,
+    /// Skin and morph on GPU by compute shader once per frame. Falls back to hardware skinning if not supported.
+    SKINNING_COMPUTE,
 };
 
 /// Statistics collected during the last frame.
@@ -252,7 +254,13 @@ public:
     SkinningMode GetSkinningMode() const { return skinningMode_; }
 
     /// Return whether hardware skinning is used.
-    bool GetUseHardwareSkinning() const { return (skinningMode_ == SKINNING_AUTO && hardwareSkinningSupported_) || skinningMode_ == SKINNING_HARDWARE; }
+    bool GetUseHardwareSkinning() const
+    {
+        return (skinningMode_ == SKINNING_AUTO && hardwareSkinningSupported_) || skinningMode_ == SKINNING_HARDWARE
+            || (skinningMode_ == SKINNING_COMPUTE && !computeSkinningSupported_);
+    }
+    /// Return whether compute skinning is used. Compute skinning is a replacement of both hardware and software skinning.
+    bool GetUseComputeSkinning() const { return skinningMode_ == SKINNING_COMPUTE && computeSkinningSupported_; }
 
     /// Return number of bones used for software skinning.
     unsigned GetNumSoftwareSkinningBones() const { return numSoftwareSkinningBones_; }
@@ -379,6 +387,8 @@ private:
     bool resetViews_{};
     /// Whether hardware skinning is supported.
     bool hardwareSkinningSupported_{ true };
+    /// Whether compute skinning is supported.
+    bool computeSkinningSupported_{};
     /// Skinning mode.
     SkinningMode skinningMode_{};
     /// Number of bones used for software skinning.
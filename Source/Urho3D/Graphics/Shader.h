@@ -62,6 +62,8 @@ public:
     const ea::string& GetSourceCode() const { return sourceCode_; }
     /// Return the latest timestamp of the shader code and its includes.
     FileTime GetTimeStamp() const { return timeStamp_; }
+    /// Return all variations requested so far.
+    const auto& GetVariations() const { return variations_; }
 
     /// Return global list of shader files.
     static ea::string GetShaderFileList();
@@ -25,8 +25,10 @@
 #include "Urho3D/Graphics/ShaderVariation.h"
 
 #include "Urho3D/Core/ProcessUtils.h"
+#include "Urho3D/Core/WorkQueue.h"
 #include "Urho3D/Graphics/Graphics.h"
 #include "Urho3D/Graphics/Shader.h"
+#include "Urho3D/IO/ContentHash.h"
 #include "Urho3D/IO/Log.h"
 #include "Urho3D/IO/VirtualFileSystem.h"
 #include "Urho3D/RenderAPI/RenderAPIUtils.h"
@@ -90,186 +92,11 @@ template <class T> ConstByteSpan ToByteSpan(const T& value)
     return {dataBytes, sizeInBytes};
 }
 
-} // namespace
-
-ShaderVariation::ShaderVariation(Shader* owner, ShaderType type, const ea::string& defines)
-    : RawShader(owner->GetContext(), type)
-    , graphics_(GetSubsystem<Graphics>())
-    , owner_(owner)
-    , defines_(defines)
-{
-    SetDebugName(GetShaderVariationName());
-    Create();
-
-    owner->OnReloaded.Subscribe(this, &ShaderVariation::OnReloaded);
-}
-
-ea::string ShaderVariation::GetShaderName() const
-{
-    return owner_ ? owner_->GetShaderName() : EMPTY_STRING;
-}
-
-ea::string ShaderVariation::GetShaderVariationName() const
-{
-    return Format("{}({})", GetShaderName(), GetDefines());
-}
-
-void ShaderVariation::OnReloaded()
-{
-    Create();
-}
-
-bool ShaderVariation::Create()
-{
-    Destroy();
-
-    if (!graphics_)
-        return false;
-
-    if (!owner_)
-    {
-        URHO3D_LOGERROR("Owner shader has expired");
-        return false;
-    }
-
-    const GraphicsSettings& settings = graphics_->GetSettings();
-    const FileIdentifier& cacheDir = settings.shaderCacheDir_;
-    const FileIdentifier binaryShaderName = cacheDir + GetCachedVariationName("bytecode");
-
-    if (!LoadByteCode(binaryShaderName))
-    {
-        // Compile shader if don't have valid bytecode
-        if (!CompileFromSource())
-        {
-            // Notify everyone if compilation failed
-            CreateFromBinary({GetShaderType()});
-            return false;
-        }
-
-        // Save the bytecode after successful compile, but not if the source is from a package
-        if (settings.cacheShaders_ && owner_->GetTimeStamp())
-            SaveByteCode(binaryShaderName);
-    }
-
-    return true;
-}
-
-bool ShaderVariation::CompileFromSource()
-{
-    const ea::string& originalShaderCode = owner_->GetSourceCode();
-    const ea::string sourceCode = PrepareGLSLShaderCode(originalShaderCode);
-
-    ea::string_view translatedSource;
-    const SpirVShader* translatedSpirv{};
-    ConstByteSpan translatedBytecode;
-    const bool processed = ProcessShaderSource(translatedSource, translatedSpirv, translatedBytecode, sourceCode);
-
-    const FileIdentifier& cacheDir = graphics_->GetSettings().shaderCacheDir_;
-    const FileIdentifier loggedSourceShaderName = cacheDir + GetCachedVariationName("glsl");
-    LogShaderSource(loggedSourceShaderName, defines_, translatedSource);
-
-    if (!processed)
-        return false;
-
-    const RenderBackend renderBackend = graphics_->GetRenderBackend();
-
-    ShaderBytecode bytecode;
-    bytecode.type_ = GetShaderType();
-    bytecode.mime_ = GetCompiledShaderMIME(renderBackend);
-    bytecode.bytecode_.assign(translatedBytecode.begin(), translatedBytecode.end());
-    if (translatedSpirv && GetShaderType() == VS)
-        bytecode.vertexAttributes_ = GetVertexAttributesFromSpirV(*translatedSpirv);
-
-    CreateFromBinary(bytecode);
-    if (!GetHandle())
-    {
-        if (renderBackend == RenderBackend::OpenGL)
-            URHO3D_LOGINFO("Shader files:\n{}", Shader::GetShaderFileList());
-        return false;
-    }
-
-    return true;
-}
-
-bool ShaderVariation::LoadByteCode(const FileIdentifier& binaryShaderName)
-{
-    Context* context = Context::GetInstance();
-    auto vfs = context->GetSubsystem<VirtualFileSystem>();
-    if (!vfs->Exists(binaryShaderName))
-        return false;
-
-    // Check timestamps if available
-    const FileTime sourceTimeStamp = owner_->GetTimeStamp();
-    if (sourceTimeStamp)
-    {
-        const FileTime bytecodeTimeStamp = vfs->GetLastModifiedTime(binaryShaderName, false);
-        if (bytecodeTimeStamp && bytecodeTimeStamp < sourceTimeStamp)
-            return false;
-    }
-
-    const AbstractFilePtr file = vfs->OpenFile(binaryShaderName, FILE_READ);
-    if (!file)
-        return false;
-
-    ShaderBytecode bytecode;
-    if (!bytecode.LoadFromFile(*file))
-        return false;
-
-    const RenderBackend renderBackend = graphics_->GetRenderBackend();
-    if (bytecode.mime_ != GetCompiledShaderMIME(renderBackend))
-        return false;
-
-    CreateFromBinary(bytecode);
-    if (!GetHandle())
-        return false;
-
-    return true;
-}
-
-void ShaderVariation::SaveByteCode(const FileIdentifier& binaryShaderName)
-{
-    // TODO: Enable shader cache in Web. Currently it is disabled because of suboptimal persistent storage support.
-    if (GetPlatform() == PlatformId::Web)
-        return;
-
-    Context* context = Context::GetInstance();
-    auto vfs = context->GetSubsystem<VirtualFileSystem>();
-
-    auto file = vfs->OpenFile(binaryShaderName, FILE_WRITE);
-    if (!file)
-        return;
-
-    GetBytecode().SaveToFile(*file);
-}
-
-ea::string ShaderVariation::GetCachedVariationName(ea::string_view extension) const
-{
-    const ea::string backendName = ToString(graphics_->GetRenderBackend()).to_lower();
-    const ea::string shortName = owner_->GetShaderName();
-    const ea::string shaderTypeName = ToString(GetShaderType()).to_lower();
-    const StringHash definesHash{defines_};
-    return Format("{}_{}_{}_{}.{}", shortName, shaderTypeName, definesHash.ToString(), backendName, extension);
-}
-
-bool ShaderVariation::NeedShaderTranslation() const
-{
-    const ShaderTranslationPolicy policy = graphics_->GetSettings().shaderTranslationPolicy_;
-    return policy != ShaderTranslationPolicy::Verbatim;
-}
-
-bool ShaderVariation::NeedShaderOptimization() const
-{
-    const ShaderTranslationPolicy policy = graphics_->GetSettings().shaderTranslationPolicy_;
-    return policy == ShaderTranslationPolicy::Optimize;
-}
-
-ea::string ShaderVariation::PrepareGLSLShaderCode(const ea::string& originalShaderCode) const
+ea::string PrepareGLSLShaderCode(const ea::string& originalShaderCode, ShaderType shaderType, const ea::string& defines,
+    RenderBackend renderBackend, bool skipVersionTag)
 {
     ea::string shaderCode;
 
-    const RenderBackend renderBackend = graphics_->GetRenderBackend();
-    const bool skipVersionTag = NeedShaderTranslation();
-
     // Check if the shader code contains a version define
     const auto versionTag = FindVersionTag(originalShaderCode);
     if (!skipVersionTag)
@@ -284,7 +111,7 @@ ea::string ShaderVariation::PrepareGLSLShaderCode(const ea::string& originalShad
         else
         {
             const bool isOpenGLES = IsOpenGLESBackend(renderBackend);
-            const bool isCompute = GetShaderType() == CS;
+            const bool isCompute = shaderType == CS;
 
             static const char* versions[2][2] = {
                 {"#version 410\n", "#version 430\n"},
@@ -303,12 +130,12 @@ ea::string ShaderVariation::PrepareGLSLShaderCode(const ea::string& originalShad
         "#define COMPILEDS\n", // DS
         "#define COMPILECS\n", // CS
     };
-    shaderCode += shaderTypeDefines[GetShaderType()];
+    shaderCode += shaderTypeDefines[shaderType];
 
     shaderCode += Format("#define URHO3D_{}\n", ToString(renderBackend).to_upper());
 
     // Prepend the defines to the shader code
-    const StringVector defineVec = defines_.split(' ');
+    const StringVector defineVec = defines.split(' ');
     for (const ea::string& define : defineVec)
     {
         const ea::string defineString = "#define " + define.replaced('=', ' ') + " \n";
@@ -328,26 +155,26 @@ ea::string ShaderVariation::PrepareGLSLShaderCode(const ea::string& originalShad
     return shaderCode;
 }
 
-bool ShaderVariation::ProcessShaderSource(ea::string_view& translatedSource, const SpirVShader*& translatedSpirv,
-    ConstByteSpan& translatedBytecode, ea::string_view originalShaderCode)
+bool ProcessShaderSource(ea::string_view& translatedSource, const SpirVShader*& translatedSpirv,
+    ConstByteSpan& translatedBytecode, ea::string_view originalShaderCode, ShaderType shaderType,
+    RenderBackend renderBackend, ShaderTranslationPolicy policy, const ea::string& variationName)
 {
     translatedSource = originalShaderCode;
     translatedSpirv = nullptr;
     translatedBytecode = ToByteSpan(originalShaderCode);
 
-    const RenderBackend renderBackend = graphics_->GetRenderBackend();
     const TargetShaderLanguage targetShaderLanguage = GetTargetShaderLanguage(renderBackend);
-    const bool needShaderTranslation = NeedShaderTranslation();
-    const bool needShaderOptimization = NeedShaderOptimization();
+    const bool needShaderTranslation = policy != ShaderTranslationPolicy::Verbatim;
+    const bool needShaderOptimization = policy == ShaderTranslationPolicy::Optimize;
 
 #ifdef URHO3D_SHADER_TRANSLATOR
     if (needShaderTranslation)
     {
         static thread_local SpirVShader spirvShader;
-        ParseUniversalShader(spirvShader, GetShaderType(), originalShaderCode, {}, targetShaderLanguage);
+        ParseUniversalShader(spirvShader, shaderType, originalShaderCode, {}, targetShaderLanguage);
         if (!spirvShader)
         {
-            URHO3D_LOGERROR("Failed to convert shader {} from GLSL to SPIR-V:\n{}{}", GetShaderVariationName(),
+            URHO3D_LOGERROR("Failed to convert shader {} from GLSL to SPIR-V:\n{}{}", variationName,
                 Shader::GetShaderFileList(), spirvShader.compilerOutput_);
             return false;
         }
@@ -360,7 +187,7 @@ bool ShaderVariation::ProcessShaderSource(ea::string_view& translatedSource, con
             ea::string optimizerOutput;
             if (!OptimizeSpirVShader(spirvShader, optimizerOutput, targetShaderLanguage))
             {
-                URHO3D_LOGERROR("Failed to optimize SPIR-V shader {}:\n{}", GetShaderVariationName(), optimizerOutput);
+                URHO3D_LOGERROR("Failed to optimize SPIR-V shader {}:\n{}", variationName, optimizerOutput);
                 return false;
             }
         }
@@ -378,7 +205,7 @@ bool ShaderVariation::ProcessShaderSource(ea::string_view& translatedSource, con
             TranslateSpirVShader(targetShader, spirvShader, targetShaderLanguage);
             if (!targetShader)
             {
-                URHO3D_LOGERROR("Failed to convert shader {} from SPIR-V to HLSL:\n{}{}", GetShaderVariationName(),
+                URHO3D_LOGERROR("Failed to convert shader {} from SPIR-V to HLSL:\n{}{}", variationName,
                     Shader::GetShaderFileList(), targetShader.compilerOutput_);
                 return false;
             }
@@ -389,9 +216,9 @@ bool ShaderVariation::ProcessShaderSource(ea::string_view& translatedSource, con
                 // On D3D backends, compile the translated source code
                 static thread_local ByteVector hlslBytecode;
                 ea::string compilerOutput;
-                if (!CompileHLSLToBinary(hlslBytecode, compilerOutput, targetShader.sourceCode_, GetShaderType()))
+                if (!CompileHLSLToBinary(hlslBytecode, compilerOutput, targetShader.sourceCode_, shaderType))
                 {
-                    URHO3D_LOGERROR("Failed to compile HLSL shader {}:\n{}{}", GetShaderVariationName(),
+                    URHO3D_LOGERROR("Failed to compile HLSL shader {}:\n{}{}", variationName,
                         Shader::GetShaderFileList(), compilerOutput);
                     return false;
                 }
@@ -410,4 +237,318 @@ bool ShaderVariation::ProcessShaderSource(ea::string_view& translatedSource, con
     return true;
 }
 
+ea::string PrepareShaderCode(const ea::string& originalShaderCode, ShaderType shaderType, const ea::string& defines,
+    RenderBackend renderBackend, ShaderTranslationPolicy policy)
+{
+    const bool needShaderTranslation = policy != ShaderTranslationPolicy::Verbatim;
+    return PrepareGLSLShaderCode(originalShaderCode, shaderType, defines, renderBackend, needShaderTranslation);
+}
+
+/// Return hash of compiler input and settings. Variations with the same hash have the same bytecode.
+/// Preprocessed source is used if possible, so unused defines and comments don't affect the hash.
+unsigned long long GetShaderContentHash(
+    const ea::string& preparedCode, ShaderType shaderType, RenderBackend renderBackend, ShaderTranslationPolicy policy)
+{
+    const TargetShaderLanguage targetShaderLanguage = GetTargetShaderLanguage(renderBackend);
+
+    ContentHasher hasher;
+    hasher.Append(ShaderBytecode::Version);
+    hasher.Append(static_cast<unsigned long long>(shaderType));
+    hasher.Append(static_cast<unsigned long long>(renderBackend));
+    hasher.Append(static_cast<unsigned long long>(targetShaderLanguage));
+    hasher.Append(static_cast<unsigned long long>(policy));
+
+#ifdef URHO3D_SHADER_TRANSLATOR
+    if (policy != ShaderTranslationPolicy::Verbatim)
+    {
+        static thread_local ea::string preprocessedCode;
+        if (PreprocessUniversalShader(preprocessedCode, shaderType, preparedCode, targetShaderLanguage))
+        {
+            hasher.Append(preprocessedCode);
+            return hasher.GetHash();
+        }
+    }
+#endif
+
+    // Shader with preprocessor errors will fail to compile anyway
+    hasher.Append(preparedCode);
+    return hasher.GetHash();
+}
+
+/// Compile prepared shader source. Translated source is returned for logging even if compilation failed.
+bool CompilePreparedShaderSource(ShaderBytecode& bytecode, ea::string& translatedSourceCode,
+    const ea::string& preparedCode, ShaderType shaderType, RenderBackend renderBackend, ShaderTranslationPolicy policy,
+    const ea::string& variationName)
+{
+    ea::string_view translatedSource;
+    const SpirVShader* translatedSpirv{};
+    ConstByteSpan translatedBytecode;
+    const bool processed = ProcessShaderSource(translatedSource, translatedSpirv, translatedBytecode, preparedCode,
+        shaderType, renderBackend, policy, variationName);
+    translatedSourceCode = translatedSource;
+    if (!processed)
+        return false;
+
+    bytecode.type_ = shaderType;
+    bytecode.mime_ = GetCompiledShaderMIME(renderBackend);
+    bytecode.bytecode_.assign(translatedBytecode.begin(), translatedBytecode.end());
+    if (translatedSpirv && shaderType == VS)
+        bytecode.vertexAttributes_ = GetVertexAttributesFromSpirV(*translatedSpirv);
+    return true;
+}
+
+/// Return file name of cached bytecode with given content hash.
+ea::string GetContentCacheName(unsigned long long contentHash)
+{
+    return Format("/{:016x}.bytecode", contentHash);
+}
+
+} // namespace
+
+ShaderVariation::ShaderVariation(Shader* owner, ShaderType type, const ea::string& defines)
+    : RawShader(owner->GetContext(), type)
+    , graphics_(GetSubsystem<Graphics>())
+    , owner_(owner)
+    , defines_(defines)
+{
+    SetDebugName(GetShaderVariationName());
+    Create();
+
+    owner->OnReloaded.Subscribe(this, &ShaderVariation::OnReloaded);
+}
+
+ea::string ShaderVariation::GetShaderName() const
+{
+    return owner_ ? owner_->GetShaderName() : EMPTY_STRING;
+}
+
+ea::string ShaderVariation::GetShaderVariationName() const
+{
+    return Format("{}({})", GetShaderName(), GetDefines());
+}
+
+void ShaderVariation::OnReloaded()
+{
+    Create();
+}
+
+bool ShaderVariation::Create()
+{
+    Destroy();
+
+    compilationPending_ = false;
+    ++compilationRevision_;
+
+    if (!graphics_)
+        return false;
+
+    if (!owner_)
+    {
+        URHO3D_LOGERROR("Owner shader has expired");
+        return false;
+    }
+
+    const GraphicsSettings& settings = graphics_->GetSettings();
+    const RenderBackend renderBackend = graphics_->GetRenderBackend();
+    const ShaderTranslationPolicy policy = settings.shaderTranslationPolicy_;
+
+    // Bytecode cooked by ShaderCooker is shipped with resources, it's cheaper to load than to preprocess the shader
+    if (!settings.cookedShaderCacheDir_.IsEmpty()
+        && LoadByteCode(settings.cookedShaderCacheDir_ + GetCachedVariationName("bytecode"), true))
+        return true;
+
+    // Local cache is content-addressed, variations that differ only in unused defines share the same bytecode.
+    // Hash includes the source, so timestamps don't matter.
+    const ea::string preparedCode =
+        PrepareShaderCode(owner_->GetSourceCode(), GetShaderType(), defines_, renderBackend, policy);
+    const unsigned long long contentHash = GetShaderContentHash(preparedCode, GetShaderType(), renderBackend, policy);
+    const FileIdentifier binaryShaderName = settings.shaderCacheDir_ + GetContentCacheName(contentHash);
+    if (LoadByteCode(binaryShaderName, false))
+        return true;
+
+    // Compile shader in background if allowed, pipeline states are recreated when it's ready
+    auto workQueue = GetSubsystem<WorkQueue>();
+    if (settings.asyncShaderCompilation_ && workQueue && workQueue->IsMultithreaded())
+    {
+        CompileFromSourceAsync(preparedCode, binaryShaderName);
+        return true;
+    }
+
+    // Compile shader if don't have valid bytecode
+    if (!CompileFromSource(preparedCode))
+    {
+        // Notify everyone if compilation failed
+        CreateFromBinary({GetShaderType()});
+        return false;
+    }
+
+    // Save the bytecode after successful compile, but not if the source is from a package
+    if (settings.cacheShaders_ && owner_->GetTimeStamp())
+        SaveByteCode(binaryShaderName);
+
+    return true;
+}
+
+bool ShaderVariation::CompileFromSource(const ea::string& preparedCode)
+{
+    const GraphicsSettings& settings = graphics_->GetSettings();
+    const RenderBackend renderBackend = graphics_->GetRenderBackend();
+
+    ShaderBytecode bytecode;
+    ea::string translatedSource;
+    const bool compiled = CompilePreparedShaderSource(bytecode, translatedSource, preparedCode, GetShaderType(),
+        renderBackend, settings.shaderTranslationPolicy_, GetShaderVariationName());
+
+    return CreateFromCompiledSource(compiled, ea::move(bytecode), translatedSource);
+}
+
+void ShaderVariation::CompileFromSourceAsync(const ea::string& preparedCode, const FileIdentifier& binaryShaderName)
+{
+    const GraphicsSettings& settings = graphics_->GetSettings();
+    auto workQueue = GetSubsystem<WorkQueue>();
+
+    compilationPending_ = true;
+
+    const WeakPtr<ShaderVariation> weakSelf{this};
+    const unsigned revision = compilationRevision_;
+    const ShaderType shaderType = GetShaderType();
+    const RenderBackend renderBackend = graphics_->GetRenderBackend();
+    const ShaderTranslationPolicy policy = settings.shaderTranslationPolicy_;
+    const ea::string variationName = GetShaderVariationName();
+
+    // Shader is compiled in the worker thread, only GPU object is created in the main thread
+    workQueue->PostTask([=]()
+    {
+        ShaderBytecode bytecode;
+        ea::string translatedSource;
+        const bool compiled = CompilePreparedShaderSource(
+            bytecode, translatedSource, preparedCode, shaderType, renderBackend, policy, variationName);
+
+        workQueue->PostTaskForMainThread(
+            [=, bytecode = ea::move(bytecode), translatedSource = ea::move(translatedSource)]()
+        {
+            if (weakSelf)
+                weakSelf->FinishAsyncCompilation(revision, compiled, bytecode, translatedSource, binaryShaderName);
+        });
+    }, TaskPriority::Low);
+}
+
+void ShaderVariation::FinishAsyncCompilation(unsigned revision, bool compiled, ShaderBytecode bytecode,
+    const ea::string& translatedSource, const FileIdentifier& binaryShaderName)
+{
+    // Shader has been reloaded or recreated while compiling
+    if (revision != compilationRevision_ || !graphics_ || !owner_)
+        return;
+
+    compilationPending_ = false;
+    if (!CreateFromCompiledSource(compiled, ea::move(bytecode), translatedSource))
+    {
+        // Notify everyone if compilation failed
+        CreateFromBinary({GetShaderType()});
+        return;
+    }
+
+    const GraphicsSettings& settings = graphics_->GetSettings();
+    if (settings.cacheShaders_ && owner_->GetTimeStamp())
+        SaveByteCode(binaryShaderName);
+}
+
+bool ShaderVariation::CreateFromCompiledSource(
+    bool compiled, ShaderBytecode bytecode, const ea::string& translatedSource)
+{
+    const GraphicsSettings& settings = graphics_->GetSettings();
+    const RenderBackend renderBackend = graphics_->GetRenderBackend();
+
+    const FileIdentifier loggedSourceShaderName = settings.shaderCacheDir_ + GetCachedVariationName("glsl");
+    LogShaderSource(loggedSourceShaderName, defines_, translatedSource);
+
+    if (!compiled)
+        return false;
+
+    CreateFromBinary(ea::move(bytecode));
+    if (!GetHandle())
+    {
+        if (renderBackend == RenderBackend::OpenGL)
+            URHO3D_LOGINFO("Shader files:\n{}", Shader::GetShaderFileList());
+        return false;
+    }
+
+    return true;
+}
+
+bool ShaderVariation::CompileByteCode(ShaderBytecode& bytecode, const ea::string& shaderName, ShaderType type,
+    const ea::string& defines, const ea::string& sourceCode, RenderBackend backend, ShaderTranslationPolicy policy)
+{
+    ea::string translatedSource;
+    const ea::string preparedCode = PrepareShaderCode(sourceCode, type, defines, backend, policy);
+    return CompilePreparedShaderSource(
+        bytecode, translatedSource, preparedCode, type, backend, policy, Format("{}({})", shaderName, defines));
+}
+
+bool ShaderVariation::LoadByteCode(const FileIdentifier& binaryShaderName, bool checkTimeStamp)
+{
+    Context* context = Context::GetInstance();
+    auto vfs = context->GetSubsystem<VirtualFileSystem>();
+    if (!vfs->Exists(binaryShaderName))
+        return false;
+
+    // Check timestamps if available
+    const FileTime sourceTimeStamp = checkTimeStamp ? owner_->GetTimeStamp() : 0;
+    if (sourceTimeStamp)
+    {
+        const FileTime bytecodeTimeStamp = vfs->GetLastModifiedTime(binaryShaderName, false);
+        if (bytecodeTimeStamp && bytecodeTimeStamp < sourceTimeStamp)
+            return false;
+    }
+
+    const AbstractFilePtr file = vfs->OpenFile(binaryShaderName, FILE_READ);
+    if (!file)
+        return false;
+
+    ShaderBytecode bytecode;
+    if (!bytecode.LoadFromFile(*file))
+        return false;
+
+    const RenderBackend renderBackend = graphics_->GetRenderBackend();
+    if (bytecode.mime_ != GetCompiledShaderMIME(renderBackend))
+        return false;
+
+    CreateFromBinary(bytecode);
+    if (!GetHandle())
+        return false;
+
+    return true;
+}
+
+void ShaderVariation::SaveByteCode(const FileIdentifier& binaryShaderName)
+{
+    // TODO: Enable shader cache in Web. Currently it is disabled because of suboptimal persistent storage support.
+    if (GetPlatform() == PlatformId::Web)
+        return;
+
+    Context* context = Context::GetInstance();
+    auto vfs = context->GetSubsystem<VirtualFileSystem>();
+
+    auto file = vfs->OpenFile(binaryShaderName, FILE_WRITE);
+    if (!file)
+        return;
+
+    GetBytecode().SaveToFile(*file);
+}
+
+ea::string ShaderVariation::GetCachedVariationName(ea::string_view extension) const
+{
+    return GetCachedVariationName(
+        owner_->GetShaderName(), GetShaderType(), defines_, graphics_->GetRenderBackend(), extension);
+}
+
+ea::string ShaderVariation::GetCachedVariationName(const ea::string& shaderName, ShaderType type,
+    const ea::string& defines, RenderBackend backend, ea::string_view extension)
+{
+    const ea::string backendName = ToString(backend).to_lower();
+    const ea::string shaderTypeName = ToString(type).to_lower();
+    const StringHash definesHash{defines};
+    return Format("{}_{}_{}_{}.{}", shaderName, shaderTypeName, definesHash.ToString(), backendName, extension);
+}
+
 } // namespace Urho3D
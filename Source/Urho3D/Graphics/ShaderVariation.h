@@ -38,6 +38,7 @@ namespace Urho3D
 
 class Shader;
 struct FileIdentifier;
+struct ShaderBytecode;
 struct SpirVShader;
 
 /// Vertex or pixel shader on the GPU.
@@ -47,26 +48,36 @@ class URHO3D_API ShaderVariation
 public:
     ShaderVariation(Shader* owner, ShaderType type, const ea::string& defines);
 
+    /// Return source shader.
+    Shader* GetOwner() const { return owner_; }
     /// Return shader name (as used in resources).
     ea::string GetShaderName() const;
     /// Return full shader variation name with defines.
     ea::string GetShaderVariationName() const;
     /// Return defines used to create the shader.
     const ea::string& GetDefines() const { return defines_; }
+    /// Implement RawShader.
+    bool IsCompilationPending() const override { return compilationPending_; }
+
+    /// Compile shader source code into bytecode for the backend. Doesn't need render device and is thread-safe,
+    /// so variations may be compiled offline in parallel.
+    static bool CompileByteCode(ShaderBytecode& bytecode, const ea::string& shaderName, ShaderType type,
+        const ea::string& defines, const ea::string& sourceCode, RenderBackend backend, ShaderTranslationPolicy policy);
+    /// Return file name of cached bytecode or logged source of the variation.
+    static ea::string GetCachedVariationName(const ea::string& shaderName, ShaderType type, const ea::string& defines,
+        RenderBackend backend, ea::string_view extension);
 
 private:
     ea::string GetCachedVariationName(ea::string_view extension) const;
-    bool NeedShaderTranslation() const;
-    bool NeedShaderOptimization() const;
-
-    ea::string PrepareGLSLShaderCode(const ea::string& originalShaderCode) const;
-    bool ProcessShaderSource(ea::string_view& translatedSource, const SpirVShader*& translatedSpirv,
-        ConstByteSpan& translatedBytecode, ea::string_view originalShaderCode);
 
     void OnReloaded();
     bool Create();
-    bool CompileFromSource();
-    bool LoadByteCode(const FileIdentifier& binaryShaderName);
+    bool CompileFromSource(const ea::string& preparedCode);
+    void CompileFromSourceAsync(const ea::string& preparedCode, const FileIdentifier& binaryShaderName);
+    void FinishAsyncCompilation(unsigned revision, bool compiled, ShaderBytecode bytecode,
+        const ea::string& translatedSource, const FileIdentifier& binaryShaderName);
+    bool CreateFromCompiledSource(bool compiled, ShaderBytecode bytecode, const ea::string& translatedSource);
+    bool LoadByteCode(const FileIdentifier& binaryShaderName, bool checkTimeStamp);
     void SaveByteCode(const FileIdentifier& binaryShaderName);
 
     /// Cached pointer to Graphics subsystem.
@@ -75,6 +86,10 @@ private:
     WeakPtr<Shader> owner_;
     /// Defines to use when compiling the shader.
     ea::string defines_;
+    /// Whether the shader is being compiled in background.
+    bool compilationPending_{};
+    /// Incremented on every recreation, results of outdated background compilation are discarded.
+    unsigned compilationRevision_{};
 };
 
 } // namespace Urho3D
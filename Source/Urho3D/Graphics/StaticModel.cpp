@@ -161,6 +161,8 @@ void StaticModel::UpdateBatches(const FrameInfo& frame)
         lodDistance_ = newLodDistance;
         CalculateLodLevels();
     }
+
+    ReportLodLevels();
 }
 
 Geometry* StaticModel::GetLodGeometry(unsigned batchIndex, unsigned level)
@@ -444,6 +446,21 @@ void StaticModel::CalculateLodLevels()
     }
 }
 
+void StaticModel::ReportLodLevels()
+{
+    if (!model_ || !model_->IsLodStreamable())
+        return;
+
+    // Geometries without LOD levels don't need anything to be streamed
+    unsigned lodLevel = M_MAX_UNSIGNED;
+    for (unsigned i = 0; i < geometryData_.size(); ++i)
+    {
+        if (geometries_[i].size() > 1)
+            lodLevel = ea::min(lodLevel, geometryData_[i].lodLevel_);
+    }
+    model_->ReportLodLevel(lodLevel);
+}
+
 void StaticModel::UpdateBatchesLightmaps()
 {
     if (GetBakeLightmapEffective())
@@ -144,6 +144,8 @@ protected:
     void ResetLodLevels();
     /// Choose LOD levels based on distance.
     void CalculateLodLevels();
+    /// Report the finest used LOD level to the model for LOD streaming.
+    void ReportLodLevels();
     /// Update lightmaps in batches.
     void UpdateBatchesLightmaps();
 
@@ -196,6 +196,8 @@ void StaticModelGroup::UpdateBatches(const FrameInfo& frame)
         lodDistance_ = newLodDistance;
         CalculateLodLevels();
     }
+
+    ReportLodLevels();
 }
 
 unsigned StaticModelGroup::GetNumOccluderTriangles()
@@ -23,107 +23,154 @@
 #include "../Precompiled.h"
 
 #include "../Graphics/Tangent.h"
+
+#include "../Core/WorkQueue.h"
 #include "../Math/Vector4.h"
 
+#include <EASTL/vector.h>
+
 namespace Urho3D
 {
 
-inline unsigned GetIndex(void*& indexPointer, unsigned indexSize)
+namespace
+{
+
+/// Number of triangles or vertices processed by one task.
+const unsigned TangentBucketSize = 4096;
+
+/// Tangent and bitangent accumulated for one triangle corner.
+struct CornerTangent
+{
+    Vector3 tangent_;
+    Vector3 bitangent_;
+};
+
+unsigned GetIndex(const void* indexData, unsigned indexSize, unsigned index)
 {
     if (indexSize == sizeof(unsigned short))
-    {
-        auto& p = (unsigned short*&)indexPointer;
-        return *p++;
-    }
+        return static_cast<const unsigned short*>(indexData)[index];
     else
-    {
-        auto& p = (unsigned*&)indexPointer;
-        return *p++;
-    }
+        return static_cast<const unsigned*>(indexData)[index];
+}
+
+/// Return vector projected onto plane with given normal and normalized.
+Vector3 ProjectOntoPlane(const Vector3& vec, const Vector3& normal)
+{
+    return (vec - normal * normal.DotProduct(vec)).Normalized();
+}
+
+/// Return any unit vector orthogonal to the normal.
+Vector3 GetOrthogonalVector(const Vector3& normal)
+{
+    const Vector3 axis = Abs(normal.x_) < 0.9f ? Vector3::RIGHT : Vector3::UP;
+    return ProjectOntoPlane(axis, normal);
+}
+
+template <class Callback> void ProcessInBuckets(WorkQueue* workQueue, unsigned size, const Callback& callback)
+{
+    if (workQueue && workQueue->IsMultithreaded())
+        ForEachParallel(workQueue, TangentBucketSize, size, callback);
+    else if (size > 0)
+        callback(0, size);
+}
+
 }
 
 void GenerateTangents(void* vertexData, unsigned vertexSize, const void* indexData, unsigned indexSize, unsigned indexStart,
-    unsigned indexCount, unsigned normalOffset, unsigned texCoordOffset, unsigned tangentOffset)
+    unsigned indexCount, unsigned normalOffset, unsigned texCoordOffset, unsigned tangentOffset, WorkQueue* workQueue)
 {
-    // Tangent generation from
-    // http://www.terathon.com/code/tangent.html
+    // Tangents are calculated like in MikkTSpace: triangle tangents are projected onto the tangent plane of the vertex
+    // and weighted by the angle of the triangle corner, so the result doesn't depend on the triangulation density.
+    auto* vertices = static_cast<unsigned char*>(vertexData);
+    const auto getPosition = [&](unsigned i) -> const Vector3& { return *reinterpret_cast<Vector3*>(vertices + i * vertexSize); };
+    const auto getNormal = [&](unsigned i) -> const Vector3& { return *reinterpret_cast<Vector3*>(vertices + i * vertexSize + normalOffset); };
+    const auto getTexCoord = [&](unsigned i) -> const Vector2& { return *reinterpret_cast<Vector2*>(vertices + i * vertexSize + texCoordOffset); };
+    const auto getIndex = [&](unsigned i) { return GetIndex(indexData, indexSize, indexStart + i); };
+
+    const unsigned numTriangles = indexCount / 3;
+    ea::vector<CornerTangent> cornerTangents(numTriangles * 3);
+    ProcessInBuckets(workQueue, numTriangles, [&](unsigned beginTriangle, unsigned endTriangle)
+    {
+        for (unsigned triangle = beginTriangle; triangle < endTriangle; ++triangle)
+        {
+            const unsigned indices[3] = {getIndex(triangle * 3), getIndex(triangle * 3 + 1), getIndex(triangle * 3 + 2)};
+
+            const Vector3& v1 = getPosition(indices[0]);
+            const Vector3& v2 = getPosition(indices[1]);
+            const Vector3& v3 = getPosition(indices[2]);
+            const Vector2& w1 = getTexCoord(indices[0]);
+            const Vector2& w2 = getTexCoord(indices[1]);
+            const Vector2& w3 = getTexCoord(indices[2]);
+
+            const Vector3 e1 = v2 - v1;
+            const Vector3 e2 = v3 - v1;
+            const Vector2 st1 = w2 - w1;
+            const Vector2 st2 = w3 - w1;
+
+            // Skip triangles degenerate in texture space, they don't define tangent directions
+            const float area = st1.x_ * st2.y_ - st2.x_ * st1.y_;
+            if (Abs(area) < M_EPSILON * M_EPSILON)
+                continue;
+
+            const float r = 1.0f / area;
+            const Vector3 sdir = (e1 * st2.y_ - e2 * st1.y_) * r;
+            const Vector3 tdir = (e2 * st1.x_ - e1 * st2.x_) * r;
+
+            for (unsigned corner = 0; corner < 3; ++corner)
+            {
+                const Vector3& normal = getNormal(indices[corner]);
+                const Vector3& origin = getPosition(indices[corner]);
+                const Vector3 edge1 = ProjectOntoPlane(getPosition(indices[(corner + 1) % 3]) - origin, normal);
+                const Vector3 edge2 = ProjectOntoPlane(getPosition(indices[(corner + 2) % 3]) - origin, normal);
+                const float angle = Acos(edge1.DotProduct(edge2)) * M_DEGTORAD;
+
+                CornerTangent& cornerTangent = cornerTangents[triangle * 3 + corner];
+                cornerTangent.tangent_ = ProjectOntoPlane(sdir, normal) * angle;
+                cornerTangent.bitangent_ = ProjectOntoPlane(tdir, normal) * angle;
+            }
+        }
+    });
+
+    // Accumulate corners in fixed order so the result doesn't depend on the number of threads
     unsigned minVertex = M_MAX_UNSIGNED;
     unsigned maxVertex = 0;
-    auto* vertices = (unsigned char*)vertexData;
-
-    auto* indexPointer = const_cast<void*>(indexData);
-    for (unsigned i = indexStart; i < indexStart + indexCount; ++i)
+    for (unsigned i = 0; i < numTriangles * 3; ++i)
     {
-        unsigned v = GetIndex(indexPointer, indexSize);
-        if (v < minVertex)
-            minVertex = v;
-        if (v > maxVertex)
-            maxVertex = v;
+        const unsigned vertex = getIndex(i);
+        minVertex = ea::min(minVertex, vertex);
+        maxVertex = ea::max(maxVertex, vertex);
     }
+    if (minVertex > maxVertex)
+        return;
 
-    unsigned vertexCount = maxVertex + 1;
-    auto* tan1 = new Vector3[vertexCount * 2];
-    Vector3* tan2 = tan1 + vertexCount;
-    memset(tan1, 0, sizeof(Vector3) * vertexCount * 2);
-
-    indexPointer = const_cast<void*>(indexData);
-    for (unsigned i = indexStart; i < indexStart + indexCount; i += 3)
+    ea::vector<CornerTangent> vertexTangents(maxVertex - minVertex + 1);
+    for (unsigned i = 0; i < numTriangles * 3; ++i)
     {
-        unsigned i1 = GetIndex(indexPointer, indexSize);
-        unsigned i2 = GetIndex(indexPointer, indexSize);
-        unsigned i3 = GetIndex(indexPointer, indexSize);
-
-        const Vector3& v1 = *((Vector3*)(vertices + i1 * vertexSize));
-        const Vector3& v2 = *((Vector3*)(vertices + i2 * vertexSize));
-        const Vector3& v3 = *((Vector3*)(vertices + i3 * vertexSize));
-
-        const Vector2& w1 = *((Vector2*)(vertices + i1 * vertexSize + texCoordOffset));
-        const Vector2& w2 = *((Vector2*)(vertices + i2 * vertexSize + texCoordOffset));
-        const Vector2& w3 = *((Vector2*)(vertices + i3 * vertexSize + texCoordOffset));
-
-        float x1 = v2.x_ - v1.x_;
-        float x2 = v3.x_ - v1.x_;
-        float y1 = v2.y_ - v1.y_;
-        float y2 = v3.y_ - v1.y_;
-        float z1 = v2.z_ - v1.z_;
-        float z2 = v3.z_ - v1.z_;
-
-        float s1 = w2.x_ - w1.x_;
-        float s2 = w3.x_ - w1.x_;
-        float t1 = w2.y_ - w1.y_;
-        float t2 = w3.y_ - w1.y_;
-
-        float r = 1.0f / (s1 * t2 - s2 * t1);
-        Vector3 sdir((t2 * x1 - t1 * x2) * r, (t2 * y1 - t1 * y2) * r, (t2 * z1 - t1 * z2) * r);
-        Vector3 tdir((s1 * x2 - s2 * x1) * r, (s1 * y2 - s2 * y1) * r, (s1 * z2 - s2 * z1) * r);
-
-        tan1[i1] += sdir;
-        tan1[i2] += sdir;
-        tan1[i3] += sdir;
-
-        tan2[i1] += tdir;
-        tan2[i2] += tdir;
-        tan2[i3] += tdir;
+        CornerTangent& vertexTangent = vertexTangents[getIndex(i) - minVertex];
+        vertexTangent.tangent_ += cornerTangents[i].tangent_;
+        vertexTangent.bitangent_ += cornerTangents[i].bitangent_;
     }
 
-    for (unsigned i = minVertex; i <= maxVertex; i++)
+    ProcessInBuckets(workQueue, vertexTangents.size(), [&](unsigned beginIndex, unsigned endIndex)
     {
-        const Vector3& n = *((Vector3*)(vertices + i * vertexSize + normalOffset));
-        const Vector3& t = tan1[i];
-        Vector3 xyz;
-        float w;
-
-        // Gram-Schmidt orthogonalize
-        xyz = (t - n * n.DotProduct(t)).Normalized();
-
-        // Calculate handedness
-        w = n.CrossProduct(t).DotProduct(tan2[i]) < 0.0f ? -1.0f : 1.0f;
-
-        Vector4& tangent = *((Vector4*)(vertices + i * vertexSize + tangentOffset));
-        tangent = xyz.ToVector4(w);
-    }
-
-    delete[] tan1;
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            const unsigned vertex = minVertex + i;
+            const Vector3& n = getNormal(vertex);
+            const Vector3& t = vertexTangents[i].tangent_;
+
+            // Gram-Schmidt orthogonalize
+            Vector3 xyz = ProjectOntoPlane(t, n);
+            if (xyz == Vector3::ZERO)
+                xyz = GetOrthogonalVector(n);
+
+            // Calculate handedness
+            const float w = n.CrossProduct(xyz).DotProduct(vertexTangents[i].bitangent_) < 0.0f ? -1.0f : 1.0f;
+
+            Vector4& tangent = *reinterpret_cast<Vector4*>(vertices + vertex * vertexSize + tangentOffset);
+            tangent = xyz.ToVector4(w);
+        }
+    });
 }
 
 }
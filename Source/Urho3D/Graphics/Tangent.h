@@ -27,9 +27,12 @@
 namespace Urho3D
 {
 
-/// Generate tangents to indexed geometry.
+class WorkQueue;
+
+/// Generate MikkTSpace-style tangents to indexed geometry.
+/// Large geometries are processed in multiple threads if work queue is provided.
 URHO3D_API void GenerateTangents
     (void* vertexData, unsigned vertexSize, const void* indexData, unsigned indexSize, unsigned indexStart, unsigned indexCount,
-        unsigned normalOffset, unsigned texCoordOffset, unsigned tangentOffset);
+        unsigned normalOffset, unsigned texCoordOffset, unsigned tangentOffset, WorkQueue* workQueue = nullptr);
 
 }
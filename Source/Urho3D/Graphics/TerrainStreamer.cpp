@@ -0,0 +1,404 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Graphics/TerrainStreamer.h"
+
+#include "../Core/Context.h"
+#include "../Core/Format.h"
+#include "../Core/Profiler.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/Terrain.h"
+#include "../IO/Log.h"
+#include "../Resource/Image.h"
+#include "../Resource/ResourceCache.h"
+#include "../Resource/ResourceEvents.h"
+#include "../Scene/Node.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
+#ifdef URHO3D_PHYSICS
+    #include "../Physics/CollisionShape.h"
+    #include "../Physics/RigidBody.h"
+#endif
+
+#include <EASTL/sort.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const IntVector2 northOffset{0, 1};
+const IntVector2 southOffset{0, -1};
+const IntVector2 westOffset{-1, 0};
+const IntVector2 eastOffset{1, 0};
+
+}
+
+TerrainStreamer::TerrainStreamer(Context* context)
+    : Component(context)
+{
+}
+
+TerrainStreamer::~TerrainStreamer() = default;
+
+void TerrainStreamer::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<TerrainStreamer>(Category_Geometry);
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, bool, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Height Map Pattern", GetHeightMapPattern, SetHeightMapPattern, ea::string, EMPTY_STRING, AM_DEFAULT);
+    URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Material", GetMaterialAttr, SetMaterialAttr, ResourceRef, ResourceRef(Material::GetTypeStatic()),
+        AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Tile Resolution", GetTileResolution, SetTileResolution, int, 256, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Vertex Spacing", GetSpacing, SetSpacing, Vector3, Vector3(1.0f, 0.25f, 1.0f), AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Patch Size", GetPatchSize, SetPatchSize, int, 32, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max LOD Levels", GetMaxLodLevels, SetMaxLodLevels, unsigned, 4, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Load Distance", GetLoadDistance, SetLoadDistance, float, 512.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Unload Distance", GetUnloadDistance, SetUnloadDistance, float, 768.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Collision Distance", GetCollisionDistance, SetCollisionDistance, float, 0.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Tiles Per Frame", GetMaxTilesPerFrame, SetMaxTilesPerFrame, unsigned, 1, AM_DEFAULT);
+}
+
+void TerrainStreamer::SetHeightMapPattern(const ea::string& pattern)
+{
+    if (pattern == heightMapPattern_)
+        return;
+
+    UnloadTiles();
+    heightMapPattern_ = pattern;
+}
+
+void TerrainStreamer::SetMaterial(Material* material)
+{
+    material_ = material;
+    for (const auto& [index, tile] : tiles_)
+    {
+        if (Terrain* terrain = GetTile(index))
+            terrain->SetMaterial(material_);
+    }
+}
+
+void TerrainStreamer::SetTileResolution(int resolution)
+{
+    resolution = Max(resolution, 1);
+    if (resolution == tileResolution_)
+        return;
+
+    UnloadTiles();
+    tileResolution_ = resolution;
+}
+
+void TerrainStreamer::SetSpacing(const Vector3& spacing)
+{
+    if (spacing == spacing_)
+        return;
+
+    UnloadTiles();
+    spacing_ = spacing;
+}
+
+void TerrainStreamer::SetPatchSize(int size)
+{
+    if (size == patchSize_)
+        return;
+
+    UnloadTiles();
+    patchSize_ = size;
+}
+
+void TerrainStreamer::SetMaxLodLevels(unsigned levels)
+{
+    maxLodLevels_ = levels;
+    for (const auto& [index, tile] : tiles_)
+    {
+        if (Terrain* terrain = GetTile(index))
+            terrain->SetMaxLodLevels(maxLodLevels_);
+    }
+}
+
+void TerrainStreamer::UnloadTiles()
+{
+    while (!tiles_.empty())
+        RemoveTile(tiles_.begin()->first);
+}
+
+void TerrainStreamer::UpdateTiles()
+{
+    if (!node_ || !focusNode_ || heightMapPattern_.empty() || !IsEnabledEffective())
+        return;
+
+    URHO3D_PROFILE("UpdateTerrainStreamer");
+
+    auto cache = GetSubsystem<ResourceCache>();
+    const Vector3 focusPosition = node_->GetWorldTransform().Inverse() * focusNode_->GetWorldPosition();
+    const float unloadDistance = Max(unloadDistance_, loadDistance_);
+
+    // Unload tiles that are too far
+    ea::vector<IntVector2> tilesToRemove;
+    for (const auto& [index, tile] : tiles_)
+    {
+        if (GetTileDistance(index, focusPosition) > unloadDistance)
+            tilesToRemove.push_back(index);
+    }
+    for (const IntVector2& index : tilesToRemove)
+        RemoveTile(index);
+
+    // Request height maps of tiles in range
+    const Vector2 tileSize = GetTileSize();
+    const IntVector2 focusIndex = GetTileIndex(focusNode_->GetWorldPosition());
+    const IntVector2 range{CeilToInt(loadDistance_ / tileSize.x_), CeilToInt(loadDistance_ / tileSize.y_)};
+    for (int z = focusIndex.y_ - range.y_; z <= focusIndex.y_ + range.y_; ++z)
+    {
+        for (int x = focusIndex.x_ - range.x_; x <= focusIndex.x_ + range.x_; ++x)
+        {
+            const IntVector2 index{x, z};
+            const float distance = GetTileDistance(index, focusPosition);
+            if (distance > loadDistance_)
+                continue;
+
+            TileState& tile = tiles_[index];
+            if (tile.node_ || tile.loading_ || tile.ready_ || tile.missing_)
+                continue;
+
+            tile.heightMapName_ = heightMapPattern_;
+            tile.heightMapName_.replace("{x}", ea::to_string(x));
+            tile.heightMapName_.replace("{z}", ea::to_string(z));
+            if (!cache->Exists(tile.heightMapName_))
+            {
+                tile.missing_ = true;
+                continue;
+            }
+
+            // Closer tiles are loaded first
+            tile.loading_ = true;
+            cache->BackgroundLoadResource<Image>(tile.heightMapName_, true, nullptr, -distance);
+            if (cache->GetExistingResource<Image>(tile.heightMapName_))
+            {
+                tile.loading_ = false;
+                tile.ready_ = true;
+            }
+        }
+    }
+
+    // Create geometry of the closest loaded tiles, it is too expensive to create all at once
+    ea::vector<ea::pair<float, IntVector2>> readyTiles;
+    for (const auto& [index, tile] : tiles_)
+    {
+        if (tile.ready_ && !tile.node_)
+            readyTiles.emplace_back(GetTileDistance(index, focusPosition), index);
+    }
+    ea::sort(readyTiles.begin(), readyTiles.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    for (unsigned i = 0; i < readyTiles.size() && i < maxTilesPerFrame_; ++i)
+    {
+        const IntVector2 index = readyTiles[i].second;
+        CreateTile(index, tiles_[index]);
+    }
+
+    for (auto& [index, tile] : tiles_)
+    {
+        if (tile.node_)
+            UpdateCollision(tile, collisionDistance_ > 0.0f && GetTileDistance(index, focusPosition) <= collisionDistance_);
+    }
+}
+
+Material* TerrainStreamer::GetMaterial() const
+{
+    return material_;
+}
+
+IntVector2 TerrainStreamer::GetTileIndex(const Vector3& worldPosition) const
+{
+    // Terrain is centered on its node, so tile centers are at multiples of the tile size
+    const Vector3 position = node_ ? node_->GetWorldTransform().Inverse() * worldPosition : worldPosition;
+    const Vector2 tileSize = GetTileSize();
+    return IntVector2(RoundToInt(position.x_ / tileSize.x_), RoundToInt(position.z_ / tileSize.y_));
+}
+
+Terrain* TerrainStreamer::GetTile(const IntVector2& index) const
+{
+    const auto iter = tiles_.find(index);
+    if (iter == tiles_.end() || !iter->second.node_)
+        return nullptr;
+    return iter->second.node_->GetComponent<Terrain>();
+}
+
+float TerrainStreamer::GetHeight(const Vector3& worldPosition) const
+{
+    Terrain* terrain = GetTile(GetTileIndex(worldPosition));
+    return terrain ? terrain->GetHeight(worldPosition) : 0.0f;
+}
+
+unsigned TerrainStreamer::GetNumLoadedTiles() const
+{
+    return static_cast<unsigned>(ea::count_if(tiles_.begin(), tiles_.end(),
+        [](const auto& item) { return item.second.node_ != nullptr; }));
+}
+
+unsigned TerrainStreamer::GetNumPendingTiles() const
+{
+    return static_cast<unsigned>(ea::count_if(tiles_.begin(), tiles_.end(),
+        [](const auto& item) { return item.second.loading_ || (item.second.ready_ && !item.second.node_); }));
+}
+
+void TerrainStreamer::SetMaterialAttr(const ResourceRef& value)
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+    SetMaterial(cache->GetResource<Material>(value.name_));
+}
+
+ResourceRef TerrainStreamer::GetMaterialAttr() const
+{
+    return GetResourceRef(material_, Material::GetTypeStatic());
+}
+
+void TerrainStreamer::OnSceneSet(Scene* scene)
+{
+    if (scene)
+    {
+        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(TerrainStreamer, HandleScenePostUpdate));
+        SubscribeToEvent(E_RESOURCEBACKGROUNDLOADED, URHO3D_HANDLER(TerrainStreamer, HandleResourceBackgroundLoaded));
+    }
+    else
+    {
+        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+        UnsubscribeFromEvent(E_RESOURCEBACKGROUNDLOADED);
+        UnloadTiles();
+    }
+}
+
+float TerrainStreamer::GetTileDistance(const IntVector2& index, const Vector3& position) const
+{
+    const Vector2 tileSize = GetTileSize();
+    const Vector2 center{index.x_ * tileSize.x_, index.y_ * tileSize.y_};
+    const Vector2 offset = (Vector2(position.x_, position.z_) - center).Abs() - tileSize * 0.5f;
+    return Vector2(Max(offset.x_, 0.0f), Max(offset.y_, 0.0f)).Length();
+}
+
+void TerrainStreamer::CreateTile(const IntVector2& index, TileState& tile)
+{
+    tile.ready_ = false;
+
+    auto cache = GetSubsystem<ResourceCache>();
+    auto* image = cache->GetExistingResource<Image>(tile.heightMapName_);
+    if (!image)
+        return;
+
+    if (image->GetWidth() != tileResolution_ + 1 || image->GetHeight() != tileResolution_ + 1)
+    {
+        URHO3D_LOGWARNING("Height map '{}' should be {} pixels wide to match terrain tile resolution",
+            tile.heightMapName_, tileResolution_ + 1);
+    }
+
+    const Vector2 tileSize = GetTileSize();
+    tile.node_ = node_->CreateTemporaryChild(Format("Tile_{}_{}", index.x_, index.y_));
+    tile.node_->SetPosition(Vector3(index.x_ * tileSize.x_, 0.0f, index.y_ * tileSize.y_));
+
+    auto* terrain = tile.node_->CreateComponent<Terrain>();
+    terrain->SetSpacing(spacing_);
+    terrain->SetPatchSize(patchSize_);
+    terrain->SetMaxLodLevels(maxLodLevels_);
+    terrain->SetMaterial(material_);
+    terrain->SetHeightMap(image);
+
+    UpdateNeighbors(index);
+}
+
+void TerrainStreamer::RemoveTile(const IntVector2& index)
+{
+    const auto iter = tiles_.find(index);
+    if (iter == tiles_.end())
+        return;
+
+    const ea::string heightMapName = iter->second.heightMapName_;
+    const bool hadNode = iter->second.node_ != nullptr;
+    if (hadNode)
+        iter->second.node_->Remove();
+    tiles_.erase(iter);
+
+    if (hadNode)
+        UpdateNeighbors(index);
+
+    // Height map is not needed anymore unless it is used by someone else
+    if (!heightMapName.empty())
+        GetSubsystem<ResourceCache>()->ReleaseResource<Image>(heightMapName);
+}
+
+void TerrainStreamer::UpdateNeighbors(const IntVector2& index)
+{
+    for (const IntVector2& tileIndex : {index, index + northOffset, index + southOffset, index + westOffset, index + eastOffset})
+    {
+        if (Terrain* terrain = GetTile(tileIndex))
+        {
+            terrain->SetNeighbors(GetTile(tileIndex + northOffset), GetTile(tileIndex + southOffset),
+                GetTile(tileIndex + westOffset), GetTile(tileIndex + eastOffset));
+        }
+    }
+}
+
+void TerrainStreamer::UpdateCollision(TileState& tile, bool enable)
+{
+#ifdef URHO3D_PHYSICS
+    auto* shape = tile.node_->GetComponent<CollisionShape>();
+    if (enable && !shape)
+    {
+        tile.node_->CreateComponent<RigidBody>();
+        tile.node_->CreateComponent<CollisionShape>()->SetTerrain();
+    }
+    else if (!enable && shape)
+    {
+        shape->Remove();
+        if (auto* body = tile.node_->GetComponent<RigidBody>())
+            body->Remove();
+    }
+#endif
+}
+
+void TerrainStreamer::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+{
+    UpdateTiles();
+}
+
+void TerrainStreamer::HandleResourceBackgroundLoaded(StringHash eventType, VariantMap& eventData)
+{
+    using namespace ResourceBackgroundLoaded;
+
+    const ea::string& name = eventData[P_RESOURCENAME].GetString();
+    const bool success = eventData[P_SUCCESS].GetBool();
+    for (auto& [index, tile] : tiles_)
+    {
+        if (tile.loading_ && tile.heightMapName_ == name)
+        {
+            tile.loading_ = false;
+            tile.ready_ = success;
+            tile.missing_ = !success;
+        }
+    }
+}
+
+}
@@ -0,0 +1,203 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Math/Vector3.h"
+#include "../Scene/Component.h"
+
+#include <EASTL/unordered_map.h>
+
+namespace Urho3D
+{
+
+class Material;
+class Terrain;
+
+/// Streams terrain tiles around the focus node. Each tile is a Terrain with its own height map,
+/// so only the height maps near the focus are kept in memory. Tiles near the focus may also get
+/// a heightfield collision shape if physics is enabled.
+class URHO3D_API TerrainStreamer : public Component
+{
+    URHO3D_OBJECT(TerrainStreamer, Component);
+
+public:
+    /// Construct.
+    explicit TerrainStreamer(Context* context);
+    /// Destruct.
+    ~TerrainStreamer() override;
+    /// Register object factory.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Set height map resource name pattern, {x} and {z} are replaced with tile indices.
+    /// @property
+    void SetHeightMapPattern(const ea::string& pattern);
+    /// Set material of all tiles.
+    /// @property
+    void SetMaterial(Material* material);
+    /// Set size of tile in vertex intervals. Height maps of tiles should be resolution + 1 pixels wide.
+    /// @property
+    void SetTileResolution(int resolution);
+    /// Set vertex spacing of tiles.
+    /// @property
+    void SetSpacing(const Vector3& spacing);
+    /// Set patch size of tiles.
+    /// @property
+    void SetPatchSize(int size);
+    /// Set max number of LOD levels of tiles.
+    /// @property
+    void SetMaxLodLevels(unsigned levels);
+    /// Set distance from the focus within which tiles are loaded.
+    /// @property
+    void SetLoadDistance(float distance) { loadDistance_ = Max(distance, 0.0f); }
+    /// Set distance from the focus beyond which tiles are unloaded. Should be greater than load distance.
+    /// @property
+    void SetUnloadDistance(float distance) { unloadDistance_ = Max(distance, 0.0f); }
+    /// Set distance from the focus within which tiles have collision shapes. Zero disables collision.
+    /// @property
+    void SetCollisionDistance(float distance) { collisionDistance_ = Max(distance, 0.0f); }
+    /// Set max number of tiles whose geometry is created in one frame.
+    /// @property
+    void SetMaxTilesPerFrame(unsigned count) { maxTilesPerFrame_ = Max(count, 1u); }
+    /// Set node around which tiles are streamed.
+    void SetFocusNode(Node* node) { focusNode_ = node; }
+    /// Unload all tiles.
+    void UnloadTiles();
+    /// Load and unload tiles around the focus node. Called automatically after the scene update.
+    void UpdateTiles();
+
+    /// Return height map resource name pattern.
+    /// @property
+    const ea::string& GetHeightMapPattern() const { return heightMapPattern_; }
+    /// Return material of all tiles.
+    /// @property
+    Material* GetMaterial() const;
+    /// Return size of tile in vertex intervals.
+    /// @property
+    int GetTileResolution() const { return tileResolution_; }
+    /// Return vertex spacing of tiles.
+    /// @property
+    const Vector3& GetSpacing() const { return spacing_; }
+    /// Return patch size of tiles.
+    /// @property
+    int GetPatchSize() const { return patchSize_; }
+    /// Return max number of LOD levels of tiles.
+    /// @property
+    unsigned GetMaxLodLevels() const { return maxLodLevels_; }
+    /// Return distance from the focus within which tiles are loaded.
+    /// @property
+    float GetLoadDistance() const { return loadDistance_; }
+    /// Return distance from the focus beyond which tiles are unloaded.
+    /// @property
+    float GetUnloadDistance() const { return unloadDistance_; }
+    /// Return distance from the focus within which tiles have collision shapes.
+    /// @property
+    float GetCollisionDistance() const { return collisionDistance_; }
+    /// Return max number of tiles whose geometry is created in one frame.
+    /// @property
+    unsigned GetMaxTilesPerFrame() const { return maxTilesPerFrame_; }
+    /// Return node around which tiles are streamed.
+    Node* GetFocusNode() const { return focusNode_; }
+
+    /// Return tile index containing position in world space.
+    IntVector2 GetTileIndex(const Vector3& worldPosition) const;
+    /// Return loaded tile by index.
+    Terrain* GetTile(const IntVector2& index) const;
+    /// Return height at world position, zero if the tile is not loaded.
+    float GetHeight(const Vector3& worldPosition) const;
+    /// Return number of tiles with created geometry.
+    /// @property
+    unsigned GetNumLoadedTiles() const;
+    /// Return number of tiles being loaded.
+    /// @property
+    unsigned GetNumPendingTiles() const;
+
+    /// Set material attribute.
+    void SetMaterialAttr(const ResourceRef& value);
+    /// Return material attribute.
+    ResourceRef GetMaterialAttr() const;
+
+protected:
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+
+private:
+    struct TileState
+    {
+        /// Height map resource name.
+        ea::string heightMapName_;
+        /// Node with Terrain, null until geometry is created.
+        SharedPtr<Node> node_;
+        /// Whether the height map is being loaded.
+        bool loading_{};
+        /// Whether the height map is loaded and geometry may be created.
+        bool ready_{};
+        /// Whether the height map does not exist.
+        bool missing_{};
+    };
+
+    /// Return tile world size in streamer space.
+    Vector2 GetTileSize() const { return Vector2(tileResolution_ * spacing_.x_, tileResolution_ * spacing_.z_); }
+    /// Return distance from position in streamer space to tile center.
+    float GetTileDistance(const IntVector2& index, const Vector3& position) const;
+    /// Create tile geometry from loaded height map.
+    void CreateTile(const IntVector2& index, TileState& tile);
+    /// Remove tile and release its height map.
+    void RemoveTile(const IntVector2& index);
+    /// Connect tile with neighbor tiles.
+    void UpdateNeighbors(const IntVector2& index);
+    /// Add or remove collision shape of the tile.
+    void UpdateCollision(TileState& tile, bool enable);
+    /// Handle scene post-update.
+    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+    /// Handle background loaded height map.
+    void HandleResourceBackgroundLoaded(StringHash eventType, VariantMap& eventData);
+
+    /// Height map resource name pattern.
+    ea::string heightMapPattern_;
+    /// Material of all tiles.
+    SharedPtr<Material> material_;
+    /// Size of tile in vertex intervals.
+    int tileResolution_{256};
+    /// Vertex spacing.
+    Vector3 spacing_{1.0f, 0.25f, 1.0f};
+    /// Patch size.
+    int patchSize_{32};
+    /// Max number of LOD levels.
+    unsigned maxLodLevels_{4};
+    /// Load distance.
+    float loadDistance_{512.0f};
+    /// Unload distance.
+    float unloadDistance_{768.0f};
+    /// Collision distance.
+    float collisionDistance_{};
+    /// Max number of tiles created in one frame.
+    unsigned maxTilesPerFrame_{1};
+    /// Focus node.
+    WeakPtr<Node> focusNode_;
+    /// Tiles by index.
+    ea::unordered_map<IntVector2, TileState> tiles_;
+};
+
+}
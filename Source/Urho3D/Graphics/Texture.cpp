@@ -358,16 +358,17 @@ bool Texture::GetSRGB() const
     return IsTextureFormatSRGB(GetParams().format_);
 }
 
-bool Texture::CreateForImage(const RawTextureParams& baseParams, Image* image)
+RawTextureParams Texture::GetParamsForImage(
+    const RawTextureParams& baseParams, Image* image, unsigned& mostDetailedLevel) const
 {
     auto renderDevice = GetSubsystem<RenderDevice>();
     auto renderer = GetSubsystem<Renderer>();
 
     const MaterialQuality quality = renderer ? renderer->GetTextureQuality() : QUALITY_HIGH;
-    const auto [mostDetailedLevel, numLevels] =
-        GetLevelsOffsetAndCount(*image, baseParams.numLevels_, GetMipsToSkip(quality));
+    const auto [offset, numLevels] =
+        GetLevelsOffsetAndCount(*image, baseParams.numLevels_, ea::max<unsigned>(GetMipsToSkip(quality), streamedMipsToSkip_));
 
-    mostDetailedLevel_ = mostDetailedLevel;
+    mostDetailedLevel = offset;
 
     RawTextureParams params = baseParams;
     params.size_ = GetMipLevelSize(image->GetSize(), mostDetailedLevel);
@@ -375,26 +376,97 @@ bool Texture::CreateForImage(const RawTextureParams& baseParams, Image* image)
     params.format_ = ToHardwareFormat(image->GetGPUFormat(), renderDevice);
     if (requestedSRGB_)
         params.format_ = SetTextureFormatSRGB(params.format_);
+    return params;
+}
+
+bool Texture::CreateForImage(const RawTextureParams& baseParams, Image* image)
+{
+    const RawTextureParams params = GetParamsForImage(baseParams, image, mostDetailedLevel_);
     return Create(params);
 }
 
-bool Texture::UpdateFromImage(unsigned arraySlice, Image* image)
+bool Texture::CreateStagingForImage(const RawTextureParams& baseParams, Image* image)
+{
+    unsigned mostDetailedLevel{};
+    const RawTextureParams params = GetParamsForImage(baseParams, image, mostDetailedLevel);
+    const TextureFormat imageFormat = image->GetGPUFormat();
+
+    // Keep temporary images alive until the texture is created
+    ea::vector<SharedPtr<Image>> levelHolders;
+    ea::vector<const void*> levelData;
+    if (!image->IsCompressed() && (SetTextureFormatSRGB(params.format_, false) == imageFormat))
+    {
+        SharedPtr<Image> currentLevel{image};
+        for (unsigned level = 0; level < mostDetailedLevel; ++level)
+            currentLevel = currentLevel->GetNextLevel();
+
+        for (unsigned level = 0; level < params.numLevels_; ++level)
+        {
+            levelData.push_back(currentLevel->GetData());
+            levelHolders.push_back(currentLevel);
+            currentLevel = currentLevel->GetNextLevel();
+        }
+    }
+    else if (SetTextureFormatSRGB(params.format_, false) == TextureFormat::TEX_FORMAT_RGBA8_UNORM)
+    {
+        URHO3D_LOGWARNING("Image '{}' is converted to RGBA8 format on upload to GPU", GetName());
+
+        for (unsigned level = 0; level < params.numLevels_; ++level)
+        {
+            const auto decompressedLevel = image->GetDecompressedImageLevel(mostDetailedLevel + level);
+            if (!decompressedLevel)
+                return false;
+
+            levelData.push_back(decompressedLevel->GetData());
+            levelHolders.push_back(decompressedLevel);
+        }
+    }
+    else
+    {
+        URHO3D_ASSERT(image->IsCompressed());
+
+        for (unsigned level = 0; level < params.numLevels_; ++level)
+            levelData.push_back(image->GetCompressedLevel(mostDetailedLevel + level).data_);
+    }
+
+    auto stagingTexture = ea::make_unique<RawTexture>(context_, params, levelData);
+    if (!stagingTexture->GetHandles())
+        return false;
+
+    stagingTexture_ = ea::move(stagingTexture);
+    stagingMostDetailedLevel_ = mostDetailedLevel;
+    return true;
+}
+
+bool Texture::ApplyStagingTexture()
+{
+    if (!stagingTexture_)
+        return false;
+
+    mostDetailedLevel_ = stagingMostDetailedLevel_;
+    AdoptGPU(*stagingTexture_);
+    stagingTexture_ = nullptr;
+    return true;
+}
+
+bool Texture::UpdateFromImage(unsigned arraySlice, Image* image, unsigned firstLevel, unsigned numLevels)
 {
     const TextureFormat internalFormat = GetFormat();
     const TextureFormat imageFormat = image->GetGPUFormat();
+    const unsigned endLevel = ea::min(GetLevels(), firstLevel + ea::min(numLevels, GetLevels()));
 
     if (!image->IsCompressed() && (SetTextureFormatSRGB(internalFormat, false) == imageFormat))
     {
         // If not compressed and not converted, upload image data as is
         const Image* currentLevel = image;
         SharedPtr<Image> currentLevelHolder;
-        for (unsigned level = 0; level < mostDetailedLevel_; ++level)
+        for (unsigned level = 0; level < mostDetailedLevel_ + firstLevel; ++level)
         {
             currentLevelHolder = currentLevel->GetNextLevel();
             currentLevel = currentLevelHolder;
         }
 
-        for (unsigned level = 0; level < GetLevels(); ++level)
+        for (unsigned level = firstLevel; level < endLevel; ++level)
         {
             Update(level, IntVector3::ZERO, currentLevel->GetSize(), arraySlice, currentLevel->GetData());
             currentLevelHolder = currentLevel->GetNextLevel();
@@ -406,7 +478,7 @@ bool Texture::UpdateFromImage(unsigned arraySlice, Image* image)
         // RGBA8 is default format, use it if hardware format is not available.
         URHO3D_LOGWARNING("Image '{}' is converted to RGBA8 format on upload to GPU", GetName());
 
-        for (unsigned level = 0; level < GetLevels(); ++level)
+        for (unsigned level = firstLevel; level < endLevel; ++level)
         {
             const auto decompressedLevel = image->GetDecompressedImageLevel(mostDetailedLevel_ + level);
             if (!decompressedLevel)
@@ -420,7 +492,7 @@ bool Texture::UpdateFromImage(unsigned arraySlice, Image* image)
         URHO3D_ASSERT(image->IsCompressed());
 
         // Upload compressed image data as is
-        for (unsigned level = 0; level < GetLevels(); ++level)
+        for (unsigned level = firstLevel; level < endLevel; ++level)
         {
             const CompressedLevel imageLevel = image->GetCompressedLevel(mostDetailedLevel_ + level);
             const IntVector3 levelSize{imageLevel.width_, imageLevel.height_, imageLevel.depth_};
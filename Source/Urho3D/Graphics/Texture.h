@@ -33,6 +33,8 @@
 #include <Diligent/Graphics/GraphicsEngine/interface/Texture.h>
 #include <Diligent/Graphics/GraphicsEngine/interface/TextureView.h>
 
+#include <EASTL/unique_ptr.h>
+
 namespace Urho3D
 {
 
@@ -167,6 +169,8 @@ public:
     /// Return mip levels to skip on a quality setting when loading.
     /// @property
     int GetMipsToSkip(MaterialQuality quality) const;
+    /// Return most detailed mip level of the source image used by the texture.
+    unsigned GetMostDetailedLevel() const { return mostDetailedLevel_; }
     /// Return mip level width, or 0 if level does not exist.
     /// @property
     int GetLevelWidth(unsigned level) const;
@@ -216,8 +220,15 @@ protected:
     /// Create texture so it can fit the image.
     /// Size and format are deduced from the image. Number of mips is adjusted according to the image.
     bool CreateForImage(const RawTextureParams& baseParams, Image* image);
-    /// Set texture data from image.
-    bool UpdateFromImage(unsigned arraySlice, Image* image);
+    /// Create staging texture that fits the image and contains all its data, same as CreateForImage() and
+    /// UpdateFromImage() would do. Safe to call from worker thread if RenderDeviceCaps::threadedResourceCreation_ is set.
+    bool CreateStagingForImage(const RawTextureParams& baseParams, Image* image);
+    /// Replace GPU texture with the staging texture, if any. Return true if applied. Should be called from main thread.
+    bool ApplyStagingTexture();
+    /// Return whether the staging texture is waiting to be applied.
+    bool HasStagingTexture() const { return stagingTexture_ != nullptr; }
+    /// Set texture data from image. Optionally update only the range of mip levels.
+    bool UpdateFromImage(unsigned arraySlice, Image* image, unsigned firstLevel = 0, unsigned numLevels = M_MAX_UNSIGNED);
     /// Read texture data to image.
     bool ReadToImage(unsigned arraySlice, unsigned level, Image* image);
 
@@ -239,6 +250,17 @@ protected:
     ea::vector<SharedPtr<RenderSurface>> renderSurfaces_;
     /// Most detailed mip level currently used.
     unsigned mostDetailedLevel_{};
+    /// Mip levels to skip requested by texture streaming, applied on top of quality setting.
+    unsigned streamedMipsToSkip_{};
+
+private:
+    /// Return texture parameters and most detailed level used to fit the image.
+    RawTextureParams GetParamsForImage(const RawTextureParams& baseParams, Image* image, unsigned& mostDetailedLevel) const;
+
+    /// Texture created in worker thread, applied in main thread.
+    ea::unique_ptr<RawTexture> stagingTexture_;
+    /// Most detailed mip level of the staging texture.
+    unsigned stagingMostDetailedLevel_{};
 };
 
 }
@@ -28,11 +28,13 @@
 #include "../Graphics/GraphicsEvents.h"
 #include "../Graphics/Renderer.h"
 #include "../Graphics/Texture2D.h"
+#include "../Graphics/TextureResidencyManager.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/XMLFile.h"
 #include "Urho3D/RenderAPI/RenderAPIUtils.h"
+#include "Urho3D/RenderAPI/RenderDevice.h"
 
 #include "../DebugNew.h"
 
@@ -61,11 +63,30 @@ bool Texture2D::BeginLoad(Deserializer& source)
     if (!graphics)
         return true;
 
-    // Load the image data for EndLoad()
+    // Load the optional parameters file first, it affects decoding
+    auto* cache = GetSubsystem<ResourceCache>();
+    ea::string xmlName = ReplaceExtension(GetName(), ".xml");
+    loadParameters_ = cache->GetTempResource<XMLFile>(xmlName, false);
+
+    premultipliedAlpha_ = false;
+    bool sRGB = GetSRGB();
+    if (loadParameters_)
+    {
+        const XMLElement rootElem = loadParameters_->GetRoot();
+        if (const XMLElement premultipliedElem = rootElem.GetChild("premultipliedalpha"))
+            premultipliedAlpha_ = premultipliedElem.GetBool("enable");
+        if (const XMLElement srgbElem = rootElem.GetChild("srgb"))
+            sRGB = srgbElem.GetBool("enable");
+    }
+
+    // Load the image data for EndLoad(). Decode directly into the format uploaded to GPU
     loadImage_ = MakeShared<Image>(context_);
+    loadImage_->SetDecodeToRGBA(true);
+    loadImage_->SetDecodePremultipliedAlpha(premultipliedAlpha_, sRGB);
     if (!loadImage_->Load(source))
     {
         loadImage_.Reset();
+        loadParameters_.Reset();
         return false;
     }
 
@@ -73,11 +94,24 @@ bool Texture2D::BeginLoad(Deserializer& source)
     if (GetAsyncLoadState() == ASYNC_LOADING)
         loadImage_->PrecalculateLevels();
 
-    // Load the optional parameters file
-    auto* cache = GetSubsystem<ResourceCache>();
-    ea::string xmlName = ReplaceExtension(GetName(), ".xml");
-    loadParameters_ = cache->GetTempResource<XMLFile>(xmlName, false);
+    return true;
+}
 
+bool Texture2D::EndLoadInWorkerThread()
+{
+    if (!renderDevice_ || !renderDevice_->GetCaps().threadedResourceCreation_ || !loadImage_)
+        return true;
+
+    // Parameters file changes sampler and metadata that may be used by the main thread right now
+    if (loadParameters_)
+        return true;
+
+    // Texture is swapped in EndLoad(), so it's fine to fall back to the main thread upload on failure
+    RawTextureParams params;
+    params.type_ = TextureType::Texture2D;
+    params.numLevels_ = requestedLevels_;
+    if (CreateStagingForImage(params, loadImage_))
+        loadImage_.Reset();
     return true;
 }
 
@@ -91,14 +125,103 @@ bool Texture2D::EndLoad()
     CheckTextureBudget(GetTypeStatic());
 
     SetParameters(loadParameters_);
-    bool success = SetData(loadImage_);
+    bool success = ApplyStagingTexture() || SetData(loadImage_);
 
     loadImage_.Reset();
     loadParameters_.Reset();
 
+    if (success)
+    {
+        if (auto textureResidencyManager = GetSubsystem<TextureResidencyManager>())
+            textureResidencyManager->AddTexture(this);
+    }
+
     return success;
 }
 
+EndLoadStatus Texture2D::EndLoadPartial(unsigned long long& uploadBudget)
+{
+    // In headless mode, do not actually load the texture, just return success
+    if (!renderDevice_)
+    {
+        loadImage_.Reset();
+        loadParameters_.Reset();
+        return EndLoadStatus::Finished;
+    }
+
+    if (HasStagingTexture())
+    {
+        CheckTextureBudget(GetTypeStatic());
+        ApplyStagingTexture();
+
+        loadParameters_.Reset();
+        if (auto textureResidencyManager = GetSubsystem<TextureResidencyManager>())
+            textureResidencyManager->AddTexture(this);
+        return EndLoadStatus::Finished;
+    }
+
+    if (!loadImage_)
+        return EndLoadStatus::Failed;
+
+    if (loadLevel_ == 0)
+    {
+        CheckTextureBudget(GetTypeStatic());
+        SetParameters(loadParameters_);
+
+        RawTextureParams params;
+        params.type_ = TextureType::Texture2D;
+        params.numLevels_ = requestedLevels_;
+        if (!CreateForImage(params, loadImage_))
+        {
+            loadImage_.Reset();
+            loadParameters_.Reset();
+            return EndLoadStatus::Failed;
+        }
+    }
+
+    // Upload at least one mip level per call
+    const unsigned numLevels = GetLevels();
+    unsigned endLevel = loadLevel_;
+    do
+    {
+        const unsigned levelSize = GetDataSize(GetLevelWidth(endLevel), GetLevelHeight(endLevel));
+        uploadBudget -= ea::min<unsigned long long>(uploadBudget, levelSize);
+        ++endLevel;
+    } while (endLevel < numLevels && uploadBudget > 0);
+
+    const bool success = UpdateFromImage(0, loadImage_, loadLevel_, endLevel - loadLevel_);
+    loadLevel_ = endLevel;
+    if (success && loadLevel_ < numLevels)
+        return EndLoadStatus::Pending;
+
+    loadImage_.Reset();
+    loadParameters_.Reset();
+    loadLevel_ = 0;
+
+    if (success)
+    {
+        if (auto textureResidencyManager = GetSubsystem<TextureResidencyManager>())
+            textureResidencyManager->AddTexture(this);
+    }
+
+    return success ? EndLoadStatus::Finished : EndLoadStatus::Failed;
+}
+
+unsigned long long Texture2D::GetEndLoadUploadSize() const
+{
+    if (!loadImage_)
+        return 0;
+
+    // Texture is not created yet, estimate by image size
+    if (loadLevel_ == 0)
+        return loadImage_->GetMemoryUse();
+
+    unsigned long long result = 0;
+    for (unsigned level = loadLevel_; level < GetLevels(); ++level)
+        result += GetDataSize(GetLevelWidth(level), GetLevelHeight(level));
+    return result;
+}
+
 bool Texture2D::SetSize(int width, int height, TextureFormat format, TextureFlags flags, int multiSample)
 {
     RawTextureParams params;
@@ -131,6 +254,19 @@ bool Texture2D::SetData(Image* image)
     return UpdateFromImage(0, image);
 }
 
+bool Texture2D::SetStreamedData(Image* image, unsigned mipsToSkip)
+{
+    streamedMipsToSkip_ = mipsToSkip;
+    return SetData(image);
+}
+
+void Texture2D::ReportScreenSize(unsigned size)
+{
+    unsigned oldSize = screenSize_.load(std::memory_order_relaxed);
+    while (oldSize < size && !screenSize_.compare_exchange_weak(oldSize, size, std::memory_order_relaxed))
+        ;
+}
+
 bool Texture2D::GetData(unsigned level, void* dest)
 {
     return Read(0, level, dest, M_MAX_UNSIGNED);
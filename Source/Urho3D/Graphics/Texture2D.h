@@ -26,6 +26,8 @@
 #include "../Graphics/RenderSurface.h"
 #include "../Graphics/Texture.h"
 
+#include <atomic>
+
 namespace Urho3D
 {
 
@@ -48,8 +50,14 @@ public:
 
     /// Load resource from stream. May be called from a worker thread. Return true if successful.
     bool BeginLoad(Deserializer& source) override;
+    /// Create GPU texture with image data in the worker thread if supported by the render device.
+    bool EndLoadInWorkerThread() override;
     /// Finish resource loading. Always called from the main thread. Return true if successful.
     bool EndLoad() override;
+    /// Finish resource loading one mip level at a time. Always called from the main thread.
+    EndLoadStatus EndLoadPartial(unsigned long long& uploadBudget) override;
+    /// Return approximate amount of image data not uploaded to GPU yet.
+    unsigned long long GetEndLoadUploadSize() const override;
 
     /// Set size, format, usage and multisampling parameters for rendertargets. Zero size will follow application window size. Return true if successful.
     /** Autoresolve true means the multisampled texture will be automatically resolved to 1-sample after being rendered to and before being sampled as a texture.
@@ -61,6 +69,19 @@ public:
     /// Set data from an image. Return true if successful. Optionally make a single channel image alpha-only.
     bool SetData(Image* image);
 
+    /// Set data from an image skipping given number of most detailed mip levels. Used by texture streaming.
+    bool SetStreamedData(Image* image, unsigned mipsToSkip);
+    /// Set number of mip levels skipped by texture streaming without reloading the texture.
+    void SetStreamedMipsToSkip(unsigned mipsToSkip) { streamedMipsToSkip_ = mipsToSkip; }
+    /// Return number of mip levels skipped by texture streaming.
+    unsigned GetStreamedMipsToSkip() const { return streamedMipsToSkip_; }
+    /// Report size of the texture on the screen in pixels. Thread-safe.
+    void ReportScreenSize(unsigned size);
+    /// Return max size on the screen reported since the last call and reset it.
+    unsigned ConsumeScreenSize() { return screenSize_.exchange(0, std::memory_order_relaxed); }
+    /// Return whether color was multiplied by alpha on load, as requested by "premultipliedalpha" in parameters file.
+    bool IsPremultipliedAlpha() const { return premultipliedAlpha_; }
+
     /// Get data from a mip level. The destination buffer must be big enough. Return true if successful.
     bool GetData(unsigned level, void* dest);
     /// Get image data from zero mip level. Only RGB and RGBA textures are supported.
@@ -73,6 +94,12 @@ private:
     SharedPtr<Image> loadImage_;
     /// Parameter file acquired during BeginLoad.
     SharedPtr<XMLFile> loadParameters_;
+    /// Next mip level to be uploaded by EndLoadPartial.
+    unsigned loadLevel_{};
+    /// Whether color was multiplied by alpha on load.
+    bool premultipliedAlpha_{};
+    /// Max size on the screen reported since the last update of texture streaming.
+    std::atomic<unsigned> screenSize_{};
 };
 
 }
@@ -0,0 +1,287 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Graphics/TextureResidencyManager.h"
+
+#include "../Core/CoreEvents.h"
+#include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/Renderer.h"
+#include "../Graphics/Texture2D.h"
+#include "../IO/Log.h"
+#include "../Resource/Image.h"
+#include "../Resource/ResourceCache.h"
+
+#include <EASTL/sort.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+unsigned GetFullSize(const Texture2D* texture)
+{
+    return static_cast<unsigned>(ea::max(texture->GetWidth(), texture->GetHeight())) << texture->GetMostDetailedLevel();
+}
+
+/// Estimate memory use of the texture if it was created with given number of skipped levels.
+unsigned long long EstimateMemoryUse(const Texture2D* texture, unsigned mipsToSkip)
+{
+    const unsigned long long memoryUse = texture->GetMemoryUse();
+    const unsigned currentLevel = texture->GetMostDetailedLevel();
+    if (mipsToSkip <= currentLevel)
+        return memoryUse << (2 * (currentLevel - mipsToSkip));
+    return memoryUse >> (2 * (mipsToSkip - currentLevel));
+}
+
+}
+
+TextureResidencyManager::TextureResidencyManager(Context* context)
+    : Object(context)
+{
+    SubscribeToEvent(E_ENDFRAME, &TextureResidencyManager::Update);
+}
+
+TextureResidencyManager::~TextureResidencyManager() = default;
+
+void TextureResidencyManager::AddTexture(Texture2D* texture)
+{
+    if (!texture || texture->GetName().empty() || texture->IsRenderTarget() || texture->IsDepthStencil())
+        return;
+
+    TextureState& state = textures_[texture];
+    if (!state.texture_)
+    {
+        state = TextureState{};
+        state.texture_ = texture;
+        state.screenSizeFrame_ = frameNumber_;
+    }
+    state.targetMipsToSkip_ = texture->GetMostDetailedLevel();
+    texture->SetStreamedMipsToSkip(state.targetMipsToSkip_);
+}
+
+void TextureResidencyManager::ReportMaterialUsage(Material* material, float screenSize)
+{
+    const auto size = static_cast<unsigned>(ea::max(0.0f, ea::min(screenSize, static_cast<float>(M_MAX_INT))));
+    for (const auto& item : material->GetTextures())
+    {
+        Texture* texture = item.second.value_;
+        if (texture && texture->GetType() == Texture2D::GetTypeStatic())
+            static_cast<Texture2D*>(texture)->ReportScreenSize(size);
+    }
+}
+
+void TextureResidencyManager::Update()
+{
+    URHO3D_PROFILE("UpdateTextureResidency");
+
+    ++frameNumber_;
+    memoryUse_ = 0;
+
+    FrameVector<TextureState*> states;
+    for (auto iter = textures_.begin(); iter != textures_.end();)
+    {
+        TextureState& state = iter->second;
+        Texture2D* texture = state.texture_;
+        if (!texture)
+        {
+            iter = textures_.erase(iter);
+            continue;
+        }
+
+        // Keep the largest recent size for a while to avoid reloading textures back and forth
+        const unsigned screenSize = texture->ConsumeScreenSize();
+        if (screenSize >= state.screenSize_ || frameNumber_ - state.screenSizeFrame_ > streamOutDelay_)
+        {
+            state.screenSize_ = screenSize;
+            state.screenSizeFrame_ = frameNumber_;
+        }
+
+        if (!state.isLoading_)
+            state.targetMipsToSkip_ = GetDesiredMipsToSkip(texture, state.screenSize_);
+
+        memoryUse_ += texture->GetMemoryUse();
+        states.push_back(&state);
+        ++iter;
+    }
+
+    ApplyMemoryBudget(states);
+
+    // Stream out first because it frees memory, then stream in the largest textures on the screen
+    const auto isStreamOut = [](const TextureState* state)
+    { return state->targetMipsToSkip_ > state->texture_->GetStreamedMipsToSkip(); };
+    ea::sort(states.begin(), states.end(),
+        [&](const TextureState* lhs, const TextureState* rhs)
+    {
+        const bool lhsStreamOut = isStreamOut(lhs);
+        const bool rhsStreamOut = isStreamOut(rhs);
+        if (lhsStreamOut != rhsStreamOut)
+            return lhsStreamOut;
+        return lhs->screenSize_ > rhs->screenSize_;
+    });
+
+    for (TextureState* state : states)
+    {
+        if (numPendingLoads_ >= maxPendingLoads_)
+            break;
+
+        if (!state->isLoading_ && state->targetMipsToSkip_ != state->texture_->GetStreamedMipsToSkip())
+            QueueLoad(*state);
+    }
+}
+
+unsigned TextureResidencyManager::GetDesiredMipsToSkip(const Texture2D* texture, unsigned screenSize) const
+{
+    const unsigned maxMipsToSkip = GetMaxMipsToSkip(texture);
+    if (screenSize == 0)
+        return maxMipsToSkip;
+
+    const unsigned fullSize = GetFullSize(texture);
+    const float requiredSize = screenSize * texelDensity_;
+
+    unsigned mipsToSkip = 0;
+    while (mipsToSkip < maxMipsToSkip && static_cast<float>(fullSize >> (mipsToSkip + 1)) >= requiredSize)
+        ++mipsToSkip;
+
+    auto renderer = GetSubsystem<Renderer>();
+    const MaterialQuality quality = renderer ? renderer->GetTextureQuality() : QUALITY_HIGH;
+    const auto qualityMipsToSkip = static_cast<unsigned>(texture->GetMipsToSkip(quality));
+    return ea::max(mipsToSkip, ea::min(qualityMipsToSkip, maxMipsToSkip));
+}
+
+unsigned TextureResidencyManager::GetMaxMipsToSkip(const Texture2D* texture) const
+{
+    const unsigned fullSize = GetFullSize(texture);
+    const unsigned numLevels = texture->GetMostDetailedLevel() + texture->GetLevels();
+
+    unsigned mipsToSkip = 0;
+    while (mipsToSkip + 1 < numLevels && (fullSize >> (mipsToSkip + 1)) >= minResidentSize_)
+        ++mipsToSkip;
+    return mipsToSkip;
+}
+
+void TextureResidencyManager::ApplyMemoryBudget(FrameVector<TextureState*>& states)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+    const unsigned long long budget = cache->GetMemoryBudget(Texture2D::GetTypeStatic());
+    if (budget == 0)
+        return;
+
+    // Textures that are not managed use the budget too
+    const unsigned long long totalMemoryUse = cache->GetMemoryUse(Texture2D::GetTypeStatic());
+    const unsigned long long otherMemoryUse = totalMemoryUse - ea::min(totalMemoryUse, memoryUse_);
+    const unsigned long long availableMemory = budget - ea::min(budget, otherMemoryUse);
+
+    unsigned long long targetMemoryUse = 0;
+    for (const TextureState* state : states)
+        targetMemoryUse += EstimateMemoryUse(state->texture_, state->targetMipsToSkip_);
+
+    // Degrade textures one level at a time, the smallest on the screen go first
+    ea::sort(states.begin(), states.end(),
+        [](const TextureState* lhs, const TextureState* rhs) { return lhs->screenSize_ < rhs->screenSize_; });
+
+    bool changed = true;
+    while (targetMemoryUse > availableMemory && changed)
+    {
+        changed = false;
+        for (TextureState* state : states)
+        {
+            if (targetMemoryUse <= availableMemory)
+                break;
+
+            const Texture2D* texture = state->texture_;
+            if (state->isLoading_ || state->targetMipsToSkip_ >= GetMaxMipsToSkip(texture))
+                continue;
+
+            const unsigned long long oldMemoryUse = EstimateMemoryUse(texture, state->targetMipsToSkip_);
+            ++state->targetMipsToSkip_;
+            const unsigned long long newMemoryUse = EstimateMemoryUse(texture, state->targetMipsToSkip_);
+            targetMemoryUse -= ea::min(targetMemoryUse, oldMemoryUse - newMemoryUse);
+            changed = true;
+        }
+    }
+}
+
+void TextureResidencyManager::QueueLoad(TextureState& state)
+{
+    state.isLoading_ = true;
+    ++numPendingLoads_;
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    Context* context = context_;
+    const ea::string fileName = state.texture_->GetName();
+    const unsigned mipsToSkip = state.targetMipsToSkip_;
+    const bool premultipliedAlpha = state.texture_->IsPremultipliedAlpha();
+    const bool sRGB = state.texture_->GetSRGB();
+    const WeakPtr<TextureResidencyManager> weakSelf{this};
+    const WeakPtr<Texture2D> weakTexture = state.texture_;
+
+    // Image is decoded in the worker thread, only upload is performed in the main thread
+    workQueue->PostTask([=]()
+    {
+        auto cache = context->GetSubsystem<ResourceCache>();
+        SharedPtr<Image> image;
+        if (AbstractFilePtr file = cache->GetFile(fileName, false))
+        {
+            image = MakeShared<Image>(context);
+            image->SetDecodeToRGBA(true);
+            image->SetDecodePremultipliedAlpha(premultipliedAlpha, sRGB);
+            if (image->Load(*file))
+                image->PrecalculateLevels();
+            else
+                image = nullptr;
+        }
+
+        workQueue->PostTaskForMainThread([=]()
+        {
+            if (weakSelf)
+                weakSelf->FinishLoad(weakTexture, image, mipsToSkip);
+        });
+    });
+}
+
+void TextureResidencyManager::FinishLoad(Texture2D* texture, Image* image, unsigned mipsToSkip)
+{
+    --numPendingLoads_;
+
+    const auto iter = texture ? textures_.find(texture) : textures_.end();
+    if (iter == textures_.end())
+        return;
+
+    TextureState& state = iter->second;
+    state.isLoading_ = false;
+
+    // Remember streamed level even on failure so the texture is not reloaded every frame
+    if (!image || !texture->SetStreamedData(image, mipsToSkip))
+    {
+        URHO3D_LOGWARNING("Cannot stream mip levels of texture '{}'", texture->GetName());
+        texture->SetStreamedMipsToSkip(mipsToSkip);
+    }
+}
+
+}
@@ -0,0 +1,123 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Core/FrameAllocator.h"
+#include "../Core/Object.h"
+
+#include <EASTL/unordered_map.h>
+
+namespace Urho3D
+{
+
+class Image;
+class Material;
+class Texture2D;
+
+/// Streams mip levels of 2D textures in and out according to their size on the screen.
+/// Render pipeline reports materials of visible drawables, textures that are small on the screen or not visible
+/// are reloaded with less detailed levels. Total memory of textures is kept under the memory budget
+/// of Texture2D in ResourceCache, if set: textures with the smallest size on the screen are degraded first.
+class URHO3D_API TextureResidencyManager : public Object
+{
+    URHO3D_OBJECT(TextureResidencyManager, Object);
+
+public:
+    /// Default number of textures that may be reloaded at once.
+    static const unsigned DefaultMaxPendingLoads = 4;
+    /// Default size of the texture that is always resident.
+    static const unsigned DefaultMinResidentSize = 64;
+    /// Default number of frames to wait before streaming out the texture that became smaller on the screen.
+    static const unsigned DefaultStreamOutDelay = 60;
+
+    explicit TextureResidencyManager(Context* context);
+    ~TextureResidencyManager() override;
+
+    /// Start managing texture. Texture should be loaded from file so it can be reloaded.
+    void AddTexture(Texture2D* texture);
+    /// Report that the material is rendered with given size on the screen in pixels. Thread-safe.
+    void ReportMaterialUsage(Material* material, float screenSize);
+    /// Choose mip levels for all textures and queue reloads. Called automatically at the end of the frame.
+    void Update();
+
+    /// Set max number of textures that may be reloaded at once.
+    void SetMaxPendingLoads(unsigned count) { maxPendingLoads_ = ea::max(count, 1u); }
+    /// Return max number of textures that may be reloaded at once.
+    unsigned GetMaxPendingLoads() const { return maxPendingLoads_; }
+    /// Set size in pixels below which textures are never streamed out.
+    void SetMinResidentSize(unsigned size) { minResidentSize_ = ea::max(size, 1u); }
+    /// Return size in pixels below which textures are never streamed out.
+    unsigned GetMinResidentSize() const { return minResidentSize_; }
+    /// Set number of frames to wait before streaming out the texture that became smaller on the screen.
+    void SetStreamOutDelay(unsigned frames) { streamOutDelay_ = frames; }
+    /// Return number of frames to wait before streaming out the texture that became smaller on the screen.
+    unsigned GetStreamOutDelay() const { return streamOutDelay_; }
+    /// Set texels per screen pixel required for the texture to be considered detailed enough.
+    void SetTexelDensity(float density) { texelDensity_ = ea::max(density, M_EPSILON); }
+    /// Return texels per screen pixel required for the texture to be considered detailed enough.
+    float GetTexelDensity() const { return texelDensity_; }
+
+    /// Return number of managed textures.
+    unsigned GetNumTextures() const { return textures_.size(); }
+    /// Return number of textures being reloaded.
+    unsigned GetNumPendingLoads() const { return numPendingLoads_; }
+    /// Return total memory used by managed textures.
+    unsigned long long GetMemoryUse() const { return memoryUse_; }
+
+private:
+    struct TextureState
+    {
+        WeakPtr<Texture2D> texture_;
+        /// Max size on the screen in pixels recently reported.
+        unsigned screenSize_{};
+        /// Frame when the screen size was last increased or reset.
+        unsigned screenSizeFrame_{};
+        /// Number of skipped mip levels requested for the texture.
+        unsigned targetMipsToSkip_{};
+        /// Whether the texture is being reloaded now.
+        bool isLoading_{};
+    };
+
+    /// Return number of skipped mip levels needed for texture of given size on the screen.
+    unsigned GetDesiredMipsToSkip(const Texture2D* texture, unsigned screenSize) const;
+    /// Return max number of skipped mip levels for the texture.
+    unsigned GetMaxMipsToSkip(const Texture2D* texture) const;
+    /// Apply memory budget by degrading the least visible textures.
+    void ApplyMemoryBudget(FrameVector<TextureState*>& states);
+    /// Start reloading texture with given number of skipped levels.
+    void QueueLoad(TextureState& state);
+    /// Apply loaded image to the texture. Called from the main thread.
+    void FinishLoad(Texture2D* texture, Image* image, unsigned mipsToSkip);
+
+    unsigned maxPendingLoads_{DefaultMaxPendingLoads};
+    unsigned minResidentSize_{DefaultMinResidentSize};
+    unsigned streamOutDelay_{DefaultStreamOutDelay};
+    float texelDensity_{1.0f};
+
+    ea::unordered_map<Texture2D*, TextureState> textures_;
+    unsigned frameNumber_{};
+    unsigned numPendingLoads_{};
+    unsigned long long memoryUse_{};
+};
+
+}
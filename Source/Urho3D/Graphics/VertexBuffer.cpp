@@ -104,6 +104,25 @@ Ubyte4 Vector4WeightsToUbyte4Norm(const Vector4& value)
     return result;
 }
 
+/// Helper types for signed byte vector and half float vectors.
+/// @{
+using Byte4 = ea::array<signed char, 4>;
+using Half2 = ea::array<unsigned short, 2>;
+using Half4 = ea::array<unsigned short, 4>;
+/// @}
+
+/// Convert float in range [-1, 1] to signed normalized byte (with clamping).
+signed char FloatToByteNorm(float value)
+{
+    return static_cast<signed char>(Clamp(RoundToInt(value * 127.0f), -127, 127));
+}
+
+/// Convert signed normalized byte to float in range [-1, 1].
+float ByteNormToFloat(signed char value)
+{
+    return ea::max(value / 127.0f, -1.0f);
+}
+
 /// No-op converter from float vector to float vector.
 Vector4 Vector4ToVector4(const Vector4& value) { return { value.x_, value.y_, value.z_, value.w_ }; }
 
@@ -116,12 +135,30 @@ Vector4 Vector3ToVector4(const Vector3& value) { return { value.x_, value.y_, va
 Vector4 Position2ToVector4(const Vector2& value) { return { value.x_, value.y_, 0.0f, 1.0f }; }
 Vector4 Position3ToVector4(const Vector3& value) { return { value.x_, value.y_, value.z_, 1.0f }; }
 Vector4 Ubyte4NormToVector4(const Ubyte4& value) { return Ubyte4ToVector4(value) / 255.0f; }
+Vector4 Byte4NormToVector4(const Byte4& value)
+{
+    return { ByteNormToFloat(value[0]), ByteNormToFloat(value[1]), ByteNormToFloat(value[2]), ByteNormToFloat(value[3]) };
+}
+Vector4 Half2ToVector4(const Half2& value) { return { HalfToFloat(value[0]), HalfToFloat(value[1]), 0.0f, 0.0f }; }
+Vector4 Half4ToVector4(const Half4& value)
+{
+    return { HalfToFloat(value[0]), HalfToFloat(value[1]), HalfToFloat(value[2]), HalfToFloat(value[3]) };
+}
 
 int Vector4ToInt(const Vector4& value) { return static_cast<int>(value.x_); }
 float Vector4ToFloat(const Vector4& value) { return value.x_; }
 Vector2 Vector4ToVector2(const Vector4& value) { return { value.x_, value.y_ }; }
 Vector3 Vector4ToVector3(const Vector4& value) { return { value.x_, value.y_, value.z_ }; }
 Ubyte4 Vector4ToUbyte4Norm(const Vector4& value) { return Vector4ToUbyte4(value * 255.0f); }
+Byte4 Vector4ToByte4Norm(const Vector4& value)
+{
+    return { FloatToByteNorm(value.x_), FloatToByteNorm(value.y_), FloatToByteNorm(value.z_), FloatToByteNorm(value.w_) };
+}
+Half2 Vector4ToHalf2(const Vector4& value) { return { FloatToHalf(value.x_), FloatToHalf(value.y_) }; }
+Half4 Vector4ToHalf4(const Vector4& value)
+{
+    return { FloatToHalf(value.x_), FloatToHalf(value.y_), FloatToHalf(value.z_), FloatToHalf(value.w_) };
+}
 /// @}
 
 }
@@ -137,12 +174,23 @@ void VertexBuffer::SetShadowed(bool enable)
     shadowedPending_ = enable;
 }
 
+void VertexBuffer::SetUnorderedAccess(bool enable)
+{
+    unorderedAccessPending_ = enable;
+}
+
+void VertexBuffer::SetDiscard(bool enable)
+{
+    discardPending_ = enable;
+}
+
 bool VertexBuffer::SetSize(unsigned vertexCount, unsigned elementMask, bool dynamic)
 {
     return SetSize(vertexCount, GetElements(elementMask), dynamic);
 }
 
-bool VertexBuffer::SetSize(unsigned vertexCount, const ea::vector<VertexElement>& elements, bool dynamic)
+bool VertexBuffer::SetSize(
+    unsigned vertexCount, const ea::vector<VertexElement>& elements, bool dynamic, const void* data)
 {
     vertexCount_ = vertexCount;
     elements_ = elements;
@@ -157,10 +205,14 @@ bool VertexBuffer::SetSize(unsigned vertexCount, const ea::vector<VertexElement>
         params.flags_ |= BufferFlag::Shadowed;
     if (dynamic)
         params.flags_ |= BufferFlag::Dynamic;
+    if (dynamic && discardPending_)
+        params.flags_ |= BufferFlag::Discard;
+    if (unorderedAccessPending_)
+        params.flags_ |= BufferFlag::BindUnorderedAccess;
     if (!elements_.empty() && elements_[0].stepRate_ != 0)
         params.flags_ |= BufferFlag::PerInstanceData;
 
-    return Create(params, nullptr);
+    return Create(params, data);
 }
 
 void VertexBuffer::UpdateOffsets()
@@ -355,6 +407,15 @@ void VertexBuffer::UnpackVertexData(const void* source, unsigned sourceStride,
     case TYPE_UBYTE4_NORM:
         ConvertArray<Vector4, Ubyte4>(destBytes, sourceBytes, destStride, sourceStride, count, Ubyte4NormToVector4);
         break;
+    case TYPE_BYTE4_NORM:
+        ConvertArray<Vector4, Byte4>(destBytes, sourceBytes, destStride, sourceStride, count, Byte4NormToVector4);
+        break;
+    case TYPE_HALF2:
+        ConvertArray<Vector4, Half2>(destBytes, sourceBytes, destStride, sourceStride, count, Half2ToVector4);
+        break;
+    case TYPE_HALF4:
+        ConvertArray<Vector4, Half4>(destBytes, sourceBytes, destStride, sourceStride, count, Half4ToVector4);
+        break;
     default:
         assert(0);
         break;
@@ -393,6 +454,15 @@ void VertexBuffer::PackVertexData(const Vector4 source[], unsigned sourceStride,
         else
             ConvertArray<Ubyte4, Vector4>(destBytes, sourceBytes, destStride, sourceStride, count, Vector4ToUbyte4Norm);
         break;
+    case TYPE_BYTE4_NORM:
+        ConvertArray<Byte4, Vector4>(destBytes, sourceBytes, destStride, sourceStride, count, Vector4ToByte4Norm);
+        break;
+    case TYPE_HALF2:
+        ConvertArray<Half2, Vector4>(destBytes, sourceBytes, destStride, sourceStride, count, Vector4ToHalf2);
+        break;
+    case TYPE_HALF4:
+        ConvertArray<Half4, Vector4>(destBytes, sourceBytes, destStride, sourceStride, count, Vector4ToHalf4);
+        break;
     default:
         assert(0);
         break;
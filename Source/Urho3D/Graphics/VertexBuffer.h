@@ -45,8 +45,18 @@ public:
     /// Enable shadowing in CPU memory. Shadowing is forced on if the graphics subsystem does not exist.
     /// @property
     void SetShadowed(bool enable);
+    /// Enable binding as unordered access view so the buffer can be written by compute shaders.
+    /// Shall be called before SetSize. Incompatible with dynamic mode.
+    void SetUnorderedAccess(bool enable);
+    /// Enable discarding of dynamic buffer data when frame ends, so the buffer doesn't need CPU copy.
+    /// The buffer should be written every frame it's used. Shall be called before SetSize.
+    void SetDiscard(bool enable);
     /// Set size, vertex elements and dynamic mode. Previous data will be lost.
-    bool SetSize(unsigned vertexCount, const ea::vector<VertexElement>& elements, bool dynamic = false);
+    /// Optional initial data should contain the whole buffer and cannot be used with dynamic mode.
+    /// Device context is not used for initial data, so it's safe to call from worker thread
+    /// if RenderDeviceCaps::threadedResourceCreation_ is set.
+    bool SetSize(unsigned vertexCount, const ea::vector<VertexElement>& elements, bool dynamic = false,
+        const void* data = nullptr);
     /// Set size and vertex elements and dynamic mode using legacy element bitmask. Previous data will be lost.
     bool SetSize(unsigned vertexCount, unsigned elementMask, bool dynamic = false);
 
@@ -145,6 +155,10 @@ private:
     VertexMaskFlags elementMask_{};
     /// Shadowed flag.
     bool shadowedPending_{};
+    /// Unordered access flag.
+    bool unorderedAccessPending_{};
+    /// Discard flag.
+    bool discardPending_{};
 };
 
 /// Vertex Buffer of dynamic size. Resize policy is similar to standard vector.
@@ -8,6 +8,7 @@
 
 #include "Urho3D/IK/AllSolvers.h"
 #include "Urho3D/IK/IKSolver.h"
+#include "Urho3D/IK/IKSolverManager.h"
 #include "Urho3D/IK/IKTargetExtractor.h"
 
 namespace Urho3D
@@ -16,6 +17,7 @@ namespace Urho3D
 void RegisterIKLibrary(Context* context)
 {
     IKSolver::RegisterObject(context);
+    IKSolverManager::RegisterObject(context);
     IKSolverComponent::RegisterObject(context);
 
     IKIdentitySolver::RegisterObject(context);
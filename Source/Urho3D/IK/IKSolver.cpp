@@ -25,9 +25,11 @@
 #include "Urho3D/IK/IKSolver.h"
 
 #include "Urho3D/Core/Context.h"
+#include "Urho3D/Core/WorkQueue.h"
 #include "Urho3D/Graphics/AnimatedModel.h"
 #include "Urho3D/Graphics/AnimationController.h"
 #include "Urho3D/IK/IKEvents.h"
+#include "Urho3D/IK/IKSolverManager.h"
 #include "Urho3D/IO/Log.h"
 #include "Urho3D/Scene/Node.h"
 #include "Urho3D/Scene/Scene.h"
@@ -38,6 +40,8 @@ namespace Urho3D
 IKSolver::IKSolver(Context* context)
     : LogicComponent(context)
 {
+    // IKSolverManager solves all solvers of the scene at once
+    SetUpdateEventMask(USE_NO_EVENT);
 }
 
 IKSolver::~IKSolver()
@@ -69,22 +73,84 @@ void IKSolver::OnNodeSet(Node* previousNode, Node* currentNode)
     }
 }
 
-void IKSolver::PostUpdate(float timeStep)
+void IKSolver::OnSceneSet(Scene* scene)
 {
-    if (!node_)
-        return;
+    LogicComponent::OnSceneSet(scene);
+
+    if (manager_)
+        manager_->RemoveSolver(this);
+
+    if (scene)
+    {
+        manager_ = scene->GetComponent<IKSolverManager>();
+        if (!manager_)
+        {
+            manager_ = scene->CreateComponent<IKSolverManager>();
+            manager_->SetTemporary(true);
+        }
+        manager_->AddSolver(this);
+    }
+    else
+        manager_ = nullptr;
+}
 
-    auto scene = GetScene();
+bool IKSolver::IsSolveNeeded()
+{
+    if (!node_ || !IsEnabledEffective())
+        return false;
 
     // Cannot solve when paused if there's no AnimatedModel because it will disturb original pose.
     if (solveWhenPaused_ && !node_->HasComponent<AnimatedModel>())
         solveWhenPaused_ = false;
 
-    if (scene->IsUpdateEnabled() || solveWhenPaused_)
+    return GetScene()->IsUpdateEnabled() || solveWhenPaused_;
+}
+
+void IKSolver::PostUpdate(float timeStep)
+{
+    if (IsSolveNeeded())
         Solve(timeStep);
 }
 
 void IKSolver::Solve(float timeStep)
+{
+    if (BeginSolve())
+    {
+        SolveInternal(timeStep);
+        EndSolve();
+    }
+}
+
+void IKSolver::SolveParallel(WorkQueue* workQueue, ea::span<IKSolver* const> solvers, float timeStep)
+{
+    static const unsigned ChunkSize = 4;
+
+    // Event handlers may remove solvers, keep weak references
+    ea::vector<WeakPtr<IKSolver>> activeSolvers;
+    for (IKSolver* solver : solvers)
+    {
+        if (solver->BeginSolve())
+            activeSolvers.emplace_back(solver);
+    }
+    ea::erase_if(activeSolvers, [](const WeakPtr<IKSolver>& solver) { return !solver || !solver->GetScene(); });
+    if (activeSolvers.empty())
+        return;
+
+    // Solvers write nodes of their own hierarchies only, dirty notifications are delayed
+    Scene* scene = activeSolvers.front()->GetScene();
+    scene->BeginThreadedUpdate();
+    ForEachParallel(workQueue, ChunkSize, activeSolvers,
+        [timeStep](unsigned, IKSolver* solver) { solver->SolveInternal(timeStep); });
+    scene->EndThreadedUpdate();
+
+    for (IKSolver* solver : activeSolvers)
+    {
+        if (solver)
+            solver->EndSolve();
+    }
+}
+
+bool IKSolver::BeginSolve()
 {
     if (IsChainTreeExpired())
         solversDirty_ = true;
@@ -97,15 +163,31 @@ void IKSolver::Solve(float timeStep)
     }
 
     if (solvers_.empty() || solverNodes_.empty())
-        return;
+        return false;
 
     SendIKEvent(true);
+    if (solvers_.empty() || solverNodes_.empty() || IsChainTreeExpired())
+        return false;
+
+    // Update world transforms in the main thread so they are only read during solving
+    for (const auto& [node, _] : solverNodes_)
+        node->GetWorldTransform();
+
     UpdateOriginalTransforms();
+    return true;
+}
+
+void IKSolver::SolveInternal(float timeStep)
+{
     for (IKSolverComponent* solver : solvers_)
     {
         URHO3D_ASSERT(solver);
         solver->Solve(settings_, timeStep);
     }
+}
+
+void IKSolver::EndSolve()
+{
     SendIKEvent(false);
 
     if (auto animatedModel = node_->GetComponent<AnimatedModel>())
@@ -29,6 +29,9 @@
 namespace Urho3D
 {
 
+class IKSolverManager;
+class WorkQueue;
+
 class IKSolver : public LogicComponent
 {
     URHO3D_OBJECT(IKSolver, LogicComponent);
@@ -42,6 +45,11 @@ public:
     void MarkSolversDirty() { solversDirty_ = true; }
     /// Solve the IK forcibly.
     void Solve(float timeStep);
+    /// Solve the IK of many solvers at once. Events are sent and transforms are prepared in the main thread,
+    /// solvers are executed in parallel. Solvers should not share bone and target nodes.
+    static void SolveParallel(WorkQueue* workQueue, ea::span<IKSolver* const> solvers, float timeStep);
+    /// Return whether the IK should be solved at the end of the frame by IKSolverManager.
+    bool IsSolveNeeded();
 
     void PostUpdate(float timeStep) override;
     StringHash GetPostUpdateEvent() const override { return E_SCENEDRAWABLEUPDATEFINISHED; }
@@ -59,6 +67,14 @@ public:
 
 private:
     void OnNodeSet(Node* previousNode, Node* currentNode) override;
+    void OnSceneSet(Scene* scene) override;
+
+    /// Prepare solving in the main thread. Return false if there is nothing to solve.
+    bool BeginSolve();
+    /// Run the solvers. May be called from worker thread.
+    void SolveInternal(float timeStep);
+    /// Finish solving in the main thread.
+    void EndSolve();
 
     bool IsChainTreeExpired() const;
     void RebuildSolvers();
@@ -72,6 +88,7 @@ private:
     bool solversDirty_{};
 
     ea::vector<WeakPtr<IKSolverComponent>> solvers_;
+    WeakPtr<IKSolverManager> manager_;
 
     IKNodeCache solverNodes_;
 };
@@ -0,0 +1,84 @@
+// Copyright (c) 2022-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/IK/IKSolverManager.h"
+
+#include "Urho3D/Core/Context.h"
+#include "Urho3D/Core/Profiler.h"
+#include "Urho3D/Core/WorkQueue.h"
+#include "Urho3D/IK/IKSolver.h"
+#include "Urho3D/Scene/Scene.h"
+#include "Urho3D/Scene/SceneEvents.h"
+
+namespace Urho3D
+{
+
+IKSolverManager::IKSolverManager(Context* context)
+    : Component(context)
+{
+}
+
+IKSolverManager::~IKSolverManager()
+{
+}
+
+void IKSolverManager::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<IKSolverManager>(Category_IK);
+
+    URHO3D_ATTRIBUTE("Parallel", bool, parallel_, true, AM_DEFAULT);
+}
+
+void IKSolverManager::AddSolver(IKSolver* solver)
+{
+    solvers_.emplace_back(solver);
+}
+
+void IKSolverManager::RemoveSolver(IKSolver* solver)
+{
+    const auto iter = ea::find(solvers_.begin(), solvers_.end(), solver);
+    if (iter != solvers_.end())
+        solvers_.erase(iter);
+}
+
+void IKSolverManager::OnSceneSet(Scene* scene)
+{
+    if (scene)
+    {
+        SubscribeToEvent(scene, E_SCENEDRAWABLEUPDATEFINISHED,
+            [this](VariantMap& eventData)
+        {
+            using namespace SceneDrawableUpdateFinished;
+            Update(eventData[P_TIMESTEP].GetFloat());
+        });
+    }
+    else
+        UnsubscribeFromEvent(E_SCENEDRAWABLEUPDATEFINISHED);
+}
+
+void IKSolverManager::Update(float timeStep)
+{
+    URHO3D_PROFILE("SolveIK");
+
+    ea::erase_if(solvers_, [](const WeakPtr<IKSolver>& solver) { return !solver; });
+
+    solversToUpdate_.clear();
+    for (IKSolver* solver : solvers_)
+    {
+        if (solver->IsSolveNeeded())
+            solversToUpdate_.push_back(solver);
+    }
+
+    if (parallel_)
+        IKSolver::SolveParallel(GetSubsystem<WorkQueue>(), solversToUpdate_, timeStep);
+    else
+    {
+        for (IKSolver* solver : solversToUpdate_)
+            solver->Solve(timeStep);
+    }
+}
+
+} // namespace Urho3D
@@ -0,0 +1,54 @@
+// Copyright (c) 2022-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "../Scene/Component.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class IKSolver;
+
+/// Scene component that solves IK of all IKSolver components in the scene at once.
+/// Characters are solved in parallel on WorkQueue after drawables are updated.
+/// Created automatically when IKSolver is added to the scene.
+class URHO3D_API IKSolverManager : public Component
+{
+    URHO3D_OBJECT(IKSolverManager, Component);
+
+public:
+    explicit IKSolverManager(Context* context);
+    ~IKSolverManager() override;
+    static void RegisterObject(Context* context);
+
+    /// Set whether solvers are executed in parallel.
+    void SetParallel(bool value) { parallel_ = value; }
+    /// Return whether solvers are executed in parallel.
+    bool IsParallel() const { return parallel_; }
+
+    /// Return number of solvers in the scene.
+    unsigned GetNumSolvers() const { return solvers_.size(); }
+
+    /// Internal. Manage solvers.
+    /// @{
+    void AddSolver(IKSolver* solver);
+    void RemoveSolver(IKSolver* solver);
+    /// @}
+
+private:
+    void OnSceneSet(Scene* scene) override;
+
+    /// Solve all solvers that need to be solved this frame.
+    void Update(float timeStep);
+
+    bool parallel_{true};
+
+    ea::vector<WeakPtr<IKSolver>> solvers_;
+    ea::vector<IKSolver*> solversToUpdate_;
+};
+
+} // namespace Urho3D
@@ -25,6 +25,8 @@
 #include "../IO/Serializer.h"
 #include "../IO/Deserializer.h"
 
+#include <EASTL/optional.h>
+
 namespace Urho3D
 {
 /// File open mode.
@@ -35,6 +37,17 @@ enum FileMode
     FILE_READWRITE
 };
 
+/// Range of data in the native file, used for asynchronous reads.
+struct NativeFileRange
+{
+    /// Native C file handle (FILE*).
+    void* handle_{};
+    /// Offset of the data in the file.
+    unsigned long long offset_{};
+    /// Size of the data.
+    unsigned size_{};
+};
+
 /// A common root class for objects that implement both Serializer and Deserializer.
 class URHO3D_API AbstractFile : public Deserializer, public Serializer
 {
@@ -56,6 +69,8 @@ public:
     virtual const ea::string& GetAbsoluteName() const { return name_; }
     /// Close the file.
     virtual void Close() {}
+    /// Return remaining data of the file as the range of native file, if it can be read directly.
+    virtual ea::optional<NativeFileRange> GetNativeFileRange() const { return ea::nullopt; }
 
 #ifndef SWIG
     // A workaround for SWIG failing to generate bindings because both IAbstractFile and IDeserializer provide GetName() method. This is
@@ -268,6 +268,24 @@ inline void SerializeValue(Archive& archive, const char* name, IntVector3& value
 inline void SerializeValue(Archive& archive, const char* name, IntRect& value) { Detail::SerializePrimitiveArray<4>(archive, name, value); }
 /// @}
 
+namespace Detail
+{
+
+/// Whether the value is written to binary archive exactly as it is stored in memory,
+/// so a sequence of such values may be serialized as one block of bytes.
+template <class T>
+struct IsBinaryArchiveBytesCompatible
+{
+    static constexpr bool value = (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+        || std::is_same_v<T, StringHash> || std::is_same_v<T, Vector2> || std::is_same_v<T, Vector3>
+        || std::is_same_v<T, Vector4> || std::is_same_v<T, Matrix3> || std::is_same_v<T, Matrix3x4>
+        || std::is_same_v<T, Matrix4> || std::is_same_v<T, Rect> || std::is_same_v<T, Quaternion>
+        || std::is_same_v<T, Color> || std::is_same_v<T, IntVector2> || std::is_same_v<T, IntVector3>
+        || std::is_same_v<T, IntRect>;
+};
+
+}
+
 /// Serialize object with standard interface as value.
 template <class T, std::enable_if_t<IsObjectSerializableInBlock<T>::value, int> = 0>
 inline void SerializeValue(Archive& archive, const char* name, T& value)
@@ -99,6 +99,17 @@ void SerializeVectorAsObjects(Archive& archive, const char* name, T& vector, con
         vector.resize(numElements);
     }
 
+    // Elements are stored in binary archive as is, serialize them at once
+    if constexpr (Detail::IsBinaryArchiveBytesCompatible<ValueType>::value
+        && std::is_same_v<TSerializer, Detail::DefaultSerializer>)
+    {
+        if (!archive.IsHumanReadable())
+        {
+            archive.SerializeBytes(element, vector.data(), numElements * sizeof(ValueType));
+            return;
+        }
+    }
+
     for (unsigned i = 0; i < numElements; ++i)
         serializeValue(archive, element, vector[i]);
 }
@@ -117,6 +128,19 @@ void SerializeArrayAsObjects(Archive& archive, const char* name, T& array, const
             throw ArchiveException("'{}/{}' has unexpected array size", archive.GetCurrentBlockPath(), name);
     }
 
+    // Elements are stored in binary archive as is, serialize them at once
+    using ValueType = std::decay_t<decltype(array[0])>;
+    if constexpr (Detail::IsBinaryArchiveBytesCompatible<ValueType>::value
+        && std::is_same_v<TSerializer, Detail::DefaultSerializer>)
+    {
+        if (!archive.IsHumanReadable())
+        {
+            if (numElements > 0)
+                archive.SerializeBytes(element, &array[0], numElements * sizeof(ValueType));
+            return;
+        }
+    }
+
     for (unsigned i = 0; i < numElements; ++i)
         serializeValue(archive, element, array[i]);
 }
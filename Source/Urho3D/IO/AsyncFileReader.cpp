@@ -0,0 +1,503 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifdef URHO3D_THREADING
+
+#include "../Precompiled.h"
+
+#include "../Core/Profiler.h"
+#include "../Core/Thread.h"
+#include "../IO/AsyncFileReader.h"
+#include "../IO/Log.h"
+
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && !defined(__ANDROID__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define URHO3D_IO_URING
+#endif
+#endif
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Synchronously read the remaining part of the request using positional reads. Return false on error.
+bool ReadPositional(void* handle, unsigned long long offset, unsigned char* dest, unsigned size)
+{
+    auto file = static_cast<FILE*>(handle);
+#ifdef _WIN32
+    const auto nativeHandle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)));
+    if (nativeHandle == INVALID_HANDLE_VALUE)
+        return false;
+
+    while (size > 0)
+    {
+        OVERLAPPED overlapped{};
+        overlapped.Offset = static_cast<DWORD>(offset & 0xffffffffull);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        DWORD bytesRead = 0;
+        if (!::ReadFile(nativeHandle, dest, size, &bytesRead, &overlapped) || bytesRead == 0)
+            return false;
+
+        offset += bytesRead;
+        dest += bytesRead;
+        size -= bytesRead;
+    }
+#else
+    const int fd = fileno(file);
+    while (size > 0)
+    {
+        const ssize_t bytesRead = pread(fd, dest, size, static_cast<off_t>(offset));
+        if (bytesRead < 0 && errno == EINTR)
+            continue;
+        if (bytesRead <= 0)
+            return false;
+
+        offset += bytesRead;
+        dest += bytesRead;
+        size -= static_cast<unsigned>(bytesRead);
+    }
+#endif
+    return true;
+}
+
+}
+
+class AsyncFileReader::WorkerThread : public Thread
+{
+public:
+    WorkerThread(const ea::string& name, ea::function<void()> function)
+        : Thread(name)
+        , function_(ea::move(function))
+    {
+    }
+
+    void ThreadFunction() override
+    {
+        URHO3D_PROFILE_THREAD(name_.c_str());
+        function_();
+    }
+
+private:
+    ea::function<void()> function_;
+};
+
+#ifdef URHO3D_IO_URING
+/// Minimal io_uring wrapper on top of raw system calls.
+struct AsyncFileReader::IoUring
+{
+    ~IoUring()
+    {
+        if (sqes_ != MAP_FAILED)
+            munmap(sqes_, sqesSize_);
+        if (cqRing_ != MAP_FAILED && cqRing_ != sqRing_)
+            munmap(cqRing_, cqRingSize_);
+        if (sqRing_ != MAP_FAILED)
+            munmap(sqRing_, sqRingSize_);
+        if (fd_ >= 0)
+            close(fd_);
+    }
+
+    bool Initialize(unsigned entries)
+    {
+        io_uring_params params{};
+        fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (fd_ < 0)
+            return false;
+
+        // IORING_OP_READ is supported since the same kernel version
+        if (!(params.features & IORING_FEAT_RW_CUR_POS))
+            return false;
+
+        sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+
+        const bool singleMap = !!(params.features & IORING_FEAT_SINGLE_MMAP);
+        if (singleMap)
+            sqRingSize_ = cqRingSize_ = ea::max(sqRingSize_, cqRingSize_);
+
+        sqRing_ = mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+        if (sqRing_ == MAP_FAILED)
+            return false;
+
+        cqRing_ = singleMap ? sqRing_
+            : mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+        if (cqRing_ == MAP_FAILED)
+            return false;
+
+        sqes_ = mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+        if (sqes_ == MAP_FAILED)
+            return false;
+
+        auto sqBase = static_cast<unsigned char*>(sqRing_);
+        sqHead_ = reinterpret_cast<unsigned*>(sqBase + params.sq_off.head);
+        sqTail_ = reinterpret_cast<unsigned*>(sqBase + params.sq_off.tail);
+        sqMask_ = *reinterpret_cast<unsigned*>(sqBase + params.sq_off.ring_mask);
+        sqArray_ = reinterpret_cast<unsigned*>(sqBase + params.sq_off.array);
+
+        auto cqBase = static_cast<unsigned char*>(cqRing_);
+        cqHead_ = reinterpret_cast<unsigned*>(cqBase + params.cq_off.head);
+        cqTail_ = reinterpret_cast<unsigned*>(cqBase + params.cq_off.tail);
+        cqMask_ = *reinterpret_cast<unsigned*>(cqBase + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cqBase + params.cq_off.cqes);
+
+        numEntries_ = params.sq_entries;
+        return true;
+    }
+
+    /// Push read operation to the submission queue. Zero user data is reserved for wake-up.
+    bool PushRead(int fd, void* dest, unsigned size, unsigned long long offset, unsigned long long userData)
+    {
+        io_uring_sqe* sqe = AllocateEntry();
+        if (!sqe)
+            return false;
+
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<unsigned long long>(dest);
+        sqe->len = size;
+        sqe->off = offset;
+        sqe->user_data = userData;
+        return true;
+    }
+
+    /// Push no-op to the submission queue.
+    bool PushNop(unsigned long long userData)
+    {
+        io_uring_sqe* sqe = AllocateEntry();
+        if (!sqe)
+            return false;
+
+        sqe->opcode = IORING_OP_NOP;
+        sqe->user_data = userData;
+        return true;
+    }
+
+    /// Submit pushed entries to the kernel.
+    void Submit()
+    {
+        const unsigned tail = *sqTail_;
+        const unsigned head = __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+        if (tail == head)
+            return;
+
+        while (syscall(__NR_io_uring_enter, fd_, tail - head, 0, 0, nullptr, 0) < 0 && errno == EINTR)
+        {
+        }
+    }
+
+    /// Wait for at least one completion and process all available completions.
+    template <class T> void WaitCompletions(const T& callback)
+    {
+        if (syscall(__NR_io_uring_enter, fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR)
+            URHO3D_LOGERROR("Failed to wait for io_uring completions: error {}", errno);
+
+        unsigned head = *cqHead_;
+        const unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+        while (head != tail)
+        {
+            const io_uring_cqe& cqe = cqes_[head & cqMask_];
+            callback(cqe.user_data, cqe.res);
+            ++head;
+        }
+        __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+    }
+
+    unsigned GetNumEntries() const { return numEntries_; }
+
+private:
+    io_uring_sqe* AllocateEntry()
+    {
+        const unsigned tail = *sqTail_;
+        const unsigned head = __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+        if (tail - head >= numEntries_)
+            return nullptr;
+
+        const unsigned index = tail & sqMask_;
+        io_uring_sqe* sqe = &static_cast<io_uring_sqe*>(sqes_)[index];
+        memset(sqe, 0, sizeof(io_uring_sqe));
+        sqArray_[index] = index;
+        __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+        return sqe;
+    }
+
+    int fd_{-1};
+    void* sqRing_{MAP_FAILED};
+    void* cqRing_{MAP_FAILED};
+    void* sqes_{MAP_FAILED};
+    size_t sqRingSize_{};
+    size_t cqRingSize_{};
+    size_t sqesSize_{};
+
+    unsigned* sqHead_{};
+    unsigned* sqTail_{};
+    unsigned sqMask_{};
+    unsigned* sqArray_{};
+    unsigned* cqHead_{};
+    unsigned* cqTail_{};
+    unsigned cqMask_{};
+    io_uring_cqe* cqes_{};
+    unsigned numEntries_{};
+};
+#else
+struct AsyncFileReader::IoUring
+{
+};
+#endif
+
+AsyncFileReader::AsyncFileReader(unsigned queueDepth, unsigned numFallbackThreads)
+{
+    if (StartNative(ea::max(queueDepth, 1u)))
+        return;
+
+    for (unsigned i = 0; i < ea::max(numFallbackThreads, 1u); ++i)
+    {
+        auto thread = ea::make_unique<WorkerThread>(
+            Format("AsyncFileReader Thread {}", i), [this] { ProcessFallbackRequests(); });
+        thread->Run();
+        threads_.push_back(ea::move(thread));
+    }
+}
+
+AsyncFileReader::~AsyncFileReader()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this] { return numPendingRequests_.load() == 0; });
+        stopping_ = true;
+
+#ifdef URHO3D_IO_URING
+        // Wake up the completion thread
+        if (ioUring_)
+        {
+            ioUring_->PushNop(0);
+            ioUring_->Submit();
+        }
+#endif
+    }
+    condition_.notify_all();
+
+    for (const auto& thread : threads_)
+        thread->Stop();
+    threads_.clear();
+    ioUring_ = nullptr;
+}
+
+SharedPtr<AsyncReadRequest> AsyncFileReader::ReadFile(const AbstractFilePtr& file, const AsyncReadRequest::Callback& callback)
+{
+    const ea::optional<NativeFileRange> range = file ? file->GetNativeFileRange() : ea::nullopt;
+    if (!range)
+        return nullptr;
+
+    auto request = MakeShared<AsyncReadRequest>();
+    request->file_ = file;
+    request->range_ = *range;
+    request->data_.resize(range->size_);
+    request->callback_ = callback;
+
+    // Reader owns the request until completion
+    request->AddRef();
+    numPendingRequests_.fetch_add(1, std::memory_order_relaxed);
+
+    if (range->size_ == 0)
+    {
+        CompleteRequest(request, true);
+        return request;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queuedRequests_.push_back(request);
+        if (ioUring_)
+            SubmitNativeRequests();
+    }
+
+    if (!ioUring_)
+        condition_.notify_one();
+
+    return request;
+}
+
+bool AsyncFileReader::StartNative(unsigned queueDepth)
+{
+#ifdef URHO3D_IO_URING
+    auto ioUring = ea::make_unique<IoUring>();
+    if (!ioUring->Initialize(queueDepth))
+    {
+        URHO3D_LOGDEBUG("io_uring is not supported, falling back to positional reads by worker threads");
+        return false;
+    }
+
+    ioUring_ = ea::move(ioUring);
+
+    auto thread = ea::make_unique<WorkerThread>("AsyncFileReader Thread", [this] { ProcessNativeCompletions(); });
+    thread->Run();
+    threads_.push_back(ea::move(thread));
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AsyncFileReader::SubmitNativeRequests()
+{
+#ifdef URHO3D_IO_URING
+    // Keep one entry reserved for wake-up on destruction
+    const unsigned maxSubmittedRequests = ioUring_->GetNumEntries() - 1;
+
+    unsigned numPushed = 0;
+    while (!queuedRequests_.empty() && numSubmittedRequests_ < maxSubmittedRequests)
+    {
+        AsyncReadRequest* request = queuedRequests_.front();
+        const NativeFileRange& range = request->range_;
+        const int fd = fileno(static_cast<FILE*>(range.handle_));
+        if (!ioUring_->PushRead(fd, request->data_.data() + request->bytesRead_, range.size_ - request->bytesRead_,
+            range.offset_ + request->bytesRead_, reinterpret_cast<unsigned long long>(request)))
+            break;
+
+        queuedRequests_.erase(queuedRequests_.begin());
+        ++numSubmittedRequests_;
+        ++numPushed;
+    }
+
+    if (numPushed > 0)
+        ioUring_->Submit();
+#endif
+}
+
+void AsyncFileReader::ProcessNativeCompletions()
+{
+#ifdef URHO3D_IO_URING
+    ea::vector<ea::pair<AsyncReadRequest*, bool>> completedRequests;
+    bool isStopped = false;
+    while (!isStopped)
+    {
+        unsigned numCompletions = 0;
+        completedRequests.clear();
+
+        ea::vector<AsyncReadRequest*> unfinishedRequests;
+        ioUring_->WaitCompletions([&](unsigned long long userData, int result)
+        {
+            if (userData == 0)
+            {
+                isStopped = true;
+                return;
+            }
+
+            ++numCompletions;
+            auto request = reinterpret_cast<AsyncReadRequest*>(userData);
+            if (result == -EINTR || result == -EAGAIN)
+            {
+                unfinishedRequests.push_back(request);
+                return;
+            }
+
+            if (result <= 0)
+            {
+                completedRequests.emplace_back(request, false);
+                return;
+            }
+
+            // Continue short reads
+            request->bytesRead_ += static_cast<unsigned>(result);
+            if (request->bytesRead_ < request->range_.size_)
+                unfinishedRequests.push_back(request);
+            else
+                completedRequests.emplace_back(request, true);
+        });
+
+        if (numCompletions > 0)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            numSubmittedRequests_ -= numCompletions;
+            queuedRequests_.insert(queuedRequests_.begin(), unfinishedRequests.begin(), unfinishedRequests.end());
+            SubmitNativeRequests();
+        }
+
+        for (const auto& [request, success] : completedRequests)
+            CompleteRequest(request, success);
+    }
+#endif
+}
+
+void AsyncFileReader::ProcessFallbackRequests()
+{
+    for (;;)
+    {
+        AsyncReadRequest* request = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return stopping_ || !queuedRequests_.empty(); });
+            if (queuedRequests_.empty())
+                return;
+
+            request = queuedRequests_.front();
+            queuedRequests_.erase(queuedRequests_.begin());
+        }
+
+        URHO3D_PROFILE("AsyncFileRead");
+        const NativeFileRange& range = request->range_;
+        const bool success = ReadPositional(range.handle_, range.offset_,
+            request->data_.data() + request->bytesRead_, range.size_ - request->bytesRead_);
+        CompleteRequest(request, success);
+    }
+}
+
+void AsyncFileReader::CompleteRequest(AsyncReadRequest* request, bool success)
+{
+    if (!success)
+        URHO3D_LOGERROR("Failed to read file '{}' asynchronously", request->file_->GetName());
+
+    request->state_.store(success ? AsyncReadRequest::State::Succeeded : AsyncReadRequest::State::Failed,
+        std::memory_order_release);
+    if (request->callback_)
+        request->callback_(request);
+    request->ReleaseRef();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        numPendingRequests_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    condition_.notify_all();
+}
+
+}
+
+#endif
@@ -0,0 +1,130 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Container/ByteVector.h"
+#include "../Container/Ptr.h"
+#include "../IO/AbstractFile.h"
+
+#include <EASTL/functional.h>
+#include <EASTL/unique_ptr.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace Urho3D
+{
+
+/// Asynchronous read of file contents. Data is owned by the request.
+class URHO3D_API AsyncReadRequest : public RefCounted
+{
+public:
+    /// Callback invoked from the internal thread of AsyncFileReader when the request is completed.
+    using Callback = ea::function<void(AsyncReadRequest* request)>;
+
+    /// Return whether the request is completed, either successfully or not.
+    bool IsCompleted() const { return state_.load(std::memory_order_acquire) != State::Pending; }
+    /// Return whether the request is completed successfully.
+    bool IsSucceeded() const { return state_.load(std::memory_order_acquire) == State::Succeeded; }
+    /// Return file being read.
+    AbstractFile* GetFile() const { return file_; }
+    /// Return read data. Should be accessed only after completion.
+    ByteVector& GetData() { return data_; }
+
+private:
+    friend class AsyncFileReader;
+
+    enum class State
+    {
+        Pending,
+        Succeeded,
+        Failed
+    };
+
+    /// File is kept alive so the native handle stays valid.
+    AbstractFilePtr file_;
+    NativeFileRange range_;
+    ByteVector data_;
+    /// Number of bytes read so far.
+    unsigned bytesRead_{};
+    Callback callback_;
+    std::atomic<State> state_{State::Pending};
+};
+
+/// Reader of files that doesn't block the caller on I/O.
+/// Uses io_uring on Linux if supported by the kernel, so many reads can be in flight at once.
+/// Falls back to positional reads by the pool of threads elsewhere.
+/// Only files that expose NativeFileRange can be read asynchronously.
+class URHO3D_API AsyncFileReader : public RefCounted
+{
+public:
+    /// Default maximum number of reads submitted to the kernel at once.
+    static const unsigned DefaultQueueDepth = 64;
+    /// Default number of threads used if io_uring is not available.
+    static const unsigned DefaultNumFallbackThreads = 2;
+
+    explicit AsyncFileReader(unsigned queueDepth = DefaultQueueDepth, unsigned numFallbackThreads = DefaultNumFallbackThreads);
+    /// Destruct. Wait for all pending requests to complete.
+    ~AsyncFileReader() override;
+
+    /// Read remaining contents of the file. Callback may be invoked from the internal thread.
+    /// Return null if the file doesn't support asynchronous reads, it should be read synchronously then.
+    SharedPtr<AsyncReadRequest> ReadFile(const AbstractFilePtr& file, const AsyncReadRequest::Callback& callback = {});
+
+    /// Return whether the native asynchronous I/O (io_uring) is used.
+    bool IsNative() const { return ioUring_ != nullptr; }
+    /// Return number of requests not completed yet.
+    unsigned GetNumPendingRequests() const { return numPendingRequests_.load(std::memory_order_relaxed); }
+
+private:
+    class WorkerThread;
+    struct IoUring;
+
+    /// Start io_uring completion thread. Return false if io_uring is not supported.
+    bool StartNative(unsigned queueDepth);
+    /// Submit queued requests to io_uring while there is space. Must be called under mutex.
+    void SubmitNativeRequests();
+    /// Process io_uring completions until stopped.
+    void ProcessNativeCompletions();
+    /// Process queued requests by positional reads until stopped.
+    void ProcessFallbackRequests();
+
+    /// Complete the request, invoke the callback and release the reference held by the reader.
+    void CompleteRequest(AsyncReadRequest* request, bool success);
+
+    ea::unique_ptr<IoUring> ioUring_;
+    /// Requests not submitted yet. Requests hold an extra reference until completion.
+    ea::vector<AsyncReadRequest*> queuedRequests_;
+    /// Number of requests submitted to io_uring.
+    unsigned numSubmittedRequests_{};
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stopping_{};
+    std::atomic<unsigned> numPendingRequests_{};
+
+    ea::vector<ea::unique_ptr<WorkerThread>> threads_;
+};
+
+}
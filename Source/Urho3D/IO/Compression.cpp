@@ -22,19 +22,342 @@
 
 #include "../Precompiled.h"
 
+#include <EASTL/heap.h>
 #include <EASTL/shared_array.h>
+#include <EASTL/unordered_map.h>
+#include <EASTL/unordered_set.h>
 
 #include "../IO/Compression.h"
 #include "../IO/Deserializer.h"
+#include "../IO/MemoryBuffer.h"
 #include "../IO/Serializer.h"
 #include "../IO/VectorBuffer.h"
 
 #include <LZ4/lz4.h>
 #include <LZ4/lz4hc.h>
 
+#include <future>
+
 namespace Urho3D
 {
 
+namespace
+{
+
+/// Length of byte sequence used to find data shared by samples.
+const unsigned DictionaryKeyLength = 8;
+/// Length of sample segment copied to the dictionary.
+const unsigned DictionarySegmentLength = 64;
+/// File ID of the frame produced by CompressBuffer.
+const char* CompressedFrameId = "UCMP";
+
+unsigned long long ReadDictionaryKey(const unsigned char* data)
+{
+    unsigned long long key;
+    memcpy(&key, data, sizeof(key));
+    return key;
+}
+
+/// Segment of the sample considered for the dictionary.
+struct DictionarySegment
+{
+    unsigned score_{};
+    unsigned sampleIndex_{};
+    unsigned offset_{};
+    unsigned size_{};
+
+    bool operator<(const DictionarySegment& rhs) const { return score_ < rhs.score_; }
+};
+
+}
+
+CompressionDictionary::CompressionDictionary(ByteVector data)
+    : data_(ea::move(data))
+{
+    if (data_.size() > MaxSize)
+        data_.erase(data_.begin(), data_.end() - MaxSize);
+
+    hash_ = 0;
+    for (unsigned char c : data_)
+        hash_ = SDBMHash(hash_, c);
+    if (hash_ == 0)
+        hash_ = 1;
+}
+
+SharedPtr<CompressionDictionary> CompressionDictionary::Train(const ea::vector<ByteVector>& samples, unsigned maxSize)
+{
+    maxSize = ea::min(maxSize, MaxSize);
+
+    // Count the number of samples that contain each key
+    ea::unordered_map<unsigned long long, unsigned> keyFrequency;
+    ea::unordered_set<unsigned long long> sampleKeys;
+    for (const ByteVector& sample : samples)
+    {
+        sampleKeys.clear();
+        for (unsigned i = 0; i + DictionaryKeyLength <= sample.size(); ++i)
+        {
+            const unsigned long long key = ReadDictionaryKey(&sample[i]);
+            if (sampleKeys.insert(key).second)
+                ++keyFrequency[key];
+        }
+    }
+
+    // Segment is as good as the keys in it are shared by other samples
+    const auto scoreSegment = [&](const DictionarySegment& segment)
+    {
+        const unsigned char* data = samples[segment.sampleIndex_].data() + segment.offset_;
+        unsigned score = 0;
+        for (unsigned i = 0; i + DictionaryKeyLength <= segment.size_; ++i)
+        {
+            const auto iter = keyFrequency.find(ReadDictionaryKey(data + i));
+            if (iter != keyFrequency.end() && iter->second > 1)
+                score += iter->second - 1;
+        }
+        return score;
+    };
+
+    ea::vector<DictionarySegment> segments;
+    for (unsigned sampleIndex = 0; sampleIndex < samples.size(); ++sampleIndex)
+    {
+        const unsigned sampleSize = samples[sampleIndex].size();
+        for (unsigned offset = 0; offset + DictionaryKeyLength <= sampleSize; offset += DictionarySegmentLength / 2)
+        {
+            DictionarySegment segment{0, sampleIndex, offset, ea::min(DictionarySegmentLength, sampleSize - offset)};
+            segment.score_ = scoreSegment(segment);
+            if (segment.score_ > 0)
+                segments.push_back(segment);
+        }
+    }
+
+    // Pick the best segments greedily. Scores only decrease, so they are updated lazily
+    ea::make_heap(segments.begin(), segments.end());
+    ea::vector<DictionarySegment> selectedSegments;
+    unsigned dictionarySize = 0;
+    while (!segments.empty() && dictionarySize < maxSize)
+    {
+        ea::pop_heap(segments.begin(), segments.end());
+        DictionarySegment segment = segments.back();
+        segments.pop_back();
+
+        const unsigned score = scoreSegment(segment);
+        if (score == 0)
+            continue;
+
+        if (score < segment.score_ && !segments.empty() && score < segments.front().score_)
+        {
+            segment.score_ = score;
+            segments.push_back(segment);
+            ea::push_heap(segments.begin(), segments.end());
+            continue;
+        }
+
+        // Keys of the selected segment don't make other segments better anymore
+        const unsigned char* data = samples[segment.sampleIndex_].data() + segment.offset_;
+        for (unsigned i = 0; i + DictionaryKeyLength <= segment.size_; ++i)
+            keyFrequency.erase(ReadDictionaryKey(data + i));
+
+        selectedSegments.push_back(segment);
+        dictionarySize += segment.size_;
+    }
+
+    // The most valuable segments are placed last so they are the closest to compressed data
+    ByteVector data;
+    data.reserve(dictionarySize);
+    for (auto iter = selectedSegments.rbegin(); iter != selectedSegments.rend(); ++iter)
+    {
+        const unsigned char* segmentData = samples[iter->sampleIndex_].data() + iter->offset_;
+        data.insert(data.end(), segmentData, segmentData + iter->size_);
+    }
+    if (data.size() > maxSize)
+        data.erase(data.begin(), data.end() - maxSize);
+
+    return MakeShared<CompressionDictionary>(ea::move(data));
+}
+
+unsigned EstimateCompressBound(unsigned srcSize, CompressionCodec codec)
+{
+    return codec == CompressionCodec::None ? srcSize : static_cast<unsigned>(LZ4_compressBound(srcSize));
+}
+
+unsigned CompressData(
+    void* dest, unsigned destCapacity, const void* src, unsigned srcSize, const CompressionSettings& settings)
+{
+    if (!dest || !src || !srcSize)
+        return 0;
+
+    const auto srcData = static_cast<const char*>(src);
+    const auto destData = static_cast<char*>(dest);
+    const auto destLimit = static_cast<int>(ea::min(destCapacity, static_cast<unsigned>(M_MAX_INT)));
+    const CompressionDictionary* dictionary = settings.dictionary_;
+    const auto dictionaryData = dictionary ? reinterpret_cast<const char*>(dictionary->GetData().data()) : nullptr;
+    const int dictionarySize = dictionary ? static_cast<int>(dictionary->GetData().size()) : 0;
+
+    switch (settings.codec_)
+    {
+    case CompressionCodec::None:
+        if (srcSize > destCapacity)
+            return 0;
+        memcpy(dest, src, srcSize);
+        return srcSize;
+
+    case CompressionCodec::LZ4:
+    {
+        const int acceleration = ea::max(settings.level_, 1);
+        if (dictionarySize == 0)
+            return static_cast<unsigned>(LZ4_compress_fast(srcData, destData, srcSize, destLimit, acceleration));
+
+        LZ4_stream_t stream;
+        LZ4_resetStream(&stream);
+        LZ4_loadDict(&stream, dictionaryData, dictionarySize);
+        return static_cast<unsigned>(
+            LZ4_compress_fast_continue(&stream, srcData, destData, srcSize, destLimit, acceleration));
+    }
+
+    case CompressionCodec::LZ4HC:
+    {
+        const int level = Clamp(settings.level_, 0, LZ4HC_CLEVEL_MAX);
+        if (dictionarySize == 0)
+            return static_cast<unsigned>(LZ4_compress_HC(srcData, destData, srcSize, destLimit, level));
+
+        LZ4_streamHC_t* stream = LZ4_createStreamHC();
+        LZ4_resetStreamHC(stream, level);
+        LZ4_loadDictHC(stream, dictionaryData, dictionarySize);
+        const int result = LZ4_compress_HC_continue(stream, srcData, destData, srcSize, destLimit);
+        LZ4_freeStreamHC(stream);
+        return static_cast<unsigned>(result);
+    }
+
+    default:
+        return 0;
+    }
+}
+
+bool DecompressData(void* dest, unsigned destSize, const void* src, unsigned srcSize,
+    CompressionCodec codec, const CompressionDictionary* dictionary)
+{
+    if (!dest || !src || !destSize || !srcSize)
+        return false;
+
+    switch (codec)
+    {
+    case CompressionCodec::None:
+        if (srcSize != destSize)
+            return false;
+        memcpy(dest, src, srcSize);
+        return true;
+
+    case CompressionCodec::LZ4:
+    case CompressionCodec::LZ4HC:
+    {
+        const auto dictionaryData = dictionary ? reinterpret_cast<const char*>(dictionary->GetData().data()) : nullptr;
+        const int dictionarySize = dictionary ? static_cast<int>(dictionary->GetData().size()) : 0;
+        const int result = LZ4_decompress_safe_usingDict(static_cast<const char*>(src), static_cast<char*>(dest),
+            static_cast<int>(srcSize), static_cast<int>(destSize), dictionaryData, dictionarySize);
+        return result == static_cast<int>(destSize);
+    }
+
+    default:
+        return false;
+    }
+}
+
+ByteVector CompressBuffer(ConstByteSpan src, const CompressionSettings& settings)
+{
+    const unsigned srcSize = src.size();
+    const unsigned blockSize = ea::max(settings.blockSize_, 1u);
+    const unsigned numBlocks = (srcSize + blockSize - 1) / blockSize;
+
+    // Empty block means that compression didn't help and the block is stored as is
+    ea::vector<ByteVector> compressedBlocks(numBlocks);
+    const auto compressBlocks = [&](unsigned firstBlock, unsigned stride)
+    {
+        for (unsigned blockIndex = firstBlock; blockIndex < numBlocks; blockIndex += stride)
+        {
+            const unsigned offset = blockIndex * blockSize;
+            const unsigned size = ea::min(blockSize, srcSize - offset);
+            if (settings.codec_ == CompressionCodec::None)
+                continue;
+
+            ByteVector& block = compressedBlocks[blockIndex];
+            block.resize(EstimateCompressBound(size, settings.codec_));
+            const unsigned compressedSize = CompressData(block.data(), block.size(), &src[offset], size, settings);
+            block.resize(compressedSize < size ? compressedSize : 0);
+        }
+    };
+
+    const unsigned numThreads = ea::max(1u, ea::min(settings.numThreads_, numBlocks));
+    if (numThreads == 1)
+        compressBlocks(0, 1);
+    else
+    {
+        ea::vector<std::future<void>> tasks;
+        for (unsigned i = 1; i < numThreads; ++i)
+            tasks.push_back(std::async(std::launch::async, compressBlocks, i, numThreads));
+        compressBlocks(0, numThreads);
+        for (auto& task : tasks)
+            task.wait();
+    }
+
+    VectorBuffer result;
+    result.WriteFileID(CompressedFrameId);
+    result.WriteUByte(static_cast<unsigned char>(settings.codec_));
+    result.WriteUInt(settings.dictionary_ ? settings.dictionary_->GetHash() : 0);
+    result.WriteVLE(srcSize);
+    result.WriteVLE(blockSize);
+    for (unsigned blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+    {
+        const ByteVector& block = compressedBlocks[blockIndex];
+        result.WriteVLE(block.size());
+        if (!block.empty())
+            result.Write(block.data(), block.size());
+        else
+        {
+            const unsigned offset = blockIndex * blockSize;
+            result.Write(&src[offset], ea::min(blockSize, srcSize - offset));
+        }
+    }
+    return result.GetBuffer();
+}
+
+bool DecompressBuffer(ConstByteSpan src, ByteVector& dest, const CompressionDictionary* dictionary)
+{
+    MemoryBuffer buffer(src.data(), src.size());
+    if (buffer.GetSize() < 9 || buffer.ReadFileID() != CompressedFrameId)
+        return false;
+
+    const auto codec = static_cast<CompressionCodec>(buffer.ReadUByte());
+    if (codec > CompressionCodec::LZ4HC)
+        return false;
+
+    const unsigned dictionaryHash = buffer.ReadUInt();
+    if (dictionaryHash != 0 && (!dictionary || dictionary->GetHash() != dictionaryHash))
+        return false;
+
+    const unsigned destSize = buffer.ReadVLE();
+    const unsigned blockSize = buffer.ReadVLE();
+    if (blockSize == 0 && destSize != 0)
+        return false;
+
+    dest.resize(destSize);
+    for (unsigned offset = 0; offset < destSize; offset += blockSize)
+    {
+        const unsigned size = ea::min(blockSize, destSize - offset);
+        const unsigned compressedSize = buffer.ReadVLE();
+        const unsigned storedSize = compressedSize != 0 ? compressedSize : size;
+        if (buffer.IsEof() || storedSize > buffer.GetSize() - buffer.GetPosition())
+            return false;
+
+        const unsigned char* storedData = buffer.GetData() + buffer.GetPosition();
+        if (compressedSize == 0)
+            memcpy(&dest[offset], storedData, size);
+        else if (!DecompressData(&dest[offset], size, storedData, compressedSize, codec, dictionary))
+            return false;
+
+        buffer.Seek(buffer.GetPosition() + storedSize);
+    }
+    return true;
+}
+
 unsigned EstimateCompressBound(unsigned srcSize)
 {
     return (unsigned)LZ4_compressBound(srcSize);
@@ -24,6 +24,9 @@
 
 #include <Urho3D/Urho3D.h>
 
+#include "../Container/ByteVector.h"
+#include "../Container/Ptr.h"
+
 namespace Urho3D
 {
 
@@ -31,6 +34,75 @@ class Deserializer;
 class Serializer;
 class VectorBuffer;
 
+/// Compression codec.
+enum class CompressionCodec : unsigned char
+{
+    /// Data is stored as is.
+    None,
+    /// Fast LZ4. Level is acceleration, higher level is faster and compresses worse.
+    LZ4,
+    /// High compression LZ4. Level is from 1 to 12, higher level is slower and compresses better.
+    /// Decompression is as fast as for LZ4.
+    LZ4HC,
+};
+
+/// Shared dictionary for compression of small similar buffers, e.g. network messages.
+/// Compressed data can be decompressed only with the same dictionary.
+class URHO3D_API CompressionDictionary : public RefCounted
+{
+public:
+    /// Max size of the dictionary that is used by the codecs.
+    static const unsigned MaxSize = 64 * 1024;
+
+    /// Construct from raw data. Only the last MaxSize bytes are used.
+    explicit CompressionDictionary(ByteVector data);
+    /// Train dictionary from samples of typical data.
+    /// Byte sequences shared by most samples are selected, the most common sequences are placed at the end.
+    static SharedPtr<CompressionDictionary> Train(const ea::vector<ByteVector>& samples, unsigned maxSize = MaxSize);
+
+    /// Return dictionary data.
+    const ByteVector& GetData() const { return data_; }
+    /// Return hash of the dictionary data, never zero.
+    unsigned GetHash() const { return hash_; }
+
+private:
+    ByteVector data_;
+    unsigned hash_{};
+};
+
+/// Compression parameters.
+struct CompressionSettings
+{
+    /// Default size of independently compressed blocks used by CompressBuffer.
+    static const unsigned DefaultBlockSize = 1024 * 1024;
+
+    /// Codec.
+    CompressionCodec codec_{CompressionCodec::LZ4HC};
+    /// Codec-specific compression level. Zero is default.
+    int level_{};
+    /// Optional dictionary.
+    SharedPtr<CompressionDictionary> dictionary_;
+    /// Max number of threads used by CompressBuffer.
+    unsigned numThreads_{1};
+    /// Size of independently compressed blocks used by CompressBuffer.
+    unsigned blockSize_{DefaultBlockSize};
+};
+
+/// Estimate worst case compressed output size in bytes for given input size and codec.
+URHO3D_API unsigned EstimateCompressBound(unsigned srcSize, CompressionCodec codec);
+/// Compress data and return the compressed data size, or 0 if the data doesn't fit into the destination.
+URHO3D_API unsigned CompressData(
+    void* dest, unsigned destCapacity, const void* src, unsigned srcSize, const CompressionSettings& settings);
+/// Decompress data produced by CompressData with the same codec and dictionary.
+/// Malformed input is detected. Return true if exactly destSize bytes are decompressed.
+URHO3D_API bool DecompressData(void* dest, unsigned destSize, const void* src, unsigned srcSize,
+    CompressionCodec codec, const CompressionDictionary* dictionary = nullptr);
+/// Compress buffer into a self-describing frame with codec, dictionary hash and size.
+/// Large buffers are split into blocks that are compressed in parallel if allowed by settings.
+URHO3D_API ByteVector CompressBuffer(ConstByteSpan src, const CompressionSettings& settings);
+/// Decompress frame produced by CompressBuffer. Dictionary should be the same as used for compression.
+URHO3D_API bool DecompressBuffer(ConstByteSpan src, ByteVector& dest, const CompressionDictionary* dictionary = nullptr);
+
 /// Estimate and return worst case LZ4 compressed output size in bytes for given input size.
 URHO3D_API unsigned EstimateCompressBound(unsigned srcSize);
 /// Compress data using the LZ4 algorithm and return the compressed data size. The needed destination buffer worst-case size is given by EstimateCompressBound().
@@ -0,0 +1,171 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../IO/ContentHash.h"
+
+#include "../Core/Format.h"
+#include "../IO/Deserializer.h"
+
+#include <cstring>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const unsigned long long prime1 = 0x9E3779B185EBCA87ull;
+const unsigned long long prime2 = 0xC2B2AE3D27D4EB4Full;
+const unsigned long long prime3 = 0x165667B19E3779F9ull;
+const unsigned long long prime4 = 0x85EBCA77C2B2AE63ull;
+const unsigned long long prime5 = 0x27D4EB2F165667C5ull;
+
+inline unsigned long long RotateLeft(unsigned long long value, unsigned bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline unsigned long long Read64(const unsigned char* ptr)
+{
+    unsigned long long value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+inline unsigned long long Read32(const unsigned char* ptr)
+{
+    unsigned value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+inline unsigned long long Round(unsigned long long acc, unsigned long long input)
+{
+    acc += input * prime2;
+    acc = RotateLeft(acc, 31);
+    return acc * prime1;
+}
+
+inline unsigned long long MergeRound(unsigned long long acc, unsigned long long value)
+{
+    acc ^= Round(0, value);
+    return acc * prime1 + prime4;
+}
+
+}
+
+unsigned long long MakeContentHash(const void* data, unsigned size, unsigned long long seed)
+{
+    // Engine supports only little-endian platforms, so no byte swapping is needed
+    const auto* ptr = static_cast<const unsigned char*>(data);
+    const unsigned char* const end = ptr + size;
+
+    unsigned long long hash{};
+    if (size >= 32)
+    {
+        unsigned long long v1 = seed + prime1 + prime2;
+        unsigned long long v2 = seed + prime2;
+        unsigned long long v3 = seed;
+        unsigned long long v4 = seed - prime1;
+
+        const unsigned char* const limit = end - 32;
+        do
+        {
+            v1 = Round(v1, Read64(ptr));
+            v2 = Round(v2, Read64(ptr + 8));
+            v3 = Round(v3, Read64(ptr + 16));
+            v4 = Round(v4, Read64(ptr + 24));
+            ptr += 32;
+        } while (ptr <= limit);
+
+        hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+        hash = MergeRound(hash, v1);
+        hash = MergeRound(hash, v2);
+        hash = MergeRound(hash, v3);
+        hash = MergeRound(hash, v4);
+    }
+    else
+    {
+        hash = seed + prime5;
+    }
+
+    hash += size;
+
+    for (; ptr + 8 <= end; ptr += 8)
+    {
+        hash ^= Round(0, Read64(ptr));
+        hash = RotateLeft(hash, 27) * prime1 + prime4;
+    }
+
+    if (ptr + 4 <= end)
+    {
+        hash ^= Read32(ptr) * prime1;
+        hash = RotateLeft(hash, 23) * prime2 + prime3;
+        ptr += 4;
+    }
+
+    for (; ptr < end; ++ptr)
+    {
+        hash ^= *ptr * prime5;
+        hash = RotateLeft(hash, 11) * prime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+void ContentHasher::Append(ea::string_view value)
+{
+    Append(static_cast<unsigned long long>(value.size()));
+    Append(value.data(), value.size());
+}
+
+unsigned ContentHasher::Append(Deserializer& source)
+{
+    unsigned char buffer[65536];
+    unsigned totalSize = 0;
+    while (!source.IsEof())
+    {
+        const unsigned size = source.Read(buffer, sizeof(buffer));
+        if (size == 0)
+            break;
+
+        Append(buffer, size);
+        totalSize += size;
+    }
+    return totalSize;
+}
+
+ea::string ContentHasher::ToString() const
+{
+    return Format("{:016x}", hash_);
+}
+
+}
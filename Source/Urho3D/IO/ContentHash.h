@@ -0,0 +1,64 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+
+#include <EASTL/string.h>
+#include <EASTL/string_view.h>
+
+namespace Urho3D
+{
+
+class Deserializer;
+
+/// Calculate 64-bit hash of the data. Result is stable across platforms and runs and matches XXH64.
+/// Should be used to detect changes of the content, not for security.
+URHO3D_API unsigned long long MakeContentHash(const void* data, unsigned size, unsigned long long seed = 0);
+
+/// Helper to calculate content hash of multiple values. Each value affects the hash of the following ones.
+class URHO3D_API ContentHasher
+{
+public:
+    ContentHasher() = default;
+    explicit ContentHasher(unsigned long long seed) : hash_(seed) {}
+
+    /// Append raw data.
+    void Append(const void* data, unsigned size) { hash_ = MakeContentHash(data, size, hash_); }
+    /// Append string with its size, so that sequence of strings is hashed unambiguously.
+    void Append(ea::string_view value);
+    /// Append integer value.
+    void Append(unsigned long long value) { Append(&value, sizeof(value)); }
+    /// Append the rest of the stream. Return number of bytes read.
+    unsigned Append(Deserializer& source);
+
+    /// Return current hash.
+    unsigned long long GetHash() const { return hash_; }
+    /// Return current hash as hexadecimal string of fixed length.
+    ea::string ToString() const;
+
+private:
+    unsigned long long hash_{};
+};
+
+}
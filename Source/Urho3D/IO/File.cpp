@@ -23,6 +23,7 @@
 #include "../Precompiled.h"
 
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../IO/File.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
@@ -151,10 +152,33 @@ bool File::Open(PackageFile* package, const ea::string& fileName)
     offset_ = entry->offset_;
     checksum_ = entry->checksum_;
     size_ = entry->size_;
-    compressed_ = package->IsCompressed();
+    compressed_ = entry->compression_ != PackageCompression::None;
+    blockOffsets_.clear();
+    blockSize_ = 0;
+    readBlockIndex_ = M_MAX_UNSIGNED;
 
     // Seek to beginning of package entry's file data
     SeekInternal(offset_);
+
+    // Read block offset table, data is read on demand
+    if (compressed_ && package->HasBlockIndex())
+    {
+        blockSize_ = package->GetBlockSize();
+        const unsigned numBlocks = (size_ + blockSize_ - 1) / blockSize_;
+
+        ByteVector tableData((numBlocks + 1) * sizeof(unsigned));
+        if (!ReadInternal(tableData.data(), tableData.size()))
+        {
+            URHO3D_LOGERROR("Could not read block table of package entry " + fileName);
+            Close();
+            return false;
+        }
+
+        MemoryBuffer table(tableData);
+        blockOffsets_.resize(numBlocks + 1);
+        for (unsigned& blockOffset : blockOffsets_)
+            blockOffset = table.ReadUInt();
+    }
     return true;
 }
 
@@ -212,6 +236,9 @@ unsigned File::Read(void* dest, unsigned size)
     }
 #endif
 
+    if (compressed_ && !blockOffsets_.empty())
+        return ReadIndexedBlocks(static_cast<unsigned char*>(dest), size);
+
     if (compressed_)
     {
         unsigned sizeLeft = size;
@@ -273,6 +300,104 @@ unsigned File::Read(void* dest, unsigned size)
     return size;
 }
 
+unsigned File::ReadIndexedBlocks(unsigned char* dest, unsigned size)
+{
+    const unsigned numBlocks = blockOffsets_.size() - 1;
+    const unsigned endPosition = position_ + size;
+    const unsigned endBlockIndex = endPosition == size_ ? numBlocks : endPosition / blockSize_;
+
+    unsigned sizeLeft = size;
+    while (sizeLeft)
+    {
+        const unsigned blockIndex = position_ / blockSize_;
+        const unsigned offsetInBlock = position_ % blockSize_;
+
+        // Decompress whole blocks directly into destination, possibly in parallel
+        if (offsetInBlock == 0 && endBlockIndex > blockIndex + 1)
+        {
+            const unsigned numWholeBlocks = endBlockIndex - blockIndex;
+            if (!DecompressBlocks(blockIndex, numWholeBlocks, dest))
+                break;
+
+            const unsigned copySize = ea::min(numWholeBlocks * blockSize_, sizeLeft);
+            dest += copySize;
+            sizeLeft -= copySize;
+            position_ += copySize;
+            continue;
+        }
+
+        if (readBlockIndex_ != blockIndex)
+        {
+            if (!readBuffer_)
+                readBuffer_ = new unsigned char[blockSize_];
+
+            if (!DecompressBlocks(blockIndex, 1, readBuffer_.get()))
+                break;
+            readBlockIndex_ = blockIndex;
+        }
+
+        const unsigned blockSize = ea::min(blockSize_, size_ - blockIndex * blockSize_);
+        const unsigned copySize = ea::min(blockSize - offsetInBlock, sizeLeft);
+        memcpy(dest, readBuffer_.get() + offsetInBlock, copySize);
+        dest += copySize;
+        sizeLeft -= copySize;
+        position_ += copySize;
+    }
+
+    if (sizeLeft)
+        URHO3D_LOGERROR("Error while decompressing file " + GetName());
+    return size - sizeLeft;
+}
+
+bool File::DecompressBlocks(unsigned firstBlock, unsigned numBlocks, unsigned char* dest)
+{
+    // Read packed data of all blocks at once
+    const unsigned packedBegin = blockOffsets_[firstBlock];
+    const unsigned packedEnd = blockOffsets_[firstBlock + numBlocks];
+    if (packedEnd < packedBegin)
+        return false;
+
+    ByteVector packedData(packedEnd - packedBegin);
+    SeekInternal(offset_ + packedBegin);
+    if (!ReadInternal(packedData.data(), packedData.size()))
+        return false;
+
+    std::atomic<bool> success{true};
+    const auto decompressBlock = [&](unsigned index)
+    {
+        const unsigned blockIndex = firstBlock + index;
+        const unsigned packedOffset = blockOffsets_[blockIndex] - packedBegin;
+        const unsigned packedSize = blockOffsets_[blockIndex + 1] - blockOffsets_[blockIndex];
+        const unsigned unpackedSize = ea::min(blockSize_, size_ - blockIndex * blockSize_);
+        unsigned char* blockDest = dest + index * blockSize_;
+
+        // Blocks that don't benefit from compression are stored as is
+        if (packedSize == unpackedSize)
+            memcpy(blockDest, packedData.data() + packedOffset, unpackedSize);
+        else if (LZ4_decompress_safe(reinterpret_cast<const char*>(packedData.data() + packedOffset),
+            reinterpret_cast<char*>(blockDest), packedSize, unpackedSize) != static_cast<int>(unpackedSize))
+            success = false;
+    };
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    if (numBlocks > 1 && workQueue && workQueue->IsMultithreaded() && WorkQueue::IsProcessingThread())
+    {
+        ForEachParallel(workQueue, 1u, numBlocks,
+            [&](unsigned beginIndex, unsigned endIndex)
+        {
+            for (unsigned index = beginIndex; index < endIndex; ++index)
+                decompressBlock(index);
+        });
+    }
+    else
+    {
+        for (unsigned index = 0; index < numBlocks; ++index)
+            decompressBlock(index);
+    }
+
+    return success;
+}
+
 unsigned File::Seek(unsigned position)
 {
     if (!IsOpen())
@@ -285,6 +410,13 @@ unsigned File::Seek(unsigned position)
     if (mode_ == FILE_READ && position > size_)
         position = size_;
 
+    // Blocks are decompressed on demand
+    if (compressed_ && !blockOffsets_.empty())
+    {
+        position_ = position;
+        return position_;
+    }
+
     if (compressed_)
     {
         // Start over from the beginning
@@ -401,6 +533,8 @@ void File::Close()
 
     readBuffer_.reset();
     inputBuffer_.reset();
+    blockOffsets_.clear();
+    readBlockIndex_ = M_MAX_UNSIGNED;
 
     if (handle_)
     {
@@ -432,6 +566,18 @@ void File::Flush()
         fflush((FILE*)handle_);
 }
 
+ea::optional<NativeFileRange> File::GetNativeFileRange() const
+{
+#ifdef __ANDROID__
+    if (assetHandle_)
+        return ea::nullopt;
+#endif
+    if (!handle_ || compressed_ || mode_ != FILE_READ)
+        return ea::nullopt;
+
+    return NativeFileRange{handle_, static_cast<unsigned long long>(offset_) + position_, size_ - position_};
+}
+
 bool File::IsOpen() const
 {
 #ifdef __ANDROID__
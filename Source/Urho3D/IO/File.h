@@ -96,6 +96,8 @@ public:
     /// Return whether is open.
     /// @property
     bool IsOpen() const override;
+    /// Return remaining data of the file as the range of native file. Not supported for compressed and Android asset files.
+    ea::optional<NativeFileRange> GetNativeFileRange() const override;
 
     /// Return the file handle.
     void* GetHandle() const { return handle_; }
@@ -127,6 +129,10 @@ private:
     bool ReadInternal(void* dest, unsigned size);
     /// Seek in file internally using either C standard IO functions or SDL RWops for Android asset files.
     void SeekInternal(unsigned newPosition);
+    /// Read from compressed package entry with block offset table. Return number of bytes actually read.
+    unsigned ReadIndexedBlocks(unsigned char* dest, unsigned size);
+    /// Read and decompress consecutive blocks into destination buffer. Return true if successful.
+    bool DecompressBlocks(unsigned firstBlock, unsigned numBlocks, unsigned char* dest);
 
     /// Absolute file name.
     ea::string absoluteFileName_;
@@ -142,6 +148,12 @@ private:
     ea::shared_array<unsigned char> readBuffer_;
     /// Decompression input buffer for compressed file loading.
     ea::shared_array<unsigned char> inputBuffer_;
+    /// Offsets of compressed blocks relative to the entry start, if the package has block index. Contains one extra element for the end.
+    ea::vector<unsigned> blockOffsets_;
+    /// Size of uncompressed block.
+    unsigned blockSize_{};
+    /// Index of the block currently stored in read buffer.
+    unsigned readBlockIndex_{M_MAX_UNSIGNED};
     /// Read buffer position.
     unsigned readBufferOffset_;
     /// Bytes in the current read buffer.
@@ -33,6 +33,7 @@
 #elif __linux__
 #include <sys/inotify.h>
 #include <sys/ioctl.h>
+#include <cerrno>
 extern "C"
 {
 // Need read/close for inotify
@@ -48,7 +49,11 @@ extern "C"
 namespace Urho3D
 {
 #ifndef __APPLE__
-static const unsigned BUFFERSIZE = 4096;
+// Large enough to receive bursts of changes without overflowing the queue of the watcher
+static const unsigned BUFFERSIZE = 64 * 1024;
+#endif
+#ifdef __linux__
+static const unsigned INOTIFY_FLAGS = IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO;
 #endif
 
 FileWatcher::FileWatcher(Context* context) :
@@ -117,44 +122,21 @@ bool FileWatcher::StartWatching(const ea::string& pathName, bool watchSubDirs)
         return false;
     }
 #elif defined(__linux__)
-    int flags = IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO;
-    int handle = inotify_add_watch(watchHandle_, pathName.c_str(), (unsigned)flags);
+    path_ = AddTrailingSlash(pathName);
+    watchSubDirs_ = watchSubDirs;
+    watchLimitReached_ = false;
 
-    if (handle < 0)
+    // Store the root path here when reconstructed with inotify later
+    if (!AddDirectoryWatch(""))
     {
         URHO3D_LOGERROR("Failed to start watching path " + pathName);
+        path_.clear();
         return false;
     }
     else
     {
-        // Store the root path here when reconstructed with inotify later
-        dirHandle_[handle] = "";
-        path_ = AddTrailingSlash(pathName);
-        watchSubDirs_ = watchSubDirs;
-
         if (watchSubDirs_)
-        {
-            ea::vector<ea::string> subDirs;
-            fileSystem_->ScanDir(subDirs, pathName, "*", SCAN_DIRS | SCAN_RECURSIVE);
-
-            for (unsigned i = 0; i < subDirs.size(); ++i)
-            {
-                ea::string subDirFullPath = AddTrailingSlash(path_ + subDirs[i]);
-
-                // Don't watch ./ or ../ sub-directories
-                if (!subDirFullPath.ends_with("./"))
-                {
-                    handle = inotify_add_watch(watchHandle_, subDirFullPath.c_str(), (unsigned)flags);
-                    if (handle < 0)
-                        URHO3D_LOGERROR("Failed to start watching subdirectory path " + subDirFullPath);
-                    else
-                    {
-                        // Store sub-directory to reconstruct later from inotify
-                        dirHandle_[handle] = AddTrailingSlash(subDirs[i]);
-                    }
-                }
-            }
-        }
+            WatchSubtree("", false);
         Run();
 
         URHO3D_LOGDEBUG("Started watching path " + pathName);
@@ -209,7 +191,7 @@ void FileWatcher::StopWatching()
             fileSystem_->Delete(dummyFileName);
 #endif
 
-#if defined(__APPLE__) && !defined(IOS) && !defined(TVOS)
+#if (defined(__APPLE__) && !defined(IOS) && !defined(TVOS)) || defined(__linux__)
         // Our implementation of file watcher requires the thread to be stopped first before closing the watcher
         Stop();
 #endif
@@ -224,7 +206,7 @@ void FileWatcher::StopWatching()
         CloseFileWatcher(watcher_);
 #endif
 
-#ifndef __APPLE__
+#if !defined(__APPLE__) && !defined(__linux__)
         Stop();
 #endif
 
@@ -244,7 +226,8 @@ void FileWatcher::ThreadFunction()
     URHO3D_PROFILE_THREAD("FileWatcher Thread");
 
 #ifdef _WIN32
-    unsigned char buffer[BUFFERSIZE];
+    ea::vector<unsigned char> bufferStorage(BUFFERSIZE);
+    unsigned char* buffer = bufferStorage.data();
     DWORD bytesFilled = 0;
 
     while (shouldRun_)
@@ -260,6 +243,13 @@ void FileWatcher::ThreadFunction()
             nullptr,
             nullptr))
         {
+            // Buffer overflow, changes are lost
+            if (bytesFilled == 0 && shouldRun_)
+            {
+                AddChange({FILECHANGE_MODIFIED, EMPTY_STRING, EMPTY_STRING});
+                continue;
+            }
+
             unsigned offset = 0;
             FileChange rename{FILECHANGE_RENAMED, EMPTY_STRING, EMPTY_STRING};
 
@@ -300,7 +290,8 @@ void FileWatcher::ThreadFunction()
         }
     }
 #elif defined(__linux__)
-    unsigned char buffer[BUFFERSIZE];
+    ea::vector<unsigned char> bufferStorage(BUFFERSIZE);
+    unsigned char* buffer = bufferStorage.data();
 
     while (shouldRun_)
     {
@@ -314,7 +305,7 @@ void FileWatcher::ThreadFunction()
         }
 
         int i = 0;
-        auto length = (int)read(watchHandle_, buffer, Min(available, sizeof(buffer)));
+        auto length = (int)read(watchHandle_, buffer, Min(available, BUFFERSIZE));
 
         if (length < 0)
             return;
@@ -324,10 +315,34 @@ void FileWatcher::ThreadFunction()
         {
             auto* event = (inotify_event*)&buffer[i];
 
-            if (event->len > 0)
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                // Queue overflow, changes are lost
+                AddChange({FILECHANGE_MODIFIED, EMPTY_STRING, EMPTY_STRING});
+            }
+            else if (event->mask & IN_IGNORED)
+            {
+                // Watch was removed because the directory was deleted
+                dirHandle_.erase(event->wd);
+            }
+            else if (event->len > 0 && dirHandle_.contains(event->wd))
             {
                 ea::string fileName = dirHandle_[event->wd] + event->name;
 
+                // Keep watches in sync with directory tree and notify about the files of added subtree,
+                // they may have been created before the watch was added
+                if (watchSubDirs_ && (event->mask & IN_ISDIR))
+                {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                    {
+                        const ea::string subDir = AddTrailingSlash(fileName);
+                        if (AddDirectoryWatch(subDir))
+                            WatchSubtree(subDir, true);
+                    }
+                    else if (event->mask & IN_MOVED_FROM)
+                        UnwatchSubtree(AddTrailingSlash(fileName));
+                }
+
                 if ((event->mask & IN_CREATE) == IN_CREATE)
                     AddChange({FILECHANGE_ADDED, fileName, EMPTY_STRING});
                 else if ((event->mask & IN_DELETE) == IN_DELETE)
@@ -393,6 +408,65 @@ void FileWatcher::ThreadFunction()
 #endif
 }
 
+#if defined(URHO3D_FILEWATCHER) && defined(__linux__)
+bool FileWatcher::AddDirectoryWatch(const ea::string& subDir)
+{
+    const ea::string fullPath = path_ + subDir;
+    const int handle = inotify_add_watch(watchHandle_, fullPath.c_str(), INOTIFY_FLAGS);
+    if (handle < 0)
+    {
+        if (errno != ENOSPC)
+            URHO3D_LOGERROR("Failed to start watching subdirectory path " + fullPath);
+        else if (!watchLimitReached_)
+        {
+            URHO3D_LOGERROR("Limit of inotify watches is reached, some subdirectories of {} are not watched. "
+                "Increase fs.inotify.max_user_watches to watch them", path_);
+            watchLimitReached_ = true;
+        }
+        return false;
+    }
+
+    // Store sub-directory to reconstruct later from inotify
+    dirHandle_[handle] = subDir;
+    return true;
+}
+
+void FileWatcher::WatchSubtree(const ea::string& subDir, bool notifyFiles)
+{
+    ea::vector<ea::string> subDirs;
+    fileSystem_->ScanDir(subDirs, path_ + subDir, "*", SCAN_DIRS | SCAN_RECURSIVE);
+    for (const ea::string& nestedDir : subDirs)
+    {
+        // Don't watch ./ or ../ sub-directories
+        const ea::string nestedPath = AddTrailingSlash(subDir + nestedDir);
+        if (!nestedPath.ends_with("./"))
+            AddDirectoryWatch(nestedPath);
+    }
+
+    if (notifyFiles)
+    {
+        ea::vector<ea::string> files;
+        fileSystem_->ScanDir(files, path_ + subDir, "*", SCAN_FILES | SCAN_RECURSIVE);
+        for (const ea::string& fileName : files)
+            AddChange({FILECHANGE_ADDED, subDir + fileName, EMPTY_STRING});
+    }
+}
+
+void FileWatcher::UnwatchSubtree(const ea::string& subDir)
+{
+    for (auto iter = dirHandle_.begin(); iter != dirHandle_.end();)
+    {
+        if (iter->second.starts_with(subDir))
+        {
+            inotify_rm_watch(watchHandle_, iter->first);
+            iter = dirHandle_.erase(iter);
+        }
+        else
+            ++iter;
+    }
+}
+#endif
+
 void FileWatcher::AddChange(const FileChange& change)
 {
     MutexLock lock(changesMutex_);
@@ -429,4 +503,23 @@ bool FileWatcher::GetNextChange(FileChange& dest)
     }
 }
 
+bool FileWatcher::GetNextChanges(ea::vector<FileChange>& dest)
+{
+    MutexLock lock(changesMutex_);
+
+    const auto delayMsec = (unsigned)(delay_ * 1000.0f);
+    const unsigned oldSize = dest.size();
+    for (auto i = changes_.begin(); i != changes_.end();)
+    {
+        if (i->second.timer_.GetMSec(false) >= delayMsec)
+        {
+            dest.push_back(ea::move(i->second.change_));
+            i = changes_.erase(i);
+        }
+        else
+            ++i;
+    }
+    return dest.size() != oldSize;
+}
+
 }
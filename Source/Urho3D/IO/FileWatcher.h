@@ -45,6 +45,7 @@ enum FileChangeKind
 };
 
 /// File change information.
+/// Change with empty file name means that some changes were lost and the whole watched directory should be rescanned.
 struct FileChange
 {
     /// File change kind.
@@ -80,6 +81,8 @@ public:
     void AddChange(const FileChange& change);
     /// Return a file change (true if was found, false if not).
     bool GetNextChange(FileChange& dest);
+    /// Append all file changes that are ready to be notified. Return true if any was found.
+    bool GetNextChanges(ea::vector<FileChange>& dest);
 
     /// Return the path being watched, or empty if not watching.
     const ea::string& GetPath() const { return path_; }
@@ -116,10 +119,19 @@ private:
 
 #elif __linux__
 
+    /// Add watch for the sub-directory relative to the watched path. Return true if successful.
+    bool AddDirectoryWatch(const ea::string& subDir);
+    /// Add watches for all directories in the subtree and optionally notify that all files in it are added.
+    void WatchSubtree(const ea::string& subDir, bool notifyFiles);
+    /// Remove watches of all directories in the subtree.
+    void UnwatchSubtree(const ea::string& subDir);
+
     /// HashMap for the directory and sub-directories (needed for inotify's int handles).
     ea::unordered_map<int, ea::string> dirHandle_;
     /// Linux inotify needs a handle.
     int watchHandle_;
+    /// Whether the limit of inotify watches was reached. Reported only once.
+    bool watchLimitReached_{};
 
 #elif defined(__APPLE__) && !defined(IOS) && !defined(TVOS)
 
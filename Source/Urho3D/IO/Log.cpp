@@ -39,10 +39,16 @@
 #else
 #include <spdlog/sinks/stdout_sinks.h>
 #endif
+#include <spdlog/details/log_msg_buffer.h>
+#include <spdlog/details/mpmc_blocking_q.h>
 #include <spdlog/details/null_mutex.h>
 
+#include <EASTL/unordered_map.h>
+
+#include <atomic>
 #include <mutex>
 #include <cstdio>
+#include <thread>
 
 #ifdef __ANDROID__
 #include <android/log.h>
@@ -142,6 +148,165 @@ private:
     ea::vector<MessageInfo> lastMessages_;
 };
 
+/// Limits number of messages per second for individual loggers.
+class RateLimitSink : public spdlog::sinks::dist_sink_mt
+{
+public:
+    using BaseClass = spdlog::sinks::dist_sink_mt;
+
+    void SetLimit(const ea::string& loggerName, unsigned maxMessagesPerSecond)
+    {
+        std::lock_guard<std::mutex> lock(BaseClass::mutex_);
+        const size_t hash = ea::hash<ea::string_view>{}(loggerName);
+        if (maxMessagesPerSecond != 0)
+            limits_[hash].maxMessagesPerSecond_ = maxMessagesPerSecond;
+        else
+            limits_.erase(hash);
+    }
+
+private:
+    struct LimitInfo
+    {
+        unsigned maxMessagesPerSecond_{};
+        spdlog::log_clock::time_point intervalStart_;
+        unsigned numMessages_{};
+        unsigned numSkipped_{};
+    };
+
+    void sink_it_(const spdlog::details::log_msg& msg) override
+    {
+        if (!limits_.empty())
+        {
+            const ea::string_view loggerName{msg.logger_name.data(), msg.logger_name.size()};
+            const auto iter = limits_.find(ea::hash<ea::string_view>{}(loggerName));
+            if (iter != limits_.end() && !CheckLimit(msg, iter->second))
+                return;
+        }
+
+        BaseClass::sink_it_(msg);
+    }
+
+    bool CheckLimit(const spdlog::details::log_msg& msg, LimitInfo& info)
+    {
+        if (msg.time - info.intervalStart_ >= std::chrono::seconds(1))
+        {
+            if (info.numSkipped_ > 0)
+            {
+                char buf[64];
+                const auto msgSize = ::snprintf(buf, sizeof(buf), "Skipped %u messages over rate limit..", info.numSkipped_);
+                if (msgSize > 0 && static_cast<size_t>(msgSize) < sizeof(buf))
+                {
+                    const spdlog::details::log_msg skippedMsg{msg.logger_name, spdlog::level::warn,
+                        spdlog::string_view_t{buf, static_cast<size_t>(msgSize)}};
+                    BaseClass::sink_it_(skippedMsg);
+                }
+            }
+
+            info.intervalStart_ = msg.time;
+            info.numMessages_ = 0;
+            info.numSkipped_ = 0;
+        }
+
+        if (info.numMessages_ >= info.maxMessagesPerSecond_)
+        {
+            ++info.numSkipped_;
+            return false;
+        }
+
+        ++info.numMessages_;
+        return true;
+    }
+
+    ea::unordered_map<size_t, LimitInfo> limits_;
+};
+
+/// Queues messages and writes them to the target sink from the dedicated thread.
+/// The caller only copies the message into bounded queue and never waits for actual output.
+class AsyncSink : public spdlog::sinks::sink
+{
+public:
+    AsyncSink(std::shared_ptr<spdlog::sinks::sink> target, unsigned queueSize, LogOverflowPolicy overflowPolicy)
+        : target_(ea::move(target))
+        , overflowPolicy_(overflowPolicy)
+        , queue_(ea::max(queueSize, 1u))
+    {
+        thread_ = std::thread([this] { ProcessMessages(); });
+    }
+
+    ~AsyncSink() override
+    {
+        isStopped_.store(true, std::memory_order_relaxed);
+        thread_.join();
+    }
+
+    void log(const spdlog::details::log_msg& msg) override
+    {
+        if (overflowPolicy_ == LogOverflowPolicy::Block)
+            queue_.enqueue(spdlog::details::log_msg_buffer{msg});
+        else
+            queue_.enqueue_nowait(spdlog::details::log_msg_buffer{msg});
+    }
+
+    void flush() override { isFlushRequested_.store(true, std::memory_order_relaxed); }
+
+    void set_pattern(const std::string& pattern) override { target_->set_pattern(pattern); }
+
+    void set_formatter(std::unique_ptr<spdlog::formatter> sinkFormatter) override
+    {
+        target_->set_formatter(std::move(sinkFormatter));
+    }
+
+private:
+    void ProcessMessages()
+    {
+        spdlog::details::log_msg_buffer msg;
+        while (true)
+        {
+            if (queue_.dequeue_for(msg, std::chrono::milliseconds(10)))
+            {
+                ReportOverrun(msg);
+                target_->log(msg);
+                continue;
+            }
+
+            // Queue is empty here
+            if (isFlushRequested_.exchange(false, std::memory_order_relaxed))
+                target_->flush();
+
+            if (isStopped_.load(std::memory_order_relaxed))
+                break;
+        }
+
+        target_->flush();
+    }
+
+    void ReportOverrun(const spdlog::details::log_msg& msg)
+    {
+        const size_t numOverruns = queue_.overrun_counter();
+        if (numOverruns == numReportedOverruns_)
+            return;
+
+        char buf[64];
+        const auto numDropped = static_cast<unsigned>(numOverruns - numReportedOverruns_);
+        const auto msgSize = ::snprintf(buf, sizeof(buf), "Dropped %u messages on log queue overflow..", numDropped);
+        if (msgSize > 0 && static_cast<size_t>(msgSize) < sizeof(buf))
+        {
+            const spdlog::details::log_msg droppedMsg{msg.logger_name, spdlog::level::warn,
+                spdlog::string_view_t{buf, static_cast<size_t>(msgSize)}};
+            target_->log(droppedMsg);
+        }
+        numReportedOverruns_ = numOverruns;
+    }
+
+    const std::shared_ptr<spdlog::sinks::sink> target_;
+    const LogOverflowPolicy overflowPolicy_;
+    spdlog::details::mpmc_blocking_queue<spdlog::details::log_msg_buffer> queue_;
+    std::thread thread_;
+    std::atomic<bool> isStopped_{};
+    std::atomic<bool> isFlushRequested_{};
+    size_t numReportedOverruns_{};
+};
+
 }
 
 static Log* GetLog()
@@ -251,7 +416,9 @@ protected:
         if (logInstance == nullptr)
             return;
         time_t time = std::chrono::system_clock::to_time_t(msg.time);
-        logInstance->SendMessageEvent(ConvertLogLevel(msg.level), time, msg.logger_name.data(), ea::string(msg.payload.data(),
+        // Buffered messages of asynchronous mode store logger name without null terminator
+        const ea::string loggerName(msg.logger_name.data(), static_cast<unsigned>(msg.logger_name.size()));
+        logInstance->SendMessageEvent(ConvertLogLevel(msg.level), time, loggerName, ea::string(msg.payload.data(),
             static_cast<unsigned int>(msg.payload.size())));
     }
 
@@ -325,7 +492,24 @@ public:
             std::chrono::seconds(5), spdlog::level::err, 10);
         dupFilterSink_->add_sink(distributorSink_);
 
-        mainSink_ = dupFilterSink_;
+        rateLimitSink_ = std::make_shared<RateLimitSink>();
+        rateLimitSink_->add_sink(dupFilterSink_);
+
+        mainSink_ = rateLimitSink_;
+    }
+
+    /// Insert or remove asynchronous queue between rate limiting and the rest of sinks.
+    void SetAsync(bool enable, unsigned queueSize, LogOverflowPolicy overflowPolicy)
+    {
+        // Replace the queue first so the old one is drained after it's detached
+        std::shared_ptr<AsyncSink> oldAsyncSink = ea::move(asyncSink_);
+        if (enable)
+        {
+            asyncSink_ = std::make_shared<AsyncSink>(dupFilterSink_, queueSize, overflowPolicy);
+            rateLimitSink_->set_sinks({asyncSink_});
+        }
+        else
+            rateLimitSink_->set_sinks({dupFilterSink_});
     }
 
 #ifdef __ANDROID__
@@ -351,6 +535,10 @@ public:
     std::shared_ptr<spdlog::sinks::dist_sink_mt> distributorSink_;
     /// Sink that filters out duplicate messages.
     std::shared_ptr<DuplicateFilterSink> dupFilterSink_;
+    /// Sink that limits number of messages per logger.
+    std::shared_ptr<RateLimitSink> rateLimitSink_;
+    /// Sink that writes messages from the dedicated thread, if asynchronous logging is enabled.
+    std::shared_ptr<AsyncSink> asyncSink_;
 
     /// Sink that should be used for logging.
     std::shared_ptr<spdlog::sinks::sink> mainSink_;
@@ -372,6 +560,8 @@ Log::Log(Context* context) :
 
 Log::~Log()
 {
+    // Drain the queue while the rest of sinks is alive
+    impl_->SetAsync(false, 0, LogOverflowPolicy::Block);
     spdlog::shutdown();
 }
 
@@ -421,6 +611,21 @@ void Log::SetQuiet(bool quiet)
     impl_->platformSink_->set_level(ConvertLogLevel(quiet ? LOG_NONE : level_));
 }
 
+void Log::SetAsync(bool enable, unsigned queueSize, LogOverflowPolicy overflowPolicy)
+{
+    impl_->SetAsync(enable, queueSize, overflowPolicy);
+}
+
+bool Log::IsAsync() const
+{
+    return impl_->asyncSink_ != nullptr;
+}
+
+void Log::SetRateLimit(const ea::string& loggerName, unsigned maxMessagesPerSecond)
+{
+    impl_->rateLimitSink_->SetLimit(loggerName, maxMessagesPerSecond);
+}
+
 void Log::SetLogFormat(const ea::string& format)
 {
     formatPattern_ = format;
@@ -77,6 +77,15 @@ static const char* logLevelNames[] =
     nullptr
 };
 
+/// Policy of asynchronous logging when the message queue is full.
+enum class LogOverflowPolicy
+{
+    /// Block the caller until there is room in the queue.
+    Block,
+    /// Discard the oldest message in the queue.
+    DiscardOldest,
+};
+
 class File;
 
 /// Stored log message from another thread.
@@ -144,6 +153,9 @@ class URHO3D_API Log : public Object
     void SendMessageEvent(LogLevel level, time_t timestamp, const ea::string& logger, const ea::string& message);
 
 public:
+    /// Default size of the message queue for asynchronous logging.
+    static const unsigned DefaultAsyncQueueSize = 8192;
+
     /// Construct.
     explicit Log(Context* context);
     /// Destruct. Close the log file if open.
@@ -162,6 +174,13 @@ public:
     /// Set quiet mode ie. only print error entries to standard error stream (which is normally redirected to console also). Output to log file is not affected by this mode.
     /// @property
     void SetQuiet(bool quiet);
+    /// Enable or disable asynchronous logging. When enabled, messages are queued and written to sinks
+    /// by the dedicated thread, so logging threads never wait for console or file output.
+    void SetAsync(bool enable, unsigned queueSize = DefaultAsyncQueueSize,
+        LogOverflowPolicy overflowPolicy = LogOverflowPolicy::DiscardOldest);
+    /// Set max number of messages per second written by the logger with given name. Zero to disable the limit.
+    /// Messages over the limit are dropped, number of dropped messages is reported afterwards.
+    void SetRateLimit(const ea::string& loggerName, unsigned maxMessagesPerSecond);
 
     /// Return logging level.
     /// @property
@@ -171,6 +190,9 @@ public:
     /// @property
     bool IsQuiet() const { return quiet_; }
 
+    /// Return whether asynchronous logging is enabled.
+    bool IsAsync() const;
+
     /// Returns a logger with specified name.
     static Logger GetLogger(const ea::string& name);
     /// Returns default logger.
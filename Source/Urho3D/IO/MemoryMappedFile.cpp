@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../IO/File.h"
+#include "../IO/FileSystem.h"
+#include "../IO/MemoryMappedFile.h"
+#include "../Math/MathDefs.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+MemoryMappedFile::MemoryMappedFile(const ea::string& fileName)
+{
+    Open(fileName);
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    Close();
+}
+
+bool MemoryMappedFile::Open(const ea::string& fileName)
+{
+    Close();
+
+#ifdef __ANDROID__
+    // Assets inside APK can't be mapped
+    if (URHO3D_IS_ASSET(fileName))
+        return false;
+#endif
+
+#if defined(_WIN32)
+    const HANDLE fileHandle = CreateFileW(GetWideNativePath(fileName).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0 || fileSize.QuadPart > M_MAX_UNSIGNED)
+    {
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    const HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle)
+    {
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    const void* data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (!data)
+    {
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    fileHandle_ = fileHandle;
+    mappingHandle_ = mappingHandle;
+    data_ = static_cast<const unsigned char*>(data);
+    size_ = static_cast<unsigned>(fileSize.QuadPart);
+    return true;
+#elif !defined(__EMSCRIPTEN__)
+    const int fd = open(GetNativePath(fileName).c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size == 0 || static_cast<unsigned long long>(st.st_size) > M_MAX_UNSIGNED)
+    {
+        close(fd);
+        return false;
+    }
+
+    // Mapping stays valid after the descriptor is closed
+    void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return false;
+
+    data_ = static_cast<const unsigned char*>(data);
+    size_ = static_cast<unsigned>(st.st_size);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void MemoryMappedFile::Close()
+{
+    if (!data_)
+        return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile(data_);
+    CloseHandle(mappingHandle_);
+    CloseHandle(fileHandle_);
+    fileHandle_ = nullptr;
+    mappingHandle_ = nullptr;
+#elif !defined(__EMSCRIPTEN__)
+    munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+
+    data_ = nullptr;
+    size_ = 0;
+}
+
+}
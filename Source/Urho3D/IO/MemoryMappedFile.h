@@ -0,0 +1,63 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Container/ByteVector.h"
+#include "../Container/RefCounted.h"
+#include "../Container/Str.h"
+
+namespace Urho3D
+{
+
+/// Read-only memory mapping of the whole file. Mapped pages are shared between processes via the OS page cache.
+class URHO3D_API MemoryMappedFile : public RefCounted
+{
+public:
+    MemoryMappedFile() = default;
+    /// Construct and map the file.
+    explicit MemoryMappedFile(const ea::string& fileName);
+    /// Destruct. Unmap the file.
+    ~MemoryMappedFile() override;
+
+    /// Map the file. Return true if successful.
+    bool Open(const ea::string& fileName);
+    /// Unmap the file. Any views into the mapping become invalid.
+    void Close();
+
+    /// Return whether the file is mapped.
+    bool IsOpen() const { return data_ != nullptr; }
+    /// Return mapped data.
+    ConstByteSpan GetData() const { return {data_, size_}; }
+    /// Return size of the file.
+    unsigned GetSize() const { return size_; }
+
+private:
+    const unsigned char* data_{};
+    unsigned size_{};
+#ifdef _WIN32
+    void* fileHandle_{};
+    void* mappingHandle_{};
+#endif
+};
+
+}
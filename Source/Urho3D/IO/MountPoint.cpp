@@ -22,11 +22,20 @@
 
 #include "Urho3D/IO/MountPoint.h"
 
+#include "Urho3D/Core/StringUtils.h"
 #include "Urho3D/IO/FileSystem.h"
 
 namespace Urho3D
 {
 
+StringHash MakeFileNameHash(ea::string_view fileName)
+{
+    unsigned hash = 0;
+    for (const char ch : fileName)
+        hash = SDBMHash(hash, static_cast<unsigned char>(ToLower(static_cast<unsigned char>(ch))));
+    return StringHash{hash};
+}
+
 MountPoint::MountPoint(Context* context)
     : Object(context)
 {
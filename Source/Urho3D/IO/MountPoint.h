@@ -32,6 +32,9 @@
 namespace Urho3D
 {
 
+/// Return case-insensitive hash of the file name. Used for indexed file lookups, stable across platforms and runs.
+URHO3D_API StringHash MakeFileNameHash(ea::string_view fileName);
+
 /// Access to engine file system mount point.
 class URHO3D_API MountPoint : public Object
 {
@@ -78,6 +81,11 @@ public:
     /// Enumerate objects in the mount point. Only files enumeration is guaranteed to be supported.
     virtual void Scan(ea::vector<ea::string>& result, const ea::string& pathName, const ea::string& filter,
         ScanFlags flags) const = 0;
+
+    /// Return hashes of all file names, see MakeFileNameHash. Should be implemented only if the set of files never
+    /// changes while mounted, so the virtual file system can find the file by single lookup instead of querying
+    /// each mount point. Return null if not supported.
+    virtual const ea::vector<StringHash>* GetFileNameHashes() const { return nullptr; }
 };
 
 /// Base implementation of watchable mount point.
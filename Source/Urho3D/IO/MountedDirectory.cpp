@@ -81,11 +81,16 @@ void MountedDirectory::ProcessUpdates()
     if (!fileWatcher_)
         return;
 
-    FileChange change;
-    while (fileWatcher_->GetNextChange(change))
+    ea::vector<FileChange> changes;
+    fileWatcher_->GetNextChanges(changes);
+    for (const FileChange& change : changes)
     {
         using namespace FileChanged;
 
+        // Lost changes cannot be attributed to specific resources
+        if (change.fileName_.empty())
+            continue;
+
         VariantMap& eventData = GetEventDataMap();
         eventData[P_FILENAME] = fileWatcher_->GetPath() + change.fileName_;
         eventData[P_RESOURCENAME] = FileIdentifier{scheme_, change.fileName_}.ToUri();
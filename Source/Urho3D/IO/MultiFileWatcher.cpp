@@ -60,4 +60,12 @@ bool MultiFileWatcher::GetNextChange(FileChange& dest)
     return false;
 }
 
+bool MultiFileWatcher::GetNextChanges(ea::vector<FileChange>& dest)
+{
+    bool found = false;
+    for (FileWatcher* watcher : watchers_)
+        found |= watcher->GetNextChanges(dest);
+    return found;
+}
+
 }
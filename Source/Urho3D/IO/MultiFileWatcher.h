@@ -44,6 +44,8 @@ public:
     void SetDelay(float interval);
     /// Return a file change (true if was found, false if not).
     bool GetNextChange(FileChange& dest);
+    /// Append all file changes that are ready to be notified. Return true if any was found.
+    bool GetNextChanges(ea::vector<FileChange>& dest);
 
     /// Return the delay in seconds for notifying file changes.
     float GetDelay() const { return delay_; }
@@ -29,6 +29,7 @@
 #ifdef _WIN32
 #include <windows.h>
 #else
+#include <cerrno>
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <csignal>
@@ -341,7 +342,15 @@ unsigned NamedPipe::Write(const void* data, unsigned size)
         {
             ssize_t writtenNow = write(writeHandle_, ((const unsigned char*)data) + written, size - written);
             if (writtenNow < 0)
+            {
+                // Pipe buffer is full, wait for the reader to consume the data
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    usleep(100);
+                    continue;
+                }
                 return 0; // Error while writing
+            }
             written += writtenNow;
         }
 
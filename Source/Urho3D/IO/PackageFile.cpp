@@ -24,12 +24,32 @@
 
 #include "../IO/File.h"
 #include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
 #include "../IO/PackageFile.h"
 #include "../IO/FileSystem.h"
 
 namespace Urho3D
 {
 
+namespace
+{
+
+/// View into the memory mapped package file. Keeps the mapping alive.
+class MappedPackageEntry : public RefCounted, public MemoryBuffer
+{
+public:
+    MappedPackageEntry(MemoryMappedFile* mapping, const PackageEntry& entry)
+        : MemoryBuffer(mapping->GetData().data() + entry.offset_, entry.size_)
+        , mapping_(mapping)
+    {
+    }
+
+private:
+    SharedPtr<MemoryMappedFile> mapping_;
+};
+
+}
+
 PackageFile::PackageFile(Context* context) :
     MountPoint(context),
     totalSize_(0),
@@ -53,6 +73,8 @@ PackageFile::~PackageFile() = default;
 
 bool PackageFile::Open(const ea::string& fileName, unsigned startOffset)
 {
+    mapping_ = nullptr;
+
     auto file = MakeShared<File>(context_, fileName);
     if (!file->IsOpen())
         return false;
@@ -88,21 +110,42 @@ bool PackageFile::Open(const ea::string& fileName, unsigned startOffset)
     nameHash_ = fileName_;
     totalSize_ = file->GetSize();
     compressed_ = id == "ULZ4" || id == "RLZ4";
+    version_ = 0;
+    blockSize_ = 0;
     unsigned numFiles = file->ReadUInt();
     checksum_ = file->ReadUInt();
 
     if (id == "RPAK" || id == "RLZ4")
     {
         // New PAK file format includes two extra PAK header fields:
-        // * Version. At this time this field is unused and is always 0. It will be used in the future if PAK format needs to be extended.
+        // * Version. Version 1 adds block size to the header and compression method to file entries.
+        //   Compressed entries begin with the table of block offsets, so they can be read at random positions.
+        //   Version 2 adds hashes of file names after the file list, so the package can be indexed without hashing names.
         // * File list offset. New format writes file list in the end of the file. This allows PAK creation without knowing entire file list
         //   beforehand.
-        unsigned version = file->ReadUInt();                        // Reserved for future use.
-        assert(version == 0);
+        version_ = file->ReadUInt();
+        if (version_ > PACKAGE_VERSION_NAME_HASHES)
+        {
+            URHO3D_LOGERROR("{} has unsupported package format version {}", fileName, version_);
+            return false;
+        }
+
         int64_t fileListOffset = file->ReadInt64();                 // New format has file list at the end of the file.
+        if (version_ >= PACKAGE_VERSION_BLOCK_INDEX)
+        {
+            blockSize_ = file->ReadUInt();
+            if (compressed_ && blockSize_ == 0)
+            {
+                URHO3D_LOGERROR("{} has invalid block size", fileName);
+                return false;
+            }
+        }
         file->Seek(fileListOffset);                                 // TODO: Serializer/Deserializer do not support files bigger than 4 GB
     }
 
+    const PackageCompression defaultCompression = compressed_ ? PackageCompression::LZ4 : PackageCompression::None;
+    ea::vector<ea::string> entryNames;
+    entryNames.reserve(numFiles);
     for (unsigned i = 0; i < numFiles; ++i)
     {
         ea::string entryName = file->ReadString();
@@ -110,18 +153,57 @@ bool PackageFile::Open(const ea::string& fileName, unsigned startOffset)
         newEntry.offset_ = file->ReadUInt() + startOffset;
         totalDataSize_ += (newEntry.size_ = file->ReadUInt());
         newEntry.checksum_ = file->ReadUInt();
-        if (!compressed_ && newEntry.offset_ + newEntry.size_ > totalSize_)
+        newEntry.compression_ = HasBlockIndex() ? static_cast<PackageCompression>(file->ReadUByte()) : defaultCompression;
+        if (newEntry.compression_ == PackageCompression::None && newEntry.offset_ + newEntry.size_ > totalSize_)
         {
             URHO3D_LOGERROR("File entry " + entryName + " outside package file");
             return false;
         }
         else
+        {
             entries_[entryName] = newEntry;
+            entryNames.push_back(ea::move(entryName));
+        }
+    }
+
+    fileNameHashes_.clear();
+    fileNameHashes_.reserve(numFiles);
+    if (version_ >= PACKAGE_VERSION_NAME_HASHES)
+    {
+        for (unsigned i = 0; i < numFiles; ++i)
+            fileNameHashes_.emplace_back(file->ReadUInt());
+    }
+    else
+    {
+        for (const ea::string& entryName : entryNames)
+            fileNameHashes_.push_back(MakeFileNameHash(entryName));
     }
 
     return true;
 }
 
+void PackageFile::SetMemoryMapped(bool enable)
+{
+    if (!enable || (compressed_ && !HasBlockIndex()) || fileName_.empty())
+    {
+        // Files that are already open keep the mapping alive
+        mapping_ = nullptr;
+        return;
+    }
+
+    if (mapping_)
+        return;
+
+    auto mapping = MakeShared<MemoryMappedFile>(fileName_);
+    if (!mapping->IsOpen() || mapping->GetSize() < totalSize_)
+    {
+        URHO3D_LOGWARNING("Cannot map package file {} into memory", fileName_);
+        return;
+    }
+
+    mapping_ = mapping;
+}
+
 bool PackageFile::Exists(const ea::string& fileName) const
 {
     bool found = entries_.find(fileName) != entries_.end();
@@ -220,6 +302,14 @@ AbstractFilePtr PackageFile::OpenFile(const FileIdentifier& fileName, FileMode m
     if (!Exists(fileName.fileName_))
         return {};
 
+    const PackageEntry& entry = *GetEntry(fileName.fileName_);
+    if (mapping_ && entry.compression_ == PackageCompression::None)
+    {
+        auto view = MakeShared<MappedPackageEntry>(mapping_, entry);
+        view->SetName(fileName.ToUri());
+        return view;
+    }
+
     auto file = MakeShared<File>(context_, this, fileName.fileName_);
     file->SetName(fileName.ToUri());
     return file;
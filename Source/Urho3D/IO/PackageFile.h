@@ -22,12 +22,27 @@
 
 #pragma once
 
+#include "Urho3D/IO/MemoryMappedFile.h"
 #include "Urho3D/IO/MountPoint.h"
 #include "Urho3D/IO/ScanFlags.h"
 
 namespace Urho3D
 {
 
+/// Compression method of the package entry.
+enum class PackageCompression : unsigned char
+{
+    /// Data is stored as is.
+    None,
+    /// Data is stored as a sequence of LZ4 blocks.
+    LZ4
+};
+
+/// Version of package format that stores block offset table for each compressed entry.
+static const unsigned PACKAGE_VERSION_BLOCK_INDEX = 1;
+/// Version of package format that stores hashes of file names after the file list.
+static const unsigned PACKAGE_VERSION_NAME_HASHES = 2;
+
 /// %File entry within the package file.
 struct PackageEntry
 {
@@ -37,6 +52,8 @@ struct PackageEntry
     unsigned size_;
     /// File checksum.
     unsigned checksum_;
+    /// Compression method.
+    PackageCompression compression_;
 };
 
 /// Stores files of a directory tree sequentially for convenient access.
@@ -84,6 +101,18 @@ public:
     /// Return whether the files are compressed.
     /// @property
     bool IsCompressed() const { return compressed_; }
+    /// Return package format version. Zero for legacy packages.
+    unsigned GetVersion() const { return version_; }
+    /// Return whether compressed entries have block offset tables and support random access.
+    bool HasBlockIndex() const { return version_ >= PACKAGE_VERSION_BLOCK_INDEX; }
+    /// Return size of uncompressed block. Valid only for packages with block index.
+    unsigned GetBlockSize() const { return blockSize_; }
+
+    /// Set whether to map the package file into memory. Uncompressed files are opened as views into the mapping then.
+    /// Legacy compressed packages are never mapped. Should be called after the package is opened.
+    void SetMemoryMapped(bool enable);
+    /// Return whether the package file is mapped into memory.
+    bool IsMemoryMapped() const { return mapping_ != nullptr; }
 
     /// Return list of file names in the package.
     const ea::vector<ea::string> GetEntryNames() const { return entries_.keys(); }
@@ -112,11 +141,14 @@ public:
 
     void Scan(ea::vector<ea::string>& result, const ea::string& pathName, const ea::string& filter,
         ScanFlags flags) const override;
+    const ea::vector<StringHash>* GetFileNameHashes() const override { return &fileNameHashes_; }
     /// @}
 
 private:
     /// File entries.
     ea::unordered_map<ea::string, PackageEntry> entries_;
+    /// Hashes of file names, either loaded from the package or calculated on open.
+    ea::vector<StringHash> fileNameHashes_;
     /// File name.
     ea::string fileName_;
     /// Package file name hash.
@@ -129,6 +161,12 @@ private:
     unsigned checksum_;
     /// Compressed flag.
     bool compressed_;
+    /// Package format version.
+    unsigned version_{};
+    /// Size of uncompressed block.
+    unsigned blockSize_{};
+    /// Memory mapping of the package file, if enabled.
+    SharedPtr<MemoryMappedFile> mapping_;
 };
 
 }
@@ -26,6 +26,7 @@
 
 #include "Urho3D/Core/Context.h"
 #include "Urho3D/Core/CoreEvents.h"
+#include "Urho3D/Core/WorkQueue.h"
 #include "Urho3D/IO/FileSystem.h"
 #include "Urho3D/IO/Log.h"
 #include "Urho3D/IO/MountPoint.h"
@@ -100,7 +101,10 @@ void VirtualFileSystem::MountPackageFile(const ea::string& path)
 {
     const auto packageFile = MakeShared<PackageFile>(context_);
     if (packageFile->Open(path, 0u))
+    {
+        packageFile->SetMemoryMapped(memoryMappedPackages_);
         Mount(packageFile);
+    }
 }
 
 void VirtualFileSystem::Mount(MountPoint* mountPoint)
@@ -113,24 +117,90 @@ void VirtualFileSystem::Mount(MountPoint* mountPoint)
         return;
     }
     mountPoints_.push_back(pointPtr);
+    IndexMountPoint(mountPoints_.size() - 1);
 
     mountPoint->SetWatching(isWatching_);
 }
 
+void VirtualFileSystem::IndexMountPoint(unsigned position)
+{
+    const ea::vector<StringHash>* fileNameHashes = mountPoints_[position]->GetFileNameHashes();
+    if (!fileNameHashes)
+    {
+        unindexedMountPoints_.push_back(position);
+        return;
+    }
+
+    // Mount points are processed in order, so the last one wins
+    for (const StringHash hash : *fileNameHashes)
+        fileIndex_[hash] = position;
+}
+
+void VirtualFileSystem::RebuildFileIndex()
+{
+    fileIndex_.clear();
+    unindexedMountPoints_.clear();
+    for (unsigned position = 0; position < mountPoints_.size(); ++position)
+        IndexMountPoint(position);
+}
+
+template <class T>
+bool VirtualFileSystem::VisitMountPointsForFile(const FileIdentifier& fileName, const T& callback) const
+{
+    // Explicit scheme is rare and may be accepted by any mount point, query them all
+    if (!fileName.scheme_.empty())
+    {
+        for (MountPoint* mountPoint : ea::reverse(mountPoints_))
+        {
+            if (callback(mountPoint))
+                return true;
+        }
+        return false;
+    }
+
+    const auto iter = fileIndex_.find(MakeFileNameHash(fileName.fileName_));
+    const unsigned indexedPosition = iter != fileIndex_.end() ? iter->second : M_MAX_UNSIGNED;
+
+    // Mount points that are not indexed take priority if they are mounted later
+    for (const unsigned position : ea::reverse(unindexedMountPoints_))
+    {
+        if (indexedPosition != M_MAX_UNSIGNED && position < indexedPosition)
+            break;
+        if (callback(mountPoints_[position]))
+            return true;
+    }
+
+    if (indexedPosition == M_MAX_UNSIGNED)
+        return false;
+
+    if (callback(mountPoints_[indexedPosition]))
+        return true;
+
+    // Hash collision or name that differs only in case, fall back to querying the rest
+    for (unsigned position = indexedPosition; position-- > 0;)
+    {
+        if (callback(mountPoints_[position]))
+            return true;
+    }
+    return false;
+}
+
 void VirtualFileSystem::MountExistingPackages(
     const StringVector& prefixPaths, const StringVector& relativePaths)
 {
     const auto fileSystem = context_->GetSubsystem<FileSystem>();
 
+    StringVector packagePaths;
     for (const ea::string& prefixPath : prefixPaths)
     {
         for (const ea::string& relativePath : relativePaths)
         {
             const ea::string packagePath = prefixPath + relativePath;
             if (fileSystem->FileExists(packagePath))
-                MountPackageFile(packagePath);
+                packagePaths.push_back(packagePath);
         }
     }
+    MountPackagesAndDirectories(packagePaths, StringVector(packagePaths.size()));
 }
 
 void VirtualFileSystem::MountExistingDirectoriesOrPackages(
@@ -138,6 +208,8 @@ void VirtualFileSystem::MountExistingDirectoriesOrPackages(
 {
     const auto fileSystem = context_->GetSubsystem<FileSystem>();
 
+    StringVector packagePaths;
+    StringVector directoryPaths;
     for (const ea::string& prefixPath : prefixPaths)
     {
         for (const ea::string& relativePath : relativePaths)
@@ -145,11 +217,61 @@ void VirtualFileSystem::MountExistingDirectoriesOrPackages(
             const ea::string packagePath = prefixPath + relativePath + ".pak";
             const ea::string directoryPath = prefixPath + relativePath;
             if (fileSystem->FileExists(packagePath))
-                MountPackageFile(packagePath);
+            {
+                packagePaths.push_back(packagePath);
+                directoryPaths.emplace_back();
+            }
             else if (fileSystem->DirExists(directoryPath))
-                MountDir(directoryPath);
+            {
+                packagePaths.emplace_back();
+                directoryPaths.push_back(directoryPath);
+            }
         }
     }
+    MountPackagesAndDirectories(packagePaths, directoryPaths);
+}
+
+ea::vector<SharedPtr<MountPoint>> VirtualFileSystem::OpenPackageFiles(const StringVector& paths) const
+{
+    ea::vector<SharedPtr<MountPoint>> result(paths.size());
+    const auto openPackage = [&](unsigned index, const ea::string& path)
+    {
+        if (path.empty())
+            return;
+
+        const auto packageFile = MakeShared<PackageFile>(context_);
+        if (packageFile->Open(path, 0u))
+        {
+            packageFile->SetMemoryMapped(memoryMappedPackages_);
+            result[index] = packageFile;
+        }
+    };
+
+    // Reading package directories is I/O bound, so it's worth doing in parallel even for few packages
+    auto workQueue = context_->GetSubsystem<WorkQueue>();
+    if (workQueue && paths.size() > 1)
+        ForEachParallel(workQueue, paths, openPackage);
+    else
+    {
+        for (unsigned i = 0; i < paths.size(); ++i)
+            openPackage(i, paths[i]);
+    }
+    return result;
+}
+
+void VirtualFileSystem::MountPackagesAndDirectories(const StringVector& packagePaths, const StringVector& directoryPaths)
+{
+    const auto packageFiles = OpenPackageFiles(packagePaths);
+    for (unsigned i = 0; i < packagePaths.size(); ++i)
+    {
+        if (!packagePaths[i].empty())
+        {
+            if (packageFiles[i])
+                Mount(packageFiles[i]);
+        }
+        else if (!directoryPaths[i].empty())
+            MountDir(directoryPaths[i]);
+    }
 }
 
 void VirtualFileSystem::Unmount(MountPoint* mountPoint)
@@ -162,6 +284,7 @@ void VirtualFileSystem::Unmount(MountPoint* mountPoint)
     {
         // Erase the slow way because order of the mount points matters.
         mountPoints_.erase(i);
+        RebuildFileIndex();
     }
 }
 
@@ -170,6 +293,7 @@ void VirtualFileSystem::UnmountAll()
     MutexLock lock(mountMutex_);
 
     mountPoints_.clear();
+    RebuildFileIndex();
 }
 
 MountPoint* VirtualFileSystem::GetMountPoint(unsigned index) const
@@ -186,13 +310,13 @@ AbstractFilePtr VirtualFileSystem::OpenFile(const FileIdentifier& fileName, File
 
     MutexLock lock(mountMutex_);
 
-    for (MountPoint* mountPoint : ea::reverse(mountPoints_))
+    AbstractFilePtr result;
+    VisitMountPointsForFile(fileName, [&](MountPoint* mountPoint)
     {
-        if (AbstractFilePtr result = mountPoint->OpenFile(fileName, mode))
-            return result;
-    }
-
-    return nullptr;
+        result = mountPoint->OpenFile(fileName, mode);
+        return result != nullptr;
+    });
+    return result;
 }
 
 ea::string VirtualFileSystem::ReadAllText(const FileIdentifier& fileName) const
@@ -224,13 +348,15 @@ FileTime VirtualFileSystem::GetLastModifiedTime(const FileIdentifier& fileName,
 {
     MutexLock lock(mountMutex_);
 
-    for (MountPoint* mountPoint : ea::reverse(mountPoints_))
+    FileTime result = 0;
+    VisitMountPointsForFile(fileName, [&](MountPoint* mountPoint)
     {
-        if (const auto result = mountPoint->GetLastModifiedTime(fileName, creationIsModification))
-            return *result;
-    }
-
-    return 0;
+        const auto time = mountPoint->GetLastModifiedTime(fileName, creationIsModification);
+        if (time)
+            result = *time;
+        return time.has_value();
+    });
+    return result;
 }
 
 ea::string VirtualFileSystem::GetAbsoluteNameFromIdentifier(const FileIdentifier& fileName) const
@@ -337,12 +463,7 @@ bool VirtualFileSystem::Exists(const FileIdentifier& fileName) const
 {
     MutexLock lock(mountMutex_);
 
-    for (MountPoint* mountPoint : ea::reverse(mountPoints_))
-    {
-        if (mountPoint->Exists(fileName))
-            return true;
-    }
-    return false;
+    return VisitMountPointsForFile(fileName, [&](MountPoint* mountPoint) { return mountPoint->Exists(fileName); });
 }
 
 MountPointGuard::MountPointGuard(MountPoint* mountPoint)
@@ -63,9 +63,10 @@ public:
     MountPoint* GetMountPoint(unsigned index) const;
 
     /// Mount all existing packages for each combination of prefix path and relative path.
+    /// Packages are opened in parallel in WorkQueue, if available, and mounted in the order of paths.
     void MountExistingPackages(const StringVector& prefixPaths, const StringVector& relativePaths);
     /// Mount all existing directories and packages for each combination of prefix path and relative path.
-    /// Package is preferred over directory if both exist.
+    /// Package is preferred over directory if both exist. Packages are opened in parallel like in MountExistingPackages.
     void MountExistingDirectoriesOrPackages(const StringVector& prefixPaths, const StringVector& relativePaths);
 
     /// Check if a file exists in the virtual file system.
@@ -93,6 +94,11 @@ public:
     /// Returns true if the file watchers are enabled.
     bool IsWatching() const { return isWatching_; }
 
+    /// Set whether package files mounted by MountPackageFile are mapped into memory.
+    void SetMemoryMappedPackages(bool enable) { memoryMappedPackages_ = enable; }
+    /// Return whether package files are mapped into memory.
+    bool GetMemoryMappedPackages() const { return memoryMappedPackages_; }
+
     /// Scan for specified files.
     void Scan(ea::vector<ea::string>& result, const ea::string& scheme, const ea::string& pathName,
         const ea::string& filter, ScanFlags flags) const;
@@ -100,12 +106,32 @@ public:
         ScanFlags flags) const;
 
 private:
+    /// Open package files in parallel. Packages that cannot be opened are returned as null.
+    ea::vector<SharedPtr<MountPoint>> OpenPackageFiles(const StringVector& paths) const;
+    /// Mount package files, directories or both in the given order. Empty package path means directory.
+    void MountPackagesAndDirectories(const StringVector& packagePaths, const StringVector& directoryPaths);
+
+    /// Add mount point at the given position to the file index. Must be called under mutex.
+    void IndexMountPoint(unsigned position);
+    /// Rebuild file index from scratch. Must be called under mutex.
+    void RebuildFileIndex();
+    /// Call callback for mount points that may contain the file, in the order of priority, until callback returns true.
+    /// Return whether callback returned true. Must be called under mutex.
+    template <class T> bool VisitMountPointsForFile(const FileIdentifier& fileName, const T& callback) const;
+
     /// Mutex for thread-safe access to the mount points.
     mutable Mutex mountMutex_;
     /// File system mount points. It is expected to have small number of mount points.
     ea::vector<SharedPtr<MountPoint>> mountPoints_;
+    /// Index of files in mount points with fixed set of files.
+    /// Key is the hash of file name, value is the position of the last mounted point that contains the file.
+    ea::unordered_map<StringHash, unsigned> fileIndex_;
+    /// Positions of mount points that cannot be indexed and should be queried for each file.
+    ea::vector<unsigned> unindexedMountPoints_;
     /// Are file watchers enabled.
     bool isWatching_{};
+    /// Whether to map package files into memory.
+    bool memoryMappedPackages_{};
 };
 
 /// Helper class to mount and unmount an object automatically.
@@ -24,11 +24,70 @@
 
 #include "../Math/Frustum.h"
 
+#ifdef URHO3D_SSE
+#include <xmmintrin.h>
+#endif
+
 #include "../DebugNew.h"
 
 namespace Urho3D
 {
 
+unsigned Frustum::IsInsideFastMask(const BoundingBox* const* boxes, unsigned count) const
+{
+    assert(count <= 4);
+
+#ifdef URHO3D_SSE
+    // Transpose boxes into SoA layout, missing boxes are replaced with the first one and masked out
+    __m128 minX, minY, minZ, minW;
+    __m128 maxX, maxY, maxZ, maxW;
+    minX = _mm_loadu_ps(&boxes[0]->min_.x_);
+    minY = _mm_loadu_ps(&boxes[count > 1 ? 1 : 0]->min_.x_);
+    minZ = _mm_loadu_ps(&boxes[count > 2 ? 2 : 0]->min_.x_);
+    minW = _mm_loadu_ps(&boxes[count > 3 ? 3 : 0]->min_.x_);
+    maxX = _mm_loadu_ps(&boxes[0]->max_.x_);
+    maxY = _mm_loadu_ps(&boxes[count > 1 ? 1 : 0]->max_.x_);
+    maxZ = _mm_loadu_ps(&boxes[count > 2 ? 2 : 0]->max_.x_);
+    maxW = _mm_loadu_ps(&boxes[count > 3 ? 3 : 0]->max_.x_);
+    _MM_TRANSPOSE4_PS(minX, minY, minZ, minW);
+    _MM_TRANSPOSE4_PS(maxX, maxY, maxZ, maxW);
+
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 centerX = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+    const __m128 centerY = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+    const __m128 centerZ = _mm_mul_ps(_mm_add_ps(minZ, maxZ), half);
+    const __m128 edgeX = _mm_sub_ps(centerX, minX);
+    const __m128 edgeY = _mm_sub_ps(centerY, minY);
+    const __m128 edgeZ = _mm_sub_ps(centerZ, minZ);
+
+    __m128 outside = _mm_setzero_ps();
+    for (const Plane& plane : planes_)
+    {
+        // Keep the order of operations of scalar code so results match exactly
+        __m128 dist = _mm_mul_ps(centerX, _mm_set1_ps(plane.normal_.x_));
+        dist = _mm_add_ps(dist, _mm_mul_ps(centerY, _mm_set1_ps(plane.normal_.y_)));
+        dist = _mm_add_ps(dist, _mm_mul_ps(centerZ, _mm_set1_ps(plane.normal_.z_)));
+        dist = _mm_add_ps(dist, _mm_set1_ps(plane.d_));
+
+        __m128 absDist = _mm_mul_ps(edgeX, _mm_set1_ps(plane.absNormal_.x_));
+        absDist = _mm_add_ps(absDist, _mm_mul_ps(edgeY, _mm_set1_ps(plane.absNormal_.y_)));
+        absDist = _mm_add_ps(absDist, _mm_mul_ps(edgeZ, _mm_set1_ps(plane.absNormal_.z_)));
+
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, _mm_sub_ps(_mm_setzero_ps(), absDist)));
+    }
+
+    return ~static_cast<unsigned>(_mm_movemask_ps(outside)) & ((1u << count) - 1);
+#else
+    unsigned mask = 0;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        if (IsInsideFast(*boxes[i]) != OUTSIDE)
+            mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
 inline Vector3 ClipEdgeZ(const Vector3& v0, const Vector3& v1, float clipZ)
 {
     return Vector3(
@@ -222,6 +281,68 @@ Rect Frustum::Projected(const Matrix4& projection) const
     return rect;
 }
 
+void Frustum::DefineEnclosing(const Frustum& first, const Frustum& second)
+{
+    for (unsigned i = 0; i < NUM_FRUSTUM_PLANES; ++i)
+    {
+        // Try planes of both frustums and their average, keep the one that encloses the vertices most tightly
+        const Vector3 candidates[3] = {first.planes_[i].normal_, second.planes_[i].normal_,
+            (first.planes_[i].normal_ + second.planes_[i].normal_).Normalized()};
+
+        float bestLooseness = M_INFINITY;
+        for (const Vector3& normal : candidates)
+        {
+            // Plane goes through the outermost vertex of both frustums
+            const Vector3* outermostVertex = &first.vertices_[0];
+            float sumDistance = 0.0f;
+            for (const Frustum* frustum : {&first, &second})
+            {
+                for (const Vector3& vertex : frustum->vertices_)
+                {
+                    sumDistance += normal.DotProduct(vertex);
+                    if (normal.DotProduct(vertex) < normal.DotProduct(*outermostVertex))
+                        outermostVertex = &vertex;
+                }
+            }
+
+            const float looseness = sumDistance - 2 * NUM_FRUSTUM_VERTICES * normal.DotProduct(*outermostVertex);
+            if (looseness < bestLooseness)
+            {
+                bestLooseness = looseness;
+                planes_[i].Define(normal, *outermostVertex);
+            }
+        }
+    }
+
+    // Vertices are intersections of adjacent planes, see Define(nearSize, farSize) for the order
+    static const FrustumPlane vertexPlanes[NUM_FRUSTUM_VERTICES][3] = {
+        {PLANE_NEAR, PLANE_RIGHT, PLANE_UP},
+        {PLANE_NEAR, PLANE_RIGHT, PLANE_DOWN},
+        {PLANE_NEAR, PLANE_LEFT, PLANE_DOWN},
+        {PLANE_NEAR, PLANE_LEFT, PLANE_UP},
+        {PLANE_FAR, PLANE_RIGHT, PLANE_UP},
+        {PLANE_FAR, PLANE_RIGHT, PLANE_DOWN},
+        {PLANE_FAR, PLANE_LEFT, PLANE_DOWN},
+        {PLANE_FAR, PLANE_LEFT, PLANE_UP},
+    };
+    for (unsigned i = 0; i < NUM_FRUSTUM_VERTICES; ++i)
+    {
+        const Plane& p0 = planes_[vertexPlanes[i][0]];
+        const Plane& p1 = planes_[vertexPlanes[i][1]];
+        const Plane& p2 = planes_[vertexPlanes[i][2]];
+        const Vector3 cross12 = p1.normal_.CrossProduct(p2.normal_);
+        const float det = p0.normal_.DotProduct(cross12);
+        if (Abs(det) < M_EPSILON)
+        {
+            vertices_[i] = (first.vertices_[i] + second.vertices_[i]) * 0.5f;
+            continue;
+        }
+
+        vertices_[i] = -(p0.d_ * cross12 + p1.d_ * p2.normal_.CrossProduct(p0.normal_)
+            + p2.d_ * p0.normal_.CrossProduct(p1.normal_)) / det;
+    }
+}
+
 void Frustum::UpdatePlanes()
 {
     planes_[PLANE_NEAR].Define(vertices_[2], vertices_[1], vertices_[0]);
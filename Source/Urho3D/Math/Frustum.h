@@ -74,6 +74,9 @@ public:
         (float orthoSize, float aspectRatio, float zoom, float nearZ, float farZ, const Matrix3x4& transform = Matrix3x4::IDENTITY);
     /// Define a split (limited) frustum from a projection matrix, with near & far distances specified.
     void DefineSplit(const Matrix4& projection, float nearZ, float farZ);
+    /// Define as convex frustum that contains both frustums, e.g. for culling both eyes of stereo camera at once.
+    /// Each plane is taken from either frustum or averaged from both, whichever encloses all vertices most tightly.
+    void DefineEnclosing(const Frustum& first, const Frustum& second);
     /// Transform by a 3x3 matrix.
     void Transform(const Matrix3& transform);
     /// Transform by a 3x4 matrix.
@@ -158,6 +161,10 @@ public:
         return INSIDE;
     }
 
+    /// Test up to 4 bounding boxes at once. Return bit mask of boxes that are (partially) inside.
+    /// Result is the same as IsInsideFast for each box.
+    unsigned IsInsideFastMask(const BoundingBox* const* boxes, unsigned count) const;
+
     /// Return distance of a point to the frustum, or 0 if inside.
     float Distance(const Vector3& point) const
     {
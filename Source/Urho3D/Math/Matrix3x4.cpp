@@ -24,6 +24,8 @@
 
 #include "../Math/Matrix3x4.h"
 
+#include "../Core/Assert.h"
+
 #include <cstdio>
 
 #include "../DebugNew.h"
@@ -31,6 +33,62 @@
 namespace Urho3D
 {
 
+namespace
+{
+
+/// Transform vectors by the columns of the matrix. Translation column is ignored if not required.
+template <bool IncludeTranslation>
+void TransformVectors(const Matrix3x4& matrix, ea::span<const Vector3> source, ea::span<Vector3> dest)
+{
+    URHO3D_ASSERT(source.size() == dest.size());
+
+#ifdef URHO3D_SSE
+    const __m128 c0 = _mm_set_ps(0.0f, matrix.m20_, matrix.m10_, matrix.m00_);
+    const __m128 c1 = _mm_set_ps(0.0f, matrix.m21_, matrix.m11_, matrix.m01_);
+    const __m128 c2 = _mm_set_ps(0.0f, matrix.m22_, matrix.m12_, matrix.m02_);
+    const __m128 c3 = IncludeTranslation ? _mm_set_ps(0.0f, matrix.m23_, matrix.m13_, matrix.m03_) : _mm_setzero_ps();
+    for (unsigned i = 0; i < source.size(); ++i)
+    {
+        const Vector3 vec = source[i];
+        const __m128 r = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(vec.x_)), _mm_mul_ps(c1, _mm_set1_ps(vec.y_))),
+            _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(vec.z_)), c3));
+        _mm_storel_pi(reinterpret_cast<__m64*>(&dest[i].x_), r);
+        _mm_store_ss(&dest[i].z_, _mm_movehl_ps(r, r));
+    }
+#elif defined(URHO3D_NEON)
+    const float columns[4][4]{
+        {matrix.m00_, matrix.m10_, matrix.m20_, 0.0f},
+        {matrix.m01_, matrix.m11_, matrix.m21_, 0.0f},
+        {matrix.m02_, matrix.m12_, matrix.m22_, 0.0f},
+        {matrix.m03_, matrix.m13_, matrix.m23_, 0.0f},
+    };
+    const float32x4_t c0 = vld1q_f32(columns[0]);
+    const float32x4_t c1 = vld1q_f32(columns[1]);
+    const float32x4_t c2 = vld1q_f32(columns[2]);
+    const float32x4_t c3 = IncludeTranslation ? vld1q_f32(columns[3]) : vdupq_n_f32(0.0f);
+    for (unsigned i = 0; i < source.size(); ++i)
+    {
+        const Vector3 vec = source[i];
+        const float32x4_t r = vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(c3, c0, vec.x_), c1, vec.y_), c2, vec.z_);
+        vst1_f32(&dest[i].x_, vget_low_f32(r));
+        vst1q_lane_f32(&dest[i].z_, r, 2);
+    }
+#else
+    const float w = IncludeTranslation ? 1.0f : 0.0f;
+    for (unsigned i = 0; i < source.size(); ++i)
+    {
+        const Vector3 vec = source[i];
+        dest[i] = Vector3(
+            matrix.m00_ * vec.x_ + matrix.m01_ * vec.y_ + matrix.m02_ * vec.z_ + matrix.m03_ * w,
+            matrix.m10_ * vec.x_ + matrix.m11_ * vec.y_ + matrix.m12_ * vec.z_ + matrix.m13_ * w,
+            matrix.m20_ * vec.x_ + matrix.m21_ * vec.y_ + matrix.m22_ * vec.z_ + matrix.m23_ * w);
+    }
+#endif
+}
+
+}
+
 const Matrix3x4 Matrix3x4::ZERO(
     0.0f, 0.0f, 0.0f, 0.0f,
     0.0f, 0.0f, 0.0f, 0.0f,
@@ -95,4 +153,32 @@ ea::string Matrix3x4::ToString() const
     return ea::string(tempBuffer);
 }
 
+void TransformPositions(const Matrix3x4& matrix, ea::span<const Vector3> source, ea::span<Vector3> dest)
+{
+    TransformVectors<true>(matrix, source, dest);
+}
+
+void TransformDirections(const Matrix3x4& matrix, ea::span<const Vector3> source, ea::span<Vector3> dest)
+{
+    TransformVectors<false>(matrix, source, dest);
+}
+
+void MultiplyMatrices(const Matrix3x4& lhs, ea::span<const Matrix3x4> source, ea::span<Matrix3x4> dest)
+{
+    URHO3D_ASSERT(source.size() == dest.size());
+
+    // Local copy cannot alias destination, so rows of the left matrix stay in registers
+    const Matrix3x4 matrix = lhs;
+    for (unsigned i = 0; i < source.size(); ++i)
+        dest[i] = matrix * source[i];
+}
+
+void MultiplyMatrices(ea::span<const Matrix3x4> lhs, ea::span<const Matrix3x4> rhs, ea::span<Matrix3x4> dest)
+{
+    URHO3D_ASSERT(lhs.size() == dest.size() && rhs.size() == dest.size());
+
+    for (unsigned i = 0; i < dest.size(); ++i)
+        dest[i] = lhs[i] * rhs[i];
+}
+
 }
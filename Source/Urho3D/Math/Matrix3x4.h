@@ -26,8 +26,12 @@
 
 #ifdef URHO3D_SSE
 #include <emmintrin.h>
+#elif defined(URHO3D_NEON)
+#include <arm_neon.h>
 #endif
 
+#include <EASTL/span.h>
+
 namespace Urho3D
 {
 
@@ -303,6 +307,13 @@ public:
             _mm_cvtss_f32(vec),
             _mm_cvtss_f32(_mm_shuffle_ps(vec, vec, _MM_SHUFFLE(1, 1, 1, 1))),
             _mm_cvtss_f32(_mm_movehl_ps(vec, vec)));
+#elif defined(URHO3D_NEON)
+        const float data[4]{rhs.x_, rhs.y_, rhs.z_, 1.0f};
+        const float32x4_t vec = vld1q_f32(data);
+        return Vector3(
+            vaddvq_f32(vmulq_f32(vld1q_f32(&m00_), vec)),
+            vaddvq_f32(vmulq_f32(vld1q_f32(&m10_), vec)),
+            vaddvq_f32(vmulq_f32(vld1q_f32(&m20_), vec)));
 #else
         return Vector3(
             (m00_ * rhs.x_ + m01_ * rhs.y_ + m02_ * rhs.z_ + m03_),
@@ -456,6 +467,22 @@ public:
         t3 = _mm_mul_ps(l, r3);
         _mm_storeu_ps(&out.m20_, _mm_add_ps(_mm_add_ps(t0, t1), _mm_add_ps(t2, t3)));
 
+        return out;
+#elif defined(URHO3D_NEON)
+        Matrix3x4 out;
+
+        const float32x4_t r0 = vld1q_f32(&rhs.m00_);
+        const float32x4_t r1 = vld1q_f32(&rhs.m10_);
+        const float32x4_t r2 = vld1q_f32(&rhs.m20_);
+        const float32x4_t r3 = vsetq_lane_f32(1.0f, vdupq_n_f32(0.0f), 3);
+
+        float32x4_t l = vld1q_f32(&m00_);
+        vst1q_f32(&out.m00_, vfmaq_laneq_f32(vfmaq_laneq_f32(vfmaq_laneq_f32(vmulq_laneq_f32(r0, l, 0), r1, l, 1), r2, l, 2), r3, l, 3));
+        l = vld1q_f32(&m10_);
+        vst1q_f32(&out.m10_, vfmaq_laneq_f32(vfmaq_laneq_f32(vfmaq_laneq_f32(vmulq_laneq_f32(r0, l, 0), r1, l, 1), r2, l, 2), r3, l, 3));
+        l = vld1q_f32(&m20_);
+        vst1q_f32(&out.m20_, vfmaq_laneq_f32(vfmaq_laneq_f32(vfmaq_laneq_f32(vmulq_laneq_f32(r0, l, 0), r1, l, 1), r2, l, 2), r3, l, 3));
+
         return out;
 #else
         return Matrix3x4(
@@ -790,4 +817,13 @@ private:
 /// Multiply a 3x4 matrix with a scalar.
 inline Matrix3x4 operator *(float lhs, const Matrix3x4& rhs) { return rhs * lhs; }
 
+/// Transform positions by the matrix. Source and destination may be the same span.
+URHO3D_API void TransformPositions(const Matrix3x4& matrix, ea::span<const Vector3> source, ea::span<Vector3> dest);
+/// Transform directions by the matrix, ignoring translation. Source and destination may be the same span.
+URHO3D_API void TransformDirections(const Matrix3x4& matrix, ea::span<const Vector3> source, ea::span<Vector3> dest);
+/// Multiply the matrix by each matrix in the source span: dest[i] = lhs * source[i]. Source and destination may be the same span.
+URHO3D_API void MultiplyMatrices(const Matrix3x4& lhs, ea::span<const Matrix3x4> source, ea::span<Matrix3x4> dest);
+/// Multiply matrices pairwise: dest[i] = lhs[i] * rhs[i]. Destination may be the same span as one of the sources.
+URHO3D_API void MultiplyMatrices(ea::span<const Matrix3x4> lhs, ea::span<const Matrix3x4> rhs, ea::span<Matrix3x4> dest);
+
 }
@@ -24,27 +24,31 @@
 
 #include "../Math/Random.h"
 
+#include <atomic>
+
 #include "../DebugNew.h"
 
 namespace Urho3D
 {
 
-static unsigned randomSeed = 1;
+/// Seed is atomic so Rand() may be called from worker threads. Concurrent calls may return the same number.
+static std::atomic<unsigned> randomSeed{1};
 
 void SetRandomSeed(unsigned seed)
 {
-    randomSeed = seed;
+    randomSeed.store(seed, std::memory_order_relaxed);
 }
 
 unsigned GetRandomSeed()
 {
-    return randomSeed;
+    return randomSeed.load(std::memory_order_relaxed);
 }
 
 int Rand()
 {
-    randomSeed = randomSeed * 214013 + 2531011;
-    return (randomSeed >> 16u) & 32767u;
+    const unsigned seed = randomSeed.load(std::memory_order_relaxed) * 214013 + 2531011;
+    randomSeed.store(seed, std::memory_order_relaxed);
+    return (seed >> 16u) & 32767u;
 }
 
 float RandStandardNormal()
@@ -31,7 +31,7 @@ namespace Urho3D
 URHO3D_API void SetRandomSeed(unsigned seed);
 /// Return the current random seed.
 URHO3D_API unsigned GetRandomSeed();
-/// Return a random number between 0-32767. Should operate similarly to MSVC rand().
+/// Return a random number between 0-32767. Should operate similarly to MSVC rand(). May be called from worker threads.
 /// @alias{RandomInt}
 URHO3D_API int Rand();
 /// Return a standard normal distributed number.
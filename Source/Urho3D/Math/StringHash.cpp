@@ -68,8 +68,7 @@ unsigned StringHash::Calculate(const char* str)
 
 unsigned StringHash::Calculate(const void* data, unsigned length)
 {
-    const ea::string_view view{static_cast<const char*>(data), length};
-    return MakeHash(view);
+    return Calculate(ea::string_view{static_cast<const char*>(data), length});
 }
 
 StringHashRegister* StringHash::GetGlobalStringHashRegister()
@@ -26,6 +26,7 @@
 #include "Urho3D/Math/MathDefs.h"
 
 #include <EASTL/string.h>
+#include <EASTL/string_view.h>
 
 namespace Urho3D
 {
@@ -36,14 +37,17 @@ class StringHashRegister;
 class URHO3D_API StringHash
 {
 public:
+    /// Hash value of empty string.
+    static constexpr unsigned EmptyValue = 2166136261u;
+
     /// Construct with zero value.
-    StringHash() noexcept
-        : value_(Empty.value_)
+    constexpr StringHash() noexcept
+        : value_(EmptyValue)
     {
     }
 
     /// Construct with an initial value.
-    explicit StringHash(unsigned value) noexcept
+    constexpr explicit StringHash(unsigned value) noexcept
         : value_(value)
     {
     }
@@ -64,26 +68,26 @@ public:
     StringHash(const ea::string_view& str) noexcept; // NOLINT(google-explicit-constructor)
 
     /// Test for equality with another hash.
-    bool operator==(const StringHash& rhs) const { return value_ == rhs.value_; }
+    constexpr bool operator==(const StringHash& rhs) const { return value_ == rhs.value_; }
 
     /// Test for inequality with another hash.
-    bool operator!=(const StringHash& rhs) const { return value_ != rhs.value_; }
+    constexpr bool operator!=(const StringHash& rhs) const { return value_ != rhs.value_; }
 
     /// Test if less than another hash.
-    bool operator<(const StringHash& rhs) const { return value_ < rhs.value_; }
+    constexpr bool operator<(const StringHash& rhs) const { return value_ < rhs.value_; }
 
     /// Test if greater than another hash.
-    bool operator>(const StringHash& rhs) const { return value_ > rhs.value_; }
+    constexpr bool operator>(const StringHash& rhs) const { return value_ > rhs.value_; }
 
     /// Return true if nonempty hash value.
-    bool IsEmpty() const { return value_ == Empty.value_; }
+    constexpr bool IsEmpty() const { return value_ == EmptyValue; }
 
     /// Return true if nonempty hash value.
-    explicit operator bool() const { return !IsEmpty(); }
+    constexpr explicit operator bool() const { return !IsEmpty(); }
 
     /// Return hash value.
     /// @property
-    unsigned Value() const { return value_; }
+    constexpr unsigned Value() const { return value_; }
 
     /// Return mutable hash value. For internal use only.
     unsigned& MutableValue() { return value_; }
@@ -99,11 +103,20 @@ public:
     ea::string Reverse() const;
 
     /// Return hash value for HashSet & HashMap.
-    unsigned ToHash() const { return value_; }
+    constexpr unsigned ToHash() const { return value_; }
 
     /// Calculate hash value from a C string.
     static unsigned Calculate(const char* str);
 
+    /// Calculate hash value from a string. May be evaluated at compile time. Matches ea::hash of the string.
+    static constexpr unsigned Calculate(ea::string_view str)
+    {
+        unsigned result = EmptyValue;
+        for (const char ch : str)
+            result = (result * 16777619u) ^ static_cast<unsigned char>(ch);
+        return result;
+    }
+
     /// Calculate hash value from binary data.
     static unsigned Calculate(const void* data, unsigned length);
 
@@ -120,4 +133,11 @@ private:
 
 static_assert(sizeof(StringHash) == sizeof(unsigned), "Unexpected StringHash size.");
 
+/// Construct StringHash from a string literal at compile time, e.g. "Position"_sh.
+/// Such hashes are not registered for reversing when URHO3D_HASH_DEBUG is on.
+constexpr StringHash operator""_sh(const char* str, size_t length)
+{
+    return StringHash{StringHash::Calculate(ea::string_view{str, length})};
+}
+
 } // namespace Urho3D
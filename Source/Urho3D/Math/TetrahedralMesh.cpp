@@ -32,6 +32,10 @@
 
 #include <cmath>
 
+#ifdef URHO3D_SSE
+#include <emmintrin.h>
+#endif
+
 namespace Urho3D
 {
 
@@ -153,6 +157,7 @@ void TetrahedralMesh::Define(ea::span<const Vector3> positions)
     boundingBox.max_ += Vector3::ONE;
     InitializeSuperMesh(boundingBox);
     BuildTetrahedrons(positions);
+    UpdateLookupData();
 }
 
 void TetrahedralMesh::CollectEdges(ea::vector<ea::pair<unsigned, unsigned>>& edges)
@@ -271,7 +276,7 @@ Vector4 TetrahedralMesh::GetInterpolationFactors(const Vector3& position, unsign
 
     const unsigned maxIters = tetrahedrons_.size();
     if (tetIndexHint >= maxIters)
-        tetIndexHint = 0;
+        tetIndexHint = GetLookupTetrahedron(position);
 
     for (unsigned i = 0; i < maxIters; ++i)
     {
@@ -291,6 +296,91 @@ Vector4 TetrahedralMesh::GetInterpolationFactors(const Vector3& position, unsign
     return GetBarycentricCoords(tetIndexHint, position);
 }
 
+void TetrahedralMesh::GetInterpolationFactors(ea::span<const Vector3> positions, ea::span<Vector4> weights,
+    ea::span<unsigned> tetIndexHints) const
+{
+    const unsigned numPositions = positions.size();
+    if (tetrahedrons_.empty())
+    {
+        for (unsigned i = 0; i < numPositions; ++i)
+            weights[i] = Vector4::ZERO;
+        return;
+    }
+
+    for (unsigned i = 0; i < numPositions; ++i)
+    {
+        const Vector3& position = positions[i];
+        unsigned& tetIndex = tetIndexHints[i];
+
+        // Objects usually stay in the same tetrahedron, check the hint before doing the lookup
+        if (tetIndex < numInnerTetrahedrons_ && GetInnerBarycentricCoordsFast(tetIndex, position, weights[i]))
+            continue;
+
+        tetIndex = WalkToTetrahedron(position, GetLookupTetrahedron(position), weights[i]);
+    }
+}
+
+unsigned TetrahedralMesh::GetLookupTetrahedron(const Vector3& position) const
+{
+    if (lookupGrid_.empty())
+        return tetrahedrons_.empty() ? M_MAX_UNSIGNED : 0;
+
+    const Vector3 cell = VectorMax(Vector3::ZERO, (position - lookupGridBox_.min_) * lookupGridCellSizeInv_);
+    const int x = ea::min(static_cast<int>(cell.x_), lookupGridSize_.x_ - 1);
+    const int y = ea::min(static_cast<int>(cell.y_), lookupGridSize_.y_ - 1);
+    const int z = ea::min(static_cast<int>(cell.z_), lookupGridSize_.z_ - 1);
+    return lookupGrid_[(z * lookupGridSize_.y_ + y) * lookupGridSize_.x_ + x];
+}
+
+void TetrahedralMesh::UpdateLookupData()
+{
+    barycentricMatrices_.resize(numInnerTetrahedrons_);
+    for (unsigned tetIndex = 0; tetIndex < numInnerTetrahedrons_; ++tetIndex)
+    {
+        const Tetrahedron& tetrahedron = tetrahedrons_[tetIndex];
+        const Matrix3x4& m = tetrahedron.matrix_;
+        TetrahedronBarycentricMatrix& matrix = barycentricMatrices_[tetIndex];
+        matrix.basePosition_ = Vector4(vertices_[tetrahedron.indices_[0]], 0.0f);
+        matrix.columns_[0] = { -m.m00_ - m.m10_ - m.m20_, m.m00_, m.m10_, m.m20_ };
+        matrix.columns_[1] = { -m.m01_ - m.m11_ - m.m21_, m.m01_, m.m11_, m.m21_ };
+        matrix.columns_[2] = { -m.m02_ - m.m12_ - m.m22_, m.m02_, m.m12_, m.m22_ };
+    }
+
+    lookupGrid_.clear();
+    if (numInnerTetrahedrons_ == 0)
+        return;
+
+    // Aim for about one cell per inner tetrahedron
+    lookupGridBox_ = BoundingBox(vertices_.data(), vertices_.size());
+    const Vector3 size = VectorMax(lookupGridBox_.Size(), Vector3::ONE * M_EPSILON);
+    const float cellSize = std::cbrt(size.x_ * size.y_ * size.z_ / numInnerTetrahedrons_);
+    const auto getNumCells = [&](float axisSize)
+    { return Clamp(CeilToInt(axisSize / ea::max(cellSize, M_EPSILON)), 1, MaxLookupGridSize); };
+
+    lookupGridSize_ = { getNumCells(size.x_), getNumCells(size.y_), getNumCells(size.z_) };
+    lookupGridCellSizeInv_ = lookupGridSize_.ToVector3() / size;
+    lookupGrid_.resize(lookupGridSize_.x_ * lookupGridSize_.y_ * lookupGridSize_.z_);
+
+    // Walk from the previous cell, neighbor cells are usually close in the mesh
+    const Vector3 cellSizeVector = size / lookupGridSize_.ToVector3();
+    unsigned tetIndex = 0;
+    unsigned cellIndex = 0;
+    for (int z = 0; z < lookupGridSize_.z_; ++z)
+    {
+        for (int y = 0; y < lookupGridSize_.y_; ++y)
+        {
+            for (int x = 0; x < lookupGridSize_.x_; ++x)
+            {
+                const Vector3 cellOffset = IntVector3(x, y, z).ToVector3() + Vector3::ONE * 0.5f;
+                const Vector3 cellCenter = lookupGridBox_.min_ + cellOffset * cellSizeVector;
+                Vector4 weights;
+                tetIndex = WalkToTetrahedron(cellCenter, tetIndex, weights);
+                lookupGrid_[cellIndex++] = tetIndex;
+            }
+        }
+    }
+}
+
 int TetrahedralMesh::SolveCubicEquation(double result[], double a, double b, double c, double eps)
 {
     // Performance-critical code, don't use degree-based functions here
@@ -419,6 +509,67 @@ unsigned TetrahedralMesh::FindTetrahedron(const Vector3& position, ea::vector<bo
     return tetIndex;
 }
 
+bool TetrahedralMesh::GetInnerBarycentricCoordsFast(unsigned tetIndex, const Vector3& position, Vector4& weights) const
+{
+    const TetrahedronBarycentricMatrix& matrix = barycentricMatrices_[tetIndex];
+#ifdef URHO3D_SSE
+    const __m128 offset = _mm_sub_ps(_mm_set_ps(0.0f, position.z_, position.y_, position.x_),
+        _mm_loadu_ps(&matrix.basePosition_.x_));
+    const __m128 x = _mm_shuffle_ps(offset, offset, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 y = _mm_shuffle_ps(offset, offset, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 z = _mm_shuffle_ps(offset, offset, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 result = _mm_add_ps(_mm_set_ps(0.0f, 0.0f, 0.0f, 1.0f),
+        _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&matrix.columns_[0].x_), x),
+        _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&matrix.columns_[1].x_), y),
+        _mm_mul_ps(_mm_loadu_ps(&matrix.columns_[2].x_), z))));
+    _mm_storeu_ps(&weights.x_, result);
+    return _mm_movemask_ps(_mm_cmplt_ps(result, _mm_setzero_ps())) == 0;
+#else
+    const Vector3 offset = position - matrix.basePosition_.ToVector3();
+    weights = Vector4(1.0f, 0.0f, 0.0f, 0.0f) + matrix.columns_[0] * offset.x_
+        + matrix.columns_[1] * offset.y_ + matrix.columns_[2] * offset.z_;
+    return weights.x_ >= 0.0f && weights.y_ >= 0.0f && weights.z_ >= 0.0f && weights.w_ >= 0.0f;
+#endif
+}
+
+unsigned TetrahedralMesh::WalkToTetrahedron(const Vector3& position, unsigned tetIndex, Vector4& weights) const
+{
+    const unsigned maxIters = tetrahedrons_.size();
+    if (tetIndex >= maxIters)
+        tetIndex = 0;
+
+    for (unsigned i = 0; i < maxIters; ++i)
+    {
+        if (tetIndex < numInnerTetrahedrons_)
+        {
+            if (GetInnerBarycentricCoordsFast(tetIndex, position, weights))
+                return tetIndex;
+        }
+        else
+        {
+            weights = GetOuterBarycentricCoords(tetIndex, position);
+            if (weights.x_ >= 0.0f && weights.y_ >= 0.0f && weights.z_ >= 0.0f && weights.w_ >= 0.0f)
+                return tetIndex;
+        }
+
+        unsigned nextTetIndex{};
+        if (weights.x_ < weights.y_ && weights.x_ < weights.z_ && weights.x_ < weights.w_)
+            nextTetIndex = tetrahedrons_[tetIndex].neighbors_[0];
+        else if (weights.y_ < weights.z_ && weights.y_ < weights.w_)
+            nextTetIndex = tetrahedrons_[tetIndex].neighbors_[1];
+        else if (weights.z_ < weights.w_)
+            nextTetIndex = tetrahedrons_[tetIndex].neighbors_[2];
+        else
+            nextTetIndex = tetrahedrons_[tetIndex].neighbors_[3];
+
+        if (nextTetIndex >= maxIters)
+            break;
+        tetIndex = nextTetIndex;
+    }
+    weights = GetBarycentricCoords(tetIndex, position);
+    return tetIndex;
+}
+
 void TetrahedralMesh::InitializeSuperMesh(const BoundingBox& boundingBox)
 {
     static const Vector3 offsets[NumSuperMeshVertices] =
@@ -1239,6 +1390,9 @@ void SerializeValue(Archive& archive, const char* name, TetrahedralMesh& value)
     SerializeVector(archive, "tetrahedrons", value.tetrahedrons_);
     SerializeVector(archive, "hullNormals", value.hullNormals_);
     SerializeValue(archive, "numInnerTetrahedrons", value.numInnerTetrahedrons_);
+
+    if (archive.IsInput())
+        value.UpdateLookupData();
 }
 
 }
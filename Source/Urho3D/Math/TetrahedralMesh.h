@@ -27,6 +27,7 @@
 #include "../Math/BoundingBox.h"
 #include "../Math/Matrix3x4.h"
 #include "../Math/Vector3.h"
+#include "../Math/Vector4.h"
 
 #include <EASTL/algorithm.h>
 #include <EASTL/span.h>
@@ -296,10 +297,24 @@ struct Tetrahedron
     }
 };
 
+/// Barycentric coordinates of inner tetrahedron as affine function of position, laid out for SIMD evaluation.
+struct TetrahedronBarycentricMatrix
+{
+    /// Position of the first vertex, W is unused.
+    Vector4 basePosition_;
+    /// Columns of the matrix, one column per world axis. Each column contains all four barycentric weights.
+    Vector4 columns_[3];
+};
+
 /// Tetrahedral mesh.
 class URHO3D_API TetrahedralMesh
 {
 public:
+    /// Max number of lookup grid cells along one axis.
+    static const int MaxLookupGridSize = 32;
+    /// Number of positions processed at once by batched sampling.
+    static const unsigned SampleBatchSize = 64;
+
     /// Define mesh from vertices.
     void Define(ea::span<const Vector3> positions);
 
@@ -320,6 +335,14 @@ public:
 
     /// Find tetrahedron containing given position and calculate barycentric coordinates within this tetrahedron.
     Vector4 GetInterpolationFactors(const Vector3& position, unsigned& tetIndexHint) const;
+    /// Batched version of GetInterpolationFactors. Hints are used as starting points if still valid.
+    void GetInterpolationFactors(ea::span<const Vector3> positions, ea::span<Vector4> weights,
+        ea::span<unsigned> tetIndexHints) const;
+    /// Return tetrahedron close to given position from lookup grid, or invalid index if the mesh is empty.
+    unsigned GetLookupTetrahedron(const Vector3& position) const;
+
+    /// Rebuild barycentric matrices and lookup grid. Should be called if mesh data is changed manually.
+    void UpdateLookupData();
 
     /// Sample value at given position from the arbitrary container of per-vertex data.
     template <class Container>
@@ -339,6 +362,37 @@ public:
         return result;
     }
 
+    /// Batched version of Sample. Spans should have the same size.
+    template <class Container, class Result>
+    void Sample(const Container& container, ea::span<const Vector3> positions, ea::span<Result> results,
+        ea::span<unsigned> tetIndexHints) const
+    {
+        Vector4 weights[SampleBatchSize];
+        const unsigned numPositions = positions.size();
+        for (unsigned batchBegin = 0; batchBegin < numPositions; batchBegin += SampleBatchSize)
+        {
+            const unsigned batchSize = ea::min(SampleBatchSize, numPositions - batchBegin);
+            GetInterpolationFactors(positions.subspan(batchBegin, batchSize),
+                ea::span<Vector4>(weights, batchSize), tetIndexHints.subspan(batchBegin, batchSize));
+
+            for (unsigned i = 0; i < batchSize; ++i)
+            {
+                Result& result = results[batchBegin + i];
+                result = Result{};
+
+                const unsigned tetIndex = tetIndexHints[batchBegin + i];
+                if (tetIndex >= tetrahedrons_.size())
+                    continue;
+
+                const Tetrahedron& tetrahedron = tetrahedrons_[tetIndex];
+                for (unsigned j = 0; j < 3; ++j)
+                    result += container[tetrahedron.indices_[j]] * weights[i][j];
+                if (tetIndex < numInnerTetrahedrons_)
+                    result += container[tetrahedron.indices_[3]] * weights[i][3];
+            }
+        }
+    }
+
 private:
     /// Solve cubic equation x^3 + a*x^2 + b*x + c = 0.
     static int SolveCubicEquation(double result[], double a, double b, double c, double eps);
@@ -353,6 +407,11 @@ private:
         const Vector3& p1, const Vector3& p2, const Vector3& p3);
     /// Find tetrahedron for given position. Ignore removed tetrahedrons. Return invalid index if cannot find.
     unsigned FindTetrahedron(const Vector3& position, ea::vector<bool>& removed) const;
+    /// Calculate barycentric coordinates for inner tetrahedron from pre-computed matrix.
+    /// Return whether the position is inside of the tetrahedron.
+    bool GetInnerBarycentricCoordsFast(unsigned tetIndex, const Vector3& position, Vector4& weights) const;
+    /// Walk the mesh from given tetrahedron towards the position. Return the last visited tetrahedron.
+    unsigned WalkToTetrahedron(const Vector3& position, unsigned tetIndex, Vector4& weights) const;
 
     /// Number of initial super-mesh vertices.
     static const unsigned NumSuperMeshVertices = 8;
@@ -424,6 +483,17 @@ public:
     /// Number of inner tetrahedrons.
     unsigned numInnerTetrahedrons_{};
 
+    /// Barycentric matrices of inner tetrahedrons. Not serialized.
+    ea::vector<TetrahedronBarycentricMatrix> barycentricMatrices_;
+    /// Bounding box covered by lookup grid.
+    BoundingBox lookupGridBox_;
+    /// Number of lookup grid cells along each axis.
+    IntVector3 lookupGridSize_;
+    /// Inverse size of lookup grid cell.
+    Vector3 lookupGridCellSizeInv_;
+    /// Tetrahedrons containing centers of lookup grid cells. Not serialized.
+    ea::vector<unsigned> lookupGrid_;
+
     /// Debug array of edges related to errors in generation.
     mutable ea::vector<ea::pair<unsigned, unsigned>> debugHighlightEdges_;
 };
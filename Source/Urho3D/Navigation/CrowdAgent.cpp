@@ -93,6 +93,7 @@ CrowdAgent::CrowdAgent(Context* context) :
     ignoreTransformChanges_(false)
 {
     SubscribeToEvent(E_NAVIGATION_TILE_ADDED, URHO3D_HANDLER(CrowdAgent, HandleNavigationTileAdded));
+    SubscribeToEvent(E_NAVIGATION_TILE_REMOVED, URHO3D_HANDLER(CrowdAgent, HandleNavigationTileRemoved));
 }
 
 CrowdAgent::~CrowdAgent()
@@ -657,13 +658,32 @@ void CrowdAgent::HandleNavigationTileAdded(StringHash eventType, VariantMap& eve
     if (crowdManager_->GetNavigationMesh() != mesh)
         return;
 
+    const IntVector2 tile = eventData[NavigationTileAdded::P_TILE].GetIntVector2();
+    const IntVector2 agentTile = mesh->GetTileIndex(node_->GetWorldPosition());
+    if (tile == agentTile && (IsInCrowd() || parked_))
+    {
+        parked_ = false;
+        RemoveAgentFromCrowd();
+        AddAgentToCrowd();
+    }
+}
+
+void CrowdAgent::HandleNavigationTileRemoved(StringHash eventType, VariantMap& eventData)
+{
+    if (!crowdManager_)
+        return;
+
+    auto* mesh = static_cast<NavigationMesh*>(eventData[NavigationTileRemoved::P_MESH].GetPtr());
+    if (crowdManager_->GetNavigationMesh() != mesh)
+        return;
+
+    // Agent cannot move without the tile, keep it out of the crowd until the tile is streamed back
     const IntVector2 tile = eventData[NavigationTileRemoved::P_TILE].GetIntVector2();
     const IntVector2 agentTile = mesh->GetTileIndex(node_->GetWorldPosition());
-    const BoundingBox boundingBox = mesh->GetTileBoundingBox(agentTile);
     if (tile == agentTile && IsInCrowd())
     {
         RemoveAgentFromCrowd();
-        AddAgentToCrowd();
+        parked_ = true;
     }
 }
 
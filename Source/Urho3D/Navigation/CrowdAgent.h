@@ -210,6 +210,9 @@ public:
     /// Return true when the agent is in crowd (being managed by a crowd manager).
     /// @property
     bool IsInCrowd() const;
+    /// Return true when the agent is removed from crowd because its navigation mesh tile is unloaded.
+    /// The agent is returned to crowd when the tile is loaded back.
+    bool IsParked() const { return parked_; }
 
 protected:
     /// Handle crowd agent pre-update.
@@ -226,6 +229,8 @@ protected:
     const dtCrowdAgent* GetDetourCrowdAgent() const;
     /// Handle navigation mesh tile added.
     void HandleNavigationTileAdded(StringHash eventType, VariantMap& eventData);
+    /// Handle navigation mesh tile removed.
+    void HandleNavigationTileRemoved(StringHash eventType, VariantMap& eventData);
 
 private:
     /// Update Detour crowd agent parameter.
@@ -270,6 +275,8 @@ private:
     CrowdAgentState previousAgentState_;
     /// Internal flag to ignore transform changes because it came from us, used in OnCrowdAgentReposition().
     bool ignoreTransformChanges_;
+    /// Whether the agent is removed from crowd until its tile is added back.
+    bool parked_{};
 };
 
 }
@@ -24,6 +24,7 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../IO/Log.h"
 #include "../Navigation/CrowdAgent.h"
@@ -67,13 +68,27 @@ static const StringVector obstacleAvoidanceTypesStructureElementNames =
     "   Adaptive Depth"
 };
 
+/// Min number of agents processed by one thread.
+static const unsigned PARALLEL_UPDATE_BUCKET_SIZE = 32;
+
 void CrowdAgentUpdateCallback(bool positionUpdate, dtCrowdAgent* ag, float* pos, float dt)
 {
     auto crowdAgent = static_cast<CrowdAgent*>(ag->params.userData);
-    if (positionUpdate)
-        crowdAgent->OnCrowdPositionUpdate(ag, pos, dt);
-    else
+    if (!positionUpdate)
         crowdAgent->OnCrowdVelocityUpdate(ag, pos, dt);
+    else if (CrowdManager* crowdManager = crowdAgent->crowdManager_)
+        crowdManager->movedAgents_.emplace_back(crowdAgent);
+}
+
+static void CrowdParallelFor(void* userData, int count, dtCrowdRangeCallback callback, void* context)
+{
+    auto workQueue = static_cast<WorkQueue*>(userData);
+    ForEachParallel(workQueue, PARALLEL_UPDATE_BUCKET_SIZE, static_cast<unsigned>(count),
+        [&](unsigned beginIndex, unsigned endIndex)
+    {
+        callback(context, static_cast<int>(beginIndex), static_cast<int>(endIndex),
+            static_cast<int>(WorkQueue::GetThreadIndex()));
+    });
 }
 
 CrowdManager::CrowdManager(Context* context) :
@@ -99,6 +114,7 @@ void CrowdManager::RegisterObject(Context* context)
 
     URHO3D_ATTRIBUTE("Max Agents", unsigned, maxAgents_, DEFAULT_MAX_AGENTS, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Max Agent Radius", float, maxAgentRadius_, DEFAULT_MAX_AGENT_RADIUS, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Parallel Update", GetParallelUpdate, SetParallelUpdate, bool, true, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Navigation Mesh", unsigned, navigationMeshId_, 0, AM_DEFAULT | AM_COMPONENTID);
     URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Filter Types", GetQueryFilterTypesAttr, SetQueryFilterTypesAttr,
         VariantVector, Variant::emptyVariantVector, AM_DEFAULT)
@@ -244,6 +260,31 @@ void CrowdManager::SetMaxAgents(unsigned maxAgents)
     }
 }
 
+void CrowdManager::SetParallelUpdate(bool enable)
+{
+    if (enable != parallelUpdate_)
+    {
+        parallelUpdate_ = enable;
+        UpdateParallelConfiguration();
+    }
+}
+
+void CrowdManager::UpdateParallelConfiguration()
+{
+    if (!crowd_)
+        return;
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    if (parallelUpdate_ && workQueue && workQueue->IsMultithreaded())
+    {
+        const int numThreads = static_cast<int>(WorkQueue::GetThreadIndexCount());
+        if (!crowd_->setParallelFor(CrowdParallelFor, workQueue, numThreads))
+            URHO3D_LOGERROR("Could not initialize parallel update of DetourCrowd");
+    }
+    else
+        crowd_->setParallelFor(nullptr, nullptr, 0);
+}
+
 void CrowdManager::SetMaxAgentRadius(float maxAgentRadius)
 {
     if (maxAgentRadius != maxAgentRadius_ && maxAgentRadius > 0.f)
@@ -403,6 +444,15 @@ void CrowdManager::FindPath(ea::vector<Vector3>& dest, const Vector3& start, con
         navigationMesh_->FindPath(dest, start, end, Vector3(crowd_->getQueryExtents()), crowd_->getFilter(queryFilterType));
 }
 
+SharedPtr<NavigationPathRequest> CrowdManager::RequestPath(const Vector3& start, const Vector3& end,
+    int queryFilterType, const NavigationPathRequest::Callback& callback)
+{
+    if (!crowd_ || !navigationMesh_)
+        return nullptr;
+    return navigationMesh_->RequestPath(
+        start, end, Vector3(crowd_->getQueryExtents()), crowd_->getFilter(queryFilterType), callback);
+}
+
 Vector3 CrowdManager::GetRandomPoint(int queryFilterType, dtPolyRef* randomRef)
 {
     if (randomRef)
@@ -586,6 +636,7 @@ bool CrowdManager::CreateCrowd()
     }
 
     // Reconfigure the newly initialized crowd
+    UpdateParallelConfiguration();
     SetQueryFilterTypesAttr(queryFilterTypeConfiguration);
     SetObstacleAvoidanceTypesAttr(obstacleAvoidanceTypeConfiguration);
 
@@ -671,7 +722,19 @@ void CrowdManager::Update(float delta)
 {
     assert(crowd_ && navigationMesh_);
     URHO3D_PROFILE("UpdateCrowd");
+    movedAgents_.clear();
     crowd_->update(delta, nullptr);
+
+    // Apply positions after the whole crowd is updated because event handlers may modify the crowd
+    for (const WeakPtr<CrowdAgent>& agent : movedAgents_)
+    {
+        if (!agent || !crowd_ || !agent->IsInCrowd())
+            continue;
+
+        dtCrowdAgent* ag = crowd_->getEditableAgent(agent->GetAgentCrowdId());
+        agent->OnCrowdPositionUpdate(ag, ag->npos, delta);
+    }
+    movedAgents_.clear();
 }
 
 const dtCrowdAgent* CrowdManager::GetDetourCrowdAgent(int agent) const
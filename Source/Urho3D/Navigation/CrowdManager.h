@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "../Navigation/NavigationMesh.h"
 #include "../Scene/Component.h"
 
 #ifdef DT_POLYREF64
@@ -65,6 +66,7 @@ class URHO3D_API CrowdManager : public Component
     URHO3D_OBJECT(CrowdManager, Component);
 
     friend class CrowdAgent;
+    friend void CrowdAgentUpdateCallback(bool positionUpdate, dtCrowdAgent* ag, float* pos, float dt);
 
 public:
     /// Construct.
@@ -96,6 +98,9 @@ public:
     /// Set the maximum number of agents.
     /// @property
     void SetMaxAgents(unsigned maxAgents);
+    /// Set whether to update independent steps of the crowd simulation in WorkQueue threads.
+    /// @property
+    void SetParallelUpdate(bool enable);
     /// Set the maximum radius of any agent.
     /// @property
     void SetMaxAgentRadius(float maxAgentRadius);
@@ -123,6 +128,9 @@ public:
     Vector3 MoveAlongSurface(const Vector3& start, const Vector3& end, int queryFilterType, int maxVisited = 3);
     /// Find a path between world space points using the crowd initialized query extent (based on maxAgentRadius) and the specified query filter type. Return non-empty list of points if successful.
     void FindPath(ea::vector<Vector3>& dest, const Vector3& start, const Vector3& end, int queryFilterType);
+    /// Request path between world space points using the crowd initialized query extent (based on maxAgentRadius) and the specified query filter type. Path is found during one of the next frames. Return null if the crowd is not initialized.
+    SharedPtr<NavigationPathRequest> RequestPath(const Vector3& start, const Vector3& end, int queryFilterType,
+        const NavigationPathRequest::Callback& callback = {});
     /// Return a random point on the navigation mesh using the crowd initialized query extent (based on maxAgentRadius) and the specified query filter type.
     Vector3 GetRandomPoint(int queryFilterType, dtPolyRef* randomRef = nullptr);
     /// Return a random point on the navigation mesh within a circle using the crowd initialized query extent (based on maxAgentRadius) and the specified query filter type. The circle radius is only a guideline and in practice the returned point may be further away.
@@ -136,6 +144,10 @@ public:
     /// @property
     unsigned GetMaxAgents() const { return maxAgents_; }
 
+    /// Return whether to update independent steps of the crowd simulation in WorkQueue threads.
+    /// @property
+    bool GetParallelUpdate() const { return parallelUpdate_; }
+
     /// Get the maximum radius of any agent.
     /// @property
     float GetMaxAgentRadius() const { return maxAgentRadius_; }
@@ -197,6 +209,8 @@ private:
     void HandleNavMeshChanged(StringHash eventType, VariantMap& eventData);
     /// Handle component added in the scene to check for late addition of the navmesh.
     void HandleComponentAdded(StringHash eventType, VariantMap& eventData);
+    /// Configure parallel update of the crowd.
+    void UpdateParallelConfiguration();
 
     /// Internal Detour crowd object.
     dtCrowd* crowd_{};
@@ -216,6 +230,10 @@ private:
     ea::vector<unsigned> numAreas_;
     /// Number of obstacle avoidance types configured in the crowd. Limit to DT_CROWD_MAX_OBSTAVOIDANCE_PARAMS.
     unsigned numObstacleAvoidanceTypes_{};
+    /// Whether to update the crowd in WorkQueue threads.
+    bool parallelUpdate_{true};
+    /// Agents moved during the crowd update. Positions are applied after the whole crowd is updated.
+    ea::vector<WeakPtr<CrowdAgent>> movedAgents_;
 };
 
 }
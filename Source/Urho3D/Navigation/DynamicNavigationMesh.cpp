@@ -26,6 +26,7 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../IO/Log.h"
 #include "../IO/MemoryBuffer.h"
@@ -52,6 +53,7 @@
 //#include "../DebugNew.h"
 
 static const unsigned TILECACHE_MAXLAYERS = 255;
+static const unsigned TILE_BUILD_BATCH_SIZE = 64;
 
 namespace Urho3D
 {
@@ -65,6 +67,60 @@ struct DynamicNavigationMesh::TileCacheData
     int dataSize;
 };
 
+/// Tile of DynamicNavigationMesh built by Recast and compressed into tile cache layers.
+struct DynamicNavigationMesh::DynamicTileBuildTask : public NavigationMesh::TileBuildTask
+{
+    DynamicTileBuildTask(DynamicNavigationMesh* owner, const IntVector2& tile)
+        : TileBuildTask(tile)
+        , owner_(owner)
+        , build_(owner->allocator_.get())
+    {
+    }
+
+    ~DynamicTileBuildTask() override
+    {
+        for (int i = 0; i < numLayers_; ++i)
+            dtFree(layers_[i].data);
+    }
+
+    void Build() override { numLayers_ = owner_->BuildTileLayers(build_, cfg_, tile_, layers_); }
+
+    unsigned Commit() override
+    {
+        dtTileCache* tileCache = owner_->tileCache_;
+        owner_->RemoveTileCacheLayers(tile_);
+
+        unsigned numTiles = 0;
+        for (int i = 0; i < numLayers_; ++i)
+        {
+            TileCacheData& layer = layers_[i];
+            dtCompressedTileRef tileRef;
+            const dtStatus status = tileCache->addTile(layer.data, layer.dataSize, DT_COMPRESSEDTILE_FREE_DATA, &tileRef);
+            if (dtStatusFailed(status))
+            {
+                dtFree(layer.data);
+                layer.data = nullptr;
+                continue;
+            }
+
+            // Tile cache owns the data now
+            layer.data = nullptr;
+            tileCache->buildNavMeshTile(tileRef, owner_->navMesh_);
+            ++numTiles;
+        }
+
+        if (numLayers_ > 0)
+            owner_->SendTileRebuiltEvent(tile_);
+        return numTiles;
+    }
+
+    DynamicNavigationMesh* owner_{};
+    rcConfig cfg_;      // NOLINT(hicpp-member-init)
+    DynamicNavBuildData build_;
+    TileCacheData layers_[TILECACHE_MAXLAYERS]{};
+    int numLayers_{};
+};
+
 struct TileCompressor : public dtTileCacheCompressor
 {
     int maxCompressedSize(const int bufferSize) override
@@ -159,20 +215,20 @@ struct MeshProcess : public dtTileCacheMeshProcess
 
 
 // From the Detour/Recast Sample_TempObstacles.cpp
-struct LinearAllocator : public dtTileCacheAlloc
+struct TileCacheLinearAllocator : public dtTileCacheAlloc
 {
     unsigned char* buffer;
     int capacity;
     int top;
     int high;
 
-    explicit LinearAllocator(const int cap) :
+    explicit TileCacheLinearAllocator(const int cap) :
         buffer(nullptr), capacity(0), top(0), high(0)
     {
         resize(cap);
     }
 
-    ~LinearAllocator() override
+    ~TileCacheLinearAllocator() override
     {
         dtFree(buffer);
     }
@@ -215,7 +271,7 @@ DynamicNavigationMesh::DynamicNavigationMesh(Context* context) :
     // 64 is the largest tile-size that DetourTileCache will tolerate without silently failing
     tileSize_ = 64;
     partitionType_ = NAVMESH_PARTITION_MONOTONE;
-    allocator_ = ea::make_unique<LinearAllocator>(32000); //32kb to start
+    allocator_ = ea::make_unique<TileCacheLinearAllocator>(32000); //32kb to start
     compressor_ = ea::make_unique<TileCompressor>();
     meshProcessor_ = ea::make_unique<MeshProcess>(this);
 }
@@ -427,28 +483,7 @@ bool DynamicNavigationMesh::Build()
         }
 
         // Build each tile
-        unsigned numTiles = 0;
-
-        for (int z = 0; z < numTilesZ_; ++z)
-        {
-            for (int x = 0; x < numTilesX_; ++x)
-            {
-                TileCacheData tiles[TILECACHE_MAXLAYERS];
-                int layerCt = BuildTile(geometryList, x, z, tiles);
-                for (int i = 0; i < layerCt; ++i)
-                {
-                    dtCompressedTileRef tileRef;
-                    int status = tileCache_->addTile(tiles[i].data, tiles[i].dataSize, DT_COMPRESSEDTILE_FREE_DATA, &tileRef);
-                    if (dtStatusFailed((dtStatus)status))
-                    {
-                        dtFree(tiles[i].data);
-                        tiles[i].data = nullptr;
-                    }
-                }
-                tileCache_->buildNavMeshTilesAt(x, z, navMesh_);
-                ++numTiles;
-            }
-        }
+        const unsigned numTiles = BuildTiles(geometryList, IntVector2::ZERO, GetNumTiles() - IntVector2::ONE);
 
         // For a full build it's necessary to update the nav mesh
         // not doing so will cause dependent components to crash, like CrowdManager
@@ -823,40 +858,24 @@ int DynamicNavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometr
 
     tileCache_->removeTile(navMesh_->getTileRefAt(x, z, 0), nullptr, nullptr);
 
-    const BoundingBox tileBoundingBox = GetTileBoundingBox(IntVector2(x, z));
-
-    DynamicNavBuildData build(allocator_.get());
+    const IntVector2 tile{x, z};
 
     rcConfig cfg;   // NOLINT(hicpp-member-init)
-    memset(&cfg, 0, sizeof cfg);
-    cfg.cs = cellSize_;
-    cfg.ch = cellHeight_;
-    cfg.walkableSlopeAngle = agentMaxSlope_;
-    cfg.walkableHeight = (int)ceilf(agentHeight_ / cfg.ch);
-    cfg.walkableClimb = (int)floorf(agentMaxClimb_ / cfg.ch);
-    cfg.walkableRadius = (int)ceilf(agentRadius_ / cfg.cs);
-    cfg.maxEdgeLen = (int)(edgeMaxLength_ / cellSize_);
-    cfg.maxSimplificationError = edgeMaxError_;
-    cfg.minRegionArea = (int)sqrtf(regionMinSize_);
-    cfg.mergeRegionArea = (int)sqrtf(regionMergeSize_);
-    cfg.maxVertsPerPoly = 6;
-    cfg.tileSize = tileSize_;
-    cfg.borderSize = cfg.walkableRadius + 3; // Add padding
-    cfg.width = cfg.tileSize + cfg.borderSize * 2;
-    cfg.height = cfg.tileSize + cfg.borderSize * 2;
-    cfg.detailSampleDist = detailSampleDistance_ < 0.9f ? 0.0f : cellSize_ * detailSampleDistance_;
-    cfg.detailSampleMaxError = cellHeight_ * detailSampleMaxError_;
-
-    rcVcopy(cfg.bmin, &tileBoundingBox.min_.x_);
-    rcVcopy(cfg.bmax, &tileBoundingBox.max_.x_);
-    cfg.bmin[0] -= cfg.borderSize * cfg.cs;
-    cfg.bmin[2] -= cfg.borderSize * cfg.cs;
-    cfg.bmax[0] += cfg.borderSize * cfg.cs;
-    cfg.bmax[2] += cfg.borderSize * cfg.cs;
+    InitializeTileConfig(cfg, tile);
 
+    DynamicNavBuildData build(allocator_.get());
     BoundingBox expandedBox(*reinterpret_cast<Vector3*>(cfg.bmin), *reinterpret_cast<Vector3*>(cfg.bmax));
     GetTileGeometry(&build, geometryList, expandedBox);
 
+    const int numLayers = BuildTileLayers(build, cfg, tile, tiles);
+    if (numLayers > 0)
+        SendTileRebuiltEvent(tile);
+    return numLayers;
+}
+
+int DynamicNavigationMesh::BuildTileLayers(
+    DynamicNavBuildData& build, const rcConfig& cfg, const IntVector2& tile, TileCacheData* tiles) const
+{
     if (build.vertices_.empty() || build.indices_.empty())
         return 0; // Nothing to do
 
@@ -953,8 +972,8 @@ int DynamicNavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometr
         dtTileCacheLayerHeader header;      // NOLINT(hicpp-member-init)
         header.magic = DT_TILECACHE_MAGIC;
         header.version = DT_TILECACHE_VERSION;
-        header.tx = x;
-        header.ty = z;
+        header.tx = tile.x_;
+        header.ty = tile.y_;
         header.tlayer = i;
 
         rcHeightfieldLayer* layer = &build.heightFieldLayers_->layers[i];
@@ -982,58 +1001,34 @@ int DynamicNavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometr
             ++retCt;
     }
 
-    // Send a notification of the rebuild of this tile to anyone interested
-    {
-        using namespace NavigationAreaRebuilt;
-        VariantMap& eventData = GetContext()->GetEventDataMap();
-        eventData[P_NODE] = GetNode();
-        eventData[P_MESH] = this;
-        eventData[P_BOUNDSMIN] = Variant(tileBoundingBox.min_);
-        eventData[P_BOUNDSMAX] = Variant(tileBoundingBox.max_);
-        SendEvent(E_NAVIGATION_AREA_REBUILT, eventData);
-    }
-
     return retCt;
 }
 
-unsigned DynamicNavigationMesh::BuildTiles(ea::vector<NavigationGeometryInfo>& geometryList, const IntVector2& from, const IntVector2& to)
+ea::unique_ptr<NavigationMesh::TileBuildTask> DynamicNavigationMesh::CreateTileBuildTask(
+    ea::vector<NavigationGeometryInfo>& geometryList, const IntVector2& tile)
 {
-    unsigned numTiles = 0;
+    auto task = ea::make_unique<DynamicTileBuildTask>(this, tile);
+    InitializeTileConfig(task->cfg_, tile);
 
-    for (int z = from.y_; z <= to.y_; ++z)
-    {
-        for (int x = from.x_; x <= to.x_; ++x)
-        {
-            dtCompressedTileRef existing[TILECACHE_MAXLAYERS];
-            const int existingCt = tileCache_->getTilesAt(x, z, existing, maxLayers_);
-            for (int i = 0; i < existingCt; ++i)
-            {
-                unsigned char* data = nullptr;
-                if (!dtStatusFailed(tileCache_->removeTile(existing[i], &data, nullptr)) && data != nullptr)
-                    dtFree(data);
-            }
+    BoundingBox expandedBox(*reinterpret_cast<Vector3*>(task->cfg_.bmin), *reinterpret_cast<Vector3*>(task->cfg_.bmax));
+    GetTileGeometry(&task->build_, geometryList, expandedBox);
+    return task;
+}
 
-            TileCacheData tiles[TILECACHE_MAXLAYERS];
-            int layerCt = BuildTile(geometryList, x, z, tiles);
-            for (int i = 0; i < layerCt; ++i)
-            {
-                dtCompressedTileRef tileRef;
-                int status = tileCache_->addTile(tiles[i].data, tiles[i].dataSize, DT_COMPRESSEDTILE_FREE_DATA, &tileRef);
-                if (dtStatusFailed((dtStatus)status))
-                {
-                    dtFree(tiles[i].data);
-                    tiles[i].data = nullptr;
-                }
-                else
-                {
-                    tileCache_->buildNavMeshTile(tileRef, navMesh_);
-                    ++numTiles;
-                }
-            }
-        }
+void DynamicNavigationMesh::RemoveTileCacheLayers(const IntVector2& tile)
+{
+    dtCompressedTileRef existing[TILECACHE_MAXLAYERS];
+    const int existingCt = tileCache_->getTilesAt(tile.x_, tile.y_, existing, maxLayers_);
+    for (int i = 0; i < existingCt; ++i)
+    {
+        unsigned char* data = nullptr;
+        if (!dtStatusFailed(tileCache_->removeTile(existing[i], &data, nullptr)) && data != nullptr)
+            dtFree(data);
     }
 
-    return numTiles;
+    // Remove stale layers of the navigation mesh too, new layers may be fewer
+    for (int layer = 0; layer < existingCt; ++layer)
+        navMesh_->removeTile(navMesh_->getTileRefAt(tile.x_, tile.y_, layer), nullptr, nullptr);
 }
 
 ea::vector<OffMeshConnection*> DynamicNavigationMesh::CollectOffMeshConnections(const BoundingBox& bounds)
@@ -1068,6 +1063,8 @@ void DynamicNavigationMesh::ReleaseTileCache()
 
 void DynamicNavigationMesh::OnSceneSet(Scene* scene)
 {
+    NavigationMesh::OnSceneSet(scene);
+
     // Subscribe to the scene subsystem update, which will trigger the tile cache to update the nav mesh
     if (scene)
         SubscribeToEvent(scene, E_SCENESUBSYSTEMUPDATE, URHO3D_HANDLER(DynamicNavigationMesh, HandleSceneSubsystemUpdate));
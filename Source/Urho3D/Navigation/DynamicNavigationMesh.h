@@ -39,6 +39,7 @@ namespace Urho3D
 
 class OffMeshConnection;
 class Obstacle;
+struct DynamicNavBuildData;
 
 class URHO3D_API DynamicNavigationMesh : public NavigationMesh
 {
@@ -109,6 +110,7 @@ public:
 
 protected:
     struct TileCacheData;
+    struct DynamicTileBuildTask;
 
     /// Subscribe to events when assigned to a scene.
     void OnSceneSet(Scene* scene) override;
@@ -124,8 +126,12 @@ protected:
 
     /// Build one tile of the navigation mesh. Return true if successful.
     int BuildTile(ea::vector<NavigationGeometryInfo>& geometryList, int x, int z, TileCacheData* tiles);
-    /// Build tiles in the rectangular area. Return number of built tiles.
-    unsigned BuildTiles(ea::vector<NavigationGeometryInfo>& geometryList, const IntVector2& from, const IntVector2& to);
+    /// Create task that builds tile cache layers of one tile and collect its geometry.
+    ea::unique_ptr<TileBuildTask> CreateTileBuildTask(ea::vector<NavigationGeometryInfo>& geometryList, const IntVector2& tile) override;
+    /// Build compressed tile cache layers from collected geometry. Return number of layers. Thread-safe.
+    int BuildTileLayers(DynamicNavBuildData& build, const rcConfig& cfg, const IntVector2& tile, TileCacheData* tiles) const;
+    /// Remove all tile cache layers of the tile.
+    void RemoveTileCacheLayers(const IntVector2& tile);
     /// Off-mesh connections to be rebuilt in the mesh processor.
     ea::vector<OffMeshConnection*> CollectOffMeshConnections(const BoundingBox& bounds);
     /// Release the navigation mesh, query, and tile cache.
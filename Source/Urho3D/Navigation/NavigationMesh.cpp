@@ -23,7 +23,9 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/MemoryTracker.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/Drawable.h"
 #include "../Graphics/Geometry.h"
@@ -31,6 +33,8 @@
 #include "../Graphics/StaticModel.h"
 #include "../Graphics/TerrainPatch.h"
 #include "../Graphics/VertexBuffer.h"
+#include "../IO/File.h"
+#include "../IO/FileSystem.h"
 #include "../IO/Log.h"
 #include "../IO/MemoryBuffer.h"
 #include "../Navigation/CrowdAgent.h"
@@ -40,18 +44,25 @@
 #include "../Navigation/Navigable.h"
 #include "../Navigation/NavigationEvents.h"
 #include "../Navigation/NavigationMesh.h"
+#include "../Navigation/NavigationMeshBaker.h"
 #include "../Navigation/Obstacle.h"
 #include "../Navigation/OffMeshConnection.h"
 #ifdef URHO3D_PHYSICS
 #include "../Physics/CollisionShape.h"
 #endif
+#include "../Resource/ResourceCache.h"
 #include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
 
+#include <atomic>
 #include <cfloat>
+#include <thread>
+#include <Detour/DetourAlloc.h>
 #include <Detour/DetourNavMesh.h>
 #include <Detour/DetourNavMeshBuilder.h>
 #include <Detour/DetourNavMeshQuery.h>
 #include <Recast/Recast.h>
+#include <Recast/RecastAlloc.h>
 
 #include "../DebugNew.h"
 
@@ -66,6 +77,14 @@ const char* navmeshPartitionTypeNames[] =
 };
 
 static const int DEFAULT_TILE_SIZE = 128;
+/// Max number of tiles whose geometry is collected at once before building them in parallel.
+static const unsigned TILE_BUILD_BATCH_SIZE = 64;
+static const unsigned DEFAULT_MAX_ASYNC_TILES = 16;
+static const unsigned DEFAULT_MAX_PATH_REQUESTS_PER_FRAME = 256;
+static const int DEFAULT_STREAMING_REGION_SIZE = 8;
+static const float DEFAULT_STREAMING_DISTANCE = 200.0f;
+/// Regions are unloaded a bit further than loaded to avoid reloading them back and forth.
+static const float STREAMING_UNLOAD_DISTANCE_FACTOR = 1.25f;
 static const float DEFAULT_CELL_SIZE = 0.3f;
 static const float DEFAULT_CELL_HEIGHT = 0.2f;
 static const float DEFAULT_AGENT_HEIGHT = 2.0f;
@@ -81,6 +100,26 @@ static const float DEFAULT_DETAIL_SAMPLE_MAX_ERROR = 1.0f;
 
 static const int MAX_POLYS = 2048;
 
+static unsigned GetNavigationMemoryTag()
+{
+    static const unsigned tag = MemoryTracker::RegisterTag("Navigation");
+    return tag;
+}
+
+static void* AllocateNavigationMemory(size_t size, dtAllocHint /*hint*/)
+{
+    return MemoryTracker::AllocateTracked(GetNavigationMemoryTag(), size);
+}
+
+static void* AllocateNavigationMemory(size_t size, rcAllocHint /*hint*/)
+{
+    return MemoryTracker::AllocateTracked(GetNavigationMemoryTag(), size);
+}
+
+static void FreeNavigationMemory(void* ptr)
+{
+    MemoryTracker::FreeTracked(GetNavigationMemoryTag(), ptr);
+}
 
 /// Temporary data for finding a path.
 struct FindPathData
@@ -95,6 +134,147 @@ struct FindPathData
     unsigned char pathFlags_[MAX_POLYS]{};
 };
 
+/// Navigation mesh query owned by one WorkQueue thread.
+struct PathQueryThreadData
+{
+    ~PathQueryThreadData() { dtFreeNavMeshQuery(query_); }
+
+    dtNavMeshQuery* query_{};
+    FindPathData pathData_;
+};
+
+namespace
+{
+
+/// NavArea used to classify path points.
+struct PathAreaInfo
+{
+    BoundingBox boundingBox_;
+    Vector3 center_;
+    unsigned char areaID_{};
+};
+
+ea::vector<PathAreaInfo> CollectPathAreas(const ea::vector<WeakPtr<NavArea>>& areas)
+{
+    ea::vector<PathAreaInfo> result;
+    for (NavArea* area : areas)
+    {
+        if (area && area->IsEnabledEffective())
+            result.push_back({area->GetWorldBoundingBox(), area->GetNode()->GetWorldPosition(), (unsigned char)area->GetAreaID()});
+    }
+    return result;
+}
+
+/// Find path between world space points using given query. Thread-safe as long as the query is not shared.
+void FindPathWithQuery(dtNavMeshQuery* query, FindPathData& pathData, const Matrix3x4& transform,
+    const ea::vector<PathAreaInfo>& areas, ea::vector<NavigationPathPoint>& dest, const Vector3& start,
+    const Vector3& end, const Vector3& extents, const dtQueryFilter* queryFilter)
+{
+    dest.clear();
+
+    // Navigation data is in local space. Transform path points from world to local
+    Matrix3x4 inverse = transform.Inverse();
+
+    Vector3 localStart = inverse * start;
+    Vector3 localEnd = inverse * end;
+
+    dtPolyRef startRef;
+    dtPolyRef endRef;
+    query->findNearestPoly(&localStart.x_, &extents.x_, queryFilter, &startRef, nullptr);
+    query->findNearestPoly(&localEnd.x_, &extents.x_, queryFilter, &endRef, nullptr);
+
+    if (!startRef || !endRef)
+        return;
+
+    int numPolys = 0;
+    int numPathPoints = 0;
+
+    query->findPath(startRef, endRef, &localStart.x_, &localEnd.x_, queryFilter, pathData.polys_, &numPolys,
+        MAX_POLYS);
+    if (!numPolys)
+        return;
+
+    Vector3 actualLocalEnd = localEnd;
+
+    // If full path was not found, clamp end point to the end polygon
+    if (pathData.polys_[numPolys - 1] != endRef)
+        query->closestPointOnPoly(pathData.polys_[numPolys - 1], &localEnd.x_, &actualLocalEnd.x_, nullptr);
+
+    query->findStraightPath(&localStart.x_, &actualLocalEnd.x_, pathData.polys_, numPolys,
+        &pathData.pathPoints_[0].x_, pathData.pathFlags_, pathData.pathPolys_, &numPathPoints, MAX_POLYS);
+
+    // Transform path result back to world space
+    for (int i = 0; i < numPathPoints; ++i)
+    {
+        NavigationPathPoint pt;
+        pt.position_ = transform * pathData.pathPoints_[i];
+        pt.flag_ = (NavigationPathPointFlag)pathData.pathFlags_[i];
+
+        // Walk through all NavAreas and find nearest
+        unsigned char nearestNavAreaID = 0;       // 0 is the default nav area ID
+        float nearestDistance = M_LARGE_VALUE;
+        for (const PathAreaInfo& area : areas)
+        {
+            if (area.boundingBox_.IsInside(pt.position_) == INSIDE)
+            {
+                float distance = (area.center_ - pt.position_).LengthSquared();
+                if (distance < nearestDistance)
+                {
+                    nearestDistance = distance;
+                    nearestNavAreaID = area.areaID_;
+                }
+            }
+        }
+        pt.areaID_ = nearestNavAreaID;
+
+        dest.push_back(pt);
+    }
+}
+
+}
+
+/// Tile of NavigationMesh built by Recast.
+struct NavigationMesh::SimpleTileBuildTask : public NavigationMesh::TileBuildTask
+{
+    SimpleTileBuildTask(NavigationMesh* owner, const IntVector2& tile)
+        : TileBuildTask(tile)
+        , owner_(owner)
+    {
+    }
+
+    ~SimpleTileBuildTask() override { dtFree(navData_); }
+
+    void Build() override { success_ = owner_->BuildTileMesh(build_, cfg_, tile_, navData_, navDataSize_); }
+
+    unsigned Commit() override
+    {
+        unsigned char* navData = ea::exchange(navData_, nullptr);
+        if (!success_)
+        {
+            owner_->AddTileMesh(tile_, nullptr, 0);
+            return 0;
+        }
+        return owner_->AddTileMesh(tile_, navData, navDataSize_) ? 1 : 0;
+    }
+
+    NavigationMesh* owner_{};
+    rcConfig cfg_;      // NOLINT(hicpp-member-init)
+    SimpleNavBuildData build_;
+    unsigned char* navData_{};
+    int navDataSize_{};
+    bool success_{};
+};
+
+/// Tiles of the navigation mesh built asynchronously.
+struct NavigationMesh::AsyncBuildBatch
+{
+    ea::vector<ea::unique_ptr<TileBuildTask>> tasks_;
+    /// Whether the build is started by either worker thread or main thread.
+    std::atomic<bool> started_{};
+    /// Whether the tiles are built.
+    std::atomic<bool> finished_{};
+};
+
 NavigationMesh::NavigationMesh(Context* context) :
     Component(context),
     navMesh_(nullptr),
@@ -120,7 +300,9 @@ NavigationMesh::NavigationMesh(Context* context) :
     partitionType_(NAVMESH_PARTITION_WATERSHED),
     keepInterResults_(false),
     drawOffMeshConnections_(false),
-    drawNavAreas_(false)
+    drawNavAreas_(false),
+    maxAsyncTiles_(DEFAULT_MAX_ASYNC_TILES),
+    maxPathRequestsPerFrame_(DEFAULT_MAX_PATH_REQUESTS_PER_FRAME)
 {
 }
 
@@ -157,6 +339,11 @@ void NavigationMesh::RegisterObject(Context* context)
         NAVMESH_PARTITION_WATERSHED, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Draw OffMeshConnections", GetDrawOffMeshConnections, SetDrawOffMeshConnections, bool, false, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Draw NavAreas", GetDrawNavAreas, SetDrawNavAreas, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Streaming Directory", GetStreamingDirectory, SetStreamingDirectory, ea::string, EMPTY_STRING, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Streaming Region Size", GetStreamingRegionSize, SetStreamingRegionSize, int,
+        DEFAULT_STREAMING_REGION_SIZE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Streaming Distance", GetStreamingDistance, SetStreamingDistance, float,
+        DEFAULT_STREAMING_DISTANCE, AM_DEFAULT);
 }
 
 void NavigationMesh::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
@@ -168,6 +355,9 @@ void NavigationMesh::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
 
     const dtNavMesh* navMesh = navMesh_;
 
+    // Navigation mesh changes rarely, keep its geometry in the debug renderer until any tile is rebuilt
+    unsigned version = worldTransform.ToHash();
+    CombineHash(version, depthTest);
     for (int j = 0; j < navMesh->getMaxTiles(); ++j)
     {
         const dtMeshTile* tile = navMesh->getTile(j);
@@ -175,19 +365,37 @@ void NavigationMesh::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
         if (!tile->header)
             continue;
 
-        for (int i = 0; i < tile->header->polyCount; ++i)
+        CombineHash(version, j);
+        CombineHash(version, tile->salt);
+        CombineHash(version, tile->header->polyCount);
+    }
+
+    const ea::string layerName = Format("NavigationMesh_{}", GetID());
+    if (!debug->DrawRetainedGeometry(layerName, version))
+    {
+        ea::vector<DebugLine> lines;
+        const unsigned color = Color::YELLOW.ToUInt();
+        for (int j = 0; j < navMesh->getMaxTiles(); ++j)
         {
-            dtPoly* poly = tile->polys + i;
-            for (unsigned j = 0; j < poly->vertCount; ++j)
+            const dtMeshTile* tile = navMesh->getTile(j);
+            assert(tile);
+            if (!tile->header)
+                continue;
+
+            for (int i = 0; i < tile->header->polyCount; ++i)
             {
-                debug->AddLine(
-                    worldTransform * *reinterpret_cast<const Vector3*>(&tile->verts[poly->verts[j] * 3]),
-                    worldTransform * *reinterpret_cast<const Vector3*>(&tile->verts[poly->verts[(j + 1) % poly->vertCount] * 3]),
-                    Color::YELLOW,
-                    depthTest
-                );
+                dtPoly* poly = tile->polys + i;
+                for (unsigned j = 0; j < poly->vertCount; ++j)
+                {
+                    lines.emplace_back(
+                        worldTransform * *reinterpret_cast<const Vector3*>(&tile->verts[poly->verts[j] * 3]),
+                        worldTransform * *reinterpret_cast<const Vector3*>(&tile->verts[poly->verts[(j + 1) % poly->vertCount] * 3]),
+                        color);
+                }
             }
         }
+
+        debug->SetRetainedGeometry(layerName, version, lines, {}, depthTest);
     }
 
     Scene* scene = GetScene();
@@ -493,6 +701,149 @@ bool NavigationMesh::Build(const IntVector2& from, const IntVector2& to)
     return true;
 }
 
+void NavigationMesh::BuildAsync(const BoundingBox& boundingBox)
+{
+    if (!node_ || !navMesh_)
+        return;
+
+    const BoundingBox localSpaceBox = boundingBox.Transformed(node_->GetWorldTransform().Inverse());
+    const float tileEdgeLength = (float)tileSize_ * cellSize_;
+
+    const int sx = Clamp((int)((localSpaceBox.min_.x_ - boundingBox_.min_.x_) / tileEdgeLength), 0, numTilesX_ - 1);
+    const int sz = Clamp((int)((localSpaceBox.min_.z_ - boundingBox_.min_.z_) / tileEdgeLength), 0, numTilesZ_ - 1);
+    const int ex = Clamp((int)((localSpaceBox.max_.x_ - boundingBox_.min_.x_) / tileEdgeLength), 0, numTilesX_ - 1);
+    const int ez = Clamp((int)((localSpaceBox.max_.z_ - boundingBox_.min_.z_) / tileEdgeLength), 0, numTilesZ_ - 1);
+
+    BuildAsync(IntVector2(sx, sz), IntVector2(ex, ez));
+}
+
+void NavigationMesh::BuildAsync(const IntVector2& from, const IntVector2& to)
+{
+    if (!node_ || !navMesh_)
+        return;
+
+    // Tiles being built are queued again because their geometry may be outdated
+    for (const IntVector2& tile : GetTilesInRect(VectorMax(from, IntVector2::ZERO), VectorMin(to, GetNumTiles() - IntVector2::ONE)))
+    {
+        if (asyncQueuedTiles_.insert(tile).second)
+            asyncQueue_.push_back(tile);
+    }
+
+    StartAsyncBatch();
+}
+
+void NavigationMesh::CompleteAsyncBuild()
+{
+    URHO3D_PROFILE("CompleteAsyncNavigationMeshBuild");
+
+    while (IsAsyncBuildPending())
+    {
+        StartAsyncBatch();
+
+        const ea::shared_ptr<AsyncBuildBatch> batch = asyncBatch_;
+        if (!batch)
+            continue;
+
+        if (!batch->started_.exchange(true))
+        {
+            for (const auto& task : batch->tasks_)
+                task->Build();
+            batch->finished_.store(true, std::memory_order_release);
+        }
+        else
+        {
+            while (!batch->finished_.load(std::memory_order_acquire))
+                std::this_thread::yield();
+        }
+
+        FinishAsyncBatch(batch.get());
+    }
+}
+
+void NavigationMesh::StartAsyncBatch()
+{
+    if (asyncBatch_ || asyncQueue_.empty())
+        return;
+
+    URHO3D_PROFILE("StartAsyncNavigationMeshBuild");
+
+    ea::vector<NavigationGeometryInfo> geometryList;
+    CollectGeometries(geometryList);
+
+    // Collect geometry in the main thread because it accesses the scene
+    const unsigned batchSize = ea::min(maxAsyncTiles_, asyncQueue_.size());
+    auto batch = ea::make_shared<AsyncBuildBatch>();
+    for (unsigned i = 0; i < batchSize; ++i)
+    {
+        asyncQueuedTiles_.erase(asyncQueue_[i]);
+        batch->tasks_.push_back(CreateTileBuildTask(geometryList, asyncQueue_[i]));
+    }
+    asyncQueue_.erase(asyncQueue_.begin(), asyncQueue_.begin() + batchSize);
+    asyncBatch_ = batch;
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    if (!workQueue)
+    {
+        batch->started_ = true;
+        for (const auto& task : batch->tasks_)
+            task->Build();
+        batch->finished_ = true;
+        FinishAsyncBatch(batch.get());
+        return;
+    }
+
+    WeakPtr<NavigationMesh> weakSelf{this};
+    workQueue->PostTask([=]()
+    {
+        if (batch->started_.exchange(true))
+            return;
+
+        for (const auto& task : batch->tasks_)
+            task->Build();
+        batch->finished_.store(true, std::memory_order_release);
+
+        workQueue->PostTaskForMainThread([=]()
+        {
+            if (weakSelf)
+                weakSelf->FinishAsyncBatch(batch.get());
+        });
+    }, TaskPriority::Low);
+}
+
+void NavigationMesh::FinishAsyncBatch(AsyncBuildBatch* batch)
+{
+    if (asyncBatch_.get() != batch)
+        return;
+
+    URHO3D_PROFILE("FinishAsyncNavigationMeshBuild");
+
+    // Keep the batch alive until all tasks are committed
+    const ea::shared_ptr<AsyncBuildBatch> batchHolder = ea::move(asyncBatch_);
+
+    unsigned numTiles = 0;
+    for (const auto& task : batchHolder->tasks_)
+        numTiles += task->Commit();
+    URHO3D_LOGDEBUG("Rebuilt " + ea::to_string(numTiles) + " tiles of the navigation mesh asynchronously");
+
+    StartAsyncBatch();
+}
+
+void NavigationMesh::CancelAsyncBuild()
+{
+    asyncQueue_.clear();
+    asyncQueuedTiles_.clear();
+
+    if (const ea::shared_ptr<AsyncBuildBatch> batch = ea::move(asyncBatch_))
+    {
+        // Tasks access this object, so wait if worker thread has already started them
+        if (batch->started_.exchange(true))
+        {
+            while (!batch->finished_.load(std::memory_order_acquire))
+                std::this_thread::yield();
+        }
+    }
+}
+
 ea::vector<unsigned char> NavigationMesh::GetTileData(const IntVector2& tile) const
 {
     VectorBuffer ret;
@@ -642,73 +993,303 @@ void NavigationMesh::FindPath(ea::vector<NavigationPathPoint>& dest, const Vecto
     if (!InitializeQuery())
         return;
 
-    // Navigation data is in local space. Transform path points from world to local
-    const Matrix3x4& transform = node_->GetWorldTransform();
-    Matrix3x4 inverse = transform.Inverse();
-
-    Vector3 localStart = inverse * start;
-    Vector3 localEnd = inverse * end;
-
     const dtQueryFilter* queryFilter = filter ? filter : queryFilter_.get();
-    dtPolyRef startRef;
-    dtPolyRef endRef;
-    navMeshQuery_->findNearestPoly(&localStart.x_, &extents.x_, queryFilter, &startRef, nullptr);
-    navMeshQuery_->findNearestPoly(&localEnd.x_, &extents.x_, queryFilter, &endRef, nullptr);
+    FindPathWithQuery(navMeshQuery_, *pathData_, node_->GetWorldTransform(), CollectPathAreas(areas_), dest, start,
+        end, extents, queryFilter);
+}
 
-    if (!startRef || !endRef)
+SharedPtr<NavigationPathRequest> NavigationMesh::RequestPath(const Vector3& start, const Vector3& end,
+    const Vector3& extents, const dtQueryFilter* filter, const NavigationPathRequest::Callback& callback)
+{
+    auto request = MakeShared<NavigationPathRequest>();
+    request->start_ = start;
+    request->end_ = end;
+    request->extents_ = extents;
+    request->filter_ = filter;
+    request->callback_ = callback;
+    pathRequests_.push_back(request);
+    return request;
+}
+
+void NavigationMesh::ProcessPathRequests(unsigned maxRequests)
+{
+    if (pathRequests_.empty())
         return;
 
-    int numPolys = 0;
-    int numPathPoints = 0;
+    URHO3D_PROFILE("ProcessPathRequests");
 
-    navMeshQuery_->findPath(startRef, endRef, &localStart.x_, &localEnd.x_, queryFilter, pathData_->polys_, &numPolys,
-        MAX_POLYS);
-    if (!numPolys)
-        return;
+    const unsigned numRequests = ea::min(maxRequests, pathRequests_.size());
+    ea::vector<SharedPtr<NavigationPathRequest>> requests(pathRequests_.begin(), pathRequests_.begin() + numRequests);
+    pathRequests_.erase(pathRequests_.begin(), pathRequests_.begin() + numRequests);
 
-    Vector3 actualLocalEnd = localEnd;
+    // Each thread needs its own query because queries are stateful
+    bool hasQueries = navMesh_ && node_;
+    if (hasQueries && threadQueries_.empty())
+    {
+        threadQueries_.resize(WorkQueue::GetThreadIndexCount());
+        for (auto& threadQuery : threadQueries_)
+        {
+            threadQuery = ea::make_unique<PathQueryThreadData>();
+            threadQuery->query_ = dtAllocNavMeshQuery();
+            if (!threadQuery->query_ || dtStatusFailed(threadQuery->query_->init(navMesh_, MAX_POLYS)))
+            {
+                URHO3D_LOGERROR("Could not init navigation mesh query");
+                hasQueries = false;
+            }
+        }
+        if (!hasQueries)
+            threadQueries_.clear();
+    }
 
-    // If full path was not found, clamp end point to the end polygon
-    if (pathData_->polys_[numPolys - 1] != endRef)
-        navMeshQuery_->closestPointOnPoly(pathData_->polys_[numPolys - 1], &localEnd.x_, &actualLocalEnd.x_, nullptr);
+    if (hasQueries)
+    {
+        // Scene is accessed in the main thread only
+        const Matrix3x4 transform = node_->GetWorldTransform();
+        const ea::vector<PathAreaInfo> areas = CollectPathAreas(areas_);
+        const dtQueryFilter* defaultFilter = queryFilter_.get();
 
-    navMeshQuery_->findStraightPath(&localStart.x_, &actualLocalEnd.x_, pathData_->polys_, numPolys,
-        &pathData_->pathPoints_[0].x_, pathData_->pathFlags_, pathData_->pathPolys_, &numPathPoints, MAX_POLYS);
+        const auto findPath = [&](NavigationPathRequest* request)
+        {
+            PathQueryThreadData& threadQuery = *threadQueries_[WorkQueue::GetThreadIndex()];
+            const dtQueryFilter* queryFilter = request->filter_ ? request->filter_ : defaultFilter;
+            FindPathWithQuery(threadQuery.query_, threadQuery.pathData_, transform, areas, request->path_,
+                request->start_, request->end_, request->extents_, queryFilter);
+        };
 
-    // Transform path result back to world space
-    for (int i = 0; i < numPathPoints; ++i)
+        if (auto workQueue = GetSubsystem<WorkQueue>())
+        {
+            ForEachParallel(workQueue, requests,
+                [&](unsigned, const SharedPtr<NavigationPathRequest>& request) { findPath(request); });
+        }
+        else
+        {
+            for (NavigationPathRequest* request : requests)
+                findPath(request);
+        }
+    }
+
+    for (NavigationPathRequest* request : requests)
     {
-        NavigationPathPoint pt;
-        pt.position_ = transform * pathData_->pathPoints_[i];
-        pt.flag_ = (NavigationPathPointFlag)pathData_->pathFlags_[i];
+        request->completed_ = true;
+        if (request->callback_)
+            request->callback_(request);
+    }
+}
 
-        // Walk through all NavAreas and find nearest
-        unsigned nearestNavAreaID = 0;       // 0 is the default nav area ID
-        float nearestDistance = M_LARGE_VALUE;
-        for (unsigned j = 0; j < areas_.size(); j++)
+void NavigationMesh::OnSceneSet(Scene* scene)
+{
+    if (scene)
+        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(NavigationMesh, HandleScenePostUpdate));
+    else
+        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+}
+
+void NavigationMesh::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+{
+    UpdateStreaming();
+    ProcessPathRequests(maxPathRequestsPerFrame_);
+}
+
+void NavigationMesh::AddStreamingPoint(Node* node)
+{
+    if (node && !streamingPoints_.contains(WeakPtr<Node>(node)))
+        streamingPoints_.emplace_back(node);
+}
+
+void NavigationMesh::RemoveStreamingPoint(Node* node)
+{
+    streamingPoints_.erase_first(WeakPtr<Node>(node));
+}
+
+bool NavigationMesh::SaveStreamingRegions(const ea::string& directory) const
+{
+    if (!navMesh_)
+    {
+        URHO3D_LOGERROR("Navigation mesh is not built");
+        return false;
+    }
+
+    const ea::string path = AddTrailingSlash(directory);
+    auto fileSystem = GetSubsystem<FileSystem>();
+    if (!fileSystem->CreateDirsRecursive(path))
+    {
+        URHO3D_LOGERROR("Cannot create directory '{}' for navigation regions", path);
+        return false;
+    }
+
+    const int regionSize = streamingRegionSize_;
+    const IntVector2 numRegions = (GetNumTiles() + IntVector2::ONE * (regionSize - 1)) / regionSize;
+    for (int z = 0; z < numRegions.y_; ++z)
+    {
+        for (int x = 0; x < numRegions.x_; ++x)
         {
-            NavArea* area = areas_[j];
-            if (area && area->IsEnabledEffective())
+            const IntVector2 region{x, z};
+            const auto [from, to] = GetStreamingRegionTiles(region);
+
+            ea::vector<IntVector2> tiles;
+            for (const IntVector2& tile : GetTilesInRect(from, to))
+            {
+                if (HasTile(tile))
+                    tiles.push_back(tile);
+            }
+
+            // Empty regions are just not stored
+            const ea::string fileName = path + GetStreamingRegionFileName(region);
+            if (tiles.empty())
             {
-                BoundingBox bb = area->GetWorldBoundingBox();
-                if (bb.IsInside(pt.position_) == INSIDE)
+                if (fileSystem->FileExists(fileName))
+                    fileSystem->Delete(fileName);
+                continue;
+            }
+
+            File file(context_, fileName, FILE_WRITE);
+            if (!file.IsOpen())
+            {
+                URHO3D_LOGERROR("Cannot write navigation region '{}'", fileName);
+                return false;
+            }
+
+            file.WriteUInt(tiles.size());
+            for (const IntVector2& tile : tiles)
+            {
+                file.WriteIntVector2(tile);
+                file.WriteBuffer(GetTileData(tile));
+            }
+        }
+    }
+
+    return true;
+}
+
+void NavigationMesh::UpdateStreaming()
+{
+    if (streamingDirectory_.empty() || !navMesh_ || !node_)
+        return;
+
+    URHO3D_PROFILE("UpdateNavigationStreaming");
+
+    ea::erase_if(streamingPoints_, [](const WeakPtr<Node>& node) { return !node; });
+
+    const Matrix3x4 inverse = node_->GetWorldTransform().Inverse();
+    ea::vector<Vector3> localPoints;
+    for (Node* node : streamingPoints_)
+        localPoints.push_back(inverse * node->GetWorldPosition());
+
+    const float loadDistanceSquared = streamingDistance_ * streamingDistance_;
+    const float unloadDistance = streamingDistance_ * STREAMING_UNLOAD_DISTANCE_FACTOR;
+    const float unloadDistanceSquared = unloadDistance * unloadDistance;
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    Context* context = context_;
+    const ea::string directory = AddTrailingSlash(streamingDirectory_);
+    const WeakPtr<NavigationMesh> weakSelf{this};
+
+    const int regionSize = streamingRegionSize_;
+    const IntVector2 numRegions = (GetNumTiles() + IntVector2::ONE * (regionSize - 1)) / regionSize;
+    for (int z = 0; z < numRegions.y_; ++z)
+    {
+        for (int x = 0; x < numRegions.x_; ++x)
+        {
+            const IntVector2 region{x, z};
+            float distanceSquared = M_LARGE_VALUE;
+            for (const Vector3& localPoint : localPoints)
+                distanceSquared = ea::min(distanceSquared, GetStreamingRegionDistanceSquared(region, localPoint));
+
+            const bool isLoaded = loadedRegions_.contains(region);
+            const bool isLoading = loadingRegions_.contains(region);
+            if (!isLoaded && !isLoading && distanceSquared <= loadDistanceSquared)
+            {
+                loadingRegions_.insert(region);
+
+                // File is read in the worker thread, tiles are added in the main thread
+                const ea::string fileName = directory + GetStreamingRegionFileName(region);
+                workQueue->PostTask([=]()
                 {
-                    Vector3 areaWorldCenter = area->GetNode()->GetWorldPosition();
-                    float distance = (areaWorldCenter - pt.position_).LengthSquared();
-                    if (distance < nearestDistance)
+                    auto cache = context->GetSubsystem<ResourceCache>();
+                    ByteVector data;
+                    if (AbstractFilePtr file = cache->GetFile(fileName, false))
                     {
-                        nearestDistance = distance;
-                        nearestNavAreaID = area->GetAreaID();
+                        data.resize(file->GetSize());
+                        data.resize(file->Read(data.data(), data.size()));
                     }
+
+                    workQueue->PostTaskForMainThread([=]()
+                    {
+                        if (weakSelf)
+                            weakSelf->FinishStreamingRegionLoad(region, data);
+                    });
+                });
+            }
+            else if ((isLoaded || isLoading) && distanceSquared > unloadDistanceSquared)
+            {
+                // Pending load is discarded when finished
+                loadingRegions_.erase(region);
+                if (isLoaded)
+                {
+                    loadedRegions_.erase(region);
+                    UnloadStreamingRegion(region);
                 }
             }
         }
-        pt.areaID_ = (unsigned char)nearestNavAreaID;
+    }
+}
 
-        dest.push_back(pt);
+ea::string NavigationMesh::GetStreamingRegionFileName(const IntVector2& region)
+{
+    return Format("Region-{}-{}.bin", region.x_, region.y_);
+}
+
+ea::pair<IntVector2, IntVector2> NavigationMesh::GetStreamingRegionTiles(const IntVector2& region) const
+{
+    const IntVector2 from = region * streamingRegionSize_;
+    const IntVector2 to = VectorMin(from + IntVector2::ONE * (streamingRegionSize_ - 1), GetNumTiles() - IntVector2::ONE);
+    return {from, to};
+}
+
+float NavigationMesh::GetStreamingRegionDistanceSquared(const IntVector2& region, const Vector3& localPoint) const
+{
+    // Use tile layout of the loaded mesh, build settings may be not set when only mesh header is loaded
+    const dtNavMeshParams* params = navMesh_->getParams();
+    const Vector2 origin{params->orig[0], params->orig[2]};
+    const Vector2 tileSize{params->tileWidth, params->tileHeight};
+
+    const auto [from, to] = GetStreamingRegionTiles(region);
+    const Vector2 point{localPoint.x_, localPoint.z_};
+    const Vector2 minPoint = origin + tileSize * Vector2{static_cast<float>(from.x_), static_cast<float>(from.y_)};
+    const Vector2 maxPoint = origin + tileSize * Vector2{static_cast<float>(to.x_ + 1), static_cast<float>(to.y_ + 1)};
+    const Vector2 offset = point - VectorMin(VectorMax(point, minPoint), maxPoint);
+    return offset.LengthSquared();
+}
+
+void NavigationMesh::FinishStreamingRegionLoad(const IntVector2& region, const ByteVector& data)
+{
+    if (!loadingRegions_.erase(region))
+        return;
+
+    loadedRegions_.insert(region);
+    if (data.empty() || !navMesh_)
+        return;
+
+    MemoryBuffer buffer(data);
+    const unsigned numTiles = buffer.ReadUInt();
+    for (unsigned i = 0; i < numTiles && !buffer.IsEof(); ++i)
+    {
+        const IntVector2 tile = buffer.ReadIntVector2();
+        const ByteVector tileData = buffer.ReadBuffer();
+
+        // Tiles may be already built at runtime
+        if (!HasTile(tile) && !AddTile(tileData))
+            URHO3D_LOGERROR("Cannot load tile {}x{} of navigation region", tile.x_, tile.y_);
     }
 }
 
+void NavigationMesh::UnloadStreamingRegion(const IntVector2& region)
+{
+    const auto [from, to] = GetStreamingRegionTiles(region);
+    for (const IntVector2& tile : GetTilesInRect(from, to))
+        RemoveTile(tile);
+}
+
 Vector3 NavigationMesh::GetRandomPoint(const dtQueryFilter* filter, dtPolyRef* randomRef)
 {
     if (!InitializeQuery())
@@ -914,9 +1495,13 @@ ea::vector<unsigned char> NavigationMesh::GetNavigationDataAttr() const
 
         const dtNavMesh* navMesh = navMesh_;
 
-        for (int z = 0; z < numTilesZ_; ++z)
-            for (int x = 0; x < numTilesX_; ++x)
-                WriteTile(ret, x, z);
+        // Tiles are stored in streaming regions instead
+        if (streamingDirectory_.empty())
+        {
+            for (int z = 0; z < numTilesZ_; ++z)
+                for (int x = 0; x < numTilesX_; ++x)
+                    WriteTile(ret, x, z);
+        }
     }
 
     return ret.GetBuffer();
@@ -1275,14 +1860,29 @@ bool NavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometryList,
 {
     URHO3D_PROFILE("BuildNavigationMeshTile");
 
-    // Remove previous tile (if any)
-    navMesh_->removeTile(navMesh_->getTileRefAt(x, z, 0), nullptr, nullptr);
+    const IntVector2 tile{x, z};
 
-    const BoundingBox tileBoundingBox = GetTileBoundingBox(IntVector2(x, z));
+    rcConfig cfg;       // NOLINT(hicpp-member-init)
+    InitializeTileConfig(cfg, tile);
 
     SimpleNavBuildData build;
+    BoundingBox expandedBox(*reinterpret_cast<Vector3*>(cfg.bmin), *reinterpret_cast<Vector3*>(cfg.bmax));
+    GetTileGeometry(&build, geometryList, expandedBox);
+
+    unsigned char* navData = nullptr;
+    int navDataSize = 0;
+    if (!BuildTileMesh(build, cfg, tile, navData, navDataSize))
+    {
+        AddTileMesh(tile, nullptr, 0);
+        return false;
+    }
+    return AddTileMesh(tile, navData, navDataSize);
+}
+
+void NavigationMesh::InitializeTileConfig(rcConfig& cfg, const IntVector2& tile) const
+{
+    const BoundingBox tileBoundingBox = GetTileBoundingBox(tile);
 
-    rcConfig cfg;       // NOLINT(hicpp-member-init)
     memset(&cfg, 0, sizeof cfg);
     cfg.cs = cellSize_;
     cfg.ch = cellHeight_;
@@ -1308,10 +1908,11 @@ bool NavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometryList,
     cfg.bmin[2] -= cfg.borderSize * cfg.cs;
     cfg.bmax[0] += cfg.borderSize * cfg.cs;
     cfg.bmax[2] += cfg.borderSize * cfg.cs;
+}
 
-    BoundingBox expandedBox(*reinterpret_cast<Vector3*>(cfg.bmin), *reinterpret_cast<Vector3*>(cfg.bmax));
-    GetTileGeometry(&build, geometryList, expandedBox);
-
+bool NavigationMesh::BuildTileMesh(SimpleNavBuildData& build, const rcConfig& cfg, const IntVector2& tile,
+    unsigned char*& navData, int& navDataSize) const
+{
     if (build.vertices_.empty() || build.indices_.empty())
         return true; // Nothing to do
 
@@ -1434,9 +2035,6 @@ bool NavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometryList,
             build.polyMesh_->flags[i] = 0x1;
     }
 
-    unsigned char* navData = nullptr;
-    int navDataSize = 0;
-
     dtNavMeshCreateParams params;       // NOLINT(hicpp-member-init)
     memset(&params, 0, sizeof params);
     params.verts = build.polyMesh_->verts;
@@ -1454,8 +2052,8 @@ bool NavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometryList,
     params.walkableHeight = agentHeight_;
     params.walkableRadius = agentRadius_;
     params.walkableClimb = agentMaxClimb_;
-    params.tileX = x;
-    params.tileY = z;
+    params.tileX = tile.x_;
+    params.tileY = tile.y_;
     rcVcopy(params.bmin, build.polyMesh_->bmin);
     rcVcopy(params.bmax, build.polyMesh_->bmax);
     params.cs = cfg.cs;
@@ -1479,6 +2077,17 @@ bool NavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometryList,
         return false;
     }
 
+    return true;
+}
+
+bool NavigationMesh::AddTileMesh(const IntVector2& tile, unsigned char* navData, int navDataSize)
+{
+    // Remove previous tile (if any)
+    navMesh_->removeTile(navMesh_->getTileRefAt(tile.x_, tile.y_, 0), nullptr, nullptr);
+
+    if (!navData)
+        return true;
+
     if (dtStatusFailed(navMesh_->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, nullptr)))
     {
         URHO3D_LOGERROR("Failed to add navigation mesh tile");
@@ -1486,34 +2095,81 @@ bool NavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometryList,
         return false;
     }
 
-    // Send a notification of the rebuild of this tile to anyone interested
-    {
-        using namespace NavigationAreaRebuilt;
-        VariantMap& eventData = GetContext()->GetEventDataMap();
-        eventData[P_NODE] = GetNode();
-        eventData[P_MESH] = this;
-        eventData[P_BOUNDSMIN] = Variant(tileBoundingBox.min_);
-        eventData[P_BOUNDSMAX] = Variant(tileBoundingBox.max_);
-        SendEvent(E_NAVIGATION_AREA_REBUILT, eventData);
-    }
+    SendTileRebuiltEvent(tile);
     return true;
 }
 
+void NavigationMesh::SendTileRebuiltEvent(const IntVector2& tile)
+{
+    // Send a notification of the rebuild of this tile to anyone interested
+    using namespace NavigationAreaRebuilt;
+    const BoundingBox tileBoundingBox = GetTileBoundingBox(tile);
+    VariantMap& eventData = GetContext()->GetEventDataMap();
+    eventData[P_NODE] = GetNode();
+    eventData[P_MESH] = this;
+    eventData[P_BOUNDSMIN] = Variant(tileBoundingBox.min_);
+    eventData[P_BOUNDSMAX] = Variant(tileBoundingBox.max_);
+    SendEvent(E_NAVIGATION_AREA_REBUILT, eventData);
+}
+
+ea::unique_ptr<NavigationMesh::TileBuildTask> NavigationMesh::CreateTileBuildTask(
+    ea::vector<NavigationGeometryInfo>& geometryList, const IntVector2& tile)
+{
+    auto task = ea::make_unique<SimpleTileBuildTask>(this, tile);
+    InitializeTileConfig(task->cfg_, tile);
+
+    BoundingBox expandedBox(*reinterpret_cast<Vector3*>(task->cfg_.bmin), *reinterpret_cast<Vector3*>(task->cfg_.bmax));
+    GetTileGeometry(&task->build_, geometryList, expandedBox);
+    return task;
+}
+
 unsigned NavigationMesh::BuildTiles(ea::vector<NavigationGeometryInfo>& geometryList, const IntVector2& from, const IntVector2& to)
 {
-    unsigned numTiles = 0;
+    URHO3D_PROFILE("BuildNavigationMeshTiles");
 
-    for (int z = from.y_; z <= to.y_; ++z)
+    const ea::vector<IntVector2> tiles = GetTilesInRect(from, to);
+    if (tiles.empty())
+        return 0;
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    unsigned numTiles = 0;
+    ea::vector<ea::unique_ptr<TileBuildTask>> tasks;
+    for (unsigned batchBegin = 0; batchBegin < tiles.size(); batchBegin += TILE_BUILD_BATCH_SIZE)
     {
-        for (int x = from.x_; x <= to.x_; ++x)
+        const unsigned batchSize = ea::min(TILE_BUILD_BATCH_SIZE, tiles.size() - batchBegin);
+
+        // Collect geometry in the main thread because it accesses the scene
+        tasks.clear();
+        for (unsigned i = 0; i < batchSize; ++i)
+            tasks.push_back(CreateTileBuildTask(geometryList, tiles[batchBegin + i]));
+
+        // Run Recast in worker threads, tiles are independent from each other
+        if (workQueue)
+            ForEachParallel(workQueue, tasks, [&](unsigned, const ea::unique_ptr<TileBuildTask>& task) { task->Build(); });
+        else
         {
-            if (BuildTile(geometryList, x, z))
-                ++numTiles;
+            for (const auto& task : tasks)
+                task->Build();
         }
+
+        // Add tiles to the navigation mesh in the main thread
+        for (const auto& task : tasks)
+            numTiles += task->Commit();
     }
     return numTiles;
 }
 
+ea::vector<IntVector2> NavigationMesh::GetTilesInRect(const IntVector2& from, const IntVector2& to) const
+{
+    ea::vector<IntVector2> tiles;
+    for (int z = from.y_; z <= to.y_; ++z)
+    {
+        for (int x = from.x_; x <= to.x_; ++x)
+            tiles.emplace_back(x, z);
+    }
+    return tiles;
+}
+
 bool NavigationMesh::InitializeQuery()
 {
     if (!navMesh_ || !node_)
@@ -1540,6 +2196,10 @@ bool NavigationMesh::InitializeQuery()
 
 void NavigationMesh::ReleaseNavigationMesh()
 {
+    CancelAsyncBuild();
+
+    threadQueries_.clear();
+
     dtFreeNavMesh(navMesh_);
     navMesh_ = nullptr;
 
@@ -1549,6 +2209,9 @@ void NavigationMesh::ReleaseNavigationMesh()
     numTilesX_ = 0;
     numTilesZ_ = 0;
     boundingBox_.Clear();
+
+    loadedRegions_.clear();
+    loadingRegions_.clear();
 }
 
 void NavigationMesh::SetPartitionType(NavmeshPartitionType partitionType)
@@ -1558,6 +2221,15 @@ void NavigationMesh::SetPartitionType(NavmeshPartitionType partitionType)
 
 void RegisterNavigationLibrary(Context* context)
 {
+    // Recast and Detour objects are created only after registration, so the allocators may be replaced here
+    static const bool allocatorsInstalled = []
+    {
+        dtAllocSetCustom(&AllocateNavigationMemory, &FreeNavigationMemory);
+        rcAllocSetCustom(&AllocateNavigationMemory, &FreeNavigationMemory);
+        return true;
+    }();
+    (void)allocatorsInstalled;
+
     Navigable::RegisterObject(context);
     NavigationMesh::RegisterObject(context);
     OffMeshConnection::RegisterObject(context);
@@ -1566,6 +2238,7 @@ void RegisterNavigationLibrary(Context* context)
     DynamicNavigationMesh::RegisterObject(context);
     Obstacle::RegisterObject(context);
     NavArea::RegisterObject(context);
+    NavigationMeshBaker::RegisterObject(context);
 }
 
 }
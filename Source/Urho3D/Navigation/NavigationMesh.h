@@ -24,9 +24,12 @@
 
 #pragma once
 
+#include <EASTL/functional.h>
+#include <EASTL/shared_ptr.h>
 #include <EASTL/unique_ptr.h>
 #include <EASTL/unordered_set.h>
 
+#include "../Container/ByteVector.h"
 #include "../Math/BoundingBox.h"
 #include "../Math/Matrix3x4.h"
 #include "../Scene/Component.h"
@@ -41,6 +44,8 @@ class dtNavMesh;
 class dtNavMeshQuery;
 class dtQueryFilter;
 
+struct rcConfig;
+
 namespace Urho3D
 {
 
@@ -54,7 +59,9 @@ class Geometry;
 class NavArea;
 
 struct FindPathData;
+struct PathQueryThreadData;
 struct NavBuildData;
+struct SimpleNavBuildData;
 
 /// Description of a navigation mesh geometry component, with transform and bounds information.
 struct NavigationGeometryInfo
@@ -89,6 +96,34 @@ struct URHO3D_API NavigationPathPoint
     unsigned char areaID_;
 };
 
+/// Asynchronous path request. Path is found by NavigationMesh during one of the next frames.
+class URHO3D_API NavigationPathRequest : public RefCounted
+{
+public:
+    /// Callback invoked from the main thread when the request is completed.
+    using Callback = ea::function<void(NavigationPathRequest* request)>;
+
+    /// Return whether the request is completed.
+    bool IsCompleted() const { return completed_; }
+    /// Return found path. Empty if there's no path.
+    const ea::vector<NavigationPathPoint>& GetPath() const { return path_; }
+    /// Return world-space start point.
+    const Vector3& GetStart() const { return start_; }
+    /// Return world-space end point.
+    const Vector3& GetEnd() const { return end_; }
+
+private:
+    friend class NavigationMesh;
+
+    Vector3 start_;
+    Vector3 end_;
+    Vector3 extents_;
+    const dtQueryFilter* filter_{};
+    Callback callback_;
+    ea::vector<NavigationPathPoint> path_;
+    bool completed_{};
+};
+
 /// Navigation mesh component. Collects the navigation geometry from child nodes with the Navigable component and responds to path queries.
 class URHO3D_API NavigationMesh : public Component
 {
@@ -160,6 +195,19 @@ public:
     virtual bool Build(const BoundingBox& boundingBox);
     /// Rebuild part of the navigation mesh in the rectangular area. Return true if successful.
     virtual bool Build(const IntVector2& from, const IntVector2& to);
+    /// Queue asynchronous rebuild of the part of the navigation mesh contained by the world-space bounding box.
+    /// Tiles are built in WorkQueue threads and replaced in the main thread, queries use previous tiles until then.
+    void BuildAsync(const BoundingBox& boundingBox);
+    /// Queue asynchronous rebuild of the part of the navigation mesh in the rectangular area.
+    void BuildAsync(const IntVector2& from, const IntVector2& to);
+    /// Wait for all queued asynchronous rebuilds and apply them.
+    void CompleteAsyncBuild();
+    /// Return whether there are tiles queued for asynchronous rebuild.
+    bool IsAsyncBuildPending() const { return asyncBatch_ || !asyncQueue_.empty(); }
+    /// Set max number of tiles rebuilt asynchronously at once.
+    void SetMaxAsyncTiles(unsigned count) { maxAsyncTiles_ = ea::max(count, 1u); }
+    /// Return max number of tiles rebuilt asynchronously at once.
+    unsigned GetMaxAsyncTiles() const { return maxAsyncTiles_; }
     /// Return tile data.
     virtual ea::vector<unsigned char> GetTileData(const IntVector2& tile) const;
     /// Add tile to navigation mesh.
@@ -174,6 +222,32 @@ public:
     BoundingBox GetTileBoundingBox(const IntVector2& tile) const;
     /// Return index of the tile at the position.
     IntVector2 GetTileIndex(const Vector3& position) const;
+
+    /// Set resource directory with cooked streaming regions. Tiles are streamed in and out around streaming points
+    /// if not empty. Navigation data attribute of NavigationMesh keeps only mesh parameters in this case.
+    void SetStreamingDirectory(const ea::string& directory) { streamingDirectory_ = directory; }
+    /// Return resource directory with cooked streaming regions.
+    const ea::string& GetStreamingDirectory() const { return streamingDirectory_; }
+    /// Set size of the streaming region in tiles.
+    void SetStreamingRegionSize(int size) { streamingRegionSize_ = ea::max(size, 1); }
+    /// Return size of the streaming region in tiles.
+    int GetStreamingRegionSize() const { return streamingRegionSize_; }
+    /// Set distance from streaming points within which regions are loaded.
+    void SetStreamingDistance(float distance) { streamingDistance_ = ea::max(distance, 0.0f); }
+    /// Return distance from streaming points within which regions are loaded.
+    float GetStreamingDistance() const { return streamingDistance_; }
+    /// Add node around which tiles are streamed in, e.g. player or active AI.
+    void AddStreamingPoint(Node* node);
+    /// Remove streaming point.
+    void RemoveStreamingPoint(Node* node);
+    /// Save all tiles to region files in the directory on the host file system. Return true if successful.
+    bool SaveStreamingRegions(const ea::string& directory) const;
+    /// Load and unload regions according to streaming points. Called automatically after scene update.
+    void UpdateStreaming();
+    /// Return whether the streaming region is loaded.
+    bool IsStreamingRegionLoaded(const IntVector2& region) const { return loadedRegions_.contains(region); }
+    /// Return number of streaming regions being loaded.
+    unsigned GetNumLoadingRegions() const { return loadingRegions_.size(); }
     /// Find the nearest point on the navigation mesh to a given point. Extents specifies how far out from the specified point to check along each axis.
     Vector3 FindNearestPoint
         (const Vector3& point, const Vector3& extents = Vector3::ONE, const dtQueryFilter* filter = nullptr, dtPolyRef* nearestRef = nullptr);
@@ -187,6 +261,20 @@ public:
     void FindPath
         (ea::vector<NavigationPathPoint>& dest, const Vector3& start, const Vector3& end, const Vector3& extents = Vector3::ONE,
             const dtQueryFilter* filter = nullptr);
+    /// Request path between world space points. Extents specifies how far off the navigation mesh the points can be.
+    /// Requests are processed in WorkQueue threads during the next frames, no more than max path requests per frame.
+    /// Filter should be alive until the request is completed.
+    SharedPtr<NavigationPathRequest> RequestPath(const Vector3& start, const Vector3& end,
+        const Vector3& extents = Vector3::ONE, const dtQueryFilter* filter = nullptr,
+        const NavigationPathRequest::Callback& callback = {});
+    /// Process queued path requests, no more than given number. Called automatically every frame.
+    void ProcessPathRequests(unsigned maxRequests);
+    /// Set max number of path requests processed per frame.
+    void SetMaxPathRequestsPerFrame(unsigned count) { maxPathRequestsPerFrame_ = ea::max(count, 1u); }
+    /// Return max number of path requests processed per frame.
+    unsigned GetMaxPathRequestsPerFrame() const { return maxPathRequestsPerFrame_; }
+    /// Return number of path requests not processed yet.
+    unsigned GetNumPendingPathRequests() const { return pathRequests_.size(); }
     /// Return a random point on the navigation mesh.
     Vector3 GetRandomPoint(const dtQueryFilter* filter = nullptr, dtPolyRef* randomRef = nullptr);
     /// Return a random point on the navigation mesh within a circle. The circle radius is only a guideline and in practice the returned point may be further away.
@@ -321,6 +409,11 @@ private:
     bool ReadTile(Deserializer& source, bool silent);
 
 protected:
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+    /// Process path requests at the end of the scene update.
+    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+
     /// Collect geometry from under Navigable components.
     void CollectGeometries(ea::vector<NavigationGeometryInfo>& geometryList);
     /// Visit nodes and collect navigable geometry.
@@ -329,14 +422,62 @@ protected:
     void GetTileGeometry(NavBuildData* build, ea::vector<NavigationGeometryInfo>& geometryList, BoundingBox& box);
     /// Add a triangle mesh to the geometry data.
     void AddTriMeshGeometry(NavBuildData* build, Geometry* geometry, const Matrix3x4& transform);
+    /// Task that builds one tile. Geometry is collected on creation in the main thread,
+    /// tile data is built in any thread and then committed in the main thread.
+    struct TileBuildTask
+    {
+        explicit TileBuildTask(const IntVector2& tile) : tile_(tile) {}
+        virtual ~TileBuildTask() = default;
+
+        /// Build tile data. Thread-safe.
+        virtual void Build() = 0;
+        /// Replace the tile in the navigation mesh with built data. Return number of added tiles.
+        virtual unsigned Commit() = 0;
+
+        /// Tile index.
+        const IntVector2 tile_;
+    };
+    struct SimpleTileBuildTask;
+    struct AsyncBuildBatch;
+
     /// Build one tile of the navigation mesh. Return true if successful.
     virtual bool BuildTile(ea::vector<NavigationGeometryInfo>& geometryList, int x, int z);
+    /// Create task that builds one tile and collect its geometry.
+    virtual ea::unique_ptr<TileBuildTask> CreateTileBuildTask(ea::vector<NavigationGeometryInfo>& geometryList, const IntVector2& tile);
     /// Build tiles in the rectangular area. Return number of built tiles.
+    /// Geometry is collected in the main thread, Recast builds tiles in WorkQueue threads.
     unsigned BuildTiles(ea::vector<NavigationGeometryInfo>& geometryList, const IntVector2& from, const IntVector2& to);
+    /// Return tiles in the rectangular area, row by row.
+    ea::vector<IntVector2> GetTilesInRect(const IntVector2& from, const IntVector2& to) const;
+    /// Initialize Recast config for the tile, including bounding box padded with border.
+    void InitializeTileConfig(rcConfig& cfg, const IntVector2& tile) const;
+    /// Build Detour tile data from collected geometry. Data is null if there's no geometry. Thread-safe.
+    bool BuildTileMesh(SimpleNavBuildData& build, const rcConfig& cfg, const IntVector2& tile,
+        unsigned char*& navData, int& navDataSize) const;
+    /// Replace tile in the navigation mesh with built data, or just remove it if data is null.
+    bool AddTileMesh(const IntVector2& tile, unsigned char* navData, int navDataSize);
+    /// Send notification that the tile is rebuilt.
+    void SendTileRebuiltEvent(const IntVector2& tile);
+    /// Start asynchronous rebuild of the next queued tiles if there's none in progress.
+    void StartAsyncBatch();
+    /// Apply asynchronously built tiles. Ignored if the batch was cancelled.
+    void FinishAsyncBatch(AsyncBuildBatch* batch);
+    /// Cancel asynchronous rebuild, waiting for the tiles being built in worker threads.
+    void CancelAsyncBuild();
     /// Ensure that the navigation mesh query is initialized. Return true if successful.
     bool InitializeQuery();
     /// Release the navigation mesh and the query.
     virtual void ReleaseNavigationMesh();
+    /// Return file name of the streaming region relative to the directory.
+    static ea::string GetStreamingRegionFileName(const IntVector2& region);
+    /// Return range of tiles in the streaming region, inclusive.
+    ea::pair<IntVector2, IntVector2> GetStreamingRegionTiles(const IntVector2& region) const;
+    /// Return squared distance in XZ plane from the point in node space to the streaming region.
+    float GetStreamingRegionDistanceSquared(const IntVector2& region, const Vector3& localPoint) const;
+    /// Add tiles of the loaded streaming region. Ignored if the region is no longer requested.
+    void FinishStreamingRegionLoad(const IntVector2& region, const ByteVector& data);
+    /// Remove tiles of the streaming region.
+    void UnloadStreamingRegion(const IntVector2& region);
 
     /// Identifying name for this navigation mesh.
     ea::string meshName_;
@@ -392,6 +533,35 @@ protected:
     bool drawNavAreas_;
     /// NavAreas for this NavMesh.
     ea::vector<WeakPtr<NavArea> > areas_;
+
+    /// Max number of tiles rebuilt asynchronously at once.
+    unsigned maxAsyncTiles_;
+    /// Tiles queued for asynchronous rebuild.
+    ea::vector<IntVector2> asyncQueue_;
+    /// Set of tiles queued for asynchronous rebuild.
+    ea::unordered_set<IntVector2> asyncQueuedTiles_;
+    /// Tiles being rebuilt asynchronously.
+    ea::shared_ptr<AsyncBuildBatch> asyncBatch_;
+
+    /// Resource directory with cooked streaming regions.
+    ea::string streamingDirectory_;
+    /// Size of the streaming region in tiles.
+    int streamingRegionSize_{8};
+    /// Distance from streaming points within which regions are loaded.
+    float streamingDistance_{200.0f};
+    /// Nodes around which tiles are streamed in.
+    ea::vector<WeakPtr<Node>> streamingPoints_;
+    /// Loaded streaming regions.
+    ea::unordered_set<IntVector2> loadedRegions_;
+    /// Streaming regions being loaded.
+    ea::unordered_set<IntVector2> loadingRegions_;
+
+    /// Max number of path requests processed per frame.
+    unsigned maxPathRequestsPerFrame_;
+    /// Queued path requests.
+    ea::vector<SharedPtr<NavigationPathRequest>> pathRequests_;
+    /// Navigation mesh queries for each WorkQueue thread.
+    ea::vector<ea::unique_ptr<PathQueryThreadData>> threadQueries_;
 };
 
 /// Register Navigation library objects.
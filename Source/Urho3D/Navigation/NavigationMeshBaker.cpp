@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Navigation/NavigationMeshBaker.h"
+
+#include "../Core/Context.h"
+#include "../IO/File.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+#include "../Navigation/NavigationMesh.h"
+#include "../Resource/ResourceCache.h"
+#include "../Scene/Scene.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+NavigationMeshBaker::NavigationMeshBaker(Context* context)
+    : AssetTransformer(context)
+{
+}
+
+NavigationMeshBaker::~NavigationMeshBaker()
+{
+}
+
+void NavigationMeshBaker::RegisterObject(Context* context)
+{
+    context->RegisterFactory<NavigationMeshBaker>(Category_Transformer);
+}
+
+bool NavigationMeshBaker::IsApplicable(const AssetTransformerInput& input)
+{
+    return input.inputFileName_.ends_with(".scene", false);
+}
+
+bool NavigationMeshBaker::Execute(
+    const AssetTransformerInput& input, AssetTransformerOutput& output, const AssetTransformerVector& transformers)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+    auto fs = GetSubsystem<FileSystem>();
+
+    AbstractFilePtr sourceFile = cache->GetFile(input.resourceName_);
+    if (!sourceFile)
+        return false;
+
+    auto scene = MakeShared<Scene>(context_);
+    if (!scene->LoadXML(*sourceFile))
+        return false;
+    sourceFile = nullptr;
+
+    ea::vector<NavigationMesh*> navMeshes;
+    scene->GetDerivedComponents(navMeshes, true);
+    if (navMeshes.empty())
+        return false;
+
+    for (NavigationMesh* navMesh : navMeshes)
+    {
+        if (!navMesh->Build())
+        {
+            URHO3D_LOGERROR("Cannot build navigation mesh of scene '{}'", input.resourceName_);
+            return false;
+        }
+    }
+
+    fs->CreateDirsRecursive(GetPath(input.outputFileName_));
+    File file(context_, input.outputFileName_, FILE_WRITE);
+    if (!file.IsOpen() || !scene->SaveXML(file))
+    {
+        URHO3D_LOGERROR("Cannot save scene '{}' with navigation data", input.resourceName_);
+        return false;
+    }
+    return true;
+}
+
+}
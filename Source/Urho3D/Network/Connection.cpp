@@ -78,7 +78,14 @@ Connection::Connection(Context* context, NetworkConnection* connection)
         connection->onMessage_ = [this](ea::string_view msg)
         {
             MutexLock lock(packetQueueLock_);
-            incomingPackets_.emplace_back(VectorBuffer(msg.data(), msg.size()));
+            ByteVector& packet = incomingPackets_.emplace_back();
+            if (!freeIncomingPackets_.empty())
+            {
+                packet = ea::move(freeIncomingPackets_.back());
+                freeIncomingPackets_.pop_back();
+            }
+            const auto bytes = reinterpret_cast<const unsigned char*>(msg.data());
+            packet.assign(bytes, bytes + msg.size());
         };
     }
 }
@@ -108,24 +115,29 @@ void Connection::SendMessageInternal(NetworkMessageId messageId, const unsigned
     URHO3D_ASSERT(numBytes <= packedMessageLimit_);
     URHO3D_ASSERT((data == nullptr && numBytes == 0) || (data != nullptr && numBytes > 0));
 
-    VectorBuffer& buffer = outgoingBuffer_[packetType];
-
-    if (buffer.GetSize() + numBytes >= packedMessageLimit_)
+    SharedPtr<NetworkBuffer>& buffer = outgoingBuffer_[packetType];
+    if (buffer && buffer->GetSize() + numBytes >= packedMessageLimit_)
         SendBuffer(packetType);
-
-    buffer.WriteUShort(messageId);
-    buffer.WriteUShort(numBytes);
+    if (!buffer)
+        buffer = outgoingBufferPool_.Acquire();
+
+    // Same layout as Serializer::WriteUShort
+    const unsigned short header[2] = {static_cast<unsigned short>(messageId), static_cast<unsigned short>(numBytes)};
+    ByteVector& bufferData = buffer->GetData();
+    const auto headerBytes = reinterpret_cast<const unsigned char*>(header);
+    bufferData.insert(bufferData.end(), headerBytes, headerBytes + sizeof(header));
     if (numBytes)
-        buffer.Write(data, numBytes);
+        bufferData.insert(bufferData.end(), data, data + numBytes);
 }
 
 void Connection::SendRemoteEvent(StringHash eventType, bool inOrder, const VariantMap& eventData)
 {
-    RemoteEvent queuedEvent;
-    queuedEvent.eventType_ = eventType;
-    queuedEvent.eventData_ = eventData;
-    queuedEvent.inOrder_ = inOrder;
-    remoteEvents_.push_back(queuedEvent);
+    remoteEvents_.push_back(GetSubsystem<Network>()->SerializeRemoteEvent(eventType, inOrder, eventData));
+}
+
+void Connection::SendRemoteEvent(const RemoteEvent& remoteEvent)
+{
+    remoteEvents_.push_back(remoteEvent);
 }
 
 void Connection::SetScene(Scene* newScene)
@@ -216,15 +228,13 @@ void Connection::SendRemoteEvents()
 
     URHO3D_PROFILE("SendRemoteEvents");
 
-    for (auto i = remoteEvents_.begin(); i != remoteEvents_.end(); ++i)
+    for (const RemoteEvent& remoteEvent : remoteEvents_)
     {
-        msg_.Clear();
         PacketTypeFlags packetType = PacketType::Reliable;
-        if (i->inOrder_)
+        if (remoteEvent.inOrder_)
             packetType |= PacketType::Ordered;
-        msg_.WriteStringHash(i->eventType_);
-        msg_.WriteVariantMap(i->eventData_);
-        SendMessage(MSG_REMOTEEVENT, msg_, packetType);
+        const ByteVector& data = *remoteEvent.data_;
+        SendMessage(remoteEvent.messageId_, data.data(), data.size(), packetType);
     }
 
     remoteEvents_.clear();
@@ -273,7 +283,18 @@ void Connection::SendBuffer(PacketTypeFlags type, VectorBuffer& buffer)
 
 void Connection::SendBuffer(PacketTypeFlags type)
 {
-    SendBuffer(type, outgoingBuffer_[type]);
+    SharedPtr<NetworkBuffer>& buffer = outgoingBuffer_[type];
+    if (!buffer || buffer->GetSize() < 1)
+        return;
+
+    if (transportConnection_)
+    {
+        packetCounterOutgoing_.AddSample(1);
+        bytesCounterOutgoing_.AddSample(buffer->GetSize());
+        transportConnection_->SendSharedMessage(NetworkBufferSlice{buffer}, type);
+    }
+    // Buffer returns to the pool once the transport releases it
+    buffer = nullptr;
 }
 
 void Connection::SendAllBuffers()
@@ -281,7 +302,6 @@ void Connection::SendAllBuffers()
     // Send clock messages at the last time to have better precision
     if (clock_)
     {
-        auto& buffer = outgoingBuffer_[PacketType::UnreliableUnordered];
         while (const auto clockMessage = clock_->PollMessage())
         {
             SendGeneratedMessage(MSG_CLOCK_SYNC, PacketType::UnreliableUnordered,
@@ -297,6 +317,9 @@ void Connection::SendAllBuffers()
     SendBuffer(PacketType::ReliableUnordered);
     SendBuffer(PacketType::UnreliableOrdered);
     SendBuffer(PacketType::UnreliableUnordered);
+
+    if (transportConnection_)
+        transportConnection_->Flush();
 }
 
 bool Connection::ProcessMessage(MemoryBuffer& buffer)
@@ -347,6 +370,7 @@ bool Connection::ProcessMessage(MemoryBuffer& buffer)
             break;
 
         case MSG_REMOTEEVENT:
+        case MSG_REMOTEEVENT_COMPACT:
             ProcessRemoteEvent(msgID, msg);
             break;
 
@@ -640,14 +664,20 @@ void Connection::ProcessRemoteEvent(int msgID, MemoryBuffer& msg)
 {
     using namespace RemoteEventData;
 
+    auto network = GetSubsystem<Network>();
     StringHash eventType = msg.ReadStringHash();
-    if (!GetSubsystem<Network>()->CheckRemoteEvent(eventType))
+    if (!network->CheckRemoteEvent(eventType))
     {
         URHO3D_LOGWARNING("Discarding not allowed remote event " + eventType.ToString());
         return;
     }
 
-    VariantMap eventData = msg.ReadVariantMap();
+    VariantMap eventData;
+    if (!network->DeserializeRemoteEventData(static_cast<NetworkMessageId>(msgID), eventType, msg, eventData))
+    {
+        URHO3D_LOGWARNING("Discarding malformed remote event " + eventType.ToString());
+        return;
+    }
     eventData[P_CONNECTION] = this;
     SendEvent(eventType, eventData);
 }
@@ -991,8 +1021,12 @@ unsigned short Connection::GetPort() const
 
 void Connection::ProcessPackets()
 {
-    MutexLock lock(packetQueueLock_);
-    for (auto& packet : incomingPackets_)
+    {
+        MutexLock lock(packetQueueLock_);
+        ea::swap(incomingPackets_, processedPackets_);
+    }
+
+    for (ByteVector& packet : processedPackets_)
     {
         MemoryBuffer msg(packet);
         if (!ProcessMessage(msg))
@@ -1001,7 +1035,11 @@ void Connection::ProcessPackets()
             break;
         }
     }
-    incomingPackets_.clear();
+
+    MutexLock lock(packetQueueLock_);
+    for (ByteVector& packet : processedPackets_)
+        freeIncomingPackets_.push_back(ea::move(packet));
+    processedPackets_.clear();
 }
 
 }
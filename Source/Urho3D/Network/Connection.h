@@ -31,6 +31,7 @@
 #include "../Core/Timer.h"
 #include "../IO/VectorBuffer.h"
 #include "../Network/AbstractConnection.h"
+#include "../Network/Transport/NetworkBuffer.h"
 
 namespace Urho3D
 {
@@ -45,15 +46,15 @@ class Serializable;
 class PackageFile;
 class NetworkConnection;
 
-/// Queued remote event.
+/// Queued remote event. Serialized once and shared by all connections it's sent to.
 struct RemoteEvent
 {
-    /// Event type.
-    StringHash eventType_;
-    /// Event data.
-    VariantMap eventData_;
+    /// Message ID, depends on event encoding.
+    NetworkMessageId messageId_{MSG_REMOTEEVENT};
+    /// Serialized event type and data.
+    SharedByteVector data_;
     /// In order flag.
-    bool inOrder_;
+    bool inOrder_{};
 };
 
 /// Package file receive transfer.
@@ -125,6 +126,8 @@ public:
 
     /// Send a remote event.
     void SendRemoteEvent(StringHash eventType, bool inOrder, const VariantMap& eventData = Variant::emptyVariantMap);
+    /// Send a remote event serialized by Network.
+    void SendRemoteEvent(const RemoteEvent& remoteEvent);
     /// Assign scene. On the server, this will cause the client to load it.
     /// @property
     void SetScene(Scene* newScene);
@@ -143,7 +146,7 @@ public:
     void SendPackages();
     /// Send out buffered messages by their type
     void SendBuffer(PacketTypeFlags type);
-    /// Send out buffered messages by their type
+    /// Send out messages from external buffer. The data is copied.
     void SendBuffer(PacketTypeFlags type, VectorBuffer& buffer);
     /// Send out all buffered messages
     void SendAllBuffers();
@@ -262,8 +265,10 @@ private:
     mutable TimedCounter bytesCounterOutgoing_{10, 1000};
     /// Statistics timer.
     Timer statsTimer_;
-    /// Outgoing packet buffer which can contain multiple messages.
-    ea::unordered_map<int, VectorBuffer> outgoingBuffer_;
+    /// Outgoing packet buffers which can contain multiple messages. Handed over to the transport without copying.
+    ea::unordered_map<int, SharedPtr<NetworkBuffer>> outgoingBuffer_;
+    /// Pool of outgoing packet buffers, reused when released by the transport.
+    NetworkBufferPool outgoingBufferPool_;
     /// Outgoing packet size limit.
     int packedMessageLimit_ = 1024;
     /// Queued remote events.
@@ -301,7 +306,11 @@ private:
 
     SharedPtr<NetworkConnection> transportConnection_;
     Mutex packetQueueLock_;
-    ea::vector<VectorBuffer> incomingPackets_;
+    ea::vector<ByteVector> incomingPackets_;
+    /// Incoming packets being processed. Swapped with incomingPackets_ so the lock is not held during processing.
+    ea::vector<ByteVector> processedPackets_;
+    /// Packet buffers that were processed and can be reused for incoming packets.
+    ea::vector<ByteVector> freeIncomingPackets_;
 
 };
 
@@ -38,6 +38,8 @@
 #include "../Network/Protocol.h"
 #include "../Network/Transport/DataChannel/DataChannelConnection.h"
 #include "../Network/Transport/DataChannel/DataChannelServer.h"
+#include "../Network/Transport/Udp/UdpConnection.h"
+#include "../Network/Transport/Udp/UdpServer.h"
 #include "../Replica/BehaviorNetworkObject.h"
 #include "../Replica/FilteredByDistance.h"
 #include "../Replica/NetworkObject.h"
@@ -47,8 +49,12 @@
 #include "../Replica/ReplicationManager.h"
 #include "../Replica/StaticNetworkObject.h"
 #include "../Replica/TrackedAnimatedModel.h"
+#include "../Replica/TrackedAnimatedModelManager.h"
 #include "../Scene/Scene.h"
 
+#include <EASTL/algorithm.h>
+#include <EASTL/optional.h>
+
 #ifdef SendMessage
 #undef SendMessage
 #endif
@@ -58,6 +64,31 @@
 namespace Urho3D
 {
 
+namespace
+{
+
+/// Native UDP transport is used for "udp" scheme, WebRTC data channels otherwise.
+bool IsUdpTransport(const URL& url)
+{
+    return url.scheme_ == "udp";
+}
+
+NetworkConnection* CreateTransportConnection(Context* context, const URL& url)
+{
+    if (IsUdpTransport(url))
+        return new UdpConnection(context);
+    return new DataChannelConnection(context);
+}
+
+SharedPtr<NetworkServer> CreateTransportServer(Context* context, const URL& url)
+{
+    if (IsUdpTransport(url))
+        return MakeShared<UdpServer>(context);
+    return MakeShared<DataChannelServer>(context);
+}
+
+}
+
 Network::Network(Context* context)
     : Object(context)
 {
@@ -118,7 +149,7 @@ bool Network::Connect(const URL& url, Scene* scene, const VariantMap& identity)
     if (!connectionToServer_)
     {
         URHO3D_LOGINFO("Connecting to server {}", url.ToString());
-        DataChannelConnection* transportConnection = new DataChannelConnection(context_);
+        NetworkConnection* transportConnection = CreateTransportConnection(context_, url);
         connectionToServer_ = new Connection(context_, transportConnection);
         connectionToServer_->SetScene(scene);
         connectionToServer_->SetIdentity(identity);
@@ -219,7 +250,7 @@ bool Network::StartServer(const URL& url, unsigned int maxConnections)
     URHO3D_PROFILE("StartServer");
 
     WorkQueue* queue = GetSubsystem<WorkQueue>();
-    transportServer_ = MakeShared<DataChannelServer>(context_);
+    transportServer_ = CreateTransportServer(context_, url);
     transportServer_->onConnected_ = [this, queue](NetworkConnection* connection)
     {
         // Hold on to DataChannelConnection reference until callback executes.
@@ -281,16 +312,26 @@ void Network::BroadcastMessage(NetworkMessageId msgID, const unsigned char* data
 
 void Network::BroadcastRemoteEvent(StringHash eventType, bool inOrder, const VariantMap& eventData)
 {
+    if (clientConnections_.empty())
+        return;
+
+    // Serialize once, the data is shared by all connections
+    const RemoteEvent remoteEvent = SerializeRemoteEvent(eventType, inOrder, eventData);
     for (auto& connection : clientConnections_)
-        connection.second->SendRemoteEvent(eventType, inOrder, eventData);
+        connection.second->SendRemoteEvent(remoteEvent);
 }
 
 void Network::BroadcastRemoteEvent(Scene* scene, StringHash eventType, bool inOrder, const VariantMap& eventData)
 {
+    ea::optional<RemoteEvent> remoteEvent;
     for (auto& pair : clientConnections_)
     {
-        if (pair.second->GetScene() == scene)
-            pair.second->SendRemoteEvent(eventType, inOrder, eventData);
+        if (pair.second->GetScene() != scene)
+            continue;
+
+        if (!remoteEvent)
+            remoteEvent = SerializeRemoteEvent(eventType, inOrder, eventData);
+        pair.second->SendRemoteEvent(*remoteEvent);
     }
 }
 
@@ -344,14 +385,22 @@ void Network::RegisterRemoteEvent(StringHash eventType)
     allowedRemoteEvents_.insert(eventType);
 }
 
+void Network::RegisterRemoteEvent(StringHash eventType, const RemoteEventSchema& schema)
+{
+    allowedRemoteEvents_.insert(eventType);
+    remoteEventSchemas_[eventType] = schema;
+}
+
 void Network::UnregisterRemoteEvent(StringHash eventType)
 {
     allowedRemoteEvents_.erase(eventType);
+    remoteEventSchemas_.erase(eventType);
 }
 
 void Network::UnregisterAllRemoteEvents()
 {
     allowedRemoteEvents_.clear();
+    remoteEventSchemas_.clear();
 }
 
 void Network::SetPackageCacheDir(const ea::string& path)
@@ -412,6 +461,93 @@ bool Network::CheckRemoteEvent(StringHash eventType) const
     return allowedRemoteEvents_.contains(eventType);
 }
 
+RemoteEvent Network::SerializeRemoteEvent(StringHash eventType, bool inOrder, const VariantMap& eventData) const
+{
+    VectorBuffer buffer;
+    buffer.WriteStringHash(eventType);
+
+    RemoteEvent remoteEvent;
+    remoteEvent.inOrder_ = inOrder;
+
+    const auto iter = remoteEventSchemas_.find(eventType);
+    const RemoteEventSchema* schema = iter != remoteEventSchemas_.end() ? &iter->second : nullptr;
+    const bool isCompact = schema && ea::all_of(schema->begin(), schema->end(), [&](const RemoteEventField& field)
+    {
+        const auto valueIter = eventData.find(field.key_);
+        return valueIter == eventData.end() || valueIter->second.GetType() == field.type_;
+    });
+
+    if (isCompact)
+    {
+        // Bit mask of present parameters, then their values, then parameters not in schema
+        remoteEvent.messageId_ = MSG_REMOTEEVENT_COMPACT;
+
+        const unsigned numFields = schema->size();
+        ea::vector<unsigned char> presenceMask((numFields + 7) / 8);
+        for (unsigned i = 0; i < numFields; ++i)
+        {
+            if (eventData.contains((*schema)[i].key_))
+                presenceMask[i / 8] |= 1u << (i % 8);
+        }
+        buffer.Write(presenceMask.data(), presenceMask.size());
+
+        for (const RemoteEventField& field : *schema)
+        {
+            const auto valueIter = eventData.find(field.key_);
+            if (valueIter != eventData.end())
+                buffer.WriteVariantData(valueIter->second);
+        }
+
+        VariantMap extraData;
+        for (const auto& [key, value] : eventData)
+        {
+            const auto isKey = [&](const RemoteEventField& field) { return field.key_ == key; };
+            if (ea::find_if(schema->begin(), schema->end(), isKey) == schema->end())
+                extraData[key] = value;
+        }
+        buffer.WriteVariantMap(extraData);
+    }
+    else
+    {
+        remoteEvent.messageId_ = MSG_REMOTEEVENT;
+        buffer.WriteVariantMap(eventData);
+    }
+
+    remoteEvent.data_ = ea::make_shared<ByteVector>(ea::move(buffer.GetBuffer()));
+    return remoteEvent;
+}
+
+bool Network::DeserializeRemoteEventData(
+    NetworkMessageId messageId, StringHash eventType, Deserializer& source, VariantMap& eventData) const
+{
+    if (messageId != MSG_REMOTEEVENT_COMPACT)
+    {
+        eventData = source.ReadVariantMap();
+        return true;
+    }
+
+    const auto iter = remoteEventSchemas_.find(eventType);
+    if (iter == remoteEventSchemas_.end())
+        return false;
+
+    const RemoteEventSchema& schema = iter->second;
+    const unsigned numFields = schema.size();
+    ea::vector<unsigned char> presenceMask((numFields + 7) / 8);
+    if (source.Read(presenceMask.data(), presenceMask.size()) != presenceMask.size())
+        return false;
+
+    eventData.clear();
+    for (unsigned i = 0; i < numFields; ++i)
+    {
+        if (presenceMask[i / 8] & (1u << (i % 8)))
+            eventData[schema[i].key_] = source.ReadVariant(schema[i].type_, context_);
+    }
+
+    for (const auto& [key, value] : source.ReadVariantMap())
+        eventData[key] = value;
+    return true;
+}
+
 ea::string Network::GetDebugInfo() const
 {
     ea::string result;
@@ -558,6 +694,7 @@ void RegisterNetworkLibrary(Context* context)
     ReplicatedAnimation::RegisterObject(context);
     ReplicatedTransform::RegisterObject(context);
     TrackedAnimatedModel::RegisterObject(context);
+    TrackedAnimatedModelManager::RegisterObject(context);
     FilteredByDistance::RegisterObject(context);
 #ifdef URHO3D_PHYSICS
     PredictedKinematicController::RegisterObject(context);
@@ -566,6 +703,8 @@ void RegisterNetworkLibrary(Context* context)
     Connection::RegisterObject(context);
     DataChannelConnection::RegisterObject(context);
     DataChannelServer::RegisterObject(context);
+    UdpConnection::RegisterObject(context);
+    UdpServer::RegisterObject(context);
 }
 
 }
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <EASTL/hash_set.h>
+#include <EASTL/unordered_map.h>
 
 #include <Urho3D/Core/Object.h>
 #include <Urho3D/IO/VectorBuffer.h>
@@ -37,6 +38,17 @@ class MemoryBuffer;
 class Scene;
 class NetworkServer;
 
+/// Parameter of the remote event sent with compact encoding.
+struct RemoteEventField
+{
+    /// Parameter name.
+    StringHash key_;
+    /// Parameter type. Parameters of other types are sent with generic encoding.
+    VariantType type_{};
+};
+
+using RemoteEventSchema = ea::vector<RemoteEventField>;
+
 /// %Network subsystem. Manages client-server communications using the UDP protocol.
 class URHO3D_API Network : public Object
 {
@@ -77,6 +89,9 @@ public:
     void SetPingBufferSize(unsigned size);
     /// Register a remote event as allowed to be received. There is also a fixed blacklist of events that can not be allowed in any case, such as ConsoleCommand.
     void RegisterRemoteEvent(StringHash eventType);
+    /// Register a remote event as allowed to be received and sent with compact encoding.
+    /// Parameters from the schema are sent without names and type tags. Both sides should use the same schema.
+    void RegisterRemoteEvent(StringHash eventType, const RemoteEventSchema& schema);
     /// Unregister a remote event as allowed to received.
     void UnregisterRemoteEvent(StringHash eventType);
     /// Unregister all remote events.
@@ -117,6 +132,11 @@ public:
     bool IsServerRunning() const;
     /// Return whether a remote event is allowed to be received.
     bool CheckRemoteEvent(StringHash eventType) const;
+    /// Serialize remote event so it can be sent to any number of connections.
+    RemoteEvent SerializeRemoteEvent(StringHash eventType, bool inOrder, const VariantMap& eventData) const;
+    /// Deserialize remote event data after the event type. Return false if the data doesn't match the encoding.
+    bool DeserializeRemoteEventData(
+        NetworkMessageId messageId, StringHash eventType, Deserializer& source, VariantMap& eventData) const;
     /// Return aggregated debug info.
     ea::string GetDebugInfo() const;
 
@@ -163,6 +183,8 @@ private:
     ea::unordered_map<WeakPtr<NetworkConnection>, SharedPtr<Connection>> clientConnections_;
     /// Allowed remote events.
     ea::hash_set<StringHash> allowedRemoteEvents_;
+    /// Schemas of remote events with compact encoding.
+    ea::unordered_map<StringHash, RemoteEventSchema> remoteEventSchemas_;
     /// Update time interval.
     float updateInterval_ = 1.0f / updateFps_;
     /// Update time accumulator.
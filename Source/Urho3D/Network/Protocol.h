@@ -47,6 +47,8 @@ enum NetworkMessageId : uint16_t
 
     /// Client->server and server->client: remote event.
     MSG_REMOTEEVENT = 0x96,
+    /// Client->server and server->client: remote event encoded with the registered schema.
+    MSG_REMOTEEVENT_COMPACT = 0x97,
     /// Server->client: info about package.
     MSG_PACKAGEINFO = 0x98,
 
@@ -0,0 +1,52 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include <Urho3D/Precompiled.h>
+
+#include <Urho3D/Network/Transport/NetworkBuffer.h>
+
+namespace Urho3D
+{
+
+SharedPtr<NetworkBuffer> NetworkBufferPool::Acquire()
+{
+    const unsigned numBuffers = buffers_.size();
+    for (unsigned i = 0; i < numBuffers; ++i)
+    {
+        const unsigned index = (nextIndex_ + i) % numBuffers;
+        NetworkBuffer* buffer = buffers_[index];
+        if (buffer->Refs() == 1)
+        {
+            nextIndex_ = (index + 1) % numBuffers;
+            buffer->GetData().clear();
+            return SharedPtr<NetworkBuffer>(buffer);
+        }
+    }
+
+    auto buffer = MakeShared<NetworkBuffer>();
+    buffers_.push_back(buffer);
+    nextIndex_ = 0;
+    return buffer;
+}
+
+}
@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include <Urho3D/Container/ByteVector.h>
+#include <Urho3D/Container/Ptr.h>
+
+#include <EASTL/string_view.h>
+
+namespace Urho3D
+{
+
+/// Ref-counted buffer of outgoing network data.
+/// Transport may keep the reference to the buffer instead of copying the data.
+class URHO3D_API NetworkBuffer : public RefCounted
+{
+public:
+    /// Return data.
+    ByteVector& GetData() { return data_; }
+    /// Return data.
+    const ByteVector& GetData() const { return data_; }
+    /// Return size of data.
+    unsigned GetSize() const { return data_.size(); }
+    /// Return data as string view.
+    ea::string_view GetView() const { return {reinterpret_cast<const char*>(data_.data()), data_.size()}; }
+
+private:
+    ByteVector data_;
+};
+
+/// Part of the network buffer. Keeps the buffer alive.
+struct NetworkBufferSlice
+{
+    SharedPtr<NetworkBuffer> buffer_;
+    unsigned offset_{};
+    unsigned size_{};
+
+    /// Construct empty.
+    NetworkBufferSlice() = default;
+    /// Construct from whole buffer.
+    explicit NetworkBufferSlice(NetworkBuffer* buffer) : buffer_(buffer), size_(buffer->GetSize()) {}
+    /// Construct from part of the buffer.
+    NetworkBufferSlice(NetworkBuffer* buffer, unsigned offset, unsigned size) : buffer_(buffer), offset_(offset), size_(size) {}
+
+    /// Return pointer to the data.
+    const unsigned char* GetData() const { return buffer_->GetData().data() + offset_; }
+    /// Return size of the data.
+    unsigned GetSize() const { return size_; }
+    /// Return data as string view.
+    ea::string_view GetView() const { return {reinterpret_cast<const char*>(GetData()), size_}; }
+};
+
+/// Pool of network buffers. Buffer is reused when all references except the one held by the pool are released.
+/// Buffers should be acquired from one thread, references may be released from any thread.
+class URHO3D_API NetworkBufferPool
+{
+public:
+    /// Return unused buffer, empty but with reserved memory. Allocate new buffer if all are in use.
+    SharedPtr<NetworkBuffer> Acquire();
+
+    /// Return total number of buffers.
+    unsigned GetNumBuffers() const { return buffers_.size(); }
+
+private:
+    ea::vector<SharedPtr<NetworkBuffer>> buffers_;
+    /// Index of the buffer to check first. Buffers are usually released in order of acquisition.
+    unsigned nextIndex_{};
+};
+
+}
@@ -24,6 +24,8 @@
 
 #include <Urho3D/Core/Object.h>
 #include <Urho3D/Network/AbstractConnection.h>
+#include <Urho3D/Network/Transport/NetworkBuffer.h>
+#include <Urho3D/Network/URL.h>
 
 namespace Urho3D
 {
@@ -51,6 +53,11 @@ public:
     virtual void Disconnect() = 0;
     /// Copies data and queues it for sending.
     virtual void SendMessage(ea::string_view data, PacketTypeFlags type = PacketType::ReliableOrdered) = 0;
+    /// Queues shared data for sending. Buffer should not be modified after this call.
+    /// Transport may keep the reference instead of copying the data, copies it by default.
+    virtual void SendSharedMessage(const NetworkBufferSlice& data, PacketTypeFlags type = PacketType::ReliableOrdered) { SendMessage(data.GetView(), type); }
+    /// Sends queued messages if transport aggregates them. Called once all messages of the frame are sent.
+    virtual void Flush() {}
     /// Result may be empty, when connection is not %State::Connected.
     ea::string GetAddress() const { return address_; }
     /// Result may be 0, when connection is not %State::Connected or when result is not applicable to the underlying transport.
@@ -0,0 +1,593 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include <Urho3D/Precompiled.h>
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Network/Transport/Udp/UdpConnection.h>
+
+#include <chrono>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Head byte of message: channel in lower bits and fragment flag.
+constexpr unsigned char ChannelMask = 0x3;
+constexpr unsigned char FragmentFlag = 0x4;
+/// Number of times disconnect notification is sent, it is not acknowledged.
+constexpr unsigned NumDisconnectNotifications = 3;
+/// Max size of message header and acknowledgement written into the datagram.
+constexpr unsigned MaxMessageHeaderSize = 1 + 5 + 5;
+constexpr unsigned MaxAckSize = 1 + 5;
+constexpr unsigned DatagramHeaderSize = 1 + 4 + 5;
+
+long long GetTimeMs()
+{
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+bool IsReliable(unsigned char channel) { return (channel & PacketType::Reliable) != 0; }
+bool IsOrdered(unsigned char channel) { return (channel & PacketType::Ordered) != 0; }
+unsigned GetReliableIndex(unsigned char channel) { return IsOrdered(channel) ? 1 : 0; }
+
+}
+
+UdpConnection::UdpConnection(Context* context)
+    : NetworkConnection(context)
+{
+}
+
+UdpConnection::~UdpConnection()
+{
+    // Owner is being destroyed, don't notify it
+    onConnected_ = nullptr;
+    onDisconnected_ = nullptr;
+    onError_ = nullptr;
+    onMessage_ = nullptr;
+    Disconnect();
+
+    // Connection may be released by the last callback from its own thread
+    if (thread_.joinable())
+        thread_.detach();
+}
+
+void UdpConnection::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<UdpConnection>();
+}
+
+bool UdpConnection::Connect(const URL& url)
+{
+    Disconnect();
+
+    const auto address = UdpAddress::Resolve(url.host_, url.port_);
+    if (!address)
+    {
+        URHO3D_LOGERROR("Cannot resolve host '{}'", url.host_);
+        return false;
+    }
+
+    auto socket = ea::make_shared<UdpSocket>();
+    if (!socket->Open())
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        socket_ = socket;
+        peerAddress_ = *address;
+        address_ = address->GetHost();
+        port_ = address->port_;
+        salt_ = RandomEngine::GetDefaultEngine().GetUInt();
+        isServerSide_ = false;
+        state_ = State::Connecting;
+        connectStartTime_ = GetTimeMs();
+        lastConnectAttemptTime_ = connectStartTime_;
+        SendControlDatagram(DatagramKind::Connect);
+    }
+
+    stopThread_ = false;
+    thread_ = std::thread([this] { RunClientThread(); });
+    return true;
+}
+
+void UdpConnection::Disconnect()
+{
+    PendingCallbacks callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        DisconnectInternal(true, callbacks);
+    }
+
+    // Client connection owns the thread
+    if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id())
+    {
+        stopThread_ = true;
+        thread_.join();
+    }
+
+    InvokeCallbacks(callbacks);
+}
+
+void UdpConnection::SendMessage(ea::string_view data, PacketTypeFlags type)
+{
+    auto buffer = MakeShared<NetworkBuffer>();
+    const auto bytes = reinterpret_cast<const unsigned char*>(data.data());
+    buffer->GetData().assign(bytes, bytes + data.size());
+    SendSharedMessage(NetworkBufferSlice{buffer}, type);
+}
+
+void UdpConnection::SendSharedMessage(const NetworkBufferSlice& data, PacketTypeFlags type)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state_ != State::Connected)
+    {
+        URHO3D_LOGDEBUG("Network message was not sent: connection is not connected.");
+        return;
+    }
+
+    auto channel = static_cast<unsigned char>(type.AsInteger() & ChannelMask);
+
+    // Large messages are always fragmented and sent as reliable ordered
+    if (data.GetSize() > MaxFragmentSize)
+        channel = PacketType::ReliableOrdered;
+
+    // Messages reference the shared buffer until sent or acknowledged
+    if (IsReliable(channel))
+    {
+        ReliableSendChannel& sendChannel = reliableSend_[GetReliableIndex(channel)];
+        unsigned offset = 0;
+        do
+        {
+            const unsigned size = ea::min<unsigned>(MaxFragmentSize, data.GetSize() - offset);
+            PendingReliableMessage& message = sendChannel.pending_[sendChannel.nextId_++];
+            message.data_ = NetworkBufferSlice{data.buffer_, data.offset_ + offset, size};
+            offset += size;
+            message.isFragment_ = offset < data.GetSize();
+        } while (offset < data.GetSize());
+    }
+    else
+    {
+        UnreliableMessage& message = unreliableQueue_.emplace_back();
+        message.channel_ = channel;
+        message.sequence_ = IsOrdered(channel) ? nextUnreliableSequence_++ : 0;
+        message.data_ = data;
+    }
+}
+
+void UdpConnection::Flush()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state_ == State::Connected)
+        WriteDatagrams(GetTimeMs(), false);
+}
+
+unsigned UdpConnection::GetNumPendingReliableMessages() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reliableSend_[0].pending_.size() + reliableSend_[1].pending_.size();
+}
+
+void UdpConnection::InitializeFromServer(
+    const ea::shared_ptr<UdpSocket>& socket, const UdpAddress& address, unsigned salt)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    socket_ = socket;
+    peerAddress_ = address;
+    address_ = address.GetHost();
+    port_ = address.port_;
+    salt_ = salt;
+    isServerSide_ = true;
+    state_ = State::Connected;
+    lastReceiveTime_ = GetTimeMs();
+    SendControlDatagram(DatagramKind::Accept);
+}
+
+void UdpConnection::ProcessDatagram(const unsigned char* data, unsigned size, long long now)
+{
+    PendingCallbacks callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (size < DatagramHeaderSize - 5)
+            return;
+
+        MemoryBuffer src(data, size);
+        const auto kind = static_cast<DatagramKind>(src.ReadUByte());
+        const unsigned salt = src.ReadUInt();
+        if (salt != salt_)
+            return;
+
+        lastReceiveTime_ = now;
+        switch (kind)
+        {
+        case DatagramKind::Connect:
+            // Acceptance may have been lost, repeat it
+            if (isServerSide_)
+                SendControlDatagram(DatagramKind::Accept);
+            break;
+
+        case DatagramKind::Accept:
+            if (!isServerSide_ && state_ == State::Connecting)
+            {
+                state_ = State::Connected;
+                roundTripTime_ = static_cast<unsigned>(now - lastConnectAttemptTime_);
+                callbacks.connected_ = true;
+            }
+            break;
+
+        case DatagramKind::Data:
+            if (state_ == State::Connected)
+                ProcessData(src, now, callbacks);
+            break;
+
+        case DatagramKind::Disconnect:
+            DisconnectInternal(false, callbacks);
+            break;
+
+        default:
+            break;
+        }
+    }
+    InvokeCallbacks(callbacks);
+}
+
+void UdpConnection::ProcessData(MemoryBuffer& src, long long now, PendingCallbacks& callbacks)
+{
+    // Acknowledgements of our reliable messages
+    const unsigned numAcks = src.ReadVLE();
+    for (unsigned i = 0; i < numAcks && !src.IsEof(); ++i)
+    {
+        const unsigned char channel = src.ReadUByte() & ChannelMask;
+        const unsigned id = src.ReadVLE();
+        if (!IsReliable(channel))
+            continue;
+
+        auto& pending = reliableSend_[GetReliableIndex(channel)].pending_;
+        const auto iter = pending.find(id);
+        if (iter == pending.end())
+            continue;
+
+        // Only messages sent once give unambiguous round-trip time
+        if (iter->second.numSends_ == 1)
+        {
+            const auto sample = static_cast<unsigned>(now - iter->second.lastSendTime_);
+            const unsigned oldValue = roundTripTime_.load(std::memory_order_relaxed);
+            roundTripTime_.store(oldValue ? (oldValue * 7 + sample) / 8 : sample, std::memory_order_relaxed);
+        }
+        pending.erase(iter);
+    }
+
+    // Messages
+    while (!src.IsEof())
+    {
+        const unsigned char head = src.ReadUByte();
+        const unsigned char channel = head & ChannelMask;
+        const bool isFragment = (head & FragmentFlag) != 0;
+        const unsigned id = channel != PacketType::UnreliableUnordered ? src.ReadVLE() : 0;
+        const unsigned size = src.ReadVLE();
+        if (size > src.GetSize() - src.GetPosition())
+        {
+            URHO3D_LOGWARNING("Corrupted datagram received from {}", peerAddress_.ToString());
+            return;
+        }
+
+        ByteVector data(size);
+        src.Read(data.data(), size);
+
+        if (IsReliable(channel))
+        {
+            pendingAcks_.emplace_back(channel, id);
+            ProcessReliableMessage(channel, id, isFragment, ea::move(data), callbacks);
+        }
+        else if (channel == PacketType::UnreliableOrdered)
+        {
+            // Drop messages older than the latest one
+            if (latestUnreliableSequence_ && static_cast<int>(id - *latestUnreliableSequence_) <= 0)
+                continue;
+            latestUnreliableSequence_ = id;
+            callbacks.messages_.push_back(ea::move(data));
+        }
+        else
+        {
+            callbacks.messages_.push_back(ea::move(data));
+        }
+    }
+}
+
+void UdpConnection::ProcessReliableMessage(
+    unsigned char channel, unsigned id, bool isFragment, ByteVector data, PendingCallbacks& callbacks)
+{
+    ReliableReceiveChannel& receiveChannel = reliableReceive_[GetReliableIndex(channel)];
+
+    // Duplicate of delivered message
+    if (static_cast<int>(id - receiveChannel.nextId_) < 0)
+        return;
+
+    if (!IsOrdered(channel))
+    {
+        if (!receiveChannel.received_.insert(id).second)
+            return;
+
+        while (receiveChannel.received_.erase(receiveChannel.nextId_))
+            ++receiveChannel.nextId_;
+
+        callbacks.messages_.push_back(ea::move(data));
+        return;
+    }
+
+    if (id != receiveChannel.nextId_)
+    {
+        receiveChannel.buffered_.emplace(id, ea::make_pair(ea::move(data), isFragment));
+        return;
+    }
+
+    DeliverMessage(ea::move(data), isFragment, receiveChannel, callbacks);
+    ++receiveChannel.nextId_;
+
+    // Deliver buffered messages that are in order now
+    auto iter = receiveChannel.buffered_.begin();
+    while (iter != receiveChannel.buffered_.end() && iter->first == receiveChannel.nextId_)
+    {
+        DeliverMessage(ea::move(iter->second.first), iter->second.second, receiveChannel, callbacks);
+        ++receiveChannel.nextId_;
+        iter = receiveChannel.buffered_.erase(iter);
+    }
+}
+
+void UdpConnection::DeliverMessage(
+    ByteVector data, bool isFragment, ReliableReceiveChannel& channel, PendingCallbacks& callbacks)
+{
+    if (!isFragment && channel.fragments_.empty())
+    {
+        callbacks.messages_.push_back(ea::move(data));
+        return;
+    }
+
+    channel.fragments_.insert(channel.fragments_.end(), data.begin(), data.end());
+    if (!isFragment)
+    {
+        callbacks.messages_.push_back(ea::move(channel.fragments_));
+        channel.fragments_.clear();
+    }
+}
+
+void UdpConnection::Update(long long now)
+{
+    PendingCallbacks callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        switch (state_)
+        {
+        case State::Connecting:
+            if (now - connectStartTime_ > ConnectTimeoutMs)
+            {
+                URHO3D_LOGERROR("Cannot connect to {}: timeout", peerAddress_.ToString());
+                state_ = State::Disconnected;
+                callbacks.error_ = true;
+            }
+            else if (now - lastConnectAttemptTime_ >= ConnectRetryIntervalMs)
+            {
+                lastConnectAttemptTime_ = now;
+                SendControlDatagram(DatagramKind::Connect);
+            }
+            break;
+
+        case State::Connected:
+            if (now - lastReceiveTime_ > DisconnectTimeoutMs)
+            {
+                URHO3D_LOGWARNING("Connection {} timed out", peerAddress_.ToString());
+                DisconnectInternal(false, callbacks);
+            }
+            else
+            {
+                // Send acknowledgements and resend lost messages without waiting for the next flush
+                WriteDatagrams(now, now - lastSendTime_ >= KeepAliveIntervalMs);
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+    InvokeCallbacks(callbacks);
+}
+
+void UdpConnection::WriteDatagrams(long long now, bool forceSend)
+{
+    const long long resendInterval = ea::max<long long>(MinResendIntervalMs, 2 * roundTripTime_.load());
+
+    VectorBuffer datagram;
+    const auto beginDatagram = [&]()
+    {
+        datagram.Clear();
+        datagram.WriteUByte(static_cast<unsigned char>(DatagramKind::Data));
+        datagram.WriteUInt(salt_);
+    };
+    const auto flushIfFull = [&](unsigned size)
+    {
+        if (datagram.GetSize() + size > MaxDatagramSize)
+        {
+            SendDatagram(datagram, now);
+            beginDatagram();
+            datagram.WriteVLE(0);
+        }
+    };
+
+    // Acknowledgements go first, in as many datagrams as needed
+    beginDatagram();
+    unsigned ackIndex = 0;
+    while (true)
+    {
+        const unsigned maxAcks = (MaxDatagramSize - DatagramHeaderSize) / MaxAckSize;
+        const unsigned numAcks = ea::min<unsigned>(maxAcks, pendingAcks_.size() - ackIndex);
+        datagram.WriteVLE(numAcks);
+        for (unsigned i = 0; i < numAcks; ++i, ++ackIndex)
+        {
+            datagram.WriteUByte(pendingAcks_[ackIndex].first);
+            datagram.WriteVLE(pendingAcks_[ackIndex].second);
+        }
+
+        if (ackIndex >= pendingAcks_.size())
+            break;
+
+        SendDatagram(datagram, now);
+        beginDatagram();
+    }
+    const bool hasAcks = !pendingAcks_.empty();
+    pendingAcks_.clear();
+
+    // Reliable messages not sent yet or not acknowledged for too long
+    bool hasMessages = false;
+    for (unsigned char channel : {PacketType::ReliableOrdered, PacketType::ReliableUnordered})
+    {
+        for (auto& [id, message] : reliableSend_[GetReliableIndex(channel)].pending_)
+        {
+            if (message.numSends_ > 0 && now - message.lastSendTime_ < resendInterval)
+                continue;
+
+            flushIfFull(MaxMessageHeaderSize + message.data_.GetSize());
+            datagram.WriteUByte(channel | (message.isFragment_ ? FragmentFlag : 0));
+            datagram.WriteVLE(id);
+            datagram.WriteVLE(message.data_.GetSize());
+            datagram.Write(message.data_.GetData(), message.data_.GetSize());
+
+            message.lastSendTime_ = now;
+            ++message.numSends_;
+            hasMessages = true;
+        }
+    }
+
+    // Unreliable messages are sent once
+    for (const UnreliableMessage& message : unreliableQueue_)
+    {
+        flushIfFull(MaxMessageHeaderSize + message.data_.GetSize());
+        datagram.WriteUByte(message.channel_);
+        if (message.channel_ != PacketType::UnreliableUnordered)
+            datagram.WriteVLE(message.sequence_);
+        datagram.WriteVLE(message.data_.GetSize());
+        datagram.Write(message.data_.GetData(), message.data_.GetSize());
+        hasMessages = true;
+    }
+    unreliableQueue_.clear();
+
+    if (hasAcks || hasMessages || forceSend)
+        SendDatagram(datagram, now);
+}
+
+void UdpConnection::SendControlDatagram(DatagramKind kind)
+{
+    VectorBuffer datagram;
+    datagram.WriteUByte(static_cast<unsigned char>(kind));
+    datagram.WriteUInt(salt_);
+    SendDatagram(datagram, GetTimeMs());
+}
+
+void UdpConnection::SendDatagram(const VectorBuffer& datagram, long long now)
+{
+    if (socket_)
+        socket_->Send(peerAddress_, datagram.GetData(), datagram.GetSize());
+    lastSendTime_ = now;
+}
+
+void UdpConnection::DisconnectInternal(bool notifyPeer, PendingCallbacks& callbacks)
+{
+    if (state_ == State::Disconnected)
+        return;
+
+    if (notifyPeer && state_ == State::Connected)
+    {
+        for (unsigned i = 0; i < NumDisconnectNotifications; ++i)
+            SendControlDatagram(DatagramKind::Disconnect);
+    }
+
+    if (state_ == State::Connected)
+        callbacks.disconnected_ = true;
+    else
+        callbacks.error_ = true;
+
+    state_ = State::Disconnected;
+    for (ReliableSendChannel& channel : reliableSend_)
+        channel.pending_.clear();
+    unreliableQueue_.clear();
+    pendingAcks_.clear();
+}
+
+void UdpConnection::InvokeCallbacks(PendingCallbacks& callbacks)
+{
+    if (callbacks.connected_ && onConnected_)
+        onConnected_();
+
+    // Messages received before the owner has subscribed are kept until it does
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!undeliveredMessages_.empty())
+        {
+            callbacks.messages_.insert(callbacks.messages_.begin(), ea::make_move_iterator(undeliveredMessages_.begin()),
+                ea::make_move_iterator(undeliveredMessages_.end()));
+            undeliveredMessages_.clear();
+        }
+
+        if (!onMessage_)
+        {
+            undeliveredMessages_ = ea::move(callbacks.messages_);
+            callbacks.messages_.clear();
+        }
+    }
+
+    for (const ByteVector& message : callbacks.messages_)
+        onMessage_(ea::string_view{reinterpret_cast<const char*>(message.data()), message.size()});
+
+    if (callbacks.disconnected_ && onDisconnected_)
+        onDisconnected_();
+    if (callbacks.error_ && onError_)
+        onError_();
+}
+
+void UdpConnection::RunClientThread()
+{
+    ea::vector<unsigned char> buffer(MaxDatagramSize);
+    while (!stopThread_)
+    {
+        UdpAddress address;
+        const unsigned size = socket_->Receive(address, buffer.data(), buffer.size(), ReceiveTimeoutMs);
+        const long long now = GetTimeMs();
+        if (size > 0 && address == peerAddress_)
+            ProcessDatagram(buffer.data(), size, now);
+
+        Update(now);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (state_ == State::Disconnected)
+            break;
+    }
+}
+
+}
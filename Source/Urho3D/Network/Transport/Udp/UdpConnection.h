@@ -0,0 +1,179 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include <Urho3D/Container/ByteVector.h>
+#include <Urho3D/Network/Transport/NetworkConnection.h>
+#include <Urho3D/Network/Transport/Udp/UdpSocket.h>
+#include <Urho3D/Network/URL.h>
+
+#include <EASTL/map.h>
+#include <EASTL/shared_ptr.h>
+#include <EASTL/unordered_set.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace Urho3D
+{
+
+class UdpServer;
+
+/// Lightweight native transport over UDP.
+/// Reliable messages are acknowledged and resent until delivered, ordered reliable messages are delivered in order.
+/// Ordered unreliable messages older than the latest received one are dropped.
+/// Messages are aggregated into datagrams of limited size when the connection is flushed.
+class URHO3D_API UdpConnection : public NetworkConnection
+{
+    friend class UdpServer;
+    URHO3D_OBJECT(UdpConnection, NetworkConnection);
+
+public:
+    /// Max size of datagram, chosen to fit into typical MTU.
+    static constexpr unsigned MaxDatagramSize = 1200;
+    /// Max size of message payload in one datagram. Larger messages are fragmented and sent as reliable ordered.
+    static constexpr unsigned MaxFragmentSize = 1024;
+    static constexpr unsigned ConnectTimeoutMs = 5000;
+    static constexpr unsigned ConnectRetryIntervalMs = 100;
+    static constexpr unsigned DisconnectTimeoutMs = 10000;
+    static constexpr unsigned KeepAliveIntervalMs = 250;
+    static constexpr unsigned MinResendIntervalMs = 50;
+    static constexpr unsigned ReceiveTimeoutMs = 5;
+
+    explicit UdpConnection(Context* context);
+    ~UdpConnection() override;
+    static void RegisterObject(Context* context);
+
+    /// Supports "udp" scheme. Connection is served by internal thread.
+    bool Connect(const URL& url) override;
+    void Disconnect() override;
+    void SendMessage(ea::string_view data, PacketTypeFlags type = PacketType::ReliableOrdered) override;
+    void SendSharedMessage(const NetworkBufferSlice& data, PacketTypeFlags type = PacketType::ReliableOrdered) override;
+    void Flush() override;
+
+    /// Return smoothed round-trip time in milliseconds.
+    unsigned GetRoundTripTime() const { return roundTripTime_.load(std::memory_order_relaxed); }
+    /// Return number of reliable messages not acknowledged by the peer yet.
+    unsigned GetNumPendingReliableMessages() const;
+
+protected:
+    /// Kind of datagram, first byte of each datagram.
+    enum class DatagramKind : unsigned char
+    {
+        Connect = 1,
+        Accept,
+        Data,
+        Disconnect,
+    };
+
+    struct PendingReliableMessage
+    {
+        NetworkBufferSlice data_;
+        bool isFragment_{};
+        long long lastSendTime_{};
+        unsigned numSends_{};
+    };
+
+    struct ReliableSendChannel
+    {
+        unsigned nextId_{};
+        ea::map<unsigned, PendingReliableMessage> pending_;
+    };
+
+    struct ReliableReceiveChannel
+    {
+        unsigned nextId_{};
+        /// Ordered messages received out of order.
+        ea::map<unsigned, ea::pair<ByteVector, bool>> buffered_;
+        /// Unordered messages received out of order, used to drop duplicates.
+        ea::unordered_set<unsigned> received_;
+        /// Accumulated fragments of the message being received.
+        ByteVector fragments_;
+    };
+
+    struct UnreliableMessage
+    {
+        unsigned char channel_{};
+        unsigned sequence_{};
+        NetworkBufferSlice data_;
+    };
+
+    /// Channel callbacks collected under the lock and invoked after.
+    struct PendingCallbacks
+    {
+        bool connected_{};
+        bool disconnected_{};
+        bool error_{};
+        ea::vector<ByteVector> messages_;
+    };
+
+    /// Initialize incoming connection accepted by the server.
+    void InitializeFromServer(const ea::shared_ptr<UdpSocket>& socket, const UdpAddress& address, unsigned salt);
+    /// Process received datagram. Called from the thread that serves the connection.
+    void ProcessDatagram(const unsigned char* data, unsigned size, long long now);
+    /// Resend messages, send acknowledgements and check timeouts. Called from the thread that serves the connection.
+    void Update(long long now);
+    /// Return whether the connection is disconnected and should be discarded by the server.
+    bool IsFinished() const { return state_ == State::Disconnected; }
+
+    /// Internal implementation, must be called under the lock.
+    /// @{
+    void ProcessData(MemoryBuffer& src, long long now, PendingCallbacks& callbacks);
+    void ProcessReliableMessage(unsigned char channel, unsigned id, bool isFragment, ByteVector data, PendingCallbacks& callbacks);
+    void DeliverMessage(ByteVector data, bool isFragment, ReliableReceiveChannel& channel, PendingCallbacks& callbacks);
+    void WriteDatagrams(long long now, bool forceSend);
+    void SendControlDatagram(DatagramKind kind);
+    void SendDatagram(const VectorBuffer& datagram, long long now);
+    void DisconnectInternal(bool notifyPeer, PendingCallbacks& callbacks);
+    /// @}
+
+    void InvokeCallbacks(PendingCallbacks& callbacks);
+    void RunClientThread();
+
+    mutable std::mutex mutex_;
+    ea::shared_ptr<UdpSocket> socket_;
+    UdpAddress peerAddress_;
+    unsigned salt_{};
+    bool isServerSide_{};
+
+    ReliableSendChannel reliableSend_[2];
+    ReliableReceiveChannel reliableReceive_[2];
+    unsigned nextUnreliableSequence_{};
+    ea::optional<unsigned> latestUnreliableSequence_;
+    ea::vector<UnreliableMessage> unreliableQueue_;
+    ea::vector<ea::pair<unsigned char, unsigned>> pendingAcks_;
+    ea::vector<ByteVector> undeliveredMessages_;
+
+    long long connectStartTime_{};
+    long long lastConnectAttemptTime_{};
+    long long lastSendTime_{};
+    long long lastReceiveTime_{};
+    std::atomic<unsigned> roundTripTime_{};
+
+    std::thread thread_;
+    std::atomic_bool stopThread_{};
+};
+
+}
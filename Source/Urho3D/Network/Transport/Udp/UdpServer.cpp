@@ -0,0 +1,196 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include <Urho3D/Precompiled.h>
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/Network/Transport/Udp/UdpServer.h>
+
+#include <chrono>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+long long GetTimeMs()
+{
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+UdpServer::UdpServer(Context* context)
+    : NetworkServer(context)
+{
+}
+
+UdpServer::~UdpServer()
+{
+    Stop();
+}
+
+void UdpServer::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<UdpServer>(Category_Network);
+}
+
+bool UdpServer::Listen(const URL& url)
+{
+    Stop();
+
+    auto socket = ea::make_shared<UdpSocket>();
+    if (!socket->Open(url.port_))
+        return false;
+
+    socket_ = socket;
+    stopThread_ = false;
+    thread_ = std::thread([this] { RunThread(); });
+    return true;
+}
+
+void UdpServer::Stop()
+{
+    if (thread_.joinable())
+    {
+        stopThread_ = true;
+        thread_.join();
+    }
+
+    ea::unordered_map<UdpAddress, SharedPtr<UdpConnection>> connections;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        connections.swap(connections_);
+    }
+
+    for (const auto& [address, connection] : connections)
+    {
+        connection->Disconnect();
+        if (onDisconnected_)
+            onDisconnected_(connection);
+    }
+
+    if (socket_)
+    {
+        socket_->Close();
+        socket_ = nullptr;
+    }
+}
+
+unsigned UdpServer::GetNumConnections() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return connections_.size();
+}
+
+void UdpServer::RunThread()
+{
+    ea::vector<unsigned char> buffer(UdpConnection::MaxDatagramSize);
+    ea::vector<SharedPtr<UdpConnection>> connections;
+    ea::vector<SharedPtr<UdpConnection>> finishedConnections;
+    while (!stopThread_)
+    {
+        UdpAddress address;
+        const unsigned size = socket_->Receive(address, buffer.data(), buffer.size(), UdpConnection::ReceiveTimeoutMs);
+        const long long now = GetTimeMs();
+        if (size > 0)
+            ProcessDatagram(address, buffer.data(), size, now);
+
+        // Update connections outside of the lock so callbacks may access the server
+        connections.clear();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& [connectionAddress, connection] : connections_)
+                connections.push_back(connection);
+        }
+
+        finishedConnections.clear();
+        for (UdpConnection* connection : connections)
+        {
+            connection->Update(now);
+            if (connection->IsFinished())
+                finishedConnections.push_back(SharedPtr<UdpConnection>(connection));
+        }
+
+        for (UdpConnection* connection : finishedConnections)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                connections_.erase(connection->peerAddress_);
+            }
+            if (onDisconnected_)
+                onDisconnected_(connection);
+        }
+    }
+}
+
+void UdpServer::ProcessDatagram(const UdpAddress& address, const unsigned char* data, unsigned size, long long now)
+{
+    SharedPtr<UdpConnection> connection;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto iter = connections_.find(address);
+        if (iter != connections_.end())
+            connection = iter->second;
+    }
+
+    MemoryBuffer src(data, size);
+    const auto kind = static_cast<UdpConnection::DatagramKind>(src.ReadUByte());
+    const unsigned salt = src.ReadUInt();
+
+    // New connection or reconnection from the same address
+    if (kind == UdpConnection::DatagramKind::Connect && (!connection || connection->salt_ != salt))
+    {
+        if (connection)
+        {
+            connection->Disconnect();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                connections_.erase(address);
+            }
+            if (onDisconnected_)
+                onDisconnected_(connection);
+        }
+
+        connection = MakeShared<UdpConnection>(context_);
+        connection->InitializeFromServer(socket_, address, salt);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            connections_[address] = connection;
+        }
+
+        URHO3D_LOGDEBUG("UDP connection from {} is accepted", address.ToString());
+        if (onConnected_)
+            onConnected_(connection);
+        return;
+    }
+
+    if (connection)
+        connection->ProcessDatagram(data, size, now);
+}
+
+}
@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include <Urho3D/Network/Transport/NetworkServer.h>
+#include <Urho3D/Network/Transport/Udp/UdpConnection.h>
+
+#include <EASTL/unordered_map.h>
+
+namespace Urho3D
+{
+
+/// Server of native UDP transport. All connections share one socket served by internal thread.
+class URHO3D_API UdpServer : public NetworkServer
+{
+    URHO3D_OBJECT(UdpServer, NetworkServer);
+
+public:
+    explicit UdpServer(Context* context);
+    ~UdpServer() override;
+    static void RegisterObject(Context* context);
+
+    /// Supports "udp" scheme. Zero port means that any free port is used.
+    bool Listen(const URL& url) override;
+    void Stop() override;
+
+    /// Return port the server is listening on.
+    unsigned short GetLocalPort() const { return socket_ ? socket_->GetLocalPort() : 0; }
+    /// Return number of connections.
+    unsigned GetNumConnections() const;
+
+private:
+    void RunThread();
+    void ProcessDatagram(const UdpAddress& address, const unsigned char* data, unsigned size, long long now);
+
+    ea::shared_ptr<UdpSocket> socket_;
+
+    mutable std::mutex mutex_;
+    ea::unordered_map<UdpAddress, SharedPtr<UdpConnection>> connections_;
+
+    std::thread thread_;
+    std::atomic_bool stopThread_{};
+};
+
+}
@@ -0,0 +1,245 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include <Urho3D/Precompiled.h>
+
+#include <Urho3D/Core/Format.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Network/Transport/Udp/UdpSocket.h>
+
+#ifndef URHO3D_PLATFORM_WEB
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <netdb.h>
+    #include <netinet/in.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+namespace Urho3D
+{
+
+namespace
+{
+
+#ifdef _WIN32
+using NativeSocket = SOCKET;
+const long long invalidHandle = static_cast<long long>(INVALID_SOCKET);
+
+void CloseNativeSocket(NativeSocket socket) { closesocket(socket); }
+int PollNativeSocket(WSAPOLLFD* fd, unsigned timeoutMs) { return WSAPoll(fd, 1, static_cast<INT>(timeoutMs)); }
+
+/// Initialize Winsock once per process.
+void InitializeSockets()
+{
+    static const bool initialized = []
+    {
+        WSADATA data{};
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    (void)initialized;
+}
+#else
+using NativeSocket = int;
+const long long invalidHandle = -1;
+
+void CloseNativeSocket(NativeSocket socket) { close(socket); }
+int PollNativeSocket(pollfd* fd, unsigned timeoutMs) { return poll(fd, 1, static_cast<int>(timeoutMs)); }
+void InitializeSockets() {}
+#endif
+
+sockaddr_in ToNativeAddress(const UdpAddress& address)
+{
+    sockaddr_in result{};
+    result.sin_family = AF_INET;
+    result.sin_addr.s_addr = address.ip_;
+    result.sin_port = htons(address.port_);
+    return result;
+}
+
+}
+
+ea::optional<UdpAddress> UdpAddress::Resolve(const ea::string& host, unsigned short port)
+{
+    InitializeSockets();
+
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+
+    addrinfo* info = nullptr;
+    const char* hostName = host.empty() ? "127.0.0.1" : host.c_str();
+    if (getaddrinfo(hostName, nullptr, &hints, &info) != 0 || !info)
+        return ea::nullopt;
+
+    UdpAddress result;
+    result.ip_ = reinterpret_cast<const sockaddr_in*>(info->ai_addr)->sin_addr.s_addr;
+    result.port_ = port;
+    freeaddrinfo(info);
+    return result;
+}
+
+ea::string UdpAddress::GetHost() const
+{
+    char buffer[INET_ADDRSTRLEN]{};
+    in_addr address{};
+    address.s_addr = ip_;
+    inet_ntop(AF_INET, &address, buffer, sizeof(buffer));
+    return buffer;
+}
+
+ea::string UdpAddress::ToString() const
+{
+    return Format("{}:{}", GetHost(), port_);
+}
+
+UdpSocket::UdpSocket()
+    : handle_(invalidHandle)
+{
+}
+
+UdpSocket::~UdpSocket()
+{
+    Close();
+}
+
+bool UdpSocket::Open(unsigned short port)
+{
+    Close();
+    InitializeSockets();
+
+    const NativeSocket socketHandle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (static_cast<long long>(socketHandle) == invalidHandle)
+    {
+        URHO3D_LOGERROR("Cannot create UDP socket");
+        return false;
+    }
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if (bind(socketHandle, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        URHO3D_LOGERROR("Cannot bind UDP socket to port {}", port);
+        CloseNativeSocket(socketHandle);
+        return false;
+    }
+
+    handle_ = static_cast<long long>(socketHandle);
+    return true;
+}
+
+void UdpSocket::Close()
+{
+    if (handle_ != invalidHandle)
+    {
+        CloseNativeSocket(static_cast<NativeSocket>(handle_));
+        handle_ = invalidHandle;
+    }
+}
+
+bool UdpSocket::Send(const UdpAddress& address, const unsigned char* data, unsigned size)
+{
+    if (handle_ == invalidHandle)
+        return false;
+
+    const sockaddr_in nativeAddress = ToNativeAddress(address);
+    const auto result = sendto(static_cast<NativeSocket>(handle_), reinterpret_cast<const char*>(data), size, 0,
+        reinterpret_cast<const sockaddr*>(&nativeAddress), sizeof(nativeAddress));
+    return result == static_cast<decltype(result)>(size);
+}
+
+unsigned UdpSocket::Receive(UdpAddress& address, unsigned char* data, unsigned size, unsigned timeoutMs)
+{
+    if (handle_ == invalidHandle)
+        return 0;
+
+#ifdef _WIN32
+    WSAPOLLFD fd{};
+#else
+    pollfd fd{};
+#endif
+    fd.fd = static_cast<NativeSocket>(handle_);
+    fd.events = POLLIN;
+    if (PollNativeSocket(&fd, timeoutMs) <= 0 || !(fd.revents & POLLIN))
+        return 0;
+
+    sockaddr_in nativeAddress{};
+    socklen_t addressSize = sizeof(nativeAddress);
+    const auto result = recvfrom(static_cast<NativeSocket>(handle_), reinterpret_cast<char*>(data), size, 0,
+        reinterpret_cast<sockaddr*>(&nativeAddress), &addressSize);
+    if (result <= 0)
+        return 0;
+
+    address.ip_ = nativeAddress.sin_addr.s_addr;
+    address.port_ = ntohs(nativeAddress.sin_port);
+    return static_cast<unsigned>(result);
+}
+
+bool UdpSocket::IsOpen() const
+{
+    return handle_ != invalidHandle;
+}
+
+unsigned short UdpSocket::GetLocalPort() const
+{
+    if (handle_ == invalidHandle)
+        return 0;
+
+    sockaddr_in address{};
+    socklen_t addressSize = sizeof(address);
+    if (getsockname(static_cast<NativeSocket>(handle_), reinterpret_cast<sockaddr*>(&address), &addressSize) != 0)
+        return 0;
+    return ntohs(address.sin_port);
+}
+
+}
+
+#else
+
+namespace Urho3D
+{
+
+// Raw sockets are not available on Web
+ea::optional<UdpAddress> UdpAddress::Resolve(const ea::string& host, unsigned short port) { return ea::nullopt; }
+ea::string UdpAddress::GetHost() const { return EMPTY_STRING; }
+ea::string UdpAddress::ToString() const { return EMPTY_STRING; }
+
+UdpSocket::UdpSocket() : handle_(-1) {}
+UdpSocket::~UdpSocket() = default;
+bool UdpSocket::Open(unsigned short port) { return false; }
+void UdpSocket::Close() {}
+bool UdpSocket::Send(const UdpAddress& address, const unsigned char* data, unsigned size) { return false; }
+unsigned UdpSocket::Receive(UdpAddress& address, unsigned char* data, unsigned size, unsigned timeoutMs) { return 0; }
+bool UdpSocket::IsOpen() const { return false; }
+unsigned short UdpSocket::GetLocalPort() const { return 0; }
+
+}
+
+#endif
@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+
+#include <EASTL/optional.h>
+#include <EASTL/string.h>
+
+namespace Urho3D
+{
+
+/// IPv4 address and port of UDP endpoint.
+struct URHO3D_API UdpAddress
+{
+    /// IP address in network byte order.
+    unsigned ip_{};
+    /// Port in host byte order.
+    unsigned short port_{};
+
+    /// Resolve host name. Return null if name cannot be resolved.
+    static ea::optional<UdpAddress> Resolve(const ea::string& host, unsigned short port);
+
+    ea::string ToString() const;
+    ea::string GetHost() const;
+    unsigned ToHash() const { return ip_ ^ (static_cast<unsigned>(port_) << 16); }
+
+    bool operator==(const UdpAddress& rhs) const { return ip_ == rhs.ip_ && port_ == rhs.port_; }
+    bool operator!=(const UdpAddress& rhs) const { return !(*this == rhs); }
+};
+
+/// Minimal non-blocking UDP socket.
+class URHO3D_API UdpSocket
+{
+public:
+    UdpSocket();
+    ~UdpSocket();
+
+    UdpSocket(const UdpSocket& other) = delete;
+    UdpSocket& operator=(const UdpSocket& other) = delete;
+
+    /// Open socket bound to the port. Zero port means that any port is used.
+    bool Open(unsigned short port = 0);
+    /// Close socket. Pending Receive call returns.
+    void Close();
+    /// Send datagram.
+    bool Send(const UdpAddress& address, const unsigned char* data, unsigned size);
+    /// Wait for datagram up to timeout. Return size of received datagram or zero if nothing is received.
+    unsigned Receive(UdpAddress& address, unsigned char* data, unsigned size, unsigned timeoutMs);
+
+    bool IsOpen() const;
+    unsigned short GetLocalPort() const;
+
+private:
+    /// Native socket handle, type is platform-dependent.
+    long long handle_;
+};
+
+}
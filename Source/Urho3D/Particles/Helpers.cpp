@@ -102,11 +102,24 @@ PatternMatchingNode::Instance::Instance(PatternMatchingNode* op, const NodePatte
     : node_(op)
     , pattern_(pattern)
 {
+    for (auto& pin : node_->pins_)
+    {
+        pinRefs_.push_back(pin.GetMemoryReference());
+        allScalar_ &= pin.GetContainerType() == ParticleGraphContainerType::Scalar;
+    }
 }
 
 void PatternMatchingNode::Instance::Update(UpdateContext& context)
 {
-    node_->Update(context, pattern_);
+    // Index optimization
+    if (allScalar_ && context.indices_.size() > 1)
+    {
+        UpdateContext contextCopy = context;
+        contextCopy.indices_ = contextCopy.indices_.subspan(0, 1);
+        return pattern_.updateFunction_(contextCopy, pinRefs_.data());
+    }
+
+    return pattern_.updateFunction_(context, pinRefs_.data());
 }
 
 PatternMatchingNode::PatternMatchingNode(Context* context, const ea::vector<NodePattern>& patterns)
@@ -169,27 +182,6 @@ VariantType PatternMatchingNode::EvaluateOutputPinType(ParticleGraphPin& pin)
     return VAR_NONE;
 }
 
-void PatternMatchingNode::Update(UpdateContext& context, const NodePattern& pattern)
-{
-    ea::fixed_vector<ParticleGraphPinRef, NodePattern::ExpectedNumberOfPins> pinRefs;
-    bool allScalar = true;
-    for (auto& pin: pins_)
-    {
-        pinRefs.push_back(pin.GetMemoryReference());
-        allScalar &= pin.GetContainerType() == ParticleGraphContainerType::Scalar;
-    }
-
-    // Index optimization
-    if (allScalar && context.indices_.size() > 1)
-    {
-        UpdateContext contextCopy = context;
-        contextCopy.indices_ = contextCopy.indices_.subspan(0, 1);
-        return pattern.updateFunction_(contextCopy, pinRefs.data());
-    }
-
-    return pattern.updateFunction_(context, pinRefs.data());
-}
-
 } // namespace ParticleGraphNodes
 
 } // namespace Urho3D
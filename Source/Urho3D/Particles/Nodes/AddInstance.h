@@ -33,6 +33,14 @@ template <typename Value0, typename Value1, typename Value2> struct AddInstance
     void operator()(const UpdateContext& context, unsigned numParticles, const SparseSpan<Value0>& x,
         const SparseSpan<Value1>& y, const SparseSpan<Value2>& out)
     {
+        static_assert(sizeof(Value0) % sizeof(float) == 0, "Add is expected to operate on float-based types");
+        if (AreContiguous(x, y, out))
+        {
+            // Same-typed float tuples are added component-wise as plain arrays of floats
+            AddFloats(reinterpret_cast<const float*>(x.data_), reinterpret_cast<const float*>(y.data_),
+                reinterpret_cast<float*>(out.data_), numParticles * sizeof(Value0) / sizeof(float));
+            return;
+        }
         for (unsigned i = 0; i < numParticles; ++i)
         {
             out[i] = x[i] + y[i];
@@ -37,6 +37,19 @@ public:
     void operator()(const UpdateContext& context, unsigned numParticles, const SparseSpan<Vector3>& vel,
         const SparseSpan<Vector3>& force, const SparseSpan<Vector3>& result) const
     {
+        if (AreContiguous(vel, force, result))
+        {
+            MultiplyAddFloats(reinterpret_cast<const float*>(vel.data_), reinterpret_cast<const float*>(force.data_),
+                context.timeStep_, reinterpret_cast<float*>(result.data_), numParticles * 3);
+            return;
+        }
+        if (AreContiguous(vel, result) && force.IsScalar() && numParticles > 0)
+        {
+            const Vector3 delta = force.data_[0] * context.timeStep_;
+            for (unsigned i = 0; i < numParticles; ++i)
+                result.data_[i] = vel.data_[i] + delta;
+            return;
+        }
         for (unsigned i = 0; i < numParticles; ++i)
         {
             result[i] = vel[i] + force[i] * context.timeStep_;
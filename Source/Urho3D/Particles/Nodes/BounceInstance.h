@@ -41,6 +41,9 @@ namespace ParticleGraphNodes
 class BounceInstance final : public Bounce::InstanceBase
 {
 public:
+    /// Physics queries are not safe to run concurrently.
+    bool IsThreadSafe() const override { return false; }
+
     void RayCastAndBounce(
         const UpdateContext& context, Node* node, PhysicsWorld* physics, Vector3& pos, Vector3& velocity);
 
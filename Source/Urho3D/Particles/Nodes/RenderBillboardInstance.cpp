@@ -81,21 +81,7 @@ void RenderBillboardInstance::Prepare(unsigned numParticles)
 {
     auto* renderBillboard = static_cast<RenderBillboard*>(GetGraphNode());
 
-    if (!renderBillboard->GetIsWorldspace())
-    {
-        sceneNode_->SetWorldTransform(GetNode()->GetWorldTransform());
-    }
-    unsigned numBillboards = billboardSet_->GetNumBillboards();
-    //if (numBillboards < numParticles)
-    {
-        billboardSet_->SetNumBillboards(numParticles);
-        numBillboards = numParticles;
-    }
-    auto& billboards = billboardSet_->GetBillboards();
-    for (unsigned i = numParticles; i < numBillboards; ++i)
-    {
-        billboards[i].enabled_ = false;
-    }
+    billboards_.resize(numParticles);
     cols_ = Max(1, renderBillboard->GetColumns());
     rows_ = Max(1, renderBillboard->GetRows());
     auto crop = renderBillboard->GetCrop();
@@ -107,7 +93,7 @@ void RenderBillboardInstance::Prepare(unsigned numParticles)
 void RenderBillboardInstance::UpdateParticle(
     unsigned index, const Vector3& pos, const Vector2& size, float frameIndex, Color& color, float rotation, Vector3& direction)
 {
-    auto* billboard = billboardSet_->GetBillboard(index);
+    Billboard* billboard = &billboards_[index];
     billboard->enabled_ = true;
     billboard->position_ = pos;
     billboard->size_ = size * cropSize_;
@@ -122,7 +108,32 @@ void RenderBillboardInstance::UpdateParticle(
     billboard->uv_ = Rect(uvMin, uvMax);
 }
 
-void RenderBillboardInstance::Commit() { billboardSet_->Commit(); }
+void RenderBillboardInstance::CommitDrawables()
+{
+    auto* renderBillboard = static_cast<RenderBillboard*>(GetGraphNode());
+
+    if (!renderBillboard->GetIsWorldspace())
+    {
+        sceneNode_->SetWorldTransform(GetNode()->GetWorldTransform());
+    }
+
+    // Internal state of billboards is kept by the billboard set
+    billboardSet_->SetNumBillboards(billboards_.size());
+    auto& billboards = billboardSet_->GetBillboards();
+    for (unsigned i = 0; i < billboards_.size(); ++i)
+    {
+        const Billboard& source = billboards_[i];
+        Billboard& billboard = billboards[i];
+        billboard.position_ = source.position_;
+        billboard.size_ = source.size_;
+        billboard.uv_ = source.uv_;
+        billboard.color_ = source.color_;
+        billboard.rotation_ = source.rotation_;
+        billboard.direction_ = source.direction_;
+        billboard.enabled_ = source.enabled_;
+    }
+    billboardSet_->Commit();
+}
 
 } // namespace ParticleGraphNodes
 
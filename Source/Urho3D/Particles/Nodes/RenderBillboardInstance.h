@@ -41,11 +41,12 @@ public:
     void Init(ParticleGraphNode* node, ParticleGraphLayerInstance* layer) override;
     void OnSceneSet(Scene* scene) override;
     void UpdateDrawableAttributes() override;
+    void CommitDrawables() override;
+    Drawable* GetDrawable() const override { return billboardSet_; }
 
     void Prepare(unsigned numParticles);
     void UpdateParticle(unsigned index, const Vector3& pos, const Vector2& size, float frameIndex, Color& color,
         float rotation, Vector3& direction);
-    void Commit();
 
     void operator()(const UpdateContext& context, unsigned numParticles, const SparseSpan<Vector3>& pin0,
         const SparseSpan<Vector2>& pin1, const SparseSpan<float>& frame, const SparseSpan<Color>& color,
@@ -56,13 +57,14 @@ public:
         {
             UpdateParticle(i, pin0[i], pin1[i], frame[i], color[i], rotation[i], direction[i]);
         }
-        Commit();
     }
 
 protected:
     SharedPtr<Urho3D::Node> sceneNode_;
     SharedPtr<Urho3D::BillboardSet> billboardSet_;
     SharedPtr<Urho3D::Octree> octree_;
+    /// Billboards of the last update. Copied to the billboard set in CommitDrawables.
+    ea::vector<Billboard> billboards_;
     unsigned cols_{};
     unsigned rows_{};
     Vector2 uvTileSize_;
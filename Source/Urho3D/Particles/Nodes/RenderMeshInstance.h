@@ -56,6 +56,8 @@ public:
 
     void OnSceneSet(Scene* scene) override;
     void UpdateDrawableAttributes() override;
+    void CommitDrawables() override;
+    Drawable* GetDrawable() const override { return drawable_; }
 
     ~RenderMeshInstance() override;
 
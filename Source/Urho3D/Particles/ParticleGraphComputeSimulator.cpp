@@ -0,0 +1,204 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "ParticleGraphComputeSimulator.h"
+
+#include "../Core/Context.h"
+#include "../Graphics/Shader.h"
+#include "../Graphics/ShaderVariation.h"
+#include "../Graphics/VertexBuffer.h"
+#include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
+#include "../Math/Random.h"
+#include "../RenderAPI/DrawCommandQueue.h"
+#include "../RenderAPI/PipelineState.h"
+#include "../RenderAPI/RawBuffer.h"
+#include "../RenderAPI/RenderContext.h"
+#include "../RenderAPI/RenderDevice.h"
+#include "../RenderAPI/RenderScope.h"
+#include "../Resource/ResourceCache.h"
+#include "ParticleGraphLayer.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Return shader with generated code. Shaders are shared by all instances of the same layer.
+Shader* GetOrCreateShader(Context* context, const ea::string& name, const ea::string& code)
+{
+    auto cache = context->GetSubsystem<ResourceCache>();
+    if (Shader* shader = cache->GetExistingResource<Shader>(name))
+        return shader;
+
+    auto shader = MakeShared<Shader>(context);
+    shader->SetName(name);
+
+    MemoryBuffer buffer(code);
+    buffer.SetName(name);
+    if (!shader->Load(buffer))
+        return nullptr;
+
+    cache->AddManualResource(shader);
+    return shader;
+}
+
+}
+
+ParticleGraphComputeSimulator::ParticleGraphComputeSimulator(Context* context) : Object(context) {}
+
+ParticleGraphComputeSimulator::~ParticleGraphComputeSimulator() {}
+
+bool ParticleGraphComputeSimulator::IsSupported(Context* context)
+{
+    auto renderDevice = context->GetSubsystem<RenderDevice>();
+    return renderDevice && renderDevice->GetCaps().computeShaders_;
+}
+
+bool ParticleGraphComputeSimulator::Initialize(ParticleGraphLayer* layer)
+{
+    capacity_ = layer->GetCapacity();
+    currentBuffer_ = 0;
+    clearParticles_ = false;
+
+    if (!IsSupported(context_) || !capacity_)
+        return false;
+
+    if (!translator_.Translate(*layer))
+    {
+        URHO3D_LOGDEBUG("Particle graph layer is simulated on CPU: {}", translator_.GetError());
+        return false;
+    }
+
+    const ea::string& shaderCode = translator_.GetShaderCode();
+    const ea::string shaderName = Format("Shaders/GLSL/v2/C_ParticleGraph_{}.glsl", StringHash(shaderCode).ToString());
+    shader_ = GetOrCreateShader(context_, shaderName, shaderCode);
+    if (!shader_)
+        return false;
+
+    const unsigned bufferSize = capacity_ * translator_.GetParticleStride();
+    const RawBufferParams argsParams{BufferType::Vertex, ParticleGraphComputeTranslator::NumIndirectArgs * sizeof(unsigned),
+        sizeof(unsigned), BufferFlag::BindUnorderedAccess | BufferFlag::BindIndirectArgs};
+    for (unsigned i = 0; i < 2; ++i)
+    {
+        particleBuffers_[i] = MakeShared<VertexBuffer>(context_);
+        particleBuffers_[i]->SetDebugName(Format("ParticleGraphComputeSimulator: Particles #{}", i));
+        particleBuffers_[i]->SetUnorderedAccess(true);
+        if (!particleBuffers_[i]->SetSize(bufferSize, {VertexElement{TYPE_FLOAT, SEM_TEXCOORD}}))
+            return false;
+
+        argsBuffers_[i] = MakeShared<RawBuffer>(context_, argsParams);
+        argsBuffers_[i]->SetDebugName(Format("ParticleGraphComputeSimulator: Indirect Args #{}", i));
+        ResetArgs(i);
+    }
+
+    updatePipelineState_ = CreatePipelineState(false);
+    emitPipelineState_ = CreatePipelineState(true);
+    return updatePipelineState_ && emitPipelineState_;
+}
+
+void ParticleGraphComputeSimulator::Simulate(float timeStep, unsigned numEmitted)
+{
+    if (!updatePipelineState_ || !emitPipelineState_)
+        return;
+
+    const unsigned sourceBuffer = currentBuffer_;
+    const unsigned destBuffer = 1 - currentBuffer_;
+    if (clearParticles_)
+    {
+        ResetArgs(sourceBuffer);
+        clearParticles_ = false;
+    }
+    ResetArgs(destBuffer);
+
+    auto renderDevice = GetSubsystem<RenderDevice>();
+    RenderContext* renderContext = renderDevice->GetRenderContext();
+    DrawCommandQueue* drawQueue = renderDevice->GetDefaultQueue();
+
+    const RenderScope renderScope(renderContext, "ParticleGraphComputeSimulator::Simulate");
+
+    // Alive particles are not known on CPU, so update kernel covers whole capacity and exits early
+    using Translator = ParticleGraphComputeTranslator;
+    const unsigned numEmitGroups = (ea::min(numEmitted, capacity_) + Translator::GroupSize - 1) / Translator::GroupSize;
+    const unsigned numUpdateGroups = (capacity_ + Translator::GroupSize - 1) / Translator::GroupSize;
+
+    drawQueue->Reset();
+    for (const bool emit : {false, true})
+    {
+        if (emit && !numEmitGroups)
+            continue;
+
+        drawQueue->SetPipelineState(emit ? emitPipelineState_ : updatePipelineState_);
+
+        if (drawQueue->BeginShaderParameterGroup(SP_OBJECT, true))
+        {
+            drawQueue->AddShaderParameter("TimeStep", timeStep);
+            drawQueue->AddShaderParameter("Capacity", static_cast<int>(capacity_));
+            drawQueue->AddShaderParameter("NumEmitted", static_cast<int>(numEmitted));
+            drawQueue->AddShaderParameter("RandomSeed", static_cast<int>(Rand()));
+            drawQueue->CommitShaderParameterGroup(SP_OBJECT);
+        }
+
+        drawQueue->AddUnorderedAccessView("SourceParticles", particleBuffers_[sourceBuffer]);
+        drawQueue->AddUnorderedAccessView("SourceArgs", argsBuffers_[sourceBuffer]);
+        drawQueue->AddUnorderedAccessView("Particles", particleBuffers_[destBuffer]);
+        drawQueue->AddUnorderedAccessView("Args", argsBuffers_[destBuffer]);
+        drawQueue->CommitUnorderedAccessViews();
+
+        drawQueue->Dispatch({static_cast<int>(emit ? numEmitGroups : numUpdateGroups), 1, 1});
+    }
+
+    renderContext->ResetRenderTargets();
+    renderContext->Execute(drawQueue);
+
+    currentBuffer_ = destBuffer;
+}
+
+SharedPtr<PipelineState> ParticleGraphComputeSimulator::CreatePipelineState(bool emit)
+{
+    auto pipelineStateCache = GetSubsystem<PipelineStateCache>();
+
+    ComputePipelineStateDesc desc;
+    desc.debugName_ = Format("{}: {}", shader_->GetName(), emit ? "Emit" : "Update");
+    desc.computeShader_ = shader_->GetVariation(CS, emit ? "URHO3D_EMIT" : "");
+
+    SharedPtr<PipelineState> pipelineState = pipelineStateCache->GetComputePipelineState(desc);
+    if (!pipelineState->IsValid())
+    {
+        URHO3D_LOGERROR("ParticleGraphComputeSimulator failed to create pipeline state");
+        return nullptr;
+    }
+    return pipelineState;
+}
+
+void ParticleGraphComputeSimulator::ResetArgs(unsigned bufferIndex)
+{
+    const unsigned args[ParticleGraphComputeTranslator::NumIndirectArgs]{
+        ParticleGraphComputeTranslator::NumParticleIndices, 0, 0, 0, 0};
+    argsBuffers_[bufferIndex]->Update(args);
+}
+
+}
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Core/Object.h"
+#include "ParticleGraphComputeTranslator.h"
+
+namespace Urho3D
+{
+
+class ParticleGraphLayer;
+class PipelineState;
+class RawBuffer;
+class Shader;
+class VertexBuffer;
+
+/// Simulates particles of particle graph layer on GPU by compute shaders generated by ParticleGraphComputeTranslator.
+/// Particles are ping-ponged between two storage buffers: update kernel compacts alive particles
+/// into the other buffer, then emit kernel appends new particles there.
+/// Number of alive particles never leaves GPU, it is stored in indirect draw arguments of the current buffer.
+class URHO3D_API ParticleGraphComputeSimulator : public Object
+{
+    URHO3D_OBJECT(ParticleGraphComputeSimulator, Object);
+
+public:
+    /// Construct.
+    explicit ParticleGraphComputeSimulator(Context* context);
+    /// Destruct.
+    ~ParticleGraphComputeSimulator() override;
+
+    /// Return whether compute simulation is supported by current render device.
+    static bool IsSupported(Context* context);
+
+    /// Initialize with committed layer. Return false if the layer cannot be simulated on GPU.
+    bool Initialize(ParticleGraphLayer* layer);
+    /// Update alive particles and emit new ones. Should be called from the main thread.
+    void Simulate(float timeStep, unsigned numEmitted);
+    /// Remove all particles on next simulation.
+    void RemoveAllParticles() { clearParticles_ = true; }
+
+    /// Return translated layer.
+    const ParticleGraphComputeTranslator& GetTranslator() const { return translator_; }
+    /// Return buffer with current particles. Particles are laid out according to the translator.
+    VertexBuffer* GetParticleBuffer() const { return particleBuffers_[currentBuffer_]; }
+    /// Return indirect draw arguments of one quad per current particle.
+    RawBuffer* GetIndirectArgsBuffer() const { return argsBuffers_[currentBuffer_]; }
+    /// Return max number of particles.
+    unsigned GetCapacity() const { return capacity_; }
+
+private:
+    /// Create pipeline state for the kernel.
+    SharedPtr<PipelineState> CreatePipelineState(bool emit);
+    /// Reset number of particles in the buffer.
+    void ResetArgs(unsigned bufferIndex);
+
+    /// Translated layer.
+    ParticleGraphComputeTranslator translator_;
+    /// Max number of particles.
+    unsigned capacity_{};
+    /// Generated shader.
+    SharedPtr<Shader> shader_;
+    /// Particle buffers.
+    SharedPtr<VertexBuffer> particleBuffers_[2];
+    /// Indirect draw arguments and number of particles of each buffer.
+    SharedPtr<RawBuffer> argsBuffers_[2];
+    /// Index of buffer with current particles.
+    unsigned currentBuffer_{};
+    /// Pipeline state of update kernel.
+    SharedPtr<PipelineState> updatePipelineState_;
+    /// Pipeline state of emit kernel.
+    SharedPtr<PipelineState> emitPipelineState_;
+    /// Whether to remove all particles on next simulation.
+    bool clearParticles_{};
+};
+
+}
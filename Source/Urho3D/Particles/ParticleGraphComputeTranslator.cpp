@@ -0,0 +1,389 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "ParticleGraphComputeTranslator.h"
+
+#include "../Core/Format.h"
+#include "ParticleGraph.h"
+#include "ParticleGraphLayer.h"
+#include "ParticleGraphNode.h"
+#include "Nodes/Add.h"
+#include "Nodes/ApplyForce.h"
+#include "Nodes/Attribute.h"
+#include "Nodes/Constant.h"
+#include "Nodes/Divide.h"
+#include "Nodes/Expire.h"
+#include "Nodes/Move.h"
+#include "Nodes/Multiply.h"
+#include "Nodes/Negate.h"
+#include "Nodes/Random.h"
+#include "Nodes/Subtract.h"
+#include "Nodes/TimeStep.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Common part of the shader, layouts shall match ParticleGraphComputeSimulator.
+const char* shaderPrologue = R"(// Generated by ParticleGraphComputeTranslator.
+// URHO3D_EMIT: initialize emitted particles, otherwise update alive particles.
+
+layout(std140, binding = 5) uniform Object
+{
+    float cTimeStep;
+    int cCapacity;
+    int cNumEmitted;
+    int cRandomSeed;
+};
+
+layout(std430, binding = 0) buffer uSourceParticles
+{
+    float sourceParticles[];
+};
+
+layout(std430, binding = 1) buffer uSourceArgs
+{
+    uint sourceArgs[];
+};
+
+layout(std430, binding = 2) buffer uParticles
+{
+    float particles[];
+};
+
+layout(std430, binding = 3) buffer uArgs
+{
+    uint args[];
+};
+
+uint HashUInt(uint value)
+{
+    value ^= value >> 16u;
+    value *= 0x7feb352du;
+    value ^= value >> 15u;
+    value *= 0x846ca68bu;
+    value ^= value >> 16u;
+    return value;
+}
+
+float NextRandom(inout uint state)
+{
+    state = HashUInt(state);
+    return float(state >> 8u) / 16777216.0;
+}
+
+)";
+
+const char* componentNames[] = {"x", "y", "z", "w"};
+
+unsigned GetNumComponents(VariantType type)
+{
+    switch (type)
+    {
+    case VAR_FLOAT: return 1;
+    case VAR_VECTOR2: return 2;
+    case VAR_VECTOR3: return 3;
+    case VAR_VECTOR4:
+    case VAR_COLOR: return 4;
+    default: return 0;
+    }
+}
+
+const char* GetShaderType(VariantType type)
+{
+    static const char* shaderTypes[] = {"", "float", "vec2", "vec3", "vec4"};
+    return shaderTypes[GetNumComponents(type)];
+}
+
+ea::string FormatFloat(float value)
+{
+    ea::string result = Format("{}", value);
+    if (result.find_first_of(".en") == ea::string::npos)
+        result += ".0";
+    return result;
+}
+
+ea::string FormatValue(const Variant& value)
+{
+    switch (value.GetType())
+    {
+    case VAR_FLOAT:
+        return FormatFloat(value.GetFloat());
+    case VAR_VECTOR2:
+    {
+        const Vector2& v = value.GetVector2();
+        return Format("vec2({}, {})", FormatFloat(v.x_), FormatFloat(v.y_));
+    }
+    case VAR_VECTOR3:
+    {
+        const Vector3& v = value.GetVector3();
+        return Format("vec3({}, {}, {})", FormatFloat(v.x_), FormatFloat(v.y_), FormatFloat(v.z_));
+    }
+    case VAR_VECTOR4:
+    {
+        const Vector4& v = value.GetVector4();
+        return Format("vec4({}, {}, {}, {})", FormatFloat(v.x_), FormatFloat(v.y_), FormatFloat(v.z_), FormatFloat(v.w_));
+    }
+    case VAR_COLOR:
+    {
+        const Color& c = value.GetColor();
+        return Format("vec4({}, {}, {}, {})", FormatFloat(c.r_), FormatFloat(c.g_), FormatFloat(c.b_), FormatFloat(c.a_));
+    }
+    default:
+        return EMPTY_STRING;
+    }
+}
+
+/// Return index of the first output pin.
+unsigned GetOutputPinIndex(const ParticleGraphNode& node)
+{
+    for (unsigned i = 0; i < node.GetNumPins(); ++i)
+    {
+        if (!node.GetPin(i).IsInput())
+            return i;
+    }
+    return ParticleGraphNode::INVALID_PIN;
+}
+
+}
+
+bool ParticleGraphComputeTranslator::Translate(ParticleGraphLayer& layer)
+{
+    shaderCode_.clear();
+    attributeOffsets_.clear();
+    particleStride_ = 0;
+    error_.clear();
+
+    if (!layer.Commit())
+    {
+        error_ = "Layer cannot be committed";
+        return false;
+    }
+
+    const ParticleGraphAttributeLayout& attributes = layer.GetAttributeLayout();
+    for (unsigned i = 0; i < attributes.GetNumAttributes(); ++i)
+    {
+        const unsigned numComponents = GetNumComponents(attributes.GetType(i));
+        if (!numComponents)
+        {
+            error_ = Format("Attribute '{}' of type {} is not supported", attributes.GetName(i),
+                Variant::GetTypeNameList()[attributes.GetType(i)]);
+            return false;
+        }
+        attributeOffsets_.push_back(particleStride_);
+        particleStride_ += numComponents;
+    }
+
+    if (!particleStride_)
+    {
+        error_ = "Layer has no attributes";
+        return false;
+    }
+
+    ea::string initCode;
+    ea::string updateCode;
+    if (!TranslateGraph(layer.GetInitGraph(), "i", initCode) || !TranslateGraph(layer.GetUpdateGraph(), "u", updateCode))
+        return false;
+
+    shaderCode_ = shaderPrologue;
+    shaderCode_ += Format("#define PARTICLE_STRIDE {}u\n\n", particleStride_);
+    shaderCode_ += Format("layout(local_size_x = {}) in;\n\n", GroupSize);
+    shaderCode_ += "void main()\n{\n";
+    shaderCode_ += "    uint index = gl_GlobalInvocationID.x;\n";
+    shaderCode_ += "    uint randomState = HashUInt(index ^ HashUInt(uint(cRandomSeed)));\n";
+    shaderCode_ += "    bool alive = true;\n";
+    shaderCode_ += "#ifdef URHO3D_EMIT\n";
+    shaderCode_ += "    if (index >= uint(cNumEmitted))\n        return;\n";
+    shaderCode_ += GenerateLoadAttributes(layer, true);
+    shaderCode_ += initCode;
+    shaderCode_ += "#else\n";
+    shaderCode_ += "    if (index >= sourceArgs[1])\n        return;\n";
+    shaderCode_ += "    uint sourceOffset = index * PARTICLE_STRIDE;\n";
+    shaderCode_ += GenerateLoadAttributes(layer, false);
+    shaderCode_ += updateCode;
+    shaderCode_ += "#endif\n";
+    shaderCode_ += "    if (!alive)\n        return;\n";
+    // Particles beyond capacity are dropped, each overflowing thread takes its increment back
+    shaderCode_ += "    uint slot = atomicAdd(args[1], 1u);\n";
+    shaderCode_ += "    if (slot >= uint(cCapacity))\n    {\n";
+    shaderCode_ += "        atomicAdd(args[1], 0xffffffffu);\n        return;\n    }\n";
+    shaderCode_ += "    uint offset = slot * PARTICLE_STRIDE;\n";
+    shaderCode_ += GenerateStoreAttributes(layer);
+    shaderCode_ += "}\n";
+    return true;
+}
+
+unsigned ParticleGraphComputeTranslator::GetAttributeOffset(unsigned attributeIndex) const
+{
+    return attributeIndex < attributeOffsets_.size() ? attributeOffsets_[attributeIndex] : M_MAX_UNSIGNED;
+}
+
+bool ParticleGraphComputeTranslator::TranslateGraph(ParticleGraph& graph, const ea::string& prefix, ea::string& code)
+{
+    using namespace ParticleGraphNodes;
+
+    // Expressions of node pins. Output pins are assigned as the nodes are translated.
+    ea::vector<ea::vector<ea::string>> pinExpressions(graph.GetNumNodes());
+
+    for (unsigned nodeIndex = 0; nodeIndex < graph.GetNumNodes(); ++nodeIndex)
+    {
+        const SharedPtr<ParticleGraphNode> node = graph.GetNode(nodeIndex);
+        ea::vector<ea::string>& expressions = pinExpressions[nodeIndex];
+        expressions.resize(node->GetNumPins());
+
+        for (unsigned pinIndex = 0; pinIndex < node->GetNumPins(); ++pinIndex)
+        {
+            const ParticleGraphPin& pin = node->GetPin(pinIndex);
+            if (!GetNumComponents(pin.GetValueType()))
+            {
+                error_ = Format("Pin {}.{} of type {} is not supported", node->GetTypeName(), pin.GetName(),
+                    Variant::GetTypeNameList()[pin.GetValueType()]);
+                return false;
+            }
+            if (pin.IsInput())
+                expressions[pinIndex] = pinExpressions[pin.GetConnectedNodeIndex()][pin.GetConnectedPinIndex()];
+        }
+
+        const StringHash nodeType = node->GetType();
+        const unsigned outputPin = GetOutputPinIndex(*node);
+        const ea::string variable = Format("{}{}", prefix, nodeIndex);
+        const ea::string declaration = outputPin != ParticleGraphNode::INVALID_PIN
+            ? Format("    {} {} = ", GetShaderType(node->GetPin(outputPin).GetValueType()), variable)
+            : EMPTY_STRING;
+
+        if (nodeType == GetAttribute::GetTypeStatic())
+        {
+            expressions[0] = Format("a{}", node->GetPin(0).GetAttributeIndex());
+        }
+        else if (nodeType == SetAttribute::GetTypeStatic())
+        {
+            expressions[0] = Format("a{}", node->GetPin(0).GetAttributeIndex());
+            code += Format("    {} = {};\n", expressions[0], expressions[1]);
+        }
+        else if (nodeType == Constant::GetTypeStatic())
+        {
+            const Variant& value = static_cast<Constant*>(node.Get())->GetValue();
+            if (value.GetType() != node->GetPin(0).GetValueType())
+            {
+                error_ = "Constant value doesn't match pin type";
+                return false;
+            }
+            expressions[0] = FormatValue(value);
+        }
+        else if (nodeType == ParticleGraphNodes::Random::GetTypeStatic())
+        {
+            const auto random = static_cast<ParticleGraphNodes::Random*>(node.Get());
+            const VariantType type = node->GetPin(0).GetValueType();
+            if (random->GetMin().GetType() != type || random->GetMax().GetType() != type)
+            {
+                error_ = "Random range doesn't match pin type";
+                return false;
+            }
+            expressions[0] = variable;
+            code += Format("{}mix({}, {}, NextRandom(randomState));\n", declaration, FormatValue(random->GetMin()),
+                FormatValue(random->GetMax()));
+        }
+        else if (nodeType == TimeStep::GetTypeStatic())
+        {
+            expressions[0] = "cTimeStep";
+        }
+        else if (nodeType == Add::GetTypeStatic() || nodeType == Subtract::GetTypeStatic()
+            || nodeType == Multiply::GetTypeStatic() || nodeType == Divide::GetTypeStatic())
+        {
+            const char* operation = nodeType == Add::GetTypeStatic() ? "+"
+                : nodeType == Subtract::GetTypeStatic()              ? "-"
+                : nodeType == Multiply::GetTypeStatic()              ? "*"
+                                                                     : "/";
+            expressions[2] = variable;
+            code += Format("{}{} {} ({});\n", declaration, expressions[0], operation, expressions[1]);
+        }
+        else if (nodeType == Negate::GetTypeStatic())
+        {
+            expressions[1] = variable;
+            code += Format("{}-({});\n", declaration, expressions[0]);
+        }
+        else if (nodeType == ApplyForce::GetTypeStatic() || nodeType == Move::GetTypeStatic())
+        {
+            expressions[2] = variable;
+            code += Format("{}{} + cTimeStep * {};\n", declaration, expressions[0], expressions[1]);
+        }
+        else if (nodeType == Expire::GetTypeStatic())
+        {
+            code += Format("    if ({} >= {})\n        alive = false;\n", expressions[0], expressions[1]);
+        }
+        else
+        {
+            error_ = Format("Node {} is not supported by compute simulation", node->GetTypeName());
+            return false;
+        }
+    }
+    return true;
+}
+
+ea::string ParticleGraphComputeTranslator::GenerateLoadAttributes(ParticleGraphLayer& layer, bool emit) const
+{
+    const ParticleGraphAttributeLayout& attributes = layer.GetAttributeLayout();
+
+    ea::string code;
+    for (unsigned i = 0; i < attributes.GetNumAttributes(); ++i)
+    {
+        const VariantType type = attributes.GetType(i);
+        const unsigned numComponents = GetNumComponents(type);
+        code += Format("    {} a{} = ", GetShaderType(type), i);
+        if (emit)
+        {
+            code += numComponents == 1 ? "0.0;\n" : Format("{}(0.0);\n", GetShaderType(type));
+            continue;
+        }
+
+        if (numComponents > 1)
+            code += Format("{}(", GetShaderType(type));
+        for (unsigned j = 0; j < numComponents; ++j)
+            code += Format("{}sourceParticles[sourceOffset + {}u]", j ? ", " : "", attributeOffsets_[i] + j);
+        code += numComponents > 1 ? ");\n" : ";\n";
+    }
+    return code;
+}
+
+ea::string ParticleGraphComputeTranslator::GenerateStoreAttributes(ParticleGraphLayer& layer) const
+{
+    const ParticleGraphAttributeLayout& attributes = layer.GetAttributeLayout();
+
+    ea::string code;
+    for (unsigned i = 0; i < attributes.GetNumAttributes(); ++i)
+    {
+        const unsigned numComponents = GetNumComponents(attributes.GetType(i));
+        for (unsigned j = 0; j < numComponents; ++j)
+        {
+            code += Format("    particles[offset + {}u] = a{}{}{};\n", attributeOffsets_[i] + j, i,
+                numComponents > 1 ? "." : "", numComponents > 1 ? componentNames[j] : "");
+        }
+    }
+    return code;
+}
+
+}
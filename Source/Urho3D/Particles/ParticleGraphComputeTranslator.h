@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Container/Str.h"
+#include "../Math/MathDefs.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class ParticleGraph;
+class ParticleGraphLayer;
+
+/// Translates particle graph layer to compute shader source code for ParticleGraphComputeSimulator.
+/// Emission graph is always evaluated on CPU, it only provides number of emitted particles.
+/// Initialization and update graphs are translated if all their nodes are GPU-expressible:
+/// attributes, constants, random values, arithmetics, time step, forces, movement and expiration.
+/// Particles are stored interleaved, each attribute takes from 1 to 4 floats.
+///
+/// Generated shader has two kernels selected by URHO3D_EMIT define:
+/// update kernel reads alive particles from source buffer and appends survivors to destination buffer,
+/// emit kernel appends new particles to destination buffer.
+/// Number of particles is stored as instance count of indirect draw arguments of each buffer.
+class URHO3D_API ParticleGraphComputeTranslator
+{
+public:
+    /// Number of threads in group.
+    static constexpr unsigned GroupSize = 64;
+    /// Number of indices drawn for each particle instance, i.e. one quad.
+    static constexpr unsigned NumParticleIndices = 6;
+    /// Number of words in indirect draw arguments.
+    static constexpr unsigned NumIndirectArgs = 5;
+
+    /// Translate committed layer. Return false if layer cannot be simulated on GPU.
+    bool Translate(ParticleGraphLayer& layer);
+
+    /// Return generated shader code.
+    const ea::string& GetShaderCode() const { return shaderCode_; }
+    /// Return size of particle in floats.
+    unsigned GetParticleStride() const { return particleStride_; }
+    /// Return offset of attribute in floats within particle. Return M_MAX_UNSIGNED if attribute is unknown.
+    unsigned GetAttributeOffset(unsigned attributeIndex) const;
+    /// Return reason why the layer cannot be simulated on GPU.
+    const ea::string& GetError() const { return error_; }
+
+private:
+    /// Generate code of the graph. Return false if any node is not supported.
+    bool TranslateGraph(ParticleGraph& graph, const ea::string& prefix, ea::string& code);
+    /// Generate load or initialization of all attributes.
+    ea::string GenerateLoadAttributes(ParticleGraphLayer& layer, bool emit) const;
+    /// Generate store of all attributes.
+    ea::string GenerateStoreAttributes(ParticleGraphLayer& layer) const;
+
+    /// Generated shader code.
+    ea::string shaderCode_;
+    /// Offsets of attributes in floats.
+    ea::vector<unsigned> attributeOffsets_;
+    /// Size of particle in floats.
+    unsigned particleStride_{};
+    /// Error message.
+    ea::string error_;
+};
+
+}
@@ -28,7 +28,7 @@
 #include "../Resource/ResourceCache.h"
 #include "../Resource/ResourceEvents.h"
 #include "../Scene/Scene.h"
-#include "../Scene/SceneEvents.h"
+#include "ParticleGraphEmitterManager.h"
 #include "ParticleGraphLayer.h"
 #include "ParticleGraphLayerInstance.h"
 
@@ -39,7 +39,11 @@ ParticleGraphEmitter::ParticleGraphEmitter(Context* context)
 {
 }
 
-ParticleGraphEmitter::~ParticleGraphEmitter() = default;
+ParticleGraphEmitter::~ParticleGraphEmitter()
+{
+    if (manager_)
+        manager_->RemoveEmitter(this);
+}
 
 void ParticleGraphEmitter::RegisterObject(Context* context)
 {
@@ -58,14 +62,22 @@ void ParticleGraphEmitter::OnSetEnabled()
 {
     Component::OnSetEnabled();
 
+    UpdateManager();
+}
+
+void ParticleGraphEmitter::UpdateManager()
+{
     Scene* scene = GetScene();
-    if (scene)
-    {
-        if (IsEnabledEffective())
-            SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(ParticleGraphEmitter, HandleScenePostUpdate));
-        else
-            UnsubscribeFromEvent(scene, E_SCENEPOSTUPDATE);
-    }
+    ParticleGraphEmitterManager* manager =
+        scene && IsEnabledEffective() ? scene->GetOrCreateComponent<ParticleGraphEmitterManager>() : nullptr;
+    if (manager == manager_)
+        return;
+
+    if (manager_)
+        manager_->RemoveEmitter(this);
+    manager_ = manager;
+    if (manager_)
+        manager_->AddEmitter(this);
 }
 
 void ParticleGraphEmitter::Reset()
@@ -197,10 +209,7 @@ void ParticleGraphEmitter::OnSceneSet(Scene* scene)
 {
     Component::OnSceneSet(scene);
 
-    if (scene && IsEnabledEffective())
-        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(ParticleGraphEmitter, HandleScenePostUpdate));
-    else if (!scene)
-        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+    UpdateManager();
 
     for (unsigned i = 0; i < layers_.size(); ++i)
     {
@@ -219,6 +228,12 @@ bool ParticleGraphEmitter::EmitNewParticle(unsigned layer)
 }
 
 void ParticleGraphEmitter::Tick(float timeStep)
+{
+    Simulate(timeStep);
+    CommitDrawables();
+}
+
+void ParticleGraphEmitter::Simulate(float timeStep)
 {
     for (unsigned i = 0; i < layers_.size(); ++i)
     {
@@ -226,6 +241,34 @@ void ParticleGraphEmitter::Tick(float timeStep)
     }
 }
 
+void ParticleGraphEmitter::CommitDrawables()
+{
+    for (auto& layer : layers_)
+    {
+        layer.CommitDrawables();
+    }
+}
+
+bool ParticleGraphEmitter::IsThreadSafe() const
+{
+    for (const auto& layer : layers_)
+    {
+        if (!layer.IsThreadSafe())
+            return false;
+    }
+    return true;
+}
+
+bool ParticleGraphEmitter::IsInView() const
+{
+    for (const auto& layer : layers_)
+    {
+        if (layer.IsInView())
+            return true;
+    }
+    return layers_.empty();
+}
+
 const ParticleGraphLayerInstance* ParticleGraphEmitter::GetLayer(unsigned layer) const
 {
     if (layer >= layers_.size())
@@ -251,47 +294,6 @@ bool ParticleGraphEmitter::CheckActiveParticles() const
     return false;
 }
 
-void ParticleGraphEmitter::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
-{
-    // Store scene's timestep and use it instead of global timestep, as time scale may be other than 1
-    using namespace ScenePostUpdate;
-
-    lastTimeStep_ = eventData[P_TIMESTEP].GetFloat();
-
-
-    Tick(lastTimeStep_);
-
-    //// If no invisible update, check that the billboardset is in view (framenumber has changed)
-    //if ((effect_ && effect_->GetUpdateInvisible()) || viewFrameNumber_ != lastUpdateFrameNumber_)
-    //{
-    //    lastUpdateFrameNumber_ = viewFrameNumber_;
-    //    needUpdate_ = true;
-    //    MarkForUpdate();
-    //}
-
-    //// Send finished event only once all particles are gone
-    //if (node_ && !emitting_ && sendFinishedEvent_ && !CheckActiveParticles())
-    //{
-    //    sendFinishedEvent_ = false;
-
-    //    // Make a weak pointer to self to check for destruction during event handling
-    //    WeakPtr<ParticleGraphEmitter> self(this);
-
-    //    using namespace ParticleEffectFinished;
-
-    //    VariantMap& eventData = GetEventDataMap();
-    //    eventData[P_NODE] = node_;
-    //    eventData[P_EFFECT] = effect_;
-
-    //    node_->SendEvent(E_PARTICLEEFFECTFINISHED, eventData);
-
-    //    if (self.Expired())
-    //        return;
-
-    //    DoAutoRemove(autoRemove_);
-    //}
-}
-
 void ParticleGraphEmitter::HandleEffectReloadFinished(StringHash eventType, VariantMap& eventData)
 {
     // When particle effect file is live-edited, remove existing particles and reapply the effect parameters
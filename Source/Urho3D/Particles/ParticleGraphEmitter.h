@@ -31,6 +31,7 @@
 namespace Urho3D
 {
 
+class ParticleGraphEmitterManager;
 class ParticleGraphLayerInstance;
 class ParticleGraphNodeInstance;
 
@@ -100,6 +101,15 @@ public:
 
     /// Manually update emitter.
     void Tick(float timeStep);
+    /// Update particles of all layers without applying them to drawables.
+    /// May be called from a worker thread if the emitter is thread-safe.
+    void Simulate(float timeStep);
+    /// Apply results of the last simulation to drawables. Should be called from the main thread.
+    void CommitDrawables();
+    /// Return whether the emitter may be simulated from a worker thread concurrently with other emitters.
+    bool IsThreadSafe() const;
+    /// Return whether the emitter was rendered in the last frame. Emitter without drawables is always in view.
+    bool IsInView() const;
 
     /// Get layer by index.
     const ParticleGraphLayerInstance* GetLayer(unsigned layer) const;
@@ -115,8 +125,8 @@ protected:
     void OnSceneSet(Scene* scene) override;
 
 private:
-    /// Handle scene post-update event.
-    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+    /// Add emitter to scene emitter manager or remove from it.
+    void UpdateManager();
     /// Handle live reload of the particle effect.
     void HandleEffectReloadFinished(StringHash eventType, VariantMap& eventData);
     /// Update all drawable attributes.
@@ -136,8 +146,8 @@ private:
     /// Zone mask.
     unsigned zoneMask_{DEFAULT_ZONEMASK};
 
-    /// Last scene timestep.
-    float lastTimeStep_{};
+    /// Manager that updates the emitter.
+    WeakPtr<ParticleGraphEmitterManager> manager_;
 
     /// Currently emitting flag.
     bool emitting_{true};
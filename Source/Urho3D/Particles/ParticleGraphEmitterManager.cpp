@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "ParticleGraphEmitterManager.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
+#include "../Graphics/Octree.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
+#include "ParticleGraphEmitter.h"
+
+#include <EASTL/algorithm.h>
+
+namespace Urho3D
+{
+
+ParticleGraphEmitterManager::ParticleGraphEmitterManager(Context* context)
+    : Component(context)
+{
+    // Manager is recreated by emitters on load
+    SetTemporary(true);
+}
+
+ParticleGraphEmitterManager::~ParticleGraphEmitterManager() = default;
+
+void ParticleGraphEmitterManager::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<ParticleGraphEmitterManager>(Category_Subsystem);
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Parallel Update", GetParallelUpdate, SetParallelUpdate, bool, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE(
+        "Culled Update Interval", GetCulledUpdateInterval, SetCulledUpdateInterval, unsigned, 1, AM_DEFAULT);
+}
+
+void ParticleGraphEmitterManager::AddEmitter(ParticleGraphEmitter* emitter)
+{
+    emitters_.push_back(EmitterState{emitter});
+}
+
+void ParticleGraphEmitterManager::RemoveEmitter(ParticleGraphEmitter* emitter)
+{
+    const auto iter = ea::find_if(emitters_.begin(), emitters_.end(),
+        [emitter](const EmitterState& state) { return state.emitter_ == emitter; });
+    if (iter != emitters_.end())
+    {
+        *iter = emitters_.back();
+        emitters_.pop_back();
+    }
+}
+
+void ParticleGraphEmitterManager::Update(float timeStep)
+{
+    URHO3D_PROFILE("UpdateParticleGraphEmitters");
+
+    // Particles are only visual, don't simulate them if nobody renders them
+    auto octree = GetScene()->GetComponent<Octree>();
+    if (octree && octree->IsLeanUpdate())
+        return;
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    const bool parallelUpdate = parallelUpdate_ && workQueue;
+
+    parallelUpdates_.clear();
+    serialUpdates_.clear();
+    for (EmitterState& state : emitters_)
+    {
+        ParticleGraphEmitter* emitter = state.emitter_;
+        state.pendingTimeStep_ += timeStep;
+        if (culledUpdateInterval_ > 1 && !emitter->IsInView() && ++state.numSkippedFrames_ < culledUpdateInterval_)
+            continue;
+
+        // World transforms are evaluated lazily, make sure they are not evaluated from worker threads
+        emitter->GetNode()->GetWorldTransform();
+
+        const EmitterUpdate update{emitter, state.pendingTimeStep_};
+        if (parallelUpdate && emitter->IsThreadSafe())
+            parallelUpdates_.push_back(update);
+        else
+            serialUpdates_.push_back(update);
+
+        state.pendingTimeStep_ = 0.0f;
+        state.numSkippedFrames_ = 0;
+    }
+
+    if (!parallelUpdates_.empty())
+    {
+        ForEachParallel(workQueue, ParallelUpdateBucketSize, parallelUpdates_,
+            [](unsigned /*index*/, const EmitterUpdate& update) { update.emitter_->Simulate(update.timeStep_); });
+    }
+    for (const EmitterUpdate& update : serialUpdates_)
+        update.emitter_->Simulate(update.timeStep_);
+
+    // Drawables are committed in the same order as emitters were added
+    for (const EmitterUpdate& update : parallelUpdates_)
+        update.emitter_->CommitDrawables();
+    for (const EmitterUpdate& update : serialUpdates_)
+        update.emitter_->CommitDrawables();
+}
+
+void ParticleGraphEmitterManager::OnSceneSet(Scene* scene)
+{
+    if (scene)
+        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, &ParticleGraphEmitterManager::HandleScenePostUpdate);
+    else
+        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+}
+
+void ParticleGraphEmitterManager::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+{
+    using namespace ScenePostUpdate;
+
+    // Use scene's timestep instead of global timestep, as time scale may be other than 1
+    Update(eventData[P_TIMESTEP].GetFloat());
+}
+
+}
@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Scene/Component.h"
+
+namespace Urho3D
+{
+
+class ParticleGraphEmitter;
+
+/// Updates all particle graph emitters of the scene on scene post-update.
+/// Emitters are simulated in parallel on WorkQueue threads, then their drawables are committed from the main thread.
+/// Emitters that are not in view may be simulated at reduced rate with accumulated time step.
+/// Emitters are not simulated at all if Octree is in lean update mode.
+/// Created automatically by emitters.
+class URHO3D_API ParticleGraphEmitterManager : public Component
+{
+    URHO3D_OBJECT(ParticleGraphEmitterManager, Component);
+
+public:
+    /// Number of emitters simulated by thread at once.
+    static constexpr unsigned ParallelUpdateBucketSize = 4;
+
+    /// Construct.
+    explicit ParticleGraphEmitterManager(Context* context);
+    /// Destruct.
+    ~ParticleGraphEmitterManager() override;
+    /// Register object factory.
+    static void RegisterObject(Context* context);
+
+    /// Set whether to simulate emitters in parallel.
+    void SetParallelUpdate(bool enable) { parallelUpdate_ = enable; }
+    /// Return whether to simulate emitters in parallel.
+    bool GetParallelUpdate() const { return parallelUpdate_; }
+    /// Set number of frames between updates of emitters that are not in view. 1 means every frame.
+    void SetCulledUpdateInterval(unsigned interval) { culledUpdateInterval_ = ea::max(interval, 1u); }
+    /// Return number of frames between updates of emitters that are not in view.
+    unsigned GetCulledUpdateInterval() const { return culledUpdateInterval_; }
+
+    /// Update all emitters. Called automatically on scene post-update.
+    void Update(float timeStep);
+
+    /// Return number of managed emitters.
+    unsigned GetNumEmitters() const { return emitters_.size(); }
+
+    /// Internal. Manage emitters.
+    /// @{
+    void AddEmitter(ParticleGraphEmitter* emitter);
+    void RemoveEmitter(ParticleGraphEmitter* emitter);
+    /// @}
+
+protected:
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+
+private:
+    struct EmitterState
+    {
+        ParticleGraphEmitter* emitter_{};
+        /// Time step accumulated while the emitter was skipped.
+        float pendingTimeStep_{};
+        /// Number of frames the emitter was skipped.
+        unsigned numSkippedFrames_{};
+    };
+
+    struct EmitterUpdate
+    {
+        ParticleGraphEmitter* emitter_{};
+        float timeStep_{};
+    };
+
+    /// Handle scene post-update event.
+    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+
+    bool parallelUpdate_{true};
+    unsigned culledUpdateInterval_{1};
+
+    ea::vector<EmitterState> emitters_;
+    /// Updates of current frame.
+    ea::vector<EmitterUpdate> parallelUpdates_;
+    ea::vector<EmitterUpdate> serialUpdates_;
+};
+
+}
@@ -202,6 +202,7 @@ void ParticleGraphLayer::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("TimeScale", GetTimeScale, SetTimeScale, float, DefaultTimeScale, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Duration", GetDuration, SetDuration, float, DefaultDuration, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Loop", IsLoop, SetLoop, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Compute Simulation", IsComputeSimulation, SetComputeSimulation, bool, false, AM_DEFAULT);
 }
 
 /// Construct ParticleGraphLayer.
@@ -336,6 +337,7 @@ void ParticleGraphLayer::SerializeInBlock(Archive& archive)
     SerializeOptionalValue(archive, "duration", duration_, DefaultDuration);
     SerializeOptionalValue(archive, "timeScale", timeScale_, DefaultTimeScale);
     SerializeOptionalValue(archive, "loop", loop_);
+    SerializeOptionalValue(archive, "computeSimulation", computeSimulation_);
 
     SerializeOptionalValue(archive, "emit", emit_, EmptyObject{},
         [&](Archive& archive, const char* name, auto& value) { SerializeValue(archive, name, *value); });
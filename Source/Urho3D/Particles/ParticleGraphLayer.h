@@ -101,6 +101,13 @@ public:
     /// Set effect duration in seconds.
     void SetDuration(float duration);
 
+    /// Return whether the layer should be simulated on GPU if possible.
+    bool IsComputeSimulation() const { return computeSimulation_; }
+
+    /// Set whether the layer should be simulated on GPU if possible.
+    /// Layer is still simulated on CPU if compute shaders are not supported or graph nodes cannot be translated.
+    void SetComputeSimulation(bool enable) { computeSimulation_ = enable; }
+
     /// Get emit graph.
     ParticleGraph& GetEmitGraph();
 
@@ -144,6 +151,8 @@ private:
     float duration_{DefaultDuration};
     /// Loop effect.
     bool loop_{};
+    /// Simulate on GPU if possible.
+    bool computeSimulation_{};
     /// Emission graph.
     SharedPtr<ParticleGraph> emit_;
     /// Initialization graph.
@@ -28,6 +28,9 @@
 #include "ParticleGraphNodeInstance.h"
 #include "Span.h"
 #include "UpdateContext.h"
+#include "../Graphics/Drawable.h"
+
+#include <EASTL/algorithm.h>
 
 namespace Urho3D
 {
@@ -76,6 +79,11 @@ void ParticleGraphLayerInstance::Apply(const SharedPtr<ParticleGraphLayer>& laye
     updateNodeInstances_ = layout.updateNodePointers_.MakeSpan<ParticleGraphNodeInstance*>(attributes_);
     nodeInstances = InitNodeInstances(nodeInstances, updateNodeInstances_, layer_->GetUpdateGraph());
 
+    // Compile graphs once pins are resolved
+    emitSteps_ = CompileGraph(emitNodeInstances_);
+    initSteps_ = CompileGraph(initNodeInstances_);
+    updateSteps_ = CompileGraph(updateNodeInstances_);
+
     // Initialize indices
     indices_ = layout.indices_.MakeSpan<unsigned>(attributes_);
     scalarIndices_ = layout.scalarIndices_.MakeSpan<unsigned>(attributes_);
@@ -86,12 +94,28 @@ void ParticleGraphLayerInstance::Apply(const SharedPtr<ParticleGraphLayer>& laye
         scalarIndices_[i] = 0;
         naturalIndices_[i] = i;
     }
+    sequentialIndices_ = true;
     destructionQueue_ = layout.destructionQueue_.MakeSpan<unsigned>(attributes_);
+
+    computeSimulator_ = nullptr;
+    if (layer_->IsComputeSimulation() && ParticleGraphComputeSimulator::IsSupported(layer_->GetContext()))
+    {
+        auto simulator = MakeShared<ParticleGraphComputeSimulator>(layer_->GetContext());
+        if (simulator->Initialize(layer_))
+            computeSimulator_ = simulator;
+    }
     Reset();
 }
 
 /// Remove all current particles.
-void ParticleGraphLayerInstance::RemoveAllParticles() { activeParticles_ = 0; }
+void ParticleGraphLayerInstance::RemoveAllParticles()
+{
+    activeParticles_ = 0;
+    ResetIndices();
+    numComputeEmitted_ = 0;
+    if (computeSimulator_)
+        computeSimulator_->RemoveAllParticles();
+}
 
 bool ParticleGraphLayerInstance::EmitNewParticles(float numParticles)
 {
@@ -103,6 +127,13 @@ bool ParticleGraphLayerInstance::EmitNewParticles(float numParticles)
     unsigned particlesToEmit = static_cast<unsigned>(emitCounterReminder_);
     emitCounterReminder_ -= static_cast<float>(particlesToEmit);
 
+    // Initialization graph is evaluated by the emit kernel
+    if (computeSimulator_)
+    {
+        numComputeEmitted_ = Urho3D::Min(numComputeEmitted_ + particlesToEmit, indices_.size());
+        return true;
+    }
+
     particlesToEmit = Urho3D::Min(particlesToEmit, indices_.size() - activeParticles_);
     if (!particlesToEmit)
         return false;
@@ -112,7 +143,7 @@ bool ParticleGraphLayerInstance::EmitNewParticles(float numParticles)
 
     auto autoContext = MakeUpdateContext(0.0f);
     autoContext.indices_ = autoContext.indices_.subspan(startIndex, particlesToEmit);
-    RunGraph(initNodeInstances_, autoContext);
+    RunGraph(initNodeInstances_, initSteps_, autoContext);
 
     return true;
 }
@@ -126,11 +157,19 @@ void ParticleGraphLayerInstance::Update(float timeStep, bool emitting)
     if (emitting)
     {
         emitContext.indices_ = indices_.subspan(0, 1);
-        RunGraph(emitNodeInstances_, emitContext);
+        RunGraph(emitNodeInstances_, emitSteps_, emitContext);
+    }
+
+    if (computeSimulator_)
+    {
+        computeSimulator_->Simulate(timeStep, numComputeEmitted_);
+        numComputeEmitted_ = 0;
+        time_ += timeStep;
+        return;
     }
 
     auto updateContext = MakeUpdateContext(timeStep);
-    RunGraph(updateNodeInstances_, updateContext);
+    RunGraph(updateNodeInstances_, updateSteps_, updateContext);
     DestroyParticles();
     time_ += timeStep;
 }
@@ -177,9 +216,22 @@ void ParticleGraphLayerInstance::Reset()
     for (ParticleGraphNodeInstance* node : updateNodeInstances_)
         node->Reset();
     activeParticles_ = 0;
+    ResetIndices();
+    numComputeEmitted_ = 0;
+    if (computeSimulator_)
+        computeSimulator_->RemoveAllParticles();
     time_ = 0.0f;
 }
 
+void ParticleGraphLayerInstance::ResetIndices()
+{
+    if (sequentialIndices_)
+        return;
+    for (unsigned i = 0; i < indices_.size(); ++i)
+        indices_[i] = i;
+    sequentialIndices_ = true;
+}
+
 void ParticleGraphLayerInstance::UpdateDrawables()
 {
     for (ParticleGraphNodeInstance* node : initNodeInstances_)
@@ -196,6 +248,46 @@ void ParticleGraphLayerInstance::UpdateDrawables()
     }
 }
 
+void ParticleGraphLayerInstance::CommitDrawables()
+{
+    for (ParticleGraphNodeInstance* node : emitNodeInstances_)
+        node->CommitDrawables();
+    for (ParticleGraphNodeInstance* node : initNodeInstances_)
+        node->CommitDrawables();
+    for (ParticleGraphNodeInstance* node : updateNodeInstances_)
+        node->CommitDrawables();
+}
+
+bool ParticleGraphLayerInstance::IsThreadSafe() const
+{
+    // GPU commands are recorded from the main thread
+    if (computeSimulator_)
+        return false;
+
+    const auto isThreadSafe = [](const ParticleGraphNodeInstance* node) { return node->IsThreadSafe(); };
+    return ea::all_of(emitNodeInstances_.begin(), emitNodeInstances_.end(), isThreadSafe)
+        && ea::all_of(initNodeInstances_.begin(), initNodeInstances_.end(), isThreadSafe)
+        && ea::all_of(updateNodeInstances_.begin(), updateNodeInstances_.end(), isThreadSafe);
+}
+
+bool ParticleGraphLayerInstance::IsInView() const
+{
+    bool hasDrawables = false;
+    for (const auto& nodes : {emitNodeInstances_, initNodeInstances_, updateNodeInstances_})
+    {
+        for (const ParticleGraphNodeInstance* node : nodes)
+        {
+            if (Drawable* drawable = node->GetDrawable())
+            {
+                if (drawable->IsInView())
+                    return true;
+                hasDrawables = true;
+            }
+        }
+    }
+    return !hasDrawables;
+}
+
 void ParticleGraphLayerInstance::SetEmitter(ParticleGraphEmitter* emitter)
 {
     emitter_ = emitter;
@@ -232,12 +324,54 @@ UpdateContext ParticleGraphLayerInstance::MakeUpdateContext(float timeStep)
     return context;
 }
 
-void ParticleGraphLayerInstance::RunGraph(ea::span<ParticleGraphNodeInstance*>& nodes, UpdateContext& updateContext)
+void ParticleGraphLayerInstance::RunGraph(ea::span<ParticleGraphNodeInstance*>& nodes,
+    const ea::vector<GraphStep>& steps, UpdateContext& updateContext)
 {
-    for (ParticleGraphNodeInstance* node : nodes)
+    const unsigned numParticles = updateContext.indices_.size();
+    for (const GraphStep& step : steps)
+    {
+        const auto stepNodes = nodes.subspan(step.firstNode_, step.numNodes_);
+        if (!step.fused_ || numParticles <= FusedBlockSize)
+        {
+            for (ParticleGraphNodeInstance* node : stepNodes)
+                node->Update(updateContext);
+            continue;
+        }
+
+        // Run all fused nodes for each block so intermediate values stay in cache
+        UpdateContext blockContext = updateContext;
+        for (unsigned offset = 0; offset < numParticles; offset += FusedBlockSize)
+        {
+            blockContext.indices_ = updateContext.indices_.subspan(offset, ea::min(FusedBlockSize, numParticles - offset));
+            blockContext.spanOffset_ = updateContext.spanOffset_ + offset;
+            for (ParticleGraphNodeInstance* node : stepNodes)
+                node->Update(blockContext);
+        }
+    }
+}
+
+ea::vector<ParticleGraphLayerInstance::GraphStep> ParticleGraphLayerInstance::CompileGraph(
+    const ea::span<ParticleGraphNodeInstance*>& nodes)
+{
+    ea::vector<GraphStep> steps;
+    for (unsigned i = 0; i < nodes.size(); ++i)
+    {
+        const bool isElementwise = nodes[i]->IsElementwise();
+        if (isElementwise && !steps.empty() && steps.back().fused_)
+        {
+            ++steps.back().numNodes_;
+            continue;
+        }
+        steps.push_back(GraphStep{i, 1, isElementwise});
+    }
+
+    // Blocks are useless for a single node
+    for (GraphStep& step : steps)
     {
-        node->Update(updateContext);
+        if (step.numNodes_ == 1)
+            step.fused_ = false;
     }
+    return steps;
 }
 
 ea::span<uint8_t> ParticleGraphLayerInstance::InitNodeInstances(ea::span<uint8_t> nodeInstanceBuffer,
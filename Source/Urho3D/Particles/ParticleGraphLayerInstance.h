@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "ParticleGraphComputeSimulator.h"
 #include "ParticleGraphLayer.h"
 #include "ParticleGraphNodeInstance.h"
 #include <EASTL/sort.h>
@@ -62,6 +63,9 @@ private:
 class URHO3D_API ParticleGraphLayerInstance
 {
 public:
+    /// Number of particles processed at once by fused runs of elementwise nodes.
+    static constexpr unsigned FusedBlockSize = 256;
+
     /// Construct.
     ParticleGraphLayerInstance();
 
@@ -71,9 +75,12 @@ public:
     /// Apply layer settings to the layer instance
     void Apply(const SharedPtr<ParticleGraphLayer>& layer);
 
-    /// Return number of active particles.
+    /// Return number of active particles. Particles simulated on GPU are not counted.
     unsigned GetNumActiveParticles() const { return activeParticles_; }
 
+    /// Return GPU simulator if the layer is simulated on GPU.
+    ParticleGraphComputeSimulator* GetComputeSimulator() const { return computeSimulator_; }
+
     /// Remove all current particles.
     void RemoveAllParticles();
 
@@ -93,7 +100,7 @@ public:
     template <typename ValueType>
     SparseSpan<ValueType> GetSparse(unsigned attributeIndex, const ea::span<unsigned>& indices);
     template <typename ValueType> SparseSpan<ValueType> GetScalar(unsigned pinIndex);
-    template <typename ValueType> SparseSpan<ValueType> GetSpan(unsigned pinIndex);
+    template <typename ValueType> SparseSpan<ValueType> GetSpan(unsigned pinIndex, unsigned offset = 0);
 
     /// Get emitter.
     ParticleGraphEmitter* GetEmitter() const { return emitter_; }
@@ -114,10 +121,30 @@ public:
     /// Update all drawable attributes. Executed by ParticleGraphEmitter.
     void UpdateDrawables();
 
+    /// Apply results of the last update to drawables. Executed by ParticleGraphEmitter from the main thread.
+    void CommitDrawables();
+
+    /// Return whether the layer may be updated from a worker thread.
+    bool IsThreadSafe() const;
+
+    /// Return whether any drawable of the layer was rendered in the last frame. Layer without drawables is always in view.
+    bool IsInView() const;
+
     /// Get effect layer.
     ParticleGraphLayer* GetLayer() const { return layer_; }
 
 protected:
+    /// Step of compiled graph: a single node or a fused run of elementwise nodes.
+    struct GraphStep
+    {
+        /// Index of the first node.
+        unsigned firstNode_{};
+        /// Number of nodes.
+        unsigned numNodes_{};
+        /// Whether the nodes are elementwise and may be updated together in blocks of particles.
+        bool fused_{};
+    };
+
     /// Handle scene change in instance.
     void OnSceneSet(Scene* scene);
 
@@ -128,11 +155,17 @@ protected:
     UpdateContext MakeUpdateContext(float timeStep);
 
     /// Run graph.
-    void RunGraph(ea::span<ParticleGraphNodeInstance*>& nodes, UpdateContext& updateContext);
+    void RunGraph(ea::span<ParticleGraphNodeInstance*>& nodes, const ea::vector<GraphStep>& steps,
+        UpdateContext& updateContext);
+    /// Compile instantiated graph nodes into steps.
+    static ea::vector<GraphStep> CompileGraph(const ea::span<ParticleGraphNodeInstance*>& nodes);
 
     /// Destroy particles.
     void DestroyParticles();
 
+    /// Reset particle indices to natural order. Should be called only when there are no active particles.
+    void ResetIndices();
+
     ea::span<uint8_t> InitNodeInstances(ea::span<uint8_t> nodeInstanceBuffer,
         ea::span<ParticleGraphNodeInstance*>& nodeInstances, const ParticleGraph& particle_graph);
 
@@ -150,6 +183,12 @@ private:
     ea::span<ParticleGraphNodeInstance*> initNodeInstances_;
     /// Node instances for update graph
     ea::span<ParticleGraphNodeInstance*> updateNodeInstances_;
+    /// Compiled emit graph.
+    ea::vector<GraphStep> emitSteps_;
+    /// Compiled initialization graph.
+    ea::vector<GraphStep> initSteps_;
+    /// Compiled update graph.
+    ea::vector<GraphStep> updateSteps_;
     /// All indices of the particle system.
     ea::span<unsigned> indices_;
     /// All indices set to 0.
@@ -162,8 +201,14 @@ private:
     unsigned destructionQueueSize_;
     /// Number of active particles.
     unsigned activeParticles_;
+    /// Whether indices go in natural order so attributes of active particles are contiguous.
+    bool sequentialIndices_{true};
     /// Reference to layer.
     SharedPtr<ParticleGraphLayer> layer_;
+    /// GPU simulator used instead of update graph.
+    SharedPtr<ParticleGraphComputeSimulator> computeSimulator_;
+    /// Number of particles to emit on GPU on next update.
+    unsigned numComputeEmitted_{};
     /// Emitter that owns the layer instance.
     ParticleGraphEmitter* emitter_{};
     /// Time since emitter start.
@@ -181,10 +226,17 @@ inline void ParticleGraphLayerInstance::DestroyParticles()
     //TODO: Eliminate duplicates.
     for (unsigned index: queue)
     {
-        ea::swap(indices_[index], indices_[activeParticles_ - 1]);
+        // Removing the last particle keeps the order of the rest
+        if (index != activeParticles_ - 1)
+        {
+            ea::swap(indices_[index], indices_[activeParticles_ - 1]);
+            sequentialIndices_ = false;
+        }
         --activeParticles_;
     }
     destructionQueueSize_ = 0;
+    if (activeParticles_ == 0)
+        ResetIndices();
 }
 
 /// Get attribute values.
@@ -199,6 +251,9 @@ template <typename ValueType> SparseSpan<ValueType> ParticleGraphLayerInstance::
 {
     const auto& attr = layer_->GetAttributeLayout().GetSpan(attributeIndex);
     const auto values = attr.MakeSpan<ValueType>(attributes_);
+    // Subrange of sequential indices addresses contiguous subrange of attribute values
+    if (sequentialIndices_ && !indices.empty())
+        return SparseSpan<ValueType>(values.data() + indices[0], naturalIndices_.data(), ParticleGraphContainerType::Span);
     return SparseSpan<ValueType>(values, indices);
 }
 
@@ -206,14 +261,14 @@ template <typename ValueType> SparseSpan<ValueType> ParticleGraphLayerInstance::
 {
     const auto& attr = layer_->GetIntermediateValues()[pinIndex];
     const auto values = attr.MakeSpan<ValueType>(temp_);
-    return SparseSpan<ValueType>(values, scalarIndices_);
+    return SparseSpan<ValueType>(values, scalarIndices_, ParticleGraphContainerType::Scalar);
 }
 
-template <typename ValueType> SparseSpan<ValueType> ParticleGraphLayerInstance::GetSpan(unsigned pinIndex)
+template <typename ValueType> SparseSpan<ValueType> ParticleGraphLayerInstance::GetSpan(unsigned pinIndex, unsigned offset)
 {
     const auto& attr = layer_->GetIntermediateValues()[pinIndex];
     const auto values = attr.MakeSpan<ValueType>(temp_);
-    return SparseSpan<ValueType>(values, naturalIndices_);
+    return SparseSpan<ValueType>(values.data() + offset, naturalIndices_.data(), ParticleGraphContainerType::Span);
 }
 
 } // namespace Urho3D
@@ -28,6 +28,16 @@
 namespace Urho3D
 {
 
+namespace
+{
+
+unsigned AlignSpanOffset(unsigned offset)
+{
+    return (offset + ParticleGraphSpanAlignment - 1) / ParticleGraphSpanAlignment * ParticleGraphSpanAlignment;
+}
+
+}
+
 /// Construct ParticleGraphSpan.
 ParticleGraphSpan::ParticleGraphSpan()
     : offset_(0)
@@ -64,6 +74,7 @@ unsigned ParticleGraphAttributeLayout::GetOrAddAttribute(const ea::string& name,
 
     unsigned i = attributes_.size();
     unsigned size = GetVariantTypeSize(type) * capacity_;
+    position_ = AlignSpanOffset(position_);
     attributes_.push_back(AttrSpan{name, nameHash, type, ParticleGraphSpan(position_, size)});
     position_ += size;
     return i;
@@ -80,6 +91,7 @@ unsigned ParticleGraphBufferLayout::Allocate(ParticleGraphContainerType containe
     assert(container != ParticleGraphContainerType::Auto);
     unsigned index = spans_.size();
     unsigned size = ((container == ParticleGraphContainerType::Scalar) ? 1 : capacity_) * GetVariantTypeSize(type);
+    position_ = AlignSpanOffset(position_);
     spans_.push_back(PinSpan{container, type, ParticleGraphSpan(position_, size)});
     position_ += size;
     return index;
@@ -27,6 +27,9 @@
 
 namespace Urho3D
 {
+/// Alignment of attribute and intermediate value arrays in bytes, suitable for SIMD loads.
+static constexpr unsigned ParticleGraphSpanAlignment = 16;
+
 /// Memory layout definition.
 struct ParticleGraphSpan
 {
@@ -50,4 +50,6 @@ void ParticleGraphNodeInstance::OnSceneSet(Scene* scene) {}
 /// Handle drawable attribute change.
 void ParticleGraphNodeInstance::UpdateDrawableAttributes() {}
 
+void ParticleGraphNodeInstance::CommitDrawables() {}
+
 } // namespace Urho3D
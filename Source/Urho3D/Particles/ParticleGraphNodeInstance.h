@@ -40,6 +40,15 @@ public:
     virtual void OnSceneSet(Scene* scene);
     /// Handle drawable attribute change.
     virtual void UpdateDrawableAttributes();
+    /// Apply results of the last update to drawables and scene nodes. Called from the main thread after the update.
+    virtual void CommitDrawables();
+    /// Return drawable rendered by the instance, if any.
+    virtual Drawable* GetDrawable() const { return nullptr; }
+    /// Return whether the instance may be updated from a worker thread concurrently with other emitters.
+    virtual bool IsThreadSafe() const { return true; }
+    /// Return whether each particle is updated independently from other particles and from the number of particles,
+    /// so the update may be split into ranges of particles.
+    virtual bool IsElementwise() const { return false; }
 
     virtual void Reset();
 protected:
@@ -25,6 +25,7 @@
 #include "ParticleGraphSystem.h"
 
 #include "ParticleGraphEmitter.h"
+#include "ParticleGraphEmitterManager.h"
 #include "ParticleGraphLayer.h"
 
 namespace Urho3D
@@ -52,6 +53,7 @@ void RegisterParticleGraphLibrary(Context* context, ParticleGraphSystem* system)
     ParticleGraphEffect::RegisterObject(context);
     ParticleGraphLayer::RegisterObject(context);
     ParticleGraphEmitter::RegisterObject(context);
+    ParticleGraphEmitterManager::RegisterObject(context);
 
     ParticleGraphNodes::RegisterGraphNodes(system);
 }
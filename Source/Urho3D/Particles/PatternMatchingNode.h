@@ -81,10 +81,16 @@ public:
         explicit Instance(PatternMatchingNode* node, const NodePattern& pattern);
 
         /// Update particles.
-        virtual void Update(UpdateContext& context);
+        void Update(UpdateContext& context) override;
+        /// Return whether the node is elementwise. Nodes with only scalar pins are not.
+        bool IsElementwise() const override { return !allScalar_; }
 
         PatternMatchingNode* node_;
         const NodePattern& pattern_;
+        /// Memory references of the pins, resolved on creation.
+        ea::fixed_vector<ParticleGraphPinRef, NodePattern::ExpectedNumberOfPins> pinRefs_;
+        /// Whether all pins are scalar.
+        bool allScalar_{true};
     };
 
     /// Construct.
@@ -111,9 +117,6 @@ protected:
     /// Evaluate runtime output pin type.
     VariantType EvaluateOutputPinType(ParticleGraphPin& pin) override;
 
-    /// Update particles.
-    void Update(UpdateContext& context, const NodePattern& pattern);
-
 protected:
     const ea::vector<NodePattern>& patterns_;
     ea::fixed_vector<ParticleGraphPin, NodePattern::ExpectedNumberOfPins> pins_;
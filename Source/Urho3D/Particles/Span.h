@@ -24,6 +24,10 @@
 
 #include <EASTL/span.h>
 
+#ifdef URHO3D_SSE
+#include <xmmintrin.h>
+#endif
+
 namespace Urho3D
 {
 
@@ -44,21 +48,62 @@ template <typename T> struct SparseSpan
     typedef ea::remove_cv_t<T> value_type;
 
     SparseSpan() = default;
-    SparseSpan(const ea::span<T>& data, const ea::span<unsigned>& indices)
+    SparseSpan(const ea::span<T>& data, const ea::span<unsigned>& indices,
+        ParticleGraphContainerType type = ParticleGraphContainerType::Sparse)
         : data_(data.data())
         , indices_(indices.data())
+        , type_(type)
     {
     }
-    SparseSpan(T* data, unsigned* indices)
+    SparseSpan(T* data, unsigned* indices, ParticleGraphContainerType type = ParticleGraphContainerType::Sparse)
         : data_(data)
         , indices_(indices)
+        , type_(type)
     {
     }
     inline T& operator[](unsigned index) const { return data_[indices_[index]]; }
-    T* data_;
-    unsigned* indices_;
+    /// Return whether element i is stored at data_[i].
+    bool IsContiguous() const { return type_ == ParticleGraphContainerType::Span; }
+    /// Return whether all elements are stored at data_[0].
+    bool IsScalar() const { return type_ == ParticleGraphContainerType::Scalar; }
+
+    T* data_{};
+    unsigned* indices_{};
+    /// Memory layout of the values: Span if contiguous, Scalar if single value, Sparse otherwise.
+    ParticleGraphContainerType type_{ParticleGraphContainerType::Sparse};
 };
 
+/// Return whether all spans are contiguous and may be processed as plain arrays.
+template <typename... Spans> bool AreContiguous(const Spans&... spans)
+{
+    return (spans.IsContiguous() && ...);
+}
+
+/// Add arrays of floats: out[i] = x[i] + y[i]. Output may alias input.
+inline void AddFloats(const float* x, const float* y, float* out, unsigned count)
+{
+    unsigned i = 0;
+#ifdef URHO3D_SSE
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i)));
+#endif
+    for (; i < count; ++i)
+        out[i] = x[i] + y[i];
+}
+
+/// Multiply and add arrays of floats: out[i] = x[i] + y[i] * scale. Output may alias input.
+inline void MultiplyAddFloats(const float* x, const float* y, float scale, float* out, unsigned count)
+{
+    unsigned i = 0;
+#ifdef URHO3D_SSE
+    const __m128 scaleVec = _mm_set1_ps(scale);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(y + i), scaleVec)));
+#endif
+    for (; i < count; ++i)
+        out[i] = x[i] + y[i] * scale;
+}
+
 template <typename... Values> struct SpanVariantTuple;
 
 
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Physics/CollisionGeometryCache.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+void RemoveModelGeometry(CollisionGeometryDataCache& cache, Model* model)
+{
+    for (auto i = cache.begin(); i != cache.end();)
+    {
+        auto current = i++;
+        if (current->first.first == model)
+            cache.erase(current);
+    }
+}
+
+void RemoveUnusedGeometry(CollisionGeometryDataCache& cache)
+{
+    for (auto i = cache.begin(); i != cache.end();)
+    {
+        auto current = i++;
+        if (current->second.Refs() == 1)
+            cache.erase(current);
+    }
+}
+
+}
+
+CollisionGeometryCache::CollisionGeometryCache(Context* context)
+    : Object(context)
+{
+}
+
+CollisionGeometryCache::~CollisionGeometryCache() = default;
+
+SharedPtr<CollisionGeometryData> CollisionGeometryCache::GetGeometry(
+    ShapeType shapeType, Model* model, unsigned lodLevel) const
+{
+    MutexLock lock(mutex_);
+
+    const CollisionGeometryDataCache* cache = GetCache(shapeType);
+    if (!cache)
+        return nullptr;
+
+    const auto iter = cache->find(ea::make_pair(model, lodLevel));
+    return iter != cache->end() ? iter->second : nullptr;
+}
+
+void CollisionGeometryCache::StoreGeometry(
+    ShapeType shapeType, Model* model, unsigned lodLevel, CollisionGeometryData* geometry)
+{
+    MutexLock lock(mutex_);
+
+    if (CollisionGeometryDataCache* cache = GetCache(shapeType))
+        (*cache)[ea::make_pair(model, lodLevel)] = geometry;
+}
+
+void CollisionGeometryCache::RemoveGeometry(Model* model)
+{
+    MutexLock lock(mutex_);
+
+    RemoveModelGeometry(triMeshCache_, model);
+    RemoveModelGeometry(convexCache_, model);
+    RemoveModelGeometry(gimpactTrimeshCache_, model);
+}
+
+void CollisionGeometryCache::Cleanup()
+{
+    MutexLock lock(mutex_);
+
+    RemoveUnusedGeometry(triMeshCache_);
+    RemoveUnusedGeometry(convexCache_);
+    RemoveUnusedGeometry(gimpactTrimeshCache_);
+}
+
+unsigned CollisionGeometryCache::GetNumGeometries() const
+{
+    MutexLock lock(mutex_);
+    return triMeshCache_.size() + convexCache_.size() + gimpactTrimeshCache_.size();
+}
+
+CollisionGeometryDataCache* CollisionGeometryCache::GetCache(ShapeType shapeType)
+{
+    switch (shapeType)
+    {
+    case SHAPE_TRIANGLEMESH: return &triMeshCache_;
+    case SHAPE_CONVEXHULL: return &convexCache_;
+    case SHAPE_GIMPACTMESH: return &gimpactTrimeshCache_;
+    default: return nullptr;
+    }
+}
+
+const CollisionGeometryDataCache* CollisionGeometryCache::GetCache(ShapeType shapeType) const
+{
+    return const_cast<CollisionGeometryCache*>(this)->GetCache(shapeType);
+}
+
+}
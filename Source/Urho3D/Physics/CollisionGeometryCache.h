@@ -0,0 +1,71 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Core/Mutex.h"
+#include "../Core/Object.h"
+#include "../Physics/CollisionShape.h"
+
+namespace Urho3D
+{
+
+/// Collision geometry built from models, shared by all physics worlds of the context.
+/// Geometry is keyed by shape type, model and LOD level and is released when no collision shape uses it,
+/// so scenes that instantiate the same map share a single copy of each triangle mesh and convex hull.
+class URHO3D_API CollisionGeometryCache : public Object
+{
+    URHO3D_OBJECT(CollisionGeometryCache, Object);
+
+public:
+    explicit CollisionGeometryCache(Context* context);
+    ~CollisionGeometryCache() override;
+
+    /// Return cached geometry for the model, or null if there's none. Thread-safe.
+    SharedPtr<CollisionGeometryData> GetGeometry(ShapeType shapeType, Model* model, unsigned lodLevel) const;
+    /// Store geometry for the model. Only model-based shape types are cached. Thread-safe.
+    void StoreGeometry(ShapeType shapeType, Model* model, unsigned lodLevel, CollisionGeometryData* geometry);
+    /// Remove all cached geometry of the model, e.g. when the model is reloaded. Thread-safe.
+    void RemoveGeometry(Model* model);
+    /// Remove geometry that is not used by any collision shape. Thread-safe.
+    void Cleanup();
+
+    /// Return number of cached geometries of all types.
+    unsigned GetNumGeometries() const;
+
+private:
+    /// Return cache for the shape type, or null if the shape type is not cached.
+    CollisionGeometryDataCache* GetCache(ShapeType shapeType);
+    const CollisionGeometryDataCache* GetCache(ShapeType shapeType) const;
+
+    /// Cache for trimesh geometry data by model and LOD level.
+    CollisionGeometryDataCache triMeshCache_;
+    /// Cache for convex geometry data by model and LOD level.
+    CollisionGeometryDataCache convexCache_;
+    /// Cache for GImpact trimesh geometry data by model and LOD level.
+    CollisionGeometryDataCache gimpactTrimeshCache_;
+
+    mutable Mutex mutex_;
+};
+
+}
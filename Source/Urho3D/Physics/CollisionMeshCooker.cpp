@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Physics/CollisionMeshCooker.h"
+
+#include "../Core/Context.h"
+#include "../Graphics/Model.h"
+#include "../IO/File.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+#include "../Physics/CollisionShape.h"
+#include "../Resource/ResourceCache.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+CollisionMeshCooker::CollisionMeshCooker(Context* context)
+    : AssetTransformer(context)
+{
+}
+
+CollisionMeshCooker::~CollisionMeshCooker()
+{
+}
+
+void CollisionMeshCooker::RegisterObject(Context* context)
+{
+    context->RegisterFactory<CollisionMeshCooker>(Category_Transformer);
+
+    URHO3D_ATTRIBUTE("Max LOD Levels", unsigned, maxLodLevels_, DefaultMaxLodLevels, AM_DEFAULT);
+}
+
+ea::string CollisionMeshCooker::GetCookedBvhName(const ea::string& modelName, unsigned lodLevel)
+{
+    return Format("{}{}_LOD{}.bvh", GetPath(modelName), GetFileName(modelName), lodLevel);
+}
+
+bool CollisionMeshCooker::IsApplicable(const AssetTransformerInput& input)
+{
+    return input.inputFileName_.ends_with(".mdl", false);
+}
+
+bool CollisionMeshCooker::Execute(
+    const AssetTransformerInput& input, AssetTransformerOutput& output, const AssetTransformerVector& transformers)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+    auto fs = GetSubsystem<FileSystem>();
+
+    auto model = cache->GetResource<Model>(input.resourceName_);
+    if (!model)
+        return false;
+
+    unsigned numLodLevels = 0;
+    for (unsigned i = 0; i < model->GetNumGeometries(); ++i)
+        numLodLevels = ea::max(numLodLevels, model->GetNumGeometryLodLevels(i));
+    numLodLevels = ea::min(numLodLevels, maxLodLevels_);
+    if (numLodLevels == 0)
+        return true;
+
+    const ea::string outputPath = GetPath(input.outputFileName_);
+    fs->CreateDirsRecursive(outputPath);
+
+    for (unsigned lodLevel = 0; lodLevel < numLodLevels; ++lodLevel)
+    {
+        // Always build BVH from scratch, cooked one may be outdated
+        const TriangleMeshData data(model, lodLevel, false);
+
+        const ea::string fileName = outputPath + GetFileNameAndExtension(GetCookedBvhName(input.resourceName_, lodLevel));
+        File file(context_, fileName, FILE_WRITE);
+        if (!file.IsOpen() || !data.SaveBvh(file))
+        {
+            URHO3D_LOGERROR("Cannot save collision BVH of model '{}' LOD {}", input.resourceName_, lodLevel);
+            return false;
+        }
+    }
+    return true;
+}
+
+}
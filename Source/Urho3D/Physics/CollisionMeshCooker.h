@@ -0,0 +1,58 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Utility/AssetTransformer.h"
+
+namespace Urho3D
+{
+
+/// Asset transformer that cooks BVH of triangle mesh collision shapes for the model.
+/// Produces "*_LOD<N>.bvh" file next to the model for each LOD level.
+/// TriangleMeshData loads cooked BVH instead of building it if the model geometry matches.
+class URHO3D_API CollisionMeshCooker : public AssetTransformer
+{
+    URHO3D_OBJECT(CollisionMeshCooker, AssetTransformer);
+
+public:
+    /// Default max number of cooked LOD levels.
+    static const unsigned DefaultMaxLodLevels = 1;
+
+    explicit CollisionMeshCooker(Context* context);
+    ~CollisionMeshCooker() override;
+    static void RegisterObject(Context* context);
+
+    /// Return resource name of the cooked BVH for the model LOD level.
+    static ea::string GetCookedBvhName(const ea::string& modelName, unsigned lodLevel);
+
+    bool IsApplicable(const AssetTransformerInput& input) override;
+    bool Execute(const AssetTransformerInput& input, AssetTransformerOutput& output,
+        const AssetTransformerVector& transformers) override;
+    bool IsExecutedOnOutput() override { return true; }
+
+private:
+    unsigned maxLodLevels_{DefaultMaxLodLevels};
+};
+
+}
@@ -32,7 +32,11 @@
 #include "../Graphics/Model.h"
 #include "../Graphics/Terrain.h"
 #include "../Graphics/VertexBuffer.h"
+#include "../IO/Deserializer.h"
 #include "../IO/Log.h"
+#include "../IO/Serializer.h"
+#include "../Physics/CollisionGeometryCache.h"
+#include "../Physics/CollisionMeshCooker.h"
 #include "../Physics/CollisionShape.h"
 #include "../Physics/PhysicsUtils.h"
 #include "../Physics/PhysicsWorld.h"
@@ -49,6 +53,7 @@
 #include <Bullet/BulletCollision/CollisionShapes/btConvexHullShape.h>
 #include <Bullet/BulletCollision/CollisionShapes/btCylinderShape.h>
 #include <Bullet/BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
+#include <Bullet/BulletCollision/CollisionShapes/btOptimizedBvh.h>
 #include <Bullet/BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
 #include <Bullet/BulletCollision/CollisionShapes/btSphereShape.h>
 #include <Bullet/BulletCollision/CollisionShapes/btTriangleIndexVertexArray.h>
@@ -63,6 +68,8 @@ namespace Urho3D
 static const float DEFAULT_COLLISION_MARGIN = 0.04f;
 static const unsigned QUANTIZE_MAX_TRIANGLES = 1000000;
 
+static const char* COOKED_BVH_FILE_ID = "UBVH";
+
 static const btVector3 WHITE(1.0f, 1.0f, 1.0f);
 static const btVector3 GREEN(0.0f, 1.0f, 0.0f);
 
@@ -81,6 +88,16 @@ static const char* typeNames[] =
     nullptr
 };
 
+static void DestroyCookedBvh(btOptimizedBvh*& bvh, void*& buffer)
+{
+    if (bvh)
+        bvh->~btOptimizedBvh();
+    if (buffer)
+        btAlignedFree(buffer);
+    bvh = nullptr;
+    buffer = nullptr;
+}
+
 class TriangleMeshInterface : public btTriangleIndexVertexArray
 {
 public:
@@ -136,6 +153,7 @@ public:
         // Bullet will not work properly with quantized AABB compression, if the triangle count is too large. Use a conservative
         // threshold value
         useQuantize_ = totalTriangles <= QUANTIZE_MAX_TRIANGLES;
+        numTriangles_ = totalTriangles;
     }
 
     explicit TriangleMeshInterface(CustomGeometry* custom) :
@@ -184,20 +202,40 @@ public:
         }
 
         useQuantize_ = totalTriangles <= QUANTIZE_MAX_TRIANGLES;
+        numTriangles_ = totalTriangles;
     }
 
     /// OK to use quantization flag.
     bool useQuantize_;
+    /// Total number of triangles.
+    unsigned numTriangles_{};
 
 private:
     /// Shared vertex/index data used in the collision.
     ea::vector<ea::shared_array<unsigned char> > dataArrays_;
 };
 
-TriangleMeshData::TriangleMeshData(Model* model, unsigned lodLevel)
+TriangleMeshData::TriangleMeshData(Model* model, unsigned lodLevel, bool useCookedBvh)
 {
     meshInterface_ = ea::make_unique<TriangleMeshInterface>(model, lodLevel);
-    shape_ = ea::make_unique<btBvhTriangleMeshShape>(meshInterface_.get(), meshInterface_->useQuantize_, true);
+
+    // Building BVH is the most expensive part, use the one cooked at import time if possible
+    bool cookedBvhLoaded = false;
+    if (useCookedBvh && !model->GetName().empty())
+    {
+        auto cache = model->GetSubsystem<ResourceCache>();
+        const ea::string bvhName = CollisionMeshCooker::GetCookedBvhName(model->GetName(), lodLevel);
+        if (cache->Exists(bvhName))
+        {
+            if (AbstractFilePtr file = cache->GetFile(bvhName, false))
+                cookedBvhLoaded = LoadBvh(*file);
+            if (!cookedBvhLoaded)
+                URHO3D_LOGWARNING("Cooked BVH '{}' doesn't match model '{}' and is ignored", bvhName, model->GetName());
+        }
+    }
+
+    if (!cookedBvhLoaded)
+        shape_ = ea::make_unique<btBvhTriangleMeshShape>(meshInterface_.get(), meshInterface_->useQuantize_, true);
 
     infoMap_ = ea::make_unique<btTriangleInfoMap>();
     btGenerateInternalEdgeInfo(shape_.get(), infoMap_.get());
@@ -214,6 +252,63 @@ TriangleMeshData::TriangleMeshData(CustomGeometry* custom)
 
 TriangleMeshData::~TriangleMeshData()
 {
+    // Shape references cooked BVH and should be destroyed first
+    shape_.reset();
+    DestroyCookedBvh(cookedBvh_, cookedBvhBuffer_);
+}
+
+bool TriangleMeshData::SaveBvh(Serializer& dest) const
+{
+    btOptimizedBvh* bvh = shape_ ? shape_->getOptimizedBvh() : nullptr;
+    if (!bvh)
+        return false;
+
+    const unsigned size = bvh->calculateSerializeBufferSize();
+    void* buffer = btAlignedAlloc(size, 16);
+    bool success = bvh->serializeInPlace(buffer, size, false);
+
+    success = success && dest.WriteFileID(COOKED_BVH_FILE_ID);
+    success = success && dest.WriteUInt(meshInterface_->numTriangles_);
+    success = success && dest.WriteVector3(ToVector3(shape_->getLocalAabbMin()));
+    success = success && dest.WriteVector3(ToVector3(shape_->getLocalAabbMax()));
+    success = success && dest.WriteUInt(size);
+    success = success && dest.Write(buffer, size) == size;
+
+    btAlignedFree(buffer);
+    return success;
+}
+
+bool TriangleMeshData::LoadBvh(Deserializer& source)
+{
+    if (source.ReadFileID() != COOKED_BVH_FILE_ID)
+        return false;
+
+    const unsigned numTriangles = source.ReadUInt();
+    const Vector3 aabbMin = source.ReadVector3();
+    const Vector3 aabbMax = source.ReadVector3();
+    const unsigned size = source.ReadUInt();
+    if (numTriangles != meshInterface_->numTriangles_ || size < sizeof(btOptimizedBvh)
+        || size > source.GetSize() - source.GetPosition())
+        return false;
+
+    // Shape computes bounding box of the mesh without building BVH, it should match the cooked one
+    auto shape = ea::make_unique<btBvhTriangleMeshShape>(meshInterface_.get(), meshInterface_->useQuantize_, false);
+    if (!ToVector3(shape->getLocalAabbMin()).Equals(aabbMin) || !ToVector3(shape->getLocalAabbMax()).Equals(aabbMax))
+        return false;
+
+    cookedBvhBuffer_ = btAlignedAlloc(size, 16);
+    if (source.Read(cookedBvhBuffer_, size) == size)
+        cookedBvh_ = btOptimizedBvh::deSerializeInPlace(cookedBvhBuffer_, size, false);
+
+    if (!cookedBvh_ || cookedBvh_->isQuantized() != meshInterface_->useQuantize_)
+    {
+        DestroyCookedBvh(cookedBvh_, cookedBvhBuffer_);
+        return false;
+    }
+
+    shape->setOptimizedBvh(cookedBvh_);
+    shape_ = ea::move(shape);
+    return true;
 }
 
 GImpactMeshData::GImpactMeshData(Model* model, unsigned lodLevel)
@@ -1036,15 +1131,15 @@ void CollisionShape::UpdateShape()
             break;
 
         case SHAPE_TRIANGLEMESH:
-            UpdateCachedGeometryShape(physicsWorld_->GetTriMeshCache());
+            UpdateCachedGeometryShape();
             break;
 
         case SHAPE_CONVEXHULL:
-            UpdateCachedGeometryShape(physicsWorld_->GetConvexCache());
+            UpdateCachedGeometryShape();
             break;
 
         case SHAPE_GIMPACTMESH:
-            UpdateCachedGeometryShape(physicsWorld_->GetGImpactTrimeshCache());
+            UpdateCachedGeometryShape();
             break;
 
         case SHAPE_TERRAIN:
@@ -1084,7 +1179,7 @@ void CollisionShape::UpdateShape()
     retryCreation_ = false;
 }
 
-void CollisionShape::UpdateCachedGeometryShape(CollisionGeometryDataCache& cache)
+void CollisionShape::UpdateCachedGeometryShape()
 {
     Scene* scene = GetScene();
     size_ = size_.Abs();
@@ -1104,18 +1199,16 @@ void CollisionShape::UpdateCachedGeometryShape(CollisionGeometryDataCache& cache
     }
     else if (model_ && model_->GetNumGeometries())
     {
-        // Check the geometry cache
-        ea::pair<Model*, unsigned> id = ea::make_pair(model_.Get(), lodLevel_);
-        auto cachedGeometry = cache.find(id);
-        if (cachedGeometry != cache.end())
-            geometry_ = cachedGeometry->second;
-        else
+        // Check the geometry cache shared by all physics worlds
+        CollisionGeometryCache* cache = physicsWorld_->GetGeometryCache();
+        geometry_ = cache->GetGeometry(shapeType_, model_, lodLevel_);
+        if (!geometry_)
         {
             geometry_ = CreateCollisionGeometryData(shapeType_, model_, lodLevel_);
             assert(geometry_);
             // Check if model has dynamic buffers, do not cache in that case
             if (!HasDynamicBuffers(model_, lodLevel_))
-                cache[id] = geometry_;
+                cache->StoreGeometry(shapeType_, model_, lodLevel_, geometry_);
         }
 
         shape_.reset(CreateCollisionGeometryDataShape(shapeType_, geometry_, cachedWorldScale_ * size_));
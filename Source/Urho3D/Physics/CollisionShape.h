@@ -34,6 +34,7 @@ class btBvhTriangleMeshShape;
 class btCollisionShape;
 class btCompoundShape;
 class btGImpactMeshShape;
+class btOptimizedBvh;
 class btTriangleMesh;
 
 struct btTriangleInfoMap;
@@ -42,10 +43,12 @@ namespace Urho3D
 {
 
 class CustomGeometry;
+class Deserializer;
 class Geometry;
 class Model;
 class PhysicsWorld;
 class RigidBody;
+class Serializer;
 class Terrain;
 class TriangleMeshInterface;
 
@@ -70,24 +73,37 @@ struct CollisionGeometryData : public RefCounted
 };
 
 /// Cache of collision geometry data.
-/// \todo Remove duplicate declaration
 using CollisionGeometryDataCache = ea::unordered_map<ea::pair<Model*, unsigned>, SharedPtr<CollisionGeometryData> >;
 
 /// Triangle mesh geometry data.
-struct TriangleMeshData : public CollisionGeometryData
+struct URHO3D_API TriangleMeshData : public CollisionGeometryData
 {
-    /// Construct from a model.
-    TriangleMeshData(Model* model, unsigned lodLevel);
+    /// Construct from a model. BVH cooked by CollisionMeshCooker is used if present and matches the model.
+    TriangleMeshData(Model* model, unsigned lodLevel, bool useCookedBvh = true);
     /// Construct from a custom geometry.
     explicit TriangleMeshData(CustomGeometry* custom);
     ~TriangleMeshData();
 
+    /// Save BVH of the shape so it doesn't have to be built on load.
+    bool SaveBvh(Serializer& dest) const;
+    /// Return whether the shape uses cooked BVH.
+    bool IsCookedBvhUsed() const { return cookedBvh_ != nullptr; }
+
     /// Bullet triangle mesh interface.
     ea::unique_ptr<TriangleMeshInterface> meshInterface_;
     /// Bullet triangle mesh collision shape.
     ea::unique_ptr<btBvhTriangleMeshShape> shape_;
     /// Bullet triangle info map.
     ea::unique_ptr<btTriangleInfoMap> infoMap_;
+
+private:
+    /// Load BVH saved by SaveBvh and create the shape with it. Return false if the BVH doesn't match the mesh.
+    bool LoadBvh(Deserializer& source);
+
+    /// BVH deserialized in place, if loaded from the cooked data.
+    btOptimizedBvh* cookedBvh_{};
+    /// Aligned buffer that contains cooked BVH.
+    void* cookedBvhBuffer_{};
 };
 
 /// Triangle mesh geometry data.
@@ -294,7 +310,7 @@ private:
     /// Update the collision shape after attribute changes.
     void UpdateShape();
     /// Update cached geometry collision shape.
-    void UpdateCachedGeometryShape(CollisionGeometryDataCache& cache);
+    void UpdateCachedGeometryShape();
     /// Set as specified shape type using model and LOD.
     void SetModelShape(ShapeType shapeType, Model* model, unsigned lodLevel,
         const Vector3& scale, const Vector3& position, const Quaternion& rotation);
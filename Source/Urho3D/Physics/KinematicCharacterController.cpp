@@ -47,6 +47,76 @@ btKinematicCharacterController* newKinematicCharCtrl(btPairCachingGhostObject *g
     return new btKinematicCharacterController(ghostCGO, shape, stepHeight, upVec);
 }
 
+namespace
+{
+
+/// Bullet controller with access to the internal state.
+class BulletKinematicController : public btKinematicCharacterController
+{
+public:
+    using btKinematicCharacterController::btKinematicCharacterController;
+
+    void SaveState(KinematicCharacterControllerState& state) const
+    {
+        state.verticalVelocity_ = m_verticalVelocity;
+        state.verticalOffset_ = m_verticalOffset;
+        state.wasOnGround_ = m_wasOnGround;
+        state.wasJumping_ = m_wasJumping;
+    }
+
+    void RestoreState(const KinematicCharacterControllerState& state)
+    {
+        m_verticalVelocity = state.verticalVelocity_;
+        m_verticalOffset = state.verticalOffset_;
+        m_wasOnGround = state.wasOnGround_;
+        m_wasJumping = state.wasJumping_;
+    }
+
+    /// Step the controller unless it rests on the ground and nothing around it changed since the last step.
+    /// Return whether the controller was stepped.
+    bool UpdateIfAwake(btCollisionWorld* collisionWorld, btScalar timeStep, bool skipIdle)
+    {
+        if (skipIdle && CanSkipStep())
+            return false;
+
+        updateAction(collisionWorld, timeStep);
+        sleepingOverlaps_ = IsIdle() && !m_touchingContact ? m_ghostObject->getNumOverlappingObjects() : -1;
+        return true;
+    }
+
+    /// Force the next step to be simulated.
+    void WakeUp() { sleepingOverlaps_ = -1; }
+
+private:
+    /// Return whether the controller has no movement of its own.
+    bool IsIdle() const
+    {
+        return m_useWalkDirection && m_walkDirection.fuzzyZero() && m_AngVel.fuzzyZero() && onGround() && !m_wasJumping;
+    }
+
+    /// Return whether the step would not change the controller.
+    bool CanSkipStep() const
+    {
+        if (sleepingOverlaps_ < 0 || !IsIdle() || m_ghostObject->getNumOverlappingObjects() != sleepingOverlaps_)
+            return false;
+
+        // Moving bodies may push the controller or remove the ground under it
+        for (int i = 0; i < sleepingOverlaps_; ++i)
+        {
+            const btCollisionObject* other = m_ghostObject->getOverlappingObject(i);
+            const bool isStatic = (other->getCollisionFlags() & btCollisionObject::CF_STATIC_OBJECT) != 0;
+            if (other->hasContactResponse() && !isStatic && other->isActive())
+                return false;
+        }
+        return true;
+    }
+
+    /// Number of overlapping objects when the controller fell asleep, -1 if awake.
+    int sleepingOverlaps_{-1};
+};
+
+}
+
 #include <Urho3D/DebugNew.h>
 
 //=============================================================================
@@ -286,6 +356,7 @@ void KinematicCharacterController::ResetShape()
     if (kinematicController_)
     {
         kinematicController_->setCollisionShape(shape_.get());
+        WakeUpKinematic();
     }
 }
 
@@ -298,7 +369,7 @@ void KinematicCharacterController::AddKinematicToWorld()
             btCapsuleShape* btColShape = GetOrCreateShape();
             pairCachingGhostObject_->setCollisionShape(btColShape);
 
-            kinematicController_ = ea::make_unique<btKinematicCharacterController>(pairCachingGhostObject_.get(),
+            kinematicController_ = ea::make_unique<BulletKinematicController>(pairCachingGhostObject_.get(),
                                                        btColShape,
                                                        stepHeight_, ToBtVector3(Vector3::UP));
             // apply default settings
@@ -306,7 +377,7 @@ void KinematicCharacterController::AddKinematicToWorld()
 
             btDiscreteDynamicsWorld *phyicsWorld = physicsWorld_->GetWorld();
             phyicsWorld->addCollisionObject(pairCachingGhostObject_.get(), colLayer_, colMask_);
-            phyicsWorld->addAction(kinematicController_.get());
+            physicsWorld_->AddCharacterController(this);
         }
     }
 }
@@ -338,7 +409,7 @@ void KinematicCharacterController::RemoveKinematicFromWorld()
     {
         btDiscreteDynamicsWorld *phyicsWorld = physicsWorld_->GetWorld();
         phyicsWorld->removeCollisionObject(pairCachingGhostObject_.get());
-        phyicsWorld->removeAction(kinematicController_.get());
+        physicsWorld_->RemoveCharacterController(this);
     }
 }
 
@@ -415,8 +486,45 @@ void KinematicCharacterController::AdjustRawPosition(const Vector3& offset, floa
     node_->SetWorldPosition(latestPosition_);
 }
 
+KinematicCharacterControllerState KinematicCharacterController::GetKinematicState() const
+{
+    KinematicCharacterControllerState state;
+    state.rawPosition_ = GetRawPosition();
+    static_cast<const BulletKinematicController*>(kinematicController_.get())->SaveState(state);
+    return state;
+}
+
+void KinematicCharacterController::SetKinematicState(const KinematicCharacterControllerState& state)
+{
+    const btVector3 objectPosition = ToBtVector3(state.rawPosition_ + colShapeOffset_);
+    pairCachingGhostObject_->setWorldTransform(btTransform(btQuaternion::getIdentity(), objectPosition));
+    static_cast<BulletKinematicController*>(kinematicController_.get())->RestoreState(state);
+    WakeUpKinematic();
+}
+
+void KinematicCharacterController::StepKinematic(float timeStep)
+{
+    UpdateKinematic(timeStep, false);
+}
+
+bool KinematicCharacterController::UpdateKinematic(float timeStep, bool skipIdle)
+{
+    if (!physicsWorld_ || !kinematicController_)
+        return false;
+
+    auto controller = static_cast<BulletKinematicController*>(kinematicController_.get());
+    return controller->UpdateIfAwake(physicsWorld_->GetWorld(), timeStep, skipIdle);
+}
+
+void KinematicCharacterController::WakeUpKinematic()
+{
+    if (kinematicController_)
+        static_cast<BulletKinematicController*>(kinematicController_.get())->WakeUp();
+}
+
 void KinematicCharacterController::WarpKinematic(const Vector3& position)
 {
+    WakeUpKinematic();
     latestPosition_ = position + positionOffset_;
     previousPosition_ = position;
     nextPosition_ = position;
@@ -449,6 +557,7 @@ void KinematicCharacterController::SetGravity(const Vector3 &gravity)
     {
         gravity_ = gravity;
         kinematicController_->setGravity(ToBtVector3(gravity_));
+        WakeUpKinematic();
     }
 }
 
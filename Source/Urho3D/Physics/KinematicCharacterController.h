@@ -34,6 +34,22 @@ namespace Urho3D
 class PhysicsWorld;
 class DebugRenderer;
 
+/// Simulation state of the kinematic character controller.
+/// May be saved and restored to rewind and re-simulate the controller.
+struct KinematicCharacterControllerState
+{
+    /// Character position in world space without interpolation.
+    Vector3 rawPosition_;
+    /// Velocity along up axis.
+    float verticalVelocity_{};
+    /// Offset along up axis on the last step.
+    float verticalOffset_{};
+    /// Whether the controller was on the ground on the last step.
+    bool wasOnGround_{};
+    /// Whether the controller was jumping on the last step.
+    bool wasJumping_{};
+};
+
 class URHO3D_API KinematicCharacterController : public Component
 {
     URHO3D_OBJECT(KinematicCharacterController, Component);
@@ -56,6 +72,17 @@ public:
     /// Adjust position of kinematic body.
     void AdjustRawPosition(const Vector3& offset, float smoothConstant);
 
+    /// Return simulation state of the controller.
+    KinematicCharacterControllerState GetKinematicState() const;
+    /// Restore simulation state of the controller. Node position and interpolation are not affected.
+    void SetKinematicState(const KinematicCharacterControllerState& state);
+    /// Simulate the controller for one step outside of physics world update.
+    /// Collision world is not updated, events are not sent. Used to re-simulate predicted controllers.
+    void StepKinematic(float timeStep);
+    /// Simulate the controller for one step of physics world update. Called by PhysicsWorld.
+    /// If skipIdle is set, the step is skipped for the controller resting on the ground. Return whether the controller was stepped.
+    bool UpdateKinematic(float timeStep, bool skipIdle);
+
     /// Set collision layer.
     void SetCollisionLayer(unsigned layer);
     /// Return collision layer.
@@ -153,6 +180,8 @@ protected:
 
     /// Instantly reset character position to new value.
     void WarpKinematic(const Vector3& position);
+    /// Force the controller to be simulated on the next step even if it is idle.
+    void WakeUpKinematic();
 
     void HandlePhysicsPreUpdate(StringHash eventType, VariantMap& eventData);
     void HandlePhysicsPostStep(StringHash eventType, VariantMap& eventData);
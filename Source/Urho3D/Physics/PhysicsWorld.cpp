@@ -25,13 +25,17 @@
 #include <EASTL/sort.h>
 
 #include "../Core/Context.h"
+#include "../Core/MemoryTracker.h"
 #include "../Core/Mutex.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/Model.h"
 #include "../IO/Log.h"
 #include "../Math/Ray.h"
 #include "../Physics/KinematicCharacterController.h"
+#include "../Physics/CollisionGeometryCache.h"
+#include "../Physics/CollisionMeshCooker.h"
 #include "../Physics/CollisionShape.h"
 #include "../Physics/Constraint.h"
 #include "../Physics/PhysicsEvents.h"
@@ -44,69 +48,121 @@
 #include "../Scene/SceneEvents.h"
 
 #include <Bullet/BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <Bullet/BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <Bullet/BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
 #include <Bullet/BulletCollision/CollisionDispatch/btInternalEdgeUtility.h>
 #include <Bullet/BulletCollision/CollisionShapes/btBoxShape.h>
 #include <Bullet/BulletCollision/CollisionShapes/btSphereShape.h>
 #include <Bullet/BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h>
 #include <Bullet/BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
+#include <Bullet/BulletDynamics/Dynamics/btActionInterface.h>
 #include <Bullet/BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <Bullet/BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#include <Bullet/LinearMath/btThreads.h>
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 
 extern ContactAddedCallback gContactAddedCallback;
 
+class btCustomSteppedWorld
+{
+public:
+    virtual ~btCustomSteppedWorld() = default;
+
+    virtual void customStepSimulation(unsigned clampedSimulationSteps, btScalar fixedTimeStep, btScalar overtime) = 0;
+    virtual btScalar getLocalTime() const = 0;
+    virtual int getNumSynchronizedBodies() const = 0;
+};
+
+template <class T>
 ATTRIBUTE_ALIGNED16(class)
-btCustomDiscreteDynamicsWorld : public btDiscreteDynamicsWorld
+btCustomDiscreteDynamicsWorld : public T, public btCustomSteppedWorld
 {
 public:
-    using btDiscreteDynamicsWorld::btDiscreteDynamicsWorld;
+    using T::T;
 
-    void customStepSimulation(unsigned clampedSimulationSteps, btScalar fixedTimeStep, btScalar overtime)
+    void customStepSimulation(unsigned clampedSimulationSteps, btScalar fixedTimeStep, btScalar overtime) override
     {
-        m_fixedTimeStep = fixedTimeStep;
-        m_localTime = overtime;
+        this->m_fixedTimeStep = fixedTimeStep;
+        this->m_localTime = overtime;
 
-        if (getDebugDrawer())
+        if (this->getDebugDrawer())
         {
-            btIDebugDraw* debugDrawer = getDebugDrawer();
+            btIDebugDraw* debugDrawer = this->getDebugDrawer();
             gDisableDeactivation = (debugDrawer->getDebugMode() & btIDebugDraw::DBG_NoDeactivation) != 0;
         }
 
         if (clampedSimulationSteps > 0)
         {
-            saveKinematicState(fixedTimeStep * clampedSimulationSteps);
+            this->saveKinematicState(fixedTimeStep * clampedSimulationSteps);
 
             for (int i = 0; i < clampedSimulationSteps; i++)
             {
                 // Urho3D: apply gravity on each substep
-                applyGravity();
+                this->applyGravity();
 
-                internalSingleStepSimulation(fixedTimeStep);
-                synchronizeMotionStates();
+                this->internalSingleStepSimulation(fixedTimeStep);
+                this->synchronizeMotionStates();
 
                 // Urho3D: clear forces on each substep
-                clearForces();
+                this->clearForces();
             }
         }
         else
         {
-            synchronizeMotionStates();
+            this->synchronizeMotionStates();
         }
 
-        clearForces();
+        this->clearForces();
     }
 
-    btScalar getLocalTime() const { return m_localTime; }
+    void synchronizeMotionStates() override
+    {
+        // Urho3D: walk only the compact list of non-static bodies and skip sleeping islands and kinematic bodies,
+        // their nodes cannot have been moved by the simulation
+        m_numSynchronizedBodies = 0;
+        for (int i = 0; i < this->m_nonStaticRigidBodies.size(); i++)
+        {
+            btRigidBody* body = this->m_nonStaticRigidBodies[i];
+            if (body->isActive() && !body->isStaticOrKinematicObject() && body->getMotionState())
+            {
+                this->synchronizeSingleMotionState(body);
+                ++m_numSynchronizedBodies;
+            }
+        }
+    }
+
+    btScalar getLocalTime() const override { return this->m_localTime; }
+    int getNumSynchronizedBodies() const override { return m_numSynchronizedBodies; }
+
+private:
+    int m_numSynchronizedBodies{};
 };
 
 namespace Urho3D
 {
 
 static const int MAX_SOLVER_ITERATIONS = 256;
+static const int COLLISION_DISPATCHER_GRAIN_SIZE = 40;
 static const Vector3 DEFAULT_GRAVITY = Vector3(0.0f, -9.81f, 0.0f);
 
 PhysicsWorldConfig PhysicsWorld::config;
 
+static unsigned GetPhysicsMemoryTag()
+{
+    static const unsigned tag = MemoryTracker::RegisterTag("Physics");
+    return tag;
+}
+
+static void* AllocatePhysicsMemory(size_t size)
+{
+    return MemoryTracker::AllocateTracked(GetPhysicsMemoryTag(), size);
+}
+
+static void FreePhysicsMemory(void* ptr)
+{
+    MemoryTracker::FreeTracked(GetPhysicsMemoryTag(), ptr);
+}
+
 static bool CompareRaycastResults(const PhysicsRaycastResult& lhs, const PhysicsRaycastResult& rhs)
 {
     return lhs.distance_ < rhs.distance_;
@@ -141,26 +197,160 @@ static bool CustomMaterialCombinerCallback(btManifoldPoint& cp, const btCollisio
     return true;
 }
 
-void RemoveCachedGeometryImpl(CollisionGeometryDataCache& cache, Model* model)
+#if BT_THREADSAFE
+/// Bullet task scheduler that executes parallel loops on WorkQueue threads,
+/// so Bullet doesn't need its own pool of threads.
+class WorkQueueTaskScheduler : public btITaskScheduler
 {
-    for (auto i = cache.begin(); i != cache.end();)
+public:
+    WorkQueueTaskScheduler() : btITaskScheduler("WorkQueue") {}
+
+    static WorkQueueTaskScheduler* GetInstance()
     {
-        auto current = i++;
-        if (current->first.first == model)
-            cache.erase(current);
+        static WorkQueueTaskScheduler instance;
+        return &instance;
     }
+
+    void SetWorkQueue(WorkQueue* workQueue) { workQueue_ = workQueue; }
+
+    int getMaxNumThreads() const override { return BT_MAX_THREAD_COUNT; }
+    int getNumThreads() const override { return static_cast<int>(ea::min(WorkQueue::GetThreadIndexCount(), BT_MAX_THREAD_COUNT)); }
+    void setNumThreads(int numThreads) override {}
+
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override
+    {
+        if (iBegin >= iEnd)
+            return;
+
+        if (!workQueue_)
+        {
+            body.forLoop(iBegin, iEnd);
+            return;
+        }
+
+        const auto size = static_cast<unsigned>(iEnd - iBegin);
+        const auto bucket = static_cast<unsigned>(ea::max(grainSize, 1));
+        ForEachParallel(workQueue_, bucket, size,
+            [&](unsigned beginIndex, unsigned endIndex) { body.forLoop(iBegin + beginIndex, iBegin + endIndex); });
+    }
+
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override
+    {
+        if (iBegin >= iEnd)
+            return btScalar(0);
+
+        if (!workQueue_)
+            return body.sumLoop(iBegin, iEnd);
+
+        Mutex mutex;
+        btScalar sum{};
+        const auto size = static_cast<unsigned>(iEnd - iBegin);
+        const auto bucket = static_cast<unsigned>(ea::max(grainSize, 1));
+        ForEachParallel(workQueue_, bucket, size,
+            [&](unsigned beginIndex, unsigned endIndex)
+        {
+            const btScalar partialSum = body.sumLoop(iBegin + beginIndex, iBegin + endIndex);
+            MutexLock lock(mutex);
+            sum += partialSum;
+        });
+        return sum;
+    }
+
+private:
+    WeakPtr<WorkQueue> workQueue_;
+};
+#endif
+
+/// Number of queries processed by one task in batched queries.
+static const unsigned QUERY_BATCH_BUCKET_SIZE = 64;
+
+static void ResetRaycastResult(PhysicsRaycastResult& result)
+{
+    result.position_ = Vector3::ZERO;
+    result.normal_ = Vector3::ZERO;
+    result.distance_ = M_INFINITY;
+    result.hitFraction_ = 0.0f;
+    result.body_ = nullptr;
 }
 
-void CleanupGeometryCacheImpl(CollisionGeometryDataCache& cache)
+static void RaycastSingleImpl(btCollisionWorld* world, PhysicsRaycastResult& result, const Ray& ray, float maxDistance, unsigned collisionMask)
 {
-    for (auto i = cache.begin(); i != cache.end();)
+    btCollisionWorld::ClosestRayResultCallback
+        rayCallback(ToBtVector3(ray.origin_), ToBtVector3(ray.origin_ + maxDistance * ray.direction_));
+    rayCallback.m_collisionFilterGroup = (short)0xffff;
+    rayCallback.m_collisionFilterMask = (short)collisionMask;
+
+    world->rayTest(rayCallback.m_rayFromWorld, rayCallback.m_rayToWorld, rayCallback);
+
+    if (rayCallback.hasHit())
     {
-        auto current = i++;
-        if (current->second.Refs() == 1)
-            cache.erase(current);
+        result.position_ = ToVector3(rayCallback.m_hitPointWorld);
+        result.normal_ = ToVector3(rayCallback.m_hitNormalWorld);
+        result.distance_ = (result.position_ - ray.origin_).Length();
+        result.hitFraction_ = rayCallback.m_closestHitFraction;
+        result.body_ = static_cast<RigidBody*>(rayCallback.m_collisionObject->getUserPointer());
     }
+    else
+        ResetRaycastResult(result);
 }
 
+static void SphereCastImpl(btCollisionWorld* world, PhysicsRaycastResult& result, const Ray& ray, float radius, float maxDistance, unsigned collisionMask)
+{
+    btSphereShape shape(radius);
+    Vector3 endPos = ray.origin_ + maxDistance * ray.direction_;
+
+    btCollisionWorld::ClosestConvexResultCallback
+        convexCallback(ToBtVector3(ray.origin_), ToBtVector3(endPos));
+    convexCallback.m_collisionFilterGroup = (short)0xffff;
+    convexCallback.m_collisionFilterMask = (short)collisionMask;
+
+    world->convexSweepTest(&shape, btTransform(btQuaternion::getIdentity(), convexCallback.m_convexFromWorld),
+        btTransform(btQuaternion::getIdentity(), convexCallback.m_convexToWorld), convexCallback);
+
+    if (convexCallback.hasHit())
+    {
+        result.body_ = static_cast<RigidBody*>(convexCallback.m_hitCollisionObject->getUserPointer());
+        result.position_ = ToVector3(convexCallback.m_hitPointWorld);
+        result.normal_ = ToVector3(convexCallback.m_hitNormalWorld);
+        result.distance_ = convexCallback.m_closestHitFraction * (endPos - ray.origin_).Length();
+        result.hitFraction_ = convexCallback.m_closestHitFraction;
+    }
+    else
+        ResetRaycastResult(result);
+}
+
+/// Callback for broadphase overlap queries. Stops on the first rigid body with overlapping shape bounds.
+struct PhysicsOverlapCallback : public btBroadphaseAabbCallback
+{
+    PhysicsOverlapCallback(const btVector3& aabbMin, const btVector3& aabbMax, unsigned collisionMask)
+        : aabbMin_(aabbMin)
+        , aabbMax_(aabbMax)
+        , collisionMask_(collisionMask)
+    {
+    }
+
+    bool process(const btBroadphaseProxy* proxy) override
+    {
+        const auto collisionObject = static_cast<const btCollisionObject*>(proxy->m_clientObject);
+        auto body = static_cast<RigidBody*>(collisionObject->getUserPointer());
+        if (!body || !(proxy->m_collisionFilterGroup & collisionMask_) || !collisionObject->getCollisionShape())
+            return true;
+
+        btVector3 objectAabbMin, objectAabbMax;
+        collisionObject->getCollisionShape()->getAabb(collisionObject->getWorldTransform(), objectAabbMin, objectAabbMax);
+        if (!TestAabbAgainstAabb2(aabbMin_, aabbMax_, objectAabbMin, objectAabbMax))
+            return true;
+
+        result_ = body;
+        return false;
+    }
+
+    const btVector3 aabbMin_;
+    const btVector3 aabbMax_;
+    const unsigned collisionMask_{};
+    RigidBody* result_{};
+};
+
 /// Callback for physics world queries.
 struct PhysicsQueryCallback : public btCollisionWorld::ContactResultCallback
 {
@@ -190,6 +380,23 @@ struct PhysicsQueryCallback : public btCollisionWorld::ContactResultCallback
     unsigned collisionMask_;
 };
 
+/// Bullet action that simulates all kinematic characters of the world in one pass.
+class CharacterControllerBatch : public btActionInterface
+{
+public:
+    explicit CharacterControllerBatch(PhysicsWorld* physicsWorld) : physicsWorld_(physicsWorld) {}
+
+    void updateAction(btCollisionWorld* collisionWorld, btScalar timeStep) override
+    {
+        physicsWorld_->UpdateCharacterControllers(timeStep);
+    }
+
+    void debugDraw(btIDebugDraw* debugDrawer) override {}
+
+private:
+    PhysicsWorld* physicsWorld_{};
+};
+
 PhysicsWorld::PhysicsWorld(Context* context) :
     Component(context),
     fps_(DEFAULT_FPS),
@@ -202,24 +409,16 @@ PhysicsWorld::PhysicsWorld(Context* context) :
     else
         collisionConfiguration_ = new btDefaultCollisionConfiguration();
 
-    collisionDispatcher_ = ea::make_unique<btCollisionDispatcher>(collisionConfiguration_);
-    btGImpactCollisionAlgorithm::registerAlgorithm(static_cast<btCollisionDispatcher*>(collisionDispatcher_.get()));
+    ghostPairCallback_ = new btGhostPairCallback();
+    characterControllerBatch_ = ea::make_unique<CharacterControllerBatch>(this);
 
-    broadphase_ = ea::make_unique<btDbvtBroadphase>();
-    solver_ = ea::make_unique<btSequentialImpulseConstraintSolver>();
-    world_ = ea::make_unique<btCustomDiscreteDynamicsWorld>(collisionDispatcher_.get(), broadphase_.get(), solver_.get(), collisionConfiguration_);
+    geometryCache_ = GetSubsystem<CollisionGeometryCache>();
+    if (!geometryCache_)
+        geometryCache_ = context_->RegisterSubsystem<CollisionGeometryCache>();
 
+    CreateWorld();
     world_->setGravity(ToBtVector3(DEFAULT_GRAVITY));
-    world_->getDispatchInfo().m_useContinuous = true;
     world_->getSolverInfo().m_splitImpulse = false; // Disable by default for performance
-    world_->setDebugDrawer(this);
-    world_->setInternalTickCallback(InternalPreTickCallback, static_cast<void*>(this), true);
-    world_->setInternalTickCallback(InternalTickCallback, static_cast<void*>(this), false);
-    world_->setSynchronizeAllMotionStates(true);
-
-    // Add ghost pair callback
-    ghostPairCallback_ = new btGhostPairCallback();
-    world_->getBroadphase()->getOverlappingPairCache()->setInternalGhostPairCallback(ghostPairCallback_);
 }
 
 PhysicsWorld::~PhysicsWorld()
@@ -256,6 +455,58 @@ PhysicsWorld::~PhysicsWorld()
     }
 }
 
+void PhysicsWorld::CreateWorld()
+{
+    world_.reset();
+    customWorld_ = nullptr;
+    solver_.reset();
+    broadphase_.reset();
+    collisionDispatcher_.reset();
+
+    broadphase_ = ea::make_unique<btDbvtBroadphase>();
+
+#if BT_THREADSAFE
+    if (multithreaded_)
+    {
+        // Task scheduler is global, it should be set before any Mt object is created
+        WorkQueueTaskScheduler* taskScheduler = WorkQueueTaskScheduler::GetInstance();
+        taskScheduler->SetWorkQueue(GetSubsystem<WorkQueue>());
+        if (btGetTaskScheduler() != taskScheduler)
+            btSetTaskScheduler(taskScheduler);
+
+        auto solverPool = ea::make_unique<btConstraintSolverPoolMt>(taskScheduler->getNumThreads());
+        collisionDispatcher_ = ea::make_unique<btCollisionDispatcherMt>(collisionConfiguration_, COLLISION_DISPATCHER_GRAIN_SIZE);
+        auto world = ea::make_unique<btCustomDiscreteDynamicsWorld<btDiscreteDynamicsWorldMt>>(
+            collisionDispatcher_.get(), broadphase_.get(), solverPool.get(), nullptr, collisionConfiguration_);
+        solver_ = ea::move(solverPool);
+        customWorld_ = world.get();
+        world_ = ea::move(world);
+    }
+    else
+#endif
+    {
+        collisionDispatcher_ = ea::make_unique<btCollisionDispatcher>(collisionConfiguration_);
+        solver_ = ea::make_unique<btSequentialImpulseConstraintSolver>();
+        auto world = ea::make_unique<btCustomDiscreteDynamicsWorld<btDiscreteDynamicsWorld>>(
+            collisionDispatcher_.get(), broadphase_.get(), solver_.get(), collisionConfiguration_);
+        customWorld_ = world.get();
+        world_ = ea::move(world);
+    }
+
+    btGImpactCollisionAlgorithm::registerAlgorithm(static_cast<btCollisionDispatcher*>(collisionDispatcher_.get()));
+
+    world_->getDispatchInfo().m_useContinuous = true;
+    world_->setDebugDrawer(this);
+    world_->setInternalTickCallback(InternalPreTickCallback, static_cast<void*>(this), true);
+    world_->setInternalTickCallback(InternalTickCallback, static_cast<void*>(this), false);
+
+    // Add ghost pair callback
+    world_->getBroadphase()->getOverlappingPairCache()->setInternalGhostPairCallback(ghostPairCallback_);
+
+    // Kinematic characters are simulated by single action
+    world_->addAction(characterControllerBatch_.get());
+}
+
 void PhysicsWorld::RegisterObject(Context* context)
 {
     context->AddFactoryReflection<PhysicsWorld>(Category_Subsystem);
@@ -268,6 +519,8 @@ void PhysicsWorld::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Interpolation", bool, interpolation_, true, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Internal Edge Utility", bool, internalEdge_, true, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Split Impulse", GetSplitImpulse, SetSplitImpulse, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Multithreaded", IsMultithreaded, SetMultithreaded, bool, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Skip Idle Characters", bool, skipIdleCharacters_, false, AM_DEFAULT);
 }
 
 bool PhysicsWorld::isVisible(const btVector3& aabbMin, const btVector3& aabbMax)
@@ -280,8 +533,11 @@ bool PhysicsWorld::isVisible(const btVector3& aabbMin, const btVector3& aabbMax)
 
 void PhysicsWorld::drawLine(const btVector3& from, const btVector3& to, const btVector3& color)
 {
-    if (debugRenderer_)
-        debugRenderer_->AddLine(ToVector3(from), ToVector3(to), Color(color.x(), color.y(), color.z()), debugDepthTest_);
+    const unsigned lineColor = Color(color.x(), color.y(), color.z()).ToUInt();
+    if (debugLines_)
+        debugLines_->emplace_back(ToVector3(from), ToVector3(to), lineColor);
+    else if (debugRenderer_)
+        debugRenderer_->AddLine(ToVector3(from), ToVector3(to), lineColor, debugDepthTest_);
 }
 
 void PhysicsWorld::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
@@ -290,10 +546,18 @@ void PhysicsWorld::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
     {
         URHO3D_PROFILE("PhysicsDrawDebug");
 
+        ea::vector<DebugLine> lines;
+        lines.reserve(numDebugLines_);
+
         debugRenderer_ = debug;
         debugDepthTest_ = depthTest;
+        debugLines_ = &lines;
         world_->debugDrawWorld();
+        debugLines_ = nullptr;
         debugRenderer_ = nullptr;
+
+        numDebugLines_ = lines.size();
+        debug->AddLines(lines, depthTest);
     }
 }
 
@@ -342,7 +606,7 @@ void PhysicsWorld::Update(float timeStep)
         }
     }
 
-    PostUpdate(timeStep, world_->getLocalTime());
+    PostUpdate(timeStep, customWorld_->getLocalTime());
     simulating_ = false;
     ApplyDelayedWorldTransforms();
 }
@@ -380,7 +644,7 @@ void PhysicsWorld::CustomUpdate(unsigned numSteps, float fixedTimeStep, float ov
 
     timeAcc_ = overtime;
     synchronizedStep_ = sync;
-    world_->customStepSimulation(numSteps, fixedTimeStep, overtime);
+    customWorld_->customStepSimulation(numSteps, fixedTimeStep, overtime);
 
     PostUpdate(timeStep, overtime);
     simulating_ = false;
@@ -392,6 +656,12 @@ void PhysicsWorld::UpdateCollisions()
     world_->performDiscreteCollisionDetection();
 }
 
+void PhysicsWorld::UpdateOverlappingPairs()
+{
+    world_->updateAabbs();
+    world_->computeOverlappingPairs();
+}
+
 void PhysicsWorld::SetFps(int fps)
 {
     fps_ = (unsigned)Clamp(fps, 1, 1000);
@@ -433,6 +703,38 @@ void PhysicsWorld::SetSplitImpulse(bool enable)
     world_->getSolverInfo().m_splitImpulse = enable;
 }
 
+void PhysicsWorld::SetMultithreaded(bool enable)
+{
+    if (multithreaded_ == enable)
+        return;
+
+    // Bullet objects cannot be moved between worlds, world can be recreated only while empty
+    if (world_->getNumCollisionObjects() != 0 || world_->getNumConstraints() != 0)
+    {
+        URHO3D_LOGWARNING("PhysicsWorld::SetMultithreaded should be called before physics objects are added");
+        return;
+    }
+
+    multithreaded_ = enable;
+    if (!IsMultithreadingSupported())
+        return;
+
+    const btVector3 gravity = world_->getGravity();
+    const btContactSolverInfo solverInfo = world_->getSolverInfo();
+    CreateWorld();
+    world_->setGravity(gravity);
+    world_->getSolverInfo() = solverInfo;
+}
+
+bool PhysicsWorld::IsMultithreadingSupported()
+{
+#if BT_THREADSAFE
+    return true;
+#else
+    return false;
+#endif
+}
+
 void PhysicsWorld::SetMaxNetworkAngularVelocity(float velocity)
 {
     maxNetworkAngularVelocity_ = Clamp(velocity, 1.0f, 32767.0f);
@@ -473,29 +775,7 @@ void PhysicsWorld::RaycastSingle(PhysicsRaycastResult& result, const Ray& ray, f
     if (maxDistance >= M_INFINITY)
         URHO3D_LOGWARNING("Infinite maxDistance in physics raycast is not supported");
 
-    btCollisionWorld::ClosestRayResultCallback
-        rayCallback(ToBtVector3(ray.origin_), ToBtVector3(ray.origin_ + maxDistance * ray.direction_));
-    rayCallback.m_collisionFilterGroup = (short)0xffff;
-    rayCallback.m_collisionFilterMask = (short)collisionMask;
-
-    world_->rayTest(rayCallback.m_rayFromWorld, rayCallback.m_rayToWorld, rayCallback);
-
-    if (rayCallback.hasHit())
-    {
-        result.position_ = ToVector3(rayCallback.m_hitPointWorld);
-        result.normal_ = ToVector3(rayCallback.m_hitNormalWorld);
-        result.distance_ = (result.position_ - ray.origin_).Length();
-        result.hitFraction_ = rayCallback.m_closestHitFraction;
-        result.body_ = static_cast<RigidBody*>(rayCallback.m_collisionObject->getUserPointer());
-    }
-    else
-    {
-        result.position_ = Vector3::ZERO;
-        result.normal_ = Vector3::ZERO;
-        result.distance_ = M_INFINITY;
-        result.hitFraction_ = 0.0f;
-        result.body_ = nullptr;
-    }
+    RaycastSingleImpl(world_.get(), result, ray, maxDistance, collisionMask);
 }
 
 void PhysicsWorld::RaycastSingleSegmented(PhysicsRaycastResult& result, const Ray& ray, float maxDistance, float segmentDistance, unsigned collisionMask, float overlapDistance)
@@ -557,33 +837,7 @@ void PhysicsWorld::SphereCast(PhysicsRaycastResult& result, const Ray& ray, floa
     if (maxDistance >= M_INFINITY)
         URHO3D_LOGWARNING("Infinite maxDistance in physics sphere cast is not supported");
 
-    btSphereShape shape(radius);
-    Vector3 endPos = ray.origin_ + maxDistance * ray.direction_;
-
-    btCollisionWorld::ClosestConvexResultCallback
-        convexCallback(ToBtVector3(ray.origin_), ToBtVector3(endPos));
-    convexCallback.m_collisionFilterGroup = (short)0xffff;
-    convexCallback.m_collisionFilterMask = (short)collisionMask;
-
-    world_->convexSweepTest(&shape, btTransform(btQuaternion::getIdentity(), convexCallback.m_convexFromWorld),
-        btTransform(btQuaternion::getIdentity(), convexCallback.m_convexToWorld), convexCallback);
-
-    if (convexCallback.hasHit())
-    {
-        result.body_ = static_cast<RigidBody*>(convexCallback.m_hitCollisionObject->getUserPointer());
-        result.position_ = ToVector3(convexCallback.m_hitPointWorld);
-        result.normal_ = ToVector3(convexCallback.m_hitNormalWorld);
-        result.distance_ = convexCallback.m_closestHitFraction * (endPos - ray.origin_).Length();
-        result.hitFraction_ = convexCallback.m_closestHitFraction;
-    }
-    else
-    {
-        result.body_ = nullptr;
-        result.position_ = Vector3::ZERO;
-        result.normal_ = Vector3::ZERO;
-        result.distance_ = M_INFINITY;
-        result.hitFraction_ = 0.0f;
-    }
+    SphereCastImpl(world_.get(), result, ray, radius, maxDistance, collisionMask);
 }
 
 void PhysicsWorld::ConvexCast(PhysicsRaycastResult& result, CollisionShape* shape, const Vector3& startPos,
@@ -680,11 +934,82 @@ void PhysicsWorld::ConvexCast(PhysicsRaycastResult& result, btCollisionShape* sh
     }
 }
 
+template <class T>
+void PhysicsWorld::ProcessQueryBatch(unsigned numQueries, const T& processQueries)
+{
+    if (simulating_)
+    {
+        URHO3D_LOGERROR("Physics queries cannot be processed while the world is being simulated");
+        return;
+    }
+
+    // Broadphase is safe to query from multiple threads only if Bullet is built with BT_THREADSAFE
+    auto workQueue = GetSubsystem<WorkQueue>();
+    if (IsMultithreadingSupported() && workQueue && workQueue->IsMultithreaded())
+        ForEachParallel(workQueue, QUERY_BATCH_BUCKET_SIZE, numQueries, processQueries);
+    else if (numQueries > 0)
+        processQueries(0, numQueries);
+}
+
+void PhysicsWorld::RaycastSingleBatch(ea::span<const PhysicsRaycastQuery> queries, ea::span<PhysicsRaycastResult> results)
+{
+    URHO3D_PROFILE("PhysicsRaycastSingleBatch");
+
+    URHO3D_ASSERT(queries.size() == results.size());
+    btCollisionWorld* world = world_.get();
+    ProcessQueryBatch(queries.size(),
+        [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            const PhysicsRaycastQuery& query = queries[i];
+            RaycastSingleImpl(world, results[i], query.ray_, query.maxDistance_, query.collisionMask_);
+        }
+    });
+}
+
+void PhysicsWorld::SphereCastBatch(ea::span<const PhysicsSphereCastQuery> queries, ea::span<PhysicsRaycastResult> results)
+{
+    URHO3D_PROFILE("PhysicsSphereCastBatch");
+
+    URHO3D_ASSERT(queries.size() == results.size());
+    btCollisionWorld* world = world_.get();
+    ProcessQueryBatch(queries.size(),
+        [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            const PhysicsSphereCastQuery& query = queries[i];
+            SphereCastImpl(world, results[i], query.ray_, query.radius_, query.maxDistance_, query.collisionMask_);
+        }
+    });
+}
+
+void PhysicsWorld::OverlapBatch(ea::span<const PhysicsOverlapQuery> queries, ea::span<RigidBody*> results)
+{
+    URHO3D_PROFILE("PhysicsOverlapBatch");
+
+    URHO3D_ASSERT(queries.size() == results.size());
+    btBroadphaseInterface* broadphase = world_->getBroadphase();
+    ProcessQueryBatch(queries.size(),
+        [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            const PhysicsOverlapQuery& query = queries[i];
+            const btVector3 aabbMin = ToBtVector3(query.box_.min_);
+            const btVector3 aabbMax = ToBtVector3(query.box_.max_);
+
+            PhysicsOverlapCallback callback(aabbMin, aabbMax, query.collisionMask_);
+            broadphase->aabbTest(aabbMin, aabbMax, callback);
+            results[i] = callback.result_;
+        }
+    });
+}
+
 void PhysicsWorld::RemoveCachedGeometry(Model* model)
 {
-    RemoveCachedGeometryImpl(triMeshCache_, model);
-    RemoveCachedGeometryImpl(convexCache_, model);
-    RemoveCachedGeometryImpl(gimpactTrimeshCache_, model);
+    geometryCache_->RemoveGeometry(model);
 }
 
 void PhysicsWorld::GetRigidBodies(ea::vector<RigidBody*>& result, const Sphere& sphere, unsigned collisionMask)
@@ -774,6 +1099,11 @@ Vector3 PhysicsWorld::GetGravity() const
     return ToVector3(world_->getGravity());
 }
 
+unsigned PhysicsWorld::GetNumSynchronizedBodies() const
+{
+    return static_cast<unsigned>(customWorld_->getNumSynchronizedBodies());
+}
+
 int PhysicsWorld::GetNumIterations() const
 {
     return world_->getSolverInfo().m_numIterations;
@@ -816,6 +1146,30 @@ void PhysicsWorld::RemoveConstraint(Constraint* constraint)
     constraints_.erase_first(constraint);
 }
 
+void PhysicsWorld::AddCharacterController(KinematicCharacterController* controller)
+{
+    if (!characterControllers_.contains(controller))
+        characterControllers_.push_back(controller);
+}
+
+void PhysicsWorld::RemoveCharacterController(KinematicCharacterController* controller)
+{
+    characterControllers_.erase_first(controller);
+}
+
+void PhysicsWorld::UpdateCharacterControllers(float timeStep)
+{
+    URHO3D_PROFILE("UpdateCharacterControllers");
+
+    // Sweeps share the broadphase and the dispatcher of the world, so characters are stepped one by one
+    numIdleCharacterControllers_ = 0;
+    for (KinematicCharacterController* controller : characterControllers_)
+    {
+        if (!controller->UpdateKinematic(timeStep, skipIdleCharacters_))
+            ++numIdleCharacterControllers_;
+    }
+}
+
 void PhysicsWorld::AddDelayedWorldTransform(const DelayedWorldTransform& transform)
 {
     delayedWorldTransforms_[transform.rigidBody_] = transform;
@@ -845,9 +1199,7 @@ btDiscreteDynamicsWorld* PhysicsWorld::GetWorld() const
 void PhysicsWorld::CleanupGeometryCache()
 {
     // Remove cached shapes whose only reference is the cache itself
-    CleanupGeometryCacheImpl(triMeshCache_);
-    CleanupGeometryCacheImpl(convexCache_);
-    CleanupGeometryCacheImpl(gimpactTrimeshCache_);
+    geometryCache_->Cleanup();
 }
 
 void PhysicsWorld::OnSceneSet(Scene* scene)
@@ -1177,7 +1529,12 @@ void PhysicsWorld::SendCollisionEvents()
 
 void RegisterPhysicsLibrary(Context* context)
 {
+    // Bullet objects are created only after registration, so the allocator may be replaced here
+    static const bool allocatorInstalled = (btAlignedAllocSetCustom(&AllocatePhysicsMemory, &FreePhysicsMemory), true);
+    (void)allocatorInstalled;
+
     CollisionShape::RegisterObject(context);
+    CollisionMeshCooker::RegisterObject(context);
     RigidBody::RegisterObject(context);
     Constraint::RegisterObject(context);
     PhysicsWorld::RegisterObject(context);
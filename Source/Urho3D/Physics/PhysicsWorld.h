@@ -26,6 +26,7 @@
 
 #include "../IO/VectorBuffer.h"
 #include "../Math/BoundingBox.h"
+#include "../Math/Ray.h"
 #include "../Math/Sphere.h"
 #include "../Math/Vector3.h"
 #include "../Replica/NetworkId.h"
@@ -41,24 +42,29 @@
 #endif
 
 #include <EASTL/optional.h>
+#include <EASTL/span.h>
 
 class btCollisionConfiguration;
 class btCollisionShape;
 class btBroadphaseInterface;
 class btConstraintSolver;
 class btDiscreteDynamicsWorld;
-class btCustomDiscreteDynamicsWorld;
+class btCustomSteppedWorld;
 class btDispatcher;
 class btDynamicsWorld;
 class btPersistentManifold;
 class btGhostPairCallback;
+class btActionInterface;
 
 namespace Urho3D
 {
 
+class CollisionGeometryCache;
 class CollisionShape;
 class Deserializer;
+struct DebugLine;
 class Constraint;
+class KinematicCharacterController;
 class Model;
 class Node;
 class Ray;
@@ -96,6 +102,39 @@ struct URHO3D_API PhysicsRaycastResult
     RigidBody* body_{};
 };
 
+/// Raycast query for batched physics raycasts.
+struct PhysicsRaycastQuery
+{
+    /// Ray in world space.
+    Ray ray_;
+    /// Max distance along the ray.
+    float maxDistance_{};
+    /// Collision mask of bodies to test.
+    unsigned collisionMask_{M_MAX_UNSIGNED};
+};
+
+/// Swept sphere query for batched physics sphere casts.
+struct PhysicsSphereCastQuery
+{
+    /// Ray of sphere movement in world space.
+    Ray ray_;
+    /// Sphere radius.
+    float radius_{};
+    /// Max distance along the ray.
+    float maxDistance_{};
+    /// Collision mask of bodies to test.
+    unsigned collisionMask_{M_MAX_UNSIGNED};
+};
+
+/// Overlap query for batched physics overlap tests.
+struct PhysicsOverlapQuery
+{
+    /// Bounding box in world space.
+    BoundingBox box_;
+    /// Collision mask of bodies to test.
+    unsigned collisionMask_{M_MAX_UNSIGNED};
+};
+
 /// Delayed world transform assignment for parented rigidbodies.
 struct DelayedWorldTransform
 {
@@ -140,9 +179,6 @@ struct PhysicsWorldConfig
 static const int DEFAULT_FPS = 60;
 static const float DEFAULT_MAX_NETWORK_ANGULAR_VELOCITY = 100.0f;
 
-/// Cache of collision geometry data.
-using CollisionGeometryDataCache = ea::unordered_map<ea::pair<Model*, unsigned>, SharedPtr<CollisionGeometryData> >;
-
 /// Physics simulation world component. Should be added only to the root scene node.
 class URHO3D_API PhysicsWorld : public Component, public btIDebugDraw
 {
@@ -187,6 +223,8 @@ public:
     void CustomUpdate(unsigned numSteps, float fixedTimeStep, float overtime, ea::optional<SynchronizedPhysicsStep> sync);
     /// Refresh collisions only without updating dynamics.
     void UpdateCollisions();
+    /// Refresh bounding boxes and overlapping pairs in the broadphase without narrowphase collision detection.
+    void UpdateOverlappingPairs();
     /// Set simulation substeps per second.
     /// @property
     void SetFps(int fps);
@@ -213,6 +251,10 @@ public:
     void SetSplitImpulse(bool enable);
     /// Set maximum angular velocity for network replication.
     void SetMaxNetworkAngularVelocity(float velocity);
+    /// Set whether to simulate in multiple threads of WorkQueue.
+    /// Should be set before physics objects are added to the world, requires Bullet built with BT_THREADSAFE.
+    /// @property
+    void SetMultithreaded(bool enable);
     /// Perform a physics world raycast and return all hits.
     void Raycast
         (ea::vector<PhysicsRaycastResult>& result, const Ray& ray, float maxDistance, unsigned collisionMask = M_MAX_UNSIGNED);
@@ -230,6 +272,18 @@ public:
     /// Perform a physics world swept convex test using a user-supplied Bullet collision shape and return the first hit.
     void ConvexCast(PhysicsRaycastResult& result, btCollisionShape* shape, const Vector3& startPos, const Quaternion& startRot,
         const Vector3& endPos, const Quaternion& endRot, unsigned collisionMask = M_MAX_UNSIGNED);
+    /// Perform physics world raycasts and return the closest hit for each query.
+    /// Results array should have the same size as queries array. Queries are executed in parallel on WorkQueue threads
+    /// if supported. Should not be called while the world is being simulated.
+    void RaycastSingleBatch(ea::span<const PhysicsRaycastQuery> queries, ea::span<PhysicsRaycastResult> results);
+    /// Perform physics world swept sphere tests and return the closest hit for each query.
+    /// Results array should have the same size as queries array. Queries are executed in parallel on WorkQueue threads
+    /// if supported. Should not be called while the world is being simulated.
+    void SphereCastBatch(ea::span<const PhysicsSphereCastQuery> queries, ea::span<PhysicsRaycastResult> results);
+    /// Perform physics world overlap tests and return any rigid body with collision shape bounding box overlapping the query box.
+    /// Results array should have the same size as queries array. Queries are executed in parallel on WorkQueue threads
+    /// if supported. Should not be called while the world is being simulated.
+    void OverlapBatch(ea::span<const PhysicsOverlapQuery> queries, ea::span<RigidBody*> results);
     /// Invalidate cached collision geometry for a model.
     void RemoveCachedGeometry(Model* model);
     /// Return rigid bodies by a sphere query.
@@ -253,6 +307,10 @@ public:
     /// @property
     int GetNumIterations() const;
 
+    /// Return number of active rigid bodies whose nodes were synchronized on the last simulation step.
+    /// Sleeping, static and kinematic bodies are skipped.
+    unsigned GetNumSynchronizedBodies() const;
+
     /// Return whether physics world will automatically simulate during scene update.
     /// @property
     bool IsUpdateEnabled() const { return updateEnabled_; }
@@ -275,6 +333,21 @@ public:
 
     /// Return maximum angular velocity for network replication.
     float GetMaxNetworkAngularVelocity() const { return maxNetworkAngularVelocity_; }
+    /// Return whether multithreaded simulation is requested.
+    /// @property
+    bool IsMultithreaded() const { return multithreaded_; }
+    /// Return whether Bullet is built with multithreading support.
+    static bool IsMultithreadingSupported();
+    /// Set whether to skip simulation of kinematic characters that rest on the ground and touch nothing moving.
+    /// @property
+    void SetSkipIdleCharacters(bool enable) { skipIdleCharacters_ = enable; }
+    /// Return whether to skip simulation of idle kinematic characters.
+    /// @property
+    bool GetSkipIdleCharacters() const { return skipIdleCharacters_; }
+    /// Return number of kinematic characters in the world.
+    unsigned GetNumCharacterControllers() const { return characterControllers_.size(); }
+    /// Return number of kinematic characters skipped on the last simulation step.
+    unsigned GetNumIdleCharacterControllers() const { return numIdleCharacterControllers_; }
 
     /// Add a rigid body to keep track of. Called by RigidBody.
     void AddRigidBody(RigidBody* body);
@@ -288,6 +361,12 @@ public:
     void AddConstraint(Constraint* constraint);
     /// Remove a constraint. Called by Constraint.
     void RemoveConstraint(Constraint* constraint);
+    /// Add a kinematic character to be simulated. Called by KinematicCharacterController.
+    void AddCharacterController(KinematicCharacterController* controller);
+    /// Remove a kinematic character. Called by KinematicCharacterController.
+    void RemoveCharacterController(KinematicCharacterController* controller);
+    /// Simulate all kinematic characters for one step. Called from the Bullet world step.
+    void UpdateCharacterControllers(float timeStep);
     /// Add a delayed world transform assignment. Called by RigidBody.
     void AddDelayedWorldTransform(const DelayedWorldTransform& transform);
     /// Add debug geometry to the debug renderer.
@@ -303,14 +382,8 @@ public:
     /// Clean up the geometry cache.
     void CleanupGeometryCache();
 
-    /// Return trimesh collision geometry cache.
-    CollisionGeometryDataCache& GetTriMeshCache() { return triMeshCache_; }
-
-    /// Return convex collision geometry cache.
-    CollisionGeometryDataCache& GetConvexCache() { return convexCache_; }
-
-    /// Return GImpact trimesh collision geometry cache.
-    CollisionGeometryDataCache& GetGImpactTrimeshCache() { return gimpactTrimeshCache_; }
+    /// Return collision geometry cache shared by all physics worlds.
+    CollisionGeometryCache* GetGeometryCache() const { return geometryCache_; }
 
     /// Set node dirtying to be disregarded.
     void SetApplyingTransforms(bool enable) { applyingTransforms_ = enable; }
@@ -342,6 +415,10 @@ private:
     /// Send accumulated collision events.
     void SendCollisionEvents();
     void ApplyDelayedWorldTransforms();
+    /// Process batched queries in parallel if supported.
+    template <class T> void ProcessQueryBatch(unsigned numQueries, const T& processQueries);
+    /// Create Bullet world and corresponding objects. Previous world should not contain any objects.
+    void CreateWorld();
 
     /// Bullet collision configuration.
     btCollisionConfiguration* collisionConfiguration_{};
@@ -352,7 +429,9 @@ private:
     /// Bullet constraint solver.
     ea::unique_ptr<btConstraintSolver> solver_;
     /// Bullet physics world.
-    ea::unique_ptr<btCustomDiscreteDynamicsWorld> world_;
+    ea::unique_ptr<btDiscreteDynamicsWorld> world_;
+    /// Bullet physics world interface for custom stepping. Points to the same object as world_.
+    btCustomSteppedWorld* customWorld_{};
     /// Extra weak pointer to scene to allow for cleanup in case the world is destroyed before other components.
     WeakPtr<Scene> scene_;
     /// Rigid bodies in the world.
@@ -361,18 +440,20 @@ private:
     ea::vector<CollisionShape*> collisionShapes_;
     /// Constraints in the world.
     ea::vector<Constraint*> constraints_;
+    /// Kinematic characters in the world.
+    ea::vector<KinematicCharacterController*> characterControllers_;
+    /// Bullet action that simulates all kinematic characters in one pass.
+    ea::unique_ptr<btActionInterface> characterControllerBatch_;
+    /// Number of kinematic characters skipped on the last simulation step.
+    unsigned numIdleCharacterControllers_{};
     /// Collision pairs on this frame.
     ea::unordered_map<ea::pair<WeakPtr<RigidBody>, WeakPtr<RigidBody> >, ManifoldPair> currentCollisions_;
     /// Collision pairs on the previous frame. Used to check if a collision is "new." Manifolds are not guaranteed to exist anymore.
     ea::unordered_map<ea::pair<WeakPtr<RigidBody>, WeakPtr<RigidBody> >, ManifoldPair> previousCollisions_;
     /// Delayed (parented) world transform assignments.
     ea::unordered_map<RigidBody*, DelayedWorldTransform> delayedWorldTransforms_;
-    /// Cache for trimesh geometry data by model and LOD level.
-    CollisionGeometryDataCache triMeshCache_;
-    /// Cache for convex geometry data by model and LOD level.
-    CollisionGeometryDataCache convexCache_;
-    /// Cache for GImpact trimesh geometry data by model and LOD level.
-    CollisionGeometryDataCache gimpactTrimeshCache_;
+    /// Cache for collision geometry data by model and LOD level, shared by all physics worlds.
+    SharedPtr<CollisionGeometryCache> geometryCache_;
     /// Preallocated event data map for physics collision events.
     VariantMap physicsCollisionData_;
     /// Preallocated event data map for node collision events.
@@ -395,6 +476,10 @@ private:
     bool interpolation_{true};
     /// Use internal edge utility flag.
     bool internalEdge_{true};
+    /// Multithreaded simulation flag.
+    bool multithreaded_{};
+    /// Whether to skip simulation of idle kinematic characters.
+    bool skipIdleCharacters_{};
     /// Applying transforms flag.
     bool applyingTransforms_{};
     /// Simulating flag.
@@ -403,6 +488,10 @@ private:
     bool debugDepthTest_{};
     /// Debug renderer.
     DebugRenderer* debugRenderer_{};
+    /// Lines collected during DrawDebugGeometry, submitted to the debug renderer in one batch.
+    ea::vector<DebugLine>* debugLines_{};
+    /// Number of debug lines in the last DrawDebugGeometry call.
+    unsigned numDebugLines_{};
     /// Debug draw flags.
     int debugMode_{};
     /// GhostPair Callback
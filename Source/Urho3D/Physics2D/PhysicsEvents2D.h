@@ -45,6 +45,15 @@ URHO3D_EVENT(E_PHYSICSUPDATECONTACT2D, PhysicsUpdateContact2D)
     URHO3D_PARAM(P_ENABLED, Enabled);              // bool [in/out]
 }
 
+/// Physics contacts of the step. Global event sent by PhysicsWorld2D once per step before per-contact events, if there were any.
+/// Contacts are accessible via PhysicsWorld2D::GetBeginContacts and PhysicsWorld2D::GetEndContacts.
+URHO3D_EVENT(E_PHYSICSCONTACTS2D, PhysicsContacts2D)
+{
+    URHO3D_PARAM(P_WORLD, World);                  // PhysicsWorld2D pointer
+    URHO3D_PARAM(P_NUMBEGINCONTACTS, NumBeginContacts); // unsigned
+    URHO3D_PARAM(P_NUMENDCONTACTS, NumEndContacts); // unsigned
+}
+
 /// Physics begin contact. Global event sent by PhysicsWorld2D.
 URHO3D_EVENT(E_PHYSICSBEGINCONTACT2D, PhysicsBeginContact2D)
 {
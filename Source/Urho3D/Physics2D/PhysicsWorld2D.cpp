@@ -84,6 +84,7 @@ void PhysicsWorld2D::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Sub Stepping", GetSubStepping, SetSubStepping, bool, false, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Gravity", GetGravity, SetGravity, Vector2, DEFAULT_GRAVITY, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Auto Clear Forces", GetAutoClearForces, SetAutoClearForces, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Per-Contact Events", GetPerContactEvents, SetPerContactEvents, bool, true, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Velocity Iterations", GetVelocityIterations, SetVelocityIterations, int, DEFAULT_VELOCITY_ITERATIONS,
         AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Position Iterations", GetPositionIterations, SetPositionIterations, int, DEFAULT_POSITION_ITERATIONS,
@@ -132,6 +133,9 @@ void PhysicsWorld2D::EndContact(b2Contact* contact)
 
 void PhysicsWorld2D::PreSolve(b2Contact* contact, const b2Manifold* oldManifold)
 {
+    if (!perContactEvents_)
+        return;
+
     b2Fixture* fixtureA = contact->GetFixtureA();
     b2Fixture* fixtureB = contact->GetFixtureB();
     if (!fixtureA || !fixtureB)
@@ -293,19 +297,14 @@ void PhysicsWorld2D::Update(float timeStep)
     world_->Step(timeStep, velocityIterations_, positionIterations_);
     physicsStepping_ = false;
 
-    // Apply world transforms. Unparented transforms first
-    for (unsigned i = 0; i < rigidBodies_.size();)
+    // Erase possible stale weak pointers in one pass
+    ea::erase_if(rigidBodies_, [](const WeakPtr<RigidBody2D>& rigidBody) { return !rigidBody; });
+
+    // Apply world transforms of awake bodies. Unparented transforms first
+    for (unsigned i = 0; i < rigidBodies_.size(); ++i)
     {
         if (rigidBodies_[i])
-        {
             rigidBodies_[i]->ApplyWorldTransform();
-            ++i;
-        }
-        else
-        {
-            // Erase possible stale weak pointer
-            rigidBodies_.erase_at(i);
-        }
     }
 
     // Apply delayed (parented) world transforms now, if any
@@ -327,8 +326,7 @@ void PhysicsWorld2D::Update(float timeStep)
         }
     }
 
-    SendBeginContactEvents();
-    SendEndContactEvents();
+    SendContactEvents();
 
     {
         VariantMap& eventData = GetEventDataMap();
@@ -729,6 +727,30 @@ void PhysicsWorld2D::HandleSceneSubsystemUpdate(StringHash eventType, VariantMap
     Update(eventData[P_TIMESTEP].GetFloat());
 }
 
+void PhysicsWorld2D::SendContactEvents()
+{
+    if (beginContactInfos_.empty() && endContactInfos_.empty())
+        return;
+
+    {
+        using namespace PhysicsContacts2D;
+        VariantMap& eventData = GetEventDataMap();
+        eventData[P_WORLD] = this;
+        eventData[P_NUMBEGINCONTACTS] = static_cast<unsigned>(beginContactInfos_.size());
+        eventData[P_NUMENDCONTACTS] = static_cast<unsigned>(endContactInfos_.size());
+        SendEvent(E_PHYSICSCONTACTS2D, eventData);
+    }
+
+    if (perContactEvents_)
+    {
+        SendBeginContactEvents();
+        SendEndContactEvents();
+    }
+
+    beginContactInfos_.clear();
+    endContactInfos_.clear();
+}
+
 void PhysicsWorld2D::SendBeginContactEvents()
 {
     if (beginContactInfos_.empty())
@@ -72,6 +72,38 @@ class URHO3D_API PhysicsWorld2D : public Component, public b2ContactListener, pu
     URHO3D_OBJECT(PhysicsWorld2D, Component);
 
 public:
+    /// Contact info. Contacts of the last step are accessible during E_PHYSICSCONTACTS2D event.
+    struct ContactInfo
+    {
+        /// Construct.
+        ContactInfo();
+        /// Construct.
+        explicit ContactInfo(b2Contact* contact);
+        /// Write contact info to buffer.
+        const ea::vector<unsigned char>& Serialize(VectorBuffer& buffer) const;
+
+        /// Rigid body A.
+        SharedPtr<RigidBody2D> bodyA_;
+        /// Rigid body B.
+        SharedPtr<RigidBody2D> bodyB_;
+        /// Node A.
+        SharedPtr<Node> nodeA_;
+        /// Node B.
+        SharedPtr<Node> nodeB_;
+        /// Shape A.
+        SharedPtr<CollisionShape2D> shapeA_;
+        /// Shape B.
+        SharedPtr<CollisionShape2D> shapeB_;
+        /// Number of contact points.
+        int numPoints_{};
+        /// Contact normal in world space.
+        Vector2 worldNormal_;
+        /// Contact positions in world space.
+        Vector2 worldPositions_[b2_maxManifoldPoints];
+        /// Contact overlap values.
+        float separations_[b2_maxManifoldPoints]{};
+    };
+
     /// Construct.
     explicit PhysicsWorld2D(Context* context);
     /// Destruct.
@@ -153,6 +185,10 @@ public:
     /// Set position iterations.
     /// @property
     void SetPositionIterations(int positionIterations);
+    /// Set whether to send begin, end and update events for each contact.
+    /// If disabled, only E_PHYSICSCONTACTS2D is sent once per step and contacts cannot be disabled from events.
+    /// @property
+    void SetPerContactEvents(bool enable) { perContactEvents_ = enable; }
     /// Add rigid body.
     void AddRigidBody(RigidBody2D* rigidBody);
     /// Remove rigid body.
@@ -221,6 +257,14 @@ public:
     /// @property
     int GetVelocityIterations() const { return velocityIterations_; }
 
+    /// Return whether to send events for each contact.
+    /// @property
+    bool GetPerContactEvents() const { return perContactEvents_; }
+    /// Return contacts that began on the last step.
+    const ea::vector<ContactInfo>& GetBeginContacts() const { return beginContactInfos_; }
+    /// Return contacts that ended on the last step.
+    const ea::vector<ContactInfo>& GetEndContacts() const { return endContactInfos_; }
+
     /// Return position iterations.
     /// @property
     int GetPositionIterations() const { return positionIterations_; }
@@ -240,6 +284,8 @@ protected:
 
     /// Handle the scene subsystem update event, step simulation here.
     void HandleSceneSubsystemUpdate(StringHash eventType, VariantMap& eventData);
+    /// Send batched contact event and per-contact events, if enabled.
+    void SendContactEvents();
     /// Send begin contact events.
     void SendBeginContactEvents();
     /// Send end contact events.
@@ -263,6 +309,8 @@ protected:
 
     /// Automatic simulation update enabled flag.
     bool updateEnabled_{true};
+    /// Whether to send events for each contact.
+    bool perContactEvents_{true};
     /// Whether is currently stepping the world. Used internally.
     bool physicsStepping_{};
     /// Applying transforms.
@@ -272,37 +320,6 @@ protected:
     /// Delayed (parented) world transform assignments.
     ea::unordered_map<RigidBody2D*, DelayedWorldTransform2D> delayedWorldTransforms_;
 
-    /// Contact info.
-    struct ContactInfo
-    {
-        /// Construct.
-        ContactInfo();
-        /// Construct.
-        explicit ContactInfo(b2Contact* contact);
-        /// Write contact info to buffer.
-        const ea::vector<unsigned char>& Serialize(VectorBuffer& buffer) const;
-
-        /// Rigid body A.
-        SharedPtr<RigidBody2D> bodyA_;
-        /// Rigid body B.
-        SharedPtr<RigidBody2D> bodyB_;
-        /// Node A.
-        SharedPtr<Node> nodeA_;
-        /// Node B.
-        SharedPtr<Node> nodeB_;
-        /// Shape A.
-        SharedPtr<CollisionShape2D> shapeA_;
-        /// Shape B.
-        SharedPtr<CollisionShape2D> shapeB_;
-        /// Number of contact points.
-        int numPoints_{};
-        /// Contact normal in world space.
-        Vector2 worldNormal_;
-        /// Contact positions in world space.
-        Vector2 worldPositions_[b2_maxManifoldPoints];
-        /// Contact overlap values.
-        float separations_[b2_maxManifoldPoints]{};
-    };
     /// Begin contact infos.
     ea::vector<ContactInfo> beginContactInfos_;
     /// End contact infos.
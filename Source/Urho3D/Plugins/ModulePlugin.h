@@ -42,6 +42,7 @@ public:
     bool IsLoaded() const override;
     bool IsOutOfDate() const override;
     bool WaitForCompleteFile(unsigned timeoutMs) const override;
+    bool SupportsPartialReload() const override { return lastModuleType_ == MODULE_NATIVE; }
     bool PerformUnload() override;
     /// @}
 
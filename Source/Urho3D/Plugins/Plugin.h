@@ -60,6 +60,9 @@ public:
     /// This function will block until plugin file is complete and ready to be loaded.
     /// Returns false if timeout exceeded, but file is still incomplete.
     virtual bool WaitForCompleteFile(unsigned timeoutMs) const { return true; }
+    /// Returns true if plugin can be reloaded without reloading unrelated plugins.
+    /// All objects created by the plugin should be registered via PluginApplication.
+    virtual bool SupportsPartialReload() const { return false; }
 
     /// Actually unloads the module. Called by %PluginManager at the end of frame when IsUnloading is true.
     virtual bool PerformUnload() { return true; }
@@ -79,6 +79,8 @@ public:
     bool IsLoaded() const { return isLoaded_; }
     /// Return whether the application is started.
     bool IsStarted() const { return isStarted_; }
+    /// Return types registered by the plugin that are unregistered on unload.
+    const ea::vector<StringHash>& GetReflectedTypes() const { return reflectedTypes_; }
 
     /// Register a factory for an object type that would be automatically unregistered on unload.
     template<typename T> ObjectReflection* AddFactoryReflection();
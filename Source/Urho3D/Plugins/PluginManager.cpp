@@ -77,19 +77,16 @@ ea::string PathToName(const ea::string& path)
 
 PluginStack::PluginStack(PluginManager* manager, const StringVector& plugins)
     : Object(manager->GetContext())
+    , manager_(manager)
 {
     for (const ea::string& name : plugins)
     {
         unsigned version{};
         if (const WeakPtr<PluginApplication> application{manager->GetPluginApplication(name, false, &version)})
-        {
-            const PluginInfo info{name, version, application};
-            applications_.push_back(info);
-            if (application->IsMain())
-                mainApplications_.push_back(info);
-        }
+            applications_.push_back(PluginInfo{name, version, application});
     }
 
+    UpdateMainPlugins();
     LoadPlugins();
 }
 
@@ -118,6 +115,23 @@ void PluginStack::UnloadPlugins()
     }
 }
 
+void PluginStack::UpdateMainPlugins()
+{
+    mainApplications_.clear();
+    for (const PluginInfo& info : applications_)
+    {
+        if (info.application_ && info.application_->IsMain())
+            mainApplications_.push_back(info);
+    }
+
+    if (!mainApplicationName_.empty())
+    {
+        const auto iter = ea::find_if(mainApplications_.begin(), mainApplications_.end(),
+            [&](const PluginInfo& info) { return info.name_ == mainApplicationName_; });
+        mainApplication_ = iter != mainApplications_.end() ? iter->application_ : nullptr;
+    }
+}
+
 PluginApplication* PluginStack::FindMainPlugin(const ea::string& mainPlugin) const
 {
     if (!mainPlugin.empty())
@@ -149,6 +163,12 @@ void PluginStack::StartApplication(const ea::string& mainPlugin)
     }
 
     mainApplication_ = FindMainPlugin(mainPlugin);
+    mainApplicationName_.clear();
+    for (const PluginInfo& info : mainApplications_)
+    {
+        if (info.application_ == mainApplication_)
+            mainApplicationName_ = info.name_;
+    }
 
     for (const PluginInfo& info : applications_)
     {
@@ -224,6 +244,87 @@ void PluginStack::StopApplication()
     }
 }
 
+unsigned PluginStack::FindFirstPlugin(const StringVector& names) const
+{
+    for (unsigned index = 0; index < applications_.size(); ++index)
+    {
+        if (names.contains(applications_[index].name_))
+            return index;
+    }
+    return applications_.size();
+}
+
+ea::vector<StringHash> PluginStack::GetReflectedTypes(unsigned firstIndex) const
+{
+    ea::vector<StringHash> result;
+    for (unsigned index = firstIndex; index < applications_.size(); ++index)
+    {
+        if (PluginApplication* application = applications_[index].application_)
+        {
+            const auto& types = application->GetReflectedTypes();
+            result.insert(result.end(), types.begin(), types.end());
+        }
+    }
+    return result;
+}
+
+SerializedPlugins PluginStack::UnloadPlugins(unsigned firstIndex)
+{
+    SerializedPlugins data;
+    for (unsigned index = applications_.size(); index-- > firstIndex;)
+    {
+        const PluginInfo& info = applications_[index];
+        if (!info.application_)
+            continue;
+
+        if (isStarted_)
+        {
+            BinaryOutputArchive archive{context_, data[info.name_]};
+            info.application_->SuspendApplication(archive, info.version_);
+        }
+        info.application_->UnloadPlugin();
+    }
+    return data;
+}
+
+void PluginStack::ReloadPlugins(unsigned firstIndex, const SerializedPlugins& serializedPlugins)
+{
+    // Plugin applications are recreated when modules are reloaded
+    for (unsigned index = firstIndex; index < applications_.size(); ++index)
+    {
+        PluginInfo& info = applications_[index];
+        info.application_ = manager_->GetPluginApplication(info.name_, true, &info.version_);
+    }
+    UpdateMainPlugins();
+
+    for (unsigned index = firstIndex; index < applications_.size(); ++index)
+    {
+        const PluginInfo& info = applications_[index];
+        if (info.application_)
+            info.application_->LoadPlugin();
+    }
+
+    if (!isStarted_)
+        return;
+
+    for (unsigned index = firstIndex; index < applications_.size(); ++index)
+    {
+        const PluginInfo& info = applications_[index];
+        if (!info.application_)
+            continue;
+
+        const auto iter = serializedPlugins.find(info.name_);
+        if (iter == serializedPlugins.end())
+            info.application_->ResumeApplication(nullptr, info.version_);
+        else
+        {
+            MemoryBuffer dataView{iter->second.GetBuffer()};
+            BinaryInputArchive archive{context_, dataView};
+            info.application_->ResumeApplication(&archive, info.version_);
+        }
+    }
+}
+
 PluginApplication* PluginStack::GetMainPlugin() const
 {
     return mainApplication_;
@@ -464,6 +565,9 @@ void PluginManager::Update(bool exiting)
     if (checkOutOfDate)
         reloadTimer_.Reset();
 
+    if (checkOutOfDate && !forceReload_ && pluginStack_)
+        ReloadOutOfDatePlugins();
+
     for (const auto& [name, plugin] : dynamicPlugins_)
         UpdatePlugin(plugin, checkOutOfDate);
     forceReload_ = false;
@@ -491,7 +595,6 @@ void PluginManager::UpdatePlugin(Plugin* plugin, bool checkOutOfDate)
     if (!plugin->GetApplication())
         return;
 
-    const bool wasApplicationLoaded = plugin->GetApplication()->IsLoaded();
     const bool pluginOutOfDate = forceReload_ || (checkOutOfDate && plugin->IsOutOfDate());
 
     if (plugin->IsUnloading() || pluginOutOfDate)
@@ -501,6 +604,53 @@ void PluginManager::UpdatePlugin(Plugin* plugin, bool checkOutOfDate)
         TryReloadPlugin(plugin);
 }
 
+void PluginManager::ReloadOutOfDatePlugins()
+{
+    ea::vector<Plugin*> outOfDatePlugins;
+    StringVector names;
+    for (const auto& [name, plugin] : dynamicPlugins_)
+    {
+        if (plugin->GetApplication() && !plugin->IsUnloading() && plugin->IsOutOfDate())
+        {
+            outOfDatePlugins.push_back(plugin);
+            names.push_back(name);
+        }
+    }
+
+    // Fall back to full reload if any plugin cannot be reloaded alone
+    const auto supportsPartialReload = [](const Plugin* plugin) { return plugin->SupportsPartialReload(); };
+    if (outOfDatePlugins.empty() || !ea::all_of(outOfDatePlugins.begin(), outOfDatePlugins.end(), supportsPartialReload))
+        return;
+
+    // Plugins loaded after the modified one may depend on it, reload them too. Earlier plugins are kept intact.
+    const unsigned firstIndex = pluginStack_->FindFirstPlugin(names);
+    reloadingTypes_ = pluginStack_->GetReflectedTypes(firstIndex);
+
+    {
+        using namespace BeginPluginReload;
+        VariantMap& eventData = GetEventDataMap();
+        eventData[P_PARTIAL] = true;
+        SendEvent(E_BEGINPLUGINRELOAD, eventData);
+    }
+
+    const SerializedPlugins serializedPlugins = pluginStack_->UnloadPlugins(firstIndex);
+    for (Plugin* plugin : outOfDatePlugins)
+    {
+        plugin->PerformUnload();
+        TryReloadPlugin(plugin);
+    }
+    pluginStack_->ReloadPlugins(firstIndex, serializedPlugins);
+
+    {
+        using namespace EndPluginReload;
+        VariantMap& eventData = GetEventDataMap();
+        eventData[P_PARTIAL] = true;
+        SendEvent(E_ENDPLUGINRELOAD, eventData);
+    }
+
+    reloadingTypes_.clear();
+}
+
 void PluginManager::PerformPluginUnload(Plugin* plugin)
 {
     if (pluginStack_)
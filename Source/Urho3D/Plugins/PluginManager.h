@@ -55,6 +55,15 @@ public:
     /// Stop plugin application for all loaded plugins.
     void StopApplication();
 
+    /// Return index of the first plugin from the list or number of plugins if none is found.
+    unsigned FindFirstPlugin(const StringVector& names) const;
+    /// Return types registered by the plugins starting from given index.
+    ea::vector<StringHash> GetReflectedTypes(unsigned firstIndex) const;
+    /// Suspend and unload plugins starting from given index. The rest of the stack is kept intact.
+    SerializedPlugins UnloadPlugins(unsigned firstIndex);
+    /// Load and resume plugins starting from given index after their modules are reloaded.
+    void ReloadPlugins(unsigned firstIndex, const SerializedPlugins& serializedPlugins);
+
     /// Return whether the application is started now.
     bool IsStarted() const { return isStarted_; }
     /// Return number of loaded plugins.
@@ -73,11 +82,14 @@ private:
 
     void LoadPlugins();
     void UnloadPlugins();
+    void UpdateMainPlugins();
     PluginApplication* FindMainPlugin(const ea::string& mainPlugin) const;
 
+    PluginManager* manager_{};
     ea::vector<PluginInfo> applications_;
     ea::vector<PluginInfo> mainApplications_;
     WeakPtr<PluginApplication> mainApplication_;
+    ea::string mainApplicationName_;
     bool isStarted_{};
 };
 
@@ -115,6 +127,8 @@ public:
     unsigned GetRevision() const { return revision_; }
     /// Return whether the load is pending at the end of the frame.
     bool IsReloadPending() const { return stackReloadPending_; }
+    /// Return types that are unloaded by current partial reload. Valid between E_BEGINPLUGINRELOAD and E_ENDPLUGINRELOAD.
+    const ea::vector<StringHash>& GetReloadingTypes() const { return reloadingTypes_; }
 
     /// Manually add new plugin with dynamic reloading.
     bool AddDynamicPlugin(Plugin* plugin);
@@ -137,6 +151,7 @@ private:
 
     void Update(bool exiting);
     void UpdatePlugin(Plugin* plugin, bool checkOutOfDate);
+    void ReloadOutOfDatePlugins();
 
     void PerformPluginUnload(Plugin* plugin);
     void TryReloadPlugin(Plugin* plugin);
@@ -170,6 +185,7 @@ private:
 
     SerializedPlugins restoreBuffer_;
     bool wasStarted_{};
+    ea::vector<StringHash> reloadingTypes_;
 
     /// Currently loaded modules
     /// @{
@@ -39,6 +39,12 @@ struct ConstantBufferCollectionRef
     unsigned offset_;
     /// Size of the chunk.
     unsigned size_;
+
+    bool operator==(const ConstantBufferCollectionRef& rhs) const
+    {
+        return index_ == rhs.index_ && offset_ == rhs.offset_ && size_ == rhs.size_;
+    }
+    bool operator!=(const ConstantBufferCollectionRef& rhs) const { return !(*this == rhs); }
 };
 
 /// Buffer of shader parameters ready to be uploaded.
@@ -14,6 +14,8 @@
 
 #include <Diligent/Graphics/GraphicsEngine/interface/DeviceContext.h>
 
+#include <EASTL/unordered_map.h>
+
 #include "Urho3D/DebugNew.h"
 
 namespace Urho3D
@@ -70,6 +72,70 @@ void DrawCommandQueue::Reset()
     scissorRects_.push_back(IntRect::ZERO);
 }
 
+void DrawCommandQueue::InheritState(const DrawCommandQueue& parent)
+{
+    clipPlaneMask_ = parent.clipPlaneMask_;
+    currentDrawCommand_.stencilRef_ = parent.currentDrawCommand_.stencilRef_;
+    if (parent.currentDrawCommand_.scissorRect_ != 0)
+        SetScissorRect(parent.scissorRects_[parent.currentDrawCommand_.scissorRect_]);
+}
+
+void DrawCommandQueue::Append(const DrawCommandQueue& other)
+{
+    URHO3D_ASSERT(currentShaderResourceGroup_.first == currentShaderResourceGroup_.second
+        && currentUnorderedAccessViewGroup_.first == currentUnorderedAccessViewGroup_.second,
+        "Shader resources should be committed before appending another queue");
+
+    const unsigned shaderResourcesOffset = shaderResources_.size();
+    const unsigned unorderedAccessViewsOffset = unorderedAccessViews_.size();
+    // First scissor rect is always empty and is shared
+    const unsigned scissorRectsOffset = scissorRects_.size() - 1;
+
+    shaderResources_.insert(shaderResources_.end(), other.shaderResources_.begin(), other.shaderResources_.end());
+    unorderedAccessViews_.insert(
+        unorderedAccessViews_.end(), other.unorderedAccessViews_.begin(), other.unorderedAccessViews_.end());
+    scissorRects_.insert(scissorRects_.end(), other.scissorRects_.begin() + 1, other.scissorRects_.end());
+
+    // Blocks of shader parameters are usually shared by many draw commands, copy each block once
+    ea::unordered_map<unsigned long long, ConstantBufferCollectionRef> copiedBlocks;
+    const auto copyBlock = [&](const ConstantBufferCollectionRef& ref)
+    {
+        if (ref.size_ == 0)
+            return ref;
+
+        const unsigned long long key = (static_cast<unsigned long long>(ref.index_) << 32) | ref.offset_;
+        const auto iter = copiedBlocks.find(key);
+        if (iter != copiedBlocks.end())
+            return iter->second;
+
+        const auto [newRef, data] = constantBuffers_.collection_.AddBlock(ref.size_);
+        const auto sourceData = static_cast<const unsigned char*>(other.constantBuffers_.collection_.GetBufferData(ref.index_));
+        memcpy(data, sourceData + ref.offset_, ref.size_);
+        copiedBlocks.emplace(key, newRef);
+        return newRef;
+    };
+
+    drawCommands_.reserve(drawCommands_.size() + other.drawCommands_.size());
+    for (DrawCommandDescription cmd : other.drawCommands_)
+    {
+        for (ConstantBufferCollectionRef& ref : cmd.constantBuffers_)
+            ref = copyBlock(ref);
+
+        cmd.shaderResources_.first += shaderResourcesOffset;
+        cmd.shaderResources_.second += shaderResourcesOffset;
+        cmd.unorderedAccessViews_.first += unorderedAccessViewsOffset;
+        cmd.unorderedAccessViews_.second += unorderedAccessViewsOffset;
+        if (cmd.scissorRect_ != 0)
+            cmd.scissorRect_ += scissorRectsOffset;
+
+        drawCommands_.push_back(cmd);
+    }
+
+    // Resources added after this call should not overlap with appended ones
+    currentShaderResourceGroup_.first = currentShaderResourceGroup_.second = shaderResources_.size();
+    currentUnorderedAccessViewGroup_.first = currentUnorderedAccessViewGroup_.second = unorderedAccessViews_.size();
+}
+
 void DrawCommandQueue::ExecuteInContext(RenderContext* renderContext)
 {
     if (drawCommands_.empty())
@@ -116,6 +182,8 @@ void DrawCommandQueue::ExecuteInContext(RenderContext* renderContext)
     RawVertexBufferArray currentVertexBuffers{};
     ShaderResourceRange currentShaderResources;
     ShaderResourceRange currentUnorderedAccessViews;
+    ea::array<ConstantBufferCollectionRef, MAX_SHADER_PARAMETER_GROUPS> currentConstantBuffers{};
+    bool shaderResourcesDirty = true;
     unsigned currentScissorRect = M_MAX_UNSIGNED;
     ea::optional<unsigned> currentStencilRef;
 
@@ -148,6 +216,8 @@ void DrawCommandQueue::ExecuteInContext(RenderContext* renderContext)
             // Reset current shader resources because mapping can be different
             currentShaderResources = {};
             currentUnorderedAccessViews = {};
+            currentConstantBuffers.fill(ConstantBufferCollectionRef{M_MAX_UNSIGNED, M_MAX_UNSIGNED, M_MAX_UNSIGNED});
+            shaderResourcesDirty = true;
         }
 
         // Set scissor
@@ -219,6 +289,7 @@ void DrawCommandQueue::ExecuteInContext(RenderContext* renderContext)
                 shaderResources_[i].variable_->Set(temp_.shaderResourceViews_[i]);
 
             currentShaderResources = cmd.shaderResources_;
+            shaderResourcesDirty = true;
         }
 
         if (currentUnorderedAccessViews != cmd.unorderedAccessViews_)
@@ -227,38 +298,82 @@ void DrawCommandQueue::ExecuteInContext(RenderContext* renderContext)
             {
                 const UnorderedAccessViewData& data = unorderedAccessViews_[i];
 
-                RawTexture* texture = data.texture_;
-                if (texture->GetResolveDirty())
-                    texture->Resolve();
-                if (texture->GetLevelsDirty())
-                    texture->GenerateLevels();
+                if (RawTexture* texture = data.texture_)
+                {
+                    if (texture->GetResolveDirty())
+                        texture->Resolve();
+                    if (texture->GetLevelsDirty())
+                        texture->GenerateLevels();
+                }
+                else if (data.buffer_)
+                    data.buffer_->Resolve();
 
                 data.variable_->Set(data.view_);
             }
 
             currentUnorderedAccessViews = cmd.unorderedAccessViews_;
+            shaderResourcesDirty = true;
         }
 
         for (unsigned i = 0; i < MAX_SHADER_PARAMETER_GROUPS; ++i)
         {
             const auto group = static_cast<ShaderParameterGroup>(i);
             const UniformBufferReflection* uniformBufferReflection = currentShaderReflection->GetUniformBuffer(group);
-            if (!uniformBufferReflection)
+            const ConstantBufferCollectionRef& ref = cmd.constantBuffers_[i];
+            ConstantBufferCollectionRef& currentRef = currentConstantBuffers[i];
+            if (!uniformBufferReflection || currentRef == ref)
                 continue;
 
-            Diligent::IBuffer* uniformBuffer = temp_.uniformBuffers_[cmd.constantBuffers_[i].index_];
-            for (Diligent::IShaderResourceVariable* variable : uniformBufferReflection->variables_)
+            // Bind buffer range once and select blocks within the same buffer by dynamic offset.
+            // Changing dynamic offset doesn't require committing shader resources.
+            if (currentRef.index_ != ref.index_ || currentRef.size_ != ref.size_)
             {
-                variable->SetBufferRange(uniformBuffer, cmd.constantBuffers_[i].offset_, cmd.constantBuffers_[i].size_);
+                Diligent::IBuffer* uniformBuffer = temp_.uniformBuffers_[ref.index_];
+                for (Diligent::IShaderResourceVariable* variable : uniformBufferReflection->variables_)
+                    variable->SetBufferRange(uniformBuffer, 0, ref.size_);
+                shaderResourcesDirty = true;
             }
+
+            for (Diligent::IShaderResourceVariable* variable : uniformBufferReflection->variables_)
+                variable->SetBufferOffset(ref.offset_);
+
+            currentRef = ref;
         }
 
-        deviceContext->CommitShaderResources(
-            currentShaderResourceBinding, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        // Skip commit if bindings are the same as for previous draw
+        if (shaderResourcesDirty)
+        {
+            deviceContext->CommitShaderResources(
+                currentShaderResourceBinding, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            ++stats.numResourceCommits_;
+            shaderResourcesDirty = false;
+        }
 
         if (currentPipelineState->GetPipelineType() == PipelineStateType::Graphics)
         {
-            if (currentIndexBuffer)
+            if (cmd.indirectArgsBuffer_)
+            {
+                if (!caps.drawIndirect_)
+                {
+                    URHO3D_LOGWARNING("Indirect draw is not supported by current graphics API");
+                    continue;
+                }
+
+                Diligent::DrawIndexedIndirectAttribs drawAttrs;
+                drawAttrs.IndexType = GetIndexType(currentIndexBuffer);
+                drawAttrs.pAttribsBuffer = cmd.indirectArgsBuffer_->GetHandle();
+                drawAttrs.DrawArgsOffset = cmd.indirectArgsOffset_;
+                drawAttrs.DrawCount = cmd.indirectDrawCount_;
+                drawAttrs.Flags = Diligent::DRAW_FLAG_VERIFY_ALL;
+                drawAttrs.AttribsBufferStateTransitionMode = Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+
+                deviceContext->DrawIndexedIndirect(drawAttrs);
+
+                // Number of primitives is not known on CPU
+                stats.numDraws_ += cmd.indirectDrawCount_;
+                stats.numIndirectDraws_ += cmd.indirectDrawCount_;
+            }
+            else if (currentIndexBuffer)
             {
                 Diligent::DrawIndexedAttribs drawAttrs;
                 drawAttrs.NumIndices = cmd.indexCount_;
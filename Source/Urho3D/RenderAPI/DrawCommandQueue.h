@@ -8,13 +8,13 @@
 #include "Urho3D/IO/Log.h"
 #include "Urho3D/RenderAPI/ConstantBufferCollection.h"
 #include "Urho3D/RenderAPI/PipelineState.h"
+#include "Urho3D/RenderAPI/RawBuffer.h"
 #include "Urho3D/RenderAPI/RawTexture.h"
 #include "Urho3D/RenderAPI/ShaderProgramReflection.h"
 
 namespace Urho3D
 {
 
-class RawBuffer;
 class RenderContext;
 
 /// Shader resource group, range in array.
@@ -46,6 +46,13 @@ struct DrawCommandDescription
     unsigned instanceCount_{};
     IntVector3 numGroups_{};
     /// @}
+
+    /// Indirect draw call parameters. Arguments are read from the buffer if it is not null.
+    /// @{
+    RawBuffer* indirectArgsBuffer_{};
+    unsigned indirectArgsOffset_{};
+    unsigned indirectDrawCount_{};
+    /// @}
 };
 
 /// Queue of draw commands.
@@ -183,7 +190,25 @@ public:
             return;
         }
 
-        unorderedAccessViews_.push_back(UnorderedAccessViewData{uav->variable_, texture, view});
+        unorderedAccessViews_.push_back(UnorderedAccessViewData{uav->variable_, texture, nullptr, view});
+        ++currentUnorderedAccessViewGroup_.second;
+    }
+
+    /// Add unordered access view of the buffer.
+    void AddUnorderedAccessView(StringHash name, RawBuffer* buffer)
+    {
+        const ShaderResourceReflection* uav = currentShaderProgramReflection_->GetUnorderedAccessView(name);
+        if (!uav || !uav->variable_)
+            return;
+
+        Diligent::IBufferView* view = buffer->GetUAV();
+        if (!view)
+        {
+            URHO3D_ASSERTLOG(false, "Requested UAV for buffer does not exist");
+            return;
+        }
+
+        unorderedAccessViews_.push_back(UnorderedAccessViewData{uav->variable_, nullptr, buffer, view});
         ++currentUnorderedAccessViewGroup_.second;
     }
 
@@ -298,6 +323,22 @@ public:
         drawCommands_.push_back(currentDrawCommand_);
     }
 
+    /// Enqueue draw indexed geometry with arguments stored in GPU buffer, e.g. written by compute shader.
+    /// Each draw reads 5 uints: index count, instance count, index start, base vertex index and instance start.
+    void DrawIndexedIndirect(RawBuffer* argsBuffer, unsigned argsOffset, unsigned drawCount = 1)
+    {
+        URHO3D_ASSERT(currentDrawCommand_.pipelineState_->GetPipelineType() == PipelineStateType::Graphics);
+        URHO3D_ASSERT(currentDrawCommand_.indexBuffer_);
+        URHO3D_ASSERT(argsBuffer && drawCount > 0);
+
+        drawCommands_.push_back(currentDrawCommand_);
+        DrawCommandDescription& drawCommand = drawCommands_.back();
+        drawCommand.baseVertexIndex_ = 0;
+        drawCommand.indirectArgsBuffer_ = argsBuffer;
+        drawCommand.indirectArgsOffset_ = argsOffset;
+        drawCommand.indirectDrawCount_ = drawCount;
+    }
+
     /// Dispatch compute shader.
     void Dispatch(const IntVector3& numGroups)
     {
@@ -307,6 +348,15 @@ public:
         drawCommands_.push_back(currentDrawCommand_);
     }
 
+    /// Inherit state that is set once for many draw commands: scissor, stencil reference and clip planes.
+    /// Should be called after Reset if the queue is recorded as a part of another queue.
+    void InheritState(const DrawCommandQueue& parent);
+    /// Append draw commands recorded into another queue. Shader parameters are copied.
+    void Append(const DrawCommandQueue& other);
+
+    /// Return number of draw commands.
+    unsigned GetNumDrawCommands() const { return drawCommands_.size(); }
+
     /// Execute commands in the queue.
     void ExecuteInContext(RenderContext* renderContext);
 
@@ -339,7 +389,8 @@ private:
     {
         Diligent::IShaderResourceVariable* variable_{};
         RawTexture* texture_{};
-        Diligent::ITextureView* view_{};
+        RawBuffer* buffer_{};
+        Diligent::IDeviceObject* view_{};
     };
 
     /// Whether to enable clip plane.
@@ -0,0 +1,194 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/RenderAPI/GpuProfiler.h"
+
+#include "Urho3D/Core/Profiler.h"
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/RenderAPI/RenderDevice.h"
+
+#include <Diligent/Graphics/GraphicsEngine/interface/DeviceContext.h>
+#include <Diligent/Graphics/GraphicsEngine/interface/Query.h>
+#include <Diligent/Graphics/GraphicsEngine/interface/RenderDevice.h>
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+bool GetTimestamp(Diligent::IQuery* query, Diligent::QueryDataTimestamp& data)
+{
+    return query->GetData(&data, sizeof(data), true) && data.Frequency != 0;
+}
+
+} // namespace
+
+GpuProfiler::GpuProfiler(RenderDevice* renderDevice)
+    : Object(renderDevice->GetContext())
+    , renderDevice_(renderDevice)
+{
+}
+
+GpuProfiler::~GpuProfiler()
+{
+}
+
+void GpuProfiler::Invalidate()
+{
+    frames_ = {};
+    currentDepth_ = 0;
+    frameStats_.clear();
+    frameTimeMs_ = 0.0;
+}
+
+void GpuProfiler::Restore()
+{
+    Diligent::IRenderDevice* device = renderDevice_->GetRenderDevice();
+    supported_ = device && device->GetDeviceInfo().Features.TimestampQueries != Diligent::DEVICE_FEATURE_STATE_DISABLED;
+}
+
+void GpuProfiler::SetEnabled(bool enabled)
+{
+    if (enabled_ == enabled)
+        return;
+
+    if (enabled && !supported_)
+        URHO3D_LOGWARNING("GPU profiling is enabled but timestamp queries are not supported by the device");
+
+    enabled_ = enabled;
+    for (FrameData& frame : frames_)
+        frame.numZones_ = 0;
+    currentDepth_ = 0;
+    frameStats_.clear();
+    frameTimeMs_ = 0.0;
+}
+
+unsigned GpuProfiler::BeginZone(Diligent::IDeviceContext* deviceContext, ea::string_view name)
+{
+    if (!enabled_ || !supported_)
+        return InvalidZone;
+
+    FrameData& frame = frames_[currentFrame_];
+    if (frame.numZones_ >= MaxZonesPerFrame)
+        return InvalidZone;
+
+    const unsigned zoneIndex = frame.numZones_;
+    if (zoneIndex >= frame.zones_.size())
+    {
+        Zone zone;
+        zone.beginQuery_ = CreateQuery();
+        zone.endQuery_ = CreateQuery();
+        if (!zone.beginQuery_ || !zone.endQuery_)
+            return InvalidZone;
+        frame.zones_.push_back(ea::move(zone));
+    }
+
+    Zone& zone = frame.zones_[zoneIndex];
+    zone.name_ = GetZoneName(name);
+    zone.depth_ = currentDepth_;
+    deviceContext->EndQuery(zone.beginQuery_);
+
+    ++frame.numZones_;
+    ++currentDepth_;
+    return zoneIndex;
+}
+
+void GpuProfiler::EndZone(Diligent::IDeviceContext* deviceContext, unsigned zoneIndex)
+{
+    if (zoneIndex == InvalidZone)
+        return;
+
+    FrameData& frame = frames_[currentFrame_];
+    if (zoneIndex >= frame.numZones_)
+        return;
+
+    deviceContext->EndQuery(frame.zones_[zoneIndex].endQuery_);
+    if (currentDepth_ > 0)
+        --currentDepth_;
+}
+
+void GpuProfiler::OnFrameEnd()
+{
+    if (!enabled_ || !supported_)
+        return;
+
+    // The oldest frame is reused for the next one, so it is resolved now
+    currentFrame_ = (currentFrame_ + 1) % NumFramesInFlight;
+    currentDepth_ = 0;
+
+    FrameData& frame = frames_[currentFrame_];
+    ResolveFrame(frame);
+    frame.numZones_ = 0;
+}
+
+const char* GpuProfiler::GetZoneName(ea::string_view name)
+{
+    const StringHash nameHash{name};
+    // Names may contain object addresses, keep memory bounded
+    if (zoneNames_.size() >= MaxZoneNames && zoneNames_.find(nameHash) == zoneNames_.end())
+        return "Other";
+
+    const auto iter = zoneNames_.try_emplace(nameHash).first;
+    if (iter->second.empty())
+        iter->second = name;
+    return iter->second.c_str();
+}
+
+Diligent::RefCntAutoPtr<Diligent::IQuery> GpuProfiler::CreateQuery()
+{
+    Diligent::QueryDesc desc;
+    desc.Name = "GpuProfiler timestamp";
+    desc.Type = Diligent::QUERY_TYPE_TIMESTAMP;
+
+    Diligent::RefCntAutoPtr<Diligent::IQuery> query;
+    renderDevice_->GetRenderDevice()->CreateQuery(desc, &query);
+    return query;
+}
+
+void GpuProfiler::ResolveFrame(FrameData& frame)
+{
+    if (frame.numZones_ == 0)
+        return;
+
+    ea::vector<GpuProfilerZoneStats> frameStats;
+    double frameTimeMs = 0.0;
+    for (unsigned i = 0; i < frame.numZones_; ++i)
+    {
+        Zone& zone = frame.zones_[i];
+
+        Diligent::QueryDataTimestamp begin;
+        Diligent::QueryDataTimestamp end;
+        const bool hasBegin = GetTimestamp(zone.beginQuery_, begin);
+        const bool hasEnd = GetTimestamp(zone.endQuery_, end);
+        // Keep previous results if the frame is not ready yet
+        if (!hasBegin || !hasEnd)
+            return;
+
+        const double durationMs = end.Counter > begin.Counter
+            ? static_cast<double>(end.Counter - begin.Counter) * 1000.0 / static_cast<double>(end.Frequency)
+            : 0.0;
+        frameStats.push_back(GpuProfilerZoneStats{zone.name_, zone.depth_, durationMs});
+        if (zone.depth_ == 0)
+            frameTimeMs += durationMs;
+    }
+
+    frameStats_ = ea::move(frameStats);
+    frameTimeMs_ = frameTimeMs;
+
+#if URHO3D_PROFILING
+    URHO3D_PROFILE_VALUE("GPU Frame Time", frameTimeMs_);
+    for (const GpuProfilerZoneStats& zone : frameStats_)
+    {
+        if (zone.depth_ == 0)
+            URHO3D_PROFILE_VALUE(zone.name_, zone.durationMs_);
+    }
+#endif
+}
+
+} // namespace Urho3D
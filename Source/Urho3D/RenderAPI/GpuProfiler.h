@@ -0,0 +1,114 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Core/Object.h"
+#include "Urho3D/Math/StringHash.h"
+
+#include <Diligent/Common/interface/RefCntAutoPtr.hpp>
+
+#include <EASTL/array.h>
+#include <EASTL/string.h>
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+namespace Diligent
+{
+
+struct IDeviceContext;
+struct IQuery;
+
+} // namespace Diligent
+
+namespace Urho3D
+{
+
+class RenderDevice;
+
+/// GPU time of single profiler zone.
+struct GpuProfilerZoneStats
+{
+    /// Zone name.
+    const char* name_{};
+    /// Nesting level of the zone, 0 for top-level zones.
+    unsigned depth_{};
+    /// GPU time spent in the zone in milliseconds.
+    double durationMs_{};
+};
+
+/// Measures GPU time of render scopes using timestamp queries.
+/// Results are read back with the latency of several frames so the CPU never waits for the GPU.
+/// Disabled by default. Does nothing if timestamp queries are not supported by the device.
+class URHO3D_API GpuProfiler : public Object
+{
+    URHO3D_OBJECT(GpuProfiler, Object);
+
+public:
+    /// Number of frames to wait before reading back the results.
+    static const unsigned NumFramesInFlight = 4;
+    /// Max number of zones per frame. Zones above the limit are ignored.
+    static const unsigned MaxZonesPerFrame = 256;
+    /// Max number of unique zone names. Zones with new names above the limit are merged.
+    static const unsigned MaxZoneNames = 1024;
+    /// Zone index returned when the zone is not recorded.
+    static const unsigned InvalidZone = M_MAX_UNSIGNED;
+
+    explicit GpuProfiler(RenderDevice* renderDevice);
+    ~GpuProfiler() override;
+
+    void Invalidate();
+    void Restore();
+    void OnFrameEnd();
+
+    /// Enable or disable profiling.
+    void SetEnabled(bool enabled);
+    /// Return whether profiling is enabled.
+    bool IsEnabled() const { return enabled_; }
+    /// Return whether timestamp queries are supported by the device.
+    bool IsSupported() const { return supported_; }
+
+    /// Begin zone and return its index. Name is copied.
+    unsigned BeginZone(Diligent::IDeviceContext* deviceContext, ea::string_view name);
+    /// End zone with given index.
+    void EndZone(Diligent::IDeviceContext* deviceContext, unsigned zoneIndex);
+
+    /// Return zones of the last resolved frame in the order of submission.
+    const ea::vector<GpuProfilerZoneStats>& GetFrameStats() const { return frameStats_; }
+    /// Return GPU time of all top-level zones of the last resolved frame in milliseconds.
+    double GetFrameTimeMs() const { return frameTimeMs_; }
+
+private:
+    struct Zone
+    {
+        const char* name_{};
+        unsigned depth_{};
+        Diligent::RefCntAutoPtr<Diligent::IQuery> beginQuery_;
+        Diligent::RefCntAutoPtr<Diligent::IQuery> endQuery_;
+    };
+
+    struct FrameData
+    {
+        ea::vector<Zone> zones_;
+        unsigned numZones_{};
+    };
+
+    const char* GetZoneName(ea::string_view name);
+    Diligent::RefCntAutoPtr<Diligent::IQuery> CreateQuery();
+    void ResolveFrame(FrameData& frame);
+
+    RenderDevice* renderDevice_{};
+    bool supported_{};
+    bool enabled_{};
+
+    ea::array<FrameData, NumFramesInFlight> frames_;
+    unsigned currentFrame_{};
+    unsigned currentDepth_{};
+
+    ea::unordered_map<StringHash, ea::string> zoneNames_;
+    ea::vector<GpuProfilerZoneStats> frameStats_;
+    double frameTimeMs_{};
+};
+
+} // namespace Urho3D
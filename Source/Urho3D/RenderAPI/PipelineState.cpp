@@ -37,6 +37,9 @@ void InitializeLayoutElementsMetadata(
         4, // TYPE_VECTOR4
         4, // TYPE_UBYTE4
         4, // TYPE_UBYTE4_NORM
+        4, // TYPE_BYTE4_NORM
+        2, // TYPE_HALF2
+        4, // TYPE_HALF4
     };
 
     static const Diligent::VALUE_TYPE valueTypes[] = {
@@ -46,7 +49,10 @@ void InitializeLayoutElementsMetadata(
         Diligent::VT_FLOAT32, // TYPE_VECTOR3
         Diligent::VT_FLOAT32, // TYPE_VECTOR4
         Diligent::VT_UINT8, // TYPE_UBYTE4
-        Diligent::VT_UINT8 // TYPE_UBYTE4_NORM
+        Diligent::VT_UINT8, // TYPE_UBYTE4_NORM
+        Diligent::VT_INT8, // TYPE_BYTE4_NORM
+        Diligent::VT_FLOAT16, // TYPE_HALF2
+        Diligent::VT_FLOAT16 // TYPE_HALF4
     };
 
     static const bool isNormalized[] = {
@@ -56,7 +62,10 @@ void InitializeLayoutElementsMetadata(
         false, // TYPE_VECTOR3
         false, // TYPE_VECTOR4
         false, // TYPE_UBYTE4
-        true // TYPE_UBYTE4_NORM
+        true, // TYPE_UBYTE4_NORM
+        true, // TYPE_BYTE4_NORM
+        false, // TYPE_HALF2
+        false // TYPE_HALF4
     };
 
     result.clear();
@@ -520,13 +529,24 @@ void PipelineState::CreateGPU(const GraphicsPipelineStateDesc& desc)
 
     DestroyGPU();
 
+    // Subscribe before validation so the pipeline state is recreated when pending shaders are compiled
+    for (RawShader* shader :
+        {desc.vertexShader_, desc.pixelShader_, desc.domainShader_, desc.hullShader_, desc.geometryShader_})
+    {
+        if (shader)
+            shader->OnReloaded.Subscribe(this, &PipelineState::Invalidate);
+    }
+
     for (RawShader* shader :
         {desc.vertexShader_, desc.pixelShader_, desc.domainShader_, desc.hullShader_, desc.geometryShader_})
     {
         if (shader && !shader->GetHandle())
         {
-            URHO3D_LOGERROR("Failed to create PipelineState '{}' due to failed {} shader compilation", GetDebugName(),
-                ToString(shader->GetShaderType()));
+            if (!shader->IsCompilationPending())
+            {
+                URHO3D_LOGERROR("Failed to create PipelineState '{}' due to failed {} shader compilation",
+                    GetDebugName(), ToString(shader->GetShaderType()));
+            }
             return;
         }
     }
@@ -550,13 +570,6 @@ void PipelineState::CreateGPU(const GraphicsPipelineStateDesc& desc)
     Diligent::IShader* geometryShader = desc.geometryShader_ ? desc.geometryShader_->GetHandle() : nullptr;
     Diligent::IShader* const shaderHandles[] = {vertexShader, pixelShader, domainShader, hullShader, geometryShader};
 
-    for (RawShader* shader :
-        {desc.vertexShader_, desc.pixelShader_, desc.domainShader_, desc.hullShader_, desc.geometryShader_})
-    {
-        if (shader)
-            shader->OnReloaded.Subscribe(this, &PipelineState::Invalidate);
-    }
-
     VertexShaderAttributeVector vertexAttributes;
     StringVector vertexAttributeNames;
     if (!isOpenGL)
@@ -700,10 +713,16 @@ void PipelineState::CreateGPU(const ComputePipelineStateDesc& desc)
 {
     DestroyGPU();
 
+    if (desc.computeShader_)
+        desc.computeShader_->OnReloaded.Subscribe(this, &PipelineState::Invalidate);
+
     if (desc.computeShader_ && !desc.computeShader_->GetHandle())
     {
-        URHO3D_LOGERROR("Failed to create PipelineState '{}' due to failed {} shader compilation", GetDebugName(),
-            ToString(desc.computeShader_->GetShaderType()));
+        if (!desc.computeShader_->IsCompilationPending())
+        {
+            URHO3D_LOGERROR("Failed to create PipelineState '{}' due to failed {} shader compilation",
+                GetDebugName(), ToString(desc.computeShader_->GetShaderType()));
+        }
         return;
     }
 
@@ -718,7 +737,6 @@ void PipelineState::CreateGPU(const ComputePipelineStateDesc& desc)
 
     Diligent::IShader* computeShader = desc.computeShader_->GetHandle();
     Diligent::IShader* const shaderHandles[] = {computeShader};
-    desc.computeShader_->OnReloaded.Subscribe(this, &PipelineState::Invalidate);
 
     if (hasSeparableShaderPrograms)
     {
@@ -803,6 +821,7 @@ SharedPtr<PipelineState> PipelineStateCache::GetPipelineState(const PipelineStat
     {
         pipelineState = MakeShared<PipelineState>(this, desc);
         weakPipelineState = pipelineState;
+        OnPipelineStateCreated(this, desc);
     }
     return pipelineState;
 }
@@ -220,6 +220,9 @@ class URHO3D_API PipelineStateCache : public Object, public DeviceObject
     URHO3D_OBJECT(PipelineStateCache, Object);
 
 public:
+    /// Signals that new pipeline state has been created.
+    Signal<void(const PipelineStateDesc& desc), PipelineStateCache> OnPipelineStateCreated;
+
     explicit PipelineStateCache(Context* context);
 
     /// Initialize pipeline state cache. Optionally loads cached pipeline states from memory blob.
@@ -6,6 +6,7 @@
 
 #include "Urho3D/RenderAPI/RawBuffer.h"
 
+#include "Urho3D/Core/Thread.h"
 #include "Urho3D/IO/Log.h"
 #include "Urho3D/RenderAPI/RenderDevice.h"
 #include "Urho3D/RenderAPI/RenderPool.h"
@@ -172,6 +173,8 @@ bool RawBuffer::CreateGPU(const void* data)
     bufferDesc.BindFlags = bufferTypeToBindFlag[params_.type_];
     if (params_.flags_.Test(BufferFlag::BindUnorderedAccess))
         bufferDesc.BindFlags |= Diligent::BIND_UNORDERED_ACCESS;
+    if (params_.flags_.Test(BufferFlag::BindIndirectArgs))
+        bufferDesc.BindFlags |= Diligent::BIND_INDIRECT_DRAW_ARGS;
 
     // TODO: Revisit this place if we add other usages
     bufferDesc.Usage = params_.flags_.Test(BufferFlag::Immutable) ? Diligent::USAGE_IMMUTABLE : Diligent::USAGE_DEFAULT;
@@ -183,17 +186,20 @@ bool RawBuffer::CreateGPU(const void* data)
     }
     internalUsage_ = bufferDesc.Usage;
 
-    bufferDesc.Mode = Diligent::BUFFER_MODE_UNDEFINED;
+    // Vertex buffers cannot be structured, so UAVs are always raw
+    bufferDesc.Mode = params_.flags_.Test(BufferFlag::BindUnorderedAccess) ? Diligent::BUFFER_MODE_RAW
+                                                                           : Diligent::BUFFER_MODE_UNDEFINED;
     bufferDesc.Size = params_.size_;
     bufferDesc.ElementByteStride = params_.stride_;
 
     Diligent::IRenderDevice* device = renderDevice_->GetRenderDevice();
     Diligent::IDeviceContext* immediateContext = renderDevice_->GetImmediateContext();
 
+    // Immediate context cannot be used outside of the main thread, the device uploads initial data on its own then
     Diligent::BufferData bufferData;
     bufferData.pData = data;
     bufferData.DataSize = params_.size_;
-    bufferData.pContext = immediateContext;
+    bufferData.pContext = Thread::IsMainThread() ? immediateContext : nullptr;
 
     device->CreateBuffer(bufferDesc, data ? &bufferData : nullptr, &handle_);
     if (!handle_)
@@ -206,6 +212,13 @@ bool RawBuffer::CreateGPU(const void* data)
     return true;
 }
 
+Diligent::IBufferView* RawBuffer::GetUAV() const
+{
+    if (!handle_ || !params_.flags_.Test(BufferFlag::BindUnorderedAccess))
+        return nullptr;
+    return handle_->GetDefaultView(Diligent::BUFFER_VIEW_UNORDERED_ACCESS);
+}
+
 void RawBuffer::Update(const void* data, unsigned size)
 {
     const unsigned dataSize = size ? size : params_.size_;
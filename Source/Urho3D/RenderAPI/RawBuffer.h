@@ -71,6 +71,8 @@ public:
     const unsigned char* GetShadowData() const { return shadowData_.get(); }
 
     Diligent::IBuffer* GetHandle() const { return handle_; }
+    /// Return default unordered access view. Only valid for buffers with BindUnorderedAccess flag.
+    Diligent::IBufferView* GetUAV() const;
     /// @}
 
 protected:
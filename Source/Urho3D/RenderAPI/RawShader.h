@@ -44,6 +44,10 @@ public:
     Diligent::IShader* GetHandle() const { return handle_; }
     /// @}
 
+    /// Return whether the shader is being compiled in background and has no handle yet.
+    /// OnReloaded is signaled when compilation is finished.
+    virtual bool IsCompilationPending() const { return false; }
+
 protected:
     RawShader(Context* context, ShaderType type);
 
@@ -333,6 +333,12 @@ RawTexture::RawTexture(Context* context, const RawTextureParams& params)
     Create(params);
 }
 
+RawTexture::RawTexture(Context* context, const RawTextureParams& params, ea::span<const void* const> initialData)
+    : DeviceObject(context)
+{
+    Create(params, initialData);
+}
+
 RawTexture::~RawTexture()
 {
     RawTexture::DestroyGPU();
@@ -429,10 +435,10 @@ Diligent::ITextureView* RawTexture::GetUAV(const RawTextureUAVKey& key) const
     return iter != handles_.uavs_.end() ? iter->second.RawPtr() : nullptr;
 }
 
-bool RawTexture::Create(const RawTextureParams& params)
+bool RawTexture::Create(const RawTextureParams& params, ea::span<const void* const> initialData)
 {
     // Optimize repeated calls.
-    if (params == params_ && handles_)
+    if (params == params_ && handles_ && initialData.empty())
         return true;
 
     Destroy();
@@ -453,7 +459,7 @@ bool RawTexture::Create(const RawTextureParams& params)
     if (!renderDevice_)
         return true;
 
-    if (!CreateGPU())
+    if (!CreateGPU(initialData))
     {
         handles_ = {};
         return false;
@@ -462,6 +468,19 @@ bool RawTexture::Create(const RawTextureParams& params)
     return true;
 }
 
+void RawTexture::AdoptGPU(RawTexture& source)
+{
+    DestroyGPU();
+
+    params_ = source.params_;
+    handles_ = ea::move(source.handles_);
+    source.handles_ = {};
+    levelsDirty_ = false;
+    resolveDirty_ = false;
+
+    OnCreateGPU();
+}
+
 bool RawTexture::CreateFromHandle(Diligent::ITexture* texture, TextureFormat format, int msaaLevel)
 {
     DestroyGPU();
@@ -633,7 +652,7 @@ bool RawTexture::CreateFromGLTexture(
     return false;
 }
 
-bool RawTexture::CreateGPU()
+bool RawTexture::CreateGPU(ea::span<const void* const> initialData)
 {
     const bool isSRV = true; // flags_.Test(TextureFlag::BindShaderResource);
     const bool isRTV = params_.flags_.Test(TextureFlag::BindRenderTarget);
@@ -674,8 +693,43 @@ bool RawTexture::CreateGPU()
         textureDesc.SampleCount = params_.multiSample_;
     }
 
+    // Initial data is uploaded by the device itself, without immediate context
+    ea::vector<Diligent::TextureSubResData> subresources;
+    Diligent::TextureData textureData;
+    if (!initialData.empty())
+    {
+        const unsigned numSlices = params_.type_ == TextureType::Texture3D ? 1 : params_.arraySize_;
+        if (params_.multiSample_ != 1 || initialData.size() != numSlices * params_.numLevelsRTV_)
+        {
+            URHO3D_LOGERROR("Initial data of texture '{}' should contain all array slices and mip levels",
+                GetDebugName());
+            return false;
+        }
+
+        const auto& formatInfo = Diligent::GetTextureFormatAttribs(params_.format_);
+        subresources.resize(initialData.size());
+        for (unsigned slice = 0; slice < numSlices; ++slice)
+        {
+            for (unsigned level = 0; level < params_.numLevelsRTV_; ++level)
+            {
+                const IntVector3 size = GetMipLevelSize(params_.size_, level);
+                const unsigned widthInBlocks = (size.x_ + formatInfo.BlockWidth - 1) / formatInfo.BlockWidth;
+                const unsigned heightInBlocks = (size.y_ + formatInfo.BlockHeight - 1) / formatInfo.BlockHeight;
+
+                const unsigned index = slice * params_.numLevelsRTV_ + level;
+                Diligent::TextureSubResData& subresource = subresources[index];
+                subresource.pData = initialData[index];
+                subresource.Stride = widthInBlocks * formatInfo.GetElementSize();
+                subresource.DepthStride = heightInBlocks * subresource.Stride;
+            }
+        }
+
+        textureData.pSubResources = subresources.data();
+        textureData.NumSubresources = subresources.size();
+    }
+
     Diligent::IRenderDevice* device = renderDevice_->GetRenderDevice();
-    device->CreateTexture(textureDesc, nullptr, &handles_.texture_);
+    device->CreateTexture(textureDesc, initialData.empty() ? nullptr : &textureData, &handles_.texture_);
     if (!handles_.texture_)
     {
         URHO3D_LOGERROR(
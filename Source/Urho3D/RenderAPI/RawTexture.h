@@ -11,6 +11,7 @@
 #include <Diligent/Graphics/GraphicsEngine/interface/Texture.h>
 #include <Diligent/Graphics/GraphicsEngine/interface/TextureView.h>
 
+#include <EASTL/span.h>
 #include <EASTL/tuple.h>
 #include <EASTL/unordered_map.h>
 #include <EASTL/vector.h>
@@ -126,6 +127,10 @@ class URHO3D_API RawTexture : public DeviceObject
 {
 public:
     RawTexture(Context* context, const RawTextureParams& params);
+    /// Create texture with initial data for each array slice and mip level, in array slice major order.
+    /// Device context is not used, so it's safe to call from worker thread if
+    /// RenderDeviceCaps::threadedResourceCreation_ is set.
+    RawTexture(Context* context, const RawTextureParams& params, ea::span<const void* const> initialData);
     ~RawTexture() override;
 
     /// Create from texture handle.
@@ -185,11 +190,13 @@ public:
 protected:
     /// Create empty texture.
     explicit RawTexture(Context* context);
-    /// Validate parameters and create GPU texture.
-    bool Create(const RawTextureParams& params);
+    /// Validate parameters and create GPU texture, optionally with initial data for all subresources.
+    bool Create(const RawTextureParams& params, ea::span<const void* const> initialData = {});
+    /// Take GPU texture and parameters from another texture. Source texture is left empty.
+    void AdoptGPU(RawTexture& source);
 
     /// Create GPU texture from current parameters.
-    bool CreateGPU();
+    bool CreateGPU(ea::span<const void* const> initialData = {});
     /// Destroy all GPU resources.
     void DestroyGPU();
 
@@ -192,8 +192,11 @@ struct URHO3D_API RenderDeviceCaps
     bool computeShaders_{};
     bool drawBaseVertex_{};
     bool drawBaseInstance_{};
+    bool drawIndirect_{};
     bool clipDistance_{};
     bool readOnlyDepth_{};
+    /// Whether textures and buffers with initial data can be created from worker threads.
+    bool threadedResourceCreation_{};
 
     bool srgbOutput_{};
     bool hdrOutput_{};
@@ -213,6 +216,10 @@ struct URHO3D_API RenderDeviceStats
     unsigned numDraws_{};
     /// Number of compute dispatches.
     unsigned numDispatches_{};
+    /// Number of indirect draw operations. Also included in the number of draw operations.
+    unsigned numIndirectDraws_{};
+    /// Number of shader resource commits. Commits are skipped if bindings didn't change since previous draw.
+    unsigned numResourceCommits_{};
 };
 
 /// GPU buffer types.
@@ -243,6 +250,8 @@ enum class BufferFlag
     PerInstanceData = 1 << 4,
     /// Buffer data cannot change after creation. Data updates lead to buffer recreation.
     Immutable = 1 << 5,
+    /// Buffer can be used as source of arguments for indirect draw commands.
+    BindIndirectArgs = 1 << 6,
 };
 URHO3D_FLAGSET(BufferFlag, BufferFlags);
 
@@ -323,6 +332,9 @@ enum VertexElementType : unsigned char
     TYPE_VECTOR4,
     TYPE_UBYTE4,
     TYPE_UBYTE4_NORM,
+    TYPE_BYTE4_NORM,
+    TYPE_HALF2,
+    TYPE_HALF4,
     MAX_VERTEX_ELEMENT_TYPES
 };
 
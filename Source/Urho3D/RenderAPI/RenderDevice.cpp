@@ -11,6 +11,7 @@
 #include "Urho3D/RenderAPI/DeviceObject.h"
 #include "Urho3D/RenderAPI/DrawCommandQueue.h"
 #include "Urho3D/RenderAPI/GAPIIncludes.h"
+#include "Urho3D/RenderAPI/GpuProfiler.h"
 #include "Urho3D/RenderAPI/RawTexture.h"
 #include "Urho3D/RenderAPI/RenderAPIUtils.h"
 #include "Urho3D/RenderAPI/RenderContext.h"
@@ -778,6 +779,7 @@ RenderDevice::RenderDevice(
     , deviceSettings_(deviceSettings)
     , windowSettings_(windowSettings)
     , renderPool_(MakeShared<RenderPool>(this))
+    , gpuProfiler_(MakeShared<GpuProfiler>(this))
     , defaultQueue_(MakeShared<DrawCommandQueue>(this))
 {
     Diligent::SetDebugMessageCallback(&DebugMessageCallback);
@@ -910,6 +912,7 @@ void RenderDevice::InitializeDevice()
         createInfo.AdapterId = FindBestAdapter(factory_, createInfo.GraphicsAPIVersion, deviceSettings_.adapterId_);
         createInfo.EnableValidation = true;
         createInfo.D3D11ValidationFlags = Diligent::D3D11_VALIDATION_FLAG_VERIFY_COMMITTED_RESOURCE_RELEVANCE;
+        createInfo.Features.TimestampQueries = Diligent::DEVICE_FEATURE_STATE_OPTIONAL;
 
         factoryD3D11_->CreateDeviceAndContextsD3D11(createInfo, &renderDevice_, &deviceContext_);
 
@@ -934,6 +937,7 @@ void RenderDevice::InitializeDevice()
         CopyBackendDeviceSettings(createInfo, deviceSettings_.d3d12_);
 
         createInfo.GraphicsAPIVersion = Diligent::Version{11, 0};
+        createInfo.Features.TimestampQueries = Diligent::DEVICE_FEATURE_STATE_OPTIONAL;
         createInfo.AdapterId = FindBestAdapter(factory_, createInfo.GraphicsAPIVersion, deviceSettings_.adapterId_);
 
         factoryD3D12_->CreateDeviceAndContextsD3D12(createInfo, &renderDevice_, &deviceContext_);
@@ -994,6 +998,7 @@ void RenderDevice::InitializeDevice()
     case RenderBackend::OpenGL:
     {
         Diligent::EngineGLCreateInfo createInfo;
+        createInfo.Features.TimestampQueries = Diligent::DEVICE_FEATURE_STATE_OPTIONAL;
         createInfo.AdapterId = FindBestAdapter(factory_, createInfo.GraphicsAPIVersion, deviceSettings_.adapterId_);
 
         factoryOpenGL_->AttachToActiveGLContext(createInfo, &renderDevice_, &deviceContext_);
@@ -1046,12 +1051,16 @@ void RenderDevice::InitializeCaps()
     caps_.drawBaseVertex_ = (adapterInfo.DrawCommand.CapFlags & Diligent::DRAW_COMMAND_CAP_FLAG_BASE_VERTEX) != 0;
     // OpenGL ES and some MacOS versions don't have base instance draw.
     caps_.drawBaseInstance_ = !IsOpenGLESBackend(deviceSettings_.backend_) && GetPlatform() != PlatformId::MacOS;
+    caps_.drawIndirect_ = (adapterInfo.DrawCommand.CapFlags & Diligent::DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT) != 0;
 
     // OpenGL does not have clear specification when it is allowed
     // to bind read-only depth texture both as depth-stencil view and as shader resource.
     // It certainly does not work in WebGL.
     caps_.readOnlyDepth_ = GetPlatform() != PlatformId::Web;
 
+    // OpenGL context is bound to the main thread, other backends have free-threaded resource creation.
+    caps_.threadedResourceCreation_ = deviceSettings_.backend_ != RenderBackend::OpenGL;
+
     caps_.srgbOutput_ = IsRenderTargetFormatSupported(TextureFormat::TEX_FORMAT_RGBA8_UNORM_SRGB)
         || IsRenderTargetFormatSupported(TextureFormat::TEX_FORMAT_BGRA8_UNORM_SRGB);
     caps_.hdrOutput_ = IsRenderTargetFormatSupported(TextureFormat::TEX_FORMAT_RGBA16_FLOAT);
@@ -1600,6 +1609,7 @@ void RenderDevice::Present()
 
     // Execute postponed work
     renderPool_->OnFrameEnd();
+    gpuProfiler_->OnFrameEnd();
 
     for (PipelineState* pipelineState : pipelineStatesToReload_)
     {
@@ -1637,6 +1647,8 @@ void RenderDevice::Present()
         maxStats_.numPrimitives_ = ea::max(maxStats_.numPrimitives_, stats_.numPrimitives_);
         maxStats_.numDraws_ = ea::max(maxStats_.numDraws_, stats_.numDraws_);
         maxStats_.numDispatches_ = ea::max(maxStats_.numDispatches_, stats_.numDispatches_);
+        maxStats_.numIndirectDraws_ = ea::max(maxStats_.numIndirectDraws_, stats_.numIndirectDraws_);
+        maxStats_.numResourceCommits_ = ea::max(maxStats_.numResourceCommits_, stats_.numResourceCommits_);
     }
 
     // Increment frame index
@@ -1799,12 +1811,14 @@ void RenderDevice::InitializeDefaultObjects()
     createDefaultTexture(TextureType::Texture3D, Diligent::RESOURCE_DIMENSION_SUPPORT_TEX_3D);
     createDefaultTexture(TextureType::Texture2DArray, Diligent::RESOURCE_DIMENSION_SUPPORT_TEX_2D_ARRAY);
     renderPool_->Restore();
+    gpuProfiler_->Restore();
 }
 
 void RenderDevice::ReleaseDefaultObjects()
 {
     defaultTextures_ = {};
     renderPool_->Invalidate();
+    gpuProfiler_->Invalidate();
 }
 
 } // namespace Urho3D
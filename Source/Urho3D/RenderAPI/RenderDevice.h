@@ -55,6 +55,7 @@ namespace Urho3D
 
 class DeviceObject;
 class DrawCommandQueue;
+class GpuProfiler;
 class PipelineState;
 class RawTexture;
 class RenderContext;
@@ -129,6 +130,7 @@ public:
     TextureFormat GetDefaultDepthFormat() const { return defaultDepthFormat_; }
     RenderContext* GetRenderContext() const { return renderContext_; }
     RenderPool* GetRenderPool() const { return renderPool_; }
+    GpuProfiler* GetGpuProfiler() const { return gpuProfiler_; }
     SDL_Window* GetSDLWindow() const { return window_.get(); }
     void* GetMetalView() const { return metalView_.get(); }
     Diligent::IEngineFactory* GetFactory() { return factory_.RawPtr(); }
@@ -209,6 +211,7 @@ private:
 
     EnumArray<ea::unique_ptr<RawTexture>, TextureType> defaultTextures_;
     SharedPtr<RenderPool> renderPool_;
+    SharedPtr<GpuProfiler> gpuProfiler_;
     SharedPtr<DrawCommandQueue> defaultQueue_;
 
     ea::unique_ptr<Diligent::SwapChainDesc> oldNativeSwapChainDesc_;
@@ -73,27 +73,49 @@ long long RenderPool::GetAge(const TextureCacheEntry& entry) const
 
 RawTexture* RenderPool::GetTransientTexture(const RawTextureParams& params)
 {
+    const FrameIndex currentFrame = renderDevice_->GetFrameIndex();
+
+    // Textures released earlier in this frame are reused so users with disjoint lifetimes share memory
     TextureCacheEntryGroup& allocations = transientTextures_[params];
-    if (allocations.numUsed_ < allocations.entries_.size())
+    for (TextureCacheEntry& entry : allocations.entries_)
     {
-        TextureCacheEntry& entry = allocations.entries_[allocations.numUsed_];
-
-        ++allocations.numUsed_;
-        entry.lastUsedFrame_ = renderDevice_->GetFrameIndex();
+        if (!entry.inUse_)
+        {
+            if (entry.lastUsedFrame_ == currentFrame)
+                ++numReusedTextures_;
 
-        return entry.texture_.get();
+            entry.inUse_ = true;
+            entry.lastUsedFrame_ = currentFrame;
+            return entry.texture_.get();
+        }
     }
 
     TextureCacheEntry& entry = allocations.entries_.emplace_back();
 
-    ++allocations.numUsed_;
     entry.texture_ = ea::make_unique<RawTexture>(context_, params);
-    entry.lastUsedFrame_ = renderDevice_->GetFrameIndex();
+    entry.lastUsedFrame_ = currentFrame;
+    entry.inUse_ = true;
     ++numAddedTextures_;
 
     return entry.texture_.get();
 }
 
+void RenderPool::ReleaseTexture(RawTexture* texture)
+{
+    // Texture parameters are adjusted on creation and cannot be used as the key
+    for (auto& [_, allocations] : transientTextures_)
+    {
+        for (TextureCacheEntry& entry : allocations.entries_)
+        {
+            if (entry.texture_.get() == texture)
+            {
+                entry.inUse_ = false;
+                return;
+            }
+        }
+    }
+}
+
 RawTexture* RenderPool::GetPersistentTexture(const RawTextureParams& params, const void* persistenceKey)
 {
     TextureCacheEntry& entry = persistentTextures_[ea::make_pair(params, persistenceKey)];
@@ -120,12 +142,13 @@ void RenderPool::RecycleTextures()
             totalTextures += allocations.entries_.size();
         totalTextures += persistentTextures_.size();
 
-        URHO3D_LOGDEBUG("RenderPool: {} uniform buffers, {} textures (+{} -{})", uniformBuffers_.size(), totalTextures,
-            numAddedTextures_, numRemovedTextures_);
+        URHO3D_LOGDEBUG("RenderPool: {} uniform buffers, {} textures (+{} -{}), {} reused within frame",
+            uniformBuffers_.size(), totalTextures, numAddedTextures_, numRemovedTextures_, numReusedTextures_);
 
         lastLogFrame_ = currentFrame;
         numAddedTextures_ = 0;
         numRemovedTextures_ = 0;
+        numReusedTextures_ = 0;
     }
 }
 
@@ -182,14 +205,13 @@ void RenderPool::CleanupOldTextures()
 {
     for (auto& [_, allocations] : transientTextures_)
     {
-        allocations.numUsed_ = 0;
         for (TextureCacheEntry& entry : allocations.entries_)
-        {
-            const unsigned oldSize = allocations.entries_.size();
-            ea::erase_if(allocations.entries_,
-                [&](const auto& entry) { return GetAge(entry) >= settings_.textureCacheMaxFrames_; });
-            numRemovedTextures_ += oldSize - allocations.entries_.size();
-        }
+            entry.inUse_ = false;
+
+        const unsigned oldSize = allocations.entries_.size();
+        ea::erase_if(allocations.entries_,
+            [&](const auto& entry) { return GetAge(entry) >= settings_.textureCacheMaxFrames_; });
+        numRemovedTextures_ += oldSize - allocations.entries_.size();
     }
     ea::erase_if(transientTextures_, [&](const auto& pair) { return pair.second.entries_.empty(); });
 
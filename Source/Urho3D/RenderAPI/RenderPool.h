@@ -47,6 +47,9 @@ public:
     /// Transient textures are recycled on demand, same parameters will return different textures between recycles.
     /// Persistent textures are not recycled, same parameters will return same texture.
     RawTexture* GetTexture(const RawTextureParams& params, const void* persistenceKey = nullptr);
+    /// Return transient texture to the pool before recycle, so it can be reused by another user within the frame.
+    /// Texture contents are not preserved. Make sure that all commands using the texture are already submitted.
+    void ReleaseTexture(RawTexture* texture);
 
     /// Recycle all transient textures.
     void RecycleTextures();
@@ -61,11 +64,11 @@ private:
     {
         ea::unique_ptr<RawTexture> texture_;
         FrameIndex lastUsedFrame_{};
+        bool inUse_{};
     };
     struct TextureCacheEntryGroup
     {
         ea::vector<TextureCacheEntry> entries_;
-        unsigned numUsed_{};
     };
 
     long long GetAge(const TextureCacheEntry& entry) const;
@@ -83,6 +86,7 @@ private:
 
     unsigned numAddedTextures_{};
     unsigned numRemovedTextures_{};
+    unsigned numReusedTextures_{};
     FrameIndex lastLogFrame_{};
 
     ByteVector scratchBuffer_;
@@ -6,14 +6,16 @@
 
 #include "Urho3D/Core/Context.h"
 #include "Urho3D/Core/NonCopyable.h"
+#include "Urho3D/RenderAPI/GpuProfiler.h"
 #include "Urho3D/RenderAPI/RenderContext.h"
+#include "Urho3D/RenderAPI/RenderDevice.h"
 
 #include <Diligent/Graphics/GraphicsEngine/interface/DeviceContext.h>
 
 namespace Urho3D
 {
 
-/// Utility class to add debug scope markers.
+/// Utility class to add debug scope markers. Scopes are also timed by GpuProfiler if it is enabled.
 class URHO3D_API RenderScope : public NonCopyable
 {
 public:
@@ -35,16 +37,23 @@ public:
     ~RenderScope()
     {
         if (renderContext_)
-            renderContext_->GetHandle()->EndDebugGroup();
+        {
+            Diligent::IDeviceContext* deviceContext = renderContext_->GetHandle();
+            renderContext_->GetRenderDevice()->GetGpuProfiler()->EndZone(deviceContext, gpuZone_);
+            deviceContext->EndDebugGroup();
+        }
     }
 
 private:
     void BeginGroup(ea::string_view name)
     {
-        renderContext_->GetHandle()->BeginDebugGroup(name.data());
+        Diligent::IDeviceContext* deviceContext = renderContext_->GetHandle();
+        deviceContext->BeginDebugGroup(name.data());
+        gpuZone_ = renderContext_->GetRenderDevice()->GetGpuProfiler()->BeginZone(deviceContext, name);
     }
 
     RenderContext* renderContext_{};
+    unsigned gpuZone_{GpuProfiler::InvalidZone};
 };
 
 } // namespace Urho3D
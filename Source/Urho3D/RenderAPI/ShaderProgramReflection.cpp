@@ -331,6 +331,20 @@ ShaderProgramReflection::ShaderProgramReflection(unsigned programObject)
             }
         }
     }
+
+#if GL_ARB_program_interface_query && GL_ARB_shader_storage_buffer_object
+    GLint numStorageBlocks = 0;
+    if (glGetProgramInterfaceiv)
+        glGetProgramInterfaceiv(programObject, GL_SHADER_STORAGE_BLOCK, GL_ACTIVE_RESOURCES, &numStorageBlocks);
+
+    for (GLuint storageBlockIndex = 0; storageBlockIndex < static_cast<GLuint>(numStorageBlocks); ++storageBlockIndex)
+    {
+        glGetProgramResourceName(programObject, GL_SHADER_STORAGE_BLOCK, storageBlockIndex, maxNameLength, nullptr, name);
+
+        if (const auto sanitatedUAVName = SanitizeUAVName(name))
+            AddUnorderedAccessView(StringHash{*sanitatedUAVName}, name);
+    }
+#endif
     RecalculateUniformHash();
 #else
     URHO3D_ASSERT(false, "Not implemented");
@@ -362,6 +376,7 @@ void ShaderProgramReflection::ReflectShader(Diligent::IShader* shader)
         }
 
         case Diligent::SHADER_RESOURCE_TYPE_TEXTURE_UAV:
+        case Diligent::SHADER_RESOURCE_TYPE_BUFFER_UAV:
         {
             if (const auto sanitatedName = SanitizeUAVName(desc.Name))
                 AddUnorderedAccessView(StringHash{*sanitatedName}, desc.Name);
@@ -252,6 +252,10 @@ void AmbientOcclusionPass::Execute(Camera* camera)
     case AmbientOcclusionMode::Preview: Blit(pipelineStates_->preview_); break;
     default: Blit(pipelineStates_->combine_); break;
     }
+
+    // Intermediate textures may be reused by the passes that follow
+    textures_.currentTarget_->ReleaseTransientTexture();
+    textures_.previousTarget_->ReleaseTransientTexture();
 }
 
 } // namespace Urho3D
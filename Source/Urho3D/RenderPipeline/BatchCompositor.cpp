@@ -60,6 +60,9 @@ void BatchCompositorPass::SetDeferredOutputDesc(const PipelineStateOutputDesc& d
 
 void BatchCompositorPass::ComposeBatches()
 {
+    // Drawable indices are stable, so retained states of removed drawables are just unused or overwritten
+    retainedBatchStates_.resize(drawableProcessor_->GetNumDrawables());
+
     // Try to process batches in worker threads
     ForEachParallel(workQueue_, geometryBatches_,
         [&](unsigned /*index*/, const GeometryBatch& geometryBatch)
@@ -101,6 +104,13 @@ void BatchCompositorPass::OnPipelineStatesInvalidated()
     lightCache_.Invalidate();
 }
 
+RetainedBatchState* BatchCompositorPass::GetRetainedBatchState(const PipelineBatchDesc& desc)
+{
+    if (desc.sourceBatchIndex_ >= MaxRetainedSourceBatches || desc.drawableIndex_ >= retainedBatchStates_.size())
+        return nullptr;
+    return &retainedBatchStates_[desc.drawableIndex_][desc.sourceBatchIndex_];
+}
+
 void BatchCompositorPass::ProcessGeometryBatch(const GeometryBatch& geometryBatch)
 {
     // Skip invalid batches. It may happen if UpdateGeometry removed some source batches.
@@ -114,7 +124,7 @@ void BatchCompositorPass::ProcessGeometryBatch(const GeometryBatch& geometryBatc
     // Always add deferred batch if possible.
     if (desc.pass_)
     {
-        AddPipelineBatch(desc, deferredCache_, deferredBatches_, delayedDeferredBatches_);
+        AddPipelineBatch(desc, deferredCache_, deferredBatches_, delayedDeferredBatches_, GetRetainedBatchState(desc));
         return;
     }
 
@@ -166,7 +176,7 @@ void BatchCompositorPass::ProcessGeometryBatch(const GeometryBatch& geometryBatc
     {
         desc.InitializeLitBatch(nullptr, M_MAX_UNSIGNED, 0);
         desc.pass_ = geometryBatch.unlitBasePass_;
-        AddPipelineBatch(desc, unlitBaseCache_, baseBatches_, delayedUnlitBaseBatches_);
+        AddPipelineBatch(desc, unlitBaseCache_, baseBatches_, delayedUnlitBaseBatches_, GetRetainedBatchState(desc));
     }
 }
 
@@ -201,9 +211,11 @@ void BatchCompositorPass::ResolveDelayedBatches(BatchCompositorSubpass subpass,
 }
 
 void BatchCompositorPass::AddPipelineBatch(const PipelineBatchDesc& desc, BatchStateCache& cache,
-    WorkQueueVector<PipelineBatch>& batches, WorkQueueVector<PipelineBatchDesc>& delayedBatches)
+    WorkQueueVector<PipelineBatch>& batches, WorkQueueVector<PipelineBatchDesc>& delayedBatches,
+    RetainedBatchState* retained)
 {
-    PipelineState* pipelineState = cache.GetPipelineState(desc.GetKey());
+    const BatchStateLookupKey key = desc.GetKey();
+    PipelineState* pipelineState = retained ? cache.GetPipelineState(key, *retained) : cache.GetPipelineState(key);
     if (pipelineState && pipelineState->IsValid())
     {
         PipelineBatch& pipelineBatch = batches.Emplace(desc);
@@ -252,6 +264,15 @@ BatchCompositor::~BatchCompositor()
 void BatchCompositor::SetPasses(ea::vector<SharedPtr<BatchCompositorPass>> passes)
 {
     allPasses_ = passes;
+    for (BatchCompositorPass* pass : allPasses_)
+        pass->SetRadixSortBatches(radixSortBatches_);
+}
+
+void BatchCompositor::SetRadixSortBatches(bool enabled)
+{
+    radixSortBatches_ = enabled;
+    for (BatchCompositorPass* pass : allPasses_)
+        pass->SetRadixSortBatches(radixSortBatches_);
 }
 
 void BatchCompositor::SetShadowOutputDesc(const PipelineStateOutputDesc& desc)
@@ -308,7 +329,8 @@ void BatchCompositor::ComposeLightVolumeBatches()
     for (unsigned lightIndex = 0; lightIndex < lightProcessors.size(); ++lightIndex)
     {
         LightProcessor* lightProcessor = lightProcessors[lightIndex];
-        if (!lightProcessor->HasLitGeometries())
+        // Clustered lights are applied by single fullscreen pass
+        if (!lightProcessor->HasLitGeometries() || drawableProcessor_->IsClusteredDeferredLight(lightIndex))
             continue;
 
         Light* light = lightProcessor->GetLight();
@@ -333,7 +355,7 @@ void BatchCompositor::ComposeLightVolumeBatches()
     }
 
     FillSortKeys(sortedLightVolumeBatches_, lightVolumeBatches_);
-    ea::sort(sortedLightVolumeBatches_.begin(), sortedLightVolumeBatches_.end());
+    SortPipelineBatches(sortedLightVolumeBatches_, radixSortBatches_);
 }
 
 void BatchCompositor::OnUpdateBegin(const CommonFrameInfo& frameInfo)
@@ -441,7 +463,7 @@ void BatchCompositor::FinalizeShadowBatchesComposition()
         {
             workQueue_->PostTask([=](unsigned threadIndex)
             {
-                lightProcessor->GetMutableSplit(splitIndex)->FinalizeShadowBatches();
+                lightProcessor->GetMutableSplit(splitIndex)->FinalizeShadowBatches(radixSortBatches_);
             }, TaskPriority::Immediate);
         }
     }
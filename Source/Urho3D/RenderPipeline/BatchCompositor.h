@@ -27,6 +27,7 @@
 #include "../RenderPipeline/DrawableProcessor.h"
 #include "../RenderPipeline/InstancingBuffer.h"
 
+#include <EASTL/array.h>
 #include <EASTL/sort.h>
 
 namespace Urho3D
@@ -154,6 +155,9 @@ public:
 
     void ComposeBatches();
 
+    /// Set whether to sort batches with radix sort.
+    void SetRadixSortBatches(bool enabled) { radixSortBatches_ = enabled; }
+
     bool HasBatches() const
     {
         return deferredBatches_.Size() > 0
@@ -184,14 +188,23 @@ protected:
     WorkQueueVector<PipelineBatch> lightBatches_;
     WorkQueueVector<PipelineBatch> negativeLightBatches_;
 
+    /// Whether to sort batches with radix sort.
+    bool radixSortBatches_{};
+
 private:
+    /// Max number of source batches per drawable that have retained pipeline states.
+    static const unsigned MaxRetainedSourceBatches = 2;
+    using RetainedDrawableBatchStates = ea::array<RetainedBatchState, MaxRetainedSourceBatches>;
+
     bool PreparePipelineBatch(PipelineBatchDesc& key, const GeometryBatch& geometryBatch) const;
 
+    RetainedBatchState* GetRetainedBatchState(const PipelineBatchDesc& desc);
     void ProcessGeometryBatch(const GeometryBatch& geometryBatch);
     void ResolveDelayedBatches(BatchCompositorSubpass subpass, const WorkQueueVector<PipelineBatchDesc>& delayedBatches,
         BatchStateCache& cache, WorkQueueVector<PipelineBatch>& batches);
     void AddPipelineBatch(const PipelineBatchDesc& desc, BatchStateCache& cache,
-        WorkQueueVector<PipelineBatch>& batches, WorkQueueVector<PipelineBatchDesc>& delayedBatches);
+        WorkQueueVector<PipelineBatch>& batches, WorkQueueVector<PipelineBatchDesc>& delayedBatches,
+        RetainedBatchState* retained = nullptr);
     PipelineState* GetPlaceholderPipelineState(BatchStateCache& cache, PipelineState* original);
 
     /// Pipeline state caches
@@ -202,6 +215,10 @@ private:
     BatchStateCache lightCache_;
     /// @}
 
+    /// Pipeline states of deferred and unlit base batches retained between frames, indexed by drawable.
+    /// Lit batches depend on per-frame lighting and are always looked up.
+    ea::vector<RetainedDrawableBatchStates> retainedBatchStates_;
+
     /// Batches whose processing is delayed due to missing pipeline state
     /// @{
     WorkQueueVector<PipelineBatchDesc> delayedDeferredBatches_;
@@ -230,6 +247,8 @@ public:
     ~BatchCompositor() override;
     void SetPasses(ea::vector<SharedPtr<BatchCompositorPass>> passes);
     void SetShadowMaterialQuality(MaterialQuality materialQuality) { shadowMaterialQuality_ = materialQuality; }
+    /// Set whether to sort batches of all passes with radix sort.
+    void SetRadixSortBatches(bool enabled);
 
     void SetShadowOutputDesc(const PipelineStateOutputDesc& desc);
     void SetLightVolumesOutputDesc(const PipelineStateOutputDesc& desc);
@@ -295,6 +314,7 @@ private:
     ea::vector<SharedPtr<BatchCompositorPass>> allPasses_;
     ea::vector<BatchCompositorPass*> passes_;
     MaterialQuality shadowMaterialQuality_{};
+    bool radixSortBatches_{};
     SharedPtr<Material> lightVolumeMaterial_;
     SharedPtr<Material> negativeLightVolumeMaterial_;
     SharedPtr<Pass> lightVolumePass_;
@@ -23,6 +23,8 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/FrameAllocator.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/Camera.h"
 #include "../RenderAPI/DrawCommandQueue.h"
 #include "../Graphics/Drawable.h"
@@ -53,6 +55,9 @@ namespace Urho3D
 namespace
 {
 
+/// Min number of batches recorded by one thread.
+const unsigned MinBatchesPerChunk = 128;
+
 /// Return shader parameter for camera depth mode.
 Vector4 GetCameraDepthModeParameter(const Camera& camera, RenderBackend backend)
 {
@@ -155,18 +160,17 @@ public:
         }
     }
 
-    /// Add uniforms to instancing buffer for instanced batches.
-    void AddBatchesToInstancingBuffer(InstancingBuffer& instancingBuffer,
-        const SourceBatch& sourceBatch, unsigned instanceIndex)
+    /// Write uniforms of instanced batch to mapped instancing buffer.
+    void WriteBatchToInstancingBuffer(unsigned char* instanceData, const SourceBatch& sourceBatch, unsigned instanceIndex)
     {
-        instancingBuffer.AddInstance();
-        instancingBuffer.SetElements(&sourceBatch.worldTransform_[instanceIndex], 0, 3);
+        InstancingBuffer::SetElements(instanceData, &sourceBatch.worldTransform_[instanceIndex], 0, 3);
+        InstancingBuffer::SetElements(instanceData, GetInstanceData(sourceBatch, instanceIndex), 3, 1);
         if (ambientEnabled_)
         {
             if (ambientMode_ == DrawableAmbientMode::Flat)
-                instancingBuffer.SetElements(&ambientValueFlat_, 3, 1);
+                InstancingBuffer::SetElements(instanceData, &ambientValueFlat_, 4, 1);
             else if (ambientMode_ == DrawableAmbientMode::Directional)
-                instancingBuffer.SetElements(ambientValueSH_, 3, 7);
+                InstancingBuffer::SetElements(instanceData, ambientValueSH_, 4, 7);
         }
     }
 
@@ -216,6 +220,7 @@ public:
 
         default:
             drawQueue.AddShaderParameter(ShaderConsts::Object_Model, sourceBatch.worldTransform_[instanceIndex]);
+            drawQueue.AddShaderParameter(ShaderConsts::Object_InstanceData, *GetInstanceData(sourceBatch, instanceIndex));
             break;
         }
 
@@ -223,6 +228,12 @@ public:
     }
 
 private:
+    /// Return custom data of the instance, zero if not provided by the drawable.
+    static const Vector4* GetInstanceData(const SourceBatch& sourceBatch, unsigned instanceIndex)
+    {
+        return sourceBatch.instancingData_ ? &sourceBatch.instancingData_[instanceIndex] : &Vector4::ZERO;
+    }
+
     const bool instancingEnabled_;
     const bool ambientEnabled_;
     const DrawableAmbientMode ambientMode_;
@@ -950,6 +961,17 @@ BatchRenderingContext::BatchRenderingContext(DrawCommandQueue& drawQueue, const
 {
 }
 
+BatchRenderingContext::BatchRenderingContext(DrawCommandQueue& drawQueue, const BatchRenderingContext& other)
+    : drawQueue_(drawQueue)
+    , camera_(other.camera_)
+    , outputShadowSplit_(other.outputShadowSplit_)
+    , instanceMultiplier_(other.instanceMultiplier_)
+    , globalResources_(other.globalResources_)
+    , frameParameters_(other.frameParameters_)
+    , cameraParameters_(other.cameraParameters_)
+{
+}
+
 BatchRenderer::BatchRenderer(RenderPipelineInterface* renderPipeline, const DrawableProcessor* drawableProcessor,
     InstancingBuffer* instancingBuffer)
     : Object(renderPipeline->GetContext())
@@ -960,6 +982,8 @@ BatchRenderer::BatchRenderer(RenderPipelineInterface* renderPipeline, const Draw
 {
 }
 
+BatchRenderer::~BatchRenderer() = default;
+
 void BatchRenderer::SetSettings(const BatchRendererSettings& settings)
 {
     settings_ = settings;
@@ -977,7 +1001,7 @@ void BatchRenderer::RenderBatches(const BatchRenderingContext& ctx, PipelineBatc
             compositor.ProcessSceneBatch(*sortedBatch.pipelineBatch_);
         compositor.FlushDrawCommands(batchGroup.startInstance_ + batchGroup.numInstances_);
     }
-    else
+    else if (!RenderBatchesInParallel(ctx, batchGroup))
     {
         DrawCommandCompositor<false> compositor(ctx, settings_, nullptr,
             *drawableProcessor_, *instancingBuffer_, batchGroup.flags_, batchGroup.startInstance_);
@@ -999,7 +1023,7 @@ void BatchRenderer::RenderBatches(const BatchRenderingContext& ctx, PipelineBatc
             compositor.ProcessSceneBatch(*sortedBatch.pipelineBatch_);
         compositor.FlushDrawCommands(batchGroup.startInstance_ + batchGroup.numInstances_);
     }
-    else
+    else if (!RenderBatchesInParallel(ctx, batchGroup))
     {
         DrawCommandCompositor<false> compositor(ctx, settings_, nullptr,
             *drawableProcessor_, *instancingBuffer_, batchGroup.flags_, batchGroup.startInstance_);
@@ -1051,7 +1075,54 @@ void BatchRenderer::PrepareInstancingBufferImpl(PipelineBatchGroup<T>& batches)
     if (!objectParameterBuilder.IsInstancingSupported())
         return;
 
-    batches.startInstance_ = instancingBuffer_->GetNextInstanceIndex();
+    for (const T& sortedBatch : batches.batches_)
+    {
+        const PipelineBatch& pipelineBatch = *sortedBatch.pipelineBatch_;
+        if (objectParameterBuilder.IsBatchInstanced(pipelineBatch))
+            batches.numInstances_ += pipelineBatch.GetSourceBatch().numWorldTransforms_;
+    }
+
+    if (batches.numInstances_ == 0)
+        return;
+
+    batches.startInstance_ = instancingBuffer_->AllocateInstances(batches.numInstances_);
+    if constexpr (ea::is_same_v<T, PipelineBatchByState>)
+        pendingInstancingByState_.push_back(&batches);
+    else
+        pendingInstancingBackToFront_.push_back(&batches);
+}
+
+void BatchRenderer::WriteInstancingBuffer()
+{
+    const unsigned numByState = pendingInstancingByState_.size();
+    const unsigned numGroups = numByState + pendingInstancingBackToFront_.size();
+    if (numGroups > 0 && instancingBuffer_->Map())
+    {
+        // Every group owns its range of instances, so groups can be written independently
+        auto workQueue = GetSubsystem<WorkQueue>();
+        ForEachParallel(workQueue, 1u, numGroups,
+            [&](unsigned beginIndex, unsigned endIndex)
+        {
+            for (unsigned i = beginIndex; i < endIndex; ++i)
+            {
+                if (i < numByState)
+                    WriteInstancingBufferImpl(*pendingInstancingByState_[i]);
+                else
+                    WriteInstancingBufferImpl(*pendingInstancingBackToFront_[i - numByState]);
+            }
+        });
+    }
+
+    pendingInstancingByState_.clear();
+    pendingInstancingBackToFront_.clear();
+}
+
+template <class T>
+void BatchRenderer::WriteInstancingBufferImpl(const PipelineBatchGroup<T>& batches) const
+{
+    ObjectParameterBuilder objectParameterBuilder(settings_, batches.flags_);
+
+    unsigned instanceIndex = batches.startInstance_;
     for (const T& sortedBatch : batches.batches_)
     {
         const PipelineBatch& pipelineBatch = *sortedBatch.pipelineBatch_;
@@ -1066,11 +1137,76 @@ void BatchRenderer::PrepareInstancingBufferImpl(PipelineBatchGroup<T>& batches)
         }
 
         for (unsigned i = 0; i < sourceBatch.numWorldTransforms_; ++i)
-            objectParameterBuilder.AddBatchesToInstancingBuffer(*instancingBuffer_, sourceBatch, i);
-        batches.numInstances_ += sourceBatch.numWorldTransforms_;
+        {
+            unsigned char* instanceData = instancingBuffer_->GetInstanceData(instanceIndex++);
+            objectParameterBuilder.WriteBatchToInstancingBuffer(instanceData, sourceBatch, i);
+        }
     }
 }
 
+template <class T>
+bool BatchRenderer::RenderBatchesInParallel(const BatchRenderingContext& ctx, const PipelineBatchGroup<T>& batchGroup)
+{
+    auto workQueue = GetSubsystem<WorkQueue>();
+    if (!workQueue->IsMultithreaded() || !WorkQueue::IsProcessingThread())
+        return false;
+
+    const unsigned numBatches = batchGroup.batches_.size();
+    const unsigned numChunks = ea::min(workQueue->GetNumProcessingThreads(), numBatches / MinBatchesPerChunk);
+    if (numChunks < 2)
+        return false;
+
+    // Find first instance of each chunk, the same way DrawCommandCompositor advances it
+    const ObjectParameterBuilder objectParameterBuilder(settings_, batchGroup.flags_);
+    FrameVector<unsigned> chunkStartInstances(numChunks + 1);
+    unsigned instanceIndex = batchGroup.startInstance_;
+    for (unsigned chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
+    {
+        chunkStartInstances[chunkIndex] = instanceIndex;
+
+        const unsigned beginBatch = numBatches * chunkIndex / numChunks;
+        const unsigned endBatch = numBatches * (chunkIndex + 1) / numChunks;
+        for (unsigned i = beginBatch; i < endBatch; ++i)
+        {
+            const PipelineBatch& pipelineBatch = *batchGroup.batches_[i].pipelineBatch_;
+            if (pipelineBatch.geometry_->GetEffectiveIndexCount() == 0
+                || !objectParameterBuilder.IsBatchInstanced(pipelineBatch))
+                continue;
+
+            const SourceBatch& sourceBatch = pipelineBatch.GetSourceBatch();
+            instanceIndex += pipelineBatch.geometryType_ == GEOM_STATIC ? sourceBatch.numWorldTransforms_ : 1u;
+        }
+    }
+    chunkStartInstances[numChunks] = instanceIndex;
+
+    while (chunkQueues_.size() < numChunks)
+        chunkQueues_.push_back(MakeShared<DrawCommandQueue>(GetSubsystem<RenderDevice>()));
+
+    ForEachParallel(workQueue, 1, numChunks, [&](unsigned beginChunk, unsigned endChunk)
+    {
+        for (unsigned chunkIndex = beginChunk; chunkIndex < endChunk; ++chunkIndex)
+        {
+            DrawCommandQueue& chunkQueue = *chunkQueues_[chunkIndex];
+            chunkQueue.Reset();
+            chunkQueue.InheritState(ctx.drawQueue_);
+
+            const BatchRenderingContext chunkCtx{chunkQueue, ctx};
+            DrawCommandCompositor<false> compositor(chunkCtx, settings_, nullptr,
+                *drawableProcessor_, *instancingBuffer_, batchGroup.flags_, chunkStartInstances[chunkIndex]);
+
+            const unsigned beginBatch = numBatches * chunkIndex / numChunks;
+            const unsigned endBatch = numBatches * (chunkIndex + 1) / numChunks;
+            for (unsigned i = beginBatch; i < endBatch; ++i)
+                compositor.ProcessSceneBatch(*batchGroup.batches_[i].pipelineBatch_);
+            compositor.FlushDrawCommands(chunkStartInstances[chunkIndex + 1]);
+        }
+    });
+
+    for (unsigned chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
+        ctx.drawQueue_.Append(*chunkQueues_[chunkIndex]);
+    return true;
+}
+
 BatchRenderFlags BatchRenderer::AdjustRenderFlags(BatchRenderFlags flags) const
 {
     if (!instancingBuffer_->IsEnabled())
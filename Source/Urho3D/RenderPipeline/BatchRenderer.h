@@ -52,6 +52,8 @@ struct BatchRenderingContext
 
     BatchRenderingContext(DrawCommandQueue& drawQueue, const Camera& camera);
     BatchRenderingContext(DrawCommandQueue& drawQueue, const ShadowSplitProcessor& outputShadowSplit);
+    /// Copy all parameters except output queue.
+    BatchRenderingContext(DrawCommandQueue& drawQueue, const BatchRenderingContext& other);
 };
 
 /// Utility class to convert pipeline batches into sequence of draw commands.
@@ -62,6 +64,7 @@ class URHO3D_API BatchRenderer : public Object
 public:
     BatchRenderer(RenderPipelineInterface* renderPipeline, const DrawableProcessor* drawableProcessor,
         InstancingBuffer* instancingBuffer);
+    ~BatchRenderer() override;
     void SetSettings(const BatchRendererSettings& settings);
 
     /// Render batches
@@ -72,15 +75,24 @@ public:
         ea::span<const PipelineBatchByState> batches);
     /// @}
 
-    /// Store instancing data for batches.
+    /// Allocate instancing data for batches. Data is written on WriteInstancingBuffer.
+    /// Batch groups should stay alive and unchanged until then.
     /// @{
     void PrepareInstancingBuffer(PipelineBatchGroup<PipelineBatchByState>& batches);
     void PrepareInstancingBuffer(PipelineBatchGroup<PipelineBatchBackToFront>& batches);
     /// @}
+    /// Map instancing buffer and write data of all prepared batch groups, in parallel if possible.
+    void WriteInstancingBuffer();
 
 private:
     template <class T>
     void PrepareInstancingBufferImpl(PipelineBatchGroup<T>& batches);
+    template <class T>
+    void WriteInstancingBufferImpl(const PipelineBatchGroup<T>& batches) const;
+    /// Record chunks of batches in worker threads and append them to the output queue in order.
+    /// Return false if there is not enough batches to split.
+    template <class T>
+    bool RenderBatchesInParallel(const BatchRenderingContext& ctx, const PipelineBatchGroup<T>& batchGroup);
     BatchRenderFlags AdjustRenderFlags(BatchRenderFlags flags) const;
 
     /// External dependencies
@@ -92,6 +104,13 @@ private:
     /// @}
 
     BatchRendererSettings settings_;
+    /// Queues for parallel recording of batches.
+    ea::vector<SharedPtr<DrawCommandQueue>> chunkQueues_;
+    /// Batch groups waiting for instancing data to be written.
+    /// @{
+    ea::vector<const PipelineBatchGroup<PipelineBatchByState>*> pendingInstancingByState_;
+    ea::vector<const PipelineBatchGroup<PipelineBatchBackToFront>*> pendingInstancingBackToFront_;
+    /// @}
 };
 
 }
@@ -39,6 +39,7 @@ namespace Urho3D
 void BatchStateCache::Invalidate()
 {
     cache_.clear();
+    revision_ = AllocateRevision();
 }
 
 void BatchStateCache::SetOutputDesc(const PipelineStateOutputDesc& outputDesc)
@@ -55,20 +56,30 @@ PipelineState* BatchStateCache::GetPipelineState(const BatchStateLookupKey& key)
     URHO3D_ASSERT(outputDesc_);
 
     const auto iter = cache_.find(key);
-    if (iter == cache_.end() || iter->second.invalidated_.load(std::memory_order_relaxed))
+    if (iter == cache_.end())
         return nullptr;
 
-    const CachedBatchState& entry = iter->second;
-    if (!entry.pipelineState_
-        || key.geometry_->GetPipelineStateHash() != entry.geometryHash_
-        || key.material_->GetPipelineStateHash() != entry.materialHash_
-        || key.pass_->GetPipelineStateHash() != entry.passHash_)
+    return GetValidPipelineState(key, iter->second);
+}
+
+PipelineState* BatchStateCache::GetPipelineState(const BatchStateLookupKey& key, RetainedBatchState& retained) const
+{
+    URHO3D_ASSERT(outputDesc_);
+
+    if (retained.entry_ && retained.cacheRevision_ == revision_ && retained.key_ == key)
+        return GetValidPipelineState(key, *retained.entry_);
+
+    const auto iter = cache_.find(key);
+    if (iter == cache_.end())
     {
-        entry.invalidated_.store(true, std::memory_order_relaxed);
+        retained = {};
         return nullptr;
     }
 
-    return entry.pipelineState_;
+    retained.key_ = key;
+    retained.cacheRevision_ = revision_;
+    retained.entry_ = &iter->second;
+    return GetValidPipelineState(key, iter->second);
 }
 
 PipelineState* BatchStateCache::GetOrCreatePipelineState(const BatchStateCreateKey& key,
@@ -92,6 +103,30 @@ PipelineState* BatchStateCache::GetOrCreatePipelineState(const BatchStateCreateK
     return entry.pipelineState_;
 }
 
+PipelineState* BatchStateCache::GetValidPipelineState(
+    const BatchStateLookupKey& key, const CachedBatchState& entry) const
+{
+    if (entry.invalidated_.load(std::memory_order_relaxed))
+        return nullptr;
+
+    if (!entry.pipelineState_
+        || key.geometry_->GetPipelineStateHash() != entry.geometryHash_
+        || key.material_->GetPipelineStateHash() != entry.materialHash_
+        || key.pass_->GetPipelineStateHash() != entry.passHash_)
+    {
+        entry.invalidated_.store(true, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    return entry.pipelineState_;
+}
+
+unsigned BatchStateCache::AllocateRevision()
+{
+    static std::atomic<unsigned> lastRevision{};
+    return ++lastRevision;
+}
+
 PipelineState* BatchStateCache::GetOrCreatePlaceholderPipelineState(
     unsigned vertexStride, BatchStateCacheCallback* callback)
 {
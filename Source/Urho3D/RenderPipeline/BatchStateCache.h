@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "../Core/MemoryTracker.h"
 #include "../Core/NonCopyable.h"
 #include "../Graphics/GraphicsDefs.h"
 #include "../RenderAPI/PipelineState.h"
@@ -32,6 +33,8 @@
 namespace Urho3D
 {
 
+URHO3D_MEMORY_TAG(BatchStateCacheMemoryTag, "RenderPipeline/BatchStateCache");
+
 class Drawable;
 class Geometry;
 class IndexBuffer;
@@ -107,6 +110,17 @@ struct CachedBatchState
     /// @}
 };
 
+/// Pipeline state cache entry retained between frames for a single source batch of Drawable.
+/// Lets steady-state frames skip hash map lookup if nothing that contributes to the key has changed.
+struct RetainedBatchState
+{
+    /// Key used to find the entry.
+    BatchStateLookupKey key_;
+    /// Revision of the cache at the moment of lookup. Entry is dangling if the revision has changed.
+    unsigned cacheRevision_{};
+    const CachedBatchState* entry_{};
+};
+
 /// External context that is not present in the key but is necessary to create new pipeline state.
 struct BatchStateCreateContext
 {
@@ -129,6 +143,9 @@ public:
     /// Return existing pipeline state or nullptr if not found. Thread-safe.
     /// Resulting state may be invalid.
     PipelineState* GetPipelineState(const BatchStateLookupKey& key) const;
+    /// Same as above, but reuse retained entry if possible and update it otherwise.
+    /// Thread-safe as long as the retained entry is not shared between threads.
+    PipelineState* GetPipelineState(const BatchStateLookupKey& key, RetainedBatchState& retained) const;
     /// Return existing or create new pipeline state. Not thread safe.
     /// Resulting state may be invalid.
     PipelineState* GetOrCreatePipelineState(const BatchStateCreateKey& key,
@@ -138,10 +155,18 @@ public:
     PipelineState* GetOrCreatePlaceholderPipelineState(unsigned vertexStride, BatchStateCacheCallback* callback);
 
 private:
+    /// Return pipeline state of the entry if it's up to date.
+    PipelineState* GetValidPipelineState(const BatchStateLookupKey& key, const CachedBatchState& entry) const;
+    /// Return new revision unique among all caches.
+    static unsigned AllocateRevision();
+
     /// Current output description. Invalid on start.
     ea::optional<PipelineStateOutputDesc> outputDesc_;
     /// Cached states, possibly invalid.
-    ea::unordered_map<BatchStateLookupKey, CachedBatchState> cache_;
+    ea::unordered_map<BatchStateLookupKey, CachedBatchState, ea::hash<BatchStateLookupKey>,
+        ea::equal_to<BatchStateLookupKey>, TaggedAllocator<BatchStateCacheMemoryTag>> cache_;
+    /// Current revision of the cache. Changed whenever cache entries are destroyed.
+    unsigned revision_{AllocateRevision()};
     /// Cached placeholder states.
     ea::unordered_map<unsigned, SharedPtr<PipelineState>> placeholderCache_;
 };
@@ -223,7 +248,8 @@ public:
 
 private:
     /// Cached states, possibly invalid.
-    ea::unordered_map<UIBatchStateKey, CachedUIBatchState> cache_;
+    ea::unordered_map<UIBatchStateKey, CachedUIBatchState, ea::hash<UIBatchStateKey>,
+        ea::equal_to<UIBatchStateKey>, TaggedAllocator<BatchStateCacheMemoryTag>> cache_;
 };
 
 /// Default implementation of UIBatchStateCache.
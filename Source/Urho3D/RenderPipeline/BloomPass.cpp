@@ -179,6 +179,13 @@ void BloomPass::Execute(Camera* camera)
     renderBufferManager_->SetOutputRenderTargets();
     for (unsigned i = 0; i < numIterations; ++i)
         ApplyBloom(textures_[i].final_, intensityMultipliers_[i]);
+
+    // Intermediate textures may be reused by the passes that follow
+    for (const CachedTextures& textures : textures_)
+    {
+        textures.final_->ReleaseTransientTexture();
+        textures.temporary_->ReleaseTransientTexture();
+    }
 }
 
 }
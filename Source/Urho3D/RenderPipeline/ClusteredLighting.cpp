@@ -0,0 +1,280 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../RenderPipeline/ClusteredLighting.h"
+
+#include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
+#include "../Graphics/Camera.h"
+#include "../Graphics/Light.h"
+#include "../Graphics/Texture2D.h"
+#include "../Math/Frustum.h"
+#include "../RenderPipeline/LightProcessor.h"
+#include "../RenderPipeline/ShaderConsts.h"
+
+#include <EASTL/algorithm.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Min distance to near clip plane used for depth slicing.
+const float MinClusterNearClip = 0.01f;
+
+/// Return view space bounding box of the light volume.
+BoundingBox GetViewSpaceLightVolume(Light* light, const Matrix3x4& view)
+{
+    if (light->GetLightType() == LIGHT_SPOT)
+        return BoundingBox{light->GetViewSpaceFrustum(view)};
+
+    const Vector3 center = view * light->GetNode()->GetWorldPosition();
+    const float range = light->GetRange();
+    return BoundingBox{center - Vector3::ONE * range, center + Vector3::ONE * range};
+}
+
+int ClampCluster(float value, unsigned numClusters)
+{
+    return Clamp(FloorToInt(value * numClusters), 0, static_cast<int>(numClusters) - 1);
+}
+
+}
+
+ClusteredLighting::ClusteredLighting(Context* context)
+    : Object(context)
+{
+    clusterLights_.resize(NumClusters * MaxLightsPerCluster);
+    clusterLightCounts_.resize(NumClusters);
+}
+
+ClusteredLighting::~ClusteredLighting() = default;
+
+void ClusteredLighting::Update(Camera* camera, ea::span<LightProcessor* const> lights, bool linearColorSpace)
+{
+    URHO3D_PROFILE("UpdateClusteredLighting");
+
+    BeginUpdate(camera);
+
+    const Matrix3x4& view = camera->GetView();
+    for (LightProcessor* lightProcessor : lights)
+    {
+        Light* light = lightProcessor->GetLight();
+        const CookedLightParams& params = lightProcessor->GetParams();
+
+        // Negative lights cannot use subtract blending here, so keep the sign of the color
+        const float colorSign = light->IsNegative() ? -1.0f : 1.0f;
+
+        LightData data;
+        data[0] = Vector4{params.position_, params.inverseRange_};
+        data[1] = Vector4{params.GetColor(linearColorSpace) * colorSign, params.effectiveSpecularIntensity_};
+        data[2] = Vector4{params.direction_, params.spotCutoff_};
+        data[3] = Vector4{params.inverseSpotCutoff_, 0.0f, 0.0f, 0.0f};
+        AddLight(GetViewSpaceLightVolume(light, view), data);
+    }
+
+    EndUpdate();
+}
+
+void ClusteredLighting::BeginUpdate(Camera* camera)
+{
+    const Matrix3x4& view = camera->GetView();
+    projection_ = camera->GetProjection(true);
+    viewProj_ = projection_ * view;
+    viewZ_ = Vector4{view.m20_, view.m21_, view.m22_, view.m23_};
+
+    nearClip_ = ea::max(camera->GetNearClip(), MinClusterNearClip);
+    farClip_ = ea::max(camera->GetFarClip(), nearClip_ * (1.0f + M_LARGE_EPSILON));
+    depthSliceScale_ = NumClustersZ / Ln(farClip_ / nearClip_);
+    depthSliceBias_ = -Ln(nearClip_) * depthSliceScale_;
+
+    lightData_.clear();
+    lightClusterRanges_.clear();
+
+    cameraParameters_[0] = {ShaderConsts::Camera_ClusterViewProj, viewProj_};
+    cameraParameters_[1] = {ShaderConsts::Camera_ClusterViewZ, viewZ_};
+    cameraParameters_[2] = {ShaderConsts::Camera_ClusterParams,
+        Vector4{static_cast<float>(NumClustersX), static_cast<float>(NumClustersY), depthSliceScale_, depthSliceBias_}};
+}
+
+void ClusteredLighting::AddLight(const BoundingBox& viewSpaceBoundingBox, const LightData& data)
+{
+    if (lightData_.size() >= MaxLights)
+        return;
+
+    ClusterRange range;
+    if (!CalculateClusterRange(viewSpaceBoundingBox, range))
+        return;
+
+    lightData_.push_back(data);
+    lightClusterRanges_.push_back(range);
+}
+
+void ClusteredLighting::EndUpdate()
+{
+    ea::fill(clusterLightCounts_.begin(), clusterLightCounts_.end(), 0u);
+
+    // Depth slices don't share clusters, so they are processed independently
+    auto workQueue = GetSubsystem<WorkQueue>();
+    ForEachParallel(workQueue, 1u, NumClustersZ,
+        [&](unsigned beginSlice, unsigned endSlice)
+    {
+        for (unsigned lightIndex = 0; lightIndex < lightClusterRanges_.size(); ++lightIndex)
+        {
+            const ClusterRange& range = lightClusterRanges_[lightIndex];
+            const int minZ = ea::max(range.min_.z_, static_cast<int>(beginSlice));
+            const int maxZ = ea::min(range.max_.z_, static_cast<int>(endSlice) - 1);
+            for (int z = minZ; z <= maxZ; ++z)
+            {
+                for (int y = range.min_.y_; y <= range.max_.y_; ++y)
+                {
+                    for (int x = range.min_.x_; x <= range.max_.x_; ++x)
+                    {
+                        const unsigned clusterIndex = (z * NumClustersY + y) * NumClustersX + x;
+                        unsigned& count = clusterLightCounts_[clusterIndex];
+                        if (count < MaxLightsPerCluster)
+                            clusterLights_[clusterIndex * MaxLightsPerCluster + count++] = lightIndex;
+                    }
+                }
+            }
+        }
+    });
+}
+
+void ClusteredLighting::CommitToGPU()
+{
+    URHO3D_PROFILE("CommitClusteredLighting");
+
+    InitializeTextures();
+
+    // Pack light lists without gaps
+    gridTextureData_.resize(NumClusters * 2);
+    indicesTextureData_.clear();
+    for (unsigned clusterIndex = 0; clusterIndex < NumClusters; ++clusterIndex)
+    {
+        const unsigned count = clusterLightCounts_[clusterIndex];
+        gridTextureData_[clusterIndex * 2] = static_cast<float>(indicesTextureData_.size());
+        gridTextureData_[clusterIndex * 2 + 1] = static_cast<float>(count);
+
+        const unsigned* clusterLights = &clusterLights_[clusterIndex * MaxLightsPerCluster];
+        for (unsigned i = 0; i < count; ++i)
+            indicesTextureData_.push_back(static_cast<float>(clusterLights[i]));
+    }
+
+    const unsigned numIndexRows = ea::max(1u, (indicesTextureData_.size() + IndexTextureWidth - 1) / IndexTextureWidth);
+    indicesTextureData_.resize(numIndexRows * IndexTextureWidth);
+    if (indicesTexture_->GetHeight() < static_cast<int>(numIndexRows))
+        indicesTexture_->SetSize(IndexTextureWidth, numIndexRows, TextureFormat::TEX_FORMAT_R32_FLOAT);
+
+    if (!lightData_.empty())
+        lightsTexture_->SetData(0, 0, 0, TexelsPerLight, lightData_.size(), lightData_.data());
+    gridTexture_->SetData(0, 0, 0, NumClustersX * NumClustersY, NumClustersZ, gridTextureData_.data());
+    indicesTexture_->SetData(0, 0, 0, IndexTextureWidth, numIndexRows, indicesTextureData_.data());
+}
+
+unsigned ClusteredLighting::GetClusterIndex(const Vector3& viewPosition) const
+{
+    const Vector4 clipPosition = projection_ * Vector4{viewPosition, 1.0f};
+    const float invW = 1.0f / ea::max(clipPosition.w_, M_EPSILON);
+    const int x = ClampCluster(clipPosition.x_ * invW * 0.5f + 0.5f, NumClustersX);
+    const int y = ClampCluster(clipPosition.y_ * invW * 0.5f + 0.5f, NumClustersY);
+    const int z = GetDepthSlice(viewPosition.z_);
+    return (z * NumClustersY + y) * NumClustersX + x;
+}
+
+ea::span<const unsigned> ClusteredLighting::GetClusterLights(unsigned clusterIndex) const
+{
+    assert(clusterIndex < NumClusters);
+    return {&clusterLights_[clusterIndex * MaxLightsPerCluster], clusterLightCounts_[clusterIndex]};
+}
+
+bool ClusteredLighting::CalculateClusterRange(const BoundingBox& viewSpaceBoundingBox, ClusterRange& range) const
+{
+    if (viewSpaceBoundingBox.max_.z_ < nearClip_ || viewSpaceBoundingBox.min_.z_ > farClip_)
+        return false;
+
+    // Corners behind near plane are clamped to it, extremes of the projection are reached at corners
+    const float minZ = ea::max(viewSpaceBoundingBox.min_.z_, nearClip_);
+    const float maxZ = ea::min(viewSpaceBoundingBox.max_.z_, farClip_);
+    Vector2 minNdc = Vector2::ONE * M_LARGE_VALUE;
+    Vector2 maxNdc = -Vector2::ONE * M_LARGE_VALUE;
+    for (unsigned i = 0; i < 8; ++i)
+    {
+        const Vector4 corner{
+            (i & 1) ? viewSpaceBoundingBox.max_.x_ : viewSpaceBoundingBox.min_.x_,
+            (i & 2) ? viewSpaceBoundingBox.max_.y_ : viewSpaceBoundingBox.min_.y_,
+            (i & 4) ? maxZ : minZ,
+            1.0f};
+        const Vector4 clipPosition = projection_ * corner;
+        const Vector2 ndc = Vector2{clipPosition.x_, clipPosition.y_} / ea::max(clipPosition.w_, M_EPSILON);
+        minNdc = VectorMin(minNdc, ndc);
+        maxNdc = VectorMax(maxNdc, ndc);
+    }
+
+    if (minNdc.x_ > 1.0f || minNdc.y_ > 1.0f || maxNdc.x_ < -1.0f || maxNdc.y_ < -1.0f)
+        return false;
+
+    range.min_.x_ = ClampCluster(minNdc.x_ * 0.5f + 0.5f, NumClustersX);
+    range.min_.y_ = ClampCluster(minNdc.y_ * 0.5f + 0.5f, NumClustersY);
+    range.min_.z_ = GetDepthSlice(minZ);
+    range.max_.x_ = ClampCluster(maxNdc.x_ * 0.5f + 0.5f, NumClustersX);
+    range.max_.y_ = ClampCluster(maxNdc.y_ * 0.5f + 0.5f, NumClustersY);
+    range.max_.z_ = GetDepthSlice(maxZ);
+    return true;
+}
+
+int ClusteredLighting::GetDepthSlice(float depth) const
+{
+    const float slice = Ln(ea::max(depth, nearClip_)) * depthSliceScale_ + depthSliceBias_;
+    return Clamp(FloorToInt(slice), 0, static_cast<int>(NumClustersZ) - 1);
+}
+
+void ClusteredLighting::InitializeTextures()
+{
+    if (lightsTexture_)
+        return;
+
+    const auto createTexture = [&](const ea::string& name, unsigned width, unsigned height, TextureFormat format)
+    {
+        auto texture = MakeShared<Texture2D>(context_);
+        texture->SetName(name);
+        texture->SetNumLevels(1);
+        texture->SetFilterMode(FILTER_NEAREST);
+        texture->SetSize(width, height, format);
+        return texture;
+    };
+
+    lightsTexture_ = createTexture("Cluster Lights", TexelsPerLight, MaxLights, TextureFormat::TEX_FORMAT_RGBA32_FLOAT);
+    gridTexture_ = createTexture(
+        "Cluster Grid", NumClustersX * NumClustersY, NumClustersZ, TextureFormat::TEX_FORMAT_RG32_FLOAT);
+    indicesTexture_ = createTexture("Cluster Light Indices", IndexTextureWidth, 1, TextureFormat::TEX_FORMAT_R32_FLOAT);
+
+    shaderResources_[0] = {ShaderResources::ClusterLights, lightsTexture_};
+    shaderResources_[1] = {ShaderResources::ClusterGrid, gridTexture_};
+    shaderResources_[2] = {ShaderResources::ClusterLightIndices, indicesTexture_};
+}
+
+}
@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Core/Object.h"
+#include "../Math/BoundingBox.h"
+#include "../Math/Matrix4.h"
+#include "../RenderPipeline/RenderPipelineDefs.h"
+
+#include <EASTL/array.h>
+#include <EASTL/span.h>
+
+namespace Urho3D
+{
+
+class Camera;
+class LightProcessor;
+class Texture2D;
+
+/// Clustered forward lighting.
+/// View frustum is split into clusters: uniformly in screen space and logarithmically in depth.
+/// Each cluster stores the list of lights intersecting it, so the ambient pass can evaluate
+/// an arbitrary number of unshadowed lights per pixel without per-light draw calls.
+class URHO3D_API ClusteredLighting : public Object
+{
+    URHO3D_OBJECT(ClusteredLighting, Object);
+
+public:
+    /// Number of clusters along each axis. Should match _ClusteredLighting.glsl.
+    /// @{
+    static const unsigned NumClustersX = 16;
+    static const unsigned NumClustersY = 8;
+    static const unsigned NumClustersZ = 24;
+    static const unsigned NumClusters = NumClustersX * NumClustersY * NumClustersZ;
+    /// @}
+    /// Max number of lights in the view. Extra lights are ignored.
+    static const unsigned MaxLights = 1024;
+    /// Max number of lights in one cluster. Extra lights are ignored.
+    static const unsigned MaxLightsPerCluster = 64;
+    /// Number of texels used to store one light.
+    static const unsigned TexelsPerLight = 4;
+    /// Width of light index texture.
+    static const unsigned IndexTextureWidth = 1024;
+
+    using LightData = ea::array<Vector4, TexelsPerLight>;
+
+    explicit ClusteredLighting(Context* context);
+    ~ClusteredLighting() override;
+
+    /// Assign lights to clusters of the camera.
+    void Update(Camera* camera, ea::span<LightProcessor* const> lights, bool linearColorSpace);
+    /// Upload cluster data to GPU. Should be called before rendering.
+    void CommitToGPU();
+
+    /// Manual update. Update calls these automatically.
+    /// @{
+    void BeginUpdate(Camera* camera);
+    void AddLight(const BoundingBox& viewSpaceBoundingBox, const LightData& data);
+    void EndUpdate();
+    /// @}
+
+    /// Return index of cluster that contains given view space position.
+    unsigned GetClusterIndex(const Vector3& viewPosition) const;
+    /// Return indices of lights in the cluster.
+    ea::span<const unsigned> GetClusterLights(unsigned clusterIndex) const;
+    /// Return number of lights in the view.
+    unsigned GetNumLights() const { return lightData_.size(); }
+
+    /// Return resources and parameters that should be passed to the ambient pass.
+    /// @{
+    ea::span<const ShaderResourceDesc> GetShaderResources() const { return shaderResources_; }
+    ea::span<const ShaderParameterDesc> GetCameraParameters() const { return cameraParameters_; }
+    /// @}
+
+private:
+    /// Range of clusters covered by the light, inclusive.
+    struct ClusterRange
+    {
+        IntVector3 min_;
+        IntVector3 max_;
+    };
+
+    /// Return cluster range covered by view space bounding box. Return false if outside of the frustum.
+    bool CalculateClusterRange(const BoundingBox& viewSpaceBoundingBox, ClusterRange& range) const;
+    /// Return depth slice of given view space depth.
+    int GetDepthSlice(float depth) const;
+    /// Create textures if needed.
+    void InitializeTextures();
+
+    /// Frame parameters
+    /// @{
+    Matrix4 projection_;
+    Matrix4 viewProj_;
+    Vector4 viewZ_;
+    float nearClip_{};
+    float farClip_{};
+    float depthSliceScale_{};
+    float depthSliceBias_{};
+    /// @}
+
+    ea::vector<LightData> lightData_;
+    ea::vector<ClusterRange> lightClusterRanges_;
+
+    /// Light indices stored with fixed capacity per cluster.
+    ea::vector<unsigned> clusterLights_;
+    ea::vector<unsigned> clusterLightCounts_;
+
+    SharedPtr<Texture2D> lightsTexture_;
+    SharedPtr<Texture2D> gridTexture_;
+    SharedPtr<Texture2D> indicesTexture_;
+
+    ea::vector<float> gridTextureData_;
+    ea::vector<float> indicesTextureData_;
+
+    ea::array<ShaderResourceDesc, 3> shaderResources_;
+    ea::array<ShaderParameterDesc, 3> cameraParameters_;
+};
+
+}
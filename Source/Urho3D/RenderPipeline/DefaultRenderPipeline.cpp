@@ -37,6 +37,7 @@
 #include "../RenderPipeline/AutoExposurePass.h"
 #include "../RenderPipeline/BatchRenderer.h"
 #include "../RenderPipeline/BloomPass.h"
+#include "../RenderPipeline/ClusteredLighting.h"
 #include "../RenderPipeline/DrawableProcessor.h"
 #include "../RenderPipeline/InstancingBuffer.h"
 #include "../RenderPipeline/LightProcessor.h"
@@ -50,6 +51,8 @@
 #endif
 
 #include "AmbientOcclusionPass.h"
+
+#include <EASTL/fixed_vector.h>
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -100,12 +103,63 @@ void DefaultRenderPipelineView::SendViewEvent(StringHash eventType)
     sender->SendEvent(eventType, eventData);
 }
 
+void DefaultRenderPipelineView::RenderClusteredDeferredLights(
+    Camera* camera, ea::span<const ShaderResourceDesc> geometryBuffer)
+{
+    static const Matrix4 flipMatrix{
+        1.0f,  0.0f, 0.0f, 0.0f,
+        0.0f, -1.0f, 0.0f, 0.0f,
+        0.0f,  0.0f, 1.0f, 0.0f,
+        0.0f,  0.0f, 0.0f, 1.0f
+    };
+
+    ClusteredLighting* clusteredLighting = sceneProcessor_->GetClusteredLighting();
+    auto renderDevice = GetSubsystem<RenderDevice>();
+    const bool isOpenGL = renderDevice->GetBackend() == RenderBackend::OpenGL;
+    const bool invertY = isOpenGL == camera->GetFlipVertical();
+
+    // Depth buffer always stores [0, 1] depth, so reconstruct from projection without OpenGL adjustment
+    Matrix4 clipToTextureSpace = Matrix4::IDENTITY;
+    clipToTextureSpace.SetScale(Vector3(0.5f, 0.5f, 1.0f));
+    clipToTextureSpace.SetTranslation(Vector3(0.5f, 0.5f, 0.0f));
+
+    const Matrix4 textureToViewSpace = (clipToTextureSpace * camera->GetProjection(true)).Inverse();
+    const Matrix4 viewToWorldSpace = camera->GetView().Inverse().ToMatrix4();
+    const Matrix4 textureToWorldSpace =
+        viewToWorldSpace * (invertY ? flipMatrix * textureToViewSpace : textureToViewSpace);
+
+    const ShaderParameterDesc shaderParameters[] = {
+        {"TextureToWorld", textureToWorldSpace},
+        {"CameraWorldPos", camera->GetNode()->GetWorldPosition()},
+    };
+
+    const auto clusterResources = clusteredLighting->GetShaderResources();
+    ea::fixed_vector<ShaderResourceDesc, 8> shaderResources(geometryBuffer.begin(), geometryBuffer.end());
+    shaderResources.insert(shaderResources.end(), clusterResources.begin(), clusterResources.end());
+
+    DrawQuadParams drawParams;
+    drawParams.pipelineStateId_ = deferred_->clusteredLightsState_;
+    drawParams.clipToUVOffsetAndScale_ = renderBufferManager_->GetDefaultClipToUVSpaceOffsetAndScale();
+    drawParams.invInputSize_ = renderBufferManager_->GetInvOutputSize();
+    drawParams.resources_ = shaderResources;
+    drawParams.parameters_ = shaderParameters;
+    drawParams.cameraParameters_ = clusteredLighting->GetCameraParameters();
+
+    renderBufferManager_->DrawQuad("ClusteredLightVolumes", drawParams);
+}
+
 void DefaultRenderPipelineView::ApplySettings()
 {
     sceneProcessor_->SetSettings(settings_);
     instancingBuffer_->SetSettings(settings_.instancingBuffer_);
     shadowMapAllocator_->SetSettings(settings_.shadowMapAllocator_);
 
+    if (dynamicResolution_.GetSettings() != settings_.dynamicResolution_)
+    {
+        dynamicResolution_.SetSettings(settings_.dynamicResolution_);
+        dynamicResolution_.Reset();
+    }
+
     if (settings_.sceneProcessor_.depthPrePass_ && !depthPrePass_)
     {
         depthPrePass_ = sceneProcessor_->CreatePass<UnorderedScenePass>(
@@ -139,6 +193,29 @@ void DefaultRenderPipelineView::ApplySettings()
         }
     }
 
+    if (deferred_)
+    {
+        deferred_->clusteredLightsState_ = {};
+        if (settings_.sceneProcessor_.clusteredLighting_)
+        {
+            static const NamedSamplerStateDesc samplers[] = {
+                {ShaderResources::Albedo, SamplerStateDesc::Nearest()},
+                {ShaderResources::Properties, SamplerStateDesc::Nearest()},
+                {ShaderResources::Normal, SamplerStateDesc::Nearest()},
+                {ShaderResources::DepthBuffer, SamplerStateDesc::Nearest()},
+            };
+
+            ea::string defines = "URHO3D_LIGHT_VOLUME_PASS URHO3D_CLUSTERED_LIGHTS";
+            if (settings_.sceneProcessor_.lightingMode_ == DirectLightingMode::DeferredPBR)
+                defines += " URHO3D_PHYSICAL_MATERIAL";
+            if (settings_.sceneProcessor_.specularQuality_ != SpecularQuality::Disabled)
+                defines += Format(" URHO3D_SPECULAR={}", static_cast<int>(settings_.sceneProcessor_.specularQuality_));
+
+            deferred_->clusteredLightsState_ = renderBufferManager_->CreateQuadPipelineState(
+                BLEND_ADD, "v2/DeferredClusteredLight", defines, samplers);
+        }
+    }
+
     outlineScenePass_ = sceneProcessor_->CreatePass<OutlineScenePass>(StringVector{"deferred", "deferred_decal", "base", "alpha"});
 
     sceneProcessor_->SetPasses({depthPrePass_, opaquePass_, deferredDecalPass_, postOpaquePass_, alphaPass_, postAlphaPass_, outlineScenePass_});
@@ -166,15 +243,35 @@ void DefaultRenderPipelineView::ApplySettings()
         postProcessPasses_.push_back(pass);
     }
 
+    const Vector4 hueSaturationValueContrast{
+        settings_.hueShift_,
+        settings_.saturation_,
+        settings_.brightness_,
+        settings_.contrast_,
+    };
+    const bool isColorGradingEnabled = !hueSaturationValueContrast.Equals(Vector4::ONE);
+
     {
         outlinePostProcessPass_ = MakeShared<OutlinePass>(this, renderBufferManager_);
         postProcessPasses_.push_back(outlinePostProcessPass_);
     }
 
+    // Per-pixel passes around tone mapping are fused into it to save full screen reads and writes
+    bool isColorGradingFused = false;
     if (settings_.renderBufferManager_.colorSpace_ == RenderPipelineColorSpace::LinearHDR)
     {
         auto pass = MakeShared<ToneMappingPass>(this, renderBufferManager_);
         pass->SetMode(settings_.toneMapping_);
+
+        outlinePostProcessPass_->SetFused(true);
+        pass->SetOutlinePass(outlinePostProcessPass_);
+
+        if (isColorGradingEnabled && settings_.antialiasing_ == PostProcessAntialiasing::None)
+        {
+            pass->SetColorGrading(hueSaturationValueContrast);
+            isColorGradingFused = true;
+        }
+
         postProcessPasses_.push_back(pass);
     }
 
@@ -201,13 +298,7 @@ void DefaultRenderPipelineView::ApplySettings()
         break;
     }
 
-    const Vector4 hueSaturationValueContrast{
-        settings_.hueShift_,
-        settings_.saturation_,
-        settings_.brightness_,
-        settings_.contrast_,
-    };
-    if (!hueSaturationValueContrast.Equals(Vector4::ONE))
+    if (isColorGradingEnabled && !isColorGradingFused)
     {
         auto pass = MakeShared<SimplePostProcessPass>(this, renderBufferManager_,
             PostProcessPassFlag::NeedColorOutputReadAndWrite,
@@ -301,6 +392,7 @@ void DefaultRenderPipelineView::Update(const FrameInfo& frameInfo)
 
     frameInfo_.frameNumber_ = frameInfo.frameNumber_;
     frameInfo_.timeStep_ = frameInfo.timeStep_;
+    frameInfo_.renderScale_ = dynamicResolution_.Update(frameInfo.timeStep_);
 
     // Begin debug snapshot
 #if URHO3D_SYSTEMUI
@@ -410,6 +502,9 @@ void DefaultRenderPipelineView::Render()
 
         renderBufferManager_->SetOutputRenderTargets(true);
         sceneProcessor_->RenderLightVolumeBatches("LightVolumes", camera, geometryBuffer, cameraParameters);
+        if (deferred_->clusteredLightsState_ != StaticPipelineStateId::Invalid
+            && sceneProcessor_->GetDrawableProcessor()->HasClusteredDeferredLights())
+            RenderClusteredDeferredLights(camera, geometryBuffer);
         renderBufferManager_->SetOutputRenderTargets();
     }
     else
@@ -25,6 +25,7 @@
 #include "OutlinePass.h"
 #include "../RenderPipeline/SceneProcessor.h"
 #include "../RenderPipeline/CameraProcessor.h"
+#include "../RenderPipeline/DynamicResolutionController.h"
 #include "../RenderPipeline/RenderBuffer.h"
 #include "../RenderPipeline/RenderBufferManager.h"
 #include "../RenderPipeline/RenderPipeline.h"
@@ -72,6 +73,8 @@ protected:
     unsigned RecalculatePipelineStateHash() const;
     void SendViewEvent(StringHash eventType);
     void ApplySettings();
+    /// Apply clustered lights to deferred geometries in single fullscreen pass.
+    void RenderClusteredDeferredLights(Camera* camera, ea::span<const ShaderResourceDesc> geometryBuffer);
 
 private:
     RenderPipelineSettings settings_;
@@ -87,6 +90,7 @@ private:
 
     CommonFrameInfo frameInfo_;
     PostProcessPassFlags postProcessFlags_;
+    DynamicResolutionController dynamicResolution_;
 
     RenderPipelineStats stats_;
     RenderPipelineDebugger debugger_;
@@ -111,6 +115,8 @@ private:
         SharedPtr<RenderBuffer> albedoBuffer_;
         SharedPtr<RenderBuffer> specularBuffer_;
         SharedPtr<RenderBuffer> normalBuffer_;
+        /// Fullscreen pass that applies clustered lights to geometry buffer.
+        StaticPipelineStateId clusteredLightsState_{};
     };
     ea::optional<DeferredLightingData> deferred_;
 
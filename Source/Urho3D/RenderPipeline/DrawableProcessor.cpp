@@ -31,6 +31,7 @@
 #include "../Graphics/Renderer.h"
 #include "../Graphics/Texture2D.h"
 #include "../Graphics/TextureCube.h"
+#include "../Graphics/TextureResidencyManager.h"
 #include "../Graphics/Zone.h"
 #include "../IO/Log.h"
 #include "../RenderPipeline/DrawableProcessor.h"
@@ -113,6 +114,17 @@ bool IsShadowCasterVisible(const BoundingBox& lightSpaceBoundingBox, Camera* sha
         return IsBoundingBoxShadowInPerspectiveFrustum(lightSpaceBoundingBox, lightSpaceFrustum, shadowCamera->GetFarClip());
 }
 
+/// Return whether the light can be evaluated by clustered forward lighting.
+/// Shadowed, directional, shaped, ramped, area and masked lights still need per-light passes.
+bool IsClusteredLight(const LightProcessor* lightProcessor)
+{
+    const Light* light = lightProcessor->GetLight();
+    const CookedLightParams& params = lightProcessor->GetParams();
+    return light->GetLightType() != LIGHT_DIRECTIONAL && !lightProcessor->HasShadow()
+        && !light->GetShapeTexture() && !light->GetRampTexture() && light->GetLightMask() == DEFAULT_LIGHTMASK
+        && params.volumetricRadius_ == 0.0f && params.volumetricLength_ == 0.0f;
+}
+
 }
 
 DrawableProcessorPass::DrawableProcessorPass(RenderPipelineInterface* renderPipeline, DrawableProcessorPassFlags flags,
@@ -201,6 +213,11 @@ void DrawableProcessor::OnUpdateBegin(const FrameInfo& frameInfo)
 
     gi_ = frameInfo_.scene_->GetComponent<GlobalIllumination>();
 
+    // Size on the screen in pixels is reported for texture streaming
+    textureResidencyManager_ = GetSubsystem<TextureResidencyManager>();
+    screenSizeScale_ = 0.5f * frameInfo_.viewSize_.y_ / ea::max(frameInfo_.camera_->GetHalfViewSize(), M_EPSILON);
+    isCameraOrthographic_ = frameInfo_.camera_->IsOrthographic();
+
     // Clean temporary containers
     sceneZRangeTemp_.clear();
     sceneZRangeTemp_.resize(WorkQueue::GetThreadIndexCount());
@@ -222,6 +239,7 @@ void DrawableProcessor::OnUpdateBegin(const FrameInfo& frameInfo)
     nonThreadedGeometryUpdates_.Clear();
 
     lightsTemp_.Clear();
+    lightProbeDrawablesTemp_.Clear();
 
     queuedDrawableUpdates_.Clear();
 
@@ -293,18 +311,18 @@ void DrawableProcessor::ProcessVisibleDrawables(const ea::vector<Drawable*>& dra
         if (!occlusionBuffers.empty() && drawable->IsOccludee())
         {
             // check for visible
-            bool anyPass = false;
             // may have multiple buffers in stereo and possibly for other cases such as lightspace shadowcaster occlusion, likely not applicable here
-            for (auto o : occlusionBuffers)
-                anyPass |= o->IsVisible(drawable->GetWorldBoundingBox());
-
-            if (!anyPass)
+            const BoundingBox& boundingBox = drawable->GetWorldBoundingBox();
+            const auto isVisible = [&](const OcclusionBuffer* o) { return o->IsVisible(boundingBox); };
+            if (!ea::any_of(occlusionBuffers.begin(), occlusionBuffers.end(), isVisible))
                 return;
         }
 
         ProcessVisibleDrawable(drawable);
     });
 
+    SampleLightProbes();
+
     // Sort lights by component ID for stability
     lights_.resize(lightsTemp_.Size());
     ea::copy(lightsTemp_.Begin(), lightsTemp_.End(), lights_.begin());
@@ -489,6 +507,11 @@ void DrawableProcessor::ProcessVisibleDrawable(Drawable* drawable)
         bool isForwardLit = false;
         bool needAmbient = false;
 
+        const float screenSize = textureResidencyManager_
+            ? boundingBox.Size().Length() * screenSizeScale_
+                / (isCameraOrthographic_ ? 1.0f : ea::max(drawable->GetDistance(), M_EPSILON))
+            : 0.0f;
+
         const auto& sourceBatches = drawable->GetBatches();
         for (unsigned sourceBatchIndex = 0; sourceBatchIndex < sourceBatches.size(); ++sourceBatchIndex)
         {
@@ -505,6 +528,9 @@ void DrawableProcessor::ProcessVisibleDrawable(Drawable* drawable)
             // Check for aux views
             CheckMaterialForAuxiliaryRenderSurfaces(sourceBatch.material_);
 
+            if (textureResidencyManager_)
+                textureResidencyManager_->ReportMaterialUsage(material, screenSize);
+
             // Update scene passes
             for (DrawableProcessorPass* pass : passes_)
             {
@@ -524,15 +550,10 @@ void DrawableProcessor::ProcessVisibleDrawable(Drawable* drawable)
             const GlobalIlluminationType giType = drawable->GetGlobalIlluminationType();
             const ReflectionMode reflectionMode = drawable->GetReflectionMode();
 
-            // Reset SH from GI if possible/needed, reset to zero otherwise
+            // Light probes are sampled later for all drawables at once
+            lightAccumulator.sphericalHarmonics_ = {};
             if (gi_ && giType >= GlobalIlluminationType::BlendLightProbes)
-            {
-                unsigned& hint = drawable->GetMutableLightProbeTetrahedronHint();
-                const Vector3& samplePosition = boundingBox.Center();
-                lightAccumulator.sphericalHarmonics_ = gi_->SampleAmbientSH(samplePosition, hint);
-            }
-            else
-                lightAccumulator.sphericalHarmonics_ = {};
+                lightProbeDrawablesTemp_.PushBack(threadIndex, drawable);
 
             // Apply ambient from Zone
             const CachedDrawableZone& cachedZone = drawable->GetMutableCachedZone();
@@ -597,6 +618,46 @@ void DrawableProcessor::ProcessVisibleDrawable(Drawable* drawable)
     }
 }
 
+void DrawableProcessor::SampleLightProbes()
+{
+    static const unsigned bucketSize = TetrahedralMesh::SampleBatchSize;
+
+    const unsigned numSamples = lightProbeDrawablesTemp_.Size();
+    if (numSamples == 0)
+        return;
+
+    URHO3D_PROFILE("SampleLightProbes");
+
+    lightProbeDrawables_.resize(numSamples);
+    ea::copy(lightProbeDrawablesTemp_.Begin(), lightProbeDrawablesTemp_.End(), lightProbeDrawables_.begin());
+    lightProbePositions_.resize(numSamples);
+    lightProbeHints_.resize(numSamples);
+    lightProbeSamples_.resize(numSamples);
+
+    ForEachParallel(workQueue_, bucketSize, numSamples,
+        [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            Drawable* drawable = lightProbeDrawables_[i];
+            lightProbePositions_[i] = drawable->GetWorldBoundingBox().Center();
+            lightProbeHints_[i] = drawable->GetMutableLightProbeTetrahedronHint();
+        }
+
+        const unsigned count = endIndex - beginIndex;
+        gi_->SampleAmbientSH(ea::span<const Vector3>(&lightProbePositions_[beginIndex], count),
+            ea::span<SphericalHarmonicsDot9>(&lightProbeSamples_[beginIndex], count),
+            ea::span<unsigned>(&lightProbeHints_[beginIndex], count));
+
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            Drawable* drawable = lightProbeDrawables_[i];
+            drawable->GetMutableLightProbeTetrahedronHint() = lightProbeHints_[i];
+            geometryLighting_[drawable->GetDrawableIndex()].sphericalHarmonics_ += lightProbeSamples_[i];
+        }
+    });
+}
+
 void DrawableProcessor::ProcessLights(LightProcessorCallback* callback)
 {
     URHO3D_PROFILE("ProcessVisibleLights");
@@ -681,15 +742,34 @@ void DrawableProcessor::FinalizeForwardLighting()
     });
 }
 
-void DrawableProcessor::ProcessForwardLighting()
+void DrawableProcessor::ProcessForwardLighting(bool clusterDeferredLights)
 {
     URHO3D_PROFILE("ProcessForwardLighting");
 
+    clusteredLightProcessors_.clear();
+    isClusteredDeferredLight_.clear();
+    isClusteredDeferredLight_.resize(lightProcessors_.size());
+    hasClusteredDeferredLights_ = false;
+
     bool hasForwardLights = false;
     for (unsigned i = 0; i < lightProcessors_.size(); ++i)
     {
-        const LightProcessor* lightProcessor = lightProcessors_[i];
-        if (lightProcessor->HasForwardLitGeometries())
+        LightProcessor* lightProcessor = lightProcessors_[i];
+
+        // Negative lights cannot be subtracted by additive fullscreen pass, keep their light volumes
+        const bool isClustered = settings_.clusteredLighting_ && IsClusteredLight(lightProcessor)
+            && !(clusterDeferredLights && lightProcessor->GetLight()->IsNegative());
+        const bool isClusteredDeferred = isClustered && clusterDeferredLights && lightProcessor->HasLitGeometries();
+
+        if (isClusteredDeferred)
+        {
+            isClusteredDeferredLight_[i] = true;
+            hasClusteredDeferredLights_ = true;
+        }
+
+        if (isClustered && (isClusteredDeferred || lightProcessor->HasForwardLitGeometries()))
+            clusteredLightProcessors_.push_back(lightProcessor);
+        else if (lightProcessor->HasForwardLitGeometries())
         {
             ProcessForwardLightingForLight(i, lightProcessor->GetLitGeometries());
             hasForwardLights = true;
@@ -800,7 +880,13 @@ void DrawableProcessor::UpdateGeometries()
         if (drawable->GetUpdateGeometryType() == UPDATE_MAIN_THREAD)
             nonThreadedGeometryUpdates_.Insert(drawable);
         else
+        {
             drawable->UpdateGeometry(frameInfo_);
+
+            // Drawable may finish the update in main thread, e.g. to upload data calculated in worker thread
+            if (drawable->GetUpdateGeometryType() == UPDATE_MAIN_THREAD)
+                nonThreadedGeometryUpdates_.Insert(drawable);
+        }
     });
 
     // Update in main thread
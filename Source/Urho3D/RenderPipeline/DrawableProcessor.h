@@ -43,6 +43,7 @@ class OcclusionBuffer;
 class Pass;
 class RenderPipelineInterface;
 class Technique;
+class TextureResidencyManager;
 struct FrameInfo;
 
 /// Flags related to geometry rendering.
@@ -183,6 +184,7 @@ public:
     /// @}
 
     const FrameInfo& GetFrameInfo() const { return frameInfo_; }
+    unsigned GetNumDrawables() const { return numDrawables_; }
     const DrawableProcessorSettings& GetSettings() const { return settings_; }
 
     /// Process occluders. UpdateBatches for occluders may be called twice, but never reentrantly.
@@ -208,6 +210,13 @@ public:
     LightProcessor* GetLightProcessor(unsigned lightIndex) const { return lightProcessors_[lightIndex]; }
 
     const auto& GetLightProcessorsByShadowMap() const { return lightProcessorsByShadowMapTexture_; }
+
+    /// Return lights that are evaluated by clustered forward lighting instead of per-object light lists.
+    const auto& GetClusteredLightProcessors() const { return clusteredLightProcessors_; }
+    /// Return whether the light is applied to deferred geometries from light clusters instead of light volume.
+    bool IsClusteredDeferredLight(unsigned lightIndex) const { return isClusteredDeferredLight_[lightIndex]; }
+    /// Return whether any light is applied to deferred geometries from light clusters.
+    bool HasClusteredDeferredLights() const { return hasClusteredDeferredLights_; }
     /// @}
 
     /// Return information from global drawable index. May be invalid for invisible drawables.
@@ -230,7 +239,8 @@ public:
     /// Should be called after all forward lighting is processed.
     void FinalizeForwardLighting();
     /// Process forward lighting for all lights.
-    void ProcessForwardLighting();
+    /// If clusterDeferredLights is set, clustered lights are applied to deferred geometries from light clusters as well.
+    void ProcessForwardLighting(bool clusterDeferredLights = false);
 
     /// Update drawable geometries if needed.
     void UpdateGeometries();
@@ -238,6 +248,8 @@ public:
 protected:
     void ProcessVisibleDrawable(Drawable* drawable);
     void ProcessQueuedDrawable(Drawable* drawable);
+    /// Sample light probes for all drawables queued during visibility processing and add them to ambient lighting.
+    void SampleLightProbes();
     void UpdateDrawableZone(const BoundingBox& boundingBox, Drawable* drawable) const;
     void UpdateDrawableReflection(const BoundingBox& boundingBox, Drawable* drawable) const;
     void QueueDrawableUpdate(Drawable* drawable);
@@ -284,6 +296,10 @@ private:
 
     MaterialQuality materialQuality_{};
     GlobalIllumination* gi_{};
+
+    TextureResidencyManager* textureResidencyManager_{};
+    float screenSizeScale_{};
+    bool isCameraOrthographic_{};
     /// @}
 
     /// Arrays indexed with drawable index
@@ -303,12 +319,21 @@ private:
     WorkQueueVector<Drawable*> threadedGeometryUpdates_;
     WorkQueueVector<Drawable*> nonThreadedGeometryUpdates_;
 
+    WorkQueueVector<Drawable*> lightProbeDrawablesTemp_;
+    ea::vector<Drawable*> lightProbeDrawables_;
+    ea::vector<Vector3> lightProbePositions_;
+    ea::vector<unsigned> lightProbeHints_;
+    ea::vector<SphericalHarmonicsDot9> lightProbeSamples_;
+
     WorkQueueVector<Light*> lightsTemp_;
     ea::vector<Light*> lights_;
     ea::vector<LightDataForAccumulator> lightDataForAccumulator_;
     ea::vector<LightProcessor*> lightProcessors_;
     ea::vector<LightProcessor*> lightProcessorsByShadowMapSize_;
     ea::vector<LightProcessor*> lightProcessorsByShadowMapTexture_;
+    ea::vector<LightProcessor*> clusteredLightProcessors_;
+    ea::vector<bool> isClusteredDeferredLight_;
+    bool hasClusteredDeferredLights_{};
     unsigned numShadowedLights_{};
 
     WorkQueueVector<Drawable*> queuedDrawableUpdates_;
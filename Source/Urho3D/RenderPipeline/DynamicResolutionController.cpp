@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../RenderPipeline/DynamicResolutionController.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+void DynamicResolutionController::SetSettings(const DynamicResolutionSettings& settings)
+{
+    settings_ = settings;
+    settings_.Validate();
+    renderScale_ = Clamp(renderScale_, settings_.minScale_, settings_.maxScale_);
+}
+
+void DynamicResolutionController::Reset()
+{
+    renderScale_ = settings_.maxScale_;
+    averageFrameTime_ = 0.0f;
+    framesSinceChange_ = 0;
+}
+
+float DynamicResolutionController::Update(float frameTime)
+{
+    if (!settings_.enabled_)
+        return 1.0f;
+
+    // Ignore spikes like loading hitches, they would drop the resolution for a long time
+    const float targetFrameTime = settings_.targetFrameTime_;
+    frameTime = Clamp(frameTime, 0.0f, 4.0f * targetFrameTime);
+    if (averageFrameTime_ == 0.0f)
+        averageFrameTime_ = frameTime;
+    else
+        averageFrameTime_ = Lerp(averageFrameTime_, frameTime, FrameTimeSmoothing);
+
+    ++framesSinceChange_;
+    if (framesSinceChange_ < settings_.adjustInterval_ || averageFrameTime_ <= 0.0f)
+        return renderScale_;
+
+    const float error = averageFrameTime_ / targetFrameTime - 1.0f;
+    if (Abs(error) <= Tolerance)
+        return renderScale_;
+
+    // Scale is adjusted by whole steps so render buffers are reused between adjustments
+    const float idealScale = renderScale_ * Sqrt(targetFrameTime / averageFrameTime_);
+    const float step = settings_.scaleStep_;
+    const float numSteps = idealScale > renderScale_ ? Floor((idealScale - renderScale_) / step)
+                                                     : -Ceil((renderScale_ - idealScale) / step);
+    const float newScale = Clamp(renderScale_ + numSteps * step, settings_.minScale_, settings_.maxScale_);
+    if (newScale != renderScale_)
+    {
+        // Predict frame time at the new scale so stale history doesn't cause overshoot
+        averageFrameTime_ *= (newScale * newScale) / (renderScale_ * renderScale_);
+        renderScale_ = newScale;
+        framesSinceChange_ = 0;
+    }
+    return renderScale_;
+}
+
+}
@@ -0,0 +1,59 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../RenderPipeline/RenderPipelineDefs.h"
+
+namespace Urho3D
+{
+
+/// Chooses scale of internal render resolution to keep frame time close to the target.
+/// Rendering cost is assumed to be proportional to the number of pixels, i.e. to the square of the scale.
+/// Frame time is measured on CPU side, so vertical synchronization hides the headroom and prevents upscaling.
+class URHO3D_API DynamicResolutionController
+{
+public:
+    /// Weight of the latest frame in the averaged frame time.
+    static constexpr float FrameTimeSmoothing = 0.1f;
+    /// Relative error of the frame time that is tolerated without changing the scale.
+    static constexpr float Tolerance = 0.05f;
+
+    void SetSettings(const DynamicResolutionSettings& settings);
+    /// Reset averaged frame time and return to the max scale.
+    void Reset();
+    /// Update controller with the duration of the last frame in seconds. Return the scale for the next frame.
+    float Update(float frameTime);
+
+    const DynamicResolutionSettings& GetSettings() const { return settings_; }
+    float GetRenderScale() const { return settings_.enabled_ ? renderScale_ : 1.0f; }
+    float GetAverageFrameTime() const { return averageFrameTime_; }
+
+private:
+    DynamicResolutionSettings settings_;
+
+    float renderScale_{1.0f};
+    float averageFrameTime_{};
+    unsigned framesSinceChange_{};
+};
+
+}
@@ -46,32 +46,67 @@ void InstancingBuffer::SetSettings(const InstancingBufferSettings& settings)
 
 void InstancingBuffer::Begin()
 {
-    if (vertexBuffer_)
-        vertexBuffer_->Discard();
+    URHO3D_ASSERT(!mappedData_, "InstancingBuffer::End was not called");
+    numInstances_.store(0, std::memory_order_relaxed);
+}
+
+bool InstancingBuffer::Map()
+{
+    const unsigned numInstances = GetNumInstances();
+    if (!vertexBuffer_ || numInstances == 0 || !EnsureCapacity(numInstances))
+        return false;
+
+    mappedData_ = static_cast<unsigned char*>(vertexBuffer_->Map());
+    return mappedData_ != nullptr;
 }
 
 void InstancingBuffer::End()
 {
-    if (vertexBuffer_)
-        vertexBuffer_->Commit();
+    if (mappedData_)
+    {
+        vertexBuffer_->Unmap();
+        mappedData_ = nullptr;
+    }
+}
+
+bool InstancingBuffer::EnsureCapacity(unsigned numInstances)
+{
+    if (numInstances <= capacity_)
+        return true;
+
+    const unsigned newCapacity = ea::max(numInstances, 2 * capacity_);
+    if (!vertexBuffer_->SetSize(newCapacity, vertexElements_, true))
+    {
+        URHO3D_LOGERROR("Failed to grow InstancingBuffer to {} instances", newCapacity);
+        capacity_ = 0;
+        return false;
+    }
+
+    capacity_ = newCapacity;
+    return true;
 }
 
 void InstancingBuffer::Initialize()
 {
     vertexBuffer_ = nullptr;
+    vertexElements_.clear();
+    capacity_ = 0;
 
     if (settings_.enableInstancing_)
     {
-        ea::vector<VertexElement> vertexElements;
         for (unsigned i = 0; i < settings_.numInstancingTexCoords_; ++i)
         {
             const unsigned index = settings_.firstInstancingTexCoord_ + i;
-            vertexElements.push_back(VertexElement(TYPE_VECTOR4, SEM_TEXCOORD, index, settings_.stepRate_));
+            vertexElements_.push_back(VertexElement(TYPE_VECTOR4, SEM_TEXCOORD, index, settings_.stepRate_));
         }
 
-        vertexBuffer_ = MakeShared<DynamicVertexBuffer>(context_);
+        static const unsigned initialCapacity = 128;
+        vertexBuffer_ = MakeShared<VertexBuffer>(context_);
         vertexBuffer_->SetDebugName("InstancingBuffer");
-        vertexBuffer_->Initialize(128, vertexElements);
+        vertexBuffer_->SetDiscard(true);
+        if (vertexBuffer_->SetSize(initialCapacity, vertexElements_, true))
+            capacity_ = initialCapacity;
+        instanceSize_ = vertexBuffer_->GetVertexSize();
     }
 }
 
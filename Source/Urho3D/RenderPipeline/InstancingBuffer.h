@@ -27,10 +27,15 @@
 #include "../Graphics/VertexBuffer.h"
 #include "../RenderPipeline/RenderPipelineDefs.h"
 
+#include <atomic>
+
 namespace Urho3D
 {
 
 /// Instancing buffer compositor.
+/// Instances are allocated first, then the GPU buffer is mapped once and instance data is written in place,
+/// possibly from multiple threads. Buffer contents are discarded on every map,
+/// so the device is free to cycle memory between frames in flight.
 class URHO3D_API InstancingBuffer : public Object
 {
     URHO3D_OBJECT(InstancingBuffer, Object);
@@ -44,40 +49,41 @@ public:
 
     /// Begin buffer composition.
     void Begin();
-    /// End buffer composition and commit added instances to GPU.
+    /// Allocate range of instances and return index of the first one. Thread-safe.
+    unsigned AllocateInstances(unsigned count) { return numInstances_.fetch_add(count, std::memory_order_relaxed); }
+    /// Map the buffer for all allocated instances. Return whether there is anything to write.
+    bool Map();
+    /// End buffer composition and commit written instances to GPU.
     void End();
 
-    /// Return index of next added instance.
-    unsigned GetNextInstanceIndex() const { return vertexBuffer_->GetVertexCount(); }
-
-    /// Add instance to buffer. Use SetElements to fill it after.
-    unsigned AddInstance()
-    {
-        const auto indexAndData = vertexBuffer_->AddVertices(1);
-        currentInstanceData_ = indexAndData.second;
-        return indexAndData.first;
-    }
-
-    /// Set one or more 4-float elements in current instance.
-    void SetElements(const void* data, unsigned index, unsigned count)
+    /// Return writeable data of the instance. Should be called only while the buffer is mapped. Thread-safe.
+    unsigned char* GetInstanceData(unsigned index) const { return mappedData_ + index * instanceSize_; }
+    /// Set one or more 4-float elements in the instance.
+    static void SetElements(unsigned char* instanceData, const void* data, unsigned index, unsigned count)
     {
-        memcpy(currentInstanceData_ + index * ElementStride, data, count * ElementStride);
+        memcpy(instanceData + index * ElementStride, data, count * ElementStride);
     }
 
     /// Getters
     /// @{
     const InstancingBufferSettings& GetSettings() const { return settings_; }
-    VertexBuffer* GetVertexBuffer() const { return vertexBuffer_ ? vertexBuffer_->GetVertexBuffer() : nullptr; }
+    VertexBuffer* GetVertexBuffer() const { return vertexBuffer_; }
     bool IsEnabled() const { return settings_.enableInstancing_; }
+    unsigned GetNumInstances() const { return numInstances_.load(std::memory_order_relaxed); }
     /// @}
 
 private:
     void Initialize();
+    bool EnsureCapacity(unsigned numInstances);
 
     InstancingBufferSettings settings_;
-    SharedPtr<DynamicVertexBuffer> vertexBuffer_;
+    SharedPtr<VertexBuffer> vertexBuffer_;
+    ea::vector<VertexElement> vertexElements_;
+    unsigned instanceSize_{};
+    unsigned capacity_{};
 
-    unsigned char* currentInstanceData_{};
+    std::atomic<unsigned> numInstances_{};
+    unsigned char* mappedData_{};
 };
 
 }
@@ -164,6 +164,7 @@ void LightProcessor::BeginUpdate(DrawableProcessor* drawableProcessor, LightProc
     litGeometries_.clear();
     shadowCasterCandidates_.clear();
     shadowMap_ = {};
+    isShadowMapPreserved_ = false;
 
     // Initialize shadow
     isShadowRequested_ = callback->IsLightShadowed(light_);
@@ -288,7 +289,11 @@ void LightProcessor::EndUpdate(DrawableProcessor* drawableProcessor,
     // Allocate shadow map
     if (numActiveSplits_ > 0)
     {
-        shadowMap_ = callback->AllocateTransientShadowMap(shadowMapSize_);
+        // Shadow maps of directional lights follow the camera and cannot be cached
+        if (light_->GetLightType() != LIGHT_DIRECTIONAL)
+            shadowMap_ = callback->AllocatePersistentShadowMap(light_, shadowMapSize_, isShadowMapPreserved_);
+        if (!shadowMap_)
+            shadowMap_ = callback->AllocateTransientShadowMap(shadowMapSize_);
         if (!shadowMap_)
             numActiveSplits_ = 0;
         else
@@ -303,6 +308,17 @@ void LightProcessor::EndUpdate(DrawableProcessor* drawableProcessor,
     UpdateHashes();
 }
 
+bool LightProcessor::CheckShadowMapCache()
+{
+    unsigned hash = 0;
+    for (unsigned i = 0; i < numActiveSplits_; ++i)
+        CombineHash(hash, splits_[i].GetShadowStateHash());
+
+    const bool isUpToDate = isShadowMapPreserved_ && hash == cachedShadowMapHash_;
+    cachedShadowMapHash_ = hash;
+    return isUpToDate;
+}
+
 void LightProcessor::InitializeShadowSplits(DrawableProcessor* drawableProcessor)
 {
     /// Setup splits
@@ -137,6 +137,10 @@ public:
     const CookedLightParams& GetParams() const { return cookedParams_; }
     /// @}
 
+    /// Return whether the persistent shadow map is up to date and doesn't need to be rendered.
+    /// Should be called once per frame after shadow batches are finalized.
+    bool CheckShadowMapCache();
+
 private:
     void InitializeShadowSplits(DrawableProcessor* drawableProcessor);
     void UpdateHashes();
@@ -170,6 +174,10 @@ private:
     ea::vector<Drawable*> shadowCasterCandidates_;
     /// Accumulative shadow map region containing all the splits.
     ShadowMapRegion shadowMap_;
+    /// Whether the shadow map is persistent and keeps the contents of the previous frame.
+    bool isShadowMapPreserved_{};
+    /// Hash of splits when the persistent shadow map was last checked.
+    unsigned cachedShadowMapHash_{};
     CookedLightParams cookedParams_;
     /// @}
 
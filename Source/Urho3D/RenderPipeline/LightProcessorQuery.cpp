@@ -106,16 +106,18 @@ SpotLightGeometryQuery::SpotLightGeometryQuery(
 
 void SpotLightGeometryQuery::TestDrawables(Drawable** start, Drawable** end, bool inside)
 {
-    for (Drawable* drawable : MakeIteratorRange(start, end))
+    const auto filter = [this](Drawable* drawable)
+    { return (drawable->GetDrawableFlags() & drawableFlags_) && (drawable->GetViewMask() & viewMask_); };
+    TestDrawablesInFrustum(start, end, inside, filter, [this](Drawable* drawable)
     {
-        const auto result = IsLitOrShadowCaster(drawable, inside);
+        const auto result = IsLitOrShadowCaster(drawable, true);
         if (result.isLit_)
             hasLitGeometries_ = true;
         if (result.isForwardLit_)
             result_.push_back(drawable);
         if (result.isShadowCaster_)
             shadowCasters_->push_back(drawable);
-    }
+    });
 }
 
 LightGeometryQueryResult SpotLightGeometryQuery::IsLitOrShadowCaster(Drawable* drawable, bool inside) const
@@ -145,11 +147,9 @@ DirectionalLightShadowCasterQuery::DirectionalLightShadowCasterQuery(ea::vector<
 
 void DirectionalLightShadowCasterQuery::TestDrawables(Drawable** start, Drawable** end, bool inside)
 {
-    for (Drawable* drawable : MakeIteratorRange(start, end))
-    {
-        if (IsShadowCaster(drawable, inside))
-            result_.push_back(drawable);
-    }
+    // Check cheap flags first, so only potential shadow casters are tested against the frustum
+    const auto filter = [this](Drawable* drawable) { return IsShadowCaster(drawable, true); };
+    TestDrawablesInFrustum(start, end, inside, filter, [this](Drawable* drawable) { result_.push_back(drawable); });
 }
 
 bool DirectionalLightShadowCasterQuery::IsShadowCaster(Drawable* drawable, bool inside) const
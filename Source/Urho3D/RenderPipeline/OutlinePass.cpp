@@ -151,7 +151,7 @@ void OutlineScenePass::OnBatchesReady()
     }
 
     BatchCompositor::FillSortKeys(sortedBatches_, deferredBatches_);
-    ea::sort(sortedBatches_.begin(), sortedBatches_.end());
+    SortPipelineBatches(sortedBatches_, radixSortBatches_, workQueue_);
 
     batchGroup_ = {sortedBatches_};
     batchGroup_.flags_ = BatchRenderFlag::EnableInstancingForStaticGeometry;
@@ -196,7 +196,7 @@ void OutlinePass::OnRenderBegin(const CommonFrameInfo& frameInfo)
 
 void OutlinePass::Execute(Camera* camera)
 {
-    if (!enabled_)
+    if (!enabled_ || fused_)
         return;
 
     const bool inLinearSpace = renderBufferManager_->IsLinearColorSpace();
@@ -85,6 +85,9 @@ public:
 
     void SetEnabled(bool enabled) { enabled_ = enabled; }
     bool IsEnabled() const { return enabled_; }
+    /// Set whether the outline is composited by another pass. Only the outline buffer is prepared then.
+    void SetFused(bool fused) { fused_ = fused; }
+    bool IsFused() const { return fused_; }
 
     /// Implement PostProcessPass.
     /// @{
@@ -98,6 +101,7 @@ private:
     void OnRenderBegin(const CommonFrameInfo& frameInfo);
 
     bool enabled_{};
+    bool fused_{};
 
     StaticPipelineStateId pipelineStateGamma_{};
     StaticPipelineStateId pipelineStateLinear_{};
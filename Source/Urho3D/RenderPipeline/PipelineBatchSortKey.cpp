@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/WorkQueue.h"
+#include "../RenderPipeline/PipelineBatchSortKey.h"
+
+#include <EASTL/array.h>
+#include <EASTL/sort.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Number of bits sorted per radix sort pass.
+const unsigned RadixBits = 8;
+const unsigned RadixSize = 1 << RadixBits;
+/// Min number of batches to sort in multiple threads.
+const unsigned MinParallelRadixSortSize = 8192;
+/// Number of batches per thread chunk.
+const unsigned RadixSortChunkSize = 4096;
+
+using RadixHistogram = ea::array<unsigned, RadixSize>;
+
+/// Return digit of the state key. Reserved bits of the secondary key are never used.
+unsigned GetRadixDigit(const PipelineBatchByState& batch, unsigned digit)
+{
+    const unsigned long long key = digit < 8 ? batch.secondaryKey_ : batch.primaryKey_;
+    return static_cast<unsigned>(key >> ((digit % 8) * RadixBits)) & (RadixSize - 1);
+}
+
+/// Return digit of the key that is ordered by render order and then by distance back to front.
+unsigned GetRadixDigit(const PipelineBatchBackToFront& batch, unsigned digit)
+{
+    // Transform float so that unsigned comparison of the bits matches float comparison, and invert for descending order
+    unsigned distanceBits;
+    memcpy(&distanceBits, &batch.distance_, sizeof(distanceBits));
+    distanceBits = (distanceBits & 0x80000000u) ? ~distanceBits : (distanceBits | 0x80000000u);
+
+    const unsigned long long key = (static_cast<unsigned long long>(batch.renderOrder_) << 32) | ~distanceBits;
+    return static_cast<unsigned>(key >> (digit * RadixBits)) & (RadixSize - 1);
+}
+
+/// Sort batches by digits from least to most significant. Equivalent keys keep relative order.
+template <class T>
+void RadixSortBatches(ea::span<T> batches, unsigned firstDigit, unsigned lastDigit, WorkQueue* workQueue)
+{
+    // Lambdas executed in other threads should see buffers of this thread, so keep explicit references
+    static thread_local ea::vector<T> threadScratchBuffer;
+    static thread_local ea::vector<RadixHistogram> threadChunkHistograms;
+    ea::vector<T>& scratchBuffer = threadScratchBuffer;
+    ea::vector<RadixHistogram>& chunkHistograms = threadChunkHistograms;
+
+    const unsigned numBatches = batches.size();
+    const bool isParallel = workQueue && workQueue->IsMultithreaded() && numBatches >= MinParallelRadixSortSize;
+    const unsigned chunkSize = isParallel ? RadixSortChunkSize : numBatches;
+    const unsigned numChunks = (numBatches + chunkSize - 1) / chunkSize;
+
+    scratchBuffer.resize(numBatches);
+    chunkHistograms.resize(numChunks);
+
+    T* source = batches.data();
+    T* destination = scratchBuffer.data();
+    for (unsigned digit = firstDigit; digit < lastDigit; ++digit)
+    {
+        // Count digits in each chunk
+        ForEachParallel(workQueue, 1, numChunks, [&](unsigned beginChunk, unsigned endChunk)
+        {
+            for (unsigned chunkIndex = beginChunk; chunkIndex < endChunk; ++chunkIndex)
+            {
+                RadixHistogram& histogram = chunkHistograms[chunkIndex];
+                histogram.fill(0);
+
+                const unsigned endIndex = ea::min(numBatches, (chunkIndex + 1) * chunkSize);
+                for (unsigned i = chunkIndex * chunkSize; i < endIndex; ++i)
+                    ++histogram[GetRadixDigit(source[i], digit)];
+            }
+        });
+
+        // Convert counts to offsets, skip the pass if all batches have the same digit
+        bool isSameDigit = false;
+        unsigned offset = 0;
+        for (unsigned value = 0; value < RadixSize; ++value)
+        {
+            const unsigned valueBegin = offset;
+            for (RadixHistogram& histogram : chunkHistograms)
+            {
+                const unsigned count = histogram[value];
+                histogram[value] = offset;
+                offset += count;
+            }
+            if (offset - valueBegin == numBatches)
+                isSameDigit = true;
+        }
+        if (isSameDigit)
+            continue;
+
+        // Scatter batches, each chunk writes to its own ranges
+        ForEachParallel(workQueue, 1, numChunks, [&](unsigned beginChunk, unsigned endChunk)
+        {
+            for (unsigned chunkIndex = beginChunk; chunkIndex < endChunk; ++chunkIndex)
+            {
+                RadixHistogram& histogram = chunkHistograms[chunkIndex];
+
+                const unsigned endIndex = ea::min(numBatches, (chunkIndex + 1) * chunkSize);
+                for (unsigned i = chunkIndex * chunkSize; i < endIndex; ++i)
+                    destination[histogram[GetRadixDigit(source[i], digit)]++] = source[i];
+            }
+        });
+
+        ea::swap(source, destination);
+    }
+
+    if (source != batches.data())
+        ea::copy(source, source + numBatches, batches.data());
+}
+
+}
+
+void SortPipelineBatches(ea::span<PipelineBatchByState> batches, bool useRadixSort, WorkQueue* workQueue)
+{
+    if (useRadixSort && batches.size() > 1)
+    {
+        // Skip reserved bits of the secondary key
+        static_assert(PipelineBatchByState::ReservedOffset == 0
+            && PipelineBatchByState::ReservedBits == 2 * RadixBits, "Unexpected mask layout");
+        RadixSortBatches(batches, 2, 16, workQueue);
+    }
+    else
+        ea::sort(batches.begin(), batches.end());
+}
+
+void SortPipelineBatches(ea::span<PipelineBatchBackToFront> batches, bool useRadixSort, WorkQueue* workQueue)
+{
+    if (useRadixSort && batches.size() > 1)
+        RadixSortBatches(batches, 0, 5, workQueue);
+    else
+        ea::sort(batches.begin(), batches.end());
+}
+
+}
@@ -34,6 +34,8 @@
 namespace Urho3D
 {
 
+class WorkQueue;
+
 /// Scene batch sorted by pipeline state, material and geometry. Also sorted front to back.
 struct PipelineBatchByState
 {
@@ -154,6 +156,14 @@ struct PipelineBatchBackToFront
     }
 };
 
+/// Sort batches using either comparison sort or LSD radix sort.
+/// Radix sort keeps order of equivalent batches and is executed in multiple threads for large number of batches
+/// if work queue is provided.
+/// @{
+URHO3D_API void SortPipelineBatches(ea::span<PipelineBatchByState> batches, bool useRadixSort, WorkQueue* workQueue = nullptr);
+URHO3D_API void SortPipelineBatches(ea::span<PipelineBatchBackToFront> batches, bool useRadixSort, WorkQueue* workQueue = nullptr);
+/// @}
+
 /// Group of batches to be rendered.
 template <class PipelineBatchSorted>
 struct PipelineBatchGroup
@@ -111,13 +111,12 @@ TextureRenderBuffer::~TextureRenderBuffer()
 
 void TextureRenderBuffer::OnRenderBegin(const CommonFrameInfo& frameInfo)
 {
-    RenderPool* renderPool = renderDevice_->GetRenderPool();
-
-    currentSize_ = CalculateRenderTargetSize(frameInfo.viewportRect_, sizeMultiplier_, fixedSize_);
+    // Viewport-sized buffers follow internal render resolution
+    const Vector2 sizeMultiplier = sizeMultiplier_ * frameInfo.renderScale_;
+    currentSize_ = CalculateRenderTargetSize(frameInfo.viewportRect_, sizeMultiplier, fixedSize_);
 
     const bool noAutoResolve = params_.flags_.Test(RenderBufferFlag::NoMultiSampledAutoResolve);
     const bool isCubemap = params_.flags_.Test(RenderBufferFlag::CubeMap);
-    const bool isFiltered = params_.flags_.Test(RenderBufferFlag::BilinearFiltering);
     const bool isPersistent = params_.flags_.Test(RenderBufferFlag::Persistent);
     const bool isDepthStencil = IsDepthTextureFormat(params_.textureFormat_);
 
@@ -132,34 +131,62 @@ void TextureRenderBuffer::OnRenderBegin(const CommonFrameInfo& frameInfo)
     params.numLevels_ = 1;
     params.multiSample_ = params_.multiSampleLevel_;
 
-    currentTexture_ = renderPool->GetTexture(params, isPersistent ? this : nullptr);
-    currentTexture_->SetSamplerStateDesc(isFiltered ? SamplerStateDesc::Bilinear() : SamplerStateDesc::Nearest());
+    // Transient textures are acquired on first use and released after last use,
+    // so buffers with disjoint lifetimes within the frame can share the same texture
+    currentParams_ = params;
+    currentTexture_ = nullptr;
+    if (isPersistent)
+        AcquireTexture();
 
     bufferIsReady_ = true;
 }
 
 void TextureRenderBuffer::OnRenderEnd(const CommonFrameInfo& frameInfo)
 {
+    ReleaseTransientTexture();
     currentTexture_ = nullptr;
     bufferIsReady_ = false;
 }
 
+RawTexture* TextureRenderBuffer::AcquireTexture() const
+{
+    if (!currentTexture_)
+    {
+        const bool isFiltered = params_.flags_.Test(RenderBufferFlag::BilinearFiltering);
+        const bool isPersistent = params_.flags_.Test(RenderBufferFlag::Persistent);
+
+        RenderPool* renderPool = renderDevice_->GetRenderPool();
+        currentTexture_ = renderPool->GetTexture(currentParams_, isPersistent ? this : nullptr);
+        currentTexture_->SetSamplerStateDesc(isFiltered ? SamplerStateDesc::Bilinear() : SamplerStateDesc::Nearest());
+    }
+    return currentTexture_;
+}
+
+void TextureRenderBuffer::ReleaseTransientTexture()
+{
+    if (currentTexture_ && !params_.flags_.Test(RenderBufferFlag::Persistent))
+    {
+        renderDevice_->GetRenderPool()->ReleaseTexture(currentTexture_);
+        currentTexture_ = nullptr;
+    }
+}
+
 RawTexture* TextureRenderBuffer::GetTexture() const
 {
     URHO3D_ASSERT(CheckIfBufferIsReady());
-    return currentTexture_;
+    return AcquireTexture();
 }
 
 RenderTargetView TextureRenderBuffer::GetView(unsigned slice) const
 {
     URHO3D_ASSERT(CheckIfBufferIsReady());
-    return RenderTargetView::TextureSlice(currentTexture_, slice);
+    return RenderTargetView::TextureSlice(AcquireTexture(), slice);
 }
 
 RenderTargetView TextureRenderBuffer::GetReadOnlyDepthView(unsigned slice) const
 {
     URHO3D_ASSERT(CheckIfBufferIsReady());
-    return RenderTargetView::ReadOnlyDepthSlice(currentTexture_, slice);
+    return RenderTargetView::ReadOnlyDepthSlice(AcquireTexture(), slice);
 }
 
 IntRect TextureRenderBuffer::GetViewportRect() const
@@ -53,6 +53,9 @@ public:
     /// Return effective viewport rectangle.
     /// Always equal to whole texture for TextureRenderBuffer, not so for viewport buffers.
     virtual IntRect GetViewportRect() const = 0;
+    /// Return texture to the pool if the buffer is not needed until the end of rendering.
+    /// Other buffers may reuse the texture. Next access to the buffer acquires new texture, contents are lost.
+    virtual void ReleaseTransientTexture() {}
 
 protected:
     RenderBuffer(RenderPipelineInterface* renderPipeline);
@@ -85,11 +88,14 @@ public:
     RenderTargetView GetView(unsigned slice) const override;
     RenderTargetView GetReadOnlyDepthView(unsigned slice) const override;
     IntRect GetViewportRect() const override;
+    void ReleaseTransientTexture() override;
     /// @}
 
 private:
     void OnRenderBegin(const CommonFrameInfo& frameInfo) override;
     void OnRenderEnd(const CommonFrameInfo& frameInfo) override;
+    /// Acquire texture from the pool on first access.
+    RawTexture* AcquireTexture() const;
 
     /// Immutable properties
     /// @{
@@ -101,7 +107,8 @@ private:
     /// Current frame info
     /// @{
     IntVector2 currentSize_;
-    RawTexture* currentTexture_{};
+    RawTextureParams currentParams_;
+    mutable RawTexture* currentTexture_{};
     /// @}
 };
 
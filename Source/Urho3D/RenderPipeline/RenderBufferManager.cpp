@@ -391,6 +391,8 @@ void RenderBufferManager::DrawQuad(ea::string_view debugComment, const DrawQuadP
         drawQueue_->AddShaderParameter(ShaderConsts::Camera_GBufferOffsets, params.clipToUVOffsetAndScale_);
         drawQueue_->AddShaderParameter(ShaderConsts::Camera_GBufferInvSize, params.invInputSize_);
         drawQueue_->AddShaderParameter(ShaderConsts::Camera_ViewProj, projection);
+        for (const ShaderParameterDesc& shaderParameter : params.cameraParameters_)
+            drawQueue_->AddShaderParameter(shaderParameter.name_, shaderParameter.value_);
         drawQueue_->CommitShaderParameterGroup(SP_CAMERA);
     }
 
@@ -503,6 +505,14 @@ void RenderBufferManager::OnRenderBegin(const CommonFrameInfo& frameInfo)
     timeStep_ = frameInfo.timeStep_;
     viewportRect_ = frameInfo.viewportRect_;
 
+    // Scaled rendering always goes to substitute buffers, they are upscaled to the viewport at the end
+    const bool isScaledOutput = frameInfo.renderScale_ != 1.0f;
+    if (isScaledOutput)
+    {
+        const Vector2 scaledSize = frameInfo.viewportRect_.Size().ToVector2() * frameInfo.renderScale_;
+        viewportRect_ = IntRect{IntVector2::ZERO, VectorMax(IntVector2::ONE, VectorRoundToInt(scaledSize))};
+    }
+
     // Get parameters of output render surface
     const TextureFormat outputFormat = RenderSurface::GetColorFormat(graphics_, frameInfo.renderTarget_);
     const int outputMultiSample = RenderSurface::GetMultiSample(graphics_, frameInfo.renderTarget_);
@@ -512,8 +522,8 @@ void RenderBufferManager::OnRenderBegin(const CommonFrameInfo& frameInfo)
     const bool outputHasReadableDepth = outputDepthStencil && HasReadableDepth(*outputDepthStencil);
 
     Texture2D* outputTexture = GetParentTexture2D(frameInfo.renderTarget_);
-    const bool isFullRectOutput =
-        viewportRect_ == IntRect::ZERO || viewportRect_ == RenderSurface::GetRect(graphics_, frameInfo.renderTarget_);
+    const bool isFullRectOutput = frameInfo.viewportRect_ == IntRect::ZERO
+        || frameInfo.viewportRect_ == RenderSurface::GetRect(graphics_, frameInfo.renderTarget_);
     const bool isSimpleTextureOutput = outputTexture != nullptr && isFullRectOutput;
     const bool isBilinearFilteredOutput = outputTexture && outputTexture->GetFilterMode() != FILTER_NEAREST;
 
@@ -529,7 +539,7 @@ void RenderBufferManager::OnRenderBegin(const CommonFrameInfo& frameInfo)
         isColorFormatMatching && isMultiSampleMatching && isFilterMatching && isColorUsageMatching;
 
     const bool needSecondaryBuffer = frameSettings_.supportColorReadWrite_;
-    const bool needSubstituteDepthBuffer = !isMultiSampleMatching || !outputDepthStencil.has_value()
+    const bool needSubstituteDepthBuffer = isScaledOutput || !isMultiSampleMatching || !outputDepthStencil.has_value()
         || ((needSecondaryBuffer || !isOutputMatching) && outputDepthStencil.value() == nullptr)
         || (settings_.readableDepth_ && (!outputHasReadableDepth || !isSimpleTextureOutput))
         || (settings_.stencilBuffer_ && !outputHasStencil);
@@ -562,9 +572,12 @@ void RenderBufferManager::OnRenderEnd(const CommonFrameInfo& frameInfo)
     if (writeableColorBuffer_ != viewportColorBuffer_.Get())
     {
         RawTexture* colorTexture = writeableColorBuffer_->GetTexture();
-        CopyTextureRegion("Copy final color to output RenderSurface", colorTexture,
-            IntRect{IntVector2::ZERO, colorTexture->GetParams().size_.ToIntVector2()}, viewportColorBuffer_->GetView(),
-            viewportColorBuffer_->GetViewportRect(), ColorSpaceTransition::Automatic, false);
+        const bool upscale = frameInfo.renderScale_ < 1.0f;
+        const ea::string_view debugComment =
+            upscale ? "Upscale final color to output RenderSurface" : "Copy final color to output RenderSurface";
+        const IntRect sourceRect{IntVector2::ZERO, colorTexture->GetParams().size_.ToIntVector2()};
+        CopyTextureRegion(debugComment, colorTexture, sourceRect, viewportColorBuffer_->GetView(),
+            viewportColorBuffer_->GetViewportRect(), ColorSpaceTransition::Automatic, false, upscale);
 
         // If viewport is reused for ping-ponging, optimize away final copy
         flipColorBuffersNextTime_ ^= viewportColorBuffer_ == readableColorBuffer_;
@@ -587,6 +600,12 @@ void RenderBufferManager::InitializePipelineStates()
         CreateQuadPipelineState(BLEND_REPLACE, "v2/X_CopyFramebuffer", "URHO3D_GAMMA_TO_LINEAR", samplers);
     copyLinearToGammaTexturePipelineState_ =
         CreateQuadPipelineState(BLEND_REPLACE, "v2/X_CopyFramebuffer", "URHO3D_LINEAR_TO_GAMMA", samplers);
+    upscaleTexturePipelineState_ =
+        CreateQuadPipelineState(BLEND_REPLACE, "v2/X_CopyFramebuffer", "URHO3D_BICUBIC", samplers);
+    upscaleGammaToLinearTexturePipelineState_ = CreateQuadPipelineState(
+        BLEND_REPLACE, "v2/X_CopyFramebuffer", "URHO3D_GAMMA_TO_LINEAR URHO3D_BICUBIC", samplers);
+    upscaleLinearToGammaTexturePipelineState_ = CreateQuadPipelineState(
+        BLEND_REPLACE, "v2/X_CopyFramebuffer", "URHO3D_LINEAR_TO_GAMMA URHO3D_BICUBIC", samplers);
 
     for (unsigned i = 0; i < MaxClearVariants; ++i)
     {
@@ -597,15 +616,22 @@ void RenderBufferManager::InitializePipelineStates()
 
 void RenderBufferManager::CopyTextureRegion(ea::string_view debugComment,
     RawTexture* sourceTexture, const IntRect& sourceRect,
-    RenderTargetView destinationSurface, const IntRect& destinationRect, ColorSpaceTransition mode, bool flipVertical)
+    RenderTargetView destinationSurface, const IntRect& destinationRect, ColorSpaceTransition mode, bool flipVertical,
+    bool upscale)
 {
     renderContext_->SetRenderTargets(ea::nullopt, {&destinationSurface, 1});
     renderContext_->SetViewport(destinationRect);
-    DrawTextureRegion(debugComment, sourceTexture, sourceRect, mode, flipVertical);
+    DrawTextureRegionImpl(debugComment, sourceTexture, sourceRect, mode, flipVertical, upscale);
 }
 
 void RenderBufferManager::DrawTextureRegion(ea::string_view debugComment, RawTexture* sourceTexture,
     const IntRect& sourceRect, ColorSpaceTransition mode, bool flipVertical)
+{
+    DrawTextureRegionImpl(debugComment, sourceTexture, sourceRect, mode, flipVertical, false);
+}
+
+void RenderBufferManager::DrawTextureRegionImpl(ea::string_view debugComment, RawTexture* sourceTexture,
+    const IntRect& sourceRect, ColorSpaceTransition mode, bool flipVertical, bool upscale)
 {
     if (sourceTexture->GetParams().type_ != TextureType::Texture2D)
     {
@@ -620,11 +646,17 @@ void RenderBufferManager::DrawTextureRegion(ea::string_view debugComment, RawTex
     DrawQuadParams callParams;
 
     if (mode == ColorSpaceTransition::None || isSRGBSource == isSRGBDestination)
-        callParams.pipelineStateId_ = copyTexturePipelineState_;
+        callParams.pipelineStateId_ = upscale ? upscaleTexturePipelineState_ : copyTexturePipelineState_;
     else if (isSRGBDestination)
-        callParams.pipelineStateId_ = copyGammaToLinearTexturePipelineState_;
+    {
+        callParams.pipelineStateId_ =
+            upscale ? upscaleGammaToLinearTexturePipelineState_ : copyGammaToLinearTexturePipelineState_;
+    }
     else
-        callParams.pipelineStateId_ = copyLinearToGammaTexturePipelineState_;
+    {
+        callParams.pipelineStateId_ =
+            upscale ? upscaleLinearToGammaTexturePipelineState_ : copyLinearToGammaTexturePipelineState_;
+    }
 
     const IntVector2 size = sourceTexture->GetParams().size_.ToIntVector2();
     callParams.invInputSize_ = Vector2::ONE / size.ToVector2();
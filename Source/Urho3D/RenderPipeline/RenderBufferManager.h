@@ -48,6 +48,8 @@ struct DrawQuadParams
     bool bindSecondaryColorToDiffuse_{};
     ea::span<const ShaderResourceDesc> resources_;
     ea::span<const ShaderParameterDesc> parameters_;
+    /// Extra parameters of camera group, e.g. for light clusters.
+    ea::span<const ShaderParameterDesc> cameraParameters_;
 };
 
 /// Controls how DrawTexture[Region] handles Gamma and Linear color space.
@@ -157,6 +159,7 @@ public:
     RawTexture* GetSecondaryColorTexture() const { return readableColorBuffer_ ? readableColorBuffer_->GetTexture() : nullptr; }
 
     /// Return size of output region (not size of output texture itself).
+    /// Output region is smaller than the viewport if render scale is less than one.
     IntVector2 GetOutputSize() const { return viewportRect_.Size(); }
     Vector2 GetInvOutputSize() const { return Vector2::ONE / GetOutputSize().ToVector2(); }
     /// Return identity offset and scale used to convert clip space to UV space.
@@ -180,7 +183,11 @@ private:
     void InitializePipelineStates();
     void ResetCachedRenderBuffers();
     void CopyTextureRegion(ea::string_view debugComment, RawTexture* sourceTexture, const IntRect& sourceRect,
-        RenderTargetView destinationSurface, const IntRect& destinationRect, ColorSpaceTransition mode, bool flipVertical);
+        RenderTargetView destinationSurface, const IntRect& destinationRect, ColorSpaceTransition mode,
+        bool flipVertical, bool upscale);
+    /// Draw region of input texture. Bicubic filter is used if upscaling.
+    void DrawTextureRegionImpl(ea::string_view debugComment, RawTexture* sourceTexture, const IntRect& sourceRect,
+        ColorSpaceTransition mode, bool flipVertical, bool upscale);
 
     /// External dependencies
     /// @{
@@ -204,6 +211,9 @@ private:
     StaticPipelineStateId copyTexturePipelineState_{};
     StaticPipelineStateId copyGammaToLinearTexturePipelineState_{};
     StaticPipelineStateId copyLinearToGammaTexturePipelineState_{};
+    StaticPipelineStateId upscaleTexturePipelineState_{};
+    StaticPipelineStateId upscaleGammaToLinearTexturePipelineState_{};
+    StaticPipelineStateId upscaleLinearToGammaTexturePipelineState_{};
     StaticPipelineStateId clearPipelineState_[MaxClearVariants]{};
 
     SharedPtr<RenderBuffer> substituteRenderBuffers_[2];
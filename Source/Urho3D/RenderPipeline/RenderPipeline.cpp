@@ -142,8 +142,10 @@ void RenderPipeline::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE_EX("PCF Kernel Size", unsigned, settings_.sceneProcessor_.pcfKernelSize_, MarkSettingsDirty, 1, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Use Variance Shadow Maps", bool, settings_.shadowMapAllocator_.enableVarianceShadowMaps_, MarkSettingsDirty, false, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("VSM Shadow Settings", Vector2, settings_.sceneProcessor_.varianceShadowMapParams_, MarkSettingsDirty, BatchRendererSettings{}.varianceShadowMapParams_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Radix Sort Batches", bool, settings_.sceneProcessor_.radixSortBatches_, MarkSettingsDirty, BatchRendererSettings{}.radixSortBatches_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("VSM Multi Sample", unsigned, settings_.shadowMapAllocator_.varianceShadowMapMultiSample_, MarkSettingsDirty, 1, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("16-bit Shadow Maps", bool, settings_.shadowMapAllocator_.use16bitShadowMaps_, MarkSettingsDirty, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Cache Static Shadow Maps", bool, settings_.shadowMapAllocator_.cacheStaticShadowMaps_, MarkSettingsDirty, false, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Auto Exposure", bool, settings_.autoExposure_.autoExposure_, MarkSettingsDirty, false, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Min Exposure", float, settings_.autoExposure_.minExposure_, MarkSettingsDirty, AutoExposurePassSettings{}.minExposure_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Max Exposure", float, settings_.autoExposure_.maxExposure_, MarkSettingsDirty, AutoExposurePassSettings{}.maxExposure_, AM_DEFAULT);
@@ -177,6 +179,13 @@ void RenderPipeline::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE_EX("Depth Bias Scale", float, settings_.shadowMapAllocator_.depthBiasScale_, MarkSettingsDirty, 1.0f, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Depth Bias Offset", float, settings_.shadowMapAllocator_.depthBiasOffset_, MarkSettingsDirty, 0.0f, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Normal Offset Scale", float, settings_.sceneProcessor_.normalOffsetScale_, MarkSettingsDirty, 1.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Clustered Lighting", bool, settings_.sceneProcessor_.clusteredLighting_, MarkSettingsDirty, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Dynamic Resolution", bool, settings_.dynamicResolution_.enabled_, MarkSettingsDirty, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Target Frame Time", float, settings_.dynamicResolution_.targetFrameTime_, MarkSettingsDirty, DynamicResolutionSettings{}.targetFrameTime_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Min Render Scale", float, settings_.dynamicResolution_.minScale_, MarkSettingsDirty, DynamicResolutionSettings{}.minScale_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Max Render Scale", float, settings_.dynamicResolution_.maxScale_, MarkSettingsDirty, DynamicResolutionSettings{}.maxScale_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Render Scale Step", float, settings_.dynamicResolution_.scaleStep_, MarkSettingsDirty, DynamicResolutionSettings{}.scaleStep_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Render Scale Interval", unsigned, settings_.dynamicResolution_.adjustInterval_, MarkSettingsDirty, DynamicResolutionSettings{}.adjustInterval_, AM_DEFAULT);
 }
 
 void RenderPipeline::SetSettings(const RenderPipelineSettings& settings)
@@ -139,20 +139,20 @@ void RenderPipelineSettings::PropagateImpliedSettings()
         renderBufferManager_.inheritMultiSampleLevel_ = false;
     }
 
-    // Setup instancing buffer format
+    // Setup instancing buffer format: world transform, custom instance data and optional ambient
     if (instancingBuffer_.enableInstancing_)
     {
         instancingBuffer_.firstInstancingTexCoord_ = 4;
         switch (sceneProcessor_.ambientMode_)
         {
         case DrawableAmbientMode::Constant:
-            instancingBuffer_.numInstancingTexCoords_ = 3;
+            instancingBuffer_.numInstancingTexCoords_ = 3 + 1;
             break;
         case DrawableAmbientMode::Flat:
-            instancingBuffer_.numInstancingTexCoords_ = 3 + 1;
+            instancingBuffer_.numInstancingTexCoords_ = 3 + 1 + 1;
             break;
         case DrawableAmbientMode::Directional:
-            instancingBuffer_.numInstancingTexCoords_ = 3 + 7;
+            instancingBuffer_.numInstancingTexCoords_ = 3 + 1 + 7;
             break;
         }
     }
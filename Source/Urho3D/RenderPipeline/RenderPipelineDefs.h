@@ -64,6 +64,9 @@ struct CommonFrameInfo
     RenderSurface* renderTarget_{};
 
     ea::array<Camera*, 2> cameras_{};
+
+    /// Scale of internal render resolution relative to viewport size.
+    float renderScale_{1.0f};
 };
 
 /// Traits of scene pass.
@@ -312,6 +315,8 @@ public:
     virtual unsigned GetShadowMapSize(Light* light, unsigned numActiveSplits) const = 0;
     /// Allocate shadow map for one frame.
     virtual ShadowMapRegion AllocateTransientShadowMap(const IntVector2& size) = 0;
+    /// Allocate shadow map that keeps its contents between frames. Return empty region if not supported.
+    virtual ShadowMapRegion AllocatePersistentShadowMap(Light* light, const IntVector2& size, bool& isContentPreserved) = 0;
 };
 
 struct LightProcessorCacheSettings
@@ -343,6 +348,9 @@ struct DrawableProcessorSettings
     unsigned maxPixelLights_{ 4 };
     unsigned pcfKernelSize_{ 1 };
     float normalOffsetScale_{1.0f};
+    /// Whether to evaluate unshadowed point and spot lights in the ambient pass from light clusters.
+    /// For deferred lighting, these lights are applied to geometry buffer in one fullscreen pass instead of light volumes.
+    bool clusteredLighting_{};
     LightProcessorCacheSettings lightProcessorCache_;
 
     /// Utility operators
@@ -353,6 +361,7 @@ struct DrawableProcessorSettings
         CombineHash(hash, maxVertexLights_);
         CombineHash(hash, pcfKernelSize_);
         CombineHash(hash, MakeHash(normalOffsetScale_));
+        CombineHash(hash, clusteredLighting_);
         return hash;
     }
 
@@ -375,7 +384,8 @@ struct DrawableProcessorSettings
             && maxPixelLights_ == rhs.maxPixelLights_
             && pcfKernelSize_ == rhs.pcfKernelSize_
             && lightProcessorCache_ == rhs.lightProcessorCache_
-            && normalOffsetScale_ == rhs.normalOffsetScale_;
+            && normalOffsetScale_ == rhs.normalOffsetScale_
+            && clusteredLighting_ == rhs.clusteredLighting_;
     }
 
     bool operator!=(const DrawableProcessorSettings& rhs) const { return !(*this == rhs); }
@@ -429,6 +439,8 @@ struct BatchRendererSettings
     bool cubemapBoxProjection_{};
     DrawableAmbientMode ambientMode_{ DrawableAmbientMode::Directional };
     Vector2 varianceShadowMapParams_{ 0.0000001f, 0.9f };
+    /// Whether to sort batches with radix sort instead of comparison sort.
+    bool radixSortBatches_{};
 
     /// Utility operators
     /// @{
@@ -448,7 +460,8 @@ struct BatchRendererSettings
     {
         return cubemapBoxProjection_ == rhs.cubemapBoxProjection_
             && ambientMode_ == rhs.ambientMode_
-            && varianceShadowMapParams_ == rhs.varianceShadowMapParams_;
+            && varianceShadowMapParams_ == rhs.varianceShadowMapParams_
+            && radixSortBatches_ == rhs.radixSortBatches_;
     }
 
     bool operator!=(const BatchRendererSettings& rhs) const { return !(*this == rhs); }
@@ -461,6 +474,9 @@ struct ShadowMapAllocatorSettings
     int varianceShadowMapMultiSample_{ 1 };
     bool use16bitShadowMaps_{};
     unsigned shadowAtlasPageSize_{ 2048 };
+    /// Whether to keep shadow maps of point and spot lights between frames
+    /// and re-render them only when the light or shadow casters change.
+    bool cacheStaticShadowMaps_{};
 
     float depthBiasScale_{1.0f};
     float depthBiasOffset_{0.0f};
@@ -490,6 +506,7 @@ struct ShadowMapAllocatorSettings
             && varianceShadowMapMultiSample_ == rhs.varianceShadowMapMultiSample_
             && use16bitShadowMaps_ == rhs.use16bitShadowMaps_
             && shadowAtlasPageSize_ == rhs.shadowAtlasPageSize_
+            && cacheStaticShadowMaps_ == rhs.cacheStaticShadowMaps_
             && depthBiasScale_ == rhs.depthBiasScale_
             && depthBiasOffset_ == rhs.depthBiasOffset_;
     }
@@ -789,12 +806,50 @@ enum class PostProcessAntialiasing
     FXAA3
 };
 
+/// Settings of dynamic resolution scaling.
+struct DynamicResolutionSettings
+{
+    bool enabled_{};
+    /// Frame time to maintain, in seconds.
+    float targetFrameTime_{1.0f / 60.0f};
+    float minScale_{0.5f};
+    float maxScale_{1.0f};
+    /// Render scale is changed in steps of this size so render buffers are not reallocated every frame.
+    float scaleStep_{0.05f};
+    /// Number of frames to wait after render scale is changed.
+    unsigned adjustInterval_{15};
+
+    /// Utility operators
+    /// @{
+    void Validate()
+    {
+        targetFrameTime_ = ea::max(targetFrameTime_, M_EPSILON);
+        minScale_ = Clamp(minScale_, 0.25f, 1.0f);
+        maxScale_ = Clamp(maxScale_, minScale_, 1.0f);
+        scaleStep_ = Clamp(scaleStep_, 0.01f, 0.5f);
+    }
+
+    bool operator==(const DynamicResolutionSettings& rhs) const
+    {
+        return enabled_ == rhs.enabled_
+            && targetFrameTime_ == rhs.targetFrameTime_
+            && minScale_ == rhs.minScale_
+            && maxScale_ == rhs.maxScale_
+            && scaleStep_ == rhs.scaleStep_
+            && adjustInterval_ == rhs.adjustInterval_;
+    }
+
+    bool operator!=(const DynamicResolutionSettings& rhs) const { return !(*this == rhs); }
+    /// @}
+};
+
 /// Settings of default render pipeline.
 struct RenderPipelineSettings : public ShaderProgramCompositorSettings
 {
     /// Global pipeline settings
     /// @{
     bool drawDebugGeometry_{true};
+    DynamicResolutionSettings dynamicResolution_;
     /// @}
 
     /// Post-processing settings
@@ -823,6 +878,7 @@ struct RenderPipelineSettings : public ShaderProgramCompositorSettings
     {
         ShaderProgramCompositorSettings::Validate();
 
+        dynamicResolution_.Validate();
         autoExposure_.Validate();
         bloom_.Validate();
     }
@@ -831,6 +887,7 @@ struct RenderPipelineSettings : public ShaderProgramCompositorSettings
     {
         return ShaderProgramCompositorSettings::operator==(rhs)
             && drawDebugGeometry_ == rhs.drawDebugGeometry_
+            && dynamicResolution_ == rhs.dynamicResolution_
             && autoExposure_ == rhs.autoExposure_
             && bloom_ == rhs.bloom_
             && toneMapping_ == rhs.toneMapping_
@@ -29,8 +29,6 @@
 #include "../RenderPipeline/BatchRenderer.h"
 #include "../RenderPipeline/ScenePass.h"
 
-#include <EASTL/sort.h>
-
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -57,12 +55,15 @@ void UnorderedScenePass::OnBatchesReady()
     BatchCompositor::FillSortKeys(sortedBaseBatches_, baseBatches_);
     BatchCompositor::FillSortKeys(sortedLightBatches_, lightBatches_, negativeLightBatches_);
 
-    ea::sort(sortedDeferredBatches_.begin(), sortedDeferredBatches_.end());
-    ea::sort(sortedBaseBatches_.begin(), sortedBaseBatches_.end());
+    SortPipelineBatches(sortedDeferredBatches_, radixSortBatches_, workQueue_);
+    SortPipelineBatches(sortedBaseBatches_, radixSortBatches_, workQueue_);
 
     const unsigned numNegativeLightBatches = negativeLightBatches_.Size();
-    ea::sort(sortedLightBatches_.begin(), sortedLightBatches_.end() - numNegativeLightBatches);
-    ea::sort(sortedLightBatches_.end() - numNegativeLightBatches, sortedLightBatches_.end());
+    const unsigned numPositiveLightBatches = sortedLightBatches_.size() - numNegativeLightBatches;
+    SortPipelineBatches(ea::span<PipelineBatchByState>(sortedLightBatches_).first(numPositiveLightBatches),
+        radixSortBatches_, workQueue_);
+    SortPipelineBatches(ea::span<PipelineBatchByState>(sortedLightBatches_).last(numNegativeLightBatches),
+        radixSortBatches_, workQueue_);
 
     deferredBatchGroup_ = { sortedDeferredBatches_ };
     baseBatchGroup_ = { sortedBaseBatches_ };
@@ -131,7 +132,7 @@ void BackToFrontScenePass::OnBatchesReady()
     static const float additiveDistanceFactor = 1 - M_EPSILON;
     static const float subtractiveDistanceFactor = 1 - 2 * M_EPSILON;
 
-    // Validate distances before sorting, NaN may corrupt ea::sort
+    // Validate distances before sorting, NaN may corrupt sorting
     for (PipelineBatchBackToFront& sortedBatch : sortedBatches_)
     {
         if (std::isfinite(sortedBatch.distance_))
@@ -149,7 +150,7 @@ void BackToFrontScenePass::OnBatchesReady()
     for (unsigned i = subtractiveLightBatchesBegin; i < subtractiveLightBatchesEnd; ++i)
         sortedBatches_[i].distance_ *= subtractiveDistanceFactor;
 
-    ea::sort(sortedBatches_.begin(), sortedBatches_.end());
+    SortPipelineBatches(sortedBatches_, radixSortBatches_, workQueue_);
 
     if (GetFlags().Test(DrawableProcessorPassFlag::RefractionPass))
     {
@@ -29,6 +29,7 @@
 #include "../Graphics/OcclusionBuffer.h"
 #include "../Graphics/Octree.h"
 #include "../Graphics/OctreeQuery.h"
+#include "../Graphics/PrecomputedVisibility.h"
 #include "../Graphics/ReflectionProbe.h"
 #include "../Graphics/Renderer.h"
 #include "../Graphics/RenderSurface.h"
@@ -37,6 +38,7 @@
 #include "../RenderPipeline/BatchCompositor.h"
 #include "../RenderPipeline/BatchRenderer.h"
 #include "../RenderPipeline/CameraProcessor.h"
+#include "../RenderPipeline/ClusteredLighting.h"
 #include "../RenderPipeline/DrawableProcessor.h"
 #include "../RenderPipeline/InstancingBuffer.h"
 #include "../RenderPipeline/LightProcessor.h"
@@ -53,6 +55,8 @@
 #include "../RenderAPI/RenderScope.h"
 #include "../Scene/Scene.h"
 
+#include <EASTL/fixed_vector.h>
+
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -73,33 +77,37 @@ public:
     /// Intersection test for drawables.
     void TestDrawables(Drawable** start, Drawable** end, bool inside) override
     {
-        for (Drawable* drawable : MakeIteratorRange(start, end))
+        const auto filter = [this](Drawable* drawable)
         {
-            const DrawableFlags flags = drawable->GetDrawableFlags();
-            if (flags == DRAWABLE_GEOMETRY && drawable->IsOccluder() && (drawable->GetViewMask() & viewMask_))
-            {
-                if (inside || frustum_.IsInsideFast(drawable->GetWorldBoundingBox()))
-                    result_.push_back(drawable);
-            }
-        }
+            return drawable->GetDrawableFlags() == DRAWABLE_GEOMETRY && drawable->IsOccluder()
+                && (drawable->GetViewMask() & viewMask_);
+        };
+        TestDrawablesInFrustum(start, end, inside, filter, [this](Drawable* drawable) { result_.push_back(drawable); });
     }
 };
 
+/// Frustum query that also culls octants by occlusion buffer and drawables by precomputed visibility, if any.
+/// Precomputed visibility is checked before the frustum test.
+/// Note: drawable occlusion is performed later in worker threads.
 class OccludedFrustumOctreeQuery : public FrustumOctreeQuery
 {
 public:
-    /// Construct with frustum, occlusion buffer and query parameters.
+    /// Construct with frustum, occlusion buffer, precomputed visibility and query parameters.
     OccludedFrustumOctreeQuery(ea::vector<Drawable*>& result, const Frustum& frustum, OcclusionBuffer* buffer,
+                               const PrecomputedVisibility* visibility,
                                DrawableFlags drawableFlags = DRAWABLE_ANY, unsigned viewMask = DEFAULT_VIEWMASK) :
         FrustumOctreeQuery(result, frustum, drawableFlags, viewMask),
-        buffer_(buffer)
+        buffer_(buffer),
+        visibility_(visibility)
     {
     }
 
     /// Intersection test for an octant.
     Intersection TestOctant(const BoundingBox& box, bool inside) override
     {
-        if (inside)
+        if (!buffer_)
+            return FrustumOctreeQuery::TestOctant(box, inside);
+        else if (inside)
             return buffer_->IsVisible(box) ? INSIDE : OUTSIDE;
         else
         {
@@ -110,21 +118,27 @@ public:
         }
     }
 
-    /// Intersection test for drawables. Note: drawable occlusion is performed later in worker threads.
+    /// Intersection test for drawables.
     void TestDrawables(Drawable** start, Drawable** end, bool inside) override
     {
-        for (Drawable* drawable : MakeIteratorRange(start, end))
+        if (!visibility_)
         {
-            if ((drawable->GetDrawableFlags() & drawableFlags_) && (drawable->GetViewMask() & viewMask_))
-            {
-                if (inside || frustum_.IsInsideFast(drawable->GetWorldBoundingBox()))
-                    result_.push_back(drawable);
-            }
+            FrustumOctreeQuery::TestDrawables(start, end, inside);
+            return;
         }
+
+        const auto filter = [this](Drawable* drawable)
+        {
+            return (drawable->GetDrawableFlags() & drawableFlags_) && (drawable->GetViewMask() & viewMask_)
+                && !visibility_->IsCulled(drawable);
+        };
+        TestDrawablesInFrustum(start, end, inside, filter, [this](Drawable* drawable) { result_.push_back(drawable); });
     }
 
     /// Occlusion buffer.
     OcclusionBuffer* buffer_;
+    /// Precomputed visibility.
+    const PrecomputedVisibility* visibility_;
 };
 
 IntVector2 CalculateOcclusionBufferSize(unsigned size, Camera* cullCamera)
@@ -274,6 +288,7 @@ void SceneProcessor::SetSettings(const ShaderProgramCompositorSettings& settings
         drawableProcessor_->SetSettings(settings.sceneProcessor_);
         batchRenderer_->SetSettings(settings.sceneProcessor_);
         batchCompositor_->SetShadowMaterialQuality(settings.sceneProcessor_.materialQuality_);
+        batchCompositor_->SetRadixSortBatches(settings.sceneProcessor_.radixSortBatches_);
     }
 }
 
@@ -304,12 +319,18 @@ void SceneProcessor::Update()
         }
     }
 
+    // Baked visibility of the camera cell is applied before frustum test
+    PrecomputedVisibility* visibility = frameInfo_.scene_->GetComponent<PrecomputedVisibility>();
+    if (visibility && (!visibility->IsEnabledEffective()
+        || !visibility->UpdateCulling(frameInfo_.camera_->GetNode()->GetWorldPosition())))
+        visibility = nullptr;
+
     // Collect visible drawables
-    if (currentOcclusionBuffer_)
+    if (currentOcclusionBuffer_ || visibility)
     {
         URHO3D_PROFILE("QueryVisibleDrawables");
-        OccludedFrustumOctreeQuery query(drawables_, frustum,
-            currentOcclusionBuffer_, DRAWABLE_GEOMETRY | DRAWABLE_LIGHT, frameInfo_.camera_->GetViewMask());
+        OccludedFrustumOctreeQuery query(drawables_, frustum, currentOcclusionBuffer_, visibility,
+            DRAWABLE_GEOMETRY | DRAWABLE_LIGHT, frameInfo_.camera_->GetViewMask());
         frameInfo_.octree_->GetDrawables(query);
     }
     else
@@ -323,7 +344,18 @@ void SceneProcessor::Update()
     // Process drawables
     drawableProcessor_->ProcessVisibleDrawables(drawables_, currentOcclusionBuffer_ ? ea::span(&currentOcclusionBuffer_, 1u) : ea::span<OcclusionBuffer*>() );
     drawableProcessor_->ProcessLights(this);
-    drawableProcessor_->ProcessForwardLighting();
+    // Light clusters are built for single view, so stereo rendering keeps light volumes
+    const bool clusterDeferredLights = settings_.clusteredLighting_ && settings_.IsDeferredLighting()
+        && !frameInfo_.additionalCameras_[1];
+    drawableProcessor_->ProcessForwardLighting(clusterDeferredLights);
+
+    if (settings_.clusteredLighting_)
+    {
+        if (!clusteredLighting_)
+            clusteredLighting_ = MakeShared<ClusteredLighting>(context_);
+        clusteredLighting_->Update(frameInfo_.camera_, drawableProcessor_->GetClusteredLightProcessors(),
+            renderPipeline_->IsLinearColorSpace());
+    }
 
     batchCompositor_->ComposeSceneBatches();
     if (settings_.enableShadows_)
@@ -355,12 +387,16 @@ void SceneProcessor::PrepareInstancingBuffer()
             pass->PrepareInstancingBuffer(batchRenderer_);
     }
 
+    batchRenderer_->WriteInstancingBuffer();
     instancingBuffer_->End();
 }
 
 void SceneProcessor::PrepareDrawablesBeforeRendering()
 {
     drawableProcessor_->UpdateGeometries();
+
+    if (settings_.clusteredLighting_ && clusteredLighting_)
+        clusteredLighting_->CommitToGPU();
 }
 
 void SceneProcessor::RenderShadowMaps()
@@ -375,6 +411,10 @@ void SceneProcessor::RenderShadowMaps()
     const auto& lightsByShadowMap = drawableProcessor_->GetLightProcessorsByShadowMap();
     for (LightProcessor* sceneLight : lightsByShadowMap)
     {
+        // Persistent shadow map is kept from the previous frame
+        if (sceneLight->CheckShadowMapCache())
+            continue;
+
         const RenderScope renderScopeLight(renderContext_, "Light 0x{} '{}'",
             static_cast<void*>(sceneLight->GetLight()), sceneLight->GetLight()->GetNode()->GetName());
 
@@ -453,6 +493,23 @@ void SceneProcessor::RenderBatchesInternal(ea::string_view debugName, Camera* ca
     const bool needClipping = camera->GetUseClipping() || frameInfo_.additionalCameras_[1] != nullptr;
     drawQueue_->SetClipPlaneMask(needClipping ? (1 << 0) : 0);
 
+    // Clustered lights are used by ambient pass of forward lit geometries
+    ea::fixed_vector<ShaderResourceDesc, 16> mergedResources;
+    ea::fixed_vector<ShaderParameterDesc, 16> mergedCameraParameters;
+    if (settings_.clusteredLighting_ && clusteredLighting_)
+    {
+        const auto clusterResources = clusteredLighting_->GetShaderResources();
+        const auto clusterParameters = clusteredLighting_->GetCameraParameters();
+
+        mergedResources.assign(globalResources.begin(), globalResources.end());
+        mergedResources.insert(mergedResources.end(), clusterResources.begin(), clusterResources.end());
+        mergedCameraParameters.assign(cameraParameters.begin(), cameraParameters.end());
+        mergedCameraParameters.insert(mergedCameraParameters.end(), clusterParameters.begin(), clusterParameters.end());
+
+        globalResources = mergedResources;
+        cameraParameters = mergedCameraParameters;
+    }
+
     BatchRenderingContext ctx{ *drawQueue_, *camera };
     ctx.instanceMultiplier_ = instanceMultiplier;
     ctx.globalResources_ = globalResources;
@@ -536,6 +593,11 @@ ShadowMapRegion SceneProcessor::AllocateTransientShadowMap(const IntVector2& siz
     return shadowMapAllocator_->AllocateShadowMap(size);
 }
 
+ShadowMapRegion SceneProcessor::AllocatePersistentShadowMap(Light* light, const IntVector2& size, bool& isContentPreserved)
+{
+    return shadowMapAllocator_->AllocatePersistentShadowMap(light, size, isContentPreserved);
+}
+
 void SceneProcessor::DrawOccluders()
 {
     const auto& activeOccluders = drawableProcessor_->GetOccluders();
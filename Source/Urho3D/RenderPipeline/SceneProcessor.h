@@ -31,6 +31,7 @@ namespace Urho3D
 class BatchCompositor;
 class BatchRenderer;
 class CameraProcessor;
+class ClusteredLighting;
 class Drawable;
 class DrawableProcessor;
 class DrawCommandQueue;
@@ -103,6 +104,7 @@ public:
     DrawableProcessor* GetDrawableProcessor() const { return drawableProcessor_; }
     BatchCompositor* GetBatchCompositor() const { return batchCompositor_; }
     BatchRenderer* GetBatchRenderer() const { return batchRenderer_; }
+    ClusteredLighting* GetClusteredLighting() const { return clusteredLighting_; }
     /// @}
 
 protected:
@@ -121,6 +123,7 @@ private:
     bool IsLightShadowed(Light* light) override;
     unsigned GetShadowMapSize(Light* light, unsigned numActiveSplits) const override;
     ShadowMapRegion AllocateTransientShadowMap(const IntVector2& size) override;
+    ShadowMapRegion AllocatePersistentShadowMap(Light* light, const IntVector2& size, bool& isContentPreserved) override;
     /// @}
 
     template <class T>
@@ -149,6 +152,7 @@ protected:
     SharedPtr<BatchCompositor> batchCompositor_;
     SharedPtr<BatchRenderer> batchRenderer_;
     SharedPtr<OcclusionBuffer> occlusionBuffer_;
+    SharedPtr<ClusteredLighting> clusteredLighting_;
     BatchStateCacheCallback* batchStateCacheCallback_{};
     /// @}
 
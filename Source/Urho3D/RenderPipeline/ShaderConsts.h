@@ -50,6 +50,9 @@ namespace ShaderConsts
     URHO3D_SHADER_CONST(Camera, FogParams);
     URHO3D_SHADER_CONST(Camera, FogColor);
     URHO3D_SHADER_CONST(Camera, NormalOffsetScale);
+    URHO3D_SHADER_CONST(Camera, ClusterViewProj);
+    URHO3D_SHADER_CONST(Camera, ClusterViewZ);
+    URHO3D_SHADER_CONST(Camera, ClusterParams);
 
     URHO3D_SHADER_CONST(Zone, CubemapCenter0);
     URHO3D_SHADER_CONST(Zone, CubemapCenter1);
@@ -97,6 +100,7 @@ namespace ShaderConsts
     URHO3D_SHADER_CONST(Custom, OutlineColor);
 
     URHO3D_SHADER_CONST(Object, Model);
+    URHO3D_SHADER_CONST(Object, InstanceData);
     URHO3D_SHADER_CONST(Object, SHAr);
     URHO3D_SHADER_CONST(Object, SHAg);
     URHO3D_SHADER_CONST(Object, SHAb);
@@ -123,6 +127,9 @@ namespace ShaderResources
     URHO3D_SHADER_RESOURCE(LightShape);
     URHO3D_SHADER_RESOURCE(ShadowMap);
     URHO3D_SHADER_RESOURCE(DepthBuffer);
+    URHO3D_SHADER_RESOURCE(ClusterLights);
+    URHO3D_SHADER_RESOURCE(ClusterGrid);
+    URHO3D_SHADER_RESOURCE(ClusterLightIndices);
 }
 
 }
@@ -280,8 +280,13 @@ void ShaderProgramCompositor::ApplyAmbientLightingVertexAndCommonDefinesForUserP
     result.AddCommonShaderDefines("URHO3D_AMBIENT_PASS");
     if (isGeometryBufferPass)
         result.AddCommonShaderDefines("URHO3D_GBUFFER_PASS");
-    else if (settings_.sceneProcessor_.maxVertexLights_ > 0)
-        result.AddCommonShaderDefines(Format("URHO3D_NUM_VERTEX_LIGHTS={}", settings_.sceneProcessor_.maxVertexLights_));
+    else
+    {
+        if (settings_.sceneProcessor_.maxVertexLights_ > 0)
+            result.AddCommonShaderDefines(Format("URHO3D_NUM_VERTEX_LIGHTS={}", settings_.sceneProcessor_.maxVertexLights_));
+        if (settings_.sceneProcessor_.clusteredLighting_)
+            result.AddCommonShaderDefines("URHO3D_CLUSTERED_LIGHTS");
+    }
 
     if (drawable->GetGlobalIlluminationType() == GlobalIlluminationType::UseLightMap)
         result.AddCommonShaderDefines("URHO3D_HAS_LIGHTMAP");
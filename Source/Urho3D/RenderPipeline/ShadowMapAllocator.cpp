@@ -103,8 +103,20 @@ void ShadowMapAllocator::ResetAllShadowMaps()
 {
     for (AtlasPage& element : pages_)
     {
-        element.areaAllocator_.Reset(shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_, shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_);
         element.clearBeforeRendering_ = false;
+        if (!element.isPersistent_)
+        {
+            element.areaAllocator_.Reset(shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_, shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_);
+            continue;
+        }
+
+        // Release persistent shadow maps of lights that are not shadowed anymore
+        if (element.persistentLight_ && --element.remainingTimeToLive_ == 0)
+        {
+            element.texture_ = nullptr;
+            element.persistentLight_ = nullptr;
+            element.isContentValid_ = false;
+        }
     }
 }
 
@@ -117,6 +129,9 @@ ShadowMapRegion ShadowMapAllocator::AllocateShadowMap(const IntVector2& size)
 
     for (AtlasPage& element : pages_)
     {
+        if (element.isPersistent_)
+            continue;
+
         const ShadowMapRegion shadowMap = element.AllocateRegion(clampedSize);
         if (shadowMap)
             return shadowMap;
@@ -126,6 +141,34 @@ ShadowMapRegion ShadowMapAllocator::AllocateShadowMap(const IntVector2& size)
     return pages_.back().AllocateRegion(clampedSize);
 }
 
+ShadowMapRegion ShadowMapAllocator::AllocatePersistentShadowMap(
+    Light* light, const IntVector2& size, bool& isContentPreserved)
+{
+    isContentPreserved = false;
+    if (!settings_.cacheStaticShadowMaps_ || !settings_.shadowAtlasPageSize_ || !shadowMapFormat_)
+        return {};
+
+    const IntVector2 clampedSize = VectorMin(size, shadowAtlasPageSize_);
+
+    AtlasPage& element = AllocatePersistentPage(light);
+    if (!element.texture_ || element.texture_->GetSize() != clampedSize)
+    {
+        element.texture_ = CreateShadowMapTexture(clampedSize, Format("Static ShadowMap #{}", element.index_));
+        element.isContentValid_ = false;
+    }
+
+    element.remainingTimeToLive_ = NumPersistentFramesToLive;
+    // Clear only once if shadow map is rendered this frame
+    element.clearBeforeRendering_ = true;
+    isContentPreserved = element.isContentValid_;
+
+    ShadowMapRegion shadowMap;
+    shadowMap.pageIndex_ = element.index_;
+    shadowMap.texture_ = element.texture_;
+    shadowMap.rect_ = IntRect(IntVector2::ZERO, clampedSize);
+    return shadowMap;
+}
+
 bool ShadowMapAllocator::BeginShadowMapRendering(const ShadowMapRegion& shadowMap)
 {
     if (!shadowMap || shadowMap.pageIndex_ >= pages_.size())
@@ -149,6 +192,7 @@ bool ShadowMapAllocator::BeginShadowMapRendering(const ShadowMapRegion& shadowMa
     if (poolElement.clearBeforeRendering_)
     {
         poolElement.clearBeforeRendering_ = false;
+        poolElement.isContentValid_ = poolElement.isPersistent_;
 
         renderContext_->ClearDepthStencil(CLEAR_DEPTH);
         if (settings_.enableVarianceShadowMaps_)
@@ -178,7 +222,7 @@ ShadowMapRegion ShadowMapAllocator::AtlasPage::AllocateRegion(const IntVector2&
     return {};
 }
 
-void ShadowMapAllocator::AllocatePage()
+SharedPtr<Texture2D> ShadowMapAllocator::CreateShadowMapTexture(const IntVector2& size, const ea::string& name) const
 {
     const bool isDepthTexture = !settings_.enableVarianceShadowMaps_;
     const TextureFlags textureFlags = isDepthTexture ? TextureFlag::BindDepthStencil : TextureFlag::BindRenderTarget;
@@ -186,20 +230,31 @@ void ShadowMapAllocator::AllocatePage()
 
     auto newShadowMap = MakeShared<Texture2D>(context_);
 
-    newShadowMap->SetName(Format("Dynamic ShadowMap #{}", pages_.size()));
+    newShadowMap->SetName(name);
 
     // Disable mipmaps from the shadow map
     newShadowMap->SetNumLevels(1);
     newShadowMap->SetFilterMode(FILTER_BILINEAR);
     newShadowMap->SetShadowCompare(isDepthTexture);
-    newShadowMap->SetSize(shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_, shadowMapFormat_, textureFlags, multiSample);
+    newShadowMap->SetSize(size.x_, size.y_, shadowMapFormat_, textureFlags, multiSample);
+    return newShadowMap;
+}
 
+void ShadowMapAllocator::AllocatePage()
+{
     // Store allocate shadow map
     AtlasPage& element = pages_.emplace_back();
     element.index_ = pages_.size() - 1;
-    element.texture_ = newShadowMap;
+    element.texture_ = CreateShadowMapTexture(shadowAtlasPageSize_, Format("Dynamic ShadowMap #{}", element.index_));
     element.areaAllocator_.Reset(shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_, shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_);
 
+    UpdateVarianceDepthTexture();
+}
+
+void ShadowMapAllocator::UpdateVarianceDepthTexture()
+{
+    // Depth buffer of page size fits persistent shadow maps as well
+    const int multiSample = settings_.varianceShadowMapMultiSample_;
     if (!settings_.enableVarianceShadowMaps_)
         vsmDepthTexture_ = nullptr;
     else if (!vsmDepthTexture_ || vsmDepthTexture_->GetSize() != shadowAtlasPageSize_)
@@ -210,4 +265,30 @@ void ShadowMapAllocator::AllocatePage()
     }
 }
 
+ShadowMapAllocator::AtlasPage& ShadowMapAllocator::AllocatePersistentPage(Light* light)
+{
+    AtlasPage* freePage = nullptr;
+    for (AtlasPage& element : pages_)
+    {
+        if (!element.isPersistent_)
+            continue;
+        if (element.persistentLight_ == light)
+            return element;
+        if (!element.persistentLight_ && !freePage)
+            freePage = &element;
+    }
+
+    if (!freePage)
+    {
+        freePage = &pages_.emplace_back();
+        freePage->index_ = pages_.size() - 1;
+        freePage->isPersistent_ = true;
+        UpdateVarianceDepthTexture();
+    }
+
+    freePage->persistentLight_ = light;
+    freePage->isContentValid_ = false;
+    return *freePage;
+}
+
 }
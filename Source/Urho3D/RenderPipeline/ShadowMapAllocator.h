@@ -45,6 +45,9 @@ class URHO3D_API ShadowMapAllocator : public Object
     URHO3D_OBJECT(ShadowMapAllocator, Object);
 
 public:
+    /// Number of frames to keep persistent shadow map that is not used.
+    static const unsigned NumPersistentFramesToLive = 60;
+
     explicit ShadowMapAllocator(Context* context);
     void SetSettings(const ShadowMapAllocatorSettings& settings);
 
@@ -52,6 +55,10 @@ public:
     void ResetAllShadowMaps();
     /// Allocate shadow map of given size. It is better to allocate from bigger to smaller sizes.
     ShadowMapRegion AllocateShadowMap(const IntVector2& size);
+    /// Allocate shadow map of given size owned by the light that keeps its contents between frames.
+    /// Return empty region if persistent shadow maps are disabled.
+    /// Output flag is set if the shadow map was rendered before and has the same size.
+    ShadowMapRegion AllocatePersistentShadowMap(Light* light, const IntVector2& size, bool& isContentPreserved);
     /// Begin shadow map rendering. Clears shadow map if necessary.
     bool BeginShadowMapRendering(const ShadowMapRegion& shadowMap);
 
@@ -67,12 +74,23 @@ private:
         AreaAllocator areaAllocator_;
         bool clearBeforeRendering_{};
 
+        /// Persistent page is used as single shadow map of the light and is not reset every frame.
+        /// @{
+        bool isPersistent_{};
+        Light* persistentLight_{};
+        unsigned remainingTimeToLive_{};
+        bool isContentValid_{};
+        /// @}
+
         /// Allocate shadow map.
         ShadowMapRegion AllocateRegion(const IntVector2& size);
     };
 
     void CacheSettings();
+    SharedPtr<Texture2D> CreateShadowMapTexture(const IntVector2& size, const ea::string& name) const;
     void AllocatePage();
+    void UpdateVarianceDepthTexture();
+    AtlasPage& AllocatePersistentPage(Light* light);
 
     /// External dependencies
     /// @{
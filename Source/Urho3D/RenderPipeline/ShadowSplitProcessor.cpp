@@ -35,8 +35,6 @@
 #include "../RenderPipeline/ShadowMapAllocator.h"
 #include "../RenderPipeline/ShadowSplitProcessor.h"
 
-#include <EASTL/sort.h>
-
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -364,12 +362,32 @@ Matrix4 ShadowSplitProcessor::GetWorldToShadowSpaceMatrix(float subPixelOffset)
     return texAdjust * shadowProj * shadowView;
 }
 
-void ShadowSplitProcessor::FinalizeShadowBatches()
+void ShadowSplitProcessor::FinalizeShadowBatches(bool useRadixSort)
 {
+    // Splits are already finalized in parallel, so sort in this thread
     BatchCompositor::FillSortKeys(sortedShadowBatches_, unsortedShadowBatches_);
-    ea::sort(sortedShadowBatches_.begin(), sortedShadowBatches_.end());
+    SortPipelineBatches(sortedShadowBatches_, useRadixSort);
     shadowBatches_ = { sortedShadowBatches_,
         BatchRenderFlag::EnableInstancingForStaticGeometry | BatchRenderFlag::DisableColorOutput };
+
+    // Drawables moved or animated since the last frame have their update revision changed by Octree.
+    // Batches are combined in order-independent way because delayed batches are appended in arbitrary order.
+    unsigned batchesHash = 0;
+    for (const PipelineBatch& batch : unsortedShadowBatches_)
+    {
+        unsigned batchHash = MakeHash(batch.drawable_);
+        CombineHash(batchHash, batch.drawable_->GetUpdateRevision());
+        CombineHash(batchHash, batch.sourceBatchIndex_);
+        CombineHash(batchHash, MakeHash(batch.geometry_));
+        CombineHash(batchHash, MakeHash(batch.material_));
+        CombineHash(batchHash, MakeHash(batch.pipelineState_));
+        batchesHash += batchHash;
+    }
+
+    shadowStateHash_ = batchesHash;
+    const Matrix4 worldToShadow = GetWorldToShadowSpaceMatrix(0.0f);
+    for (unsigned i = 0; i < 16; ++i)
+        CombineHash(shadowStateHash_, MakeHash(worldToShadow.Data()[i]));
 }
 
 }
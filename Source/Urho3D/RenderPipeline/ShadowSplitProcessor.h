@@ -65,7 +65,7 @@ public:
     /// @}
 
     void FinalizeShadow(const ShadowMapRegion& shadowMap, unsigned pcfKernelSize);
-    void FinalizeShadowBatches();
+    void FinalizeShadowBatches(bool useRadixSort);
 
     /// Return immutable
     /// @{
@@ -93,6 +93,8 @@ public:
     auto& GetMutableUnsortedShadowBatches() { return unsortedShadowBatches_; }
     auto& GetMutableShadowBatches() { return shadowBatches_; }
     const auto& GetShadowBatches() const { return shadowBatches_; }
+    /// Return hash of shadow camera and shadow batches. Used to detect changes of persistent shadow maps.
+    unsigned GetShadowStateHash() const { return shadowStateHash_; }
 
 private:
     void InitializeBaseDirectionalCamera(Camera* cullCamera);
@@ -132,6 +134,7 @@ private:
     ea::vector<PipelineBatch> unsortedShadowBatches_;
     ea::vector<PipelineBatchByState> sortedShadowBatches_;
     PipelineBatchGroup<PipelineBatchByState> shadowBatches_;
+    unsigned shadowStateHash_{};
     /// @}
 };
 
@@ -33,69 +33,35 @@
 namespace Urho3D
 {
 
-class StereoFrustumOctreeQuery : public OctreeQuery
+/// Frustum query that tests drawables against combined frustum of both eyes.
+class StereoFrustumOctreeQuery : public FrustumOctreeQuery
 {
 public:
     StereoFrustumOctreeQuery(
-        ea::vector<Drawable*>& result, ea::array<Frustum, 2> frustums, DrawableFlags drawableFlags, unsigned viewMask)
-        : OctreeQuery(result, drawableFlags, viewMask)
+        ea::vector<Drawable*>& result, const Frustum& frustum, DrawableFlags drawableFlags, unsigned viewMask)
+        : FrustumOctreeQuery(result, frustum, drawableFlags, viewMask)
     {
-        frustums_[0] = frustums[0];
-        frustums_[1] = frustums[1];
     }
-
-    virtual Intersection TestOctant(const BoundingBox& box, bool inside) override
-    {
-        if (inside)
-            return INSIDE;
-
-        Intersection inter = frustums_[0].IsInside(box);
-        inter = Max(inter, frustums_[1].IsInside(box));
-        return inter;
-    }
-
-    virtual void TestDrawables(Drawable** start, Drawable** end, bool inside)
-    {
-        while (start != end)
-        {
-            Drawable* drawable = *start++;
-            if ((drawable->GetDrawableFlags() & drawableFlags_) && (drawable->GetViewMask() & viewMask_))
-            {
-                const auto bb = drawable->GetWorldBoundingBox();
-                if (inside || frustums_[0].IsInsideFast(bb) || frustums_[1].IsInsideFast(bb))
-                    result_.push_back(drawable);
-            }
-        }
-    }
-
-    Frustum frustums_[2];
 };
 
 class StereoOccluderOctreeQuery : public StereoFrustumOctreeQuery
 {
 public:
     /// Construct with frustum and query parameters.
-    StereoOccluderOctreeQuery(
-        ea::vector<Drawable*>& result, ea::array<Frustum, 2> frustums, unsigned viewMask = DEFAULT_VIEWMASK)
-        : StereoFrustumOctreeQuery(result, frustums, DRAWABLE_GEOMETRY, viewMask)
+    StereoOccluderOctreeQuery(ea::vector<Drawable*>& result, const Frustum& frustum, unsigned viewMask = DEFAULT_VIEWMASK)
+        : StereoFrustumOctreeQuery(result, frustum, DRAWABLE_GEOMETRY, viewMask)
     {
     }
 
     /// Intersection test for drawables.
     void TestDrawables(Drawable** start, Drawable** end, bool inside) override
     {
-        while (start != end)
+        const auto filter = [this](Drawable* drawable)
         {
-            Drawable* drawable = *start++;
-
-            const DrawableFlags flags = drawable->GetDrawableFlags();
-            if (flags == DRAWABLE_GEOMETRY && drawable->IsOccluder() && (drawable->GetViewMask() & viewMask_))
-            {
-                const auto bb = drawable->GetWorldBoundingBox();
-                if (inside || frustums_[0].IsInsideFast(bb) || frustums_[1].IsInsideFast(bb))
-                    result_.push_back(drawable);
-            }
-        }
+            return drawable->GetDrawableFlags() == DRAWABLE_GEOMETRY && drawable->IsOccluder()
+                && (drawable->GetViewMask() & viewMask_);
+        };
+        TestDrawablesInFrustum(start, end, inside, filter, [this](Drawable* drawable) { result_.push_back(drawable); });
     }
 };
 
@@ -103,10 +69,10 @@ class StereoOccludedFrustumOctreeQuery : public StereoFrustumOctreeQuery
 {
 public:
     /// Construct with frustum, occlusion buffer and query parameters.
-    StereoOccludedFrustumOctreeQuery(ea::vector<Drawable*>& result, ea::array<Frustum, 2> frustums,
+    StereoOccludedFrustumOctreeQuery(ea::vector<Drawable*>& result, const Frustum& frustum,
         ea::array<OcclusionBuffer*, 2> buffers, DrawableFlags drawableFlags = DRAWABLE_ANY,
         unsigned viewMask = DEFAULT_VIEWMASK)
-        : StereoFrustumOctreeQuery(result, frustums, drawableFlags, viewMask)
+        : StereoFrustumOctreeQuery(result, frustum, drawableFlags, viewMask)
     {
         buffers_[0] = buffers[0];
         buffers_[1] = buffers[1];
@@ -119,30 +85,13 @@ public:
             return buffers_[0]->IsVisible(box) || buffers_[1]->IsVisible(box) ? INSIDE : OUTSIDE;
         else
         {
-            Intersection result = frustums_[0].IsInside(box);
-            result = Max(result, frustums_[1].IsInside(box));
+            Intersection result = frustum_.IsInside(box);
             if (result != OUTSIDE && !buffers_[0]->IsVisible(box) && !buffers_[1]->IsVisible(box))
                 result = OUTSIDE;
             return result;
         }
     }
 
-    /// Intersection test for drawables. Note: drawable occlusion is performed later in worker threads.
-    void TestDrawables(Drawable** start, Drawable** end, bool inside) override
-    {
-        while (start != end)
-        {
-            Drawable* drawable = *start++;
-
-            if ((drawable->GetDrawableFlags() & drawableFlags_) && (drawable->GetViewMask() & viewMask_))
-            {
-                const auto bb = drawable->GetWorldBoundingBox();
-                if (inside || frustums_[0].IsInsideFast(bb) || frustums_[1].IsInsideFast(bb))
-                    result_.push_back(drawable);
-            }
-        }
-    }
-
     /// Occlusion buffer.
     OcclusionBuffer* buffers_[2];
 };
@@ -167,16 +116,16 @@ public:
 
         assert(frameInfo_.additionalCameras_[0] != nullptr);
 
-        // get our frustums
-        ea::array<Frustum, 2> frustums = {
-            frameInfo_.camera_->GetFrustum(), frameInfo_.additionalCameras_[1]->GetFrustum()};
+        // Cull once with frustum that encloses both eyes
+        Frustum frustum;
+        frustum.DefineEnclosing(frameInfo_.camera_->GetFrustum(), frameInfo_.additionalCameras_[1]->GetFrustum());
         Camera* cameras[2] = {frameInfo_.camera_, frameInfo_.additionalCameras_[1]};
 
         if (settings_.maxOccluderTriangles_ > 0)
         {
             URHO3D_PROFILE("ProcessOccluders");
 
-            StereoOccluderOctreeQuery occluderQuery(occluders_, frustums, frameInfo_.camera_->GetViewMask());
+            StereoOccluderOctreeQuery occluderQuery(occluders_, frustum, frameInfo_.camera_->GetViewMask());
             frameInfo_.octree_->GetDrawables(occluderQuery);
             drawableProcessor_->ProcessOccluders(occluders_, settings_.occluderSizeThreshold_);
 
@@ -215,7 +164,7 @@ public:
         if (currentOcclusionBuffers_[0])
         {
             URHO3D_PROFILE("QueryVisibleDrawables");
-            StereoOccludedFrustumOctreeQuery query(drawables_, frustums, currentOcclusionBuffers_,
+            StereoOccludedFrustumOctreeQuery query(drawables_, frustum, currentOcclusionBuffers_,
                 DRAWABLE_GEOMETRY | DRAWABLE_LIGHT, frameInfo_.camera_->GetViewMask());
             frameInfo_.octree_->GetDrawables(query);
         }
@@ -223,7 +172,7 @@ public:
         {
             URHO3D_PROFILE("QueryVisibleDrawables");
             StereoFrustumOctreeQuery drawableQuery(
-                drawables_, frustums, DRAWABLE_GEOMETRY | DRAWABLE_LIGHT, frameInfo_.camera_->GetViewMask());
+                drawables_, frustum, DRAWABLE_GEOMETRY | DRAWABLE_LIGHT, frameInfo_.camera_->GetViewMask());
             frameInfo_.octree_->GetDrawables(drawableQuery);
         }
 
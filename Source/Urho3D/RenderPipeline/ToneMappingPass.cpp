@@ -24,6 +24,7 @@
 
 #include "../Graphics/Graphics.h"
 #include "../Graphics/Texture2D.h"
+#include "../RenderPipeline/OutlinePass.h"
 #include "../RenderPipeline/RenderBufferManager.h"
 #include "Urho3D/RenderPipeline/ShaderConsts.h"
 #include "../RenderPipeline/ToneMappingPass.h"
@@ -48,6 +49,15 @@ void ToneMappingPass::SetMode(ToneMappingMode mode)
     }
 }
 
+void ToneMappingPass::SetColorGrading(const Vector4& hueSaturationValueContrast)
+{
+    const bool wasEnabled = !hueSaturationValueContrast_.Equals(Vector4::ONE);
+    const bool isEnabled = !hueSaturationValueContrast.Equals(Vector4::ONE);
+    if (wasEnabled != isEnabled)
+        toneMappingState_ = StaticPipelineStateId::Invalid;
+    hueSaturationValueContrast_ = hueSaturationValueContrast;
+}
+
 void ToneMappingPass::InitializeStates()
 {
     ea::string defines;
@@ -66,9 +76,19 @@ void ToneMappingPass::InitializeStates()
         break;
     }
 
+    if (!hueSaturationValueContrast_.Equals(Vector4::ONE))
+        defines += "COLOR_GRADING ";
+
     static const NamedSamplerStateDesc samplers[] = {{ShaderResources::Albedo, SamplerStateDesc::Bilinear()}};
     toneMappingState_ =
         renderBufferManager_->CreateQuadPipelineState(BLEND_REPLACE, "v2/P_ToneMapping", defines, samplers);
+
+    static const NamedSamplerStateDesc outlineSamplers[] = {
+        {ShaderResources::Albedo, SamplerStateDesc::Bilinear()},
+        {ShaderResources::Emission, SamplerStateDesc::Bilinear()},
+    };
+    toneMappingWithOutlineState_ = renderBufferManager_->CreateQuadPipelineState(
+        BLEND_REPLACE, "v2/P_ToneMapping", defines + "OUTLINE ", outlineSamplers);
 }
 
 void ToneMappingPass::Execute(Camera* camera)
@@ -77,9 +97,28 @@ void ToneMappingPass::Execute(Camera* camera)
         InitializeStates();
 
     renderBufferManager_->SwapColorBuffers(false);
-
     renderBufferManager_->SetOutputRenderTargets();
-    renderBufferManager_->DrawFeedbackViewportQuad("Apply tone mapping", toneMappingState_, {}, {});
+
+    // Outline is composited in linear space before tone mapping, as the separate outline pass would do
+    RenderBuffer* outlineBuffer = outlinePass_ && outlinePass_->IsEnabled() ? outlinePass_->GetColorOutput() : nullptr;
+    if (outlineBuffer)
+    {
+        RawTexture* outlineTexture = outlineBuffer->GetTexture();
+        const Vector2 inputInvSize = Vector2::ONE / outlineTexture->GetParams().size_.ToVector2();
+
+        const ShaderParameterDesc parameters[] = {
+            {"InputInvSize", inputInvSize},
+            {"HSVParams", hueSaturationValueContrast_},
+        };
+        const ShaderResourceDesc shaderResources[] = {{ShaderResources::Emission, outlineTexture}};
+        renderBufferManager_->DrawFeedbackViewportQuad(
+            "Apply outline and tone mapping", toneMappingWithOutlineState_, shaderResources, parameters);
+    }
+    else
+    {
+        const ShaderParameterDesc parameters[] = {{"HSVParams", hueSaturationValueContrast_}};
+        renderBufferManager_->DrawFeedbackViewportQuad("Apply tone mapping", toneMappingState_, {}, parameters);
+    }
 }
 
 }
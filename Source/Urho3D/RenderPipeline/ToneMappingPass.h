@@ -32,6 +32,7 @@
 namespace Urho3D
 {
 
+class OutlinePass;
 class RenderBufferManager;
 class RenderPipelineInterface;
 
@@ -44,6 +45,10 @@ class URHO3D_API ToneMappingPass
 public:
     ToneMappingPass(RenderPipelineInterface* renderPipeline, RenderBufferManager* renderBufferManager);
     void SetMode(ToneMappingMode mode);
+    /// Set outline pass to composite before tone mapping. The outline pass should be fused.
+    void SetOutlinePass(OutlinePass* outlinePass) { outlinePass_ = outlinePass; }
+    /// Set hue shift, saturation, brightness and contrast to apply after tone mapping.
+    void SetColorGrading(const Vector4& hueSaturationValueContrast);
 
     PostProcessPassFlags GetExecutionFlags() const override { return PostProcessPassFlag::NeedColorOutputReadAndWrite; }
     void Execute(Camera* camera) override;
@@ -52,8 +57,11 @@ protected:
     void InitializeStates();
 
     ToneMappingMode mode_;
+    WeakPtr<OutlinePass> outlinePass_;
+    Vector4 hueSaturationValueContrast_{Vector4::ONE};
 
     StaticPipelineStateId toneMappingState_{};
+    StaticPipelineStateId toneMappingWithOutlineState_{};
 };
 
 }
@@ -25,10 +25,15 @@
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
 #include "../Core/Exception.h"
+#include "../IO/Compression.h"
 #include "../IO/Log.h"
 #include "../Network/Connection.h"
 #include "../Network/Network.h"
 #include "../Network/NetworkEvents.h"
+#ifdef URHO3D_PHYSICS
+#include "../Physics/PhysicsWorld.h"
+#include "../Replica/PredictedKinematicController.h"
+#endif
 #include "../Replica/NetworkObject.h"
 #include "../Replica/ReplicationManager.h"
 #include "../Replica/NetworkSettingsConsts.h"
@@ -238,13 +243,41 @@ void ClientReplica::ProcessRemoveObjects(MemoryBuffer& messageData)
 void ClientReplica::ProcessAddObjects(MemoryBuffer& messageData)
 {
     const auto messageFrame = static_cast<NetworkFrame>(messageData.ReadInt64());
-    while (!messageData.IsEof())
+
+    // Batch of objects may be compressed
+    const unsigned uncompressedSize = messageData.ReadVLE();
+    const unsigned dictionaryHash = uncompressedSize != 0 ? messageData.ReadUInt() : 0;
+    const unsigned char* data = messageData.GetData() + messageData.Tell();
+    unsigned dataSize = messageData.GetSize() - messageData.Tell();
+    if (uncompressedSize != 0)
     {
-        const auto networkId = static_cast<NetworkId>(messageData.ReadUInt());
-        const StringHash componentType = messageData.ReadStringHash();
-        const unsigned ownerConnectionId = messageData.ReadVLE();
+        const CompressionDictionary* dictionary = dictionaryHash != 0 ? compressionDictionary_.Get() : nullptr;
+        if (dictionaryHash != 0 && (!dictionary || dictionary->GetHash() != dictionaryHash))
+        {
+            URHO3D_LOGERROR("Cannot decompress added objects, compression dictionary doesn't match the server");
+            return;
+        }
 
-        messageData.ReadBuffer(componentBuffer_.GetBuffer());
+        uncompressedBuffer_.resize(uncompressedSize);
+        if (!DecompressData(uncompressedBuffer_.data(), uncompressedSize, data, dataSize, CompressionCodec::LZ4HC,
+            dictionary))
+        {
+            URHO3D_LOGERROR("Cannot decompress added objects");
+            return;
+        }
+        data = uncompressedBuffer_.data();
+        dataSize = uncompressedSize;
+    }
+
+    MemoryBuffer objectsData{data, dataSize};
+
+    while (!objectsData.IsEof())
+    {
+        const auto networkId = static_cast<NetworkId>(objectsData.ReadUInt());
+        const StringHash componentType = objectsData.ReadStringHash();
+        const unsigned ownerConnectionId = objectsData.ReadVLE();
+
+        objectsData.ReadBuffer(componentBuffer_.GetBuffer());
 
         const bool isOwned = ownerConnectionId == GetConnectionId();
         if (NetworkObject* networkObject = CreateNetworkObject(networkId, componentType))
@@ -364,6 +397,18 @@ void ClientReplica::RemoveNetworkObject(WeakPtr<NetworkObject> networkObject)
         networkObject->Remove();
 }
 
+#ifdef URHO3D_PHYSICS
+PredictedKinematicReplayer* ClientReplica::GetKinematicReplayer()
+{
+    if (!kinematicReplayer_ || !kinematicReplayer_->GetPhysicsWorld())
+    {
+        auto physicsWorld = scene_->GetComponent<PhysicsWorld>();
+        kinematicReplayer_ = physicsWorld ? MakeShared<PredictedKinematicReplayer>(physicsWorld) : nullptr;
+    }
+    return kinematicReplayer_;
+}
+#endif
+
 ea::string ClientReplica::GetDebugInfo() const
 {
     static const ea::string unnamedScene = "Unnamed";
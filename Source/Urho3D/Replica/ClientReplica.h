@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "../IO/Compression.h"
 #include "../IO/MemoryBuffer.h"
 #include "../IO/VectorBuffer.h"
 #include "../Replica/TickSynchronizer.h"
@@ -42,6 +43,7 @@ class AbstractConnection;
 class Network;
 class NetworkObjectRegistry;
 class NetworkObject;
+class PredictedKinematicReplayer;
 class Scene;
 struct NetworkSetting;
 
@@ -131,11 +133,17 @@ public:
 
     bool ProcessMessage(NetworkMessageId messageId, MemoryBuffer& messageData);
     void ProcessSceneUpdate();
+    /// Set dictionary used to decompress added objects. Should be the same as on the server.
+    void SetCompressionDictionary(CompressionDictionary* dictionary) { compressionDictionary_ = dictionary; }
 
     ea::string GetDebugInfo() const;
     const ea::unordered_set<WeakPtr<NetworkObject>>& GetOwnedNetworkObjects() const { return ownedObjects_; };
     bool HasOwnedNetworkObjects() const { return !ownedObjects_.empty(); }
     NetworkObject* GetOwnedNetworkObject() const { return ownedObjects_.size() == 1 ? *ownedObjects_.begin() : nullptr; }
+#ifdef URHO3D_PHYSICS
+    /// Return replayer of predicted kinematic controllers. Created on demand if the scene has PhysicsWorld.
+    PredictedKinematicReplayer* GetKinematicReplayer();
+#endif
 
 private:
     void OnInputReady(float timeStep);
@@ -159,6 +167,12 @@ private:
     ea::unordered_set<WeakPtr<NetworkObject>> ownedObjects_;
 
     VectorBuffer componentBuffer_;
+    ByteVector uncompressedBuffer_;
+    SharedPtr<CompressionDictionary> compressionDictionary_;
+
+#ifdef URHO3D_PHYSICS
+    SharedPtr<PredictedKinematicReplayer> kinematicReplayer_;
+#endif
 };
 
 }
@@ -59,19 +59,9 @@ ea::optional<NetworkObjectRelevance> FilteredByDistance::GetRelevanceForClient(A
 
     ReplicationManager* replicationManager = GetNetworkObject()->GetReplicationManager();
     ServerReplicator* serverReplicator = replicationManager->GetServerReplicator();
-    const auto& ownedObjects = serverReplicator->GetNetworkObjectsOwnedByConnection(connection);
+    const NetworkInterestGrid& interestGrid = serverReplicator->GetInterestGrid();
 
-    const Vector3 thisPosition = GetNode()->GetWorldPosition();
-    float distanceToConnectionObjects = M_LARGE_VALUE;
-
-    for (NetworkObject* networkObject : ownedObjects)
-    {
-        const Vector3 otherPosition = networkObject->GetNode()->GetWorldPosition();
-        const float distance = (thisPosition - otherPosition).Length();
-        distanceToConnectionObjects = ea::min(distanceToConnectionObjects, distance);
-    }
-
-    if (distanceToConnectionObjects < distance_)
+    if (interestGrid.IsInRange(connection, GetNode()->GetWorldPosition(), distance_))
         return ea::nullopt;
 
     if (!isRelevant_)
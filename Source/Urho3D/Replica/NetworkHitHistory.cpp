@@ -0,0 +1,629 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Replica/NetworkHitHistory.h"
+
+#include "../Replica/NetworkObject.h"
+#include "../Scene/Node.h"
+#ifdef URHO3D_PHYSICS
+#include "../Graphics/Model.h"
+#include "../Physics/CollisionShape.h"
+#endif
+
+#include <EASTL/sort.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+static constexpr int MaxCellCoordinate = (1 << 20) - 1;
+
+/// Clip segment [tMin, tMax] of the ray to the box. Direction doesn't have to be normalized.
+bool ClipRayToBox(const Vector3& origin, const Vector3& direction, const BoundingBox& box, float& tMin, float& tMax)
+{
+    for (unsigned axis = 0; axis < 3; ++axis)
+    {
+        const float o = origin.Data()[axis];
+        const float d = direction.Data()[axis];
+        const float boxMin = box.min_.Data()[axis];
+        const float boxMax = box.max_.Data()[axis];
+        if (Abs(d) < M_EPSILON)
+        {
+            if (o < boxMin || o > boxMax)
+                return false;
+            continue;
+        }
+
+        float t1 = (boxMin - o) / d;
+        float t2 = (boxMax - o) / d;
+        if (t1 > t2)
+            ea::swap(t1, t2);
+        tMin = ea::max(tMin, t1);
+        tMax = ea::min(tMax, t2);
+        if (tMin > tMax)
+            return false;
+    }
+    return true;
+}
+
+/// Return distance along the ray to the shape, or M_INFINITY if there is no hit.
+float HitDistance(const NetworkHitShape& shape, const Matrix3x4& shapeTransform, const Ray& ray, float maxDistance)
+{
+    // Direction is not normalized in local space, so distance along it is the same as in world space
+    const Matrix3x4 inverseTransform = shapeTransform.Inverse();
+    const Vector3 origin = inverseTransform * ray.origin_;
+    const Vector3 direction = inverseTransform * (ray.origin_ + ray.direction_) - origin;
+
+    if (shape.type_ == NetworkHitShape::Type::Box)
+    {
+        const BoundingBox box{-shape.size_ * 0.5f, shape.size_ * 0.5f};
+        float tMin = 0.0f;
+        float tMax = maxDistance;
+        return ClipRayToBox(origin, direction, box, tMin, tMax) ? tMin : M_INFINITY;
+    }
+    else
+    {
+        const float radius = shape.size_.x_ * 0.5f;
+        const float a = direction.DotProduct(direction);
+        const float b = 2.0f * origin.DotProduct(direction);
+        const float c = origin.DotProduct(origin) - radius * radius;
+        if (c <= 0.0f)
+            return 0.0f;
+
+        const float discriminant = b * b - 4.0f * a * c;
+        if (discriminant < 0.0f || a < M_EPSILON)
+            return M_INFINITY;
+
+        const float t = (-b - Sqrt(discriminant)) / (2.0f * a);
+        return t >= 0.0f && t <= maxDistance ? t : M_INFINITY;
+    }
+}
+
+/// Return whether the sphere overlaps the shape.
+bool IsOverlapped(const NetworkHitShape& shape, const Matrix3x4& shapeTransform, const Sphere& sphere)
+{
+    if (shape.type_ == NetworkHitShape::Type::Box)
+    {
+        const Vector3 halfSize = shape.size_ * 0.5f;
+        const Vector3 localCenter = shapeTransform.Inverse() * sphere.center_;
+        const Vector3 localClosest = VectorMax(-halfSize, VectorMin(localCenter, halfSize));
+        const Vector3 closest = shapeTransform * localClosest;
+        return (closest - sphere.center_).LengthSquared() <= sphere.radius_ * sphere.radius_;
+    }
+    else
+    {
+        const Vector3 scale = shapeTransform.Scale();
+        const float radius = shape.size_.x_ * 0.5f * ea::max({scale.x_, scale.y_, scale.z_});
+        const float distance = (shapeTransform.Translation() - sphere.center_).Length();
+        return distance <= sphere.radius_ + radius;
+    }
+}
+
+#ifdef URHO3D_PHYSICS
+bool GetCollisionShape(const CollisionShape* collisionShape, NetworkHitShape& shape)
+{
+    const Vector3 size = collisionShape->GetSize();
+    shape.offset_ = Matrix3x4{collisionShape->GetPosition(), collisionShape->GetRotation(), 1.0f};
+
+    switch (collisionShape->GetShapeType())
+    {
+    case SHAPE_STATICPLANE:
+    case SHAPE_TERRAIN:
+        return false;
+
+    case SHAPE_SPHERE:
+        shape.type_ = NetworkHitShape::Type::Sphere;
+        shape.size_ = size;
+        return true;
+
+    case SHAPE_CAPSULE:
+    case SHAPE_CYLINDER:
+    case SHAPE_CONE:
+        shape.type_ = NetworkHitShape::Type::Box;
+        shape.size_ = Vector3{size.x_, size.y_, size.x_};
+        return true;
+
+    case SHAPE_TRIANGLEMESH:
+    case SHAPE_CONVEXHULL:
+    case SHAPE_GIMPACTMESH:
+    {
+        const Model* model = collisionShape->GetModel();
+        if (!model)
+            return false;
+
+        const BoundingBox& boundingBox = model->GetBoundingBox();
+        shape.type_ = NetworkHitShape::Type::Box;
+        shape.size_ = boundingBox.Size() * size;
+        shape.offset_ = shape.offset_ * Matrix3x4{boundingBox.Center() * size, Quaternion::IDENTITY, 1.0f};
+        return true;
+    }
+
+    case SHAPE_BOX:
+    default:
+        shape.type_ = NetworkHitShape::Type::Box;
+        shape.size_ = size;
+        return true;
+    }
+}
+#endif
+
+}
+
+void NetworkHitHistory::Reset(unsigned numFrames, float cellSize)
+{
+    cellSize_ = ea::max(cellSize, M_EPSILON);
+    frames_.clear();
+    frames_.resize(numFrames);
+    lastFrame_ = ea::nullopt;
+    gridBase_ = nullptr;
+    gridNext_ = nullptr;
+}
+
+void NetworkHitHistory::RecordFrame(NetworkFrame frame, ea::span<NetworkObject* const> networkObjects)
+{
+    if (frames_.empty())
+        return;
+
+    // Invalidate frames skipped since the last record
+    if (lastFrame_)
+    {
+        const long long numSkippedFrames = ea::min<long long>(frame - *lastFrame_ - 1, frames_.size());
+        for (long long offset = 1; offset <= numSkippedFrames; ++offset)
+            frames_[GetFrameIndex(frame - offset)].valid_ = false;
+    }
+    lastFrame_ = frame;
+
+    FrameSnapshot& snapshot = frames_[GetFrameIndex(frame)];
+    snapshot.valid_ = true;
+    snapshot.frame_ = frame;
+    snapshot.objects_.clear();
+    snapshot.shapes_.clear();
+    snapshot.objectIndices_.clear();
+
+    // Grid may reference the overwritten frame or the previous last frame
+    gridBase_ = nullptr;
+    gridNext_ = nullptr;
+
+#ifdef URHO3D_PHYSICS
+    ea::vector<NetworkHitShape> shapes;
+    ea::vector<CollisionShape*> collisionShapes;
+    for (NetworkObject* networkObject : networkObjects)
+    {
+        Node* node = networkObject->GetNode();
+        node->GetComponents<CollisionShape>(collisionShapes);
+
+        shapes.clear();
+        for (const CollisionShape* collisionShape : collisionShapes)
+        {
+            NetworkHitShape shape;
+            if (collisionShape->IsEnabledEffective() && GetCollisionShape(collisionShape, shape))
+                shapes.push_back(shape);
+        }
+
+        if (!shapes.empty())
+            RecordObject(frame, networkObject->GetNetworkId(), node->GetWorldTransform(), shapes);
+    }
+#endif
+}
+
+void NetworkHitHistory::RecordObject(
+    NetworkFrame frame, NetworkId networkId, const Matrix3x4& worldTransform, ea::span<const NetworkHitShape> shapes)
+{
+    FrameSnapshot* snapshot = GetFrameSnapshot(frame);
+    if (!snapshot || shapes.empty())
+        return;
+
+    ObjectSnapshot& object = snapshot->objects_.emplace_back();
+    object.networkId_ = networkId;
+    worldTransform.Decompose(object.position_, object.rotation_, object.scale_);
+    object.firstShape_ = snapshot->shapes_.size();
+    object.numShapes_ = shapes.size();
+    for (const NetworkHitShape& shape : shapes)
+    {
+        snapshot->shapes_.push_back(shape);
+        const BoundingBox localBox{-shape.size_ * 0.5f, shape.size_ * 0.5f};
+        object.worldBoundingBox_.Merge(localBox.Transformed(worldTransform * shape.offset_));
+    }
+
+    snapshot->objectIndices_[networkId] = snapshot->objects_.size() - 1;
+}
+
+void NetworkHitHistory::ProcessRayQueries(ea::span<const NetworkRayQuery> queries, ea::vector<NetworkHitResult>& results)
+{
+    SortQueries(queries);
+    const unsigned firstResult = results.size();
+
+    for (const QueryFrames& frames : sortedQueries_)
+    {
+        BuildGrid(*frames.base_, frames.next_);
+
+        const NetworkRayQuery& query = queries[frames.queryIndex_];
+        CollectRayCandidates(query.ray_, query.maxDistance_);
+
+        NetworkHitResult bestResult;
+        bestResult.distance_ = M_INFINITY;
+        for (unsigned objectIndex : candidates_)
+        {
+            const ObjectSnapshot& object = frames.base_->objects_[objectIndex];
+            const Matrix3x4 worldTransform = SampleTransform(objectIndex, *frames.base_, frames.next_, frames.blendFactor_);
+            for (unsigned i = 0; i < object.numShapes_; ++i)
+            {
+                const NetworkHitShape& shape = frames.base_->shapes_[object.firstShape_ + i];
+                const float distance = HitDistance(shape, worldTransform * shape.offset_, query.ray_,
+                    ea::min(query.maxDistance_, bestResult.distance_));
+                if (distance < bestResult.distance_)
+                {
+                    bestResult.networkId_ = object.networkId_;
+                    bestResult.shapeIndex_ = i;
+                    bestResult.distance_ = distance;
+                }
+            }
+        }
+
+        if (bestResult.distance_ != M_INFINITY)
+        {
+            bestResult.queryIndex_ = frames.queryIndex_;
+            bestResult.position_ = query.ray_.origin_ + query.ray_.direction_ * bestResult.distance_;
+            results.push_back(bestResult);
+        }
+    }
+
+    ea::sort(results.begin() + firstResult, results.end(),
+        [](const NetworkHitResult& lhs, const NetworkHitResult& rhs) { return lhs.queryIndex_ < rhs.queryIndex_; });
+}
+
+void NetworkHitHistory::ProcessSphereQueries(
+    ea::span<const NetworkSphereQuery> queries, ea::vector<NetworkHitResult>& results)
+{
+    SortQueries(queries);
+    const unsigned firstResult = results.size();
+
+    for (const QueryFrames& frames : sortedQueries_)
+    {
+        BuildGrid(*frames.base_, frames.next_);
+
+        const NetworkSphereQuery& query = queries[frames.queryIndex_];
+        const Vector3 extent = Vector3::ONE * query.sphere_.radius_;
+        CollectBoxCandidates(BoundingBox{query.sphere_.center_ - extent, query.sphere_.center_ + extent});
+
+        for (unsigned objectIndex : candidates_)
+        {
+            const ObjectSnapshot& object = frames.base_->objects_[objectIndex];
+            const Matrix3x4 worldTransform = SampleTransform(objectIndex, *frames.base_, frames.next_, frames.blendFactor_);
+            for (unsigned i = 0; i < object.numShapes_; ++i)
+            {
+                const NetworkHitShape& shape = frames.base_->shapes_[object.firstShape_ + i];
+                const Matrix3x4 shapeTransform = worldTransform * shape.offset_;
+                if (IsOverlapped(shape, shapeTransform, query.sphere_))
+                {
+                    NetworkHitResult& result = results.emplace_back();
+                    result.queryIndex_ = frames.queryIndex_;
+                    result.networkId_ = object.networkId_;
+                    result.shapeIndex_ = i;
+                    result.position_ = shapeTransform.Translation();
+                }
+            }
+        }
+    }
+
+    ea::stable_sort(results.begin() + firstResult, results.end(),
+        [](const NetworkHitResult& lhs, const NetworkHitResult& rhs) { return lhs.queryIndex_ < rhs.queryIndex_; });
+}
+
+bool NetworkHitHistory::HasFrame(NetworkFrame frame) const
+{
+    return GetFrameSnapshot(frame) != nullptr;
+}
+
+unsigned NetworkHitHistory::GetNumObjects(NetworkFrame frame) const
+{
+    const FrameSnapshot* snapshot = GetFrameSnapshot(frame);
+    return snapshot ? snapshot->objects_.size() : 0;
+}
+
+NetworkHitHistory::FrameSnapshot* NetworkHitHistory::GetFrameSnapshot(NetworkFrame frame)
+{
+    return const_cast<FrameSnapshot*>(const_cast<const NetworkHitHistory*>(this)->GetFrameSnapshot(frame));
+}
+
+const NetworkHitHistory::FrameSnapshot* NetworkHitHistory::GetFrameSnapshot(NetworkFrame frame) const
+{
+    if (frames_.empty())
+        return nullptr;
+
+    const FrameSnapshot& snapshot = frames_[GetFrameIndex(frame)];
+    return snapshot.valid_ && snapshot.frame_ == frame ? &snapshot : nullptr;
+}
+
+bool NetworkHitHistory::FindFrames(const NetworkTime& time, QueryFrames& result) const
+{
+    if (!lastFrame_)
+        return false;
+
+    const auto capacity = static_cast<long long>(frames_.size());
+    const NetworkFrame lastFrame = *lastFrame_;
+    const long long behind = ea::clamp(lastFrame - time.Frame(), 0ll, capacity - 1);
+    const NetworkFrame frame = lastFrame - behind;
+
+    // Search backwards first so the time stays between base and next frames
+    for (long long offset = 0; offset < capacity; ++offset)
+    {
+        const FrameSnapshot* base = GetFrameSnapshot(frame - offset);
+        if (!base && frame + offset <= lastFrame)
+            base = GetFrameSnapshot(frame + offset);
+        if (!base)
+            continue;
+
+        result.base_ = base;
+        result.next_ = nullptr;
+        result.blendFactor_ = 0.0f;
+
+        if (base->frame_ <= time.Frame())
+        {
+            if (const FrameSnapshot* next = GetFrameSnapshot(base->frame_ + 1))
+            {
+                const double delta = time - NetworkTime{base->frame_};
+                result.blendFactor_ = static_cast<float>(ea::min(delta, 1.0));
+                if (result.blendFactor_ > 0.0f)
+                    result.next_ = next;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+template <class T> void NetworkHitHistory::SortQueries(ea::span<const T> queries)
+{
+    sortedQueries_.clear();
+    for (unsigned i = 0; i < queries.size(); ++i)
+    {
+        QueryFrames frames;
+        frames.queryIndex_ = i;
+        if (FindFrames(queries[i].time_, frames))
+            sortedQueries_.push_back(frames);
+    }
+
+    ea::sort(sortedQueries_.begin(), sortedQueries_.end(),
+        [](const QueryFrames& lhs, const QueryFrames& rhs)
+    {
+        if (lhs.base_ != rhs.base_)
+            return lhs.base_->frame_ < rhs.base_->frame_;
+        return lhs.next_ < rhs.next_;
+    });
+}
+
+void NetworkHitHistory::BuildGrid(const FrameSnapshot& base, const FrameSnapshot* next)
+{
+    if (gridBase_ == &base && gridNext_ == next)
+        return;
+
+    gridBase_ = &base;
+    gridNext_ = next;
+    gridCells_.clear();
+    largeObjects_.clear();
+    gridBoundingBox_ = BoundingBox{};
+
+    const unsigned numObjects = base.objects_.size();
+    nextObjectIndices_.resize(numObjects);
+    candidateStamps_.clear();
+    candidateStamps_.resize(numObjects, 0);
+    currentStamp_ = 0;
+
+    for (unsigned objectIndex = 0; objectIndex < numObjects; ++objectIndex)
+    {
+        const ObjectSnapshot& object = base.objects_[objectIndex];
+
+        // Index the box swept between frames so any time in between is covered
+        BoundingBox boundingBox = object.worldBoundingBox_;
+        nextObjectIndices_[objectIndex] = M_MAX_UNSIGNED;
+        if (next)
+        {
+            const auto iter = next->objectIndices_.find(object.networkId_);
+            if (iter != next->objectIndices_.end())
+            {
+                nextObjectIndices_[objectIndex] = iter->second;
+                boundingBox.Merge(next->objects_[iter->second].worldBoundingBox_);
+            }
+        }
+        gridBoundingBox_.Merge(boundingBox);
+
+        const int minX = GetCellCoordinate(boundingBox.min_.x_);
+        const int minY = GetCellCoordinate(boundingBox.min_.y_);
+        const int minZ = GetCellCoordinate(boundingBox.min_.z_);
+        const int maxX = GetCellCoordinate(boundingBox.max_.x_);
+        const int maxY = GetCellCoordinate(boundingBox.max_.y_);
+        const int maxZ = GetCellCoordinate(boundingBox.max_.z_);
+
+        const auto numCells = static_cast<unsigned long long>(maxX - minX + 1) * (maxY - minY + 1) * (maxZ - minZ + 1);
+        if (numCells > MaxCellsPerObject)
+        {
+            largeObjects_.push_back(objectIndex);
+            continue;
+        }
+
+        for (int x = minX; x <= maxX; ++x)
+        {
+            for (int y = minY; y <= maxY; ++y)
+            {
+                for (int z = minZ; z <= maxZ; ++z)
+                    gridCells_.emplace_back(GetCellKey(x, y, z), objectIndex);
+            }
+        }
+    }
+
+    ea::sort(gridCells_.begin(), gridCells_.end());
+}
+
+Matrix3x4 NetworkHitHistory::SampleTransform(
+    unsigned objectIndex, const FrameSnapshot& base, const FrameSnapshot* next, float blendFactor) const
+{
+    const ObjectSnapshot& object = base.objects_[objectIndex];
+    const unsigned nextIndex = nextObjectIndices_[objectIndex];
+    if (!next || nextIndex == M_MAX_UNSIGNED)
+        return Matrix3x4{object.position_, object.rotation_, object.scale_};
+
+    const ObjectSnapshot& nextObject = next->objects_[nextIndex];
+    return Matrix3x4{object.position_.Lerp(nextObject.position_, blendFactor),
+        object.rotation_.Slerp(nextObject.rotation_, blendFactor), object.scale_.Lerp(nextObject.scale_, blendFactor)};
+}
+
+void NetworkHitHistory::CollectRayCandidates(const Ray& ray, float maxDistance)
+{
+    ++currentStamp_;
+    candidates_.clear();
+    for (unsigned objectIndex : largeObjects_)
+        AddCandidate(objectIndex);
+
+    float tMin = 0.0f;
+    float tMax = maxDistance;
+    if (gridCells_.empty() || !gridBoundingBox_.Defined()
+        || !ClipRayToBox(ray.origin_, ray.direction_, gridBoundingBox_, tMin, tMax))
+        return;
+
+    // Test all objects if the ray crosses more cells than there are objects
+    const unsigned numObjects = nextObjectIndices_.size();
+    const float maxCrossedCells = 3.0f * ((tMax - tMin) / cellSize_ + 1.0f);
+    if (maxCrossedCells > static_cast<float>(numObjects))
+    {
+        for (unsigned objectIndex = 0; objectIndex < numObjects; ++objectIndex)
+            AddCandidate(objectIndex);
+        return;
+    }
+
+    // Walk cells along the ray
+    const Vector3 start = ray.origin_ + ray.direction_ * tMin;
+    int cell[3] = {GetCellCoordinate(start.x_), GetCellCoordinate(start.y_), GetCellCoordinate(start.z_)};
+    int step[3]{};
+    float tNext[3]{};
+    float tDelta[3]{};
+    for (unsigned axis = 0; axis < 3; ++axis)
+    {
+        const float direction = ray.direction_.Data()[axis];
+        if (Abs(direction) < M_EPSILON)
+        {
+            tNext[axis] = M_INFINITY;
+            tDelta[axis] = M_INFINITY;
+            continue;
+        }
+
+        step[axis] = direction > 0.0f ? 1 : -1;
+        const float boundary = (cell[axis] + (direction > 0.0f ? 1 : 0)) * cellSize_;
+        tNext[axis] = tMin + (boundary - start.Data()[axis]) / direction;
+        tDelta[axis] = cellSize_ / Abs(direction);
+    }
+
+    while (true)
+    {
+        AddCellCandidates(GetCellKey(cell[0], cell[1], cell[2]));
+
+        const unsigned axis = tNext[0] < tNext[1] ? (tNext[0] < tNext[2] ? 0 : 2) : (tNext[1] < tNext[2] ? 1 : 2);
+        if (tNext[axis] > tMax)
+            break;
+
+        cell[axis] += step[axis];
+        tNext[axis] += tDelta[axis];
+    }
+}
+
+void NetworkHitHistory::CollectBoxCandidates(const BoundingBox& box)
+{
+    ++currentStamp_;
+    candidates_.clear();
+    for (unsigned objectIndex : largeObjects_)
+        AddCandidate(objectIndex);
+
+    if (gridCells_.empty() || box.IsInside(gridBoundingBox_) == OUTSIDE)
+        return;
+
+    const int minX = GetCellCoordinate(box.min_.x_);
+    const int minY = GetCellCoordinate(box.min_.y_);
+    const int minZ = GetCellCoordinate(box.min_.z_);
+    const int maxX = GetCellCoordinate(box.max_.x_);
+    const int maxY = GetCellCoordinate(box.max_.y_);
+    const int maxZ = GetCellCoordinate(box.max_.z_);
+
+    // Test all objects if the box covers more cells than there are objects
+    const unsigned numObjects = nextObjectIndices_.size();
+    const auto numCells = static_cast<unsigned long long>(maxX - minX + 1) * (maxY - minY + 1) * (maxZ - minZ + 1);
+    if (numCells > numObjects)
+    {
+        for (unsigned objectIndex = 0; objectIndex < numObjects; ++objectIndex)
+            AddCandidate(objectIndex);
+        return;
+    }
+
+    for (int x = minX; x <= maxX; ++x)
+    {
+        for (int y = minY; y <= maxY; ++y)
+        {
+            for (int z = minZ; z <= maxZ; ++z)
+                AddCellCandidates(GetCellKey(x, y, z));
+        }
+    }
+}
+
+void NetworkHitHistory::AddCandidate(unsigned objectIndex)
+{
+    if (candidateStamps_[objectIndex] != currentStamp_)
+    {
+        candidateStamps_[objectIndex] = currentStamp_;
+        candidates_.push_back(objectIndex);
+    }
+}
+
+void NetworkHitHistory::AddCellCandidates(CellKey key)
+{
+    const auto isLess = [](const ea::pair<CellKey, unsigned>& lhs, CellKey rhs) { return lhs.first < rhs; };
+    for (auto iter = ea::lower_bound(gridCells_.begin(), gridCells_.end(), key, isLess);
+         iter != gridCells_.end() && iter->first == key; ++iter)
+    {
+        AddCandidate(iter->second);
+    }
+}
+
+unsigned NetworkHitHistory::GetFrameIndex(NetworkFrame frame) const
+{
+    const auto capacity = static_cast<long long>(frames_.size());
+    const long long index = static_cast<long long>(frame) % capacity;
+    return static_cast<unsigned>(index < 0 ? index + capacity : index);
+}
+
+int NetworkHitHistory::GetCellCoordinate(float value) const
+{
+    return ea::clamp(FloorToInt(value / cellSize_), -MaxCellCoordinate, MaxCellCoordinate);
+}
+
+NetworkHitHistory::CellKey NetworkHitHistory::GetCellKey(int x, int y, int z) const
+{
+    const auto pack = [](int value) { return static_cast<CellKey>(value + MaxCellCoordinate) & 0x1fffff; };
+    return (pack(x) << 42) | (pack(y) << 21) | pack(z);
+}
+
+}
@@ -0,0 +1,202 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/// \file
+
+#pragma once
+
+#include "../Math/BoundingBox.h"
+#include "../Math/Matrix3x4.h"
+#include "../Math/Ray.h"
+#include "../Math/Sphere.h"
+#include "../Replica/NetworkId.h"
+#include "../Replica/NetworkTime.h"
+
+#include <EASTL/optional.h>
+#include <EASTL/span.h>
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class NetworkObject;
+
+/// Shape of NetworkObject in the local space of its node, used by lag-compensated queries.
+struct NetworkHitShape
+{
+    enum class Type
+    {
+        Box,
+        Sphere
+    };
+
+    Type type_{};
+    /// Offset of the shape relative to the node, without scale.
+    Matrix3x4 offset_;
+    /// Size of the box or diameter of the sphere.
+    Vector3 size_;
+};
+
+/// Ray query against the past state of the scene.
+struct NetworkRayQuery
+{
+    Ray ray_;
+    float maxDistance_{M_LARGE_VALUE};
+    NetworkTime time_;
+};
+
+/// Sphere overlap query against the past state of the scene.
+struct NetworkSphereQuery
+{
+    Sphere sphere_;
+    NetworkTime time_;
+};
+
+/// Result of lag-compensated query.
+struct NetworkHitResult
+{
+    /// Index of the query in the batch.
+    unsigned queryIndex_{};
+    NetworkId networkId_{};
+    /// Index of the shape within the object.
+    unsigned shapeIndex_{};
+    /// Hit position for ray queries, center of the hit shape for sphere queries.
+    Vector3 position_;
+    /// Distance along the ray for ray queries, zero for sphere queries.
+    float distance_{};
+};
+
+/// History of transforms and collision shapes of NetworkObject-s for the last N frames.
+/// Server records it once per network frame. Queries are rewound to the requested time,
+/// interpolated between recorded frames and processed in batches: all queries of the same frame
+/// share one spatial grid, so hit validation doesn't scale with shots times objects.
+/// Shapes are taken from CollisionShape components of the node: boxes and spheres are exact,
+/// other finite shapes are approximated by boxes. Static planes and terrains are ignored.
+class URHO3D_API NetworkHitHistory
+{
+public:
+    static constexpr float DefaultCellSize = 8.0f;
+    /// Objects that cover more cells are tested by every query.
+    static constexpr unsigned MaxCellsPerObject = 64;
+
+    /// Remove all recorded frames and set max number of frames and size of the grid cell.
+    void Reset(unsigned numFrames, float cellSize = DefaultCellSize);
+    /// Record state of the objects in the frame. Frames should be recorded in increasing order.
+    void RecordFrame(NetworkFrame frame, ea::span<NetworkObject* const> networkObjects);
+    /// Record object with explicit shapes. Should be called after RecordFrame for the same frame.
+    void RecordObject(NetworkFrame frame, NetworkId networkId, const Matrix3x4& worldTransform,
+        ea::span<const NetworkHitShape> shapes);
+
+    /// Process ray queries and return the closest hit per query, if any. Results are sorted by query index.
+    /// Queries outside of the recorded history are clamped to the closest recorded frame.
+    void ProcessRayQueries(ea::span<const NetworkRayQuery> queries, ea::vector<NetworkHitResult>& results);
+    /// Process sphere queries and return all overlapped shapes. Results are sorted by query index.
+    void ProcessSphereQueries(ea::span<const NetworkSphereQuery> queries, ea::vector<NetworkHitResult>& results);
+
+    /// Return properties and state.
+    /// @{
+    unsigned GetCapacity() const { return frames_.size(); }
+    float GetCellSize() const { return cellSize_; }
+    bool HasFrame(NetworkFrame frame) const;
+    unsigned GetNumObjects(NetworkFrame frame) const;
+    /// @}
+
+private:
+    using CellKey = unsigned long long;
+
+    struct ObjectSnapshot
+    {
+        NetworkId networkId_{};
+        Vector3 position_;
+        Quaternion rotation_;
+        Vector3 scale_;
+        unsigned firstShape_{};
+        unsigned numShapes_{};
+        BoundingBox worldBoundingBox_;
+    };
+
+    struct FrameSnapshot
+    {
+        bool valid_{};
+        NetworkFrame frame_{};
+        ea::vector<ObjectSnapshot> objects_;
+        ea::vector<NetworkHitShape> shapes_;
+        ea::unordered_map<NetworkId, unsigned> objectIndices_;
+    };
+
+    /// Query assigned to recorded frames.
+    struct QueryFrames
+    {
+        unsigned queryIndex_{};
+        const FrameSnapshot* base_{};
+        const FrameSnapshot* next_{};
+        float blendFactor_{};
+    };
+
+    unsigned GetFrameIndex(NetworkFrame frame) const;
+    FrameSnapshot* GetFrameSnapshot(NetworkFrame frame);
+    const FrameSnapshot* GetFrameSnapshot(NetworkFrame frame) const;
+    /// Find the recorded frame closest to the time, and the frame after it if any.
+    bool FindFrames(const NetworkTime& time, QueryFrames& result) const;
+    /// Assign queries to frames and sort them so queries of the same frame are processed together.
+    template <class T> void SortQueries(ea::span<const T> queries);
+    /// Build spatial grid over the objects swept between two frames, unless already built.
+    void BuildGrid(const FrameSnapshot& base, const FrameSnapshot* next);
+    /// Sample object transform at the time between two frames.
+    Matrix3x4 SampleTransform(unsigned objectIndex, const FrameSnapshot& base, const FrameSnapshot* next, float blendFactor) const;
+
+    /// Collect candidate objects intersected by the segment of the ray.
+    void CollectRayCandidates(const Ray& ray, float maxDistance);
+    /// Collect candidate objects intersected by the box.
+    void CollectBoxCandidates(const BoundingBox& box);
+    void AddCandidate(unsigned objectIndex);
+    void AddCellCandidates(CellKey key);
+
+    int GetCellCoordinate(float value) const;
+    CellKey GetCellKey(int x, int y, int z) const;
+
+    float cellSize_{DefaultCellSize};
+    ea::vector<FrameSnapshot> frames_;
+    ea::optional<NetworkFrame> lastFrame_;
+    ea::vector<QueryFrames> sortedQueries_;
+
+    /// Grid of the frame being queried. Sorted pairs of cell and object index.
+    /// @{
+    ea::vector<ea::pair<CellKey, unsigned>> gridCells_;
+    ea::vector<unsigned> largeObjects_;
+    ea::vector<unsigned> nextObjectIndices_;
+    BoundingBox gridBoundingBox_;
+    const FrameSnapshot* gridBase_{};
+    const FrameSnapshot* gridNext_{};
+    /// @}
+
+    /// Candidates of the current query, deduplicated by stamp.
+    /// @{
+    ea::vector<unsigned> candidates_;
+    ea::vector<unsigned> candidateStamps_;
+    unsigned currentStamp_{};
+    /// @}
+};
+
+}
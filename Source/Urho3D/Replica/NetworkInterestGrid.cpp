@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Replica/NetworkInterestGrid.h"
+
+namespace Urho3D
+{
+
+void NetworkInterestGrid::Reset(float cellSize)
+{
+    cellSize_ = ea::max(cellSize, M_EPSILON);
+
+    // Keep allocated memory, the set of cells is usually stable between frames
+    for (auto& [key, points] : cells_)
+        points.clear();
+    for (auto& [connection, points] : pointsByConnection_)
+        points.clear();
+}
+
+void NetworkInterestGrid::AddInterestPoint(AbstractConnection* connection, const Vector3& position)
+{
+    const CellKey key = GetCellKey(
+        GetCellCoordinate(position.x_), GetCellCoordinate(position.y_), GetCellCoordinate(position.z_));
+    cells_[key].push_back(InterestPoint{connection, position});
+    pointsByConnection_[connection].push_back(position);
+}
+
+float NetworkInterestGrid::GetDistanceToConnection(
+    AbstractConnection* connection, const Vector3& position, float maxDistance) const
+{
+    const auto pointsIter = pointsByConnection_.find(connection);
+    if (pointsIter == pointsByConnection_.end() || pointsIter->second.empty())
+        return M_LARGE_VALUE;
+
+    const PositionVector& connectionPoints = pointsIter->second;
+    float minDistanceSquared = M_LARGE_VALUE;
+
+    const Vector3 extent{maxDistance, maxDistance, maxDistance};
+    const Vector3 minPosition = position - extent;
+    const Vector3 maxPosition = position + extent;
+    const int minX = GetCellCoordinate(minPosition.x_);
+    const int minY = GetCellCoordinate(minPosition.y_);
+    const int minZ = GetCellCoordinate(minPosition.z_);
+    const int maxX = GetCellCoordinate(maxPosition.x_);
+    const int maxY = GetCellCoordinate(maxPosition.y_);
+    const int maxZ = GetCellCoordinate(maxPosition.z_);
+
+    // Scan points of the connection directly if the query covers more cells than there are points
+    const auto numCells = static_cast<unsigned long long>(maxX - minX + 1) * (maxY - minY + 1) * (maxZ - minZ + 1);
+    if (numCells > connectionPoints.size())
+    {
+        for (const Vector3& point : connectionPoints)
+            minDistanceSquared = ea::min(minDistanceSquared, (point - position).LengthSquared());
+        return Sqrt(minDistanceSquared);
+    }
+
+    for (int x = minX; x <= maxX; ++x)
+    {
+        for (int y = minY; y <= maxY; ++y)
+        {
+            for (int z = minZ; z <= maxZ; ++z)
+            {
+                const auto cellIter = cells_.find(GetCellKey(x, y, z));
+                if (cellIter == cells_.end())
+                    continue;
+
+                for (const InterestPoint& point : cellIter->second)
+                {
+                    if (point.connection_ == connection)
+                        minDistanceSquared = ea::min(minDistanceSquared, (point.position_ - position).LengthSquared());
+                }
+            }
+        }
+    }
+
+    return minDistanceSquared < M_LARGE_VALUE ? Sqrt(minDistanceSquared) : M_LARGE_VALUE;
+}
+
+bool NetworkInterestGrid::IsInRange(AbstractConnection* connection, const Vector3& position, float distance) const
+{
+    return GetDistanceToConnection(connection, position, distance) < distance;
+}
+
+unsigned NetworkInterestGrid::GetNumInterestPoints(AbstractConnection* connection) const
+{
+    const auto iter = pointsByConnection_.find(connection);
+    return iter != pointsByConnection_.end() ? iter->second.size() : 0;
+}
+
+int NetworkInterestGrid::GetCellCoordinate(float value) const
+{
+    // Clamp to the range representable by the cell key
+    static constexpr float maxCoordinate = static_cast<float>((1 << 20) - 1);
+    return static_cast<int>(Clamp(Floor(value / cellSize_), -maxCoordinate, maxCoordinate));
+}
+
+NetworkInterestGrid::CellKey NetworkInterestGrid::GetCellKey(int x, int y, int z) const
+{
+    static constexpr CellKey mask = (1ull << 21) - 1;
+    return (static_cast<CellKey>(x) & mask) | ((static_cast<CellKey>(y) & mask) << 21)
+        | ((static_cast<CellKey>(z) & mask) << 42);
+}
+
+}
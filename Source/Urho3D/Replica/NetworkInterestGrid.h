@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/// \file
+
+#pragma once
+
+#include "../Core/MemoryTracker.h"
+#include "../Math/Vector3.h"
+
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class AbstractConnection;
+
+URHO3D_MEMORY_TAG(NetworkInterestGridMemoryTag, "Replica/NetworkInterestGrid");
+
+/// Spatial hash of interest points of client connections, i.e. positions of NetworkObject-s owned by connections.
+/// Server rebuilds it once per network frame so relevance behaviors can query it
+/// instead of iterating owned objects for each (object, connection) pair.
+class URHO3D_API NetworkInterestGrid
+{
+public:
+    static constexpr float DefaultCellSize = 50.0f;
+
+    /// Remove all interest points and set size of the grid cell.
+    void Reset(float cellSize);
+    /// Add interest point of the connection.
+    void AddInterestPoint(AbstractConnection* connection, const Vector3& position);
+
+    /// Return distance from the position to the nearest interest point of the connection.
+    /// Points farther than maxDistance may be ignored, M_LARGE_VALUE is returned if nothing is found.
+    float GetDistanceToConnection(AbstractConnection* connection, const Vector3& position, float maxDistance) const;
+    /// Return whether any interest point of the connection is closer to the position than the distance.
+    bool IsInRange(AbstractConnection* connection, const Vector3& position, float distance) const;
+
+    /// Return properties and state.
+    /// @{
+    float GetCellSize() const { return cellSize_; }
+    unsigned GetNumInterestPoints(AbstractConnection* connection) const;
+    /// @}
+
+private:
+    using CellKey = unsigned long long;
+
+    struct InterestPoint
+    {
+        AbstractConnection* connection_{};
+        Vector3 position_;
+    };
+
+    int GetCellCoordinate(float value) const;
+    CellKey GetCellKey(int x, int y, int z) const;
+
+    using Allocator = TaggedAllocator<NetworkInterestGridMemoryTag>;
+    using PointVector = ea::vector<InterestPoint, Allocator>;
+    using PositionVector = ea::vector<Vector3, Allocator>;
+
+    float cellSize_{DefaultCellSize};
+    ea::unordered_map<CellKey, PointVector, ea::hash<CellKey>, ea::equal_to<CellKey>, Allocator> cells_;
+    /// Interest points of the connections, used when the query covers too many cells.
+    ea::unordered_map<AbstractConnection*, PositionVector, ea::hash<AbstractConnection*>,
+        ea::equal_to<AbstractConnection*>, Allocator> pointsByConnection_;
+};
+
+}
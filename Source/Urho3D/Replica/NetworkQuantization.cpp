@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Replica/NetworkQuantization.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+constexpr unsigned QuaternionComponentBits = 10;
+constexpr unsigned QuaternionComponentMask = (1u << QuaternionComponentBits) - 1;
+constexpr float QuaternionComponentLimit = 0.70710678f;
+
+unsigned QuantizeQuaternionComponent(float value)
+{
+    const float normalized = Clamp(value / QuaternionComponentLimit * 0.5f + 0.5f, 0.0f, 1.0f);
+    return static_cast<unsigned>(RoundToInt(normalized * QuaternionComponentMask));
+}
+
+float DequantizeQuaternionComponent(unsigned value)
+{
+    const float normalized = static_cast<float>(value & QuaternionComponentMask) / QuaternionComponentMask;
+    return (normalized - 0.5f) * 2.0f * QuaternionComponentLimit;
+}
+
+}
+
+void WriteQuantizedFloat(Serializer& dest, float value, float precision)
+{
+    static constexpr auto maxValue = static_cast<double>(M_MAX_INT);
+    const double quantized = Clamp(Round(static_cast<double>(value) / precision), -maxValue, maxValue);
+    dest.WriteVLE(ZigZagEncode(static_cast<int>(quantized)));
+}
+
+float ReadQuantizedFloat(Deserializer& src, float precision)
+{
+    return static_cast<float>(ZigZagDecode(src.ReadVLE()) * static_cast<double>(precision));
+}
+
+void WriteQuantizedVector3(Serializer& dest, const Vector3& value, float precision)
+{
+    WriteQuantizedFloat(dest, value.x_, precision);
+    WriteQuantizedFloat(dest, value.y_, precision);
+    WriteQuantizedFloat(dest, value.z_, precision);
+}
+
+Vector3 ReadQuantizedVector3(Deserializer& src, float precision)
+{
+    const float x = ReadQuantizedFloat(src, precision);
+    const float y = ReadQuantizedFloat(src, precision);
+    const float z = ReadQuantizedFloat(src, precision);
+    return {x, y, z};
+}
+
+unsigned PackQuaternion(const Quaternion& value)
+{
+    const float components[4] = {value.w_, value.x_, value.y_, value.z_};
+
+    unsigned largestIndex = 0;
+    for (unsigned i = 1; i < 4; ++i)
+    {
+        if (Abs(components[i]) > Abs(components[largestIndex]))
+            largestIndex = i;
+    }
+
+    // Quaternion and its negation represent the same rotation, keep the largest component positive
+    const float sign = components[largestIndex] < 0.0f ? -1.0f : 1.0f;
+
+    unsigned result = largestIndex;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        if (i != largestIndex)
+            result = (result << QuaternionComponentBits) | QuantizeQuaternionComponent(components[i] * sign);
+    }
+    return result;
+}
+
+Quaternion UnpackQuaternion(unsigned value)
+{
+    const unsigned largestIndex = value >> (3 * QuaternionComponentBits);
+
+    float components[4]{};
+    float sumSquared = 0.0f;
+    unsigned shift = 3 * QuaternionComponentBits;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        if (i == largestIndex)
+            continue;
+
+        shift -= QuaternionComponentBits;
+        components[i] = DequantizeQuaternionComponent(value >> shift);
+        sumSquared += components[i] * components[i];
+    }
+    components[largestIndex] = Sqrt(ea::max(0.0f, 1.0f - sumSquared));
+
+    Quaternion result{components[0], components[1], components[2], components[3]};
+    result.Normalize();
+    return result;
+}
+
+}
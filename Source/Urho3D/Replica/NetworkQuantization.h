@@ -0,0 +1,61 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/// \file
+
+#pragma once
+
+#include "../IO/Deserializer.h"
+#include "../IO/Serializer.h"
+#include "../Math/Quaternion.h"
+#include "../Math/Vector3.h"
+
+namespace Urho3D
+{
+
+/// Helpers for compact encoding of values replicated over network.
+/// @{
+
+/// Encode signed integer so small absolute values take less bytes when written as VLE.
+inline unsigned ZigZagEncode(int value) { return (static_cast<unsigned>(value) << 1) ^ static_cast<unsigned>(value >> 31); }
+/// Decode signed integer encoded with ZigZagEncode.
+inline int ZigZagDecode(unsigned value) { return static_cast<int>(value >> 1) ^ -static_cast<int>(value & 1); }
+
+/// Write float quantized with given precision as VLE. Values out of range are clamped.
+URHO3D_API void WriteQuantizedFloat(Serializer& dest, float value, float precision);
+/// Read float written by WriteQuantizedFloat.
+URHO3D_API float ReadQuantizedFloat(Deserializer& src, float precision);
+/// Write vector quantized with given precision.
+URHO3D_API void WriteQuantizedVector3(Serializer& dest, const Vector3& value, float precision);
+/// Read vector written by WriteQuantizedVector3.
+URHO3D_API Vector3 ReadQuantizedVector3(Deserializer& src, float precision);
+
+/// Pack normalized quaternion into 32 bits using "smallest three" encoding:
+/// the index of the largest component and three other components in 10 bits each.
+URHO3D_API unsigned PackQuaternion(const Quaternion& value);
+/// Unpack quaternion packed by PackQuaternion.
+URHO3D_API Quaternion UnpackQuaternion(unsigned value);
+
+/// @}
+
+}
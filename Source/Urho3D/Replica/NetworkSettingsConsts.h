@@ -64,7 +64,7 @@ namespace NetworkSettings
 /// @{
 
 /// Version of internal protocol.
-URHO3D_NETWORK_SETTING(InternalProtocolVersion, unsigned, 1);
+URHO3D_NETWORK_SETTING(InternalProtocolVersion, unsigned, 2);
 /// Update frequency of the server, frames per second.
 URHO3D_NETWORK_SETTING(UpdateFrequency, unsigned, 30);
 /// Connection ID of current client.
@@ -103,6 +103,23 @@ URHO3D_NETWORK_SETTING(InputBufferingMin, unsigned, 0);
 URHO3D_NETWORK_SETTING(InputBufferingMax, unsigned, 8);
 /// Interval in seconds between NetworkObject becoming unneeded for client and replication stopped.
 URHO3D_NETWORK_SETTING(RelevanceTimeout, float, 5.0f);
+/// Size of the cell of the spatial grid used to find objects owned by client near other objects.
+URHO3D_NETWORK_SETTING(InterestGridCellSize, float, 50.0f);
+/// Whether to update and send messages to clients in parallel using WorkQueue.
+/// Relevance and snapshot callbacks of NetworkObject-s must be thread-safe if enabled.
+URHO3D_NETWORK_SETTING(ParallelClientUpdates, bool, false);
+/// Budget in bytes per second for unreliable updates sent to each client. Zero means unlimited.
+/// If budget is exceeded, objects with the highest accumulated priority are sent first.
+URHO3D_NETWORK_SETTING(UnreliableBandwidthBudget, unsigned, 0);
+/// Distance from objects owned by client at which priority of unreliable update is halved.
+URHO3D_NETWORK_SETTING(UpdatePriorityDistance, float, 20.0f);
+/// Max number of objects that start replication for each client per frame. Zero means unlimited.
+/// Objects above the limit are streamed over next frames, objects closest to the client go first.
+URHO3D_NETWORK_SETTING(MaxAddedObjectsPerFrame, unsigned, 64);
+/// Whether to record transforms and collision shapes of objects for lag-compensated hit queries.
+URHO3D_NETWORK_SETTING(EnableHitHistory, bool, false);
+/// Size of the cell of the spatial grid used by lag-compensated hit queries.
+URHO3D_NETWORK_SETTING(HitHistoryCellSize, float, 8.0f);
 /// Duration in seconds of value tracking on server. Used for lag compensation.
 URHO3D_NETWORK_SETTING(ServerTracingDuration, float, 5.0f);
 
@@ -27,12 +27,14 @@
 #ifdef URHO3D_PHYSICS
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
+#include "../Core/Profiler.h"
 #include "../Physics/KinematicCharacterController.h"
 #include "../Physics/PhysicsEvents.h"
 #include "../Physics/PhysicsWorld.h"
 #include "../Scene/Node.h"
 #include "../Scene/Scene.h"
 #include "../Network/NetworkEvents.h"
+#include "../Replica/ClientReplica.h"
 #include "../Replica/NetworkSettingsConsts.h"
 #include "../Replica/ReplicatedTransform.h"
 
@@ -46,6 +48,8 @@ PredictedKinematicController::PredictedKinematicController(Context* context)
 
 PredictedKinematicController::~PredictedKinematicController()
 {
+    if (client_.replayer_)
+        client_.replayer_->RemoveController(this);
 }
 
 void PredictedKinematicController::RegisterObject(Context* context)
@@ -139,13 +143,10 @@ void PredictedKinematicController::InitializeFromSnapshot(NetworkFrame frame, De
 
         client_.input_.set_capacity(maxInputFrames_);
 
-        SubscribeToEvent(physicsWorld_, E_PHYSICSPRESTEP,
-            [this](VariantMap& eventData)
-        {
-            const Variant& networkFrame = eventData[PhysicsPreStep::P_NETWORKFRAME];
-            if (!networkFrame.IsEmpty())
-                OnPhysicsSynchronizedOnClient(static_cast<NetworkFrame>(networkFrame.GetInt64()));
-        });
+        ClientReplica* clientReplica = GetNetworkObject()->GetReplicationManager()->GetClientReplica();
+        client_.replayer_ = clientReplica ? clientReplica->GetKinematicReplayer() : nullptr;
+        if (client_.replayer_)
+            client_.replayer_->AddController(this);
     }
     else
         kinematicController_->SetGravity(Vector3::ZERO);
@@ -176,6 +177,12 @@ void PredictedKinematicController::InitializeCommon()
     UnsubscribeFromEvent(E_BEGINSERVERNETWORKFRAME);
     UnsubscribeFromEvent(E_PHYSICSPRESTEP);
 
+    if (client_.replayer_)
+    {
+        client_.replayer_->RemoveController(this);
+        client_.replayer_ = nullptr;
+    }
+
     replicatedTransform_ = node_->GetComponent<ReplicatedTransform>();
     kinematicController_ = node_->GetComponent<KinematicCharacterController>();
 
@@ -193,6 +200,7 @@ void PredictedKinematicController::InitializeCommon()
         maxInputFrames_ = replicationManager->GetSetting(NetworkSettings::MaxInputFrames).GetUInt();
         maxRedundancy_ = replicationManager->GetSetting(NetworkSettings::MaxInputRedundancy).GetUInt();
         networkStepTime_ = 1.0f / replicationManager->GetUpdateFrequency();
+        physicsStepsPerFrame_ = physicsWorld_ ? ea::max(1, RoundToInt(networkStepTime_ / physicsStepTime_)) : 1;
     }
 }
 
@@ -266,10 +274,6 @@ void PredictedKinematicController::OnServerFrameBegin(NetworkFrame serverFrame)
 
 void PredictedKinematicController::OnPhysicsSynchronizedOnClient(NetworkFrame frame)
 {
-    if (!IsConnectedToComponents())
-        return;
-
-    CheckAndCorrectController(frame);
     TrackCurrentInput(frame);
     ApplyActionsOnClient();
     UpdateEffectiveVelocity(networkStepTime_);
@@ -290,49 +294,78 @@ void PredictedKinematicController::UpdateEffectiveVelocity(float timeStep)
     previousPosition_ = currentPosition;
 }
 
-void PredictedKinematicController::CheckAndCorrectController(NetworkFrame frame)
+unsigned PredictedKinematicController::CheckAndRewindController(NetworkFrame frame)
 {
     // Skip if not ready
     const auto latestConfirmedFrame = replicatedTransform_->GetLatestFrame();
     if (client_.input_.empty() || !latestConfirmedFrame)
-        return;
+        return 0;
 
     // Apply only latest confirmed state only once.
     if (client_.latestConfirmedFrame_ && *client_.latestConfirmedFrame_ == *latestConfirmedFrame)
-        return;
+        return 0;
 
     // Avoid re-adjusting affected frames to stabilize behavior.
     if (client_.latestAffectedFrame_ && (*latestConfirmedFrame <= *client_.latestAffectedFrame_))
-        return;
+        return 0;
 
     // Skip if cannot find matching input frame for whatever reason
     const auto nextInputFrameIter = ea::find_if(client_.input_.begin(), client_.input_.end(),
         [&](const InputFrame& inputFrame) { return !inputFrame.isLost_ && inputFrame.frame_ == *latestConfirmedFrame + 1; });
     if (nextInputFrameIter == client_.input_.end())
-        return;
+        return 0;
 
     const unsigned nextInputFrameIndex = nextInputFrameIter - client_.input_.begin();
-    if (AdjustConfirmedFrame(*latestConfirmedFrame, nextInputFrameIndex))
+    const unsigned numReplayedFrames = RewindToConfirmedFrame(*latestConfirmedFrame, nextInputFrameIndex);
+    if (numReplayedFrames != 0)
         client_.latestAffectedFrame_ = frame;
     client_.latestConfirmedFrame_ = *latestConfirmedFrame;
+    return numReplayedFrames;
 }
 
-bool PredictedKinematicController::AdjustConfirmedFrame(NetworkFrame confirmedFrame, unsigned nextInputFrameIndex)
+unsigned PredictedKinematicController::RewindToConfirmedFrame(NetworkFrame confirmedFrame, unsigned nextInputFrameIndex)
 {
     const float movementThreshold = replicatedTransform_->GetMovementThreshold();
-    const float smoothingConstant = replicatedTransform_->GetSmoothingConstant();
 
     const auto confirmedPosition = replicatedTransform_->GetTemporalPosition(confirmedFrame);
     URHO3D_ASSERT(confirmedPosition);
 
     const InputFrame& nextInput = client_.input_[nextInputFrameIndex];
-    const Vector3 offset = confirmedPosition->value_ - nextInput.startPosition_;
-    if (!offset.Equals(Vector3::ZERO, movementThreshold))
-    {
-        kinematicController_->AdjustRawPosition(offset, smoothingConstant);
-        return true;
-    }
-    return false;
+    if (confirmedPosition->value_.Equals(nextInput.startState_.rawPosition_, movementThreshold))
+        return 0;
+
+    // Rewind to the state at the start of the next frame, with position corrected by the server
+    KinematicCharacterControllerState state = nextInput.startState_;
+    state.rawPosition_ = confirmedPosition->value_;
+
+    client_.replayOriginalPosition_ = kinematicController_->GetRawPosition();
+    client_.replayStartIndex_ = nextInputFrameIndex;
+    kinematicController_->SetKinematicState(state);
+    return client_.input_.size() - nextInputFrameIndex;
+}
+
+void PredictedKinematicController::ReplayInputFrame(unsigned index)
+{
+    const InputFrame& input = client_.input_[client_.replayStartIndex_ + index];
+
+    kinematicController_->SetWalkIncrement(input.walkVelocity_ * physicsStepTime_);
+    if (input.needJump_ && kinematicController_->OnGround())
+        kinematicController_->Jump();
+
+    for (unsigned i = 0; i < physicsStepsPerFrame_; ++i)
+        kinematicController_->StepKinematic(physicsStepTime_);
+}
+
+void PredictedKinematicController::FinishReplay()
+{
+    const float smoothingConstant = replicatedTransform_->GetSmoothingConstant();
+
+    // Keep replayed state, but move the controller back so the correction is smoothed out
+    KinematicCharacterControllerState state = kinematicController_->GetKinematicState();
+    const Vector3 offset = state.rawPosition_ - client_.replayOriginalPosition_;
+    state.rawPosition_ = client_.replayOriginalPosition_;
+    kinematicController_->SetKinematicState(state);
+    kinematicController_->AdjustRawPosition(offset, smoothingConstant);
 }
 
 void PredictedKinematicController::TrackCurrentInput(NetworkFrame frame)
@@ -364,7 +397,7 @@ void PredictedKinematicController::TrackCurrentInput(NetworkFrame frame)
     InputFrame currentInput;
     currentInput.frame_ = frame;
     currentInput.walkVelocity_ = client_.walkVelocity_;
-    currentInput.startPosition_ = kinematicController_->GetRawPosition();
+    currentInput.startState_ = kinematicController_->GetKinematicState();
     currentInput.needJump_ = client_.needJump_;
     currentInput.rotation_ = node_->GetWorldRotation();
     client_.input_.push_back(currentInput);
@@ -393,5 +426,81 @@ void PredictedKinematicController::ReadInputFrame(NetworkFrame frame, Deserializ
         server_.input_.Set(frame, inputFrame);
 }
 
+PredictedKinematicReplayer::PredictedKinematicReplayer(PhysicsWorld* physicsWorld)
+    : Object(physicsWorld->GetContext())
+    , physicsWorld_(physicsWorld)
+{
+    SubscribeToEvent(physicsWorld_, E_PHYSICSPRESTEP,
+        [this](VariantMap& eventData)
+    {
+        const Variant& networkFrame = eventData[PhysicsPreStep::P_NETWORKFRAME];
+        if (!networkFrame.IsEmpty())
+            OnPhysicsPreStep(static_cast<NetworkFrame>(networkFrame.GetInt64()));
+    });
+}
+
+PredictedKinematicReplayer::~PredictedKinematicReplayer()
+{
+}
+
+void PredictedKinematicReplayer::AddController(PredictedKinematicController* controller)
+{
+    const WeakPtr<PredictedKinematicController> weakController{controller};
+    if (ea::find(controllers_.begin(), controllers_.end(), weakController) == controllers_.end())
+        controllers_.push_back(weakController);
+}
+
+void PredictedKinematicReplayer::RemoveController(PredictedKinematicController* controller)
+{
+    ea::erase_if(controllers_, [&](const WeakPtr<PredictedKinematicController>& item) { return !item || item == controller; });
+}
+
+void PredictedKinematicReplayer::OnPhysicsPreStep(NetworkFrame frame)
+{
+    ea::erase_if(controllers_, [](const WeakPtr<PredictedKinematicController>& item) { return !item; });
+
+    // Rewind all controllers first so they are replayed against each other
+    unsigned maxReplayedFrames = 0;
+    pendingReplays_.clear();
+    for (PredictedKinematicController* controller : controllers_)
+    {
+        if (!controller->IsConnectedToComponents())
+            continue;
+
+        if (const unsigned numReplayedFrames = controller->CheckAndRewindController(frame))
+        {
+            pendingReplays_.emplace_back(controller, numReplayedFrames);
+            maxReplayedFrames = ea::max(maxReplayedFrames, numReplayedFrames);
+        }
+    }
+
+    if (!pendingReplays_.empty())
+    {
+        URHO3D_PROFILE("ReplayPredictedKinematics");
+
+        for (unsigned frameIndex = 0; frameIndex < maxReplayedFrames; ++frameIndex)
+        {
+            physicsWorld_->UpdateOverlappingPairs();
+            for (const auto& [controller, numReplayedFrames] : pendingReplays_)
+            {
+                if (frameIndex < numReplayedFrames)
+                    controller->ReplayInputFrame(frameIndex);
+            }
+        }
+
+        for (const auto& [controller, numReplayedFrames] : pendingReplays_)
+            controller->FinishReplay();
+
+        numReplayedControllers_ = pendingReplays_.size();
+        numReplayedFrames_ = maxReplayedFrames;
+    }
+
+    for (PredictedKinematicController* controller : controllers_)
+    {
+        if (controller->IsConnectedToComponents())
+            controller->OnPhysicsSynchronizedOnClient(frame);
+    }
+}
+
 }
 #endif
@@ -25,6 +25,9 @@
 #pragma once
 
 #include "../Replica/BehaviorNetworkObject.h"
+#ifdef URHO3D_PHYSICS
+#include "../Physics/KinematicCharacterController.h"
+#endif
 
 #include <EASTL/optional.h>
 #include <EASTL/vector.h>
@@ -36,6 +39,7 @@ namespace Urho3D
 {
 
 class KinematicCharacterController;
+class PredictedKinematicReplayer;
 class ReplicatedTransform;
 
 /// Kinematic controller of the player replicated over network.
@@ -79,11 +83,13 @@ public:
     /// @}
 
 private:
+    friend class PredictedKinematicReplayer;
+
     struct InputFrame
     {
         bool isLost_{};
         NetworkFrame frame_{};
-        Vector3 startPosition_;
+        KinematicCharacterControllerState startState_;
         Vector3 walkVelocity_;
         Quaternion rotation_;
         bool needJump_{};
@@ -93,9 +99,16 @@ private:
 
     void OnServerFrameBegin(NetworkFrame serverFrame);
 
+    /// Check latest confirmed state and rewind the controller if prediction was wrong.
+    /// Return number of input frames that should be replayed.
+    unsigned CheckAndRewindController(NetworkFrame frame);
+    /// Rewind the controller to the confirmed frame. Return number of input frames that should be replayed.
+    unsigned RewindToConfirmedFrame(NetworkFrame confirmedFrame, unsigned nextInputFrameIndex);
+    /// Re-simulate input frame with given index since rewind.
+    void ReplayInputFrame(unsigned index);
+    /// Finish replay and smooth out the difference between old and new predicted positions.
+    void FinishReplay();
     void OnPhysicsSynchronizedOnClient(NetworkFrame frame);
-    void CheckAndCorrectController(NetworkFrame frame);
-    bool AdjustConfirmedFrame(NetworkFrame confirmedFrame, unsigned nextInputFrameIndex);
     void TrackCurrentInput(NetworkFrame frame);
     void ApplyActionsOnClient();
     void UpdateEffectiveVelocity(float timeStep);
@@ -112,6 +125,7 @@ private:
 
     float networkStepTime_{};
     float physicsStepTime_{};
+    unsigned physicsStepsPerFrame_{};
     unsigned maxRedundancy_{};
     unsigned maxInputFrames_{};
 
@@ -131,9 +145,49 @@ private:
         ea::ring_buffer<InputFrame> input_;
         ea::optional<NetworkFrame> latestConfirmedFrame_;
         ea::optional<NetworkFrame> latestAffectedFrame_;
+
+        SharedPtr<PredictedKinematicReplayer> replayer_;
+        unsigned replayStartIndex_{};
+        Vector3 replayOriginalPosition_;
     } client_;
 };
 
+/// Re-simulates predicted kinematic controllers owned by the client when server state doesn't match prediction.
+/// All corrected controllers are rewound to the confirmed frame and replayed together,
+/// so the collision world is updated once per replayed frame instead of once per controller.
+class URHO3D_API PredictedKinematicReplayer : public Object
+{
+    URHO3D_OBJECT(PredictedKinematicReplayer, Object);
+
+public:
+    PredictedKinematicReplayer(PhysicsWorld* physicsWorld);
+    ~PredictedKinematicReplayer() override;
+
+    /// Add controller owned by this client. Controller is updated by the replayer on each network frame.
+    void AddController(PredictedKinematicController* controller);
+    /// Remove controller.
+    void RemoveController(PredictedKinematicController* controller);
+
+    /// Return physics world.
+    PhysicsWorld* GetPhysicsWorld() const { return physicsWorld_; }
+    /// Return number of controllers.
+    unsigned GetNumControllers() const { return controllers_.size(); }
+    /// Return number of controllers replayed on the latest correction.
+    unsigned GetNumReplayedControllers() const { return numReplayedControllers_; }
+    /// Return number of frames replayed on the latest correction.
+    unsigned GetNumReplayedFrames() const { return numReplayedFrames_; }
+
+private:
+    void OnPhysicsPreStep(NetworkFrame frame);
+
+    WeakPtr<PhysicsWorld> physicsWorld_;
+    ea::vector<WeakPtr<PredictedKinematicController>> controllers_;
+
+    ea::vector<ea::pair<PredictedKinematicController*, unsigned>> pendingReplays_;
+    unsigned numReplayedControllers_{};
+    unsigned numReplayedFrames_{};
+};
+
 }
 
 #endif
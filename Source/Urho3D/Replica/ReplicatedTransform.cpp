@@ -25,6 +25,7 @@
 #include "../Core/Context.h"
 #include "../Network/NetworkEvents.h"
 #include "../Replica/ReplicatedTransform.h"
+#include "../Replica/NetworkQuantization.h"
 #include "../Replica/NetworkSettingsConsts.h"
 
 namespace Urho3D
@@ -68,6 +69,8 @@ void ReplicatedTransform::RegisterObject(Context* context)
     URHO3D_ENUM_ATTRIBUTE("Synchronize Rotation", synchronizeRotation_, replicatedRotationModeNames, DefaultSynchronizeRotation, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Extrapolate Position", bool, extrapolatePosition_, DefaultExtrapolatePosition, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Extrapolate Rotation", bool, extrapolateRotation_, DefaultExtrapolateRotation, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Position Precision", GetPositionPrecision, SetPositionPrecision, float, DefaultPositionPrecision, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Quantize Rotation", bool, quantizeRotation_, DefaultQuantizeRotation, AM_DEFAULT);
 }
 
 void ReplicatedTransform::InitializeOnServer()
@@ -95,7 +98,12 @@ void ReplicatedTransform::WriteSnapshot(NetworkFrame frame, Serializer& dest)
     flags[1] = synchronizeRotation_ != ReplicatedRotationMode::None;
     flags[2] = extrapolatePosition_;
     flags[3] = extrapolateRotation_;
+    flags[4] = positionPrecision_ > 0.0f;
+    flags[5] = quantizeRotation_;
     dest.WriteVLE(flags.to_uint32());
+
+    if (flags[4])
+        dest.WriteFloat(positionPrecision_);
 }
 
 void ReplicatedTransform::InitializeFromSnapshot(NetworkFrame frame, Deserializer& src, bool isOwned)
@@ -107,6 +115,8 @@ void ReplicatedTransform::InitializeFromSnapshot(NetworkFrame frame, Deserialize
     synchronizeRotation_ = flags[1] ? ReplicatedRotationMode::XYZ : ReplicatedRotationMode::None;
     extrapolatePosition_ = flags[2];
     extrapolateRotation_ = flags[3];
+    positionPrecision_ = flags[4] ? src.ReadFloat() : 0.0f;
+    quantizeRotation_ = flags[5];
 
     const auto replicationManager = GetNetworkObject()->GetReplicationManager();
     const unsigned updateFrequency = replicationManager->GetUpdateFrequency();
@@ -196,38 +206,65 @@ bool ReplicatedTransform::PrepareUnreliableDelta(NetworkFrame frame)
 
 void ReplicatedTransform::WriteUnreliableDelta(NetworkFrame frame, Serializer& dest)
 {
+    // Velocities are often zero, don't send them at all then
+    ea::bitset<32> mask;
+    mask[0] = synchronizePosition_ && server_.velocity_ != Vector3::ZERO;
+    mask[1] = synchronizeRotation_ == ReplicatedRotationMode::XYZ && server_.angularVelocity_ != Vector3::ZERO;
+    dest.WriteVLE(mask.to_uint32());
+
     if (synchronizePosition_)
     {
-        dest.WriteVector3(server_.position_);
-        dest.WriteVector3(server_.velocity_);
+        WriteVector(dest, server_.position_);
+        if (mask[0])
+            WriteVector(dest, server_.velocity_);
     }
 
     if (synchronizeRotation_ == ReplicatedRotationMode::XYZ)
     {
-        dest.WriteQuaternion(server_.rotation_);
-        dest.WriteVector3(server_.angularVelocity_);
+        if (quantizeRotation_)
+            dest.WriteUInt(PackQuaternion(server_.rotation_));
+        else
+            dest.WriteQuaternion(server_.rotation_);
+
+        if (mask[1])
+            WriteVector(dest, server_.angularVelocity_);
     }
 }
 
 void ReplicatedTransform::ReadUnreliableDelta(NetworkFrame frame, Deserializer& src)
 {
+    const ea::bitset<32> mask = src.ReadVLE();
+
     if (synchronizePosition_)
     {
-        const Vector3 position = src.ReadVector3();
-        const Vector3 velocity = src.ReadVector3();
+        const Vector3 position = ReadVector(src);
+        const Vector3 velocity = mask[0] ? ReadVector(src) : Vector3::ZERO;
 
         positionTrace_.Set(frame, {position, velocity});
     }
 
     if (synchronizeRotation_ == ReplicatedRotationMode::XYZ)
     {
-        const Quaternion rotation = src.ReadQuaternion();
-        const Vector3 angularVelocity = src.ReadVector3();
+        const Quaternion rotation = quantizeRotation_ ? UnpackQuaternion(src.ReadUInt()) : src.ReadQuaternion();
+        const Vector3 angularVelocity = mask[1] ? ReadVector(src) : Vector3::ZERO;
 
         rotationTrace_.Set(frame, {rotation, angularVelocity});
     }
 }
 
+void ReplicatedTransform::WriteVector(Serializer& dest, const Vector3& value) const
+{
+    if (positionPrecision_ > 0.0f)
+        WriteQuantizedVector3(dest, value, positionPrecision_);
+    else
+        dest.WriteVector3(value);
+}
+
+Vector3 ReplicatedTransform::ReadVector(Deserializer& src) const
+{
+    return positionPrecision_ > 0.0f ? ReadQuantizedVector3(src, positionPrecision_) : src.ReadVector3();
+}
+
 PositionAndVelocity ReplicatedTransform::SampleTemporalPosition(const NetworkTime& time) const
 {
     return positionTrace_.SampleValid(time);
@@ -59,6 +59,8 @@ public:
     static constexpr ReplicatedRotationMode DefaultSynchronizeRotation = ReplicatedRotationMode::XYZ;
     static constexpr bool DefaultExtrapolatePosition = true;
     static constexpr bool DefaultExtrapolateRotation = false;
+    static constexpr float DefaultPositionPrecision = 0.0f;
+    static constexpr bool DefaultQuantizeRotation = false;
 
     static constexpr NetworkCallbackFlags CallbackMask =
         NetworkCallbackMask::UpdateTransformOnServer | NetworkCallbackMask::UnreliableDelta | NetworkCallbackMask::InterpolateState;
@@ -91,6 +93,12 @@ public:
     bool GetExtrapolatePosition() const { return extrapolatePosition_; }
     void SetExtrapolateRotation(bool value) { extrapolateRotation_ = value; }
     bool GetExtrapolateRotation() const { return extrapolateRotation_; }
+    /// Set precision of replicated position and velocity. Zero precision means that full floats are sent.
+    void SetPositionPrecision(float value) { positionPrecision_ = ea::max(0.0f, value); }
+    float GetPositionPrecision() const { return positionPrecision_; }
+    /// Set whether to pack replicated rotation into 32 bits.
+    void SetQuantizeRotation(bool value) { quantizeRotation_ = value; }
+    bool GetQuantizeRotation() const { return quantizeRotation_; }
 
     /// Implement NetworkBehavior.
     /// @{
@@ -118,6 +126,9 @@ public:
 private:
     void InitializeCommon();
     void OnServerFrameEnd(NetworkFrame frame);
+    /// Write and read position, velocity or angular velocity according to position precision.
+    void WriteVector(Serializer& dest, const Vector3& value) const;
+    Vector3 ReadVector(Deserializer& src) const;
 
     /// Attributes independent on the client and the server.
     /// @{
@@ -136,6 +147,8 @@ private:
     ReplicatedRotationMode synchronizeRotation_{DefaultSynchronizeRotation};
     bool extrapolatePosition_{DefaultExtrapolatePosition};
     bool extrapolateRotation_{DefaultExtrapolateRotation};
+    float positionPrecision_{DefaultPositionPrecision};
+    bool quantizeRotation_{DefaultQuantizeRotation};
     /// @}
 
     NetworkValue<PositionAndVelocity> positionTrace_;
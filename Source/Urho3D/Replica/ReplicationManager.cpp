@@ -301,6 +301,7 @@ void ReplicationManager::StartServer()
     mode_ = ReplicationManagerMode::Server;
 
     server_ = MakeShared<ServerReplicator>(GetScene());
+    server_->SetCompressionDictionary(compressionDictionary_);
 
     URHO3D_LOGINFO("Started server for scene replication");
 }
@@ -380,6 +381,15 @@ void ReplicationManager::DropConnection(AbstractConnection* connection)
         StartStandalone();
 }
 
+void ReplicationManager::SetCompressionDictionary(CompressionDictionary* dictionary)
+{
+    compressionDictionary_ = dictionary;
+    if (server_)
+        server_->SetCompressionDictionary(dictionary);
+    if (ClientReplica* replica = GetClientReplica())
+        replica->SetCompressionDictionary(dictionary);
+}
+
 bool ReplicationManager::ProcessMessageOnUninitializedClient(
     AbstractConnection* connection, NetworkMessageId messageId, MemoryBuffer& messageData)
 {
@@ -410,6 +420,7 @@ bool ReplicationManager::ProcessMessageOnUninitializedClient(
     {
         client_->replica_ =
             MakeShared<ClientReplica>(GetScene(), connection, *client_->initialClock_, *client_->serverSettings_);
+        client_->replica_->SetCompressionDictionary(compressionDictionary_);
 
         connection->SendSerializedMessage(
             MSG_SYNCHRONIZED, MsgSynchronized{*client_->ackMagic_}, PacketType::ReliableUnordered);
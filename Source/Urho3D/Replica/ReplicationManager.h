@@ -110,6 +110,10 @@ public:
     bool ProcessMessage(AbstractConnection* connection, NetworkMessageId messageId, MemoryBuffer& messageData);
     /// Process connection dropped. Removes client connection for server, converts scene to standalone for client.
     void DropConnection(AbstractConnection* connection);
+    /// Set dictionary used to compress replicated objects. Server and clients should use the same dictionary.
+    void SetCompressionDictionary(CompressionDictionary* dictionary);
+    /// Return dictionary used to compress replicated objects.
+    CompressionDictionary* GetCompressionDictionary() const { return compressionDictionary_; }
 
     /// Return current state specific to client or server.
     /// @{
@@ -151,6 +155,7 @@ private:
     ReplicationManagerMode mode_{};
     SharedPtr<ServerReplicator> server_;
     ea::optional<ClientData> client_;
+    SharedPtr<CompressionDictionary> compressionDictionary_;
 };
 
 }
@@ -25,7 +25,10 @@
 #include <Urho3D/Core/Context.h>
 #include <Urho3D/Core/CoreEvents.h>
 #include <Urho3D/Core/Exception.h>
+#include <Urho3D/Core/Profiler.h>
 #include <Urho3D/Core/Timer.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/IO/Compression.h>
 #include <Urho3D/IO/Log.h>
 #include <Urho3D/Math/RandomEngine.h>
 #include <Urho3D/Network/Connection.h>
@@ -39,6 +42,7 @@
 #include <Urho3D/Scene/SceneEvents.h>
 
 #include <EASTL/numeric.h>
+#include <EASTL/sort.h>
 
 namespace Urho3D
 {
@@ -46,6 +50,9 @@ namespace Urho3D
 namespace
 {
 
+/// Batches of added objects smaller than this are not compressed.
+static constexpr unsigned CompressAddObjectsThreshold = 256;
+
 unsigned GetIndex(NetworkId networkId)
 {
     return DeconstructComponentReference(networkId).first;
@@ -84,13 +91,16 @@ void SharedReplicationState::OnNetworkObjectRemoved(NetworkObject* networkObject
     }
 }
 
-void SharedReplicationState::PrepareForUpdate()
+void SharedReplicationState::PrepareForUpdate(float interestGridCellSize)
 {
     ResetFrameBuffers();
     InitializeNewObjects();
 
     objectRegistry_->UpdateNetworkObjects();
     objectRegistry_->GetSortedNetworkObjects(sortedNetworkObjects_);
+
+    UpdateObjectStates();
+    UpdateInterestGrid(interestGridCellSize);
 }
 
 void SharedReplicationState::ResetFrameBuffers()
@@ -108,6 +118,10 @@ void SharedReplicationState::ResetFrameBuffers()
     needUnreliableDeltaUpdate_.resize(indexUppedBound);
     unreliableDeltaUpdateData_.resize(indexUppedBound);
 
+    isSnapshotQueued_.clear();
+    isSnapshotQueued_.resize(indexUppedBound);
+    snapshotData_.resize(indexUppedBound);
+
     deltaUpdateBuffer_.Clear();
 }
 
@@ -131,16 +145,65 @@ void SharedReplicationState::InitializeNewObjects()
     recentlyAddedObjects_.clear();
 }
 
+void SharedReplicationState::UpdateObjectStates()
+{
+    const unsigned indexUpperBound = GetIndexUpperBound();
+    objectPositions_.resize(indexUpperBound);
+    objectOwners_.resize(indexUpperBound);
+
+    // This also updates world transforms of all objects in the main thread
+    for (NetworkObject* networkObject : sortedNetworkObjects_)
+    {
+        const unsigned index = GetIndex(networkObject->GetNetworkId());
+        objectPositions_[index] = networkObject->GetNode()->GetWorldPosition();
+        objectOwners_[index] = networkObject->GetOwnerConnection();
+    }
+}
+
+void SharedReplicationState::UpdateInterestGrid(float cellSize)
+{
+    interestGrid_.Reset(cellSize);
+    for (const auto& [connection, ownedObjects] : ownedObjectsByConnection_)
+    {
+        for (NetworkObject* networkObject : ownedObjects)
+        {
+            const unsigned index = GetIndex(networkObject->GetNetworkId());
+            interestGrid_.AddInterestPoint(connection, objectPositions_[index]);
+        }
+    }
+}
+
 void SharedReplicationState::QueueDeltaUpdate(NetworkObject* networkObject)
 {
     const unsigned index = GetIndex(networkObject->GetNetworkId());
     isDeltaUpdateQueued_[index] = true;
 }
 
+void SharedReplicationState::QueueSnapshot(NetworkObject* networkObject)
+{
+    const unsigned index = GetIndex(networkObject->GetNetworkId());
+    isSnapshotQueued_[index] = true;
+}
+
 void SharedReplicationState::CookDeltaUpdates(NetworkFrame currentFrame)
 {
     recentlyRemovedObjects_.clear();
 
+    // Snapshots are written once per frame even if many clients need them, e.g. when they join together
+    for (unsigned i = 0; i < isSnapshotQueued_.size(); ++i)
+    {
+        if (!isSnapshotQueued_[i])
+            continue;
+
+        NetworkObject* networkObject = objectRegistry_->GetNetworkObjectByIndex(i);
+        URHO3D_ASSERT(networkObject);
+
+        const unsigned beginOffset = deltaUpdateBuffer_.Tell();
+        networkObject->WriteSnapshot(currentFrame, deltaUpdateBuffer_);
+        const unsigned endOffset = deltaUpdateBuffer_.Tell();
+        snapshotData_[i] = {beginOffset, endOffset};
+    }
+
     for (unsigned i = 0; i < isDeltaUpdateQueued_.size(); ++i)
     {
         if (!isDeltaUpdateQueued_[i])
@@ -198,6 +261,13 @@ ea::optional<ConstByteSpan> SharedReplicationState::GetUnreliableUpdateByIndex(u
     return GetSpanData(unreliableDeltaUpdateData_[index]);
 }
 
+ea::optional<ConstByteSpan> SharedReplicationState::GetSnapshotByIndex(unsigned index) const
+{
+    if (!isSnapshotQueued_[index])
+        return ea::nullopt;
+    return GetSpanData(snapshotData_[index]);
+}
+
 ConstByteSpan SharedReplicationState::GetSpanData(const DeltaBufferSpan& span) const
 {
     const auto data = deltaUpdateBuffer_.GetData();
@@ -213,6 +283,7 @@ ClientSynchronizationState::ClientSynchronizationState(
     , inputDelayFilter_(GetSetting(NetworkSettings::InputDelayFilterBufferSize).GetUInt())
     , inputStats_(GetSetting(NetworkSettings::InputBufferingWindowSize).GetUInt(), InputStatsSafetyLimit)
     , inputBufferFilter_(GetSetting(NetworkSettings::InputBufferingFilterBufferSize).GetUInt())
+    , magic_(MakeMagic())
 {
     SetNetworkSetting(settings_, NetworkSettings::ConnectionId, connection_->GetObjectID());
 }
@@ -235,9 +306,16 @@ void ClientSynchronizationState::SendMessages()
     // Send configuration on startup once
     if (!synchronizationMagic_)
     {
-        const unsigned magic = MakeMagic();
-        connection_->SendSerializedMessage(MSG_CONFIGURE, MsgConfigure{magic, settings_}, PacketType::ReliableUnordered);
-        synchronizationMagic_ = magic;
+        const MsgConfigure msg{magic_, settings_};
+        QueueGeneratedMessage(MSG_CONFIGURE, PacketType::ReliableUnordered,
+            [&](VectorBuffer& buffer, ea::string* debugInfo)
+        {
+            msg.Save(buffer);
+            if (debugInfo)
+                *debugInfo = msg.ToString();
+            return true;
+        });
+        synchronizationMagic_ = magic_;
     }
 
     // Send clock updates
@@ -250,10 +328,31 @@ void ClientSynchronizationState::SendMessages()
         UpdateInputBuffer();
 
         const MsgSceneClock msg{frame_, frameLocalTime_, inputDelay_ + inputBufferSize_};
-        connection_->SendSerializedMessage(MSG_SCENE_CLOCK, msg, PacketType::UnreliableUnordered);
+        QueueGeneratedMessage(MSG_SCENE_CLOCK, PacketType::UnreliableUnordered,
+            [&](VectorBuffer& buffer, ea::string* debugInfo)
+        {
+            msg.Save(buffer);
+            if (debugInfo)
+                *debugInfo = msg.ToString();
+            return true;
+        });
     }
 }
 
+void ClientSynchronizationState::FlushMessages()
+{
+    const unsigned char* data = queuedMessagesData_.GetData();
+    for (const QueuedMessage& msg : queuedMessages_)
+    {
+        const unsigned size = msg.endOffset_ - msg.beginOffset_;
+        connection_->SendLoggedMessage(
+            msg.messageId_, size ? data + msg.beginOffset_ : nullptr, size, msg.messageType_, msg.debugInfo_);
+    }
+
+    queuedMessages_.clear();
+    queuedMessagesData_.Clear();
+}
+
 void ClientSynchronizationState::UpdateInputDelay()
 {
     const unsigned latestPingTimestamp = connection_->GetLocalTimeOfLatestRoundtrip();
@@ -330,7 +429,7 @@ void ClientReplicationState::SendMessages(NetworkFrame currentFrame, const Share
     if (IsSynchronized())
     {
         SendRemoveObjects();
-        SendAddObjects();
+        SendAddObjects(sharedState);
         SendUpdateObjectsReliable(sharedState);
         SendUpdateObjectsUnreliable(currentFrame, sharedState);
     }
@@ -392,7 +491,7 @@ void ClientReplicationState::ProcessObjectsFeedbackUnreliable(MemoryBuffer& mess
 
 void ClientReplicationState::SendRemoveObjects()
 {
-    connection_->SendGeneratedMessage(MSG_REMOVE_OBJECTS, PacketType::ReliableOrdered,
+    QueueGeneratedMessage(MSG_REMOVE_OBJECTS, PacketType::ReliableOrdered,
         [&](VectorBuffer& msg, ea::string* debugInfo)
     {
         if (debugInfo)
@@ -414,27 +513,27 @@ void ClientReplicationState::SendRemoveObjects()
     });
 }
 
-void ClientReplicationState::SendAddObjects()
+void ClientReplicationState::SendAddObjects(const SharedReplicationState& sharedState)
 {
-    connection_->SendGeneratedMessage(MSG_ADD_OBJECTS, PacketType::ReliableOrdered,
+    QueueGeneratedMessage(MSG_ADD_OBJECTS, PacketType::ReliableOrdered,
         [&](VectorBuffer& msg, ea::string* debugInfo)
     {
         msg.WriteInt64(static_cast<long long>(GetCurrentFrame()));
 
-        bool sendMessage = false;
+        componentBuffer_.Clear();
         for (const auto& [networkObject, isSnapshot] : pendingUpdatedObjects_)
         {
             if (!isSnapshot)
                 continue;
 
-            sendMessage = true;
-            msg.WriteUInt(static_cast<unsigned>(networkObject->GetNetworkId()));
-            msg.WriteStringHash(networkObject->GetType());
-            msg.WriteVLE(networkObject->GetOwnerConnectionId());
+            const auto snapshot = sharedState.GetSnapshotByIndex(GetIndex(networkObject->GetNetworkId()));
+            URHO3D_ASSERT(snapshot);
 
-            componentBuffer_.Clear();
-            networkObject->WriteSnapshot(GetCurrentFrame(), componentBuffer_);
-            msg.WriteBuffer(componentBuffer_.GetBuffer());
+            componentBuffer_.WriteUInt(static_cast<unsigned>(networkObject->GetNetworkId()));
+            componentBuffer_.WriteStringHash(networkObject->GetType());
+            componentBuffer_.WriteVLE(networkObject->GetOwnerConnectionId());
+            componentBuffer_.WriteVLE(snapshot->size());
+            componentBuffer_.Write(snapshot->data(), snapshot->size());
 
             if (debugInfo)
             {
@@ -443,13 +542,40 @@ void ClientReplicationState::SendAddObjects()
                 debugInfo->append(ToString(networkObject->GetNetworkId()));
             }
         }
-        return sendMessage;
+
+        const unsigned dataSize = componentBuffer_.GetSize();
+        if (dataSize == 0)
+            return false;
+
+        // Objects of the same prefab have mostly identical snapshots and are compressed well in batches
+        // Shared dictionary helps even for small batches
+        CompressionDictionary* dictionary = sharedState.GetCompressionDictionary();
+        if (dataSize >= CompressAddObjectsThreshold || dictionary)
+        {
+            CompressionSettings settings;
+            settings.dictionary_ = dictionary;
+
+            compressedBuffer_.resize(EstimateCompressBound(dataSize, settings.codec_));
+            const unsigned compressedSize = CompressData(
+                compressedBuffer_.data(), compressedBuffer_.size(), componentBuffer_.GetData(), dataSize, settings);
+            if (compressedSize != 0 && compressedSize < dataSize)
+            {
+                msg.WriteVLE(dataSize);
+                msg.WriteUInt(dictionary ? dictionary->GetHash() : 0);
+                msg.Write(compressedBuffer_.data(), compressedSize);
+                return true;
+            }
+        }
+
+        msg.WriteVLE(0);
+        msg.Write(componentBuffer_.GetData(), dataSize);
+        return true;
     });
 }
 
 void ClientReplicationState::SendUpdateObjectsReliable(const SharedReplicationState& sharedState)
 {
-    connection_->SendGeneratedMessage(MSG_UPDATE_OBJECTS_RELIABLE, PacketType::ReliableOrdered,
+    QueueGeneratedMessage(MSG_UPDATE_OBJECTS_RELIABLE, PacketType::ReliableOrdered,
         [&](VectorBuffer& msg, ea::string* debugInfo)
     {
         msg.WriteInt64(static_cast<long long>(GetCurrentFrame()));
@@ -486,38 +612,44 @@ void ClientReplicationState::SendUpdateObjectsReliable(const SharedReplicationSt
 void ClientReplicationState::SendUpdateObjectsUnreliable(
     NetworkFrame currentFrame, const SharedReplicationState& sharedState)
 {
-    connection_->SendGeneratedMessage(MSG_UPDATE_OBJECTS_UNRELIABLE, PacketType::UnreliableUnordered,
-        [&](VectorBuffer& msg, ea::string* debugInfo)
+    unreliableUpdates_.clear();
+    for (const auto& [networkObject, isSnapshot] : pendingUpdatedObjects_)
     {
-        bool sendMessage = false;
+        // Skip redundant updates, both if update is empty or if snapshot was already sent
+        const unsigned index = GetIndex(networkObject->GetNetworkId());
+        if (isSnapshot)
+            continue;
 
-        msg.WriteInt64(static_cast<long long>(GetCurrentFrame()));
+        const auto updateSpan = sharedState.GetUnreliableUpdateByIndex(index);
+        if (!updateSpan)
+            continue;
 
-        for (const auto& [networkObject, isSnapshot] : pendingUpdatedObjects_)
-        {
-            // Skip redundant updates, both if update is empty or if snapshot was already sent
-            const unsigned index = GetIndex(networkObject->GetNetworkId());
-            if (isSnapshot)
-                continue;
+        const NetworkObjectRelevance relevance = objectsRelevance_[index];
+        URHO3D_ASSERT(relevance != NetworkObjectRelevance::Irrelevant);
+        if (relevance == NetworkObjectRelevance::NoUpdates)
+            continue;
 
-            const auto updateSpan = sharedState.GetUnreliableUpdateByIndex(index);
-            if (!updateSpan)
-                continue;
+        if (static_cast<long long>(currentFrame) % static_cast<unsigned>(relevance) != 0)
+            continue;
 
-            const NetworkObjectRelevance relevance = objectsRelevance_[index];
-            URHO3D_ASSERT(relevance != NetworkObjectRelevance::Irrelevant);
-            if (relevance == NetworkObjectRelevance::NoUpdates)
-                continue;
+        unreliableUpdates_.push_back(UnreliableUpdate{networkObject, *updateSpan});
+    }
 
-            if (static_cast<long long>(currentFrame) % static_cast<unsigned>(relevance) != 0)
-                continue;
+    PrioritizeUnreliableUpdates(sharedState);
 
-            sendMessage = true;
+    QueueGeneratedMessage(MSG_UPDATE_OBJECTS_UNRELIABLE, PacketType::UnreliableUnordered,
+        [&](VectorBuffer& msg, ea::string* debugInfo)
+    {
+        msg.WriteInt64(static_cast<long long>(GetCurrentFrame()));
+
+        for (const UnreliableUpdate& update : unreliableUpdates_)
+        {
+            NetworkObject* networkObject = update.networkObject_;
             msg.WriteUInt(static_cast<unsigned>(networkObject->GetNetworkId()));
             msg.WriteStringHash(networkObject->GetType());
 
-            msg.WriteVLE(updateSpan->size());
-            msg.Write(updateSpan->data(), updateSpan->size());
+            msg.WriteVLE(update.data_.size());
+            msg.Write(update.data_.data(), update.data_.size());
 
             if (debugInfo)
             {
@@ -526,11 +658,62 @@ void ClientReplicationState::SendUpdateObjectsUnreliable(
                 debugInfo->append(ToString(networkObject->GetNetworkId()));
             }
         }
+
+        const bool sendMessage = !unreliableUpdates_.empty();
         return sendMessage;
     });
 }
 
-void ClientReplicationState::UpdateNetworkObjects(SharedReplicationState& sharedState)
+void ClientReplicationState::PrioritizeUnreliableUpdates(const SharedReplicationState& sharedState)
+{
+    numDeferredUpdates_ = 0;
+
+    const unsigned budgetPerSecond = GetSetting(NetworkSettings::UnreliableBandwidthBudget).GetUInt();
+    if (budgetPerSecond == 0)
+        return;
+
+    // Accumulate priority: closer and faster objects gain priority faster, deferred objects keep their priority
+    const float priorityDistance = ea::max(GetSetting(NetworkSettings::UpdatePriorityDistance).GetFloat(), M_EPSILON);
+    const NetworkInterestGrid& interestGrid = sharedState.GetInterestGrid();
+    for (UnreliableUpdate& update : unreliableUpdates_)
+    {
+        const unsigned index = GetIndex(update.networkObject_->GetNetworkId());
+        const Vector3& position = sharedState.GetObjectPositionByIndex(index);
+        const float distance = sharedState.GetObjectOwnerByIndex(index) == connection_
+            ? 0.0f
+            : interestGrid.GetDistanceToConnection(connection_, position, M_LARGE_VALUE);
+        const float speed = (position - objectsLatestSentPosition_[index]).Length() * updateFrequency_;
+
+        objectsPriority_[index] += (1.0f + speed) / (1.0f + distance / priorityDistance);
+        update.priority_ = objectsPriority_[index];
+    }
+
+    ea::sort(unreliableUpdates_.begin(), unreliableUpdates_.end(),
+        [](const UnreliableUpdate& lhs, const UnreliableUpdate& rhs) { return lhs.priority_ > rhs.priority_; });
+
+    // Always send at least one update so the client doesn't starve
+    const unsigned budget = ea::max(1u, budgetPerSecond / updateFrequency_);
+    unsigned bytesUsed = 0;
+    unsigned numUpdates = 0;
+    for (const UnreliableUpdate& update : unreliableUpdates_)
+    {
+        const unsigned updateSize = update.data_.size() + 2 * sizeof(unsigned);
+        if (numUpdates > 0 && bytesUsed + updateSize > budget)
+            break;
+
+        const unsigned index = GetIndex(update.networkObject_->GetNetworkId());
+        objectsPriority_[index] = 0.0f;
+        objectsLatestSentPosition_[index] = sharedState.GetObjectPositionByIndex(index);
+
+        bytesUsed += updateSize;
+        ++numUpdates;
+    }
+
+    numDeferredUpdates_ = unreliableUpdates_.size() - numUpdates;
+    unreliableUpdates_.resize(numUpdates);
+}
+
+void ClientReplicationState::UpdateNetworkObjects(const SharedReplicationState& sharedState)
 {
     if (!IsSynchronized())
         return;
@@ -541,9 +724,12 @@ void ClientReplicationState::UpdateNetworkObjects(SharedReplicationState& shared
     const unsigned indexUpperBound = sharedState.GetIndexUpperBound();
     objectsRelevance_.resize(indexUpperBound, NetworkObjectRelevance::Irrelevant);
     objectsRelevanceTimeouts_.resize(indexUpperBound);
+    objectsPriority_.resize(indexUpperBound);
+    objectsLatestSentPosition_.resize(indexUpperBound);
 
     pendingRemovedObjects_.clear();
     pendingUpdatedObjects_.clear();
+    addedObjects_.clear();
 
     // Process removed components first
     for (NetworkId networkId : sharedState.GetRecentlyRemovedObjects())
@@ -575,7 +761,9 @@ void ClientReplicationState::UpdateNetworkObjects(SharedReplicationState& shared
             if (objectsRelevance_[index] != NetworkObjectRelevance::Irrelevant)
             {
                 objectsRelevanceTimeouts_[index] = relevanceTimeout;
-                pendingUpdatedObjects_.push_back({networkObject, true});
+                objectsPriority_[index] = 0.0f;
+                objectsLatestSentPosition_[index] = sharedState.GetObjectPositionByIndex(index);
+                addedObjects_.push_back(AddedObject{networkObject});
             }
         }
         else if (wasRelevant)
@@ -598,11 +786,72 @@ void ClientReplicationState::UpdateNetworkObjects(SharedReplicationState& shared
                 objectsRelevanceTimeouts_[index] = relevanceTimeout;
             }
 
-            // Queue non-snapshot update
-            sharedState.QueueDeltaUpdate(networkObject);
+            // Queue non-snapshot update, delta update is requested from shared state later
             pendingUpdatedObjects_.push_back({networkObject, false});
         }
     }
+
+    SelectAddedObjects(sharedState);
+}
+
+void ClientReplicationState::SelectAddedObjects(const SharedReplicationState& sharedState)
+{
+    numDeferredAddedObjects_ = 0;
+
+    const unsigned maxAddedObjects = GetSetting(NetworkSettings::MaxAddedObjectsPerFrame).GetUInt();
+    if (maxAddedObjects == 0 || addedObjects_.size() <= maxAddedObjects)
+    {
+        for (AddedObject& addedObject : addedObjects_)
+            addedObject.accepted_ = true;
+    }
+    else
+    {
+        // Stream objects closest to the objects owned by the client first
+        const NetworkInterestGrid& interestGrid = sharedState.GetInterestGrid();
+        addedObjectsOrder_.clear();
+        for (unsigned i = 0; i < addedObjects_.size(); ++i)
+        {
+            AddedObject& addedObject = addedObjects_[i];
+            const unsigned index = GetIndex(addedObject.networkObject_->GetNetworkId());
+            const Vector3& position = sharedState.GetObjectPositionByIndex(index);
+            addedObject.distance_ = interestGrid.GetDistanceToConnection(connection_, position, M_LARGE_VALUE);
+            addedObjectsOrder_.push_back(i);
+        }
+
+        ea::stable_sort(addedObjectsOrder_.begin(), addedObjectsOrder_.end(),
+            [&](unsigned lhs, unsigned rhs) { return addedObjects_[lhs].distance_ < addedObjects_[rhs].distance_; });
+        for (unsigned i = 0; i < maxAddedObjects; ++i)
+            addedObjects_[addedObjectsOrder_[i]].accepted_ = true;
+    }
+
+    // Objects are sorted so that parents go first. Children of deferred parents are deferred too.
+    for (const AddedObject& addedObject : addedObjects_)
+    {
+        NetworkObject* networkObject = addedObject.networkObject_;
+        const NetworkId parentNetworkId = networkObject->GetParentNetworkId();
+        const bool isParentDeferred = parentNetworkId != NetworkId::None
+            && objectsRelevance_[GetIndex(parentNetworkId)] == NetworkObjectRelevance::Irrelevant;
+
+        if (!addedObject.accepted_ || isParentDeferred)
+        {
+            objectsRelevance_[GetIndex(networkObject->GetNetworkId())] = NetworkObjectRelevance::Irrelevant;
+            ++numDeferredAddedObjects_;
+            continue;
+        }
+
+        pendingUpdatedObjects_.push_back({networkObject, true});
+    }
+}
+
+void ClientReplicationState::QueueDeltaUpdates(SharedReplicationState& sharedState) const
+{
+    for (const auto& [networkObject, isSnapshot] : pendingUpdatedObjects_)
+    {
+        if (isSnapshot)
+            sharedState.QueueSnapshot(networkObject);
+        else
+            sharedState.QueueDeltaUpdate(networkObject);
+    }
 }
 
 ServerReplicator::ServerReplicator(Scene* scene)
@@ -663,20 +912,74 @@ void ServerReplicator::OnInputReady(float timeStep, bool isUpdateNow, float over
     }
 }
 
+template <class T> void ServerReplicator::ForEachClient(const T& callback)
+{
+    const bool isParallel = GetSetting(NetworkSettings::ParallelClientUpdates).GetBool();
+    auto workQueue = GetSubsystem<WorkQueue>();
+    if (!isParallel || !workQueue)
+    {
+        for (ClientReplicationState* clientState : clientStates_)
+            callback(clientState);
+        return;
+    }
+
+    ForEachParallel(workQueue, clientStates_,
+        [&](unsigned /*index*/, ClientReplicationState* clientState) { callback(clientState); });
+}
+
 void ServerReplicator::OnNetworkUpdate()
 {
+    URHO3D_PROFILE("ServerNetworkUpdate");
+
     using namespace EndServerNetworkFrame;
     auto& eventData = network_->GetEventDataMap();
     eventData[P_FRAME] = static_cast<long long>(currentFrame_);
     network_->SendEvent(E_ENDSERVERNETWORKFRAME, eventData);
 
-    sharedState_->PrepareForUpdate();
-    for (auto& [connection, clientState] : connections_)
-        clientState->UpdateNetworkObjects(*sharedState_);
-    sharedState_->CookDeltaUpdates(currentFrame_);
+    {
+        URHO3D_PROFILE("PrepareReplication");
+
+        sharedState_->PrepareForUpdate(GetSetting(NetworkSettings::InterestGridCellSize).GetFloat());
+        if (GetSetting(NetworkSettings::EnableHitHistory).GetBool())
+            RecordHitHistory();
+
+        clientStates_.clear();
+        for (auto& [connection, clientState] : connections_)
+            clientStates_.push_back(clientState);
+    }
+
+    // World transforms are already updated by the shared state, so they are not lazily updated from multiple threads
+    {
+        URHO3D_PROFILE("UpdateClientObjects");
+        ForEachClient([&](ClientReplicationState* clientState) { clientState->UpdateNetworkObjects(*sharedState_); });
+    }
+
+    {
+        URHO3D_PROFILE("CookDeltaUpdates");
+        for (ClientReplicationState* clientState : clientStates_)
+            clientState->QueueDeltaUpdates(*sharedState_);
+        sharedState_->CookDeltaUpdates(currentFrame_);
+    }
+
+    {
+        URHO3D_PROFILE("SendClientMessages");
+        ForEachClient(
+            [&](ClientReplicationState* clientState) { clientState->SendMessages(currentFrame_, *sharedState_); });
+
+        for (ClientReplicationState* clientState : clientStates_)
+            clientState->FlushMessages();
+    }
+}
+
+void ServerReplicator::RecordHitHistory()
+{
+    const float duration = GetSetting(NetworkSettings::ServerTracingDuration).GetFloat();
+    const unsigned numFrames = ea::max(1, CeilToInt(duration * updateFrequency_));
+    const float cellSize = GetSetting(NetworkSettings::HitHistoryCellSize).GetFloat();
+    if (hitHistory_.GetCapacity() != numFrames || hitHistory_.GetCellSize() != cellSize)
+        hitHistory_.Reset(numFrames, cellSize);
 
-    for (auto& [connection, clientState] : connections_)
-        clientState->SendMessages(currentFrame_, *sharedState_);
+    hitHistory_.RecordFrame(currentFrame_, sharedState_->GetSortedObjects());
 }
 
 void ServerReplicator::AddConnection(AbstractConnection* connection)
@@ -740,6 +1043,11 @@ void ServerReplicator::SetCurrentFrame(NetworkFrame frame)
     currentFrame_ = frame;
 }
 
+void ServerReplicator::SetSetting(const NetworkSetting& setting, const Variant& value)
+{
+    SetNetworkSetting(settings_, setting, value);
+}
+
 ClientReplicationState* ServerReplicator::GetClientState(AbstractConnection* connection) const
 {
     auto iter = connections_.find(connection);
@@ -755,9 +1063,10 @@ ea::string ServerReplicator::GetDebugInfo() const
 
     for (const auto& [connection, clientState] : connections_)
     {
-        result += Format("Connection {}: Ping {}ms, InDelay {}+{} frames, InLoss {}%\n", connection->ToString(),
-            connection->GetPing(), clientState->GetInputDelay(), clientState->GetInputBufferSize(),
-            CeilToInt(clientState->GetReportedInputLoss() * 100.0f));
+        result += Format("Connection {}: Ping {}ms, InDelay {}+{} frames, InLoss {}%, Deferred {}+{}\n",
+            connection->ToString(), connection->GetPing(), clientState->GetInputDelay(),
+            clientState->GetInputBufferSize(), CeilToInt(clientState->GetReportedInputLoss() * 100.0f),
+            clientState->GetNumDeferredUpdates(), clientState->GetNumDeferredAddedObjects());
     }
 
     return result;
@@ -774,6 +1083,18 @@ unsigned ServerReplicator::GetFeedbackDelay(AbstractConnection* connection) cons
     return iter != connections_.end() ? iter->second->GetInputDelay() + iter->second->GetInputBufferSize() : 0;
 }
 
+unsigned ServerReplicator::GetNumDeferredUpdates(AbstractConnection* connection) const
+{
+    const ClientReplicationState* clientState = GetClientState(connection);
+    return clientState ? clientState->GetNumDeferredUpdates() : 0;
+}
+
+unsigned ServerReplicator::GetNumDeferredAddedObjects(AbstractConnection* connection) const
+{
+    const ClientReplicationState* clientState = GetClientState(connection);
+    return clientState ? clientState->GetNumDeferredAddedObjects() : 0;
+}
+
 const ea::unordered_set<NetworkObject*>& ServerReplicator::GetNetworkObjectsOwnedByConnection(
     AbstractConnection* connection) const
 {
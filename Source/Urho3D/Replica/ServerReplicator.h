@@ -26,10 +26,14 @@
 
 #include "../Container/IndexAllocator.h"
 #include "../Core/Timer.h"
+#include "../IO/Compression.h"
 #include "../IO/MemoryBuffer.h"
 #include "../IO/VectorBuffer.h"
 #include "../Network/ClockSynchronizer.h"
+#include "../Network/PacketTypeFlags.h"
 #include "../Replica/ClientInputStatistics.h"
+#include "../Replica/NetworkHitHistory.h"
+#include "../Replica/NetworkInterestGrid.h"
 #include "../Replica/NetworkId.h"
 #include "../Replica/TickSynchronizer.h"
 #include "../Replica/ProtocolMessages.h"
@@ -56,11 +60,15 @@ public:
     explicit SharedReplicationState(NetworkObjectRegistry* objectRegistry);
 
     /// Initial preparation for network update.
-    void PrepareForUpdate();
+    void PrepareForUpdate(float interestGridCellSize);
     /// Request delta update to be prepared for specified object.
     void QueueDeltaUpdate(NetworkObject* networkObject);
-    /// Cook all requested delta updates.
+    /// Request snapshot to be prepared for specified object. Snapshot is shared by all clients.
+    void QueueSnapshot(NetworkObject* networkObject);
+    /// Cook all requested delta updates and snapshots.
     void CookDeltaUpdates(NetworkFrame currentFrame);
+    /// Set dictionary used to compress batches of snapshots.
+    void SetCompressionDictionary(CompressionDictionary* dictionary) { compressionDictionary_ = dictionary; }
 
     /// Return state of the current frame.
     /// @{
@@ -68,8 +76,13 @@ public:
     const ea::vector<NetworkObject*>& GetSortedObjects() const { return sortedNetworkObjects_; }
     unsigned GetIndexUpperBound() const;
     const ea::unordered_set<NetworkObject*>& GetOwnedObjectsByConnection(AbstractConnection* connection) const;
+    const NetworkInterestGrid& GetInterestGrid() const { return interestGrid_; }
+    const Vector3& GetObjectPositionByIndex(unsigned index) const { return objectPositions_[index]; }
+    AbstractConnection* GetObjectOwnerByIndex(unsigned index) const { return objectOwners_[index]; }
     ea::optional<ConstByteSpan> GetReliableUpdateByIndex(unsigned index) const;
     ea::optional<ConstByteSpan> GetUnreliableUpdateByIndex(unsigned index) const;
+    ea::optional<ConstByteSpan> GetSnapshotByIndex(unsigned index) const;
+    CompressionDictionary* GetCompressionDictionary() const { return compressionDictionary_; }
     /// @}
 
 private:
@@ -85,6 +98,8 @@ private:
 
     void ResetFrameBuffers();
     void InitializeNewObjects();
+    void UpdateObjectStates();
+    void UpdateInterestGrid(float cellSize);
 
     ConstByteSpan GetSpanData(const DeltaBufferSpan& span) const;
 
@@ -95,15 +110,26 @@ private:
 
     ea::vector<NetworkObject*> sortedNetworkObjects_;
 
+    /// Replication-relevant state of objects gathered once per frame, indexed by network index.
+    /// Clients read it in hot loops instead of chasing pointers to nodes.
+    /// @{
+    ea::vector<Vector3> objectPositions_;
+    ea::vector<AbstractConnection*> objectOwners_;
+    /// @}
+
     ea::vector<bool> isDeltaUpdateQueued_;
     ea::vector<bool> needReliableDeltaUpdate_;
     ea::vector<bool> needUnreliableDeltaUpdate_;
+    ea::vector<bool> isSnapshotQueued_;
 
     VectorBuffer deltaUpdateBuffer_;
     ea::vector<DeltaBufferSpan> reliableDeltaUpdateData_;
     ea::vector<DeltaBufferSpan> unreliableDeltaUpdateData_;
+    ea::vector<DeltaBufferSpan> snapshotData_;
 
     ea::unordered_map<AbstractConnection*, ea::unordered_set<NetworkObject*>> ownedObjectsByConnection_;
+    NetworkInterestGrid interestGrid_;
+    SharedPtr<CompressionDictionary> compressionDictionary_;
 };
 
 /// Clock synchronization state specific to individual client connection.
@@ -125,7 +151,37 @@ public:
     unsigned GetInputBufferSize() const { return inputBufferSize_; };
     /// @}
 
+    /// Send messages queued for current frame to connection. Should be called from the main thread.
+    void FlushMessages();
+
 protected:
+    /// Queue message to be sent to connection when messages are flushed. Safe to call from worker thread.
+    /// Signature of generator is the same as for AbstractConnection::SendGeneratedMessage.
+    template <class T>
+    void QueueGeneratedMessage(NetworkMessageId messageId, PacketTypeFlags messageType, T generator)
+    {
+    #ifdef URHO3D_LOGGING
+        ea::string debugInfo;
+        ea::string* debugInfoPtr = &debugInfo;
+    #else
+        ea::string* debugInfoPtr = nullptr;
+    #endif
+
+        messageBuffer_.Clear();
+        if (generator(messageBuffer_, debugInfoPtr))
+        {
+            QueuedMessage& queuedMessage = queuedMessages_.emplace_back();
+            queuedMessage.messageId_ = messageId;
+            queuedMessage.messageType_ = messageType;
+            queuedMessage.beginOffset_ = queuedMessagesData_.GetSize();
+            queuedMessagesData_.Write(messageBuffer_.GetData(), messageBuffer_.GetSize());
+            queuedMessage.endOffset_ = queuedMessagesData_.GetSize();
+        #ifdef URHO3D_LOGGING
+            queuedMessage.debugInfo_ = ea::move(debugInfo);
+        #endif
+        }
+    }
+
     /// Send messages to connection for current frame.
     void SendMessages();
     /// Process messages for this client.
@@ -146,6 +202,22 @@ private:
 
     static constexpr unsigned InputStatsSafetyLimit = 64;
 
+    /// Message queued for sending to connection.
+    struct QueuedMessage
+    {
+        NetworkMessageId messageId_{};
+        PacketTypeFlags messageType_{};
+        unsigned beginOffset_{};
+        unsigned endOffset_{};
+        ea::string debugInfo_;
+    };
+
+    VectorBuffer messageBuffer_;
+    VectorBuffer queuedMessagesData_;
+    ea::vector<QueuedMessage> queuedMessages_;
+
+    /// Magic is generated on construction because random engine is not thread-safe.
+    const unsigned magic_{};
     ea::optional<unsigned> synchronizationMagic_;
     bool synchronized_{};
 
@@ -171,11 +243,14 @@ public:
         NetworkObjectRegistry* objectRegistry, AbstractConnection* connection, const VariantMap& settings);
 
     /// Perform network update from the perspective of this client connection.
-    void UpdateNetworkObjects(SharedReplicationState& sharedState);
+    /// Doesn't modify shared state, so different clients can be updated in parallel.
+    void UpdateNetworkObjects(const SharedReplicationState& sharedState);
+    /// Queue delta updates and snapshots for objects updated by this client. Should be called from the main thread.
+    void QueueDeltaUpdates(SharedReplicationState& sharedState) const;
 
     /// Process messages for this client.
     bool ProcessMessage(NetworkMessageId messageId, MemoryBuffer& messageData);
-    /// Send messages to connection for current frame.
+    /// Queue messages to connection for current frame. Messages are sent on FlushMessages.
     void SendMessages(NetworkFrame currentFrame, const SharedReplicationState& sharedState);
 
     /// Manage reported input loss.
@@ -184,20 +259,56 @@ public:
     float GetReportedInputLoss() const { return reportedLoss_;}
     /// @}
 
+    /// Return number of unreliable updates deferred during the last frame due to bandwidth budget.
+    unsigned GetNumDeferredUpdates() const { return numDeferredUpdates_; }
+    /// Return number of new objects deferred during the last frame due to the limit of added objects per frame.
+    unsigned GetNumDeferredAddedObjects() const { return numDeferredAddedObjects_; }
+
 private:
     void ProcessObjectsFeedbackUnreliable(MemoryBuffer& messageData);
     void SendRemoveObjects();
-    void SendAddObjects();
+    void SendAddObjects(const SharedReplicationState& sharedState);
     void SendUpdateObjectsReliable(const SharedReplicationState& sharedState);
     void SendUpdateObjectsUnreliable(NetworkFrame currentFrame, const SharedReplicationState& sharedState);
+    void PrioritizeUnreliableUpdates(const SharedReplicationState& sharedState);
+    void SelectAddedObjects(const SharedReplicationState& sharedState);
 
     ea::vector<NetworkObjectRelevance> objectsRelevance_;
     ea::vector<float> objectsRelevanceTimeouts_;
 
+    /// Unreliable update ready to be sent this frame.
+    struct UnreliableUpdate
+    {
+        NetworkObject* networkObject_{};
+        ConstByteSpan data_;
+        float priority_{};
+    };
+
+    /// Accumulated priorities of unreliable updates, reset when update is sent.
+    ea::vector<float> objectsPriority_;
+    /// Positions of objects when the latest unreliable update was sent, used to estimate velocity.
+    ea::vector<Vector3> objectsLatestSentPosition_;
+    ea::vector<UnreliableUpdate> unreliableUpdates_;
+    unsigned numDeferredUpdates_{};
+
+    /// Object that became relevant this frame.
+    struct AddedObject
+    {
+        NetworkObject* networkObject_{};
+        float distance_{};
+        bool accepted_{};
+    };
+
+    /// Objects that became relevant this frame. Closest to the client are added first if there are too many.
+    ea::vector<AddedObject> addedObjects_;
+    ea::vector<unsigned> addedObjectsOrder_;
+    unsigned numDeferredAddedObjects_{};
+
     ea::vector<NetworkId> pendingRemovedObjects_;
     ea::vector<ea::pair<NetworkObject*, bool>> pendingUpdatedObjects_;
 
     VectorBuffer componentBuffer_;
+    ByteVector compressedBuffer_;
 
     float reportedLoss_{};
 };
@@ -218,14 +329,23 @@ public:
     void ReportInputLoss(AbstractConnection* connection, float percentLoss);
 
     void SetCurrentFrame(NetworkFrame frame);
+    /// Set server setting. Settings sent to clients are applied only to connections added later.
+    void SetSetting(const NetworkSetting& setting, const Variant& value);
+    /// Set dictionary used to compress added objects. Clients should use the same dictionary.
+    void SetCompressionDictionary(CompressionDictionary* dictionary) { sharedState_->SetCompressionDictionary(dictionary); }
 
     /// Return current state of the replicator.
     /// @{
     ea::string GetDebugInfo() const;
     const Variant& GetSetting(const NetworkSetting& setting) const;
     unsigned GetFeedbackDelay(AbstractConnection* connection) const;
+    unsigned GetNumDeferredUpdates(AbstractConnection* connection) const;
+    unsigned GetNumDeferredAddedObjects(AbstractConnection* connection) const;
     const ea::unordered_set<NetworkObject*>& GetNetworkObjectsOwnedByConnection(AbstractConnection* connection) const;
     NetworkObject* GetNetworkObjectOwnedByConnection(AbstractConnection* connection) const;
+    const NetworkInterestGrid& GetInterestGrid() const { return sharedState_->GetInterestGrid(); }
+    /// Return history for lag-compensated hit queries. Recorded only if EnableHitHistory setting is set.
+    NetworkHitHistory& GetHitHistory() { return hitHistory_; }
     NetworkTime GetServerTime() const { return NetworkTime{currentFrame_}; }
     unsigned GetUpdateFrequency() const { return updateFrequency_; }
     NetworkFrame GetCurrentFrame() const { return currentFrame_; }
@@ -234,8 +354,11 @@ public:
 private:
     void OnInputReady(float timeStep, bool isUpdateNow, float overtime);
     void OnNetworkUpdate();
+    void RecordHitHistory();
 
     ClientReplicationState* GetClientState(AbstractConnection* connection) const;
+    /// Invoke callback for each client state, in parallel if enabled.
+    template <class T> void ForEachClient(const T& callback);
 
     const WeakPtr<Network> network_;
     const WeakPtr<Scene> scene_;
@@ -250,6 +373,9 @@ private:
 
     SharedPtr<SharedReplicationState> sharedState_;
     ea::unordered_map<AbstractConnection*, SharedPtr<ClientReplicationState>> connections_;
+    ea::vector<ClientReplicationState*> clientStates_;
+
+    NetworkHitHistory hitHistory_;
 };
 
 }
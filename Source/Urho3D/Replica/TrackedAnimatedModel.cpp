@@ -24,9 +24,10 @@
 
 #include "../Core/Context.h"
 #include "../Graphics/AnimatedModel.h"
-#include "../Network/NetworkEvents.h"
 #include "../Replica/TrackedAnimatedModel.h"
+#include "../Replica/TrackedAnimatedModelManager.h"
 #include "../Replica/NetworkSettingsConsts.h"
+#include "../Scene/Scene.h"
 
 namespace Urho3D
 {
@@ -38,6 +39,8 @@ TrackedAnimatedModel::TrackedAnimatedModel(Context* context)
 
 TrackedAnimatedModel::~TrackedAnimatedModel()
 {
+    if (manager_)
+        manager_->RemoveModel(this);
 }
 
 void TrackedAnimatedModel::RegisterObject(Context* context)
@@ -47,6 +50,17 @@ void TrackedAnimatedModel::RegisterObject(Context* context)
     URHO3D_COPY_BASE_ATTRIBUTES(NetworkBehavior);
 
     URHO3D_ATTRIBUTE("Track On Client", bool, trackOnClient_, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Evaluate Bones Only", bool, evaluateBonesOnly_, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Track Hitbox Bones Only", GetTrackHitboxBonesOnly, SetTrackHitboxBonesOnly, bool, false, AM_DEFAULT);
+}
+
+void TrackedAnimatedModel::SetTrackHitboxBonesOnly(bool enable)
+{
+    if (trackHitboxBonesOnly_ != enable)
+    {
+        trackHitboxBonesOnly_ = enable;
+        numSkeletonBones_ = M_MAX_UNSIGNED;
+    }
 }
 
 void TrackedAnimatedModel::InitializeOnServer()
@@ -60,32 +74,84 @@ void TrackedAnimatedModel::InitializeOnServer()
     transformTrace_.Resize(traceDuration);
     boundingBoxTrace_.Resize(traceDuration);
 
-    SubscribeToEvent(E_ENDSERVERNETWORKFRAME,
-        [this](VariantMap& eventData)
+    if (Scene* scene = GetScene())
     {
-        using namespace BeginServerNetworkFrame;
-        const auto serverFrame = static_cast<NetworkFrame>(eventData[P_FRAME].GetInt64());
-        OnServerFrameEnd(serverFrame);
-    });
+        manager_ = scene->GetOrCreateComponent<TrackedAnimatedModelManager>();
+        manager_->AddModel(this);
+    }
 }
 
-void TrackedAnimatedModel::OnServerFrameEnd(NetworkFrame frame)
+void TrackedAnimatedModel::OnSceneSet(Scene* scene)
 {
-    if (!animatedModel_)
+    if (!scene && manager_)
+    {
+        manager_->RemoveModel(this);
+        manager_ = nullptr;
+    }
+}
+
+void TrackedAnimatedModel::UpdateTrackedBones()
+{
+    Skeleton& skeleton = animatedModel_->GetSkeleton();
+    const unsigned numBones = skeleton.GetNumBones();
+    if (numSkeletonBones_ == numBones)
         return;
 
-    animatedModel_->ApplyAnimation();
+    numSkeletonBones_ = numBones;
+    trackedBones_.clear();
+    boneToTrackedIndex_.assign(numBones, M_MAX_UNSIGNED);
+    for (unsigned i = 0; i < numBones; ++i)
+    {
+        const Bone* bone = skeleton.GetBone(i);
+        if (trackHitboxBonesOnly_ && !(bone->collisionMask_ & (BONECOLLISION_SPHERE | BONECOLLISION_BOX)))
+            continue;
+
+        boneToTrackedIndex_[i] = trackedBones_.size();
+        trackedBones_.push_back(i);
+    }
+
+    const auto replicationManager = GetNetworkObject()->GetReplicationManager();
+    const unsigned traceDuration = replicationManager->GetTraceDurationInFrames();
+    bonePositionsTrace_.Resize(trackedBones_.size(), traceDuration);
+    boneRotationsTrace_.Resize(trackedBones_.size(), traceDuration);
+}
+
+bool TrackedAnimatedModel::PrepareServerFrame()
+{
+    if (!animatedModel_)
+        return false;
+
+    UpdateTrackedBones();
 
+    if (!evaluateBonesOnly_)
+    {
+        animatedModel_->ApplyAnimation();
+        return true;
+    }
+
+    // World transforms are evaluated lazily, make sure they are not evaluated from worker threads
+    node_->GetWorldTransform();
+    animatedModel_->GetWorldBoundingBox();
+    const auto& bones = animatedModel_->GetSkeleton().GetBones();
+    for (unsigned i = 0; i < bones.size(); ++i)
+    {
+        Node* boneNode = bones[i].node_;
+        if (bones[i].parentIndex_ == i && boneNode && boneNode->GetParent())
+            boneNode->GetParent()->GetWorldTransform();
+    }
+    return true;
+}
+
+void TrackedAnimatedModel::TrackServerFrame(NetworkFrame frame)
+{
     const auto& bones = animatedModel_->GetSkeleton().GetBones();
     const unsigned numBones = bones.size();
 
-    if (bonePositionsTrace_.Size() != numBones)
+    if (evaluateBonesOnly_)
     {
-        const auto replicationManager = GetNetworkObject()->GetReplicationManager();
-        const unsigned traceDuration = replicationManager->GetTraceDurationInFrames();
-
-        bonePositionsTrace_.Resize(numBones, traceDuration);
-        boneRotationsTrace_.Resize(numBones, traceDuration);
+        evaluatedPositions_.resize(numBones);
+        evaluatedRotations_.resize(numBones);
+        animatedModel_->EvaluateBoneWorldTransforms(evaluatedPositions_, evaluatedRotations_);
     }
 
     transformTrace_.Set(frame, node_->GetWorldTransform());
@@ -94,9 +160,16 @@ void TrackedAnimatedModel::OnServerFrameEnd(NetworkFrame frame)
     const auto positions = bonePositionsTrace_.SetUninitialized(frame);
     const auto rotations = boneRotationsTrace_.SetUninitialized(frame);
 
-    for (unsigned i = 0; i < numBones; ++i)
+    const unsigned numTrackedBones = trackedBones_.size();
+    for (unsigned i = 0; i < numTrackedBones; ++i)
     {
-        if (Node* node = bones[i].node_)
+        const unsigned boneIndex = trackedBones_[i];
+        if (evaluateBonesOnly_)
+        {
+            positions[i] = evaluatedPositions_[boneIndex];
+            rotations[i] = evaluatedRotations_[boneIndex];
+        }
+        else if (Node* node = bones[boneIndex].node_)
         {
             positions[i] = node->GetWorldPosition();
             rotations[i] = node->GetWorldRotation();
@@ -111,14 +184,16 @@ void TrackedAnimatedModel::OnServerFrameEnd(NetworkFrame frame)
 
 Vector3 TrackedAnimatedModel::SampleTemporalBonePosition(const NetworkTime& time, unsigned index) const
 {
+    const unsigned trackedIndex = index < boneToTrackedIndex_.size() ? boneToTrackedIndex_[index] : M_MAX_UNSIGNED;
     const auto result = bonePositionsTrace_.SampleValid(time);
-    return index < result.Size() ? result[index] : Vector3::ZERO;
+    return trackedIndex < result.Size() ? result[trackedIndex] : Vector3::ZERO;
 }
 
 Quaternion TrackedAnimatedModel::SampleTemporalBoneRotation(const NetworkTime& time, unsigned index) const
 {
+    const unsigned trackedIndex = index < boneToTrackedIndex_.size() ? boneToTrackedIndex_[index] : M_MAX_UNSIGNED;
     const auto result = boneRotationsTrace_.SampleValid(time);
-    return index < result.Size() ? result[index] : Quaternion::IDENTITY;
+    return trackedIndex < result.Size() ? result[trackedIndex] : Quaternion::IDENTITY;
 }
 
 void TrackedAnimatedModel::ProcessTemporalRayQuery(const NetworkTime& time, const RayOctreeQuery& query, ea::vector<RayQueryResult>& results) const
@@ -128,7 +203,9 @@ void TrackedAnimatedModel::ProcessTemporalRayQuery(const NetworkTime& time, cons
 
     const auto& bones = animatedModel_->GetSkeleton().GetBones();
     const unsigned numBones = bones.size();
-    if (numBones != bonePositionsTrace_.Size() || numBones != boneRotationsTrace_.Size())
+    const unsigned numTrackedBones = trackedBones_.size();
+    if (numBones != numSkeletonBones_ || numTrackedBones != bonePositionsTrace_.Size()
+        || numTrackedBones != boneRotationsTrace_.Size())
         return;
 
     const BoundingBox worldBoundingBox = boundingBoxTrace_.GetClosestRaw(time.Frame());
@@ -136,16 +213,17 @@ void TrackedAnimatedModel::ProcessTemporalRayQuery(const NetworkTime& time, cons
     const auto bonePositions = bonePositionsTrace_.SampleValid(time);
     const auto boneRotations = boneRotationsTrace_.SampleValid(time);
 
+    // Bones that are not tracked have no collision shapes and are ignored by the query
     thread_local ea::vector<Matrix3x4> boneTransformsStorage;
     auto& boneTransforms = boneTransformsStorage;
-    auto boneTransforms11 = boneTransformsStorage;
-    boneTransforms.resize(numBones);
-    for (unsigned i = 0; i < numBones; ++i)
+    boneTransforms.assign(numBones, Matrix3x4::IDENTITY);
+    for (unsigned i = 0; i < numTrackedBones; ++i)
     {
+        const unsigned boneIndex = trackedBones_[i];
         const Vector3 position = bonePositions[i];
         const Quaternion rotation = boneRotations[i];
-        const Vector3 scale = bones[i].node_ ? bones[i].node_->GetWorldScale() : Vector3::ONE;
-        boneTransforms[i] = Matrix3x4{position, rotation, scale};
+        const Vector3 scale = bones[boneIndex].node_ ? bones[boneIndex].node_->GetWorldScale() : Vector3::ONE;
+        boneTransforms[boneIndex] = Matrix3x4{position, rotation, scale};
     }
 
     animatedModel_->ProcessCustomRayQuery(query, worldBoundingBox, worldTransform, boneTransforms, results);
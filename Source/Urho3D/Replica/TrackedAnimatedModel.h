@@ -32,9 +32,13 @@ namespace Urho3D
 
 class AnimatedModel;
 class RayOctreeQuery;
+class TrackedAnimatedModelManager;
 struct RayQueryResult;
 
 /// Behavior that tracks bone transforms of AnimatedModel on server. Not implemented on client.
+/// If bones only evaluation is enabled, animations are sampled without updating bone nodes and the model,
+/// and all such models of the scene are processed in parallel.
+/// If hitbox bones tracking is enabled, only bones with collision shapes are stored.
 class URHO3D_API TrackedAnimatedModel : public NetworkBehavior
 {
     URHO3D_OBJECT(TrackedAnimatedModel, NetworkBehavior);
@@ -50,22 +54,57 @@ public:
     void InitializeOnServer() override;
     /// @}
 
-    /// Getters for network properties
+    /// Set whether to evaluate animation of bones without applying it to bone nodes.
+    void SetEvaluateBonesOnly(bool enable) { evaluateBonesOnly_ = enable; }
+    /// Return whether to evaluate animation of bones without applying it to bone nodes.
+    bool GetEvaluateBonesOnly() const { return evaluateBonesOnly_; }
+    /// Set whether to store only bones with collision shapes.
+    void SetTrackHitboxBonesOnly(bool enable);
+    /// Return whether to store only bones with collision shapes.
+    bool GetTrackHitboxBonesOnly() const { return trackHitboxBonesOnly_; }
+    /// Return number of stored bones.
+    unsigned GetNumTrackedBones() const { return trackedBones_.size(); }
+
+    /// Internal. Track bones at the end of the server frame.
+    /// @{
+    bool PrepareServerFrame();
+    void TrackServerFrame(NetworkFrame frame);
+    /// @}
+
+    /// Getters for network properties. Bones are identified by index in Skeleton.
     /// @{
     Vector3 SampleTemporalBonePosition(const NetworkTime& time, unsigned index) const;
     Quaternion SampleTemporalBoneRotation(const NetworkTime& time, unsigned index) const;
     void ProcessTemporalRayQuery(const NetworkTime& time, const RayOctreeQuery& query, ea::vector<RayQueryResult>& results) const;
     /// @}
 
+protected:
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+
 private:
-    void OnServerFrameEnd(NetworkFrame frame);
+    /// Update list of tracked bones if skeleton is changed.
+    void UpdateTrackedBones();
 
     /// Attributes independent on the client and the server.
     /// @{
     bool trackOnClient_{};
+    bool evaluateBonesOnly_{};
+    bool trackHitboxBonesOnly_{};
     /// @}
 
     WeakPtr<AnimatedModel> animatedModel_;
+    WeakPtr<TrackedAnimatedModelManager> manager_;
+
+    /// Indices of tracked bones in Skeleton.
+    ea::vector<unsigned> trackedBones_;
+    /// Index of tracked bone for each bone in Skeleton, M_MAX_UNSIGNED if bone is not tracked.
+    ea::vector<unsigned> boneToTrackedIndex_;
+    /// Number of bones in Skeleton when tracked bones were last updated.
+    unsigned numSkeletonBones_{M_MAX_UNSIGNED};
+    /// World transforms of all bones, used when bones are evaluated without nodes.
+    ea::vector<Vector3> evaluatedPositions_;
+    ea::vector<Quaternion> evaluatedRotations_;
 
     NetworkValue<Matrix3x4> transformTrace_;
     NetworkValue<BoundingBox> boundingBoxTrace_;
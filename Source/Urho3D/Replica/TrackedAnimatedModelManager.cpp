@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Replica/TrackedAnimatedModelManager.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
+#include "../Network/NetworkEvents.h"
+#include "../Replica/TrackedAnimatedModel.h"
+#include "../Scene/Scene.h"
+
+#include <EASTL/algorithm.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+TrackedAnimatedModelManager::TrackedAnimatedModelManager(Context* context)
+    : Component(context)
+{
+    // Manager is recreated by models on server initialization
+    SetTemporary(true);
+}
+
+TrackedAnimatedModelManager::~TrackedAnimatedModelManager() = default;
+
+void TrackedAnimatedModelManager::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<TrackedAnimatedModelManager>(Category_Network);
+}
+
+void TrackedAnimatedModelManager::AddModel(TrackedAnimatedModel* model)
+{
+    if (ea::find(models_.begin(), models_.end(), model) == models_.end())
+        models_.push_back(model);
+}
+
+void TrackedAnimatedModelManager::RemoveModel(TrackedAnimatedModel* model)
+{
+    const auto iter = ea::find(models_.begin(), models_.end(), model);
+    if (iter != models_.end())
+    {
+        *iter = models_.back();
+        models_.pop_back();
+    }
+}
+
+void TrackedAnimatedModelManager::Update(NetworkFrame frame)
+{
+    URHO3D_PROFILE("TrackAnimatedModels");
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+
+    parallelUpdates_.clear();
+    serialUpdates_.clear();
+    for (TrackedAnimatedModel* model : models_)
+    {
+        if (!model->PrepareServerFrame())
+            continue;
+
+        if (workQueue && model->GetEvaluateBonesOnly())
+            parallelUpdates_.push_back(model);
+        else
+            serialUpdates_.push_back(model);
+    }
+
+    if (!parallelUpdates_.empty())
+    {
+        ForEachParallel(workQueue, ParallelUpdateBucketSize, parallelUpdates_,
+            [frame](unsigned /*index*/, TrackedAnimatedModel* model) { model->TrackServerFrame(frame); });
+    }
+    for (TrackedAnimatedModel* model : serialUpdates_)
+        model->TrackServerFrame(frame);
+}
+
+void TrackedAnimatedModelManager::OnSceneSet(Scene* scene)
+{
+    if (scene)
+    {
+        SubscribeToEvent(E_ENDSERVERNETWORKFRAME,
+            [this](VariantMap& eventData)
+        {
+            using namespace EndServerNetworkFrame;
+            Update(static_cast<NetworkFrame>(eventData[P_FRAME].GetInt64()));
+        });
+    }
+    else
+        UnsubscribeFromEvent(E_ENDSERVERNETWORKFRAME);
+}
+
+}
@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/// \file
+
+#pragma once
+
+#include "../Replica/NetworkId.h"
+#include "../Scene/Component.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class TrackedAnimatedModel;
+
+/// Tracks bones of all TrackedAnimatedModel components of the scene at the end of the server network frame.
+/// Models that evaluate bones only are processed in parallel on WorkQueue threads, other models are processed
+/// from the main thread. Created automatically by TrackedAnimatedModel on server.
+class URHO3D_API TrackedAnimatedModelManager : public Component
+{
+    URHO3D_OBJECT(TrackedAnimatedModelManager, Component);
+
+public:
+    /// Number of models processed by thread at once.
+    static constexpr unsigned ParallelUpdateBucketSize = 4;
+
+    /// Construct.
+    explicit TrackedAnimatedModelManager(Context* context);
+    /// Destruct.
+    ~TrackedAnimatedModelManager() override;
+    /// Register object factory.
+    static void RegisterObject(Context* context);
+
+    /// Record bones of all models for given frame. Called automatically at the end of the server network frame.
+    void Update(NetworkFrame frame);
+
+    /// Return number of managed models.
+    unsigned GetNumModels() const { return models_.size(); }
+
+    /// Internal. Manage models.
+    /// @{
+    void AddModel(TrackedAnimatedModel* model);
+    void RemoveModel(TrackedAnimatedModel* model);
+    /// @}
+
+protected:
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+
+private:
+    ea::vector<TrackedAnimatedModel*> models_;
+    /// Models processed on the current frame.
+    ea::vector<TrackedAnimatedModel*> parallelUpdates_;
+    ea::vector<TrackedAnimatedModel*> serialUpdates_;
+};
+
+}
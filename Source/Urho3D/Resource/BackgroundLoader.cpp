@@ -25,104 +25,267 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/ProcessUtils.h"
 #include "../Core/Profiler.h"
+#include "../IO/AsyncFileReader.h"
 #include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
 #include "../Resource/BackgroundLoader.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/ResourceEvents.h"
 
+#include <EASTL/heap.h>
+#include <EASTL/sort.h>
+
 #include "../DebugNew.h"
 
 namespace Urho3D
 {
 
+class BackgroundLoader::LoaderThread : public Thread
+{
+public:
+    LoaderThread(BackgroundLoader* loader, unsigned index)
+        : Thread(Format("BackgroundLoader Thread {}", index))
+        , loader_(loader)
+    {
+    }
+
+    void ThreadFunction() override
+    {
+        URHO3D_PROFILE_THREAD(name_.c_str());
+
+        while (shouldRun_ && loader_->LoadNextResource())
+        {
+        }
+    }
+
+private:
+    BackgroundLoader* loader_{};
+};
+
 BackgroundLoader::BackgroundLoader(ResourceCache* owner) :
-    owner_(owner)
+    owner_(owner),
+    numThreads_(Clamp(GetNumPhysicalCPUs(), 2u, 5u) - 1)
 {
 }
 
 BackgroundLoader::~BackgroundLoader()
 {
+    StopThreads();
+    // Wait for reads in flight
+    asyncFileReader_ = nullptr;
+
     MutexLock lock(backgroundLoadMutex_);
 
     backgroundLoadQueue_.clear();
 }
 
-void BackgroundLoader::ThreadFunction()
+void BackgroundLoader::SetNumThreads(unsigned numThreads)
 {
-    URHO3D_PROFILE_THREAD("BackgroundLoader Thread");
+    numThreads = ea::max(numThreads, 1u);
+    if (numThreads_ == numThreads)
+        return;
 
-    while (shouldRun_)
+    numThreads_ = numThreads;
+    if (!threads_.empty())
     {
-        backgroundLoadMutex_.Acquire();
+        StopThreads();
+        StartThreads();
+    }
+}
 
-        // Search for a queued resource that has not been loaded yet
-        auto i = backgroundLoadQueue_.begin();
-        while (i != backgroundLoadQueue_.end())
-        {
-            if (i->second.resource_->GetAsyncLoadState() == ASYNC_QUEUED)
-                break;
-            else
-                ++i;
-        }
+void BackgroundLoader::StartThreads()
+{
+    if (!threads_.empty())
+        return;
+
+    if (!asyncFileReader_)
+        asyncFileReader_ = MakeShared<AsyncFileReader>();
+
+    for (unsigned i = 0; i < numThreads_; ++i)
+    {
+        threads_.push_back(ea::make_unique<LoaderThread>(this, i));
+        threads_.back()->Run();
+    }
+}
+
+void BackgroundLoader::StopThreads()
+{
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        stopping_ = true;
+    }
+    pendingCondition_.notify_all();
+
+    for (const auto& thread : threads_)
+        thread->Stop();
+    threads_.clear();
+
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    stopping_ = false;
+}
+
+void BackgroundLoader::PushPendingResource(const ResourceKey& key, float priority)
+{
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pendingResources_.push_back(PendingResource{priority, pendingOrder_++, key});
+        ea::push_heap(pendingResources_.begin(), pendingResources_.end());
+    }
+    pendingCondition_.notify_one();
+}
 
-        if (i == backgroundLoadQueue_.end())
+bool BackgroundLoader::LoadNextResource()
+{
+    PendingResource pending;
+    CompletedRead completedRead;
+    {
+        std::unique_lock<std::mutex> lock(pendingMutex_);
+        pendingCondition_.wait(lock,
+            [this] { return stopping_ || !pendingResources_.empty() || !completedReads_.empty(); });
+        if (stopping_)
+            return false;
+
+        // Parse resources that are already read first so the memory is freed sooner
+        if (!completedReads_.empty())
         {
-            // No resources to load found
-            backgroundLoadMutex_.Release();
-            Time::Sleep(5);
+            completedRead = ea::move(completedReads_.front());
+            completedReads_.pop_front();
         }
         else
         {
-            BackgroundLoadItem& item = i->second;
-            Resource* resource = item.resource_;
-            // We can be sure that the item is not removed from the queue as long as it is in the
-            // "queued" or "loading" state
-            backgroundLoadMutex_.Release();
-
-            bool success = false;
-            AbstractFilePtr file = owner_->GetFile(resource->GetName(), item.sendEventOnFailure_);
-            if (file)
-            {
-                resource->SetAsyncLoadState(ASYNC_LOADING);
-                success = resource->BeginLoad(*file);
-            }
+            ea::pop_heap(pendingResources_.begin(), pendingResources_.end());
+            pending = pendingResources_.back();
+            pendingResources_.pop_back();
+        }
+    }
 
-            // Process dependencies now
-            // Need to lock the queue again when manipulating other entries
-            ea::pair<StringHash, StringHash> key = ea::make_pair(resource->GetType(), resource->GetNameHash());
-            backgroundLoadMutex_.Acquire();
-            if (item.dependents_.size())
-            {
-                for (auto i = item.dependents_.begin(); i != item.dependents_.end(); ++i)
-                {
-                    auto j = backgroundLoadQueue_.find(*i);
-                    if (j != backgroundLoadQueue_.end())
-                        j->second.dependencies_.erase(key);
-                }
+    if (completedRead.request_)
+    {
+        LoadReadResource(completedRead.key_, completedRead.request_);
+        return true;
+    }
 
-                item.dependents_.clear();
-            }
+    backgroundLoadMutex_.Acquire();
+
+    // Skip outdated entries, the resource may be already picked with higher priority
+    auto i = backgroundLoadQueue_.find(pending.key_);
+    if (i == backgroundLoadQueue_.end() || i->second.resource_->GetAsyncLoadState() != ASYNC_QUEUED
+        || i->second.priority_ != pending.priority_)
+    {
+        backgroundLoadMutex_.Release();
+        return true;
+    }
 
-            resource->SetAsyncLoadState(success ? ASYNC_SUCCESS : ASYNC_FAIL);
-            backgroundLoadMutex_.Release();
+    BackgroundLoadItem& item = i->second;
+    Resource* resource = item.resource_;
+    // Claim the resource so other threads don't load it.
+    // We can be sure that the item is not removed from the queue as long as it is in the
+    // "queued" or "loading" state
+    resource->SetAsyncLoadState(ASYNC_LOADING);
+    backgroundLoadMutex_.Release();
+
+    AbstractFilePtr file = owner_->GetFile(resource->GetName(), item.sendEventOnFailure_);
+
+    // Don't block on I/O if possible, the resource is loaded by any thread when reading is completed
+    const ResourceKey key = pending.key_;
+    const auto onReadCompleted = [this, key](AsyncReadRequest* request)
+    {
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex_);
+            completedReads_.push_back(CompletedRead{key, SharedPtr<AsyncReadRequest>(request)});
         }
+        pendingCondition_.notify_one();
+    };
+    if (file && asyncFileReader_ && asyncFileReader_->ReadFile(file, onReadCompleted))
+        return true;
+
+    const bool success = file && resource->BeginLoad(*file);
+    CompleteBeginLoad(item, success);
+    return true;
+}
+
+void BackgroundLoader::LoadReadResource(const ResourceKey& key, AsyncReadRequest* request)
+{
+    BackgroundLoadItem* item = nullptr;
+    {
+        // Item is not removed from the queue while it's in the "loading" state
+        MutexLock lock(backgroundLoadMutex_);
+        const auto iter = backgroundLoadQueue_.find(key);
+        if (iter == backgroundLoadQueue_.end())
+            return;
+        item = &iter->second;
+    }
+
+    bool success = false;
+    if (request->IsSucceeded())
+    {
+        MemoryBuffer buffer(request->GetData());
+        buffer.SetName(request->GetFile()->GetName());
+        success = item->resource_->BeginLoad(buffer);
     }
+    CompleteBeginLoad(*item, success);
 }
 
-bool BackgroundLoader::QueueResource(StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller)
+void BackgroundLoader::CompleteBeginLoad(BackgroundLoadItem& item, bool success)
+{
+    Resource* resource = item.resource_;
+
+    // Offload as much as possible of EndLoad() from the main thread
+    if (success)
+        success = resource->EndLoadInWorkerThread();
+
+    // Process dependencies now
+    // Need to lock the queue again when manipulating other entries
+    const ResourceKey key = ea::make_pair(resource->GetType(), resource->GetNameHash());
+    MutexLock lock(backgroundLoadMutex_);
+    if (item.dependents_.size())
+    {
+        for (auto j = item.dependents_.begin(); j != item.dependents_.end(); ++j)
+        {
+            auto k = backgroundLoadQueue_.find(*j);
+            if (k != backgroundLoadQueue_.end())
+                k->second.dependencies_.erase(key);
+        }
+
+        item.dependents_.clear();
+    }
+
+    resource->SetAsyncLoadState(success ? ASYNC_SUCCESS : ASYNC_FAIL);
+}
+
+bool BackgroundLoader::QueueResource(StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller, float priority)
 {
     StringHash nameHash(name);
     ea::pair<StringHash, StringHash> key = ea::make_pair(type, nameHash);
 
     MutexLock lock(backgroundLoadMutex_);
 
-    // Check if already exists in the queue
-    if (backgroundLoadQueue_.find(key) != backgroundLoadQueue_.end())
+    // Dependencies should not delay the resource that requested them
+    if (caller)
+    {
+        const auto callerIter = backgroundLoadQueue_.find(ea::make_pair(caller->GetType(), caller->GetNameHash()));
+        if (callerIter != backgroundLoadQueue_.end())
+            priority = ea::max(priority, callerIter->second.priority_);
+    }
+
+    // Check if already exists in the queue, raise priority if it's not loaded yet
+    const auto existingIter = backgroundLoadQueue_.find(key);
+    if (existingIter != backgroundLoadQueue_.end())
+    {
+        BackgroundLoadItem& existingItem = existingIter->second;
+        if (existingItem.resource_->GetAsyncLoadState() == ASYNC_QUEUED && existingItem.priority_ < priority)
+        {
+            existingItem.priority_ = priority;
+            PushPendingResource(key, priority);
+        }
         return false;
+    }
 
     BackgroundLoadItem& item = backgroundLoadQueue_[key];
     item.sendEventOnFailure_ = sendEventOnFailure;
+    item.priority_ = priority;
 
     // Make sure the pointer is non-null and is a Resource subclass
     item.resource_ = DynamicCast<Resource>(owner_->GetContext()->CreateObject(type));
@@ -165,9 +328,9 @@ bool BackgroundLoader::QueueResource(StringHash type, const ea::string& name, bo
                        " requested for a background loaded resource but was not in the background load queue");
     }
 
-    // Start the background loader thread now
-    if (!IsStarted())
-        Run();
+    // Start the background loader threads now
+    PushPendingResource(key, priority);
+    StartThreads();
 
     return true;
 }
@@ -181,6 +344,14 @@ void BackgroundLoader::WaitForResource(StringHash type, StringHash nameHash)
     auto i = backgroundLoadQueue_.find(key);
     if (i != backgroundLoadQueue_.end())
     {
+        // Load the resource next if no thread picked it yet
+        BackgroundLoadItem& item = i->second;
+        if (item.resource_->GetAsyncLoadState() == ASYNC_QUEUED && item.priority_ < M_INFINITY)
+        {
+            item.priority_ = M_INFINITY;
+            PushPendingResource(key, item.priority_);
+        }
+
         backgroundLoadMutex_.Release();
 
         {
@@ -207,7 +378,12 @@ void BackgroundLoader::WaitForResource(StringHash type, StringHash nameHash)
         }
 
         // This may take a long time and may potentially wait on other resources, so it is important we do not hold the mutex during this
-        FinishBackgroundLoading(i->second);
+        for (;;)
+        {
+            unsigned long long uploadBudget = ea::numeric_limits<unsigned long long>::max();
+            if (FinishBackgroundLoading(i->second, uploadBudget))
+                break;
+        }
 
         backgroundLoadMutex_.Acquire();
         // Erasing by key since queue may change since iterator been acquired.
@@ -218,61 +394,118 @@ void BackgroundLoader::WaitForResource(StringHash type, StringHash nameHash)
         backgroundLoadMutex_.Release();
 }
 
-void BackgroundLoader::FinishResources(int maxMs)
+void BackgroundLoader::FinishResources(int maxMs, unsigned long long maxUploadBytes)
 {
-    if (IsStarted())
-    {
-        HiresTimer timer;
+    if (threads_.empty())
+        return;
 
-        backgroundLoadMutex_.Acquire();
+    HiresTimer timer;
+    const long long maxUSec = maxMs * 1000LL;
+    unsigned long long uploadBudget = maxUploadBytes;
 
-        for (auto i = backgroundLoadQueue_.begin(); i != backgroundLoadQueue_.end();
-             i = backgroundLoadQueue_.begin())
+    // Collect resources that are ready to finish. Continue partially finished resources first, then go by priority
+    struct ReadyResource
+    {
+        bool isFinishing_{};
+        float priority_{};
+        ResourceKey key_;
+    };
+    ea::vector<ReadyResource> readyResources;
+    {
+        MutexLock lock(backgroundLoadMutex_);
+        for (const auto& [key, item] : backgroundLoadQueue_)
         {
-            const auto key = i->first;
-            Resource* resource = i->second.resource_;
-            unsigned numDeps = i->second.dependencies_.size();
-            AsyncLoadState state = resource->GetAsyncLoadState();
-            if (numDeps > 0 || state == ASYNC_QUEUED || state == ASYNC_LOADING)
-                ++i;
-            else
-            {
-                // Finishing a resource may need it to wait for other resources to load, in which case we can not
-                // hold on to the mutex
-                backgroundLoadMutex_.Release();
-                FinishBackgroundLoading(i->second);
-                backgroundLoadMutex_.Acquire();
-                // Erasing by key because the queue may change since last time
-                backgroundLoadQueue_.erase(key);
-            }
+            const AsyncLoadState state = item.resource_->GetAsyncLoadState();
+            if (item.dependencies_.empty() && (state == ASYNC_SUCCESS || state == ASYNC_FAIL))
+                readyResources.push_back(ReadyResource{item.isFinishing_, item.priority_, key});
+        }
+    }
 
-            // Break when the time limit passed so that we keep sufficient FPS
-            if (timer.GetUSec(false) >= maxMs * 1000LL)
+    const auto isBetter = [](const ReadyResource& lhs, const ReadyResource& rhs)
+    {
+        if (lhs.isFinishing_ != rhs.isFinishing_)
+            return lhs.isFinishing_;
+        return lhs.priority_ > rhs.priority_;
+    };
+    ea::stable_sort(readyResources.begin(), readyResources.end(), isBetter);
+
+    bool isFirst = true;
+    for (const ReadyResource& readyResource : readyResources)
+    {
+        // Always finish at least one resource so loading makes progress even if budgets are too small
+        const StringHash type = readyResource.key_.first;
+        if (!isFirst)
+        {
+            const long long elapsed = timer.GetUSec(false);
+            if (uploadBudget == 0 || elapsed >= maxUSec)
                 break;
+
+            // Skip resources that are not expected to fit into the remaining time
+            const auto estimate = finishTimeEstimates_.find(type);
+            if (estimate != finishTimeEstimates_.end() && elapsed + static_cast<long long>(estimate->second) > maxUSec)
+                continue;
         }
+        isFirst = false;
 
-        backgroundLoadMutex_.Release();
+        BackgroundLoadItem* item = nullptr;
+        {
+            MutexLock lock(backgroundLoadMutex_);
+            const auto iter = backgroundLoadQueue_.find(readyResource.key_);
+            if (iter != backgroundLoadQueue_.end())
+                item = &iter->second;
+        }
+        if (!item)
+            continue;
+
+        // Finishing a resource may need it to wait for other resources to load, in which case we can not
+        // hold on to the mutex
+        HiresTimer finishTimer;
+        const bool isFinished = FinishBackgroundLoading(*item, uploadBudget);
+        UpdateFinishTimeEstimate(type, finishTimer.GetUSec(false));
+
+        if (isFinished)
+        {
+            MutexLock lock(backgroundLoadMutex_);
+            // Erasing by key because the queue may change since last time
+            backgroundLoadQueue_.erase(readyResource.key_);
+        }
     }
 }
 
+void BackgroundLoader::UpdateFinishTimeEstimate(StringHash type, long long usec)
+{
+    static const float smoothingFactor = 0.25f;
+
+    const auto [iter, isNew] = finishTimeEstimates_.emplace(type, static_cast<float>(usec));
+    if (!isNew)
+        iter->second = Lerp(iter->second, static_cast<float>(usec), smoothingFactor);
+}
+
 unsigned BackgroundLoader::GetNumQueuedResources() const
 {
     MutexLock lock(backgroundLoadMutex_);
     return backgroundLoadQueue_.size();
 }
 
-void BackgroundLoader::FinishBackgroundLoading(BackgroundLoadItem& item)
+bool BackgroundLoader::FinishBackgroundLoading(BackgroundLoadItem& item, unsigned long long& uploadBudget)
 {
     Resource* resource = item.resource_;
 
     bool success = resource->GetAsyncLoadState() == ASYNC_SUCCESS;
-    // If BeginLoad() phase was successful, call EndLoad() and get the final success/failure result
+    // If BeginLoad() phase was successful, call EndLoadPartial() until the final success/failure result
     if (success)
     {
         URHO3D_PROFILE("FinishBackgroundLoading");
         URHO3D_PROFILE_ZONENAME(resource->GetTypeName().c_str(), resource->GetTypeName().length());
-        URHO3D_LOGDEBUG("Finishing background loaded resource " + resource->GetName());
-        success = resource->EndLoad();
+        if (!item.isFinishing_)
+            URHO3D_LOGDEBUG("Finishing background loaded resource " + resource->GetName());
+
+        item.isFinishing_ = true;
+        const EndLoadStatus status = resource->EndLoadPartial(uploadBudget);
+        if (status == EndLoadStatus::Pending)
+            return false;
+
+        success = status == EndLoadStatus::Finished;
     }
     resource->SetAsyncLoadState(ASYNC_DONE);
 
@@ -299,6 +532,7 @@ void BackgroundLoader::FinishBackgroundLoading(BackgroundLoadItem& item)
         eventData[P_RESOURCE] = resource;
         owner_->SendEvent(E_RESOURCEBACKGROUNDLOADED, eventData);
     }
+    return true;
 }
 
 }
@@ -23,16 +23,26 @@
 #pragma once
 
 #include <EASTL/hash_set.h>
+#include <EASTL/unique_ptr.h>
 #include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
 
 #include "../Core/Mutex.h"
 #include "../Container/Ptr.h"
 #include "../Core/Thread.h"
 #include "../Math/StringHash.h"
 
+#include <EASTL/deque.h>
+#include <EASTL/numeric_limits.h>
+
+#include <condition_variable>
+#include <mutex>
+
 namespace Urho3D
 {
 
+class AsyncFileReader;
+class AsyncReadRequest;
 class Resource;
 class ResourceCache;
 
@@ -47,42 +57,111 @@ struct URHO3D_API BackgroundLoadItem
     ea::hash_set<ea::pair<StringHash, StringHash> > dependents_;
     /// Whether to send failure event.
     bool sendEventOnFailure_;
+    /// Load priority. Resources with higher priority are loaded first.
+    float priority_{};
+    /// Whether the resource finalization is started but not completed yet.
+    bool isFinishing_{};
 };
 
 /// Background loader of resources. Owned by the ResourceCache.
+/// Resources are loaded by the pool of threads in the order of priority.
 /// @nobind
-class URHO3D_API BackgroundLoader : public RefCounted, public Thread
+class URHO3D_API BackgroundLoader : public RefCounted
 {
 public:
     /// Construct.
     explicit BackgroundLoader(ResourceCache* owner);
 
-    /// Destruct. Forcibly clear the load queue.
+    /// Destruct. Stop loader threads and forcibly clear the load queue.
     ~BackgroundLoader() override;
 
-    /// Resource background loading loop.
-    void ThreadFunction() override;
-
     /// Queue loading of a resource. The name must be sanitated to ensure consistent format. Return true if queued (not a duplicate and resource was a known type).
-    bool QueueResource(StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller);
+    /// Priority of already queued resource is raised if needed. Dependencies are loaded with priority not lower than the caller's.
+    bool QueueResource(StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller, float priority = 0.0f);
     /// Wait and finish possible loading of a resource when being requested from the cache.
     void WaitForResource(StringHash type, StringHash nameHash);
-    /// Process resources that are ready to finish.
-    void FinishResources(int maxMs);
+    /// Process resources that are ready to finish, in the order of priority.
+    /// Resources are skipped if they are expected to exceed the time budget. Large resources may be finished in parts.
+    void FinishResources(int maxMs, unsigned long long maxUploadBytes = ea::numeric_limits<unsigned long long>::max());
+    /// Set number of loader threads. Threads are restarted if already running. Should be called from the main thread.
+    void SetNumThreads(unsigned numThreads);
 
     /// Return amount of resources in the load queue.
     unsigned GetNumQueuedResources() const;
+    /// Return number of loader threads.
+    unsigned GetNumThreads() const { return numThreads_; }
 
 private:
-    /// Finish one background loaded resource.
-    void FinishBackgroundLoading(BackgroundLoadItem& item);
+    using ResourceKey = ea::pair<StringHash, StringHash>;
+    class LoaderThread;
+
+    /// Resource waiting for a loader thread.
+    struct PendingResource
+    {
+        float priority_{};
+        /// Order of queueing, used to load resources with equal priority in FIFO order.
+        unsigned long long order_{};
+        ResourceKey key_;
+
+        bool operator <(const PendingResource& rhs) const
+        {
+            return priority_ != rhs.priority_ ? priority_ < rhs.priority_ : order_ > rhs.order_;
+        }
+    };
+
+    /// Resource which file is read asynchronously and is ready to be loaded.
+    struct CompletedRead
+    {
+        ResourceKey key_;
+        SharedPtr<AsyncReadRequest> request_;
+    };
+
+    /// Start loader threads if not started yet.
+    void StartThreads();
+    /// Stop all loader threads.
+    void StopThreads();
+    /// Push resource to the pending queue. Must be called under background load mutex.
+    void PushPendingResource(const ResourceKey& key, float priority);
+    /// Wait for the next pending resource and load it or start reading its file. Return false if loader is stopping.
+    bool LoadNextResource();
+    /// Load resource from file contents read asynchronously.
+    void LoadReadResource(const ResourceKey& key, AsyncReadRequest* request);
+    /// Store result of BeginLoad and update dependencies.
+    void CompleteBeginLoad(BackgroundLoadItem& item, bool success);
+    /// Finish one background loaded resource or part of it. Return true if the resource is completely finished.
+    bool FinishBackgroundLoading(BackgroundLoadItem& item, unsigned long long& uploadBudget);
+    /// Update estimated time of finishing resource of given type.
+    void UpdateFinishTimeEstimate(StringHash type, long long usec);
 
     /// Resource cache.
     ResourceCache* owner_;
     /// Mutex for thread-safe access to the background load queue.
     mutable Mutex backgroundLoadMutex_;
     /// Resources that are queued for background loading.
-    ea::unordered_map<ea::pair<StringHash, StringHash>, BackgroundLoadItem> backgroundLoadQueue_;
+    ea::unordered_map<ResourceKey, BackgroundLoadItem> backgroundLoadQueue_;
+
+    /// Mutex for the pending queue. Can be locked while holding background load mutex, but not vice versa.
+    std::mutex pendingMutex_;
+    /// Condition to wake up loader threads.
+    std::condition_variable pendingCondition_;
+    /// Binary max-heap of resources waiting for a loader thread. May contain outdated entries.
+    ea::vector<PendingResource> pendingResources_;
+    /// Resources which files are read and should be loaded by the next free loader thread.
+    ea::deque<CompletedRead> completedReads_;
+    /// Counter of queued resources.
+    unsigned long long pendingOrder_{};
+    /// Whether the loader threads should exit.
+    bool stopping_{};
+
+    /// Number of loader threads.
+    unsigned numThreads_{};
+    /// Loader threads. Started on the first request.
+    ea::vector<ea::unique_ptr<LoaderThread>> threads_;
+    /// Reader of resource files. Loader threads don't wait for I/O and can load other resources meanwhile.
+    SharedPtr<AsyncFileReader> asyncFileReader_;
+
+    /// Estimated time of single FinishBackgroundLoading call per resource type, in microseconds. Accessed only from the main thread.
+    ea::unordered_map<StringHash, float> finishTimeEstimates_;
 };
 
 }
@@ -0,0 +1,355 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Resource/Compress.h"
+
+#include "../Math/MathDefs.h"
+
+#include <cstring>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+struct ColorVector
+{
+    float r_{};
+    float g_{};
+    float b_{};
+};
+
+ColorVector operator+(const ColorVector& lhs, const ColorVector& rhs) { return {lhs.r_ + rhs.r_, lhs.g_ + rhs.g_, lhs.b_ + rhs.b_}; }
+ColorVector operator-(const ColorVector& lhs, const ColorVector& rhs) { return {lhs.r_ - rhs.r_, lhs.g_ - rhs.g_, lhs.b_ - rhs.b_}; }
+ColorVector operator*(const ColorVector& lhs, float rhs) { return {lhs.r_ * rhs, lhs.g_ * rhs, lhs.b_ * rhs}; }
+float Dot(const ColorVector& lhs, const ColorVector& rhs) { return lhs.r_ * rhs.r_ + lhs.g_ * rhs.g_ + lhs.b_ * rhs.b_; }
+
+ColorVector GetPixelColor(const unsigned char* pixel)
+{
+    return {static_cast<float>(pixel[0]), static_cast<float>(pixel[1]), static_cast<float>(pixel[2])};
+}
+
+unsigned short PackColor565(const ColorVector& color)
+{
+    const int r = Clamp(RoundToInt(color.r_ * 31.0f / 255.0f), 0, 31);
+    const int g = Clamp(RoundToInt(color.g_ * 63.0f / 255.0f), 0, 63);
+    const int b = Clamp(RoundToInt(color.b_ * 31.0f / 255.0f), 0, 31);
+    return static_cast<unsigned short>((r << 11) | (g << 5) | b);
+}
+
+ColorVector UnpackColor565(unsigned short color)
+{
+    const int r = (color >> 11) & 0x1f;
+    const int g = (color >> 5) & 0x3f;
+    const int b = color & 0x1f;
+    return {static_cast<float>((r << 3) | (r >> 2)), static_cast<float>((g << 2) | (g >> 4)),
+        static_cast<float>((b << 3) | (b >> 2))};
+}
+
+void WriteUShort(unsigned char* dest, unsigned short value)
+{
+    dest[0] = static_cast<unsigned char>(value & 0xff);
+    dest[1] = static_cast<unsigned char>(value >> 8);
+}
+
+/// Copy 4x4 block of pixels, clamping coordinates at the image border.
+void ExtractBlock(unsigned char* block, const unsigned char* rgba, int width, int height, int x, int y)
+{
+    for (int py = 0; py < 4; ++py)
+    {
+        const int sy = Min(y + py, height - 1);
+        for (int px = 0; px < 4; ++px)
+        {
+            const int sx = Min(x + px, width - 1);
+            memcpy(block + 4 * (py * 4 + px), rgba + 4 * (sy * width + sx), 4);
+        }
+    }
+}
+
+/// Return principal axis of block colors.
+ColorVector GetPrincipalAxis(const unsigned char* block, const ColorVector& mean)
+{
+    float covariance[6]{};
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        const ColorVector delta = GetPixelColor(block + 4 * i) - mean;
+        covariance[0] += delta.r_ * delta.r_;
+        covariance[1] += delta.r_ * delta.g_;
+        covariance[2] += delta.r_ * delta.b_;
+        covariance[3] += delta.g_ * delta.g_;
+        covariance[4] += delta.g_ * delta.b_;
+        covariance[5] += delta.b_ * delta.b_;
+    }
+
+    // Power iteration converges fast enough for 3x3 matrix
+    ColorVector axis{1.0f, 1.0f, 1.0f};
+    for (unsigned iteration = 0; iteration < 8; ++iteration)
+    {
+        const ColorVector next{
+            covariance[0] * axis.r_ + covariance[1] * axis.g_ + covariance[2] * axis.b_,
+            covariance[1] * axis.r_ + covariance[3] * axis.g_ + covariance[4] * axis.b_,
+            covariance[2] * axis.r_ + covariance[4] * axis.g_ + covariance[5] * axis.b_};
+        const float length = Sqrt(Dot(next, next));
+        if (length < M_EPSILON)
+            break;
+        axis = next * (1.0f / length);
+    }
+    return axis;
+}
+
+/// Build 4-color palette from endpoints in DXT order.
+void BuildPalette(ColorVector* palette, unsigned short color0, unsigned short color1)
+{
+    palette[0] = UnpackColor565(color0);
+    palette[1] = UnpackColor565(color1);
+    palette[2] = palette[0] * (2.0f / 3.0f) + palette[1] * (1.0f / 3.0f);
+    palette[3] = palette[0] * (1.0f / 3.0f) + palette[1] * (2.0f / 3.0f);
+}
+
+/// Select nearest palette entries. Return total squared error.
+float SelectIndices(unsigned char* indices, const unsigned char* block, const ColorVector* palette)
+{
+    float totalError = 0.0f;
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        const ColorVector color = GetPixelColor(block + 4 * i);
+        float bestError = M_LARGE_VALUE;
+        for (unsigned char index = 0; index < 4; ++index)
+        {
+            const ColorVector delta = color - palette[index];
+            const float error = Dot(delta, delta);
+            if (error < bestError)
+            {
+                bestError = error;
+                indices[i] = index;
+            }
+        }
+        totalError += bestError;
+    }
+    return totalError;
+}
+
+/// Refine endpoints by least squares fit to the selected indices. Return false if the system is degenerate.
+bool RefineEndpoints(ColorVector& endpoint0, ColorVector& endpoint1, const unsigned char* block, const unsigned char* indices)
+{
+    static const float weights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+
+    float aa = 0.0f;
+    float ab = 0.0f;
+    float bb = 0.0f;
+    ColorVector ax;
+    ColorVector bx;
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        const float a = weights[indices[i]];
+        const float b = 1.0f - a;
+        const ColorVector color = GetPixelColor(block + 4 * i);
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        ax = ax + color * a;
+        bx = bx + color * b;
+    }
+
+    const float determinant = aa * bb - ab * ab;
+    if (Abs(determinant) < M_EPSILON)
+        return false;
+
+    const float invDeterminant = 1.0f / determinant;
+    endpoint0 = (ax * bb - bx * ab) * invDeterminant;
+    endpoint1 = (bx * aa - ax * ab) * invDeterminant;
+    return true;
+}
+
+/// Encode 4-color block from endpoints. Return total squared error.
+float EncodeColorEndpoints(unsigned char* dest, const unsigned char* block, const ColorVector& endpoint0,
+    const ColorVector& endpoint1, unsigned char* indices)
+{
+    unsigned short color0 = PackColor565(endpoint0);
+    unsigned short color1 = PackColor565(endpoint1);
+    if (color0 < color1)
+        ea::swap(color0, color1);
+
+    ColorVector palette[4];
+    BuildPalette(palette, color0, color1);
+
+    // Equal endpoints mean 3-color mode, use only the first color
+    float error = 0.0f;
+    if (color0 == color1)
+    {
+        for (unsigned i = 0; i < 16; ++i)
+        {
+            const ColorVector delta = GetPixelColor(block + 4 * i) - palette[0];
+            error += Dot(delta, delta);
+            indices[i] = 0;
+        }
+    }
+    else
+        error = SelectIndices(indices, block, palette);
+
+    unsigned packedIndices = 0;
+    for (unsigned i = 0; i < 16; ++i)
+        packedIndices |= static_cast<unsigned>(indices[i]) << (2 * i);
+
+    WriteUShort(dest, color0);
+    WriteUShort(dest + 2, color1);
+    dest[4] = static_cast<unsigned char>(packedIndices & 0xff);
+    dest[5] = static_cast<unsigned char>((packedIndices >> 8) & 0xff);
+    dest[6] = static_cast<unsigned char>((packedIndices >> 16) & 0xff);
+    dest[7] = static_cast<unsigned char>(packedIndices >> 24);
+    return error;
+}
+
+void CompressColorBlock(unsigned char* dest, const unsigned char* block)
+{
+    ColorVector mean;
+    for (unsigned i = 0; i < 16; ++i)
+        mean = mean + GetPixelColor(block + 4 * i);
+    mean = mean * (1.0f / 16.0f);
+
+    // Fit endpoints along the principal axis
+    const ColorVector axis = GetPrincipalAxis(block, mean);
+    float minProjection = M_LARGE_VALUE;
+    float maxProjection = -M_LARGE_VALUE;
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        const float projection = Dot(GetPixelColor(block + 4 * i) - mean, axis);
+        minProjection = Min(minProjection, projection);
+        maxProjection = Max(maxProjection, projection);
+    }
+
+    // Inset endpoints slightly to reduce error of the interpolated colors
+    const float inset = (maxProjection - minProjection) / 16.0f;
+    ColorVector endpoint0 = mean + axis * (maxProjection - inset);
+    ColorVector endpoint1 = mean + axis * (minProjection + inset);
+
+    unsigned char indices[16];
+    const float error = EncodeColorEndpoints(dest, block, endpoint0, endpoint1, indices);
+
+    // Try to improve the result once, keep it only if it's better
+    if (error > 0.0f && RefineEndpoints(endpoint0, endpoint1, block, indices))
+    {
+        unsigned char refinedBlock[8];
+        unsigned char refinedIndices[16];
+        if (EncodeColorEndpoints(refinedBlock, block, endpoint0, endpoint1, refinedIndices) < error)
+            memcpy(dest, refinedBlock, sizeof(refinedBlock));
+    }
+}
+
+void CompressExplicitAlphaBlock(unsigned char* dest, const unsigned char* block)
+{
+    for (unsigned i = 0; i < 8; ++i)
+    {
+        const unsigned alpha0 = (block[4 * (2 * i) + 3] * 15 + 127) / 255;
+        const unsigned alpha1 = (block[4 * (2 * i + 1) + 3] * 15 + 127) / 255;
+        dest[i] = static_cast<unsigned char>(alpha0 | (alpha1 << 4));
+    }
+}
+
+void CompressInterpolatedAlphaBlock(unsigned char* dest, const unsigned char* block)
+{
+    unsigned char minAlpha = 255;
+    unsigned char maxAlpha = 0;
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        minAlpha = Min(minAlpha, block[4 * i + 3]);
+        maxAlpha = Max(maxAlpha, block[4 * i + 3]);
+    }
+
+    // 8-alpha mode requires alpha0 > alpha1
+    int palette[8];
+    palette[0] = maxAlpha;
+    palette[1] = minAlpha;
+    for (int i = 1; i < 7; ++i)
+        palette[i + 1] = ((7 - i) * maxAlpha + i * minAlpha) / 7;
+
+    unsigned long long packedIndices = 0;
+    if (minAlpha != maxAlpha)
+    {
+        for (unsigned i = 0; i < 16; ++i)
+        {
+            const int alpha = block[4 * i + 3];
+            unsigned bestIndex = 0;
+            for (unsigned index = 1; index < 8; ++index)
+            {
+                if (Abs(alpha - palette[index]) < Abs(alpha - palette[bestIndex]))
+                    bestIndex = index;
+            }
+            packedIndices |= static_cast<unsigned long long>(bestIndex) << (3 * i);
+        }
+    }
+
+    dest[0] = maxAlpha;
+    dest[1] = minAlpha;
+    for (unsigned i = 0; i < 6; ++i)
+        dest[2 + i] = static_cast<unsigned char>((packedIndices >> (8 * i)) & 0xff);
+}
+
+}
+
+unsigned GetCompressedImageSizeDXT(int width, int height, CompressedFormat format)
+{
+    const unsigned blockSize = format == CF_DXT1 ? 8 : 16;
+    return ((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+}
+
+void CompressImageDXT(unsigned char* blocks, const unsigned char* rgba, int width, int height, CompressedFormat format)
+{
+    CompressImageDXT(blocks, rgba, width, height, format, 0, (height + 3) / 4);
+}
+
+void CompressImageDXT(unsigned char* blocks, const unsigned char* rgba, int width, int height,
+    CompressedFormat format, int beginBlockRow, int endBlockRow)
+{
+    const unsigned blockSize = format == CF_DXT1 ? 8 : 16;
+    const unsigned blockRowSize = ((width + 3) / 4) * blockSize;
+
+    unsigned char block[4 * 16];
+    unsigned char* destBlock = blocks + beginBlockRow * blockRowSize;
+    for (int y = beginBlockRow * 4; y < endBlockRow * 4; y += 4)
+    {
+        for (int x = 0; x < width; x += 4)
+        {
+            ExtractBlock(block, rgba, width, height, x, y);
+
+            if (format == CF_DXT3)
+            {
+                CompressExplicitAlphaBlock(destBlock, block);
+                destBlock += 8;
+            }
+            else if (format == CF_DXT5)
+            {
+                CompressInterpolatedAlphaBlock(destBlock, block);
+                destBlock += 8;
+            }
+
+            CompressColorBlock(destBlock, block);
+            destBlock += 8;
+        }
+    }
+}
+
+}
@@ -0,0 +1,41 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Resource/Image.h"
+
+namespace Urho3D
+{
+
+/// Return size of DXT compressed image in bytes.
+URHO3D_API unsigned GetCompressedImageSizeDXT(int width, int height, CompressedFormat format);
+/// Compress RGBA image to DXT1, DXT3 or DXT5 blocks. Alpha is ignored for DXT1.
+/// The destination buffer required is GetCompressedImageSizeDXT bytes.
+URHO3D_API void CompressImageDXT(unsigned char* blocks, const unsigned char* rgba, int width, int height, CompressedFormat format);
+/// Compress the range of block rows of RGBA image to DXT1, DXT3 or DXT5 blocks.
+/// Block rows are 4 pixels high. Destination buffer is for the whole image, so ranges may be compressed independently.
+URHO3D_API void CompressImageDXT(unsigned char* blocks, const unsigned char* rgba, int width, int height,
+    CompressedFormat format, int beginBlockRow, int endBlockRow);
+
+}
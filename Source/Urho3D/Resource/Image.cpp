@@ -22,14 +22,19 @@
 
 #include "../Precompiled.h"
 
+#include "../Container/ByteVector.h"
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../IO/File.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
 #include "../IO/VirtualFileSystem.h"
+#include "../Resource/Compress.h"
 #include "../Resource/Decompress.h"
 
+#include <EASTL/array.h>
+
 #include <SDL_surface.h>
 #include <STB/stb_image.h>
 #include <STB/stb_image_write.h>
@@ -218,6 +223,74 @@ struct DDSurfaceDesc2
     unsigned dwTextureStage_;
 };
 
+namespace
+{
+
+/// Minimum number of pixels processed by one image processing task.
+const unsigned MinPixelsPerTask = 64 * 1024;
+/// Number of taps for Kaiser 2x downsampling filter.
+const int NumKaiserTaps = 6;
+
+/// Process image rows in parallel if called from WorkQueue thread and the image is big enough.
+/// Signature of callback: void(unsigned beginRow, unsigned endRow)
+template <class Callback>
+void ForEachImageRow(Context* context, unsigned numRows, unsigned rowWidth, const Callback& callback)
+{
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+    const unsigned rowsPerTask = ea::max(1u, MinPixelsPerTask / ea::max(1u, rowWidth));
+    if (!workQueue || !workQueue->IsMultithreaded() || !WorkQueue::IsProcessingThread())
+        callback(0u, numRows);
+    else
+        ForEachParallel(workQueue, rowsPerTask, numRows, callback);
+}
+
+/// Modified Bessel function of the first kind of order zero.
+float BesselI0(float x)
+{
+    const float halfXSquared = x * x * 0.25f;
+    float sum = 1.0f;
+    float term = 1.0f;
+    for (int k = 1; k < 16; ++k)
+    {
+        term *= halfXSquared / (k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+float Sinc(float x)
+{
+    if (Abs(x) < M_EPSILON)
+        return 1.0f;
+    x *= M_PI;
+    return sinf(x) / x;
+}
+
+/// Calculate normalized weights of Kaiser-windowed sinc filter for 2x downsampling.
+/// Tap i samples source pixel (2 * x - 2 + i) for destination pixel x.
+ea::array<float, NumKaiserTaps> CalculateKaiserWeights()
+{
+    static const float alpha = 4.0f;
+    static const float radius = NumKaiserTaps * 0.5f;
+
+    ea::array<float, NumKaiserTaps> weights{};
+    float sum = 0.0f;
+    for (int i = 0; i < NumKaiserTaps; ++i)
+    {
+        const float offset = i - (NumKaiserTaps - 1) * 0.5f;
+        const float t = offset / radius;
+        const float window = BesselI0(alpha * Sqrt(ea::max(0.0f, 1.0f - t * t))) / BesselI0(alpha);
+        weights[i] = Sinc(offset * 0.5f) * window;
+        sum += weights[i];
+    }
+
+    for (float& weight : weights)
+        weight /= sum;
+    return weights;
+}
+
+}
+
 bool CompressedLevel::Decompress(unsigned char* dest) const
 {
     if (!data_)
@@ -856,17 +929,19 @@ bool Image::BeginLoad(Deserializer& source)
             return false;
         }
 
-        size_t imgSize = (size_t)features.width * features.height * (features.has_alpha ? 4 : 3);
-        ea::shared_array<uint8_t> pixelData(new uint8_t[imgSize]);
+        // Decode directly into image data
+        const unsigned components = features.has_alpha || decodeToRGBA_ ? 4 : 3;
+        const size_t imgSize = (size_t)features.width * features.height * components;
+        SetSize(features.width, features.height, components);
 
         bool decodeError(false);
-        if (features.has_alpha)
+        if (components == 4)
         {
-            decodeError = WebPDecodeRGBAInto(data.get(), dataSize, pixelData.get(), imgSize, 4 * features.width) == nullptr;
+            decodeError = WebPDecodeRGBAInto(data.get(), dataSize, data_.get(), imgSize, 4 * features.width) == nullptr;
         }
         else
         {
-            decodeError = WebPDecodeRGBInto(data.get(), dataSize, pixelData.get(), imgSize, 3 * features.width) == nullptr;
+            decodeError = WebPDecodeRGBInto(data.get(), dataSize, data_.get(), imgSize, 3 * features.width) == nullptr;
         }
         if (decodeError)
         {
@@ -874,8 +949,8 @@ bool Image::BeginLoad(Deserializer& source)
             return false;
         }
 
-        SetSize(features.width, features.height, features.has_alpha ? 4 : 3);
-        SetData(pixelData.get());
+        if (decodePremultipliedAlpha_ && features.has_alpha)
+            PremultiplyAlpha(decodeSRGB_);
     }
 #endif
     else
@@ -884,7 +959,7 @@ bool Image::BeginLoad(Deserializer& source)
         source.Seek(0);
         int width, height;
         unsigned components;
-        unsigned char* pixelData = GetImageData(source, width, height, components);
+        unsigned char* pixelData = GetImageData(source, width, height, components, decodeToRGBA_);
         if (!pixelData)
         {
             URHO3D_LOGERROR("Could not load image " + source.GetName() + ": " + ea::string(stbi_failure_reason()));
@@ -893,6 +968,9 @@ bool Image::BeginLoad(Deserializer& source)
         SetSize(width, height, components);
         SetData(pixelData);
         FreeImageData(pixelData);
+
+        if (decodePremultipliedAlpha_ && components == 4)
+            PremultiplyAlpha(decodeSRGB_);
     }
 
     return true;
@@ -1241,34 +1319,37 @@ bool Image::Resize(int width, int height)
 
     /// \todo Reducing image size does not sample all needed pixels
     ea::shared_array<unsigned char> newData(new unsigned char[width * height * components_]);
-    for (int y = 0; y < height; ++y)
+    ForEachImageRow(context_, height, width, [&](unsigned beginRow, unsigned endRow)
     {
-        for (int x = 0; x < width; ++x)
+        for (int y = static_cast<int>(beginRow); y < static_cast<int>(endRow); ++y)
         {
-            // Calculate float coordinates between 0 - 1 for resampling
-            float xF = (width_ > 1) ? (float)x / (float)(width - 1) : 0.0f;
-            float yF = (height_ > 1) ? (float)y / (float)(height - 1) : 0.0f;
-            unsigned uintColor = GetPixelBilinear(xF, yF).ToUInt();
-            unsigned char* dest = newData.get() + (y * width + x) * components_;
-            auto* src = (unsigned char*)&uintColor;
-
-            switch (components_)
+            for (int x = 0; x < width; ++x)
             {
-            case 4:
-                dest[3] = src[3];
-                // Fall through
-            case 3:
-                dest[2] = src[2];
-                // Fall through
-            case 2:
-                dest[1] = src[1];
-                // Fall through
-            default:
-                dest[0] = src[0];
-                break;
+                // Calculate float coordinates between 0 - 1 for resampling
+                float xF = (width_ > 1) ? (float)x / (float)(width - 1) : 0.0f;
+                float yF = (height_ > 1) ? (float)y / (float)(height - 1) : 0.0f;
+                unsigned uintColor = GetPixelBilinear(xF, yF).ToUInt();
+                unsigned char* dest = newData.get() + (y * width + x) * components_;
+                auto* src = (unsigned char*)&uintColor;
+
+                switch (components_)
+                {
+                case 4:
+                    dest[3] = src[3];
+                    // Fall through
+                case 3:
+                    dest[2] = src[2];
+                    // Fall through
+                case 2:
+                    dest[1] = src[1];
+                    // Fall through
+                default:
+                    dest[0] = src[0];
+                    break;
+                }
             }
         }
-    }
+    });
 
     width_ = width;
     height_ = height;
@@ -1443,6 +1524,93 @@ bool Image::SaveDDS(const ea::string& fileName) const
     return true;
 }
 
+bool Image::SaveDDS(const ea::string& fileName, CompressedFormat format, bool generateMips, ImageMipFilter mipFilter) const
+{
+    URHO3D_PROFILE("SaveImageDDSCompressed");
+
+    if (IsCompressed())
+    {
+        URHO3D_LOGERROR("Can not save compressed image to DDS");
+        return false;
+    }
+
+    if (format != CF_DXT1 && format != CF_DXT3 && format != CF_DXT5)
+    {
+        URHO3D_LOGERROR("Only DXT1, DXT3 and DXT5 formats are supported for DDS compression");
+        return false;
+    }
+
+    if (depth_ > 1)
+    {
+        URHO3D_LOGERROR("Can not save 3D image to compressed DDS");
+        return false;
+    }
+
+    // Keep references to temporary images
+    ea::vector<SharedPtr<Image>> tempImages;
+    const Image* level = this;
+    if (components_ != 4)
+    {
+        tempImages.push_back(ConvertToRGBA());
+        level = tempImages.back();
+        if (!level)
+            return false;
+    }
+
+    ea::vector<const Image*> levels{level};
+    while (generateMips && (level->GetWidth() > 1 || level->GetHeight() > 1))
+    {
+        tempImages.push_back(level->GetNextLevel(mipFilter));
+        level = tempImages.back();
+        if (!level)
+            return false;
+        levels.push_back(level);
+    }
+
+    File outFile(context_, fileName, FILE_WRITE);
+    if (!outFile.IsOpen())
+    {
+        URHO3D_LOGERROR("Access denied to " + fileName);
+        return false;
+    }
+
+    outFile.WriteFileID("DDS ");
+
+    DDSurfaceDesc2 ddsd;        // NOLINT(hicpp-member-init)
+    memset(&ddsd, 0, sizeof(ddsd));
+    ddsd.dwSize_ = sizeof(ddsd);
+    ddsd.dwFlags_ = 0x00000001l /*DDSD_CAPS*/
+        | 0x00000002l /*DDSD_HEIGHT*/ | 0x00000004l /*DDSD_WIDTH*/ | 0x00020000l /*DDSD_MIPMAPCOUNT*/ | 0x00001000l /*DDSD_PIXELFORMAT*/
+        | 0x00080000l /*DDSD_LINEARSIZE*/;
+    ddsd.dwWidth_ = width_;
+    ddsd.dwHeight_ = height_;
+    ddsd.dwLinearSize_ = GetCompressedImageSizeDXT(width_, height_, format);
+    ddsd.dwMipMapCount_ = levels.size();
+    ddsd.ddpfPixelFormat_.dwSize_ = sizeof(ddsd.ddpfPixelFormat_);
+    ddsd.ddpfPixelFormat_.dwFlags_ = 0x00000004l /*DDPF_FOURCC*/;
+    ddsd.ddpfPixelFormat_.dwFourCC_ = format == CF_DXT1 ? FOURCC_DXT1 : format == CF_DXT3 ? FOURCC_DXT3 : FOURCC_DXT5;
+    ddsd.ddsCaps_.dwCaps_ = DDSCAPS_TEXTURE;
+    if (levels.size() > 1)
+        ddsd.ddsCaps_.dwCaps_ |= DDSCAPS_COMPLEX | DDSCAPS_MIPMAP;
+
+    outFile.Write(&ddsd, sizeof(ddsd));
+
+    ByteVector blocks;
+    for (const Image* image : levels)
+    {
+        const int width = image->GetWidth();
+        const int height = image->GetHeight();
+        blocks.resize(GetCompressedImageSizeDXT(width, height, format));
+        ForEachImageRow(context_, (height + 3) / 4, width * 4, [&](unsigned beginRow, unsigned endRow)
+        {
+            CompressImageDXT(blocks.data(), image->GetData(), width, height, format, beginRow, endRow);
+        });
+        outFile.Write(blocks.data(), blocks.size());
+    }
+
+    return true;
+}
+
 bool Image::SaveWEBP(const ea::string& fileName, float compression /* = 0.0f */) const
 {
 #ifdef URHO3D_WEBP
@@ -1766,84 +1934,87 @@ SharedPtr<Image> Image::GetNextLevel() const
     // 2D case
     else if (depth_ == 1)
     {
-        switch (components_)
+        ForEachImageRow(context_, heightOut, widthOut, [&](unsigned beginRow, unsigned endRow)
         {
-        case 1:
-            for (int y = 0; y < heightOut; ++y)
+            switch (components_)
             {
-                const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_];
-                const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_];
-                unsigned char* out = &pixelDataOut[y * widthOut];
-
-                for (int x = 0; x < widthOut; ++x)
+            case 1:
+                for (int y = static_cast<int>(beginRow); y < static_cast<int>(endRow); ++y)
                 {
-                    out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 1] +
-                                              inLower[x * 2] + inLower[x * 2 + 1]) >> 2);
-                }
-            }
-            break;
+                    const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_];
+                    const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_];
+                    unsigned char* out = &pixelDataOut[y * widthOut];
 
-        case 2:
-            for (int y = 0; y < heightOut; ++y)
-            {
-                const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_ * 2];
-                const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_ * 2];
-                unsigned char* out = &pixelDataOut[y * widthOut * 2];
+                    for (int x = 0; x < widthOut; ++x)
+                    {
+                        out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 1] +
+                                                  inLower[x * 2] + inLower[x * 2 + 1]) >> 2);
+                    }
+                }
+                break;
 
-                for (int x = 0; x < widthOut * 2; x += 2)
+            case 2:
+                for (int y = static_cast<int>(beginRow); y < static_cast<int>(endRow); ++y)
                 {
-                    out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 2] +
-                                              inLower[x * 2] + inLower[x * 2 + 2]) >> 2);
-                    out[x + 1] = (unsigned char)(((unsigned)inUpper[x * 2 + 1] + inUpper[x * 2 + 3] +
-                                                  inLower[x * 2 + 1] + inLower[x * 2 + 3]) >> 2);
-                }
-            }
-            break;
+                    const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_ * 2];
+                    const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_ * 2];
+                    unsigned char* out = &pixelDataOut[y * widthOut * 2];
 
-        case 3:
-            for (int y = 0; y < heightOut; ++y)
-            {
-                const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_ * 3];
-                const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_ * 3];
-                unsigned char* out = &pixelDataOut[y * widthOut * 3];
+                    for (int x = 0; x < widthOut * 2; x += 2)
+                    {
+                        out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 2] +
+                                                  inLower[x * 2] + inLower[x * 2 + 2]) >> 2);
+                        out[x + 1] = (unsigned char)(((unsigned)inUpper[x * 2 + 1] + inUpper[x * 2 + 3] +
+                                                      inLower[x * 2 + 1] + inLower[x * 2 + 3]) >> 2);
+                    }
+                }
+                break;
 
-                for (int x = 0; x < widthOut * 3; x += 3)
+            case 3:
+                for (int y = static_cast<int>(beginRow); y < static_cast<int>(endRow); ++y)
                 {
-                    out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 3] +
-                                              inLower[x * 2] + inLower[x * 2 + 3]) >> 2);
-                    out[x + 1] = (unsigned char)(((unsigned)inUpper[x * 2 + 1] + inUpper[x * 2 + 4] +
-                                                  inLower[x * 2 + 1] + inLower[x * 2 + 4]) >> 2);
-                    out[x + 2] = (unsigned char)(((unsigned)inUpper[x * 2 + 2] + inUpper[x * 2 + 5] +
-                                                  inLower[x * 2 + 2] + inLower[x * 2 + 5]) >> 2);
-                }
-            }
-            break;
+                    const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_ * 3];
+                    const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_ * 3];
+                    unsigned char* out = &pixelDataOut[y * widthOut * 3];
 
-        case 4:
-            for (int y = 0; y < heightOut; ++y)
-            {
-                const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_ * 4];
-                const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_ * 4];
-                unsigned char* out = &pixelDataOut[y * widthOut * 4];
+                    for (int x = 0; x < widthOut * 3; x += 3)
+                    {
+                        out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 3] +
+                                                  inLower[x * 2] + inLower[x * 2 + 3]) >> 2);
+                        out[x + 1] = (unsigned char)(((unsigned)inUpper[x * 2 + 1] + inUpper[x * 2 + 4] +
+                                                      inLower[x * 2 + 1] + inLower[x * 2 + 4]) >> 2);
+                        out[x + 2] = (unsigned char)(((unsigned)inUpper[x * 2 + 2] + inUpper[x * 2 + 5] +
+                                                      inLower[x * 2 + 2] + inLower[x * 2 + 5]) >> 2);
+                    }
+                }
+                break;
 
-                for (int x = 0; x < widthOut * 4; x += 4)
+            case 4:
+                for (int y = static_cast<int>(beginRow); y < static_cast<int>(endRow); ++y)
                 {
-                    out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 4] +
-                                              inLower[x * 2] + inLower[x * 2 + 4]) >> 2);
-                    out[x + 1] = (unsigned char)(((unsigned)inUpper[x * 2 + 1] + inUpper[x * 2 + 5] +
-                                                  inLower[x * 2 + 1] + inLower[x * 2 + 5]) >> 2);
-                    out[x + 2] = (unsigned char)(((unsigned)inUpper[x * 2 + 2] + inUpper[x * 2 + 6] +
-                                                  inLower[x * 2 + 2] + inLower[x * 2 + 6]) >> 2);
-                    out[x + 3] = (unsigned char)(((unsigned)inUpper[x * 2 + 3] + inUpper[x * 2 + 7] +
-                                                  inLower[x * 2 + 3] + inLower[x * 2 + 7]) >> 2);
+                    const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_ * 4];
+                    const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_ * 4];
+                    unsigned char* out = &pixelDataOut[y * widthOut * 4];
+
+                    for (int x = 0; x < widthOut * 4; x += 4)
+                    {
+                        out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 4] +
+                                                  inLower[x * 2] + inLower[x * 2 + 4]) >> 2);
+                        out[x + 1] = (unsigned char)(((unsigned)inUpper[x * 2 + 1] + inUpper[x * 2 + 5] +
+                                                      inLower[x * 2 + 1] + inLower[x * 2 + 5]) >> 2);
+                        out[x + 2] = (unsigned char)(((unsigned)inUpper[x * 2 + 2] + inUpper[x * 2 + 6] +
+                                                      inLower[x * 2 + 2] + inLower[x * 2 + 6]) >> 2);
+                        out[x + 3] = (unsigned char)(((unsigned)inUpper[x * 2 + 3] + inUpper[x * 2 + 7] +
+                                                      inLower[x * 2 + 3] + inLower[x * 2 + 7]) >> 2);
+                    }
                 }
-            }
-            break;
+                break;
 
-        default:
-            assert(false);  // Should never reach here
-            break;
-        }
+            default:
+                assert(false);  // Should never reach here
+                break;
+            }
+        });
     }
     // 3D case
     else
@@ -1983,6 +2154,81 @@ SharedPtr<Image> Image::GetNextLevel() const
     return mipImage;
 }
 
+SharedPtr<Image> Image::GetNextLevel(ImageMipFilter filter) const
+{
+    if (filter == ImageMipFilter::Box || depth_ > 1)
+        return GetNextLevel();
+
+    if (IsCompressed())
+    {
+        URHO3D_LOGERROR("Can not generate mip level from compressed data");
+        return SharedPtr<Image>();
+    }
+    if (components_ < 1 || components_ > 4)
+    {
+        URHO3D_LOGERROR("Illegal number of image components for mip level generation");
+        return SharedPtr<Image>();
+    }
+
+    URHO3D_PROFILE("CalculateImageMipLevelKaiser");
+
+    static const ea::array<float, NumKaiserTaps> weights = CalculateKaiserWeights();
+
+    const int components = static_cast<int>(components_);
+    const int widthOut = ea::max(1, width_ / 2);
+    const int heightOut = ea::max(1, height_ / 2);
+
+    // Filter rows first, then columns
+    ea::vector<float> tempData(widthOut * height_ * components);
+    const unsigned char* pixelDataIn = data_.get();
+    ForEachImageRow(context_, height_, width_, [&](unsigned beginRow, unsigned endRow)
+    {
+        for (int y = static_cast<int>(beginRow); y < static_cast<int>(endRow); ++y)
+        {
+            const unsigned char* in = &pixelDataIn[y * width_ * components];
+            float* out = &tempData[y * widthOut * components];
+            for (int x = 0; x < widthOut; ++x)
+            {
+                for (int c = 0; c < components; ++c)
+                {
+                    float sum = 0.0f;
+                    for (int i = 0; i < NumKaiserTaps; ++i)
+                    {
+                        const int sourceX = Clamp(2 * x - 2 + i, 0, width_ - 1);
+                        sum += weights[i] * in[sourceX * components + c];
+                    }
+                    out[x * components + c] = sum;
+                }
+            }
+        }
+    });
+
+    SharedPtr<Image> mipImage(MakeShared<Image>(context_));
+    mipImage->SetSize(widthOut, heightOut, components_);
+
+    unsigned char* pixelDataOut = mipImage->data_.get();
+    const int rowSize = widthOut * components;
+    ForEachImageRow(context_, heightOut, widthOut, [&](unsigned beginRow, unsigned endRow)
+    {
+        for (int y = static_cast<int>(beginRow); y < static_cast<int>(endRow); ++y)
+        {
+            unsigned char* out = &pixelDataOut[y * rowSize];
+            for (int x = 0; x < rowSize; ++x)
+            {
+                float sum = 0.0f;
+                for (int i = 0; i < NumKaiserTaps; ++i)
+                {
+                    const int sourceY = Clamp(2 * y - 2 + i, 0, height_ - 1);
+                    sum += weights[i] * tempData[sourceY * rowSize + x];
+                }
+                out[x] = static_cast<unsigned char>(Clamp(RoundToInt(sum), 0, 255));
+            }
+        }
+    });
+
+    return mipImage;
+}
+
 SharedPtr<Image> Image::ConvertToRGBA() const
 {
     if (IsCompressed())
@@ -2004,51 +2250,56 @@ SharedPtr<Image> Image::ConvertToRGBA() const
     SharedPtr<Image> ret(MakeShared<Image>(context_));
     ret->SetSize(width_, height_, depth_, 4);
 
-    const unsigned char* src = data_.get();
-    unsigned char* dest = ret->GetData();
-
-    switch (components_)
+    const unsigned numRows = height_ * depth_;
+    ForEachImageRow(context_, numRows, width_, [&](unsigned beginRow, unsigned endRow)
     {
-    case 1:
-        for (unsigned i = 0; i < static_cast<unsigned>(width_ * height_ * depth_); ++i)
-        {
-            unsigned char pixel = *src++;
-            *dest++ = pixel;
-            *dest++ = pixel;
-            *dest++ = pixel;
-            *dest++ = 255;
-        }
-        break;
+        const unsigned numPixels = (endRow - beginRow) * width_;
+        const unsigned char* src = data_.get() + beginRow * width_ * components_;
+        unsigned char* dest = ret->GetData() + beginRow * width_ * 4;
 
-    case 2:
-        for (unsigned i = 0; i < static_cast<unsigned>(width_ * height_ * depth_); ++i)
+        switch (components_)
         {
-            unsigned char pixel = *src++;
-            *dest++ = pixel;
-            *dest++ = pixel;
-            *dest++ = pixel;
-            *dest++ = *src++;
-        }
-        break;
+        case 1:
+            for (unsigned i = 0; i < numPixels; ++i)
+            {
+                unsigned char pixel = *src++;
+                *dest++ = pixel;
+                *dest++ = pixel;
+                *dest++ = pixel;
+                *dest++ = 255;
+            }
+            break;
 
-    case 3:
-        for (unsigned i = 0; i < static_cast<unsigned>(width_ * height_ * depth_); ++i)
-        {
-            *dest++ = *src++;
-            *dest++ = *src++;
-            *dest++ = *src++;
-            *dest++ = 255;
-        }
-        break;
+        case 2:
+            for (unsigned i = 0; i < numPixels; ++i)
+            {
+                unsigned char pixel = *src++;
+                *dest++ = pixel;
+                *dest++ = pixel;
+                *dest++ = pixel;
+                *dest++ = *src++;
+            }
+            break;
 
-    case 4:
-        memcpy(dest, src, width_ * height_ * depth_ * 4);
-        break;
+        case 3:
+            for (unsigned i = 0; i < numPixels; ++i)
+            {
+                *dest++ = *src++;
+                *dest++ = *src++;
+                *dest++ = *src++;
+                *dest++ = 255;
+            }
+            break;
 
-    default:
-        assert(false);  // Should never reach nere
-        break;
-    }
+        case 4:
+            memcpy(dest, src, numPixels * 4);
+            break;
+
+        default:
+            assert(false);  // Should never reach nere
+            break;
+        }
+    });
 
     return ret;
 }
@@ -2443,12 +2694,65 @@ void Image::GetLevels(ea::vector<const Image*>& levels) const
 }
 
 unsigned char* Image::GetImageData(Deserializer& source, int& width, int& height, unsigned& components)
+{
+    return GetImageData(source, width, height, components, false);
+}
+
+unsigned char* Image::GetImageData(
+    Deserializer& source, int& width, int& height, unsigned& components, bool expandRGBToRGBA)
 {
     unsigned dataSize = source.GetSize();
 
     ea::shared_array<unsigned char> buffer(new unsigned char[dataSize]);
     source.Read(buffer.get(), dataSize);
-    return stbi_load_from_memory(buffer.get(), dataSize, &width, &height, (int*)&components, 0);
+
+    // Let the decoder write alpha instead of converting the image later
+    int desiredComponents = 0;
+    int fileComponents = 0;
+    if (expandRGBToRGBA && stbi_info_from_memory(buffer.get(), dataSize, &width, &height, &fileComponents)
+        && fileComponents == 3)
+        desiredComponents = 4;
+
+    unsigned char* pixelData =
+        stbi_load_from_memory(buffer.get(), dataSize, &width, &height, (int*)&components, desiredComponents);
+    if (pixelData && desiredComponents != 0)
+        components = desiredComponents;
+    return pixelData;
+}
+
+void Image::PremultiplyAlpha(bool sRGB)
+{
+    if (components_ != 4 || !data_)
+        return;
+
+    // Tables to convert between gamma and linear space, linear values have extra precision
+    static const unsigned linearScale = 4095;
+    static const auto tables = []()
+    {
+        ea::pair<ea::array<unsigned short, 256>, ea::array<unsigned char, linearScale + 1>> result;
+        for (unsigned i = 0; i < 256; ++i)
+            result.first[i] = static_cast<unsigned short>(RoundToInt(Color::ConvertGammaToLinear(i / 255.0f) * linearScale));
+        for (unsigned i = 0; i <= linearScale; ++i)
+            result.second[i] = static_cast<unsigned char>(RoundToInt(Color::ConvertLinearToGamma(static_cast<float>(i) / linearScale) * 255.0f));
+        return result;
+    }();
+
+    unsigned char* pixel = data_.get();
+    const unsigned numPixels = width_ * height_ * depth_;
+    for (unsigned i = 0; i < numPixels; ++i, pixel += 4)
+    {
+        const unsigned alpha = pixel[3];
+        if (alpha == 255)
+            continue;
+
+        for (unsigned j = 0; j < 3; ++j)
+        {
+            if (sRGB)
+                pixel[j] = tables.second[(tables.first[pixel[j]] * alpha + 127) / 255];
+            else
+                pixel[j] = static_cast<unsigned char>((pixel[j] * alpha + 127) / 255);
+        }
+    }
 }
 
 void Image::FreeImageData(unsigned char* pixelData)
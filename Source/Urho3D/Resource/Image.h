@@ -53,6 +53,15 @@ enum CompressedFormat
     CF_PVRTC_RGBA_4BPP,
 };
 
+/// Filter used to generate image mip levels.
+enum class ImageMipFilter
+{
+    /// Average of 2x2 pixels. Fast, but blurs and aliases.
+    Box,
+    /// Kaiser-windowed sinc. Slower, but keeps mip levels sharp.
+    Kaiser,
+};
+
 /// Compressed image mip level.
 struct URHO3D_API CompressedLevel
 {
@@ -100,6 +109,18 @@ public:
     /// Save the image to a file. Format of the image is determined by file extension. JPG is saved with maximum quality.
     bool SaveFile(const FileIdentifier& fileName) const override;
 
+    /// Set whether decoded images with 3 color components are expanded to 4 components with opaque alpha,
+    /// which is the format supported by GPU. Affects only images decoded from PNG, JPG, TGA and WebP.
+    void SetDecodeToRGBA(bool enable) { decodeToRGBA_ = enable; }
+    /// Set whether color of decoded images with alpha is multiplied by alpha.
+    /// Color is converted to linear space for multiplication if sRGB flag is set.
+    /// Affects only images decoded from PNG, JPG, TGA and WebP.
+    void SetDecodePremultipliedAlpha(bool enable, bool sRGB = false)
+    {
+        decodePremultipliedAlpha_ = enable;
+        decodeSRGB_ = sRGB;
+    }
+
     /// Set 2D size and number of color components. Old image data will be destroyed and new data is undefined. Return true if successful.
     bool SetSize(int width, int height, unsigned components);
     /// Set 3D size and number of color components. Old image data will be destroyed and new data is undefined. Return true if successful.
@@ -136,6 +157,9 @@ public:
     bool SaveJPG(const ea::string& fileName, int quality) const;
     /// Save in DDS format. Only uncompressed RGBA images are supported. Return true if successful.
     bool SaveDDS(const ea::string& fileName) const;
+    /// Save in DDS format compressed as DXT1, DXT3 or DXT5, optionally with full mip chain. Return true if successful.
+    bool SaveDDS(const ea::string& fileName, CompressedFormat format, bool generateMips = true,
+        ImageMipFilter mipFilter = ImageMipFilter::Box) const;
     /// Save in WebP format with minimum (fastest) or specified compression. Return true if successful. Fails always if WebP support is not compiled in.
     bool SaveWEBP(const ea::string& fileName, float compression = 0.0f) const;
     /// Whether this texture is detected as a cubemap, only relevant for DDS.
@@ -200,6 +224,9 @@ public:
 
     /// Return next mip level by bilinear filtering. Note that if the image is already 1x1x1, will keep returning an image of that size.
     SharedPtr<Image> GetNextLevel() const;
+    /// Return next mip level generated with specified filter. Kaiser filter is supported only for 2D images.
+    /// Unlike GetNextLevel(), the result is not cached.
+    SharedPtr<Image> GetNextLevel(ImageMipFilter filter) const;
     /// Return the next sibling image of an array or cubemap.
     SharedPtr<Image> GetNextSibling() const { return nextSibling_;  }
     /// Return image converted to 4-component (RGBA) to circumvent modern rendering API's not supporting e.g. the luminance-alpha format.
@@ -231,6 +258,11 @@ public:
 private:
     /// Decode an image using stb_image.
     static unsigned char* GetImageData(Deserializer& source, int& width, int& height, unsigned& components);
+    /// Decode an image using stb_image. Images with 3 color components are expanded to 4 if requested.
+    static unsigned char* GetImageData(
+        Deserializer& source, int& width, int& height, unsigned& components, bool expandRGBToRGBA);
+    /// Multiply color of decoded image by alpha in place.
+    void PremultiplyAlpha(bool sRGB);
     /// Free an image file's pixel data.
     static void FreeImageData(unsigned char* pixelData);
 
@@ -252,6 +284,12 @@ private:
     bool sRGB_{};
     /// Compressed format.
     CompressedFormat compressedFormat_{CF_NONE};
+    /// Whether to expand decoded RGB images to RGBA.
+    bool decodeToRGBA_{};
+    /// Whether to premultiply alpha of decoded images.
+    bool decodePremultipliedAlpha_{};
+    /// Whether decoded images are premultiplied in linear space.
+    bool decodeSRGB_{};
     /// Pixel data.
     ea::shared_array<unsigned char> data_;
     /// Precalculated mip level image.
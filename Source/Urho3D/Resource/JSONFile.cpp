@@ -33,6 +33,7 @@
 #include "../Resource/ResourceCache.h"
 
 #include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/prettywriter.h>
 
@@ -55,61 +56,82 @@ void JSONFile::RegisterObject(Context* context)
     context->AddFactoryReflection<JSONFile>();
 }
 
-// Convert rapidjson value to JSON value.
-static void ToJSONValue(JSONValue& jsonValue, const rapidjson::Value& rapidjsonValue)
+namespace
 {
-    switch (rapidjsonValue.GetType())
-    {
-    case kNullType:
-        // Reset to null type
-        jsonValue.SetType(JSON_NULL);
-        break;
 
-    case kFalseType:
-        jsonValue = false;
-        break;
-
-    case kTrueType:
-        jsonValue = true;
-        break;
+/// SAX handler that builds JSON value directly from rapidjson reader events without intermediate DOM.
+class JSONValueReader : public BaseReaderHandler<UTF8<>, JSONValueReader>
+{
+public:
+    explicit JSONValueReader(JSONValue& root) : root_(root) {}
+
+    bool Null() { NextValue().SetType(JSON_NULL); return true; }
+    bool Bool(bool value) { NextValue() = value; return true; }
+    bool Int(int value) { NextValue() = value; return true; }
+    bool Uint(unsigned value) { NextValue() = value; return true; }
+    bool Int64(int64_t value) { NextValue() = static_cast<double>(value); return true; }
+    bool Uint64(uint64_t value) { NextValue() = static_cast<double>(value); return true; }
+    bool Double(double value) { NextValue() = value; return true; }
+    bool String(const char* value, SizeType length, bool /*copy*/)
+    {
+        NextValue() = ea::string(value, length);
+        return true;
+    }
 
-    case kNumberType:
-        if (rapidjsonValue.IsInt())
-            jsonValue = rapidjsonValue.GetInt();
-        else if (rapidjsonValue.IsUint())
-            jsonValue = rapidjsonValue.GetUint();
-        else
-            jsonValue = rapidjsonValue.GetDouble();
-        break;
+    bool StartObject() { return StartContainer(JSON_OBJECT); }
+    bool Key(const char* value, SizeType length, bool /*copy*/)
+    {
+        key_.assign(value, length);
+        return true;
+    }
+    bool EndObject(SizeType /*memberCount*/) { stack_.pop_back(); return true; }
 
-    case kStringType:
-        jsonValue = rapidjsonValue.GetString();
-        break;
+    bool StartArray() { return StartContainer(JSON_ARRAY); }
+    bool EndArray(SizeType /*elementCount*/) { stack_.pop_back(); return true; }
 
-    case kArrayType:
-        {
-            jsonValue.Resize(rapidjsonValue.Size());
-            for (unsigned i = 0; i < rapidjsonValue.Size(); ++i)
-            {
-                ToJSONValue(jsonValue[i], rapidjsonValue[i]);
-            }
-        }
-        break;
+private:
+    /// Return value to be filled by the next event.
+    JSONValue& NextValue()
+    {
+        if (stack_.empty())
+            return root_;
 
-    case kObjectType:
+        JSONValue& parent = *stack_.back();
+        if (parent.IsArray())
         {
-            jsonValue.SetType(JSON_OBJECT);
-            for (rapidjson::Value::ConstMemberIterator i = rapidjsonValue.MemberBegin(); i != rapidjsonValue.MemberEnd(); ++i)
-            {
-                JSONValue& value = jsonValue[ea::string(i->name.GetString())];
-                ToJSONValue(value, i->value);
-            }
+            parent.Push(JSONValue{});
+            return parent[parent.Size() - 1];
         }
-        break;
+        return parent[key_];
+    }
 
-    default:
-        break;
+    bool StartContainer(JSONValueType type)
+    {
+        JSONValue& value = NextValue();
+        value.SetType(type);
+        // Nested values are stored in heap-allocated containers, so the pointer is stable until the container ends
+        stack_.push_back(&value);
+        return true;
     }
+
+    JSONValue& root_;
+    ea::vector<JSONValue*> stack_;
+    ea::string key_;
+};
+
+/// Parse JSON from the stream directly into JSON value.
+template <unsigned ParseFlags, class Stream>
+ParseResult ParseToJSONValue(Stream& stream, JSONValue& value)
+{
+    JSONValue result;
+    JSONValueReader handler(result);
+    Reader reader;
+    const ParseResult parseResult = reader.Parse<ParseFlags>(stream, handler);
+    if (!parseResult.IsError())
+        value = ea::move(result);
+    return parseResult;
+}
+
 }
 
 bool JSONFile::BeginLoad(Deserializer& source)
@@ -126,15 +148,17 @@ bool JSONFile::BeginLoad(Deserializer& source)
         return false;
     buffer[dataSize] = '\0';
 
-    rapidjson::Document document;
-    if (document.Parse<kParseCommentsFlag | kParseTrailingCommasFlag>(buffer.get()).HasParseError())
+    // Buffer is owned by the loader, so strings may be decoded in place
+    InsituStringStream stream(buffer.get());
+    const ParseResult result =
+        ParseToJSONValue<kParseInsituFlag | kParseCommentsFlag | kParseTrailingCommasFlag>(stream, root_);
+    if (result.IsError())
     {
-        URHO3D_LOGERROR("Could not parse JSON data from " + source.GetName());
+        URHO3D_LOGERROR("Could not parse JSON data from {} at offset {}: {}", source.GetName(), result.Offset(),
+            GetParseError_En(result.Code()));
         return false;
     }
 
-    ToJSONValue(root_, document);
-
     SetMemoryUse(dataSize);
 
     return true;
@@ -273,15 +297,15 @@ bool JSONFile::FromString(const ea::string & source)
 
 bool JSONFile::ParseJSON(const ea::string& json, JSONValue& value, bool reportError)
 {
-    rapidjson::Document document;
-    if (document.Parse<0>(json.c_str()).HasParseError())
+    StringStream stream(json.c_str());
+    const ParseResult result = ParseToJSONValue<kParseDefaultFlags>(stream, value);
+    if (result.IsError())
     {
         if (reportError)
-            URHO3D_LOGERRORF("Could not parse JSON data from string with error: %s", document.GetParseError());
+            URHO3D_LOGERROR("Could not parse JSON data from string with error: {}", GetParseError_En(result.Code()));
 
         return false;
     }
-    ToJSONValue(value, document);
     return true;
 }
 
@@ -144,6 +144,12 @@ bool Resource::EndLoad()
     return true;
 }
 
+EndLoadStatus Resource::EndLoadPartial(unsigned long long& uploadBudget)
+{
+    uploadBudget -= ea::min(uploadBudget, GetEndLoadUploadSize());
+    return EndLoad() ? EndLoadStatus::Finished : EndLoadStatus::Failed;
+}
+
 bool Resource::Save(Serializer& dest) const
 {
     URHO3D_LOGERROR("Save not supported for " + GetTypeName());
@@ -80,6 +80,17 @@ enum AsyncLoadState
     ASYNC_FAIL = 4
 };
 
+/// Status of partial finalization of resource loading.
+enum class EndLoadStatus
+{
+    /// Loading failed.
+    Failed,
+    /// Loading succeeded.
+    Finished,
+    /// Some work is remaining, finalization should be continued later.
+    Pending
+};
+
 /// Base class for resources.
 /// @templateversion
 class URHO3D_API Resource : public Object
@@ -97,8 +108,17 @@ public:
     bool Load(Deserializer& source);
     /// Load resource from stream. May be called from a worker thread. Return true if successful.
     virtual bool BeginLoad(Deserializer& source);
+    /// Perform the part of EndLoad() that doesn't need the main thread, e.g. create GPU resources with initial data.
+    /// Called from the worker thread after successful BeginLoad() during background loading. Return true if successful.
+    virtual bool EndLoadInWorkerThread() { return true; }
     /// Finish resource loading. Always called from the main thread. Return true if successful.
     virtual bool EndLoad();
+    /// Finish resource loading in parts, uploading approximately the budgeted amount of bytes to GPU at once.
+    /// Budget is decreased by the amount of uploaded data. At least some work is done even if the budget is exhausted.
+    /// Always called from the main thread. Default implementation calls EndLoad().
+    virtual EndLoadStatus EndLoadPartial(unsigned long long& uploadBudget);
+    /// Return approximate amount of data uploaded to GPU by the remaining EndLoad() work, in bytes.
+    virtual unsigned long long GetEndLoadUploadSize() const { return 0; }
     /// Save resource. Return true if successful.
     virtual bool Save(Serializer& dest) const;
 
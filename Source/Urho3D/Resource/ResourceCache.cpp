@@ -85,7 +85,8 @@ ResourceCache::ResourceCache(Context* context) :
     Object(context),
     returnFailedResources_(false),
     searchPackagesFirst_(true),
-    finishBackgroundResourcesMs_(5)
+    finishBackgroundResourcesMs_(5),
+    finishBackgroundResourcesBytes_(32 * 1024 * 1024)
 {
     // Register Resource library object factories
     RegisterResourceLibrary(context_);
@@ -126,7 +127,7 @@ bool ResourceCache::AddManualResource(Resource* resource)
     }
 
     resource->ResetUseTimer();
-    resourceGroups_[resource->GetType()].resources_[resource->GetNameHash()] = resource;
+    StoreResource(resource->GetType(), resource->GetNameHash(), resource);
     UpdateResourceGroup(resource->GetType());
     return true;
 }
@@ -141,6 +142,7 @@ void ResourceCache::ReleaseResource(StringHash type, const ea::string& name, boo
     // If other references exist, do not release, unless forced
     if ((existingRes.Refs() == 1 && existingRes.WeakRefs() == 0) || force)
     {
+        ForgetResource(type, nameHash);
         resourceGroups_[type].resources_.erase(nameHash);
         UpdateResourceGroup(type);
     }
@@ -165,6 +167,7 @@ void ResourceCache::ReleaseResource(const ea::string& resourceName, bool force)
                     // If other references exist, do not release, unless forced
                     if ((current->second.Refs() == 1 && current->second.WeakRefs() == 0) || force)
                     {
+                        ForgetResource(i->first, current->first);
                         j = i->second.resources_.erase(current);
                         released = true;
                         continue;
@@ -193,6 +196,7 @@ void ResourceCache::ReleaseResources(StringHash type, bool force)
             // If other references exist, do not release, unless forced
             if ((current->second.Refs() == 1 && current->second.WeakRefs() == 0) || force)
             {
+                ForgetResource(i->first, current->first);
                 i->second.resources_.erase(current);
                 released = true;
             }
@@ -219,6 +223,7 @@ void ResourceCache::ReleaseResources(StringHash type, const ea::string& partialN
                 // If other references exist, do not release, unless forced
                 if ((current->second.Refs() == 1 && current->second.WeakRefs() == 0) || force)
                 {
+                    ForgetResource(i->first, current->first);
                     i->second.resources_.erase(current);
                     released = true;
                 }
@@ -251,6 +256,7 @@ void ResourceCache::ReleaseResources(const ea::string& partialName, bool force)
                     // If other references exist, do not release, unless forced
                     if ((current->second.Refs() == 1 && current->second.WeakRefs() == 0) || force)
                     {
+                        ForgetResource(i->first, current->first);
                         i->second.resources_.erase(current);
                         released = true;
                     }
@@ -280,6 +286,7 @@ void ResourceCache::ReleaseAllResources(bool force)
                 // If other references exist, do not release, unless forced
                 if ((current->second.Refs() == 1 && current->second.WeakRefs() == 0) || force)
                 {
+                    ForgetResource(i->first, current->first);
                     i->second.resources_.erase(current);
                     released = true;
                 }
@@ -426,20 +433,13 @@ Resource* ResourceCache::GetExistingResource(StringHash type, const ea::string&
 {
     ea::string sanitatedName = SanitateResourceName(name);
 
-    if (!Thread::IsMainThread())
-    {
-        URHO3D_LOGERROR("Attempted to get resource " + sanitatedName + " from outside the main thread");
-        return nullptr;
-    }
-
     // If empty name, return null pointer immediately
     if (sanitatedName.empty())
         return nullptr;
 
     StringHash nameHash(sanitatedName);
 
-    const SharedPtr<Resource>& existing = type != StringHash::Empty ? FindResource(type, nameHash) : FindResource(nameHash);
-    return existing;
+    return LookupResource(type, nameHash);
 }
 
 Resource* ResourceCache::GetResource(StringHash type, const ea::string& name, bool sendEventOnFailure)
@@ -457,6 +457,7 @@ Resource* ResourceCache::GetResource(StringHash type, const ea::string& name, bo
         return nullptr;
 
     StringHash nameHash(sanitatedName);
+    RecordResource(type, sanitatedName);
 
 #ifdef URHO3D_THREADING
     // Check if the resource is being background loaded but is now needed immediately
@@ -513,13 +514,13 @@ Resource* ResourceCache::GetResource(StringHash type, const ea::string& name, bo
 
     // Store to cache
     resource->ResetUseTimer();
-    resourceGroups_[type].resources_[nameHash] = resource;
+    StoreResource(type, nameHash, resource);
     UpdateResourceGroup(type);
 
     return resource;
 }
 
-bool ResourceCache::BackgroundLoadResource(StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller)
+bool ResourceCache::BackgroundLoadResource(StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller, float priority)
 {
 #ifdef URHO3D_THREADING
     // If empty name, fail immediately
@@ -529,10 +530,11 @@ bool ResourceCache::BackgroundLoadResource(StringHash type, const ea::string& na
 
     // First check if already exists as a loaded resource
     StringHash nameHash(sanitatedName);
+    RecordResource(type, sanitatedName);
     if (FindResource(type, nameHash) != noResource)
         return false;
 
-    return backgroundLoader_->QueueResource(type, sanitatedName, sendEventOnFailure, caller);
+    return backgroundLoader_->QueueResource(type, sanitatedName, sendEventOnFailure, caller, priority);
 #else
     // When threading not supported, fall back to synchronous loading
     return GetResource(type, name, sendEventOnFailure);
@@ -593,6 +595,22 @@ SharedPtr<Resource> ResourceCache::GetTempResource(StringHash type, const ea::st
     return resource;
 }
 
+void ResourceCache::SetNumBackgroundLoadThreads(unsigned numThreads)
+{
+#ifdef URHO3D_THREADING
+    backgroundLoader_->SetNumThreads(numThreads);
+#endif
+}
+
+unsigned ResourceCache::GetNumBackgroundLoadThreads() const
+{
+#ifdef URHO3D_THREADING
+    return backgroundLoader_->GetNumThreads();
+#else
+    return 0;
+#endif
+}
+
 unsigned ResourceCache::GetNumBackgroundLoadResources() const
 {
 #ifdef URHO3D_THREADING
@@ -754,6 +772,81 @@ ea::string ResourceCache::PrintMemoryUsage() const
     return output;
 }
 
+void ResourceCache::StartResourceRecording()
+{
+    MutexLock lock(resourceMutex_);
+
+    recordingResources_ = true;
+    recordedResources_.clear();
+    recordedResourceNames_.clear();
+}
+
+ea::vector<ResourceRef> ResourceCache::StopResourceRecording()
+{
+    MutexLock lock(resourceMutex_);
+
+    recordingResources_ = false;
+    recordedResourceNames_.clear();
+    return ea::move(recordedResources_);
+}
+
+bool ResourceCache::IsRecordingResources() const
+{
+    MutexLock lock(resourceMutex_);
+    return recordingResources_;
+}
+
+void ResourceCache::RecordResource(StringHash type, const ea::string& name)
+{
+    MutexLock lock(resourceMutex_);
+
+    if (recordingResources_ && recordedResourceNames_.insert(name).second)
+        recordedResources_.emplace_back(type, name);
+}
+
+void ResourceCache::StoreResource(StringHash type, StringHash nameHash, Resource* resource)
+{
+    ForgetResource(type, nameHash);
+
+    LookupShard& shard = GetLookupShard(nameHash);
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+        shard.resources_.emplace(nameHash, ea::make_pair(type, resource));
+    }
+
+    resourceGroups_[type].resources_[nameHash] = resource;
+}
+
+void ResourceCache::ForgetResource(StringHash type, StringHash nameHash)
+{
+    LookupShard& shard = GetLookupShard(nameHash);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+
+    const auto [begin, end] = shard.resources_.equal_range(nameHash);
+    for (auto iter = begin; iter != end; ++iter)
+    {
+        if (iter->second.first == type)
+        {
+            shard.resources_.erase(iter);
+            break;
+        }
+    }
+}
+
+Resource* ResourceCache::LookupResource(StringHash type, StringHash nameHash) const
+{
+    const LookupShard& shard = GetLookupShard(nameHash);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+
+    const auto [begin, end] = shard.resources_.equal_range(nameHash);
+    for (auto iter = begin; iter != end; ++iter)
+    {
+        if (type == StringHash::Empty || iter->second.first == type)
+            return iter->second.second;
+    }
+    return nullptr;
+}
+
 const SharedPtr<Resource>& ResourceCache::FindResource(StringHash type, StringHash nameHash)
 {
     MutexLock lock(resourceMutex_);
@@ -802,6 +895,7 @@ void ResourceCache::ReleasePackageResources(PackageFile* package, bool force)
                 // If other references exist, do not release, unless forced
                 if ((k->second.Refs() == 1 && k->second.WeakRefs() == 0) || force)
                 {
+                    ForgetResource(j->first, k->first);
                     j->second.resources_.erase(k);
                     affectedGroups.insert(j->first);
                 }
@@ -847,6 +941,7 @@ void ResourceCache::UpdateResourceGroup(StringHash type)
         {
             URHO3D_LOGDEBUG("Resource group " + oldestResource->second->GetTypeName() + " over memory budget, releasing resource " +
                      oldestResource->second->GetName());
+            ForgetResource(i->first, oldestResource->first);
             i->second.resources_.erase(oldestResource);
         }
         else
@@ -860,7 +955,7 @@ void ResourceCache::HandleBeginFrame(StringHash eventType, VariantMap& eventData
 #ifdef URHO3D_THREADING
     {
         URHO3D_PROFILE("FinishBackgroundResources");
-        backgroundLoader_->FinishResources(finishBackgroundResourcesMs_);
+        backgroundLoader_->FinishResources(finishBackgroundResourcesMs_, finishBackgroundResourcesBytes_);
     }
 #endif
 }
@@ -970,6 +1065,11 @@ void ResourceCache::RouteResourceName(FileIdentifier& name) const
 
 void ResourceCache::Clear()
 {
+    for (LookupShard& shard : lookupShards_)
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+        shard.resources_.clear();
+    }
     resourceGroups_.clear();
     dependentResources_.clear();
 }
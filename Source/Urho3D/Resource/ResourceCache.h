@@ -31,9 +31,13 @@
 #include "Urho3D/IO/ScanFlags.h"
 #include "Urho3D/Resource/Resource.h"
 
+#include <EASTL/array.h>
 #include <EASTL/hash_set.h>
+#include <EASTL/unordered_map.h>
 #include <EASTL/unique_ptr.h>
 
+#include <shared_mutex>
+
 namespace Urho3D
 {
 
@@ -124,6 +128,13 @@ public:
     /// Set how many milliseconds maximum per frame to spend on finishing background loaded resources.
     /// @property
     void SetFinishBackgroundResourcesMs(int ms) { finishBackgroundResourcesMs_ = Max(ms, 1); }
+    /// Set how many bytes maximum per frame to upload to GPU when finishing background loaded resources.
+    /// At least one resource or part of resource is finished per frame regardless of the budget.
+    /// @property
+    void SetFinishBackgroundResourcesBytes(unsigned long long bytes) { finishBackgroundResourcesBytes_ = ea::max(bytes, 1ull); }
+    /// Set number of threads used for background loading of resources.
+    /// @property
+    void SetNumBackgroundLoadThreads(unsigned numThreads);
 
     /// Add a resource router object. By default there is none, so the routing process is skipped.
     void AddResourceRouter(ResourceRouter* router, bool addAsFirst = false);
@@ -137,18 +148,27 @@ public:
     /// Load a resource without storing it in the resource cache. Return null if not found or if fails. Can be called from outside the main thread if the resource itself is safe to load completely (it does not possess for example GPU data).
     SharedPtr<Resource> GetTempResource(StringHash type, const ea::string& name, bool sendEventOnFailure = true);
     /// Background load a resource. An event will be sent when complete. Return true if successfully stored to the load queue, false if eg. already exists. Can be called from outside the main thread.
-    bool BackgroundLoadResource(StringHash type, const ea::string& name, bool sendEventOnFailure = true, Resource* caller = nullptr);
+    /// Resources with higher priority are loaded first, e.g. negated distance to the camera may be used as priority.
+    bool BackgroundLoadResource(StringHash type, const ea::string& name, bool sendEventOnFailure = true, Resource* caller = nullptr, float priority = 0.0f);
     /// Return number of pending background-loaded resources.
     /// @property
     unsigned GetNumBackgroundLoadResources() const;
     /// Return all loaded resources of a specific type.
     void GetResources(ea::vector<Resource*>& result, StringHash type) const;
     /// Return an already loaded resource of specific type & name, or null if not found. Will not load if does not exist. Specifying zero type will search all types.
+    /// Can be called from outside the main thread. The caller is responsible for keeping the resource alive, the main thread may release it at any moment.
     Resource* GetExistingResource(StringHash type, const ea::string& name);
 
     /// Return all loaded resources.
     const ea::unordered_map<StringHash, ResourceGroup>& GetAllResources() const { return resourceGroups_; }
 
+    /// Start recording resources requested by GetResource and BackgroundLoadResource. Clears previous recording.
+    void StartResourceRecording();
+    /// Stop recording. Return requested resources in order of the first request.
+    ea::vector<ResourceRef> StopResourceRecording();
+    /// Return whether requested resources are being recorded.
+    bool IsRecordingResources() const;
+
     /// Template version of returning a resource by name.
     template <class T> T* GetResource(const ea::string& name, bool sendEventOnFailure = true);
     /// Template version of returning an existing resource by name.
@@ -158,7 +178,7 @@ public:
     /// Template version of releasing a resource by name.
     template <class T> void ReleaseResource(const ea::string& resourceName, bool force = false);
     /// Template version of queueing a resource background load.
-    template <class T> bool BackgroundLoadResource(const ea::string& name, bool sendEventOnFailure = true, Resource* caller = nullptr);
+    template <class T> bool BackgroundLoadResource(const ea::string& name, bool sendEventOnFailure = true, Resource* caller = nullptr, float priority = 0.0f);
     /// Template version of returning loaded resources of a specific type.
     template <class T> void GetResources(ea::vector<T*>& result) const;
     /// Return whether a file exists in the resource directories or package files. Does not check manually added in-memory resources.
@@ -186,6 +206,12 @@ public:
     /// Return how many milliseconds maximum to spend on finishing background loaded resources.
     /// @property
     int GetFinishBackgroundResourcesMs() const { return finishBackgroundResourcesMs_; }
+    /// Return how many bytes maximum per frame to upload to GPU when finishing background loaded resources.
+    /// @property
+    unsigned long long GetFinishBackgroundResourcesBytes() const { return finishBackgroundResourcesBytes_; }
+    /// Return number of threads used for background loading of resources.
+    /// @property
+    unsigned GetNumBackgroundLoadThreads() const;
 
     /// Return a resource router by index.
     ResourceRouter* GetResourceRouter(unsigned index) const;
@@ -220,6 +246,27 @@ public:
     FileIdentifier GetResolvedIdentifier(const FileIdentifier& name) const;
 
 private:
+    /// Number of independently locked parts of the concurrent resource lookup.
+    static const unsigned NumLookupShards = 16;
+
+    /// Part of the concurrent resource lookup. Resources are not owned, ResourceGroup keeps them alive.
+    struct LookupShard
+    {
+        mutable std::shared_mutex mutex_;
+        ea::unordered_multimap<StringHash, ea::pair<StringHash, Resource*>> resources_;
+    };
+
+    /// Store resource to the group and to the concurrent lookup. Overwrites existing resource.
+    void StoreResource(StringHash type, StringHash nameHash, Resource* resource);
+    /// Remove resource from the concurrent lookup. Should be called before the resource is removed from the group.
+    void ForgetResource(StringHash type, StringHash nameHash);
+    /// Find a resource in the concurrent lookup. Specifying zero type will search all types. Can be called from any thread.
+    Resource* LookupResource(StringHash type, StringHash nameHash) const;
+    /// Record requested resource if recording is enabled. Can be called from any thread.
+    void RecordResource(StringHash type, const ea::string& name);
+    /// Return lookup shard for the resource name.
+    LookupShard& GetLookupShard(StringHash nameHash) const { return lookupShards_[nameHash.Value() % NumLookupShards]; }
+
     /// Find a resource.
     const SharedPtr<Resource>& FindResource(StringHash type, StringHash nameHash);
     /// Find a resource by name only. Searches all type groups.
@@ -237,6 +284,8 @@ private:
     mutable Mutex resourceMutex_;
     /// Resources by type.
     ea::unordered_map<StringHash, ResourceGroup> resourceGroups_;
+    /// Resources by name, for lookup from any thread without blocking the main thread.
+    mutable ea::array<LookupShard, NumLookupShards> lookupShards_;
     /// Dependent resources. Only used with automatic reload to eg. trigger reload of a cube texture when any of its faces change.
     ea::unordered_map<StringHash, ea::hash_set<StringHash> > dependentResources_;
     /// Resource background loader.
@@ -249,6 +298,14 @@ private:
     bool searchPackagesFirst_;
     /// How many milliseconds maximum per frame to spend on finishing background loaded resources.
     int finishBackgroundResourcesMs_;
+    /// How many bytes maximum per frame to upload to GPU when finishing background loaded resources.
+    unsigned long long finishBackgroundResourcesBytes_;
+    /// Whether requested resources are recorded.
+    bool recordingResources_{};
+    /// Recorded resources in order of the first request.
+    ea::vector<ResourceRef> recordedResources_;
+    /// Names of recorded resources.
+    ea::hash_set<ea::string> recordedResourceNames_;
     /// List of resources that will not be auto-reloaded if reloading event triggers.
     ea::vector<ea::string> ignoreResourceAutoReload_;
 };
@@ -277,10 +334,10 @@ template <class T> SharedPtr<T> ResourceCache::GetTempResource(const ea::string&
     return StaticCast<T>(GetTempResource(type, name, sendEventOnFailure));
 }
 
-template <class T> bool ResourceCache::BackgroundLoadResource(const ea::string& name, bool sendEventOnFailure, Resource* caller)
+template <class T> bool ResourceCache::BackgroundLoadResource(const ea::string& name, bool sendEventOnFailure, Resource* caller, float priority)
 {
     StringHash type = T::GetTypeStatic();
-    return BackgroundLoadResource(type, name, sendEventOnFailure, caller);
+    return BackgroundLoadResource(type, name, sendEventOnFailure, caller, priority);
 }
 
 template <class T> void ResourceCache::GetResources(ea::vector<T*>& result) const
@@ -85,11 +85,17 @@ bool XMLFile::BeginLoad(Deserializer& source)
         return false;
     }
 
-    ea::shared_array<char> buffer(new char[dataSize]);
-    if (source.Read(buffer.get(), dataSize) != dataSize)
+    // Document takes ownership of the buffer and parses it in place instead of copying it
+    auto buffer = static_cast<char*>(pugi::get_memory_allocation_function()(ea::max(dataSize, 1u)));
+    if (!buffer)
         return false;
+    if (source.Read(buffer, dataSize) != dataSize)
+    {
+        pugi::get_memory_deallocation_function()(buffer);
+        return false;
+    }
 
-    if (!document_->load_buffer(buffer.get(), dataSize))
+    if (!document_->load_buffer_inplace_own(buffer, dataSize))
     {
         URHO3D_LOGERROR("Could not parse XML data from " + source.GetName());
         document_->reset();
@@ -67,12 +67,54 @@ struct CachedRmlTexture
     SharedPtr<Texture2D> texture_;
 };
 
+/// Internal RmlUI compiled geometry holder.
+struct CompiledRmlGeometry
+{
+    SharedPtr<VertexBuffer> vertexBuffer_;
+    SharedPtr<IndexBuffer> indexBuffer_;
+    Rml::TextureHandle texture_{};
+};
+
 /// Wrap CachedRmlTexture pointer to RmlUI handle.
 Rml::TextureHandle WrapTextureHandle(CachedRmlTexture* texture) { return reinterpret_cast<Rml::TextureHandle>(texture); }
 
 /// Unwrap RmlUI handle to CachedRmlTexture pointer.
 CachedRmlTexture* UnwrapTextureHandle(Rml::TextureHandle texture) { return reinterpret_cast<CachedRmlTexture*>(texture); }
 
+/// Wrap CompiledRmlGeometry pointer to RmlUI handle.
+Rml::CompiledGeometryHandle WrapGeometryHandle(CompiledRmlGeometry* geometry) { return reinterpret_cast<Rml::CompiledGeometryHandle>(geometry); }
+
+/// Unwrap RmlUI handle to CompiledRmlGeometry pointer.
+CompiledRmlGeometry* UnwrapGeometryHandle(Rml::CompiledGeometryHandle geometry) { return reinterpret_cast<CompiledRmlGeometry*>(geometry); }
+
+/// Copy RmlUI vertices to internal format.
+void CopyVertices(RmlVertex* destVertices, const Rml::Vertex* vertices, int numVertices, const Rml::Vector2f& translation)
+{
+    for (int i = 0; i < numVertices; ++i)
+    {
+        destVertices[i].position_.x_ = vertices[i].position.x + translation.x;
+        destVertices[i].position_.y_ = vertices[i].position.y + translation.y;
+        destVertices[i].position_.z_ = 0.0f;
+        const Rml::Colourb& color = vertices[i].colour;
+        destVertices[i].color_ = (color.alpha << 24u) | (color.blue << 16u) | (color.green << 8u) | color.red;
+        destVertices[i].texCoord_.x_ = vertices[i].tex_coord.x;
+        destVertices[i].texCoord_.y_ = vertices[i].tex_coord.y;
+    }
+}
+
+/// Return texture and restore its data if lost.
+Texture2D* GetRestoredTexture(Rml::TextureHandle textureHandle)
+{
+    CachedRmlTexture* cachedTexture = UnwrapTextureHandle(textureHandle);
+    Texture2D* texture = cachedTexture ? cachedTexture->texture_ : nullptr;
+    if (texture && texture->IsDataLost())
+    {
+        texture->SetData(cachedTexture->image_);
+        texture->ClearDataLost();
+    }
+    return texture;
+}
+
 /// Roughly transform scissor rect.
 IntRect TransformScissorRect(const IntRect& rect, const Matrix3x4& transform)
 {
@@ -118,6 +160,9 @@ void RmlRenderer::BeginRendering()
 
     drawQueue_->SetVertexBuffers({vertexBuffer});
     drawQueue_->SetIndexBuffer(indexBuffer);
+    currentVertexBuffer_ = vertexBuffer;
+    currentIndexBuffer_ = indexBuffer;
+    pendingBatch_ = {};
 
     batchStateCreateContext_.vertexBuffer_ = vertexBuffer;
     batchStateCreateContext_.indexBuffer_ = indexBuffer;
@@ -158,6 +203,7 @@ void RmlRenderer::EndRendering()
     RenderContext* renderContext = renderDevice->GetRenderContext();
     const RenderScope renderScope(renderContext, "RmlRenderer::EndRendering");
 
+    FlushBatch();
     vertexBuffer_->Commit();
     indexBuffer_->Commit();
     renderContext->Execute(drawQueue_);
@@ -199,35 +245,122 @@ Material* RmlRenderer::GetBatchMaterial(Texture2D* texture)
 void RmlRenderer::RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices,
     Rml::TextureHandle textureHandle, const Rml::Vector2f& translation)
 {
-    auto renderDevice = GetSubsystem<RenderDevice>();
-    RenderContext* renderContext = renderDevice->GetRenderContext();
-
     const auto [firstVertex, vertexData] = vertexBuffer_->AddVertices(num_vertices);
     const auto [firstIndex, indexData] = indexBuffer_->AddIndices(num_indices);
 
-    RmlVertex* destVertices = reinterpret_cast<RmlVertex*>(vertexData);
-    for (unsigned i = 0; i < num_vertices; ++i)
-    {
-        destVertices[i].position_.x_ = vertices[i].position.x + translation.x;
-        destVertices[i].position_.y_ = vertices[i].position.y + translation.y;
-        destVertices[i].position_.z_ = 0.0f;
-        const Rml::Colourb& color = vertices[i].colour;
-        destVertices[i].color_ = (color.alpha << 24u) | (color.blue << 16u) | (color.green << 8u) | color.red;
-        destVertices[i].texCoord_.x_ = vertices[i].tex_coord.x;
-        destVertices[i].texCoord_.y_ = vertices[i].tex_coord.y;
-    }
+    CopyVertices(reinterpret_cast<RmlVertex*>(vertexData), vertices, num_vertices, translation);
 
     unsigned* destIndices = reinterpret_cast<unsigned*>(indexData);
     for (unsigned i = 0; i < num_indices; ++i)
         destIndices[i] = indices[i] + firstVertex;
 
-    // Restore texture data if lost
-    CachedRmlTexture* cachedTexture = UnwrapTextureHandle(textureHandle);
-    Texture2D* texture = cachedTexture ? cachedTexture->texture_ : nullptr;
-    if (texture && texture->IsDataLost())
+    Batch batch;
+    batch.vertexBuffer_ = vertexBuffer_->GetVertexBuffer();
+    batch.indexBuffer_ = indexBuffer_->GetIndexBuffer();
+    batch.texture_ = GetRestoredTexture(textureHandle);
+    batch.scissor_ = GetCurrentScissor();
+    batch.transform_ = transform_;
+    batch.firstIndex_ = firstIndex;
+    batch.numIndices_ = num_indices;
+    AddBatch(batch);
+}
+
+Rml::CompiledGeometryHandle RmlRenderer::CompileGeometry(Rml::Vertex* vertices, int num_vertices, int* indices,
+    int num_indices, Rml::TextureHandle textureHandle)
+{
+    if (!GetSubsystem<RenderDevice>() || num_vertices <= 0 || num_indices <= 0)
+        return 0;
+
+    ea::vector<RmlVertex> vertexData(num_vertices);
+    CopyVertices(vertexData.data(), vertices, num_vertices, Rml::Vector2f{0.0f, 0.0f});
+
+    auto geometry = new CompiledRmlGeometry{};
+    geometry->texture_ = textureHandle;
+
+    geometry->vertexBuffer_ = MakeShared<VertexBuffer>(context_);
+    geometry->vertexBuffer_->SetDebugName("RmlCompiledGeometry");
+    geometry->vertexBuffer_->SetShadowed(true);
+    geometry->vertexBuffer_->SetSize(num_vertices, MASK_POSITION | MASK_COLOR | MASK_TEXCOORD1);
+    geometry->vertexBuffer_->Update(vertexData.data());
+
+    geometry->indexBuffer_ = MakeShared<IndexBuffer>(context_);
+    geometry->indexBuffer_->SetDebugName("RmlCompiledGeometry");
+    geometry->indexBuffer_->SetShadowed(true);
+    geometry->indexBuffer_->SetSize(num_indices, true);
+    geometry->indexBuffer_->Update(indices);
+
+    return WrapGeometryHandle(geometry);
+}
+
+void RmlRenderer::RenderCompiledGeometry(Rml::CompiledGeometryHandle geometryHandle, const Rml::Vector2f& translation)
+{
+    CompiledRmlGeometry* geometry = UnwrapGeometryHandle(geometryHandle);
+    if (!geometry)
+        return;
+
+    Batch batch;
+    batch.vertexBuffer_ = geometry->vertexBuffer_;
+    batch.indexBuffer_ = geometry->indexBuffer_;
+    batch.texture_ = GetRestoredTexture(geometry->texture_);
+    batch.scissor_ = GetCurrentScissor();
+    batch.transform_ = transform_ * Matrix3x4(Vector3(translation.x, translation.y, 0.0f), Quaternion::IDENTITY, 1.0f);
+    batch.firstIndex_ = 0;
+    batch.numIndices_ = geometry->indexBuffer_->GetIndexCount();
+    AddBatch(batch);
+}
+
+void RmlRenderer::ReleaseCompiledGeometry(Rml::CompiledGeometryHandle geometryHandle)
+{
+    CompiledRmlGeometry* geometry = UnwrapGeometryHandle(geometryHandle);
+    delete geometry;
+}
+
+IntRect RmlRenderer::GetCurrentScissor() const
+{
+    if (!scissorEnabled_)
+        return IntRect{IntVector2::ZERO, viewportSize_};
+    else if (transformEnabled_)
+        return TransformScissorRect(scissor_, transform_);
+    else
+        return scissor_;
+}
+
+void RmlRenderer::AddBatch(const Batch& batch)
+{
+    // Consecutive dynamic geometry with the same state is drawn with one call
+    const bool isContinuous = pendingBatch_.indexBuffer_ == batch.indexBuffer_
+        && pendingBatch_.firstIndex_ + pendingBatch_.numIndices_ == batch.firstIndex_;
+    if (pendingBatch_.numIndices_ > 0 && isContinuous && pendingBatch_.vertexBuffer_ == batch.vertexBuffer_
+        && pendingBatch_.texture_ == batch.texture_ && pendingBatch_.scissor_ == batch.scissor_
+        && pendingBatch_.transform_.Equals(batch.transform_))
     {
-        texture->SetData(cachedTexture->image_);
-        texture->ClearDataLost();
+        pendingBatch_.numIndices_ += batch.numIndices_;
+        return;
+    }
+
+    FlushBatch();
+    pendingBatch_ = batch;
+}
+
+void RmlRenderer::FlushBatch()
+{
+    if (pendingBatch_.numIndices_ == 0)
+        return;
+
+    auto renderDevice = GetSubsystem<RenderDevice>();
+    RenderContext* renderContext = renderDevice->GetRenderContext();
+    const Batch& batch = pendingBatch_;
+    Texture2D* texture = batch.texture_;
+
+    if (currentVertexBuffer_ != batch.vertexBuffer_)
+    {
+        drawQueue_->SetVertexBuffers({batch.vertexBuffer_});
+        currentVertexBuffer_ = batch.vertexBuffer_;
+    }
+    if (currentIndexBuffer_ != batch.indexBuffer_)
+    {
+        drawQueue_->SetIndexBuffer(batch.indexBuffer_);
+        currentIndexBuffer_ = batch.indexBuffer_;
     }
 
     Material* material = GetBatchMaterial(texture);
@@ -240,15 +373,7 @@ void RmlRenderer::RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* i
         pass, BLEND_ALPHA, samplerStateHash};
     PipelineState* pipelineState = batchStateCache_->GetOrCreatePipelineState(batchStateKey, batchStateCreateContext_);
 
-    IntRect scissor;
-    if (!scissorEnabled_)
-        scissor = IntRect{IntVector2::ZERO, viewportSize_};
-    else if (transformEnabled_)
-        scissor = TransformScissorRect(scissor_, transform_);
-    else
-        scissor = scissor_;
-
-    drawQueue_->SetScissorRect(scissor);
+    drawQueue_->SetScissorRect(batch.scissor_);
     drawQueue_->SetPipelineState(pipelineState);
 
     if (texture)
@@ -272,11 +397,12 @@ void RmlRenderer::RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* i
 
     if (drawQueue_->BeginShaderParameterGroup(SP_OBJECT, true))
     {
-        drawQueue_->AddShaderParameter(VSP_MODEL, transform_);
+        drawQueue_->AddShaderParameter(VSP_MODEL, batch.transform_);
         drawQueue_->CommitShaderParameterGroup(SP_OBJECT);
     }
 
-    drawQueue_->DrawIndexed(firstIndex, num_indices);
+    drawQueue_->DrawIndexed(batch.firstIndex_, batch.numIndices_);
+    pendingBatch_ = {};
 }
 
 void RmlRenderer::EnableScissorRegion(bool enable)
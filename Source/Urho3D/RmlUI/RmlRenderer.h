@@ -35,7 +35,9 @@ class Context;
 class DrawCommandQueue;
 class DynamicIndexBuffer;
 class DynamicVertexBuffer;
+class IndexBuffer;
 class Texture2D;
+class VertexBuffer;
 
 namespace Detail
 {
@@ -57,15 +59,36 @@ public:
     bool LoadTexture(Rml::TextureHandle& textureOut, Rml::Vector2i& sizeOut, const Rml::String& source) override;
 
     void RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture, const Rml::Vector2f& translation) override;
+    Rml::CompiledGeometryHandle CompileGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture) override;
+    void RenderCompiledGeometry(Rml::CompiledGeometryHandle geometry, const Rml::Vector2f& translation) override;
+    void ReleaseCompiledGeometry(Rml::CompiledGeometryHandle geometry) override;
     void EnableScissorRegion(bool enable) override;
     void SetScissorRegion(int x, int y, int width, int height) override;
     void SetTransform(const Rml::Matrix4f* transform) override;
     /// @}
 
 private:
+    /// Indexed draw call that may be merged with adjacent draw calls.
+    struct Batch
+    {
+        VertexBuffer* vertexBuffer_{};
+        IndexBuffer* indexBuffer_{};
+        Texture2D* texture_{};
+        IntRect scissor_;
+        Matrix3x4 transform_;
+        unsigned firstIndex_{};
+        unsigned numIndices_{};
+    };
+
     /// Perform initialization tasks that require graphics subsystem.
     void InitializeGraphics();
     Material* GetBatchMaterial(Texture2D* texture);
+    /// Return current scissor rectangle in viewport space.
+    IntRect GetCurrentScissor() const;
+    /// Merge batch with pending batch or replace it.
+    void AddBatch(const Batch& batch);
+    /// Submit pending batch to draw queue.
+    void FlushBatch();
 
     /// Default materials
     /// @{
@@ -92,6 +115,10 @@ private:
     Matrix4 projection_;
     /// @}
 
+    Batch pendingBatch_;
+    VertexBuffer* currentVertexBuffer_{};
+    IndexBuffer* currentIndexBuffer_{};
+
     bool scissorEnabled_ = false;
     IntRect scissor_;
 
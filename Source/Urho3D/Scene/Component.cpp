@@ -62,6 +62,15 @@ Component::Component(Context* context) :
 
 Component::~Component() = default;
 
+void Component::OnRecycle()
+{
+    assert(!node_);
+
+    Serializable::OnRecycle();
+    id_ = 0;
+    networkUpdate_ = false;
+}
+
 AttributeScopeHint Component::GetEffectiveScopeHint() const
 {
     // Don't use Serializable::GetReflection() to avoid effect from overrides.
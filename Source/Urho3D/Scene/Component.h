@@ -110,6 +110,8 @@ public:
     unsigned GetIndexInParent() const;
 
 protected:
+    /// Reset the component before it is returned to the object pool.
+    void OnRecycle() override;
     /// Handle scene node being assigned at creation.
     virtual void OnNodeSet(Node* previousNode, Node* currentNode);
     /// Handle scene being assigned. This may happen several times during the component's lifetime. Scene-wide subsystems and events are subscribed to here.
@@ -0,0 +1,365 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Precompiled.h>
+
+#include <Urho3D/Scene/CookedPrefab.h>
+
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+
+#include <EASTL/map.h>
+
+#include <atomic>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+enum SerializableFlag : unsigned char
+{
+    Temporary = 1 << 0,
+};
+
+/// Read number of elements. Each element takes at least one byte, so larger counts indicate corrupted data.
+bool ReadCount(Deserializer& source, unsigned& count)
+{
+    count = source.ReadVLE();
+    return count <= source.GetSize() - source.Tell();
+}
+
+/// Identifier and type of attribute value. Attribute names are stored as hashes.
+struct SchemaAttribute
+{
+    bool isId_{};
+    unsigned key_{};
+    VariantType type_{};
+
+    explicit SchemaAttribute(const AttributePrefab& attribute)
+        : isId_(attribute.GetIdentifierType() == AttributePrefab::IdentifierType::Id)
+        , key_(isId_ ? static_cast<unsigned>(attribute.GetId()) : attribute.GetNameHash().Value())
+        , type_(attribute.GetType())
+    {
+    }
+
+    SchemaAttribute() = default;
+};
+
+/// Attribute layout of serializable. Identifiers and types of attributes in order of values.
+struct SerializableSchema
+{
+    StringHash typeNameHash_;
+    ea::string typeName_;
+    ea::vector<SchemaAttribute> attributes_;
+};
+
+class CookedPrefabWriter
+{
+public:
+    void WriteRoot(Serializer& dest, const NodePrefab& prefab)
+    {
+        // Root children are written into separate buffers to store their sizes
+        VectorBuffer rootBuffer;
+        WriteSerializable(rootBuffer, prefab.GetNode());
+        WriteComponents(rootBuffer, prefab);
+
+        const auto& children = prefab.GetChildren();
+        ea::vector<VectorBuffer> childBuffers(children.size());
+        for (unsigned i = 0; i < children.size(); ++i)
+            WriteNode(childBuffers[i], children[i]);
+
+        dest.Write(CookedPrefab::Magic.data(), BinaryMagicSize);
+        dest.WriteUInt(CookedPrefab::Version);
+
+        dest.WriteVLE(schemas_.size());
+        for (const SerializableSchema& schema : schemas_)
+        {
+            dest.WriteStringHash(schema.typeNameHash_);
+            dest.WriteString(schema.typeName_);
+            dest.WriteVLE(schema.attributes_.size());
+            for (const SchemaAttribute& attribute : schema.attributes_)
+            {
+                dest.WriteBool(attribute.isId_);
+                dest.WriteUInt(attribute.key_);
+                dest.WriteUByte(static_cast<unsigned char>(attribute.type_));
+            }
+        }
+
+        dest.Write(rootBuffer.GetData(), rootBuffer.GetSize());
+        dest.WriteVLE(childBuffers.size());
+        for (const VectorBuffer& childBuffer : childBuffers)
+        {
+            dest.WriteUInt(childBuffer.GetSize());
+            dest.Write(childBuffer.GetData(), childBuffer.GetSize());
+        }
+    }
+
+private:
+    void WriteNode(Serializer& dest, const NodePrefab& prefab)
+    {
+        WriteSerializable(dest, prefab.GetNode());
+        WriteComponents(dest, prefab);
+
+        const auto& children = prefab.GetChildren();
+        dest.WriteVLE(children.size());
+        for (const NodePrefab& child : children)
+            WriteNode(dest, child);
+    }
+
+    void WriteComponents(Serializer& dest, const NodePrefab& prefab)
+    {
+        const auto& components = prefab.GetComponents();
+        dest.WriteVLE(components.size());
+        for (const SerializablePrefab& component : components)
+            WriteSerializable(dest, component);
+    }
+
+    void WriteSerializable(Serializer& dest, const SerializablePrefab& prefab)
+    {
+        dest.WriteVLE(GetOrCreateSchema(prefab));
+        dest.WriteVLE(static_cast<unsigned>(prefab.GetId()));
+        dest.WriteUByte(prefab.IsTemporary() ? Temporary : 0);
+        for (const AttributePrefab& attribute : prefab.GetAttributes())
+            dest.WriteVariantData(attribute.GetValue());
+    }
+
+    unsigned GetOrCreateSchema(const SerializablePrefab& prefab)
+    {
+        SerializableSchema schema;
+        schema.typeNameHash_ = prefab.GetTypeNameHash();
+        schema.typeName_ = prefab.GetTypeName();
+        for (const AttributePrefab& attribute : prefab.GetAttributes())
+            schema.attributes_.emplace_back(attribute);
+
+        ea::vector<unsigned> key;
+        key.reserve(2 + 2 * schema.attributes_.size());
+        key.push_back(schema.typeNameHash_.Value());
+        key.push_back(StringHash{schema.typeName_}.Value());
+        for (const SchemaAttribute& attribute : schema.attributes_)
+        {
+            key.push_back(attribute.key_);
+            key.push_back(attribute.type_ | (attribute.isId_ ? 0x80000000u : 0u));
+        }
+
+        const auto [iter, isNew] = schemaIndices_.emplace(ea::move(key), schemas_.size());
+        if (isNew)
+            schemas_.push_back(ea::move(schema));
+        return iter->second;
+    }
+
+    ea::vector<SerializableSchema> schemas_;
+    ea::map<ea::vector<unsigned>, unsigned> schemaIndices_;
+};
+
+class CookedPrefabReader
+{
+public:
+    CookedPrefabReader(Context* context, const ea::vector<SerializableSchema>& schemas)
+        : context_(context)
+        , schemas_(schemas)
+    {
+    }
+
+    bool ReadNode(Deserializer& source, NodePrefab& prefab)
+    {
+        if (!ReadSerializable(source, prefab.GetMutableNode()) || !ReadComponents(source, prefab))
+            return false;
+
+        unsigned numChildren{};
+        if (!ReadCount(source, numChildren))
+            return false;
+
+        auto& children = prefab.GetMutableChildren();
+        children.resize(numChildren);
+        for (NodePrefab& child : children)
+        {
+            if (!ReadNode(source, child))
+                return false;
+        }
+        return true;
+    }
+
+    bool ReadComponents(Deserializer& source, NodePrefab& prefab)
+    {
+        unsigned numComponents{};
+        if (!ReadCount(source, numComponents))
+            return false;
+
+        auto& components = prefab.GetMutableComponents();
+        components.resize(numComponents);
+        for (SerializablePrefab& component : components)
+        {
+            if (!ReadSerializable(source, component))
+                return false;
+        }
+        return true;
+    }
+
+    bool ReadSerializable(Deserializer& source, SerializablePrefab& prefab)
+    {
+        const unsigned schemaIndex = source.ReadVLE();
+        if (schemaIndex >= schemas_.size())
+            return false;
+
+        const SerializableSchema& schema = schemas_[schemaIndex];
+        if (!schema.typeName_.empty())
+            prefab.SetType(schema.typeName_);
+        else
+            prefab.SetType(schema.typeNameHash_);
+        prefab.SetId(static_cast<SerializableId>(source.ReadVLE()));
+        prefab.SetTemporary(!!(source.ReadUByte() & Temporary));
+
+        auto& attributes = prefab.GetMutableAttributes();
+        attributes.clear();
+        attributes.reserve(schema.attributes_.size());
+        for (const SchemaAttribute& schemaAttribute : schema.attributes_)
+        {
+            AttributePrefab& attribute = schemaAttribute.isId_
+                ? attributes.emplace_back(static_cast<AttributeId>(schemaAttribute.key_))
+                : attributes.emplace_back(StringHash{schemaAttribute.key_});
+            attribute.SetValue(source.ReadVariant(schemaAttribute.type_, context_));
+        }
+        return true;
+    }
+
+private:
+    Context* context_{};
+    const ea::vector<SerializableSchema>& schemas_;
+};
+
+}
+
+const BinaryMagic CookedPrefab::Magic{{'C', 'P', 'F', 'B'}};
+
+bool CookedPrefab::Save(Serializer& dest, const NodePrefab& prefab)
+{
+    CookedPrefabWriter writer;
+    writer.WriteRoot(dest, prefab);
+    return true;
+}
+
+bool CookedPrefab::IsCooked(ConstByteSpan data)
+{
+    return data.size() >= BinaryMagicSize && ea::equal(Magic.begin(), Magic.end(), data.begin());
+}
+
+bool CookedPrefab::Load(Context* context, ConstByteSpan data, NodePrefab& prefab, WorkQueue* workQueue)
+{
+    URHO3D_PROFILE("LoadCookedPrefab");
+
+    prefab.Clear();
+    if (!IsCooked(data))
+    {
+        URHO3D_LOGERROR("Data is not a cooked prefab");
+        return false;
+    }
+
+    MemoryBuffer source(data.data(), data.size());
+    source.Seek(BinaryMagicSize);
+    const unsigned version = source.ReadUInt();
+    if (version != Version)
+    {
+        URHO3D_LOGERROR("Cooked prefab version {} is not supported, expected {}", version, Version);
+        return false;
+    }
+
+    // Partially loaded prefab is not returned
+    const auto corrupted = [&]()
+    {
+        URHO3D_LOGERROR("Cooked prefab is corrupted");
+        prefab.Clear();
+        return false;
+    };
+
+    unsigned numSchemas{};
+    if (!ReadCount(source, numSchemas))
+        return corrupted();
+
+    ea::vector<SerializableSchema> schemas(numSchemas);
+    for (SerializableSchema& schema : schemas)
+    {
+        schema.typeNameHash_ = source.ReadStringHash();
+        schema.typeName_ = source.ReadString();
+
+        unsigned numAttributes{};
+        if (!ReadCount(source, numAttributes))
+            return corrupted();
+
+        schema.attributes_.resize(numAttributes);
+        for (SchemaAttribute& attribute : schema.attributes_)
+        {
+            attribute.isId_ = source.ReadBool();
+            attribute.key_ = source.ReadUInt();
+            attribute.type_ = static_cast<VariantType>(source.ReadUByte());
+            if (attribute.type_ >= MAX_VAR_TYPES)
+                return corrupted();
+        }
+    }
+
+    CookedPrefabReader reader(context, schemas);
+    if (!reader.ReadSerializable(source, prefab.GetMutableNode()) || !reader.ReadComponents(source, prefab))
+        return corrupted();
+
+    // Locate subtrees first, they are independent and may be decoded in any order
+    unsigned numSubtrees{};
+    if (!ReadCount(source, numSubtrees))
+        return corrupted();
+
+    ea::vector<ConstByteSpan> subtrees(numSubtrees);
+    for (ConstByteSpan& subtree : subtrees)
+    {
+        const unsigned size = source.ReadUInt();
+        if (source.Tell() + size > source.GetSize())
+            return corrupted();
+        subtree = data.subspan(source.Tell(), size);
+        source.SeekRelative(static_cast<int>(size));
+    }
+
+    auto& children = prefab.GetMutableChildren();
+    children.resize(subtrees.size());
+    std::atomic_bool success{true};
+    const auto decodeSubtrees = [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            MemoryBuffer subtreeSource(subtrees[i].data(), subtrees[i].size());
+            // Subtree should be consumed exactly
+            if (!reader.ReadNode(subtreeSource, children[i]) || subtreeSource.Tell() != subtreeSource.GetSize())
+                success = false;
+        }
+    };
+
+    if (workQueue)
+        ForEachParallel(workQueue, 1, subtrees.size(), decodeSubtrees);
+    else
+        decodeSubtrees(0, subtrees.size());
+
+    if (!success)
+        return corrupted();
+    return true;
+}
+
+} // namespace Urho3D
@@ -0,0 +1,57 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include <Urho3D/Container/ByteVector.h>
+#include <Urho3D/Resource/Resource.h>
+#include <Urho3D/Scene/NodePrefab.h>
+
+namespace Urho3D
+{
+
+class Serializer;
+class WorkQueue;
+
+/// Cooked binary format of NodePrefab optimized for loading speed.
+/// Attribute layout of each distinct serializable type is stored once in the schema table.
+/// Nodes and components store schema index followed by a contiguous block of attribute values,
+/// without per-attribute descriptors and identifiers.
+/// Subtrees of the root node are stored with their sizes and may be decoded in parallel.
+/// Attributes are identified by name hashes, so the data stays valid when attributes are added or reordered.
+class URHO3D_API CookedPrefab
+{
+public:
+    /// Magic word of cooked prefab.
+    static const BinaryMagic Magic;
+    /// Version of the format. Data of other versions is rejected.
+    static const unsigned Version = 1;
+
+    /// Save prefab in cooked format.
+    static bool Save(Serializer& dest, const NodePrefab& prefab);
+    /// Load prefab from cooked data. Subtrees of the root node are decoded in parallel if work queue is provided.
+    static bool Load(Context* context, ConstByteSpan data, NodePrefab& prefab, WorkQueue* workQueue = nullptr);
+    /// Return whether the data starts with cooked prefab magic word.
+    static bool IsCooked(ConstByteSpan data);
+};
+
+} // namespace Urho3D
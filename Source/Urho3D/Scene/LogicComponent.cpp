@@ -37,11 +37,16 @@ LogicComponent::LogicComponent(Context* context) :
     Component(context),
     updateEventMask_(USE_UPDATE | USE_POSTUPDATE | USE_FIXEDUPDATE | USE_FIXEDPOSTUPDATE),
     currentEventMask_(0),
+    parallelUpdateEventMask_(USE_NO_EVENT),
+    currentParallelEventMask_(USE_NO_EVENT),
     delayedStartCalled_(false)
 {
 }
 
-LogicComponent::~LogicComponent() = default;
+LogicComponent::~LogicComponent()
+{
+    RemoveParallelSubscriptions();
+}
 
 void LogicComponent::OnSetEnabled()
 {
@@ -78,6 +83,15 @@ void LogicComponent::SetUpdateEventMask(UpdateEventFlags mask)
     }
 }
 
+void LogicComponent::SetParallelUpdateEventMask(UpdateEventFlags mask)
+{
+    if (parallelUpdateEventMask_ != mask)
+    {
+        parallelUpdateEventMask_ = mask;
+        UpdateEventSubscription();
+    }
+}
+
 void LogicComponent::OnNodeSet(Node* previousNode, Node* currentNode)
 {
     if (node_)
@@ -98,8 +112,9 @@ void LogicComponent::OnSceneSet(Scene* scene)
         UpdateEventSubscription();
     else
     {
-        UnsubscribeFromEvent(E_SCENEUPDATE);
+        UnsubscribeFromEvent<SceneUpdateTypedEvent>();
         UnsubscribeFromEvent(GetPostUpdateEvent());
+        RemoveParallelSubscriptions();
 #if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
         UnsubscribeFromEvent(E_PHYSICSPRESTEP);
         UnsubscribeFromEvent(E_PHYSICSPOSTSTEP);
@@ -116,19 +131,27 @@ void LogicComponent::UpdateEventSubscription()
 
     bool enabled = IsEnabledEffective();
 
-    bool needUpdate = enabled && ((updateEventMask_ & USE_UPDATE) || !delayedStartCalled_);
+    // DelayedStart is always called from the serial update
+    const bool needAnyUpdate = enabled && ((updateEventMask_ & USE_UPDATE) || !delayedStartCalled_);
+    const bool needParallelUpdate = needAnyUpdate && delayedStartCalled_ && (parallelUpdateEventMask_ & USE_UPDATE);
+    const bool needUpdate = needAnyUpdate && !needParallelUpdate;
+    UpdateParallelSubscription(scene, USE_UPDATE, needParallelUpdate);
     if (needUpdate && !(currentEventMask_ & USE_UPDATE))
     {
-        SubscribeToEvent(scene, E_SCENEUPDATE, URHO3D_HANDLER(LogicComponent, HandleSceneUpdate));
+        SubscribeToEvent<SceneUpdateTypedEvent>(scene, &LogicComponent::HandleSceneUpdate);
         currentEventMask_ |= USE_UPDATE;
     }
     else if (!needUpdate && (currentEventMask_ & USE_UPDATE))
     {
-        UnsubscribeFromEvent(scene, E_SCENEUPDATE);
+        UnsubscribeFromEvent<SceneUpdateTypedEvent>();
         currentEventMask_ &= ~USE_UPDATE;
     }
 
-    bool needPostUpdate = enabled && (updateEventMask_ & USE_POSTUPDATE);
+    const bool needAnyPostUpdate = enabled && (updateEventMask_ & USE_POSTUPDATE);
+    const bool needParallelPostUpdate = needAnyPostUpdate && (parallelUpdateEventMask_ & USE_POSTUPDATE)
+        && GetPostUpdateEvent() == E_SCENEPOSTUPDATE;
+    const bool needPostUpdate = needAnyPostUpdate && !needParallelPostUpdate;
+    UpdateParallelSubscription(scene, USE_POSTUPDATE, needParallelPostUpdate);
     if (needPostUpdate && !(currentEventMask_ & USE_POSTUPDATE))
     {
         SubscribeToEvent(scene, GetPostUpdateEvent(), URHO3D_HANDLER(LogicComponent, HandleScenePostUpdate));
@@ -171,10 +194,8 @@ void LogicComponent::UpdateEventSubscription()
 #endif
 }
 
-void LogicComponent::HandleSceneUpdate(StringHash eventType, VariantMap& eventData)
+void LogicComponent::HandleSceneUpdate(const SceneUpdateTypedEvent& event)
 {
-    using namespace SceneUpdate;
-
     // Execute user-defined delayed start function before first update
     if (!delayedStartCalled_)
     {
@@ -184,14 +205,58 @@ void LogicComponent::HandleSceneUpdate(StringHash eventType, VariantMap& eventDa
         // If did not need actual update events, unsubscribe now
         if (!(updateEventMask_ & USE_UPDATE))
         {
-            UnsubscribeFromEvent(GetScene(), E_SCENEUPDATE);
+            UnsubscribeFromEvent<SceneUpdateTypedEvent>();
             currentEventMask_ &= ~USE_UPDATE;
             return;
         }
+
+        // Switch to parallel update, it is executed later in the same frame
+        if (parallelUpdateEventMask_ & USE_UPDATE)
+        {
+            UpdateEventSubscription();
+            if (currentParallelEventMask_ & USE_UPDATE)
+                return;
+        }
     }
 
     // Then execute user-defined update function
-    Update(eventData[P_TIMESTEP].GetFloat());
+    Update(event.timeStep_);
+}
+
+void LogicComponent::UpdateParallelSubscription(Scene* scene, UpdateEvent phase, bool enable)
+{
+    if (enable == !!(currentParallelEventMask_ & phase))
+        return;
+
+    if (enable)
+    {
+        // Remove from the previous scene if moved
+        if (parallelUpdateScene_ && parallelUpdateScene_ != scene)
+            RemoveParallelSubscriptions();
+
+        scene->AddParallelUpdate(this, phase);
+        parallelUpdateScene_ = scene;
+        currentParallelEventMask_ |= phase;
+    }
+    else
+    {
+        if (parallelUpdateScene_)
+            parallelUpdateScene_->RemoveParallelUpdate(this, phase);
+        currentParallelEventMask_ &= ~phase;
+    }
+}
+
+void LogicComponent::RemoveParallelSubscriptions()
+{
+    if (parallelUpdateScene_)
+    {
+        if (currentParallelEventMask_ & USE_UPDATE)
+            parallelUpdateScene_->RemoveParallelUpdate(this, USE_UPDATE);
+        if (currentParallelEventMask_ & USE_POSTUPDATE)
+            parallelUpdateScene_->RemoveParallelUpdate(this, USE_POSTUPDATE);
+    }
+    parallelUpdateScene_ = nullptr;
+    currentParallelEventMask_ = USE_NO_EVENT;
 }
 
 void LogicComponent::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
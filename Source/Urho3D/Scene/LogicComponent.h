@@ -30,6 +30,8 @@
 namespace Urho3D
 {
 
+struct SceneUpdateTypedEvent;
+
 enum UpdateEvent : unsigned
 {
     /// Bitmask for not using any events.
@@ -85,6 +87,14 @@ class URHO3D_API LogicComponent : public Component
     /// Return what update events are subscribed to.
     UpdateEventFlags GetUpdateEventMask() const { return updateEventMask_; }
 
+    /// Set what update events are thread-safe and may be invoked from worker threads in parallel with other components.
+    /// Only USE_UPDATE and USE_POSTUPDATE are supported, the latter only for default post update event.
+    /// Parallel Update() and PostUpdate() should not send events, node creation and removal should be deferred
+    /// via Scene::DeferAction. DelayedStart() is always called from the main thread.
+    void SetParallelUpdateEventMask(UpdateEventFlags mask);
+    /// Return what update events may be invoked in parallel.
+    UpdateEventFlags GetParallelUpdateEventMask() const { return parallelUpdateEventMask_; }
+
     /// Return whether the DelayedStart() function has been called.
     bool IsDelayedStartCalled() const { return delayedStartCalled_; }
 
@@ -97,8 +107,12 @@ protected:
 private:
     /// Subscribe/unsubscribe to update events based on current enabled state and update event mask.
     void UpdateEventSubscription();
+    /// Add to or remove from the parallel update phase of the scene.
+    void UpdateParallelSubscription(Scene* scene, UpdateEvent phase, bool enable);
+    /// Remove from all parallel update phases.
+    void RemoveParallelSubscriptions();
     /// Handle scene update event.
-    void HandleSceneUpdate(StringHash eventType, VariantMap& eventData);
+    void HandleSceneUpdate(const SceneUpdateTypedEvent& event);
     /// Handle scene post-update event.
     void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
 #if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
@@ -111,6 +125,12 @@ private:
     UpdateEventFlags updateEventMask_;
     /// Current event subscription mask.
     UpdateEventFlags currentEventMask_;
+    /// Requested parallel update mask.
+    UpdateEventFlags parallelUpdateEventMask_;
+    /// Current parallel update mask.
+    UpdateEventFlags currentParallelEventMask_;
+    /// Scene where the component is registered for parallel update.
+    WeakPtr<Scene> parallelUpdateScene_;
     /// Flag for delayed start.
     bool delayedStartCalled_;
 };
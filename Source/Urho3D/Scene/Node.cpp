@@ -74,6 +74,23 @@ Node::~Node()
         scene_->NodeRemoved(this);
 }
 
+void Node::OnRecycle()
+{
+    RemoveAllChildren();
+    RemoveAllComponents();
+
+    if (scene_)
+        scene_->NodeRemoved(this);
+
+    Serializable::OnRecycle();
+    id_ = 0;
+    enabledPrev_ = true;
+    listeners_.clear();
+    impl_->dependencyNodes_.clear();
+    impl_->attrBuffer_.Clear();
+    MarkDirty();
+}
+
 void Node::RegisterObject(Context* context)
 {
     context->AddFactoryReflection<Node>();
@@ -930,6 +947,8 @@ void Node::MarkDirty()
         if (cur->dirty_)
             return;
         cur->dirty_ = true;
+        if (cur->scene_)
+            cur->scene_->NodeTransformDirty(cur->transformIndex_);
 
         // Notify listener components first, then mark child nodes
         for (auto i = cur->listeners_.begin(); i !=
@@ -1019,6 +1038,8 @@ void Node::AddChild(Node* node, unsigned index)
         scene_->NodeAdded(node);
 
     node->parent_ = this;
+    if (scene_)
+        scene_->NodeReparented();
     node->MarkDirty();
 
     // Send change event
@@ -1199,6 +1220,19 @@ void Node::ReorderChild(Node* child, unsigned index)
     SharedPtr<Node> childShared(child);
     children_.erase_first(childShared);
     children_.insert_at(index, childShared);
+
+    // Send change event
+    if (scene_)
+    {
+        using namespace NodeReordered;
+
+        VariantMap& eventData = GetEventDataMap();
+        eventData[P_SCENE] = scene_;
+        eventData[P_PARENT] = this;
+        eventData[P_NODE] = child;
+
+        scene_->SendEvent(E_NODEREORDERED, eventData);
+    }
 }
 
 void Node::ReorderComponent(Component* component, unsigned index)
@@ -1212,6 +1246,19 @@ void Node::ReorderComponent(Component* component, unsigned index)
     SharedPtr<Component> componentShared(component);
     components_.erase_first(componentShared);
     components_.insert_at(index, componentShared);
+
+    // Send change event
+    if (scene_)
+    {
+        using namespace ComponentReordered;
+
+        VariantMap& eventData = GetEventDataMap();
+        eventData[P_SCENE] = scene_;
+        eventData[P_NODE] = this;
+        eventData[P_COMPONENT] = component;
+
+        scene_->SendEvent(E_COMPONENTREORDERED, eventData);
+    }
 }
 
 Node* Node::Clone(Node* parent)
@@ -1919,7 +1966,10 @@ bool Node::LoadJSON(const JSONValue& source, SceneResolver& resolver, bool loadC
 
 Node* Node::CreateChild(unsigned id, bool temporary)
 {
-    SharedPtr<Node> newNode(MakeShared<Node>(context_));
+    // Go through the reflection so recycled nodes are reused if the pool is enabled
+    SharedPtr<Node> newNode{static_cast<Node*>(context_->CreateObject(Node::GetTypeStatic()).Get())};
+    if (!newNode)
+        newNode = MakeShared<Node>(context_);
     newNode->SetTemporary(temporary);
 
     // If zero ID specified, or the ID is already taken, let the scene assign
@@ -90,6 +90,7 @@ class URHO3D_API Node : public Serializable
     URHO3D_OBJECT(Node, Serializable);
 
     friend class Connection;
+    friend class TransformHierarchy;
 
 public:
     /// Construct.
@@ -806,6 +807,8 @@ private:
     Vector3 scale_;
     /// World-space rotation.
     mutable Quaternion worldRotation_;
+    /// Index in the flat transform hierarchy of the scene.
+    unsigned transformIndex_{M_MAX_UNSIGNED};
     /// Components.
     ea::vector<SharedPtr<Component> > components_;
     /// Child scene nodes.
@@ -816,6 +819,9 @@ private:
     ea::unique_ptr<NodeImpl> impl_;
 
 protected:
+    /// Reset the node before it is returned to the object pool.
+    void OnRecycle() override;
+
     /// User variables.
     StringVariantMap vars_;
 };
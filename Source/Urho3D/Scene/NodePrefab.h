@@ -92,6 +92,7 @@ public:
     void SetType(const char* typeName);
     void SetType(StringHash typeNameHash);
     void SetId(SerializableId id) { id_ = id; }
+    void SetTemporary(bool temporary) { temporary_ = temporary; }
 
     void Import(const Serializable* serializable, PrefabSaveFlags flags = {});
     void Export(Serializable* serializable, PrefabLoadFlags flags = {}) const;
@@ -103,6 +104,7 @@ public:
     const ea::string& GetTypeName() const { return typeName_; }
     StringHash GetTypeNameHash() const { return typeNameHash_; }
     SerializableId GetId() const { return id_; }
+    bool IsTemporary() const { return temporary_; }
     const ea::vector<AttributePrefab>& GetAttributes() const { return attributes_; }
     ea::vector<AttributePrefab>& GetMutableAttributes() { return attributes_; }
 
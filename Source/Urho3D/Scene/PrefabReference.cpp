@@ -234,8 +234,14 @@ void PrefabReference::InstantiatePrefab(const NodePrefab& nodePrefab, PrefabInst
 {
     const auto flags = PrefabLoadFlag::KeepExistingComponents | PrefabLoadFlag::KeepExistingChildren
         | PrefabLoadFlag::LoadAsTemporary | PrefabLoadFlag::IgnoreRootAttributes;
-    PrefabReaderFromMemory reader{nodePrefab};
-    node_->Load(reader, flags);
+    const PrefabTemplate* nodeTemplate = prefab_ && path_.empty() ? &prefab_->GetNodeTemplate() : nullptr;
+    if (nodeTemplate && nodeTemplate->IsValid())
+        nodeTemplate->Instantiate(node_, flags);
+    else
+    {
+        PrefabReaderFromMemory reader{nodePrefab};
+        node_->Load(reader, flags);
+    }
 
     if (instanceFlags != PrefabInstanceFlag::None)
     {
@@ -22,8 +22,13 @@
 
 #include <Urho3D/Precompiled.h>
 
+#include <Urho3D/Core/Profiler.h>
+#include <Urho3D/Core/Thread.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/IO/Log.h>
+#include <Urho3D/Resource/ResourceEvents.h>
+#include <Urho3D/Scene/CookedPrefab.h>
 #include <Urho3D/Scene/PrefabReference.h>
 #include <Urho3D/Scene/PrefabResource.h>
 #include <Urho3D/Scene/Scene.h>
@@ -36,6 +41,13 @@ namespace Urho3D
 PrefabResource::PrefabResource(Context* context)
     : SimpleResource(context)
 {
+    // Prefab may be modified in place before reload is signalled
+    SubscribeToEvent(this, E_RELOADFINISHED,
+        [this]
+    {
+        templateDirty_ = true;
+        pool_.clear();
+    });
 }
 
 PrefabResource::~PrefabResource()
@@ -61,8 +73,70 @@ Node* PrefabResource::InstantiateReference(Node* parentNode)
     return instanceNode;
 }
 
+Node* PrefabResource::Spawn(Node* parentNode, const Vector3& position, const Quaternion& rotation)
+{
+    URHO3D_PROFILE("SpawnPrefab");
+
+    const PrefabTemplate& nodeTemplate = GetNodeTemplate();
+    if (!nodeTemplate.IsValid())
+        return parentNode->InstantiatePrefab(GetNodePrefab(), position, rotation);
+
+    // Reuse recycled instance if it still matches the prefab
+    while (!pool_.empty())
+    {
+        SharedPtr<Node> node = ea::move(pool_.back());
+        pool_.pop_back();
+
+        parentNode->AddChild(node);
+        if (nodeTemplate.Reapply(node))
+        {
+            node->SetPosition(position);
+            node->SetRotation(rotation);
+            return node;
+        }
+        node->Remove();
+    }
+
+    Node* node = parentNode->CreateChild();
+    nodeTemplate.Instantiate(node, PrefabLoadFlag::DiscardIds);
+    node->SetPosition(position);
+    node->SetRotation(rotation);
+    return node;
+}
+
+void PrefabResource::Recycle(Node* node)
+{
+    if (!node)
+        return;
+
+    SharedPtr<Node> nodeHolder{node};
+    node->Remove();
+    if (pool_.size() < maxPoolSize_)
+        pool_.push_back(ea::move(nodeHolder));
+}
+
+void PrefabResource::SetMaxPoolSize(unsigned size)
+{
+    maxPoolSize_ = size;
+    if (pool_.size() > maxPoolSize_)
+        pool_.resize(maxPoolSize_);
+}
+
+const PrefabTemplate& PrefabResource::GetNodeTemplate()
+{
+    if (templateDirty_)
+    {
+        URHO3D_PROFILE("CompilePrefabTemplate");
+
+        templateDirty_ = false;
+        template_.Compile(context_, GetNodePrefab());
+    }
+    return template_;
+}
+
 void PrefabResource::NormalizeIds()
 {
+    templateDirty_ = true;
     prefab_.NormalizeIds(context_);
 
     auto& sceneAttributes = prefab_.GetMutableNode().GetMutableAttributes();
@@ -78,9 +152,39 @@ void PrefabResource::SerializeInBlock(Archive& archive)
     const bool compactSave = false;
     const auto flags = PrefabArchiveFlag::None;
 
+    if (archive.IsInput())
+        templateDirty_ = true;
+
     prefab_.SerializeInBlock(archive, flags, compactSave);
 }
 
+bool PrefabResource::BeginLoad(Deserializer& source)
+{
+    const unsigned basePosition = source.Tell();
+
+    BinaryMagic magic{};
+    const bool isCooked =
+        source.Read(magic.data(), BinaryMagicSize) == BinaryMagicSize && magic == CookedPrefab::Magic;
+    source.Seek(basePosition);
+
+    templateDirty_ = true;
+    if (!isCooked)
+        return SimpleResource::BeginLoad(source);
+
+    ByteVector data(source.GetSize() - basePosition);
+    if (source.Read(data.data(), data.size()) != data.size())
+        return false;
+
+    // Don't spawn tasks from background loading threads
+    WorkQueue* workQueue = Thread::IsMainThread() ? GetSubsystem<WorkQueue>() : nullptr;
+    return CookedPrefab::Load(context_, data, prefab_, workQueue);
+}
+
+bool PrefabResource::SaveCooked(Serializer& dest) const
+{
+    return CookedPrefab::Save(dest, prefab_);
+}
+
 const NodePrefab& PrefabResource::GetNodePrefab() const
 {
     return !prefab_.GetChildren().empty() ? prefab_.GetChildren()[0] : NodePrefab::Empty;
@@ -94,6 +198,7 @@ const NodePrefab& PrefabResource::GetNodePrefabSlice(ea::string_view path) const
 
 NodePrefab& PrefabResource::GetMutableNodePrefab()
 {
+    templateDirty_ = true;
     auto& children = prefab_.GetMutableChildren();
     if (children.empty())
         children.emplace_back();
@@ -110,6 +215,7 @@ bool PrefabResource::LoadLegacyXML(const XMLElement& source)
     if (!tempScene->LoadXML(source))
         return false;
 
+    templateDirty_ = true;
     tempScene->GeneratePrefab(prefab_);
 
     static const char* helpMessage =
@@ -24,6 +24,7 @@
 
 #include <Urho3D/Resource/Resource.h>
 #include <Urho3D/Scene/NodePrefab.h>
+#include <Urho3D/Scene/PrefabTemplate.h>
 
 namespace Urho3D
 {
@@ -37,6 +38,9 @@ class URHO3D_API PrefabResource : public SimpleResource
     URHO3D_OBJECT(PrefabResource, SimpleResource)
 
 public:
+    /// Default max number of recycled instances.
+    static const unsigned DefaultMaxPoolSize = 64;
+
     explicit PrefabResource(Context* context);
     ~PrefabResource() override;
 
@@ -44,13 +48,36 @@ public:
 
     /// Instantiate prefab into a scene or node as PrefabReference.
     Node* InstantiateReference(Node* parentNode);
+    /// Instantiate node prefab as persistent child of the node. Recycled instances are reused if available.
+    Node* Spawn(Node* parentNode, const Vector3& position = Vector3::ZERO, const Quaternion& rotation = Quaternion::IDENTITY);
+    /// Remove node spawned from this prefab from the scene and keep it for reuse.
+    void Recycle(Node* node);
+    /// Remove all recycled instances.
+    void ClearPool() { pool_.clear(); }
+    /// Set max number of recycled instances kept for reuse.
+    void SetMaxPoolSize(unsigned size);
+    /// Return max number of recycled instances kept for reuse.
+    unsigned GetMaxPoolSize() const { return maxPoolSize_; }
+    /// Return number of recycled instances available for reuse.
+    unsigned GetPoolSize() const { return pool_.size(); }
+
+    /// Return compiled template of node prefab. Template is invalid if prefab cannot be compiled.
+    const PrefabTemplate& GetNodeTemplate();
 
     void NormalizeIds();
 
     void SerializeInBlock(Archive& archive) override;
+    /// Load resource. Cooked prefabs are detected by magic word and decoded without archive.
+    bool BeginLoad(Deserializer& source) override;
+    /// Save resource in cooked binary format. Cooked prefabs are fast to load but cannot be saved back.
+    bool SaveCooked(Serializer& dest) const;
 
     const NodePrefab& GetScenePrefab() const { return prefab_; }
-    NodePrefab& GetMutableScenePrefab() { return prefab_; }
+    NodePrefab& GetMutableScenePrefab()
+    {
+        templateDirty_ = true;
+        return prefab_;
+    }
 
     const NodePrefab& GetNodePrefab() const;
     NodePrefab& GetMutableNodePrefab();
@@ -61,6 +88,12 @@ private:
     bool LoadLegacyXML(const XMLElement& source) override;
 
     NodePrefab prefab_;
+
+    PrefabTemplate template_;
+    bool templateDirty_{true};
+
+    ea::vector<SharedPtr<Node>> pool_;
+    unsigned maxPoolSize_{DefaultMaxPoolSize};
 };
 
 } // namespace Urho3D
@@ -0,0 +1,285 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include <Urho3D/Precompiled.h>
+
+#include <Urho3D/Scene/PrefabTemplate.h>
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Scene/Component.h>
+#include <Urho3D/Scene/Node.h>
+#include <Urho3D/Scene/SceneResolver.h>
+
+namespace Urho3D
+{
+
+bool PrefabTemplate::Compile(Context* context, const NodePrefab& prefab)
+{
+    Clear();
+    if (prefab.IsEmpty() || !CompileNode(context, prefab, M_MAX_UNSIGNED))
+    {
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+void PrefabTemplate::Clear()
+{
+    nodes_.clear();
+    components_.clear();
+}
+
+bool PrefabTemplate::CompileNode(Context* context, const NodePrefab& prefab, unsigned parentIndex)
+{
+    const unsigned index = nodes_.size();
+    nodes_.emplace_back();
+
+    CompiledNode compiledNode;
+    compiledNode.parentIndex_ = parentIndex;
+    if (!CompileSerializable(context, prefab.GetNode(), Node::GetTypeStatic(), compiledNode.node_))
+        return false;
+
+    compiledNode.componentsBegin_ = components_.size();
+    for (const SerializablePrefab& componentPrefab : prefab.GetComponents())
+    {
+        CompiledSerializable compiledComponent;
+        if (!CompileSerializable(context, componentPrefab, componentPrefab.GetTypeNameHash(), compiledComponent))
+            return false;
+        components_.push_back(ea::move(compiledComponent));
+    }
+    compiledNode.componentsEnd_ = components_.size();
+
+    const auto& children = prefab.GetChildren();
+    compiledNode.numChildren_ = children.size();
+    nodes_[index] = ea::move(compiledNode);
+
+    for (const NodePrefab& child : children)
+    {
+        if (!CompileNode(context, child, index))
+            return false;
+    }
+    return true;
+}
+
+bool PrefabTemplate::CompileSerializable(
+    Context* context, const SerializablePrefab& prefab, StringHash typeNameHash, CompiledSerializable& result)
+{
+    // Unknown components are not supported, they are instantiated by the generic path
+    ObjectReflection* reflection = context->GetReflection(typeNameHash);
+    if (!reflection)
+        return false;
+
+    result.reflection_ = reflection;
+    result.id_ = static_cast<unsigned>(prefab.GetId());
+    result.temporary_ = prefab.IsTemporary();
+
+    const auto& objectAttributes = reflection->GetAttributes();
+    for (const AttributePrefab& attributePrefab : prefab.GetAttributes())
+    {
+        // Same rules as SerializablePrefab::Export
+        if (attributePrefab.GetId() != AttributeId::None)
+            continue;
+
+        const unsigned attributeIndex = reflection->GetAttributeIndex(attributePrefab.GetNameHash());
+        if (attributeIndex == M_MAX_UNSIGNED)
+            continue;
+
+        const AttributeInfo& attr = objectAttributes[attributeIndex];
+        if (!attr.ShouldLoad())
+            continue;
+
+        CompiledAttribute& compiledAttribute = result.attributes_.emplace_back();
+        compiledAttribute.index_ = attributeIndex;
+        compiledAttribute.nameHash_ = attributePrefab.GetNameHash();
+
+        const Variant& value = attributePrefab.GetValue();
+        if (value.GetType() == VAR_STRING && !attr.enumNames_.empty())
+        {
+            const unsigned enumValue = attr.ConvertEnumToUInt(value.GetString());
+            if (enumValue == M_MAX_UNSIGNED)
+            {
+                URHO3D_LOGWARNING("Attribute '{}' of Serializable '{}' has unknown enum value '{}'", attr.name_,
+                    reflection->GetTypeName(), value.GetString());
+                result.attributes_.pop_back();
+                continue;
+            }
+            compiledAttribute.value_ = enumValue;
+        }
+        else
+            compiledAttribute.value_ = value;
+    }
+    return true;
+}
+
+void PrefabTemplate::ExportSerializable(
+    const CompiledSerializable& compiled, Serializable* serializable, PrefabLoadFlags flags)
+{
+    ObjectReflection* reflection = serializable->GetReflection();
+    if (!reflection)
+        return;
+
+    if (reflection != compiled.reflection_ && flags.Test(PrefabLoadFlag::CheckSerializableType)
+        && reflection->GetTypeNameHash() != compiled.reflection_->GetTypeNameHash())
+    {
+        URHO3D_LOGERROR("Serializable '{}' is not of type '{}'", reflection->GetTypeName(),
+            compiled.reflection_->GetTypeName());
+        return;
+    }
+
+    if (!flags.Test(PrefabLoadFlag::KeepTemporaryState))
+        serializable->SetTemporary(compiled.temporary_);
+
+    const auto& objectAttributes = reflection->GetAttributes();
+    if (reflection == compiled.reflection_)
+    {
+        for (const CompiledAttribute& attribute : compiled.attributes_)
+            serializable->OnSetAttribute(objectAttributes[attribute.index_], attribute.value_);
+    }
+    else
+    {
+        // Object is of derived type or reflection was changed, resolve attributes again
+        for (const CompiledAttribute& attribute : compiled.attributes_)
+        {
+            const unsigned attributeIndex = reflection->GetAttributeIndex(attribute.nameHash_, attribute.index_);
+            if (attributeIndex != M_MAX_UNSIGNED)
+                serializable->OnSetAttribute(objectAttributes[attributeIndex], attribute.value_);
+        }
+    }
+}
+
+void PrefabTemplate::Instantiate(Node* node, PrefabLoadFlags flags) const
+{
+    if (!IsValid())
+        return;
+
+    const bool discardIds = flags.Test(PrefabLoadFlag::DiscardIds);
+    const bool loadAsTemporary = flags.Test(PrefabLoadFlag::LoadAsTemporary);
+    const PrefabLoadFlags childFlags = flags & ~PrefabLoadFlag::LoadAsTemporary & ~PrefabLoadFlag::IgnoreRootAttributes;
+
+    if (!flags.Test(PrefabLoadFlag::KeepExistingComponents))
+        node->RemoveAllComponents();
+    if (!flags.Test(PrefabLoadFlag::KeepExistingChildren))
+        node->RemoveAllChildren();
+
+    SceneResolver resolver;
+    ea::vector<Node*> createdNodes(nodes_.size());
+    for (unsigned nodeIndex = 0; nodeIndex < nodes_.size(); ++nodeIndex)
+    {
+        const CompiledNode& compiledNode = nodes_[nodeIndex];
+        const bool isRoot = nodeIndex == 0;
+        const bool isRootChild = compiledNode.parentIndex_ == 0;
+
+        Node* targetNode = node;
+        if (!isRoot)
+        {
+            Node* parentNode = createdNodes[compiledNode.parentIndex_];
+            targetNode = parentNode->CreateChild(EMPTY_STRING, discardIds ? 0 : compiledNode.node_.id_);
+        }
+        createdNodes[nodeIndex] = targetNode;
+
+        const PrefabLoadFlags nodeFlags = isRoot ? flags : childFlags;
+        if (!nodeFlags.Test(PrefabLoadFlag::IgnoreRootAttributes))
+            ExportSerializable(compiledNode.node_, targetNode, nodeFlags);
+        if (isRootChild && loadAsTemporary)
+            targetNode->SetTemporary(true);
+        resolver.AddNode(compiledNode.node_.id_, targetNode);
+
+        for (unsigned i = compiledNode.componentsBegin_; i < compiledNode.componentsEnd_; ++i)
+        {
+            const CompiledSerializable& compiledComponent = components_[i];
+            Component* component = targetNode->CreateComponent(
+                compiledComponent.reflection_->GetTypeNameHash(), discardIds ? 0 : compiledComponent.id_);
+            if (!component)
+                continue;
+
+            resolver.AddComponent(compiledComponent.id_, component);
+            ExportSerializable(compiledComponent, component, nodeFlags);
+            if (isRoot && loadAsTemporary)
+                component->SetTemporary(true);
+        }
+    }
+
+    resolver.Resolve();
+    node->ApplyAttributes();
+}
+
+bool PrefabTemplate::Reapply(Node* node) const
+{
+    if (!IsValid())
+        return false;
+
+    // Match hierarchy first so it's not modified partially
+    ea::vector<Node*> targetNodes(nodes_.size());
+    targetNodes[0] = node;
+    ea::vector<unsigned> nextChildIndex(nodes_.size());
+    for (unsigned nodeIndex = 0; nodeIndex < nodes_.size(); ++nodeIndex)
+    {
+        const CompiledNode& compiledNode = nodes_[nodeIndex];
+        if (nodeIndex != 0)
+        {
+            const unsigned parentIndex = compiledNode.parentIndex_;
+            Node* parentNode = targetNodes[parentIndex];
+            Node* targetNode = parentNode->GetChild(nextChildIndex[parentIndex]++);
+            if (!targetNode)
+                return false;
+            targetNodes[nodeIndex] = targetNode;
+        }
+
+        Node* targetNode = targetNodes[nodeIndex];
+        const unsigned numComponents = compiledNode.componentsEnd_ - compiledNode.componentsBegin_;
+        if (targetNode->GetNumChildren() != compiledNode.numChildren_ || targetNode->GetNumComponents() != numComponents)
+            return false;
+
+        const auto& components = targetNode->GetComponents();
+        for (unsigned i = 0; i < numComponents; ++i)
+        {
+            if (components[i]->GetReflection() != components_[compiledNode.componentsBegin_ + i].reflection_)
+                return false;
+        }
+    }
+
+    SceneResolver resolver;
+    for (unsigned nodeIndex = 0; nodeIndex < nodes_.size(); ++nodeIndex)
+    {
+        const CompiledNode& compiledNode = nodes_[nodeIndex];
+        Node* targetNode = targetNodes[nodeIndex];
+        ExportSerializable(compiledNode.node_, targetNode, PrefabLoadFlag::None);
+        resolver.AddNode(compiledNode.node_.id_, targetNode);
+
+        const auto& components = targetNode->GetComponents();
+        for (unsigned i = compiledNode.componentsBegin_; i < compiledNode.componentsEnd_; ++i)
+        {
+            Component* component = components[i - compiledNode.componentsBegin_];
+            ExportSerializable(components_[i], component, PrefabLoadFlag::None);
+            resolver.AddComponent(components_[i].id_, component);
+        }
+    }
+
+    resolver.Resolve();
+    node->ApplyAttributes();
+    return true;
+}
+
+} // namespace Urho3D
@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include <Urho3D/Core/ObjectReflection.h>
+#include <Urho3D/Scene/NodePrefab.h>
+
+namespace Urho3D
+{
+
+class Node;
+class Serializable;
+
+/// Flattened representation of NodePrefab used for fast instantiation.
+/// Attribute names are resolved to indices in object reflections and enum names are converted to values once,
+/// so instantiation doesn't perform any string-keyed lookups. Nodes are stored in depth-first order.
+class URHO3D_API PrefabTemplate
+{
+public:
+    /// Compile template from prefab. Return false if template cannot be used, e.g. if prefab contains unknown types.
+    bool Compile(Context* context, const NodePrefab& prefab);
+    /// Reset template.
+    void Clear();
+
+    /// Load prefab into node. Equivalent of Node::Load from PrefabReaderFromMemory with the same flags.
+    void Instantiate(Node* node, PrefabLoadFlags flags = PrefabLoadFlag::None) const;
+    /// Re-apply attributes to the hierarchy previously instantiated from this template.
+    /// Return false if the hierarchy doesn't match the template.
+    bool Reapply(Node* node) const;
+
+    /// Return whether the template is compiled and can be used.
+    bool IsValid() const { return !nodes_.empty(); }
+    /// Return number of nodes in the template.
+    unsigned GetNumNodes() const { return nodes_.size(); }
+
+private:
+    struct CompiledAttribute
+    {
+        unsigned index_{};
+        StringHash nameHash_;
+        Variant value_;
+    };
+
+    struct CompiledSerializable
+    {
+        SharedPtr<ObjectReflection> reflection_;
+        unsigned id_{};
+        bool temporary_{};
+        ea::vector<CompiledAttribute> attributes_;
+    };
+
+    struct CompiledNode
+    {
+        /// Index of parent node in the template. Root node has no parent.
+        unsigned parentIndex_{M_MAX_UNSIGNED};
+        CompiledSerializable node_;
+        unsigned componentsBegin_{};
+        unsigned componentsEnd_{};
+        unsigned numChildren_{};
+    };
+
+    /// Compile node and its children recursively.
+    bool CompileNode(Context* context, const NodePrefab& prefab, unsigned parentIndex);
+    /// Compile attributes of serializable.
+    static bool CompileSerializable(
+        Context* context, const SerializablePrefab& prefab, StringHash typeNameHash, CompiledSerializable& result);
+    /// Apply compiled attributes to serializable.
+    static void ExportSerializable(const CompiledSerializable& compiled, Serializable* serializable, PrefabLoadFlags flags);
+
+    ea::vector<CompiledNode> nodes_;
+    ea::vector<CompiledSerializable> components_;
+};
+
+} // namespace Urho3D
@@ -27,6 +27,7 @@
 #include "Urho3D/Core/Context.h"
 #include "Urho3D/Core/CoreEvents.h"
 #include "Urho3D/Core/Profiler.h"
+#include "Urho3D/Core/Thread.h"
 #include "Urho3D/Core/WorkQueue.h"
 #include "Urho3D/Graphics/Texture2D.h"
 #include "Urho3D/IO/Archive.h"
@@ -38,9 +39,11 @@
 #include "Urho3D/Resource/XMLArchive.h"
 #include "Urho3D/Resource/XMLFile.h"
 #include "Urho3D/Scene/Component.h"
+#include "Urho3D/Scene/LogicComponent.h"
 #include "Urho3D/Scene/ObjectAnimation.h"
 #include "Urho3D/Scene/PrefabReference.h"
 #include "Urho3D/Scene/PrefabResource.h"
+#include "Urho3D/Scene/SceneChunkStreamer.h"
 #include "Urho3D/Scene/SceneEvents.h"
 #include "Urho3D/Scene/SceneResource.h"
 #include "Urho3D/Scene/ShakeComponent.h"
@@ -97,19 +100,23 @@ void Scene::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Next Component ID", unsigned, replicatedComponentID_, FIRST_REPLICATED_ID, AM_DEFAULT | AM_NOEDIT);
     URHO3D_ATTRIBUTE("Variables", StringVariantMap, vars_, Variant::emptyStringVariantMap, AM_DEFAULT); // Network replication of vars uses custom data
     URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Variable Names", GetVarNamesAttr, SetVarNamesAttr, ea::string, EMPTY_STRING, AM_DEFAULT | AM_NOEDIT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Batched Transform Update", IsBatchedTransformUpdate, SetBatchedTransformUpdate, bool, false, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Lightmaps", ResourceRefList, lightmaps_, ReloadLightmaps, ResourceRefList(Texture2D::GetTypeStatic()), AM_DEFAULT);
 }
 
 bool Scene::CreateComponentIndex(StringHash componentType)
 {
-    if (!IsEmpty())
-    {
-        URHO3D_LOGERROR("Component Index may be created only for empty Scene");
-        return false;
-    }
+    if (indexedComponentTypes_.contains(componentType))
+        return true;
 
     indexedComponentTypes_.push_back(componentType);
-    componentIndexes_.emplace_back();
+    SceneComponentIndex& index = componentIndexes_.emplace_back();
+
+    for (const auto& [id, component] : replicatedComponents_)
+    {
+        if (component->GetType() == componentType)
+            index.Insert(component);
+    }
     return true;
 }
 
@@ -388,6 +395,9 @@ bool Scene::LoadAsync(AbstractFilePtr file, LoadMode mode)
     asyncProgress_.loadedNodes_ = asyncProgress_.totalNodes_ = asyncProgress_.loadedResources_ = asyncProgress_.totalResources_ = 0;
     asyncProgress_.resources_.clear();
 
+    if (mode != LOAD_SCENE)
+        BeginPreloadResources(file->GetName());
+
     if (mode > LOAD_RESOURCES_ONLY)
     {
         // Preload resources if appropriate, then return to the original position for loading the scene content
@@ -452,6 +462,9 @@ bool Scene::LoadAsyncXML(AbstractFilePtr file, LoadMode mode)
     asyncProgress_.loadedNodes_ = asyncProgress_.totalNodes_ = asyncProgress_.loadedResources_ = asyncProgress_.totalResources_ = 0;
     asyncProgress_.resources_.clear();
 
+    if (mode != LOAD_SCENE)
+        BeginPreloadResources(file->GetName());
+
     if (mode > LOAD_RESOURCES_ONLY)
     {
         XMLElement rootElement = xml->GetRoot();
@@ -521,6 +534,9 @@ bool Scene::LoadAsyncJSON(AbstractFilePtr file, LoadMode mode)
     asyncProgress_.loadedNodes_ = asyncProgress_.totalNodes_ = asyncProgress_.loadedResources_ = asyncProgress_.totalResources_ = 0;
     asyncProgress_.resources_.clear();
 
+    if (mode != LOAD_SCENE)
+        BeginPreloadResources(file->GetName());
+
     if (mode > LOAD_RESOURCES_ONLY)
     {
         JSONValue rootVal = json->GetRoot();
@@ -569,6 +585,13 @@ void Scene::StopAsyncLoading()
     asyncProgress_.jsonIndex_ = 0;
     asyncProgress_.resources_.clear();
     resolver_.Reset();
+
+    // Discard incomplete recording
+    if (asyncProgress_.recordingResources_)
+    {
+        asyncProgress_.recordingResources_ = false;
+        GetSubsystem<ResourceCache>()->StopResourceRecording();
+    }
 }
 
 Node* Scene::Instantiate(Deserializer& source, const Vector3& position, const Quaternion& rotation)
@@ -790,7 +813,9 @@ void Scene::Update(float timeStep)
     eventData[P_TIMESTEP] = timeStep;
 
     // Update variable timestep logic
+    SendEvent(SceneUpdateTypedEvent{this, timeStep});
     SendEvent(E_SCENEUPDATE, eventData);
+    RunParallelUpdate(USE_UPDATE, timeStep);
 
     // Update scene attribute animation.
     SendEvent(E_ATTRIBUTEANIMATIONUPDATE, eventData);
@@ -800,6 +825,9 @@ void Scene::Update(float timeStep)
 
     // Post-update variable timestep logic
     SendEvent(E_SCENEPOSTUPDATE, eventData);
+    RunParallelUpdate(USE_POSTUPDATE, timeStep);
+
+    UpdateWorldTransforms();
 
     // Note: using a float for elapsed time accumulation is inherently inaccurate. The purpose of this value is
     // primarily to update material animation effects, as it is available to shaders. It can be reset by calling
@@ -807,6 +835,23 @@ void Scene::Update(float timeStep)
     elapsedTime_ += timeStep;
 }
 
+void Scene::SetBatchedTransformUpdate(bool enable)
+{
+    if (enable == IsBatchedTransformUpdate())
+        return;
+
+    if (enable)
+        transformHierarchy_ = ea::make_unique<TransformHierarchy>();
+    else
+        transformHierarchy_ = nullptr;
+}
+
+void Scene::UpdateWorldTransforms()
+{
+    if (transformHierarchy_)
+        transformHierarchy_->Update(this, GetSubsystem<WorkQueue>());
+}
+
 void Scene::BeginThreadedUpdate()
 {
     // Check the work queue subsystem whether it actually has created worker threads. If not, do not enter threaded mode.
@@ -838,6 +883,77 @@ void Scene::DelayedMarkedDirty(Component* component)
     delayedDirtyComponents_.push_back(component);
 }
 
+void Scene::AddParallelUpdate(LogicComponent* component, UpdateEvent phase)
+{
+    GetParallelUpdateComponents(phase).emplace_back(component);
+}
+
+void Scene::RemoveParallelUpdate(LogicComponent* component, UpdateEvent phase)
+{
+    auto& components = GetParallelUpdateComponents(phase);
+    const auto iter = ea::find_if(components.begin(), components.end(),
+        [component](const WeakPtr<LogicComponent>& other) { return other.Get() == component; });
+    if (iter != components.end())
+        *iter = nullptr;
+}
+
+void Scene::DeferAction(ea::function<void()> action)
+{
+    if (!parallelUpdate_ && Thread::IsMainThread())
+    {
+        action();
+        return;
+    }
+
+    MutexLock lock(deferredActionsMutex_);
+    deferredActions_.push_back(ea::move(action));
+}
+
+ea::vector<WeakPtr<LogicComponent>>& Scene::GetParallelUpdateComponents(UpdateEvent phase)
+{
+    URHO3D_ASSERT(phase == USE_UPDATE || phase == USE_POSTUPDATE);
+    return phase == USE_UPDATE ? parallelUpdateComponents_ : parallelPostUpdateComponents_;
+}
+
+void Scene::RunParallelUpdate(UpdateEvent phase, float timeStep)
+{
+    auto& components = GetParallelUpdateComponents(phase);
+    ea::erase_if(components, [](const WeakPtr<LogicComponent>& component) { return !component; });
+    if (components.empty())
+        return;
+
+    URHO3D_PROFILE("ParallelUpdate");
+
+    static const unsigned ChunkSize = 16;
+
+    // Components are not added or removed during the phase, structural changes are deferred
+    BeginThreadedUpdate();
+    parallelUpdate_ = true;
+    ForEachParallel(GetSubsystem<WorkQueue>(), ChunkSize, components.size(),
+        [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            LogicComponent* component = components[i];
+            if (phase == USE_UPDATE)
+                component->Update(timeStep);
+            else
+                component->PostUpdate(timeStep);
+        }
+    });
+    parallelUpdate_ = false;
+    EndThreadedUpdate();
+
+    // Apply deferred structural changes in the main thread
+    ea::vector<ea::function<void()>> actions;
+    {
+        MutexLock lock(deferredActionsMutex_);
+        ea::swap(actions, deferredActions_);
+    }
+    for (const auto& action : actions)
+        action();
+}
+
 unsigned Scene::GetFreeNodeID()
 {
     for (;;)
@@ -879,6 +995,7 @@ void Scene::NodeAdded(Node* node)
         oldScene->NodeRemoved(node);
 
     node->SetScene(this);
+    NodeReparented();
 
     // If the new node has an ID of zero (default), assign a replicated ID now
     unsigned id = node->GetID();
@@ -934,6 +1051,7 @@ void Scene::NodeRemoved(Node* node)
     replicatedNodes_.erase(id);
 
     node->ResetScene();
+    NodeReparented();
 
     // Remove node from tag cache
     if (!node->GetTags().empty())
@@ -952,6 +1070,12 @@ void Scene::NodeRemoved(Node* node)
         NodeRemoved(*i);
 }
 
+void Scene::NodeReparented()
+{
+    if (transformHierarchy_)
+        transformHierarchy_->MarkStructureDirty();
+}
+
 void Scene::ComponentAdded(Component* component)
 {
     if (!component)
@@ -978,7 +1102,7 @@ void Scene::ComponentAdded(Component* component)
     component->OnSceneSet(this);
 
     if (auto index = GetMutableComponentIndex(component->GetType()))
-        index->insert(component);
+        index->Insert(component);
 }
 
 void Scene::ComponentRemoved(Component* component)
@@ -987,7 +1111,7 @@ void Scene::ComponentRemoved(Component* component)
         return;
 
     if (auto index = GetMutableComponentIndex(component->GetType()))
-        index->erase(component);
+        index->Erase(component);
 
     unsigned id = component->GetID();
     replicatedComponents_.erase(id);
@@ -1120,6 +1244,9 @@ void Scene::FinishAsyncLoading()
         FinishLoading(asyncProgress_.file_);
     }
 
+    if (asyncProgress_.recordingResources_)
+        SavePrefetchManifest(asyncProgress_.file_->GetName());
+
     StopAsyncLoading();
 
     using namespace AsyncLoadFinished;
@@ -1150,6 +1277,66 @@ void Scene::FinishSaving(Serializer* dest) const
     }
 }
 
+void Scene::BeginPreloadResources(const ea::string& fileName)
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+
+    // Queue everything requested during the previous load at once instead of discovering dependencies one by one
+#ifdef URHO3D_THREADING
+    if (AbstractFilePtr manifestFile = cache->GetFile(GetPrefetchManifestName(fileName), false))
+    {
+        auto manifest = MakeShared<JSONFile>(context_);
+        if (manifest->Load(*manifestFile))
+        {
+            const JSONArray& resources = manifest->GetRoot().Get("resources").GetArray();
+            URHO3D_LOGDEBUG("Prefetching {} resources for {}", resources.size(), fileName);
+
+            // Preserve the order of requests
+            for (unsigned i = 0; i < resources.size(); ++i)
+            {
+                const ea::string& entry = resources[i].GetString();
+                const unsigned separator = entry.find(';');
+                if (separator == ea::string::npos)
+                    continue;
+
+                const StringHash type{entry.substr(0, separator)};
+                const ea::string name = cache->SanitateResourceName(entry.substr(separator + 1));
+                if (cache->BackgroundLoadResource(type, name, true, nullptr, -static_cast<float>(i)))
+                {
+                    ++asyncProgress_.totalResources_;
+                    asyncProgress_.resources_.insert(StringHash(name));
+                }
+            }
+        }
+    }
+#endif
+
+    if (prefetchManifestRecording_)
+    {
+        cache->StartResourceRecording();
+        asyncProgress_.recordingResources_ = true;
+    }
+}
+
+void Scene::SavePrefetchManifest(const ea::string& fileName)
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+
+    asyncProgress_.recordingResources_ = false;
+    const ea::vector<ResourceRef> resources = cache->StopResourceRecording();
+
+    JSONArray resourcesArray;
+    for (const ResourceRef& ref : resources)
+        resourcesArray.push_back(Format("{};{}", context_->GetTypeName(ref.type_), ref.name_));
+
+    auto manifest = MakeShared<JSONFile>(context_);
+    manifest->GetRoot().Set("resources", resourcesArray);
+
+    const ea::string manifestName = GetPrefetchManifestName(fileName);
+    if (!manifest->SaveFile(FileIdentifier::FromUri(manifestName)))
+        URHO3D_LOGWARNING("Cannot save prefetch manifest {}", manifestName);
+}
+
 void Scene::PreloadResources(AbstractFilePtr file, bool isSceneFile)
 {
     // If not threaded, can not background load resources, so rather load synchronously later when needed
@@ -1412,6 +1599,7 @@ void RegisterSceneLibrary(Context* context)
     PrefabReference::RegisterObject(context);
     PrefabResource::RegisterObject(context);
     ShakeComponent::RegisterObject(context);
+    SceneChunkStreamer::RegisterObject(context);
 }
 
 }
@@ -29,17 +29,21 @@
 #include "../Resource/XMLElement.h"
 #include "../Scene/Node.h"
 #include "../Scene/SceneResolver.h"
+#include "../Scene/TransformHierarchy.h"
 
 #include <EASTL/span.h>
 #include <EASTL/unique_ptr.h>
+#include <EASTL/unordered_map.h>
 #include <EASTL/unordered_set.h>
 
 namespace Urho3D
 {
 
 class File;
+class LogicComponent;
 class PackageFile;
 class Texture2D;
+enum UpdateEvent : unsigned;
 
 /// TODO: Get rid of "replicated" word in the code. It is not used in the networking code anymore.
 static const unsigned FIRST_REPLICATED_ID = 0x1;
@@ -84,10 +88,81 @@ struct AsyncProgress
     unsigned loadedNodes_;
     /// Total root-level nodes.
     unsigned totalNodes_;
+    /// Whether requested resources are recorded to the prefetch manifest.
+    bool recordingResources_{};
 };
 
-/// Index of components in the Scene.
-using SceneComponentIndex = ea::hash_set<Component*>;
+/// Index of components of one type in the Scene.
+/// Components are kept in the dense array so they can be iterated without visiting nodes.
+/// Order of components is not preserved on removal. Use component IDs as stable handles.
+class URHO3D_API SceneComponentIndex
+{
+public:
+    /// Add component to the index. Does nothing if already added.
+    void Insert(Component* component)
+    {
+        if (indices_.emplace(component, components_.size()).second)
+            components_.push_back(component);
+    }
+
+    /// Remove component from the index. The last component takes its place.
+    void Erase(Component* component)
+    {
+        const auto iter = indices_.find(component);
+        if (iter == indices_.end())
+            return;
+
+        const unsigned index = iter->second;
+        indices_.erase(iter);
+
+        Component* lastComponent = components_.back();
+        components_.pop_back();
+        if (lastComponent != component)
+        {
+            components_[index] = lastComponent;
+            indices_[lastComponent] = index;
+        }
+    }
+
+    /// Remove all components.
+    void Clear()
+    {
+        components_.clear();
+        indices_.clear();
+    }
+
+    /// Return whether the component is in the index.
+    bool Contains(Component* component) const { return indices_.contains(component); }
+    /// Return index of the component in the dense array, or M_MAX_UNSIGNED if not found.
+    unsigned GetIndex(Component* component) const
+    {
+        const auto iter = indices_.find(component);
+        return iter != indices_.end() ? iter->second : M_MAX_UNSIGNED;
+    }
+    /// Return all indexed components.
+    ea::span<Component* const> GetComponents() const { return components_; }
+
+    /// Iterate over indexed components cast to the type of the index.
+    template <class T, class Callback> void ForEach(const Callback& callback) const
+    {
+        for (Component* component : components_)
+            callback(static_cast<T*>(component));
+    }
+
+    /// @name Container interface
+    /// @{
+    auto begin() const { return components_.begin(); }
+    auto end() const { return components_.end(); }
+    unsigned size() const { return components_.size(); }
+    bool empty() const { return components_.empty(); }
+    /// @}
+
+private:
+    /// Indexed components.
+    ea::vector<Component*> components_;
+    /// Indices of components in the array.
+    ea::unordered_map<Component*, unsigned> indices_;
+};
 
 /// Root scene node, represents the whole scene.
 class URHO3D_API Scene : public Node
@@ -109,9 +184,9 @@ public:
     /// @nobind
     static void RegisterObject(Context* context);
 
-    /// Create component index. Scene must be empty.
+    /// Create component index. Components of this type already present in the Scene are added to the index.
     bool CreateComponentIndex(StringHash componentType);
-    /// Create component index for template type. Scene must be empty.
+    /// Create component index for template type.
     template <class T> void CreateComponentIndex() { CreateComponentIndex(T::GetTypeStatic()); }
     /// Return component index. Iterable. Invalidated when indexed component is added or removed!
     const SceneComponentIndex& GetComponentIndex(StringHash componentType);
@@ -183,6 +258,17 @@ public:
     /// Set maximum milliseconds per frame to spend on async scene loading.
     /// @property
     void SetAsyncLoadingMs(int ms);
+    /// Enable or disable recording of resources requested during async loading.
+    /// Recorded resources are saved as the prefetch manifest next to the scene file
+    /// and are queued for background loading all at once when the scene is loaded next time.
+    /// @property
+    void SetPrefetchManifestRecording(bool enable) { prefetchManifestRecording_ = enable; }
+    /// Enable or disable batched update of world transforms.
+    /// If enabled, world transforms of all dirty nodes are updated in parallel once per frame after scene post-update.
+    /// @property
+    void SetBatchedTransformUpdate(bool enable);
+    /// Update world transforms of all dirty nodes if batched update is enabled. Called automatically on scene update.
+    void UpdateWorldTransforms();
     /// Add a required package file for networking. To be called on the server.
     void AddRequiredPackageFile(PackageFile* package);
     /// Clear required package files.
@@ -209,6 +295,11 @@ public:
     /// Return whether updates are enabled.
     /// @property
     bool IsUpdateEnabled() const { return updateEnabled_; }
+    /// Return whether batched update of world transforms is enabled.
+    /// @property
+    bool IsBatchedTransformUpdate() const { return transformHierarchy_ != nullptr; }
+    /// Return flat transform hierarchy, or null if batched update is disabled.
+    TransformHierarchy* GetTransformHierarchy() const { return transformHierarchy_.get(); }
 
     /// Return whether an asynchronous loading operation is in progress.
     /// @property
@@ -241,6 +332,11 @@ public:
     /// Return maximum milliseconds per frame to spend on async loading.
     /// @property
     int GetAsyncLoadingMs() const { return asyncLoadingMs_; }
+    /// Return whether resources requested during async loading are recorded to the prefetch manifest.
+    /// @property
+    bool GetPrefetchManifestRecording() const { return prefetchManifestRecording_; }
+    /// Return name of the prefetch manifest for the scene file.
+    static ea::string GetPrefetchManifestName(const ea::string& fileName) { return fileName + ".prefetch.json"; }
 
     /// Return required package files.
     /// @property
@@ -261,6 +357,16 @@ public:
     /// Return threaded update flag.
     bool IsThreadedUpdate() const { return threadedUpdate_; }
 
+    /// Add logic component to the parallel phase of scene update or post-update. Called by LogicComponent.
+    void AddParallelUpdate(LogicComponent* component, UpdateEvent phase);
+    /// Remove logic component from the parallel phase of scene update or post-update. Called by LogicComponent.
+    void RemoveParallelUpdate(LogicComponent* component, UpdateEvent phase);
+    /// Defer action until the end of the current parallel update phase. Is thread-safe.
+    /// Node creation and removal from parallel update should be deferred. Executed immediately outside of parallel update.
+    void DeferAction(ea::function<void()> action);
+    /// Return whether parallel update phase is in progress.
+    bool IsParallelUpdate() const { return parallelUpdate_; }
+
     /// Get free node ID.
     unsigned GetFreeNodeID();
     /// Get free component ID.
@@ -275,6 +381,14 @@ public:
     void NodeAdded(Node* node);
     /// Node removed. Remove from ID map.
     void NodeRemoved(Node* node);
+    /// Node parent changed. Mark flat transform hierarchy for rebuild.
+    void NodeReparented();
+    /// Node transform marked dirty. Thread-safe.
+    void NodeTransformDirty(unsigned transformIndex)
+    {
+        if (transformHierarchy_)
+            transformHierarchy_->MarkDirty(transformIndex);
+    }
     /// Component added. Add to ID map.
     void ComponentAdded(Component* component);
     /// Component removed. Remove from ID map.
@@ -285,6 +399,10 @@ public:
     ea::string GetVarNamesAttr() const;
 
 private:
+    /// Return components of parallel update phase.
+    ea::vector<WeakPtr<LogicComponent>>& GetParallelUpdateComponents(UpdateEvent phase);
+    /// Run parallel update phase and apply deferred actions.
+    void RunParallelUpdate(UpdateEvent phase, float timeStep);
     /// Handle the logic update event to update the scene, if active.
     void HandleUpdate(StringHash eventType, VariantMap& eventData);
     /// Handle a background loaded resource completing.
@@ -297,6 +415,10 @@ private:
     void FinishLoading(Deserializer* source);
     /// Finish saving. Sets the scene filename and checksum.
     void FinishSaving(Serializer* dest) const;
+    /// Queue resources from the prefetch manifest and start recording if enabled.
+    void BeginPreloadResources(const ea::string& fileName);
+    /// Save recorded resources to the prefetch manifest.
+    void SavePrefetchManifest(const ea::string& fileName);
     /// Preload resources from a binary scene or object prefab file.
     void PreloadResources(AbstractFilePtr file, bool isSceneFile);
     /// Preload resources from an XML scene or object prefab file.
@@ -333,6 +455,16 @@ private:
     ea::vector<Component*> delayedDirtyComponents_;
     /// Mutex for the delayed dirty notification queue.
     Mutex sceneMutex_;
+    /// Logic components updated in parallel on scene update.
+    ea::vector<WeakPtr<LogicComponent>> parallelUpdateComponents_;
+    /// Logic components updated in parallel on scene post-update.
+    ea::vector<WeakPtr<LogicComponent>> parallelPostUpdateComponents_;
+    /// Actions deferred until the end of parallel update.
+    ea::vector<ea::function<void()>> deferredActions_;
+    /// Mutex for deferred actions.
+    Mutex deferredActionsMutex_;
+    /// Whether the parallel update phase is in progress.
+    bool parallelUpdate_{};
     /// Next free non-local node ID.
     unsigned replicatedNodeID_;
     /// Next free non-local component ID.
@@ -351,6 +483,10 @@ private:
     bool asyncLoading_;
     /// Threaded update flag.
     bool threadedUpdate_;
+    /// Whether to record the prefetch manifest during async loading.
+    bool prefetchManifestRecording_{};
+    /// Flat transform hierarchy if batched transform update is enabled.
+    ea::unique_ptr<TransformHierarchy> transformHierarchy_;
 
     /// Lightmap textures names.
     ResourceRefList lightmaps_;
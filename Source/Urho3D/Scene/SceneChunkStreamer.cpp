@@ -0,0 +1,226 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Scene/SceneChunkStreamer.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../Resource/ResourceCache.h"
+#include "../Resource/ResourceEvents.h"
+#include "../Scene/Node.h"
+#include "../Scene/PrefabReference.h"
+#include "../Scene/PrefabResource.h"
+
+#include <EASTL/sort.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Number of variants per chunk in attribute.
+const unsigned ChunkAttributeStride = 3;
+
+}
+
+SceneChunkStreamer::SceneChunkStreamer(Context* context)
+    : LogicComponent(context)
+{
+    SetUpdateEventMask(USE_UPDATE);
+    SubscribeToEvent(E_LOADFAILED, URHO3D_HANDLER(SceneChunkStreamer, HandleLoadFailed));
+}
+
+SceneChunkStreamer::~SceneChunkStreamer() = default;
+
+void SceneChunkStreamer::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<SceneChunkStreamer>(Category_Scene);
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Load Distance", GetLoadDistance, SetLoadDistance, float, DefaultLoadDistance, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Unload Distance", GetUnloadDistance, SetUnloadDistance, float, DefaultUnloadDistance, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Instantiations Per Frame", GetMaxInstantiationsPerFrame, SetMaxInstantiationsPerFrame,
+        unsigned, DefaultMaxInstantiationsPerFrame, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Chunks", GetChunksAttr, SetChunksAttr, VariantVector, Variant::emptyVariantVector, AM_DEFAULT);
+}
+
+unsigned SceneChunkStreamer::AddChunk(const ea::string& prefabName, const Vector3& position, float radius)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+
+    Chunk& chunk = chunks_.emplace_back();
+    chunk.prefabName_ = cache->SanitateResourceName(prefabName);
+    chunk.position_ = position;
+    chunk.radius_ = ea::max(radius, 0.0f);
+    return chunks_.size() - 1;
+}
+
+void SceneChunkStreamer::RemoveAllChunks()
+{
+    for (Chunk& chunk : chunks_)
+        UnloadChunk(chunk);
+    chunks_.clear();
+}
+
+void SceneChunkStreamer::SetLoadDistance(float distance)
+{
+    loadDistance_ = ea::max(distance, 0.0f);
+    unloadDistance_ = ea::max(unloadDistance_, loadDistance_);
+}
+
+void SceneChunkStreamer::SetUnloadDistance(float distance)
+{
+    unloadDistance_ = ea::max(distance, loadDistance_);
+}
+
+unsigned SceneChunkStreamer::GetNumLoadedChunks() const
+{
+    return ea::count_if(
+        chunks_.begin(), chunks_.end(), [](const Chunk& chunk) { return chunk.state_ == ChunkState::Loaded; });
+}
+
+bool SceneChunkStreamer::IsChunkLoaded(unsigned index) const
+{
+    return index < chunks_.size() && chunks_[index].state_ == ChunkState::Loaded;
+}
+
+Node* SceneChunkStreamer::GetChunkNode(unsigned index) const
+{
+    return index < chunks_.size() ? chunks_[index].instance_.Get() : nullptr;
+}
+
+void SceneChunkStreamer::SetChunksAttr(const VariantVector& value)
+{
+    RemoveAllChunks();
+    for (unsigned i = 0; i + ChunkAttributeStride <= value.size(); i += ChunkAttributeStride)
+        AddChunk(value[i].GetString(), value[i + 1].GetVector3(), value[i + 2].GetFloat());
+}
+
+VariantVector SceneChunkStreamer::GetChunksAttr() const
+{
+    VariantVector result;
+    result.reserve(chunks_.size() * ChunkAttributeStride);
+    for (const Chunk& chunk : chunks_)
+    {
+        result.push_back(chunk.prefabName_);
+        result.push_back(chunk.position_);
+        result.push_back(chunk.radius_);
+    }
+    return result;
+}
+
+void SceneChunkStreamer::Update(float timeStep)
+{
+    URHO3D_PROFILE("UpdateSceneChunks");
+
+    if (!observer_)
+        return;
+
+    auto cache = GetSubsystem<ResourceCache>();
+    const Vector3 observerPosition = observer_->GetWorldPosition();
+    const Matrix3x4& worldTransform = node_->GetWorldTransform();
+    const Vector3 worldScale = worldTransform.Scale();
+    const float scale = ea::max({Abs(worldScale.x_), Abs(worldScale.y_), Abs(worldScale.z_)});
+
+    ea::vector<Chunk*> readyChunks;
+    for (Chunk& chunk : chunks_)
+    {
+        const Vector3 worldPosition = worldTransform * chunk.position_;
+        chunk.distance_ = ea::max(0.0f, (worldPosition - observerPosition).Length() - chunk.radius_ * scale);
+
+        if (chunk.distance_ > unloadDistance_)
+        {
+            if (chunk.state_ != ChunkState::Unloaded)
+                UnloadChunk(chunk);
+            continue;
+        }
+
+        // Hysteresis: keep loaded chunks between load and unload distances
+        if (chunk.state_ == ChunkState::Unloaded && chunk.distance_ <= loadDistance_)
+        {
+            // Closer chunks are loaded first
+            cache->BackgroundLoadResource<PrefabResource>(chunk.prefabName_, true, nullptr, -chunk.distance_);
+            chunk.state_ = ChunkState::Loading;
+        }
+
+        if (chunk.state_ == ChunkState::Loading)
+        {
+            if (auto prefab = cache->GetExistingResource<PrefabResource>(chunk.prefabName_))
+            {
+                chunk.prefab_ = prefab;
+                chunk.state_ = ChunkState::Ready;
+            }
+        }
+
+        if (chunk.state_ == ChunkState::Ready)
+            readyChunks.push_back(&chunk);
+    }
+
+    // Attach the closest chunks first, the rest is postponed to the next frames
+    const unsigned numInstantiations = ea::min<unsigned>(readyChunks.size(), maxInstantiationsPerFrame_);
+    ea::partial_sort(readyChunks.begin(), readyChunks.begin() + numInstantiations, readyChunks.end(),
+        [](const Chunk* lhs, const Chunk* rhs) { return lhs->distance_ < rhs->distance_; });
+    for (unsigned i = 0; i < numInstantiations; ++i)
+        InstantiateChunk(*readyChunks[i]);
+}
+
+void SceneChunkStreamer::HandleLoadFailed(StringHash eventType, VariantMap& eventData)
+{
+    using namespace LoadFailed;
+
+    const ea::string& resourceName = eventData[P_RESOURCENAME].GetString();
+    for (Chunk& chunk : chunks_)
+    {
+        if (chunk.state_ == ChunkState::Loading && chunk.prefabName_ == resourceName)
+            chunk.state_ = ChunkState::Failed;
+    }
+}
+
+void SceneChunkStreamer::InstantiateChunk(Chunk& chunk)
+{
+    URHO3D_PROFILE("InstantiateSceneChunk");
+
+    // Chunk instances are owned by the streamer and are never saved
+    Node* instance = node_->CreateChild();
+    instance->SetTemporary(true);
+    instance->CreateComponent<PrefabReference>()->SetPrefab(chunk.prefab_);
+
+    chunk.instance_ = instance;
+    chunk.state_ = ChunkState::Loaded;
+}
+
+void SceneChunkStreamer::UnloadChunk(Chunk& chunk)
+{
+    if (chunk.instance_)
+        chunk.instance_->Remove();
+
+    chunk.instance_ = nullptr;
+    chunk.prefab_ = nullptr;
+    chunk.state_ = ChunkState::Unloaded;
+}
+
+}
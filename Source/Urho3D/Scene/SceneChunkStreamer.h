@@ -0,0 +1,131 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Scene/LogicComponent.h"
+
+namespace Urho3D
+{
+
+class PrefabResource;
+
+/// Streams parts of the world in and out according to distance from the observer.
+/// Each chunk is a prefab resource that is loaded by the background loader, so the prefab is deserialized
+/// into detached hierarchy on worker threads. Loaded chunks are attached to the scene on the main thread
+/// as temporary child nodes, with limited number of instantiations per frame.
+class URHO3D_API SceneChunkStreamer : public LogicComponent
+{
+    URHO3D_OBJECT(SceneChunkStreamer, LogicComponent);
+
+public:
+    /// Default distance at which chunks are loaded.
+    static constexpr float DefaultLoadDistance = 100.0f;
+    /// Default distance at which chunks are unloaded.
+    static constexpr float DefaultUnloadDistance = 120.0f;
+    /// Default max number of chunks attached to the scene per frame.
+    static const unsigned DefaultMaxInstantiationsPerFrame = 1;
+
+    explicit SceneChunkStreamer(Context* context);
+    ~SceneChunkStreamer() override;
+
+    static void RegisterObject(Context* context);
+
+    /// Add chunk. Position is in the local space of the node, chunk is considered a sphere. Return chunk index.
+    unsigned AddChunk(const ea::string& prefabName, const Vector3& position, float radius = 0.0f);
+    /// Remove all chunks and their instances.
+    void RemoveAllChunks();
+
+    /// Set node which position determines what chunks are loaded.
+    void SetObserver(Node* observer) { observer_ = observer; }
+    /// Return observer node.
+    Node* GetObserver() const { return observer_; }
+    /// Set distance from the observer to the chunk bounds at which the chunk is loaded.
+    void SetLoadDistance(float distance);
+    /// Return load distance.
+    float GetLoadDistance() const { return loadDistance_; }
+    /// Set distance from the observer to the chunk bounds at which the chunk is unloaded. Should not be less than load distance.
+    void SetUnloadDistance(float distance);
+    /// Return unload distance.
+    float GetUnloadDistance() const { return unloadDistance_; }
+    /// Set max number of chunks attached to the scene per frame.
+    void SetMaxInstantiationsPerFrame(unsigned count) { maxInstantiationsPerFrame_ = ea::max(count, 1u); }
+    /// Return max number of chunks attached to the scene per frame.
+    unsigned GetMaxInstantiationsPerFrame() const { return maxInstantiationsPerFrame_; }
+
+    /// Return number of chunks.
+    unsigned GetNumChunks() const { return chunks_.size(); }
+    /// Return number of chunks attached to the scene.
+    unsigned GetNumLoadedChunks() const;
+    /// Return whether the chunk is attached to the scene.
+    bool IsChunkLoaded(unsigned index) const;
+    /// Return root node of the chunk instance, if loaded.
+    Node* GetChunkNode(unsigned index) const;
+
+    /// Set chunks attribute.
+    void SetChunksAttr(const VariantVector& value);
+    /// Return chunks attribute.
+    VariantVector GetChunksAttr() const;
+
+protected:
+    /// Update streaming.
+    void Update(float timeStep) override;
+
+private:
+    enum class ChunkState
+    {
+        Unloaded,
+        Loading,
+        Ready,
+        Loaded,
+        Failed
+    };
+
+    struct Chunk
+    {
+        ea::string prefabName_;
+        Vector3 position_;
+        float radius_{};
+
+        ChunkState state_{};
+        SharedPtr<PrefabResource> prefab_;
+        WeakPtr<Node> instance_;
+        /// Distance from the observer to the chunk bounds evaluated in the last update.
+        float distance_{};
+    };
+
+    /// Handle failed loading of resource.
+    void HandleLoadFailed(StringHash eventType, VariantMap& eventData);
+    /// Attach loaded chunk to the scene.
+    void InstantiateChunk(Chunk& chunk);
+    /// Remove chunk instance and forget loaded resource.
+    void UnloadChunk(Chunk& chunk);
+
+    ea::vector<Chunk> chunks_;
+    WeakPtr<Node> observer_;
+    float loadDistance_{DefaultLoadDistance};
+    float unloadDistance_{DefaultUnloadDistance};
+    unsigned maxInstantiationsPerFrame_{DefaultMaxInstantiationsPerFrame};
+};
+
+}
@@ -27,6 +27,8 @@
 namespace Urho3D
 {
 
+class Scene;
+
 /// Variable timestep scene update.
 URHO3D_EVENT(E_SCENEUPDATE, SceneUpdate)
 {
@@ -34,6 +36,14 @@ URHO3D_EVENT(E_SCENEUPDATE, SceneUpdate)
     URHO3D_PARAM(P_TIMESTEP, TimeStep);            // float
 }
 
+/// Variable timestep scene update. Typed version of E_SCENEUPDATE, sent by the scene before it.
+struct SceneUpdateTypedEvent
+{
+    URHO3D_TYPED_EVENT(SceneUpdateTypedEvent);
+    Scene* scene_{};
+    float timeStep_{};
+};
+
 /// Network-aware scene update.
 /// In standalone mode, SceneNetworkUpdate is equivalent to SceneUpdate.
 /// In server mode, SceneNetworkUpdate is called once per network frame with fixed timestep.
@@ -137,6 +147,22 @@ URHO3D_EVENT(E_COMPONENTREMOVED, ComponentRemoved)
     URHO3D_PARAM(P_COMPONENT, Component);          // Component pointer
 }
 
+/// A child node has been moved to another position in the parent node.
+URHO3D_EVENT(E_NODEREORDERED, NodeReordered)
+{
+    URHO3D_PARAM(P_SCENE, Scene);                  // Scene pointer
+    URHO3D_PARAM(P_PARENT, Parent);                // Node pointer
+    URHO3D_PARAM(P_NODE, Node);                    // Node pointer
+}
+
+/// A component has been moved to another position in the node.
+URHO3D_EVENT(E_COMPONENTREORDERED, ComponentReordered)
+{
+    URHO3D_PARAM(P_SCENE, Scene);                  // Scene pointer
+    URHO3D_PARAM(P_NODE, Node);                    // Node pointer
+    URHO3D_PARAM(P_COMPONENT, Component);          // Component pointer
+}
+
 /// A node's name has changed.
 URHO3D_EVENT(E_NODENAMECHANGED, NodeNameChanged)
 {
@@ -72,6 +72,33 @@ Serializable::Serializable(Context* context) :
 
 Serializable::~Serializable() = default;
 
+void Serializable::OnRecycle()
+{
+    RemoveAllEventSubscriptions();
+
+    RemoveInstanceDefault();
+    setInstanceDefault_ = false;
+    ResetToDefault();
+    temporary_ = false;
+}
+
+void Serializable::DeleteThis()
+{
+    ObjectReflection* reflection = !context_.Expired() && !HasScriptObject() ? context_->GetReflection(GetType()) : nullptr;
+    if (!reflection || !reflection->CanRecycleObject())
+    {
+        delete this;
+        return;
+    }
+
+    // Expire weak pointers first so the recycled object is not confused with the old one
+    RenewRefCount();
+
+    SharedPtr<Serializable> self{this};
+    OnRecycle();
+    reflection->RecycleObject(SharedPtr<Object>(self));
+}
+
 void Serializable::OnSetAttribute(const AttributeInfo& attr, const Variant& src)
 {
     // TODO: may be could use an observer pattern here
@@ -130,6 +130,12 @@ public:
     bool IsTemporary() const { return temporary_; }
 
 protected:
+    /// Reset the object before it is returned to the object pool of its type.
+    /// Derived classes should restore the state of the newly constructed object.
+    virtual void OnRecycle();
+    /// Return the object to the object pool of its type if there is a free slot, delete it otherwise.
+    void DeleteThis() override;
+
     /// Attribute default value at each instance level.
     ea::unique_ptr<VariantMap> instanceDefaultValues_;
     /// When true, store the attribute value as instance's default value (internal use only).
@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Scene/TransformHierarchy.h"
+
+#include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
+#include "../Scene/Node.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+TransformHierarchy::TransformHierarchy() = default;
+
+TransformHierarchy::~TransformHierarchy() = default;
+
+void TransformHierarchy::Update(Node* root, WorkQueue* workQueue)
+{
+    URHO3D_PROFILE("UpdateWorldTransforms");
+
+    if (structureDirty_)
+    {
+        structureDirty_ = false;
+        Rebuild(root);
+    }
+
+    const unsigned numChunks = chunkOffsets_.size() - 1;
+    ForEachParallel(workQueue, 1, numChunks, [&](unsigned beginChunk, unsigned endChunk)
+    {
+        for (unsigned chunkIndex = beginChunk; chunkIndex < endChunk; ++chunkIndex)
+            UpdateRange(chunkOffsets_[chunkIndex], chunkOffsets_[chunkIndex + 1]);
+    });
+}
+
+void TransformHierarchy::Rebuild(Node* root)
+{
+    URHO3D_PROFILE("RebuildTransformHierarchy");
+
+    nodes_.clear();
+    parentIndices_.clear();
+    chunkOffsets_.clear();
+
+    // Scene itself is not included, top-level nodes are transform hierarchy roots
+    ea::vector<ea::pair<Node*, unsigned>> stack;
+    for (const SharedPtr<Node>& child : root->GetChildren())
+    {
+        if (chunkOffsets_.empty() || nodes_.size() - chunkOffsets_.back() >= ChunkSize)
+            chunkOffsets_.push_back(nodes_.size());
+
+        stack.emplace_back(child.Get(), InvalidIndex);
+        while (!stack.empty())
+        {
+            const auto [node, parentIndex] = stack.back();
+            stack.pop_back();
+
+            const unsigned index = nodes_.size();
+            node->transformIndex_ = index;
+            nodes_.push_back(node);
+            parentIndices_.push_back(parentIndex);
+
+            // Push in reverse order so children are stored in order
+            const auto& children = node->GetChildren();
+            for (auto iter = children.rbegin(); iter != children.rend(); ++iter)
+                stack.emplace_back(iter->Get(), index);
+        }
+    }
+    chunkOffsets_.push_back(nodes_.size());
+
+    numNodes_ = nodes_.size();
+    worldTransforms_.resize(numNodes_);
+    worldRotations_.resize(numNodes_);
+    dirtyFlags_ = ea::make_unique<std::atomic<bool>[]>(numNodes_);
+
+    // Dirty nodes are initialized in the first update
+    for (unsigned index = 0; index < numNodes_; ++index)
+    {
+        const Node* node = nodes_[index];
+        const bool isDirty = node->dirty_;
+        dirtyFlags_[index].store(isDirty, std::memory_order_relaxed);
+        if (!isDirty)
+        {
+            worldTransforms_[index] = node->worldTransform_;
+            worldRotations_[index] = node->worldRotation_;
+        }
+    }
+}
+
+void TransformHierarchy::UpdateRange(unsigned beginIndex, unsigned endIndex)
+{
+    for (unsigned index = beginIndex; index < endIndex; ++index)
+    {
+        if (!dirtyFlags_[index].load(std::memory_order_relaxed))
+            continue;
+
+        dirtyFlags_[index].store(false, std::memory_order_relaxed);
+
+        // Node is accessed only if dirty, parent transform is taken from the flat storage
+        const Node* node = nodes_[index];
+        const unsigned parentIndex = parentIndices_[index];
+        Matrix3x4& worldTransform = worldTransforms_[index];
+        Quaternion& worldRotation = worldRotations_[index];
+        if (parentIndex == InvalidIndex)
+        {
+            worldTransform = node->GetTransformMatrix();
+            worldRotation = node->rotation_;
+        }
+        else
+        {
+            worldTransform = worldTransforms_[parentIndex] * node->GetTransformMatrix();
+            worldRotation = worldRotations_[parentIndex] * node->rotation_;
+        }
+
+        node->worldTransform_ = worldTransform;
+        node->worldRotation_ = worldRotation;
+        node->dirty_ = false;
+    }
+}
+
+}
@@ -0,0 +1,93 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Math/Matrix3x4.h"
+#include "../Math/Quaternion.h"
+
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+
+#include <atomic>
+
+namespace Urho3D
+{
+
+class Node;
+class WorkQueue;
+
+/// Flat storage of world transforms of scene nodes in depth-first order.
+/// Parent always goes before its children, so world transforms of all dirty nodes are updated in one linear pass.
+/// Top-level subtrees are grouped into chunks that are updated in parallel.
+/// Node keeps its own copy of world transform, so Node API works as before.
+class URHO3D_API TransformHierarchy
+{
+public:
+    /// Index of node without parent in the hierarchy.
+    static constexpr unsigned InvalidIndex = M_MAX_UNSIGNED;
+    /// Min number of nodes processed by one task.
+    static constexpr unsigned ChunkSize = 1024;
+
+    TransformHierarchy();
+    ~TransformHierarchy();
+
+    /// Mark hierarchy for rebuild when nodes are added, removed or reparented.
+    void MarkStructureDirty() { structureDirty_ = true; }
+    /// Mark world transform of the node dirty. Thread-safe.
+    void MarkDirty(unsigned index)
+    {
+        if (index < numNodes_)
+            dirtyFlags_[index].store(true, std::memory_order_relaxed);
+    }
+
+    /// Update world transforms of all dirty nodes. Rebuild hierarchy if necessary.
+    void Update(Node* root, WorkQueue* workQueue);
+
+    /// Return number of nodes in the hierarchy.
+    unsigned GetNumNodes() const { return numNodes_; }
+    /// Return node by index.
+    Node* GetNode(unsigned index) const { return nodes_[index]; }
+    /// Return index of the parent node.
+    unsigned GetParentIndex(unsigned index) const { return parentIndices_[index]; }
+    /// Return world transform by index. Valid only after update.
+    const Matrix3x4& GetWorldTransform(unsigned index) const { return worldTransforms_[index]; }
+
+private:
+    /// Rebuild node order from the scene graph.
+    void Rebuild(Node* root);
+    /// Update world transforms in range.
+    void UpdateRange(unsigned beginIndex, unsigned endIndex);
+
+    ea::vector<Node*> nodes_;
+    ea::vector<unsigned> parentIndices_;
+    ea::vector<Matrix3x4> worldTransforms_;
+    ea::vector<Quaternion> worldRotations_;
+    ea::unique_ptr<std::atomic<bool>[]> dirtyFlags_;
+    /// Begin index of each chunk, followed by the total number of nodes.
+    ea::vector<unsigned> chunkOffsets_;
+
+    unsigned numNodes_{};
+    bool structureDirty_{true};
+};
+
+}
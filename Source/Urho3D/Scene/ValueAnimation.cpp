@@ -342,12 +342,14 @@ bool ValueAnimation::IsValid() const
 
 Variant ValueAnimation::GetAnimationValue(float scaledTime) const
 {
-    unsigned index = 1;
-    for (; index < keyFrames_.size(); ++index)
-    {
-        if (scaledTime < keyFrames_[index].time_)
-            break;
-    }
+    unsigned keyFrameIndex = 1;
+    return GetAnimationValue(scaledTime, keyFrameIndex);
+}
+
+Variant ValueAnimation::GetAnimationValue(float scaledTime, unsigned& keyFrameIndex) const
+{
+    const unsigned index = FindNextKeyFrame(scaledTime, keyFrameIndex);
+    keyFrameIndex = index;
 
     if (index >= keyFrames_.size() || !interpolatable_ || interpolationMethod_ == IM_NONE)
         return keyFrames_[index - 1].value_;
@@ -360,6 +362,18 @@ Variant ValueAnimation::GetAnimationValue(float scaledTime) const
     }
 }
 
+unsigned ValueAnimation::FindNextKeyFrame(float scaledTime, unsigned hint) const
+{
+    // Time usually moves forward a little, so continue from the previous key frame when it is not after the time
+    unsigned index = hint >= 1 && hint <= keyFrames_.size() && keyFrames_[hint - 1].time_ <= scaledTime ? hint : 1;
+    for (; index < keyFrames_.size(); ++index)
+    {
+        if (scaledTime < keyFrames_[index].time_)
+            break;
+    }
+    return index;
+}
+
 void ValueAnimation::GetEventFrames(float beginTime, float endTime, ea::vector<const VAnimEventFrame*>& eventFrames) const
 {
     for (unsigned i = 0; i < eventFrames_.size(); ++i)
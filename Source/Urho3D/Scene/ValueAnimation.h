@@ -136,6 +136,8 @@ public:
 
     /// Return animation value.
     Variant GetAnimationValue(float scaledTime) const;
+    /// Return animation value. Key frame index found by the previous call is used as a starting point and updated.
+    Variant GetAnimationValue(float scaledTime, unsigned& keyFrameIndex) const;
 
     /// Return all key frames.
     const ea::vector<VAnimKeyFrame>& GetKeyFrames() const { return keyFrames_; }
@@ -147,6 +149,8 @@ public:
     void GetEventFrames(float beginTime, float endTime, ea::vector<const VAnimEventFrame*>& eventFrames) const;
 
 protected:
+    /// Return index of the first key frame after given time, starting the search from the hint if possible.
+    unsigned FindNextKeyFrame(float scaledTime, unsigned hint) const;
     /// Linear interpolation.
     Variant LinearInterpolation(unsigned index1, unsigned index2, float scaledTime) const;
     /// Spline interpolation.
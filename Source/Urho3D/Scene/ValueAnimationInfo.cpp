@@ -88,7 +88,7 @@ bool ValueAnimationInfo::SetTime(float time)
     float scaledTime = CalculateScaledTime(currentTime_, finished);
 
     // Apply to the target object
-    ApplyValue(animation_->GetAnimationValue(scaledTime));
+    ApplyValue(animation_->GetAnimationValue(scaledTime, keyFrameIndex_));
 
     // Send keyframe event if necessary
     if (animation_->HasEventFrames())
@@ -94,6 +94,8 @@ protected:
     float currentTime_;
     /// Last scaled time.
     float lastScaledTime_;
+    /// Key frame found on the last update, used to speed up the search.
+    unsigned keyFrameIndex_{1};
 };
 
 }
@@ -162,6 +162,54 @@ void CompileSpirV(SpirVShader& outputShader, EShLanguage stage, ea::string_view
     }
 }
 
+/// Preprocess GLSL shader in the same environment as CompileSpirV.
+bool PreprocessGLSL(
+    ea::string& output, EShLanguage stage, ea::string_view sourceCode, TargetShaderLanguage targetLanguage)
+{
+    thread_local ea::string shaderCode;
+    shaderCode.clear();
+    shaderCode += "#version 450\n";
+    AppendWithoutVersion(shaderCode, sourceCode);
+
+    const char* inputStrings[] = { shaderCode.data() };
+    const int inputLengths[] = { static_cast<int>(shaderCode.length()) };
+
+    const auto envClient =
+        targetLanguage == TargetShaderLanguage::VULKAN_1_0 ? glslang::EShClientVulkan : glslang::EShClientOpenGL;
+    glslang::TShader shader(stage);
+    shader.setStringsWithLengths(inputStrings, inputLengths, 1);
+    shader.setEnvInput(glslang::EShSourceGlsl, stage, envClient, 100);
+    shader.setEnvClient(envClient, glslang::EShTargetOpenGL_450);
+    shader.setEnvTarget(glslang::EshTargetSpv, glslang::EShTargetSpv_1_0);
+
+    std::string preprocessedCode;
+    glslang::TShader::ForbidIncluder includer;
+    if (!shader.preprocess(
+            GetDefaultResources(), 100, ENoProfile, false, false, EShMsgDefault, &preprocessedCode, includer))
+        return false;
+
+    // Remove line information so the output doesn't depend on the number of skipped lines
+    output.clear();
+    const ea::string_view preprocessedView{preprocessedCode.c_str(), preprocessedCode.size()};
+    for (size_t lineStart = 0; lineStart < preprocessedView.size();)
+    {
+        size_t lineEnd = preprocessedView.find('\n', lineStart);
+        if (lineEnd == ea::string_view::npos)
+            lineEnd = preprocessedView.size();
+
+        const ea::string_view line = preprocessedView.substr(lineStart, lineEnd - lineStart);
+        const size_t firstChar = line.find_first_not_of(" \t\r");
+        if (firstChar != ea::string_view::npos && !line.substr(firstChar).starts_with("#line"))
+        {
+            output.append(line.begin(), line.end());
+            output.push_back('\n');
+        }
+
+        lineStart = lineEnd + 1;
+    }
+    return true;
+}
+
 /// Remapping HLSL compiler.
 class RemappingCompilerHLSL : public spirv_cross::CompilerHLSL
 {
@@ -308,6 +356,19 @@ void ParseUniversalShader(SpirVShader& output, ShaderType shaderType, ea::string
 #endif
 }
 
+bool PreprocessUniversalShader(
+    ea::string& output, ShaderType shaderType, ea::string_view sourceCode, TargetShaderLanguage targetLanguage)
+{
+#ifdef URHO3D_SHADER_TRANSLATOR
+    return PreprocessGLSL(output, ConvertShaderType(shaderType), sourceCode, targetLanguage);
+#else
+    URHO3D_ASSERTLOG(0, "URHO3D_SHADER_TRANSLATOR should be enabled to use PreprocessUniversalShader");
+
+    output.clear();
+    return false;
+#endif
+}
+
 void TranslateSpirVShader(TargetShader& output, const SpirVShader& shader, TargetShaderLanguage targetLanguage)
 {
 #ifdef URHO3D_SHADER_TRANSLATOR
@@ -47,6 +47,10 @@ struct TargetShader
 URHO3D_API void ParseUniversalShader(SpirVShader& output, ShaderType shaderType, ea::string_view sourceCode,
     const ShaderDefineArray& shaderDefines, TargetShaderLanguage targetLanguage);
 
+/// Preprocess universal GLSL shader. Sources that differ only in comments or unused defines have the same output.
+URHO3D_API bool PreprocessUniversalShader(
+    ea::string& output, ShaderType shaderType, ea::string_view sourceCode, TargetShaderLanguage targetLanguage);
+
 /// Convert SPIR-V shader to target shader language.
 URHO3D_API void TranslateSpirVShader(
     TargetShader& output, const SpirVShader& shader, TargetShaderLanguage targetLanguage);
@@ -32,6 +32,7 @@
 #include <Diligent/Graphics/GraphicsTools/interface/MapHelper.hpp>
 
 #include <cstddef>
+#include <cstring>
 
 namespace Diligent
 {
@@ -308,6 +309,12 @@ void ImGuiDiligentRenderer::EndFrame()
 {
 }
 
+void ImGuiDiligentRenderer::ResetBufferOffsets()
+{
+    m_VertexBufferOffset = 0;
+    m_IndexBufferOffset  = 0;
+}
+
 void ImGuiDiligentRenderer::InvalidateDeviceObjects()
 {
     m_pVB.Release();
@@ -628,6 +635,8 @@ void ImGuiDiligentRenderer::RenderDrawData(IDeviceContext* pCtx, ImDrawData* pDr
     if (!m_pVB || static_cast<int>(m_VertexBufferSize) < pDrawData->TotalVtxCount)
     {
         m_pVB.Release();
+        m_VertexBufferOffset = 0;
+        m_IndexBufferOffset  = 0;
         while (static_cast<int>(m_VertexBufferSize) < pDrawData->TotalVtxCount)
             m_VertexBufferSize *= 2;
 
@@ -643,6 +652,8 @@ void ImGuiDiligentRenderer::RenderDrawData(IDeviceContext* pCtx, ImDrawData* pDr
     if (!m_pIB || static_cast<int>(m_IndexBufferSize) < pDrawData->TotalIdxCount)
     {
         m_pIB.Release();
+        m_VertexBufferOffset = 0;
+        m_IndexBufferOffset  = 0;
         while (static_cast<int>(m_IndexBufferSize) < pDrawData->TotalIdxCount)
             m_IndexBufferSize *= 2;
 
@@ -655,12 +666,25 @@ void ImGuiDiligentRenderer::RenderDrawData(IDeviceContext* pCtx, ImDrawData* pDr
         m_pDevice->CreateBuffer(IBDesc, nullptr, &m_pIB);
     }
 
+    // Append draw data after the data of previous viewports in this frame, start over if it doesn't fit
+    if (m_VertexBufferOffset + pDrawData->TotalVtxCount > m_VertexBufferSize ||
+        m_IndexBufferOffset + pDrawData->TotalIdxCount > m_IndexBufferSize)
     {
-        MapHelper<ImDrawVert> Verices(pCtx, m_pVB, MAP_WRITE, MAP_FLAG_DISCARD);
-        MapHelper<ImDrawIdx>  Indices(pCtx, m_pIB, MAP_WRITE, MAP_FLAG_DISCARD);
+        m_VertexBufferOffset = 0;
+        m_IndexBufferOffset  = 0;
+    }
 
-        ImDrawVert* pVtxDst = Verices;
-        ImDrawIdx*  pIdxDst = Indices;
+    const Uint32 BaseVtxOffset = m_VertexBufferOffset;
+    const Uint32 BaseIdxOffset = m_IndexBufferOffset;
+    if (pDrawData->TotalVtxCount > 0 && pDrawData->TotalIdxCount > 0)
+    {
+        // Data already written in this frame may still be used by the GPU, so it must not be discarded
+        const MAP_FLAGS MapFlags = BaseVtxOffset == 0 && BaseIdxOffset == 0 ? MAP_FLAG_DISCARD : MAP_FLAG_NO_OVERWRITE;
+        MapHelper<ImDrawVert> Verices(pCtx, m_pVB, MAP_WRITE, MapFlags);
+        MapHelper<ImDrawIdx>  Indices(pCtx, m_pIB, MAP_WRITE, MapFlags);
+
+        ImDrawVert* pVtxDst = static_cast<ImDrawVert*>(Verices) + BaseVtxOffset;
+        ImDrawIdx*  pIdxDst = static_cast<ImDrawIdx*>(Indices) + BaseIdxOffset;
         for (Int32 CmdListID = 0; CmdListID < pDrawData->CmdListsCount; CmdListID++)
         {
             const ImDrawList* pCmdList = pDrawData->CmdLists[CmdListID];
@@ -669,6 +693,9 @@ void ImGuiDiligentRenderer::RenderDrawData(IDeviceContext* pCtx, ImDrawData* pDr
             pVtxDst += pCmdList->VtxBuffer.Size;
             pIdxDst += pCmdList->IdxBuffer.Size;
         }
+
+        m_VertexBufferOffset += pDrawData->TotalVtxCount;
+        m_IndexBufferOffset += pDrawData->TotalIdxCount;
     }
 
     // Setup orthographic projection matrix into our constant buffer
@@ -733,7 +760,9 @@ void ImGuiDiligentRenderer::RenderDrawData(IDeviceContext* pCtx, ImDrawData* pDr
         *CBData = Projection;
     }
 
-    ITextureView* pLastTextureView = nullptr;
+    ITextureView* pLastTextureView  = nullptr;
+    Rect          LastScissor       = {};
+    bool          bLastScissorValid = false;
     auto SetupRenderState = [&]() //
     {
         // Setup shader and vertex buffers
@@ -757,14 +786,15 @@ void ImGuiDiligentRenderer::RenderDrawData(IDeviceContext* pCtx, ImDrawData* pDr
                            static_cast<Uint32>(m_RenderSurfaceHeight));
 
         pLastTextureView = nullptr;
+        bLastScissorValid = false;
     };
 
     SetupRenderState();
 
     // Render command lists
     // (Because we merged all buffers into a single one, we maintain our own offset into them)
-    Uint32 GlobalIdxOffset = 0;
-    Uint32 GlobalVtxOffset = 0;
+    Uint32 GlobalIdxOffset = BaseIdxOffset;
+    Uint32 GlobalVtxOffset = BaseVtxOffset;
 
     for (Int32 CmdListID = 0; CmdListID < pDrawData->CmdListsCount; CmdListID++)
     {
@@ -783,6 +813,22 @@ void ImGuiDiligentRenderer::RenderDrawData(IDeviceContext* pCtx, ImDrawData* pDr
             }
             else
             {
+                if (pCmd->ElemCount == 0)
+                    continue;
+
+                // Merge following commands that continue the same indices with the same state
+                Uint32 ElemCount = pCmd->ElemCount;
+                while (CmdID + 1 < pCmdList->CmdBuffer.Size)
+                {
+                    const ImDrawCmd* pNextCmd = &pCmdList->CmdBuffer[CmdID + 1];
+                    if (pNextCmd->UserCallback != NULL || pNextCmd->TextureId != pCmd->TextureId ||
+                        pNextCmd->VtxOffset != pCmd->VtxOffset || pNextCmd->IdxOffset != pCmd->IdxOffset + ElemCount ||
+                        memcmp(&pNextCmd->ClipRect, &pCmd->ClipRect, sizeof(ImVec4)) != 0)
+                        break;
+                    ElemCount += pNextCmd->ElemCount;
+                    ++CmdID;
+                }
+
                 // Apply scissor/clipping rectangle
                 float4 ClipRect //
                     {
@@ -801,10 +847,15 @@ void ImGuiDiligentRenderer::RenderDrawData(IDeviceContext* pCtx, ImDrawData* pDr
                         static_cast<Int32>(ClipRect.z),
                         static_cast<Int32>(ClipRect.w) //
                     };
-                pCtx->SetScissorRects(1,
-                                      &Scissor,
-                                      static_cast<Uint32>(m_RenderSurfaceWidth),
-                                      static_cast<Uint32>(m_RenderSurfaceHeight));
+                if (!bLastScissorValid || memcmp(&Scissor, &LastScissor, sizeof(Rect)) != 0)
+                {
+                    LastScissor       = Scissor;
+                    bLastScissorValid = true;
+                    pCtx->SetScissorRects(1,
+                                          &Scissor,
+                                          static_cast<Uint32>(m_RenderSurfaceWidth),
+                                          static_cast<Uint32>(m_RenderSurfaceHeight));
+                }
 
                 // Bind texture
                 auto* pTextureView = reinterpret_cast<ITextureView*>(pCmd->TextureId);
@@ -816,7 +867,7 @@ void ImGuiDiligentRenderer::RenderDrawData(IDeviceContext* pCtx, ImDrawData* pDr
                     pCtx->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
                 }
 
-                DrawIndexedAttribs DrawAttrs{pCmd->ElemCount, sizeof(ImDrawIdx) == sizeof(Uint16) ? VT_UINT16 : VT_UINT32, DRAW_FLAG_VERIFY_STATES};
+                DrawIndexedAttribs DrawAttrs{ElemCount, sizeof(ImDrawIdx) == sizeof(Uint16) ? VT_UINT16 : VT_UINT32, DRAW_FLAG_VERIFY_STATES};
                 DrawAttrs.FirstIndexLocation = pCmd->IdxOffset + GlobalIdxOffset;
                 if (m_BaseVertexSupported)
                 {
@@ -63,6 +63,9 @@ public:
                   Uint32            RenderSurfaceHeight,
                   SURFACE_TRANSFORM SurfacePreTransform);
     void EndFrame();
+    // Start writing draw data from the beginning of vertex and index buffers. Should be called once per frame.
+    // Other RenderDrawData calls within the frame append to the buffers without discarding them.
+    void ResetBufferOffsets();
     void RenderDrawData(IDeviceContext* pCtx, ImDrawData* pDrawData, IPipelineState* pUserPSO = nullptr, IShaderResourceBinding* pUserSRB = nullptr, IShaderResourceVariable* pUserTextureVar = nullptr, IShaderResourceVariable* pUserConstantsVar = nullptr);
     void InvalidateDeviceObjects();
     void CreateDeviceObjects();
@@ -85,6 +88,8 @@ private:
     const TEXTURE_FORMAT m_DepthBufferFmt;
     Uint32               m_VertexBufferSize    = 0;
     Uint32               m_IndexBufferSize     = 0;
+    Uint32               m_VertexBufferOffset  = 0;
+    Uint32               m_IndexBufferOffset   = 0;
     Uint32               m_RenderSurfaceWidth  = 0;
     Uint32               m_RenderSurfaceHeight = 0;
     SURFACE_TRANSFORM    m_SurfacePreTransform = SURFACE_TRANSFORM_IDENTITY;
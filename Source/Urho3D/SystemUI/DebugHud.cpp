@@ -27,12 +27,14 @@
 
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
+#include "../Core/MemoryTracker.h"
 #include "../Core/Profiler.h"
 #include "../Engine/Engine.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/GraphicsEvents.h"
 #include "../Graphics/Renderer.h"
 #include "../IO/Log.h"
+#include "../RenderAPI/GpuProfiler.h"
 #include "../RenderAPI/RenderDevice.h"
 #include "../SystemUI/SystemUI.h"
 #include "../UI/UI.h"
@@ -159,6 +161,10 @@ void DebugHud::RenderUI(DebugHudModeFlags mode)
         ui::SetCursorPosX(left_offset);
         ui::Text("Dispatches %u", renderDevice->GetMaxStats().numDispatches_);
         ui::SetCursorPosX(left_offset);
+        ui::Text("Indirect Draws %u", renderDevice->GetMaxStats().numIndirectDraws_);
+        ui::SetCursorPosX(left_offset);
+        ui::Text("Resource Commits %u", renderDevice->GetMaxStats().numResourceCommits_);
+        ui::SetCursorPosX(left_offset);
         ui::Text("Views %u", renderer->GetNumViews());
         ui::SetCursorPosX(left_offset);
         ui::Text("Lights %u", renderer->GetNumLights());
@@ -177,6 +183,51 @@ void DebugHud::RenderUI(DebugHudModeFlags mode)
         }
     }
 
+    if (mode & DEBUGHUD_SHOW_PROFILER)
+    {
+        static const unsigned maxProfilerZones = 10;
+
+        const float left_offset = ui::GetCursorPos().x;
+        const auto profilerStats = FrameProfiler::GetAverageStats();
+        const unsigned numZones = ea::min<unsigned>(profilerStats.size(), maxProfilerZones);
+        for (unsigned i = 0; i < numZones; ++i)
+        {
+            const FrameProfilerZoneStats& zone = profilerStats[i];
+            ui::Text("%s %.2f ms (%.0f)", zone.name_, zone.totalMs_, zone.count_);
+            ui::SetCursorPosX(left_offset);
+        }
+
+        GpuProfiler* gpuProfiler = renderDevice->GetGpuProfiler();
+        if (gpuProfiler->IsEnabled() && !gpuProfiler->GetFrameStats().empty())
+        {
+            ui::Text("GPU %.2f ms", gpuProfiler->GetFrameTimeMs());
+            ui::SetCursorPosX(left_offset);
+            for (const GpuProfilerZoneStats& zone : gpuProfiler->GetFrameStats())
+            {
+                if (zone.depth_ != 0)
+                    continue;
+                ui::Text("  %s %.2f ms", zone.name_, zone.durationMs_);
+                ui::SetCursorPosX(left_offset);
+            }
+        }
+    }
+
+    if (mode & DEBUGHUD_SHOW_MEMORY)
+    {
+        static const unsigned maxMemoryTags = 10;
+
+        const float left_offset = ui::GetCursorPos().x;
+        const auto memoryStats = MemoryTracker::GetStats();
+        const unsigned numTags = ea::min<unsigned>(memoryStats.size(), maxMemoryTags);
+        for (unsigned i = 0; i < numTags; ++i)
+        {
+            const MemoryTagStats& tag = memoryStats[i];
+            ui::Text("%s %.1f KB (%lld) +%llu/f", tag.name_, tag.liveBytes_ / 1024.0, tag.liveAllocations_,
+                tag.frameAllocations_);
+            ui::SetCursorPosX(left_offset);
+        }
+    }
+
     if (mode & DEBUGHUD_SHOW_MODE)
     {
         // TODO: Add more stats?
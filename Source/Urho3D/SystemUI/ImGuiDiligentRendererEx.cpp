@@ -45,6 +45,10 @@ struct ViewportRendererData
 {
     ea::optional<ImVec2> postponedResize_;
     Diligent::RefCntAutoPtr<Diligent::ISwapChain> swapChain_;
+    /// Draw data rendered last time, empty if the viewport should be rendered on the next frame.
+    ea::vector<unsigned char> lastDrawData_;
+    /// Whether the viewport was not rendered on this frame and should not be presented.
+    bool isPresentSkipped_{};
 };
 
 ViewportRendererData* GetViewportData(ImGuiViewport* viewport)
@@ -53,6 +57,53 @@ ViewportRendererData* GetViewportData(ImGuiViewport* viewport)
     return static_cast<ViewportRendererData*>(viewport->RendererUserData);
 }
 
+bool IsFontTexture(ImTextureID textureId)
+{
+    const ImGuiIO& io = ImGui::GetIO();
+    if (io.Fonts && io.Fonts->TexID == textureId)
+        return true;
+    for (const ImFontAtlas* fonts : io.AllFonts)
+    {
+        if (fonts && fonts->TexID == textureId)
+            return true;
+    }
+    return false;
+}
+
+/// Write everything that affects rendering of the draw data into the buffer.
+/// Return false if the draw data may change the output without changing itself: if it uses callbacks or textures
+/// other than fonts, which may be render targets.
+bool SerializeDrawData(const ImDrawData* drawData, ea::vector<unsigned char>& buffer)
+{
+    const auto append = [&](const void* data, unsigned size)
+    {
+        const auto bytes = static_cast<const unsigned char*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    };
+
+    buffer.clear();
+    append(&drawData->DisplayPos, sizeof(ImVec2));
+    append(&drawData->DisplaySize, sizeof(ImVec2));
+    append(&drawData->FramebufferScale, sizeof(ImVec2));
+    for (int listIndex = 0; listIndex < drawData->CmdListsCount; ++listIndex)
+    {
+        const ImDrawList* drawList = drawData->CmdLists[listIndex];
+        for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+        {
+            if (cmd.UserCallback || !IsFontTexture(cmd.TextureId))
+                return false;
+            append(&cmd.ClipRect, sizeof(cmd.ClipRect));
+            append(&cmd.TextureId, sizeof(cmd.TextureId));
+            append(&cmd.VtxOffset, sizeof(cmd.VtxOffset));
+            append(&cmd.IdxOffset, sizeof(cmd.IdxOffset));
+            append(&cmd.ElemCount, sizeof(cmd.ElemCount));
+        }
+        append(drawList->VtxBuffer.Data, drawList->VtxBuffer.Size * sizeof(ImDrawVert));
+        append(drawList->IdxBuffer.Data, drawList->IdxBuffer.Size * sizeof(ImDrawIdx));
+    }
+    return true;
+}
+
 bool IsSRGBTextureFormat(TextureFormat format)
 {
     return format == TextureFormat::TEX_FORMAT_RGBA8_UNORM_SRGB || format == TextureFormat::TEX_FORMAT_BGRA8_UNORM_SRGB;
@@ -167,6 +218,7 @@ void ImGuiDiligentRendererEx::NewFrame()
 {
     const Diligent::SwapChainDesc& swapChainDesc = renderDevice_->GetSwapChain()->GetDesc();
     Diligent::ImGuiDiligentRenderer::NewFrame(swapChainDesc.Width, swapChainDesc.Height, swapChainDesc.PreTransform);
+    Diligent::ImGuiDiligentRenderer::ResetBufferOffsets();
 }
 
 void ImGuiDiligentRendererEx::RenderDrawData(ImDrawData* drawData)
@@ -253,6 +305,7 @@ void ImGuiDiligentRendererEx::SetWindowSize(ImGuiViewport* viewport, ImVec2 size
     ImGuiIO& IO = ImGui::GetIO();
     auto userData = GetViewportData(viewport);
 
+    userData->lastDrawData_.clear();
     if (userData->swapChain_)
     {
         const IntVector2 swapChainSize = VectorRoundToInt(ToVector2(size) * ToVector2(IO.DisplayFramebufferScale));
@@ -282,6 +335,23 @@ void ImGuiDiligentRendererEx::RenderWindow(ImGuiViewport* viewport, void* render
         }
     }
 
+    // Keep the previous image if nothing changed. On OpenGL, swap chain is presented anyway
+    userData->isPresentSkipped_ = false;
+    if (renderDevice_->GetBackend() != RenderBackend::OpenGL)
+    {
+        const bool isCacheable = SerializeDrawData(viewport->DrawData, drawDataBuffer_);
+        if (isCacheable && !userData->lastDrawData_.empty() && drawDataBuffer_ == userData->lastDrawData_)
+        {
+            userData->isPresentSkipped_ = true;
+            return;
+        }
+
+        if (isCacheable)
+            ea::swap(userData->lastDrawData_, drawDataBuffer_);
+        else
+            userData->lastDrawData_.clear();
+    }
+
     #if GL_SUPPORTED || GLES_SUPPORTED
     // On OpenGL, set swap chain and invalidate cached context state
     if (renderDevice_->GetBackend() == RenderBackend::OpenGL)
@@ -319,7 +389,8 @@ void ImGuiDiligentRendererEx::SwapBuffers(ImGuiViewport* viewport, void* renderA
     #endif
 
     auto userData = GetViewportData(viewport);
-    userData->swapChain_->Present(0);
+    if (!userData->isPresentSkipped_)
+        userData->swapChain_->Present(0);
 }
 
 void ImGuiDiligentRendererEx::CreateSwapChainForViewport(ImGuiViewport* viewport)
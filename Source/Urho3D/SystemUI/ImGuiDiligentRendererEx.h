@@ -48,6 +48,8 @@ private:
     SharedPtr<PipelineState> secondaryPipelineState_;
 
     ea::vector<ImGuiViewport*> viewports_;
+    /// Temporary buffer for comparing draw data of secondary viewports.
+    ea::vector<unsigned char> drawDataBuffer_;
 };
 
 } // namespace Diligent
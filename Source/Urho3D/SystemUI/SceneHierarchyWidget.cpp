@@ -25,6 +25,8 @@
 #include "../SystemUI/SceneHierarchyWidget.h"
 
 #include "../Scene/Component.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
 #include "../SystemUI/DragDropPayload.h"
 #include "../SystemUI/Widgets.h"
 
@@ -134,6 +136,16 @@ unsigned GetVisibleItemsCount(Node* node, bool showTemporary, bool showComponent
     return numChildren + numComponents;
 }
 
+bool IsNodeOpenByDefault(Node* node, bool showTemporary, bool showComponents)
+{
+    return node->GetParent() == nullptr || GetVisibleItemsCount(node, showTemporary, showComponents) <= 2;
+}
+
+}
+
+Object* SceneHierarchyWidget::HierarchyRow::GetObject() const
+{
+    return component_ ? static_cast<Object*>(component_) : node_;
 }
 
 SceneHierarchyWidget::SceneHierarchyWidget(Context* context)
@@ -143,6 +155,8 @@ SceneHierarchyWidget::SceneHierarchyWidget(Context* context)
 
 void SceneHierarchyWidget::SetSettings(const SceneHierarchySettings& settings)
 {
+    if (settings_.showTemporary_ != settings.showTemporary_ || settings_.showComponents_ != settings.showComponents_)
+        MarkRowsDirty();
     settings_ = settings;
 }
 
@@ -152,30 +166,41 @@ void SceneHierarchyWidget::RenderContent(Scene* scene, SceneSelection& selection
     const bool queryChanged = search_.currentQuery_ != settings_.filterByName_;
     search_.currentQuery_ = settings_.filterByName_;
     if (queryChanged || sceneChanged)
+    {
         UpdateSearchResults(scene);
+        MarkRowsDirty();
+    }
 
     ProcessActiveObject(selection.GetActiveObject());
 
-    BeginRangeSelection();
+    if (rowsDirty_ || rowsScene_ != scene || !pathToActiveObject_.empty())
+        UpdateRows(scene);
+
+    ProcessRangeSelection(selection);
+
+    const auto activeObject = selection.GetActiveObject();
+    const auto activeRow = ea::find_if(rows_.begin(), rows_.end(),
+        [&](const HierarchyRow& row) { return row.GetObject() == activeObject; });
+    isActiveObjectVisible_ = activeRow != rows_.end();
 
     const ImGuiStyle& style = ui::GetStyle();
     ui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(style.ItemSpacing.x, 0));
-    if (search_.lastQuery_.empty())
+
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(rows_.size()));
+    if (scrollToActiveObject_ && isActiveObjectVisible_)
     {
-        RenderNode(selection, scene);
+        const int index = static_cast<int>(activeRow - rows_.begin());
+        clipper.ForceDisplayRangeByIndices(index, index + 1);
     }
-    else
+
+    while (clipper.Step())
     {
-        for (Node* node : search_.lastResults_)
-        {
-            if (node && (settings_.showTemporary_ || !node->IsTemporaryEffective()))
-                RenderNode(selection, node);
-        }
+        for (int index = clipper.DisplayStart; index < clipper.DisplayEnd; ++index)
+            RenderRow(selection, rows_[index]);
     }
     ui::PopStyleVar();
 
-    EndRangeSelection(selection);
-
     RenderContextMenu(scene, selection);
 
     ApplyPendingUpdates(scene);
@@ -188,25 +213,117 @@ void SceneHierarchyWidget::RenderContent(Scene* scene, SceneSelection& selection
         ignoreNextMouseRelease_ = false;
 }
 
-void SceneHierarchyWidget::RenderNode(SceneSelection& selection, Node* node)
+void SceneHierarchyWidget::UpdateRows(Scene* scene)
+{
+    if (rowsScene_ != scene)
+    {
+        if (rowsScene_)
+            UnsubscribeFromEvents(rowsScene_);
+        rowsScene_ = scene;
+        SubscribeToSceneEvents(scene);
+    }
+
+    // Nodes on the path to the new active object are opened once
+    ImGuiStorage* storage = ui::GetStateStorage();
+    for (Node* node : pathToActiveObject_)
+    {
+        const IdScopeGuard guard(node->GetID());
+        storage->SetInt(ui::GetID("##Node"), 1);
+    }
+
+    rows_.clear();
+    rowsDirty_ = false;
+
+    if (search_.lastQuery_.empty())
+    {
+        AddNodeRows(scene, 0);
+    }
+    else
+    {
+        for (Node* node : search_.lastResults_)
+        {
+            if (node && (settings_.showTemporary_ || !node->IsTemporaryEffective()))
+                AddNodeRows(node, 0);
+        }
+    }
+}
+
+void SceneHierarchyWidget::AddNodeRows(Node* node, unsigned depth)
 {
     if (!settings_.showTemporary_ && node->IsTemporary())
         return;
 
-    ProcessItemIfActive(selection, node);
+    rows_.push_back(HierarchyRow{node, nullptr, depth});
+    if (!IsNodeOpen(node))
+        return;
+
+    if (settings_.showComponents_)
+    {
+        for (Component* component : node->GetComponents())
+        {
+            if (settings_.showTemporary_ || !component->IsTemporary())
+                rows_.push_back(HierarchyRow{node, component, depth + 1});
+        }
+    }
+
+    for (Node* child : node->GetChildren())
+        AddNodeRows(child, depth + 1);
+}
+
+bool SceneHierarchyWidget::IsNodeOpen(Node* node) const
+{
+    // Should match ID and flags of the tree node in RenderNode
+    const IdScopeGuard guard(node->GetID());
+    const bool defaultOpen = IsNodeOpenByDefault(node, settings_.showTemporary_, settings_.showComponents_);
+    return ui::GetStateStorage()->GetInt(ui::GetID("##Node"), defaultOpen ? 1 : 0) != 0;
+}
+
+void SceneHierarchyWidget::SubscribeToSceneEvents(Scene* scene)
+{
+    // Rows are rebuilt from scratch on any structural change, it's cheap compared to rendering the whole tree
+    SubscribeToEvent(scene, E_NODEADDED, &SceneHierarchyWidget::MarkRowsDirty);
+    SubscribeToEvent(scene, E_NODEREMOVED, &SceneHierarchyWidget::MarkRowsDirty);
+    SubscribeToEvent(scene, E_NODEREORDERED, &SceneHierarchyWidget::MarkRowsDirty);
+    SubscribeToEvent(scene, E_COMPONENTADDED, &SceneHierarchyWidget::MarkRowsDirty);
+    SubscribeToEvent(scene, E_COMPONENTREMOVED, &SceneHierarchyWidget::MarkRowsDirty);
+    SubscribeToEvent(scene, E_COMPONENTREORDERED, &SceneHierarchyWidget::MarkRowsDirty);
+    SubscribeToEvent(E_TEMPORARYCHANGED, &SceneHierarchyWidget::MarkRowsDirty);
+}
+
+void SceneHierarchyWidget::RenderRow(SceneSelection& selection, const HierarchyRow& row)
+{
+    const float indent = row.depth_ * ui::GetStyle().IndentSpacing;
+    if (indent > 0.0f)
+        ui::Indent(indent);
+
+    if (row.component_)
+    {
+        const IdScopeGuard guard("Components");
+        RenderComponent(selection, row.component_);
+    }
+    else
+        RenderNode(selection, row.node_);
+
+    if (indent > 0.0f)
+        ui::Unindent(indent);
+}
+
+void SceneHierarchyWidget::RenderNode(SceneSelection& selection, Node* node)
+{
+    ProcessItemIfActive(node);
 
     const unsigned numItems = GetVisibleItemsCount(node, settings_.showTemporary_, settings_.showComponents_);
+    // Children are rendered as separate rows
     ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow
         | ImGuiTreeNodeFlags_OpenOnDoubleClick
         | ImGuiTreeNodeFlags_SpanAvailWidth
-        | ImGuiTreeNodeFlags_AllowItemOverlap;
-    if (node->GetParent() == nullptr)
-        flags |= ImGuiTreeNodeFlags_DefaultOpen;
+        | ImGuiTreeNodeFlags_AllowItemOverlap
+        | ImGuiTreeNodeFlags_NoTreePushOnOpen;
     if (selection.IsSelected(node))
         flags |= ImGuiTreeNodeFlags_Selected;
     if (numItems == 0)
         flags |= ImGuiTreeNodeFlags_Leaf;
-    if (numItems <= 2)
+    if (IsNodeOpenByDefault(node, settings_.showTemporary_, settings_.showComponents_))
         flags |= ImGuiTreeNodeFlags_DefaultOpen;
     HierarchyItemFlags itemFlags = HierarchyItemFlag::Node;
     if (node->IsTemporaryEffective())
@@ -214,17 +331,15 @@ void SceneHierarchyWidget::RenderNode(SceneSelection& selection, Node* node)
     if (node->IsEnabled())
         itemFlags |= HierarchyItemFlag::Enabled;
 
-    if (pathToActiveObject_.contains(node))
-        ui::SetNextItemOpen(true);
-
     const IdScopeGuard guard(node->GetID());
     ui::PushStyleColor(ImGuiCol_Text, GetItemColor(itemFlags));
-    const bool opened = ui::TreeNodeEx(GetNodeTitle(node).c_str(), flags);
+    ui::TreeNodeEx("##Node", flags, "%s", GetNodeTitle(node).c_str());
     ui::PopStyleColor();
     const bool toggleSelect = ui::IsKeyDown(KEY_CTRL);
     const bool rangeSelect = ui::IsKeyDown(KEY_SHIFT);
 
-    ProcessRangeSelection(node, opened);
+    if (ui::IsItemToggledOpen())
+        MarkRowsDirty();
 
     if (ui::IsItemClicked(MOUSEB_LEFT) && ui::IsItemToggledOpen())
         ignoreNextMouseRelease_ = true;
@@ -267,35 +382,18 @@ void SceneHierarchyWidget::RenderNode(SceneSelection& selection, Node* node)
         if (const auto reorder = RenderObjectReorder(nodeReorder_, node, parent, "Move node up or down in the parent node"))
             pendingNodeReorder_ = reorder;
     }
-
-    if (opened)
-    {
-        if (settings_.showComponents_)
-        {
-            const IdScopeGuard guard("Components");
-            for (Component* component : node->GetComponents())
-                RenderComponent(selection, component);
-        }
-
-        for (Node* child : node->GetChildren())
-            RenderNode(selection, child);
-
-        ui::TreePop();
-    }
 }
 
 void SceneHierarchyWidget::RenderComponent(SceneSelection& selection, Component* component)
 {
-    if (component->IsTemporary() && !settings_.showTemporary_)
-        return;
-
-    ProcessItemIfActive(selection, component);
+    ProcessItemIfActive(component);
 
     ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow
         | ImGuiTreeNodeFlags_OpenOnDoubleClick
         | ImGuiTreeNodeFlags_SpanAvailWidth
         | ImGuiTreeNodeFlags_AllowItemOverlap
-        | ImGuiTreeNodeFlags_Leaf;
+        | ImGuiTreeNodeFlags_Leaf
+        | ImGuiTreeNodeFlags_NoTreePushOnOpen;
     if (selection.IsSelected(component))
         flags |= ImGuiTreeNodeFlags_Selected;
     HierarchyItemFlags itemFlags = HierarchyItemFlag::Component;
@@ -306,13 +404,11 @@ void SceneHierarchyWidget::RenderComponent(SceneSelection& selection, Component*
 
     const IdScopeGuard guard(component->GetID());
     ui::PushStyleColor(ImGuiCol_Text, GetItemColor(itemFlags));
-    const bool opened = ui::TreeNodeEx(component->GetTypeName().c_str(), flags);
+    ui::TreeNodeEx(component->GetTypeName().c_str(), flags);
     ui::PopStyleColor();
     const bool toggleSelect = ui::IsKeyDown(KEY_CTRL);
     const bool rangeSelect = ui::IsKeyDown(KEY_SHIFT);
 
-    ProcessRangeSelection(component, opened);
-
     if (ui::IsItemHovered() && ui::IsMouseReleased(MOUSEB_LEFT) && !ui::IsMouseDragPastThreshold(MOUSEB_LEFT))
     {
         ProcessObjectSelected(selection, component, toggleSelect, rangeSelect);
@@ -339,9 +435,6 @@ void SceneHierarchyWidget::RenderComponent(SceneSelection& selection, Component*
 
     if (const auto reorder = RenderObjectReorder(componentReorder_, component, component->GetNode(), "Move component up or down in the node"))
         pendingComponentReorder_ = reorder;
-
-    if (opened)
-        ui::TreePop();
 }
 
 template <class T>
@@ -423,8 +516,8 @@ void SceneHierarchyWidget::ProcessObjectSelected(SceneSelection& selection, Obje
 
     if (toggle)
         selection.SetSelected(object, !selection.IsSelected(object));
-    else if (range && activeObject && wasActiveObjectVisible_ && activeObject != object)
-        rangeSelection_.pendingRequest_ = RangeSelectionRequest{WeakPtr<Object>(activeObject), WeakPtr<Object>(object)};
+    else if (range && activeObject && isActiveObjectVisible_ && activeObject != object)
+        pendingRangeSelection_ = RangeSelectionRequest{WeakPtr<Object>(activeObject), WeakPtr<Object>(object)};
     else
     {
         selection.Clear();
@@ -432,16 +525,12 @@ void SceneHierarchyWidget::ProcessObjectSelected(SceneSelection& selection, Obje
     }
 }
 
-void SceneHierarchyWidget::ProcessItemIfActive(SceneSelection& selection, Object* currentItem)
+void SceneHierarchyWidget::ProcessItemIfActive(Object* currentItem)
 {
-    if (selection.GetActiveObject() == currentItem)
+    if (scrollToActiveObject_ && lastActiveObject_ == currentItem)
     {
-        isActiveObjectVisible_ = true;
-        if (scrollToActiveObject_)
-        {
-            ui::SetScrollHereY();
-            scrollToActiveObject_ = false;
-        }
+        ui::SetScrollHereY();
+        scrollToActiveObject_ = false;
     }
 }
 
@@ -491,50 +580,27 @@ void SceneHierarchyWidget::RenderContextMenu(Scene* scene, SceneSelection& selec
     }
 }
 
-void SceneHierarchyWidget::BeginRangeSelection()
+void SceneHierarchyWidget::ProcessRangeSelection(SceneSelection& selection)
 {
-    wasActiveObjectVisible_ = isActiveObjectVisible_;
-    isActiveObjectVisible_ = false;
-    rangeSelection_.result_.clear();
-    rangeSelection_.isActive_ = false;
-    rangeSelection_.currentRequest_ = rangeSelection_.pendingRequest_;
-    rangeSelection_.pendingRequest_ = ea::nullopt;
-}
-
-void SceneHierarchyWidget::ProcessRangeSelection(Object* currentObject, bool open)
-{
-    if (!rangeSelection_.currentRequest_)
+    if (!pendingRangeSelection_)
         return;
 
-    const WeakPtr<Object> weakObject{currentObject};
-    const bool isBorder = rangeSelection_.currentRequest_->IsBorder(currentObject);
+    const RangeSelectionRequest request = *pendingRangeSelection_;
+    pendingRangeSelection_ = ea::nullopt;
 
-    if (!rangeSelection_.isActive_ && isBorder)
-    {
-        rangeSelection_.isActive_ = true;
-        rangeSelection_.result_.push_back(weakObject);
-    }
-    else if (rangeSelection_.isActive_ && isBorder)
+    const auto isBorder = [&](const HierarchyRow& row)
     {
-        rangeSelection_.result_.push_back(weakObject);
-        rangeSelection_.isActive_ = false;
-        rangeSelection_.currentRequest_ = ea::nullopt;
-    }
-    else if (rangeSelection_.isActive_)
-    {
-        rangeSelection_.result_.push_back(weakObject);
-    }
-}
+        Object* object = row.GetObject();
+        return object == request.from_ || object == request.to_;
+    };
 
-void SceneHierarchyWidget::EndRangeSelection(SceneSelection& selection)
-{
-    rangeSelection_.currentRequest_ = ea::nullopt;
+    const auto begin = ea::find_if(rows_.begin(), rows_.end(), isBorder);
+    const auto end = begin != rows_.end() ? ea::find_if(begin + 1, rows_.end(), isBorder) : rows_.end();
+    if (end == rows_.end())
+        return;
 
-    if (!rangeSelection_.isActive_)
-    {
-        for (Object* object : rangeSelection_.result_)
-            selection.SetSelected(object, true);
-    }
+    for (auto iter = begin; iter != end + 1; ++iter)
+        selection.SetSelected(iter->GetObject(), true);
 }
 
 void SceneHierarchyWidget::UpdateSearchResults(Scene* scene)
@@ -54,18 +54,33 @@ public:
     const SceneHierarchySettings& GetSettings() const { return settings_; }
 
 private:
+    /// Visible item of the hierarchy. Only rows on the screen are rendered.
+    struct HierarchyRow
+    {
+        Node* node_{};
+        Component* component_{};
+        unsigned depth_{};
+
+        Object* GetObject() const;
+    };
+
+    void UpdateRows(Scene* scene);
+    void AddNodeRows(Node* node, unsigned depth);
+    bool IsNodeOpen(Node* node) const;
+    void SubscribeToSceneEvents(Scene* scene);
+    void MarkRowsDirty() { rowsDirty_ = true; }
+
+    void RenderRow(SceneSelection& selection, const HierarchyRow& row);
     void RenderNode(SceneSelection& selection, Node* node);
     void RenderComponent(SceneSelection& selection, Component* component);
     void ApplyPendingUpdates(Scene* scene);
 
     void ProcessObjectSelected(SceneSelection& selection, Object* object, bool toggle, bool range);
-    void ProcessItemIfActive(SceneSelection& selection, Object* currentObject);
+    void ProcessItemIfActive(Object* currentObject);
 
     void ProcessActiveObject(Object* activeObject);
 
-    void BeginRangeSelection();
-    void ProcessRangeSelection(Object* currentObject, bool open);
-    void EndRangeSelection(SceneSelection& selection);
+    void ProcessRangeSelection(SceneSelection& selection);
 
     void UpdateSearchResults(Scene* scene);
 
@@ -96,16 +111,20 @@ private:
     {
         WeakPtr<Object> from_;
         WeakPtr<Object> to_;
-
-        bool IsBorder(Object* object) const { return object == from_ || object == to_; }
     };
 
     SceneHierarchySettings settings_;
 
+    /// Cached rows
+    /// @{
+    WeakPtr<Scene> rowsScene_;
+    ea::vector<HierarchyRow> rows_;
+    bool rowsDirty_{true};
+    /// @}
+
     /// UI state
     /// @{
     bool isActiveObjectVisible_{};
-    bool wasActiveObjectVisible_{};
 
     bool ignoreNextMouseRelease_{};
 
@@ -113,14 +132,7 @@ private:
     Object* lastActiveObject_{};
     ea::vector<Node*> pathToActiveObject_;
 
-    struct RangeSelection
-    {
-        ea::optional<RangeSelectionRequest> pendingRequest_;
-
-        ea::optional<RangeSelectionRequest> currentRequest_;
-        bool isActive_{};
-        ea::vector<WeakPtr<Object>> result_;
-    } rangeSelection_;
+    ea::optional<RangeSelectionRequest> pendingRangeSelection_;
 
     struct NodeSearch
     {
@@ -75,6 +75,7 @@ void BorderImage::GetBatches(ea::vector<UIBatch>& batches, ea::vector<float>& ve
 
 void BorderImage::SetTexture(Texture* texture)
 {
+    MarkBatchesDirty();
     texture_ = texture;
     if (imageRect_ == IntRect::ZERO)
         SetFullImageRect();
@@ -82,6 +83,7 @@ void BorderImage::SetTexture(Texture* texture)
 
 void BorderImage::SetImageRect(const IntRect& rect)
 {
+    MarkBatchesDirty();
     if (rect != IntRect::ZERO)
         imageRect_ = rect;
 }
@@ -94,6 +96,7 @@ void BorderImage::SetFullImageRect()
 
 void BorderImage::SetBorder(const IntRect& rect)
 {
+    MarkBatchesDirty();
     border_.left_ = Max(rect.left_, 0);
     border_.top_ = Max(rect.top_, 0);
     border_.right_ = Max(rect.right_, 0);
@@ -102,6 +105,7 @@ void BorderImage::SetBorder(const IntRect& rect)
 
 void BorderImage::SetImageBorder(const IntRect& rect)
 {
+    MarkBatchesDirty();
     imageBorder_.left_ = Max(rect.left_, 0);
     imageBorder_.top_ = Max(rect.top_, 0);
     imageBorder_.right_ = Max(rect.right_, 0);
@@ -110,31 +114,37 @@ void BorderImage::SetImageBorder(const IntRect& rect)
 
 void BorderImage::SetHoverOffset(const IntVector2& offset)
 {
+    MarkBatchesDirty();
     hoverOffset_ = offset;
 }
 
 void BorderImage::SetHoverOffset(int x, int y)
 {
+    MarkBatchesDirty();
     hoverOffset_ = IntVector2(x, y);
 }
 
 void BorderImage::SetDisabledOffset(const IntVector2& offset)
 {
+    MarkBatchesDirty();
     disabledOffset_ = offset;
 }
 
 void BorderImage::SetDisabledOffset(int x, int y)
 {
+    MarkBatchesDirty();
     disabledOffset_ = IntVector2(x, y);
 }
 
 void BorderImage::SetBlendMode(BlendMode mode)
 {
+    MarkBatchesDirty();
     blendMode_ = mode;
 }
 
 void BorderImage::SetTiled(bool enable)
 {
+    MarkBatchesDirty();
     tiled_ = enable;
 }
 
@@ -239,6 +249,7 @@ ResourceRef BorderImage::GetMaterialAttr() const
 
 void BorderImage::SetMaterial(Material* material)
 {
+    MarkBatchesDirty();
     material_ = material;
 }
 
@@ -154,11 +154,13 @@ void Button::OnKey(Key key, MouseButtonFlags buttons, QualifierFlags qualifiers)
 
 void Button::SetPressedOffset(const IntVector2& offset)
 {
+    MarkBatchesDirty();
     pressedOffset_ = offset;
 }
 
 void Button::SetPressedOffset(int x, int y)
 {
+    MarkBatchesDirty();
     pressedOffset_ = IntVector2(x, y);
 }
 
@@ -190,6 +192,7 @@ void Button::SetRepeatRate(float rate)
 
 void Button::SetPressed(bool enable)
 {
+    MarkBatchesDirty();
     pressed_ = enable;
     SetChildOffset(pressed_ ? pressedChildOffset_ : IntVector2::ZERO);
 }
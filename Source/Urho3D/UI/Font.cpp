@@ -27,9 +27,11 @@
 #include "../Graphics/Graphics.h"
 #include "../IO/Deserializer.h"
 #include "../IO/FileSystem.h"
+#include "../IO/Log.h"
 #include "../UI/Font.h"
 #include "../UI/FontFaceBitmap.h"
 #include "../UI/FontFaceFreeType.h"
+#include "../UI/FontFaceScaled.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/XMLElement.h"
 #include "../Resource/XMLFile.h"
@@ -97,6 +99,8 @@ bool Font::BeginLoad(Deserializer& source)
     }
 
     ea::string ext = GetExtension(GetName());
+    sdfFont_ = ext == ".sdf";
+
     if (ext == ".ttf" || ext == ".otf" || ext == ".woff")
     {
         fontType_ = FONT_FREETYPE;
@@ -105,8 +109,6 @@ bool Font::BeginLoad(Deserializer& source)
     else if (ext == ".xml" || ext == ".fnt" || ext == ".sdf")
         fontType_ = FONT_BITMAP;
 
-    sdfFont_ = ext == ".sdf";
-
     SetMemoryUse(fontDataSize_);
     return true;
 }
@@ -136,6 +138,21 @@ void Font::SetScaledGlyphOffset(const Vector2& offset)
     scaledOffset_ = offset;
 }
 
+void Font::SetSDFFont(bool enable)
+{
+    if (fontType_ != FONT_FREETYPE)
+    {
+        URHO3D_LOGWARNING("Signed distance field mode can be changed only for FreeType fonts");
+        return;
+    }
+
+    if (enable != sdfFont_)
+    {
+        sdfFont_ = enable;
+        ReleaseFaces();
+    }
+}
+
 FontFace* Font::GetFace(float pointSize)
 {
     // In headless mode, always return null
@@ -168,7 +185,7 @@ FontFace* Font::GetFace(float pointSize)
     switch (fontType_)
     {
     case FONT_FREETYPE:
-        return GetFaceFreeType(pointSize);
+        return sdfFont_ ? GetFaceSDF(pointSize) : GetFaceFreeType(pointSize);
 
     case FONT_BITMAP:
         return GetFaceBitmap(pointSize);
@@ -187,6 +204,7 @@ IntVector2 Font::GetTotalGlyphOffset(float pointSize) const
 void Font::ReleaseFaces()
 {
     faces_.clear();
+    sdfAtlasFace_ = nullptr;
 }
 
 void Font::LoadParameters()
@@ -218,6 +236,10 @@ void Font::LoadParameters()
         scaledOffset_.x_ = scaledElem.GetFloat("x");
         scaledOffset_.y_ = scaledElem.GetFloat("y");
     }
+
+    XMLElement sdfElem = rootElem.GetChild("sdf");
+    if (sdfElem)
+        sdfFont_ = sdfElem.GetBool("enable");
 }
 
 FontFace* Font::GetFaceFreeType(float pointSize)
@@ -231,6 +253,29 @@ FontFace* Font::GetFaceFreeType(float pointSize)
     return newFace;
 }
 
+FontFace* Font::GetFaceSDF(float pointSize)
+{
+    if (!sdfAtlasFace_ || sdfAtlasFace_->IsDataLost())
+    {
+        // Atlas face is recreated together with all scaled faces
+        faces_.clear();
+        sdfAtlasFace_ = new FontFaceFreeType(this);
+        if (!sdfAtlasFace_->Load(&fontData_[0], fontDataSize_, SDF_FONT_POINT_SIZE))
+        {
+            sdfAtlasFace_ = nullptr;
+            return nullptr;
+        }
+    }
+
+    SharedPtr<FontFace> newFace(new FontFaceScaled(this, sdfAtlasFace_));
+    if (!newFace->Load(&fontData_[0], fontDataSize_, pointSize))
+        return nullptr;
+
+    int key = FloatToFixed(pointSize);
+    faces_[key] = newFace;
+    return newFace;
+}
+
 FontFace* Font::GetFaceBitmap(float pointSize)
 {
     SharedPtr<FontFace> newFace(new FontFaceBitmap(this));
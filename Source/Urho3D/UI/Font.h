@@ -35,6 +35,12 @@ class FontFace;
 
 static const int FONT_TEXTURE_MIN_SIZE = 128;
 static const int FONT_DPI = 96;
+/// Point size of glyph atlas shared by all sizes of signed distance field FreeType font.
+static const float SDF_FONT_POINT_SIZE = 32.0f;
+/// Distance in atlas pixels covered by signed distance field outside and inside of glyph edge.
+static const int SDF_FONT_SPREAD = 4;
+/// Supersampling of glyph images used to calculate signed distance field.
+static const int SDF_FONT_SUPERSAMPLING = 4;
 
 /// %Font file type.
 enum FontType
@@ -69,6 +75,9 @@ public:
     /// Set point size scaled position adjustment for glyphs.
     /// @property
     void SetScaledGlyphOffset(const Vector2& offset);
+    /// Set whether FreeType font is rendered as signed distance field.
+    /// All point sizes share one glyph atlas and glyphs are rendered on demand. Releases created faces.
+    void SetSDFFont(bool enable);
 
     /// Return font face. Pack and render to a texture if not rendered yet. Return null on error.
     FontFace* GetFace(float pointSize);
@@ -101,9 +110,13 @@ private:
     FontFace* GetFaceFreeType(float pointSize);
     /// Return bitmap font face. Called internally. Return null on error.
     FontFace* GetFaceBitmap(float pointSize);
+    /// Return signed distance field font face scaled from the shared atlas face. Called internally. Return null on error.
+    FontFace* GetFaceSDF(float pointSize);
 
     /// Created faces.
     ea::unordered_map<int, SharedPtr<FontFace> > faces_;
+    /// Glyph atlas face of signed distance field FreeType font.
+    SharedPtr<FontFace> sdfAtlasFace_;
     /// Font data.
     ea::shared_array<unsigned char> fontData_;
     /// Size of font data.
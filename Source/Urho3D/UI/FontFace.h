@@ -98,6 +98,7 @@ public:
 
 protected:
     friend class FontFaceBitmap;
+    friend class FontFaceScaled;
     /// Create a texture for font rendering.
     SharedPtr<Texture2D> CreateFaceTexture();
     /// Load font face texture from image resource.
@@ -49,6 +49,67 @@ inline float FixedToFloat(FT_Pos value)
     return value / 64.0f;
 }
 
+namespace
+{
+
+/// Compute squared Euclidean distance transform of one row or column in place.
+/// See "Distance Transforms of Sampled Functions" by Felzenszwalb and Huttenlocher.
+void ComputeDistanceTransform1D(float* data, unsigned stride, int count, ea::vector<float>& values,
+    ea::vector<int>& parabolas, ea::vector<float>& boundaries)
+{
+    values.resize(count);
+    parabolas.resize(count);
+    boundaries.resize(count + 1);
+    for (int i = 0; i < count; ++i)
+        values[i] = data[i * stride];
+
+    const auto intersect = [&](int q, int p)
+    { return ((values[q] + q * q) - (values[p] + p * p)) / (2.0f * (q - p)); };
+
+    // Build lower envelope of parabolas rooted at each sample
+    int k = 0;
+    parabolas[0] = 0;
+    boundaries[0] = -M_INFINITY;
+    boundaries[1] = M_INFINITY;
+    for (int q = 1; q < count; ++q)
+    {
+        float s = intersect(q, parabolas[k]);
+        while (s <= boundaries[k])
+        {
+            --k;
+            s = intersect(q, parabolas[k]);
+        }
+
+        ++k;
+        parabolas[k] = q;
+        boundaries[k] = s;
+        boundaries[k + 1] = M_INFINITY;
+    }
+
+    k = 0;
+    for (int q = 0; q < count; ++q)
+    {
+        while (boundaries[k + 1] < q)
+            ++k;
+        const int p = parabolas[k];
+        data[q * stride] = (q - p) * (q - p) + values[p];
+    }
+}
+
+/// Compute squared Euclidean distance transform of an image in place.
+void ComputeDistanceTransform(float* data, int width, int height)
+{
+    ea::vector<float> values;
+    ea::vector<int> parabolas;
+    ea::vector<float> boundaries;
+    for (int x = 0; x < width; ++x)
+        ComputeDistanceTransform1D(data + x, width, height, values, parabolas, boundaries);
+    for (int y = 0; y < height; ++y)
+        ComputeDistanceTransform1D(data + y * width, 1, width, values, parabolas, boundaries);
+}
+
+}
+
 /// FreeType library subsystem.
 class FreeTypeLibrary : public Object
 {
@@ -109,7 +170,11 @@ bool FontFaceFreeType::Load(const unsigned char* fontData, unsigned fontDataSize
     const FontHintLevel hintLevel = ui->GetFontHintLevel();
     const float subpixelThreshold = ui->GetFontSubpixelThreshold();
 
-    subpixel_ = (hintLevel <= FONT_HINT_LEVEL_LIGHT) && (pointSize <= subpixelThreshold);
+    // Signed distance field glyphs are rendered from supersampled images
+    sdf_ = font_->IsSDFFont();
+    supersampling_ = sdf_ ? SDF_FONT_SUPERSAMPLING : 1;
+
+    subpixel_ = !sdf_ && (hintLevel <= FONT_HINT_LEVEL_LIGHT) && (pointSize <= subpixelThreshold);
     oversampling_ = subpixel_ ? ui->GetFontOversampling() : 1;
 
     if (pointSize <= 0)
@@ -132,7 +197,7 @@ bool FontFaceFreeType::Load(const unsigned char* fontData, unsigned fontDataSize
         URHO3D_LOGERROR("Could not create font face");
         return false;
     }
-    error = FT_Set_Char_Size(face, 0, pointSize * 64, oversampling_ * FONT_DPI, FONT_DPI);
+    error = FT_Set_Char_Size(face, 0, pointSize * supersampling_ * 64, oversampling_ * FONT_DPI, FONT_DPI);
     if (error)
     {
         FT_Done_Face(face);
@@ -177,6 +242,9 @@ bool FontFaceFreeType::Load(const unsigned char* fontData, unsigned fontDataSize
         rowHeight_ = Max(rowHeight_, ascender_ + descender);
     }
 
+    ascender_ /= supersampling_;
+    rowHeight_ /= supersampling_;
+
     int textureWidth = maxTextureSize;
     int textureHeight = maxTextureSize;
     hasMutableGlyph_ = false;
@@ -194,7 +262,8 @@ bool FontFaceFreeType::Load(const unsigned char* fontData, unsigned fontDataSize
 
     while (glyphIndex != 0)
     {
-        if (!LoadCharGlyph(charCode, image))
+        // Signed distance field glyphs are expensive to render, so they are rendered only when requested
+        if (!sdf_ && !LoadCharGlyph(charCode, image))
         {
             hasMutableGlyph_ = true;
             break;
@@ -257,7 +326,7 @@ bool FontFaceFreeType::Load(const unsigned char* fontData, unsigned fontDataSize
                     deserializer.Seek((unsigned)(deserializer.GetPosition() + 3 * sizeof(unsigned short)));
 
                     // x_scale is a 16.16 fixed-point value that converts font units -> 26.6 pixels (oversampled!)
-                    auto xScale = (float)face->size->metrics.x_scale / (1u << 22u) / oversampling_;
+                    auto xScale = (float)face->size->metrics.x_scale / (1u << 22u) / (oversampling_ * supersampling_);
 
                     for (unsigned j = 0; j < numKerningPairs; ++j)
                     {
@@ -283,7 +352,7 @@ bool FontFaceFreeType::Load(const unsigned char* fontData, unsigned fontDataSize
             URHO3D_LOGWARNING("Can not read kerning information: not version 0");
     }
 
-    if (!hasMutableGlyph_)
+    if (!hasMutableGlyph_ && !sdf_)
     {
         FT_Done_Face(face);
         face_ = nullptr;
@@ -394,6 +463,58 @@ void FontFaceFreeType::BoxFilter(unsigned char* dest, size_t destSize, const uns
     }
 }
 
+void FontFaceFreeType::RenderDistanceField(unsigned char* dest, unsigned pitch, const FontGlyph& fontGlyph) const
+{
+    const FT_Bitmap& bitmap = ((FT_Face)face_)->glyph->bitmap;
+    const int padding = SDF_FONT_SPREAD * supersampling_;
+    const int width = static_cast<int>(bitmap.width) + 2 * padding;
+    const int height = static_cast<int>(bitmap.rows) + 2 * padding;
+
+    // Squared distances to the nearest pixel inside and outside of the glyph
+    ea::vector<float> distanceToInside(width * height);
+    ea::vector<float> distanceToOutside(width * height);
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            const int srcX = x - padding;
+            const int srcY = y - padding;
+            bool inside = false;
+            if (srcX >= 0 && srcY >= 0 && srcX < static_cast<int>(bitmap.width) && srcY < static_cast<int>(bitmap.rows))
+            {
+                const unsigned char* src = bitmap.buffer + bitmap.pitch * srcY;
+                if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+                    inside = (src[srcX >> 3u] & (0x80u >> (srcX & 7u))) != 0;
+                else
+                    inside = src[srcX] >= 128;
+            }
+            distanceToInside[y * width + x] = inside ? 0.0f : M_LARGE_VALUE;
+            distanceToOutside[y * width + x] = inside ? M_LARGE_VALUE : 0.0f;
+        }
+    }
+
+    ComputeDistanceTransform(distanceToInside.data(), width, height);
+    ComputeDistanceTransform(distanceToOutside.data(), width, height);
+
+    // Sample the centers of supersampled blocks and map [-spread, spread] to [0, 1]
+    const float maxDistance = static_cast<float>(padding);
+    for (int y = 0; y < fontGlyph.texHeight_; ++y)
+    {
+        unsigned char* rowDest = dest + y * pitch;
+        const int srcY = Min(y * supersampling_ + supersampling_ / 2, height - 1);
+        for (int x = 0; x < fontGlyph.texWidth_; ++x)
+        {
+            const int srcX = Min(x * supersampling_ + supersampling_ / 2, width - 1);
+            const unsigned index = srcY * width + srcX;
+            const float distance = distanceToOutside[index] > 0.0f
+                ? Sqrt(distanceToOutside[index]) - 0.5f
+                : -(Sqrt(distanceToInside[index]) - 0.5f);
+            const float value = Clamp(0.5f + 0.5f * distance / maxDistance, 0.0f, 1.0f);
+            rowDest[x] = static_cast<unsigned char>(value * 255.0f + 0.5f);
+        }
+    }
+}
+
 bool FontFaceFreeType::LoadCharGlyph(unsigned charCode, Image* image)
 {
     if (!face_)
@@ -441,6 +562,25 @@ bool FontFaceFreeType::LoadCharGlyph(unsigned charCode, Image* image)
         fontGlyph.width_ /= oversampling_;
         fontGlyph.offsetX_ /= oversampling_;
         fontGlyph.advanceX_ /= oversampling_;
+
+        if (sdf_ && slot->bitmap.width > 0 && slot->bitmap.rows > 0)
+        {
+            // Glyph image is downsampled and padded to keep the distance field around the edges
+            const int padding = SDF_FONT_SPREAD * supersampling_;
+            fontGlyph.texWidth_ = (slot->bitmap.width + 2 * padding + supersampling_ - 1) / supersampling_;
+            fontGlyph.texHeight_ = (slot->bitmap.rows + 2 * padding + supersampling_ - 1) / supersampling_;
+            fontGlyph.width_ = fontGlyph.texWidth_;
+            fontGlyph.height_ = fontGlyph.texHeight_;
+            fontGlyph.offsetX_ = static_cast<float>(slot->bitmap_left - padding) / supersampling_;
+            fontGlyph.offsetY_ = floorf(ascender_ + 0.5f) - static_cast<float>(slot->bitmap_top + padding) / supersampling_;
+            fontGlyph.advanceX_ = FixedToFloat(slot->metrics.horiAdvance) / supersampling_;
+        }
+        else if (sdf_)
+        {
+            fontGlyph.texWidth_ = 0;
+            fontGlyph.texHeight_ = 0;
+            fontGlyph.advanceX_ = FixedToFloat(slot->metrics.horiAdvance) / supersampling_;
+        }
     }
 
     int x = 0, y = 0;
@@ -487,7 +627,11 @@ bool FontFaceFreeType::LoadCharGlyph(unsigned charCode, Image* image)
             pitch = (unsigned)fontGlyph.texWidth_;
         }
 
-        if (slot->bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+        if (sdf_)
+        {
+            RenderDistanceField(dest, pitch, fontGlyph);
+        }
+        else if (slot->bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
         {
             for (unsigned y = 0; y < (unsigned)slot->bitmap.rows; ++y)
             {
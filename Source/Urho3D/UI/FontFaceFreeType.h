@@ -54,6 +54,8 @@ private:
     bool LoadCharGlyph(unsigned charCode, Image* image = nullptr);
     /// Smooth one row of a horizontally oversampled glyph image.
     void BoxFilter(unsigned char* dest, size_t destSize, const unsigned char* src, size_t srcSize);
+    /// Convert supersampled glyph bitmap of the current glyph slot to signed distance field.
+    void RenderDistanceField(unsigned char* dest, unsigned pitch, const FontGlyph& fontGlyph) const;
 
     /// FreeType library.
     SharedPtr<FreeTypeLibrary> freeType_;
@@ -69,6 +71,10 @@ private:
     float ascender_{};
     /// Has mutable glyph.
     bool hasMutableGlyph_{};
+    /// Whether glyphs are rendered as signed distance field on demand.
+    bool sdf_{};
+    /// Scale from FreeType glyph metrics to glyph metrics in the texture.
+    int supersampling_{1};
     /// Glyph area allocator.
     AreaAllocator allocator_;
 };
@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../UI/FontFaceScaled.h"
+
+#include "../Graphics/Texture2D.h"
+#include "../IO/Log.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+FontFaceScaled::FontFaceScaled(Font* font, FontFace* atlasFace) :
+    FontFace(font),
+    atlasFace_(atlasFace)
+{
+}
+
+FontFaceScaled::~FontFaceScaled()
+{
+    // Textures are owned and accounted by the atlas face
+    textures_.clear();
+}
+
+bool FontFaceScaled::Load(const unsigned char* fontData, unsigned fontDataSize, float pointSize)
+{
+    const float atlasPointSize = atlasFace_->GetPointSize();
+    if (pointSize <= 0 || atlasPointSize <= 0)
+    {
+        URHO3D_LOGERROR("Zero or negative point size");
+        return false;
+    }
+
+    pointSize_ = pointSize;
+    scale_ = pointSize / atlasPointSize;
+    rowHeight_ = atlasFace_->GetRowHeight() * scale_;
+    textures_ = atlasFace_->GetTextures();
+
+    kerningMapping_ = atlasFace_->kerningMapping_;
+    for (auto& item : kerningMapping_)
+        item.second *= scale_;
+
+    return true;
+}
+
+const FontGlyph* FontFaceScaled::GetGlyph(unsigned c)
+{
+    auto i = glyphMapping_.find(c);
+    if (i != glyphMapping_.end())
+    {
+        FontGlyph& glyph = i->second;
+        glyph.used_ = true;
+        // Make sure the glyph stays resident in the atlas
+        if (atlasFace_->HasMutableGlyphs())
+            atlasFace_->GetGlyph(c);
+        return &glyph;
+    }
+
+    const FontGlyph* atlasGlyph = atlasFace_->GetGlyph(c);
+    if (!atlasGlyph)
+        return nullptr;
+
+    // Atlas may have allocated new texture page for the glyph
+    textures_ = atlasFace_->GetTextures();
+
+    FontGlyph& glyph = glyphMapping_[c];
+    glyph = *atlasGlyph;
+    glyph.width_ *= scale_;
+    glyph.height_ *= scale_;
+    glyph.offsetX_ *= scale_;
+    glyph.offsetY_ *= scale_;
+    glyph.advanceX_ *= scale_;
+    glyph.used_ = true;
+    return &glyph;
+}
+
+}
@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../UI/FontFace.h"
+
+namespace Urho3D
+{
+
+/// %Font face that reuses glyphs and textures of another face scaled to a different point size.
+/// Used for signed distance field fonts so that all point sizes share one glyph atlas.
+class URHO3D_API FontFaceScaled : public FontFace
+{
+public:
+    /// Construct.
+    FontFaceScaled(Font* font, FontFace* atlasFace);
+    /// Destruct.
+    ~FontFaceScaled() override;
+
+    /// Load font face. Font data is ignored, glyphs are taken from the atlas face.
+    bool Load(const unsigned char* fontData, unsigned fontDataSize, float pointSize) override;
+    /// Return pointer to the glyph structure corresponding to a character. Return null if glyph not found.
+    const FontGlyph* GetGlyph(unsigned c) override;
+
+    /// Return if font face uses mutable glyphs.
+    bool HasMutableGlyphs() const override { return atlasFace_->HasMutableGlyphs(); }
+
+private:
+    /// Face that owns glyph textures.
+    SharedPtr<FontFace> atlasFace_;
+    /// Scale from atlas face to this face.
+    float scale_{1.0f};
+};
+
+}
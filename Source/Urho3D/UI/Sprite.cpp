@@ -192,6 +192,7 @@ void Sprite::SetRotation(float angle)
 
 void Sprite::SetTexture(Texture* texture)
 {
+    MarkBatchesDirty();
     texture_ = texture;
     if (imageRect_ == IntRect::ZERO)
         SetFullImageRect();
@@ -199,6 +200,7 @@ void Sprite::SetTexture(Texture* texture)
 
 void Sprite::SetImageRect(const IntRect& rect)
 {
+    MarkBatchesDirty();
     if (rect != IntRect::ZERO)
         imageRect_ = rect;
 }
@@ -211,6 +213,7 @@ void Sprite::SetFullImageRect()
 
 void Sprite::SetBlendMode(BlendMode mode)
 {
+    MarkBatchesDirty();
     blendMode_ = mode;
 }
 
@@ -180,6 +180,7 @@ void Text::GetBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexDat
     {
         // One batch per texture/page
         UIBatch pageBatch(this, BLEND_ALPHA, currentScissor, textures[n], &vertexData);
+        pageBatch.signedDistanceField_ = font_->IsSDFFont();
 
         const ea::vector<GlyphLocation>& pageGlyphLocation = pageGlyphLocations_[n];
 
@@ -313,6 +314,7 @@ void Text::SetTextAlignment(HorizontalAlignment align)
     {
         textAlignment_ = align;
         charLocationsDirty_ = true;
+        MarkBatchesDirty();
     }
 }
 
@@ -369,6 +371,7 @@ void Text::HandleChangeLanguage(StringHash eventType, VariantMap& eventData)
 
 void Text::SetSelection(unsigned start, unsigned length)
 {
+    MarkBatchesDirty();
     selectionStart_ = start;
     selectionLength_ = length;
     ValidateSelection();
@@ -376,37 +379,44 @@ void Text::SetSelection(unsigned start, unsigned length)
 
 void Text::ClearSelection()
 {
+    MarkBatchesDirty();
     selectionStart_ = 0;
     selectionLength_ = 0;
 }
 
 void Text::SetTextEffect(TextEffect textEffect)
 {
+    MarkBatchesDirty();
     textEffect_ = textEffect;
 }
 
 void Text::SetEffectShadowOffset(const IntVector2& offset)
 {
+    MarkBatchesDirty();
     shadowOffset_ = offset;
 }
 
 void Text::SetEffectStrokeThickness(int thickness)
 {
+    MarkBatchesDirty();
     strokeThickness_ = Abs(thickness);
 }
 
 void Text::SetEffectRoundStroke(bool roundStroke)
 {
+    MarkBatchesDirty();
     roundStroke_ = roundStroke;
 }
 
 void Text::SetEffectColor(const Color& effectColor)
 {
+    MarkBatchesDirty();
     effectColor_ = effectColor;
 }
 
 void Text::SetEffectDepthBias(float bias)
 {
+    MarkBatchesDirty();
     effectDepthBias_ = bias;
 }
 
@@ -485,6 +495,7 @@ bool Text::FilterImplicitAttributes(XMLElement& dest) const
 
 void Text::UpdateText(bool onResize)
 {
+    MarkBatchesDirty();
     rowWidths_.clear();
     printText_.clear();
 
@@ -704,20 +704,25 @@ void Text3D::UpdateTextMaterials(bool forceUpdate)
                 Pass* pass = tech ? tech->GetPass("alpha") : nullptr;
                 if (pass)
                 {
+                    // Distance is stored in red channel of FreeType glyph atlas
+                    ea::string defines = "SIGNED_DISTANCE_FIELD";
+                    if (texture && texture->GetFormat() == TextureFormat::TEX_FORMAT_R8_UNORM)
+                        defines += " ALPHAMAP";
+
                     switch (GetTextEffect())
                     {
                     case TE_NONE:
-                        pass->SetPixelShaderDefines("SIGNED_DISTANCE_FIELD");
                         break;
 
                     case TE_SHADOW:
-                        pass->SetPixelShaderDefines("SIGNED_DISTANCE_FIELD TEXT_EFFECT_SHADOW");
+                        defines += " TEXT_EFFECT_SHADOW";
                         break;
 
                     case TE_STROKE:
-                        pass->SetPixelShaderDefines("SIGNED_DISTANCE_FIELD TEXT_EFFECT_STROKE");
+                        defines += " TEXT_EFFECT_STROKE";
                         break;
                     }
+                    pass->SetPixelShaderDefines(defines);
                 }
             }
 
@@ -406,6 +406,10 @@ void UI::Update(float timeStep)
             UIElement* element = i->first;
             if (element)
             {
+                // Hovering is not reset when cached batches are used
+                element->SetHovering(false);
+                element->MarkBatchesDirty();
+
                 using namespace HoverEnd;
 
                 VariantMap& eventData = GetEventDataMap();
@@ -881,11 +885,15 @@ void UI::Initialize()
     const ea::string alphaMapDefines = baseDefines + "ALPHAMAP ";
     const ea::string diffMapDefines = baseDefines + "DIFFMAP ";
     const ea::string diffMapAlphaMaskDefines = diffMapDefines + "ALPHAMASK ";
+    const ea::string sdfAlphaMapDefines = alphaMapDefines + "SIGNED_DISTANCE_FIELD ";
+    const ea::string sdfDiffMapDefines = diffMapDefines + "SIGNED_DISTANCE_FIELD ";
 
     noTextureMaterial_ = Material::CreateBaseMaterial(context_, "v2/X_Basic", baseDefines, baseDefines);
     alphaMapMaterial_ = Material::CreateBaseMaterial(context_, "v2/X_Basic", alphaMapDefines, alphaMapDefines);
     diffMapMaterial_ = Material::CreateBaseMaterial(context_, "v2/X_Basic", diffMapDefines, diffMapDefines);
     diffMapAlphaMaskMaterial_ = Material::CreateBaseMaterial(context_, "v2/X_Basic", diffMapDefines, diffMapAlphaMaskDefines);
+    sdfAlphaMapMaterial_ = Material::CreateBaseMaterial(context_, "v2/X_Basic", alphaMapDefines, sdfAlphaMapDefines);
+    sdfDiffMapMaterial_ = Material::CreateBaseMaterial(context_, "v2/X_Basic", diffMapDefines, sdfDiffMapDefines);
 
     initialized_ = true;
 
@@ -930,6 +938,8 @@ Material* UI::GetBatchMaterial(const UIBatch& batch) const
 
     if (!batch.texture_)
         return noTextureMaterial_;
+    else if (batch.signedDistanceField_)
+        return batch.texture_->GetFormat() == TextureFormat::TEX_FORMAT_R8_UNORM ? sdfAlphaMapMaterial_ : sdfDiffMapMaterial_;
     else if (batch.texture_->GetFormat() == TextureFormat::TEX_FORMAT_R8_UNORM)
         return alphaMapMaterial_;
     else if (batch.blendMode_ != BLEND_ALPHA && batch.blendMode_ != BLEND_ADDALPHA && batch.blendMode_ != BLEND_PREMULALPHA)
@@ -1076,6 +1086,26 @@ void UI::GetBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData,
     if (currentScissor.left_ == currentScissor.right_ || currentScissor.top_ == currentScissor.bottom_)
         return;
 
+    // Reuse batches of child elements if nothing has changed
+    if (UIBatchCache* cache = element->GetBatchCache())
+    {
+        if (cache->dirty_ || cache->scissor_ != currentScissor)
+        {
+            cache->batches_.clear();
+            cache->vertexData_.clear();
+            cache->scissor_ = currentScissor;
+            cache->dirty_ = false;
+            GetChildBatches(cache->batches_, cache->vertexData_, element, currentScissor);
+        }
+        cache->AppendTo(batches, vertexData);
+        return;
+    }
+
+    GetChildBatches(batches, vertexData, element, currentScissor);
+}
+
+void UI::GetChildBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, UIElement* element, const IntRect& currentScissor)
+{
     element->SortChildren();
     const ea::vector<SharedPtr<UIElement> >& children = element->GetChildren();
     if (children.empty())
@@ -1296,6 +1326,7 @@ void UI::ProcessHover(const IntVector2& windowCursorPos, MouseButtonFlags button
                 // Begin hover event
                 if (!hoveredElements_.contains(element))
                 {
+                    element->MarkBatchesDirty();
                     SendDragOrHoverEvent(E_HOVERBEGIN, element, cursorPos, IntVector2::ZERO, nullptr);
                     // Exit if element is destroyed by the event handling
                     if (!element)
@@ -1341,6 +1372,7 @@ void UI::ProcessHover(const IntVector2& windowCursorPos, MouseButtonFlags button
             // Begin hover event
             if (!hoveredElements_.contains(element))
             {
+                element->MarkBatchesDirty();
                 SendDragOrHoverEvent(E_HOVERBEGIN, element, cursorPos, IntVector2::ZERO, nullptr);
                 // Exit if element is destroyed by the event handling
                 if (!element)
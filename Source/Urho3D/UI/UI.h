@@ -311,6 +311,8 @@ private:
     void Render(VertexBuffer* buffer, const ea::vector<UIBatch>& batches, unsigned batchStart, unsigned batchEnd);
     /// Generate batches from an UI element recursively. Skip the cursor element.
     void GetBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, UIElement* element, IntRect currentScissor);
+    /// Generate batches from child elements of an UI element. Skip the cursor element.
+    void GetChildBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, UIElement* element, const IntRect& currentScissor);
     /// Return UI element at screen position recursively.
     void GetElementAt(UIElement*& result, UIElement* current, const IntVector2& position, bool enabledOnly);
     /// Return the first element in hierarchy that can alter focus.
@@ -496,6 +498,8 @@ private:
     SharedPtr<Material> alphaMapMaterial_;
     SharedPtr<Material> diffMapMaterial_;
     SharedPtr<Material> diffMapAlphaMaskMaterial_;
+    SharedPtr<Material> sdfAlphaMapMaterial_;
+    SharedPtr<Material> sdfDiffMapMaterial_;
     /// @}
 };
 
@@ -407,7 +407,8 @@ bool UIBatch::Merge(const UIBatch& batch)
         batch.texture_ != texture_ ||
         batch.vertexData_ != vertexData_ ||
         batch.vertexStart_ != vertexEnd_ ||
-        batch.customMaterial_ != customMaterial_)
+        batch.customMaterial_ != customMaterial_ ||
+        batch.signedDistanceField_ != signedDistanceField_)
         return false;
 
     vertexEnd_ = batch.vertexEnd_;
@@ -448,4 +449,19 @@ void UIBatch::AddOrMerge(const UIBatch& batch, ea::vector<UIBatch>& batches)
     batches.push_back(batch);
 }
 
+void UIBatchCache::AppendTo(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData) const
+{
+    const unsigned vertexOffset = vertexData.size();
+    vertexData.insert(vertexData.end(), vertexData_.begin(), vertexData_.end());
+
+    for (const UIBatch& cachedBatch : batches_)
+    {
+        UIBatch batch = cachedBatch;
+        batch.vertexData_ = &vertexData;
+        batch.vertexStart_ += vertexOffset;
+        batch.vertexEnd_ += vertexOffset;
+        UIBatch::AddOrMerge(batch, batches);
+    }
+}
+
 }
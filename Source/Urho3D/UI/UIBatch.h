@@ -95,6 +95,24 @@ public:
     bool useGradient_{};
     /// Custom material.
     Material* customMaterial_{};
+    /// Whether the texture is signed distance field font texture.
+    bool signedDistanceField_{};
+};
+
+/// Cached rendering batches of %UI element children.
+struct URHO3D_API UIBatchCache
+{
+    /// Append cached batches and their vertex data.
+    void AppendTo(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData) const;
+
+    /// Scissor rectangle the batches were generated with.
+    IntRect scissor_;
+    /// Cached batches. Vertex ranges refer to the cached vertex data.
+    ea::vector<UIBatch> batches_;
+    /// Cached vertex data.
+    ea::vector<float> vertexData_;
+    /// Whether the batches should be generated again.
+    bool dirty_{true};
 };
 
 }
@@ -147,6 +147,7 @@ void UIElement::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Bring To Back", GetBringToBack, SetBringToBack, bool, true, AM_FILE);
     URHO3D_ACCESSOR_ATTRIBUTE("Clip Children", GetClipChildren, SetClipChildren, bool, false, AM_FILE);
     URHO3D_ACCESSOR_ATTRIBUTE("Use Derived Opacity", GetUseDerivedOpacity, SetUseDerivedOpacity, bool, true, AM_FILE);
+    URHO3D_ACCESSOR_ATTRIBUTE("Cache Batches", GetBatchCaching, SetBatchCaching, bool, false, AM_FILE);
     URHO3D_ENUM_ACCESSOR_ATTRIBUTE("Focus Mode", GetFocusMode, SetFocusMode, FocusMode, focusModes, FM_NOTFOCUSABLE, AM_FILE);
     URHO3D_ENUM_ACCESSOR_ATTRIBUTE("Drag And Drop Mode", GetDragDropMode, SetDragDropMode, DragAndDropModeFlags, dragDropModes, DD_DISABLED, AM_FILE);
     URHO3D_ENUM_ACCESSOR_ATTRIBUTE("Layout Mode", GetLayoutMode, SetLayoutMode, LayoutMode, layoutModes, LM_FREE, AM_FILE);
@@ -841,6 +842,7 @@ void UIElement::SetPivot(float x, float y)
 
 void UIElement::SetClipBorder(const IntRect& rect)
 {
+    MarkBatchesDirty();
     clipBorder_.left_ = Max(rect.left_, 0);
     clipBorder_.top_ = Max(rect.top_, 0);
     clipBorder_.right_ = Max(rect.right_, 0);
@@ -849,6 +851,7 @@ void UIElement::SetClipBorder(const IntRect& rect)
 
 void UIElement::SetColor(const Color& color)
 {
+    MarkBatchesDirty();
     for (auto& cornerColor : colors_)
         cornerColor = color;
     colorGradient_ = false;
@@ -857,6 +860,7 @@ void UIElement::SetColor(const Color& color)
 
 void UIElement::SetColor(Corner corner, const Color& color)
 {
+    MarkBatchesDirty();
     colors_[corner] = color;
     colorGradient_ = false;
     derivedColorDirty_ = true;
@@ -876,6 +880,7 @@ void UIElement::SetPriority(int priority)
     priority_ = priority;
     if (parent_)
         parent_->sortOrderDirty_ = true;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetOpacity(float opacity)
@@ -896,11 +901,13 @@ void UIElement::SetBringToBack(bool enable)
 
 void UIElement::SetClipChildren(bool enable)
 {
+    MarkBatchesDirty();
     clipChildren_ = enable;
 }
 
 void UIElement::SetSortChildren(bool enable)
 {
+    MarkBatchesDirty();
     if (!sortChildren_ && enable)
         sortOrderDirty_ = true;
 
@@ -910,16 +917,41 @@ void UIElement::SetSortChildren(bool enable)
 void UIElement::SetUseDerivedOpacity(bool enable)
 {
     useDerivedOpacity_ = enable;
+    MarkDirty();
+}
+
+void UIElement::SetBatchCaching(bool enable)
+{
+    if (enable == GetBatchCaching())
+        return;
+
+    if (enable)
+        batchCache_ = ea::make_unique<UIBatchCache>();
+    else
+        batchCache_ = nullptr;
+    MarkBatchesDirty();
+}
+
+void UIElement::MarkBatchesDirty()
+{
+    // Batches of an element are stored in the caches of all its parents
+    for (UIElement* element = this; element; element = element->parent_)
+    {
+        if (element->batchCache_)
+            element->batchCache_->dirty_ = true;
+    }
 }
 
 void UIElement::SetEnabled(bool enable)
 {
+    MarkBatchesDirty();
     enabled_ = enable;
     enabledPrev_ = enable;
 }
 
 void UIElement::SetDeepEnabled(bool enable)
 {
+    MarkBatchesDirty();
     enabled_ = enable;
 
     for (auto i = children_.begin(); i != children_.end(); ++i)
@@ -928,6 +960,7 @@ void UIElement::SetDeepEnabled(bool enable)
 
 void UIElement::ResetDeepEnabled()
 {
+    MarkBatchesDirty();
     enabled_ = enabledPrev_;
 
     for (auto i = children_.begin(); i != children_.end(); ++i)
@@ -936,6 +969,7 @@ void UIElement::ResetDeepEnabled()
 
 void UIElement::SetEnabledRecursive(bool enable)
 {
+    MarkBatchesDirty();
     enabled_ = enable;
     enabledPrev_ = enable;
 
@@ -979,6 +1013,7 @@ void UIElement::SetFocus(bool enable)
 
 void UIElement::SetSelected(bool enable)
 {
+    MarkBatchesDirty();
     selected_ = enable;
 }
 
@@ -992,6 +1027,7 @@ void UIElement::SetVisible(bool enable)
     if (enable != visible_)
     {
         visible_ = enable;
+        MarkBatchesDirty();
 
         // Parent's layout may change as a result of visibility change
         if (parent_)
@@ -1389,6 +1425,7 @@ void UIElement::RemoveChild(UIElement* element, unsigned index)
                 sender->SendEvent(E_ELEMENTREMOVED, eventData);
             }
 
+            MarkBatchesDirty();
             element->Detach();
             children_.erase_at(i);
             UpdateLayout();
@@ -1399,6 +1436,7 @@ void UIElement::RemoveChild(UIElement* element, unsigned index)
 
 void UIElement::RemoveChildAtIndex(unsigned index)
 {
+    MarkBatchesDirty();
     if (index >= children_.size())
         return;
 
@@ -1423,6 +1461,7 @@ void UIElement::RemoveChildAtIndex(unsigned index)
 
 void UIElement::RemoveAllChildren()
 {
+    MarkBatchesDirty();
     UIElement* root = GetRoot();
     UIElement* sender = Refs() > 0 ? GetElementEventSender() : nullptr;
 
@@ -1484,6 +1523,7 @@ void UIElement::SetInternal(bool enable)
 
 void UIElement::SetTraversalMode(TraversalMode traversalMode)
 {
+    MarkBatchesDirty();
     traversalMode_ = traversalMode;
 }
 
@@ -1855,6 +1895,8 @@ void UIElement::SetChildOffset(const IntVector2& offset)
 
 void UIElement::SetHovering(bool enable)
 {
+    if (enable != hovering_)
+        MarkBatchesDirty();
     hovering_ = enable;
 }
 
@@ -1978,8 +2020,15 @@ Animatable* UIElement::FindAttributeAnimationTarget(const ea::string& name, ea::
     }
 }
 
+void UIElement::OnSetAttribute(const AttributeInfo& attr, const Variant& src)
+{
+    Animatable::OnSetAttribute(attr, src);
+    MarkBatchesDirty();
+}
+
 void UIElement::MarkDirty()
 {
+    MarkBatchesDirty();
     positionDirty_ = true;
     opacityDirty_ = true;
     derivedColorDirty_ = true;
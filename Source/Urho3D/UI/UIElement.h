@@ -30,6 +30,8 @@
 #include "../Scene/Animatable.h"
 #include "../UI/UIBatch.h"
 
+#include <EASTL/unique_ptr.h>
+
 namespace Urho3D
 {
 
@@ -328,6 +330,13 @@ public:
     /// Set whether parent elements' opacity affects opacity. Default true.
     /// @property
     void SetUseDerivedOpacity(bool enable);
+    /// Set whether to cache rendering batches of child elements. Default false.
+    /// Cached batches are reused until a child element is changed. Useful for large static hierarchies.
+    /// @property
+    void SetBatchCaching(bool enable);
+    /// Mark cached rendering batches of this element and its parents as outdated.
+    /// Elements with custom rendering should call it when their batches change.
+    void MarkBatchesDirty();
     /// Set whether reacts to input. Default false, but is enabled by subclasses if applicable.
     /// @property
     void SetEnabled(bool enable);
@@ -583,6 +592,13 @@ public:
     /// @property
     bool GetUseDerivedOpacity() const { return useDerivedOpacity_; }
 
+    /// Return whether rendering batches of child elements are cached.
+    /// @property
+    bool GetBatchCaching() const { return batchCache_ != nullptr; }
+
+    /// Return cached rendering batches of child elements, or null if caching is disabled. Used internally.
+    UIBatchCache* GetBatchCache() const { return batchCache_.get(); }
+
     /// Return whether has focus.
     /// @property{get_focus}
     bool HasFocus() const;
@@ -770,6 +786,8 @@ protected:
     void OnAttributeAnimationRemoved() override;
     /// Find target of an attribute animation from object hierarchy by name.
     Animatable* FindAttributeAnimationTarget(const ea::string& name, ea::string& outName) override;
+    /// Handle attribute write access.
+    void OnSetAttribute(const AttributeInfo& attr, const Variant& src) override;
     /// Mark screen position as needing an update.
     void MarkDirty();
     /// Remove child XML element by matching attribute name.
@@ -855,6 +873,8 @@ protected:
     MouseButtonFlags dragButtonCombo_{};
     /// Drag button count.
     unsigned dragButtonCount_{};
+    /// Cached rendering batches of child elements.
+    ea::unique_ptr<UIBatchCache> batchCache_;
 
 private:
     /// Return child elements recursively.
@@ -30,6 +30,8 @@
 #include "../Urho2D/Drawable2D.h"
 #include "../Urho2D/Renderer2D.h"
 
+#include <atomic>
+
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -37,6 +39,9 @@ namespace Urho3D
 
 const float PIXEL_SIZE = 0.01f;
 
+/// Last assigned version of source batches. Source batches may be updated from worker threads during culling.
+static std::atomic<unsigned> lastSourceBatchesVersion{0};
+
 SourceBatch2D::SourceBatch2D() :
     distance_(0.0f),
     drawOrder_(0)
@@ -97,7 +102,10 @@ void Drawable2D::SetOrderInLayer(int orderInLayer)
 const ea::vector<SourceBatch2D>& Drawable2D::GetSourceBatches()
 {
     if (sourceBatchesDirty_)
+    {
         UpdateSourceBatches();
+        sourceBatchesVersion_ = ++lastSourceBatchesVersion;
+    }
 
     return sourceBatches_;
 }
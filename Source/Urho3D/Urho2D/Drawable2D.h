@@ -128,6 +128,8 @@ public:
 
     /// Return all source batches (called by Renderer2D).
     const ea::vector<SourceBatch2D>& GetSourceBatches();
+    /// Return version of source batches, unique among all drawables. Used by Renderer2D to reuse uploaded vertices.
+    unsigned GetSourceBatchesVersion() const { return sourceBatchesVersion_; }
 
 protected:
     /// Handle scene being assigned.
@@ -150,6 +152,8 @@ protected:
     ea::vector<SourceBatch2D> sourceBatches_;
     /// Source batches dirty flag.
     bool sourceBatchesDirty_;
+    /// Source batches version.
+    unsigned sourceBatchesVersion_{};
     /// Renderer2D.
     WeakPtr<Renderer2D> renderer_;
 };
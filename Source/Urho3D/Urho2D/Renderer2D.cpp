@@ -192,10 +192,12 @@ void Renderer2D::UpdateBatchesDelayed(const FrameInfo& frame)
     Camera* camera = frame.camera_;
     ViewBatchInfo2D& viewBatchInfo = viewBatchInfos_[camera];
 
-    if (viewBatchInfo.vertexBufferUpdateFrameNumber_ != frame_.frameNumber_)
+    // Vertex buffer is kept between frames while visible source batches stay the same
+    VertexBuffer* vertexBuffer = viewBatchInfo.vertexBuffer_;
+    const bool vertexBufferDirty = viewBatchInfo.vertexBufferDirty_ || vertexBuffer->IsDataLost();
+    if (viewBatchInfo.vertexBufferUpdateFrameNumber_ != frame_.frameNumber_ && vertexBufferDirty)
     {
         unsigned vertexCount = viewBatchInfo.vertexCount_;
-        VertexBuffer* vertexBuffer = viewBatchInfo.vertexBuffer_;
         vertexBuffer->SetDebugName("Renderer2D Batches");
 
         if (vertexBuffer->GetVertexCount() < vertexCount)
@@ -216,10 +218,13 @@ void Renderer2D::UpdateBatchesDelayed(const FrameInfo& frame)
                 }
 
                 vertexBuffer->Unmap();
+                viewBatchInfo.vertexBufferDirty_ = false;
             }
             else
                 URHO3D_LOGERROR("Failed to lock vertex buffer");
         }
+        else
+            viewBatchInfo.vertexBufferDirty_ = false;
 
         viewBatchInfo.vertexBufferUpdateFrameNumber_ = frame_.frameNumber_;
     }
@@ -373,18 +378,32 @@ void Renderer2D::GetDrawables(ea::vector<Drawable2D*>& drawables, Node* node)
         GetDrawables(drawables, i->Get());
 }
 
-static inline bool CompareSourceBatch2Ds(const SourceBatch2D* lhs, const SourceBatch2D* rhs)
+namespace
+{
+
+/// Return radix key ordering by draw order ascending, then by distance descending.
+unsigned long long GetDrawOrderDistanceKey(int drawOrder, float distance)
 {
-    if (lhs->drawOrder_ != rhs->drawOrder_)
-        return lhs->drawOrder_ < rhs->drawOrder_;
+    // Flip sign bit of draw order and map float bits to unsigned order, then invert to sort farther batches first
+    const auto orderBits = static_cast<unsigned>(drawOrder) ^ 0x80000000u;
+    unsigned distanceBits;
+    memcpy(&distanceBits, &distance, sizeof(distanceBits));
+    distanceBits ^= (distanceBits & 0x80000000u) ? 0xffffffffu : 0x80000000u;
+    return static_cast<unsigned long long>(orderBits) << 32u | ~distanceBits;
+}
 
-    if (lhs->distance_ != rhs->distance_)
-        return lhs->distance_ > rhs->distance_;
+struct ExtractDrawOrderDistanceKey
+{
+    using radix_type = unsigned long long;
+    radix_type operator()(const SourceBatch2DSortKey& value) const { return value.key_; }
+};
 
-    if (lhs->material_ != rhs->material_)
-        return lhs->material_->GetNameHash() < rhs->material_->GetNameHash();
+struct ExtractMaterialHashKey
+{
+    using radix_type = unsigned;
+    radix_type operator()(const SourceBatch2DSortKey& value) const { return value.materialHash_; }
+};
 
-    return lhs < rhs;
 }
 
 void Renderer2D::UpdateViewBatchInfo(ViewBatchInfo2D& viewBatchInfo, Camera* camera)
@@ -393,33 +412,45 @@ void Renderer2D::UpdateViewBatchInfo(ViewBatchInfo2D& viewBatchInfo, Camera* cam
     if (viewBatchInfo.batchUpdatedFrameNumber_ == frame_.frameNumber_)
         return;
 
-    ea::vector<const SourceBatch2D*>& sourceBatches = viewBatchInfo.sourceBatches_;
-    sourceBatches.clear();
+    sortKeys_.clear();
     for (unsigned d = 0; d < drawables_.size(); ++d)
     {
-        if (!drawables_[d]->IsInView(camera))
+        Drawable2D* drawable = drawables_[d];
+        if (!drawable->IsInView(camera))
             continue;
 
-        const ea::vector<SourceBatch2D>& batches = drawables_[d]->GetSourceBatches();
+        const ea::vector<SourceBatch2D>& batches = drawable->GetSourceBatches();
+        const unsigned version = drawable->GetSourceBatchesVersion();
         for (unsigned b = 0; b < batches.size(); ++b)
         {
-            if (batches[b].material_ && !batches[b].vertices_.empty())
-                sourceBatches.push_back(&batches[b]);
+            const SourceBatch2D& batch = batches[b];
+            if (!batch.material_ || batch.vertices_.empty())
+                continue;
+
+            const float distance = camera->GetDistance(batch.owner_->GetNode()->GetWorldPosition());
+            batch.distance_ = distance;
+
+            SourceBatch2DSortKey& sortKey = sortKeys_.emplace_back();
+            sortKey.key_ = GetDrawOrderDistanceKey(batch.drawOrder_, distance);
+            sortKey.materialHash_ = batch.material_->GetNameHash().Value();
+            sortKey.version_ = version;
+            sortKey.distance_ = distance;
+            sortKey.material_ = batch.material_;
+            sortKey.batch_ = &batch;
         }
     }
 
-    for (unsigned i = 0; i < sourceBatches.size(); ++i)
-    {
-        const SourceBatch2D* sourceBatch = sourceBatches[i];
-        // if (sourceBatch->owner_)
-        {
-            Vector3 worldPos = sourceBatch->owner_->GetNode()->GetWorldPosition();
-            sourceBatch->distance_ = camera->GetDistance(worldPos);
-        }
-    }
+    // Static sprites produce exactly the same keys every frame, in this case batches and vertices are kept as is
+    viewBatchInfo.batchUpdatedFrameNumber_ = frame_.frameNumber_;
+    if (sortKeys_ == viewBatchInfo.sortKeys_)
+        return;
+
+    ea::swap(sortKeys_, viewBatchInfo.sortKeys_);
+    viewBatchInfo.vertexBufferDirty_ = true;
 
-    ea::quick_sort(sourceBatches.begin(), sourceBatches.end(), CompareSourceBatch2Ds);
+    SortSourceBatches(viewBatchInfo);
 
+    const ea::vector<const SourceBatch2D*>& sourceBatches = viewBatchInfo.sourceBatches_;
     viewBatchInfo.batchCount_ = 0;
     Material* currMaterial = nullptr;
     unsigned iStart = 0;
@@ -430,7 +461,7 @@ void Renderer2D::UpdateViewBatchInfo(ViewBatchInfo2D& viewBatchInfo, Camera* cam
 
     for (unsigned b = 0; b < sourceBatches.size(); ++b)
     {
-        distance = Min(distance, sourceBatches[b]->distance_);
+        distance = Min(distance, sortedKeys_[b].distance_);
         Material* material = sourceBatches[b]->material_;
         const ea::vector<Vertex2D>& vertices = sourceBatches[b]->vertices_;
 
@@ -460,7 +491,24 @@ void Renderer2D::UpdateViewBatchInfo(ViewBatchInfo2D& viewBatchInfo, Camera* cam
 
     viewBatchInfo.indexCount_ = iStart + iCount;
     viewBatchInfo.vertexCount_ = vStart + vCount;
-    viewBatchInfo.batchUpdatedFrameNumber_ = frame_.frameNumber_;
+}
+
+void Renderer2D::SortSourceBatches(ViewBatchInfo2D& viewBatchInfo)
+{
+    URHO3D_PROFILE("SortSourceBatches2D");
+
+    // Radix sort is stable, so sort by the least significant key first
+    sortedKeys_ = viewBatchInfo.sortKeys_;
+    sortBuffer_.resize(sortedKeys_.size());
+    ea::radix_sort<SourceBatch2DSortKey*, ExtractMaterialHashKey>(
+        sortedKeys_.begin(), sortedKeys_.end(), sortBuffer_.begin());
+    ea::radix_sort<SourceBatch2DSortKey*, ExtractDrawOrderDistanceKey>(
+        sortedKeys_.begin(), sortedKeys_.end(), sortBuffer_.begin());
+
+    ea::vector<const SourceBatch2D*>& sourceBatches = viewBatchInfo.sourceBatches_;
+    sourceBatches.resize(sortedKeys_.size());
+    for (unsigned i = 0; i < sortedKeys_.size(); ++i)
+        sourceBatches[i] = sortedKeys_[i].batch_;
 }
 
 void Renderer2D::AddViewBatch(ViewBatchInfo2D& viewBatchInfo, Material* material,
@@ -37,6 +37,34 @@ class VertexBuffer;
 struct FrameInfo;
 struct SourceBatch2D;
 
+/// Sort key of 2D source batch.
+/// @nobind
+struct SourceBatch2DSortKey
+{
+    /// Draw order in the high half and inverted distance in the low half.
+    unsigned long long key_{};
+    /// Material name hash.
+    unsigned materialHash_{};
+    /// Source batches version of the owner.
+    unsigned version_{};
+    /// Distance to camera.
+    float distance_{};
+    /// Material.
+    Material* material_{};
+    /// Source batch.
+    const SourceBatch2D* batch_{};
+
+    /// Equality comparison operator.
+    bool operator==(const SourceBatch2DSortKey& other) const
+    {
+        return key_ == other.key_ && materialHash_ == other.materialHash_ && version_ == other.version_
+            && material_ == other.material_ && batch_ == other.batch_;
+    }
+
+    /// Inequality comparison operator.
+    bool operator!=(const SourceBatch2DSortKey& other) const { return !(*this == other); }
+};
+
 /// 2D view batch info.
 /// @nobind
 struct ViewBatchInfo2D
@@ -56,6 +84,10 @@ struct ViewBatchInfo2D
     unsigned batchUpdatedFrameNumber_;
     /// Source batches.
     ea::vector<const SourceBatch2D*> sourceBatches_;
+    /// Sort keys of source batches in the order of collection, used to detect changes.
+    ea::vector<SourceBatch2DSortKey> sortKeys_;
+    /// Whether the vertex buffer should be updated.
+    bool vertexBufferDirty_{true};
     /// Batch count.
     unsigned batchCount_;
     /// Distances.
@@ -108,6 +140,8 @@ private:
     void GetDrawables(ea::vector<Drawable2D*>& drawables, Node* node);
     /// Update view batch info.
     void UpdateViewBatchInfo(ViewBatchInfo2D& viewBatchInfo, Camera* camera);
+    /// Sort source batches by draw order, distance and material.
+    void SortSourceBatches(ViewBatchInfo2D& viewBatchInfo);
     /// Add view batch.
     void AddViewBatch(ViewBatchInfo2D& viewBatchInfo, Material* material,
         unsigned indexStart, unsigned indexCount, unsigned vertexStart, unsigned vertexCount, float distance);
@@ -130,6 +164,12 @@ private:
     ea::unordered_map<Texture2D*, ea::unordered_map<int, SharedPtr<Material> > > cachedMaterials_;
     /// Cached techniques per blend mode.
     ea::unordered_map<int, SharedPtr<Technique> > cachedTechniques_;
+    /// Sort keys collected for current view.
+    ea::vector<SourceBatch2DSortKey> sortKeys_;
+    /// Sorted keys for current view.
+    ea::vector<SourceBatch2DSortKey> sortedKeys_;
+    /// Temporary buffer for radix sort.
+    ea::vector<SourceBatch2DSortKey> sortBuffer_;
 };
 
 }
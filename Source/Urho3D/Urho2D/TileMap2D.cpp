@@ -50,6 +50,9 @@ void TileMap2D::RegisterObject(Context* context)
     context->AddFactoryReflection<TileMap2D>(Category_Urho2D);
 
     URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, bool, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Chunk Size", GetChunkSize, SetChunkSize, int, 0, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Chunk Unload Delay", GetChunkUnloadDelay, SetChunkUnloadDelay, unsigned,
+        DEFAULT_CHUNK_UNLOAD_DELAY, AM_DEFAULT);
     URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Tmx File", GetTmxFileAttr, SetTmxFileAttr, ResourceRef, ResourceRef(TmxFile2D::GetTypeStatic()),
         AM_DEFAULT);
 }
@@ -117,12 +120,28 @@ void TileMap2D::SetTmxFile(TmxFile2D* tmxFile)
     if (tmxFile == tmxFile_)
         return;
 
+    tmxFile_ = tmxFile;
+    CreateLayers();
+}
+
+void TileMap2D::SetChunkSize(int chunkSize)
+{
+    chunkSize = Max(chunkSize, 0);
+    if (chunkSize == chunkSize_)
+        return;
+
+    chunkSize_ = chunkSize;
+    if (tmxFile_)
+        CreateLayers();
+}
+
+void TileMap2D::CreateLayers()
+{
     if (rootNode_)
         rootNode_->RemoveAllChildren();
 
     layers_.clear();
 
-    tmxFile_ = tmxFile;
     if (!tmxFile_)
         return;
 
@@ -31,6 +31,9 @@ namespace Urho3D
 class TileMapLayer2D;
 class TmxFile2D;
 
+/// Default number of frames after which hidden tile map chunks release vertex data.
+static const unsigned DEFAULT_CHUNK_UNLOAD_DELAY = 60;
+
 /// Tile map component.
 class URHO3D_API TileMap2D : public Component
 {
@@ -51,12 +54,24 @@ public:
     /// Set tmx file.
     /// @property
     void SetTmxFile(TmxFile2D* tmxFile);
+    /// Set size of tile layer chunks in tiles. Zero creates a node with StaticSprite2D per tile.
+    /// @property
+    void SetChunkSize(int chunkSize);
+    /// Set number of frames after which vertex data of the chunk that is out of view is released.
+    /// @property
+    void SetChunkUnloadDelay(unsigned numFrames) { chunkUnloadDelay_ = numFrames; }
     /// Add debug geometry to the debug renderer.
     void DrawDebugGeometry();
 
     /// Return tmx file.
     /// @property
     TmxFile2D* GetTmxFile() const;
+    /// Return size of tile layer chunks in tiles.
+    /// @property
+    int GetChunkSize() const { return chunkSize_; }
+    /// Return number of frames after which vertex data of the chunk that is out of view is released.
+    /// @property
+    unsigned GetChunkUnloadDelay() const { return chunkUnloadDelay_; }
 
     /// Return information.
     /// @property
@@ -80,6 +95,9 @@ public:
     ///
     ea::vector<SharedPtr<TileMapObject2D> > GetTileCollisionShapes(unsigned gid) const;
 private:
+    /// Recreate layers from tmx file.
+    void CreateLayers();
+
     /// Tmx file.
     SharedPtr<TmxFile2D> tmxFile_;
     /// Tile map information.
@@ -88,6 +106,10 @@ private:
     SharedPtr<Node> rootNode_;
     /// Tile map layers.
     ea::vector<WeakPtr<TileMapLayer2D> > layers_;
+    /// Size of tile layer chunks in tiles.
+    int chunkSize_{};
+    /// Number of frames after which hidden chunks are released.
+    unsigned chunkUnloadDelay_{DEFAULT_CHUNK_UNLOAD_DELAY};
 };
 
 }
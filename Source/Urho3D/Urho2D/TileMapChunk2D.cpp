@@ -0,0 +1,183 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/Texture2D.h"
+#include "../Scene/Node.h"
+#include "../Urho2D/Renderer2D.h"
+#include "../Urho2D/Sprite2D.h"
+#include "../Urho2D/TileMapChunk2D.h"
+#include "../Urho2D/TmxFile2D.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+TileMapChunk2D::TileMapChunk2D(Context* context) :
+    Drawable2D(context)
+{
+}
+
+TileMapChunk2D::~TileMapChunk2D() = default;
+
+void TileMapChunk2D::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<TileMapChunk2D>();
+}
+
+void TileMapChunk2D::SetTiles(const TmxTileLayer2D* tileLayer, const TileMapInfo2D& info, const IntRect& region)
+{
+    tileLayer_ = tileLayer;
+    info_ = info;
+    region_ = region;
+
+    tilesBoundingBox_.Clear();
+    if (tileLayer_)
+    {
+        for (int y = region_.top_; y < region_.bottom_; ++y)
+        {
+            for (int x = region_.left_; x < region_.right_; ++x)
+            {
+                const Tile2D* tile = tileLayer_->GetTile(x, y);
+                Rect drawRect;
+                if (!tile || !tile->GetSprite() || !tile->GetSprite()->GetDrawRectangle(drawRect, tile->GetFlipX(), tile->GetFlipY()))
+                    continue;
+
+                const Vector2 position = info_.TileIndexToPosition(x, y);
+                tilesBoundingBox_.Merge((position + drawRect.min_).ToVector3());
+                tilesBoundingBox_.Merge((position + drawRect.max_).ToVector3());
+            }
+        }
+    }
+
+    sourceBatches_.clear();
+    sourceBatchesDirty_ = true;
+    loaded_ = false;
+    worldBoundingBoxDirty_ = true;
+}
+
+bool TileMapChunk2D::ReleaseIfHidden(unsigned frameNumber, unsigned numFrames)
+{
+    if (!loaded_ || frameNumber - viewFrameNumber_ <= numFrames)
+        return false;
+
+    sourceBatches_.clear();
+    sourceBatchesDirty_ = true;
+    loaded_ = false;
+    return true;
+}
+
+void TileMapChunk2D::OnWorldBoundingBoxUpdate()
+{
+    boundingBox_ = tilesBoundingBox_;
+    worldBoundingBox_ = tilesBoundingBox_.Defined() ? tilesBoundingBox_.Transformed(node_->GetWorldTransform()) : tilesBoundingBox_;
+}
+
+void TileMapChunk2D::OnDrawOrderChanged()
+{
+    const int drawOrder = GetDrawOrder();
+    for (SourceBatch2D& sourceBatch : sourceBatches_)
+        sourceBatch.drawOrder_ = drawOrder;
+}
+
+void TileMapChunk2D::UpdateSourceBatches()
+{
+    if (!sourceBatchesDirty_)
+        return;
+
+    for (SourceBatch2D& sourceBatch : sourceBatches_)
+        sourceBatch.vertices_.clear();
+
+    sourceBatchesDirty_ = false;
+    loaded_ = true;
+
+    if (!tileLayer_ || !renderer_)
+        return;
+
+    const Matrix3x4& worldTransform = node_->GetWorldTransform();
+    const unsigned color = Color::WHITE.ToUInt();
+    const int drawOrder = GetDrawOrder();
+
+    for (int y = region_.top_; y < region_.bottom_; ++y)
+    {
+        for (int x = region_.left_; x < region_.right_; ++x)
+        {
+            const Tile2D* tile = tileLayer_->GetTile(x, y);
+            Sprite2D* sprite = tile ? tile->GetSprite() : nullptr;
+            if (!sprite)
+                continue;
+
+            const bool flipX = tile->GetFlipX();
+            const bool flipY = tile->GetFlipY();
+            const bool swapXY = tile->GetSwapXY();
+            Rect drawRect;
+            Rect textureRect;
+            if (!sprite->GetDrawRectangle(drawRect, flipX, flipY) || !sprite->GetTextureRectangle(textureRect, flipX, flipY))
+                continue;
+
+            // Tiles are grouped by material, tile sets are few so linear search is fine
+            Material* material = renderer_->GetMaterial(sprite->GetTexture(), BLEND_ALPHA);
+            auto batchIter = ea::find_if(sourceBatches_.begin(), sourceBatches_.end(),
+                [material](const SourceBatch2D& sourceBatch) { return sourceBatch.material_ == material; });
+            if (batchIter == sourceBatches_.end())
+            {
+                SourceBatch2D& sourceBatch = sourceBatches_.emplace_back();
+                sourceBatch.owner_ = this;
+                sourceBatch.drawOrder_ = drawOrder;
+                sourceBatch.material_ = material;
+                batchIter = sourceBatches_.end() - 1;
+            }
+
+            // Same layout as in StaticSprite2D
+            const Vector2 position = info_.TileIndexToPosition(x, y);
+            Vertex2D vertex0;
+            Vertex2D vertex1;
+            Vertex2D vertex2;
+            Vertex2D vertex3;
+
+            vertex0.position_ = worldTransform * Vector3(position.x_ + drawRect.min_.x_, position.y_ + drawRect.min_.y_, 0.0f);
+            vertex1.position_ = worldTransform * Vector3(position.x_ + drawRect.min_.x_, position.y_ + drawRect.max_.y_, 0.0f);
+            vertex2.position_ = worldTransform * Vector3(position.x_ + drawRect.max_.x_, position.y_ + drawRect.max_.y_, 0.0f);
+            vertex3.position_ = worldTransform * Vector3(position.x_ + drawRect.max_.x_, position.y_ + drawRect.min_.y_, 0.0f);
+
+            vertex0.uv_ = textureRect.min_;
+            (swapXY ? vertex3.uv_ : vertex1.uv_) = Vector2(textureRect.min_.x_, textureRect.max_.y_);
+            vertex2.uv_ = textureRect.max_;
+            (swapXY ? vertex1.uv_ : vertex3.uv_) = Vector2(textureRect.max_.x_, textureRect.min_.y_);
+
+            vertex0.color_ = vertex1.color_ = vertex2.color_ = vertex3.color_ = color;
+
+            ea::vector<Vertex2D>& vertices = batchIter->vertices_;
+            vertices.push_back(vertex0);
+            vertices.push_back(vertex1);
+            vertices.push_back(vertex2);
+            vertices.push_back(vertex3);
+        }
+    }
+}
+
+}
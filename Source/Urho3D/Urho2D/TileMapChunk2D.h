@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Urho2D/Drawable2D.h"
+#include "../Urho2D/TileMapDefs2D.h"
+
+namespace Urho3D
+{
+
+class TmxTileLayer2D;
+
+/// Drawable that renders a rectangular region of a tile layer without a node per tile.
+/// Vertex data is generated when the chunk becomes visible and may be released when it is out of view.
+class URHO3D_API TileMapChunk2D : public Drawable2D
+{
+    URHO3D_OBJECT(TileMapChunk2D, Drawable2D);
+
+public:
+    /// Construct.
+    explicit TileMapChunk2D(Context* context);
+    /// Destruct.
+    ~TileMapChunk2D() override;
+    /// Register object factory. Drawable2D must be registered first.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Set tile layer and region of tiles to render.
+    void SetTiles(const TmxTileLayer2D* tileLayer, const TileMapInfo2D& info, const IntRect& region);
+    /// Release vertex data if the chunk was not in view for given number of frames. Return true if released.
+    bool ReleaseIfHidden(unsigned frameNumber, unsigned numFrames);
+
+    /// Return region of tiles, exclusive of right and bottom.
+    const IntRect& GetRegion() const { return region_; }
+    /// Return whether vertex data is generated.
+    bool IsLoaded() const { return loaded_; }
+
+private:
+    /// Recalculate the world-space bounding box.
+    void OnWorldBoundingBoxUpdate() override;
+    /// Handle draw order changed.
+    void OnDrawOrderChanged() override;
+    /// Update source batches. Materials are requested from Renderer2D, so it should be called from the main thread.
+    void UpdateSourceBatches() override;
+
+    /// Tile layer.
+    const TmxTileLayer2D* tileLayer_{};
+    /// Tile map information.
+    TileMapInfo2D info_{};
+    /// Region of tiles.
+    IntRect region_;
+    /// Bounding box of all tiles in chunk space.
+    BoundingBox tilesBoundingBox_;
+    /// Whether vertex data is generated.
+    bool loaded_{};
+};
+
+}
@@ -24,10 +24,14 @@
 
 #include "../Core/Context.h"
 #include "../Graphics/DebugRenderer.h"
+#include "../Graphics/Renderer.h"
 #include "../Resource/ResourceCache.h"
 #include "../Scene/Node.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
 #include "../Urho2D/StaticSprite2D.h"
 #include "../Urho2D/TileMap2D.h"
+#include "../Urho2D/TileMapChunk2D.h"
 #include "../Urho2D/TileMapLayer2D.h"
 #include "../Urho2D/TmxFile2D.h"
 
@@ -183,6 +187,8 @@ void TileMapLayer2D::Initialize(TileMap2D* tileMap, const TmxLayer2D* tmxLayer)
         nodes_.clear();
     }
 
+    UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+    chunkSize_ = 0;
     tileLayer_ = nullptr;
     objectGroup_ = nullptr;
     imageLayer_ = nullptr;
@@ -196,7 +202,10 @@ void TileMapLayer2D::Initialize(TileMap2D* tileMap, const TmxLayer2D* tmxLayer)
     switch (tmxLayer_->GetType())
     {
     case LT_TILE_LAYER:
-        SetTileLayer((const TmxTileLayer2D*)tmxLayer_);
+        if (tileMap_->GetChunkSize() > 0)
+            SetTileLayerChunked((const TmxTileLayer2D*)tmxLayer_);
+        else
+            SetTileLayer((const TmxTileLayer2D*)tmxLayer_);
         break;
 
     case LT_OBJECT_GROUP:
@@ -226,9 +235,9 @@ void TileMapLayer2D::SetDrawOrder(int drawOrder)
         if (!nodes_[i])
             continue;
 
-        auto* staticSprite = nodes_[i]->GetComponent<StaticSprite2D>();
-        if (staticSprite)
-            staticSprite->SetLayer(drawOrder_);
+        auto* drawable = nodes_[i]->GetDerivedComponent<Drawable2D>();
+        if (drawable)
+            drawable->SetLayer(drawOrder_);
     }
 }
 
@@ -291,7 +300,7 @@ Tile2D* TileMapLayer2D::GetTile(int x, int y) const
 
 Node* TileMapLayer2D::GetTileNode(int x, int y) const
 {
-    if (!tileLayer_)
+    if (!tileLayer_ || IsChunked())
         return nullptr;
 
     if (x < 0 || x >= tileLayer_->GetWidth() || y < 0 || y >= tileLayer_->GetHeight())
@@ -366,6 +375,49 @@ void TileMapLayer2D::SetTileLayer(const TmxTileLayer2D* tileLayer)
     }
 }
 
+void TileMapLayer2D::SetTileLayerChunked(const TmxTileLayer2D* tileLayer)
+{
+    tileLayer_ = tileLayer;
+    chunkSize_ = tileMap_->GetChunkSize();
+
+    const int width = tileLayer->GetWidth();
+    const int height = tileLayer->GetHeight();
+    const TileMapInfo2D& info = tileMap_->GetInfo();
+    for (int y = 0; y < height; y += chunkSize_)
+    {
+        for (int x = 0; x < width; x += chunkSize_)
+        {
+            const IntRect region{x, y, Min(x + chunkSize_, width), Min(y + chunkSize_, height)};
+
+            SharedPtr<Node> chunkNode(GetNode()->CreateTemporaryChild("Chunk"));
+            auto* chunk = chunkNode->CreateComponent<TileMapChunk2D>();
+            chunk->SetTiles(tileLayer, info, region);
+            chunk->SetLayer(drawOrder_);
+            chunk->SetOrderInLayer(y * width + x);
+
+            nodes_.push_back(chunkNode);
+        }
+    }
+
+    if (Scene* scene = GetScene())
+        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(TileMapLayer2D, HandleScenePostUpdate));
+}
+
+void TileMapLayer2D::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+{
+    auto* renderer = GetSubsystem<Renderer>();
+    if (!renderer || !tileMap_)
+        return;
+
+    const unsigned frameNumber = renderer->GetFrameInfo().frameNumber_;
+    const unsigned unloadDelay = tileMap_->GetChunkUnloadDelay();
+    for (Node* node : nodes_)
+    {
+        if (auto* chunk = node ? node->GetComponent<TileMapChunk2D>() : nullptr)
+            chunk->ReleaseIfHidden(frameNumber, unloadDelay);
+    }
+}
+
 void TileMapLayer2D::SetObjectGroup(const TmxObjectGroup2D* objectGroup)
 {
     objectGroup_ = objectGroup;
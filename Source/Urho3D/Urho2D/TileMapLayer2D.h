@@ -94,7 +94,7 @@ public:
     /// Return height (for tile layer only).
     /// @property
     int GetHeight() const;
-    /// Return tile node (for tile layer only).
+    /// Return tile node (for tile layer only). Chunked layers have no tile nodes.
     Node* GetTileNode(int x, int y) const;
     /// Return tile (for tile layer only).
     Tile2D* GetTile(int x, int y) const;
@@ -111,9 +111,17 @@ public:
     /// @property
     Node* GetImageNode() const;
 
+    /// Return whether tiles are rendered by chunks (for tile layer only).
+    /// @property
+    bool IsChunked() const { return chunkSize_ > 0; }
+
 private:
     /// Set tile layer.
     void SetTileLayer(const TmxTileLayer2D* tileLayer);
+    /// Set tile layer rendered by chunks.
+    void SetTileLayerChunked(const TmxTileLayer2D* tileLayer);
+    /// Release vertex data of chunks that are out of view.
+    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
     /// Set object group.
     void SetObjectGroup(const TmxObjectGroup2D* objectGroup);
     /// Set image layer.
@@ -133,8 +141,10 @@ private:
     int drawOrder_{};
     /// Visible.
     bool visible_{true};
-    /// Tile node or image nodes.
+    /// Tile node or image nodes. Chunk nodes for chunked tile layer.
     ea::vector<SharedPtr<Node> > nodes_;
+    /// Size of chunks in tiles, zero if tile layer is not chunked.
+    int chunkSize_{};
 };
 
 }
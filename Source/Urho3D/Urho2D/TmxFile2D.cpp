@@ -33,6 +33,8 @@
 #include "../Urho2D/TmxFile2D.h"
 #include "../Math/AreaAllocator.h"
 
+#include <STB/stb_image.h>
+
 #include "../DebugNew.h"
 
 
@@ -94,6 +96,50 @@ enum LayerEncoding {
     Base64,
 };
 
+enum LayerCompression {
+    NoCompression,
+    Zlib,
+    Gzip,
+};
+
+/// Decompress zlib or gzip stream of known size.
+static bool DecompressLayerData(ea::vector<unsigned char>& dest, const ea::vector<unsigned char>& src, LayerCompression compression)
+{
+    const auto* data = reinterpret_cast<const char*>(src.data());
+    auto size = static_cast<int>(src.size());
+    if (compression == Zlib)
+    {
+        const int decompressedSize = stbi_zlib_decode_buffer(reinterpret_cast<char*>(dest.data()),
+            static_cast<int>(dest.size()), data, size);
+        return decompressedSize == static_cast<int>(dest.size());
+    }
+
+    // Skip gzip header and trailer, the rest is raw deflate stream
+    static const unsigned gzipFlagExtra = 4;
+    static const unsigned gzipFlagName = 8;
+    static const unsigned gzipFlagComment = 16;
+    static const unsigned gzipFlagHeaderCrc = 2;
+    if (size < 18 || src[0] != 0x1f || src[1] != 0x8b || src[2] != 8)
+        return false;
+
+    const unsigned flags = src[3];
+    int offset = 10;
+    if (flags & gzipFlagExtra)
+        offset += 2 + (src[offset] | src[offset + 1] << 8u);
+    if (flags & gzipFlagName)
+        while (offset < size && src[offset++] != 0);
+    if (flags & gzipFlagComment)
+        while (offset < size && src[offset++] != 0);
+    if (flags & gzipFlagHeaderCrc)
+        offset += 2;
+    if (offset + 8 > size)
+        return false;
+
+    const int decompressedSize = stbi_zlib_decode_noheader_buffer(reinterpret_cast<char*>(dest.data()),
+        static_cast<int>(dest.size()), data + offset, size - offset - 8);
+    return decompressedSize == static_cast<int>(dest.size());
+}
+
 bool TmxTileLayer2D::Load(const XMLElement& element, const TileMapInfo2D& info)
 {
     LoadInfo(element);
@@ -106,12 +152,6 @@ bool TmxTileLayer2D::Load(const XMLElement& element, const TileMapInfo2D& info)
     }
 
     LayerEncoding encoding;
-    if (dataElem.HasAttribute("compression"))
-    {
-        URHO3D_LOGERROR("Compression not supported now");
-        return false;
-    }
-
     if (dataElem.HasAttribute("encoding"))
     {
         ea::string encodingAttribute = dataElem.GetAttribute("encoding");
@@ -130,53 +170,63 @@ bool TmxTileLayer2D::Load(const XMLElement& element, const TileMapInfo2D& info)
     else
         encoding = XML;
 
-    tiles_.resize((unsigned) (width_ * height_));
+    LayerCompression compression = NoCompression;
+    if (dataElem.HasAttribute("compression"))
+    {
+        ea::string compressionAttribute = dataElem.GetAttribute("compression");
+        if (compressionAttribute == "zlib")
+            compression = Zlib;
+        else if (compressionAttribute == "gzip")
+            compression = Gzip;
+        else
+        {
+            URHO3D_LOGERROR("Compression not supported: " + compressionAttribute);
+            return false;
+        }
+
+        if (encoding != Base64)
+        {
+            URHO3D_LOGERROR("Compression is only supported for base64 encoding");
+            return false;
+        }
+    }
+
+    const auto numTiles = static_cast<unsigned>(width_ * height_);
+    gids_.clear();
+    gids_.resize(numTiles);
+    tiles_.clear();
+
     if (encoding == XML)
     {
         XMLElement tileElem = dataElem.GetChild("tile");
 
-        for (int y = 0; y < height_; ++y)
+        for (unsigned i = 0; i < numTiles; ++i)
         {
-            for (int x = 0; x < width_; ++x)
-            {
-                if (!tileElem)
-                    return false;
-
-                unsigned gid = tileElem.GetUInt("gid");
-                if (gid > 0)
-                {
-                    SharedPtr<Tile2D> tile(new Tile2D());
-                    tile->gid_ = gid;
-                    tile->sprite_ = tmxFile_->GetTileSprite(gid & ~FLIP_ALL);
-                    tile->propertySet_ = tmxFile_->GetTilePropertySet(gid & ~FLIP_ALL);
-                    tiles_[y * width_ + x] = tile;
-                }
+            if (!tileElem)
+                return false;
 
-                tileElem = tileElem.GetNext("tile");
-            }
+            SetTileGid(i, tileElem.GetUInt("gid"));
+            tileElem = tileElem.GetNext("tile");
         }
     }
     else if (encoding == CSV)
     {
-        ea::string dataValue = dataElem.GetValue();
-        ea::vector<ea::string> gidVector = dataValue.split(',');
-        int currentIndex = 0;
-        for (int y = 0; y < height_; ++y)
+        // Parse in place, splitting values into strings is too slow for large maps
+        const ea::string dataValue = dataElem.GetValue();
+        const char* ptr = dataValue.c_str();
+        for (unsigned i = 0; i < numTiles; ++i)
         {
-            for (int x = 0; x < width_; ++x)
+            while (*ptr && !IsDigit(*ptr))
+                ++ptr;
+            if (!*ptr)
             {
-                gidVector[currentIndex].replace("\n", "");
-                unsigned gid = ToUInt(gidVector[currentIndex]);
-                if (gid > 0)
-                {
-                    SharedPtr<Tile2D> tile(new Tile2D());
-                    tile->gid_ = gid;
-                    tile->sprite_ = tmxFile_->GetTileSprite(gid & ~FLIP_ALL);
-                    tile->propertySet_ = tmxFile_->GetTilePropertySet(gid & ~FLIP_ALL);
-                    tiles_[y * width_ + x] = tile;
-                }
-                ++currentIndex;
+                URHO3D_LOGERROR("Not enough tiles in layer data");
+                return false;
             }
+
+            char* end = nullptr;
+            SetTileGid(i, static_cast<unsigned>(strtoul(ptr, &end, 10)));
+            ptr = end;
         }
     }
     else if (encoding == Base64)
@@ -187,26 +237,30 @@ bool TmxTileLayer2D::Load(const XMLElement& element, const TileMapInfo2D& info)
               && dataValue[startPosition] != '+' && dataValue[startPosition] != '/') ++startPosition;
         dataValue = dataValue.substr(startPosition);
         ea::vector<unsigned char> buffer = DecodeBase64(dataValue);
-        int currentIndex = 0;
-        for (int y = 0; y < height_; ++y)
+
+        if (compression != NoCompression)
         {
-            for (int x = 0; x < width_; ++x)
+            ea::vector<unsigned char> decompressedBuffer(numTiles * 4);
+            if (!DecompressLayerData(decompressedBuffer, buffer, compression))
             {
-                // buffer contains 32-bit integers in little-endian format
-                unsigned gid = ((unsigned)buffer[currentIndex+3] << 24u)
-                             | ((unsigned)buffer[currentIndex+2] << 16u)
-                             | ((unsigned)buffer[currentIndex+1] << 8u)
-                             | (unsigned)buffer[currentIndex];
-                if (gid > 0)
-                {
-                    SharedPtr<Tile2D> tile(new Tile2D());
-                    tile->gid_ = gid;
-                    tile->sprite_ = tmxFile_->GetTileSprite(gid & ~FLIP_ALL);
-                    tile->propertySet_ = tmxFile_->GetTilePropertySet(gid & ~FLIP_ALL);
-                    tiles_[y * width_ + x] = tile;
-                }
-                currentIndex += 4;
+                URHO3D_LOGERROR("Could not decompress layer data");
+                return false;
             }
+            buffer = ea::move(decompressedBuffer);
+        }
+
+        if (buffer.size() < numTiles * 4)
+        {
+            URHO3D_LOGERROR("Not enough tiles in layer data");
+            return false;
+        }
+
+        for (unsigned i = 0; i < numTiles; ++i)
+        {
+            // buffer contains 32-bit integers in little-endian format
+            const unsigned char* gidBytes = &buffer[i * 4];
+            SetTileGid(i, ((unsigned)gidBytes[3] << 24u) | ((unsigned)gidBytes[2] << 16u)
+                | ((unsigned)gidBytes[1] << 8u) | (unsigned)gidBytes[0]);
         }
     }
 
@@ -216,12 +270,35 @@ bool TmxTileLayer2D::Load(const XMLElement& element, const TileMapInfo2D& info)
     return true;
 }
 
-Tile2D* TmxTileLayer2D::GetTile(int x, int y) const
+void TmxTileLayer2D::SetTileGid(unsigned index, unsigned gid)
+{
+    gids_[index] = gid;
+    if (gid == 0 || tiles_.contains(gid))
+        return;
+
+    SharedPtr<Tile2D> tile(new Tile2D());
+    tile->gid_ = gid;
+    tile->sprite_ = tmxFile_->GetTileSprite(gid & ~FLIP_ALL);
+    tile->propertySet_ = tmxFile_->GetTilePropertySet(gid & ~FLIP_ALL);
+    tiles_[gid] = tile;
+}
+
+unsigned TmxTileLayer2D::GetTileGid(int x, int y) const
 {
     if (x < 0 || x >= width_ || y < 0 || y >= height_)
+        return 0;
+
+    return gids_[y * width_ + x];
+}
+
+Tile2D* TmxTileLayer2D::GetTile(int x, int y) const
+{
+    const unsigned gid = GetTileGid(x, y);
+    if (gid == 0)
         return nullptr;
 
-    return tiles_[y * width_ + x];
+    const auto iter = tiles_.find(gid);
+    return iter != tiles_.end() ? iter->second.Get() : nullptr;
 }
 
 TmxObjectGroup2D::TmxObjectGroup2D(TmxFile2D* tmxFile) :
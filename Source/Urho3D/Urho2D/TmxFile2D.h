@@ -93,14 +93,21 @@ class TmxTileLayer2D : public TmxLayer2D
 public:
     explicit TmxTileLayer2D(TmxFile2D* tmxFile);
 
-    /// Load from XML element.
+    /// Load from XML element. Base64 data may be compressed with zlib or gzip.
     bool Load(const XMLElement& element, const TileMapInfo2D& info);
-    /// Return tile.
+    /// Return tile. Tiles with the same gid are shared.
     Tile2D* GetTile(int x, int y) const;
+    /// Return tile gid including flip flags, 0 if there is no tile.
+    unsigned GetTileGid(int x, int y) const;
 
 protected:
-    /// Tiles.
-    ea::vector<SharedPtr<Tile2D> > tiles_;
+    /// Store tile gid and create shared tile for it if needed.
+    void SetTileGid(unsigned index, unsigned gid);
+
+    /// Tile gids including flip flags, row by row.
+    ea::vector<unsigned> gids_;
+    /// Tiles by gid.
+    ea::unordered_map<unsigned, SharedPtr<Tile2D> > tiles_;
 };
 
 /// Tmx objects layer.
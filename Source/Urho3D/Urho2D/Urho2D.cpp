@@ -31,6 +31,7 @@
 #include "../Urho2D/Sprite2D.h"
 #include "../Urho2D/SpriteSheet2D.h"
 #include "../Urho2D/TileMap2D.h"
+#include "../Urho2D/TileMapChunk2D.h"
 #include "../Urho2D/TileMapLayer2D.h"
 #include "../Urho2D/TmxFile2D.h"
 #include "../Urho2D/Urho2D.h"
@@ -50,6 +51,7 @@ void RegisterUrho2DLibrary(Context* context)
     // Must register objects from base to derived order
     Drawable2D::RegisterObject(context);
     StaticSprite2D::RegisterObject(context);
+    TileMapChunk2D::RegisterObject(context);
 
     StretchableSprite2D::RegisterObject(context);
 
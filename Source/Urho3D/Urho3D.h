@@ -109,6 +109,11 @@
 #   undef URHO3D_SSE
 #endif
 
+// Enable NEON on 64-bit ARM.
+#if !defined(URHO3D_SSE) && !defined(URHO3D_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#   define URHO3D_NEON
+#endif
+
 // Platform identification macros.
 #if defined(__ANDROID__)
     #define URHO3D_PLATFORM_ANDROID 1
@@ -24,9 +24,13 @@
 
 #include "../Utility/AssetTransformer.h"
 
+#include "../Core/ProcessUtils.h"
+#include "../Core/Timer.h"
 #include "../IO/ArchiveSerialization.h"
 #include "../IO/Base64Archive.h"
 #include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
+#include "../IO/VectorBuffer.h"
 
 #include <EASTL/sort.h>
 #include <EASTL/unordered_set.h>
@@ -82,12 +86,38 @@ ea::string AssetTransformerInput::ToBase64() const
     return archive.GetBase64();
 }
 
+AssetTransformerInput AssetTransformerInput::FromBytes(const ByteVector& bytes)
+{
+    MemoryBuffer buffer(bytes);
+    BinaryInputArchive archive(nullptr, buffer);
+    AssetTransformerInput result;
+    SerializeValue(archive, "input", result);
+    return result;
+}
+
+ByteVector AssetTransformerInput::ToBytes() const
+{
+    VectorBuffer buffer;
+    BinaryOutputArchive archive(nullptr, buffer);
+    SerializeValue(archive, "input", const_cast<AssetTransformerInput&>(*this));
+    return buffer.GetBuffer();
+}
+
+void AssetTransformerStats::SerializeInBlock(Archive& archive)
+{
+    SerializeValue(archive, "type", type_);
+    SerializeValue(archive, "startTimeUs", startTimeUs_);
+    SerializeValue(archive, "durationUs", durationUs_);
+}
+
 void AssetTransformerOutput::SerializeInBlock(Archive& archive)
 {
     SerializeValue(archive, "sourceModified", sourceModified_);
     SerializeValue(archive, "outputResourceNames", outputResourceNames_);
     SerializeValue(archive, "appliedTransformers", appliedTransformers_);
     SerializeValue(archive, "dependencyModificationTimes", dependencyModificationTimes_);
+    SerializeValue(archive, "transformerStats", transformerStats_);
+    SerializeValue(archive, "peakMemory", peakMemory_);
 }
 
 AssetTransformerOutput AssetTransformerOutput::FromBase64(const ea::string& base64)
@@ -105,6 +135,23 @@ ea::string AssetTransformerOutput::ToBase64() const
     return archive.GetBase64();
 }
 
+AssetTransformerOutput AssetTransformerOutput::FromBytes(const ByteVector& bytes)
+{
+    MemoryBuffer buffer(bytes);
+    BinaryInputArchive archive(nullptr, buffer);
+    AssetTransformerOutput result;
+    SerializeValue(archive, "output", result);
+    return result;
+}
+
+ByteVector AssetTransformerOutput::ToBytes() const
+{
+    VectorBuffer buffer;
+    BinaryOutputArchive archive(nullptr, buffer);
+    SerializeValue(archive, "output", const_cast<AssetTransformerOutput&>(*this));
+    return buffer.GetBuffer();
+}
+
 AssetTransformer::AssetTransformer(Context* context)
     : Serializable(context)
 {
@@ -120,6 +167,19 @@ bool AssetTransformer::IsApplicable(const AssetTransformerInput& input, const As
     return false;
 }
 
+bool AssetTransformer::IsThreadSafe(const AssetTransformerVector& transformers)
+{
+    if (transformers.empty())
+        return false;
+
+    for (AssetTransformer* transformer : transformers)
+    {
+        if (!transformer->IsThreadSafe())
+            return false;
+    }
+    return true;
+}
+
 bool AssetTransformer::ExecuteTransformers(const AssetTransformerInput& input, AssetTransformerOutput& output,
     const AssetTransformerVector& transformers, bool isNestedExecution)
 {
@@ -131,7 +191,16 @@ bool AssetTransformer::ExecuteTransformers(const AssetTransformerInput& input, A
 
         if (transformer->IsApplicable(input))
         {
-            if (!transformer->Execute(input, output, transformers))
+            AssetTransformerStats stats;
+            stats.type_ = transformer->GetTypeName();
+            stats.startTimeUs_ = Time::GetTimeSinceEpochUs();
+
+            HiresTimer timer;
+            const bool success = transformer->Execute(input, output, transformers);
+            stats.durationUs_ = timer.GetUSec(false);
+            output.transformerStats_.push_back(stats);
+
+            if (!success)
                 return false;
             output.appliedTransformers_.insert(transformer->GetTypeName());
         }
@@ -150,6 +219,8 @@ bool AssetTransformer::ExecuteTransformersAndStore(const AssetTransformerInput&
     if (!AssetTransformer::ExecuteTransformers(input, output, transformers, false))
         return false;
 
+    output.peakMemory_ = GetPeakProcessMemory();
+
     StringVector copiedFiles;
     fs->CopyDir(tempFolderHolder.GetPath(), outputPath, &copiedFiles);
 
@@ -159,6 +230,30 @@ bool AssetTransformer::ExecuteTransformersAndStore(const AssetTransformerInput&
     return true;
 }
 
+bool AssetTransformer::ExecuteTransformersAndStore(const AssetTransformerInput& input,
+    const ea::vector<AssetTransformerFlavorTarget>& targets, ea::vector<AssetTransformerOutput>& outputs)
+{
+    AssetTransformerInput sharedInput = input;
+    if (!sharedInput.sharedData_)
+        sharedInput.sharedData_ = ea::make_shared<AssetTransformerSharedData>();
+
+    outputs.clear();
+    outputs.resize(targets.size());
+    for (unsigned index = 0; index < targets.size(); ++index)
+    {
+        const AssetTransformerFlavorTarget& target = targets[index];
+
+        // Each flavor needs its own temporary folder because it is copied to the output path as a whole
+        const ea::string tempPath = Format("{}{}/", AddTrailingSlash(input.tempPath_), index);
+        AssetTransformerInput flavorInput{sharedInput, tempPath, tempPath + input.resourceName_};
+        flavorInput.flavor_ = target.flavor_;
+
+        if (!ExecuteTransformersAndStore(flavorInput, target.outputPath_, outputs[index], target.transformers_))
+            return false;
+    }
+    return true;
+}
+
 void AssetTransformer::AddDependency(
     const AssetTransformerInput& input, AssetTransformerOutput& output, const ea::string& fileName) const
 {
@@ -22,10 +22,13 @@
 
 #pragma once
 
+#include "../Container/ByteVector.h"
 #include "../Engine/ApplicationFlavor.h"
 #include "../IO/FileSystem.h"
 #include "../Scene/Serializable.h"
 
+#include <EASTL/shared_ptr.h>
+#include <EASTL/unordered_map.h>
 #include <EASTL/unordered_set.h>
 
 namespace Urho3D
@@ -34,6 +37,24 @@ namespace Urho3D
 class AssetTransformer;
 using AssetTransformerVector = ea::vector<AssetTransformer*>;
 
+/// Flavor-independent data shared between executions of the same asset for several flavors.
+/// Transformers may store expensive intermediate results here, e.g. parsed source file.
+class URHO3D_API AssetTransformerSharedData
+{
+public:
+    /// Return value stored by the key, or null if there's none. Key should identify the type of the value.
+    template <class T> ea::shared_ptr<const T> Get(const ea::string& key) const
+    {
+        const auto iter = values_.find(key);
+        return iter != values_.end() ? ea::static_pointer_cast<const T>(iter->second) : nullptr;
+    }
+    /// Store value by the key. Value should not be modified after that.
+    void Set(const ea::string& key, ea::shared_ptr<const void> value) { values_[key] = ea::move(value); }
+
+private:
+    ea::unordered_map<ea::string, ea::shared_ptr<const void>> values_;
+};
+
 /// Transformer execution inputs (should be serializable on its own).
 struct URHO3D_API AssetTransformerInput
 {
@@ -46,6 +67,8 @@ struct URHO3D_API AssetTransformerInput
     void SerializeInBlock(Archive& archive);
     static AssetTransformerInput FromBase64(const ea::string& base64);
     ea::string ToBase64() const;
+    static AssetTransformerInput FromBytes(const ByteVector& bytes);
+    ByteVector ToBytes() const;
 
     /// Flavor of the transformer.
     ApplicationFlavor flavor_;
@@ -64,6 +87,21 @@ struct URHO3D_API AssetTransformerInput
     ea::string tempPath_;
     /// Absolute file name to the file counterpart in writeable directory.
     ea::string outputFileName_;
+    /// Data shared between flavors of the same asset. Not serialized, may be null.
+    ea::shared_ptr<AssetTransformerSharedData> sharedData_;
+};
+
+/// Execution statistics of the single transformer.
+struct URHO3D_API AssetTransformerStats
+{
+    void SerializeInBlock(Archive& archive);
+
+    /// Type of the transformer.
+    ea::string type_;
+    /// Start time in microseconds since epoch, see Time::GetTimeSinceEpochUs.
+    long long startTimeUs_{};
+    /// Duration in microseconds.
+    long long durationUs_{};
 };
 
 /// Transformer execution result (should be serializable on its own).
@@ -72,6 +110,8 @@ struct URHO3D_API AssetTransformerOutput
     void SerializeInBlock(Archive& archive);
     static AssetTransformerOutput FromBase64(const ea::string& base64);
     ea::string ToBase64() const;
+    static AssetTransformerOutput FromBytes(const ByteVector& bytes);
+    ByteVector ToBytes() const;
 
     /// Whether the source file was modified.
     bool sourceModified_{};
@@ -81,6 +121,21 @@ struct URHO3D_API AssetTransformerOutput
     ea::unordered_set<ea::string> appliedTransformers_;
     /// Other files that were used to generate the output.
     ea::unordered_map<ea::string, FileTime> dependencyModificationTimes_;
+    /// Execution statistics of the applied transformers, including nested execution.
+    ea::vector<AssetTransformerStats> transformerStats_;
+    /// Peak memory usage of the process that executed the transformers, in bytes. 0 if unknown.
+    unsigned long long peakMemory_{};
+};
+
+/// Flavor of the asset to be produced by multi-flavor execution.
+struct URHO3D_API AssetTransformerFlavorTarget
+{
+    /// Flavor of the output.
+    ApplicationFlavor flavor_;
+    /// Transformers that match the flavor.
+    AssetTransformerVector transformers_;
+    /// Path where results are copied.
+    ea::string outputPath_;
 };
 
 /// Interface of a script that can be used to transform assets.
@@ -95,12 +150,18 @@ public:
 
     /// Return whether the transformer array is applied to the given asset in any way.
     static bool IsApplicable(const AssetTransformerInput& input, const AssetTransformerVector& transformers);
+    /// Return whether the transformer array can be executed on a worker thread.
+    static bool IsThreadSafe(const AssetTransformerVector& transformers);
     /// Execute transformer array on the asset.
     static bool ExecuteTransformers(const AssetTransformerInput& input, AssetTransformerOutput& output,
         const AssetTransformerVector& transformers, bool isNestedExecution);
     /// Execute transformer array on the asset and copy results in the output path.
     static bool ExecuteTransformersAndStore(const AssetTransformerInput& input, const ea::string& outputPath,
         AssetTransformerOutput& output, const AssetTransformerVector& transformers);
+    /// Execute transformers on the asset for several flavors and copy results in corresponding output paths.
+    /// Flavor of the input is ignored. Flavor-independent data is shared via AssetTransformerInput::sharedData_.
+    static bool ExecuteTransformersAndStore(const AssetTransformerInput& input,
+        const ea::vector<AssetTransformerFlavorTarget>& targets, ea::vector<AssetTransformerOutput>& outputs);
 
     /// Return whether the transformer can be applied to the given asset. Should be as fast as possible.
     virtual bool IsApplicable(const AssetTransformerInput& input) { return false; }
@@ -114,6 +175,9 @@ public:
     virtual bool IsSingleInstanced() { return true; }
     /// Return whether to execute this transformer on the output of the other transformer.
     virtual bool IsExecutedOnOutput() { return false; }
+    /// Return whether the transformer can be executed on a worker thread concurrently with other assets.
+    /// Thread-safe transformer should not use ResourceCache or any other main thread subsystem.
+    virtual bool IsThreadSafe() { return false; }
 
     /// Manage requirement flavor of the transformer.
     /// @{
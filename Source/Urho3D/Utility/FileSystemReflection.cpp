@@ -74,9 +74,17 @@ FileSystemReflection::~FileSystemReflection()
 
 void FileSystemReflection::Update()
 {
-    FileChange change;
-    while (fileWatcher_->GetNextChange(change))
+    ea::vector<FileChange> changes;
+    fileWatcher_->GetNextChanges(changes);
+    for (const FileChange& change : changes)
     {
+        // Some changes were lost, rebuild the whole tree
+        if (change.fileName_.empty())
+        {
+            treeDirty_ = true;
+            continue;
+        }
+
         updatedResources_.insert(change.fileName_);
         if (change.kind_ == FILECHANGE_ADDED || change.kind_ == FILECHANGE_REMOVED || change.kind_ == FILECHANGE_RENAMED)
             treeDirty_ = true;
@@ -25,7 +25,9 @@
 #include "../Container/Functors.h"
 #include "../Core/Context.h"
 #include "../Core/Exception.h"
+#include "../Core/Mutex.h"
 #include "../Core/StringUtils.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/AnimatedModel.h"
 #include "../Graphics/Animation.h"
 #include "../Graphics/AnimationController.h"
@@ -79,6 +81,43 @@ namespace
 
 const unsigned MaxNameAssignTries = 64*1024;
 
+/// Invoke callback for each index in range, in parallel if called from WorkQueue thread.
+/// Exceptions thrown by the callback are rethrown on the calling thread after all work is done.
+template <class T>
+void ForEachIndexParallel(Context* context, unsigned size, const T& callback)
+{
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+    if (!workQueue || !workQueue->IsMultithreaded() || !WorkQueue::IsProcessingThread() || size <= 1)
+    {
+        for (unsigned index = 0; index < size; ++index)
+            callback(index);
+        return;
+    }
+
+    ea::vector<std::exception_ptr> exceptions(size);
+    ForEachParallel(workQueue, 1u, size,
+        [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned index = beginIndex; index < endIndex; ++index)
+        {
+            try
+            {
+                callback(index);
+            }
+            catch (...)
+            {
+                exceptions[index] = std::current_exception();
+            }
+        }
+    });
+
+    for (const std::exception_ptr& exception : exceptions)
+    {
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+}
+
 template <class T, unsigned N, class U>
 ea::array<T, N> ToArray(const U& vec)
 {
@@ -436,6 +475,19 @@ public:
 
     template <class T>
     ea::vector<T> ReadBufferView(int bufferViewIndex, int byteOffset, int componentType, int type, int count, bool normalized) const
+    {
+        const int numComponents = tg::GetNumComponentsInType(type);
+        if (numComponents <= 0)
+            throw RuntimeException("Unexpected type {} of buffer view elements", type);
+
+        ea::vector<T> result(count * numComponents);
+        ReadBufferViewTo(result.data(), bufferViewIndex, byteOffset, componentType, type, count, normalized);
+        return result;
+    }
+
+    /// Decode buffer view into the destination array of count * numComponents elements.
+    template <class T>
+    void ReadBufferViewTo(T* result, int bufferViewIndex, int byteOffset, int componentType, int type, int count, bool normalized) const
     {
         base_.CheckBufferView(bufferViewIndex);
 
@@ -444,32 +496,32 @@ public:
             throw RuntimeException("Unexpected type {} of buffer view elements", type);
 
         const tg::BufferView& bufferView = model_.bufferViews[bufferViewIndex];
+        const unsigned numElements = count * numComponents;
 
-        ea::vector<T> result(count * numComponents);
         switch (componentType)
         {
         case TINYGLTF_COMPONENT_TYPE_BYTE:
             ReadBufferViewImpl<signed char>(result, bufferView, byteOffset, componentType, type, count);
             if constexpr (ea::is_floating_point_v<T>)
-                NormalizeFloats(result, normalized, 127);
+                NormalizeFloats(result, numElements, normalized, 127);
             break;
 
         case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
             ReadBufferViewImpl<unsigned char>(result, bufferView, byteOffset, componentType, type, count);
             if constexpr (ea::is_floating_point_v<T>)
-                NormalizeFloats(result, normalized, 255);
+                NormalizeFloats(result, numElements, normalized, 255);
             break;
 
         case TINYGLTF_COMPONENT_TYPE_SHORT:
             ReadBufferViewImpl<short>(result, bufferView, byteOffset, componentType, type, count);
             if constexpr (ea::is_floating_point_v<T>)
-                NormalizeFloats(result, normalized, 32767);
+                NormalizeFloats(result, numElements, normalized, 32767);
             break;
 
         case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
             ReadBufferViewImpl<unsigned short>(result, bufferView, byteOffset, componentType, type, count);
             if constexpr (ea::is_floating_point_v<T>)
-                NormalizeFloats(result, normalized, 65535);
+                NormalizeFloats(result, numElements, normalized, 65535);
             break;
 
         case TINYGLTF_COMPONENT_TYPE_INT:
@@ -491,8 +543,6 @@ public:
         default:
             throw RuntimeException("Unsupported component type {} of buffer view elements", componentType);
         }
-
-        return result;
     }
 
     template <class T>
@@ -506,21 +556,33 @@ public:
 
     template <class T>
     ea::vector<T> ReadAccessor(const tg::Accessor& accessor) const
+    {
+        const int numComponents = tg::GetNumComponentsInType(accessor.type);
+        if (numComponents <= 0)
+            throw RuntimeException("Unexpected type {} of buffer view elements", accessor.type);
+
+        ea::vector<T> result(accessor.count * numComponents);
+        ReadAccessorTo(result.data(), accessor);
+        return result;
+    }
+
+    /// Decode accessor into the destination array of count * numComponents elements.
+    template <class T>
+    void ReadAccessorTo(T* result, const tg::Accessor& accessor) const
     {
         const int numComponents = tg::GetNumComponentsInType(accessor.type);
         if (numComponents <= 0)
             throw RuntimeException("Unexpected type {} of buffer view elements", accessor.type);
 
         // Read dense buffer data
-        ea::vector<T> result;
         if (accessor.bufferView >= 0)
         {
-            result = ReadBufferView<T>(accessor.bufferView, accessor.byteOffset,
+            ReadBufferViewTo(result, accessor.bufferView, accessor.byteOffset,
                 accessor.componentType, accessor.type, accessor.count, accessor.normalized);
         }
         else
         {
-            result.resize(accessor.count * numComponents);
+            ea::fill_n(result, accessor.count * numComponents, T{});
         }
 
         // Read sparse buffer data
@@ -539,7 +601,25 @@ public:
             for (unsigned i = 0; i < indices.size(); ++i)
                 ea::copy_n(&values[i * numComponents], numComponents, &result[indices[i] * numComponents]);
         }
+    }
+
+    /// Decode accessor of floats directly into array of aggregates of floats, e.g. Vector3.
+    template <class T>
+    ea::vector<T> ReadAccessorAsFloats(const tg::Accessor& accessor) const
+    {
+        static constexpr unsigned numFloats = sizeof(T) / sizeof(float);
+        static_assert(numFloats * sizeof(float) == sizeof(T), "Type should be an aggregate of floats");
+
+        const int numComponents = tg::GetNumComponentsInType(accessor.type);
+        if (numComponents <= 0)
+            throw RuntimeException("Unexpected type {} of buffer view elements", accessor.type);
+
+        const unsigned totalFloats = accessor.count * numComponents;
+        if (totalFloats % numFloats != 0)
+            throw RuntimeException("Unexpected number of components in array");
 
+        ea::vector<T> result(totalFloats / numFloats);
+        ReadAccessorTo(reinterpret_cast<float*>(result.data()), accessor);
         return result;
     }
 
@@ -557,7 +637,7 @@ private:
     }
 
     template <class T, class U>
-    void ReadBufferViewImpl(ea::vector<U>& result,
+    void ReadBufferViewImpl(U* result,
         const tg::BufferView& bufferView, int byteOffset, int componentType, int type, int count) const
     {
         const tg::Buffer& buffer = model_.buffers[bufferView.buffer];
@@ -579,28 +659,12 @@ private:
     }
 
     template <class T>
-    static ea::vector<T> RepackFloats(const ea::vector<float>& source)
-    {
-        static constexpr unsigned numComponents = sizeof(T) / sizeof(float);
-        if (source.size() % numComponents != 0)
-            throw RuntimeException("Unexpected number of components in array");
-
-        const unsigned numElements = source.size() / numComponents;
-
-        ea::vector<T> result;
-        result.resize(numElements);
-        for (unsigned i = 0; i < numElements; ++i)
-            std::memcpy(&result[i], &source[i * numComponents], sizeof(T));
-        return result;
-    }
-
-    template <class T>
-    static void NormalizeFloats(ea::vector<T>& result, bool normalize, float maxValue)
+    static void NormalizeFloats(T* result, unsigned numElements, bool normalize, float maxValue)
     {
         if (normalize)
         {
-            for (T& value : result)
-                value = ea::max(static_cast<T>(-1), static_cast<T>(value / maxValue));
+            for (unsigned i = 0; i < numElements; ++i)
+                result[i] = ea::max(static_cast<T>(-1), static_cast<T>(result[i] / maxValue));
         }
     }
 
@@ -609,21 +673,21 @@ private:
 };
 
 template <>
-ea::vector<Vector2> GLTFBufferReader::ReadAccessor(const tg::Accessor& accessor) const { return RepackFloats<Vector2>(ReadAccessor<float>(accessor)); }
+ea::vector<Vector2> GLTFBufferReader::ReadAccessor(const tg::Accessor& accessor) const { return ReadAccessorAsFloats<Vector2>(accessor); }
 
 template <>
-ea::vector<Vector3> GLTFBufferReader::ReadAccessor(const tg::Accessor& accessor) const { return RepackFloats<Vector3>(ReadAccessor<float>(accessor)); }
+ea::vector<Vector3> GLTFBufferReader::ReadAccessor(const tg::Accessor& accessor) const { return ReadAccessorAsFloats<Vector3>(accessor); }
 
 template <>
-ea::vector<Vector4> GLTFBufferReader::ReadAccessor(const tg::Accessor& accessor) const { return RepackFloats<Vector4>(ReadAccessor<float>(accessor)); }
+ea::vector<Vector4> GLTFBufferReader::ReadAccessor(const tg::Accessor& accessor) const { return ReadAccessorAsFloats<Vector4>(accessor); }
 
 template <>
-ea::vector<Matrix4> GLTFBufferReader::ReadAccessor(const tg::Accessor& accessor) const { return RepackFloats<Matrix4>(ReadAccessor<float>(accessor)); }
+ea::vector<Matrix4> GLTFBufferReader::ReadAccessor(const tg::Accessor& accessor) const { return ReadAccessorAsFloats<Matrix4>(accessor); }
 
 template <>
 ea::vector<Quaternion> GLTFBufferReader::ReadAccessor(const tg::Accessor& accessor) const
 {
-    auto values = RepackFloats<Vector4>(ReadAccessor<float>(accessor));
+    const auto values = ReadAccessorAsFloats<Vector4>(accessor);
     ea::vector<Quaternion> result(values.size());
     ea::transform(values.begin(), values.end(), result.begin(), RotationFromVector);
     return result;
@@ -2373,10 +2437,13 @@ public:
         textureImporter_.CookTextures();
     }
 
+    /// Can be called from multiple threads.
     SharedPtr<Material> GetMaterial(int materialIndex, MaterialVariant variant)
     {
         base_.CheckMaterial(materialIndex);
         const SharedPtr<Material> material = materials_[materialIndex].variants_[variant];
+
+        MutexLock lock(referencedMaterialsMutex_);
         referencedMaterials_.insert(material);
         return material;
     }
@@ -2659,6 +2726,7 @@ private:
     };
 
     ea::vector<ImportedMaterial> materials_;
+    Mutex referencedMaterialsMutex_;
     ea::unordered_set<SharedPtr<Material>> referencedMaterials_;
 };
 
@@ -2714,7 +2782,8 @@ private:
 
     void InitializeModels()
     {
-        for (const GLTFMeshSkinPairPtr& pair : hierarchyAnalyzer_.GetUniqueMeshSkinPairs())
+        const auto& meshSkinPairs = hierarchyAnalyzer_.GetUniqueMeshSkinPairs();
+        for (const GLTFMeshSkinPairPtr& pair : meshSkinPairs)
         {
             const tg::Mesh& sourceMesh = model_.meshes[pair->mesh_];
 
@@ -2725,9 +2794,16 @@ private:
             const auto [baseName, distance] = ParseLodDistance(model.meshName_);
             model.baseMeshName_ = baseName;
             model.lodDistance_ = distance;
-
-            model.modelView_ = ImportModelView(sourceMesh, hierarchyAnalyzer_.GetSkinBones(pair->skin_));
         }
+
+        // Geometry conversion is independent for each mesh
+        ForEachIndexParallel(base_.GetContext(), models_.size(),
+            [&](unsigned index)
+        {
+            const GLTFMeshSkinPairPtr& pair = meshSkinPairs[index];
+            const tg::Mesh& sourceMesh = model_.meshes[pair->mesh_];
+            models_[index].modelView_ = ImportModelView(sourceMesh, hierarchyAnalyzer_.GetSkinBones(pair->skin_));
+        });
     }
 
     void CombineLODs()
@@ -2786,27 +2862,61 @@ private:
 
     void CookModels()
     {
-        ea::unordered_map<SharedPtr<ModelView>, SharedPtr<Model>> viewToModel;
+        // Model views may be shared between imported models
+        ea::vector<ModelView*> uniqueModelViews;
+        ea::unordered_set<ModelView*> visitedModelViews;
         for (ImportedModel& importedModel : models_)
         {
             importedModel.materials_ = importedModel.modelView_->ExportMaterialList();
 
-            SharedPtr<Model>& model = viewToModel[importedModel.modelView_];
-            if (!model)
+            if (visitedModelViews.insert(importedModel.modelView_).second)
             {
                 const ea::string modelName =
                     base_.GetResourceName(importedModel.baseMeshName_, "Models/", "Model", ".mdl");
                 importedModel.modelView_->SetName(modelName);
-
-                base_.GetCallback()->OnModelLoaded(*importedModel.modelView_);
-
-                model = importedModel.modelView_->ExportModel();
-                base_.AddToResourceCache(model);
-                modelsToSave_.push_back(model);
+                uniqueModelViews.push_back(importedModel.modelView_);
             }
+        }
+
+        // Callbacks may be expensive (e.g. lightmap UV generation), process models in parallel if possible
+        GLTFImporterCallback* callback = base_.GetCallback();
+        if (callback->IsModelCallbackThreadSafe())
+        {
+            ForEachIndexParallel(base_.GetContext(), uniqueModelViews.size(),
+                [&](unsigned index) { callback->OnModelLoaded(*uniqueModelViews[index]); });
+        }
+        else
+        {
+            for (ModelView* modelView : uniqueModelViews)
+                callback->OnModelLoaded(*modelView);
+        }
 
-            importedModel.model_ = model;
+        ea::unordered_map<ModelView*, SharedPtr<Model>> viewToModel;
+        for (ModelView* modelView : uniqueModelViews)
+        {
+            SharedPtr<Model> model = modelView->ExportModel(
+                EMPTY_STRING, GetVertexQuantization(), base_.GetSettings().streamableLODs_);
+            base_.AddToResourceCache(model);
+            modelsToSave_.push_back(model);
+            viewToModel[modelView] = model;
         }
+
+        for (ImportedModel& importedModel : models_)
+            importedModel.model_ = viewToModel[importedModel.modelView_];
+    }
+
+    ModelVertexQuantizationFlags GetVertexQuantization() const
+    {
+        const GLTFImporterSettings& settings = base_.GetSettings();
+
+        ModelVertexQuantizationFlags result = ModelVertexQuantizationFlag::BoneWeights;
+        if (settings.quantizePositions_)
+            result |= ModelVertexQuantizationFlag::Positions;
+        if (settings.quantizeNormals_)
+            result |= ModelVertexQuantizationFlag::NormalsAndTangents;
+        if (settings.quantizeUVs_)
+            result |= ModelVertexQuantizationFlag::UVs;
+        return result;
     }
 
     ea::vector<ImportedModel*> FindLods(const ImportedModel& importedModel)
@@ -2930,6 +3040,21 @@ private:
         modelView->CalculateMissingTangents();
         modelView->RecalculateBoneBoundingBoxes();
         modelView->RepairBoneWeights();
+
+        const GLTFImporterSettings& settings = base_.GetSettings();
+        const bool hasAuthoredLODs = settings.combineLODs_ && ParseLodDistance(sourceMesh.name.c_str()).second;
+        if (settings.numGeneratedLODs_ > 0 && !hasAuthoredLODs)
+        {
+            modelView->GenerateLODs(settings.numGeneratedLODs_, settings.generatedLODTriangleRatio_,
+                settings.generatedLODDistance_, settings.generatedLODMaxError_);
+        }
+
+        if (settings.optimizeMeshes_)
+            modelView->OptimizeGeometries(settings.weldVertices_);
+
+        if (settings.generateMeshlets_)
+            modelView->GenerateMeshlets(settings.meshletMaxVertices_, settings.meshletMaxTriangles_);
+
         modelView->Normalize();
         return modelView;
     }
@@ -3141,8 +3266,19 @@ public:
 private:
     using AnimationKey = ea::pair<unsigned, ea::optional<unsigned>>;
 
+    struct PendingAnimation
+    {
+        unsigned animationIndex_{};
+        ea::optional<unsigned> groupIndex_;
+        const GLTFAnimationTrackGroup* group_{};
+        ea::string animationName_;
+        SharedPtr<Animation> animation_;
+    };
+
     void ImportAnimations()
     {
+        // Assign names first so they don't depend on the order of import
+        ea::vector<PendingAnimation> pendingAnimations;
         const unsigned numAnimations = base_.GetModel().animations.size();
         for (unsigned animationIndex = 0; animationIndex < numAnimations; ++animationIndex)
         {
@@ -3151,25 +3287,49 @@ private:
             {
                 const ea::string animationNameHint = GetAnimationGroupName(sourceAnimation, groupIndex);
                 const ea::string animationName = base_.GetResourceName(animationNameHint, "Animations/", "Animation", ".ani");
+                pendingAnimations.push_back(PendingAnimation{animationIndex, groupIndex, &group, animationName});
+            }
+        }
+
+        // Key frames are cooked independently for each animation
+        ForEachIndexParallel(base_.GetContext(), pendingAnimations.size(),
+            [&](unsigned index)
+        {
+            PendingAnimation& pending = pendingAnimations[index];
+            pending.animation_ = ImportAnimation(pending.animationName_, pending.groupIndex_, *pending.group_);
+        });
+
+        // Callbacks may inspect the original key frames, so compress animations afterwards
+        for (const PendingAnimation& pending : pendingAnimations)
+            base_.GetCallback()->OnAnimationLoaded(*pending.animation_);
+
+        if (base_.GetSettings().compressAnimations_)
+        {
+            ForEachIndexParallel(base_.GetContext(), pendingAnimations.size(),
+                [&](unsigned index) { CompressAnimation(*pendingAnimations[index].animation_); });
+        }
 
-                auto animation = ImportAnimation(animationName, groupIndex, group);
+        for (const PendingAnimation& pending : pendingAnimations)
+        {
+            const unsigned animationIndex = pending.animationIndex_;
+            const ea::optional<unsigned>& groupIndex = pending.groupIndex_;
+            const SharedPtr<Animation>& animation = pending.animation_;
 
-                if (groupIndex)
+            if (groupIndex)
+            {
+                const GLTFSkeleton& skeleton = hierarchyAnalyzer_.GetSkeleton(*groupIndex);
+                if (!skeleton.rootNode_->skinnedMeshNodes_.empty())
                 {
-                    const GLTFSkeleton& skeleton = hierarchyAnalyzer_.GetSkeleton(*groupIndex);
-                    if (!skeleton.rootNode_->skinnedMeshNodes_.empty())
-                    {
-                        const GLTFNode& skinnedMeshNode = hierarchyAnalyzer_.GetNode(skeleton.rootNode_->skinnedMeshNodes_[0]);
-                        if (Model* model = modelImporter_.GetModel(*skinnedMeshNode.mesh_, *skinnedMeshNode.skin_))
-                            animation->AddMetadata(AnimationMetadata::Model, model->GetName());
-                    }
+                    const GLTFNode& skinnedMeshNode = hierarchyAnalyzer_.GetNode(skeleton.rootNode_->skinnedMeshNodes_[0]);
+                    if (Model* model = modelImporter_.GetModel(*skinnedMeshNode.mesh_, *skinnedMeshNode.skin_))
+                        animation->AddMetadata(AnimationMetadata::Model, model->GetName());
                 }
-
-                base_.AddToResourceCache(animation);
-                animations_[{ animationIndex, groupIndex }] = animation;
-                if (!groupIndex)
-                    hasSceneAnimations_ = true;
             }
+
+            base_.AddToResourceCache(animation);
+            animations_[{ animationIndex, groupIndex }] = animation;
+            if (!groupIndex)
+                hasSceneAnimations_ = true;
         }
     }
 
@@ -3239,11 +3399,48 @@ private:
         const float animationLength = GetAnimationLength(*animation);
         animation->SetLength(animationLength);
         animation->SetAnimationName(GetFileName(animationName));
-
-        base_.GetCallback()->OnAnimationLoaded(*animation);
         return animation;
     }
 
+    void CompressAnimation(Animation& animation) const
+    {
+        const GLTFImporterSettings& settings = base_.GetSettings();
+        const StringVariantMap& parentTracks = animation.GetMetadata(AnimationMetadata::ParentTracks).GetStringVariantMap();
+
+        // Rotation of the bone displaces all its children, so limit rotation error by the size of the subtree
+        ea::unordered_map<ea::string, float> subtreeSizes;
+        for (const auto& [trackName, _] : parentTracks)
+        {
+            float distanceToAncestor = 0.0f;
+            ea::string currentName = trackName;
+            while (true)
+            {
+                const auto iter = parentTracks.find(currentName);
+                if (iter == parentTracks.end() || iter->second.GetString().empty())
+                    break;
+
+                const AnimationTrack* track = animation.GetTrack(currentName);
+                if (track && track->channelMask_.Test(CHANNEL_POSITION) && !track->keyFrames_.empty())
+                    distanceToAncestor += track->keyFrames_.front().position_.Length();
+
+                currentName = iter->second.GetString();
+                float& subtreeSize = subtreeSizes[currentName];
+                subtreeSize = ea::max(subtreeSize, distanceToAncestor);
+            }
+        }
+
+        for (const auto& [nameHash, _] : animation.GetTracks())
+        {
+            AnimationTrack& track = *animation.GetTrack(nameHash);
+            float rotationError = settings.animationRotationError_;
+            const auto iter = subtreeSizes.find(track.name_);
+            if (iter != subtreeSizes.end() && iter->second > M_EPSILON)
+                rotationError = ea::min(rotationError, settings.animationPositionError_ / iter->second * M_RADTODEG);
+
+            track.CompressKeyFrames(settings.animationPositionError_, rotationError, settings.animationScaleError_);
+        }
+    }
+
     using GLTFNodeAndParentVector = ea::vector<ea::pair<GLTFNode*, GLTFNode*>>;
 
     void FillAnimationTrackParents(Animation& animation, const GLTFSkeleton& skeleton) const
@@ -3850,6 +4047,23 @@ void SerializeValue(Archive& archive, const char* name, GLTFImporterSettings& va
     SerializeValue(archive, "skipTag", value.skipTag_);
     SerializeValue(archive, "keepNamesOnMerge", value.keepNamesOnMerge_);
     SerializeValue(archive, "addEmptyNodesToSkeleton", value.addEmptyNodesToSkeleton_);
+    SerializeValue(archive, "optimizeMeshes", value.optimizeMeshes_);
+    SerializeValue(archive, "weldVertices", value.weldVertices_);
+    SerializeValue(archive, "numGeneratedLODs", value.numGeneratedLODs_);
+    SerializeValue(archive, "generatedLODTriangleRatio", value.generatedLODTriangleRatio_);
+    SerializeValue(archive, "generatedLODDistance", value.generatedLODDistance_);
+    SerializeValue(archive, "generatedLODMaxError", value.generatedLODMaxError_);
+    SerializeValue(archive, "streamableLODs", value.streamableLODs_);
+    SerializeValue(archive, "quantizePositions", value.quantizePositions_);
+    SerializeValue(archive, "quantizeNormals", value.quantizeNormals_);
+    SerializeValue(archive, "quantizeUVs", value.quantizeUVs_);
+    SerializeValue(archive, "generateMeshlets", value.generateMeshlets_);
+    SerializeValue(archive, "meshletMaxVertices", value.meshletMaxVertices_);
+    SerializeValue(archive, "meshletMaxTriangles", value.meshletMaxTriangles_);
+    SerializeValue(archive, "compressAnimations", value.compressAnimations_);
+    SerializeValue(archive, "animationPositionError", value.animationPositionError_);
+    SerializeValue(archive, "animationRotationError", value.animationRotationError_);
+    SerializeValue(archive, "animationScaleError", value.animationScaleError_);
 
     SerializeValue(archive, "offsetMatrixError", value.offsetMatrixError_);
     SerializeValue(archive, "keyFrameTimeError", value.keyFrameTimeError_);
@@ -3930,6 +4144,37 @@ bool GLTFImporter::MergeFile(const ea::string& fileName, const ea::string& asset
     }
 }
 
+GLTFImporter::SourceModelPtr GLTFImporter::GetSourceModel() const
+{
+    if (!model_)
+    {
+        URHO3D_LOGERROR("Source GLTF model is not loaded or already processed");
+        return nullptr;
+    }
+
+    return ea::make_shared<const tg::Model>(*model_);
+}
+
+bool GLTFImporter::LoadSourceModel(const SourceModelPtr& sourceModel)
+{
+    try
+    {
+        if (model_ || impl_)
+            throw RuntimeException("Primary source model is already loaded");
+
+        if (!sourceModel)
+            throw RuntimeException("Source GLTF model is null");
+
+        model_ = ea::make_unique<tg::Model>(*sourceModel);
+        return true;
+    }
+    catch (const RuntimeException& e)
+    {
+        URHO3D_LOGERROR("{}", e.what());
+        return false;
+    }
+}
+
 bool GLTFImporter::Process(
     const ea::string& outputPath, const ea::string& resourceNamePrefix, GLTFImporterCallback* callback)
 {
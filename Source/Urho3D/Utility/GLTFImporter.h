@@ -29,6 +29,7 @@
 #include "Urho3D/Math/Transform.h"
 #include "Urho3D/Utility/AnimationMetadata.h"
 
+#include <EASTL/shared_ptr.h>
 #include <EASTL/unique_ptr.h>
 
 namespace tinygltf
@@ -56,6 +57,42 @@ struct GLTFImporterSettings
     ea::string skipTag_;
     bool keepNamesOnMerge_{false};
     bool addEmptyNodesToSkeleton_{false};
+    bool optimizeMeshes_{true};
+    bool weldVertices_{false};
+
+    /// Automatic LOD generation for geometries without authored LODs.
+    /// @{
+    unsigned numGeneratedLODs_{};
+    float generatedLODTriangleRatio_{0.5f};
+    float generatedLODDistance_{20.0f};
+    float generatedLODMaxError_{0.02f};
+    /// @}
+
+    /// Whether to store each LOD level in its own buffers, the coarsest first, so finer LOD levels can be streamed.
+    bool streamableLODs_{false};
+
+    /// Vertex quantization of exported models.
+    /// @{
+    bool quantizePositions_{false};
+    bool quantizeNormals_{false};
+    bool quantizeUVs_{false};
+    /// @}
+
+    /// Meshlets for GPU-driven culling. No more than 256 vertices per meshlet.
+    /// @{
+    bool generateMeshlets_{false};
+    unsigned meshletMaxVertices_{64};
+    unsigned meshletMaxTriangles_{124};
+    /// @}
+
+    /// Removal of animation key frames reproduced by interpolation.
+    /// Position and scale errors are absolute, rotation error is in degrees.
+    /// @{
+    bool compressAnimations_{false};
+    float animationPositionError_{0.001f};
+    float animationRotationError_{0.1f};
+    float animationScaleError_{0.001f};
+    /// @}
 
     float offsetMatrixError_{0.00002f};
     float keyFrameTimeError_{M_EPSILON};
@@ -85,6 +122,8 @@ struct GLTFImporterSettings
 class URHO3D_API GLTFImporterCallback
 {
 public:
+    /// Return whether OnModelLoaded may be called for different models from multiple threads at once.
+    virtual bool IsModelCallbackThreadSafe() const { return false; }
     virtual void OnModelLoaded(ModelView& modelView) {};
     virtual void OnAnimationLoaded(Animation& animation) {};
 };
@@ -100,6 +139,7 @@ class URHO3D_API GLTFImporter : public Object
 
 public:
     using ResourceToFileNameMap = ea::unordered_map<ea::string, ea::string>;
+    using SourceModelPtr = ea::shared_ptr<const tinygltf::Model>;
 
     GLTFImporter(Context* context, const GLTFImporterSettings& settings);
     ~GLTFImporter() override;
@@ -110,6 +150,10 @@ public:
     /// Load and merge secondary GLTF file.
     /// Merge functionality is limited, unsupported content of secondary file is ignored.
     bool MergeFile(const ea::string& fileName, const ea::string& assetName);
+    /// Return copy of loaded and merged source model, so it can be reused by other importers without parsing.
+    SourceModelPtr GetSourceModel() const;
+    /// Load primary source model returned by GetSourceModel. Node renames are not applied again.
+    bool LoadSourceModel(const SourceModelPtr& sourceModel);
 
     /// Process loaded GLTF files and import resources. Injects resources into resource cache!
     bool Process(const ea::string& outputPath, const ea::string& resourceNamePrefix, GLTFImporterCallback* callback);
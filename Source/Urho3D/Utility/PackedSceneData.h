@@ -137,6 +137,8 @@ class URHO3D_API PackedSceneData
 {
 public:
     PackedSceneData() = default;
+    /// Create from serialized scene data.
+    explicit PackedSceneData(const ByteVector& sceneData) : sceneData_(sceneData) {}
 
     /// Load into scene.
     void ToScene(Scene* scene) const;
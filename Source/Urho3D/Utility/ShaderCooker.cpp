@@ -0,0 +1,219 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Utility/ShaderCooker.h"
+
+#include "../Core/Context.h"
+#include "../Core/WorkQueue.h"
+#include "../Graphics/Shader.h"
+#include "../Graphics/ShaderVariation.h"
+#include "../IO/ArchiveSerialization.h"
+#include "../IO/File.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+#include "../RenderAPI/ShaderBytecode.h"
+#include "../Resource/JSONFile.h"
+#include "../Resource/ResourceCache.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const char* const shaderTypeNames[] = {
+    "VS",
+    "PS",
+    "GS",
+    "HS",
+    "DS",
+    "CS",
+    nullptr
+};
+
+const StringVector renderBackendNames = {
+    "D3D11",
+    "D3D12",
+    "OpenGL",
+    "Vulkan",
+};
+
+const StringVector translationPolicyNames = {
+    "Verbatim",
+    "Translate",
+    "Optimize",
+};
+
+}
+
+void ShaderVariationDesc::SerializeInBlock(Archive& archive)
+{
+    SerializeValue(archive, "shader", shaderName_);
+    SerializeEnum(archive, "type", type_, shaderTypeNames);
+    SerializeOptionalValue(archive, "defines", defines_);
+}
+
+void ShaderVariationList::SerializeInBlock(Archive& archive)
+{
+    SerializeOptionalValue(archive, "variations", variations_);
+}
+
+void ShaderVariationList::Add(const ShaderVariationDesc& variation)
+{
+    if (!variations_.contains(variation))
+        variations_.push_back(variation);
+}
+
+void ShaderVariationList::AddLoadedVariations(Context* context)
+{
+    auto cache = context->GetSubsystem<ResourceCache>();
+
+    ea::vector<Shader*> shaders;
+    cache->GetResources<Shader>(shaders);
+    for (Shader* shader : shaders)
+    {
+        for (const auto& [key, variation] : shader->GetVariations())
+            Add(ShaderVariationDesc{shader->GetName(), key.first, variation->GetDefines()});
+    }
+}
+
+ShaderCooker::ShaderCooker(Context* context)
+    : AssetTransformer(context)
+{
+}
+
+ShaderCooker::~ShaderCooker()
+{
+}
+
+void ShaderCooker::RegisterObject(Context* context)
+{
+    context->RegisterFactory<ShaderCooker>(Category_Transformer);
+
+    URHO3D_ENUM_ATTRIBUTE("Backend", backend_, renderBackendNames, RenderBackend::Vulkan, AM_DEFAULT);
+    URHO3D_ENUM_ATTRIBUTE("Translation Policy", translationPolicy_, translationPolicyNames,
+        ShaderTranslationPolicy::Optimize, AM_DEFAULT);
+}
+
+bool ShaderCooker::IsApplicable(const AssetTransformerInput& input)
+{
+    return input.resourceName_.ends_with(".shadervariations", false);
+}
+
+bool ShaderCooker::Execute(
+    const AssetTransformerInput& input, AssetTransformerOutput& output, const AssetTransformerVector& transformers)
+{
+    ShaderVariationList variations;
+    {
+        File file(context_, input.inputFileName_);
+        auto jsonFile = MakeShared<JSONFile>(context_);
+        if (!file.IsOpen() || !jsonFile->Load(file) || !jsonFile->LoadObject("shaderVariations", variations))
+        {
+            URHO3D_LOGERROR("Cannot load shader variations '{}'", input.resourceName_);
+            return false;
+        }
+    }
+
+    const auto fileNames = CookVariations(variations, GetPath(input.outputFileName_));
+    if (!fileNames)
+        return false;
+
+    const ea::string resourcePath = GetPath(input.resourceName_);
+    for (const ea::string& fileName : *fileNames)
+        output.outputResourceNames_.push_back(resourcePath + fileName);
+    return true;
+}
+
+ea::optional<StringVector> ShaderCooker::CookVariations(
+    const ShaderVariationList& variations, const ea::string& outputPath)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+    auto fs = GetSubsystem<FileSystem>();
+    auto workQueue = GetSubsystem<WorkQueue>();
+
+    // Resources are loaded in the calling thread, only compilation is performed in the worker threads
+    const unsigned numVariations = variations.variations_.size();
+    ea::vector<SharedPtr<Shader>> shaders(numVariations);
+    for (unsigned i = 0; i < numVariations; ++i)
+    {
+        const ShaderVariationDesc& desc = variations.variations_[i];
+        shaders[i] = cache->GetTempResource<Shader>(desc.shaderName_);
+        if (!shaders[i])
+        {
+            URHO3D_LOGERROR("Cannot load shader '{}'", desc.shaderName_);
+            return ea::nullopt;
+        }
+    }
+
+    ea::vector<ShaderBytecode> bytecodes(numVariations);
+    ea::vector<unsigned char> compiled(numVariations);
+    ForEachParallel(workQueue, 1, numVariations,
+        [&](unsigned begin, unsigned end)
+    {
+        for (unsigned i = begin; i < end; ++i)
+        {
+            const ShaderVariationDesc& desc = variations.variations_[i];
+            compiled[i] = ShaderVariation::CompileByteCode(bytecodes[i], shaders[i]->GetShaderName(), desc.type_,
+                desc.defines_, shaders[i]->GetSourceCode(), backend_, translationPolicy_);
+        }
+    });
+
+    StringVector fileNames;
+    bool success = true;
+    for (unsigned i = 0; i < numVariations; ++i)
+    {
+        const ShaderVariationDesc& desc = variations.variations_[i];
+        if (!compiled[i])
+        {
+            URHO3D_LOGERROR("Cannot compile shader '{}' with defines '{}'", desc.shaderName_, desc.defines_);
+            success = false;
+            continue;
+        }
+
+        ea::string fileName = ShaderVariation::GetCachedVariationName(
+            shaders[i]->GetShaderName(), desc.type_, desc.defines_, backend_, "bytecode");
+        fileName.ltrim("/");
+
+        const ea::string fullFileName = outputPath + fileName;
+        fs->CreateDirsRecursive(GetPath(fullFileName));
+
+        File file(context_, fullFileName, FILE_WRITE);
+        if (!file.IsOpen() || !bytecodes[i].SaveToFile(file))
+        {
+            URHO3D_LOGERROR("Cannot save shader bytecode '{}'", fullFileName);
+            success = false;
+            continue;
+        }
+        fileNames.push_back(fileName);
+    }
+
+    if (!success)
+        return ea::nullopt;
+    return fileNames;
+}
+
+}
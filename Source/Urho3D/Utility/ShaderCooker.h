@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../RenderAPI/RenderAPIDefs.h"
+#include "../Utility/AssetTransformer.h"
+
+namespace Urho3D
+{
+
+/// Shader variation used by the application.
+struct URHO3D_API ShaderVariationDesc
+{
+    /// Resource name of the shader.
+    ea::string shaderName_;
+    /// Shader stage.
+    ShaderType type_{};
+    /// Space-separated defines.
+    ea::string defines_;
+
+    void SerializeInBlock(Archive& archive);
+
+    bool operator==(const ShaderVariationDesc& rhs) const
+    {
+        return shaderName_ == rhs.shaderName_ && type_ == rhs.type_ && defines_ == rhs.defines_;
+    }
+};
+
+/// List of shader variations stored in *.shadervariations file.
+/// Usually collected by the application after rendering all content of interest.
+struct URHO3D_API ShaderVariationList
+{
+    ea::vector<ShaderVariationDesc> variations_;
+
+    void SerializeInBlock(Archive& archive);
+
+    /// Add variation if it is not in the list yet.
+    void Add(const ShaderVariationDesc& variation);
+    /// Add variations of all shaders loaded in resource cache.
+    void AddLoadedVariations(Context* context);
+};
+
+/// Asset transformer that compiles shader variations listed in *.shadervariations file into bytecode,
+/// so players never compile shaders at runtime.
+/// Bytecode is stored next to the list under the names used by the runtime shader cache.
+/// ShaderVariation looks it up in GraphicsSettings::cookedShaderCacheDir_ if there's no local cache,
+/// so the list is usually placed there, e.g. ShaderCache/Game.shadervariations.
+/// Variations are compiled in parallel on WorkQueue threads.
+/// Use flavor of the transformer to cook bytecode for the backends of specific platforms.
+class URHO3D_API ShaderCooker : public AssetTransformer
+{
+    URHO3D_OBJECT(ShaderCooker, AssetTransformer);
+
+public:
+    explicit ShaderCooker(Context* context);
+    ~ShaderCooker() override;
+    static void RegisterObject(Context* context);
+
+    bool IsApplicable(const AssetTransformerInput& input) override;
+    bool Execute(const AssetTransformerInput& input, AssetTransformerOutput& output,
+        const AssetTransformerVector& transformers) override;
+
+    /// Compile variations and save bytecode to the directory.
+    /// Return resource names of saved files relative to the directory, or nothing if any variation failed.
+    ea::optional<StringVector> CookVariations(const ShaderVariationList& variations, const ea::string& outputPath);
+
+    /// Set render backend to cook bytecode for.
+    void SetBackend(RenderBackend backend) { backend_ = backend; }
+    /// Return render backend to cook bytecode for.
+    RenderBackend GetBackend() const { return backend_; }
+    /// Set shader translation policy, should match the one used by the player.
+    void SetTranslationPolicy(ShaderTranslationPolicy policy) { translationPolicy_ = policy; }
+    /// Return shader translation policy.
+    ShaderTranslationPolicy GetTranslationPolicy() const { return translationPolicy_; }
+
+private:
+    RenderBackend backend_{RenderBackend::Vulkan};
+    ShaderTranslationPolicy translationPolicy_{ShaderTranslationPolicy::Optimize};
+};
+
+}
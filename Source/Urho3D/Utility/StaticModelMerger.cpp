@@ -0,0 +1,364 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Utility/StaticModelMerger.h"
+
+#include "../Core/Context.h"
+#include "../Graphics/HierarchicalLod.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/Model.h"
+#include "../Graphics/ModelView.h"
+#include "../Graphics/StaticModel.h"
+#include "../IO/File.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+#include "../Resource/ResourceCache.h"
+#include "../Scene/Scene.h"
+
+#include <EASTL/unordered_map.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Cell and drawable settings that should be equal for merged models.
+struct MergedDrawableKey
+{
+    IntVector3 cell_;
+    unsigned viewMask_{};
+    unsigned lightMask_{};
+    unsigned shadowMask_{};
+    unsigned zoneMask_{};
+    float drawDistance_{};
+    float shadowDistance_{};
+    bool castShadows_{};
+    bool occluder_{};
+    bool occludee_{};
+
+    MergedDrawableKey(StaticModel* staticModel, float cellSize)
+        : cell_(VectorFloorToInt(staticModel->GetWorldBoundingBox().Center() / cellSize))
+        , viewMask_(staticModel->GetViewMask())
+        , lightMask_(staticModel->GetLightMask())
+        , shadowMask_(staticModel->GetShadowMask())
+        , zoneMask_(staticModel->GetZoneMask())
+        , drawDistance_(staticModel->GetDrawDistance())
+        , shadowDistance_(staticModel->GetShadowDistance())
+        , castShadows_(staticModel->GetCastShadows())
+        , occluder_(staticModel->IsOccluder())
+        , occludee_(staticModel->IsOccludee())
+    {
+    }
+
+    bool operator==(const MergedDrawableKey& rhs) const
+    {
+        return cell_ == rhs.cell_ && viewMask_ == rhs.viewMask_ && lightMask_ == rhs.lightMask_
+            && shadowMask_ == rhs.shadowMask_ && zoneMask_ == rhs.zoneMask_ && drawDistance_ == rhs.drawDistance_
+            && shadowDistance_ == rhs.shadowDistance_ && castShadows_ == rhs.castShadows_
+            && occluder_ == rhs.occluder_ && occludee_ == rhs.occludee_;
+    }
+
+    unsigned ToHash() const
+    {
+        unsigned hash = cell_.ToHash();
+        CombineHash(hash, viewMask_);
+        CombineHash(hash, lightMask_);
+        CombineHash(hash, shadowMask_);
+        CombineHash(hash, zoneMask_);
+        CombineHash(hash, MakeHash(drawDistance_));
+        CombineHash(hash, MakeHash(shadowDistance_));
+        CombineHash(hash, (castShadows_ ? 1u : 0u) | (occluder_ ? 2u : 0u) | (occludee_ ? 4u : 0u));
+        return hash;
+    }
+};
+
+/// StaticModels merged into one model.
+struct MergedCell
+{
+    IntVector3 cell_;
+    ea::vector<StaticModel*> staticModels_;
+};
+
+/// Append geometry transformed to world space.
+void AppendTransformedGeometry(GeometryLODView& dest, const GeometryLODView& source, const Matrix3x4& transform)
+{
+    const Matrix3 rotationMatrix = transform.ToMatrix3();
+    const Matrix3 normalMatrix = rotationMatrix.Inverse().Transpose();
+    // Mirroring transform swaps triangle winding and handedness of tangent space
+    const bool isMirrored = transform.Determinant() < 0.0f;
+
+    const unsigned baseIndex = dest.vertices_.size();
+    for (ModelVertex vertex : source.vertices_)
+    {
+        vertex.SetPosition(transform * vertex.GetPosition());
+        if (vertex.HasNormal())
+            vertex.SetNormal((normalMatrix * vertex.GetNormal()).Normalized());
+        if (vertex.HasTangent())
+        {
+            const float handedness = isMirrored ? -vertex.tangent_.w_ : vertex.tangent_.w_;
+            vertex.tangent_ = (rotationMatrix * vertex.GetTangent()).Normalized().ToVector4(handedness);
+        }
+        if (vertex.HasBinormal())
+            vertex.binormal_ = (rotationMatrix * vertex.binormal_.ToVector3()).Normalized().ToVector4(vertex.binormal_.w_);
+        dest.vertices_.push_back(vertex);
+    }
+
+    for (unsigned i = 0; i + 2 < source.indices_.size(); i += 3)
+    {
+        dest.indices_.push_back(baseIndex + source.indices_[i]);
+        dest.indices_.push_back(baseIndex + source.indices_[isMirrored ? i + 2 : i + 1]);
+        dest.indices_.push_back(baseIndex + source.indices_[isMirrored ? i + 1 : i + 2]);
+    }
+}
+
+/// Return whether all geometries of the model can be merged.
+bool IsModelViewMergeable(const ModelView& modelView, bool allowLods)
+{
+    if (!modelView.GetBones().empty())
+        return false;
+
+    for (const GeometryView& geometry : modelView.GetGeometries())
+    {
+        if (geometry.lods_.empty() || (!allowLods && geometry.lods_.size() != 1))
+            return false;
+        for (const GeometryLODView& lod : geometry.lods_)
+        {
+            if (lod.primitiveType_ != TRIANGLE_LIST)
+                return false;
+        }
+    }
+    return true;
+}
+
+/// Simplify merged geometries for HLOD proxy.
+void SimplifyGeometries(ea::vector<GeometryView>& geometries, float triangleRatio, float maxError)
+{
+    for (GeometryView& geometry : geometries)
+    {
+        GeometryLODView& lod = geometry.lods_[0];
+        const auto targetNumTriangles = static_cast<unsigned>(lod.GetNumPrimitives() * Clamp(triangleRatio, 0.0f, 1.0f));
+        GeometryLODView simplifiedLod = lod.Simplify(targetNumTriangles, maxError);
+        if (!simplifiedLod.indices_.empty())
+            lod = ea::move(simplifiedLod);
+    }
+}
+
+}
+
+StaticModelMerger::StaticModelMerger(Context* context)
+    : AssetTransformer(context)
+{
+}
+
+StaticModelMerger::~StaticModelMerger()
+{
+}
+
+void StaticModelMerger::RegisterObject(Context* context)
+{
+    context->RegisterFactory<StaticModelMerger>(Category_Transformer);
+
+    URHO3D_ATTRIBUTE("Cell Size", float, cellSize_, DefaultCellSize, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Min Models Per Cell", unsigned, minModelsPerCell_, DefaultMinModelsPerCell, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Required Tag", ea::string, requiredTag_, EMPTY_STRING, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("HLOD Distance", float, hlodDistance_, 0.0f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("HLOD Triangle Ratio", float, hlodTriangleRatio_, DefaultHlodTriangleRatio, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("HLOD Max Error", float, hlodMaxError_, DefaultHlodMaxError, AM_DEFAULT);
+}
+
+ea::string StaticModelMerger::GetMergedModelName(const ea::string& sceneName, unsigned index)
+{
+    return Format("{}{}_Merged{}.mdl", GetPath(sceneName), GetFileName(sceneName), index);
+}
+
+bool StaticModelMerger::IsApplicable(const AssetTransformerInput& input)
+{
+    return input.inputFileName_.ends_with(".scene", false);
+}
+
+bool StaticModelMerger::Execute(
+    const AssetTransformerInput& input, AssetTransformerOutput& output, const AssetTransformerVector& transformers)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+    auto fs = GetSubsystem<FileSystem>();
+
+    AbstractFilePtr sourceFile = cache->GetFile(input.resourceName_);
+    if (!sourceFile)
+        return false;
+
+    auto scene = MakeShared<Scene>(context_);
+    if (!scene->LoadXML(*sourceFile))
+        return false;
+    sourceFile = nullptr;
+
+    ea::vector<StaticModel*> staticModels;
+    scene->GetComponents<StaticModel>(staticModels, true);
+
+    // Group models in scene order so the result is deterministic
+    const ea::string mergedModelPrefix = Format("{}{}_Merged", GetPath(input.resourceName_), GetFileName(input.resourceName_));
+    const float cellSize = ea::max(cellSize_, M_EPSILON);
+    const bool isHlod = hlodDistance_ > 0.0f;
+    ea::unordered_map<const Model*, SharedPtr<ModelView>> modelViews;
+    ea::unordered_map<MergedDrawableKey, unsigned> cellIndices;
+    ea::vector<MergedCell> cells;
+    for (StaticModel* staticModel : staticModels)
+    {
+        Model* model = staticModel->GetModel();
+        if (!model || !staticModel->IsEnabledEffective() || model->GetName().starts_with(mergedModelPrefix))
+            continue;
+        if (!requiredTag_.empty() && !staticModel->GetNode()->HasTag(requiredTag_))
+            continue;
+
+        SharedPtr<ModelView>& modelView = modelViews[model];
+        if (!modelView)
+        {
+            modelView = MakeShared<ModelView>(context_);
+            if (!modelView->ImportModel(model))
+                URHO3D_LOGWARNING("Cannot import model '{}', it is not merged", model->GetName());
+        }
+        if (modelView->GetGeometries().empty() || !IsModelViewMergeable(*modelView, isHlod))
+            continue;
+
+        const MergedDrawableKey key{staticModel, cellSize};
+        const auto [iter, isNew] = cellIndices.emplace(key, cells.size());
+        if (isNew)
+            cells.push_back(MergedCell{key.cell_});
+        cells[iter->second].staticModels_.push_back(staticModel);
+    }
+
+    const ea::string outputPath = GetPath(input.outputFileName_);
+    Node* mergedRoot = nullptr;
+    unsigned numMergedModels = 0;
+    unsigned numSourceModels = 0;
+    for (const MergedCell& cell : cells)
+    {
+        if (cell.staticModels_.size() < ea::max(minModelsPerCell_, 1u))
+            continue;
+
+        // Geometries are merged by material and vertex format
+        ea::vector<GeometryView> geometries;
+        ea::unordered_map<ea::pair<ea::string, unsigned>, unsigned> geometryIndices;
+        for (StaticModel* staticModel : cell.staticModels_)
+        {
+            const ModelView& modelView = *modelViews[staticModel->GetModel()];
+            const Matrix3x4& worldTransform = staticModel->GetNode()->GetWorldTransform();
+
+            const auto& sourceGeometries = modelView.GetGeometries();
+            for (unsigned i = 0; i < sourceGeometries.size(); ++i)
+            {
+                // HLOD proxy is coarse anyway, start from the least detailed LOD
+                const GeometryLODView& sourceLod =
+                    isHlod ? sourceGeometries[i].lods_.back() : sourceGeometries[i].lods_[0];
+                Material* material = staticModel->GetMaterial(i);
+                const ea::string materialName = material ? material->GetName() : EMPTY_STRING;
+
+                const auto key = ea::make_pair(materialName, sourceLod.vertexFormat_.ToHash());
+                const auto [iter, isNew] = geometryIndices.emplace(key, geometries.size());
+                if (isNew)
+                {
+                    GeometryView& geometry = geometries.emplace_back();
+                    geometry.material_ = materialName;
+                    geometry.lods_.resize(1);
+                    geometry.lods_[0].primitiveType_ = TRIANGLE_LIST;
+                    geometry.lods_[0].vertexFormat_ = sourceLod.vertexFormat_;
+                }
+
+                AppendTransformedGeometry(geometries[iter->second].lods_[0], sourceLod, worldTransform);
+            }
+        }
+
+        if (isHlod)
+            SimplifyGeometries(geometries, hlodTriangleRatio_, hlodMaxError_);
+
+        const ea::string modelName = GetMergedModelName(input.resourceName_, numMergedModels);
+        auto mergedModelView = MakeShared<ModelView>(context_);
+        mergedModelView->SetName(modelName);
+        mergedModelView->SetGeometries(ea::move(geometries));
+
+        fs->CreateDirsRecursive(outputPath);
+        const SharedPtr<Model> mergedModel = mergedModelView->ExportModel(modelName);
+        if (!mergedModel->SaveFile(outputPath + GetFileNameAndExtension(modelName)))
+        {
+            URHO3D_LOGERROR("Cannot save merged model '{}' of scene '{}'", modelName, input.resourceName_);
+            return false;
+        }
+
+        // Copy settings from the first model, they are equal for all models in the cell
+        const StaticModel* firstModel = cell.staticModels_.front();
+        if (!mergedRoot)
+            mergedRoot = scene->CreateChild("Merged Static Models");
+        Node* node = mergedRoot->CreateChild(Format("Cell {} {} {}", cell.cell_.x_, cell.cell_.y_, cell.cell_.z_));
+        auto mergedStaticModel = node->CreateComponent<StaticModel>();
+        mergedStaticModel->SetModel(mergedModel);
+        mergedStaticModel->SetMaterialsAttr(mergedModelView->ExportMaterialList());
+        mergedStaticModel->SetViewMask(firstModel->GetViewMask());
+        mergedStaticModel->SetLightMask(firstModel->GetLightMask());
+        mergedStaticModel->SetShadowMask(firstModel->GetShadowMask());
+        mergedStaticModel->SetZoneMask(firstModel->GetZoneMask());
+        mergedStaticModel->SetDrawDistance(firstModel->GetDrawDistance());
+        mergedStaticModel->SetShadowDistance(firstModel->GetShadowDistance());
+        mergedStaticModel->SetCastShadows(firstModel->GetCastShadows());
+        mergedStaticModel->SetOccluder(firstModel->IsOccluder());
+        mergedStaticModel->SetOccludee(firstModel->IsOccludee());
+
+        if (isHlod)
+        {
+            // Proxy is hidden until HierarchicalLod decides to show it
+            mergedStaticModel->SetEnabled(false);
+            auto hierarchicalLod = node->CreateComponent<HierarchicalLod>();
+            hierarchicalLod->SetDistance(hlodDistance_);
+            for (StaticModel* staticModel : cell.staticModels_)
+                hierarchicalLod->AddDetailedNode(staticModel->GetNode());
+        }
+        else
+        {
+            for (StaticModel* staticModel : cell.staticModels_)
+                staticModel->Remove();
+        }
+
+        ++numMergedModels;
+        numSourceModels += cell.staticModels_.size();
+    }
+
+    if (numMergedModels == 0)
+        return false;
+
+    fs->CreateDirsRecursive(outputPath);
+    File file(context_, input.outputFileName_, FILE_WRITE);
+    if (!file.IsOpen() || !scene->SaveXML(file))
+    {
+        URHO3D_LOGERROR("Cannot save scene '{}' with merged static models", input.resourceName_);
+        return false;
+    }
+
+    URHO3D_LOGINFO("Merged {} static models of scene '{}' into {} models", numSourceModels, input.resourceName_,
+        numMergedModels);
+    return true;
+}
+
+}
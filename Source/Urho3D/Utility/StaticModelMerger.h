@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Utility/AssetTransformer.h"
+
+namespace Urho3D
+{
+
+/// Asset transformer that merges static models of the scene into one model per spatial cell.
+/// StaticModels are grouped by the cell of their bounding box center and by drawable settings,
+/// geometries with the same material and vertex format are merged into one geometry with vertices in world space.
+/// Produces "*_Merged<N>.mdl" models next to the scene, source StaticModel components are removed from the scene.
+/// Only the most detailed LOD of triangle geometries is merged, models with several LODs are left as is.
+/// If HLOD distance is set, source models are kept and merged models become simplified proxies
+/// shown by HierarchicalLod beyond that distance. The least detailed LOD of source models is used then.
+class URHO3D_API StaticModelMerger : public AssetTransformer
+{
+    URHO3D_OBJECT(StaticModelMerger, AssetTransformer);
+
+public:
+    static constexpr float DefaultCellSize = 64.0f;
+    static const unsigned DefaultMinModelsPerCell = 2;
+    static constexpr float DefaultHlodTriangleRatio = 0.25f;
+    static constexpr float DefaultHlodMaxError = 0.02f;
+
+    explicit StaticModelMerger(Context* context);
+    ~StaticModelMerger() override;
+    static void RegisterObject(Context* context);
+
+    /// Return resource name of the merged model of the scene.
+    static ea::string GetMergedModelName(const ea::string& sceneName, unsigned index);
+
+    bool IsApplicable(const AssetTransformerInput& input) override;
+    bool Execute(const AssetTransformerInput& input, AssetTransformerOutput& output,
+        const AssetTransformerVector& transformers) override;
+    bool IsExecutedOnOutput() override { return true; }
+
+private:
+    /// Size of the cell in world units.
+    float cellSize_{DefaultCellSize};
+    /// Min number of models in the cell to merge them.
+    unsigned minModelsPerCell_{DefaultMinModelsPerCell};
+    /// If not empty, only models of nodes with this tag are merged.
+    ea::string requiredTag_;
+    /// If positive, merged models are HLOD proxies shown beyond this distance.
+    float hlodDistance_{};
+    /// Fraction of triangles kept in HLOD proxies.
+    float hlodTriangleRatio_{DefaultHlodTriangleRatio};
+    /// Max simplification error of HLOD proxies relative to the geometry size.
+    float hlodMaxError_{DefaultHlodMaxError};
+};
+
+}
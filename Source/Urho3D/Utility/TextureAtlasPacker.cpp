@@ -0,0 +1,316 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Utility/TextureAtlasPacker.h"
+
+#include "../Core/Context.h"
+#include "../IO/File.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+#include "../Math/AreaAllocator.h"
+#include "../Resource/Image.h"
+#include "../Resource/XMLFile.h"
+
+#include <EASTL/numeric.h>
+#include <EASTL/sort.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const StringVector supportedExtensions = {".png", ".jpg", ".jpeg", ".tga", ".bmp", ".webp"};
+
+const unsigned BlockSize = 4;
+
+bool IsImageFile(const ea::string& fileName)
+{
+    for (const ea::string& extension : supportedExtensions)
+    {
+        if (fileName.ends_with(extension, false))
+            return true;
+    }
+    return false;
+}
+
+/// Return rectangle of non-transparent pixels of RGBA image. Fully transparent image keeps one pixel.
+IntRect GetOpaqueRect(const Image& image)
+{
+    const unsigned char* data = image.GetData();
+    const int width = image.GetWidth();
+    const int height = image.GetHeight();
+
+    IntRect rect{width, height, 0, 0};
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            if (data[(y * width + x) * 4 + 3] != 0)
+            {
+                rect.left_ = ea::min(rect.left_, x);
+                rect.top_ = ea::min(rect.top_, y);
+                rect.right_ = ea::max(rect.right_, x + 1);
+                rect.bottom_ = ea::max(rect.bottom_, y + 1);
+            }
+        }
+    }
+
+    if (rect.left_ >= rect.right_ || rect.top_ >= rect.bottom_)
+        return IntRect{0, 0, 1, 1};
+    return rect;
+}
+
+}
+
+TextureAtlasPacker::TextureAtlasPacker(Context* context)
+    : AssetTransformer(context)
+{
+}
+
+TextureAtlasPacker::~TextureAtlasPacker()
+{
+}
+
+void TextureAtlasPacker::RegisterObject(Context* context)
+{
+    context->RegisterFactory<TextureAtlasPacker>(Category_Transformer);
+
+    URHO3D_ATTRIBUTE("Max Size", unsigned, maxSize_, DefaultMaxSize, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Padding", unsigned, padding_, DefaultPadding, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Trim", bool, trim_, true, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Align To Blocks", bool, alignToBlocks_, true, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Recursive", bool, recursive_, false, AM_DEFAULT);
+}
+
+bool TextureAtlasPacker::PackSprites(
+    ea::vector<TextureAtlasSprite>& sprites, int maxSize, int padding, int alignment, IntVector2& atlasSize)
+{
+    if (sprites.empty())
+        return false;
+
+    alignment = ea::max(alignment, 1);
+    const auto alignSize = [&](int size) { return (size + alignment - 1) / alignment * alignment; };
+
+    ea::vector<IntVector2> paddedSizes;
+    IntVector2 maxPaddedSize;
+    long long totalArea = 0;
+    for (const TextureAtlasSprite& sprite : sprites)
+    {
+        const IntVector2 size{alignSize(sprite.size_.x_ + padding), alignSize(sprite.size_.y_ + padding)};
+        paddedSizes.push_back(size);
+        maxPaddedSize = VectorMax(maxPaddedSize, size);
+        totalArea += static_cast<long long>(size.x_) * size.y_;
+    }
+
+    // Larger sprites go first, it gives denser packing
+    ea::vector<unsigned> order(sprites.size());
+    ea::iota(order.begin(), order.end(), 0u);
+    ea::stable_sort(order.begin(), order.end(),
+        [&](unsigned lhs, unsigned rhs)
+    {
+        const IntVector2& lhsSize = paddedSizes[lhs];
+        const IntVector2& rhsSize = paddedSizes[rhs];
+        const int lhsMaxSide = ea::max(lhsSize.x_, lhsSize.y_);
+        const int rhsMaxSide = ea::max(rhsSize.x_, rhsSize.y_);
+        if (lhsMaxSide != rhsMaxSide)
+            return lhsMaxSide > rhsMaxSide;
+        return lhsSize.x_ * lhsSize.y_ > rhsSize.x_ * rhsSize.y_;
+    });
+
+    // Try atlas sizes in order of increasing area, more square atlases first
+    ea::vector<IntVector2> candidates;
+    for (int width = 1; width <= maxSize; width *= 2)
+    {
+        for (int height = 1; height <= maxSize; height *= 2)
+        {
+            if (width >= maxPaddedSize.x_ && height >= maxPaddedSize.y_
+                && static_cast<long long>(width) * height >= totalArea)
+                candidates.emplace_back(width, height);
+        }
+    }
+    ea::stable_sort(candidates.begin(), candidates.end(),
+        [](const IntVector2& lhs, const IntVector2& rhs)
+    {
+        if (lhs.x_ * lhs.y_ != rhs.x_ * rhs.y_)
+            return lhs.x_ * lhs.y_ < rhs.x_ * rhs.y_;
+        return Abs(lhs.x_ - lhs.y_) < Abs(rhs.x_ - rhs.y_);
+    });
+
+    for (const IntVector2& candidate : candidates)
+    {
+        // Slow mode of allocator tracks maximal free rectangles
+        AreaAllocator allocator(candidate.x_, candidate.y_, false);
+        bool success = true;
+        for (unsigned index : order)
+        {
+            IntVector2& position = sprites[index].position_;
+            if (!allocator.Allocate(paddedSizes[index].x_, paddedSizes[index].y_, position.x_, position.y_))
+            {
+                success = false;
+                break;
+            }
+        }
+
+        if (success)
+        {
+            atlasSize = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TextureAtlasPacker::IsApplicable(const AssetTransformerInput& input)
+{
+    return input.resourceName_.ends_with(".atlas", false);
+}
+
+bool TextureAtlasPacker::Execute(
+    const AssetTransformerInput& input, AssetTransformerOutput& output, const AssetTransformerVector& transformers)
+{
+    auto fs = GetSubsystem<FileSystem>();
+
+    const ea::string inputPath = GetPath(input.inputFileName_);
+    const ea::string atlasName = GetFileName(input.resourceName_);
+    const ea::string atlasImageName = atlasName + ".png";
+
+    StringVector fileNames;
+    fs->ScanDir(fileNames, inputPath, "*", recursive_ ? SCAN_FILES | SCAN_RECURSIVE : SCAN_FILES);
+    ea::sort(fileNames.begin(), fileNames.end());
+
+    ea::vector<TextureAtlasSprite> sprites;
+    ea::vector<SharedPtr<Image>> images;
+    for (const ea::string& fileName : fileNames)
+    {
+        if (!IsImageFile(fileName) || fileName.comparei(atlasImageName) == 0)
+            continue;
+
+        const ea::string fullFileName = inputPath + fileName;
+        AddDependency(input, output, fullFileName);
+
+        auto image = MakeShared<Image>(context_);
+        File file(context_, fullFileName);
+        if (!file.IsOpen() || !image->Load(file))
+        {
+            URHO3D_LOGWARNING("Cannot load image '{}' to pack into atlas '{}'", fileName, input.resourceName_);
+            continue;
+        }
+
+        if (image->IsCompressed() || image->GetDepth() > 1)
+        {
+            URHO3D_LOGWARNING("Cannot pack compressed or 3D image '{}' into atlas '{}'", fileName, input.resourceName_);
+            continue;
+        }
+
+        if (image->GetComponents() != 4)
+            image = image->ConvertToRGBA();
+        if (!image)
+            continue;
+
+        const IntVector2 imageSize{image->GetWidth(), image->GetHeight()};
+        const IntRect rect = trim_ ? GetOpaqueRect(*image) : IntRect{IntVector2::ZERO, imageSize};
+
+        TextureAtlasSprite& sprite = sprites.emplace_back();
+        sprite.name_ = GetPath(fileName) + GetFileName(fileName);
+        sprite.size_ = rect.Size();
+        sprite.frameSize_ = imageSize;
+        sprite.trimOffset_ = rect.Min();
+        images.push_back(image);
+    }
+
+    if (sprites.empty())
+    {
+        URHO3D_LOGWARNING("No images to pack into atlas '{}'", input.resourceName_);
+        return true;
+    }
+
+    IntVector2 atlasSize;
+    const int alignment = alignToBlocks_ ? BlockSize : 1;
+    if (!PackSprites(sprites, maxSize_, padding_, alignment, atlasSize))
+    {
+        URHO3D_LOGERROR("Images of atlas '{}' don't fit into {}x{} texture", input.resourceName_, maxSize_, maxSize_);
+        return false;
+    }
+
+    auto atlasImage = MakeShared<Image>(context_);
+    atlasImage->SetSize(atlasSize.x_, atlasSize.y_, 4);
+    atlasImage->SetData(nullptr);
+
+    auto xmlFile = MakeShared<XMLFile>(context_);
+    XMLElement root = xmlFile->CreateRoot("TextureAtlas");
+    root.SetAttribute("imagePath", atlasImageName);
+
+    unsigned char* atlasData = atlasImage->GetData();
+    for (unsigned i = 0; i < sprites.size(); ++i)
+    {
+        const TextureAtlasSprite& sprite = sprites[i];
+        const unsigned char* imageData = images[i]->GetData();
+        const int imageWidth = sprite.frameSize_.x_;
+        for (int y = 0; y < sprite.size_.y_; ++y)
+        {
+            const int sourceOffset = ((sprite.trimOffset_.y_ + y) * imageWidth + sprite.trimOffset_.x_) * 4;
+            const int destOffset = ((sprite.position_.y_ + y) * atlasSize.x_ + sprite.position_.x_) * 4;
+            memcpy(atlasData + destOffset, imageData + sourceOffset, sprite.size_.x_ * 4);
+        }
+
+        XMLElement subTexture = root.CreateChild("SubTexture");
+        subTexture.SetString("name", sprite.name_);
+        subTexture.SetInt("x", sprite.position_.x_);
+        subTexture.SetInt("y", sprite.position_.y_);
+        subTexture.SetInt("width", sprite.size_.x_);
+        subTexture.SetInt("height", sprite.size_.y_);
+
+        // Frame is used to keep the hot spot of trimmed sprite, see SpriteSheet2D
+        if (sprite.size_ != sprite.frameSize_)
+        {
+            subTexture.SetInt("frameX", -sprite.trimOffset_.x_);
+            subTexture.SetInt("frameY", -sprite.trimOffset_.y_);
+            subTexture.SetInt("frameWidth", sprite.frameSize_.x_);
+            subTexture.SetInt("frameHeight", sprite.frameSize_.y_);
+        }
+    }
+
+    const ea::string outputPath = GetPath(input.outputFileName_);
+    fs->CreateDirsRecursive(outputPath);
+
+    if (!atlasImage->SavePNG(outputPath + atlasImageName))
+    {
+        URHO3D_LOGERROR("Cannot save image of atlas '{}'", input.resourceName_);
+        return false;
+    }
+
+    File xmlOutput(context_, outputPath + atlasName + ".xml", FILE_WRITE);
+    if (!xmlOutput.IsOpen() || !xmlFile->Save(xmlOutput))
+    {
+        URHO3D_LOGERROR("Cannot save sprite sheet of atlas '{}'", input.resourceName_);
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,88 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Math/Rect.h"
+#include "../Utility/AssetTransformer.h"
+
+namespace Urho3D
+{
+
+/// Sprite packed by TextureAtlasPacker.
+struct URHO3D_API TextureAtlasSprite
+{
+    /// Name of the sprite in the sprite sheet.
+    ea::string name_;
+    /// Size of the sprite in the atlas, after trimming.
+    IntVector2 size_;
+    /// Size of the source image.
+    IntVector2 frameSize_;
+    /// Offset of the trimmed rectangle in the source image.
+    IntVector2 trimOffset_;
+    /// Position in the atlas. Filled by packing.
+    IntVector2 position_;
+};
+
+/// Asset transformer that packs images of the folder into one texture atlas with SpriteSheet2D.
+/// Applied to "*.atlas" marker files, contents of the marker file are ignored.
+/// Marker "Folder/Name.atlas" produces "Folder/Name.png" and "Folder/Name.xml" from all other images in the folder.
+/// Sprites are named after the image files without extension.
+/// Rectangles are aligned to 4x4 blocks by default so the atlas can be block-compressed without bleeding.
+class URHO3D_API TextureAtlasPacker : public AssetTransformer
+{
+    URHO3D_OBJECT(TextureAtlasPacker, AssetTransformer);
+
+public:
+    static const unsigned DefaultMaxSize = 2048;
+    static const unsigned DefaultPadding = 1;
+
+    explicit TextureAtlasPacker(Context* context);
+    ~TextureAtlasPacker() override;
+    static void RegisterObject(Context* context);
+
+    /// Pack sprites into the smallest power-of-two atlas not larger than the max size.
+    /// Padding is added to the right and bottom of each sprite, positions and padded sizes are aligned.
+    /// Return false if sprites don't fit.
+    static bool PackSprites(ea::vector<TextureAtlasSprite>& sprites, int maxSize, int padding, int alignment,
+        IntVector2& atlasSize);
+
+    bool IsApplicable(const AssetTransformerInput& input) override;
+    bool Execute(const AssetTransformerInput& input, AssetTransformerOutput& output,
+        const AssetTransformerVector& transformers) override;
+    bool IsThreadSafe() override { return true; }
+
+private:
+    /// Max width and height of the atlas.
+    unsigned maxSize_{DefaultMaxSize};
+    /// Transparent pixels between sprites.
+    unsigned padding_{DefaultPadding};
+    /// Whether to trim transparent borders of images.
+    bool trim_{true};
+    /// Whether to align sprites to 4x4 blocks.
+    bool alignToBlocks_{true};
+    /// Whether to pack images from subfolders too.
+    bool recursive_{};
+};
+
+}
@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Utility/TextureCompressor.h"
+
+#include "../Core/Context.h"
+#include "../IO/File.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const StringVector textureCompressionFormatNames = {
+    "Auto",
+    "DXT1",
+    "DXT3",
+    "DXT5",
+};
+
+const StringVector imageMipFilterNames = {
+    "Box",
+    "Kaiser",
+};
+
+const StringVector supportedExtensions = {".png", ".jpg", ".jpeg", ".tga", ".bmp", ".webp"};
+
+bool IsImageOpaque(const Image& image)
+{
+    if (!image.HasAlphaChannel())
+        return true;
+
+    const unsigned char* data = image.GetData();
+    const unsigned numPixels = image.GetWidth() * image.GetHeight() * image.GetDepth();
+    const unsigned components = image.GetComponents();
+    for (unsigned i = 0; i < numPixels; ++i)
+    {
+        if (data[i * components + components - 1] != 255)
+            return false;
+    }
+    return true;
+}
+
+}
+
+TextureCompressor::TextureCompressor(Context* context)
+    : AssetTransformer(context)
+{
+}
+
+TextureCompressor::~TextureCompressor()
+{
+}
+
+void TextureCompressor::RegisterObject(Context* context)
+{
+    context->RegisterFactory<TextureCompressor>(Category_Transformer);
+
+    URHO3D_ENUM_ATTRIBUTE("Format", format_, textureCompressionFormatNames, TextureCompressionFormat::Auto, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Generate Mips", bool, generateMips_, true, AM_DEFAULT);
+    URHO3D_ENUM_ATTRIBUTE("Mip Filter", mipFilter_, imageMipFilterNames, ImageMipFilter::Kaiser, AM_DEFAULT);
+}
+
+bool TextureCompressor::IsApplicable(const AssetTransformerInput& input)
+{
+    for (const ea::string& extension : supportedExtensions)
+    {
+        if (input.resourceName_.ends_with(extension, false))
+            return true;
+    }
+    return false;
+}
+
+bool TextureCompressor::Execute(
+    const AssetTransformerInput& input, AssetTransformerOutput& output, const AssetTransformerVector& transformers)
+{
+    auto fs = GetSubsystem<FileSystem>();
+
+    auto image = MakeShared<Image>(context_);
+    {
+        File file(context_, input.inputFileName_);
+        if (!file.IsOpen() || !image->Load(file))
+        {
+            URHO3D_LOGERROR("Cannot load image '{}'", input.resourceName_);
+            return false;
+        }
+    }
+
+    // Image may be already compressed by previous execution
+    if (image->IsCompressed())
+        return true;
+
+    if (image->GetDepth() > 1)
+    {
+        URHO3D_LOGWARNING("Cannot compress 3D image '{}'", input.resourceName_);
+        return true;
+    }
+
+    fs->CreateDirsRecursive(GetPath(input.outputFileName_));
+    if (!image->SaveDDS(input.outputFileName_, GetCompressedFormat(*image), generateMips_, mipFilter_))
+    {
+        URHO3D_LOGERROR("Cannot save compressed image '{}'", input.resourceName_);
+        return false;
+    }
+    return true;
+}
+
+CompressedFormat TextureCompressor::GetCompressedFormat(const Image& image) const
+{
+    switch (format_)
+    {
+    case TextureCompressionFormat::DXT1: return CF_DXT1;
+    case TextureCompressionFormat::DXT3: return CF_DXT3;
+    case TextureCompressionFormat::DXT5: return CF_DXT5;
+    case TextureCompressionFormat::Auto:
+    default: return IsImageOpaque(image) ? CF_DXT1 : CF_DXT5;
+    }
+}
+
+}
@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Resource/Image.h"
+#include "../Utility/AssetTransformer.h"
+
+namespace Urho3D
+{
+
+/// Block compression format used by TextureCompressor.
+enum class TextureCompressionFormat
+{
+    /// DXT1 for opaque images, DXT5 otherwise.
+    Auto,
+    DXT1,
+    DXT3,
+    DXT5,
+};
+
+/// Asset transformer that replaces images with block-compressed DDS with pre-generated mip levels.
+/// Output keeps the resource name of the image, so materials don't need to be changed.
+/// Use flavor of the transformer to choose a format for specific platforms.
+class URHO3D_API TextureCompressor : public AssetTransformer
+{
+    URHO3D_OBJECT(TextureCompressor, AssetTransformer);
+
+public:
+    explicit TextureCompressor(Context* context);
+    ~TextureCompressor() override;
+    static void RegisterObject(Context* context);
+
+    bool IsApplicable(const AssetTransformerInput& input) override;
+    bool Execute(const AssetTransformerInput& input, AssetTransformerOutput& output,
+        const AssetTransformerVector& transformers) override;
+    bool IsExecutedOnOutput() override { return true; }
+    bool IsThreadSafe() override { return true; }
+
+    /// Return compressed format that would be used for the image.
+    CompressedFormat GetCompressedFormat(const Image& image) const;
+
+private:
+    TextureCompressionFormat format_{};
+    bool generateMips_{true};
+    ImageMipFilter mipFilter_{ImageMipFilter::Kaiser};
+};
+
+}
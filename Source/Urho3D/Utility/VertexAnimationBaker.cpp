@@ -0,0 +1,362 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Utility/VertexAnimationBaker.h"
+
+#include "../Core/Context.h"
+#include "../Graphics/AnimatedModel.h"
+#include "../Graphics/AnimationController.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/ModelView.h"
+#include "../Graphics/Octree.h"
+#include "../Graphics/Texture2D.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+#include "../Resource/Image.h"
+#include "../Resource/ResourceCache.h"
+#include "../Resource/XMLFile.h"
+#include "../Scene/Scene.h"
+#include "../Utility/VertexAnimationMetadata.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Suffix of the baked resources.
+const ea::string bakedSuffix = "_VAT";
+
+/// Encode value in range [0, 1] into two bytes.
+ea::pair<unsigned char, unsigned char> EncodeTwoBytes(float value)
+{
+    const auto encoded = static_cast<unsigned>(RoundToInt(Clamp(value, 0.0f, 1.0f) * 65535.0f));
+    return {static_cast<unsigned char>(encoded >> 8), static_cast<unsigned char>(encoded & 0xff)};
+}
+
+/// Encode value in range [-1, 1] into one byte.
+unsigned char EncodeByte(float value)
+{
+    return static_cast<unsigned char>(RoundToInt(Clamp(value * 0.5f + 0.5f, 0.0f, 1.0f) * 255.0f));
+}
+
+}
+
+VertexAnimationBaker::VertexAnimationBaker(Context* context)
+    : AssetTransformer(context)
+{
+}
+
+VertexAnimationBaker::~VertexAnimationBaker()
+{
+}
+
+void VertexAnimationBaker::RegisterObject(Context* context)
+{
+    context->RegisterFactory<VertexAnimationBaker>(Category_Transformer);
+
+    URHO3D_ATTRIBUTE("Animations", ResourceRefList, animations_, ResourceRefList(Animation::GetTypeStatic()), AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Sample Rate", float, sampleRate_, DefaultSampleRate, AM_DEFAULT);
+}
+
+bool VertexAnimationBaker::IsApplicable(const AssetTransformerInput& input)
+{
+    return input.inputFileName_.ends_with(".mdl", false)
+        && !input.inputFileName_.ends_with(bakedSuffix + ".mdl", false);
+}
+
+bool VertexAnimationBaker::Execute(
+    const AssetTransformerInput& input, AssetTransformerOutput& output, const AssetTransformerVector& transformers)
+{
+    if (animations_.names_.empty())
+        return true;
+
+    auto cache = GetSubsystem<ResourceCache>();
+    auto fs = GetSubsystem<FileSystem>();
+
+    auto model = cache->GetResource<Model>(input.resourceName_);
+    if (!model)
+        return false;
+
+    auto modelView = MakeShared<ModelView>(context_);
+    if (!modelView->ImportModel(model))
+    {
+        URHO3D_LOGERROR("Cannot import model '{}'", input.resourceName_);
+        return false;
+    }
+
+    if (modelView->GetBones().empty())
+    {
+        URHO3D_LOGWARNING("Model '{}' has no skeleton, vertex animation is not baked", input.resourceName_);
+        return true;
+    }
+
+    // Only the most detailed LOD is baked, vertices are addressed by index in it
+    unsigned numVertices = 0;
+    for (GeometryView& geometry : modelView->GetGeometries())
+    {
+        if (geometry.lods_.size() > 1)
+            geometry.lods_.resize(1);
+        if (!geometry.lods_.empty())
+            numVertices += geometry.lods_[0].vertices_.size();
+    }
+    if (numVertices == 0)
+        return true;
+
+    BakedFrames frames;
+    if (!BakeFrames(model, *modelView, frames))
+        return false;
+
+    BoundingBox bounds;
+    for (const Vector3& position : frames.positions_)
+        bounds.Merge(position);
+
+    const unsigned width = ea::min(numVertices, MaxTextureWidth);
+    const unsigned numRows = (numVertices + width - 1) / width;
+    if (frames.numFrames_ * numRows * 3 > MaxTextureHeight)
+    {
+        URHO3D_LOGERROR("Too many frames or vertices to bake vertex animation of model '{}'", input.resourceName_);
+        return false;
+    }
+
+    const ea::string baseName = GetFileName(input.resourceName_) + bakedSuffix;
+    const ea::string resourcePath = GetPath(input.resourceName_);
+    const ea::string outputPath = GetPath(input.outputFileName_);
+    fs->CreateDirsRecursive(outputPath);
+
+    // Texture name should differ from the model name, otherwise their XML files would clash
+    const ea::string textureName = resourcePath + baseName + "_Texture.png";
+    if (!SaveTexture(outputPath + baseName + "_Texture.png", frames, bounds, numVertices, width, numRows))
+        return false;
+
+    // Replace skinning with vertex coordinates in the texture
+    unsigned vertexIndex = 0;
+    ea::vector<GeometryView>& geometries = modelView->GetGeometries();
+    for (unsigned geometryIndex = 0; geometryIndex < geometries.size(); ++geometryIndex)
+    {
+        GeometryView& geometry = geometries[geometryIndex];
+        for (GeometryLODView& lod : geometry.lods_)
+        {
+            lod.vertexFormat_.uv_[1] = TYPE_VECTOR2;
+            lod.vertexFormat_.blendIndices_ = ModelVertexFormat::Undefined;
+            lod.vertexFormat_.blendWeights_ = ModelVertexFormat::Undefined;
+            lod.morphs_.clear();
+
+            for (ModelVertex& vertex : lod.vertices_)
+            {
+                vertex.uv_[1] = Vector4(vertexIndex % width, vertexIndex / width, 0.0f, 0.0f);
+                vertex.blendIndices_ = Vector4::ZERO;
+                vertex.blendWeights_ = Vector4::ZERO;
+                ++vertexIndex;
+            }
+        }
+
+        if (geometry.material_.empty())
+            continue;
+
+        auto material = cache->GetResource<Material>(geometry.material_);
+        if (!material)
+        {
+            URHO3D_LOGWARNING("Cannot load material '{}' to make vertex animation material", geometry.material_);
+            continue;
+        }
+
+        const ea::string materialName = Format("{}_{}.material", baseName, geometryIndex);
+        if (!SaveMaterial(outputPath + materialName, material, textureName, bounds, numRows))
+            return false;
+        geometry.material_ = resourcePath + materialName;
+    }
+
+    modelView->SetBones({});
+    modelView->SetMorphs({});
+    modelView->AddMetadata(VertexAnimationMetadata::Animations, frames.animationNames_);
+    modelView->AddMetadata(VertexAnimationMetadata::AnimationFrames, frames.animationFrames_);
+    modelView->AddMetadata(VertexAnimationMetadata::FrameRate, sampleRate_);
+
+    // Bounding box should contain all animated frames, not just bind pose
+    const SharedPtr<Model> bakedModel = modelView->ExportModel(resourcePath + baseName + ".mdl");
+    bakedModel->SetBoundingBox(bounds);
+    if (!bakedModel->SaveFile(outputPath + baseName + ".mdl"))
+    {
+        URHO3D_LOGERROR("Cannot save baked model '{}'", input.resourceName_);
+        return false;
+    }
+    return true;
+}
+
+bool VertexAnimationBaker::BakeFrames(Model* model, const ModelView& modelView, BakedFrames& result) const
+{
+    auto cache = GetSubsystem<ResourceCache>();
+
+    auto scene = MakeShared<Scene>(context_);
+    scene->CreateComponent<Octree>();
+    Node* node = scene->CreateChild();
+
+    auto animatedModel = node->CreateComponent<AnimatedModel>();
+    animatedModel->SetModel(model);
+    animatedModel->ApplyAnimation();
+
+    auto animationController = node->CreateComponent<AnimationController>();
+    animationController->Update(0.0f);
+
+    Skeleton& skeleton = animatedModel->GetSkeleton();
+    const unsigned numBones = skeleton.GetNumBones();
+    ea::vector<Matrix3x4> skinMatrices(numBones);
+
+    for (const ea::string& animationName : animations_.names_)
+    {
+        auto animation = cache->GetResource<Animation>(animationName);
+        if (!animation)
+        {
+            URHO3D_LOGERROR("Cannot load animation '{}' to bake", animationName);
+            return false;
+        }
+
+        const float animationLength = animation->GetLength();
+        const unsigned numFrames = ea::max(1, CeilToInt(animationLength * sampleRate_ - M_LARGE_EPSILON));
+
+        result.animationNames_.push_back(GetFileName(animationName));
+        result.animationFrames_.push_back(IntVector2(result.numFrames_, numFrames));
+        result.numFrames_ += numFrames;
+
+        animationController->StopAll();
+        animationController->PlayNew(AnimationParameters{animation}.Looped());
+        for (unsigned frame = 0; frame < numFrames; ++frame)
+        {
+            const float frameTime = ea::min(frame / sampleRate_, animationLength);
+            animationController->UpdateAnimationTime(animation, frameTime);
+            animationController->Update(0.0f);
+            animatedModel->ApplyAnimation();
+
+            for (unsigned boneIndex = 0; boneIndex < numBones; ++boneIndex)
+            {
+                const Bone* bone = skeleton.GetBone(boneIndex);
+                skinMatrices[boneIndex] = bone->node_ ? bone->node_->GetWorldTransform() * bone->offsetMatrix_ : Matrix3x4::IDENTITY;
+            }
+
+            for (const GeometryView& geometry : modelView.GetGeometries())
+            {
+                if (geometry.lods_.empty())
+                    continue;
+
+                for (const ModelVertex& vertex : geometry.lods_[0].vertices_)
+                {
+                    Matrix3x4 skinMatrix = Matrix3x4::ZERO;
+                    float totalWeight = 0.0f;
+                    for (const auto& [boneIndex, weight] : vertex.GetBlendIndicesAndWeights())
+                    {
+                        if (weight > 0.0f && boneIndex < numBones)
+                        {
+                            skinMatrix = skinMatrix + skinMatrices[boneIndex] * weight;
+                            totalWeight += weight;
+                        }
+                    }
+                    if (totalWeight <= 0.0f)
+                        skinMatrix = Matrix3x4::IDENTITY;
+
+                    result.positions_.push_back(skinMatrix * vertex.GetPosition());
+                    result.normals_.push_back((skinMatrix.ToMatrix3() * vertex.GetNormal()).Normalized());
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+bool VertexAnimationBaker::SaveTexture(const ea::string& fileName, const BakedFrames& frames,
+    const BoundingBox& bounds, unsigned numVertices, unsigned width, unsigned numRows) const
+{
+    const unsigned height = frames.numFrames_ * numRows * 3;
+    const unsigned layerSize = width * numRows * 4;
+    const Vector3 boundsSize = VectorMax(bounds.Size(), Vector3::ONE * M_EPSILON);
+
+    ea::vector<unsigned char> data(width * height * 4);
+    for (unsigned frame = 0; frame < frames.numFrames_; ++frame)
+    {
+        unsigned char* positionHigh = &data[frame * layerSize * 3];
+        unsigned char* positionLow = positionHigh + layerSize;
+        unsigned char* normal = positionLow + layerSize;
+
+        for (unsigned i = 0; i < numVertices; ++i)
+        {
+            const unsigned sourceIndex = frame * numVertices + i;
+            const Vector3 position = (frames.positions_[sourceIndex] - bounds.min_) / boundsSize;
+            const Vector3& vertexNormal = frames.normals_[sourceIndex];
+
+            for (unsigned component = 0; component < 3; ++component)
+            {
+                const auto [high, low] = EncodeTwoBytes(position.Data()[component]);
+                positionHigh[i * 4 + component] = high;
+                positionLow[i * 4 + component] = low;
+                normal[i * 4 + component] = EncodeByte(vertexNormal.Data()[component]);
+            }
+            positionHigh[i * 4 + 3] = 255;
+            positionLow[i * 4 + 3] = 255;
+            normal[i * 4 + 3] = 255;
+        }
+    }
+
+    auto image = MakeShared<Image>(context_);
+    image->SetSize(width, height, 4);
+    image->SetData(data.data());
+    if (!image->SavePNG(fileName))
+    {
+        URHO3D_LOGERROR("Cannot save vertex animation texture '{}'", fileName);
+        return false;
+    }
+
+    // Texture should be sampled exactly as is
+    auto parameters = MakeShared<XMLFile>(context_);
+    XMLElement root = parameters->CreateRoot("texture");
+    root.CreateChild("mipmap").SetBool("enable", false);
+    root.CreateChild("filter").SetAttribute("mode", "nearest");
+    root.CreateChild("linear").SetBool("enable", true);
+    return parameters->SaveFile(ReplaceExtension(fileName, ".xml"));
+}
+
+bool VertexAnimationBaker::SaveMaterial(const ea::string& fileName, Material* sourceMaterial,
+    const ea::string& textureName, const BoundingBox& bounds, unsigned numRows) const
+{
+    const ea::string defines = "URHO3D_VERTEX_ANIMATION";
+    const auto appendDefine = [&](const ea::string& existing) { return existing.empty() ? defines : existing + " " + defines; };
+
+    auto fakeTexture = MakeShared<Texture2D>(context_);
+    fakeTexture->SetName(textureName);
+
+    const SharedPtr<Material> material = sourceMaterial->Clone();
+    material->SetVertexShaderDefines(appendDefine(material->GetVertexShaderDefines()));
+    material->SetPixelShaderDefines(appendDefine(material->GetPixelShaderDefines()));
+    material->SetTexture("VertexAnimation", fakeTexture);
+    material->SetShaderParameter("VertexAnimationBoundsMin", bounds.min_);
+    material->SetShaderParameter("VertexAnimationBoundsSize", VectorMax(bounds.Size(), Vector3::ONE * M_EPSILON));
+    material->SetShaderParameter("VertexAnimationNumRows", static_cast<float>(numRows));
+
+    if (!material->SaveFile(fileName))
+    {
+        URHO3D_LOGERROR("Cannot save vertex animation material '{}'", fileName);
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2017-2022 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Graphics/Animation.h"
+#include "../Graphics/Model.h"
+#include "../Utility/AssetTransformer.h"
+
+namespace Urho3D
+{
+
+class Material;
+class ModelView;
+
+/// Asset transformer that bakes skeletal animations of the model into vertex animation texture (VAT).
+/// Produces static "*_VAT.mdl" model and "*_VAT.png" texture next to the model, and "*_VAT_N.material"
+/// for each geometry that has material. The result is meant to be rendered by CrowdModel.
+///
+/// Texture contains three rows of layers per frame: high byte of position, low byte of position and normal.
+/// Positions are normalized to the bounding box of all frames. Vertices are laid out in rows of limited width,
+/// column and row of each vertex are stored in the second UV channel of the model.
+/// Tangents are not animated. Morphs are not baked.
+class URHO3D_API VertexAnimationBaker : public AssetTransformer
+{
+    URHO3D_OBJECT(VertexAnimationBaker, AssetTransformer);
+
+public:
+    /// Max width of the texture.
+    static const unsigned MaxTextureWidth = 4096;
+    /// Max height of the texture.
+    static const unsigned MaxTextureHeight = 16384;
+    static constexpr float DefaultSampleRate = 30.0f;
+
+    explicit VertexAnimationBaker(Context* context);
+    ~VertexAnimationBaker() override;
+    static void RegisterObject(Context* context);
+
+    bool IsApplicable(const AssetTransformerInput& input) override;
+    bool Execute(const AssetTransformerInput& input, AssetTransformerOutput& output,
+        const AssetTransformerVector& transformers) override;
+    bool IsExecutedOnOutput() override { return true; }
+
+private:
+    /// Animated vertex positions and normals of all frames.
+    struct BakedFrames
+    {
+        ea::vector<Vector3> positions_;
+        ea::vector<Vector3> normals_;
+        StringVector animationNames_;
+        VariantVector animationFrames_;
+        unsigned numFrames_{};
+    };
+
+    /// Evaluate skinned vertices of the model for each frame of each animation.
+    bool BakeFrames(Model* model, const ModelView& modelView, BakedFrames& result) const;
+    /// Save vertex animation texture and its parameters.
+    bool SaveTexture(const ea::string& fileName, const BakedFrames& frames, const BoundingBox& bounds,
+        unsigned numVertices, unsigned width, unsigned numRows) const;
+    /// Save material suitable for vertex animation.
+    bool SaveMaterial(const ea::string& fileName, Material* sourceMaterial, const ea::string& textureName,
+        const BoundingBox& bounds, unsigned numRows) const;
+
+    ResourceRefList animations_{Animation::GetTypeStatic()};
+    float sampleRate_{DefaultSampleRate};
+};
+
+}
@@ -0,0 +1,25 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Container/ConstString.h"
+
+namespace Urho3D
+{
+
+/// Metadata of the Model baked by VertexAnimationBaker.
+namespace VertexAnimationMetadata
+{
+
+/// Names of baked animations.
+URHO3D_GLOBAL_CONSTANT(ConstString Animations{"VertexAnimations"});
+/// First frame and number of frames of each baked animation, as IntVector2.
+URHO3D_GLOBAL_CONSTANT(ConstString AnimationFrames{"VertexAnimationFrames"});
+/// Number of baked frames per second.
+URHO3D_GLOBAL_CONSTANT(ConstString FrameRate{"VertexAnimationFrameRate"});
+
+} // namespace VertexAnimationMetadata
+
+} // namespace Urho3D
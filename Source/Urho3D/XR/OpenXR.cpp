@@ -1298,6 +1298,7 @@ OpenXR::OpenXR(Context* ctx)
     : BaseClassName(ctx)
 {
     SubscribeToEvent(E_BEGINFRAME, &OpenXR::HandleBeginFrame);
+    SubscribeToEvent(E_BEGINRENDERING, &OpenXR::HandleBeginRendering);
     SubscribeToEvent(E_ENDRENDERING, &OpenXR::HandleEndRendering);
 }
 
@@ -1651,23 +1652,43 @@ bool OpenXR::UpdateSessionState(XrSessionState state)
     return true;
 }
 
-void OpenXR::BeginFrame()
+bool OpenXR::BeginFrame()
 {
+    // Runtime throttles the frame loop here, so logic update starts as late as possible
     XrFrameState frameState = {XR_TYPE_FRAME_STATE};
-    xrWaitFrame(session_.Raw(), nullptr, &frameState);
+    if (!URHO3D_CHECK_OPENXR(xrWaitFrame(session_.Raw(), nullptr, &frameState)))
+        return false;
 
     XrFrameBeginInfo beginInfo = {XR_TYPE_FRAME_BEGIN_INFO};
-    xrBeginFrame(session_.Raw(), &beginInfo);
+    if (!URHO3D_CHECK_OPENXR(xrBeginFrame(session_.Raw(), &beginInfo)))
+        return false;
 
     predictedTime_ = frameState.predictedDisplayTime;
+    predictedPeriod_ = frameState.predictedDisplayPeriod;
+    return frameState.shouldRender == XR_TRUE;
 }
 
-void OpenXR::LocateViewsAndSpaces()
+void OpenXR::LocateHeadAndViews()
 {
     // Head
     headLocation_.next = &headVelocity_;
     xrLocateSpace(viewSpace_.Raw(), headSpace_.Raw(), predictedTime_, &headLocation_);
 
+    // Eyes
+    XrViewLocateInfo viewInfo = {XR_TYPE_VIEW_LOCATE_INFO};
+    viewInfo.viewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+    viewInfo.space = headSpace_.Raw();
+    viewInfo.displayTime = predictedTime_;
+
+    XrViewState viewState = {XR_TYPE_VIEW_STATE};
+    unsigned numViews = 0;
+    xrLocateViews(session_.Raw(), &viewInfo, &viewState, 2, &numViews, views_.data());
+}
+
+void OpenXR::LocateViewsAndSpaces()
+{
+    LocateHeadAndViews();
+
     // Hands
     for (VRHand hand : {VRHand::Left, VRHand::Right})
     {
@@ -1686,16 +1707,6 @@ void OpenXR::LocateViewsAndSpaces()
                 handGrips_[hand]->actionSpace_.Raw(), headSpace_.Raw(), predictedTime_, &handGrips_[hand]->location_);
         }
     }
-
-    // Eyes
-    XrViewLocateInfo viewInfo = {XR_TYPE_VIEW_LOCATE_INFO};
-    viewInfo.viewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
-    viewInfo.space = headSpace_.Raw();
-    viewInfo.displayTime = predictedTime_;
-
-    XrViewState viewState = {XR_TYPE_VIEW_STATE};
-    unsigned numViews = 0;
-    xrLocateViews(session_.Raw(), &viewInfo, &viewState, 2, &numViews, views_.data());
 }
 
 void OpenXR::SynchronizeActions()
@@ -1720,12 +1731,18 @@ void OpenXR::HandleBeginFrame()
 
     PollEvents();
 
+    frameBegun_ = false;
+    frameRendered_ = false;
+
     if (IsRunning())
     {
-        BeginFrame();
+        const bool shouldRender = BeginFrame();
+        frameBegun_ = true;
 
-        if (IsVisible())
+        // Runtime may ask to skip rendering, e.g. when the headset is taken off
+        if (IsVisible() && shouldRender)
         {
+            frameRendered_ = true;
             AcquireSwapChainImages();
             LocateViewsAndSpaces();
             SynchronizeActions();
@@ -1737,6 +1754,17 @@ void OpenXR::HandleBeginFrame()
     }
 }
 
+void OpenXR::HandleBeginRendering()
+{
+    if (!lateLatching_ || !frameRendered_ || !IsConnected())
+        return;
+
+    // Logic update is done, predict poses again for the same display time to use the latest tracking data.
+    // Eye poses submitted to the compositor are updated together with cameras, so they always match.
+    LocateHeadAndViews();
+    UpdateCurrentRigTransforms();
+}
+
 void OpenXR::AcquireSwapChainImages()
 {
     Texture2D* colorTexture = swapChain_->AcquireImage();
@@ -1843,10 +1871,10 @@ void OpenXR::HandleEndRendering()
     if (!IsConnected())
         return;
 
-    if (IsRunning())
+    if (IsRunning() && frameBegun_)
     {
         XrFrameEndInfo endInfo{XR_TYPE_FRAME_END_INFO};
-        if (IsVisible())
+        if (frameRendered_)
         {
             ReleaseSwapChainImages();
             LinkImagesToFrameInfo(endInfo);
@@ -1854,6 +1882,9 @@ void OpenXR::HandleEndRendering()
 
         EndFrame(endInfo);
     }
+
+    frameBegun_ = false;
+    frameRendered_ = false;
 }
 
 void OpenXR::BindActions(XMLFile* xmlFile)
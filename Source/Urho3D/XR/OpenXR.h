@@ -243,6 +243,18 @@ public:
     void SetCurrentActionSet(SharedPtr<XRActionGroup> set) override;
     /// @}
 
+    /// Set whether head and eye poses are located again right before rendering. This reduces motion-to-photon
+    /// latency because the poses used for rendering are predicted after the whole logic update.
+    /// Hand poses and the head pose seen by the logic update are not affected. Enabled by default.
+    void SetLateLatching(bool enable) { lateLatching_ = enable; }
+    /// Return whether head and eye poses are located again right before rendering.
+    bool IsLateLatching() const { return lateLatching_; }
+    /// Return predicted time when the current frame will be displayed, in nanoseconds of the runtime clock.
+    /// Gameplay may use it to extrapolate state to the moment the frame reaches the user.
+    long long GetPredictedDisplayTime() const { return predictedTime_; }
+    /// Return predicted interval between displayed frames, in seconds.
+    float GetPredictedDisplayPeriod() const { return static_cast<float>(predictedPeriod_) * 1e-9f; }
+
     const OpenXRTweaks& GetTweaks() const { return tweaks_; }
     const StringVector GetExtensions() const { return supportedExtensions_; }
 
@@ -260,9 +272,10 @@ protected:
 
     void PollEvents();
     bool UpdateSessionState(XrSessionState state);
-    void BeginFrame();
+    bool BeginFrame();
     void AcquireSwapChainImages();
     void LocateViewsAndSpaces();
+    void LocateHeadAndViews();
     void SynchronizeActions();
 
     void ReleaseSwapChainImages();
@@ -270,6 +283,7 @@ protected:
     void EndFrame(XrFrameEndInfo& endInfo);
 
     void HandleBeginFrame();
+    void HandleBeginRendering();
     void HandleEndRendering();
 
     StringVector supportedExtensions_;
@@ -311,6 +325,14 @@ protected:
     XrEnvironmentBlendMode blendMode_{XR_ENVIRONMENT_BLEND_MODE_OPAQUE};
     /// Predicted time for display of the next frame.
     XrTime predictedTime_{};
+    /// Predicted interval between displayed frames.
+    XrDuration predictedPeriod_{};
+    /// Whether the frame is begun and should be ended.
+    bool frameBegun_{};
+    /// Whether the swap chain images are acquired and the frame is rendered.
+    bool frameRendered_{};
+    /// Whether to locate head and eye poses again right before rendering.
+    bool lateLatching_{true};
     /// Current session state.
     XrSessionState sessionState_{};
 
@@ -122,11 +122,26 @@ void VirtualReality::UpdateCurrentRig()
     if (!rig_.IsValid() || !currentSurface)
         return;
 
-    // Update transforms and cameras
     Node* head = rig_.head_;
     head->SetVar("PreviousTransformLocal", head->GetTransformMatrix());
     head->SetVar("PreviousTransformWorld", head->GetWorldTransform());
-    head->SetTransformMatrix(GetHeadTransform());
+    UpdateCurrentRigTransforms();
+
+    // Connect to the current surface in the swap chain
+    if (currentSurface->GetViewport(0) != rig_.viewport_)
+        currentSurface->SetViewport(0, rig_.viewport_);
+
+    rig_.viewport_->SetRect({0, 0, currentBackBufferColor_->GetWidth(), currentBackBufferColor_->GetHeight()});
+    currentSurface->QueueUpdate();
+}
+
+void VirtualReality::UpdateCurrentRigTransforms()
+{
+    if (!rig_.IsValid())
+        return;
+
+    // Update transforms and cameras
+    rig_.head_->SetTransformMatrix(GetHeadTransform());
 
     Node* leftEyeNode = rig_.leftEye_->GetNode();
     Node* rightEyeNode = rig_.rightEye_->GetNode();
@@ -150,13 +165,6 @@ void VirtualReality::UpdateCurrentRig()
     const float ipdAdjust = ipdCorrection_ * 0.5f * 0.001f;
     leftEyeNode->Translate({ipdAdjust, 0, 0}, TS_LOCAL);
     rightEyeNode->Translate({-ipdAdjust, 0, 0}, TS_LOCAL);
-
-    // Connect to the current surface in the swap chain
-    if (currentSurface->GetViewport(0) != rig_.viewport_)
-        currentSurface->SetViewport(0, rig_.viewport_);
-
-    rig_.viewport_->SetRect({0, 0, currentBackBufferColor_->GetWidth(), currentBackBufferColor_->GetHeight()});
-    currentSurface->QueueUpdate();
 }
 
 XRBinding* VirtualReality::GetInputBinding(const ea::string& path) const
@@ -276,6 +276,8 @@ protected:
     void CreateDefaultRig();
     void ValidateCurrentRig();
     void UpdateCurrentRig();
+    /// Update head and eye transforms and projections of the current rig from the latest tracking data.
+    void UpdateCurrentRigTransforms();
 
     /// Name of the system being run, ie. Windows Mixed Reality
     ea::string systemName_;
@@ -0,0 +1,131 @@
+// Morph and skin vertices of one vertex buffer.
+// URHO3D_SKINNED: apply skinning by up to 4 bones.
+// URHO3D_MORPHED: apply morph deltas before skinning.
+
+/// Size of source vertex in words: position, normal, tangent, blend weights, blend indices, morph range.
+#define SOURCE_STRIDE 17u
+/// Size of morph delta in words: morph index, position, normal and tangent deltas.
+#define MORPH_STRIDE 10u
+/// Size of bone matrix in words.
+#define BONE_STRIDE 12u
+
+layout(std140, binding = 5) uniform Object
+{
+    int cNumVertices;
+    int cOutputStride;
+    int cNormalOffset;
+    int cTangentOffset;
+    int cMorphWeightsOffset;
+};
+
+layout(std430, binding = 0) buffer uSourceVertices
+{
+    uint sourceVertices[];
+};
+
+layout(std430, binding = 1) buffer uAnimationData
+{
+    float animationData[];
+};
+
+#ifdef URHO3D_MORPHED
+layout(std430, binding = 2) buffer uMorphDeltas
+{
+    uint morphDeltas[];
+};
+#endif
+
+layout(std430, binding = 3) buffer uOutputVertices
+{
+    float outputVertices[];
+};
+
+vec3 LoadSourceVec3(uint offset)
+{
+    return uintBitsToFloat(uvec3(sourceVertices[offset], sourceVertices[offset + 1u], sourceVertices[offset + 2u]));
+}
+
+vec4 LoadSourceVec4(uint offset)
+{
+    return uintBitsToFloat(uvec4(sourceVertices[offset], sourceVertices[offset + 1u],
+        sourceVertices[offset + 2u], sourceVertices[offset + 3u]));
+}
+
+#ifdef URHO3D_MORPHED
+vec3 LoadMorphVec3(uint offset)
+{
+    return uintBitsToFloat(uvec3(morphDeltas[offset], morphDeltas[offset + 1u], morphDeltas[offset + 2u]));
+}
+#endif
+
+#ifdef URHO3D_SKINNED
+mat3x4 LoadBoneMatrix(uint boneIndex)
+{
+    uint offset = boneIndex * BONE_STRIDE;
+    return mat3x4(
+        animationData[offset + 0u], animationData[offset + 1u], animationData[offset + 2u], animationData[offset + 3u],
+        animationData[offset + 4u], animationData[offset + 5u], animationData[offset + 6u], animationData[offset + 7u],
+        animationData[offset + 8u], animationData[offset + 9u], animationData[offset + 10u], animationData[offset + 11u]);
+}
+#endif
+
+void StoreOutputVec3(uint offset, vec3 value)
+{
+    outputVertices[offset] = value.x;
+    outputVertices[offset + 1u] = value.y;
+    outputVertices[offset + 2u] = value.z;
+}
+
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+void main()
+{
+    uint vertexIndex = gl_GlobalInvocationID.x;
+    if (vertexIndex >= uint(cNumVertices))
+        return;
+
+    uint sourceOffset = vertexIndex * SOURCE_STRIDE;
+    vec3 position = LoadSourceVec3(sourceOffset);
+    vec3 normal = LoadSourceVec3(sourceOffset + 3u);
+    vec4 tangent = LoadSourceVec4(sourceOffset + 6u);
+
+#ifdef URHO3D_MORPHED
+    uint morphStart = sourceVertices[sourceOffset + 15u];
+    uint morphEnd = morphStart + sourceVertices[sourceOffset + 16u];
+    for (uint i = morphStart; i < morphEnd; ++i)
+    {
+        uint morphOffset = i * MORPH_STRIDE;
+        float weight = animationData[uint(cMorphWeightsOffset) + morphDeltas[morphOffset]];
+        if (weight != 0.0)
+        {
+            position += LoadMorphVec3(morphOffset + 1u) * weight;
+            normal += LoadMorphVec3(morphOffset + 4u) * weight;
+            tangent.xyz += LoadMorphVec3(morphOffset + 7u) * weight;
+        }
+    }
+#endif
+
+#ifdef URHO3D_SKINNED
+    vec4 blendWeights = LoadSourceVec4(sourceOffset + 10u);
+    uint blendIndices = sourceVertices[sourceOffset + 14u];
+
+    mat3x4 skinMatrix = LoadBoneMatrix(blendIndices & 0xffu) * blendWeights.x
+        + LoadBoneMatrix((blendIndices >> 8u) & 0xffu) * blendWeights.y
+        + LoadBoneMatrix((blendIndices >> 16u) & 0xffu) * blendWeights.z
+        + LoadBoneMatrix(blendIndices >> 24u) * blendWeights.w;
+
+    // Matrix rows are stored as columns of mat3x4
+    position = vec4(position, 1.0) * skinMatrix;
+    normal = vec4(normal, 0.0) * skinMatrix;
+    tangent.xyz = vec4(tangent.xyz, 0.0) * skinMatrix;
+#endif
+
+    uint outputOffset = vertexIndex * uint(cOutputStride);
+    StoreOutputVec3(outputOffset, position);
+    if (cNormalOffset >= 0)
+        StoreOutputVec3(outputOffset + uint(cNormalOffset), normal);
+    if (cTangentOffset >= 0)
+    {
+        StoreOutputVec3(outputOffset + uint(cTangentOffset), tangent.xyz);
+        outputVertices[outputOffset + uint(cTangentOffset) + 3u] = tangent.w;
+    }
+}
@@ -0,0 +1,80 @@
+#include "_Config.glsl"
+#include "_Uniforms.glsl"
+#include "_VertexLayout.glsl"
+#include "_VertexTransform.glsl"
+#include "_VertexScreenPos.glsl"
+#include "_GammaCorrection.glsl"
+#include "_DefaultSamplers.glsl"
+#include "_SamplerUtils.glsl"
+#include "_ClusteredLighting.glsl"
+#include "_BRDF.glsl"
+
+/// Fullscreen pass that applies all clustered lights to the geometry buffer at once.
+/// Should be used with URHO3D_LIGHT_VOLUME_PASS and URHO3D_CLUSTERED_LIGHTS.
+
+VERTEX_OUTPUT_HIGHP(vec2 vTexCoord)
+
+#ifdef URHO3D_PIXEL_SHADER
+UNIFORM_BUFFER_BEGIN(6, Custom)
+    /// Converts from geometry buffer texture space to world space.
+    UNIFORM_HIGHP(mat4 cTextureToWorld)
+    /// Camera position in world space.
+    UNIFORM_HIGHP(vec3 cCameraWorldPos)
+UNIFORM_BUFFER_END(6, Custom)
+#endif
+
+#ifdef URHO3D_VERTEX_SHADER
+void main()
+{
+    VertexTransform vertexTransform = GetVertexTransform();
+    gl_Position = WorldToClipSpace(vertexTransform.position.xyz);
+    vTexCoord = GetQuadTexCoord(gl_Position);
+}
+#endif
+
+#ifdef URHO3D_PIXEL_SHADER
+void main()
+{
+    float hwDepth = texture(sDepthBuffer, vTexCoord).r;
+    if (hwDepth >= 1.0)
+        discard;
+
+    vec4 worldPos = vec4(vTexCoord, hwDepth, 1.0) * cTextureToWorld;
+    worldPos.xyz /= worldPos.w;
+
+    ivec2 lightRange = GetClusterLightRange(worldPos.xyz);
+    if (lightRange.y == 0)
+        discard;
+
+    half4 albedoInput = texture(sAlbedo, vTexCoord);
+    half4 specularInput = texture(sProperties, vTexCoord);
+    half3 normal = DecodeNormal(texture(sNormal, vTexCoord));
+    half3 eyeVec = normalize(cCameraWorldPos - worldPos.xyz);
+    #ifndef URHO3D_PHYSICAL_MATERIAL
+        half specularPower = RoughnessToSpecularPower(specularInput.a);
+    #endif
+
+    half3 finalColor = vec3(0.0);
+    for (int i = 0; i < lightRange.y; ++i)
+    {
+        half3 lightVec;
+        half4 lightColor = GetClusteredLightColor(lightRange.x + i, worldPos.xyz, lightVec);
+
+    #if defined(URHO3D_PHYSICAL_MATERIAL) || URHO3D_SPECULAR > 0
+        half3 halfVec = normalize(eyeVec + lightVec);
+    #endif
+
+    #if defined(URHO3D_PHYSICAL_MATERIAL)
+        finalColor += Direct_PBR(lightColor.rgb, albedoInput.rgb, specularInput.rgb, specularInput.a,
+            lightVec, normal, eyeVec, halfVec);
+    #elif URHO3D_SPECULAR > 0
+        finalColor += Direct_SimpleSpecular(lightColor.rgb, albedoInput.rgb, specularInput.rgb,
+            lightVec, normal, halfVec, specularPower, lightColor.a);
+    #else
+        finalColor += Direct_Simple(lightColor.rgb, albedoInput.rgb, lightVec, normal);
+    #endif
+    }
+
+    gl_FragColor = vec4(finalColor, 0.0);
+}
+#endif
@@ -33,6 +33,13 @@ void main()
     #define URHO3D_FONT_SUPERSAMPLE
 #endif
 
+/// Sample signed distance from font texture.
+#ifdef ALPHAMAP
+    #define SampleDistance(uv) texture(sAlbedo, uv).r
+#else
+    #define SampleDistance(uv) texture(sAlbedo, uv).a
+#endif
+
 /// Return width of SDF font border.
 half GetBorderWidth(half distance)
 {
@@ -50,7 +57,7 @@ void main()
     half4 finalColor = vColor;
 
 #ifdef SIGNED_DISTANCE_FIELD
-    half distance = texture(sAlbedo, vTexCoord).a;
+    half distance = SampleDistance(vTexCoord);
     half width = GetBorderWidth(distance);
 
     half mainWeight = GetOpacity(distance, width);
@@ -58,10 +65,10 @@ void main()
         const float inv2v2 = 0.354; // 1 / (2 * sqrt(2))
         vec2 deltaUV = inv2v2 * fwidth(vTexCoord);
         vec4 square = vec4(vTexCoord - deltaUV, vTexCoord + deltaUV);
-        mainWeight += GetOpacity(texture(sAlbedo, square.xy).a, width);
-        mainWeight += GetOpacity(texture(sAlbedo, square.zw).a, width);
-        mainWeight += GetOpacity(texture(sAlbedo, square.xw).a, width);
-        mainWeight += GetOpacity(texture(sAlbedo, square.zy).a, width);
+        mainWeight += GetOpacity(SampleDistance(square.xy), width);
+        mainWeight += GetOpacity(SampleDistance(square.zw), width);
+        mainWeight += GetOpacity(SampleDistance(square.xw), width);
+        mainWeight += GetOpacity(SampleDistance(square.zy), width);
         // Divide by 4 instead of 5 to make font sharper
         mainWeight = min(0.25 * mainWeight, 1.0);
     #endif
@@ -72,7 +79,7 @@ void main()
     #endif
 
     #ifdef TEXT_EFFECT_SHADOW
-        half shadowDistance = texture(sAlbedo, vTexCoord + cShadowOffset).a;
+        half shadowDistance = SampleDistance(vTexCoord + cShadowOffset);
         half shadowWeight = step(0.5, shadowDistance);
         finalColor.rgb = mix(cShadowColor.rgb, finalColor.rgb, shadowWeight);
     #endif
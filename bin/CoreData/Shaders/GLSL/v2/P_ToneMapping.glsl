@@ -6,12 +6,24 @@
 #include "_DefaultSamplers.glsl"
 #include "_SamplerUtils.glsl"
 #include "_GammaCorrection.glsl"
+#include "_ColorGrading.glsl"
 
 VERTEX_OUTPUT_HIGHP(vec2 vTexCoord)
 VERTEX_OUTPUT_HIGHP(vec2 vScreenPos)
 
 #ifdef URHO3D_PIXEL_SHADER
 
+#if defined(OUTLINE) || defined(COLOR_GRADING)
+UNIFORM_BUFFER_BEGIN(6, Custom)
+#ifdef OUTLINE
+    UNIFORM(vec2 cInputInvSize)
+#endif
+#ifdef COLOR_GRADING
+    UNIFORM(mediump vec4 cHSVParams)
+#endif
+UNIFORM_BUFFER_END(6, Custom)
+#endif
+
 /// Reinhard tone mapping
 vec3 Reinhard(vec3 x)
 {
@@ -36,6 +48,36 @@ vec3 Uncharted2(vec3 x)
     return ((x*(A*x + C*B) + D*E) / (x*(A*x + B) + D*F)) - E/F;
 }
 
+#ifdef OUTLINE
+vec4 SampleOutline(vec2 offset)
+{
+    return texture(sEmission, vTexCoord + offset * cInputInvSize);
+}
+
+/// Same edge filter as in P_Outline, returns linear color and opacity of the outline.
+half4 GetOutline()
+{
+    half cThickness = 1.3;
+
+    half3 offset = vec3(0.0, cThickness, -cThickness);
+    half4 sample0 = SampleOutline(offset.xx);
+    half4 sample1 = SampleOutline(offset.zz);
+    half4 sample2 = SampleOutline(offset.zy);
+    half4 sample3 = SampleOutline(offset.yz);
+    half4 sample4 = SampleOutline(offset.yy);
+
+    half3 averageColor = (2.0 * sample0.rgb + sample1.rgb + sample2.rgb + sample3.rgb + sample4.rgb) * 0.2;
+    half averageAlpha = (2.0 * sample0.a + sample1.a + sample2.a + sample3.a + sample4.a) * 0.2;
+
+    half4 edge4 = abs(4.0 * sample0 - sample1 - sample2 - sample3 - sample4);
+    half edgeScale = max(0.0, averageAlpha);
+    half edge = edgeScale * max(max(edge4.r, edge4.g), max(edge4.b, edge4.a));
+
+    half3 color = averageColor / max(0.001, averageAlpha);
+    return vec4(GammaToLinearSpace(color), clamp(edge, 0.0, 1.0));
+}
+#endif
+
 #endif
 
 #ifdef URHO3D_VERTEX_SHADER
@@ -53,6 +95,11 @@ void main()
 {
     vec3 finalColor = texture(sAlbedo, vScreenPos).rgb;
 
+#ifdef OUTLINE
+    half4 outline = GetOutline();
+    finalColor = mix(finalColor, outline.rgb, outline.a);
+#endif
+
 #ifdef REINHARD
     finalColor = Reinhard(finalColor);
 #endif
@@ -64,6 +111,11 @@ void main()
     finalColor = Uncharted2(finalColor) * whiteScale;
 #endif
 
-    gl_FragColor = vec4(LinearToGammaSpace(finalColor), 1.0);
+    finalColor = LinearToGammaSpace(finalColor);
+#ifdef COLOR_GRADING
+    finalColor = ApplyColorGrading(finalColor, cHSVParams);
+#endif
+
+    gl_FragColor = vec4(finalColor, 1.0);
 }
 #endif
@@ -46,6 +46,15 @@ void main()
 #endif
 
 #ifdef URHO3D_PIXEL_SHADER
+#ifdef SIGNED_DISTANCE_FIELD
+/// Return glyph opacity from signed distance field value.
+float GetDistanceFieldOpacity(float distance)
+{
+    float width = fwidth(distance);
+    return smoothstep(0.5 - width, 0.5 + width, distance);
+}
+#endif
+
 void main()
 {
     vec4 diffColor = vec4(1.0, 1.0, 1.0, 1.0);
@@ -56,6 +65,9 @@ void main()
 
     #ifdef DIFFMAP
         vec4 diffInput = texture(sAlbedo, vTexCoord);
+        #ifdef SIGNED_DISTANCE_FIELD
+            diffInput = vec4(1.0, 1.0, 1.0, GetDistanceFieldOpacity(diffInput.a));
+        #endif
         #ifdef ALPHAMASK
             if (diffInput.a < 0.5)
                 discard;
@@ -64,6 +76,9 @@ void main()
     #endif
     #ifdef ALPHAMAP
         float alphaInput = texture(sAlbedo, vTexCoord).r;
+        #ifdef SIGNED_DISTANCE_FIELD
+            alphaInput = GetDistanceFieldOpacity(alphaInput);
+        #endif
         diffColor.a *= alphaInput;
     #endif
 
@@ -19,9 +19,52 @@ void main()
 #endif
 
 #ifdef URHO3D_PIXEL_SHADER
+#ifdef URHO3D_BICUBIC
+/// Sample texture with Catmull-Rom filter. 9 bilinear taps are used instead of 16 point taps.
+vec4 SampleCatmullRom(vec2 uv)
+{
+    vec2 samplePos = uv / cGBufferInvSize;
+    vec2 texPos1 = floor(samplePos - 0.5) + 0.5;
+    vec2 f = samplePos - texPos1;
+
+    vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));
+    vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);
+    vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));
+    vec2 w3 = f * f * (-0.5 + 0.5 * f);
+
+    // Middle taps are merged into one bilinear tap
+    vec2 w12 = w1 + w2;
+    vec2 offset12 = w2 / w12;
+
+    vec2 texPos0 = (texPos1 - 1.0) * cGBufferInvSize;
+    vec2 texPos3 = (texPos1 + 2.0) * cGBufferInvSize;
+    vec2 texPos12 = (texPos1 + offset12) * cGBufferInvSize;
+
+    vec4 result = vec4(0.0);
+    result += texture(sAlbedo, vec2(texPos0.x, texPos0.y)) * w0.x * w0.y;
+    result += texture(sAlbedo, vec2(texPos12.x, texPos0.y)) * w12.x * w0.y;
+    result += texture(sAlbedo, vec2(texPos3.x, texPos0.y)) * w3.x * w0.y;
+
+    result += texture(sAlbedo, vec2(texPos0.x, texPos12.y)) * w0.x * w12.y;
+    result += texture(sAlbedo, vec2(texPos12.x, texPos12.y)) * w12.x * w12.y;
+    result += texture(sAlbedo, vec2(texPos3.x, texPos12.y)) * w3.x * w12.y;
+
+    result += texture(sAlbedo, vec2(texPos0.x, texPos3.y)) * w0.x * w3.y;
+    result += texture(sAlbedo, vec2(texPos12.x, texPos3.y)) * w12.x * w3.y;
+    result += texture(sAlbedo, vec2(texPos3.x, texPos3.y)) * w3.x * w3.y;
+
+    // Catmull-Rom filter has negative lobes
+    return max(result, vec4(0.0));
+}
+#endif
+
 void main()
 {
-    vec4 color = texture(sAlbedo, vScreenPos);
+    #ifdef URHO3D_BICUBIC
+        vec4 color = SampleCatmullRom(vScreenPos);
+    #else
+        vec4 color = texture(sAlbedo, vScreenPos);
+    #endif
     #if defined(URHO3D_GAMMA_TO_LINEAR)
         gl_FragColor = GammaToLinearSpaceAlpha(color);
     #elif defined(URHO3D_LINEAR_TO_GAMMA)
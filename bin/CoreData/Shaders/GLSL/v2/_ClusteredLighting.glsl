@@ -0,0 +1,65 @@
+/// _ClusteredLighting.glsl
+/// [Pixel Shader only]
+/// [Lit material only]
+/// Unshadowed point and spot lights looked up from light clusters.
+/// Should match ClusteredLighting on C++ side.
+#ifndef _CLUSTERED_LIGHTING_GLSL_
+#define _CLUSTERED_LIGHTING_GLSL_
+
+#ifndef _UNIFORMS_GLSL_
+    #error Include _Uniforms.glsl before _ClusteredLighting.glsl
+#endif
+
+#if defined(URHO3D_PIXEL_SHADER) && defined(URHO3D_CLUSTERED_LIGHTS)
+
+/// Number of depth slices.
+#define URHO3D_NUM_CLUSTERS_Z 24
+/// Width of light index texture.
+#define URHO3D_CLUSTER_INDEX_TEXTURE_WIDTH 1024
+
+/// Lights, 4 texels per light: position and inverse range, color and specular intensity,
+/// direction and spot cutoff, inverse spot cutoff.
+SAMPLER_HIGHP(11, sampler2D sClusterLights)
+/// Offset and number of lights for each cluster.
+SAMPLER_HIGHP(12, sampler2D sClusterGrid)
+/// Light indices of all clusters.
+SAMPLER_HIGHP(13, sampler2D sClusterLightIndices)
+
+/// Return offset and number of lights in the cluster that contains world position.
+ivec2 GetClusterLightRange(vec3 worldPos)
+{
+    vec4 clipPos = vec4(worldPos, 1.0) * cClusterViewProj;
+    vec2 screenPos = clamp(clipPos.xy / max(clipPos.w, 1e-5) * 0.5 + 0.5, 0.0, 1.0);
+    float viewDepth = dot(vec4(worldPos, 1.0), cClusterViewZ);
+    float slice = log(max(viewDepth, 1e-5)) * cClusterParams.z + cClusterParams.w;
+
+    ivec2 numClusters = ivec2(cClusterParams.xy);
+    ivec2 clusterXY = min(ivec2(screenPos * cClusterParams.xy), numClusters - 1);
+    int clusterZ = clamp(int(floor(slice)), 0, URHO3D_NUM_CLUSTERS_Z - 1);
+    return ivec2(texelFetch(sClusterGrid, ivec2(clusterXY.y * numClusters.x + clusterXY.x, clusterZ), 0).xy);
+}
+
+/// Evaluate light at given offset in the light index texture.
+/// Return light color with distance and spot attenuation applied. w component is specular intensity.
+half4 GetClusteredLightColor(int indexOffset, vec3 worldPos, out half3 lightVec)
+{
+    ivec2 indexUV = ivec2(indexOffset % URHO3D_CLUSTER_INDEX_TEXTURE_WIDTH, indexOffset / URHO3D_CLUSTER_INDEX_TEXTURE_WIDTH);
+    int lightIndex = int(texelFetch(sClusterLightIndices, indexUV, 0).r);
+
+    vec4 lightPos = texelFetch(sClusterLights, ivec2(0, lightIndex), 0);
+    half4 lightColor = texelFetch(sClusterLights, ivec2(1, lightIndex), 0);
+    half4 lightDir = texelFetch(sClusterLights, ivec2(2, lightIndex), 0);
+    half inverseSpotCutoff = texelFetch(sClusterLights, ivec2(3, lightIndex), 0).x;
+
+    vec3 scaledLightVec = (lightPos.xyz - worldPos) * lightPos.w;
+    half lightDist = max(0.001, length(scaledLightVec));
+    lightVec = scaledLightVec / lightDist;
+
+    half invDistance = max(0.0, 1.0 - lightDist);
+    half spotFactor = clamp((dot(lightVec, lightDir.xyz) - lightDir.w) * inverseSpotCutoff, 0.0, 1.0);
+    return vec4(lightColor.rgb * (invDistance * invDistance * spotFactor), lightColor.a);
+}
+
+#endif // URHO3D_PIXEL_SHADER && URHO3D_CLUSTERED_LIGHTS
+
+#endif // _CLUSTERED_LIGHTING_GLSL_
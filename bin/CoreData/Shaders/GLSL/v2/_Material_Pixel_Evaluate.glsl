@@ -92,6 +92,42 @@
     }
 #endif
 
+#ifdef URHO3D_CLUSTERED_LIGHTS
+    /// Calculate lighting from all clustered lights affecting the pixel.
+    half3 CalculateClusteredLighting(SurfaceData surfaceData, vec3 worldPos)
+    {
+        ivec2 lightRange = GetClusterLightRange(worldPos);
+
+        half3 result = vec3(0.0);
+        for (int i = 0; i < lightRange.y; ++i)
+        {
+            half3 lightVec;
+            half4 lightColor = GetClusteredLightColor(lightRange.x + i, worldPos, lightVec);
+
+        #if defined(URHO3D_PHYSICAL_MATERIAL) || URHO3D_SPECULAR > 0
+            half3 halfVec = normalize(surfaceData.eyeVec + lightVec);
+        #endif
+
+        #if defined(URHO3D_SURFACE_VOLUMETRIC)
+            result += Direct_Volumetric(lightColor.rgb, surfaceData.albedo.rgb);
+        #elif defined(URHO3D_PHYSICAL_MATERIAL)
+            result += Direct_PBR(lightColor.rgb, surfaceData.albedo.rgb,
+                surfaceData.specular, surfaceData.roughness,
+                lightVec, surfaceData.normal, surfaceData.eyeVec, halfVec);
+        #elif URHO3D_SPECULAR > 0
+            result += Direct_SimpleSpecular(lightColor.rgb,
+                surfaceData.albedo.rgb, surfaceData.specular,
+                lightVec, surfaceData.normal, halfVec,
+                RoughnessToSpecularPower(surfaceData.roughness), lightColor.a);
+        #else
+            result += Direct_Simple(lightColor.rgb,
+                surfaceData.albedo.rgb, lightVec, surfaceData.normal);
+        #endif
+        }
+        return result;
+    }
+#endif
+
 /// Return color with applied lighting, but without fog.
 /// Fills all channels of geometry buffer except destination color.
 half3 GetSurfaceColor(SurfaceData surfaceData)
@@ -109,6 +145,11 @@ half3 GetSurfaceColor(SurfaceData surfaceData)
 #elif defined(URHO3D_LIGHT_PASS)
     surfaceColor += CalculateDirectLighting(surfaceData);
 #endif
+
+#ifdef URHO3D_CLUSTERED_LIGHTS
+    // Negative lights are accumulated together with positive ones
+    surfaceColor = max(vec3(0.0), surfaceColor + CalculateClusteredLighting(surfaceData, vWorldPos));
+#endif
     return surfaceColor;
 }
 
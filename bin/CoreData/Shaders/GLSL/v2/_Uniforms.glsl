@@ -70,6 +70,15 @@ UNIFORM_BUFFER_BEGIN(1, Camera)
     UNIFORM(half3 cFogColor)
     /// Scale of normal shadow bias.
     UNIFORM(half cNormalOffsetScale)
+#ifdef URHO3D_CLUSTERED_LIGHTS
+    /// World to clip space matrix used to find light cluster.
+    UNIFORM_HIGHP(mat4 cClusterViewProj)
+    /// World to view space transform of depth used to find light cluster.
+    UNIFORM_HIGHP(vec4 cClusterViewZ)
+    /// xy: Number of light clusters along screen axises.
+    /// zw: Scale and bias applied to logarithm of view space depth to get depth slice.
+    UNIFORM_HIGHP(vec4 cClusterParams)
+#endif
 UNIFORM_BUFFER_END(1, Camera)
 
 /// Zone: Reflection probe parameters.
@@ -212,11 +221,25 @@ UNIFORM_BUFFER_END(3, Light)
     #define UNIFORMS_PLANAR_REFLECTION
 #endif
 
+/// Uniforms needed for vertex animation textures, see VertexAnimationBaker.
+/// cVertexAnimationBoundsMin: Minimum of animated vertex positions in model space.
+/// cVertexAnimationBoundsSize: Size of the box containing animated vertex positions in model space.
+/// cVertexAnimationNumRows: Number of texture rows per vertex layer of the frame.
+#ifdef URHO3D_VERTEX_ANIMATION
+    #define UNIFORMS_VERTEX_ANIMATION \
+        UNIFORM_HIGHP(vec3 cVertexAnimationBoundsMin) \
+        UNIFORM_HIGHP(vec3 cVertexAnimationBoundsSize) \
+        UNIFORM_HIGHP(float cVertexAnimationNumRows)
+#else
+    #define UNIFORMS_VERTEX_ANIMATION
+#endif
+
 #define DEFAULT_MATERIAL_UNIFORMS \
     UNIFORMS_UV_TRANSFORM \
     UNIFORMS_LIGHTMAP \
     UNIFORMS_SURFACE \
-    UNIFORMS_PLANAR_REFLECTION
+    UNIFORMS_PLANAR_REFLECTION \
+    UNIFORMS_VERTEX_ANIMATION
 
 /// cLMOffset.xy: Scale applied to lightmap UVs;
 /// cLMOffset.zw: Offset applied to lightmap UVs.
@@ -228,6 +251,7 @@ UNIFORM_BUFFER_END(4, Material)
 
 /// Object: Per-instance constants.
 /// cModel: Object to world space matrix.
+/// cInstanceData: Custom per-instance data provided by the drawable, zero by default.
 /// cAmbient: Per-object ambient lighting in current color space.
 /// cSH*: Per-object ambient lighting in linear color space.
 /// cBillboardRot: Rotation of billboard plane in world space.
@@ -237,30 +261,33 @@ UNIFORM_BUFFER_END(4, Material)
         VERTEX_INPUT(vec4 iTexCoord4)
         VERTEX_INPUT(vec4 iTexCoord5)
         VERTEX_INPUT(vec4 iTexCoord6)
+        VERTEX_INPUT(vec4 iTexCoord7)
         #define cModel mat4(iTexCoord4, iTexCoord5, iTexCoord6, vec4(0.0, 0.0, 0.0, 1.0))
+        #define cInstanceData iTexCoord7
 
     #if defined(URHO3D_AMBIENT_DIRECTIONAL)
-        VERTEX_INPUT(half4 iTexCoord7)
         VERTEX_INPUT(half4 iTexCoord8)
         VERTEX_INPUT(half4 iTexCoord9)
         VERTEX_INPUT(half4 iTexCoord10)
         VERTEX_INPUT(half4 iTexCoord11)
         VERTEX_INPUT(half4 iTexCoord12)
         VERTEX_INPUT(half4 iTexCoord13)
-        #define cSHAr iTexCoord7
-        #define cSHAg iTexCoord8
-        #define cSHAb iTexCoord9
-        #define cSHBr iTexCoord10
-        #define cSHBg iTexCoord11
-        #define cSHBb iTexCoord12
-        #define cSHC  iTexCoord13
+        VERTEX_INPUT(half4 iTexCoord14)
+        #define cSHAr iTexCoord8
+        #define cSHAg iTexCoord9
+        #define cSHAb iTexCoord10
+        #define cSHBr iTexCoord11
+        #define cSHBg iTexCoord12
+        #define cSHBb iTexCoord13
+        #define cSHC  iTexCoord14
     #elif defined(URHO3D_AMBIENT_FLAT)
-        VERTEX_INPUT(half4 iTexCoord7)
-        #define cAmbient iTexCoord7
+        VERTEX_INPUT(half4 iTexCoord8)
+        #define cAmbient iTexCoord8
     #endif
     #else
         UNIFORM_BUFFER_BEGIN(5, Object)
             UNIFORM_HIGHP(mat4 cModel)
+            UNIFORM_HIGHP(vec4 cInstanceData)
 
         #if defined(URHO3D_AMBIENT_DIRECTIONAL)
             UNIFORM(half4 cSHAr)
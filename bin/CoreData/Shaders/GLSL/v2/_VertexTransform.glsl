@@ -112,6 +112,35 @@ mat4 GetModelMatrix()
     #define ApplyShadowNormalOffset(position, normal)
 #endif
 
+#ifdef URHO3D_VERTEX_ANIMATION
+    /// Vertex animation texture baked by VertexAnimationBaker.
+    /// Each frame consists of three layers: high and low bytes of normalized position and normal.
+    SAMPLER_HIGHP(14, sampler2D sVertexAnimation)
+
+    /// Return texel of vertex animation texture for given frame and layer.
+    vec4 SampleVertexAnimation(float frame, float layer)
+    {
+        ivec2 texel = ivec2(iTexCoord1);
+        texel.y += int((frame * 3.0 + layer) * cVertexAnimationNumRows);
+        return texelFetch(sVertexAnimation, texel, 0);
+    }
+
+    /// Return animated vertex position in model space for given frame.
+    vec3 GetVertexAnimationPosition(float frame)
+    {
+        vec3 high = SampleVertexAnimation(frame, 0.0).xyz;
+        vec3 low = SampleVertexAnimation(frame, 1.0).xyz;
+        vec3 normalized = (high * (255.0 * 256.0) + low * 255.0) / 65535.0;
+        return cVertexAnimationBoundsMin + normalized * cVertexAnimationBoundsSize;
+    }
+
+    /// Return animated vertex normal in model space for given frame.
+    half3 GetVertexAnimationNormal(float frame)
+    {
+        return SampleVertexAnimation(frame, 2.0).xyz * 2.0 - 1.0;
+    }
+#endif
+
 /// Return vertex transform in world space. Expected vertex inputs are listed below:
 ///
 /// URHO3D_GEOMETRY_STATIC, URHO3D_GEOMETRY_SKINNED:
@@ -119,6 +148,12 @@ mat4 GetModelMatrix()
 ///   iNormal.xyz: (optional) Vertex normal in model space
 ///   iTangent.xyz: (optional) Vertex tangent in model space and sign of binormal
 ///
+/// URHO3D_GEOMETRY_STATIC with URHO3D_VERTEX_ANIMATION:
+///   iTexCoord1.xy: Column and row of the vertex in vertex animation texture
+///   cInstanceData.xy: Current and next frame of vertex animation
+///   cInstanceData.z: Blend factor between current and next frame
+///   iTangent.xyz: (optional) Vertex tangent in bind pose
+///
 /// URHO3D_GEOMETRY_BILLBOARD:
 ///   iPos.xyz: Billboard position in model space
 ///   iTexCoord1.xy: Billboard size
@@ -142,12 +177,26 @@ mat4 GetModelMatrix()
     {
         mat4 modelMatrix = GetModelMatrix();
 
+    #if defined(URHO3D_VERTEX_ANIMATION) && defined(URHO3D_GEOMETRY_STATIC)
+        vec3 position = mix(GetVertexAnimationPosition(cInstanceData.x),
+            GetVertexAnimationPosition(cInstanceData.y), cInstanceData.z);
+    #else
+        vec3 position = iPos.xyz;
+    #endif
+
         VertexTransform result;
-        result.position = iPos * modelMatrix;
+        result.position = vec4(position, 1.0) * modelMatrix;
 
         #ifdef URHO3D_VERTEX_NEED_NORMAL
+            #if defined(URHO3D_VERTEX_ANIMATION) && defined(URHO3D_GEOMETRY_STATIC)
+                half3 normal = mix(GetVertexAnimationNormal(cInstanceData.x),
+                    GetVertexAnimationNormal(cInstanceData.y), cInstanceData.z);
+            #else
+                half3 normal = iNormal;
+            #endif
+
             mediump mat3 normalMatrix = GetNormalMatrix(modelMatrix);
-            result.normal = normalize(iNormal * normalMatrix);
+            result.normal = normalize(normal * normalMatrix);
 
             ApplyShadowNormalOffset(result.position, result.normal);
 